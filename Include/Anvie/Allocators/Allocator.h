@@ -0,0 +1,187 @@
+/**
+ * @file Allocator.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Generic allocator interface used by containers.
+ *
+ * An @c Allocator is a small table of callbacks along with a context pointer.
+ * Containers created with a @c *_create_with_allocator function use the given
+ * allocator for all of their internal memory, instead of @c calloc and @c free.
+ * This allows plugging in an @c Arena, a block pool or any other custom
+ * allocator without changing the containers.
+ *
+ * A @c NULL @c Allocator* always means the system allocator (@c malloc,
+ * @c realloc and @c free), so containers created with plain @c *_create
+ * functions behave exactly as before.
+ *
+ * The allocator object must stay alive as long as any container using it.
+ * */
+
+#ifndef ANVIE_UTILS_ALLOCATORS_ALLOCATOR_H
+#define ANVIE_UTILS_ALLOCATORS_ALLOCATOR_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <string.h>
+
+/**
+ * Allocate @p size bytes. Returned memory need not be initialized.
+ * @return Pointer to allocated memory, or @c NULL on failure.
+ * */
+typedef void* (*AllocateCallback)(Size size, void* ctx);
+
+/**
+ * Resize an allocation of @p old_size bytes to @p new_size bytes,
+ * preserving contents up to minimum of both sizes.
+ * @p ptr can be @c NULL, in which case this is an allocation.
+ * @return Pointer to resized memory, or @c NULL on failure, in which
+ * case original allocation is left untouched.
+ * */
+typedef void* (*ReallocateCallback)(void* ptr, Size old_size, Size new_size, void* ctx);
+
+/**
+ * Release an allocation of @p size bytes.
+ * */
+typedef void (*FreeCallback)(void* ptr, Size size, void* ctx);
+
+/**
+ * A pluggable allocator.
+ *
+ * If @c free is @c NULL then the allocator releases memory in bulk
+ * (for eg: an @c Arena on reset). Containers using such an allocator
+ * skip all individual frees on destroy, including destroying element
+ * copies, since that memory is expected to come from the same allocator.
+ * */
+typedef struct Allocator {
+    AllocateCallback   allocate;   /**< Allocate uninitialized memory. Cannot be NULL. */
+    ReallocateCallback reallocate; /**< Resize memory. Cannot be NULL. */
+    FreeCallback       free;       /**< Release memory. NULL if memory is released in bulk. */
+    void*              ctx;        /**< Context passed to each callback. */
+} Allocator;
+
+/**
+ * Check whether memory allocated from given allocator must be
+ * released individually.
+ * */
+#define allocator_needs_free(a) (!(a) || (a)->free)
+
+/**
+ * Allocate uninitialized memory from given allocator.
+ *
+ * @param allocator Allocator to use, @c NULL for system allocator.
+ * @param size Number of bytes to allocate.
+ * */
+static FORCE_INLINE void* allocator_allocate(const Allocator* allocator, Size size) {
+    return allocator ? allocator->allocate(size, allocator->ctx) : malloc(size);
+}
+
+/**
+ * Allocate zero initialized memory from given allocator.
+ * This is what @c ALLOCATE does for system allocator.
+ *
+ * @param allocator Allocator to use, @c NULL for system allocator.
+ * @param size Number of bytes to allocate.
+ * */
+static FORCE_INLINE void* allocator_allocate_zeroed(const Allocator* allocator, Size size) {
+    if(!allocator) return calloc(1, size);
+
+    void* mem = allocator->allocate(size, allocator->ctx);
+    if(mem) memset(mem, 0, size);
+    return mem;
+}
+
+/**
+ * Resize memory allocated from given allocator.
+ *
+ * @param allocator Allocator to use, @c NULL for system allocator.
+ * @param ptr Memory to be resized. Can be @c NULL.
+ * @param old_size Current size of allocation.
+ * @param new_size New size of allocation.
+ * */
+static FORCE_INLINE void* allocator_reallocate(const Allocator* allocator, void* ptr, Size old_size, Size new_size) {
+    return allocator ? allocator->reallocate(ptr, old_size, new_size, allocator->ctx) : realloc(ptr, new_size);
+}
+
+/**
+ * Release memory allocated from given allocator.
+ *
+ * @param allocator Allocator to use, @c NULL for system allocator.
+ * @param ptr Memory to be released. Can be @c NULL.
+ * @param size Size of allocation.
+ * */
+static FORCE_INLINE void allocator_free(const Allocator* allocator, void* ptr, Size size) {
+    if(!ptr) return;
+    if(!allocator) free(ptr);
+    else if(allocator->free) allocator->free(ptr, size, allocator->ctx);
+}
+
+/**
+ * Statistics common to all allocators in this library.
+ * A snapshot is obtained from @c *_get_stats function of each allocator.
+ *
+ * Event counters (@c total_allocs, @c total_frees, @c peak_live_count,
+ * @c search_steps) are maintained on every allocation and free. Rest of
+ * the fields are computed when the snapshot is taken.
+ * */
+typedef struct AllocatorStats {
+    Size    live_count;        /**< Number of allocations currently live. */
+    Size    peak_live_count;   /**< Highest value @c live_count has ever reached. */
+    Size    total_allocs;      /**< Total number of successful allocations. */
+    Size    total_frees;       /**< Total number of frees. */
+    Size    chunk_count;       /**< Number of columns, pages or chunks committed. */
+    Size    reserved_bytes;    /**< Bytes obtained from system for allocations. */
+    Size    used_bytes;        /**< Bytes currently handed out to users. */
+    Size    search_steps;      /**< Total steps spent searching for a free slot, over all allocations. */
+    Float32 avg_search_length; /**< @c search_steps divided by @c total_allocs. */
+    Float32 fragmentation;     /**< Fraction of touched memory (handed out at least once) that is now free. */
+} AllocatorStats;
+
+/**
+ * Record a successful allocation in given stats.
+ * For use by allocator implementations.
+ *
+ * @param stats @c AllocatorStats lvalue.
+ * @param live Number of live allocations after this allocation.
+ * */
+#define ALLOCATOR_STATS_RECORD_ALLOC(stats, live)                       \
+    do {                                                                \
+        (stats).total_allocs++;                                         \
+        if((live) > (stats).peak_live_count) (stats).peak_live_count = (live); \
+    } while(0)
+
+/**
+ * Record a free in given stats.
+ * For use by allocator implementations.
+ *
+ * @param stats @c AllocatorStats lvalue.
+ * */
+#define ALLOCATOR_STATS_RECORD_FREE(stats) ((stats).total_frees++)
+
+/**
+ * Fill average search length in given stats, from it's counters.
+ * For use by allocator implementations.
+ *
+ * @param stats @c AllocatorStats lvalue.
+ * */
+#define ALLOCATOR_STATS_FINALIZE(stats)                                 \
+    do {                                                                \
+        (stats).avg_search_length = (stats).total_allocs ?              \
+            (Float32)(stats).search_steps / (Float32)(stats).total_allocs : 0.f; \
+    } while(0)
+
+#endif // ANVIE_UTILS_ALLOCATORS_ALLOCATOR_H
@@ -0,0 +1,105 @@
+/**
+ * @file Arena.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief An @c Arena is a bump allocator. Memory is allocated by just
+ * moving a pointer forward inside large chunks of memory. Individual
+ * allocations are never freed, instead the whole arena is reset at once.
+ *
+ * This is useful when a lot of objects share same lifetime, for eg: all
+ * objects created while handling a request. Instead of freeing each of them
+ * separately, all can be released at once with a single @c arena_reset.
+ *
+ * PROS:
+ * - Allocation is just a pointer bump in the common case.
+ * - Reset and restore to a saved marker are constant time.
+ * - Allocations made one after another are close to each other in memory.
+ * CONS:
+ * - Individual allocations cannot be freed.
+ * - Not asynchronous.
+ * */
+
+#ifndef ANVIE_UTILS_ALLOCATORS_ARENA_H
+#define ANVIE_UTILS_ALLOCATORS_ARENA_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+
+#ifndef ARENA_DEFAULT_CHUNK_SIZE
+/**
+ * Default size of each chunk arena allocates memory from.
+ * Allocations larger than chunk size get a chunk of their own.
+ * */
+#define ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#endif
+
+#ifndef ARENA_DEFAULT_ALIGNMENT
+/**
+ * Alignment used by @c arena_allocate. This is same as what
+ * @c malloc guarantees on most 64 bit platforms.
+ * */
+#define ARENA_DEFAULT_ALIGNMENT 16
+#endif
+
+/**
+ * A contiguous chunk of memory from which an arena allocates.
+ * Chunks are kept in a singly linked list. Chunks after the current
+ * chunk are not in use, and are kept around for reuse after a reset.
+ * */
+typedef struct ArenaChunk {
+    struct ArenaChunk* next;     /**< Next chunk in list. */
+    Size               capacity; /**< Number of bytes in @c data. */
+    Size               used;     /**< Number of bytes used in @c data. */
+    Uint8              data[];   /**< Memory allocations are made from. */
+} ArenaChunk;
+
+/**
+ * Bump allocator with chunked growth.
+ * */
+typedef struct Arena {
+    ArenaChunk*    first;      /**< First chunk in chunk list. */
+    ArenaChunk*    current;    /**< Chunk allocations are being made from. */
+    Size           chunk_size; /**< Size of each new chunk. */
+    AllocatorStats stats;      /**< Event counters, use @c arena_get_stats to get a full snapshot. */
+} Arena;
+
+/**
+ * A saved state of arena. Restoring an arena to a marker releases
+ * all allocations made after the marker was saved.
+ * */
+typedef struct ArenaMarker {
+    ArenaChunk* chunk;      /**< Current chunk when marker was saved. */
+    Size        used;       /**< Used bytes in chunk when marker was saved. */
+    Size        live_count; /**< Number of live allocations when marker was saved. */
+} ArenaMarker;
+
+Arena*         arena_create(Size chunk_size);
+void           arena_destroy(Arena* arena);
+void*          arena_allocate(Arena* arena, Size size);
+void*          arena_allocate_aligned(Arena* arena, Size size, Size alignment);
+void*          arena_allocate_zeroed(Arena* arena, Size size);
+void*          arena_reallocate(Arena* arena, void* ptr, Size old_size, Size new_size);
+ArenaMarker    arena_save(Arena* arena);
+void           arena_restore(Arena* arena, ArenaMarker marker);
+void           arena_reset(Arena* arena);
+Size           arena_get_used_size(Arena* arena);
+Size           arena_get_reserved_size(Arena* arena);
+Allocator      arena_get_allocator(Arena* arena);
+AllocatorStats arena_get_stats(Arena* arena);
+
+#endif // ANVIE_UTILS_ALLOCATORS_ARENA_H
@@ -58,6 +58,7 @@
 
 #include <Anvie/Types.h>
 #include <Anvie/Containers/BitVector.h>
+#include <Anvie/Allocators/Allocator.h>
 
 /**
  * @c BlockAllocators allocate memory blocks. All
@@ -105,48 +106,126 @@ typedef Uint8* MemBlockArray;
 #define LIN_BLOCK_ALLOCATOR_RESIZE_FACTOR 5
 #endif
 
+/**
+ * Flags to change how a @c LinBlockAllocator gets memory for it's columns.
+ * Passed to @c lballoc_create_with_options.
+ * */
+typedef enum LinBlockAllocatorFlags {
+    /**
+     * Reserve one large virtual address range with @c mmap upfront and commit
+     * columns from it lazily, in order. All blocks then live in one contiguous
+     * range, so finding owner of a block on free is plain arithmetic, and
+     * there's no per column @c malloc. Capacity is limited by the reserved range.
+     * */
+    LIN_BLOCK_ALLOCATOR_FLAG_MMAP      = 1 << 0,
+
+    /**
+     * Advise kernel to back reserved range with transparent huge pages
+     * (@c MADV_HUGEPAGE). Implies @c LIN_BLOCK_ALLOCATOR_FLAG_MMAP.
+     * */
+    LIN_BLOCK_ALLOCATOR_FLAG_HUGEPAGE  = 1 << 1,
+
+    /**
+     * Back reserved range with explicit huge pages (@c MAP_HUGETLB).
+     * Falls back to a normal mapping if no huge pages are available.
+     * Implies @c LIN_BLOCK_ALLOCATOR_FLAG_MMAP.
+     * */
+    LIN_BLOCK_ALLOCATOR_FLAG_HUGETLB   = 1 << 2,
+} LinBlockAllocatorFlags;
+
 /**
  * A @c LinBlockAllocator has a linear growth policy, meaning everytime,
  * the @c LinrBlockAllocator is at it's capacity and cannot allocate more
  * blocks, it'll increase it's size by a pre-defined step value.
  * This is for use cases when there will be allocations, but the number
  * of allocations grows in an almost linear fashion.
+ *
+ * Each column holds @c (1 << col_shift) blocks. By default @c col_shift is
+ * @c LIN_BLOCK_ALLOCATOR_RESIZE_FACTOR, but it can be chosen per instance
+ * using @c lballoc_create_with_options. Blocks never move once allocated.
  * */
 typedef struct LinBlockAllocator {
     Size           allocation_count; /**< Total number of allocated blocks. */
     Size           total_capacity; /**< Total number of blocks that can and has been allocated. */
     Size           block_size;  /**< Size of each block. */
-    Size           last_freed_block; /**< Index of last free'd block. */
+    Size           last_freed_block; /**< Index of last free'd block, head of free block list. */
+    Size           next_unused_block; /**< Index of first block that has never been allocated. */
     BitVector*     occupancy; /**< To store whether or not a block is allocated. */
     MemBlockArray* block_matrix; /**< A 2D Matrix of memory blocks. */
+    Size*          col_order; /**< Column indices sorted by address, to find owner of a block. */
+    Size           col_shift; /**< Log2 of number of blocks in each column. */
+    Uint32         flags; /**< @c LinBlockAllocatorFlags used to create this allocator. */
+    MemBlockArray  region; /**< Reserved virtual range when created with @c LIN_BLOCK_ALLOCATOR_FLAG_MMAP */
+    Size           region_size; /**< Size of reserved range in bytes. */
+    Size           committed_size; /**< Number of bytes committed from start of reserved range. */
+    AllocatorStats stats; /**< Event counters, use @c lballoc_get_stats to get a full snapshot. */
 } LinBlockAllocator;
 
+/**
+ * Callback used to visit each live (allocated) block of a block allocator.
+ *
+ * @param blk Allocated block being visited.
+ * @param index Index of block inside the allocator.
+ * @param udata User data passed to the foreach call.
+ * */
+typedef void (*MemBlockVisitorCallback)(MemBlock blk, Size index, void* udata);
+
 LinBlockAllocator* lballoc_create(Size block_size);
+LinBlockAllocator* lballoc_create_with_options(Size block_size, Size col_shift, Size max_blocks, Uint32 flags);
 void               lballoc_destroy(LinBlockAllocator* lba);
 void               lballoc_reserve(LinBlockAllocator* lba, Size num_blocks);
 MemBlock           lballoc_allocate(LinBlockAllocator* lba);
 void               lballoc_free(LinBlockAllocator* lba, MemBlock blk);
 Float32            lballoc_get_load(LinBlockAllocator* lba);
+void               lballoc_foreach(LinBlockAllocator* lba, MemBlockVisitorCallback visitor, void* udata);
+AllocatorStats     lballoc_get_stats(LinBlockAllocator* lba);
+
+#ifndef EXP_BLOCK_ALLOCATOR_INITIAL_CAPACITY
+/**
+ * Number of blocks an @c ExpBlockAllocator can hold right after creation.
+ * Every time the allocator runs out of blocks, this capacity is doubled.
+ * Must be a non-zero value.
+ * */
+#define EXP_BLOCK_ALLOCATOR_INITIAL_CAPACITY 32
+#endif
 
 /**
  * The @c ExpBlockAllocator has an exponential growth policy, much like
  * any other continuous container out there. The size will increase to
  * twice it's current value, everytime this block allocator feels like
  * resizing.
+ *
+ * All blocks live in one contiguous array, which makes visiting all
+ * live blocks a linear sweep over memory instead of a walk over
+ * separately allocated columns.
+ *
+ * The price paid for contiguity is that growing the allocator may move
+ * the whole array. Any @c MemBlock obtained before a call to
+ * @c eballoc_allocate or @c eballoc_reserve that resulted in growth
+ * becomes invalid. Store block indices (see @c eballoc_get_block_index
+ * and @c eballoc_get_block) if references must outlive a growth, or
+ * reserve enough blocks beforehand.
  * */
 typedef struct ExpBlockAllocator {
-    Size          allocation_count; /**< Total number of allocated blocks. */
-    Size          total_capacity; /**< Total number of blocks that can and has been allocated. */
-    Size          block_size;  /**< Size of each block. */
-    Size          last_freed_block; /**< Index of last free'd block. */
-    BitVector*    occupancy; /**< To store whether or not a bit is allocated. */
-    MemBlockArray block_array;  /**< A linear resizable array of Memory */
+    Size           allocation_count; /**< Total number of allocated blocks. */
+    Size           total_capacity; /**< Total number of blocks that can and has been allocated. */
+    Size           block_size;  /**< Size of each block. */
+    Size           last_freed_block; /**< Index of last free'd block. */
+    BitVector*     occupancy; /**< To store whether or not a bit is allocated. */
+    MemBlockArray  block_array;  /**< A linear resizable array of Memory */
+    Size           high_water_block; /**< One past highest index ever allocated. */
+    AllocatorStats stats; /**< Event counters, use @c eballoc_get_stats to get a full snapshot. */
 } ExpBlockAllocator;
 
-/* ExpBlockAllocator* eballoc_create(Size block_size); */
-/* void               eballoc_destroy(ExpBlockAllocator* lba); */
-/* MemBlock           eballoc_allocate(ExpBlockAllocator* lba); */
-/* void               eballoc_free(ExpBlockAllocator* lba, MemBlock blk); */
-/* Float32            eballoc_get_load(ExpBlockAllocator* lba); */
+ExpBlockAllocator* eballoc_create(Size block_size);
+void               eballoc_destroy(ExpBlockAllocator* eba);
+void               eballoc_reserve(ExpBlockAllocator* eba, Size num_blocks);
+MemBlock           eballoc_allocate(ExpBlockAllocator* eba);
+void               eballoc_free(ExpBlockAllocator* eba, MemBlock blk);
+Float32            eballoc_get_load(ExpBlockAllocator* eba);
+void               eballoc_foreach(ExpBlockAllocator* eba, MemBlockVisitorCallback visitor, void* udata);
+Size               eballoc_get_block_index(ExpBlockAllocator* eba, MemBlock blk);
+MemBlock           eballoc_get_block(ExpBlockAllocator* eba, Size index);
+AllocatorStats     eballoc_get_stats(ExpBlockAllocator* eba);
 
 #endif // ANVIE_UTILS_ALLOCATORS_BLOCK_ALLLOCATOR_H
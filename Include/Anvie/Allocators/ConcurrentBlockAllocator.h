@@ -0,0 +1,71 @@
+/**
+ * @file ConcurrentBlockAllocator.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A thread safe front end for @c LinBlockAllocator.
+ *
+ * Each thread using a @c ConcurrentBlockAllocator gets it's own small cache
+ * (a magazine) of free blocks. Allocations and frees are served from this
+ * magazine without any locking. Only when a magazine runs empty (or full),
+ * it's refilled from (or drained to) a shared @c LinBlockAllocator depot,
+ * in batches, under a lock.
+ *
+ * A block can be freed from any thread, not just the one that allocated it.
+ * Such a block simply goes into the freeing thread's magazine, from where it
+ * can be reused by that thread or returned to the depot.
+ * */
+
+#ifndef ANVIE_UTILS_ALLOCATORS_CONCURRENT_BLOCK_ALLLOCATOR_H
+#define ANVIE_UTILS_ALLOCATORS_CONCURRENT_BLOCK_ALLLOCATOR_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/BlockAllocator.h>
+#include <pthread.h>
+
+#ifndef CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE
+/**
+ * Maximum number of free blocks cached by each thread.
+ * Half of this many blocks are moved between a magazine and
+ * the shared depot at once.
+ * */
+#define CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE 64
+#endif
+
+typedef struct BlockMagazine BlockMagazine;
+
+/**
+ * Thread safe block allocator with per thread caches of free blocks,
+ * backed by a shared @c LinBlockAllocator.
+ * */
+typedef struct ConcurrentBlockAllocator {
+    LinBlockAllocator* depot;     /**< Shared pool all magazines are refilled from. */
+    pthread_mutex_t    lock;      /**< Protects depot and magazine list. */
+    pthread_key_t      magazine_key; /**< Key to get magazine of calling thread. */
+    BlockMagazine*     magazines; /**< List of all magazines, to be freed on destroy. */
+    Size               retired_allocs; /**< Allocation count of magazines of exited threads. */
+    Size               retired_frees; /**< Free count of magazines of exited threads. */
+} ConcurrentBlockAllocator;
+
+ConcurrentBlockAllocator* cballoc_create(Size block_size);
+void                      cballoc_destroy(ConcurrentBlockAllocator* cba);
+MemBlock                  cballoc_allocate(ConcurrentBlockAllocator* cba);
+void                      cballoc_free(ConcurrentBlockAllocator* cba, MemBlock blk);
+void                      cballoc_flush(ConcurrentBlockAllocator* cba);
+AllocatorStats            cballoc_get_stats(ConcurrentBlockAllocator* cba);
+
+#endif // ANVIE_UTILS_ALLOCATORS_CONCURRENT_BLOCK_ALLLOCATOR_H
@@ -0,0 +1,71 @@
+/**
+ * @file MmapAllocator.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief An mmap allocator serves allocations above a size threshold
+ * directly from anonymous memory mappings, and everything else from the
+ * system allocator.
+ *
+ * Resizing a mapping uses @c mremap where available, which moves pages
+ * in the page table instead of copying them. This makes it a good fit for
+ * huge vectors : plug it into @c vector_create_with_allocator and reallocs
+ * of the element array stop copying once it grows past the threshold.
+ * Freed mappings are returned to the system right away.
+ *
+ * PROS:
+ * - Growing huge buffers costs page table updates instead of copies.
+ * - Memory of huge buffers is given back to system immediately on free.
+ * CONS:
+ * - Each mapping is rounded up to page size.
+ * - Every mapping is a system call, so threshold must not be too small.
+ * */
+
+#ifndef ANVIE_UTILS_ALLOCATORS_MMAP_ALLOCATOR_H
+#define ANVIE_UTILS_ALLOCATORS_MMAP_ALLOCATOR_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+
+#ifndef MMAP_ALLOCATOR_DEFAULT_THRESHOLD
+/**
+ * Allocations larger than this many bytes are mapped by default.
+ * */
+#define MMAP_ALLOCATOR_DEFAULT_THRESHOLD (1024 * 1024)
+#endif
+
+/**
+ * Allocator that maps large allocations.
+ * */
+typedef struct MmapAllocator {
+    Size           threshold;    /**< allocations larger than this are mapped */
+    Size           page_size;    /**< size of a page, mappings are rounded up to it */
+    Size           map_count;    /**< number of live mappings */
+    Size           mapped_bytes; /**< total size of live mappings, after rounding */
+    Size           used_bytes;   /**< total size of live allocations, as requested */
+    AllocatorStats stats;        /**< event counters, use @c mmapalloc_get_stats to get a full snapshot */
+} MmapAllocator;
+
+MmapAllocator* mmapalloc_create(Size threshold);
+void           mmapalloc_destroy(MmapAllocator* mma);
+void*          mmapalloc_allocate(MmapAllocator* mma, Size size);
+void*          mmapalloc_reallocate(MmapAllocator* mma, void* ptr, Size old_size, Size new_size);
+void           mmapalloc_free(MmapAllocator* mma, void* ptr, Size size);
+Allocator      mmapalloc_get_allocator(MmapAllocator* mma);
+AllocatorStats mmapalloc_get_stats(MmapAllocator* mma);
+
+#endif // ANVIE_UTILS_ALLOCATORS_MMAP_ALLOCATOR_H
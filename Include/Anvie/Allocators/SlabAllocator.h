@@ -0,0 +1,111 @@
+/**
+ * @file SlabAllocator.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A slab allocator serves small allocations of varying size from
+ * a fixed set of size classes. Each size class is a pool of equally sized
+ * blocks carved out of large pages, with freed blocks kept in an intrusive
+ * free list. Both allocation and free are constant time.
+ *
+ * Size classes are powers of two, from @c SLAB_ALLOCATOR_MIN_BLOCK_SIZE up to
+ * @c SLAB_ALLOCATOR_MAX_BLOCK_SIZE. Requests larger than that are forwarded to
+ * the system allocator.
+ *
+ * Like @c Allocator, the size of an allocation must be given back when freeing
+ * it. That is what makes finding the owning class constant time, without any
+ * per block header.
+ *
+ * PROS:
+ * - No per allocation header, no per allocation @c malloc call.
+ * - Similar sized objects end up next to each other in memory.
+ * CONS:
+ * - Not asynchronous.
+ * - Pages are never returned to system until allocator is destroyed.
+ * - Up to half of a block may be wasted for sizes just above a power of two.
+ * */
+
+#ifndef ANVIE_UTILS_ALLOCATORS_SLAB_ALLOCATOR_H
+#define ANVIE_UTILS_ALLOCATORS_SLAB_ALLOCATOR_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+
+#ifndef SLAB_ALLOCATOR_PAGE_SIZE
+/**
+ * Size of each page a size class carves it's blocks out of.
+ * Must be at least @c SLAB_ALLOCATOR_MAX_BLOCK_SIZE.
+ * */
+#define SLAB_ALLOCATOR_PAGE_SIZE (64 * 1024)
+#endif
+
+/**
+ * Size of smallest size class. A freed block stores the next free block
+ * pointer inside itself, so this cannot be less than size of a pointer.
+ * */
+#define SLAB_ALLOCATOR_MIN_BLOCK_SIZE 8
+
+/**
+ * Size of largest size class. Larger requests go to system allocator.
+ * */
+#define SLAB_ALLOCATOR_MAX_BLOCK_SIZE 2048
+
+/**
+ * Total number of size classes : 8, 16, 32, ..., 2048
+ * */
+#define SLAB_ALLOCATOR_CLASS_COUNT 9
+
+/**
+ * A page from which blocks of a single size class are allocated.
+ * */
+typedef struct SlabPage {
+    struct SlabPage* next;  /**< Next page of same size class. */
+    Size             used;  /**< Number of bytes in @c data handed out by bump allocation. */
+    Uint8            data[] __attribute__((aligned(16))); /**< Memory blocks are carved from. */
+} SlabPage;
+
+/**
+ * A pool of equally sized blocks.
+ * */
+typedef struct SlabClass {
+    Size      block_size; /**< Size of each block in this class. */
+    Size      live_count; /**< Number of blocks currently allocated. */
+    Size      page_count; /**< Number of pages in @c pages list. */
+    void*     free_list;  /**< Head of intrusive list of freed blocks. */
+    SlabPage* pages;      /**< List of pages, first one is used for bump allocation. */
+} SlabClass;
+
+/**
+ * Allocator for small objects of varying sizes.
+ * */
+typedef struct SlabAllocator {
+    SlabClass      classes[SLAB_ALLOCATOR_CLASS_COUNT]; /**< Size classes in increasing order of block size. */
+    Size           large_count; /**< Number of live allocations forwarded to system allocator. */
+    Size           large_bytes; /**< Total size of live allocations forwarded to system allocator. */
+    AllocatorStats stats; /**< Event counters, use @c slaballoc_get_stats to get a full snapshot. */
+} SlabAllocator;
+
+SlabAllocator* slaballoc_create();
+void           slaballoc_destroy(SlabAllocator* sla);
+void*          slaballoc_allocate(SlabAllocator* sla, Size size);
+void*          slaballoc_reallocate(SlabAllocator* sla, void* ptr, Size old_size, Size new_size);
+void           slaballoc_free(SlabAllocator* sla, void* ptr, Size size);
+Size           slaballoc_get_block_size(Size size);
+Allocator      slaballoc_get_allocator(SlabAllocator* sla);
+AllocatorStats slaballoc_get_stats(SlabAllocator* sla);
+
+#endif // ANVIE_UTILS_ALLOCATORS_SLAB_ALLOCATOR_H
@@ -87,6 +87,15 @@
  */
 #define XNOR(a, b) NOT(XOR(a, b))
 
+/**
+ * Performs a bitwise AND operation of first value with NOT of second value.
+ *
+ * @param a First value
+ * @param b Second value, whose set bits are cleared in @p a
+ * @return Result of the bitwise ANDNOT operation
+ */
+#define ANDNOT(a, b) AND(a, NOT(b))
+
 /**
  * Performs a bitwise shift right operation on a value.
  *
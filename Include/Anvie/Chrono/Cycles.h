@@ -0,0 +1,115 @@
+/**
+ * @file Cycles.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Cycle counter of CPU, cheapest possible timestamps for measuring
+ * short durations, eg: a single container operation. Counter ticks at a
+ * constant rate (TSC on x86, virtual counter on AArch64), which is converted
+ * to nanoseconds with a frequency calibrated once against monotonic clock.
+ * */
+
+#ifndef ANVIE_CHRONO_CYCLES_H
+#define ANVIE_CHRONO_CYCLES_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Chrono/Time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+/**
+ * Read cycle counter. Reading is not ordered with surrounding instructions,
+ * so CPU may read it a little earlier or later than where it's written.
+ * On platforms without a known counter, this is monotonic nanoseconds.
+ * */
+static FORCE_INLINE Uint64 chrono_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    Uint64 cycles;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    return chrono_monotonic_nanoseconds();
+#endif
+}
+
+/**
+ * Read cycle counter only after all previous instructions have completed,
+ * and before any following one starts. Slower than @c chrono_cycles, use it
+ * when measured code is only a few instructions long.
+ * */
+static FORCE_INLINE Uint64 chrono_cycles_ordered(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    Uint32 aux;
+    Uint64 cycles = __rdtscp(&aux);
+    _mm_lfence();
+    return cycles;
+#elif defined(__aarch64__)
+    Uint64 cycles;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(cycles) : : "memory");
+    return cycles;
+#else
+    return chrono_monotonic_nanoseconds();
+#endif
+}
+
+Uint64 chrono_cycles_frequency(void);
+Uint64 chrono_cycles_to_nanoseconds(Uint64 cycles);
+
+/**
+ * Timestamp taken by @c chrono_timer_start, pass it by value to read time
+ * elapsed since then.
+ * */
+typedef struct ChronoTimer {
+    Uint64 start; /**< Cycle counter when timer was started. */
+} ChronoTimer;
+
+static FORCE_INLINE ChronoTimer chrono_timer_start(void) {
+    ChronoTimer timer = {chrono_cycles()};
+    return timer;
+}
+
+static FORCE_INLINE Uint64 chrono_timer_elapsed_cycles(ChronoTimer timer) {
+    return chrono_cycles() - timer.start;
+}
+
+static FORCE_INLINE Uint64 chrono_timer_elapsed_nanoseconds(ChronoTimer timer) {
+    return chrono_cycles_to_nanoseconds(chrono_timer_elapsed_cycles(timer));
+}
+
+/**
+ * Run following statement or block once, and add number of cycles it took
+ * to @p total_cycles, an lvalue of integer type. Leaving block with @c break,
+ * @c return or @c goto skips the addition.
+ *
+ * Example :
+ * @code{.c}
+ * Uint64 find_cycles = 0;
+ * CHRONO_TIMED_SCOPE(find_cycles) {
+ *     found = densemap_find(map, key);
+ * }
+ * @endcode
+ * */
+#define CHRONO_TIMED_SCOPE(total_cycles)                                                         \
+    for(Uint64 chrono_scope_start_ = chrono_cycles(), chrono_scope_once_ = 1; chrono_scope_once_; \
+        chrono_scope_once_ = 0, (total_cycles) += chrono_cycles() - chrono_scope_start_)
+
+#endif // ANVIE_CHRONO_CYCLES_H
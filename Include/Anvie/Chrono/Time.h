@@ -29,11 +29,17 @@
 #ifdef __linux__
 
 #include <sys/time.h>
+#include <time.h>
+
+/*
+** Wall clock time since epoch. Wall clock can jump back or forward when system
+** time is changed, so use monotonic clock below to measure durations.
+*/
 
 static FORCE_INLINE Size chrono_get_time_as_seconds(void) {
     struct timeval tv;
     gettimeofday(&tv, NULL);
-    return ((Size)tv.tv_sec)+((Size)tv.tv_usec)/1000000;
+    return (Size)tv.tv_sec;
 }
 
 static FORCE_INLINE Size chrono_get_time_as_milliseconds(void) {
@@ -49,11 +55,30 @@ static FORCE_INLINE Size chrono_get_time_as_microseconds(void) {
 }
 
 static FORCE_INLINE Size chrono_get_time_as_nanoseconds(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (Size)tv.tv_sec * 1000000000 + (Size)tv.tv_usec * 1000;
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (Size)ts.tv_sec * 1000000000 + (Size)ts.tv_nsec;
 }
 
+/*
+** Monotonic time since some unspecified point (usually boot). Never goes back,
+** and has nanosecond resolution, so difference of two readings is a duration.
+** For cheapest timestamps of short durations, see Anvie/Chrono/Cycles.h.
+*/
+
+static FORCE_INLINE Uint64 chrono_monotonic_nanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000 + (Uint64)ts.tv_nsec;
+}
+
+static FORCE_INLINE Uint64 chrono_monotonic_microseconds(void) {
+    return chrono_monotonic_nanoseconds() / 1000;
+}
+
+static FORCE_INLINE Uint64 chrono_monotonic_milliseconds(void) {
+    return chrono_monotonic_nanoseconds() / 1000000;
+}
 
 #else
 #error Platform not supported for time
@@ -0,0 +1,91 @@
+/**
+ * @file AtomicBitVector.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Fixed length bit vector that can be shared between threads.
+ * All bit operations are lock-free atomic operations on 64 bit words, so
+ * this can be used as a concurrent "visited" set in parallel traversals,
+ * or to claim slots from many threads at once.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_ATOMIC_BIT_VECTOR_H
+#define ANVIE_UTILS_CONTAINERS_ATOMIC_BIT_VECTOR_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/BitVector.h>
+
+/**
+ * Bit vector with a fixed number of bits, stored in 64 bit words.
+ * Bit @c i is bit @c (i % 64) of word @c (i / 64).
+ *
+ * CONCURRENCY SEMANTICS
+ * - all functions except create, destroy and conversion functions can be
+ *   called from any number of threads at once.
+ * - operations that modify a bit have acquire-release ordering, so memory
+ *   written by a thread before it sets a bit is visible to a thread that
+ *   observes that bit set.
+ * - functions that read more than one word (popcount, copy to
+ *   @c BitVector) see each word atomically, but not all words at one instant.
+ * - bits past @c length in last word are always clear.
+ *
+ * ALLOCATION SEMANTICS
+ * - words are allocated once at creation using @c allocator and never move.
+ * - a @c NULL @c allocator means system allocator is used.
+ * */
+typedef struct AtomicBitVector {
+    Size       length;     /**< Number of bits. */
+    Size       word_count; /**< Number of 64 bit words in @c words. */
+    Uint64*    words;      /**< Bits, accessed only through atomic operations. */
+    Allocator* allocator;  /**< Allocator for all memory owned by this, NULL for system allocator. */
+} AtomicBitVector;
+
+#define INVALID_ATOMIC_BITVECTOR ((AtomicBitVector*)0)
+
+#define atomic_bitvec_length(abv) ((abv) ? (abv)->length : 0)
+#define atomic_bitvec_word_index(index) ((index) >> 6)
+#define atomic_bitvec_bit_mask(index) ((Uint64)1 << ((index) & 63))
+
+AtomicBitVector* atomic_bitvec_create(Size length);
+AtomicBitVector* atomic_bitvec_create_with_allocator(Size length, Allocator* allocator);
+void             atomic_bitvec_destroy(AtomicBitVector* abv);
+
+/* single bit operation */
+Bool atomic_bitvec_peek(AtomicBitVector* abv, Size index);
+void atomic_bitvec_set(AtomicBitVector* abv, Size index);
+void atomic_bitvec_clear(AtomicBitVector* abv, Size index);
+Bool atomic_bitvec_test_and_set(AtomicBitVector* abv, Size index);
+Bool atomic_bitvec_test_and_clear(AtomicBitVector* abv, Size index);
+
+/* word operation */
+Uint64 atomic_bitvec_load_word(AtomicBitVector* abv, Size word_index);
+Uint64 atomic_bitvec_fetch_or(AtomicBitVector* abv, Size word_index, Uint64 mask);
+Uint64 atomic_bitvec_fetch_and(AtomicBitVector* abv, Size word_index, Uint64 mask);
+
+/* claim operation */
+Size atomic_bitvec_claim_first_clear(AtomicBitVector* abv);
+Size atomic_bitvec_claim_next_clear(AtomicBitVector* abv, Size from);
+
+/* whole vector operation */
+void atomic_bitvec_clear_all(AtomicBitVector* abv);
+Size atomic_bitvec_popcount(AtomicBitVector* abv);
+
+/* conversion */
+BitVector* atomic_bitvec_to_bitvec(AtomicBitVector* abv);
+
+#endif // ANVIE_UTILS_CONTAINERS_ATOMIC_BIT_VECTOR_H
@@ -0,0 +1,164 @@
+/**
+ * @file BTree.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Ordered map stored as a B+tree, with items kept sorted by key in
+ * leaves that are linked together for range iteration.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_BTREE_H
+#define ANVIE_UTILS_CONTAINERS_BTREE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Containers/Common.h>
+
+#ifndef BTREE_ORDER
+/**
+ * Maximum number of keys in a node, must be a multiple of 8. Keys of a node
+ * are kept in one array, so 64 keys fill 8 cache lines and a search within a
+ * node is a handful of SIMD compares for integer keys. Larger orders make
+ * trees shallower at cost of longer searches within a node and larger moves
+ * on insertion and deletion.
+ * */
+#define BTREE_ORDER 64
+#endif
+
+#if BTREE_ORDER < 8 || BTREE_ORDER % 8
+#   error "BTREE_ORDER must be a positive multiple of 8"
+#endif
+
+/**
+ * A key and it's data in a @c BTree. Like a @c DenseMapItem, key and data
+ * hold values themselves when they're at most 8 bytes, and pointers to
+ * copies otherwise.
+ * */
+typedef struct BTreeItem {
+    void* key;
+    void* data;
+} BTreeItem;
+
+/**
+ * How keys of a @c BTree are compared.
+ * */
+typedef enum BTreeKeyKind {
+    BTREE_KEY_GENERIC,  /**< With @c compare_key callback. */
+    BTREE_KEY_UNSIGNED, /**< As unsigned integers, without any callback. */
+    BTREE_KEY_SIGNED,   /**< As signed integers, without any callback. */
+} BTreeKeyKind;
+
+/**
+ * Position in a @c BTree, along with where iteration must stop.
+ * Iterators are invalidated by insertion and deletion.
+ * */
+typedef struct BTreeIterator {
+    struct BTreeLeaf* leaf;     /**< Leaf of next item, NULL when iteration is over. */
+    Size              pos;      /**< Position of next item in leaf. */
+    struct BTreeLeaf* end_leaf; /**< Leaf of item iteration stops at, NULL to iterate till last item. */
+    Size              end_pos;  /**< Position of item iteration stops at in @c end_leaf. */
+} BTreeIterator;
+
+/**
+ * Analogous to @c std::map in CPP, but stored as a B+tree.
+ *
+ * LAYOUT
+ * - all items live in leaves, sorted by key. Leaves are linked to their
+ *   neighbours, so ordered and range iteration never go back up the tree.
+ * - inner nodes only hold separator keys and children. Every node holds
+ *   upto @c BTREE_ORDER keys in a contiguous array, and all nodes except
+ *   root are at least half full.
+ *
+ * KEYS
+ * - integer keys (@c btree_create_integer) are stored as order preserving
+ *   64 bit integers, and searched within a node with SIMD compares when
+ *   enabled, or a branch free scan otherwise. No callback is ever called.
+ * - other keys (@c btree_create) are binary searched within a node with
+ *   @c compare_key. Separators in inner nodes are separate copies of keys
+ *   when keys have a copy constructor or are larger than 8 bytes.
+ *
+ * Keys and data are copied like @c Vector elements : values of upto 8 bytes
+ * are stored directly (or into storage given to copy constructor), larger
+ * values are copied to separate memory and stored as pointers.
+ * */
+typedef struct BTree {
+    struct BTreeNode*          root;              /**< Root node, NULL when tree is empty. */
+    struct BTreeLeaf*          first;             /**< Leaf with smallest keys. */
+    struct BTreeLeaf*          last;              /**< Leaf with largest keys. */
+    Size                       height;            /**< Number of levels, 1 when root is a leaf, 0 when empty. */
+    Size                       item_count;        /**< Number of items in tree. */
+    BTreeKeyKind               key_kind;          /**< How keys are compared. */
+    Size                       key_size;          /**< Size of key in bytes. */
+    CreateElementCopyCallback  create_key_copy;   /**< Copy constructor of key, can be NULL. */
+    DestroyElementCopyCallback destroy_key_copy;  /**< Copy destructor of key, can be NULL. */
+    CompareElementCallback     compare_key;       /**< Key comparator for generic keys. */
+    Size                       data_size;         /**< Size of data in bytes. */
+    CreateElementCopyCallback  create_data_copy;  /**< Copy constructor of data, can be NULL. */
+    DestroyElementCopyCallback destroy_data_copy; /**< Copy destructor of data, can be NULL. */
+} BTree;
+
+#define btree_count(tree) ((tree)->item_count)
+#define btree_height(tree) ((tree)->height)
+
+BTree* btree_create(
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy
+);
+BTree* btree_create_integer(
+    Size                       key_size,
+    Bool                       is_signed,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy
+);
+void       btree_destroy(BTree* tree, void* udata);
+void       btree_clear(BTree* tree, void* udata);
+
+BTreeItem* btree_insert(BTree* tree, void* key, void* data, void* udata);
+BTreeItem* btree_search(BTree* tree, void* key, void* udata);
+Bool       btree_delete(BTree* tree, void* key, void* udata);
+Bool       btree_build_from_sorted(BTree* tree, const void* keys, const void* values, Size count, void* udata);
+
+BTreeIterator btree_iter(BTree* tree);
+BTreeIterator btree_lower_bound(BTree* tree, void* key, void* udata);
+BTreeIterator btree_range(BTree* tree, void* low, void* high, void* udata);
+BTreeItem*    btree_iter_next(BTreeIterator* iter);
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/BTree.h>
+
+/*                                prefix   prefix    ktype   dtype */
+DEF_INTEGER_INTEGER_BTREE_INTERFACE(u32_u32, U32_U32_, Uint32, Uint32);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE(u32_u64, U32_U64_, Uint32, Uint64);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE(u64_u32, U64_U32_, Uint64, Uint32);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE(u64_u64, U64_U64_, Uint64, Uint64);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE(i32_u32, I32_U32_, Int32,  Uint32);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE(i64_u64, I64_U64_, Int64,  Uint64);
+
+/*                                                    prefix     prefix      ktype    kcreate           kdestroy           kcompare      dtype    dcreate           ddestroy */
+DEF_INTEGER_INTEGER_BTREE_INTERFACE_WITH_COPY_AND_DESTROY(zstr_u32,  ZStr_U32_,  ZString, zstr_create_copy, zstr_destroy_copy, compare_zstr, Uint32,  NULL,             NULL);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE_WITH_COPY_AND_DESTROY(zstr_u64,  ZStr_U64_,  ZString, zstr_create_copy, zstr_destroy_copy, compare_zstr, Uint64,  NULL,             NULL);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE_WITH_COPY_AND_DESTROY(u64_zstr,  U64_ZStr_,  Uint64,  NULL,             NULL,              compare_u64,  ZString, zstr_create_copy, zstr_destroy_copy);
+DEF_INTEGER_INTEGER_BTREE_INTERFACE_WITH_COPY_AND_DESTROY(zstr_zstr, ZStr_ZStr_, ZString, zstr_create_copy, zstr_destroy_copy, compare_zstr, ZString, zstr_create_copy, zstr_destroy_copy);
+
+#endif // ANVIE_UTILS_CONTAINERS_BTREE_H
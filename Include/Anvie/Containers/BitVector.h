@@ -29,20 +29,51 @@
 #define ANVIE_UTILS_CONTAINER_BIT_VECTOR_H
 
 #include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
 #include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/Image.h>
 #include <Anvie/Bit/Bit.h>
 
+/**
+ * Succinct rank directory over bits of a @c BitVector.
+ * Every superblock of @c BITVEC_RANK_SUPERBLOCK_BITS bits stores number of
+ * set bits before it, and every block of @c BITVEC_RANK_BLOCK_BITS bits
+ * stores number of set bits before it within it's superblock. This takes
+ * less than 5% extra memory and makes rank constant time.
+ * */
+typedef struct BitVectorRankIndex {
+    Size    length;         /**< Number of bits indexed. */
+    Size    total;          /**< Number of set bits in indexed bits. */
+    Size    block_count;    /**< Number of entries in @c blocks. */
+    Size    super_count;    /**< Number of entries in @c supers. */
+    Size*   supers;         /**< Set bits before each superblock. */
+    Uint16* blocks;         /**< Set bits before each block, relative to it's superblock. */
+    Bool    valid;          /**< Cleared whenever bits of @c BitVector change, index is rebuilt on next query. */
+} BitVectorRankIndex;
+
+#define BITVEC_RANK_BLOCK_BITS 512
+#define BITVEC_RANK_SUPERBLOCK_BITS 4096
+
 /**
  * BitVector stores multiple boolean values in a single byte.
  * Instead of using 1 byte to store boolean, you can now store
  * 8 boolean values in a single byte.
  * */
 typedef struct BitVector {
-    Size   length;              /**< Number of booleans used. */
-    Size   capacity;            /**< Total number of booleans that can be stored. */
-    Uint8* data;                /**< Array to store boolean values. */
+    Size       length;          /**< Number of booleans used. */
+    Size       capacity;        /**< Total number of booleans that can be stored. */
+    Uint8*     data;            /**< Array to store boolean values. */
+    Allocator* allocator;       /**< Allocator for all memory owned by @c BitVector, NULL for system allocator. */
+    BitVectorRankIndex* rank_index; /**< Optional rank directory, NULL until @c bitvec_build_rank_index is called. */
 } BitVector;
 
+/**
+ * Callback called for index of each set bit by @c bitvec_foreach_set.
+ * @param index Index of set bit.
+ * @param udata User data passed to foreach call.
+ * */
+typedef void (*BitVectorVisitorCallback)(Size index, void* udata);
+
 /**
  * Instead of comparing with NULL always, this will probably
  * look more neat and easy to read.
@@ -60,8 +91,12 @@ typedef struct BitVector {
 #define    bitvec_get_capacity_in_bytes(bv) ((bv) ? DIV8(bv->capacity) : 0)
 
 BitVector* bitvec_create();
+BitVector* bitvec_create_with_allocator(Allocator* allocator);
 void       bitvec_destroy(BitVector* bv);
 BitVector* bitvec_clone(BitVector* bv);
+Size       bitvec_write_to_buffer(BitVector* bv, void* buffer, Size capacity);
+Bool       bitvec_serialize_to_fd(BitVector* bv, int fd);
+BitVector* bitvec_from_image(Image* image);
 void       bitvec_set_equal(BitVector* dstbv, BitVector* srcbv);
 
 /* resize/reserve operation */
@@ -81,6 +116,9 @@ void       bitvec_clear_range(BitVector* bv, Size range_begin, Size range_size);
 /* get operation */
 Bool       bitvec_peek(BitVector* bv, Size index);
 
+/** bv must be valid and index in range, nothing is checked */
+#define    bitvec_peek_unchecked(bv, index) ((Bool)GET8_BIT((bv)->data[DIV8(index)], MOD8(index)))
+
 /* logical operations */
 /* binary operations */
 BitVector* bitvec_xor(BitVector* bv1, BitVector* bv2);
@@ -94,26 +132,57 @@ BitVector* bitvec_shr(BitVector* bv, Size index);
 /* unary operation */
 BitVector* bitvec_not(BitVector* bv);
 
-/* TODO: Will implement these later, writing tests take too much time,
- * I also need to improve and implement tests for other containers.
- * Will implemenent these when I feel the need for these or when I want to.
- * For, now it's just a reminder.
- * */
-/* binary inline operation */
-/* void       bitvec_xor_inline(BitVector* bv1, BitVector* bv2); */
-/* void       bitvec_and_inline(BitVector* bv1, BitVector* bv2); */
-/* void       bitvec_or_inline(BitVector* bv1, BitVector* bv2); */
-/* void       bitvec_xnor_inline(BitVector* bv1, BitVector* bv2); */
-/* void       bitvec_nand_inline(BitVector* bv1, BitVector* bv2); */
-/* void       bitvec_nor_inline(BitVector* bv1, BitVector* bv2); */
-/* void       bitvec_shl_inline(BitVector* bv, Size index); */
-/* void       bitvec_shr_inline(BitVector* bv, Size index); */
-/* unary operation */
-/* void       bitvec_not_inline(BitVector* bv); */
+BitVector* bitvec_andnot(BitVector* bv1, BitVector* bv2);
+
+/* destination binary operation, dst = bv1 OP bv2 */
+void       bitvec_xor_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_and_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_or_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_xnor_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_nand_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_nor_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_andnot_into(BitVector* dst, BitVector* bv1, BitVector* bv2);
+void       bitvec_not_into(BitVector* dst, BitVector* bv);
+
+/* in place binary operation, dst = dst OP src */
+void       bitvec_xor_assign(BitVector* dst, BitVector* src);
+void       bitvec_and_assign(BitVector* dst, BitVector* src);
+void       bitvec_or_assign(BitVector* dst, BitVector* src);
+void       bitvec_xnor_assign(BitVector* dst, BitVector* src);
+void       bitvec_nand_assign(BitVector* dst, BitVector* src);
+void       bitvec_nor_assign(BitVector* dst, BitVector* src);
+void       bitvec_andnot_assign(BitVector* dst, BitVector* src);
+void       bitvec_not_assign(BitVector* bv);
+
+/* multi-way operation, dst = bvs[0] | bvs[1] | ... | bvs[n-1] */
+void       bitvec_or_many(BitVector* dst, BitVector** bvs, Size n);
+
+/* destination and in place shift operation */
+void       bitvec_shl_into(BitVector* dst, BitVector* bv, Size index);
+void       bitvec_shr_into(BitVector* dst, BitVector* bv, Size index);
+void       bitvec_shl_assign(BitVector* bv, Size index);
+void       bitvec_shr_assign(BitVector* bv, Size index);
 
 /* comparision operation */
 Bool       bitvec_cmpeq(BitVector* bv1, BitVector* bv2);
 
+/* counting operation */
+Size       bitvec_popcount(BitVector* bv);
+Size       bitvec_count_range(BitVector* bv, Size range_begin, Size range_size);
+
+/* search operation */
+Size       bitvec_find_first_set(BitVector* bv);
+Size       bitvec_find_first_clear(BitVector* bv);
+Size       bitvec_find_next_set(BitVector* bv, Size from);
+Size       bitvec_find_next_clear(BitVector* bv, Size from);
+void       bitvec_foreach_set(BitVector* bv, BitVectorVisitorCallback visitor, void* udata);
+
+/* rank/select operation */
+void       bitvec_build_rank_index(BitVector* bv);
+void       bitvec_drop_rank_index(BitVector* bv);
+Size       bitvec_rank(BitVector* bv, Size index);
+Size       bitvec_select(BitVector* bv, Size k);
+
 /* misc operations */
 /* TODO: BitVector* bitvec_reverse(BitVector* bv); */
 
@@ -0,0 +1,88 @@
+/**
+ * @file BloomFilter.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Probabilistic set membership on top of @c BitVector.
+ * A Bloom filter answers "definitely not present" or "maybe present" using
+ * a few bits per key. Put one in front of an expensive lookup that mostly
+ * misses, and most misses never reach the lookup.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_BLOOM_FILTER_H
+#define ANVIE_UTILS_CONTAINERS_BLOOM_FILTER_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/BitVector.h>
+
+/** Number of bits in a block of a blocked filter, one cache line. */
+#define BLOOM_BLOCK_BITS 512
+
+/** Maximum number of probes per key. */
+#define BLOOM_MAX_HASH_COUNT 16
+
+/**
+ * Bloom filter over keys hashed with a @c HashCallback.
+ *
+ * Each key is hashed once with @c hash. The hash is mixed and split into
+ * @c hash_count bit positions using double hashing, so a weak or identity
+ * hash still spreads well over the filter.
+ *
+ * BLOCKED FILTERS
+ * - a blocked filter first picks one @c BLOOM_BLOCK_BITS bit block, and
+ *   places all probes of a key inside that block. A lookup then touches
+ *   exactly one cache line, and is checked a register at a time.
+ * - this costs a slightly higher false positive rate for same memory.
+ *
+ * ALLOCATION SEMANTICS
+ * - bits are stored in a @c BitVector allocated using @c allocator.
+ * - a @c NULL @c allocator means system allocator is used.
+ * */
+typedef struct BloomFilter {
+    BitVector*   bits; /**< Filter bits, length is @c bit_count. */
+    Size         bit_count; /**< Number of bits, a multiple of @c BLOOM_BLOCK_BITS when blocked. */
+    Size         block_count; /**< Number of blocks in blocked filter, 0 otherwise. */
+    Uint32       hash_count; /**< Number of bits set per key. */
+    Bool         is_blocked; /**< True when all probes of a key lie in one block. */
+    HashCallback hash; /**< Hash function applied to keys. */
+    Size         item_count; /**< Number of insertions so far, used for false positive estimate. */
+    Allocator*   allocator; /**< Allocator for all memory owned by filter, NULL for system allocator. */
+} BloomFilter;
+
+/* sizing helpers */
+Size    bloom_optimal_bit_count(Size expected_count, Float64 false_positive_rate);
+Uint32  bloom_optimal_hash_count(Size bit_count, Size expected_count);
+
+BloomFilter* bloom_create(HashCallback hash, Size bit_count, Uint32 hash_count, Bool is_blocked);
+BloomFilter* bloom_create_with_allocator(HashCallback hash, Size bit_count, Uint32 hash_count, Bool is_blocked, Allocator* allocator);
+BloomFilter* bloom_create_for(HashCallback hash, Size expected_count, Float64 false_positive_rate, Bool is_blocked, Allocator* allocator);
+void         bloom_destroy(BloomFilter* bf);
+void         bloom_clear(BloomFilter* bf);
+
+/* insert/query operation */
+void bloom_insert(BloomFilter* bf, void* key, void* udata);
+Bool bloom_contains(BloomFilter* bf, void* key, void* udata);
+void bloom_insert_hash(BloomFilter* bf, Size hash);
+Bool bloom_contains_hash(BloomFilter* bf, Size hash);
+
+/* whole filter operation */
+void    bloom_merge(BloomFilter* dst, BloomFilter* src);
+Float64 bloom_estimated_false_positive_rate(BloomFilter* bf);
+
+#endif // ANVIE_UTILS_CONTAINERS_BLOOM_FILTER_H
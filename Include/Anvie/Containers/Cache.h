@@ -0,0 +1,196 @@
+/**
+ * @file Cache.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A bounded key-value cache with LRU, CLOCK or S3-FIFO eviction.
+ * Entries live in a fixed array allocated once, a @c DenseMap maps each
+ * key to it's entry index, and all recency information is kept in a flat
+ * array indexed by entry, so hits and evictions never allocate.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_CACHE_H
+#define ANVIE_UTILS_CONTAINERS_CACHE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Containers/ConcurrentMap.h>
+#include <pthread.h>
+
+/** Eviction policy of a @c Cache. */
+typedef enum CachePolicy {
+    CACHE_POLICY_LRU,    /**< Evict least recently used entry. Every hit moves entry to front of a list. */
+    CACHE_POLICY_CLOCK,  /**< Second chance : a hand sweeps over entries, clearing reference bits, evicts first unreferenced one. */
+    CACHE_POLICY_S3FIFO, /**< Small and main FIFO queues with a ghost queue, keeps one-hit wonders out of main queue. */
+} CachePolicy;
+
+/**
+ * Callback called for each entry evicted to make room for an insertion.
+ * @param key Key of evicted entry, in same form as passed to cache functions.
+ * @param data Pointer to data of evicted entry, valid only during the call.
+ * @param udata User data passed to insert call.
+ * */
+typedef void (*CacheEvictCallback)(void* key, void* data, void* udata);
+
+/** Counters of a cache, updated on every operation. */
+typedef struct CacheStats {
+    Size hits;       /**< Searches that found their key. */
+    Size misses;     /**< Searches that did not find their key. */
+    Size insertions; /**< New keys inserted. */
+    Size evictions;  /**< Entries evicted to make room. */
+} CacheStats;
+
+/**
+ * Recency information of one entry, kept in a flat array indexed by entry.
+ * Free entries are chained through @c next.
+ * */
+typedef struct CacheEntry {
+    Uint32 prev;   /**< Previous entry in queue, towards head. */
+    Uint32 next;   /**< Next entry in queue, towards tail, or next free entry. */
+    Uint8  queue;  /**< Queue holding entry, or none when free. */
+    Uint8  freq;   /**< Reference bit for CLOCK, access count capped at 3 for S3-FIFO. */
+    Size   hash;   /**< Hash of key, so eviction never hashes again. */
+    Size   charge; /**< Cost of entry counted against @c max_charge. */
+} CacheEntry;
+
+/** A doubly linked queue over entry indices, head is most recent. */
+typedef struct CacheQueue {
+    Uint32 head;   /**< First entry, or @c CACHE_NONE when empty. */
+    Uint32 tail;   /**< Last entry, next to be considered for eviction. */
+    Size   count;  /**< Number of entries in queue. */
+    Size   charge; /**< Sum of charges of entries in queue. */
+} CacheQueue;
+
+/** Entry index meaning no entry, also queue id of free entries. */
+#define CACHE_NONE ((Uint32)-1)
+
+/**
+ * Bounded map from keys to fixed size data, evicting entries when full.
+ *
+ * CAPACITY
+ * - at most @c max_entries entries are kept. Storage for all of them is
+ *   allocated on creation.
+ * - each entry also has a charge given on insert, eg: size in bytes of
+ *   what it's data refers to. When @c max_charge is not 0, sum of charges is
+ *   kept at most @c max_charge as well.
+ *
+ * KEYS AND DATA
+ * - keys and data are plain-old-data copied into the cache. Keys are passed
+ *   as to a @c DenseMap without copy callbacks : by value when @c key_size
+ *   is at most 8, pointer to key otherwise.
+ * - data is @c data_size bytes, passed as pointer to those bytes.
+ * - pointers to data returned by @c cache_get are valid until next insert
+ *   or delete.
+ * */
+typedef struct Cache {
+    DenseMap*    index;       /**< Map from key to entry index, with keys pointing into @c slots. */
+    Uint8*       slots;       /**< Key and data of each entry, @c slot_size bytes each. */
+    CacheEntry*  entries;     /**< Recency information of each entry. */
+    CacheQueue   queues[2];   /**< Main queue, and small queue of S3-FIFO. */
+    Uint64*      ghosts;      /**< S3-FIFO ghost table of hashes of recently evicted keys, NULL for other policies. */
+    Size         ghost_mask;  /**< Number of ghost table entries minus one. */
+    Uint32       free_head;   /**< First free entry. */
+    Uint32       hand;        /**< Position of CLOCK hand. */
+    CachePolicy  policy;      /**< Eviction policy. */
+    HashCallback hash;        /**< Hash function for keys. */
+    Size         key_size;    /**< Size of key in bytes. */
+    Size         data_size;   /**< Size of data in bytes. */
+    Size         data_offset; /**< Offset of data in a slot. */
+    Size         slot_size;   /**< Size of a slot. */
+    Size         max_entries; /**< Maximum number of entries. */
+    Size         max_charge;  /**< Maximum sum of charges, 0 for no limit. */
+    Size         item_count;  /**< Number of entries in cache. */
+    Size         charge;      /**< Sum of charges of entries in cache. */
+    CacheStats   stats;       /**< Hit, miss, insertion and eviction counters. */
+    Allocator*   allocator;   /**< Allocator for all memory owned by cache. NULL means system allocator. */
+} Cache;
+
+Cache* cache_create(
+    HashCallback           hash,
+    Size                   key_size,
+    CompareElementCallback compare_key,
+    Size                   data_size,
+    Size                   max_entries,
+    Size                   max_charge,
+    CachePolicy            policy,
+    Allocator*             allocator
+);
+void cache_destroy(Cache* cache);
+void cache_clear(Cache* cache, void* udata);
+
+Bool  cache_insert(Cache* cache, void* key, const void* data, Size charge, CacheEvictCallback on_evict, void* udata);
+Bool  cache_insert_with_hash(Cache* cache, void* key, const void* data, Size charge, Size hash, CacheEvictCallback on_evict, void* udata);
+void* cache_get(Cache* cache, void* key, void* udata);
+void* cache_get_with_hash(Cache* cache, void* key, Size hash, void* udata);
+void* cache_peek(Cache* cache, void* key, void* udata);
+Bool  cache_delete(Cache* cache, void* key, void* udata);
+
+#define cache_item_count(cache) ((cache)->item_count)
+#define cache_total_charge(cache) ((cache)->charge)
+#define cache_reset_stats(cache) ((void)((cache)->stats = (CacheStats){0}))
+
+/**
+ * One shard of a @c ShardedCache. @c cache is accessed only with @c lock held.
+ * */
+typedef struct ShardedCacheShard {
+    pthread_mutex_t lock;  /**< Held for every operation, since even hits update recency. */
+    Cache*          cache; /**< Entries whose hash selects this shard. */
+} __attribute__((aligned(CONCURRENT_MAP_CACHE_LINE_SIZE))) ShardedCacheShard;
+
+/**
+ * A @c Cache safe to use from any number of threads, split into independent
+ * shards the same way as a @c ConcurrentMap : top bits of mixed hash of a
+ * key select it's shard, and each shard has it's own lock and it's own share
+ * of capacity. Eviction is per shard, so it is only approximately global.
+ *
+ * Searches copy data into a buffer of caller while shard is locked, and
+ * eviction callbacks are called with shard locked, so they must not use the
+ * cache. @c allocator must be thread safe.
+ * */
+typedef struct ShardedCache {
+    ShardedCacheShard* shards;            /**< Array of @c shard_count shards. */
+    Size               shard_count;       /**< Number of shards, a power of two. */
+    Uint32             shard_shift;       /**< Right shift of mixed hash that gives shard index. */
+    HashCallback       hash;              /**< Hash function, same as hash of each shard. */
+    Size               data_size;         /**< Size of data in bytes. */
+    void*              shard_memory;      /**< Unaligned allocation holding @c shards. */
+    Size               shard_memory_size; /**< Size of @c shard_memory in bytes. */
+    Allocator*         allocator;         /**< Allocator for all memory owned by cache, NULL for system allocator. */
+} ShardedCache;
+
+ShardedCache* sharded_cache_create(
+    HashCallback           hash,
+    Size                   key_size,
+    CompareElementCallback compare_key,
+    Size                   data_size,
+    Size                   max_entries,
+    Size                   max_charge,
+    CachePolicy            policy,
+    Size                   shard_count,
+    Allocator*             allocator
+);
+void sharded_cache_destroy(ShardedCache* cache);
+
+Bool sharded_cache_insert(ShardedCache* cache, void* key, const void* data, Size charge, CacheEvictCallback on_evict, void* udata);
+Bool sharded_cache_get(ShardedCache* cache, void* key, void* data, void* udata);
+Bool sharded_cache_delete(ShardedCache* cache, void* key, void* udata);
+void sharded_cache_stats(ShardedCache* cache, CacheStats* stats);
+Size sharded_cache_item_count(ShardedCache* cache);
+
+#endif // ANVIE_UTILS_CONTAINERS_CACHE_H
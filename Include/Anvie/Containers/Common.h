@@ -24,6 +24,7 @@
 #define ANVIE_UTILS_COMMON_H
 
 #include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
 
 /**
  * Will create a copy of data structure given in src to dst.
@@ -74,6 +75,24 @@ typedef void (*PrintElementCallback)(void* element, Size pos, void* udata);
  * */
 typedef Bool (*FilterElementCallback)(void* element, void* udata);
 
+/**
+ * To transform elements of a container into elements of another type.
+ * @param dst Where transformed element is written. A @c out_type* pointer.
+ * @param element Element passed to callback from container.
+ * A @c type* pointer or @c type value.
+ * @param udata User data passed to map function.
+ * */
+typedef void (*MapElementCallback)(void* dst, void* element, void* udata);
+
+/**
+ * To fold elements of a container into an accumulator, one at a time.
+ * @param acc Accumulator, updated in place.
+ * @param element Element passed to callback from container.
+ * A @c type* pointer or @c type value.
+ * @param udata User data passed to reduce function.
+ * */
+typedef void (*ReduceElementCallback)(void* acc, void* element, void* udata);
+
 /**
  * Compare two provided elements.
  * @param p1 A @c type* pointer or @c type value.
@@ -114,6 +133,25 @@ void print_zstr(ZString x, Size idx, void* udata);
 void zstr_create_copy(ZString* to, ZString data, void* udata);
 void zstr_destroy_copy(ZString* data, void* udata);
 
+/* string copies allocated from an Allocator* passed in as udata */
+void zstr_create_copy_with_allocator(ZString* to, ZString data, Allocator* allocator);
+void zstr_destroy_copy_with_allocator(ZString* data, Allocator* allocator);
+
+/* string copies packed into a StringArena* passed in as udata, see StringArena.h */
+struct StringArena;
+void zstr_create_copy_in_arena(ZString* to, ZString data, struct StringArena* arena);
+void zstr_destroy_copy_in_arena(ZString* data, struct StringArena* arena);
+
+/* seed used by default hash functions below, set it before using any map */
+void   hash_set_default_seed(Uint64 seed);
+Uint64 hash_get_default_seed();
+
+/* building blocks for custom hash functions */
+Uint64 hash_mix64(Uint64 val);
+Uint64 hash_u64_seeded(Uint64 val, Uint64 seed);
+Uint64 hash_bytes(const void* data, Size length);
+Uint64 hash_bytes_seeded(const void* data, Size length, Uint64 seed);
+
 /* hash functions always take 64 bit values and return 64 bit values */
 Uint64 hash_u8(Uint64 val, void* udata);
 Uint64 hash_u16(Uint64 val, void* udata);
@@ -127,4 +165,41 @@ Int32 compare_u32(Uint64 v1, Uint64 v2, void* udata);
 Int32 compare_u64(Uint64 v1, Uint64 v2, void* udata);
 Int32 compare_zstr(ZString v1, ZString v2, void* udata);
 
+/* byte comparisons a whole register at a time, mem_compare orders bytes as unsigned like memcmp */
+Bool  mem_equal(const void* a, const void* b, Size length);
+Int32 mem_compare(const void* a, const void* b, Size length);
+
+/** Number of buckets in histograms of @c HashMapStats, last one also counts all longer lengths. */
+#define HASH_MAP_STATS_HISTOGRAM_SIZE 32
+
+/**
+ * Health of a hash map, filled by @c dense_map_stats and @c sparse_map_stats.
+ * Long probes or chains for a low load factor mean a bad hash function, and
+ * high load with long probes means @c max_load_factor is tuned too high.
+ *
+ * Lengths count from 1 : a key found in first group it can be in (DenseMap),
+ * or at head of it's chain (SparseMap), has probe length 1.
+ * */
+typedef struct HashMapStats {
+    Size    item_count;      /**< Number of items. */
+    Size    capacity;        /**< Number of slots or buckets, including those of table being migrated from. */
+    Float64 load_factor;     /**< Items per slot or bucket of current table. */
+    Size    probe_histogram[HASH_MAP_STATS_HISTOGRAM_SIZE]; /**< Entry i counts keys with probe length i + 1. */
+    Size    max_probe;       /**< Longest probe length. */
+    Float64 mean_probe;      /**< Average probe length of a successful search. */
+    Size    p99_probe;       /**< 99 percent of keys have at most this probe length. */
+    Size    chain_histogram[HASH_MAP_STATS_HISTOGRAM_SIZE]; /**< Entry i counts non empty buckets with i + 1 items, SparseMap only. */
+    Size    max_chain;       /**< Longest chain, SparseMap only. */
+    Float64 mean_chain;      /**< Average length of a non empty chain, SparseMap only. */
+    Float64 tag_collision_rate; /**< Other items passed with same tag (DenseMap metadata) or same stored hash (SparseMap) per successful search. */
+    Size    tombstone_count; /**< Deleted slots still continuing probe sequences, DenseMap only. */
+    Size    resize_count;    /**< Number of times table was rebuilt, since map was created. */
+    Size    bytes_used;      /**< Bytes holding items, including separately allocated key and data copies. */
+    Size    bytes_allocated; /**< Bytes allocated by map for items, buckets and metadata. */
+} HashMapStats;
+
+void hash_map_stats_add_probe(HashMapStats* stats, Size length);
+void hash_map_stats_add_chain(HashMapStats* stats, Size length);
+void hash_map_stats_finish(HashMapStats* stats);
+
 #endif // ANVIE_UTILS_COMMON_H
@@ -0,0 +1,112 @@
+/**
+ * @file ConcurrentMap.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A hash map that can be used from many threads at once.
+ * Keys are spread over a fixed number of independent @c DenseMap shards,
+ * each behind it's own reader-writer lock, so threads working on
+ * different shards never wait for each other.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_CONCURRENT_MAP_H
+#define ANVIE_UTILS_CONTAINERS_CONCURRENT_MAP_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <pthread.h>
+
+#ifndef CONCURRENT_MAP_DEFAULT_SHARD_COUNT
+/** Number of shards used when 0 is passed as shard count. */
+#define CONCURRENT_MAP_DEFAULT_SHARD_COUNT 64
+#endif
+
+#ifndef CONCURRENT_MAP_CACHE_LINE_SIZE
+/** Each shard is aligned to and padded to this, so that locks of two shards never share a cache line. */
+#define CONCURRENT_MAP_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * One shard of a @c ConcurrentMap. @c map is accessed only with @c lock held.
+ * */
+typedef struct ConcurrentMapShard {
+    pthread_rwlock_t lock; /**< Read locked for searches, write locked for modifications. */
+    DenseMap*        map;  /**< Items whose hash selects this shard. */
+} __attribute__((aligned(CONCURRENT_MAP_CACHE_LINE_SIZE))) ConcurrentMapShard;
+
+/**
+ * Callback to compute data for a key absent from map.
+ * @param key Key, in same form as passed to map functions.
+ * @param data Where to write @c data_size bytes of data.
+ * @param udata User data passed to @c concurrent_map_compute_if_absent.
+ * */
+typedef void (*ConcurrentMapComputeCallback)(void* key, void* data, void* udata);
+
+/**
+ * Hash map with unique keys, safe to use from any number of threads.
+ *
+ * Top bits of mixed hash of a key select it's shard, and each shard is a
+ * @c DenseMap storing keys and data inline (see @c dense_map_create_inline).
+ * Shards grow on their own, so a resize blocks only one shard.
+ *
+ * KEYS AND DATA
+ * - keys are passed exactly as they are to a @c DenseMap : by value when
+ *   @c key_size is at most 8 and no key copy callbacks are given, as pointer
+ *   otherwise. Key copy callbacks are supported, map owns copies of keys.
+ * - data is plain-old-data of @c data_size bytes, always passed as pointer to
+ *   those bytes. Searches copy data into a buffer of caller while shard is
+ *   locked, so no pointer into map ever escapes a lock.
+ *
+ * CONCURRENCY SEMANTICS
+ * - all functions except create and destroy can be called from any thread.
+ * - each operation is atomic with respect to others on same key.
+ * - callbacks (hash, compare, key copy, compute) can be called from all
+ *   threads at once, and must not use the map they are called for.
+ * - @c allocator must be thread safe, system allocator is.
+ * */
+typedef struct ConcurrentMap {
+    ConcurrentMapShard* shards;       /**< Array of @c shard_count shards. */
+    Size                shard_count;  /**< Number of shards, a power of two. */
+    Uint32              shard_shift;  /**< Right shift of mixed hash that gives shard index. */
+    HashCallback        hash;         /**< Hash function, same as hash of each shard. */
+    Size                data_size;    /**< Size of data in bytes. */
+    void*               shard_memory; /**< Unaligned allocation holding @c shards. */
+    Size                shard_memory_size; /**< Size of @c shard_memory in bytes. */
+    Allocator*          allocator;    /**< Allocator for all memory owned by map, NULL for system allocator. */
+} ConcurrentMap;
+
+ConcurrentMap* concurrent_map_create(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    Size                       shard_count,
+    Allocator*                 allocator
+);
+void concurrent_map_destroy(ConcurrentMap* map, void* udata);
+
+Bool concurrent_map_insert(ConcurrentMap* map, void* key, const void* data, void* udata);
+Bool concurrent_map_search(ConcurrentMap* map, void* key, void* data, void* udata);
+Bool concurrent_map_delete(ConcurrentMap* map, void* key, void* udata);
+Bool concurrent_map_compute_if_absent(ConcurrentMap* map, void* key, ConcurrentMapComputeCallback compute, void* data, void* udata);
+Size concurrent_map_item_count(ConcurrentMap* map);
+
+#endif // ANVIE_UTILS_CONTAINERS_CONCURRENT_MAP_H
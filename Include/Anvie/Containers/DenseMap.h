@@ -26,6 +26,39 @@
 
 #include <Anvie/Containers/Vector.h>
 #include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/BloomFilter.h>
+#include <string.h>
+
+#ifndef DENSE_MAP_HASH_BITS
+/**
+ * Number of bits of hash stored for each slot, 64 or 32. With 32 bits, stored
+ * hashes take half the memory, but probing then uses only 25 bits of hash to
+ * pick a group, which spreads items well until a few hundred million slots.
+ * */
+#define DENSE_MAP_HASH_BITS 64
+#endif
+
+#if DENSE_MAP_HASH_BITS == 32
+typedef Uint32 DenseMapHash;
+#elif DENSE_MAP_HASH_BITS == 64
+typedef Uint64 DenseMapHash;
+#else
+#   error "DENSE_MAP_HASH_BITS must be 32 or 64"
+#endif
+
+/**
+ * Flag for @c dense_map_build_from_arrays : keys are distinct from each other
+ * and from keys already in map, so no key needs to be compared on insert.
+ * */
+#define DENSE_MAP_BUILD_UNIQUE_KEYS (1u << 0)
+
+/**
+ * Flags for @c dense_map_write_to_buffer and @c dense_map_serialize_to_fd :
+ * keys (or data) are @c ZString copies, whose strings are written into image
+ * along with them.
+ * */
+#define DENSE_MAP_IMAGE_ZSTR_KEYS (1u << 0)
+#define DENSE_MAP_IMAGE_ZSTR_DATA (1u << 1)
 
 /**
  * Represents a single item in the hash table.
@@ -49,6 +82,21 @@ void create_dmi_copy(DenseMapItem* dst, DenseMapItem* src,  Dmi_CallbackData* cl
 void destroy_dmi_copy(DenseMapItem* copy, Dmi_CallbackData* clbk_data);
 DEF_STRUCT_VECTOR_INTERFACE(dmi, Dmi, DenseMapItem, create_dmi_copy, destroy_dmi_copy);
 
+/**
+ * Position of an iteration over a @c DenseMap. Zero initialize to start
+ * from first item, eg: `DenseMapIterator iter = {0};`
+ * */
+typedef struct DenseMapIterator {
+    Size slot; /**< Slot from where search for next item starts. */
+} DenseMapIterator;
+
+/**
+ * Callback called for each item by @c dense_map_foreach and @c dense_map_drain.
+ * @param item Item in map, in same form as returned by @c dense_map_search.
+ * @param udata User data passed to foreach call.
+ * */
+typedef void (*DenseMapVisitorCallback)(DenseMapItem* item, void* udata);
+
 /**
  * Analogous to @c std::unordered_map or @c std::unordered_multimap in CPP.
  *
@@ -73,10 +121,21 @@ DEF_STRUCT_VECTOR_INTERFACE(dmi, Dmi, DenseMapItem, create_dmi_copy, destroy_dmi
  *   pointer.
  *   In case of hash map of struct key or struct value pairs, it's strictly required
  *   to provide copy constructors and destructors!
- * - The implementation uses Robin Hood collision resolution strategy to solve collisions.
+ * - Keys and data of at most 8 bytes are passed by value, like elements of a @c Vector.
+ *   Their copy constructor is given address of key or data field of the item itself,
+ *   so a copied @c ZString key is stored right in the item and passed to `hash` and
+ *   `compare_key` the same way a user given key is.
+ * - The implementation uses open addressing in the style of SwissTable. Slots are split into
+ *   groups as wide as a SIMD register (or a word without SIMD), and each slot has a metadata
+ *   byte holding an occupancy bit and 7 bits of hash. Metadata of a whole group is compared
+ *   against a key at once, so keys are compared only for slots whose 7 hash bits match.
  * - Due to the above point, the whole hash map is like a flat array and no use of separate
  *   chaining is done. This is what gives the name @c DenseMap, because all items are in
  *   a sparse vector of key-value pairs and not sparse vector of pointer to the pairs.
+ * - Mixed hash of each item is stored next to metadata, so growing the map never calls
+ *   `hash` again, and a slot whose stored hash differs is rejected without calling
+ *   `compare_key`. Callers that already have hash of a key can skip hashing entirely with
+ *   @c dense_map_insert_with_hash and @c dense_map_search_with_hash.
  *
  * The implementation provides two use cases :
  * - Not multimap : There will exist items with each having a unique key. The hash of the
@@ -88,6 +147,9 @@ DEF_STRUCT_VECTOR_INTERFACE(dmi, Dmi, DenseMapItem, create_dmi_copy, destroy_dmi
  *
  * The above feature is dependent on the `is_multimap` member of @c DenseMap object. This can
  * be changed anytime but is also required as an argument to the constructor of @c DenseMap.
+ *
+ * A map created with @c dense_map_create_inline stores key and data bytes directly in
+ * slots instead of @c DenseMapItem pointers, see @c dense_map_create_inline.
  * */
 typedef struct DenseMap {
     HashCallback               hash; /**< Hash function */
@@ -100,10 +162,23 @@ typedef struct DenseMap {
     Size                       key_size; /**< Size of key in bytes. */
     Bool                       is_multimap; /**< True when contains multiple items with same key. False otherwise. */
     Float32                    max_load_factor; /**< Maximum load factor tolerance before we resize the hash table. */
+    Float32                    min_load_factor; /**< Load below which a deletion shrinks the hash table, 0 to never shrink. */
     Size                       item_count; /**< Total number of slots filled in the hash table. */
-    U8_Vector*                 probe_len; /**< Vector<Uint8> to store probing length for each corresponding item in the map. */
+    Size                       tombstone_count; /**< Number of slots emptied by delete that still continue probe sequences. */
     U8_Vector*                 metadata; /**< Vector<Uint8> to store metadata about each corresponding element in map. */
-    Dmi_Vector*                map; /**< Vector<DenseMapItem> A vector to store all elements in the map. */
+    DenseMapHash*              hashes; /**< Mixed hash of each slot, valid only where metadata is occupied. */
+    Dmi_Vector*                map; /**< Vector<DenseMapItem> A vector to store all elements in the map, or slot bytes when inline. */
+    Size                       slot_size; /**< Bytes per inline slot holding key and data, 0 when slots are @c DenseMapItem. */
+    Size                       data_offset; /**< Offset of data in an inline slot. */
+    Allocator*                 allocator; /**< Allocator for slot vectors and key/data copies. NULL means system allocator. */
+    BloomFilter*               filter; /**< Optional filter of inserted keys checked before probing, NULL when disabled. */
+    Size                       rehash_budget; /**< Old slots migrated per operation by incremental rehash, 0 to rehash all at once. */
+    U8_Vector*                 old_metadata; /**< Metadata of table being migrated from, NULL when no migration is in progress. */
+    DenseMapHash*              old_hashes; /**< Hashes of table being migrated from. */
+    Dmi_Vector*                old_map; /**< Slots of table being migrated from, NULL when no migration is in progress. */
+    Size                       old_tombstone_count; /**< Number of tombstones in table being migrated from. */
+    Size                       migrate_pos; /**< Slots of old table before this one have been migrated. */
+    Size                       resize_count; /**< Number of times table was rebuilt, reported by @c dense_map_stats. */
 } DenseMap;
 
 DenseMap* dense_map_create(
@@ -118,13 +193,88 @@ DenseMap* dense_map_create(
     Bool                       is_multimap,
     Float32                    max_load_factor
 );
+DenseMap* dense_map_create_with_allocator(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy,
+    Bool                       is_multimap,
+    Float32                    max_load_factor,
+    Allocator*                 allocator
+);
+DenseMap* dense_map_create_inline(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy,
+    Size                       data_offset,
+    Size                       slot_size,
+    Bool                       is_multimap,
+    Float32                    max_load_factor,
+    Allocator*                 allocator
+);
 void          dense_map_destroy(DenseMap* map, void* udata);
+DenseMap*     dense_map_clone(DenseMap* map, void* udata);
+Size          dense_map_write_to_buffer(DenseMap* map, Uint32 flags, void* buffer, Size capacity);
+Bool          dense_map_serialize_to_fd(DenseMap* map, Uint32 flags, int fd);
+DenseMap*     dense_map_from_image(Image* image, HashCallback hash, CompareElementCallback compare_key);
 void          dense_map_resize(DenseMap* map, Size size, void* udata);
+void          dense_map_reserve(DenseMap* map, Size expected_count, void* udata);
+void          dense_map_shrink_to_fit(DenseMap* map, void* udata);
+void          dense_map_set_shrink_watermark(DenseMap* map, Float32 min_load_factor);
 DenseMapItem* dense_map_insert(DenseMap* map, void* key, void* value, void* udata);
 DenseMapItem* dense_map_search(DenseMap* map, void* key, void* udata);
+DenseMapItem* dense_map_insert_with_hash(DenseMap* map, void* key, void* value, Size hash, void* udata);
+DenseMapItem* dense_map_search_with_hash(DenseMap* map, void* key, Size hash, void* udata);
+Size          dense_map_search_batch(DenseMap* map, void** keys, Size n, DenseMapItem** out, void* udata);
+Size          dense_map_insert_batch(DenseMap* map, void** keys, void** values, Size n, DenseMapItem** out, void* udata);
+Size          dense_map_build_from_arrays(DenseMap* map, void** keys, void** values, Size n, Uint32 flags, void* udata);
 void          dense_map_delete(DenseMap* map, void* key, void* udata);
+void          dense_map_enable_filter(DenseMap* map, Size expected_count, Float64 false_positive_rate, void* udata);
+void          dense_map_disable_filter(DenseMap* map);
+
+DenseMapItem* dense_map_iter_next(DenseMap* map, DenseMapIterator* iter);
+void          dense_map_foreach(DenseMap* map, DenseMapVisitorCallback visitor, void* udata);
+void          dense_map_clear(DenseMap* map, void* udata);
+void          dense_map_drain(DenseMap* map, DenseMapVisitorCallback visitor, void* udata);
+
+void          dense_map_enable_incremental_rehash(DenseMap* map, Size budget);
+void          dense_map_disable_incremental_rehash(DenseMap* map, void* udata);
+Bool          dense_map_rehash_step(DenseMap* map, Size budget, void* udata);
+
+void          dense_map_stats(DenseMap* map, HashMapStats* stats);
+
+/**
+ * Convert pointer to a key or data value into form taken by @c dense_map_insert
+ * and friends when map has no copy callbacks for it : the value itself when it's
+ * at most 8 bytes, otherwise the pointer unchanged.
+ * @param value Pointer to value.
+ * @param size Size of value in bytes.
+ * */
+static FORCE_INLINE void* dense_map_pack(const void* value, Size size) {
+    Uint64 packed = 0;
+    if(size > sizeof(packed)) {
+        return (void*)value;
+    }
+    /* bounded again, since GCC warns about copy of a large constant size even in a branch never taken */
+    memcpy(&packed, value, MIN(size, sizeof(packed)));
+    return (void*)packed;
+}
+
+/* address of key and data in slot returned by insert or search of an inline map */
+#define dense_map_slot_key(map, item) ((void*)(item))
+#define dense_map_slot_data(map, item) ((void*)((Uint8*)(item) + (map)->data_offset))
 
 #include <Anvie/Containers/Interface/DenseMap.h>
+#include <Anvie/Containers/Interface/SpecializedDenseMap.h>
 
 /*                                      prefix  prefix   hash     ktype  kcompare    dtype */
 DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE(u8_u8,  U8_U8_,  hash_u8, Uint8, compare_u8, Uint8);
@@ -165,5 +315,11 @@ DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(u64_zstr, U64_ZStr
 /*                                                            prefix     prefix      hash       ktype    kcreate           kdestroy           kcompare      dtype    dcreate           ddestroy           is_multimap  max_load_factor */
 DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(zstr_zstr, ZStr_ZStr_, hash_zstr, ZString, zstr_create_copy, zstr_destroy_copy, compare_zstr, ZString, zstr_create_copy, zstr_destroy_copy, True,        DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
 
+/* strings packed into a StringArena, which is passed as udata, see StringArena.h */
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(zstr_arena_u32, ZStrArena_U32_, hash_zstr, ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, compare_zstr, Uint32 , NULL, NULL, True, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(zstr_arena_u64, ZStrArena_U64_, hash_zstr, ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, compare_zstr, Uint64 , NULL, NULL, True, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(u32_zstr_arena, U32_ZStrArena_, hash_u32 , Uint32 , NULL, NULL, compare_u32 , ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, True, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(u64_zstr_arena, U64_ZStrArena_, hash_u64 , Uint64 , NULL, NULL, compare_u64 , ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, True, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
 
 #endif // ANVIE_UTILS_CONTAINERS_DENSE_MAP_H
@@ -0,0 +1,111 @@
+/**
+ * @file Deque.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Double ended queue backed by a ring buffer.
+ * Insertion and removal at both ends is constant time, and order of
+ * elements is always preserved. Use this instead of @c Vector when
+ * elements are mostly added at one end and removed from the other.
+ * To define deques of different types, use the macros defined in
+ * `Interface/Deque.h` and use the corresponding functions only.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_DEQUE_H
+#define ANVIE_UTILS_CONTAINERS_DEQUE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+
+/**
+ * Represents a double ended queue.
+ *
+ * Elements are stored in a ring buffer of @c capacity elements, where
+ * @c capacity is always a power of two. Element at logical position
+ * @c i is stored at physical slot @c (head + i) & (capacity - 1).
+ *
+ * INSERTION SEMANTICS
+ * Same as @c Vector :
+ * - if @c element_size is less than or equal to 8, then data is treated as value.
+ * - if @c element_size is more than 8, then data is treated as pointer to element
+ *   and is copied to internal memory using @c memcpy.
+ * - if @c create_copy is set, it's ALWAYS used to create copy of data.
+ *
+ * RESIZE SEMANTICS
+ * - capacity is doubled when deque is full. Elements are never shifted
+ *   otherwise.
+ *
+ * ALLOCATION SEMANTICS
+ * - all memory owned by deque is allocated using @c allocator.
+ * - a @c NULL @c allocator means system allocator is used.
+ * - if @c allocator releases memory in bulk (has no free callback), then
+ *   destroying deque does not destroy element copies either.
+ * */
+typedef struct Deque {
+    Size                       element_size; /**< size of each element in deque */
+    Size                       length; /**< number of elements in deque */
+    Size                       capacity; /**< total number of elements ring buffer can hold, always a power of two */
+    Size                       head; /**< physical slot of element at front */
+    UByteArray                 data; /**< ring buffer of elements */
+    CreateElementCopyCallback  create_copy; /**< copy constructor functor */
+    DestroyElementCopyCallback destroy_copy; /**< copy destructor functor */
+    Allocator*                 allocator; /**< allocator for all memory owned by deque, NULL for system allocator */
+} Deque;
+
+#define deque_slot(dq, pos) (((dq)->head + (pos)) & ((dq)->capacity - 1))
+#define deque_address_at(dq, pos) ((dq)->data + deque_slot(dq, pos) * (dq)->element_size)
+#define deque_length(dq) ((dq)->length)
+#define deque_element_size(dq) ((dq)->element_size)
+#define deque_capacity(dq) ((dq)->capacity)
+#define deque_is_empty(dq) ((dq)->length == 0)
+
+Deque* deque_create(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy);
+Deque* deque_create_with_allocator(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy, Allocator* allocator);
+void   deque_destroy(Deque* dq, void* udata);
+void   deque_reserve(Deque* dq, Size capacity);
+void   deque_clear(Deque* dq, void* udata);
+
+void  deque_push_back(Deque* dq, void* data, void* udata);
+void  deque_push_front(Deque* dq, void* data, void* udata);
+void* deque_pop_back(Deque* dq);
+void* deque_pop_front(Deque* dq);
+
+void* deque_peek(Deque* dq, Size pos);
+void* deque_front(Deque* dq);
+void* deque_back(Deque* dq);
+
+void deque_print(Deque* dq, PrintElementCallback printer, void* udata);
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/Deque.h>
+
+DEF_INTEGER_DEQUE_INTERFACE(u8,  U8,  Uint8);
+DEF_INTEGER_DEQUE_INTERFACE(u16, U16, Uint16);
+DEF_INTEGER_DEQUE_INTERFACE(u32, U32, Uint32);
+DEF_INTEGER_DEQUE_INTERFACE(u64, U64, Uint64);
+
+DEF_INTEGER_DEQUE_INTERFACE(i8,  I8, Int8);
+DEF_INTEGER_DEQUE_INTERFACE(i16, I16, Int16);
+DEF_INTEGER_DEQUE_INTERFACE(i32, I32, Int32);
+DEF_INTEGER_DEQUE_INTERFACE(i64, I64, Int64);
+
+DEF_INTEGER_DEQUE_INTERFACE_WITH_COPY_AND_DESTROY(zstr, ZStr, ZString, zstr_create_copy, zstr_destroy_copy);
+DEF_INTEGER_DEQUE_INTERFACE(voidptr, VPtr, void*);
+
+#endif // ANVIE_UTILS_CONTAINERS_DEQUE_H
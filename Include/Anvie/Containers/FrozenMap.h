@@ -0,0 +1,107 @@
+/**
+ * @file FrozenMap.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief An immutable hash map built once from a @c DenseMap.
+ * Keys are placed with a minimal perfect hash, so every search is one
+ * probe and one key comparision, and there are no empty slots at all.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_FROZEN_MAP_H
+#define ANVIE_UTILS_CONTAINERS_FROZEN_MAP_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/DenseMap.h>
+
+/** First 8 bytes of every frozen map image, "ANVFROZN" in little endian. */
+#define FROZEN_MAP_MAGIC 0x4e5a4f5246564e41ull
+
+/** Format version of frozen map image, bumped on every incompatible change. */
+#define FROZEN_MAP_VERSION 1
+
+/**
+ * Header at start of a frozen map image. Image is header, then
+ * @c bucket_count 32 bit pilots padded to 8 bytes, then @c item_count
+ * slots of @c slot_size bytes, all in native byte order.
+ * */
+typedef struct FrozenMapHeader {
+    Uint64 magic;              /**< Always @c FROZEN_MAP_MAGIC. */
+    Uint64 version;            /**< Always @c FROZEN_MAP_VERSION. */
+    Uint64 image_size;         /**< Size of whole image in bytes. */
+    Uint64 item_count;         /**< Number of slots, one per key. */
+    Uint64 bucket_count;       /**< Number of pilots. */
+    Uint64 dense_bucket_count; /**< Buckets before this one get 60 percent of keys, rest get the others. */
+    Uint64 seed;               /**< Seed mixed into hash of every key. */
+    Uint64 key_size;           /**< Size of key in bytes. */
+    Uint64 data_size;          /**< Size of data in bytes. */
+    Uint64 data_offset;        /**< Offset of data in a slot. */
+    Uint64 slot_size;          /**< Size of a slot. */
+} FrozenMapHeader;
+
+/**
+ * Read-only hash map with unique keys, where each key has exactly one
+ * possible slot.
+ *
+ * Keys are spread over buckets, and each bucket has a pilot value, found
+ * while building, that sends every key of bucket to a slot no other key
+ * uses (PTHash). A search hashes key once, reads pilot of it's bucket and
+ * compares key in the single slot this gives.
+ *
+ * KEYS AND DATA
+ * - keys and data are plain-old-data copied into slots, laid out like a
+ *   struct `{ ktype key; dtype data; }` same as an inline @c DenseMap.
+ * - keys are passed to @c frozen_map_search and to @c compare_key in same
+ *   form as to a @c DenseMap without key copy callbacks : by value when
+ *   @c key_size is at most 8, pointer to key otherwise.
+ * - search returns pointer to data bytes in slot.
+ *
+ * IMAGE
+ * - whole map is a single buffer, see @c FrozenMapHeader. It can be
+ *   written out with @c frozen_map_serialize and used in place later with
+ *   @c frozen_map_open, eg: after @c mmap of a file, without rebuilding.
+ * - @c hash must return same values in program that opens image as in one
+ *   that built it, so don't use a random seed with hash functions of
+ *   @c Common.h for maps that are stored.
+ * */
+typedef struct FrozenMap {
+    const FrozenMapHeader* header;      /**< Start of image. */
+    const Uint32*          pilots;      /**< Pilot of each bucket. */
+    const Uint8*           slots;       /**< Slots, @c item_count of them. */
+    HashCallback           hash;        /**< Hash function for keys. */
+    CompareElementCallback compare_key; /**< Key comparision function. */
+    Bool                   owns_image;  /**< True when image was allocated by map and is freed with it. */
+    Allocator*             allocator;   /**< Allocator of map and of image when owned. NULL means system allocator. */
+} FrozenMap;
+
+FrozenMap* dense_map_freeze(DenseMap* map, void* udata);
+FrozenMap* frozen_map_open(const void* image, Size size, HashCallback hash, CompareElementCallback compare_key, Allocator* allocator);
+void       frozen_map_destroy(FrozenMap* map);
+
+void* frozen_map_search(FrozenMap* map, void* key, void* udata);
+void* frozen_map_search_with_hash(FrozenMap* map, void* key, Size hash, void* udata);
+
+Size frozen_map_serialized_size(FrozenMap* map);
+Size frozen_map_serialize(FrozenMap* map, void* buffer, Size size);
+
+#define frozen_map_item_count(map) ((Size)(map)->header->item_count)
+#define frozen_map_slot_key(map, pos) ((void*)((map)->slots + (pos) * (map)->header->slot_size))
+#define frozen_map_slot_data(map, pos) ((void*)((map)->slots + (pos) * (map)->header->slot_size + (map)->header->data_offset))
+
+#endif // ANVIE_UTILS_CONTAINERS_FROZEN_MAP_H
@@ -0,0 +1,61 @@
+/**
+ * @file GroupBy.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Hash group by over a column of keys and a column of values.
+ * Rows are hashed and probed in batches, and large inputs are radix
+ * partitioned by hash first, so that table of each partition stays in
+ * cache while it's rows are aggregated.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_GROUP_BY_H
+#define ANVIE_UTILS_CONTAINERS_GROUP_BY_H
+
+#include <Anvie/Types.h>
+#include <Anvie/ThreadPool.h>
+#include <Anvie/Containers/Vector.h>
+
+/**
+ * Aggregates of each distinct key, as columns. Entry at same position in
+ * each vector belongs to same group.
+ *
+ * ORDERING SEMANTICS
+ * Order of groups is unspecified. Inputs small enough to be aggregated in
+ * a single table keep keys in order of their first appearance, larger ones
+ * are grouped by partition first.
+ *
+ * FLOATING POINT SEMANTICS
+ * Values of a group are summed in order of their rows, so sums are same
+ * for serial and parallel variants. Min and max are updated with @c < and
+ * @c > comparisions, so a NaN is only picked up if it's the first value
+ * of it's group.
+ * */
+typedef struct GroupByResult {
+    U64_Vector* keys;   /**< distinct keys */
+    F64_Vector* sums;   /**< sum of values of each key */
+    U64_Vector* counts; /**< number of rows of each key */
+    F64_Vector* mins;   /**< smallest value of each key */
+    F64_Vector* maxs;   /**< largest value of each key */
+} GroupByResult;
+
+Bool group_by_aggregate_f64(U64_Vector* keys, F64_Vector* values, GroupByResult* result);
+Bool group_by_aggregate_f64_parallel(ThreadPool* pool, U64_Vector* keys, F64_Vector* values, GroupByResult* result);
+void group_by_result_destroy(GroupByResult* result);
+
+#endif // ANVIE_UTILS_CONTAINERS_GROUP_BY_H
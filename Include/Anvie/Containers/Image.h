@@ -0,0 +1,138 @@
+/**
+ * @file Image.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Binary images of containers, that can be written to a file once and
+ * mapped back into memory at every start, without parsing, copying or
+ * rehashing anything.
+ *
+ * An image holds exactly one container. It starts with an @c ImageHeader,
+ * followed by sections of raw container memory, each aligned to
+ * @c IMAGE_SECTION_ALIGN bytes from start of image, and ends with an
+ * @c ImageTrailer holding a checksum of everything before it. Nothing in an
+ * image is an absolute address, so it can be mapped anywhere.
+ *
+ * Images are written with `*_serialize_to_fd` or `*_write_to_buffer` of each
+ * container, and loaded with @c image_map_file or @c image_wrap_buffer
+ * followed by `*_from_image` of same container. A loaded container points
+ * straight into image memory :
+ * - It's meant to be read. Modifying it is allowed, but changes are private
+ *   to process and never written back to file, and growing it copies data
+ *   out of image.
+ * - It's released along with image by @c image_destroy. Destroying it
+ *   before that is allowed and releases nothing.
+ *
+ * Images are in native byte order and only load on machines of same
+ * endianness and word size as writer.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_IMAGE_H
+#define ANVIE_UTILS_CONTAINERS_IMAGE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+
+/** Alignment of each section, relative to start of image. */
+#define IMAGE_SECTION_ALIGN 64
+
+/** Checksum is computed over image in chunks of this many bytes. */
+#define IMAGE_CHECKSUM_CHUNK_SIZE (1024 * 1024)
+
+/** Current version of image format, images of other versions are rejected. */
+#define IMAGE_VERSION 1
+
+/** Maximum number of container specific parameters in header. */
+#define IMAGE_MAX_PARAMS 12
+
+/**
+ * Container held by an image.
+ * */
+typedef enum ImageKind {
+    IMAGE_KIND_INVALID = 0,
+    IMAGE_KIND_VECTOR,
+    IMAGE_KIND_BITVECTOR,
+    IMAGE_KIND_STRING,
+    IMAGE_KIND_DENSE_MAP,
+    IMAGE_KIND_MAX
+} ImageKind;
+
+/**
+ * First bytes of every image. Meaning of @c params depends on @c kind,
+ * and is defined by container writing the image.
+ * */
+typedef struct ImageHeader {
+    Uint8  magic[8];     /**< "ANVIEIMG" */
+    Uint16 version;      /**< @c IMAGE_VERSION of writer. */
+    Uint16 kind;         /**< @c ImageKind of container. */
+    Uint32 flags;        /**< Container specific flags. */
+    Uint32 byte_order;   /**< 0x01020304 as written by writer, to detect other endianness. */
+    Uint32 word_size;    /**< sizeof(Size) of writer. */
+    Uint64 image_size;   /**< Size of whole image, including header and trailer. */
+    Uint64 params[IMAGE_MAX_PARAMS]; /**< Container specific parameters. */
+} ImageHeader;
+
+/**
+ * Last bytes of every image.
+ * */
+typedef struct ImageTrailer {
+    Uint64 checksum;     /**< Checksum of all bytes before trailer. */
+    Uint8  magic[8];     /**< "ANVIEEND" */
+} ImageTrailer;
+
+/**
+ * A loaded image, see @c image_map_file.
+ * */
+typedef struct Image Image;
+
+/**
+ * Streams an image to a file descriptor or into a buffer, computing it's
+ * checksum on the way. For use by container writers.
+ * */
+typedef struct ImageWriter {
+    int    fd;           /**< Destination file, -1 when writing to buffer. */
+    Uint8* buffer;       /**< Destination buffer, NULL when writing to file. */
+    Size   capacity;     /**< Size of @c buffer. */
+    Size   offset;       /**< Bytes of image produced so far. */
+    Uint8* chunk;        /**< Staging chunk for file writes. */
+    Size   chunk_fill;   /**< Bytes of current checksum chunk produced so far. */
+    Uint64 checksum;     /**< Checksum of all completed chunks. */
+    Bool   failed;       /**< Set when a write failed or buffer was too small. */
+} ImageWriter;
+
+Image*        image_map_file(ZString path);
+Image*        image_wrap_buffer(void* buffer, Size size);
+void          image_destroy(Image* image);
+ImageKind     image_get_kind(Image* image);
+Size          image_get_size(Image* image);
+
+/* for container implementations */
+Bool          image_writer_init_fd(ImageWriter* writer, int fd);
+void          image_writer_init_buffer(ImageWriter* writer, void* buffer, Size capacity);
+void          image_writer_begin(ImageWriter* writer, ImageKind kind, Uint32 flags, const Uint64* params, Size param_count, Size image_size);
+void          image_writer_put(ImageWriter* writer, const void* data, Size size);
+void          image_writer_align(ImageWriter* writer);
+Size          image_writer_finish(ImageWriter* writer);
+
+Size          image_section_size(Size size);
+const ImageHeader* image_get_header(Image* image);
+void*         image_take_section(Image* image, Size* cursor, Size size);
+Allocator*    image_get_allocator(Image* image);
+void*         image_get_container(Image* image);
+void          image_set_container(Image* image, void* container);
+
+#endif // ANVIE_UTILS_CONTAINERS_IMAGE_H
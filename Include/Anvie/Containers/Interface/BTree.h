@@ -0,0 +1,113 @@
+/**
+ * @file BTree.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of B-trees for any
+ * key and data type.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_BTREE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_BTREE_H
+
+/**
+ * Define a new @c BTree interface for integer key and integer value. Keys are
+ * compared as integers, signed or unsigned depending on @p ktype, without
+ * any callback.
+ * @param api_prefix What prefix to add before each @c BTree api call?
+ * @param type_prefix What prefix to add before @c BTree type?
+ * @param ktype Type of key, an integer type.
+ * @param dtype Type of data.
+ * */
+#define DEF_INTEGER_INTEGER_BTREE_INTERFACE(api_prefix, type_prefix, ktype, dtype) \
+    static FORCE_INLINE BTree* api_prefix##_btree_create() {            \
+        return btree_create_integer(sizeof(ktype), !(((ktype)-1) > (ktype)0), sizeof(dtype), NULL, NULL); \
+    }                                                                   \
+                                                                        \
+    DEF_BTREE_INTERFACE_COMMON(api_prefix, type_prefix, ktype, dtype)
+
+/**
+ * Define a new @c BTree interface for key and data types that fit in 8 bytes,
+ * with copy callbacks, eg: strings. Keys are compared with @p kcompare.
+ * @param api_prefix What prefix to add before each @c BTree api call?
+ * @param type_prefix What prefix to add before @c BTree type?
+ * @param ktype Type of key.
+ * @param kcreate Copy constructor callback for key.
+ * @param kdestroy Copy destructor callback for key.
+ * @param kcompare Key compare callback. Cannot be NULL.
+ * @param dtype Type of data.
+ * @param dcreate Copy constructor callback for data.
+ * @param ddestroy Copy destructor callback for data.
+ * */
+#define DEF_INTEGER_INTEGER_BTREE_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, type_prefix, ktype, kcreate, kdestroy, kcompare, dtype, dcreate, ddestroy) \
+    static FORCE_INLINE BTree* api_prefix##_btree_create() {            \
+        return btree_create(sizeof(ktype),                              \
+                            (CreateElementCopyCallback)(void*)kcreate,  \
+                            (DestroyElementCopyCallback)(void*)kdestroy, \
+                            (CompareElementCallback)(void*)kcompare,    \
+                            sizeof(dtype),                              \
+                            (CreateElementCopyCallback)(void*)dcreate,  \
+                            (DestroyElementCopyCallback)(void*)ddestroy); \
+    }                                                                   \
+                                                                        \
+    DEF_BTREE_INTERFACE_COMMON(api_prefix, type_prefix, ktype, dtype)
+
+/* wrappers common to all interfaces */
+#define DEF_BTREE_INTERFACE_COMMON(api_prefix, type_prefix, ktype, dtype) \
+    typedef BTree type_prefix##BTree;                                   \
+    typedef struct type_prefix##BTreeItem {                             \
+        ktype key __attribute__((aligned(8)));                          \
+        dtype data __attribute__((aligned(8)));                         \
+    } type_prefix##BTreeItem;                                           \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_btree_destroy(type_prefix##BTree* tree, void* udata) { \
+        btree_destroy(tree, udata);                                     \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_btree_clear(type_prefix##BTree* tree, void* udata) { \
+        btree_clear(tree, udata);                                       \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##BTreeItem* api_prefix##_btree_insert(type_prefix##BTree* tree, ktype key, dtype data, void* udata) { \
+        return (type_prefix##BTreeItem*)btree_insert(tree, (void*)(Uint64)key, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##BTreeItem* api_prefix##_btree_search(type_prefix##BTree* tree, ktype key, void* udata) { \
+        return (type_prefix##BTreeItem*)btree_search(tree, (void*)(Uint64)key, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_btree_delete(type_prefix##BTree* tree, ktype key, void* udata) { \
+        return btree_delete(tree, (void*)(Uint64)key, udata);           \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_btree_build_from_sorted(type_prefix##BTree* tree, const ktype* keys, const dtype* values, Size count, void* udata) { \
+        return btree_build_from_sorted(tree, keys, values, count, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE BTreeIterator api_prefix##_btree_lower_bound(type_prefix##BTree* tree, ktype key, void* udata) { \
+        return btree_lower_bound(tree, (void*)(Uint64)key, udata);      \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE BTreeIterator api_prefix##_btree_range(type_prefix##BTree* tree, ktype low, ktype high, void* udata) { \
+        return btree_range(tree, (void*)(Uint64)low, (void*)(Uint64)high, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##BTreeItem* api_prefix##_btree_iter_next(BTreeIterator* iter) { \
+        return (type_prefix##BTreeItem*)btree_iter_next(iter);          \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_BTREE_H
@@ -24,6 +24,8 @@
 #ifndef ANVIE_UTILS_CONTAINERS_DENSE_MAP_INTERFACE_H
 #define ANVIE_UTILS_CONTAINERS_DENSE_MAP_INTERFACE_H
 
+#include <stddef.h>
+
 #define DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE 0.875f
 
 /**
@@ -89,8 +91,8 @@
 #define DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, type_prefix, hash, ktype, create_key_copy, destroy_key_copy, compare_key, dtype, create_data_copy, destroy_data_copy, is_multimap, max_load_factor) \
     typedef DenseMap type_prefix##DenseMap;                             \
     typedef struct type_prefix##DenseMapItem {                          \
-        ktype key;                                                      \
-        dtype data;                                                     \
+        ktype key __attribute__((aligned(8)));                          \
+        dtype data __attribute__((aligned(8)));                         \
     } type_prefix##DenseMapItem;                                        \
                                                                         \
     static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create() { \
@@ -105,6 +107,18 @@
                                 is_multimap, max_load_factor);          \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create_with_allocator(Allocator* allocator) { \
+        return dense_map_create_with_allocator((HashCallback)(void*)hash,                     \
+                                               sizeof(ktype),                          \
+                                               (CreateElementCopyCallback)(void*)create_key_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_key_copy, \
+                                               (CompareElementCallback)(void*)compare_key,    \
+                                               sizeof(dtype),                          \
+                                               (CreateElementCopyCallback)(void*)create_data_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_data_copy, \
+                                               is_multimap, max_load_factor, allocator); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void api_prefix##_dense_map_destroy(type_prefix##DenseMap* map, void* udata) { \
         dense_map_destroy(map, udata);                                  \
     }                                                                   \
@@ -123,13 +137,29 @@
                                                                         \
     static FORCE_INLINE void api_prefix##_dense_map_delete(type_prefix##DenseMap* map, ktype key, void* udata) { \
         dense_map_delete(map, (void*)(Uint64)key, udata);                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_iter_next(type_prefix##DenseMap* map, DenseMapIterator* iter) { \
+        return (type_prefix##DenseMapItem*)dense_map_iter_next(map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_foreach(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_foreach(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_clear(type_prefix##DenseMap* map, void* udata) { \
+        dense_map_clear(map, udata);                                    \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_drain(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_drain(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #define DEF_STRUCT_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, type_prefix, hash, ktype, create_key_copy, destroy_key_copy, compare_key, dtype, create_data_copy, destroy_data_copy, is_multimap, max_load_factor) \
     typedef DenseMap type_prefix##DenseMap;                             \
     typedef struct type_prefix##DenseMapItem {                          \
         ktype* key;                                                     \
-        dtype data;                                                     \
+        dtype data __attribute__((aligned(8)));                         \
     } type_prefix##DenseMapItem;                                        \
                                                                         \
     static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create() { \
@@ -144,6 +174,18 @@
                                 is_multimap, max_load_factor);          \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create_with_allocator(Allocator* allocator) { \
+        return dense_map_create_with_allocator((HashCallback)(void*)hash,                     \
+                                               sizeof(ktype),                          \
+                                               (CreateElementCopyCallback)(void*)create_key_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_key_copy, \
+                                               (CompareElementCallback)(void*)compare_key,    \
+                                               sizeof(dtype),                          \
+                                               (CreateElementCopyCallback)(void*)create_data_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_data_copy, \
+                                               is_multimap, max_load_factor, allocator); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void api_prefix##_dense_map_destroy(type_prefix##DenseMap* map, void* udata) { \
         dense_map_destroy(map, udata);                                  \
     }                                                                   \
@@ -162,6 +204,22 @@
                                                                         \
     static FORCE_INLINE void api_prefix##_dense_map_delete(type_prefix##DenseMap* map, ktype* key, void* udata) { \
         dense_map_delete(map, (void*)(Uint64)key, udata);                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_iter_next(type_prefix##DenseMap* map, DenseMapIterator* iter) { \
+        return (type_prefix##DenseMapItem*)dense_map_iter_next(map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_foreach(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_foreach(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_clear(type_prefix##DenseMap* map, void* udata) { \
+        dense_map_clear(map, udata);                                    \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_drain(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_drain(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #define DEF_INTEGER_STRUCT_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, type_prefix, hash, ktype, create_key_copy, destroy_key_copy, compare_key, dtype, create_data_copy, destroy_data_copy, is_multimap, max_load_factor) \
@@ -183,6 +241,18 @@
                                 is_multimap, max_load_factor);          \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create_with_allocator(Allocator* allocator) { \
+        return dense_map_create_with_allocator((HashCallback)(void*)hash,                     \
+                                               sizeof(ktype),                          \
+                                               (CreateElementCopyCallback)(void*)create_key_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_key_copy, \
+                                               (CompareElementCallback)(void*)compare_key,    \
+                                               sizeof(dtype),                          \
+                                               (CreateElementCopyCallback)(void*)create_data_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_data_copy, \
+                                               is_multimap, max_load_factor, allocator); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void api_prefix##_dense_map_destroy(type_prefix##DenseMap* map, void* udata) { \
         dense_map_destroy(map, udata);                                  \
     }                                                                   \
@@ -201,6 +271,22 @@
                                                                         \
     static FORCE_INLINE void api_prefix##_dense_map_delete(type_prefix##DenseMap* map, ktype key, void* udata) { \
         dense_map_delete(map, (void*)(Uint64)key, udata);                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_iter_next(type_prefix##DenseMap* map, DenseMapIterator* iter) { \
+        return (type_prefix##DenseMapItem*)dense_map_iter_next(map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_foreach(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_foreach(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_clear(type_prefix##DenseMap* map, void* udata) { \
+        dense_map_clear(map, udata);                                    \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_drain(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_drain(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #define DEF_STRUCT_STRUCT_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, type_prefix, hash, ktype, create_key_copy, destroy_key_copy, compare_key, dtype, create_data_copy, destroy_data_copy, is_multimap, max_load_factor) \
@@ -222,6 +308,18 @@
                                 is_multimap, max_load_factor);          \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create_with_allocator(Allocator* allocator) { \
+        return dense_map_create_with_allocator((HashCallback)(void*)hash,                     \
+                                               sizeof(ktype),                          \
+                                               (CreateElementCopyCallback)(void*)create_key_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_key_copy, \
+                                               (CompareElementCallback)(void*)compare_key,    \
+                                               sizeof(dtype),                          \
+                                               (CreateElementCopyCallback)(void*)create_data_copy, \
+                                               (DestroyElementCopyCallback)(void*)destroy_data_copy, \
+                                               is_multimap, max_load_factor, allocator); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void api_prefix##_dense_map_destroy(type_prefix##DenseMap* map, void* udata) { \
         dense_map_destroy(map, udata);                                  \
     }                                                                   \
@@ -240,6 +338,94 @@
                                                                         \
     static FORCE_INLINE void api_prefix##_dense_map_delete(type_prefix##DenseMap* map, ktype* key, void* udata) { \
         dense_map_delete(map, (void*)(Uint64)key, udata);                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_iter_next(type_prefix##DenseMap* map, DenseMapIterator* iter) { \
+        return (type_prefix##DenseMapItem*)dense_map_iter_next(map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_foreach(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_foreach(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_clear(type_prefix##DenseMap* map, void* udata) { \
+        dense_map_clear(map, udata);                                    \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_drain(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_drain(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
+    }
+
+/**
+ * Define a @c DenseMap interface that stores keys and data inline in slots,
+ * see @c dense_map_create_inline. Both key and data are plain-old-data of any
+ * size, and are copied into slots byte by byte. Returned item pointers point
+ * directly into slots and are valid until next insertion, deletion or resize.
+ * @param api_prefix What prefix to add before each @c DenseMap api call?
+ * @param type_prefix What prefix to add before @c DenseMap type?
+ * @param hash Hash function. Gets key by value if it's at most 8 bytes, pointer to key otherwise.
+ * @param ktype Type of key.
+ * @param kcompare Key compare callback. Gets keys same as @p hash.
+ * @param dtype Type of data.
+ * @param is_multimap True when multiple items with same key can coexist.
+ * @param max_load_factor Maximum load factor before map is resized.
+ * */
+#define DEF_INLINE_DENSE_MAP_INTERFACE(api_prefix, type_prefix, hash, ktype, kcompare, dtype, is_multimap, max_load_factor) \
+    typedef DenseMap type_prefix##DenseMap;                             \
+    typedef struct type_prefix##DenseMapItem {                          \
+        ktype key;                                                      \
+        dtype data;                                                     \
+    } type_prefix##DenseMapItem;                                        \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create_with_allocator(Allocator* allocator) { \
+        return dense_map_create_inline((HashCallback)(void*)hash,       \
+                                       sizeof(ktype), NULL, NULL,       \
+                                       (CompareElementCallback)(void*)kcompare, \
+                                       sizeof(dtype), NULL, NULL,       \
+                                       offsetof(type_prefix##DenseMapItem, data), \
+                                       sizeof(type_prefix##DenseMapItem), \
+                                       is_multimap, max_load_factor, allocator); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create() { \
+        return api_prefix##_dense_map_create_with_allocator(NULL);      \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_destroy(type_prefix##DenseMap* map, void* udata) { \
+        dense_map_destroy(map, udata);                                  \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_resize(type_prefix##DenseMap* map, Size size, void* udata) { \
+        dense_map_resize(map, size, udata);                             \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_insert(type_prefix##DenseMap* map, ktype key, dtype data, void* udata) { \
+        return (type_prefix##DenseMapItem*)dense_map_insert(map, dense_map_pack(&key, sizeof(ktype)), \
+                                                            dense_map_pack(&data, sizeof(dtype)), udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_search(type_prefix##DenseMap* map, ktype key, void* udata) { \
+        return (type_prefix##DenseMapItem*)dense_map_search(map, dense_map_pack(&key, sizeof(ktype)), udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_delete(type_prefix##DenseMap* map, ktype key, void* udata) { \
+        dense_map_delete(map, dense_map_pack(&key, sizeof(ktype)), udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_iter_next(type_prefix##DenseMap* map, DenseMapIterator* iter) { \
+        return (type_prefix##DenseMapItem*)dense_map_iter_next(map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_foreach(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_foreach(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_clear(type_prefix##DenseMap* map, void* udata) { \
+        dense_map_clear(map, udata);                                    \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_drain(type_prefix##DenseMap* map, void (*visitor)(type_prefix##DenseMapItem* item, void* udata), void* udata) { \
+        dense_map_drain(map, (DenseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #endif // ANVIE_UTILS_CONTAINERS_DENSE_MAP_INTERFACE_H
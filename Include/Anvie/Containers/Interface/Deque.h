@@ -0,0 +1,218 @@
+/**
+ * @file Deque.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of deques for any type.
+ *
+ * This file defines three macros :
+ * - DEF_INTEGER_DEQUE_INTERFACE (integers)
+ * - DEF_INTEGER_DEQUE_INTERFACE_WITH_COPY_AND_DESTROY (mostly pointers)
+ * - DEF_STRUCT_DEQUE_INTERFACE (structs)
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_DEQUE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_DEQUE_H
+
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Interface/Common.h>
+
+/**
+ * @def DEF_INTEGER_DEQUE_INTERFACE
+ * @brief Define the Integer Deque Container Interface
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the integer deque container.
+ * @param type The type of integer elements stored in the deque.
+ */
+#define DEF_INTEGER_DEQUE_INTERFACE(api_prefix, typename, type)         \
+    DEF_INTEGER_DEQUE_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, typename, type, NULL, NULL)
+
+/**
+ * @def DEF_INTEGER_DEQUE_INTERFACE_WITH_COPY_AND_DESTROY
+ * @brief Define the Integer Deque Container Interface with Copy and Destroy Functions
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the integer deque container.
+ * @param type The type of integer elements stored in the deque.
+ * @param copy Callback function for copying integer elements.
+ * @param destroy Callback function for destroying integer elements.
+ */
+#define DEF_INTEGER_DEQUE_INTERFACE_WITH_COPY_AND_DESTROY(api_prefix, typename, type, copy, destroy) \
+    /**
+     * Same layout as generic Deque, with type specific members,
+     * so both can be used interchangeably by type casting.
+     * */                                                               \
+    DEF_INTEGER_TYPE_SPECIFIC_CALLBACKS(type, typename);                \
+    typedef struct typename##_Deque {                                   \
+        Size                            element_size;                   \
+        Size                            length;                         \
+        Size                            capacity;                       \
+        Size                            head;                           \
+        type*                           data;                           \
+        Create##typename##CopyCallback  create_copy;                    \
+        Destroy##typename##CopyCallback destroy_copy;                   \
+        Allocator*                      allocator;                      \
+    } typename##_Deque;                                                 \
+                                                                        \
+    FORCE_INLINE typename##_Deque* api_prefix##_deque_create() {        \
+        return (typename##_Deque*)deque_create(sizeof(type),            \
+                             (CreateElementCopyCallback)(void*)(copy),  \
+                             (DestroyElementCopyCallback)(void*)destroy); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Deque* api_prefix##_deque_create_with_allocator(Allocator* allocator) { \
+        return (typename##_Deque*)deque_create_with_allocator(sizeof(type), \
+                             (CreateElementCopyCallback)(void*)(copy),  \
+                             (DestroyElementCopyCallback)(void*)destroy, \
+                             allocator);                                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_destroy(typename##_Deque* dq, void* udata) { \
+        deque_destroy((Deque*)dq, udata);                               \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_reserve(typename##_Deque* dq, Size capacity) { \
+        deque_reserve((Deque*)dq, capacity);                            \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_clear(typename##_Deque* dq, void* udata) { \
+        deque_clear((Deque*)dq, udata);                                 \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_push_back(typename##_Deque* dq, type value, void* udata) { \
+        deque_push_back((Deque*)dq, (void*)(Uint64)value, udata);       \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_push_front(typename##_Deque* dq, type value, void* udata) { \
+        deque_push_front((Deque*)dq, (void*)(Uint64)value, udata);      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_deque_pop_back(typename##_Deque* dq) { \
+        return (type)(Uint64)deque_pop_back((Deque*)dq);                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_deque_pop_front(typename##_Deque* dq) { \
+        return (type)(Uint64)deque_pop_front((Deque*)dq);               \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_deque_peek(typename##_Deque* dq, Size pos) { \
+        return (type)(Uint64)deque_peek((Deque*)dq, pos);               \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_deque_front(typename##_Deque* dq) {  \
+        return (type)(Uint64)deque_front((Deque*)dq);                   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_deque_back(typename##_Deque* dq) {   \
+        return (type)(Uint64)deque_back((Deque*)dq);                    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_address_at(typename##_Deque* dq, Size pos) { \
+        return (type*)deque_address_at((Deque*)dq, pos);                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_print(typename##_Deque* dq, Print##typename##Callback printer, void* udata) { \
+        deque_print((Deque*)dq, (PrintElementCallback)(void*)printer, udata); \
+    }
+
+/**
+ * @def DEF_STRUCT_DEQUE_INTERFACE
+ * @brief Define the Struct Deque Container Interface
+ *
+ * @param api_prefix The API prefix for functions.
+ * @param typename The typename for the deque container.
+ * @param type The type of elements stored in the deque.
+ * @param copy_create Callback function for creating a copy of elements.
+ * @param copy_destroy Callback function for destroying a copy of elements.
+ */
+#define DEF_STRUCT_DEQUE_INTERFACE(api_prefix, typename, type, copy_create, copy_destroy) \
+    DEF_STRUCT_TYPE_SPECIFIC_CALLBACKS(type, typename);                 \
+    typedef struct typename##_Deque {                                   \
+        Size                            element_size;                   \
+        Size                            length;                         \
+        Size                            capacity;                       \
+        Size                            head;                           \
+        type*                           data;                           \
+        Create##typename##CopyCallback  create_copy;                    \
+        Destroy##typename##CopyCallback destroy_copy;                   \
+        Allocator*                      allocator;                      \
+    } typename##_Deque;                                                 \
+                                                                        \
+    FORCE_INLINE typename##_Deque* api_prefix##_deque_create() {        \
+        return (typename##_Deque*)deque_create(sizeof(type),            \
+                                               (CreateElementCopyCallback)(copy_create), \
+                                               (DestroyElementCopyCallback)(copy_destroy)); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Deque* api_prefix##_deque_create_with_allocator(Allocator* allocator) { \
+        return (typename##_Deque*)deque_create_with_allocator(sizeof(type), \
+                                               (CreateElementCopyCallback)(copy_create), \
+                                               (DestroyElementCopyCallback)(copy_destroy), \
+                                               allocator);              \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_destroy(typename##_Deque* dq, void* udata) { \
+        deque_destroy((Deque*)dq, udata);                               \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_reserve(typename##_Deque* dq, Size capacity) { \
+        deque_reserve((Deque*)dq, capacity);                            \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_clear(typename##_Deque* dq, void* udata) { \
+        deque_clear((Deque*)dq, udata);                                 \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_push_back(typename##_Deque* dq, type* data, void* udata) { \
+        deque_push_back((Deque*)dq, (void*)data, udata);                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_push_front(typename##_Deque* dq, type* data, void* udata) { \
+        deque_push_front((Deque*)dq, (void*)data, udata);               \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_pop_back(typename##_Deque* dq) { \
+        return (type*)deque_pop_back((Deque*)dq);                       \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_pop_front(typename##_Deque* dq) { \
+        return (type*)deque_pop_front((Deque*)dq);                      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_peek(typename##_Deque* dq, Size pos) { \
+        return (type*)deque_peek((Deque*)dq, pos);                      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_front(typename##_Deque* dq) { \
+        return (type*)deque_front((Deque*)dq);                          \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_back(typename##_Deque* dq) {  \
+        return (type*)deque_back((Deque*)dq);                           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_deque_address_at(typename##_Deque* dq, Size pos) { \
+        return (type*)deque_address_at((Deque*)dq, pos);                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_deque_print(typename##_Deque* dq, Print##typename##Callback printer, void* udata) { \
+        deque_print((Deque*)dq, (PrintElementCallback)(void*)printer, udata); \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_DEQUE_H
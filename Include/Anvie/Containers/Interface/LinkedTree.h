@@ -0,0 +1,82 @@
+/**
+ * @file LinkedTree.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of linked trees for any type.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_LINKED_TREE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_LINKED_TREE_H
+
+#define DEF_INTEGER_LINKED_TREE_INTERFACE(prefix, type) DEF_INTEGER_LINKED_TREE_INTERFACE_WITH_COPY_AND_DESTROY(prefix, type, NULL, NULL)
+
+/* wrappers common to integer and struct interfaces */
+#define DEF_LINKED_TREE_INTERFACE_COMMON(prefix, type, copy, destroy)   \
+    static FORCE_INLINE LinkedTree* prefix##_linked_tree_create() {     \
+        return linked_tree_create(sizeof(type),                         \
+                                  (CreateElementCopyCallback)(void*)copy, \
+                                  (DestroyElementCopyCallback)(void*)destroy); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type* prefix##_linked_tree_node_data(LinkedTreeNode* node) { \
+        return (type*)linked_tree_node_data(node);                      \
+    }
+
+#define DEF_INTEGER_LINKED_TREE_INTERFACE_WITH_COPY_AND_DESTROY(prefix, type, copy, destroy) \
+    DEF_LINKED_TREE_INTERFACE_COMMON(prefix, type, copy, destroy)       \
+                                                                        \
+    static FORCE_INLINE type prefix##_linked_tree_node_value(LinkedTreeNode* node) { \
+        return *(type*)linked_tree_node_data(node);                     \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_push_front(LinkedTree* tree, LinkedTreeNode* parent, type data, void* udata) { \
+        return linked_tree_push_front(tree, parent, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_push_back(LinkedTree* tree, LinkedTreeNode* parent, type data, void* udata) { \
+        return linked_tree_push_back(tree, parent, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_insert_before(LinkedTree* tree, LinkedTreeNode* sibling, type data, void* udata) { \
+        return linked_tree_insert_before(tree, sibling, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_insert_after(LinkedTree* tree, LinkedTreeNode* sibling, type data, void* udata) { \
+        return linked_tree_insert_after(tree, sibling, (void*)(Uint64)data, udata); \
+    }
+
+#define DEF_STRUCT_LINKED_TREE_INTERFACE(prefix, type, copy, destroy)   \
+    DEF_LINKED_TREE_INTERFACE_COMMON(prefix, type, copy, destroy)       \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_push_front(LinkedTree* tree, LinkedTreeNode* parent, type* data, void* udata) { \
+        return linked_tree_push_front(tree, parent, (void*)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_push_back(LinkedTree* tree, LinkedTreeNode* parent, type* data, void* udata) { \
+        return linked_tree_push_back(tree, parent, (void*)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_insert_before(LinkedTree* tree, LinkedTreeNode* sibling, type* data, void* udata) { \
+        return linked_tree_insert_before(tree, sibling, (void*)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE LinkedTreeNode* prefix##_linked_tree_insert_after(LinkedTree* tree, LinkedTreeNode* sibling, type* data, void* udata) { \
+        return linked_tree_insert_after(tree, sibling, (void*)data, udata); \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_LINKED_TREE_H
@@ -0,0 +1,92 @@
+/**
+ * @file Pipeline.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Defines macros that'll help in quick creation of pipelines over
+ * typed vectors.
+ *
+ * This file defines one macro :
+ * - DEF_NUMERIC_PIPELINE_INTERFACE (numbers, stages run as plain loops)
+ *
+ * It must be used after vector interface for same typename is defined.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_PIPELINE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_PIPELINE_H
+
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Containers/Interface/Common.h>
+
+/**
+ * @def DEF_NUMERIC_PIPELINE_INTERFACE
+ * @brief Define the Numeric Pipeline Interface
+ *
+ * Only for the numeric types that have matching `pipeline_*_<api_prefix>`
+ * functions : u8, u16, u32, u64, i8, i16, i32, i64, f32 and f64. Stages
+ * and reductions defined here expect elements of @p type when pipeline is
+ * evaluated, so they must come before any map to another type.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the vector container.
+ * @param type The type of elements stored in vector.
+ * @param sum_type The type sums are accumulated in.
+ */
+#define DEF_NUMERIC_PIPELINE_INTERFACE(api_prefix, typename, type, sum_type) \
+    FORCE_INLINE Pipeline api_prefix##_pipeline_from_vector(typename##_Vector* vec) { \
+        return pipeline_from_vector((Vector*)vec);                      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Pipeline api_prefix##_pipeline_from_view(typename##_VectorView view) { \
+        VectorView generic = {view.element_size, view.length, (UByteArray)view.data}; \
+        return pipeline_from_view(generic);                             \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Pipeline* api_prefix##_pipeline_add(Pipeline* pipeline, type value) { \
+        return pipeline_add_##api_prefix(pipeline, value);              \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Pipeline* api_prefix##_pipeline_mul(Pipeline* pipeline, type value) { \
+        return pipeline_mul_##api_prefix(pipeline, value);              \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Pipeline* api_prefix##_pipeline_retain_eq(Pipeline* pipeline, type value) { \
+        return pipeline_retain_eq_##api_prefix(pipeline, value);        \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Pipeline* api_prefix##_pipeline_retain_lt(Pipeline* pipeline, type value) { \
+        return pipeline_retain_lt_##api_prefix(pipeline, value);        \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Pipeline* api_prefix##_pipeline_retain_in_range(Pipeline* pipeline, type lo, type hi) { \
+        return pipeline_retain_in_range_##api_prefix(pipeline, lo, hi); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE sum_type api_prefix##_pipeline_sum(Pipeline* pipeline) { \
+        return pipeline_sum_##api_prefix(pipeline);                     \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_pipeline_min(Pipeline* pipeline, type* out) { \
+        return pipeline_min_##api_prefix(pipeline, out);                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_pipeline_max(Pipeline* pipeline, type* out) { \
+        return pipeline_max_##api_prefix(pipeline, out);                \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_PIPELINE_H
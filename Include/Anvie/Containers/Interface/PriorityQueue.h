@@ -0,0 +1,181 @@
+/**
+ * @file PriorityQueue.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of priority queues for any type.
+ *
+ * This file defines two macros :
+ * - DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE (numbers, compared inline)
+ * - DEF_STRUCT_PRIORITY_QUEUE_INTERFACE (structs, compared using a callback)
+ *
+ * Both must be used after vector interface for same typename is defined,
+ * because queue exposes it's heap as a typed vector.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_PRIORITY_QUEUE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_PRIORITY_QUEUE_H
+
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Interface/Common.h>
+
+/**
+ * @def DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE
+ * @brief Define the Numeric Priority Queue Container Interface
+ *
+ * Only for the numeric types that have matching `priority_queue_*_<api_prefix>`
+ * functions : u8, u16, u32, u64, i8, i16, i32, i64, f32 and f64.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the priority queue container.
+ * @param type The type of elements stored in the priority queue.
+ */
+#define DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(api_prefix, typename, type) \
+    /**
+     * Same layout as generic PriorityQueue, with type specific members,
+     * so both can be used interchangeably by type casting.
+     * */                                                               \
+    typedef struct typename##_PriorityQueue {                           \
+        typename##_Vector*     heap;                                    \
+        CompareElementCallback compare;                                 \
+        void*                  udata;                                   \
+        Bool                   descending;                              \
+    } typename##_PriorityQueue;                                         \
+                                                                        \
+    FORCE_INLINE typename##_PriorityQueue* api_prefix##_priority_queue_create(Bool descending) { \
+        return (typename##_PriorityQueue*)priority_queue_create_##api_prefix(descending, NULL); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_PriorityQueue* api_prefix##_priority_queue_create_with_allocator(Bool descending, Allocator* allocator) { \
+        return (typename##_PriorityQueue*)priority_queue_create_##api_prefix(descending, allocator); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_PriorityQueue* api_prefix##_priority_queue_from_vector(typename##_Vector* vec, Bool descending) { \
+        return (typename##_PriorityQueue*)priority_queue_from_vector_##api_prefix((Vector*)vec, descending); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_destroy(typename##_PriorityQueue* pq) { \
+        priority_queue_destroy((PriorityQueue*)pq);                     \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_clear(typename##_PriorityQueue* pq) { \
+        priority_queue_clear((PriorityQueue*)pq);                       \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_reserve(typename##_PriorityQueue* pq, Size capacity) { \
+        priority_queue_reserve((PriorityQueue*)pq, capacity);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_push(typename##_PriorityQueue* pq, type value) { \
+        priority_queue_push_##api_prefix((PriorityQueue*)pq, value);    \
+    }                                                                   \
+                                                                        \
+    /**
+     * Get element on top, or 0 if queue is empty.
+     * */                                                               \
+    FORCE_INLINE type api_prefix##_priority_queue_peek(typename##_PriorityQueue* pq) { \
+        return pq->heap->length ? pq->heap->data[0] : (type)0;          \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_priority_queue_pop(typename##_PriorityQueue* pq, type* out) { \
+        return priority_queue_pop_##api_prefix((PriorityQueue*)pq, out); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_priority_queue_replace_top(typename##_PriorityQueue* pq, type value, type* out) { \
+        return priority_queue_replace_top_##api_prefix((PriorityQueue*)pq, value, out); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_priority_queue_length(typename##_PriorityQueue* pq) { \
+        return priority_queue_length(pq);                               \
+    }
+
+/**
+ * @def DEF_STRUCT_PRIORITY_QUEUE_INTERFACE
+ * @brief Define the Struct Priority Queue Container Interface
+ *
+ * @param api_prefix The API prefix for functions.
+ * @param typename The typename for the priority queue container.
+ * @param type The type of elements stored in the priority queue.
+ * @param copy Callback function for copying elements. Can be NULL.
+ * @param destroy Callback function for destroying elements. Can be NULL.
+ */
+#define DEF_STRUCT_PRIORITY_QUEUE_INTERFACE(api_prefix, typename, type, copy, destroy) \
+    /**
+     * Same layout as generic PriorityQueue, with type specific members,
+     * so both can be used interchangeably by type casting.
+     * */                                                               \
+    typedef struct typename##_PriorityQueue {                           \
+        typename##_Vector*          heap;                               \
+        Compare##typename##Callback compare;                            \
+        void*                       udata;                              \
+        Bool                        descending;                         \
+    } typename##_PriorityQueue;                                         \
+                                                                        \
+    FORCE_INLINE typename##_PriorityQueue* api_prefix##_priority_queue_create(Compare##typename##Callback compare, void* udata) { \
+        return (typename##_PriorityQueue*)priority_queue_create(sizeof(type), \
+                             (CreateElementCopyCallback)(void*)(copy),  \
+                             (DestroyElementCopyCallback)(void*)destroy, \
+                             (CompareElementCallback)(void*)compare,    \
+                             udata);                                    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_PriorityQueue* api_prefix##_priority_queue_create_with_allocator(Compare##typename##Callback compare, void* udata, Allocator* allocator) { \
+        return (typename##_PriorityQueue*)priority_queue_create_with_allocator(sizeof(type), \
+                             (CreateElementCopyCallback)(void*)(copy),  \
+                             (DestroyElementCopyCallback)(void*)destroy, \
+                             (CompareElementCallback)(void*)compare,    \
+                             udata, allocator);                         \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_PriorityQueue* api_prefix##_priority_queue_from_vector(typename##_Vector* vec, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_PriorityQueue*)priority_queue_from_vector((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_destroy(typename##_PriorityQueue* pq) { \
+        priority_queue_destroy((PriorityQueue*)pq);                     \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_clear(typename##_PriorityQueue* pq) { \
+        priority_queue_clear((PriorityQueue*)pq);                       \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_reserve(typename##_PriorityQueue* pq, Size capacity) { \
+        priority_queue_reserve((PriorityQueue*)pq, capacity);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_priority_queue_push(typename##_PriorityQueue* pq, type* data) { \
+        priority_queue_push((PriorityQueue*)pq, data);                  \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_priority_queue_peek(typename##_PriorityQueue* pq) { \
+        return (type*)priority_queue_peek((PriorityQueue*)pq);          \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_priority_queue_pop(typename##_PriorityQueue* pq, type* out) { \
+        return priority_queue_pop((PriorityQueue*)pq, out);             \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_priority_queue_replace_top(typename##_PriorityQueue* pq, type* data, type* out) { \
+        return priority_queue_replace_top((PriorityQueue*)pq, data, out); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_priority_queue_length(typename##_PriorityQueue* pq) { \
+        return priority_queue_length(pq);                               \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_PRIORITY_QUEUE_H
@@ -0,0 +1,115 @@
+/**
+ * @file Queue.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of queues for any type.
+ *
+ * This file defines two macros, each defining both a single producer single
+ * consumer and a multi producer multi consumer queue of a type :
+ * - DEF_INTEGER_QUEUE_INTERFACE (integers and pointers, pushed by value)
+ * - DEF_STRUCT_QUEUE_INTERFACE (structs, pushed by address)
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_QUEUE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_QUEUE_H
+
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+
+/**
+ * @def DEF_QUEUE_KIND_INTERFACE
+ * @brief Define functions common to integer and struct queues of one kind.
+ *
+ * @param kind Lowercase kind of queue, `spsc` or `mpmc`.
+ * @param Kind Type name of kind of queue, `Spsc` or `Mpmc`.
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the queue.
+ * @param type The type of elements stored in the queue.
+ */
+#define DEF_QUEUE_KIND_INTERFACE(kind, Kind, api_prefix, typename, type) \
+    typedef Kind##Queue typename##_##Kind##Queue;                       \
+                                                                        \
+    static FORCE_INLINE typename##_##Kind##Queue* api_prefix##_##kind##_queue_create(Size capacity) { \
+        return kind##_queue_create(sizeof(type), capacity);             \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE typename##_##Kind##Queue* api_prefix##_##kind##_queue_create_with_allocator(Size capacity, Allocator* allocator) { \
+        return kind##_queue_create_with_allocator(sizeof(type), capacity, allocator); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_##kind##_queue_destroy(typename##_##Kind##Queue* q) { \
+        kind##_queue_destroy(q);                                        \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_##kind##_queue_pop(typename##_##Kind##Queue* q, type* value) { \
+        return kind##_queue_pop(q, value);                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Size api_prefix##_##kind##_queue_push_batch(typename##_##Kind##Queue* q, const type* values, Size count) { \
+        return kind##_queue_push_batch(q, values, count);               \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Size api_prefix##_##kind##_queue_pop_batch(typename##_##Kind##Queue* q, type* values, Size count) { \
+        return kind##_queue_pop_batch(q, values, count);                \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Size api_prefix##_##kind##_queue_length(typename##_##Kind##Queue* q) { \
+        return kind##_queue_length(q);                                  \
+    }
+
+/**
+ * @def DEF_INTEGER_QUEUE_INTERFACE
+ * @brief Define the Integer Queue Container Interface, values are pushed by value.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the integer queues.
+ * @param type The type of integer elements stored in the queues.
+ */
+#define DEF_INTEGER_QUEUE_INTERFACE(api_prefix, typename, type)         \
+    DEF_QUEUE_KIND_INTERFACE(spsc, Spsc, api_prefix, typename, type)    \
+    DEF_QUEUE_KIND_INTERFACE(mpmc, Mpmc, api_prefix, typename, type)    \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_spsc_queue_push(typename##_SpscQueue* q, type value) { \
+        return spsc_queue_push(q, &value);                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_mpmc_queue_push(typename##_MpmcQueue* q, type value) { \
+        return mpmc_queue_push(q, &value);                              \
+    }
+
+/**
+ * @def DEF_STRUCT_QUEUE_INTERFACE
+ * @brief Define the Struct Queue Container Interface, values are pushed by address.
+ *
+ * @param api_prefix The API prefix for functions.
+ * @param typename The typename for the queues.
+ * @param type The type of elements stored in the queues.
+ */
+#define DEF_STRUCT_QUEUE_INTERFACE(api_prefix, typename, type)          \
+    DEF_QUEUE_KIND_INTERFACE(spsc, Spsc, api_prefix, typename, type)    \
+    DEF_QUEUE_KIND_INTERFACE(mpmc, Mpmc, api_prefix, typename, type)    \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_spsc_queue_push(typename##_SpscQueue* q, const type* value) { \
+        return spsc_queue_push(q, value);                               \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE Bool api_prefix##_mpmc_queue_push(typename##_MpmcQueue* q, const type* value) { \
+        return mpmc_queue_push(q, value);                               \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_QUEUE_H
@@ -0,0 +1,69 @@
+/**
+ * @file RadixTree.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of radix trees for
+ * any data type.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_RADIX_TREE_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_RADIX_TREE_H
+
+#define DEF_INTEGER_RADIX_TREE_INTERFACE(prefix, type) DEF_INTEGER_RADIX_TREE_INTERFACE_WITH_COPY_AND_DESTROY(prefix, type, NULL, NULL)
+
+/**
+ * Define typed wrappers over @c RadixTree for data of given type, that fits
+ * in 8 bytes. Key type is chosen per call, so only calls taking or returning
+ * data are wrapped.
+ * @param prefix What prefix to add before each @c RadixTree api call?
+ * @param type Type of data.
+ * @param copy Copy constructor callback for data.
+ * @param destroy Copy destructor callback for data.
+ * */
+#define DEF_INTEGER_RADIX_TREE_INTERFACE_WITH_COPY_AND_DESTROY(prefix, type, copy, destroy) \
+    static FORCE_INLINE RadixTree* prefix##_radix_tree_create() {       \
+        return radix_tree_create(sizeof(type),                          \
+                                 (CreateElementCopyCallback)(void*)copy, \
+                                 (DestroyElementCopyCallback)(void*)destroy); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type prefix##_radix_tree_leaf_value(RadixTreeLeaf* leaf) { \
+        return (type)(Uint64)leaf->data;                                \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE RadixTreeLeaf* prefix##_radix_tree_insert(RadixTree* tree, const void* key, Size key_length, type data, void* udata) { \
+        return radix_tree_insert(tree, key, key_length, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE RadixTreeLeaf* prefix##_radix_tree_insert_zstr(RadixTree* tree, ZString key, type data, void* udata) { \
+        return radix_tree_insert_zstr(tree, key, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE RadixTreeLeaf* prefix##_radix_tree_insert_strview(RadixTree* tree, StringView key, type data, void* udata) { \
+        return radix_tree_insert_strview(tree, key, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE RadixTreeLeaf* prefix##_radix_tree_insert_u64(RadixTree* tree, Uint64 key, type data, void* udata) { \
+        return radix_tree_insert_u64(tree, key, (void*)(Uint64)data, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE RadixTreeLeaf* prefix##_radix_tree_insert_i64(RadixTree* tree, Int64 key, type data, void* udata) { \
+        return radix_tree_insert_i64(tree, key, (void*)(Uint64)data, udata); \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_RADIX_TREE_H
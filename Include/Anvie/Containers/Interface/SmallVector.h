@@ -0,0 +1,92 @@
+/**
+ * @file SmallVector.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macro to create small vectors on top of an already
+ * defined typed vector interface.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_SMALL_VECTOR_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_SMALL_VECTOR_H
+
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <stddef.h>
+
+/**
+ * @def DEF_SMALL_VECTOR_INTERFACE
+ * @brief Define a small vector holding up to N elements inline.
+ *
+ * Vector interface for @p vector_typename must already be defined. Use
+ * @c api_prefix##_small_vector_as_vector to get the typed vector and use
+ * it with rest of the typed vector API.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32x8`).
+ * @param typename The typename for small vector type. Resulting type is `typename##_SmallVector`.
+ * @param vector_typename Typename of the vector interface (e.g., `U32` for `U32_Vector`).
+ * @param type The type of elements.
+ * @param N Number of elements stored inline. Must be at least 1.
+ * @param copy Copy constructor for elements, or NULL.
+ * @param destroy Copy destructor for elements, or NULL.
+ */
+#define DEF_SMALL_VECTOR_INTERFACE(api_prefix, typename, vector_typename, type, N, copy, destroy) \
+    typedef struct typename##_SmallVector {                             \
+        vector_typename##_Vector vec;                                   \
+        Allocator                allocator;                             \
+        Allocator*               parent;                                \
+        void*                    storage;                               \
+        Size                     storage_size;                          \
+        type                     inline_data[N];                        \
+    } typename##_SmallVector;                                           \
+                                                                        \
+    FORCE_INLINE void api_prefix##_small_vector_init(typename##_SmallVector* sv, Allocator* parent) { \
+        small_vector_init((SmallVector*)sv, sizeof(type),               \
+                          (CreateElementCopyCallback)(void*)(copy),     \
+                          (DestroyElementCopyCallback)(void*)(destroy), \
+                          sv->inline_data, N, parent);                  \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_small_vector_deinit(typename##_SmallVector* sv, void* udata) { \
+        small_vector_deinit((SmallVector*)sv, udata);                   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_SmallVector* api_prefix##_small_vector_create_with_allocator(Allocator* parent) { \
+        return (typename##_SmallVector*)small_vector_create(sizeof(typename##_SmallVector), \
+                          offsetof(typename##_SmallVector, inline_data), sizeof(type), \
+                          (CreateElementCopyCallback)(void*)(copy),     \
+                          (DestroyElementCopyCallback)(void*)(destroy), \
+                          N, parent);                                   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_SmallVector* api_prefix##_small_vector_create() { \
+        return api_prefix##_small_vector_create_with_allocator(NULL);   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_small_vector_destroy(typename##_SmallVector* sv, void* udata) { \
+        small_vector_destroy((SmallVector*)sv, sizeof(typename##_SmallVector), udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE vector_typename##_Vector* api_prefix##_small_vector_as_vector(typename##_SmallVector* sv) { \
+        return &sv->vec;                                                \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_small_vector_is_inline(typename##_SmallVector* sv) { \
+        return small_vector_is_inline(sv);                              \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_SMALL_VECTOR_H
@@ -0,0 +1,146 @@
+/**
+ * @file SoaVector.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines macros that'll help in quick creation of struct of arrays
+ * vectors for any record type.
+ *
+ * Fields of a record are given as an X-macro, that applies it's argument
+ * to each `(type, name)` pair :
+ *
+ * @code
+ * #define PARTICLE_FIELDS(FIELD) \
+ *     FIELD(Float32, x)          \
+ *     FIELD(Float32, y)          \
+ *     FIELD(Uint64, timestamp)
+ *
+ * DEF_SOA_VECTOR_INTERFACE(particle, Particle, PARTICLE_FIELDS);
+ * @endcode
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_INTERFACE_SOA_VECTOR_H
+#define ANVIE_UTILS_CONTAINERS_INTERFACE_SOA_VECTOR_H
+
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <stddef.h>
+
+/* applied to each field of a field list by DEF_SOA_VECTOR_INTERFACE */
+#define SOA_VECTOR_ROW_MEMBER(type, name) type name;
+#define SOA_VECTOR_COLUMN_MEMBER(type, name) type* name;
+#define SOA_VECTOR_COLUMN_SIZE(type, name) sizeof(type),
+#define SOA_VECTOR_STORE_FIELD(type, name) soa->name[pos] = row->name;
+#define SOA_VECTOR_LOAD_FIELD(type, name) row.name = soa->name[pos];
+
+/**
+ * @def soa_vector_column_index
+ * @brief Get index of column storing given field, in a typed SoA vector.
+ *
+ * @param soa Pointer to a typed SoA vector.
+ * @param field Name of field.
+ */
+#define soa_vector_column_index(soa, field)                             \
+    ((offsetof(__typeof__(*(soa)), field) - offsetof(SoaVector, columns)) / sizeof(void*))
+
+/**
+ * @def DEF_SOA_VECTOR_INTERFACE
+ * @brief Define a struct of arrays vector for records with given fields.
+ *
+ * Defines `typename##_SoaRow`, a plain struct with all fields, and
+ * `typename##_SoaVector`, which has same layout as generic SoaVector
+ * followed by one typed column pointer per field. Columns can be accessed
+ * directly, eg : `soa->timestamp[i]`, and passed to SIMD kernels as is.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `particle`).
+ * @param typename The typename for the SoA vector container.
+ * @param fields X-macro listing `FIELD(type, name)` of each field.
+ */
+#define DEF_SOA_VECTOR_INTERFACE(api_prefix, typename, fields)          \
+    typedef struct typename##_SoaRow {                                  \
+        fields(SOA_VECTOR_ROW_MEMBER)                                   \
+    } typename##_SoaRow;                                                \
+                                                                        \
+    typedef struct typename##_SoaVector {                               \
+        Size       length;                                              \
+        Size       capacity;                                            \
+        Size       column_count;                                        \
+        Size*      column_sizes;                                        \
+        Allocator* allocator;                                           \
+        fields(SOA_VECTOR_COLUMN_MEMBER)                                \
+    } typename##_SoaVector;                                             \
+                                                                        \
+    FORCE_INLINE typename##_SoaVector* api_prefix##_soa_vector_create_with_allocator(Allocator* allocator) { \
+        Size sizes[] = { fields(SOA_VECTOR_COLUMN_SIZE) };              \
+        return (typename##_SoaVector*)soa_vector_create_with_allocator(ARRAY_SIZE(sizes), sizes, allocator); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_SoaVector* api_prefix##_soa_vector_create() { \
+        return api_prefix##_soa_vector_create_with_allocator(NULL);     \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_soa_vector_destroy(typename##_SoaVector* soa) { \
+        soa_vector_destroy((SoaVector*)soa);                            \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_soa_vector_reserve(typename##_SoaVector* soa, Size capacity) { \
+        return soa_vector_reserve((SoaVector*)soa, capacity);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_soa_vector_clear(typename##_SoaVector* soa) { \
+        soa_vector_clear((SoaVector*)soa);                              \
+    }                                                                   \
+                                                                        \
+    /* row at pos must exist */                                         \
+    FORCE_INLINE void api_prefix##_soa_vector_set(typename##_SoaVector* soa, Size pos, const typename##_SoaRow* row) { \
+        fields(SOA_VECTOR_STORE_FIELD)                                  \
+    }                                                                   \
+                                                                        \
+    /* row at pos must exist */                                         \
+    FORCE_INLINE typename##_SoaRow api_prefix##_soa_vector_peek(typename##_SoaVector* soa, Size pos) { \
+        typename##_SoaRow row;                                          \
+        fields(SOA_VECTOR_LOAD_FIELD)                                   \
+        return row;                                                     \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_soa_vector_push_back(typename##_SoaVector* soa, const typename##_SoaRow* row) { \
+        Size pos = soa_vector_extend((SoaVector*)soa, 1);               \
+        if(pos == SIZE_MAX) return False;                               \
+        api_prefix##_soa_vector_set(soa, pos, row);                     \
+        return True;                                                    \
+    }                                                                   \
+                                                                        \
+    /* vector must not be empty */                                      \
+    FORCE_INLINE typename##_SoaRow api_prefix##_soa_vector_pop_back(typename##_SoaVector* soa) { \
+        typename##_SoaRow row = api_prefix##_soa_vector_peek(soa, soa->length - 1); \
+        soa_vector_pop_back((SoaVector*)soa);                           \
+        return row;                                                     \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_soa_vector_extend(typename##_SoaVector* soa, Size count) { \
+        return soa_vector_extend((SoaVector*)soa, count);               \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_soa_vector_swap(typename##_SoaVector* soa, Size p1, Size p2) { \
+        soa_vector_swap((SoaVector*)soa, p1, p2);                       \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_soa_vector_sort_by_column(typename##_SoaVector* soa, Size col, CompareElementCallback compare, void* udata) { \
+        soa_vector_sort_by_column((SoaVector*)soa, col, compare, udata); \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_INTERFACE_SOA_VECTOR_H
@@ -104,6 +104,7 @@
         ktype key __attribute__((aligned(8)));                          \
         dtype data __attribute__((aligned(8)));                         \
         ktname##_##dtname##_SparseMapItem* next __attribute__((aligned(8))); \
+        Size hash __attribute__((aligned(8)));                          \
     } ktname##_##dtname##_SparseMapItem;                                \
     DEF_STRUCT_VECTOR_INTERFACE(pfx##_smi, ktname##_##dtname##_Smi, ktname##_##dtname##_SparseMapItem, create_smi_copy, destroy_smi_copy); \
                                                                         \
@@ -127,6 +128,9 @@
         Size                          item_count;                       \
         BitVector*                    occupancy;                        \
         ktname##_##dtname##_Smi_Vector*   map;                          \
+        Allocator*                      allocator;                      \
+        LinBlockAllocator*              node_pool;                      \
+        Bool                            owns_node_pool;                 \
     } ktname##_##dtname##_SparseMap;                                            \
                                                                         \
     static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create() { \
@@ -141,6 +145,30 @@
                                                                  is_mm, max_lf); \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_allocator(Allocator* allocator) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, NULL); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_node_pool(Allocator* allocator, LinBlockAllocator* node_pool) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, node_pool); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void pfx##_sparse_map_destroy(ktname##_##dtname##_SparseMap* map, void* udata) { \
         sparse_map_destroy((SparseMap*)map, udata);                     \
     }                                                                   \
@@ -159,6 +187,22 @@
                                                                         \
     static FORCE_INLINE void pfx##_sparse_map_delete(ktname##_##dtname##_SparseMap* map, ktype key, void* udata) { \
         sparse_map_delete((SparseMap*)map, (void*)(Uint64)key, udata);  \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMapItem* pfx##_sparse_map_iter_next(ktname##_##dtname##_SparseMap* map, SparseMapIterator* iter) { \
+        return (ktname##_##dtname##_SparseMapItem*)sparse_map_iter_next((SparseMap*)map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_foreach(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_foreach((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_clear(ktname##_##dtname##_SparseMap* map, void* udata) { \
+        sparse_map_clear((SparseMap*)map, udata);                       \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_drain(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_drain((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #define DEF_STRUCT_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(pfx, type_prefix, hash, ktype, k_cpy_ctr, k_cpy_dtr, k_cmp, dtype, d_cpy_ctr, d_cpy_dtr, is_mm, max_lf) \
@@ -178,6 +222,7 @@
         ktype* key __attribute__((aligned(8)));                         \
         dtype  data __attribute__((aligned(8)));                        \
         ktname##_##dtname##_SparseMapItem* next __attribute__((aligned(8))); \
+        Size hash __attribute__((aligned(8)));                          \
     } ktname##_##dtname##_SparseMapItem;                                \
     DEF_STRUCT_VECTOR_INTERFACE(pfx##_smi, ktname##_##dtname##_Smi, ktname##_##dtname##_SparseMapItem, create_smi_copy, destroy_smi_copy); \
                                                                         \
@@ -201,6 +246,9 @@
         Size                            item_count;                     \
         BitVector*                      occupancy;                      \
         ktname##_##dtname##_Smi_Vector* map;                            \
+        Allocator*                      allocator;                      \
+        LinBlockAllocator*              node_pool;                      \
+        Bool                            owns_node_pool;                 \
     } ktname##_##dtname##_SparseMap;                                    \
                                                                         \
     static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create() { \
@@ -215,6 +263,30 @@
                                                                  is_mm, max_lf); \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_allocator(Allocator* allocator) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, NULL); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_node_pool(Allocator* allocator, LinBlockAllocator* node_pool) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, node_pool); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void pfx##_sparse_map_destroy(ktname##_##dtname##_SparseMap* map, void* udata) { \
         sparse_map_destroy((SparseMap*)map, udata);                     \
     }                                                                   \
@@ -233,6 +305,22 @@
                                                                         \
     static FORCE_INLINE void pfx##_sparse_map_delete(ktname##_##dtname##_SparseMap* map, ktype* key, void* udata) { \
         sparse_map_delete((SparseMap*)map, (void*)(Uint64)key, udata);  \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMapItem* pfx##_sparse_map_iter_next(ktname##_##dtname##_SparseMap* map, SparseMapIterator* iter) { \
+        return (ktname##_##dtname##_SparseMapItem*)sparse_map_iter_next((SparseMap*)map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_foreach(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_foreach((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_clear(ktname##_##dtname##_SparseMap* map, void* udata) { \
+        sparse_map_clear((SparseMap*)map, udata);                       \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_drain(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_drain((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #define DEF_INTEGER_STRUCT_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(pfx, type_prefix, hash, ktype, k_cpy_ctr, k_cpy_dtr, k_cmp, dtype, d_cpy_ctr, d_cpy_dtr, is_mm, max_lf) \
@@ -252,6 +340,7 @@
         ktype  key __attribute__((aligned(8)));                         \
         dtype* data __attribute__((aligned(8)));                        \
         ktname##_##dtname##_SparseMapItem* next __attribute__((aligned(8))); \
+        Size hash __attribute__((aligned(8)));                          \
     } ktname##_##dtname##_SparseMapItem;                                \
     DEF_STRUCT_VECTOR_INTERFACE(pfx##_smi, ktname##_##dtname##_Smi, ktname##_##dtname##_SparseMapItem, create_smi_copy, destroy_smi_copy); \
                                                                         \
@@ -275,6 +364,9 @@
         Size                            item_count;                     \
         BitVector*                      occupancy;                      \
         ktname##_##dtname##_Smi_Vector* map;                            \
+        Allocator*                      allocator;                      \
+        LinBlockAllocator*              node_pool;                      \
+        Bool                            owns_node_pool;                 \
     } ktname##_##dtname##_SparseMap;                                    \
                                                                         \
     static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create() { \
@@ -289,6 +381,30 @@
                                                          is_mm, max_lf); \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_allocator(Allocator* allocator) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, NULL); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_node_pool(Allocator* allocator, LinBlockAllocator* node_pool) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, node_pool); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void pfx##_sparse_map_destroy(ktname##_##dtname##_SparseMap* map, void* udata) { \
         sparse_map_destroy((SparseMap*)map, udata);                     \
     }                                                                   \
@@ -307,6 +423,22 @@
                                                                         \
     static FORCE_INLINE void pfx##_sparse_map_delete(ktname##_##dtname##_SparseMap* map, ktype key, void* udata) { \
         sparse_map_delete((SparseMap*)map, (void*)(Uint64)key, udata);  \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMapItem* pfx##_sparse_map_iter_next(ktname##_##dtname##_SparseMap* map, SparseMapIterator* iter) { \
+        return (ktname##_##dtname##_SparseMapItem*)sparse_map_iter_next((SparseMap*)map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_foreach(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_foreach((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_clear(ktname##_##dtname##_SparseMap* map, void* udata) { \
+        sparse_map_clear((SparseMap*)map, udata);                       \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_drain(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_drain((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #define DEF_STRUCT_STRUCT_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(pfx, type_prefix, hash, ktype, k_cpy_ctr, k_cpy_dtr, k_cmp, dtype, d_cpy_ctr, d_cpy_dtr, is_mm, max_lf) \
@@ -326,6 +458,7 @@
         ktype* key __attribute__((aligned(8)));                         \
         dtype* data __attribute__((aligned(8)));                        \
         ktname##_##dtname##_SparseMapItem* next __attribute__((aligned(8))); \
+        Size hash __attribute__((aligned(8)));                          \
     } ktname##_##dtname##_SparseMapItem;                                \
     DEF_STRUCT_VECTOR_INTERFACE(pfx##_smi, ktname##_##dtname##_Smi, ktname##_##dtname##_SparseMapItem, create_smi_copy, destroy_smi_copy); \
                                                                         \
@@ -349,6 +482,9 @@
         Size                            item_count;                     \
         BitVector*                      occupancy;                      \
         ktname##_##dtname##_Smi_Vector* map;                            \
+        Allocator*                      allocator;                      \
+        LinBlockAllocator*              node_pool;                      \
+        Bool                            owns_node_pool;                 \
     } ktname##_##dtname##_SparseMap;                                    \
                                                                         \
     static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create() { \
@@ -363,6 +499,30 @@
                                                                 is_mm, max_lf); \
     }                                                                   \
                                                                         \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_allocator(Allocator* allocator) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, NULL); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMap* pfx##_sparse_map_create_with_node_pool(Allocator* allocator, LinBlockAllocator* node_pool) { \
+        return (ktname##_##dtname##_SparseMap*)sparse_map_create_with_allocator((HashCallback)(void*)hash, \
+                                                                                sizeof(ktype), \
+                                                                                (CreateElementCopyCallback)(void*)k_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)k_cpy_dtr, \
+                                                                                (CompareElementCallback)(void*)k_cmp, \
+                                                                                sizeof(dtype), \
+                                                                                (CreateElementCopyCallback)(void*)d_cpy_ctr, \
+                                                                                (DestroyElementCopyCallback)(void*)d_cpy_dtr, \
+                                                                                is_mm, max_lf, allocator, node_pool); \
+    }                                                                   \
+                                                                        \
     static FORCE_INLINE void pfx##_sparse_map_destroy(ktname##_##dtname##_SparseMap* map, void* udata) { \
         sparse_map_destroy((SparseMap*)map, udata);                     \
     }                                                                   \
@@ -381,6 +541,22 @@
                                                                         \
     static FORCE_INLINE void pfx##_sparse_map_delete(ktname##_##dtname##_SparseMap* map, ktype* key, void* udata) { \
         sparse_map_delete((SparseMap*)map, (void*)(Uint64)key, udata);  \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE ktname##_##dtname##_SparseMapItem* pfx##_sparse_map_iter_next(ktname##_##dtname##_SparseMap* map, SparseMapIterator* iter) { \
+        return (ktname##_##dtname##_SparseMapItem*)sparse_map_iter_next((SparseMap*)map, iter); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_foreach(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_foreach((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_clear(ktname##_##dtname##_SparseMap* map, void* udata) { \
+        sparse_map_clear((SparseMap*)map, udata);                       \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void pfx##_sparse_map_drain(ktname##_##dtname##_SparseMap* map, void (*visitor)(ktname##_##dtname##_SparseMapItem* item, void* udata), void* udata) { \
+        sparse_map_drain((SparseMap*)map, (SparseMapVisitorCallback)(void*)visitor, udata); \
     }
 
 #endif // ANVIE_UTILS_CONTAINERS_SPARSE_MAP_INTERFACE_H
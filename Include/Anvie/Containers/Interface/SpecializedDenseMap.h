@@ -0,0 +1,302 @@
+/**
+ * @file SpecializedDenseMap.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Builder for @c DenseMap variants specialized at compile time
+ * for one key and data type. No function pointers are involved : hash,
+ * key equality and copies of keys and data are expanded inline, so the
+ * compiler sees the whole probe loop.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_SPECIALIZED_DENSE_MAP_INTERFACE_H
+#define ANVIE_UTILS_CONTAINERS_SPECIALIZED_DENSE_MAP_INTERFACE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Arithmetic.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <string.h>
+
+/**
+ * Metadata layout is same as that of @c DenseMap : highest bit marks an
+ * occupied slot, lower 7 bits are lower 7 bits of mixed hash. Groups are
+ * always one 64 bit word wide here, so that this header needs no SIMD
+ * headers, and group matching is plain integer code that inlines anywhere.
+ * */
+#define SPECIALIZED_DENSE_MAP_GROUP_SIZE 8
+#define SPECIALIZED_DENSE_MAP_INITIAL_SIZE 64
+#define SPECIALIZED_DENSE_MAP_MAX_LOAD_FACTOR 0.9375f
+#define SPECIALIZED_DENSE_MAP_MDATA_EMPTY ((Uint8)0x00)
+#define SPECIALIZED_DENSE_MAP_MDATA_DELETED ((Uint8)0x7f)
+#define SPECIALIZED_DENSE_MAP_MDATA_OF(hash) ((Uint8)(0x80 | ((hash) & 0x7f)))
+
+/* slot in group of lowest matching byte of a non-zero group mask */
+#define SPECIALIZED_DENSE_MAP_GROUP_SLOT(mask) ((Size)__builtin_ctzll(mask) >> 3)
+
+/* hash and equality for integer and pointer keys, to be passed to DEF_SPECIALIZED_DENSE_MAP */
+#define SPECIALIZED_DENSE_MAP_INTEGER_HASH(key) ((Uint64)(key))
+#define SPECIALIZED_DENSE_MAP_INTEGER_EQUAL(k1, k2) ((k1) == (k2))
+
+/* finalizer of splitmix64, applied to every user hash just like in DenseMap */
+static FORCE_INLINE Uint64 specialized_dense_map_mix(Uint64 x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/* highest bit of each byte in group whose metadata is exactly given byte */
+static FORCE_INLINE Uint64 specialized_dense_map_group_match(const Uint8* group, Uint8 mdata) {
+    Uint64 word;
+    memcpy(&word, group, sizeof(word));
+    Uint64 x = word ^ (0x0101010101010101ull * mdata);
+    Uint64 y = (x & 0x7f7f7f7f7f7f7f7full) + 0x7f7f7f7f7f7f7f7full;
+    return ~(y | x | 0x7f7f7f7f7f7f7f7full);
+}
+
+/* highest bit of each byte in group that is empty or deleted */
+static FORCE_INLINE Uint64 specialized_dense_map_group_match_free(const Uint8* group) {
+    Uint64 word;
+    memcpy(&word, group, sizeof(word));
+    return ~word & 0x8080808080808080ull;
+}
+
+/* first empty or deleted slot in probe sequence of given mixed hash, SIZE_MAX if none */
+static FORCE_INLINE Size specialized_dense_map_find_free_slot(const Uint8* mdata, Size length, Uint64 hash) {
+    Size group_mask = length / SPECIALIZED_DENSE_MAP_GROUP_SIZE - 1;
+    Size group      = (hash >> 7) & group_mask;
+
+    for(Size step = 1; step <= group_mask + 1; step++) {
+        Uint64 free = specialized_dense_map_group_match_free(mdata + group * SPECIALIZED_DENSE_MAP_GROUP_SIZE);
+        if(free) {
+            return group * SPECIALIZED_DENSE_MAP_GROUP_SIZE + SPECIALIZED_DENSE_MAP_GROUP_SLOT(free);
+        }
+        group = (group + step) & group_mask;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Define a @c DenseMap specialized for given key and data types.
+ *
+ * Generated map has same probing scheme as @c DenseMap and same api names as
+ * maps defined by @c DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE, so switching a
+ * map over is a matter of changing the line that defines it. Differences :
+ * - keys and data are stored by value in slots. They are copied by assignment
+ *   and never destroyed, so both must be plain-old-data. Pointer keys and
+ *   data are stored as pointers, map never owns what they point to.
+ * - @p hash and @p equal are expanded inline. Each can be a function or
+ *   a function-like macro : `Uint64 hash(ktype key)` and `Bool equal(ktype k1, ktype k2)`.
+ *   Hash is mixed before use, so an identity hash is fine for integer keys.
+ *   Use a seeded hash like @c hash_u64_seeded when keys can be chosen by others.
+ * - @c udata arguments are unused, and kept only to match @c DenseMap api.
+ * - there is no Bloom filter support.
+ *
+ * @param api_prefix What prefix to add before each api call?
+ * @param type_prefix What prefix to add before map and item types?
+ * @param ktype Type of key.
+ * @param dtype Type of data.
+ * @param hash Hash function or macro of key.
+ * @param equal Key equality function or macro.
+ * @param is_multimap True when multiple items with same key can coexist.
+ * @param max_load_factor Maximum load factor before map is resized.
+ * */
+#define DEF_SPECIALIZED_DENSE_MAP(api_prefix, type_prefix, ktype, dtype, hash, equal, is_multimap, max_load_factor) \
+    typedef struct type_prefix##DenseMapItem {                          \
+        ktype key;                                                      \
+        dtype data;                                                     \
+    } type_prefix##DenseMapItem;                                        \
+                                                                        \
+    typedef struct type_prefix##DenseMap {                              \
+        Size                       length; /**< Number of slots, a power of two. */ \
+        Size                       item_count; /**< Number of occupied slots. */ \
+        Size                       tombstone_count; /**< Number of deleted slots. */ \
+        Uint8*                     metadata; /**< One metadata byte per slot. */ \
+        type_prefix##DenseMapItem* items; /**< Slots, valid only where metadata is occupied. */ \
+        Allocator*                 allocator; /**< Allocator for all memory of map, NULL for system allocator. */ \
+    } type_prefix##DenseMap;                                            \
+                                                                        \
+    /* move all items to a fresh table of given size, dropping tombstones */ \
+    static inline Bool api_prefix##_dense_map_rehash_(type_prefix##DenseMap* map, Size size) { \
+        Uint8* mdata = allocator_allocate_zeroed(map->allocator, size); \
+        ERR_RETURN_VALUE_IF_FAIL(mdata, False, ERR_OUT_OF_MEMORY);      \
+        type_prefix##DenseMapItem* items = allocator_allocate(map->allocator, size * sizeof(type_prefix##DenseMapItem)); \
+        if(!items) {                                                    \
+            allocator_free(map->allocator, mdata, size);                \
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));       \
+            return False;                                               \
+        }                                                               \
+                                                                        \
+        for(Size s = 0; s < map->length; s++) {                         \
+            if(!(map->metadata[s] & 0x80)) {                            \
+                continue;                                               \
+            }                                                           \
+            Uint64 h    = specialized_dense_map_mix(hash(map->items[s].key)); \
+            Size   slot = specialized_dense_map_find_free_slot(mdata, size, h); \
+            items[slot] = map->items[s];                                \
+            mdata[slot] = SPECIALIZED_DENSE_MAP_MDATA_OF(h);            \
+        }                                                               \
+                                                                        \
+        if(map->metadata) {                                             \
+            allocator_free(map->allocator, map->metadata, map->length); \
+            allocator_free(map->allocator, map->items, map->length * sizeof(type_prefix##DenseMapItem)); \
+        }                                                               \
+        map->metadata        = mdata;                                   \
+        map->items           = items;                                   \
+        map->length          = size;                                    \
+        map->tombstone_count = 0;                                       \
+        return True;                                                    \
+    }                                                                   \
+                                                                        \
+    /* first slot holding given key, SIZE_MAX if not present */        \
+    static FORCE_INLINE Size api_prefix##_dense_map_find_slot_(type_prefix##DenseMap* map, ktype key, Uint64 h) { \
+        const Uint8* mdata      = map->metadata;                        \
+        const Uint8  this_mdata = SPECIALIZED_DENSE_MAP_MDATA_OF(h);    \
+        Size         group_mask = map->length / SPECIALIZED_DENSE_MAP_GROUP_SIZE - 1; \
+        Size         group      = (h >> 7) & group_mask;                \
+                                                                        \
+        for(Size step = 1; step <= group_mask + 1; step++) {            \
+            const Uint8* gmdata = mdata + group * SPECIALIZED_DENSE_MAP_GROUP_SIZE; \
+            for(Uint64 match = specialized_dense_map_group_match(gmdata, this_mdata); match; match &= match - 1) { \
+                Size slot = group * SPECIALIZED_DENSE_MAP_GROUP_SIZE + SPECIALIZED_DENSE_MAP_GROUP_SLOT(match); \
+                if(equal(map->items[slot].key, key)) {                  \
+                    return slot;                                        \
+                }                                                       \
+            }                                                           \
+            if(specialized_dense_map_group_match(gmdata, SPECIALIZED_DENSE_MAP_MDATA_EMPTY)) { \
+                break;                                                  \
+            }                                                           \
+            group = (group + step) & group_mask;                        \
+        }                                                               \
+                                                                        \
+        return SIZE_MAX;                                                \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create_with_allocator(Allocator* allocator) { \
+        type_prefix##DenseMap* map = allocator_allocate_zeroed(allocator, sizeof(type_prefix##DenseMap)); \
+        ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_OUT_OF_MEMORY);         \
+        map->allocator = allocator;                                     \
+        if(!api_prefix##_dense_map_rehash_(map, SPECIALIZED_DENSE_MAP_INITIAL_SIZE)) { \
+            allocator_free(allocator, map, sizeof(type_prefix##DenseMap)); \
+            return NULL;                                                \
+        }                                                               \
+        return map;                                                     \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMap* api_prefix##_dense_map_create() { \
+        return api_prefix##_dense_map_create_with_allocator(NULL);      \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_destroy(type_prefix##DenseMap* map, void* udata) { \
+        UNUSED(udata);                                                  \
+        ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);                 \
+        if(!allocator_needs_free(map->allocator)) {                     \
+            return;                                                     \
+        }                                                               \
+        allocator_free(map->allocator, map->metadata, map->length);     \
+        allocator_free(map->allocator, map->items, map->length * sizeof(type_prefix##DenseMapItem)); \
+        allocator_free(map->allocator, map, sizeof(type_prefix##DenseMap)); \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_resize(type_prefix##DenseMap* map, Size size, void* udata) { \
+        UNUSED(udata);                                                  \
+        ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);                 \
+        if(size <= map->item_count || size <= map->length) {            \
+            return;                                                     \
+        }                                                               \
+        api_prefix##_dense_map_rehash_(map, NEXT_POW2(size));           \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_insert(type_prefix##DenseMap* map, ktype key, dtype data, void* udata) { \
+        UNUSED(udata);                                                  \
+        ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);     \
+        Uint64 h = specialized_dense_map_mix(hash(key));                \
+                                                                        \
+        if(!(is_multimap)) {                                            \
+            Size slot = api_prefix##_dense_map_find_slot_(map, key, h); \
+            if(slot != SIZE_MAX) {                                      \
+                map->items[slot].data = data;                           \
+                return map->items + slot;                               \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        Float32 load_factor = MIN((Float32)(max_load_factor), SPECIALIZED_DENSE_MAP_MAX_LOAD_FACTOR); \
+        if((Float32)(map->item_count + map->tombstone_count + 1) > load_factor * (Float32)map->length) { \
+            Bool grow = (Float32)(map->item_count + 1) > load_factor * (Float32)map->length / 2; \
+            ERR_RETURN_VALUE_IF_FAIL(api_prefix##_dense_map_rehash_(map, grow ? map->length * 2 : map->length), \
+                                     NULL, ERR_OPERATION_FAILED);       \
+        }                                                               \
+                                                                        \
+        Size slot = specialized_dense_map_find_free_slot(map->metadata, map->length, h); \
+        ERR_RETURN_VALUE_IF_FAIL(slot != SIZE_MAX, NULL, ERR_OPERATION_FAILED); \
+        if(map->metadata[slot] == SPECIALIZED_DENSE_MAP_MDATA_DELETED) { \
+            map->tombstone_count--;                                     \
+        }                                                               \
+        map->metadata[slot]   = SPECIALIZED_DENSE_MAP_MDATA_OF(h);      \
+        map->items[slot].key  = key;                                    \
+        map->items[slot].data = data;                                   \
+        map->item_count++;                                              \
+        return map->items + slot;                                       \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE type_prefix##DenseMapItem* api_prefix##_dense_map_search(type_prefix##DenseMap* map, ktype key, void* udata) { \
+        UNUSED(udata);                                                  \
+        ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);     \
+        Size slot = api_prefix##_dense_map_find_slot_(map, key, specialized_dense_map_mix(hash(key))); \
+        return slot == SIZE_MAX ? NULL : map->items + slot;             \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void api_prefix##_dense_map_delete(type_prefix##DenseMap* map, ktype key, void* udata) { \
+        UNUSED(udata);                                                  \
+        ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);                 \
+        Uint64 h          = specialized_dense_map_mix(hash(key));       \
+        Uint8* mdata      = map->metadata;                              \
+        Size   group_mask = map->length / SPECIALIZED_DENSE_MAP_GROUP_SIZE - 1; \
+        Size   group      = (h >> 7) & group_mask;                      \
+                                                                        \
+        for(Size step = 1; step <= group_mask + 1; step++) {            \
+            Uint8* gmdata = mdata + group * SPECIALIZED_DENSE_MAP_GROUP_SIZE; \
+            Uint64 empty  = specialized_dense_map_group_match(gmdata, SPECIALIZED_DENSE_MAP_MDATA_EMPTY); \
+            for(Uint64 match = specialized_dense_map_group_match(gmdata, SPECIALIZED_DENSE_MAP_MDATA_OF(h)); match; match &= match - 1) { \
+                Size slot = group * SPECIALIZED_DENSE_MAP_GROUP_SIZE + SPECIALIZED_DENSE_MAP_GROUP_SLOT(match); \
+                if(!equal(map->items[slot].key, key)) {                 \
+                    continue;                                           \
+                }                                                       \
+                map->item_count--;                                      \
+                if(empty) {                                             \
+                    mdata[slot] = SPECIALIZED_DENSE_MAP_MDATA_EMPTY;    \
+                } else {                                                \
+                    mdata[slot] = SPECIALIZED_DENSE_MAP_MDATA_DELETED;  \
+                    map->tombstone_count++;                             \
+                }                                                       \
+                if(!(is_multimap)) {                                    \
+                    return;                                             \
+                }                                                       \
+            }                                                           \
+            if(empty) {                                                 \
+                return;                                                 \
+            }                                                           \
+            group = (group + step) & group_mask;                        \
+        }                                                               \
+    }
+
+#endif // ANVIE_UTILS_CONTAINERS_SPECIALIZED_DENSE_MAP_INTERFACE_H
@@ -24,14 +24,20 @@
  * - DEF_INTEGER_VECTOR_INTERFACE (integers)
  * - DEF_INTEGER_VECTOR_INTERFACE_WITH_COPY_AND_DESTROY (mostly pointers)
  * - DEF_STRUCT_VECTOR_INTERFACE (structs)
+ *
+ * and DEF_NUMERIC_VECTOR_SORT_INTERFACE to add comparator free sorts
+ * to an already defined numeric vector.
  * */
 
 #ifndef UTILS_VECTOR_INTERFACE_H
 #define UTILS_VECTOR_INTERFACE_H
 
 #include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
 #include <Anvie/Containers/Interface/Common.h>
 
+#include <string.h>
+
 /**
  * @def DEF_INTEGER_VECTOR_INTERFACE
  * @brief Define the Integer Vector Container Interface
@@ -76,8 +82,36 @@
         Create##typename##CopyCallback  create_copy;                    \
         Destroy##typename##CopyCallback destroy_copy;                   \
         Float32                         resize_factor;                  \
+        Allocator*                      allocator;                      \
+        const VectorGrowthPolicy*       growth_policy;                  \
     } typename##_Vector;                                                \
                                                                         \
+    /**
+     * Same layout as generic VectorView.
+     * */                                                               \
+    typedef struct typename##_VectorView {                              \
+        Size  element_size;                                             \
+        Size  length;                                                   \
+        type* data;                                                     \
+    } typename##_VectorView;                                            \
+                                                                        \
+    /**
+     * Elements are passed to generic vector as bits of their value in a
+     * pointer. A plain cast would convert floats to integers instead.
+     * */                                                               \
+    FORCE_INLINE void* api_prefix##_vector_value_to_ptr(type value) {   \
+        Uint64 bits = 0;                                                \
+        memcpy(&bits, &value, sizeof(type));                            \
+        return (void*)bits;                                             \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_vector_ptr_to_value(void* ptr) {     \
+        Uint64 bits = (Uint64)ptr;                                      \
+        type   value;                                                   \
+        memcpy(&value, &bits, sizeof(type));                            \
+        return value;                                                   \
+    }                                                                   \
+                                                                        \
     /**
      * Now each api wrapper is completely different from other api wrappers.
      * Because each vector type is different from other, as long
@@ -89,6 +123,13 @@
                              (DestroyElementCopyCallback)(void*)destroy); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_create_with_allocator(Allocator* allocator) { \
+        return (typename##_Vector*)vector_create_with_allocator(sizeof(type), \
+                             (CreateElementCopyCallback)(void*)(copy),  \
+                             (DestroyElementCopyCallback)(void*)destroy, \
+                             allocator);                                \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_destroy(typename##_Vector* vec, void* udata) { \
         vector_destroy((Vector*)vec, udata);                            \
     }                                                                   \
@@ -105,6 +146,14 @@
         vector_reserve((Vector*)vec, sz);                               \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_shrink_to_fit(typename##_Vector* vec) { \
+        vector_shrink_to_fit((Vector*)vec);                             \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_set_growth_policy(typename##_Vector* vec, const VectorGrowthPolicy* policy) { \
+        vector_set_growth_policy((Vector*)vec, policy);                 \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_clear(typename##_Vector* vec, void* udata) { \
         vector_clear((Vector*)vec, udata);                              \
     }                                                                   \
@@ -122,11 +171,11 @@
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_overwrite(typename##_Vector* vec, Size to, type value, void* udata) { \
-        vector_overwrite((Vector*)vec, to, (void*)(Uint64)value, udata); \
+        vector_overwrite((Vector*)vec, to, api_prefix##_vector_value_to_ptr(value), udata); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_insert(typename##_Vector* vec, type value, Size pos, void* udata) { \
-        vector_insert((Vector*)vec, (void*)(Uint64)value, pos, udata);  \
+        vector_insert((Vector*)vec, api_prefix##_vector_value_to_ptr(value), pos, udata); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_delete(typename##_Vector* vec, Size pos, void* udata) { \
@@ -134,11 +183,11 @@
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_remove(typename##_Vector* vec, Size pos) { \
-        return (type)(Uint64)vector_remove((Vector*)vec, pos);          \
+        return api_prefix##_vector_ptr_to_value(vector_remove((Vector*)vec, pos)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_insert_fast(typename##_Vector* vec, type value, Size pos, void* udata) { \
-        vector_insert_fast((Vector*)vec, (void*)(Uint64)value, pos, udata); \
+        vector_insert_fast((Vector*)vec, api_prefix##_vector_value_to_ptr(value), pos, udata); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_delete_fast(typename##_Vector* vec, Size pos, void* udata) { \
@@ -146,43 +195,64 @@
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_remove_fast(typename##_Vector* vec, Size pos) { \
-        return (type)(Uint64)vector_remove_fast((Vector*)vec, pos);     \
+        return api_prefix##_vector_ptr_to_value(vector_remove_fast((Vector*)vec, pos)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_push_front(typename##_Vector* vec, type value, void* udata) { \
-        vector_push_front((Vector*)vec, (void*)(Uint64)value, udata);   \
+        vector_push_front((Vector*)vec, api_prefix##_vector_value_to_ptr(value), udata); \
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_pop_front(typename##_Vector* vec) { \
-        return (type)(Uint64)vector_pop_front((Vector*)vec);            \
+        return api_prefix##_vector_ptr_to_value(vector_pop_front((Vector*)vec)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_push_front_fast(typename##_Vector* vec, type value, void* udata) { \
-        vector_push_front_fast((Vector*)vec, (void*)(Uint64)value, udata); \
+        vector_push_front_fast((Vector*)vec, api_prefix##_vector_value_to_ptr(value), udata); \
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_pop_front_fast(typename##_Vector* vec) { \
-        return (type)(Uint64)vector_pop_front_fast((Vector*)vec);       \
+        return api_prefix##_vector_ptr_to_value(vector_pop_front_fast((Vector*)vec)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_push_back(typename##_Vector* vec, type value, void* udata) { \
-        vector_push_back((Vector*)vec, (void*)(Uint64)value, udata);    \
+        vector_push_back((Vector*)vec, api_prefix##_vector_value_to_ptr(value), udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_push_back_n(typename##_Vector* vec, const type* array, Size count, void* udata) { \
+        vector_push_back_n((Vector*)vec, array, count, udata);          \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_insert_range(typename##_Vector* vec, Size pos, const type* array, Size count, void* udata) { \
+        vector_insert_range((Vector*)vec, pos, array, count, udata);    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_delete_range(typename##_Vector* vec, Size pos, Size count, void* udata) { \
+        vector_delete_range((Vector*)vec, pos, count, udata);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_assign_from_array(typename##_Vector* vec, const type* array, Size count, void* udata) { \
+        vector_assign_from_array((Vector*)vec, array, count, udata);    \
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_pop_back(typename##_Vector* vec) { \
-        return (type)(Uint64)vector_pop_back((Vector*)vec);             \
+        return api_prefix##_vector_ptr_to_value(vector_pop_back((Vector*)vec)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_peek(typename##_Vector* vec, Size pos) { \
-        return (type)(Uint64)vector_peek((Vector*)vec, pos);            \
+        return api_prefix##_vector_ptr_to_value(vector_peek((Vector*)vec, pos)); \
+    }                                                                   \
+                                                                        \
+    /* vec must be valid and pos in range, nothing is checked */        \
+    FORCE_INLINE type api_prefix##_vector_peek_unchecked(typename##_Vector* vec, Size pos) { \
+        return vec->data[pos];                                          \
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_front(typename##_Vector* vec) { \
-        return (type)(Uint64)vector_front((Vector*)vec);                \
+        return api_prefix##_vector_ptr_to_value(vector_front((Vector*)vec)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE type api_prefix##_vector_back(typename##_Vector* vec) { \
-        return (type)(Uint64)vector_back((Vector*)vec);                 \
+        return api_prefix##_vector_ptr_to_value(vector_back((Vector*)vec)); \
     }                                                                   \
                                                                         \
     FORCE_INLINE void api_prefix##_vector_print(typename##_Vector* vec, PrintElementCallback printer, void* udata) { \
@@ -197,6 +267,10 @@
         return (typename##_Vector*)vector_filter((Vector*)vec, (FilterElementCallback)(void*)filter, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE Size api_prefix##_vector_retain_if(typename##_Vector* vec, Filter##typename##Callback filter, void* udata) { \
+        return vector_retain_if((Vector*)vec, (FilterElementCallback)(void*)filter, udata); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_swap(typename##_Vector* vec, Size p1, Size p2) { \
         vector_swap((Vector*)vec, p1, p2);                              \
     }                                                                   \
@@ -205,6 +279,14 @@
         vector_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_partial_sort(typename##_Vector* vec, Size count, Compare##typename##Callback compare, void* udata) { \
+        vector_partial_sort((Vector*)vec, count, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_nth_element(typename##_Vector* vec, Size nth, Compare##typename##Callback compare, void* udata) { \
+        vector_nth_element((Vector*)vec, nth, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE Bool api_prefix##_vector_check_sorted(typename##_Vector* vec, Compare##typename##Callback compare, void* udata) { \
         return vector_check_sorted((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
@@ -217,10 +299,109 @@
         vector_bubble_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_stable_sort(typename##_Vector* vec, Compare##typename##Callback compare, void* udata) { \
+        vector_stable_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_stable_sort_with_buffer(typename##_Vector* vec, Compare##typename##Callback compare, void* udata, void* scratch, Size scratch_size) { \
+        vector_stable_sort_with_buffer((Vector*)vec, (CompareElementCallback)(void*)compare, udata, scratch, scratch_size); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_stable_sort_scratch_size(typename##_Vector* vec) { \
+        return vector_stable_sort_scratch_size((Vector*)vec);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_parallel_sort(typename##_Vector* vec, Compare##typename##Callback compare, void* udata, Size nthreads) { \
+        vector_parallel_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata, nthreads); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_merge_sort(typename##_Vector* vec, Compare##typename##Callback compare, void* udata) { \
         vector_merge_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE typename##_VectorView api_prefix##_vector_get_view(typename##_Vector* vec, Size start, Size size) { \
+        VectorView view = vector_get_view((Vector*)vec, start, size);   \
+        return (typename##_VectorView){view.element_size, view.length, (type*)view.data}; \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_VectorView api_prefix##_vector_view_from_array(type* data, Size length) { \
+        VectorView view = vector_view_from_array((void*)data, length, sizeof(type)); \
+        return (typename##_VectorView){view.element_size, view.length, (type*)view.data}; \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_VectorView api_prefix##_vector_view_slice(typename##_VectorView view, Size start, Size size) { \
+        VectorView slice = vector_view_slice((VectorView){view.element_size, view.length, (UByteArray)view.data}, start, size); \
+        return (typename##_VectorView){slice.element_size, slice.length, (type*)slice.data}; \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_vector_view_peek(typename##_VectorView* view, Size pos) { \
+        return api_prefix##_vector_ptr_to_value(vector_view_peek((VectorView*)view, pos)); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_vector_view_front(typename##_VectorView* view) { \
+        return api_prefix##_vector_ptr_to_value(vector_view_front((VectorView*)view)); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_vector_view_back(typename##_VectorView* view) { \
+        return api_prefix##_vector_ptr_to_value(vector_view_back((VectorView*)view)); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_view_print(typename##_VectorView* view, Print##typename##Callback printer, void* udata) { \
+        vector_view_print((VectorView*)view, (PrintElementCallback)(void*)printer, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_find(typename##_VectorView* view, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_find((VectorView*)view, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_lower_bound(typename##_Vector* vec, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_lower_bound((Vector*)vec, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_upper_bound(typename##_Vector* vec, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_upper_bound((Vector*)vec, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_binary_search(typename##_Vector* vec, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_binary_search((Vector*)vec, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_sorted_union(typename##_Vector* vec, typename##_Vector* other, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_Vector*)vector_sorted_union((Vector*)vec, (Vector*)other, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_sorted_intersect(typename##_Vector* vec, typename##_Vector* other, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_Vector*)vector_sorted_intersect((Vector*)vec, (Vector*)other, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_sorted_difference(typename##_Vector* vec, typename##_Vector* other, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_Vector*)vector_sorted_difference((Vector*)vec, (Vector*)other, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_lower_bound(typename##_VectorView* view, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_lower_bound((VectorView*)view, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_upper_bound(typename##_VectorView* view, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_upper_bound((VectorView*)view, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_binary_search(typename##_VectorView* view, type data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_binary_search((VectorView*)view, api_prefix##_vector_value_to_ptr(data), (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_view_sort(typename##_VectorView* view, Compare##typename##Callback compare, void* udata) { \
+        vector_view_sort((VectorView*)view, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_view_stable_sort(typename##_VectorView* view, Compare##typename##Callback compare, void* udata) { \
+        vector_view_stable_sort((VectorView*)view, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_vector_view_check_sorted(typename##_VectorView* view, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_check_sorted((VectorView*)view, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE type* api_prefix##_vector_data(typename##_Vector* vec) { \
         return vec ? vec->data : NULL;                                  \
     }                                                                   \
@@ -257,8 +438,19 @@
         Create##typename##CopyCallback  create_copy;                    \
         Destroy##typename##CopyCallback destroy_copy;                   \
         Float32                         resize_factor;                  \
+        Allocator*                      allocator;                      \
+        const VectorGrowthPolicy*       growth_policy;                  \
     } typename##_Vector;                                                \
                                                                         \
+    /**
+     * Same layout as generic VectorView.
+     * */                                                               \
+    typedef struct typename##_VectorView {                              \
+        Size  element_size;                                             \
+        Size  length;                                                   \
+        type* data;                                                     \
+    } typename##_VectorView;                                            \
+                                                                        \
     /**
      * Now each api wrapper is completely different from other api wrappers.
      * */                                                               \
@@ -268,6 +460,13 @@
                                                  (DestroyElementCopyCallback)(copy_destroy)); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_create_with_allocator(Allocator* allocator) { \
+        return (typename##_Vector*)vector_create_with_allocator(sizeof(type), \
+                                                 (CreateElementCopyCallback)(copy_create), \
+                                                 (DestroyElementCopyCallback)(copy_destroy), \
+                                                 allocator);            \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_destroy(typename##_Vector* vec, void* udata) { \
         vector_destroy((Vector*)vec, udata);                            \
     }                                                                   \
@@ -284,6 +483,14 @@
         vector_reserve((Vector*)vec, sz);                               \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_shrink_to_fit(typename##_Vector* vec) { \
+        vector_shrink_to_fit((Vector*)vec);                             \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_set_growth_policy(typename##_Vector* vec, const VectorGrowthPolicy* policy) { \
+        vector_set_growth_policy((Vector*)vec, policy);                 \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_clear(typename##_Vector* vec, void* udata) { \
         vector_clear((Vector*)vec, udata);                              \
     }                                                                   \
@@ -348,10 +555,109 @@
         vector_push_back((Vector*)vec, (void*)data, udata);             \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_push_back_n(typename##_Vector* vec, const type* array, Size count, void* udata) { \
+        vector_push_back_n((Vector*)vec, array, count, udata);          \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_insert_range(typename##_Vector* vec, Size pos, const type* array, Size count, void* udata) { \
+        vector_insert_range((Vector*)vec, pos, array, count, udata);    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_delete_range(typename##_Vector* vec, Size pos, Size count, void* udata) { \
+        vector_delete_range((Vector*)vec, pos, count, udata);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_assign_from_array(typename##_Vector* vec, const type* array, Size count, void* udata) { \
+        vector_assign_from_array((Vector*)vec, array, count, udata);    \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE type* api_prefix##_vector_pop_back(typename##_Vector* vec) { \
         return (type*)(Uint64)vector_pop_back((Vector*)vec);            \
     }                                                                   \
                                                                         \
+    FORCE_INLINE typename##_VectorView api_prefix##_vector_get_view(typename##_Vector* vec, Size start, Size size) { \
+        VectorView view = vector_get_view((Vector*)vec, start, size);   \
+        return (typename##_VectorView){view.element_size, view.length, (type*)view.data}; \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_VectorView api_prefix##_vector_view_from_array(type* data, Size length) { \
+        VectorView view = vector_view_from_array((void*)data, length, sizeof(type)); \
+        return (typename##_VectorView){view.element_size, view.length, (type*)view.data}; \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_VectorView api_prefix##_vector_view_slice(typename##_VectorView view, Size start, Size size) { \
+        VectorView slice = vector_view_slice((VectorView){view.element_size, view.length, (UByteArray)view.data}, start, size); \
+        return (typename##_VectorView){slice.element_size, slice.length, (type*)slice.data}; \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_vector_view_peek(typename##_VectorView* view, Size pos) { \
+        return (type*)vector_view_peek((VectorView*)view, pos); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_vector_view_front(typename##_VectorView* view) { \
+        return (type*)vector_view_front((VectorView*)view); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type* api_prefix##_vector_view_back(typename##_VectorView* view) { \
+        return (type*)vector_view_back((VectorView*)view); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_view_print(typename##_VectorView* view, Print##typename##Callback printer, void* udata) { \
+        vector_view_print((VectorView*)view, (PrintElementCallback)(void*)printer, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_find(typename##_VectorView* view, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_find((VectorView*)view, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_lower_bound(typename##_Vector* vec, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_lower_bound((Vector*)vec, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_upper_bound(typename##_Vector* vec, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_upper_bound((Vector*)vec, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_binary_search(typename##_Vector* vec, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_binary_search((Vector*)vec, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_sorted_union(typename##_Vector* vec, typename##_Vector* other, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_Vector*)vector_sorted_union((Vector*)vec, (Vector*)other, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_sorted_intersect(typename##_Vector* vec, typename##_Vector* other, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_Vector*)vector_sorted_intersect((Vector*)vec, (Vector*)other, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE typename##_Vector* api_prefix##_vector_sorted_difference(typename##_Vector* vec, typename##_Vector* other, Compare##typename##Callback compare, void* udata) { \
+        return (typename##_Vector*)vector_sorted_difference((Vector*)vec, (Vector*)other, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_lower_bound(typename##_VectorView* view, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_lower_bound((VectorView*)view, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_upper_bound(typename##_VectorView* view, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_upper_bound((VectorView*)view, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_view_binary_search(typename##_VectorView* view, type* data, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_binary_search((VectorView*)view, (void*)data, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_view_sort(typename##_VectorView* view, Compare##typename##Callback compare, void* udata) { \
+        vector_view_sort((VectorView*)view, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_view_stable_sort(typename##_VectorView* view, Compare##typename##Callback compare, void* udata) { \
+        vector_view_stable_sort((VectorView*)view, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_vector_view_check_sorted(typename##_VectorView* view, Compare##typename##Callback compare, void* udata) { \
+        return vector_view_check_sorted((VectorView*)view, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE type* api_prefix##_vector_data(typename##_Vector* vec) { \
         return vec ? vec->data : NULL;                                  \
     }                                                                   \
@@ -360,6 +666,11 @@
         return vec ? vec->data + pos : NULL;                            \
     }                                                                   \
                                                                         \
+    /* vec must be valid and pos in range, nothing is checked */        \
+    FORCE_INLINE type* api_prefix##_vector_peek_unchecked(typename##_Vector* vec, Size pos) { \
+        return vec->data + pos;                                         \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE type* api_prefix##_vector_front(typename##_Vector* vec) { \
         return (vec) ? vec->data : NULL;                                \
     }                                                                   \
@@ -380,6 +691,10 @@
         return (typename##_Vector*)vector_filter((Vector*)vec, (FilterElementCallback)(void*)filter, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE Size api_prefix##_vector_retain_if(typename##_Vector* vec, Filter##typename##Callback filter, void* udata) { \
+        return vector_retain_if((Vector*)vec, (FilterElementCallback)(void*)filter, udata); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE void api_prefix##_vector_swap(typename##_Vector* vec, Size p1, Size p2) { \
         vector_swap((Vector*)vec, p1, p2);                              \
     }                                                                   \
@@ -388,6 +703,14 @@
         vector_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_partial_sort(typename##_Vector* vec, Size count, Compare##typename##Callback compare, void* udata) { \
+        vector_partial_sort((Vector*)vec, count, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_nth_element(typename##_Vector* vec, Size nth, Compare##typename##Callback compare, void* udata) { \
+        vector_nth_element((Vector*)vec, nth, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE Bool api_prefix##_vector_check_sorted(typename##_Vector* vec, Compare##typename##Callback compare, void* udata) { \
         return vector_check_sorted((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
@@ -400,10 +723,161 @@
         vector_bubble_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
     }                                                                   \
                                                                         \
+    FORCE_INLINE void api_prefix##_vector_stable_sort(typename##_Vector* vec, Compare##typename##Callback compare, void* udata) { \
+        vector_stable_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_stable_sort_with_buffer(typename##_Vector* vec, Compare##typename##Callback compare, void* udata, void* scratch, Size scratch_size) { \
+        vector_stable_sort_with_buffer((Vector*)vec, (CompareElementCallback)(void*)compare, udata, scratch, scratch_size); \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_stable_sort_scratch_size(typename##_Vector* vec) { \
+        return vector_stable_sort_scratch_size((Vector*)vec);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_parallel_sort(typename##_Vector* vec, Compare##typename##Callback compare, void* udata, Size nthreads) { \
+        vector_parallel_sort((Vector*)vec, (CompareElementCallback)(void*)compare, udata, nthreads); \
+    }                                                                   \
+                                                                        \
     FORCE_INLINE type* api_prefix##_vector_address_at(typename##_Vector* vec, Size idx) { \
         return (type*)vector_address_at((Vector*)vec, idx);             \
     }
 
 
+/**
+ * @def DEF_NUMERIC_VECTOR_SORT_INTERFACE
+ * @brief Define comparator free sorts, partial sorts and selections for a numeric vector.
+ *
+ * Must be used after the vector interface is defined with DEF_INTEGER_VECTOR_INTERFACE,
+ * and only for the numeric types that have a matching `vector_sort_<api_prefix>`
+ * function : u8, u16, u32, u64, i8, i16, i32, i64, f32 and f64.
+ *
+ * Floats are ordered by their bit patterns, so -0.0 comes before 0.0,
+ * and NaNs end up at either end depending on their sign bit.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the vector container.
+ */
+#define DEF_NUMERIC_VECTOR_SORT_INTERFACE(api_prefix, typename)        \
+    FORCE_INLINE void api_prefix##_vector_sort_ascending(typename##_Vector* vec) { \
+        vector_sort_##api_prefix((Vector*)vec, False);                  \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_sort_descending(typename##_Vector* vec) { \
+        vector_sort_##api_prefix((Vector*)vec, True);                   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_partial_sort_ascending(typename##_Vector* vec, Size count) { \
+        vector_partial_sort_##api_prefix((Vector*)vec, count, False);   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_partial_sort_descending(typename##_Vector* vec, Size count) { \
+        vector_partial_sort_##api_prefix((Vector*)vec, count, True);    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_nth_element_ascending(typename##_Vector* vec, Size nth) { \
+        vector_nth_element_##api_prefix((Vector*)vec, nth, False);      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE void api_prefix##_vector_nth_element_descending(typename##_Vector* vec, Size nth) { \
+        vector_nth_element_##api_prefix((Vector*)vec, nth, True);       \
+    }
+
+/**
+ * @def DEF_NUMERIC_VECTOR_RETAIN_INTERFACE
+ * @brief Define in place range filters for an integer vector.
+ *
+ * Must be used after the vector interface is defined with DEF_INTEGER_VECTOR_INTERFACE,
+ * and only for the integer types that have matching `vector_retain_*_<api_prefix>`
+ * functions : u8, u16, u32, u64, i8, i16, i32 and i64.
+ *
+ * All filters keep order of retained elements and return new length of vector.
+ * 4 and 8 byte elements are filtered using SIMD compares and compress stores
+ * when AVX2 or higher is enabled.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u32`).
+ * @param typename The typename for the vector container.
+ * @param type The type of elements stored in vector.
+ */
+#define DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(api_prefix, typename, type) \
+    FORCE_INLINE Size api_prefix##_vector_retain_eq(typename##_Vector* vec, type value) { \
+        return vector_retain_eq_##api_prefix((Vector*)vec, value);      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_retain_lt(typename##_Vector* vec, type value) { \
+        return vector_retain_lt_##api_prefix((Vector*)vec, value);      \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_retain_in_range(typename##_Vector* vec, type lo, type hi) { \
+        return vector_retain_in_range_##api_prefix((Vector*)vec, lo, hi); \
+    }
+
+/**
+ * @def DEF_NUMERIC_VECTOR_SEARCH_INTERFACE
+ * @brief Define comparator free searches for a numeric vector sorted in ascending order.
+ *
+ * Must be used after the vector interface is defined with DEF_INTEGER_VECTOR_INTERFACE,
+ * and only for the numeric types that have matching `vector_*_<api_prefix>` search
+ * functions : u8, u16, u32, u64, i8, i16, i32, i64, f32 and f64.
+ *
+ * Searches are branchless and prefetch both possible next probes.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u64`).
+ * @param typename The typename for the vector container.
+ * @param type The type of elements stored in vector.
+ */
+#define DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(api_prefix, typename, type) \
+    FORCE_INLINE Size api_prefix##_vector_lower_bound_ascending(typename##_Vector* vec, type value) { \
+        return vector_lower_bound_##api_prefix((Vector*)vec, value);    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_upper_bound_ascending(typename##_Vector* vec, type value) { \
+        return vector_upper_bound_##api_prefix((Vector*)vec, value);    \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_binary_search_ascending(typename##_Vector* vec, type value) { \
+        return vector_binary_search_##api_prefix((Vector*)vec, value);  \
+    }
+
+/**
+ * @def DEF_NUMERIC_VECTOR_REDUCE_INTERFACE
+ * @brief Define linear scans and reductions for a numeric vector.
+ *
+ * Must be used after the vector interface is defined with DEF_INTEGER_VECTOR_INTERFACE,
+ * and only for the numeric types that have matching `vector_*_<api_prefix>` reduction
+ * functions : u8, u16, u32, u64, i8, i16, i32, i64, f32 and f64.
+ *
+ * Integer scans use SIMD registers when enabled. Sums are accumulated in
+ * @p sum_type and wrap around on overflow for integers.
+ *
+ * @param api_prefix The API prefix for functions (e.g., `u64`).
+ * @param typename The typename for the vector container.
+ * @param type The type of elements stored in vector.
+ * @param sum_type The type sum of elements is returned in.
+ */
+#define DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(api_prefix, typename, type, sum_type) \
+    FORCE_INLINE Size api_prefix##_vector_find(typename##_Vector* vec, type value) { \
+        return vector_find_##api_prefix((Vector*)vec, value);           \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Size api_prefix##_vector_count(typename##_Vector* vec, type value) { \
+        return vector_count_##api_prefix((Vector*)vec, value);          \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE Bool api_prefix##_vector_contains(typename##_Vector* vec, type value) { \
+        return vector_contains_##api_prefix((Vector*)vec, value);       \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_vector_min(typename##_Vector* vec) { \
+        return vector_min_##api_prefix((Vector*)vec);                   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE type api_prefix##_vector_max(typename##_Vector* vec) { \
+        return vector_max_##api_prefix((Vector*)vec);                   \
+    }                                                                   \
+                                                                        \
+    FORCE_INLINE sum_type api_prefix##_vector_sum(typename##_Vector* vec) { \
+        return vector_sum_##api_prefix((Vector*)vec);                   \
+    }
 
 #endif // UTILS_VECTOR_INTERFACE_H
@@ -0,0 +1,117 @@
+/**
+ * @file LinkedTree.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A tree whose nodes all live in one block pool and never move.
+ * Children are linked as first child and next sibling, so adding, moving
+ * or removing a child never touches it's siblings.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_LINKED_TREE_H
+#define ANVIE_UTILS_CONTAINERS_LINKED_TREE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/BlockAllocator.h>
+#include <Anvie/Containers/Common.h>
+
+/**
+ * A node of a @c LinkedTree. Node's data is stored right after it, in
+ * same pool block, so a node and it's data are a single allocation.
+ * */
+typedef struct LinkedTreeNode {
+    struct LinkedTreeNode* parent;       /**< Node this is a child of, NULL for root. */
+    struct LinkedTreeNode* first_child;  /**< First child, NULL if there are none. */
+    struct LinkedTreeNode* last_child;   /**< Last child, NULL if there are none. */
+    struct LinkedTreeNode* next_sibling; /**< Next child of parent, NULL for last child. */
+    struct LinkedTreeNode* prev_sibling; /**< Previous child of parent, NULL for first child. */
+    Size                   child_count;  /**< Number of immediate children. */
+    Uint64                 data[];       /**< Storage of node's data, @c element_size bytes. */
+} LinkedTreeNode;
+
+/**
+ * A tree with pointer stable nodes.
+ *
+ * STORAGE
+ * - every node is a block of one @c LinBlockAllocator, holding links to
+ *   it's parent, first and last child and both siblings, followed by it's data.
+ *   Blocks never move, so a @c LinkedTreeNode* stays valid until that
+ *   node is deleted, no matter what else is inserted or removed.
+ * - adding a child, and detaching or re-attaching a whole subtree, are
+ *   constant time. No node is ever copied.
+ * - destroying tree releases whole pool at once. Nodes are visited only
+ *   when their data has a copy destructor, and even then tree is not walked.
+ *
+ * DATA
+ * Data is stored same way as in a @c Vector : through @c create_copy if
+ * set, otherwise by value when @c element_size is atmost 8, otherwise
+ * by copying @c element_size bytes from given pointer.
+ *
+ * Root node is created along with tree and holds no data.
+ * */
+typedef struct LinkedTree {
+    LinkedTreeNode*            root;         /**< Root node, parent of all top level nodes. */
+    Size                       element_size; /**< Size of data of each node. */
+    Size                       node_count;   /**< Number of nodes, not counting root. */
+    CreateElementCopyCallback  create_copy;  /**< Copy constructor for each element. Can be NULL. */
+    DestroyElementCopyCallback destroy_copy; /**< Copy destructor for each element. Can be NULL. */
+    LinBlockAllocator*         pool;         /**< Pool all nodes are allocated from. */
+} LinkedTree;
+
+LinkedTree* linked_tree_create(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy);
+void        linked_tree_destroy(LinkedTree* tree, void* udata);
+void        linked_tree_clear(LinkedTree* tree, void* udata);
+void        linked_tree_reserve(LinkedTree* tree, Size node_count);
+
+LinkedTreeNode* linked_tree_push_front(LinkedTree* tree, LinkedTreeNode* parent, void* data, void* udata);
+LinkedTreeNode* linked_tree_push_back(LinkedTree* tree, LinkedTreeNode* parent, void* data, void* udata);
+LinkedTreeNode* linked_tree_insert_before(LinkedTree* tree, LinkedTreeNode* sibling, void* data, void* udata);
+LinkedTreeNode* linked_tree_insert_after(LinkedTree* tree, LinkedTreeNode* sibling, void* data, void* udata);
+
+void linked_tree_detach(LinkedTree* tree, LinkedTreeNode* node);
+void linked_tree_attach_back(LinkedTree* tree, LinkedTreeNode* parent, LinkedTreeNode* node);
+void linked_tree_delete(LinkedTree* tree, LinkedTreeNode* node, void* udata);
+
+#define linked_tree_root(tree) ((tree)->root)
+#define linked_tree_node_count(tree) ((tree)->node_count)
+
+/**
+ * Address of data stored in given node, @c element_size bytes.
+ * */
+static FORCE_INLINE void* linked_tree_node_data(LinkedTreeNode* node) {
+    return node->data;
+}
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/LinkedTree.h>
+
+DEF_INTEGER_LINKED_TREE_INTERFACE(u8,  Uint8);
+DEF_INTEGER_LINKED_TREE_INTERFACE(u16, Uint16);
+DEF_INTEGER_LINKED_TREE_INTERFACE(u32, Uint32);
+DEF_INTEGER_LINKED_TREE_INTERFACE(u64, Uint64);
+
+DEF_INTEGER_LINKED_TREE_INTERFACE(i8,  Int8);
+DEF_INTEGER_LINKED_TREE_INTERFACE(i16, Int16);
+DEF_INTEGER_LINKED_TREE_INTERFACE(i32, Int32);
+DEF_INTEGER_LINKED_TREE_INTERFACE(i64, Int64);
+
+DEF_INTEGER_LINKED_TREE_INTERFACE_WITH_COPY_AND_DESTROY(zstr, ZString, zstr_create_copy, zstr_destroy_copy);
+DEF_INTEGER_LINKED_TREE_INTERFACE(voidptr, void*);
+
+#endif // ANVIE_UTILS_CONTAINERS_LINKED_TREE_H
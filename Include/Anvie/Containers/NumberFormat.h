@@ -0,0 +1,49 @@
+/**
+ * @file NumberFormat.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Conversion of integers and doubles to and from decimal text,
+ * without going through printf or a null terminated buffer. Doubles are
+ * formatted with fewest digits that still parse back to same value.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_NUMBER_FORMAT_H
+#define ANVIE_UTILS_CONTAINERS_NUMBER_FORMAT_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Containers/StringView.h>
+
+/** Maximum number of characters written by @c num_format_u64. */
+#define NUM_FORMAT_U64_MAX_LENGTH 20
+
+/** Maximum number of characters written by @c num_format_i64. */
+#define NUM_FORMAT_I64_MAX_LENGTH 20
+
+/** Maximum number of characters written by @c num_format_f64. */
+#define NUM_FORMAT_F64_MAX_LENGTH 25
+
+Size num_format_u64(Char* dst, Uint64 value);
+Size num_format_i64(Char* dst, Int64 value);
+Size num_format_f64(Char* dst, Float64 value);
+
+Size num_parse_u64(StringView sv, Uint64* value);
+Size num_parse_i64(StringView sv, Int64* value);
+Size num_parse_f64(StringView sv, Float64* value);
+
+#endif // ANVIE_UTILS_CONTAINERS_NUMBER_FORMAT_H
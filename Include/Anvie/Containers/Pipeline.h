@@ -0,0 +1,171 @@
+/**
+ * @file Pipeline.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Lazy pipelines of map, filter and take stages over elements of
+ * a container, ending in a reduction. Nothing is evaluated until a
+ * reduction is called, and elements then flow through all stages a cache
+ * sized chunk at a time, without any intermediate container. To use
+ * pipelines over typed vectors, use the macros defined in
+ * `Interface/Pipeline.h`.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_PIPELINE_H
+#define ANVIE_UTILS_CONTAINERS_PIPELINE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/Vector.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Containers/SparseMap.h>
+#include <Anvie/Containers/BitVector.h>
+
+/* most stages a single pipeline can have */
+#define PIPELINE_MAX_STAGES 8
+
+typedef enum PipelineSourceKind {
+    PIPELINE_SOURCE_VIEW,       /**< elements of a vector or a view */
+    PIPELINE_SOURCE_DENSE_MAP,  /**< items of a dense map, as DenseMapItem pointers */
+    PIPELINE_SOURCE_SPARSE_MAP, /**< items of a sparse map, as SparseMapItem pointers */
+    PIPELINE_SOURCE_SET_BITS    /**< positions of set bits of a bitvector, as Size values */
+} PipelineSourceKind;
+
+typedef enum PipelineStageKind {
+    PIPELINE_STAGE_MAP,     /**< callback writes an output element for each element */
+    PIPELINE_STAGE_FILTER,  /**< callback decides which elements go on */
+    PIPELINE_STAGE_TAKE,    /**< only first few elements go on */
+    PIPELINE_STAGE_NUMERIC  /**< typed kernel, runs over a whole chunk of numbers at once */
+} PipelineStageKind;
+
+typedef struct PipelineChunk PipelineChunk;
+typedef struct PipelineStage PipelineStage;
+
+/**
+ * Kernel of a numeric stage, called once for each chunk, with all it's
+ * elements of stage's type.
+ * */
+typedef void (*PipelineKernel)(PipelineStage* stage, PipelineChunk* chunk);
+
+struct PipelineStage {
+    PipelineStageKind kind;
+    Size              element_size; /**< size of elements coming out of this stage */
+    void*             callback;     /**< map or filter callback */
+    void*             udata;        /**< passed to callback */
+    PipelineKernel    kernel;       /**< kernel of numeric stages */
+    Uint64            operands[2];  /**< operands of numeric stages, as bits of a value of stage type */
+    Size              count;        /**< number of elements a take stage lets through */
+};
+
+/**
+ * A pipeline over elements of a container. It's just a description of
+ * stages and is kept by value, and building it never allocates memory.
+ *
+ * EVALUATION SEMANTICS
+ * - Elements are pulled from source a chunk at a time, and each chunk goes
+ *   through all stages before next one is pulled. Stages work on scratch
+ *   buffers of a few KB on stack of evaluating call.
+ * - Vectors and views are read in place. A filter only records which
+ *   elements of a chunk are still alive, so elements are never copied
+ *   until a map writes new ones.
+ * - Once a take stage has let it's count through, no more elements are
+ *   pulled from source.
+ * - Every reduction evaluates pipeline again from start. Container must not
+ *   be modified while a reduction runs, except by callbacks changing data of
+ *   map items in place.
+ *
+ * CALLBACK SEMANTICS
+ * Same as @c Vector, an element of size 1, 2, 4 or 8 is passed to callbacks
+ * as value, and as a pointer to element otherwise. Map sources therefore
+ * pass item pointers, and set bits pass their positions.
+ *
+ * NUMERIC STAGES
+ * Stages and reductions with a type suffix expect elements of that type,
+ * and run as plain loops over whole chunks, with no callback per element.
+ * Only element size is checked, so a u64 stage on f64 elements is not
+ * caught. Integer arithmetic wraps around.
+ *
+ * ERRORS
+ * A stage that can't be added, because of invalid arguments or too many
+ * stages, marks pipeline as failed, and all reductions of it then return
+ * nothing.
+ * */
+typedef struct Pipeline {
+    PipelineSourceKind source;
+    VectorView         view;         /**< elements of vector sources */
+    void*              container;    /**< map or bitvector of other sources */
+    Size               element_size; /**< size of elements coming out of last stage */
+    Size               stage_count;
+    PipelineStage      stages[PIPELINE_MAX_STAGES];
+    Bool               failed;
+} Pipeline;
+
+Pipeline pipeline_from_vector(Vector* vec);
+Pipeline pipeline_from_view(VectorView view);
+Pipeline pipeline_from_dense_map(DenseMap* map);
+Pipeline pipeline_from_sparse_map(SparseMap* map);
+Pipeline pipeline_from_set_bits(BitVector* bv);
+
+Pipeline* pipeline_map(Pipeline* pipeline, Size element_size, MapElementCallback map, void* udata);
+Pipeline* pipeline_filter(Pipeline* pipeline, FilterElementCallback filter, void* udata);
+Pipeline* pipeline_take(Pipeline* pipeline, Size count);
+
+Size pipeline_count(Pipeline* pipeline);
+void pipeline_reduce(Pipeline* pipeline, void* acc, ReduceElementCallback reduce, void* udata);
+Size pipeline_collect(Pipeline* pipeline, Vector* out, void* udata);
+
+// numeric stages and reductions, with no callback per element
+#define DECL_NUMERIC_PIPELINE(sfx, type, sum_type)                      \
+    Pipeline* pipeline_add_##sfx(Pipeline* pipeline, type value);       \
+    Pipeline* pipeline_mul_##sfx(Pipeline* pipeline, type value);       \
+    Pipeline* pipeline_retain_eq_##sfx(Pipeline* pipeline, type value); \
+    Pipeline* pipeline_retain_lt_##sfx(Pipeline* pipeline, type value); \
+    Pipeline* pipeline_retain_in_range_##sfx(Pipeline* pipeline, type lo, type hi); \
+    sum_type  pipeline_sum_##sfx(Pipeline* pipeline);                   \
+    Bool      pipeline_min_##sfx(Pipeline* pipeline, type* out);        \
+    Bool      pipeline_max_##sfx(Pipeline* pipeline, type* out)
+
+DECL_NUMERIC_PIPELINE(u8,  Uint8,   Uint64);
+DECL_NUMERIC_PIPELINE(u16, Uint16,  Uint64);
+DECL_NUMERIC_PIPELINE(u32, Uint32,  Uint64);
+DECL_NUMERIC_PIPELINE(u64, Uint64,  Uint64);
+DECL_NUMERIC_PIPELINE(i8,  Int8,    Int64);
+DECL_NUMERIC_PIPELINE(i16, Int16,   Int64);
+DECL_NUMERIC_PIPELINE(i32, Int32,   Int64);
+DECL_NUMERIC_PIPELINE(i64, Int64,   Int64);
+DECL_NUMERIC_PIPELINE(f32, Float32, Float64);
+DECL_NUMERIC_PIPELINE(f64, Float64, Float64);
+
+#undef DECL_NUMERIC_PIPELINE
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/Pipeline.h>
+
+DEF_NUMERIC_PIPELINE_INTERFACE(u8,  U8,  Uint8,   Uint64);
+DEF_NUMERIC_PIPELINE_INTERFACE(u16, U16, Uint16,  Uint64);
+DEF_NUMERIC_PIPELINE_INTERFACE(u32, U32, Uint32,  Uint64);
+DEF_NUMERIC_PIPELINE_INTERFACE(u64, U64, Uint64,  Uint64);
+DEF_NUMERIC_PIPELINE_INTERFACE(i8,  I8,  Int8,    Int64);
+DEF_NUMERIC_PIPELINE_INTERFACE(i16, I16, Int16,   Int64);
+DEF_NUMERIC_PIPELINE_INTERFACE(i32, I32, Int32,   Int64);
+DEF_NUMERIC_PIPELINE_INTERFACE(i64, I64, Int64,   Int64);
+DEF_NUMERIC_PIPELINE_INTERFACE(f32, F32, Float32, Float64);
+DEF_NUMERIC_PIPELINE_INTERFACE(f64, F64, Float64, Float64);
+
+#endif // ANVIE_UTILS_CONTAINERS_PIPELINE_H
@@ -0,0 +1,120 @@
+/**
+ * @file PriorityQueue.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Priority queue backed by a @c Vector, kept in 4-ary heap order.
+ * A 4-ary heap is half as deep as a binary heap, and all children of a
+ * node are next to each other in memory, so a sift down touches fewer
+ * cache lines. To define priority queues of different types, use the
+ * macros defined in `Interface/PriorityQueue.h`.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_PRIORITY_QUEUE_H
+#define ANVIE_UTILS_CONTAINERS_PRIORITY_QUEUE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/Vector.h>
+
+/**
+ * Represents a priority queue.
+ *
+ * ORDERING SEMANTICS
+ * - element on top is the one that @c vector_sort would place first with
+ *   same compare function, ie: a is above b if compare(a, b) > 0.
+ * - numeric queues are created with @c priority_queue_create_<sfx> and
+ *   have no compare function. Their elements are compared inline, smallest
+ *   on top, or largest on top if queue is @c descending. Only functions with
+ *   matching suffix must be used on them.
+ * - floats are ordered by their bit patterns, just like @c vector_sort_f32.
+ *
+ * INSERTION SEMANTICS
+ * Same as @c Vector, data is treated as value for elements of size 1, 2, 4
+ * and 8, and as a pointer to element otherwise, and @c create_copy of @c heap
+ * is always used if set.
+ *
+ * REMOVAL SEMANTICS
+ * Removed element is copied out as is, without calling copy callbacks, so
+ * ownership of any copy made by @c create_copy moves to caller. If there's
+ * nowhere to copy it to, it's destroyed instead.
+ *
+ * TOP K
+ * To keep k largest of many elements, keep a queue of at most k elements
+ * with smallest on top, and replace top whenever a larger element arrives.
+ * When all elements are already in a vector, @c vector_partial_sort is faster.
+ * */
+typedef struct PriorityQueue {
+    Vector*                heap;       /**< elements in heap order, top at position 0 */
+    CompareElementCallback compare;    /**< decides order of elements, NULL for numeric queues */
+    void*                  udata;      /**< passed to compare and to copy callbacks of heap */
+    Bool                   descending; /**< largest element on top, numeric queues only */
+} PriorityQueue;
+
+#define priority_queue_length(pq) ((pq)->heap->length)
+#define priority_queue_is_empty(pq) ((pq)->heap->length == 0)
+
+PriorityQueue* priority_queue_create(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy, CompareElementCallback compare, void* udata);
+PriorityQueue* priority_queue_create_with_allocator(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy, CompareElementCallback compare, void* udata, Allocator* allocator);
+PriorityQueue* priority_queue_from_vector(Vector* vec, CompareElementCallback compare, void* udata);
+void           priority_queue_destroy(PriorityQueue* pq);
+void           priority_queue_clear(PriorityQueue* pq);
+void           priority_queue_reserve(PriorityQueue* pq, Size capacity);
+
+void  priority_queue_push(PriorityQueue* pq, void* data);
+void* priority_queue_peek(PriorityQueue* pq);
+Bool  priority_queue_pop(PriorityQueue* pq, void* out);
+Bool  priority_queue_replace_top(PriorityQueue* pq, void* data, void* out);
+
+// numeric queues, with comparisons inlined
+#define DECL_NUMERIC_PRIORITY_QUEUE(sfx, type)                          \
+    PriorityQueue* priority_queue_create_##sfx(Bool descending, Allocator* allocator); \
+    PriorityQueue* priority_queue_from_vector_##sfx(Vector* vec, Bool descending); \
+    void           priority_queue_push_##sfx(PriorityQueue* pq, type value); \
+    Bool           priority_queue_pop_##sfx(PriorityQueue* pq, type* out); \
+    Bool           priority_queue_replace_top_##sfx(PriorityQueue* pq, type value, type* out)
+
+DECL_NUMERIC_PRIORITY_QUEUE(u8,  Uint8);
+DECL_NUMERIC_PRIORITY_QUEUE(u16, Uint16);
+DECL_NUMERIC_PRIORITY_QUEUE(u32, Uint32);
+DECL_NUMERIC_PRIORITY_QUEUE(u64, Uint64);
+DECL_NUMERIC_PRIORITY_QUEUE(i8,  Int8);
+DECL_NUMERIC_PRIORITY_QUEUE(i16, Int16);
+DECL_NUMERIC_PRIORITY_QUEUE(i32, Int32);
+DECL_NUMERIC_PRIORITY_QUEUE(i64, Int64);
+DECL_NUMERIC_PRIORITY_QUEUE(f32, Float32);
+DECL_NUMERIC_PRIORITY_QUEUE(f64, Float64);
+
+#undef DECL_NUMERIC_PRIORITY_QUEUE
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/PriorityQueue.h>
+
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(u8,  U8,  Uint8);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(u16, U16, Uint16);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(u32, U32, Uint32);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(u64, U64, Uint64);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(i8,  I8,  Int8);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(i16, I16, Int16);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(i32, I32, Int32);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(i64, I64, Int64);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(f32, F32, Float32);
+DEF_NUMERIC_PRIORITY_QUEUE_INTERFACE(f64, F64, Float64);
+
+#endif // ANVIE_UTILS_CONTAINERS_PRIORITY_QUEUE_H
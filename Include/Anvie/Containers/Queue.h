@@ -0,0 +1,130 @@
+/**
+ * @file Queue.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Bounded lock-free queues to hand elements between threads.
+ * @c SpscQueue is a ring for exactly one producer thread and one consumer
+ * thread, @c MpmcQueue allows any number of both. Like @c Vector, both
+ * store elements of a fixed size, but elements are always passed by
+ * address and copied in and out, since a slot may be reused as soon as it's
+ * popped. Nothing ever blocks, a push into a full queue or a pop from an
+ * empty one just fails. Batch functions move many elements for the cost of
+ * one synchronization.
+ * To define queues of different types, use the macros defined in
+ * `Interface/Queue.h` and use the corresponding functions only.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_QUEUE_H
+#define ANVIE_UTILS_CONTAINERS_QUEUE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+
+#ifndef QUEUE_CACHE_LINE_SIZE
+/** Indices written by producers and by consumers are kept this far apart, so they never share a cache line. */
+#define QUEUE_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * Single producer, single consumer ring queue.
+ *
+ * @c head is written only by producer and @c tail only by consumer, each on
+ * it's own cache line. Each side also keeps a cached copy of other side's
+ * index, and reads the shared one only when cached copy says queue is full
+ * (or empty), so in steady state neither side touches other's cache line.
+ * */
+typedef struct SpscQueue {
+    Size   head;         /**< Number of elements ever pushed, written by producer. */
+    Size   cached_tail;  /**< Producer's last seen value of @c tail. */
+    Uint8  producer_pad[QUEUE_CACHE_LINE_SIZE - 2 * sizeof(Size)];
+    Size   tail;         /**< Number of elements ever popped, written by consumer. */
+    Size   cached_head;  /**< Consumer's last seen value of @c head. */
+    Uint8  consumer_pad[QUEUE_CACHE_LINE_SIZE - 2 * sizeof(Size)];
+    Size   element_size; /**< Size of each element. */
+    Size   capacity;     /**< Number of slots, a power of two. */
+    Uint8* data;         /**< Slots, @c capacity elements. */
+    void*  memory;       /**< Allocation holding queue and it's slots. */
+    Size   memory_size;  /**< Size of @c memory. */
+    Allocator* allocator; /**< Allocator of @c memory, NULL for system allocator. */
+} __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))) SpscQueue;
+
+/**
+ * Multi producer, multi consumer bounded queue, after Dmitry Vyukov's design.
+ *
+ * Every slot has a sequence number next to it's element. A slot at position
+ * @c pos is free for a producer when it's sequence is @c pos, and full for a
+ * consumer when it's @c pos + 1. Producers and consumers claim positions by
+ * advancing @c enqueue_pos and @c dequeue_pos with a compare and swap, and
+ * publish a slot by storing it's next sequence number. Producers never
+ * touch @c dequeue_pos and consumers never touch @c enqueue_pos.
+ * */
+typedef struct MpmcQueue {
+    Size   enqueue_pos;  /**< Next position to push to. */
+    Uint8  producer_pad[QUEUE_CACHE_LINE_SIZE - sizeof(Size)];
+    Size   dequeue_pos;  /**< Next position to pop from. */
+    Uint8  consumer_pad[QUEUE_CACHE_LINE_SIZE - sizeof(Size)];
+    Size   element_size; /**< Size of each element. */
+    Size   cell_size;    /**< Size of a slot, sequence number followed by element. */
+    Size   capacity;     /**< Number of slots, a power of two. */
+    Uint8* cells;        /**< Slots, @c capacity cells. */
+    void*  memory;       /**< Allocation holding queue and it's slots. */
+    Size   memory_size;  /**< Size of @c memory. */
+    Allocator* allocator; /**< Allocator of @c memory, NULL for system allocator. */
+} __attribute__((aligned(QUEUE_CACHE_LINE_SIZE))) MpmcQueue;
+
+#define spsc_queue_capacity(q) ((q)->capacity)
+#define spsc_queue_element_size(q) ((q)->element_size)
+#define mpmc_queue_capacity(q) ((q)->capacity)
+#define mpmc_queue_element_size(q) ((q)->element_size)
+
+SpscQueue* spsc_queue_create(Size element_size, Size capacity);
+SpscQueue* spsc_queue_create_with_allocator(Size element_size, Size capacity, Allocator* allocator);
+void       spsc_queue_destroy(SpscQueue* q);
+Bool       spsc_queue_push(SpscQueue* q, const void* element);
+Bool       spsc_queue_pop(SpscQueue* q, void* element);
+Size       spsc_queue_push_batch(SpscQueue* q, const void* elements, Size count);
+Size       spsc_queue_pop_batch(SpscQueue* q, void* elements, Size count);
+Size       spsc_queue_length(SpscQueue* q);
+
+MpmcQueue* mpmc_queue_create(Size element_size, Size capacity);
+MpmcQueue* mpmc_queue_create_with_allocator(Size element_size, Size capacity, Allocator* allocator);
+void       mpmc_queue_destroy(MpmcQueue* q);
+Bool       mpmc_queue_push(MpmcQueue* q, const void* element);
+Bool       mpmc_queue_pop(MpmcQueue* q, void* element);
+Size       mpmc_queue_push_batch(MpmcQueue* q, const void* elements, Size count);
+Size       mpmc_queue_pop_batch(MpmcQueue* q, void* elements, Size count);
+Size       mpmc_queue_length(MpmcQueue* q);
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/Queue.h>
+
+DEF_INTEGER_QUEUE_INTERFACE(u8,  U8,  Uint8);
+DEF_INTEGER_QUEUE_INTERFACE(u16, U16, Uint16);
+DEF_INTEGER_QUEUE_INTERFACE(u32, U32, Uint32);
+DEF_INTEGER_QUEUE_INTERFACE(u64, U64, Uint64);
+
+DEF_INTEGER_QUEUE_INTERFACE(i8,  I8,  Int8);
+DEF_INTEGER_QUEUE_INTERFACE(i16, I16, Int16);
+DEF_INTEGER_QUEUE_INTERFACE(i32, I32, Int32);
+DEF_INTEGER_QUEUE_INTERFACE(i64, I64, Int64);
+
+DEF_INTEGER_QUEUE_INTERFACE(voidptr, VPtr, void*);
+
+#endif // ANVIE_UTILS_CONTAINERS_QUEUE_H
@@ -0,0 +1,214 @@
+/**
+ * @file RadixTree.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Adaptive radix tree, an ordered map from byte string keys to data
+ * with prefix queries.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_RADIX_TREE_H
+#define ANVIE_UTILS_CONTAINERS_RADIX_TREE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/Vector.h>
+#include <Anvie/Containers/StringView.h>
+#include <string.h>
+
+/**
+ * A key and it's data stored in a @c RadixTree. Key is a copy of inserted
+ * key, followed by a null terminator so that string keys can be used as
+ * @c ZString directly. Data holds the value itself when it's at most 8 bytes,
+ * and a pointer to a copy otherwise, like @c Vector elements.
+ *
+ * A leaf never moves once created, so a pointer to it stays valid till it's
+ * key is deleted.
+ * */
+typedef struct RadixTreeLeaf {
+    void* data;
+    Size  key_length;
+    Uint8 key[];
+} RadixTreeLeaf;
+
+/**
+ * Adaptive radix tree (ART). Each inner node branches on one byte of key,
+ * and grows through four layouts (4, 16, 48 and 256 children) as children
+ * are added, so sparse nodes stay small and dense ones are direct lookups.
+ * Runs of bytes shared by all keys below a node are stored in the node
+ * itself (path compression), and a branch with a single key is just a leaf
+ * (lazy expansion).
+ *
+ * Keys are ordered byte by byte as unsigned values, a key comes before all
+ * keys it's a prefix of. Integers encoded with @c radix_tree_encode_u64 and
+ * @c radix_tree_encode_i64 keep their numeric order.
+ * */
+typedef struct RadixTree {
+    void*                      root;      /**< A node, or a tagged leaf when tree has a single key. */
+    Size                       count;     /**< Number of keys in tree. */
+    Size                       data_size; /**< Size of data in bytes. */
+    CreateElementCopyCallback  create_data_copy;
+    DestroyElementCopyCallback destroy_data_copy;
+} RadixTree;
+
+#define radix_tree_count(tree) ((tree)->count)
+
+/**
+ * Walks keys of a tree, or of a prefix of it, in increasing order. Pending
+ * subtrees are kept on an explicit stack, so long keys don't recurse deep.
+ *
+ * Tree must not be modified while it's being iterated. Destroy iterator
+ * with @c radix_tree_iter_destroy once done, even if it wasn't run till end.
+ * */
+typedef struct RadixTreeIterator {
+    VPtr_Vector* stack;
+} RadixTreeIterator;
+
+RadixTree* radix_tree_create(Size data_size, CreateElementCopyCallback create_data_copy, DestroyElementCopyCallback destroy_data_copy);
+void       radix_tree_destroy(RadixTree* tree, void* udata);
+void       radix_tree_clear(RadixTree* tree, void* udata);
+
+RadixTreeLeaf* radix_tree_insert(RadixTree* tree, const void* key, Size key_length, void* data, void* udata);
+RadixTreeLeaf* radix_tree_search(RadixTree* tree, const void* key, Size key_length);
+Bool           radix_tree_delete(RadixTree* tree, const void* key, Size key_length, void* udata);
+RadixTreeLeaf* radix_tree_longest_prefix(RadixTree* tree, const void* key, Size key_length);
+RadixTreeLeaf* radix_tree_minimum(RadixTree* tree);
+RadixTreeLeaf* radix_tree_maximum(RadixTree* tree);
+
+RadixTreeIterator radix_tree_iter(RadixTree* tree);
+RadixTreeIterator radix_tree_iter_prefix(RadixTree* tree, const void* prefix, Size prefix_length);
+RadixTreeLeaf*    radix_tree_iter_next(RadixTreeIterator* iter);
+void              radix_tree_iter_destroy(RadixTreeIterator* iter);
+
+/*------------------------------ KEY HELPERS -------------------------------*/
+
+/**
+ * Encode an unsigned integer as a big endian key, so that byte order of
+ * keys is same as numeric order.
+ * */
+static FORCE_INLINE void radix_tree_encode_u64(Uint64 value, Uint8 key[8]) {
+    for(Size i = 0; i < 8; i++) {
+        key[i] = (Uint8)(value >> (56 - 8 * i));
+    }
+}
+
+/**
+ * Encode a signed integer as a big endian key. Sign bit is flipped, so that
+ * negative values come before positive ones.
+ * */
+static FORCE_INLINE void radix_tree_encode_i64(Int64 value, Uint8 key[8]) {
+    radix_tree_encode_u64((Uint64)value ^ ((Uint64)1 << 63), key);
+}
+
+static FORCE_INLINE Uint64 radix_tree_decode_u64(const Uint8 key[8]) {
+    Uint64 value = 0;
+    for(Size i = 0; i < 8; i++) {
+        value = (value << 8) | key[i];
+    }
+    return value;
+}
+
+static FORCE_INLINE Int64 radix_tree_decode_i64(const Uint8 key[8]) {
+    return (Int64)(radix_tree_decode_u64(key) ^ ((Uint64)1 << 63));
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_insert_zstr(RadixTree* tree, ZString key, void* data, void* udata) {
+    return radix_tree_insert(tree, key, key ? strlen(key) : 0, data, udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_search_zstr(RadixTree* tree, ZString key) {
+    return radix_tree_search(tree, key, key ? strlen(key) : 0);
+}
+
+static FORCE_INLINE Bool radix_tree_delete_zstr(RadixTree* tree, ZString key, void* udata) {
+    return radix_tree_delete(tree, key, key ? strlen(key) : 0, udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_longest_prefix_zstr(RadixTree* tree, ZString key) {
+    return radix_tree_longest_prefix(tree, key, key ? strlen(key) : 0);
+}
+
+static FORCE_INLINE RadixTreeIterator radix_tree_iter_prefix_zstr(RadixTree* tree, ZString prefix) {
+    return radix_tree_iter_prefix(tree, prefix, prefix ? strlen(prefix) : 0);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_insert_strview(RadixTree* tree, StringView key, void* data, void* udata) {
+    return radix_tree_insert(tree, key.data, key.length, data, udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_search_strview(RadixTree* tree, StringView key) {
+    return radix_tree_search(tree, key.data, key.length);
+}
+
+static FORCE_INLINE Bool radix_tree_delete_strview(RadixTree* tree, StringView key, void* udata) {
+    return radix_tree_delete(tree, key.data, key.length, udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_longest_prefix_strview(RadixTree* tree, StringView key) {
+    return radix_tree_longest_prefix(tree, key.data, key.length);
+}
+
+static FORCE_INLINE RadixTreeIterator radix_tree_iter_prefix_strview(RadixTree* tree, StringView prefix) {
+    return radix_tree_iter_prefix(tree, prefix.data, prefix.length);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_insert_u64(RadixTree* tree, Uint64 key, void* data, void* udata) {
+    Uint8 bytes[8];
+    radix_tree_encode_u64(key, bytes);
+    return radix_tree_insert(tree, bytes, sizeof(bytes), data, udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_search_u64(RadixTree* tree, Uint64 key) {
+    Uint8 bytes[8];
+    radix_tree_encode_u64(key, bytes);
+    return radix_tree_search(tree, bytes, sizeof(bytes));
+}
+
+static FORCE_INLINE Bool radix_tree_delete_u64(RadixTree* tree, Uint64 key, void* udata) {
+    Uint8 bytes[8];
+    radix_tree_encode_u64(key, bytes);
+    return radix_tree_delete(tree, bytes, sizeof(bytes), udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_insert_i64(RadixTree* tree, Int64 key, void* data, void* udata) {
+    Uint8 bytes[8];
+    radix_tree_encode_i64(key, bytes);
+    return radix_tree_insert(tree, bytes, sizeof(bytes), data, udata);
+}
+
+static FORCE_INLINE RadixTreeLeaf* radix_tree_search_i64(RadixTree* tree, Int64 key) {
+    Uint8 bytes[8];
+    radix_tree_encode_i64(key, bytes);
+    return radix_tree_search(tree, bytes, sizeof(bytes));
+}
+
+static FORCE_INLINE Bool radix_tree_delete_i64(RadixTree* tree, Int64 key, void* udata) {
+    Uint8 bytes[8];
+    radix_tree_encode_i64(key, bytes);
+    return radix_tree_delete(tree, bytes, sizeof(bytes), udata);
+}
+
+#include <Anvie/Containers/Interface/RadixTree.h>
+
+DEF_INTEGER_RADIX_TREE_INTERFACE(u8,  Uint8);
+DEF_INTEGER_RADIX_TREE_INTERFACE(u16, Uint16);
+DEF_INTEGER_RADIX_TREE_INTERFACE(u32, Uint32);
+DEF_INTEGER_RADIX_TREE_INTERFACE(u64, Uint64);
+DEF_INTEGER_RADIX_TREE_INTERFACE_WITH_COPY_AND_DESTROY(zstr, ZString, zstr_create_copy, zstr_destroy_copy);
+
+#endif // ANVIE_UTILS_CONTAINERS_RADIX_TREE_H
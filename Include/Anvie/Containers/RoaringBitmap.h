@@ -0,0 +1,141 @@
+/**
+ * @file RoaringBitmap.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Compressed bitmap over 32 bit values, in the style of Roaring
+ * bitmaps. The 32 bit space is split into chunks of 65536 values keyed by
+ * upper 16 bits, and each non-empty chunk is stored in the smallest of three
+ * forms : a sorted array of lower 16 bits, a dense 8 KiB bitmap, or a list
+ * of runs. Use this instead of @c BitVector when set values are sparse or
+ * clustered over a large range.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_ROARING_BITMAP_H
+#define ANVIE_UTILS_CONTAINERS_ROARING_BITMAP_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/BitVector.h>
+
+/** Number of values covered by a single container. */
+#define ROARING_CHUNK_SIZE 65536
+
+/** Array containers holding more values than this are converted to bitmaps. */
+#define ROARING_ARRAY_MAX_SIZE 4096
+
+/** Number of 64 bit words in a bitmap container. */
+#define ROARING_BITMAP_WORDS (ROARING_CHUNK_SIZE / 64)
+
+/**
+ * Storage form of a single container.
+ * */
+typedef enum RoaringContainerType {
+    ROARING_CONTAINER_ARRAY  = 0, /**< sorted array of Uint16 values */
+    ROARING_CONTAINER_BITMAP = 1, /**< ROARING_BITMAP_WORDS words of bits */
+    ROARING_CONTAINER_RUN    = 2, /**< sorted, non-overlapping, non-adjacent runs */
+} RoaringContainerType;
+
+/**
+ * A run of consecutive values, [start, start + length].
+ * */
+typedef struct RoaringRun {
+    Uint16 start;  /**< first value of run */
+    Uint16 length; /**< number of values in run minus one */
+} RoaringRun;
+
+/**
+ * Values of a single 65536 value chunk.
+ * */
+typedef struct RoaringContainer {
+    Uint16 key;         /**< upper 16 bits shared by all values in this container */
+    Uint16 type;        /**< one of RoaringContainerType */
+    Uint32 cardinality; /**< number of values in container, never zero */
+    Uint32 size;        /**< number of array values, runs or bitmap words in data */
+    Uint32 capacity;    /**< number of array values, runs or bitmap words data can hold */
+    void*  data;        /**< Uint16 array, Uint64 bitmap words or RoaringRun array */
+} RoaringContainer;
+
+/**
+ * Compressed bitmap over 32 bit values.
+ *
+ * Containers are kept sorted by key, so that a lookup is a binary search
+ * over containers followed by a search inside one container.
+ *
+ * CONTAINER SEMANTICS
+ * - a container with at most @c ROARING_ARRAY_MAX_SIZE values is an array,
+ *   otherwise it's a bitmap.
+ * - run containers are created by @c roaring_add_range and
+ *   @c roaring_run_optimize. Adding or removing a single value converts
+ *   a run container back to array or bitmap.
+ * - results of set operations are arrays or bitmaps.
+ *
+ * ALLOCATION SEMANTICS
+ * - all memory owned by bitmap is allocated using @c allocator.
+ * - a @c NULL @c allocator means system allocator is used.
+ * */
+typedef struct RoaringBitmap {
+    Size              count;      /**< number of containers */
+    Size              capacity;   /**< number of containers that can be stored without reallocation */
+    RoaringContainer* containers; /**< containers sorted by key */
+    Allocator*        allocator;  /**< allocator for all memory owned by bitmap, NULL for system allocator */
+} RoaringBitmap;
+
+/**
+ * Callback called for each value in a @c RoaringBitmap, in increasing order.
+ * @param value
+ * @param udata User data passed to foreach call.
+ * */
+typedef void (*RoaringVisitorCallback)(Uint32 value, void* udata);
+
+#define roaring_is_empty(rb) ((rb)->count == 0)
+
+RoaringBitmap* roaring_create();
+RoaringBitmap* roaring_create_with_allocator(Allocator* allocator);
+void           roaring_destroy(RoaringBitmap* rb);
+RoaringBitmap* roaring_clone(RoaringBitmap* rb);
+void           roaring_clear(RoaringBitmap* rb);
+
+/* set/remove operation */
+Bool   roaring_add(RoaringBitmap* rb, Uint32 value);
+Bool   roaring_remove(RoaringBitmap* rb, Uint32 value);
+Bool   roaring_contains(RoaringBitmap* rb, Uint32 value);
+void   roaring_add_range(RoaringBitmap* rb, Uint64 range_begin, Uint64 range_end);
+Uint64 roaring_cardinality(RoaringBitmap* rb);
+void   roaring_run_optimize(RoaringBitmap* rb);
+
+/* binary operations */
+RoaringBitmap* roaring_and(RoaringBitmap* rb1, RoaringBitmap* rb2);
+RoaringBitmap* roaring_or(RoaringBitmap* rb1, RoaringBitmap* rb2);
+RoaringBitmap* roaring_xor(RoaringBitmap* rb1, RoaringBitmap* rb2);
+RoaringBitmap* roaring_andnot(RoaringBitmap* rb1, RoaringBitmap* rb2);
+Bool           roaring_cmpeq(RoaringBitmap* rb1, RoaringBitmap* rb2);
+
+/* iteration */
+void roaring_foreach(RoaringBitmap* rb, RoaringVisitorCallback visitor, void* udata);
+
+/* serialization */
+Size           roaring_serialized_size(RoaringBitmap* rb);
+Size           roaring_serialize(RoaringBitmap* rb, void* buffer, Size buffer_size);
+RoaringBitmap* roaring_deserialize(const void* buffer, Size buffer_size);
+RoaringBitmap* roaring_deserialize_with_allocator(const void* buffer, Size buffer_size, Allocator* allocator);
+
+/* conversion */
+RoaringBitmap* roaring_from_bitvec(BitVector* bv);
+BitVector*     roaring_to_bitvec(RoaringBitmap* rb);
+
+#endif // ANVIE_UTILS_CONTAINERS_ROARING_BITMAP_H
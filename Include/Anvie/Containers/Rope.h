@@ -0,0 +1,95 @@
+/**
+ * @file Rope.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A @c Rope is a string stored as a balanced tree of small pieces.
+ * Concatenating two ropes or taking a slice of one takes logarithmic time,
+ * and shares pieces between ropes instead of copying them.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_ROPE_H
+#define ANVIE_UTILS_CONTAINERS_ROPE_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/String.h>
+#include <Anvie/Containers/StringView.h>
+
+#ifndef ROPE_LEAF_SIZE
+/**
+ * Maximum number of characters in a leaf. Small appends are merged into
+ * leaves upto this size, and slicing copies atmost two partial leaves.
+ * */
+#define ROPE_LEAF_SIZE 512
+#endif// ROPE_LEAF_SIZE
+
+/**
+ * Node of a rope. A leaf has no children and stores it's characters right
+ * after node, any other node is concatenation of it's children.
+ *
+ * Nodes are never modified once created, so any number of ropes can share
+ * them. Each node is freed when last rope or node referencing it is gone.
+ * */
+typedef struct RopeNode {
+    struct RopeNode* left;     /**< Left child, NULL for a leaf. */
+    struct RopeNode* right;    /**< Right child, NULL for a leaf. */
+    Size             length;   /**< Number of characters under node. */
+    Uint32           height;   /**< 0 for a leaf, one more than taller child otherwise. */
+    Uint32           refcount; /**< Number of ropes and nodes referencing this node. */
+    Char             data[];   /**< Characters of a leaf. */
+} RopeNode;
+
+/**
+ * A string stored as an AVL balanced tree of leaves of atmost
+ * @c ROPE_LEAF_SIZE characters.
+ *
+ * - @c rope_concat and @c rope_slice create new ropes in O(log n) time,
+ *   sharing all unchanged nodes with ropes they are made from.
+ * - @c rope_append_view and @c rope_append change a rope in place, in same
+ *   time. Other ropes sharing nodes with it are not affected.
+ * - ropes combined with each other must use same allocator.
+ * - reference counts are not atomic, so ropes sharing nodes must be used
+ *   from one thread at a time.
+ * */
+typedef struct Rope {
+    RopeNode*  root;      /**< Root node, NULL for an empty rope. */
+    Allocator* allocator; /**< Allocator for rope and it's nodes, NULL for system allocator. */
+} Rope;
+
+/** Visitor called with each leaf of a rope, in order. Returning False stops the visit. */
+typedef Bool (*RopeVisitorCallback)(StringView chunk, void* udata);
+
+Rope* rope_create(StringView sv, Allocator* allocator);
+Rope* rope_clone(Rope* rope);
+void  rope_destroy(Rope* rope);
+
+Bool  rope_append_view(Rope* rope, StringView sv);
+Bool  rope_append(Rope* rope, Rope* other);
+Rope* rope_concat(Rope* rope1, Rope* rope2);
+Rope* rope_slice(Rope* rope, Size pos, Size length);
+
+Char    rope_char_at(Rope* rope, Size pos);
+Size    rope_copy_to(Rope* rope, Size pos, Char* dst, Size n);
+Bool    rope_foreach_chunk(Rope* rope, RopeVisitorCallback visitor, void* udata);
+String* rope_to_string(Rope* rope);
+
+#define rope_length(rope) ((rope)->root ? (rope)->root->length : 0)
+#define rope_height(rope) ((rope)->root ? (rope)->root->height : 0)
+
+#endif // ANVIE_UTILS_CONTAINERS_ROPE_H
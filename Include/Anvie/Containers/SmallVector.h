@@ -0,0 +1,77 @@
+/**
+ * @file SmallVector.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A @c Vector with inline storage for a fixed number of elements.
+ * Elements are stored inside the small vector object itself until they
+ * don't fit anymore, and only then memory is allocated from heap.
+ *
+ * A small vector IS a @c Vector : it's first member is the vector and all
+ * vector functions work on it without any change. This is done by
+ * giving the vector a special @c Allocator that knows about inline storage :
+ * - reallocating inline storage to a size that fits keeps it inline.
+ * - reallocating inline storage to a larger size spills to heap.
+ * - reallocating heap storage to a size that fits inline moves it back.
+ * - freeing inline storage or the vector header is a no-op.
+ * All other memory comes from parent allocator.
+ *
+ * Since vector stores pointer to allocator embedded in small vector, a small
+ * vector must not be moved or copied by value after initialization. Vectors
+ * cloned from a small vector keep using it's allocator, so they must be
+ * destroyed before it.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_SMALL_VECTOR_H
+#define ANVIE_UTILS_CONTAINERS_SMALL_VECTOR_H
+
+#include <Anvie/Containers/Vector.h>
+
+/**
+ * Generic header of every small vector. Inline storage of typed small
+ * vectors follows this header.
+ * */
+typedef struct SmallVector {
+    Vector     vec; /**< The vector itself, must be first member. */
+    Allocator  allocator; /**< Allocator given to vector, aware of inline storage. */
+    Allocator* parent; /**< Allocator for memory that doesn't fit inline. NULL means system allocator. */
+    void*      storage; /**< Inline storage. */
+    Size       storage_size; /**< Size of inline storage in bytes. */
+} SmallVector;
+
+#define small_vector_is_inline(sv) ((void*)(sv)->vec.data == (sv)->storage)
+
+void small_vector_init(SmallVector* sv,
+                       Size element_size,
+                       CreateElementCopyCallback create_copy,
+                       DestroyElementCopyCallback destroy_copy,
+                       void* storage,
+                       Size inline_count,
+                       Allocator* parent);
+void small_vector_deinit(SmallVector* sv, void* udata);
+SmallVector* small_vector_create(Size object_size,
+                                 Size storage_offset,
+                                 Size element_size,
+                                 CreateElementCopyCallback create_copy,
+                                 DestroyElementCopyCallback destroy_copy,
+                                 Size inline_count,
+                                 Allocator* parent);
+void small_vector_destroy(SmallVector* sv, Size object_size, void* udata);
+
+#include <Anvie/Containers/Interface/SmallVector.h>
+
+#endif // ANVIE_UTILS_CONTAINERS_SMALL_VECTOR_H
@@ -0,0 +1,91 @@
+/**
+ * @file SnapshotMap.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A read-mostly hash map whose readers never take a lock.
+ * Readers search an immutable published version of map. Writers copy
+ * it, modify the copy and publish the copy with one atomic pointer swap
+ * (read-copy-update). Old versions are freed once no reader can see them,
+ * using epoch based reclamation.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_SNAPSHOT_MAP_H
+#define ANVIE_UTILS_CONTAINERS_SNAPSHOT_MAP_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <pthread.h>
+
+typedef struct SnapshotMapReader SnapshotMapReader;
+typedef struct SnapshotMapVersion SnapshotMapVersion;
+
+/**
+ * Hash map with unique keys, for many reader threads and rare writes.
+ *
+ * Each version is an inline @c DenseMap (see @c dense_map_create_inline),
+ * and both keys and data are plain-old-data, so a version can be copied
+ * slot by slot.
+ *
+ * CONCURRENCY SEMANTICS
+ * - reads are lock-free. A reader announces current epoch in it's own cache
+ *   line, loads published version, and clears announcement when done. Readers
+ *   never write to any memory shared with other readers.
+ * - writes are serialized by a mutex and copy whole map, so each write costs
+ *   O(n). Batch many changes with @c snapshot_map_write_begin and
+ *   @c snapshot_map_write_commit to pay for one copy.
+ * - a version replaced by a write is freed only after every reader that
+ *   could have loaded it has finished it's read.
+ * - a reader sees either all or none of the changes of a commit.
+ *
+ * KEYS AND DATA
+ * - keys are passed as to a @c DenseMap without copy callbacks : by value when
+ *   @c key_size is at most 8, pointer to key otherwise.
+ * - data is @c data_size bytes, passed as pointer to those bytes.
+ * */
+typedef struct SnapshotMap {
+    DenseMap*           current;     /**< Published version, read and replaced atomically. */
+    Uint64              epoch;       /**< Global epoch, incremented on each publish. */
+    SnapshotMapReader*  readers;     /**< Per thread reader records, only ever pushed to. */
+    pthread_key_t       reader_key;  /**< Key to get reader record of calling thread. */
+    pthread_mutex_t     write_lock;  /**< Serializes writers. */
+    SnapshotMapVersion* retired;     /**< Replaced versions waiting to be freed, protected by @c write_lock. */
+    Size                data_size;   /**< Size of data in bytes. */
+    Allocator*          allocator;   /**< Thread safe allocator for all memory owned by map, NULL for system allocator. */
+} SnapshotMap;
+
+SnapshotMap* snapshot_map_create(HashCallback hash, Size key_size, CompareElementCallback compare_key, Size data_size, Allocator* allocator);
+void         snapshot_map_destroy(SnapshotMap* map);
+
+/* lock-free read operation */
+DenseMap* snapshot_map_read_begin(SnapshotMap* map);
+void      snapshot_map_read_end(SnapshotMap* map);
+Bool      snapshot_map_search(SnapshotMap* map, void* key, void* data, void* udata);
+
+/* write operation */
+DenseMap* snapshot_map_write_begin(SnapshotMap* map, void* udata);
+void      snapshot_map_write_commit(SnapshotMap* map, DenseMap* next);
+void      snapshot_map_write_abort(SnapshotMap* map, DenseMap* next);
+Bool      snapshot_map_insert(SnapshotMap* map, void* key, const void* data, void* udata);
+Bool      snapshot_map_delete(SnapshotMap* map, void* key, void* udata);
+
+Size snapshot_map_item_count(SnapshotMap* map);
+Size snapshot_map_reclaim(SnapshotMap* map);
+
+#endif // ANVIE_UTILS_CONTAINERS_SNAPSHOT_MAP_H
@@ -0,0 +1,79 @@
+/**
+ * @file SoaVector.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Struct of arrays vector. Each field of a record is stored in it's
+ * own contiguous column, so a scan over one field touches only memory of
+ * that field. To define SoA vectors for a record type, use the macros
+ * defined in `Interface/SoaVector.h` and use the corresponding functions only.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_SOA_VECTOR_H
+#define ANVIE_UTILS_CONTAINERS_SOA_VECTOR_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+
+/**
+ * Represents a struct of arrays vector.
+ *
+ * A row is one record, and a column holds one field of all records.
+ * All columns always have same length and capacity, they're grown
+ * together. Column elements are plain data, they're moved with @c memcpy
+ * and never constructed or destroyed.
+ *
+ * COMPARE SEMANTICS
+ * Same as @c Vector : if size of column element is 1, 2, 4 or 8 bytes,
+ * then comparator gets elements by value, otherwise it gets pointers
+ * to elements.
+ *
+ * ALLOCATION SEMANTICS
+ * - header and each column are allocated using @c allocator.
+ * - a @c NULL @c allocator means system allocator is used.
+ * */
+typedef struct SoaVector {
+    Size       length;       /**< number of rows in vector */
+    Size       capacity;     /**< number of rows each column can hold */
+    Size       column_count; /**< number of columns */
+    Size*      column_sizes; /**< size of an element of each column, stored in same allocation as header */
+    Allocator* allocator;    /**< allocator for all memory owned by vector, NULL for system allocator */
+    void*      columns[];    /**< one array per column */
+} SoaVector;
+
+#define soa_vector_length(soa) ((soa)->length)
+#define soa_vector_capacity(soa) ((soa)->capacity)
+#define soa_vector_column(soa, col) ((soa)->columns[col])
+#define soa_vector_address_at(soa, col, pos) ((UByteArray)(soa)->columns[col] + (pos) * (soa)->column_sizes[col])
+
+SoaVector* soa_vector_create(Size column_count, const Size* column_sizes);
+SoaVector* soa_vector_create_with_allocator(Size column_count, const Size* column_sizes, Allocator* allocator);
+void       soa_vector_destroy(SoaVector* soa);
+Bool       soa_vector_reserve(SoaVector* soa, Size capacity);
+void       soa_vector_clear(SoaVector* soa);
+
+Size soa_vector_extend(SoaVector* soa, Size count);
+void soa_vector_pop_back(SoaVector* soa);
+void soa_vector_swap(SoaVector* soa, Size p1, Size p2);
+void soa_vector_sort_by_column(SoaVector* soa, Size col, CompareElementCallback compare, void* udata);
+
+/*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
+
+#include <Anvie/Containers/Interface/SoaVector.h>
+
+#endif // ANVIE_UTILS_CONTAINERS_SOA_VECTOR_H
@@ -29,6 +29,14 @@
 #include <Anvie/Containers/BitVector.h>
 #include <Anvie/Containers/Vector.h>
 #include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/BloomFilter.h>
+#include <Anvie/Allocators/BlockAllocator.h>
+
+/**
+ * Flag for @c sparse_map_build_from_arrays : keys are distinct from each other
+ * and from keys already in map, so no bucket chain needs to be searched on insert.
+ * */
+#define SPARSE_MAP_BUILD_UNIQUE_KEYS (1u << 0)
 
 /**
  * Represents a single item in the hash table.
@@ -46,6 +54,7 @@ struct SparseMapItem {
     void*          key;         /**< To find position in sparse_map : `pos = hash(key) % length`*/
     void*          data;        /**< Data stored in this hash item. This is always a separate copy from what's provided by user. */
     SparseMapItem* next;        /*< Point to next item in this bucket. If this is the last entry, then this ponts to NULL. */
+    Size           hash;        /**< Hash of key, so that rehashing never calls `hash` and mismatching keys are rejected without comparing them. */
 };
 
 /* create vector to store sparse map items */
@@ -54,6 +63,22 @@ void create_smi_copy(SparseMapItem* dst, SparseMapItem* src,  Smi_CallbackData*
 void destroy_smi_copy(SparseMapItem* copy, Smi_CallbackData* clbk_data);
 DEF_STRUCT_VECTOR_INTERFACE(smi, Smi, SparseMapItem, create_smi_copy, destroy_smi_copy);
 
+/**
+ * Position of an iteration over a @c SparseMap. Zero initialize to start
+ * from first item, eg: `SparseMapIterator iter = {0};`
+ * */
+typedef struct SparseMapIterator {
+    Size           bucket; /**< Bucket from where search for next occupied bucket starts. */
+    SparseMapItem* next;   /**< Next chained item of current bucket, NULL when bucket is done. */
+} SparseMapIterator;
+
+/**
+ * Callback called for each item by @c sparse_map_foreach and @c sparse_map_drain.
+ * @param item Item in map, in same form as returned by @c sparse_map_search.
+ * @param udata User data passed to foreach call.
+ * */
+typedef void (*SparseMapVisitorCallback)(SparseMapItem* item, void* udata);
+
 /**
  * @brief Analogous to @c std::unordered_map or @c std::unordered_multimap in CPP.
  *
@@ -77,6 +102,10 @@ DEF_STRUCT_VECTOR_INTERFACE(smi, Smi, SparseMapItem, create_smi_copy, destroy_sm
  * - For data sizes of 1, 2, 4, or 8 and if it's a structured data, it's mandatory to provide
  *   copy constructors and destructors. Otherwise, the implementation will copy the pointer
  *   rather than the data pointed to by the pointer.
+ * - Keys and data of at most 8 bytes are passed by value, like elements of a @c Vector.
+ *   Their copy constructor is given address of key or data field of the item itself,
+ *   so a copied @c ZString key is stored right in the item and passed to `hash` and
+ *   `compare_key` the same way a user given key is.
  * - The implementation uses separate chaining for collision resolution, distinguishing it from
  *   @c DenseMap, which stores all elements in a linear array using linear probing (Robin Hood).
  *
@@ -104,6 +133,16 @@ typedef struct SparseMap {
     Size                       item_count; /**< Total number of elements in the hash table. */
     BitVector*                 occupancy; /**< BitVector to store whether a particular bucket is empty or occupied. */
     Smi_Vector*                map; /**< Vector<SparseMapItem> A vector to store all elements in the map. */
+    Allocator*                 allocator; /**< Allocator for buckets and key/data copies. NULL means system allocator. */
+    LinBlockAllocator*         node_pool; /**< Pool from which chained items are allocated. */
+    Bool                       owns_node_pool; /**< True when @c node_pool was created by this map and is destroyed with it. */
+    BloomFilter*               filter; /**< Optional filter of inserted keys checked before probing, NULL when disabled. */
+    Size                       rehash_budget; /**< Old buckets migrated per operation by incremental rehash, 0 to rehash all at once. */
+    Smi_Vector*                old_map; /**< Buckets of table being migrated from, NULL when no migration is in progress. */
+    BitVector*                 old_occupancy; /**< Occupancy of table being migrated from. */
+    Size                       migrate_pos; /**< Buckets of old table before this one have been migrated. */
+    Float32                    min_load_factor; /**< Load below which a deletion shrinks the hash table, 0 to never shrink. */
+    Size                       resize_count; /**< Number of times table was rebuilt, reported by @c sparse_map_stats. */
 } SparseMap;
 
 SparseMap* sparse_map_create(
@@ -118,11 +157,46 @@ SparseMap* sparse_map_create(
     Bool                       is_multimap,
     Float32                    max_load_factor
 );
+SparseMap* sparse_map_create_with_allocator(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy,
+    Bool                       is_multimap,
+    Float32                    max_load_factor,
+    Allocator*                 allocator,
+    LinBlockAllocator*         node_pool
+);
 void           sparse_map_destroy(SparseMap* map, void* udata);
 void           sparse_map_resize(SparseMap* map, Size size, void* udata);
+void           sparse_map_reserve(SparseMap* map, Size expected_count, void* udata);
+void           sparse_map_shrink_to_fit(SparseMap* map, void* udata);
+void           sparse_map_set_shrink_watermark(SparseMap* map, Float32 min_load_factor);
 SparseMapItem* sparse_map_insert(SparseMap* map, void* key, void* value, void* udata);
 SparseMapItem* sparse_map_search(SparseMap* map, void* key, void* udata);
+SparseMapItem* sparse_map_insert_with_hash(SparseMap* map, void* key, void* value, Size hash, void* udata);
+SparseMapItem* sparse_map_search_with_hash(SparseMap* map, void* key, Size hash, void* udata);
+Size           sparse_map_search_batch(SparseMap* map, void** keys, Size n, SparseMapItem** out, void* udata);
+Size           sparse_map_insert_batch(SparseMap* map, void** keys, void** values, Size n, SparseMapItem** out, void* udata);
+Size           sparse_map_build_from_arrays(SparseMap* map, void** keys, void** values, Size n, Uint32 flags, void* udata);
 void           sparse_map_delete(SparseMap* map, void* key, void* udata);
+void           sparse_map_enable_filter(SparseMap* map, Size expected_count, Float64 false_positive_rate, void* udata);
+void           sparse_map_disable_filter(SparseMap* map);
+
+SparseMapItem* sparse_map_iter_next(SparseMap* map, SparseMapIterator* iter);
+void           sparse_map_foreach(SparseMap* map, SparseMapVisitorCallback visitor, void* udata);
+void           sparse_map_clear(SparseMap* map, void* udata);
+void           sparse_map_drain(SparseMap* map, SparseMapVisitorCallback visitor, void* udata);
+
+void           sparse_map_enable_incremental_rehash(SparseMap* map, Size budget);
+void           sparse_map_disable_incremental_rehash(SparseMap* map, void* udata);
+Bool           sparse_map_rehash_step(SparseMap* map, Size budget, void* udata);
+
+void           sparse_map_stats(SparseMap* map, HashMapStats* stats);
 
 #include <Anvie/Containers/Interface/SparseMap.h>
 
@@ -165,4 +239,10 @@ DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(u64_zstr, U64, ZS
 /*                                                             prefix     prefix     hash       ktype    kcreate           kdestroy           kcompare      dtype    dcreate           ddestroy           is_multimap  max_load_factor */
 DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(zstr_zstr, ZStr, ZStr, hash_zstr, ZString, zstr_create_copy, zstr_destroy_copy, compare_zstr, ZString, zstr_create_copy, zstr_destroy_copy, True, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
 
+/* strings packed into a StringArena, which is passed as udata, see StringArena.h */
+DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(zstr_arena_u32, ZStrArena, U32, hash_zstr, ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, compare_zstr, Uint32 , NULL, NULL, True, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(zstr_arena_u64, ZStrArena, U64, hash_zstr, ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, compare_zstr, Uint64 , NULL, NULL, True, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(u32_zstr_arena, U32, ZStrArena, hash_u32 , Uint32 , NULL, NULL, compare_u32 , ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, True, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(u64_zstr_arena, U64, ZStrArena, hash_u64 , Uint64 , NULL, NULL, compare_u64 , ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena, True, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
 #endif // ANVIE_UTILS_CONTAINERS_SPARSE_MAP_H
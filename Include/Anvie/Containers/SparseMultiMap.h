@@ -0,0 +1,105 @@
+/**
+ * @file SparseMultiMap.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A multimap that stores all values of a key next to each other.
+ * Each distinct key has a single entry in a @c SparseMap, and that entry
+ * owns a @c Vector with all values of the key, so getting all values of
+ * a key is one search and no chain walk.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_SPARSE_MULTI_MAP_H
+#define ANVIE_UTILS_CONTAINERS_SPARSE_MULTI_MAP_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/SparseMap.h>
+#include <Anvie/Containers/Vector.h>
+
+/**
+ * Callback called for each value of a key by @c sparse_multimap_foreach_value.
+ * @param value Pointer to value stored in map.
+ * @param udata User data passed to foreach call.
+ * */
+typedef void (*SparseMultiMapValueCallback)(void* value, void* udata);
+
+/**
+ * @brief Analogous to @c std::unordered_multimap in CPP, but with values of
+ * each key grouped together.
+ *
+ * KEYS
+ * - @c keys is a @c SparseMap with unique keys. Key semantics are same as
+ *   there : by value when @c key_size is at most 8 and no key copy callbacks
+ *   are given, pointer to key otherwise.
+ * - data of each item in @c keys is a @c Vector* holding values of that key.
+ *   A key is removed as soon as it's last value is deleted, so this vector
+ *   is never empty.
+ *
+ * VALUES
+ * - values are passed just like to a @c Vector : by value when @c value_size
+ *   is at most 8, pointer to value otherwise. Value copy callbacks are
+ *   used same as in a @c Vector.
+ * - values of a key are kept in order of insertion.
+ * - @c sparse_multimap_equal_range returns a view over values of a key.
+ *   View is invalidated by next insert or delete of same key.
+ * */
+typedef struct SparseMultiMap {
+    SparseMap*                 keys; /**< Map from each distinct key to @c Vector* of it's values. */
+    Size                       value_size; /**< Size of each value in bytes. */
+    CreateElementCopyCallback  create_value_copy; /**< Copy constructor of value. */
+    DestroyElementCopyCallback destroy_value_copy; /**< Copy destructor of value. */
+    Size                       value_count; /**< Total number of values of all keys. */
+    Allocator*                 allocator; /**< Allocator for value vectors. NULL means system allocator. */
+} SparseMultiMap;
+
+SparseMultiMap* sparse_multimap_create(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       value_size,
+    CreateElementCopyCallback  create_value_copy,
+    DestroyElementCopyCallback destroy_value_copy
+);
+SparseMultiMap* sparse_multimap_create_with_allocator(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       value_size,
+    CreateElementCopyCallback  create_value_copy,
+    DestroyElementCopyCallback destroy_value_copy,
+    Allocator*                 allocator
+);
+void sparse_multimap_destroy(SparseMultiMap* map, void* udata);
+
+Bool       sparse_multimap_insert(SparseMultiMap* map, void* key, void* value, void* udata);
+VectorView sparse_multimap_equal_range(SparseMultiMap* map, void* key, void* udata);
+Size       sparse_multimap_count(SparseMultiMap* map, void* key, void* udata);
+void       sparse_multimap_foreach_value(SparseMultiMap* map, void* key, SparseMultiMapValueCallback visitor, void* udata);
+Size       sparse_multimap_delete(SparseMultiMap* map, void* key, void* udata);
+Bool       sparse_multimap_delete_value(SparseMultiMap* map, void* key, Size pos, void* udata);
+void       sparse_multimap_clear(SparseMultiMap* map, void* udata);
+
+#define sparse_multimap_key_count(map) ((map)->keys->item_count)
+#define sparse_multimap_value_count(map) ((map)->value_count)
+
+#endif // ANVIE_UTILS_CONTAINERS_SPARSE_MULTI_MAP_H
@@ -21,8 +21,23 @@
  * in a memory safe manner and quite efficient manner based on use case.
  * */
 
+#ifndef ANVIE_UTILS_CONTAINERS_STRING_H
+#define ANVIE_UTILS_CONTAINERS_STRING_H
+
 #include <Anvie/Types.h>
 #include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/StringView.h>
+#include <Anvie/Containers/Image.h>
+#include <stdarg.h>
+
+#ifndef STR_INLINE_CAPACITY
+/**
+ * Number of bytes a @c String stores inside itself before it's data
+ * spills to a separate allocation. Keeps whole object within 56 bytes.
+ * */
+#define STR_INLINE_CAPACITY 24
+#endif// STR_INLINE_CAPACITY
 
 /**
  * @c String is a container to store non-NULL
@@ -45,19 +60,41 @@
  * and may reduce performance. Besides, the application must
  * guarantee that it won't try to access contents of string beyond
  * it's length.
+ *
+ * Short strings of upto @c STR_INLINE_CAPACITY bytes are stored in
+ * @c inline_data, and @c data then points into the object itself. Only
+ * when string grows beyond that, it's contents are moved to a separate
+ * allocation. Because of this a @c String must never be copied by value,
+ * use @c str_clone instead.
  * */
 typedef struct String {
-    char*   data;     /**< Non @c NULL terminated character array */
-    Size    length;   /**< current length of @c data */
-    Size    capacity; /**< total memory allocated for string @c data */
+    char*      data;      /**< Non @c NULL terminated character array, either @c inline_data or allocated */
+    Size       length;    /**< current length of @c data */
+    Size       capacity;  /**< total memory available for string @c data */
+    Allocator* allocator; /**< allocator for @c data, NULL for system allocator */
+    Char       inline_data[STR_INLINE_CAPACITY]; /**< storage of @c data for short strings */
 } String;
 
+#define str_is_inline(sb) ((sb)->data == (sb)->inline_data)
+
+/**
+ * View of whole contents of a @c String, valid until string is modified
+ * or destroyed. Use this to pass a @c String to any @c strview_ function.
+ * */
+static FORCE_INLINE StringView str_view(String* str) {
+    return strview(str->data, str->length);
+}
+
 #define str_at(sb, idx) if(sb && sb->str) sb->str[idx]
 
 String* str_create(ZString str);
+String* str_create_with_allocator(ZString str, Allocator* allocator);
 void    str_destroy(String* strbuf);
 
 String* str_clone(String* sb);
+Size    str_write_to_buffer(String* str, void* buffer, Size capacity);
+Bool    str_serialize_to_fd(String* str, int fd);
+String* str_from_image(Image* image);
 ZString str_clone_to_zstr(String* sb);
 
 void    str_set_zstr(String* strbuf, ZString zstr);
@@ -68,6 +105,9 @@ Int32   str_cmpn_zstr(String* sb, ZString zs, Size n);
 Int32   str_cmp(String* sb1, String* sb2);
 Int32   str_cmpn(String* sb1, String* sb2, Size n);
 
+Uint64  str_hash(String* sb, void* udata);
+Uint64  str_hash_seeded(String* sb, Uint64 seed);
+
 void    str_reserve(String* buf, Size n);
 void    str_clear(String* buf);
 void    str_clear_fast(String* buf);
@@ -77,3 +117,33 @@ Char    str_pop_char(String* buf);
 void    str_push_zstr(String* buf, ZString s);
 void    str_pushn_zstr(String* buf, ZString s, Size n);
 ZString str_popn_zstr(String* buf, Size n);
+
+StringView str_subview(String* str, Size pos, Size length);
+StringView str_popn_view(String* str, Size n);
+Int32      str_cmp_view(String* str, StringView sv);
+void       str_push_view(String* str, StringView sv);
+void       str_set_view(String* str, StringView sv);
+
+Size str_appendf(String* str, ZString fmt, ...) __attribute__((format(printf, 2, 3)));
+Size str_vappendf(String* str, ZString fmt, va_list args);
+void str_push_u64(String* str, Uint64 value);
+void str_push_i64(String* str, Int64 value);
+void str_push_f64(String* str, Float64 value);
+
+Size    str_find_char(String* str, Char c, Size from);
+Size    str_find_any(String* str, ZString set, Size from);
+Size    str_find(String* str, ZString needle, Size from);
+Size    str_findn(String* str, const Char* needle, Size n, Size from);
+Size    str_count_char(String* str, Char c);
+
+Bool str_validate_utf8(String* str);
+Bool str_is_ascii(String* str);
+Size str_utf8_length(String* str);
+void str_to_lower(String* str);
+void str_to_upper(String* str);
+
+Size                str_split(String* str, Char delim, StringView* fields, Size max_fields);
+StringSplitIterator str_split_iter(String* str, Char delim);
+Bool                str_split_next(StringSplitIterator* iter, StringView* field);
+
+#endif // ANVIE_UTILS_CONTAINERS_STRING_H
@@ -0,0 +1,107 @@
+/**
+ * @file StringArena.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Storage of many null terminated strings packed back to back in
+ * large chunks, so that containers of strings need no allocation per string.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_STRING_ARENA_H
+#define ANVIE_UTILS_CONTAINERS_STRING_ARENA_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/Common.h>
+#include <string.h>
+
+#ifndef STRING_ARENA_DEFAULT_CHUNK_SIZE
+/**
+ * Default size of each chunk strings are packed into.
+ * A string larger than chunk size gets a chunk of it's own.
+ * */
+#define STRING_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#endif
+
+/** Bytes stored before each string, holding it's length. */
+#define STRING_ARENA_HEADER_SIZE sizeof(Uint32)
+
+/**
+ * A chunk of a @c StringArena. Chunks are kept in a singly linked list,
+ * chunk strings are being added to first.
+ * */
+typedef struct StringArenaChunk {
+    struct StringArenaChunk* next;     /**< Next chunk in list. */
+    Size                     capacity; /**< Number of bytes in @c data. */
+    Size                     used;     /**< Number of bytes used in @c data. */
+    Char                     data[];   /**< Packed strings. */
+} StringArenaChunk;
+
+/**
+ * Storage of strings that are never freed one by one.
+ *
+ * STORAGE
+ * - each string is copied once into a chunk, preceded by it's length and
+ *   followed by a null terminator. Strings never move, except during a
+ *   compaction, so a string can be stored anywhere as a plain @c ZString.
+ * - releasing a string only counts it's bytes as wasted. All strings
+ *   are freed together by @c string_arena_destroy or @c string_arena_reset,
+ *   in time proportional to number of chunks, not number of strings.
+ * - when many strings are released, @c string_arena_compact copies
+ *   strings still in use to new chunks and frees old ones.
+ * */
+typedef struct StringArena {
+    StringArenaChunk* chunks;       /**< Chunk list, strings are added to first one. */
+    StringArenaChunk* retired;      /**< Chunks being compacted from, NULL outside a compaction. */
+    Size              chunk_size;   /**< Size of each new chunk. */
+    Size              used_size;    /**< Bytes taken by all strings, including released ones. */
+    Size              wasted_size;  /**< Bytes taken by released strings. */
+    Size              string_count; /**< Number of strings added and not yet released. */
+    Allocator*        allocator;    /**< Allocator for chunks, NULL for system allocator. */
+} StringArena;
+
+StringArena* string_arena_create(Size chunk_size, Allocator* allocator);
+void         string_arena_destroy(StringArena* arena);
+void         string_arena_reset(StringArena* arena);
+
+ZString string_arena_push(StringArena* arena, ZString zstr);
+ZString string_arena_pushn(StringArena* arena, const Char* data, Size length);
+void    string_arena_release(StringArena* arena, ZString zstr);
+
+void string_arena_compact(StringArena* arena, ZString* strings, Size count);
+void string_arena_compact_begin(StringArena* arena);
+void string_arena_relocate(StringArena* arena, ZString* zstr);
+void string_arena_compact_end(StringArena* arena);
+
+#define string_arena_count(arena) ((arena)->string_count)
+#define string_arena_wasted_size(arena) ((arena)->wasted_size)
+#define string_arena_used_size(arena) ((arena)->used_size)
+
+/**
+ * Length of a string stored in a @c StringArena, read from it's header
+ * instead of searching for it's null terminator.
+ *
+ * @param zstr String returned by @c string_arena_push or @c string_arena_pushn.
+ * */
+static FORCE_INLINE Size string_arena_length(ZString zstr) {
+    Uint32 length;
+    memcpy(&length, zstr - STRING_ARENA_HEADER_SIZE, sizeof(length));
+    return length;
+}
+
+#endif // ANVIE_UTILS_CONTAINERS_STRING_ARENA_H
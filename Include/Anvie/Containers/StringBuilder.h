@@ -0,0 +1,92 @@
+/**
+ * @file StringBuilder.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A @c StringBuilder appends into a chain of chunks that never
+ * move, so building a large string never copies what was already written.
+ * Result is either written out chunk by chunk, or copied once into a
+ * @c String.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_STRING_BUILDER_H
+#define ANVIE_UTILS_CONTAINERS_STRING_BUILDER_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Containers/String.h>
+#include <Anvie/Containers/StringView.h>
+#include <sys/uio.h>
+
+#ifndef STRING_BUILDER_DEFAULT_CHUNK_SIZE
+/** Capacity of each chunk when none is given on creation. */
+#define STRING_BUILDER_DEFAULT_CHUNK_SIZE (4 * 1024)
+#endif// STRING_BUILDER_DEFAULT_CHUNK_SIZE
+
+/**
+ * One chunk of a @c StringBuilder, with it's characters stored right after it.
+ * */
+typedef struct StringBuilderChunk {
+    struct StringBuilderChunk* next;     /**< Next chunk in chain, NULL for last one. */
+    Size                       length;   /**< Number of characters written to chunk. */
+    Size                       capacity; /**< Number of characters chunk can hold. */
+    Char                       data[];   /**< Characters of chunk. */
+} StringBuilderChunk;
+
+/**
+ * Append only string stored in a chain of chunks.
+ *
+ * - each chunk holds @c chunk_size characters. An append that does not fit
+ *   fills rest of last chunk and continues in a new one, so nothing written
+ *   is ever moved.
+ * - an append larger than @c chunk_size gets a chunk of it's own size, so
+ *   large appends are never split into many small chunks.
+ * - @c string_builder_clear keeps all chunks for reuse, so repeatedly building
+ *   strings of similar size allocates only the first time.
+ * - an arena allocator, from @c arena_get_allocator, makes each new chunk a
+ *   pointer bump, and all chunks are released with arena.
+ * */
+typedef struct StringBuilder {
+    StringBuilderChunk* head;        /**< First chunk, NULL if none is allocated yet. */
+    StringBuilderChunk* tail;        /**< Chunk being appended to. */
+    Size                length;      /**< Total number of characters appended. */
+    Size                chunk_count; /**< Number of chunks with atleast one character. */
+    Size                chunk_size;  /**< Capacity of each new chunk. */
+    Allocator*          allocator;   /**< Allocator for builder and chunks, NULL for system allocator. */
+} StringBuilder;
+
+StringBuilder* string_builder_create(Size chunk_size, Allocator* allocator);
+void           string_builder_destroy(StringBuilder* sb);
+void           string_builder_clear(StringBuilder* sb);
+
+Bool  string_builder_push_char(StringBuilder* sb, Char c);
+Bool  string_builder_push_zstr(StringBuilder* sb, ZString zstr);
+Bool  string_builder_pushn(StringBuilder* sb, const Char* data, Size n);
+Bool  string_builder_push_view(StringBuilder* sb, StringView sv);
+Bool  string_builder_push_str(StringBuilder* sb, String* str);
+Char* string_builder_reserve(StringBuilder* sb, Size n);
+void  string_builder_commit(StringBuilder* sb, Size n);
+
+Size    string_builder_iovecs(StringBuilder* sb, struct iovec* iov, Size max_iov);
+Size    string_builder_copy_to(StringBuilder* sb, Char* dst, Size capacity);
+Bool    string_builder_append_to(StringBuilder* sb, String* str);
+String* string_builder_finish(StringBuilder* sb);
+
+#define string_builder_length(sb) ((sb)->length)
+
+#endif // ANVIE_UTILS_CONTAINERS_STRING_BUILDER_H
@@ -0,0 +1,152 @@
+/**
+ * @file StringPool.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief String interning. A @c StringPool stores each distinct string
+ * once and gives it a 32 bit @c Symbol, so strings can be stored, hashed
+ * and compared as plain integers.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_STRING_POOL_H
+#define ANVIE_UTILS_CONTAINERS_STRING_POOL_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
+#include <Anvie/Allocators/Arena.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/String.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Containers/SparseMap.h>
+#include <Anvie/Containers/ConcurrentMap.h>
+#include <pthread.h>
+
+/** Identifier of an interned string. Same string always has same symbol in a pool. */
+typedef Uint32 Symbol;
+
+/** Symbol never given to any string, returned when a string is not found. */
+#define SYMBOL_NONE ((Symbol)0)
+
+#ifndef STRING_POOL_FIRST_SEGMENT_SIZE
+/**
+ * Number of symbols in first segment of symbol table. Each next segment
+ * is twice as large as previous one. Must be a power of two.
+ * */
+#define STRING_POOL_FIRST_SEGMENT_SIZE 256
+#endif
+
+/** Number of segments needed to hold every 32 bit symbol. */
+#define STRING_POOL_SEGMENT_COUNT (33 - __builtin_ctz(STRING_POOL_FIRST_SEGMENT_SIZE))
+
+/**
+ * Key of index of a @c StringPool : bytes of an interned string.
+ * */
+typedef struct StringPoolKey {
+    const Char* data;   /**< Bytes of string, in arena of pool. */
+    Size        length; /**< Number of bytes. */
+} StringPoolKey;
+
+/**
+ * Storage of distinct strings, each identified by a @c Symbol.
+ *
+ * STORAGE
+ * - bytes of each string are copied once into an @c Arena, followed by a
+ *   null terminator and preceded by their length, so strings never move and
+ *   are freed all at once with pool.
+ * - string of a symbol is found in constant time through a table split in
+ *   segments of doubling size. Segments never move either, so a symbol can
+ *   be looked up while other strings are being interned.
+ * - symbols are given in order, starting from 1. @c SYMBOL_NONE is never
+ *   given, so a zeroed @c Symbol means no string.
+ * */
+typedef struct StringPool {
+    DenseMap*  index;                               /**< Map from @c StringPoolKey to symbol. */
+    Arena*     bytes;                               /**< Storage of bytes of all strings. */
+    ZString*   segments[STRING_POOL_SEGMENT_COUNT]; /**< String of each symbol, allocated as needed. */
+    Size       count;                               /**< Number of symbols given. */
+    Size       max_count;                           /**< Maximum number of symbols pool may give. */
+    Allocator* allocator;                           /**< Allocator for index and segments, NULL for system allocator. */
+} StringPool;
+
+StringPool* string_pool_create(Allocator* allocator);
+void        string_pool_destroy(StringPool* pool);
+void        string_pool_reserve(StringPool* pool, Size count);
+
+Symbol  string_pool_intern(StringPool* pool, ZString zstr);
+Symbol  string_pool_internn(StringPool* pool, const Char* data, Size length);
+Symbol  string_pool_intern_str(StringPool* pool, String* str);
+Symbol  string_pool_intern_with_hash(StringPool* pool, const Char* data, Size length, Uint64 hash);
+Symbol  string_pool_find(StringPool* pool, ZString zstr);
+Symbol  string_pool_findn(StringPool* pool, const Char* data, Size length);
+ZString string_pool_lookup(StringPool* pool, Symbol sym);
+Size    string_pool_length(StringPool* pool, Symbol sym);
+
+#define string_pool_count(pool) ((pool)->count)
+
+/**
+ * One shard of a @c ConcurrentStringPool. @c pool is interned into only
+ * with @c lock held.
+ * */
+typedef struct ConcurrentStringPoolShard {
+    pthread_mutex_t lock; /**< Held while interning or finding a string. */
+    StringPool*     pool; /**< Strings whose hash selects this shard. */
+} __attribute__((aligned(CONCURRENT_MAP_CACHE_LINE_SIZE))) ConcurrentStringPoolShard;
+
+/**
+ * A @c StringPool safe to share between any number of threads.
+ *
+ * Strings are split into shards the same way as keys of a
+ * @c ConcurrentMap, each shard with it's own lock. Lowest bits of a symbol
+ * are it's shard, rest are it's symbol in that shard, so symbols stay
+ * unique and stable across whole pool.
+ *
+ * Looking up string of a symbol takes no lock at all. A symbol must only
+ * reach another thread through some synchronization (a lock, an atomic
+ * store with release ordering, etc...), as any value shared between
+ * threads would.
+ * */
+typedef struct ConcurrentStringPool {
+    ConcurrentStringPoolShard* shards;            /**< Array of @c shard_count shards. */
+    Size                       shard_count;       /**< Number of shards, a power of two. */
+    Uint32                     shard_bits;        /**< Number of low bits of symbol giving shard. */
+    Uint32                     shard_shift;       /**< Right shift of mixed hash that gives shard index. */
+    void*                      shard_memory;      /**< Unaligned allocation holding @c shards. */
+    Size                       shard_memory_size; /**< Size of @c shard_memory in bytes. */
+    Allocator*                 allocator;         /**< Allocator for all memory owned by pool, NULL for system allocator. */
+} ConcurrentStringPool;
+
+ConcurrentStringPool* concurrent_string_pool_create(Size shard_count, Allocator* allocator);
+void                  concurrent_string_pool_destroy(ConcurrentStringPool* pool);
+
+Symbol  concurrent_string_pool_intern(ConcurrentStringPool* pool, ZString zstr);
+Symbol  concurrent_string_pool_internn(ConcurrentStringPool* pool, const Char* data, Size length);
+Symbol  concurrent_string_pool_findn(ConcurrentStringPool* pool, const Char* data, Size length);
+ZString concurrent_string_pool_lookup(ConcurrentStringPool* pool, Symbol sym);
+Size    concurrent_string_pool_count(ConcurrentStringPool* pool);
+
+/* maps keyed by symbol, where comparing keys is one integer comparision */
+#define hash_symbol hash_u32
+#define compare_symbol compare_u32
+
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(sym_u32, Sym_U32_, hash_symbol, Symbol, NULL, NULL, compare_symbol, Uint32, NULL, NULL, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(sym_u64, Sym_U64_, hash_symbol, Symbol, NULL, NULL, compare_symbol, Uint64, NULL, NULL, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_DENSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(sym_sym, Sym_Sym_, hash_symbol, Symbol, NULL, NULL, compare_symbol, Symbol, NULL, NULL, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
+DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(sym_u32, Sym, U32, hash_symbol, Symbol, NULL, NULL, compare_symbol, Uint32, NULL, NULL, False, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INTEGER_INTEGER_SPARSE_MAP_INTERFACE_WITH_COPY_AND_DESTROY(sym_u64, Sym, U64, hash_symbol, Symbol, NULL, NULL, compare_symbol, Uint64, NULL, NULL, False, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
+#endif // ANVIE_UTILS_CONTAINERS_STRING_POOL_H
@@ -0,0 +1,135 @@
+/**
+ * @file StringView.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A @c StringView refers to characters owned by someone else, a
+ * @c String, a string literal, a file mapped in memory, etc... Views are
+ * passed by value, and comparing, hashing, searching or slicing them never
+ * copies a byte or needs a null terminator.
+ * */
+
+#ifndef ANVIE_UTILS_CONTAINERS_STRING_VIEW_H
+#define ANVIE_UTILS_CONTAINERS_STRING_VIEW_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/Vector.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <string.h>
+
+/**
+ * A non owning reference to a run of characters, eg: a field of a
+ * @c String returned by @c str_split. Valid as long as the referenced
+ * bytes are not modified or freed.
+ * */
+typedef struct StringView {
+    const Char* data;   /**< First character, not null terminated. */
+    Size        length; /**< Number of characters. */
+} StringView;
+
+/**
+ * State of a split over a @c StringView or a @c String,
+ * see @c strview_split_iter.
+ * */
+typedef struct StringSplitIterator {
+    const Char* data;   /**< Bytes being split. */
+    Size        length; /**< Number of bytes being split. */
+    Size        pos;    /**< Start of next field, greater than @c length when done. */
+    Char        delim;  /**< Delimiter between fields. */
+} StringSplitIterator;
+
+/** View of a string literal, length computed at compile time. */
+#define STRVIEW_LITERAL(s) ((StringView){(s), sizeof(s) - 1})
+
+#define strview_is_empty(sv) ((sv).length == 0)
+
+/**
+ * Create view of given bytes.
+ *
+ * @param data First character, need not be null terminated.
+ * @param length Number of characters.
+ * */
+static FORCE_INLINE StringView strview(const Char* data, Size length) {
+    return (StringView){data, length};
+}
+
+/**
+ * Create view of a null terminated string, without it's terminator.
+ *
+ * @param zstr Null terminated string, NULL gives an empty view.
+ * */
+static FORCE_INLINE StringView strview_from_zstr(ZString zstr) {
+    return (StringView){zstr, zstr ? strlen(zstr) : 0};
+}
+
+Int32  strview_cmp(StringView sv1, StringView sv2);
+Int32  strview_cmp_zstr(StringView sv, ZString zstr);
+Bool   strview_equal(StringView sv1, StringView sv2);
+Bool   strview_starts_with(StringView sv, StringView prefix);
+Bool   strview_ends_with(StringView sv, StringView suffix);
+
+Uint64 strview_hash_seeded(StringView sv, Uint64 seed);
+
+Size   strview_find_char(StringView sv, Char c, Size from);
+Size   strview_rfind_char(StringView sv, Char c);
+Size   strview_find_any(StringView sv, ZString set, Size from);
+Size   strview_find(StringView sv, StringView needle, Size from);
+Size   strview_count_char(StringView sv, Char c);
+
+StringView strview_sub(StringView sv, Size pos, Size length);
+StringView strview_left(StringView sv, Size n);
+StringView strview_right(StringView sv, Size n);
+StringView strview_trim(StringView sv);
+StringView strview_trim_left(StringView sv);
+StringView strview_trim_right(StringView sv);
+
+Size                strview_split(StringView sv, Char delim, StringView* fields, Size max_fields);
+StringSplitIterator strview_split_iter(StringView sv, Char delim);
+Bool                strview_split_next(StringSplitIterator* iter, StringView* field);
+
+Bool strview_validate_utf8(StringView sv);
+Bool strview_is_ascii(StringView sv);
+Size strview_utf8_length(StringView sv);
+
+/**
+ * Check whether a null terminated string is valid UTF-8,
+ * see @c strview_validate_utf8.
+ * */
+static FORCE_INLINE Bool zstr_validate_utf8(ZString zstr) {
+    return strview_validate_utf8(strview_from_zstr(zstr));
+}
+
+/* callbacks for containers of views, these get a pointer to the view */
+Uint64 hash_strview(const StringView* sv, void* udata);
+Int32  compare_strview(const StringView* sv1, const StringView* sv2, void* udata);
+
+/**
+ * Maps keyed by @c StringView. A view is larger than 8 bytes, so keys are
+ * stored inline and searches hash and compare the view passed in directly.
+ * Map stores only the view, bytes it refers to must outlive the map, eg: a
+ * @c StringPool, or a buffer read from a file. Searching with view of any
+ * other buffer, like a field of a line being parsed, needs no copy.
+ * */
+DEF_INLINE_DENSE_MAP_INTERFACE(strview_u32, StrView_U32_, hash_strview, StringView, compare_strview, Uint32, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+DEF_INLINE_DENSE_MAP_INTERFACE(strview_u64, StrView_U64_, hash_strview, StringView, compare_strview, Uint64, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
+/* vector of views, eg: to collect fields of a split */
+DEF_STRUCT_VECTOR_INTERFACE(strview, StrView, StringView, NULL, NULL);
+
+#endif // ANVIE_UTILS_CONTAINERS_STRING_VIEW_H
@@ -102,6 +102,7 @@ struct Tree {
     Size                       element_size; /**< Size of data element. */
     CreateElementCopyCallback  create_copy;  /**< Copy constructor for each element. Can be NULL. */
     DestroyElementCopyCallback destroy_copy; /**< Copy destructor for each element. Can be NULL. */
+    Size                       bulk_depth;   /**< Number of open @c tree_begin_bulk calls. Size and height are not maintained while non zero. */
 };
 #define TO_TREE(x) ((Tree*)(x))
 
@@ -310,6 +311,47 @@ FORCE_INLINE void tree_delete_fast(Tree* tree, Size index, void* udata) {
     tree_node_delete_fast(TO_TREE_NODE(tree), index, udata);
 }
 
+void tree_begin_bulk(Tree* tree);
+void tree_end_bulk(Tree* tree);
+
+/*------------------------------- TRAVERSAL --------------------------------*/
+
+/**
+ * Order in which a @c TreeIterator visits nodes.
+ * */
+typedef enum TreeTraversalOrder {
+    TREE_TRAVERSAL_PREORDER,    /**< Node first, then subtrees of it's children, left to right. */
+    TREE_TRAVERSAL_POSTORDER,   /**< Subtrees of children left to right, then node itself. */
+    TREE_TRAVERSAL_LEVEL_ORDER, /**< All nodes at depth d before any node at depth d + 1. */
+} TreeTraversalOrder;
+
+/**
+ * Walks a tree without recursion. Pending nodes are kept in an explicit
+ * stack (queue for level order), so depth of tree is limited only by memory.
+ *
+ * Tree must not be modified while it's being iterated. Destroy iterator
+ * with @c tree_iter_destroy once done, even if it wasn't run till end.
+ * */
+typedef struct TreeIterator {
+    VPtr_Vector*       nodes;      /**< Stack, or queue for level order, of nodes to visit. */
+    U64_Vector*        next_child; /**< Postorder only, index of next child to descend into for each node in stack. */
+    Size               head;       /**< Level order only, position of front of queue in @c nodes. */
+    TreeNode*          skip;       /**< Node not to be returned, root when iterating whole tree. */
+    TreeTraversalOrder order;
+} TreeIterator;
+
+TreeIterator tree_node_iter(TreeNode* node, TreeTraversalOrder order);
+TreeIterator tree_iter(Tree* tree, TreeTraversalOrder order);
+TreeNode*    tree_iter_next(TreeIterator* iter);
+void         tree_iter_destroy(TreeIterator* iter);
+
+/**
+ * Callback called for each node visited by @c tree_parallel_foreach.
+ * */
+typedef void (*TreeNodeVisitCallback)(TreeNode* node, void* udata);
+
+void tree_parallel_foreach(Tree* tree, TreeNodeVisitCallback visit, void* udata, Size nthreads);
+
 /*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
 
 #include <Anvie/Containers/Interface/Tree.h>
@@ -28,7 +28,36 @@
 #define UTILS_VECTOR_H
 
 #include <Anvie/Types.h>
+#include <Anvie/Allocators/Allocator.h>
 #include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/Image.h>
+
+/**
+ * Decide capacity of a vector that must hold at least @p min_capacity
+ * elements, when it's current capacity is @p capacity.
+ * Returned value less than @p min_capacity is treated as @p min_capacity.
+ * */
+typedef Size (*VectorGrowthCallback)(Size capacity, Size min_capacity, void* udata);
+
+/**
+ * How a vector computes it's new capacity when it runs out of space.
+ * */
+typedef enum VectorGrowthMode {
+    VECTOR_GROWTH_GEOMETRIC,  /**< multiply capacity by (1 + resize_factor) until large enough, the default */
+    VECTOR_GROWTH_FIXED_STEP, /**< add @c step to capacity until large enough */
+    VECTOR_GROWTH_CALLBACK    /**< ask @c callback for new capacity */
+} VectorGrowthMode;
+
+/**
+ * Growth policy of a vector. Policy is not copied, so it must stay
+ * alive as long as any vector using it, just like an @c Allocator.
+ * */
+typedef struct VectorGrowthPolicy {
+    VectorGrowthMode     mode;     /**< how new capacity is computed */
+    Size                 step;     /**< number of elements added at once in fixed step mode */
+    VectorGrowthCallback callback; /**< capacity decider in callback mode */
+    void*                udata;    /**< passed to @c callback */
+} VectorGrowthPolicy;
 
 /**
  * Represents a Dynamic Array.
@@ -53,8 +82,14 @@
  * - @c resize_factor decides what the new size of new allocation will be.
  * - new_size = old_size * (1 + resize_factor)
  * - this means a @c resize_factor of 1 means 2x resize and 2 means 3x resize.
- * - if @c free_when_possible is set to @c True, then array will autmatically be
- *   freed if new size is less than capcity/2. It is set to True by default.
+ * - a @c growth_policy, if set, decides new capacity instead, see @c VectorGrowthPolicy.
+ * - capacity never shrinks by itself, use @c vector_shrink_to_fit to give memory back.
+ *
+ * ALLOCATION SEMANTICS
+ * - all memory owned by vector is allocated using @c allocator.
+ * - a @c NULL @c allocator means system allocator is used.
+ * - if @c allocator releases memory in bulk (has no free callback), then
+ *   destroying vector does not destroy element copies either.
  *
  * CALLBACKS
  * Vector follows a callback based approach to allow user to control some key
@@ -97,11 +132,28 @@ typedef struct Vector {
     CreateElementCopyCallback  create_copy; /**< copy constructor functor */
     DestroyElementCopyCallback destroy_copy; /**< copy destructor functor */
     Float32                    resize_factor; /**< percent factor for resizing arrays, by defualt it's 1, this means 2x resize */
+    Allocator*                 allocator; /**< allocator for all memory owned by vector, NULL for system allocator */
+    const VectorGrowthPolicy*  growth_policy; /**< how capacity grows, NULL for geometric growth by resize_factor */
 } Vector;
 
 #define vector_at(vec, type, pos) ((type*)((vec)->data))[pos]
 #define vector_address_at(vec, pos) ((vec)->data + (pos) * (vec)->element_size)
 #define vector_length(vec) ((vec)->length)
+
+/**
+ * Same as @c vector_peek, but without any checks. @p vec must be valid and
+ * @p pos must be less than it's length. For loops that already know their
+ * indices are in range, eg: inside containers.
+ * */
+static FORCE_INLINE void* vector_peek_unchecked(Vector* vec, Size pos) {
+    switch(vec->element_size) {
+        case 8: return (void*)vector_at(vec, Uint64, pos);
+        case 4: return (void*)(Uint64)vector_at(vec, Uint32, pos);
+        case 2: return (void*)(Uint64)vector_at(vec, Uint16, pos);
+        case 1: return (void*)(Uint64)vector_at(vec, Uint8, pos);
+        default: return vector_address_at(vec, pos);
+    }
+}
 #define vector_element_size(vec) ((vec)->element_size)
 
 Vector* vector_create (
@@ -109,11 +161,23 @@ Vector* vector_create (
     CreateElementCopyCallback create_copy,
     DestroyElementCopyCallback destroy_copy
 );
+Vector* vector_create_with_allocator (
+    Size element_size,
+    CreateElementCopyCallback create_copy,
+    DestroyElementCopyCallback destroy_copy,
+    Allocator* allocator
+);
 void vector_destroy(Vector* vec, void* udata);
 Vector* vector_clone(Vector* vec, void* udata);
 
+Size vector_write_to_buffer(Vector* vec, void* buffer, Size capacity);
+Bool vector_serialize_to_fd(Vector* vec, int fd);
+Vector* vector_from_image(Image* image);
+
 void vector_resize(Vector* vec, Size new_size);
 void vector_reserve(Vector* vec, Size capacity);
+void vector_shrink_to_fit(Vector* vec);
+void vector_set_growth_policy(Vector* vec, const VectorGrowthPolicy* policy);
 void vector_clear(Vector* vec, void* udata);
 
 Vector* vector_get_subvector(Vector* vec, Size start, Size size, void* udata);
@@ -138,6 +202,11 @@ void* vector_pop_front(Vector* vec);
 void* vector_pop_front_fast(Vector* vec);
 
 void  vector_push_back(Vector* vec, void* data, void* udata);
+void  vector_push_back_n(Vector* vec, const void* array, Size count, void* udata);
+
+void vector_insert_range(Vector* vec, Size pos, const void* array, Size count, void* udata);
+void vector_delete_range(Vector* vec, Size pos, Size count, void* udata);
+void vector_assign_from_array(Vector* vec, const void* array, Size count, void* udata);
 void* vector_pop_back(Vector* vec);
 
 void* vector_peek(Vector* vec, Size pos);
@@ -148,16 +217,154 @@ void vector_print(Vector* vec, PrintElementCallback printer, void* udata);
 
 void vector_merge(Vector* vec, Vector* other, void* udata);
 Vector* vector_filter(Vector* vec, FilterElementCallback filter, void* udata);
-// TODO: accumulate, sort, iterators, intersection, duplicate, slice, insert_range
+Size vector_retain_if(Vector* vec, FilterElementCallback filter, void* udata);
+
+// in place range filters for integer vectors, all return new length of vector
+#define DECL_NUMERIC_VECTOR_RETAIN(sfx, type)                           \
+    Size vector_retain_eq_##sfx(Vector* vec, type value);               \
+    Size vector_retain_lt_##sfx(Vector* vec, type value);               \
+    Size vector_retain_in_range_##sfx(Vector* vec, type lo, type hi)
+
+DECL_NUMERIC_VECTOR_RETAIN(u8,  Uint8);
+DECL_NUMERIC_VECTOR_RETAIN(u16, Uint16);
+DECL_NUMERIC_VECTOR_RETAIN(u32, Uint32);
+DECL_NUMERIC_VECTOR_RETAIN(u64, Uint64);
+DECL_NUMERIC_VECTOR_RETAIN(i8,  Int8);
+DECL_NUMERIC_VECTOR_RETAIN(i16, Int16);
+DECL_NUMERIC_VECTOR_RETAIN(i32, Int32);
+DECL_NUMERIC_VECTOR_RETAIN(i64, Int64);
+
+#undef DECL_NUMERIC_VECTOR_RETAIN
+// TODO: accumulate, iterators, duplicate
 
 void vector_swap(Vector* vec, Size p1, Size p2);
 void vector_sort(Vector* vec, CompareElementCallback compare, void* udata);
+void vector_partial_sort(Vector* vec, Size count, CompareElementCallback compare, void* udata);
+void vector_nth_element(Vector* vec, Size nth, CompareElementCallback compare, void* udata);
 Bool vector_check_sorted(Vector* vec, CompareElementCallback compare, void* udata);
 
 // sorting algorithms
 void vector_insertion_sort(Vector* vec, CompareElementCallback compare, void* udata);
 void vector_bubble_sort(Vector* vec, CompareElementCallback compare, void* udata);
 void vector_merge_sort(Vector* vec, CompareElementCallback compare, void* udata);
+void vector_stable_sort(Vector* vec, CompareElementCallback compare, void* udata);
+void vector_stable_sort_with_buffer(Vector* vec, CompareElementCallback compare, void* udata, void* scratch, Size scratch_size);
+Size vector_stable_sort_scratch_size(Vector* vec);
+void vector_parallel_sort(Vector* vec, CompareElementCallback compare, void* udata, Size nthreads);
+
+// searches and set operations on sorted vectors
+Size vector_lower_bound(Vector* vec, void* data, CompareElementCallback compare, void* udata);
+Size vector_upper_bound(Vector* vec, void* data, CompareElementCallback compare, void* udata);
+Size vector_binary_search(Vector* vec, void* data, CompareElementCallback compare, void* udata);
+Vector* vector_sorted_union(Vector* vec, Vector* other, CompareElementCallback compare, void* udata);
+Vector* vector_sorted_intersect(Vector* vec, Vector* other, CompareElementCallback compare, void* udata);
+Vector* vector_sorted_difference(Vector* vec, Vector* other, CompareElementCallback compare, void* udata);
+
+// comparator free searches for numeric vectors sorted in ascending order
+#define DECL_NUMERIC_VECTOR_SEARCH(sfx, type)                           \
+    Size vector_lower_bound_##sfx(Vector* vec, type value);             \
+    Size vector_upper_bound_##sfx(Vector* vec, type value);             \
+    Size vector_binary_search_##sfx(Vector* vec, type value)
+
+DECL_NUMERIC_VECTOR_SEARCH(u8,  Uint8);
+DECL_NUMERIC_VECTOR_SEARCH(u16, Uint16);
+DECL_NUMERIC_VECTOR_SEARCH(u32, Uint32);
+DECL_NUMERIC_VECTOR_SEARCH(u64, Uint64);
+DECL_NUMERIC_VECTOR_SEARCH(i8,  Int8);
+DECL_NUMERIC_VECTOR_SEARCH(i16, Int16);
+DECL_NUMERIC_VECTOR_SEARCH(i32, Int32);
+DECL_NUMERIC_VECTOR_SEARCH(i64, Int64);
+DECL_NUMERIC_VECTOR_SEARCH(f32, Float32);
+DECL_NUMERIC_VECTOR_SEARCH(f64, Float64);
+
+#undef DECL_NUMERIC_VECTOR_SEARCH
+
+// linear scans and reductions for numeric vectors, vectorized where possible
+#define DECL_NUMERIC_VECTOR_REDUCE(sfx, type, sum_type)                 \
+    Size     vector_find_##sfx(Vector* vec, type value);                \
+    Size     vector_count_##sfx(Vector* vec, type value);               \
+    Bool     vector_contains_##sfx(Vector* vec, type value);            \
+    type     vector_min_##sfx(Vector* vec);                             \
+    type     vector_max_##sfx(Vector* vec);                             \
+    sum_type vector_sum_##sfx(Vector* vec)
+
+DECL_NUMERIC_VECTOR_REDUCE(u8,  Uint8,   Uint64);
+DECL_NUMERIC_VECTOR_REDUCE(u16, Uint16,  Uint64);
+DECL_NUMERIC_VECTOR_REDUCE(u32, Uint32,  Uint64);
+DECL_NUMERIC_VECTOR_REDUCE(u64, Uint64,  Uint64);
+DECL_NUMERIC_VECTOR_REDUCE(i8,  Int8,    Int64);
+DECL_NUMERIC_VECTOR_REDUCE(i16, Int16,   Int64);
+DECL_NUMERIC_VECTOR_REDUCE(i32, Int32,   Int64);
+DECL_NUMERIC_VECTOR_REDUCE(i64, Int64,   Int64);
+DECL_NUMERIC_VECTOR_REDUCE(f32, Float32, Float64);
+DECL_NUMERIC_VECTOR_REDUCE(f64, Float64, Float64);
+
+#undef DECL_NUMERIC_VECTOR_REDUCE
+
+// comparator free sorts for numeric vectors
+void vector_sort_u8(Vector* vec, Bool descending);
+void vector_sort_u16(Vector* vec, Bool descending);
+void vector_sort_u32(Vector* vec, Bool descending);
+void vector_sort_u64(Vector* vec, Bool descending);
+void vector_sort_i8(Vector* vec, Bool descending);
+void vector_sort_i16(Vector* vec, Bool descending);
+void vector_sort_i32(Vector* vec, Bool descending);
+void vector_sort_i64(Vector* vec, Bool descending);
+void vector_sort_f32(Vector* vec, Bool descending);
+void vector_sort_f64(Vector* vec, Bool descending);
+
+// comparator free top k selection for numeric vectors
+#define DECL_NUMERIC_VECTOR_SELECT(sfx)                                 \
+    void vector_partial_sort_##sfx(Vector* vec, Size count, Bool descending); \
+    void vector_nth_element_##sfx(Vector* vec, Size nth, Bool descending)
+
+DECL_NUMERIC_VECTOR_SELECT(u8);
+DECL_NUMERIC_VECTOR_SELECT(u16);
+DECL_NUMERIC_VECTOR_SELECT(u32);
+DECL_NUMERIC_VECTOR_SELECT(u64);
+DECL_NUMERIC_VECTOR_SELECT(i8);
+DECL_NUMERIC_VECTOR_SELECT(i16);
+DECL_NUMERIC_VECTOR_SELECT(i32);
+DECL_NUMERIC_VECTOR_SELECT(i64);
+DECL_NUMERIC_VECTOR_SELECT(f32);
+DECL_NUMERIC_VECTOR_SELECT(f64);
+
+#undef DECL_NUMERIC_VECTOR_SELECT
+
+/**
+ * A non owning view over a contiguous range of elements, usually of a
+ * @c Vector. Creating a view never allocates memory or calls copy constructors.
+ *
+ * A view stays valid only as long as the memory it points to. Any operation
+ * that may reallocate or shift elements of parent vector (insert, delete,
+ * resize, etc...) invalidates all views into it.
+ * */
+typedef struct VectorView {
+    Size       element_size; /**< size of each element in view */
+    Size       length; /**< number of elements in view */
+    UByteArray data; /**< first element of view, in parent buffer */
+} VectorView;
+
+#define vector_view_address_at(view, pos) ((view)->data + (pos) * (view)->element_size)
+#define vector_view_length(view) ((view)->length)
+
+VectorView vector_view_from_array(void* data, Size length, Size element_size);
+VectorView vector_get_view(Vector* vec, Size start, Size size);
+VectorView vector_view_slice(VectorView view, Size start, Size size);
+
+void* vector_view_peek(VectorView* view, Size pos);
+void* vector_view_front(VectorView* view);
+void* vector_view_back(VectorView* view);
+void  vector_view_print(VectorView* view, PrintElementCallback printer, void* udata);
+
+Size vector_view_find(VectorView* view, void* data, CompareElementCallback compare, void* udata);
+Size vector_view_lower_bound(VectorView* view, void* data, CompareElementCallback compare, void* udata);
+Size vector_view_upper_bound(VectorView* view, void* data, CompareElementCallback compare, void* udata);
+Size vector_view_binary_search(VectorView* view, void* data, CompareElementCallback compare, void* udata);
+
+void vector_view_sort(VectorView* view, CompareElementCallback compare, void* udata);
+void vector_view_stable_sort(VectorView* view, CompareElementCallback compare, void* udata);
+Bool vector_view_check_sorted(VectorView* view, CompareElementCallback compare, void* udata);
 
 /*---------------- DEFINE COMMON INTERFACES FOR TYPE-SAFETY-----------------*/
 
@@ -176,7 +383,52 @@ DEF_INTEGER_VECTOR_INTERFACE(i64, I64, Int64);
 DEF_INTEGER_VECTOR_INTERFACE(f32, F32, Float32);
 DEF_INTEGER_VECTOR_INTERFACE(f64, F64, Float64);
 
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(u8,  U8);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(u16, U16);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(u32, U32);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(u64, U64);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(i8,  I8);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(i16, I16);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(i32, I32);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(i64, I64);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(f32, F32);
+DEF_NUMERIC_VECTOR_SORT_INTERFACE(f64, F64);
+
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(u8,  U8,  Uint8);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(u16, U16, Uint16);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(u32, U32, Uint32);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(u64, U64, Uint64);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(i8,  I8,  Int8);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(i16, I16, Int16);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(i32, I32, Int32);
+DEF_NUMERIC_VECTOR_RETAIN_INTERFACE(i64, I64, Int64);
+
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(u8,  U8,  Uint8);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(u16, U16, Uint16);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(u32, U32, Uint32);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(u64, U64, Uint64);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(i8,  I8,  Int8);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(i16, I16, Int16);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(i32, I32, Int32);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(i64, I64, Int64);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(f32, F32, Float32);
+DEF_NUMERIC_VECTOR_SEARCH_INTERFACE(f64, F64, Float64);
+
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(u8,  U8,  Uint8,   Uint64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(u16, U16, Uint16,  Uint64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(u32, U32, Uint32,  Uint64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(u64, U64, Uint64,  Uint64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(i8,  I8,  Int8,    Int64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(i16, I16, Int16,   Int64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(i32, I32, Int32,   Int64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(i64, I64, Int64,   Int64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(f32, F32, Float32, Float64);
+DEF_NUMERIC_VECTOR_REDUCE_INTERFACE(f64, F64, Float64, Float64);
+
 DEF_INTEGER_VECTOR_INTERFACE_WITH_COPY_AND_DESTROY(zstr, ZStr, ZString, zstr_create_copy, zstr_destroy_copy);
+
+/* strings packed into a StringArena, which is passed as udata, see StringArena.h */
+DEF_INTEGER_VECTOR_INTERFACE_WITH_COPY_AND_DESTROY(zstr_arena, ZStrArena, ZString, zstr_create_copy_in_arena, zstr_destroy_copy_in_arena);
 DEF_INTEGER_VECTOR_INTERFACE(voidptr, VPtr, void*);
 
 // define interface to contain vector of vectors
@@ -0,0 +1,96 @@
+/**
+ * @file Counters.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Opt-in counters of hot path events inside containers, eg: number of
+ * reallocations a vector did, or number of groups a dense map probed. Build
+ * with ANVIE_ENABLE_COUNTERS defined to 1 (cmake -DANVUTILS_COUNTERS=ON) to
+ * enable them. Otherwise counting compiles to nothing, and every counter reads
+ * as 0.
+ *
+ * Counters are kept separately for each thread, without any synchronization,
+ * so a snapshot only covers work done on calling thread.
+ * */
+
+#ifndef ANVIE_COUNTERS_H
+#define ANVIE_COUNTERS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <stdio.h>
+
+#ifndef ANVIE_ENABLE_COUNTERS
+#   define ANVIE_ENABLE_COUNTERS 0
+#endif // ANVIE_ENABLE_COUNTERS
+
+/**
+ * All counters, as X(ID, "subsystem.event"). Add new counters here.
+ * */
+#define COUNTER_LIST(X)                                                 \
+    X(VECTOR_REALLOC,          "vector.realloc")                        \
+    X(VECTOR_ELEMENT_COPY,     "vector.element_copy")                   \
+    X(DENSE_MAP_FIND,          "dense_map.find")                        \
+    X(DENSE_MAP_GROUP_PROBE,   "dense_map.group_probe")                 \
+    X(DENSE_MAP_KEY_COMPARE,   "dense_map.key_compare")                 \
+    X(DENSE_MAP_REHASH,        "dense_map.rehash")                      \
+    X(SPARSE_MAP_FIND,         "sparse_map.find")                       \
+    X(SPARSE_MAP_CHAIN_STEP,   "sparse_map.chain_step")                 \
+    X(SPARSE_MAP_KEY_COMPARE,  "sparse_map.key_compare")                \
+    X(SPARSE_MAP_REHASH,       "sparse_map.rehash")                     \
+    X(BITVEC_CREATE,           "bitvec.create")                         \
+    X(BITVEC_REALLOC,          "bitvec.realloc")                        \
+    X(STRING_REALLOC,          "string.realloc")
+
+#define COUNTER_ENUM_ENTRY(id, name) COUNTER_##id,
+typedef enum CounterId {
+    COUNTER_LIST(COUNTER_ENUM_ENTRY)
+    COUNTER_MAX
+} CounterId;
+#undef COUNTER_ENUM_ENTRY
+
+/**
+ * Snapshot of all counters of a thread, indexed by @c CounterId.
+ * */
+typedef struct Counters {
+    Uint64 values[COUNTER_MAX];
+} Counters;
+
+/**
+ * Count @p n events with given id, or one with COUNTER_INC, eg:
+ * COUNTER_INC(VECTOR_REALLOC). @p n is not evaluated when counters are
+ * disabled.
+ * */
+#if ANVIE_ENABLE_COUNTERS
+/* counters of current thread, use COUNTER_ADD and COUNTER_INC instead of this */
+extern _Thread_local Uint64 counters_thread_values[COUNTER_MAX];
+
+#   define COUNTER_ADD(id, n) ((void)(counters_thread_values[COUNTER_##id] += (Uint64)(n)))
+#else
+#   define COUNTER_ADD(id, n) ((void)0)
+#endif // ANVIE_ENABLE_COUNTERS
+
+#define COUNTER_INC(id) COUNTER_ADD(id, 1)
+
+Bool    counters_enabled();
+ZString counter_name(CounterId id);
+void    counters_get(Counters* counters);
+void    counters_reset();
+void    counters_diff(Counters* diff, const Counters* after, const Counters* before);
+void    counters_print(FILE* file, const Counters* counters);
+
+#endif // ANVIE_COUNTERS_H
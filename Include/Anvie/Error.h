@@ -69,9 +69,36 @@ typedef enum Error {
 ZString err_to_zstr(Error err);
 #define ERRMSG(err) err_to_zstr(err)
 
+/**
+ * Define ANVIE_UNCHECKED to 1 (cmake -DANVUTILS_UNCHECKED=ON) to compile out
+ * checks of errors only a caller breaking contract of a function can cause,
+ * ie: ERR_INVALID_ARGUMENTS and ERR_INVALID_INDEX, in builds with NDEBUG.
+ * Such checks then cost nothing in hot paths, and a bad argument is
+ * undefined behaviour. Builds without NDEBUG keep all checks. Checks of
+ * runtime failures, like ERR_OUT_OF_MEMORY, are always kept. So are checks
+ * of bytes a caller can't vouch for, like a deserialized buffer or a mapped
+ * image, and of sizes that may overflow : report those with some other error,
+ * eg: ERR_INVALID_CONTENTS or ERR_INVALID_CAPACITY.
+ * */
+#if defined(ANVIE_UNCHECKED) && ANVIE_UNCHECKED && defined(NDEBUG)
+#   define ERR_CHECK_PRECONDITIONS 0
+#else
+#   define ERR_CHECK_PRECONDITIONS 1
+#endif
+
+/* ERR_IS_PRECONDITION(err) is 1 for errors listed here, and 0 for any other identifier */
+#define ERR_PRECONDITION_ERR_INVALID_ARGUMENTS ~, 1
+#define ERR_PRECONDITION_ERR_INVALID_INDEX     ~, 1
+#define ERR_SECOND_ARG(a, b, ...) b
+#define ERR_SECOND_ARG_(...) ERR_SECOND_ARG(__VA_ARGS__)
+#define ERR_IS_PRECONDITION(err) ERR_SECOND_ARG_(ERR_PRECONDITION_##err, 0, ~)
+
+/* condition is still compiled when unchecked, so that variables used only in checks stay used, but never evaluated */
+#define ERR_CHECKED_COND(cond, err) (!(ERR_CHECK_PRECONDITIONS || !ERR_IS_PRECONDITION(err)) || (cond))
+
 #define ERRFMT "%s\n"
-#define ERR_RETURN_IF_FAIL(cond, err) RETURN_IF_FAIL((cond), ERRFMT, ERRMSG(err))
-#define ERR_RETURN_VALUE_IF_FAIL(cond, value, err) RETURN_VALUE_IF_FAIL((cond), (value), ERRFMT, ERRMSG(err))
+#define ERR_RETURN_IF_FAIL(cond, err) RETURN_IF_FAIL(ERR_CHECKED_COND(cond, err), ERRFMT, ERRMSG(err))
+#define ERR_RETURN_VALUE_IF_FAIL(cond, value, err) RETURN_VALUE_IF_FAIL(ERR_CHECKED_COND(cond, err), (value), ERRFMT, ERRMSG(err))
 
 // print an error message
 #define ERR(tag, ...) do {                                              \
@@ -93,7 +120,7 @@ ZString err_to_zstr(Error err);
 
 // make an assertion
 #define ASSERT(cond, ...)                           \
-    if(!(cond)) {                                   \
+    if(UNLIKELY(!(cond))) {                         \
         ERR(__FUNCTION__, __VA_ARGS__);             \
         exit(1);                                    \
     }
@@ -112,7 +139,7 @@ ZString err_to_zstr(Error err);
 
 // print error if condition is met
 #define FATAL_IF(cond, ...)                         \
-    if(cond) {                                      \
+    if(UNLIKELY(cond)) {                            \
         ERR(__FUNCTION__, __VA_ARGS__);             \
     }
 
@@ -122,7 +149,7 @@ ZString err_to_zstr(Error err);
     {                                                  \
         Bool ________res____ = !(cond);                \
         FATAL_IF(________res____, __VA_ARGS__);        \
-        if(________res____) return;                    \
+        if(UNLIKELY(________res____)) return;          \
     }
 
 // return value if condition fails to be true
@@ -130,14 +157,14 @@ ZString err_to_zstr(Error err);
     {                                                                \
         Bool _________res_____ = !(cond);                            \
         FATAL_IF(_________res_____, __VA_ARGS__);                    \
-        if(_________res_____) return value;                          \
+        if(UNLIKELY(_________res_____)) return value;                \
     }
 
 #define GOTO_LABEL_IF_FAIL(cond, label, ...)                         \
     {                                                                \
         Bool _________res_____ = !(cond);                            \
         FATAL_IF(_________res_____, __VA_ARGS__);                    \
-        if(_________res_____) goto label;                            \
+        if(UNLIKELY(_________res_____)) goto label;                  \
     }
 
 #endif // ANVIE_ERROR_MESSAGES_H
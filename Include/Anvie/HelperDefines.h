@@ -59,6 +59,10 @@
 // don't want compiler to complain about it
 #define UNUSED(x) (void)(x)
 
+// branch prediction hints, for conditions that are almost always true or false
+#define LIKELY(cond)   __builtin_expect(!!(cond), 1)
+#define UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+
 // use when a function is to be forced to be inlined
 #define FORCE_INLINE inline __attribute__((always_inline))
 
@@ -20,8 +20,29 @@
  * @brief Different functions for computing entropy of given data.
  * */
 
+#ifndef ANVIE_UTILS_MATHS_ENTROPY_H
+#define ANVIE_UTILS_MATHS_ENTROPY_H
+
 #include <Anvie/Types.h>
 
+/**
+ * Count occurences of each byte value in given data.
+ *
+ * @param data Pointer to data to count bytes of.
+ * @param sz Size of data in bytes.
+ * @param out Array of 256 counts, out[b] is set to number of bytes equal to b.
+ * */
+void byte_histogram(const void* data, Size sz, Size out[0x100]);
+
+/**
+ * Compute shannon entropy from byte counts, with same normalization as
+ * compute_shannon_entropy.
+ *
+ * @param hist Array of 256 byte counts.
+ * @param total Sum of all counts.
+ * */
+Float32 compute_histogram_entropy(const Size hist[0x100], Size total);
+
 /**
  * Compute shannon entropy for given data.
  *
@@ -29,3 +50,46 @@
  * @param sz Size of data in bytes.
  * */
 Float32 compute_shannon_entropy(void* data, Size sz);
+
+/*------------------------------- STREAMING --------------------------------*/
+
+/**
+ * Entropy of data seen so far, for inputs that arrive in chunks.
+ * Initialize with entropy_init, or zero it.
+ * */
+typedef struct EntropyState {
+    Size hist[0x100]; /**< Count of each byte value seen so far. */
+    Size total;       /**< Number of bytes seen so far. */
+} EntropyState;
+
+void entropy_init(EntropyState* state);
+void entropy_update(EntropyState* state, const void* chunk, Size n);
+Float32 entropy_finalize(const EntropyState* state);
+
+/**
+ * Entropy of last window bytes of a stream, updated in O(1) per byte.
+ * */
+typedef struct EntropyWindow {
+    Uint8*  ring;         /**< Last window bytes, oldest at pos once full. */
+    Size    window;       /**< Window size in bytes. */
+    Size    pos;          /**< Where next byte goes in ring. */
+    Size    filled;       /**< Number of bytes in window, at most window. */
+    Size    hist[0x100];  /**< Count of each byte value in window. */
+    Uint64* clogc;        /**< c * ln(c) in 40.24 fixed point for every count c upto window. */
+    Uint64  sum_clogc;    /**< Sum of clogc over hist, exact so it never drifts. */
+} EntropyWindow;
+
+EntropyWindow* entropy_window_create(Size window);
+void entropy_window_destroy(EntropyWindow* win);
+Float32 entropy_window_push(EntropyWindow* win, Uint8 byte);
+void entropy_window_update(EntropyWindow* win, const void* data, Size n, Float32* out);
+Float32 entropy_window_get(const EntropyWindow* win);
+
+/*-------------------------------- PARALLEL --------------------------------*/
+
+Size compute_block_entropy(const void* data, Size sz, Size block_size, Float32* out);
+Size compute_block_entropy_parallel(const void* data, Size sz, Size block_size, Float32* out, Size nthreads);
+Float32* compute_file_block_entropy(ZString path, Size block_size, Size* nblocks, Size nthreads);
+Float32 compute_shannon_entropy_parallel(const void* data, Size sz, Size nthreads);
+
+#endif // ANVIE_UTILS_MATHS_ENTROPY_H
@@ -24,14 +24,23 @@
 #define ANVIE_UTILS_MATHS_MATRIX4F_H
 
 #include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Maths/Vector3f.h>
+#include <Anvie/Maths/Vector4f.h>
+#include <math.h>
+
+#ifdef __SSE__
+#   include <immintrin.h>
+#endif
 
 /**
  * @brief 4x4 Matrix of Float32 values.
  * Used in computing Model, View, Project matrix.
+ * Rows are aligned to 16 bytes, so each loads into a single SSE register.
  * */
 typedef struct anvie_matrix_4f_t {
     Float32 data[4][4];
-} Matrix4f;
+} __attribute__((aligned(16))) Matrix4f;
 
 Matrix4f* matrix_4f_create();
 void matrix_4f_destroy(Matrix4f* mat);
@@ -68,4 +77,270 @@ void matrix_4f_translate(Matrix4f* matrix, Float32 dx, Float32 dy, Float32 dz);
 void matrix_4f_rotate(Matrix4f* matrix, Float32 yaw, Float32 pitch, Float32 roll);
 void matrix_4f_scale(Matrix4f* matrix, Float32 sx, Float32 sy, Float32 sz);
 
+/*------------------------------- VALUE API --------------------------------*/
+
+/*
+ * By value counterparts of above functions. These never allocate and are
+ * defined here so that a chain of transforms can stay in registers.
+ * The _into variants write result to dst, which may alias an operand.
+ */
+
+static FORCE_INLINE Matrix4f matrix_4f_zero_v() {
+    return (Matrix4f){0};
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_identity_v() {
+    Matrix4f mat = {0};
+    mat.data[0][0] = 1.f;
+    mat.data[1][1] = 1.f;
+    mat.data[2][2] = 1.f;
+    mat.data[3][3] = 1.f;
+    return mat;
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_translation_matrix_v(Float32 dx, Float32 dy, Float32 dz) {
+    Matrix4f mat = matrix_4f_identity_v();
+    mat.data[0][3] = dx;
+    mat.data[1][3] = dy;
+    mat.data[2][3] = dz;
+    return mat;
+}
+
+/* angles are in radians, yaw about Z, pitch about Y and roll about X axis */
+static FORCE_INLINE Matrix4f matrix_4f_rotation_matrix_v(Float32 yaw, Float32 pitch, Float32 roll) {
+    Float32 cy = cosf(yaw), sy = sinf(yaw);
+    Float32 cp = cosf(pitch), sp = sinf(pitch);
+    Float32 cr = cosf(roll), sr = sinf(roll);
+
+    Matrix4f mat = matrix_4f_identity_v();
+    mat.data[0][0] = cp*cy;
+    mat.data[0][1] = sr*sp*cy - cr*sy;
+    mat.data[0][2] = cr*sp*cy + sr*sy;
+
+    mat.data[1][0] = cp*sy;
+    mat.data[1][1] = sr*sp*sy + cr*cy;
+    mat.data[1][2] = cr*sp*sy - sr*cy;
+
+    mat.data[2][0] = -sp;
+    mat.data[2][1] = sr*cp;
+    mat.data[2][2] = cr*cp;
+    return mat;
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_scale_matrix_v(Float32 sx, Float32 sy, Float32 sz) {
+    Matrix4f mat = matrix_4f_identity_v();
+    mat.data[0][0] = sx;
+    mat.data[1][1] = sy;
+    mat.data[2][2] = sz;
+    return mat;
+}
+
+/*
+ * Scalar reference versions of add, sub and mul. Results of vectorized
+ * versions below are checked against these.
+ */
+
+static FORCE_INLINE Matrix4f matrix_4f_add_v_scalar(Matrix4f m1, Matrix4f m2) {
+    Matrix4f res;
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            res.data[r][c] = m1.data[r][c] + m2.data[r][c];
+        }
+    }
+    return res;
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_sub_v_scalar(Matrix4f m1, Matrix4f m2) {
+    Matrix4f res;
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            res.data[r][c] = m1.data[r][c] - m2.data[r][c];
+        }
+    }
+    return res;
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_mul_v_scalar(Matrix4f m1, Matrix4f m2) {
+    Matrix4f res;
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            res.data[r][c] = m1.data[r][0]*m2.data[0][c] + m1.data[r][1]*m2.data[1][c]
+                           + m1.data[r][2]*m2.data[2][c] + m1.data[r][3]*m2.data[3][c];
+        }
+    }
+    return res;
+}
+
+#ifdef __SSE__
+/* a * b + c, fused when FMA is available */
+static FORCE_INLINE __m128 matrix_4f_madd_ps(__m128 a, __m128 b, __m128 c) {
+#   ifdef __FMA__
+    return _mm_fmadd_ps(a, b, c);
+#   else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#   endif
+}
+#endif // __SSE__
+
+static FORCE_INLINE Matrix4f matrix_4f_add_v(Matrix4f m1, Matrix4f m2) {
+#ifdef __SSE__
+    Matrix4f res;
+    for(Size r = 0; r < 4; r++) {
+        _mm_store_ps(res.data[r], _mm_add_ps(_mm_load_ps(m1.data[r]), _mm_load_ps(m2.data[r])));
+    }
+    return res;
+#else
+    return matrix_4f_add_v_scalar(m1, m2);
+#endif
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_sub_v(Matrix4f m1, Matrix4f m2) {
+#ifdef __SSE__
+    Matrix4f res;
+    for(Size r = 0; r < 4; r++) {
+        _mm_store_ps(res.data[r], _mm_sub_ps(_mm_load_ps(m1.data[r]), _mm_load_ps(m2.data[r])));
+    }
+    return res;
+#else
+    return matrix_4f_sub_v_scalar(m1, m2);
+#endif
+}
+
+/**
+ * Each row of result is a combination of rows of m2, weighted by entries of
+ * same row of m1. So each entry of m1 is broadcast and multiplied with a
+ * whole row of m2 at once : 16 broadcasts and 16 multiply-adds in total.
+ * */
+static FORCE_INLINE Matrix4f matrix_4f_mul_v(Matrix4f m1, Matrix4f m2) {
+#ifdef __SSE__
+    __m128 b0 = _mm_load_ps(m2.data[0]);
+    __m128 b1 = _mm_load_ps(m2.data[1]);
+    __m128 b2 = _mm_load_ps(m2.data[2]);
+    __m128 b3 = _mm_load_ps(m2.data[3]);
+
+    Matrix4f res;
+    for(Size r = 0; r < 4; r++) {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(m1.data[r][0]), b0);
+        row = matrix_4f_madd_ps(_mm_set1_ps(m1.data[r][1]), b1, row);
+        row = matrix_4f_madd_ps(_mm_set1_ps(m1.data[r][2]), b2, row);
+        row = matrix_4f_madd_ps(_mm_set1_ps(m1.data[r][3]), b3, row);
+        _mm_store_ps(res.data[r], row);
+    }
+    return res;
+#else
+    return matrix_4f_mul_v_scalar(m1, m2);
+#endif
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_transpose_v(Matrix4f mat) {
+    Matrix4f res;
+#ifdef __SSE__
+    __m128 r0 = _mm_load_ps(mat.data[0]);
+    __m128 r1 = _mm_load_ps(mat.data[1]);
+    __m128 r2 = _mm_load_ps(mat.data[2]);
+    __m128 r3 = _mm_load_ps(mat.data[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_store_ps(res.data[0], r0);
+    _mm_store_ps(res.data[1], r1);
+    _mm_store_ps(res.data[2], r2);
+    _mm_store_ps(res.data[3], r3);
+#else
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            res.data[r][c] = mat.data[c][r];
+        }
+    }
+#endif // __SSE__
+    return res;
+}
+
+/*
+ * Inverse of a rigid body transform, a rotation followed by a translation.
+ * Rotation block is orthonormal, so it's inverse is it's transpose and
+ * translation becomes -R^T t. Result is wrong if matrix has scale or
+ * shear, use matrix_4f_affine_inverse for those.
+ */
+static FORCE_INLINE Matrix4f matrix_4f_rigid_inverse_v(Matrix4f mat) {
+    Matrix4f res = matrix_4f_transpose_v(mat);
+
+    /* last row of transpose holds translation, it's replaced by last column */
+    Float32 tx = res.data[3][0], ty = res.data[3][1], tz = res.data[3][2];
+    for(Size r = 0; r < 3; r++) {
+        res.data[r][3] = -(res.data[r][0]*tx + res.data[r][1]*ty + res.data[r][2]*tz);
+    }
+    res.data[3][0] = res.data[3][1] = res.data[3][2] = 0;
+    res.data[3][3] = 1;
+    return res;
+}
+
+/* transform a column vector, mat * vec */
+static FORCE_INLINE Vector4f matrix_4f_mul_vector_v(Matrix4f mat, Vector4f vec) {
+    return (Vector4f){
+        mat.data[0][0]*vec.x + mat.data[0][1]*vec.y + mat.data[0][2]*vec.z + mat.data[0][3]*vec.t,
+        mat.data[1][0]*vec.x + mat.data[1][1]*vec.y + mat.data[1][2]*vec.z + mat.data[1][3]*vec.t,
+        mat.data[2][0]*vec.x + mat.data[2][1]*vec.y + mat.data[2][2]*vec.z + mat.data[2][3]*vec.t,
+        mat.data[3][0]*vec.x + mat.data[3][1]*vec.y + mat.data[3][2]*vec.z + mat.data[3][3]*vec.t
+    };
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_translate_v(Matrix4f mat, Float32 dx, Float32 dy, Float32 dz) {
+    return matrix_4f_mul_v(mat, matrix_4f_translation_matrix_v(dx, dy, dz));
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_rotate_v(Matrix4f mat, Float32 yaw, Float32 pitch, Float32 roll) {
+    return matrix_4f_mul_v(mat, matrix_4f_rotation_matrix_v(yaw, pitch, roll));
+}
+
+static FORCE_INLINE Matrix4f matrix_4f_scale_v(Matrix4f mat, Float32 sx, Float32 sy, Float32 sz) {
+    return matrix_4f_mul_v(mat, matrix_4f_scale_matrix_v(sx, sy, sz));
+}
+
+static FORCE_INLINE void matrix_4f_add_into(Matrix4f* dst, const Matrix4f* m1, const Matrix4f* m2) {
+    *dst = matrix_4f_add_v(*m1, *m2);
+}
+
+static FORCE_INLINE void matrix_4f_sub_into(Matrix4f* dst, const Matrix4f* m1, const Matrix4f* m2) {
+    *dst = matrix_4f_sub_v(*m1, *m2);
+}
+
+static FORCE_INLINE void matrix_4f_mul_into(Matrix4f* dst, const Matrix4f* m1, const Matrix4f* m2) {
+    *dst = matrix_4f_mul_v(*m1, *m2);
+}
+
+static FORCE_INLINE void matrix_4f_mul_vector_into(Vector4f* dst, const Matrix4f* mat, const Vector4f* vec) {
+    *dst = matrix_4f_mul_vector_v(*mat, *vec);
+}
+
+void matrix_4f_mul_n(Matrix4f* dst, const Matrix4f* m1, const Matrix4f* m2, Size count);
+void matrix_4f_mul_array(Matrix4f* dst, const Matrix4f* mat, const Matrix4f* src, Size count);
+
+/*-------------------------------- INVERSE ---------------------------------*/
+
+void matrix_4f_transpose(Matrix4f* mat);
+Bool matrix_4f_inverse(Matrix4f* mat);
+Bool matrix_4f_inverse_into(Matrix4f* dst, const Matrix4f* mat);
+Bool matrix_4f_affine_inverse(Matrix4f* mat);
+void matrix_4f_rigid_inverse(Matrix4f* mat);
+Size matrix_4f_inverse_array(Matrix4f* dst, const Matrix4f* src, Size count);
+
+/*---------------------------- BATCH TRANSFORMS ----------------------------*/
+
+void matrix_4f_transform_points_4f(const Matrix4f* mat, const Vector4f* in, Vector4f* out, Size count);
+void matrix_4f_transform_points_3f(const Matrix4f* mat, const Vector3f* in, Vector3f* out, Size count);
+void matrix_4f_transform_points_soa(
+    const Matrix4f* mat,
+    const Float32* in_x, const Float32* in_y, const Float32* in_z,
+    Float32* out_x, Float32* out_y, Float32* out_z,
+    Size count
+);
+
+void matrix_4f_transform_points_4f_parallel(const Matrix4f* mat, const Vector4f* in, Vector4f* out, Size count, Size nthreads);
+void matrix_4f_transform_points_3f_parallel(const Matrix4f* mat, const Vector3f* in, Vector3f* out, Size count, Size nthreads);
+void matrix_4f_transform_points_soa_parallel(
+    const Matrix4f* mat,
+    const Float32* in_x, const Float32* in_y, const Float32* in_z,
+    Float32* out_x, Float32* out_y, Float32* out_z,
+    Size count, Size nthreads
+);
+
 #endif // ANVIE_UTILS_MATHS_MATRIX4F_H
@@ -0,0 +1,218 @@
+/**
+ * @file Quaternionf.h
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @date Thu, 15th October, 2026
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Float32 unit quaternion for rotations.
+ *
+ * Composing two rotations as quaternions takes 16 multiplies against 64
+ * for 4x4 matrices, and quaternions interpolate cleanly. Convert to a
+ * Matrix4f only when a transform is actually applied.
+ * */
+
+#ifndef ANVIE_UTILS_MATHS_QUATERNIONF_H
+#define ANVIE_UTILS_MATHS_QUATERNIONF_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Maths/Vector3f.h>
+#include <Anvie/Maths/Matrix4f.h>
+#include <math.h>
+
+/**
+ * @brief Quaternion w + xi + yj + zk.
+ * Aligned to 16 bytes so that it loads into a single SSE register.
+ * */
+typedef struct anvie_quaternion_f_t {
+    Float32 x;
+    Float32 y;
+    Float32 z;
+    Float32 w;
+} __attribute__((aligned(16))) Quaternionf;
+
+/*------------------------------- VALUE API --------------------------------*/
+
+/*
+ * Rotations follow same conventions as Matrix4f : they act on column
+ * vectors and quaternionf_mul_v(a, b) first rotates by b, then by a, just
+ * like matrix_4f_mul_v. All functions except normalize expect unit
+ * quaternions where it matters.
+ */
+
+static FORCE_INLINE Quaternionf quaternionf_v(Float32 x, Float32 y, Float32 z, Float32 w) {
+    return (Quaternionf){x, y, z, w};
+}
+
+static FORCE_INLINE Quaternionf quaternionf_identity_v() {
+    return (Quaternionf){0, 0, 0, 1};
+}
+
+/* rotation by angle radians around axis, axis need not be normalized */
+static FORCE_INLINE Quaternionf quaternionf_from_axis_angle_v(Vector3f axis, Float32 angle) {
+    Vector3f n = vector_3f_normalize_v(axis);
+    Float32  s = sinf(angle * 0.5f);
+    return (Quaternionf){n.x * s, n.y * s, n.z * s, cosf(angle * 0.5f)};
+}
+
+/* same rotation as matrix_4f_rotation_matrix_v : roll about X, then pitch about Y, then yaw about Z */
+static FORCE_INLINE Quaternionf quaternionf_from_euler_v(Float32 yaw, Float32 pitch, Float32 roll) {
+    Float32 cy = cosf(yaw * 0.5f), sy = sinf(yaw * 0.5f);
+    Float32 cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    Float32 cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+
+    return (Quaternionf){
+        sr*cp*cy - cr*sp*sy,
+        cr*sp*cy + sr*cp*sy,
+        cr*cp*sy - sr*sp*cy,
+        cr*cp*cy + sr*sp*sy
+    };
+}
+
+static FORCE_INLINE Float32 quaternionf_dot_v(Quaternionf q1, Quaternionf q2) {
+    return q1.x*q2.x + q1.y*q2.y + q1.z*q2.z + q1.w*q2.w;
+}
+
+static FORCE_INLINE Float32 quaternionf_norm_v(Quaternionf q) {
+    return sqrtf(quaternionf_dot_v(q, q));
+}
+
+/* zero quaternion is returned as is */
+static FORCE_INLINE Quaternionf quaternionf_normalize_v(Quaternionf q) {
+    Float32 norm = quaternionf_norm_v(q);
+    if(!norm) {
+        return q;
+    }
+    Float32 inv = 1.f / norm;
+    return (Quaternionf){q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+/* inverse rotation of a unit quaternion */
+static FORCE_INLINE Quaternionf quaternionf_conjugate_v(Quaternionf q) {
+    return (Quaternionf){-q.x, -q.y, -q.z, q.w};
+}
+
+/* scalar reference version of Hamilton product, checks the SSE one below */
+static FORCE_INLINE Quaternionf quaternionf_mul_v_scalar(Quaternionf a, Quaternionf b) {
+    return (Quaternionf){
+        a.w*b.x + a.x*b.w + a.y*b.z - a.z*b.y,
+        a.w*b.y - a.x*b.z + a.y*b.w + a.z*b.x,
+        a.w*b.z + a.x*b.y - a.y*b.x + a.z*b.w,
+        a.w*b.w - a.x*b.x - a.y*b.y - a.z*b.z
+    };
+}
+
+/* Hamilton product a * b, rotation by b followed by a */
+static FORCE_INLINE Quaternionf quaternionf_mul_v(Quaternionf a, Quaternionf b) {
+#ifdef __SSE__
+    /* each coordinate of a scales a permutation of b with some signs flipped */
+    __m128 vb = _mm_load_ps(&b.x);
+    __m128 r  = _mm_mul_ps(_mm_set1_ps(a.w), vb);
+
+    __m128 bx = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.f, -0.f, 0.f, -0.f));
+    __m128 by = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.f, 0.f, -0.f, -0.f));
+    __m128 bz = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.f, 0.f, 0.f, -0.f));
+
+    r = matrix_4f_madd_ps(_mm_set1_ps(a.x), bx, r);
+    r = matrix_4f_madd_ps(_mm_set1_ps(a.y), by, r);
+    r = matrix_4f_madd_ps(_mm_set1_ps(a.z), bz, r);
+
+    Quaternionf res;
+    _mm_store_ps(&res.x, r);
+    return res;
+#else
+    return quaternionf_mul_v_scalar(a, b);
+#endif // __SSE__
+}
+
+/* rotate a vector, cheaper than q * v * conjugate(q) : v + 2w(u x v) + 2u x (u x v) */
+static FORCE_INLINE Vector3f quaternionf_rotate_vector_3f_v(Quaternionf q, Vector3f v) {
+    Vector3f u  = {q.x, q.y, q.z};
+    Vector3f t  = vector_3f_scale_v(vector_3f_cross_v(u, v), 2.f);
+    return vector_3f_add_v(vector_3f_add_v(v, vector_3f_scale_v(t, q.w)), vector_3f_cross_v(u, t));
+}
+
+/* normalized linear interpolation along shorter arc, cheap and good for small angles */
+static FORCE_INLINE Quaternionf quaternionf_nlerp_v(Quaternionf q1, Quaternionf q2, Float32 t) {
+    Float32 s = quaternionf_dot_v(q1, q2) < 0 ? -t : t;
+    return quaternionf_normalize_v((Quaternionf){
+        q1.x*(1 - t) + q2.x*s,
+        q1.y*(1 - t) + q2.y*s,
+        q1.z*(1 - t) + q2.z*s,
+        q1.w*(1 - t) + q2.w*s
+    });
+}
+
+/* spherical linear interpolation along shorter arc, constant angular velocity */
+static FORCE_INLINE Quaternionf quaternionf_slerp_v(Quaternionf q1, Quaternionf q2, Float32 t) {
+    Float32 d    = quaternionf_dot_v(q1, q2);
+    Float32 sign = d < 0 ? -1.f : 1.f;
+    d *= sign;
+
+    /* sin(theta) vanishes for nearly equal rotations, nlerp is exact enough there */
+    if(d > 0.9995f) {
+        return quaternionf_nlerp_v(q1, q2, t);
+    }
+
+    Float32 theta = acosf(d);
+    Float32 inv   = 1.f / sinf(theta);
+    Float32 w1    = sinf((1 - t) * theta) * inv;
+    Float32 w2    = sinf(t * theta) * inv * sign;
+    return (Quaternionf){
+        q1.x*w1 + q2.x*w2,
+        q1.y*w1 + q2.y*w2,
+        q1.z*w1 + q2.z*w2,
+        q1.w*w1 + q2.w*w2
+    };
+}
+
+static FORCE_INLINE Matrix4f quaternionf_to_matrix_4f_v(Quaternionf q) {
+    Float32 xx = q.x*q.x, yy = q.y*q.y, zz = q.z*q.z;
+    Float32 xy = q.x*q.y, xz = q.x*q.z, yz = q.y*q.z;
+    Float32 wx = q.w*q.x, wy = q.w*q.y, wz = q.w*q.z;
+
+    Matrix4f mat = matrix_4f_identity_v();
+    mat.data[0][0] = 1 - 2*(yy + zz);
+    mat.data[0][1] = 2*(xy - wz);
+    mat.data[0][2] = 2*(xz + wy);
+
+    mat.data[1][0] = 2*(xy + wz);
+    mat.data[1][1] = 1 - 2*(xx + zz);
+    mat.data[1][2] = 2*(yz - wx);
+
+    mat.data[2][0] = 2*(xz - wy);
+    mat.data[2][1] = 2*(yz + wx);
+    mat.data[2][2] = 1 - 2*(xx + yy);
+    return mat;
+}
+
+static FORCE_INLINE void quaternionf_mul_into(Quaternionf* dst, const Quaternionf* a, const Quaternionf* b) {
+    *dst = quaternionf_mul_v(*a, *b);
+}
+
+Quaternionf quaternionf_from_matrix_4f_v(Matrix4f mat);
+
+/*---------------------------- BATCH ROTATIONS -----------------------------*/
+
+void quaternionf_rotate_points_3f(const Quaternionf* q, const Vector3f* in, Vector3f* out, Size count);
+void quaternionf_rotate_points_soa(
+    const Quaternionf* q,
+    const Float32* in_x, const Float32* in_y, const Float32* in_z,
+    Float32* out_x, Float32* out_y, Float32* out_z,
+    Size count
+);
+
+#endif // ANVIE_UTILS_MATHS_QUATERNIONF_H
@@ -24,6 +24,8 @@
 #define ANVIE_UTILS_MATH_VECTOR2F_H
 
 #include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <math.h>
 
 typedef struct anvie_vector_2f_t {
     Float32 x;
@@ -46,4 +48,54 @@ Float32 vector_2f_dot(Vector2f* vec1, Vector2f* vec2);
 Float32 vector_2f_compute_norm(Vector2f* vec);
 void vector_2f_normalize(Vector2f* vec);
 
+/*------------------------------- VALUE API --------------------------------*/
+
+/*
+ * By value counterparts of above functions. These never allocate and are
+ * defined here so that a chain of operations can stay in registers.
+ * The _into variants write result to dst, which may alias an operand.
+ */
+
+static FORCE_INLINE Vector2f vector_2f_v(Float32 x, Float32 y) {
+    return (Vector2f){x, y};
+}
+
+static FORCE_INLINE Vector2f vector_2f_add_v(Vector2f v1, Vector2f v2) {
+    return (Vector2f){v1.x + v2.x, v1.y + v2.y};
+}
+
+static FORCE_INLINE Vector2f vector_2f_sub_v(Vector2f v1, Vector2f v2) {
+    return (Vector2f){v1.x - v2.x, v1.y - v2.y};
+}
+
+static FORCE_INLINE Vector2f vector_2f_scale_v(Vector2f v, Float32 scale) {
+    return (Vector2f){v.x * scale, v.y * scale};
+}
+
+static FORCE_INLINE Float32 vector_2f_dot_v(Vector2f v1, Vector2f v2) {
+    return v1.x*v2.x + v1.y*v2.y;
+}
+
+static FORCE_INLINE Float32 vector_2f_norm_v(Vector2f v) {
+    return sqrtf(vector_2f_dot_v(v, v));
+}
+
+/* zero vector is returned as is */
+static FORCE_INLINE Vector2f vector_2f_normalize_v(Vector2f v) {
+    Float32 norm = vector_2f_norm_v(v);
+    return norm ? vector_2f_scale_v(v, 1.f / norm) : v;
+}
+
+static FORCE_INLINE void vector_2f_add_into(Vector2f* dst, const Vector2f* v1, const Vector2f* v2) {
+    *dst = vector_2f_add_v(*v1, *v2);
+}
+
+static FORCE_INLINE void vector_2f_sub_into(Vector2f* dst, const Vector2f* v1, const Vector2f* v2) {
+    *dst = vector_2f_sub_v(*v1, *v2);
+}
+
+static FORCE_INLINE void vector_2f_scale_into(Vector2f* dst, const Vector2f* v, Float32 scale) {
+    *dst = vector_2f_scale_v(*v, scale);
+}
+
 #endif // ANVIE_UTILS_MATH_VECTOR2F_H
@@ -24,6 +24,8 @@
 #define ANVIE_UTILS_MATH_VECTOR3F_H
 
 #include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <math.h>
 
 typedef struct anvie_vector_3f_t {
     Float32 x;
@@ -49,4 +51,66 @@ Vector3f* vector_3f_cross(Vector3f* vec1, Vector3f* vec2);
 Float32 vector_3f_compute_norm(Vector3f* vec);
 void vector_3f_normalize(Vector3f* vec);
 
+/*------------------------------- VALUE API --------------------------------*/
+
+/*
+ * By value counterparts of above functions. These never allocate and are
+ * defined here so that a chain of operations can stay in registers.
+ * The _into variants write result to dst, which may alias an operand.
+ */
+
+static FORCE_INLINE Vector3f vector_3f_v(Float32 x, Float32 y, Float32 z) {
+    return (Vector3f){x, y, z};
+}
+
+static FORCE_INLINE Vector3f vector_3f_add_v(Vector3f v1, Vector3f v2) {
+    return (Vector3f){v1.x + v2.x, v1.y + v2.y, v1.z + v2.z};
+}
+
+static FORCE_INLINE Vector3f vector_3f_sub_v(Vector3f v1, Vector3f v2) {
+    return (Vector3f){v1.x - v2.x, v1.y - v2.y, v1.z - v2.z};
+}
+
+static FORCE_INLINE Vector3f vector_3f_scale_v(Vector3f v, Float32 scale) {
+    return (Vector3f){v.x * scale, v.y * scale, v.z * scale};
+}
+
+static FORCE_INLINE Float32 vector_3f_dot_v(Vector3f v1, Vector3f v2) {
+    return v1.x*v2.x + v1.y*v2.y + v1.z*v2.z;
+}
+
+static FORCE_INLINE Vector3f vector_3f_cross_v(Vector3f v1, Vector3f v2) {
+    return (Vector3f){
+        v1.y*v2.z - v1.z*v2.y,
+        v1.z*v2.x - v1.x*v2.z,
+        v1.x*v2.y - v1.y*v2.x
+    };
+}
+
+static FORCE_INLINE Float32 vector_3f_norm_v(Vector3f v) {
+    return sqrtf(vector_3f_dot_v(v, v));
+}
+
+/* zero vector is returned as is */
+static FORCE_INLINE Vector3f vector_3f_normalize_v(Vector3f v) {
+    Float32 norm = vector_3f_norm_v(v);
+    return norm ? vector_3f_scale_v(v, 1.f / norm) : v;
+}
+
+static FORCE_INLINE void vector_3f_add_into(Vector3f* dst, const Vector3f* v1, const Vector3f* v2) {
+    *dst = vector_3f_add_v(*v1, *v2);
+}
+
+static FORCE_INLINE void vector_3f_sub_into(Vector3f* dst, const Vector3f* v1, const Vector3f* v2) {
+    *dst = vector_3f_sub_v(*v1, *v2);
+}
+
+static FORCE_INLINE void vector_3f_scale_into(Vector3f* dst, const Vector3f* v, Float32 scale) {
+    *dst = vector_3f_scale_v(*v, scale);
+}
+
+static FORCE_INLINE void vector_3f_cross_into(Vector3f* dst, const Vector3f* v1, const Vector3f* v2) {
+    *dst = vector_3f_cross_v(*v1, *v2);
+}
+
 #endif // ANVIE_UTILS_MATH_VECTOR3F_H
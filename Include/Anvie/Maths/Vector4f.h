@@ -24,13 +24,16 @@
 #define ANVIE_UTILS_MATH_VECTOR4F_H
 
 #include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+#include <math.h>
 
+/* aligned to 16 bytes so that a vector loads into a single SSE register */
 typedef struct anvie_vector_4f_t {
     Float32 x;
     Float32 y;
     Float32 z;
     Float32 t;
-} Vector4f;
+} __attribute__((aligned(16))) Vector4f;
 
 Vector4f* vector_4f_create(Float32 x, Float32 y, Float32 z, Float32 t);
 void vector_4f_destroy(Vector4f* vec);
@@ -50,4 +53,54 @@ Float32 vector_4f_dot(Vector4f* vec1, Vector4f* vec2);
 Float32 vector_4f_compute_norm(Vector4f* vec);
 void vector_4f_normalize(Vector4f* vec);
 
+/*------------------------------- VALUE API --------------------------------*/
+
+/*
+ * By value counterparts of above functions. These never allocate and are
+ * defined here so that a chain of operations can stay in registers.
+ * The _into variants write result to dst, which may alias an operand.
+ */
+
+static FORCE_INLINE Vector4f vector_4f_v(Float32 x, Float32 y, Float32 z, Float32 t) {
+    return (Vector4f){x, y, z, t};
+}
+
+static FORCE_INLINE Vector4f vector_4f_add_v(Vector4f v1, Vector4f v2) {
+    return (Vector4f){v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.t + v2.t};
+}
+
+static FORCE_INLINE Vector4f vector_4f_sub_v(Vector4f v1, Vector4f v2) {
+    return (Vector4f){v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.t - v2.t};
+}
+
+static FORCE_INLINE Vector4f vector_4f_scale_v(Vector4f v, Float32 scale) {
+    return (Vector4f){v.x * scale, v.y * scale, v.z * scale, v.t * scale};
+}
+
+static FORCE_INLINE Float32 vector_4f_dot_v(Vector4f v1, Vector4f v2) {
+    return v1.x*v2.x + v1.y*v2.y + v1.z*v2.z + v1.t*v2.t;
+}
+
+static FORCE_INLINE Float32 vector_4f_norm_v(Vector4f v) {
+    return sqrtf(vector_4f_dot_v(v, v));
+}
+
+/* zero vector is returned as is */
+static FORCE_INLINE Vector4f vector_4f_normalize_v(Vector4f v) {
+    Float32 norm = vector_4f_norm_v(v);
+    return norm ? vector_4f_scale_v(v, 1.f / norm) : v;
+}
+
+static FORCE_INLINE void vector_4f_add_into(Vector4f* dst, const Vector4f* v1, const Vector4f* v2) {
+    *dst = vector_4f_add_v(*v1, *v2);
+}
+
+static FORCE_INLINE void vector_4f_sub_into(Vector4f* dst, const Vector4f* v1, const Vector4f* v2) {
+    *dst = vector_4f_sub_v(*v1, *v2);
+}
+
+static FORCE_INLINE void vector_4f_scale_into(Vector4f* dst, const Vector4f* v, Float32 scale) {
+    *dst = vector_4f_scale_v(*v, scale);
+}
+
 #endif // ANVIE_UTILS_MATH_VECTOR4F_H
@@ -0,0 +1,68 @@
+/**
+ * @file ArithmeticOps.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines generic SIMD (Single Instruction Multiple Data) wrappers over
+ * lane wise integer arithmetic operations.
+ *
+ * This file only contains definions. The actual implementation of each function
+ * is in the Impl file.
+ * */
+
+#ifndef ANVIE_SIMD_ARITHMETIC_OPERATIONS_H
+#define ANVIE_SIMD_ARITHMETIC_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+
+    /* wrapping addition and subtraction */
+    static inline MVec simd_add_epi8(MVec v1, MVec v2);
+    static inline MVec simd_add_epi16(MVec v1, MVec v2);
+    static inline MVec simd_add_epi32(MVec v1, MVec v2);
+    static inline MVec simd_add_epi64(MVec v1, MVec v2);
+    static inline MVec simd_sub_epi8(MVec v1, MVec v2);
+    static inline MVec simd_sub_epi16(MVec v1, MVec v2);
+    static inline MVec simd_sub_epi32(MVec v1, MVec v2);
+    static inline MVec simd_sub_epi64(MVec v1, MVec v2);
+
+    /* low half of each lane wise product, eg: for multiplicative hashing */
+    static inline MVec simd_mullo_epi16(MVec v1, MVec v2);
+    static inline MVec simd_mullo_epi32(MVec v1, MVec v2);
+
+    /* unsigned saturating addition and subtraction, lanes clamp at 0 and at maximum value */
+    static inline MVec simd_adds_epu8(MVec v1, MVec v2);
+    static inline MVec simd_subs_epu8(MVec v1, MVec v2);
+
+    /* signed (epi) and unsigned (epu) minimum and maximum, 8 byte lanes are not available below AVX512 */
+    static inline MVec simd_min_epi8(MVec v1, MVec v2);
+    static inline MVec simd_min_epi16(MVec v1, MVec v2);
+    static inline MVec simd_min_epi32(MVec v1, MVec v2);
+    static inline MVec simd_max_epi8(MVec v1, MVec v2);
+    static inline MVec simd_max_epi16(MVec v1, MVec v2);
+    static inline MVec simd_max_epi32(MVec v1, MVec v2);
+
+    static inline MVec simd_min_epu8(MVec v1, MVec v2);
+    static inline MVec simd_min_epu16(MVec v1, MVec v2);
+    static inline MVec simd_min_epu32(MVec v1, MVec v2);
+    static inline MVec simd_max_epu8(MVec v1, MVec v2);
+    static inline MVec simd_max_epu16(MVec v1, MVec v2);
+    static inline MVec simd_max_epu32(MVec v1, MVec v2);
+
+#include <Anvie/Simd/Impl/ArithmeticOps.h>
+
+#endif // ANVIE_SIMD_ARITHMETIC_OPERATIONS_H
@@ -0,0 +1,64 @@
+/**
+ * @file BitwiseOps.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines generic SIMD (Single Instruction Multiple Data) wrappers over
+ * bitwise operations on whole vector registers.
+ *
+ * This file only contains definions. The actual implementation of each function
+ * is in the Impl file.
+ * */
+
+#ifndef ANVIE_SIMD_BITWISE_OPERATIONS_H
+#define ANVIE_SIMD_BITWISE_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+
+    static inline MVec simd_and(MVec v1, MVec v2);
+    static inline MVec simd_or(MVec v1, MVec v2);
+    static inline MVec simd_xor(MVec v1, MVec v2);
+    static inline MVec simd_andnot(MVec v1, MVec v2); /**< (~v1) & v2 */
+
+    /**
+     * Shift each 2, 4 or 8 byte lane by @p n bits : left (slli), logical
+     * right (srli) or arithmetic right (srai). Logical shifts by lane width
+     * or more give 0, arithmetic ones fill lane with it's sign bit.
+     * */
+    static inline MVec simd_slli_epi16(MVec v, Uint32 n);
+    static inline MVec simd_slli_epi32(MVec v, Uint32 n);
+    static inline MVec simd_slli_epi64(MVec v, Uint32 n);
+    static inline MVec simd_srli_epi16(MVec v, Uint32 n);
+    static inline MVec simd_srli_epi32(MVec v, Uint32 n);
+    static inline MVec simd_srli_epi64(MVec v, Uint32 n);
+    static inline MVec simd_srai_epi16(MVec v, Uint32 n);
+    static inline MVec simd_srai_epi32(MVec v, Uint32 n);
+    static inline MVec simd_srai_epi64(MVec v, Uint32 n);
+
+    /* number of set bits in each byte */
+    static inline MVec simd_popcnt_epi8(MVec v);
+
+    /* number of set bits in whole register */
+    static inline Size simd_popcount(MVec v);
+
+    /* True if no bit of @p v is set */
+    static inline Bool simd_testz(MVec v);
+
+#include <Anvie/Simd/Impl/BitwiseOps.h>
+
+#endif // ANVIE_SIMD_BITWISE_OPERATIONS_H
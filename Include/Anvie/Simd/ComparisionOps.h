@@ -18,8 +18,7 @@
  * limitations under the License.
  *
  * @brief Defines generic SIMD (Single Instruction Multiple Data) wrappers over
- * comparision operations. The only condition is that SIMD at atleast one of the
- * all three levels must be enabled.
+ * comparision operations.
  *
  * This file only contains definions. The actual implementation of each function
  * is in the Impl file.
@@ -28,6 +27,7 @@
 #ifndef ANVIE_SIMD_COMPARISION_OPERATIONS_H
 #define ANVIE_SIMD_COMPARISION_OPERATIONS_H
 
+#include <Anvie/Types.h>
 #include <Anvie/Simd/Types.h>
 
 /**
@@ -45,12 +45,11 @@
  * of highest size. Meaning if AVX512 extensions are available then the wrapper will behave as corresponding
  * intrinsic functions of AVX512 extensions, leaving all other lower sized extensions.
  *
- * If AVX extensions are not abled at all, then each function will return 0 irrespective of the values
- * passed as parameters.
+ * On AArch64, NEON registers are 16 bytes and wrappers behave as AVX ones do, masks included.
+ * If neither is enabled, each function compares lanes of the emulated 16 byte register one by one,
+ * giving same results as AVX would.
  * */
 
-#if SIMD_ENABLED
-
     static inline MVec simd_cmpeq_epi8(MVec v1, MVec v2);
     static inline MVec simd_cmpgt_epi8(MVec v1, MVec v2);
 
@@ -66,10 +65,17 @@
     static inline MMask simd_cmpeq_epi8_mask(MVec v1, MVec v2);
     static inline MMask simd_cmpgt_epi8_mask(MVec v1, MVec v2);
 
-    static inline Uint8 simd_tzcnt(Uint64 v);
+    /* one bit per 4 or 8 byte lane instead of one bit per byte */
+    static inline MMask simd_cmpeq_epi32_mask(MVec v1, MVec v2);
+    static inline MMask simd_cmpgt_epi32_mask(MVec v1, MVec v2);
+    static inline MMask simd_cmpeq_epi64_mask(MVec v1, MVec v2);
+    static inline MMask simd_cmpgt_epi64_mask(MVec v1, MVec v2);
 
-#include <Anvie/Simd/Impl/ComparisionOps.h>
+    /* one bit per byte, set if most significant bit of that byte is set */
+    static inline MMask simd_movemask_epi8(MVec v);
 
-#endif // SIMD_ENABLED
+    static inline Uint32 simd_tzcnt(Uint64 v);
+
+#include <Anvie/Simd/Impl/ComparisionOps.h>
 
 #endif // ANVIE_SIMD_COMPARISION_OPERATIONS_H
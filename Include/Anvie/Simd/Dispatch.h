@@ -0,0 +1,115 @@
+/**
+ * @file Dispatch.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Runtime selection of SIMD kernels. Kernels that are worth it are
+ * compiled once for each SIMD level (see @c anvutils_add_simd_kernels in
+ * Source/CMakeLists.txt), and callers go through a table of those builds
+ * indexed by level selected at load time. This way one binary built for
+ * baseline x86-64 still uses AVX2 or AVX512 on machines that have them.
+ *
+ * A kernel source defines it's functions through @c SIMD_KERNEL, and it's
+ * caller declares them with @c SIMD_KERNEL_DECLARE and calls them through
+ * @c SIMD_DISPATCH :
+ *
+ * @code
+ * // Kernels/Count.c, compiled once per level
+ * Size SIMD_KERNEL(count_byte)(const Char* data, Size length, Char c) { ... }
+ *
+ * // Count.c
+ * SIMD_KERNEL_DECLARE(Size, count_byte, (const Char* data, Size length, Char c));
+ * Size n = SIMD_DISPATCH(count_byte)(data, length, c);
+ * @endcode
+ * */
+
+#ifndef ANVIE_SIMD_DISPATCH_H
+#define ANVIE_SIMD_DISPATCH_H
+
+#include <Anvie/Types.h>
+
+/**
+ * Levels at which SIMD kernels are built. These are same as levels of
+ * @c Anvie/Simd/Types.h, so a kernel built at a level sees exactly that
+ * @c SIMD_LVLx, and a level can only be used if CPU supports all
+ * instructions it's kernels are compiled with.
+ * */
+typedef enum SimdLevel {
+    SIMD_LEVEL_NONE,   /**< No SIMD, kernels use scalar code. Always available. */
+    SIMD_LEVEL_AVX,    /**< 16 byte registers, @c SIMD_LVL1. */
+    SIMD_LEVEL_AVX2,   /**< 32 byte registers, @c SIMD_LVL2. Also requires FMA, BMI1, BMI2 and POPCNT. */
+    SIMD_LEVEL_AVX512, /**< 64 byte registers, @c SIMD_LVL3. AVX512 F, BW, DQ and VL on top of AVX2 level. */
+    SIMD_LEVEL_COUNT
+} SimdLevel;
+
+/**
+ * Level used by @c SIMD_DISPATCH. Selected before @c main runs, as highest
+ * level CPU supports, unless overriden by @c ANVIE_SIMD_LEVEL environment
+ * variable ("none", "avx", "avx2" or "avx512"). Change it only through
+ * @c simd_level_set.
+ * */
+extern SimdLevel simd_level_active;
+
+SimdLevel simd_level_detect();
+SimdLevel simd_level_get();
+Bool      simd_level_set(SimdLevel level);
+ZString   simd_level_name(SimdLevel level);
+SimdLevel simd_level_from_name(ZString name);
+
+#define SIMD_KERNEL_CONCAT_(name, level) name##_##level
+#define SIMD_KERNEL_CONCAT(name, level)  SIMD_KERNEL_CONCAT_(name, level)
+
+/**
+ * Name of a kernel function in a kernel source. Build defines
+ * @c ANVIE_SIMD_KERNEL_LEVEL for each build of kernel sources,
+ * which gets appended to @p name.
+ * */
+#ifdef ANVIE_SIMD_KERNEL_LEVEL
+#   define SIMD_KERNEL(name) SIMD_KERNEL_CONCAT(name, ANVIE_SIMD_KERNEL_LEVEL)
+#endif // ANVIE_SIMD_KERNEL_LEVEL
+
+/**
+ * Declare all builds of a kernel and a table of them indexed by @c SimdLevel.
+ * When kernels are built only once (@c ANVIE_SIMD_DISPATCH not defined, as on
+ * non x86 targets), every level uses that build.
+ *
+ * @param ret Return type of kernel.
+ * @param name Name kernel is defined with through @c SIMD_KERNEL.
+ * @param params Parenthesized parameter list.
+ * */
+#if ANVIE_SIMD_DISPATCH
+#   define SIMD_KERNEL_DECLARE(ret, name, params)                                  \
+    ret name##_none params;                                                        \
+    ret name##_avx params;                                                         \
+    ret name##_avx2 params;                                                        \
+    ret name##_avx512 params;                                                      \
+    static ret(*const name##_table[SIMD_LEVEL_COUNT]) params = {                   \
+        name##_none, name##_avx, name##_avx2, name##_avx512                        \
+    }
+#else
+#   define SIMD_KERNEL_DECLARE(ret, name, params)                                  \
+    ret name##_none params;                                                        \
+    static ret(*const name##_table[SIMD_LEVEL_COUNT]) params = {                   \
+        name##_none, name##_none, name##_none, name##_none                         \
+    }
+#endif // ANVIE_SIMD_DISPATCH
+
+/**
+ * Build of kernel @p name for active level.
+ * */
+#define SIMD_DISPATCH(name) (name##_table[simd_level_active])
+
+#endif // ANVIE_SIMD_DISPATCH_H
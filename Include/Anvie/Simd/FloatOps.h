@@ -0,0 +1,65 @@
+/**
+ * @file FloatOps.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Defines generic SIMD (Single Instruction Multiple Data) wrappers over
+ * lane wise operations on 4 byte floats in @c MVecF registers.
+ *
+ * This file only contains definions. The actual implementation of each function
+ * is in the Impl file.
+ * */
+
+#ifndef ANVIE_SIMD_FLOAT_OPERATIONS_H
+#define ANVIE_SIMD_FLOAT_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+
+    static inline MVecF simd_setzero_ps();
+    static inline MVecF simd_set1_ps(Float32 a);
+    static inline MVecF simd_loadu_ps(const Float32* m);
+    static inline void  simd_storeu_ps(Float32* m, MVecF v);
+
+    static inline MVecF simd_add_ps(MVecF v1, MVecF v2);
+    static inline MVecF simd_sub_ps(MVecF v1, MVecF v2);
+    static inline MVecF simd_mul_ps(MVecF v1, MVecF v2);
+    static inline MVecF simd_div_ps(MVecF v1, MVecF v2);
+
+    /* same as x86 : if either lane is NaN, lane of @p v2 is returned */
+    static inline MVecF simd_min_ps(MVecF v1, MVecF v2);
+    static inline MVecF simd_max_ps(MVecF v1, MVecF v2);
+
+    static inline MVecF simd_sqrt_ps(MVecF v);
+
+    /* v1 * v2 + v3, rounded once when FMA is available */
+    static inline MVecF simd_fmadd_ps(MVecF v1, MVecF v2, MVecF v3);
+
+    /* one bit per lane, same as @c simd_cmpeq_epi32_mask. Comparisions with NaN are false */
+    static inline MMask simd_cmpeq_ps_mask(MVecF v1, MVecF v2);
+    static inline MMask simd_cmplt_ps_mask(MVecF v1, MVecF v2);
+    static inline MMask simd_cmple_ps_mask(MVecF v1, MVecF v2);
+
+    /* sum of all lanes, order of additions differs between SIMD levels */
+    static inline Float32 simd_reduce_add_ps(MVecF v);
+
+    /* conversion from 4 byte integer lanes, and back truncating towards zero */
+    static inline MVecF simd_cvtepi32_ps(MVec v);
+    static inline MVec  simd_cvttps_epi32(MVecF v);
+
+#include <Anvie/Simd/Impl/FloatOps.h>
+
+#endif // ANVIE_SIMD_FLOAT_OPERATIONS_H
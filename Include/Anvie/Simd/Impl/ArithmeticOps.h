@@ -0,0 +1,135 @@
+/**
+ * @file ArithmeticOps.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation file for SIMD arithmetic operations.
+ * */
+
+#ifndef ANVIE_SIMD_IMPLEMENTATIONS_ARITHMETIC_OPERATIONS_H
+#define ANVIE_SIMD_IMPLEMENTATIONS_ARITHMETIC_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+#include <Anvie/HelperDefines.h>
+
+#if SIMD_LVL3
+#   define SIMD_ARITH_OP(op, t, n)                                  \
+    static inline MVec simd_##op##_##t##n(MVec v1, MVec v2) {       \
+        return _mm512_##op##_##t##n(v1, v2);                        \
+    }
+#elif SIMD_LVL2
+#   define SIMD_ARITH_OP(op, t, n)                                  \
+    static inline MVec simd_##op##_##t##n(MVec v1, MVec v2) {       \
+        return _mm256_##op##_##t##n(v1, v2);                        \
+    }
+#elif SIMD_LVL1
+#   define SIMD_ARITH_OP(op, t, n)                                  \
+    static inline MVec simd_##op##_##t##n(MVec v1, MVec v2) {       \
+        return _mm_##op##_##t##n(v1, v2);                           \
+    }
+#elif SIMD_NEON
+/* wrapping ops give same bits for signed and unsigned lanes, so only min and max care about it */
+#   define SIMD_NEON_ARITH_add   vaddq
+#   define SIMD_NEON_ARITH_sub   vsubq
+#   define SIMD_NEON_ARITH_mullo vmulq
+#   define SIMD_NEON_ARITH_adds  vqaddq
+#   define SIMD_NEON_ARITH_subs  vqsubq
+#   define SIMD_NEON_ARITH_min   vminq
+#   define SIMD_NEON_ARITH_max   vmaxq
+#   define SIMD_NEON_LANE_epi    s
+#   define SIMD_NEON_LANE_epu    u
+#   define SIMD_NEON_ARITH(f, l, n, a, b) SIMD_NEON_ARITH_(f, l, n, a, b)
+#   define SIMD_NEON_ARITH_(f, l, n, a, b) \
+        vreinterpretq_u8_##l##n(f##_##l##n(vreinterpretq_##l##n##_u8(a), vreinterpretq_##l##n##_u8(b)))
+#   define SIMD_ARITH_OP(op, t, n)                                  \
+    static inline MVec simd_##op##_##t##n(MVec v1, MVec v2) {       \
+        return SIMD_NEON_ARITH(SIMD_NEON_ARITH_##op, SIMD_NEON_LANE_##t, n, v1, v2); \
+    }
+#else
+/* lanes are computed as unsigned (epu) or signed (epi) values, wrapping ones always as unsigned */
+#   define SIMD_SCALAR_LANE_epi(n, v, k) v.i##n[k]
+#   define SIMD_SCALAR_LANE_epu(n, v, k) v.u##n[k]
+#   define SIMD_SCALAR_ARITH_add(n, a, b)   (Uint##n)((Uint##n)(a) + (Uint##n)(b))
+#   define SIMD_SCALAR_ARITH_sub(n, a, b)   (Uint##n)((Uint##n)(a) - (Uint##n)(b))
+#   define SIMD_SCALAR_ARITH_mullo(n, a, b) (Uint##n)((Uint64)(Uint##n)(a) * (Uint##n)(b))
+#   define SIMD_SCALAR_ARITH_adds(n, a, b)  (Uint##n)MIN((Uint64)(a) + (b), (Uint##n)~(Uint##n)0)
+#   define SIMD_SCALAR_ARITH_subs(n, a, b)  (Uint##n)((a) > (b) ? (a) - (b) : 0)
+#   define SIMD_SCALAR_ARITH_min(n, a, b)   MIN(a, b)
+#   define SIMD_SCALAR_ARITH_max(n, a, b)   MAX(a, b)
+#   define SIMD_ARITH_OP(op, t, n)                                                  \
+    static inline MVec simd_##op##_##t##n(MVec v1, MVec v2) {                       \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                              \
+            SIMD_SCALAR_LANE_##t(n, v1, k) =                                        \
+                SIMD_SCALAR_ARITH_##op(n, SIMD_SCALAR_LANE_##t(n, v1, k), SIMD_SCALAR_LANE_##t(n, v2, k)); \
+        }                                                                           \
+        return v1;                                                                  \
+    }
+#endif
+
+SIMD_ARITH_OP(add, epi, 8);
+SIMD_ARITH_OP(add, epi, 16);
+SIMD_ARITH_OP(add, epi, 32);
+SIMD_ARITH_OP(add, epi, 64);
+SIMD_ARITH_OP(sub, epi, 8);
+SIMD_ARITH_OP(sub, epi, 16);
+SIMD_ARITH_OP(sub, epi, 32);
+SIMD_ARITH_OP(sub, epi, 64);
+
+SIMD_ARITH_OP(mullo, epi, 16);
+SIMD_ARITH_OP(mullo, epi, 32);
+
+SIMD_ARITH_OP(adds, epu, 8);
+SIMD_ARITH_OP(subs, epu, 8);
+
+SIMD_ARITH_OP(min, epi, 8);
+SIMD_ARITH_OP(min, epi, 16);
+SIMD_ARITH_OP(min, epi, 32);
+SIMD_ARITH_OP(max, epi, 8);
+SIMD_ARITH_OP(max, epi, 16);
+SIMD_ARITH_OP(max, epi, 32);
+
+SIMD_ARITH_OP(min, epu, 8);
+SIMD_ARITH_OP(min, epu, 16);
+SIMD_ARITH_OP(min, epu, 32);
+SIMD_ARITH_OP(max, epu, 8);
+SIMD_ARITH_OP(max, epu, 16);
+SIMD_ARITH_OP(max, epu, 32);
+
+#undef SIMD_ARITH_OP
+#undef SIMD_SCALAR_LANE_epi
+#undef SIMD_SCALAR_LANE_epu
+#undef SIMD_SCALAR_ARITH_add
+#undef SIMD_SCALAR_ARITH_sub
+#undef SIMD_SCALAR_ARITH_mullo
+#undef SIMD_SCALAR_ARITH_adds
+#undef SIMD_SCALAR_ARITH_subs
+#undef SIMD_SCALAR_ARITH_min
+#undef SIMD_SCALAR_ARITH_max
+#undef SIMD_NEON_ARITH_add
+#undef SIMD_NEON_ARITH_sub
+#undef SIMD_NEON_ARITH_mullo
+#undef SIMD_NEON_ARITH_adds
+#undef SIMD_NEON_ARITH_subs
+#undef SIMD_NEON_ARITH_min
+#undef SIMD_NEON_ARITH_max
+#undef SIMD_NEON_LANE_epi
+#undef SIMD_NEON_LANE_epu
+#undef SIMD_NEON_ARITH
+#undef SIMD_NEON_ARITH_
+
+#endif // ANVIE_SIMD_IMPLEMENTATIONS_ARITHMETIC_OPERATIONS_H
@@ -0,0 +1,215 @@
+/**
+ * @file BitwiseOps.h
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation file for SIMD bitwise operations.
+ * */
+
+#ifndef ANVIE_SIMD_IMPLEMENTATIONS_BITWISE_OPERATIONS_H
+#define ANVIE_SIMD_IMPLEMENTATIONS_BITWISE_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+#include <Anvie/HelperDefines.h>
+
+#if SIMD_LVL3
+#   define SIMD_BITWISE_OP(op)                          \
+    static inline MVec simd_##op(MVec v1, MVec v2) {    \
+        return _mm512_##op##_si512(v1, v2);             \
+    }
+#elif SIMD_LVL2
+#   define SIMD_BITWISE_OP(op)                          \
+    static inline MVec simd_##op(MVec v1, MVec v2) {    \
+        return _mm256_##op##_si256(v1, v2);             \
+    }
+#elif SIMD_LVL1
+#   define SIMD_BITWISE_OP(op)                          \
+    static inline MVec simd_##op(MVec v1, MVec v2) {    \
+        return _mm_##op##_si128(v1, v2);                \
+    }
+#elif SIMD_NEON
+#   define SIMD_NEON_BITWISE_and(a, b)    vandq_u8(a, b)
+#   define SIMD_NEON_BITWISE_or(a, b)     vorrq_u8(a, b)
+#   define SIMD_NEON_BITWISE_xor(a, b)    veorq_u8(a, b)
+#   define SIMD_NEON_BITWISE_andnot(a, b) vbicq_u8(b, a)
+#   define SIMD_BITWISE_OP(op)                          \
+    static inline MVec simd_##op(MVec v1, MVec v2) {    \
+        return SIMD_NEON_BITWISE_##op(v1, v2);          \
+    }
+#else
+#   define SIMD_SCALAR_BITWISE_and(a, b)    ((a) & (b))
+#   define SIMD_SCALAR_BITWISE_or(a, b)     ((a) | (b))
+#   define SIMD_SCALAR_BITWISE_xor(a, b)    ((a) ^ (b))
+#   define SIMD_SCALAR_BITWISE_andnot(a, b) (~(a) & (b))
+#   define SIMD_BITWISE_OP(op)                                          \
+    static inline MVec simd_##op(MVec v1, MVec v2) {                    \
+        for(Size k = 0; k < SIMD_LANES(Uint64); k++) {                  \
+            v1.u64[k] = SIMD_SCALAR_BITWISE_##op(v1.u64[k], v2.u64[k]); \
+        }                                                               \
+        return v1;                                                      \
+    }
+#endif
+
+SIMD_BITWISE_OP(and);
+SIMD_BITWISE_OP(or);
+SIMD_BITWISE_OP(xor);
+SIMD_BITWISE_OP(andnot);
+
+#undef SIMD_BITWISE_OP
+#undef SIMD_SCALAR_BITWISE_and
+#undef SIMD_SCALAR_BITWISE_or
+#undef SIMD_SCALAR_BITWISE_xor
+#undef SIMD_SCALAR_BITWISE_andnot
+#undef SIMD_NEON_BITWISE_and
+#undef SIMD_NEON_BITWISE_or
+#undef SIMD_NEON_BITWISE_xor
+#undef SIMD_NEON_BITWISE_andnot
+
+/* hardware shifts by a count in a register already give 0 (or sign) for counts above lane width */
+#if SIMD_LVL3
+#   define SIMD_SHIFT_OP(op, n)                                 \
+    static inline MVec simd_##op##_epi##n(MVec v, Uint32 c) {   \
+        return _mm512_##op##_epi##n(v, c);                      \
+    }
+#elif SIMD_LVL2
+#   define SIMD_SHIFT_OP(op, n)                                 \
+    static inline MVec simd_##op##_epi##n(MVec v, Uint32 c) {   \
+        return _mm256_##op##_epi##n(v, (Int32)MIN(c, 255u));   \
+    }
+#elif SIMD_LVL1
+#   define SIMD_SHIFT_OP(op, n)                                 \
+    static inline MVec simd_##op##_epi##n(MVec v, Uint32 c) {   \
+        return _mm_##op##_epi##n(v, (Int32)MIN(c, 255u));       \
+    }
+#elif SIMD_NEON
+/* NEON shifts left by a signed count in each lane, negative counts shift right, logically if lanes are unsigned */
+#   define SIMD_NEON_SHIFT_slli(n, v, c) c < n ? vshlq_s##n(v, vdupq_n_s##n((Int##n)c)) : vdupq_n_s##n(0)
+#   define SIMD_NEON_SHIFT_srli(n, v, c)                                                                \
+        c < n ? vreinterpretq_s##n##_u##n(vshlq_u##n(vreinterpretq_u##n##_s##n(v), vdupq_n_s##n(-(Int##n)c))) \
+              : vdupq_n_s##n(0)
+#   define SIMD_NEON_SHIFT_srai(n, v, c) vshlq_s##n(v, vdupq_n_s##n(-(Int##n)MIN(c, n - 1)))
+#   define SIMD_SHIFT_OP(op, n)                                 \
+    static inline MVec simd_##op##_epi##n(MVec v, Uint32 c) {   \
+        return vreinterpretq_u8_s##n(SIMD_NEON_SHIFT_##op(n, vreinterpretq_s##n##_u8(v), c)); \
+    }
+#else
+#   define SIMD_SCALAR_SHIFT_slli(n, v, c) v.u##n[k] = c < n ? (Uint##n)(v.u##n[k] << c) : 0
+#   define SIMD_SCALAR_SHIFT_srli(n, v, c) v.u##n[k] = c < n ? (Uint##n)(v.u##n[k] >> c) : 0
+#   define SIMD_SCALAR_SHIFT_srai(n, v, c) v.i##n[k] = (Int##n)(v.i##n[k] >> MIN(c, n - 1))
+#   define SIMD_SHIFT_OP(op, n)                                 \
+    static inline MVec simd_##op##_epi##n(MVec v, Uint32 c) {   \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {          \
+            SIMD_SCALAR_SHIFT_##op(n, v, c);                    \
+        }                                                       \
+        return v;                                               \
+    }
+#endif
+
+SIMD_SHIFT_OP(slli, 16);
+SIMD_SHIFT_OP(slli, 32);
+SIMD_SHIFT_OP(slli, 64);
+SIMD_SHIFT_OP(srli, 16);
+SIMD_SHIFT_OP(srli, 32);
+SIMD_SHIFT_OP(srli, 64);
+SIMD_SHIFT_OP(srai, 16);
+SIMD_SHIFT_OP(srai, 32);
+
+#if SIMD_LVL3 || SIMD_NEON || !SIMD_ENABLED
+SIMD_SHIFT_OP(srai, 64);
+#else
+/* no 8 byte arithmetic shift below AVX512, so shift logically and fill in sign bits */
+static inline MVec simd_srai_epi64(MVec v, Uint32 c) {
+    c = MIN(c, 63);
+#   if SIMD_LVL2
+    MVec32 sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), v);
+    return _mm256_or_si256(_mm256_srli_epi64(v, (Int32)c), _mm256_slli_epi64(sign, (Int32)(64 - c)));
+#   else
+    MVec16 sign = _mm_cmpgt_epi64(_mm_setzero_si128(), v);
+    return _mm_or_si128(_mm_srli_epi64(v, (Int32)c), _mm_slli_epi64(sign, (Int32)(64 - c)));
+#   endif
+}
+#endif // SIMD_LVL3 || SIMD_NEON || !SIMD_ENABLED
+
+#undef SIMD_SHIFT_OP
+#undef SIMD_SCALAR_SHIFT_slli
+#undef SIMD_SCALAR_SHIFT_srli
+#undef SIMD_SCALAR_SHIFT_srai
+#undef SIMD_NEON_SHIFT_slli
+#undef SIMD_NEON_SHIFT_srli
+#undef SIMD_NEON_SHIFT_srai
+
+/* counts of set bits of each 4 bit value, looked up for low and high half of every byte */
+static inline MVec simd_popcnt_epi8(MVec v) {
+#if SIMD_LVL3
+    const MVec64 lut = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const MVec64 nib = _mm512_set1_epi8(0x0f);
+    return _mm512_add_epi8(_mm512_shuffle_epi8(lut, _mm512_and_si512(v, nib)),
+                           _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(v, 4), nib)));
+#elif SIMD_LVL2
+    const MVec32 lut = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const MVec32 nib = _mm256_set1_epi8(0x0f);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(v, nib)),
+                           _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nib)));
+#elif SIMD_LVL1
+    const MVec16 lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const MVec16 nib = _mm_set1_epi8(0x0f);
+    return _mm_add_epi8(_mm_shuffle_epi8(lut, _mm_and_si128(v, nib)),
+                        _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nib)));
+#elif SIMD_NEON
+    return vcntq_u8(v);
+#else
+    for(Size k = 0; k < SIMD_LANES(Uint8); k++) {
+        v.u8[k] = (Uint8)__builtin_popcount(v.u8[k]);
+    }
+    return v;
+#endif
+}
+
+/* byte counts are summed into 8 byte lanes by sum of absolute differences against zero */
+static inline Size simd_popcount(MVec v) {
+#if SIMD_LVL3
+    return (Size)_mm512_reduce_add_epi64(_mm512_sad_epu8(simd_popcnt_epi8(v), _mm512_setzero_si512()));
+#elif SIMD_LVL2
+    MVec32 sums = _mm256_sad_epu8(simd_popcnt_epi8(v), _mm256_setzero_si256());
+    MVec16 sum  = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return (Size)(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+#elif SIMD_LVL1
+    MVec16 sum = _mm_sad_epu8(simd_popcnt_epi8(v), _mm_setzero_si128());
+    return (Size)(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+#elif SIMD_NEON
+    return (Size)vaddlvq_u8(vcntq_u8(v));
+#else
+    return (Size)(__builtin_popcountll(v.u64[0]) + __builtin_popcountll(v.u64[1]));
+#endif
+}
+
+static inline Bool simd_testz(MVec v) {
+#if SIMD_LVL3
+    return _mm512_test_epi8_mask(v, v) == 0;
+#elif SIMD_LVL2
+    return _mm256_testz_si256(v, v);
+#elif SIMD_LVL1
+    return _mm_testz_si128(v, v);
+#elif SIMD_NEON
+    return vmaxvq_u32(vreinterpretq_u32_u8(v)) == 0;
+#else
+    return !(v.u64[0] | v.u64[1]);
+#endif
+}
+
+#endif // ANVIE_SIMD_IMPLEMENTATIONS_BITWISE_OPERATIONS_H
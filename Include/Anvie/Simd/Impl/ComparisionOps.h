@@ -28,11 +28,11 @@
 #include <Anvie/Simd/Types.h>
 #include <Anvie/HelperDefines.h>
 
-#if SIMD_ENABLED
-#   if SIMD_LVL3
+#if SIMD_LVL3
 #   define SIMD_CMP_EPI(op, n)                                          \
     static inline MVec64 simd_cmp##op##_epi##n(MVec64 v1, MVec64 v2) {  \
-        return _mm512_cmp##op##_epi8(v1, v2);                           \
+        /* AVX512 compares only produce masks, expand mask back to lanes */ \
+        return _mm512_movm_epi##n(_mm512_cmp##op##_epi##n##_mask(v1, v2)); \
     }                                                                   \
                                                                         \
     static inline MMask64 simd_cmp##op##_epi##n##_mask(MVec64 v1, MVec64 v2) { \
@@ -47,21 +47,39 @@
         return _mm_cmp##op##_epi##n##_mask(v1, v2);                     \
     }
 
-#   elif SIMD_LVL2
+#elif SIMD_LVL2
 #   define SIMD_CMP_EPI(op, n)                                          \
     static inline MVec32 simd_cmp##op##_epi##n(MVec32 v1, MVec32 v2) {  \
         return _mm256_cmp##op##_epi##n(v1, v2);                         \
     }
-#   elif SIMD_LVL1
+#elif SIMD_LVL1
 #   define SIMD_CMP_EPI(op, n)                                          \
     static inline MVec16 simd_cmp##op##_epi##n(MVec16 v1, MVec16 v2) {  \
         return _mm_cmp##op##_epi##n(v1, v2);                            \
     }
-#   endif
+#elif SIMD_NEON
+#   define SIMD_CMP_EPI(op, n)                                          \
+    static inline MVec simd_cmp##op##_epi##n(MVec v1, MVec v2) {        \
+        return vreinterpretq_u8_u##n(vc##op##q_s##n(vreinterpretq_s##n##_u8(v1), vreinterpretq_s##n##_u8(v2))); \
+    }
 #else
+#   define SIMD_SCALAR_CMP_eq(a, b) ((a) == (b))
+#   define SIMD_SCALAR_CMP_gt(a, b) ((a) > (b))
 #   define SIMD_CMP_EPI(op, n)                                          \
-    static inline Uint8 simd_cmp##op##_epi##n(Uint64 v1, Uint64 v2) {   \
-        return 0;                                                       \
+    static inline MVec simd_cmp##op##_epi##n(MVec v1, MVec v2) {        \
+        MVec r;                                                         \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                  \
+            r.i##n[k] = SIMD_SCALAR_CMP_##op(v1.i##n[k], v2.i##n[k]) ? -1 : 0; \
+        }                                                               \
+        return r;                                                       \
+    }                                                                   \
+                                                                        \
+    static inline MMask simd_cmp##op##_epi##n##_mask(MVec v1, MVec v2) { \
+        MMask mask = 0;                                                 \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                  \
+            mask |= (MMask)(SIMD_SCALAR_CMP_##op(v1.i##n[k], v2.i##n[k]) << k); \
+        }                                                               \
+        return mask;                                                    \
     }
 #endif
 
@@ -80,9 +98,14 @@ SIMD_CMP_EPI(gt, 64);
 
 #undef SIMD_CMP
 #undef SIMD_CMP_EPI
+#undef SIMD_SCALAR_CMP_eq
+#undef SIMD_SCALAR_CMP_gt
 
 
-#if SIMD_LVL2
+#if SIMD_LVL3 || !SIMD_ENABLED
+    /* already defined along with vector compares */
+#   define SIMD_CMP_EPI8_MASK(op)
+#elif SIMD_LVL2
 #   define SIMD_CMP_EPI8_MASK(op)                                       \
     static inline MMask32 simd_cmp##op##_epi8_mask(MVec32 v1, MVec32 v2) { \
         /* movemask will convert given value to a uint32 mask */        \
@@ -94,26 +117,89 @@ SIMD_CMP_EPI(gt, 64);
         /* movemask will convert given value to a uint32 mask */        \
         return _mm_movemask_epi8(_mm_cmp##op##_epi8(v1, v2));           \
     }
+#elif SIMD_NEON
+#   define SIMD_CMP_EPI8_MASK(op)                                       \
+    static inline MMask simd_cmp##op##_epi8_mask(MVec v1, MVec v2) {    \
+        return simd_movemask_epi8(simd_cmp##op##_epi8(v1, v2));         \
+    }
 #endif
 
 SIMD_CMP_EPI8_MASK(eq);
 SIMD_CMP_EPI8_MASK(gt);
 
-/**
- * Count trailing zeroes
- * */
-static inline Uint8 simd_tzcnt(Uint64 v) {
-#if SIMD_ENABLED
-#   if SIMD_LVL3
-        return (Uint8) _tzcnt_u64(v);
-#   elif SIMD_LVL2
-        return (Uint8) _tzcnt_u32(v);
-#   elif SIMD_LVL1
-        return (Uint8) _tzcnt_u16(v);
-#   endif
+#undef SIMD_CMP_EPI8_MASK
+
+/* lane masks for 4 and 8 byte words, sign bit of each lane is it's comparision result */
+#if SIMD_LVL3 || !SIMD_ENABLED
+    /* already defined along with vector compares */
+#   define SIMD_CMP_EPI32_64_MASK(op)
+#elif SIMD_LVL2
+#   define SIMD_CMP_EPI32_64_MASK(op)                                   \
+    static inline MMask32 simd_cmp##op##_epi32_mask(MVec32 v1, MVec32 v2) { \
+        return (MMask32)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmp##op##_epi32(v1, v2))); \
+    }                                                                   \
+                                                                        \
+    static inline MMask32 simd_cmp##op##_epi64_mask(MVec32 v1, MVec32 v2) { \
+        return (MMask32)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmp##op##_epi64(v1, v2))); \
+    }
+#elif SIMD_LVL1
+#   define SIMD_CMP_EPI32_64_MASK(op)                                   \
+    static inline MMask16 simd_cmp##op##_epi32_mask(MVec16 v1, MVec16 v2) { \
+        return (MMask16)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmp##op##_epi32(v1, v2))); \
+    }                                                                   \
+                                                                        \
+    static inline MMask16 simd_cmp##op##_epi64_mask(MVec16 v1, MVec16 v2) { \
+        return (MMask16)_mm_movemask_pd(_mm_castsi128_pd(_mm_cmp##op##_epi64(v1, v2))); \
+    }
+#elif SIMD_NEON
+/* all ones lanes keep only their own bit, and a horizontal add packs them together */
+#   define SIMD_CMP_EPI32_64_MASK(op)                                   \
+    static inline MMask simd_cmp##op##_epi32_mask(MVec v1, MVec v2) {   \
+        static const Uint32 lane_bits[4] = {1, 2, 4, 8};                \
+        uint32x4_t lanes = vreinterpretq_u32_u8(simd_cmp##op##_epi32(v1, v2)); \
+        return (MMask)vaddvq_u32(vandq_u32(lanes, vld1q_u32(lane_bits))); \
+    }                                                                   \
+                                                                        \
+    static inline MMask simd_cmp##op##_epi64_mask(MVec v1, MVec v2) {   \
+        static const Uint64 lane_bits[2] = {1, 2};                      \
+        uint64x2_t lanes = vreinterpretq_u64_u8(simd_cmp##op##_epi64(v1, v2)); \
+        return (MMask)vaddvq_u64(vandq_u64(lanes, vld1q_u64(lane_bits))); \
+    }
+#endif
+
+SIMD_CMP_EPI32_64_MASK(eq);
+SIMD_CMP_EPI32_64_MASK(gt);
+
+#undef SIMD_CMP_EPI32_64_MASK
+
+static inline MMask simd_movemask_epi8(MVec v) {
+#if SIMD_LVL3
+    return _mm512_movepi8_mask(v);
+#elif SIMD_LVL2
+    return (MMask)_mm256_movemask_epi8(v);
+#elif SIMD_LVL1
+    return (MMask)_mm_movemask_epi8(v);
+#elif SIMD_NEON
+    /* no movemask on NEON, sign bit is spread over each byte, which then keeps only it's own bit
+     * in that half of register, and a horizontal add of each half gives one byte of mask */
+    static const Uint8 lane_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(v), 7)), vld1q_u8(lane_bits));
+    return (MMask)(vaddv_u8(vget_low_u8(bits)) | (vaddv_u8(vget_high_u8(bits)) << 8));
 #else
-    return 0;
+    MMask mask = 0;
+    for(Size k = 0; k < SIMD_LANES(Uint8); k++) {
+        mask |= (MMask)((v.u8[k] >> 7) << k);
+    }
+    return mask;
 #endif
 }
 
+/**
+ * Count trailing zeroes, number of bits of a register if @p v is 0.
+ * */
+static inline Uint32 simd_tzcnt(Uint64 v) {
+    /* tzcnt needs BMI, which is not implied by any AVX level */
+    return v ? (Uint32)__builtin_ctzll(v) : (Uint32)(sizeof(MVec) * 8);
+}
+
 #endif // ANVIE_SIMD_IMPLEMENTATIONS_COMPARISION_OPERATIONS_H
@@ -0,0 +1,255 @@
+/**
+ * @file FloatOps.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Implementation file for SIMD float operations.
+ * */
+
+#ifndef ANVIE_SIMD_IMPLEMENTATIONS_FLOAT_OPERATIONS_H
+#define ANVIE_SIMD_IMPLEMENTATIONS_FLOAT_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+#include <math.h>
+#include <string.h>
+
+#if SIMD_LVL3
+#   define SIMD_PS(op) _mm512_##op##_ps
+#elif SIMD_LVL2
+#   define SIMD_PS(op) _mm256_##op##_ps
+#elif SIMD_LVL1
+#   define SIMD_PS(op) _mm_##op##_ps
+#endif // SIMD_LVL3
+
+#if SIMD_X86
+#   define SIMD_FLOAT_OP(op)                                    \
+    static inline MVecF simd_##op##_ps(MVecF v1, MVecF v2) {    \
+        return SIMD_PS(op)(v1, v2);                             \
+    }
+#elif SIMD_NEON
+/* NEON min and max give NaN if any lane is NaN, select instead to return second lane like x86 */
+#   define SIMD_NEON_FLOAT_add(a, b) vaddq_f32(a, b)
+#   define SIMD_NEON_FLOAT_sub(a, b) vsubq_f32(a, b)
+#   define SIMD_NEON_FLOAT_mul(a, b) vmulq_f32(a, b)
+#   define SIMD_NEON_FLOAT_div(a, b) vdivq_f32(a, b)
+#   define SIMD_NEON_FLOAT_min(a, b) vbslq_f32(vcltq_f32(a, b), a, b)
+#   define SIMD_NEON_FLOAT_max(a, b) vbslq_f32(vcgtq_f32(a, b), a, b)
+#   define SIMD_FLOAT_OP(op)                                    \
+    static inline MVecF simd_##op##_ps(MVecF v1, MVecF v2) {    \
+        return SIMD_NEON_FLOAT_##op(v1, v2);                    \
+    }
+#else
+#   define SIMD_SCALAR_FLOAT_add(a, b) ((a) + (b))
+#   define SIMD_SCALAR_FLOAT_sub(a, b) ((a) - (b))
+#   define SIMD_SCALAR_FLOAT_mul(a, b) ((a) * (b))
+#   define SIMD_SCALAR_FLOAT_div(a, b) ((a) / (b))
+#   define SIMD_SCALAR_FLOAT_min(a, b) ((a) < (b) ? (a) : (b))
+#   define SIMD_SCALAR_FLOAT_max(a, b) ((a) > (b) ? (a) : (b))
+#   define SIMD_FLOAT_OP(op)                                    \
+    static inline MVecF simd_##op##_ps(MVecF v1, MVecF v2) {    \
+        for(Size k = 0; k < SIMD_LANES(Float32); k++) {         \
+            v1.f32[k] = SIMD_SCALAR_FLOAT_##op(v1.f32[k], v2.f32[k]); \
+        }                                                       \
+        return v1;                                              \
+    }
+#endif // SIMD_X86
+
+SIMD_FLOAT_OP(add);
+SIMD_FLOAT_OP(sub);
+SIMD_FLOAT_OP(mul);
+SIMD_FLOAT_OP(div);
+SIMD_FLOAT_OP(min);
+SIMD_FLOAT_OP(max);
+
+#undef SIMD_FLOAT_OP
+#undef SIMD_SCALAR_FLOAT_add
+#undef SIMD_SCALAR_FLOAT_sub
+#undef SIMD_SCALAR_FLOAT_mul
+#undef SIMD_SCALAR_FLOAT_div
+#undef SIMD_SCALAR_FLOAT_min
+#undef SIMD_SCALAR_FLOAT_max
+#undef SIMD_NEON_FLOAT_add
+#undef SIMD_NEON_FLOAT_sub
+#undef SIMD_NEON_FLOAT_mul
+#undef SIMD_NEON_FLOAT_div
+#undef SIMD_NEON_FLOAT_min
+#undef SIMD_NEON_FLOAT_max
+
+static inline MVecF simd_setzero_ps() {
+#if SIMD_X86
+    return SIMD_PS(setzero)();
+#elif SIMD_NEON
+    return vdupq_n_f32(0.0f);
+#else
+    MVecF v = {{0}};
+    return v;
+#endif
+}
+
+static inline MVecF simd_set1_ps(Float32 a) {
+#if SIMD_X86
+    return SIMD_PS(set1)(a);
+#elif SIMD_NEON
+    return vdupq_n_f32(a);
+#else
+    MVecF v;
+    for(Size k = 0; k < SIMD_LANES(Float32); k++) {
+        v.f32[k] = a;
+    }
+    return v;
+#endif
+}
+
+static inline MVecF simd_loadu_ps(const Float32* m) {
+#if SIMD_X86
+    return SIMD_PS(loadu)(m);
+#elif SIMD_NEON
+    return vld1q_f32(m);
+#else
+    MVecF v;
+    memcpy(&v, m, sizeof(v));
+    return v;
+#endif
+}
+
+static inline void simd_storeu_ps(Float32* m, MVecF v) {
+#if SIMD_X86
+    SIMD_PS(storeu)(m, v);
+#elif SIMD_NEON
+    vst1q_f32(m, v);
+#else
+    memcpy(m, &v, sizeof(v));
+#endif
+}
+
+static inline MVecF simd_sqrt_ps(MVecF v) {
+#if SIMD_X86
+    return SIMD_PS(sqrt)(v);
+#elif SIMD_NEON
+    return vsqrtq_f32(v);
+#else
+    for(Size k = 0; k < SIMD_LANES(Float32); k++) {
+        v.f32[k] = sqrtf(v.f32[k]);
+    }
+    return v;
+#endif
+}
+
+static inline MVecF simd_fmadd_ps(MVecF v1, MVecF v2, MVecF v3) {
+#if SIMD_X86 && (defined(__FMA__) || SIMD_LVL3)
+    return SIMD_PS(fmadd)(v1, v2, v3);
+#elif SIMD_NEON
+    return vfmaq_f32(v3, v1, v2);
+#else
+    return simd_add_ps(simd_mul_ps(v1, v2), v3);
+#endif
+}
+
+/* ordered, non signalling predicates, so NaN lanes compare false */
+#if SIMD_LVL3
+#   define SIMD_FLOAT_CMP(op, pred)                                     \
+    static inline MMask simd_cmp##op##_ps_mask(MVecF v1, MVecF v2) {    \
+        return _mm512_cmp_ps_mask(v1, v2, pred);                        \
+    }
+#elif SIMD_X86
+#   define SIMD_FLOAT_CMP(op, pred)                                     \
+    static inline MMask simd_cmp##op##_ps_mask(MVecF v1, MVecF v2) {    \
+        return (MMask)SIMD_PS(movemask)(SIMD_PS(cmp)(v1, v2, pred));    \
+    }
+#elif SIMD_NEON
+#   define SIMD_FLOAT_CMP(op, pred)                                     \
+    static inline MMask simd_cmp##op##_ps_mask(MVecF v1, MVecF v2) {    \
+        static const Uint32 lane_bits[4] = {1, 2, 4, 8};                \
+        return (MMask)vaddvq_u32(vandq_u32(vc##op##q_f32(v1, v2), vld1q_u32(lane_bits))); \
+    }
+#else
+#   define SIMD_SCALAR_FLOAT_CMP_eq(a, b) ((a) == (b))
+#   define SIMD_SCALAR_FLOAT_CMP_lt(a, b) ((a) < (b))
+#   define SIMD_SCALAR_FLOAT_CMP_le(a, b) ((a) <= (b))
+#   define SIMD_FLOAT_CMP(op, pred)                                     \
+    static inline MMask simd_cmp##op##_ps_mask(MVecF v1, MVecF v2) {    \
+        MMask mask = 0;                                                 \
+        for(Size k = 0; k < SIMD_LANES(Float32); k++) {                 \
+            mask |= (MMask)(SIMD_SCALAR_FLOAT_CMP_##op(v1.f32[k], v2.f32[k]) << k); \
+        }                                                               \
+        return mask;                                                    \
+    }
+#endif // SIMD_LVL3
+
+SIMD_FLOAT_CMP(eq, _CMP_EQ_OQ);
+SIMD_FLOAT_CMP(lt, _CMP_LT_OQ);
+SIMD_FLOAT_CMP(le, _CMP_LE_OQ);
+
+#undef SIMD_FLOAT_CMP
+#undef SIMD_SCALAR_FLOAT_CMP_eq
+#undef SIMD_SCALAR_FLOAT_CMP_lt
+#undef SIMD_SCALAR_FLOAT_CMP_le
+
+static inline Float32 simd_reduce_add_ps(MVecF v) {
+#if SIMD_LVL3
+    return _mm512_reduce_add_ps(v);
+#elif SIMD_X86
+#   if SIMD_LVL2
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+#   else
+    __m128 sum = v;
+#   endif
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+#elif SIMD_NEON
+    return vaddvq_f32(v);
+#else
+    return (v.f32[0] + v.f32[2]) + (v.f32[1] + v.f32[3]);
+#endif
+}
+
+static inline MVecF simd_cvtepi32_ps(MVec v) {
+#if SIMD_X86
+    return SIMD_PS(cvtepi32)(v);
+#elif SIMD_NEON
+    return vcvtq_f32_s32(vreinterpretq_s32_u8(v));
+#else
+    MVecF r;
+    for(Size k = 0; k < SIMD_LANES(Float32); k++) {
+        r.f32[k] = (Float32)v.i32[k];
+    }
+    return r;
+#endif
+}
+
+static inline MVec simd_cvttps_epi32(MVecF v) {
+#if SIMD_LVL3
+    return _mm512_cvttps_epi32(v);
+#elif SIMD_LVL2
+    return _mm256_cvttps_epi32(v);
+#elif SIMD_LVL1
+    return _mm_cvttps_epi32(v);
+#elif SIMD_NEON
+    return vreinterpretq_u8_s32(vcvtq_s32_f32(v));
+#else
+    MVec r;
+    for(Size k = 0; k < SIMD_LANES(Int32); k++) {
+        r.i32[k] = (Int32)v.f32[k];
+    }
+    return r;
+#endif
+}
+
+#undef SIMD_PS
+
+#endif // ANVIE_SIMD_IMPLEMENTATIONS_FLOAT_OPERATIONS_H
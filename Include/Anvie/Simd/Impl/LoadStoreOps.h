@@ -25,6 +25,7 @@
 
 #include <Anvie/Types.h>
 #include <Anvie/Simd/Types.h>
+#include <string.h>
 
 /* intel really needs to be so dumb in naming somethings, why 64x only for 64? not others? idiot. */
 #define _mm256_set_epi64 _mm256_set_epi64x
@@ -41,12 +42,11 @@
         return _mm512_loadu_epi8(m);                            \
     }                                                           \
                                                                 \
-    static inline MVec simd256_loadu_epi##n(const void* m) {    \
+    static inline MVec32 simd256_loadu_epi##n(const void* m) {  \
         return _mm256_loadu_epi8(m);                            \
     }                                                           \
                                                                 \
-    }                                                           \
-    static inline MVec simd128_loadu_epi##n(const void* m) {    \
+    static inline MVec16 simd128_loadu_epi##n(const void* m) {  \
         return _mm_loadu_epi8(m);                               \
     }
 #elif SIMD_LVL2
@@ -55,12 +55,45 @@
         return _mm256_set1_epi##n(a);               \
     }
 #elif SIMD_LVL1
+#   define _mm_set1_epi64_ _mm_set1_epi64x
+#   define _mm_set1_epi32_ _mm_set1_epi32
+#   define _mm_set1_epi16_ _mm_set1_epi16
+#   define _mm_set1_epi8_ _mm_set1_epi8
+#   define SIMD_SET1_EPI(n)                         \
+    static inline MVec simd_set1_epi##n(Int##n a) { \
+        return _mm_set1_epi##n##_(a);               \
+    }
+#elif SIMD_NEON
+#   define SIMD_SET1_EPI(n)                         \
+    static inline MVec simd_set1_epi##n(Int##n a) { \
+        return vreinterpretq_u8_s##n(vdupq_n_s##n(a)); \
+    }
+#else
 #   define SIMD_SET1_EPI(n)                         \
     static inline MVec simd_set1_epi##n(Int##n a) { \
-        return _mm_set1_epi##n(a);                  \
+        MVec v;                                     \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) { \
+            v.i##n[k] = a;                          \
+        }                                           \
+        return v;                                   \
     }
 #endif // SIMD_LVL3
 
+static inline MVec simd_setzero() {
+#if SIMD_LVL3
+    return _mm512_setzero_si512();
+#elif SIMD_LVL2
+    return _mm256_setzero_si256();
+#elif SIMD_LVL1
+    return _mm_setzero_si128();
+#elif SIMD_NEON
+    return vdupq_n_u8(0);
+#else
+    MVec v = {{0}};
+    return v;
+#endif
+}
+
 SIMD_SET1_EPI(8);
 SIMD_SET1_EPI(16);
 SIMD_SET1_EPI(32);
@@ -96,6 +129,18 @@ static inline MVec32 simd_loadu_si256(const void* m) {
 }
 #endif // SIMD_LVL2
 
+#if !SIMD_X86
+static inline MVec simd_loadu(const void* m) {
+#   if SIMD_NEON
+    return vld1q_u8((const Uint8*)m);
+#   else
+    MVec v;
+    memcpy(&v, m, sizeof(v));
+    return v;
+#   endif
+}
+#endif // !SIMD_X86
+
 #if SIMD_LVL3
 static inline MVec simd_loadu_si512(const void* m) {
     return _mm512_loadu_si512(m);
@@ -120,4 +165,238 @@ SIMD_LOADU_EPI(64);
 #undef SIMD_LOADU_EPI
 #endif // SIMD_LVL3
 
+static inline MVec simd_broadcast_si128(const void* m) {
+#if SIMD_LVL3
+    return _mm512_broadcast_i32x4(_mm_loadu_si128((const MVec16*)m));
+#elif SIMD_LVL2
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const MVec16*)m));
+#elif SIMD_LVL1
+    return _mm_loadu_si128((const MVec16*)m);
+#else
+    return simd_loadu(m);
+#endif
+}
+
+static inline void simd_storeu(void* m, MVec v) {
+#if SIMD_LVL3
+    _mm512_storeu_si512(m, v);
+#elif SIMD_LVL2
+    _mm256_storeu_si256((MVec32*)m, v);
+#elif SIMD_LVL1
+    _mm_storeu_si128((MVec16*)m, v);
+#elif SIMD_NEON
+    vst1q_u8((Uint8*)m, v);
+#else
+    memcpy(m, &v, sizeof(v));
+#endif
+}
+
+#if SIMD_LVL3
+static inline Size simd_compress_storeu_epi32(void* m, MMask mask, MVec v) {
+    _mm512_mask_compressstoreu_epi32(m, (__mmask16)mask, v);
+    return (Size)__builtin_popcountll(mask & 0xffff);
+}
+
+static inline Size simd_compress_storeu_epi64(void* m, MMask mask, MVec v) {
+    _mm512_mask_compressstoreu_epi64(m, (__mmask8)mask, v);
+    return (Size)__builtin_popcountll(mask & 0xff);
+}
+#elif SIMD_LVL2
+/**
+ * For each 8 bit lane mask, indices of selected lanes packed as nibbles,
+ * first selected lane in lowest nibble.
+ * */
+static const Uint32 simd_compress_epi32_lut[256] = {
+    0x00000000, 0x00000000, 0x00000001, 0x00000010, 0x00000002, 0x00000020, 0x00000021, 0x00000210,
+    0x00000003, 0x00000030, 0x00000031, 0x00000310, 0x00000032, 0x00000320, 0x00000321, 0x00003210,
+    0x00000004, 0x00000040, 0x00000041, 0x00000410, 0x00000042, 0x00000420, 0x00000421, 0x00004210,
+    0x00000043, 0x00000430, 0x00000431, 0x00004310, 0x00000432, 0x00004320, 0x00004321, 0x00043210,
+    0x00000005, 0x00000050, 0x00000051, 0x00000510, 0x00000052, 0x00000520, 0x00000521, 0x00005210,
+    0x00000053, 0x00000530, 0x00000531, 0x00005310, 0x00000532, 0x00005320, 0x00005321, 0x00053210,
+    0x00000054, 0x00000540, 0x00000541, 0x00005410, 0x00000542, 0x00005420, 0x00005421, 0x00054210,
+    0x00000543, 0x00005430, 0x00005431, 0x00054310, 0x00005432, 0x00054320, 0x00054321, 0x00543210,
+    0x00000006, 0x00000060, 0x00000061, 0x00000610, 0x00000062, 0x00000620, 0x00000621, 0x00006210,
+    0x00000063, 0x00000630, 0x00000631, 0x00006310, 0x00000632, 0x00006320, 0x00006321, 0x00063210,
+    0x00000064, 0x00000640, 0x00000641, 0x00006410, 0x00000642, 0x00006420, 0x00006421, 0x00064210,
+    0x00000643, 0x00006430, 0x00006431, 0x00064310, 0x00006432, 0x00064320, 0x00064321, 0x00643210,
+    0x00000065, 0x00000650, 0x00000651, 0x00006510, 0x00000652, 0x00006520, 0x00006521, 0x00065210,
+    0x00000653, 0x00006530, 0x00006531, 0x00065310, 0x00006532, 0x00065320, 0x00065321, 0x00653210,
+    0x00000654, 0x00006540, 0x00006541, 0x00065410, 0x00006542, 0x00065420, 0x00065421, 0x00654210,
+    0x00006543, 0x00065430, 0x00065431, 0x00654310, 0x00065432, 0x00654320, 0x00654321, 0x06543210,
+    0x00000007, 0x00000070, 0x00000071, 0x00000710, 0x00000072, 0x00000720, 0x00000721, 0x00007210,
+    0x00000073, 0x00000730, 0x00000731, 0x00007310, 0x00000732, 0x00007320, 0x00007321, 0x00073210,
+    0x00000074, 0x00000740, 0x00000741, 0x00007410, 0x00000742, 0x00007420, 0x00007421, 0x00074210,
+    0x00000743, 0x00007430, 0x00007431, 0x00074310, 0x00007432, 0x00074320, 0x00074321, 0x00743210,
+    0x00000075, 0x00000750, 0x00000751, 0x00007510, 0x00000752, 0x00007520, 0x00007521, 0x00075210,
+    0x00000753, 0x00007530, 0x00007531, 0x00075310, 0x00007532, 0x00075320, 0x00075321, 0x00753210,
+    0x00000754, 0x00007540, 0x00007541, 0x00075410, 0x00007542, 0x00075420, 0x00075421, 0x00754210,
+    0x00007543, 0x00075430, 0x00075431, 0x00754310, 0x00075432, 0x00754320, 0x00754321, 0x07543210,
+    0x00000076, 0x00000760, 0x00000761, 0x00007610, 0x00000762, 0x00007620, 0x00007621, 0x00076210,
+    0x00000763, 0x00007630, 0x00007631, 0x00076310, 0x00007632, 0x00076320, 0x00076321, 0x00763210,
+    0x00000764, 0x00007640, 0x00007641, 0x00076410, 0x00007642, 0x00076420, 0x00076421, 0x00764210,
+    0x00007643, 0x00076430, 0x00076431, 0x00764310, 0x00076432, 0x00764320, 0x00764321, 0x07643210,
+    0x00000765, 0x00007650, 0x00007651, 0x00076510, 0x00007652, 0x00076520, 0x00076521, 0x00765210,
+    0x00007653, 0x00076530, 0x00076531, 0x00765310, 0x00076532, 0x00765320, 0x00765321, 0x07653210,
+    0x00007654, 0x00076540, 0x00076541, 0x00765410, 0x00076542, 0x00765420, 0x00765421, 0x07654210,
+    0x00076543, 0x00765430, 0x00765431, 0x07654310, 0x00765432, 0x07654320, 0x07654321, 0x76543210,
+};
+
+static inline Size simd_compress_storeu_epi32(void* m, MMask mask, MVec v) {
+    mask &= 0xff;
+    MVec32 idx = _mm256_srlv_epi32(_mm256_set1_epi32((Int32)simd_compress_epi32_lut[mask]),
+                                   _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+    idx = _mm256_and_si256(idx, _mm256_set1_epi32(7));
+    _mm256_storeu_si256((MVec32*)m, _mm256_permutevar8x32_epi32(v, idx));
+    return (Size)__builtin_popcount(mask);
+}
+
+static inline Size simd_compress_storeu_epi64(void* m, MMask mask, MVec v) {
+    /* each 8 byte lane is a pair of 4 byte lanes */
+    mask &= 0xf;
+    MMask mask32 = ((mask & 1) * 3) | ((mask & 2) * 6) | ((mask & 4) * 12) | ((mask & 8) * 24);
+    return simd_compress_storeu_epi32(m, mask32, v) / 2;
+}
+#else
+/* only 2 or 4 lanes, so selected ones are copied one by one */
+#   define SIMD_COMPRESS_STOREU_EPI(n)                                          \
+    static inline Size simd_compress_storeu_epi##n(void* m, MMask mask, MVec v) { \
+        Int##n lanes[SIMD_LANES(Int##n)];                                       \
+        Size   count = 0;                                                       \
+        simd_storeu(lanes, v);                                                  \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                          \
+            if(mask & ((MMask)1 << k)) {                                        \
+                memcpy((Uint8*)m + count++ * sizeof(Int##n), lanes + k, sizeof(Int##n)); \
+            }                                                                   \
+        }                                                                       \
+        return count;                                                           \
+    }
+
+SIMD_COMPRESS_STOREU_EPI(32);
+SIMD_COMPRESS_STOREU_EPI(64);
+
+#   undef SIMD_COMPRESS_STOREU_EPI
+#endif // SIMD_LVL3
+
+#if SIMD_LVL3
+#   define SIMD_MASK_LOAD_STORE_EPI(n, mask_type)                                   \
+    static inline MVec simd_maskz_loadu_epi##n(const void* m, MMask mask) {         \
+        return _mm512_maskz_loadu_epi##n((mask_type)mask, m);                       \
+    }                                                                               \
+                                                                                    \
+    static inline void simd_mask_storeu_epi##n(void* m, MMask mask, MVec v) {       \
+        _mm512_mask_storeu_epi##n(m, (mask_type)mask, v);                           \
+    }
+
+SIMD_MASK_LOAD_STORE_EPI(32, __mmask16);
+SIMD_MASK_LOAD_STORE_EPI(64, __mmask8);
+#elif SIMD_LVL2
+/* lane bit masks are expanded to lanes with only sign bit set, as AVX2 masked loads want */
+#   define SIMD_MASK_LOAD_STORE_EPI(n, bits, lane_type)                             \
+    static inline MVec32 simd_mask_to_lanes_epi##n(MMask mask) {                    \
+        const MVec32 lane_bits = _mm256_setr_epi##n bits;                           \
+        return _mm256_cmpeq_epi##n(_mm256_and_si256(simd_set1_epi##n((Int##n)mask), lane_bits), lane_bits); \
+    }                                                                               \
+                                                                                    \
+    static inline MVec simd_maskz_loadu_epi##n(const void* m, MMask mask) {         \
+        return _mm256_maskload_epi##n((const lane_type*)m, simd_mask_to_lanes_epi##n(mask)); \
+    }                                                                               \
+                                                                                    \
+    static inline void simd_mask_storeu_epi##n(void* m, MMask mask, MVec v) {       \
+        _mm256_maskstore_epi##n((lane_type*)m, simd_mask_to_lanes_epi##n(mask), v); \
+    }
+
+#   define _mm256_setr_epi64 _mm256_setr_epi64x
+SIMD_MASK_LOAD_STORE_EPI(32, (1, 2, 4, 8, 16, 32, 64, 128), int);
+SIMD_MASK_LOAD_STORE_EPI(64, (1, 2, 4, 8), long long);
+#   undef _mm256_setr_epi64
+#elif SIMD_LVL1
+/* integer masked loads need AVX2, float ones of AVX move same bits */
+static inline MVec16 simd_mask_to_lanes_epi32(MMask mask) {
+    const MVec16 lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((Int32)mask), lane_bits), lane_bits);
+}
+
+static inline MVec16 simd_mask_to_lanes_epi64(MMask mask) {
+    const MVec16 lane_bits = _mm_set_epi64x(2, 1);
+    return _mm_cmpeq_epi64(_mm_and_si128(_mm_set1_epi64x((Int64)mask), lane_bits), lane_bits);
+}
+
+static inline MVec simd_maskz_loadu_epi32(const void* m, MMask mask) {
+    return _mm_castps_si128(_mm_maskload_ps((const Float32*)m, simd_mask_to_lanes_epi32(mask)));
+}
+
+static inline MVec simd_maskz_loadu_epi64(const void* m, MMask mask) {
+    return _mm_castpd_si128(_mm_maskload_pd((const Float64*)m, simd_mask_to_lanes_epi64(mask)));
+}
+
+static inline void simd_mask_storeu_epi32(void* m, MMask mask, MVec v) {
+    _mm_maskstore_ps((Float32*)m, simd_mask_to_lanes_epi32(mask), _mm_castsi128_ps(v));
+}
+
+static inline void simd_mask_storeu_epi64(void* m, MMask mask, MVec v) {
+    _mm_maskstore_pd((Float64*)m, simd_mask_to_lanes_epi64(mask), _mm_castsi128_pd(v));
+}
+#else
+/* NEON has no masked loads and stores either, so selected lanes are copied one by one */
+#   define SIMD_MASK_LOAD_STORE_EPI(n, mask_type)                                   \
+    static inline MVec simd_maskz_loadu_epi##n(const void* m, MMask mask) {         \
+        Int##n lanes[SIMD_LANES(Int##n)] = {0};                                     \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                              \
+            if(mask & ((MMask)1 << k)) {                                            \
+                memcpy(lanes + k, (const Uint8*)m + k * sizeof(Int##n), sizeof(Int##n)); \
+            }                                                                       \
+        }                                                                           \
+        return simd_loadu(lanes);                                                   \
+    }                                                                               \
+                                                                                    \
+    static inline void simd_mask_storeu_epi##n(void* m, MMask mask, MVec v) {       \
+        Int##n lanes[SIMD_LANES(Int##n)];                                           \
+        simd_storeu(lanes, v);                                                      \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                              \
+            if(mask & ((MMask)1 << k)) {                                            \
+                memcpy((Uint8*)m + k * sizeof(Int##n), lanes + k, sizeof(Int##n));  \
+            }                                                                       \
+        }                                                                           \
+    }
+
+SIMD_MASK_LOAD_STORE_EPI(32, MMask);
+SIMD_MASK_LOAD_STORE_EPI(64, MMask);
+#endif // SIMD_LVL3
+
+#undef SIMD_MASK_LOAD_STORE_EPI
+
+#if SIMD_LVL3
+static inline MVec simd_gather_epi32(const void* base, MVec idx) {
+    return _mm512_i32gather_epi32(idx, base, 4);
+}
+
+static inline MVec simd_gather_epi64(const void* base, MVec idx) {
+    return _mm512_i64gather_epi64(idx, base, 8);
+}
+#elif SIMD_LVL2
+static inline MVec simd_gather_epi32(const void* base, MVec idx) {
+    return _mm256_i32gather_epi32((const int*)base, idx, 4);
+}
+
+static inline MVec simd_gather_epi64(const void* base, MVec idx) {
+    return _mm256_i64gather_epi64((const long long*)base, idx, 8);
+}
+#else
+/* no gather instructions below AVX2, lanes are loaded one by one */
+#   define SIMD_GATHER_EPI(n)                                                       \
+    static inline MVec simd_gather_epi##n(const void* base, MVec idx) {             \
+        Int##n lanes[SIMD_LANES(Int##n)];                                           \
+        simd_storeu(lanes, idx);                                                    \
+        for(Size k = 0; k < SIMD_LANES(Int##n); k++) {                              \
+            memcpy(lanes + k, (const Uint8*)base + lanes[k] * (PtrDiff)sizeof(Int##n), sizeof(Int##n)); \
+        }                                                                           \
+        return simd_loadu(lanes);                                                   \
+    }
+
+SIMD_GATHER_EPI(32);
+SIMD_GATHER_EPI(64);
+
+#   undef SIMD_GATHER_EPI
+#endif // SIMD_LVL3
+
 #endif // ANVIE_SIMD_IMPLEMENTATION_LOAD_STORE_OPERATIONS_H
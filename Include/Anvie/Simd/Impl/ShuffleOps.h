@@ -0,0 +1,48 @@
+/**
+ * @file ShuffleOps.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation file for SIMD shuffle operations.
+ * */
+
+#ifndef ANVIE_SIMD_IMPLEMENTATIONS_SHUFFLE_OPERATIONS_H
+#define ANVIE_SIMD_IMPLEMENTATIONS_SHUFFLE_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+
+static inline MVec simd_shuffle_epi8(MVec table, MVec idx) {
+#if SIMD_LVL3
+    return _mm512_shuffle_epi8(table, idx);
+#elif SIMD_LVL2
+    return _mm256_shuffle_epi8(table, idx);
+#elif SIMD_LVL1
+    return _mm_shuffle_epi8(table, idx);
+#elif SIMD_NEON
+    /* table lookups give 0 for indices past table, so keeping sign bit zeroes same lanes as x86 does */
+    return vqtbl1q_u8(table, vandq_u8(idx, vdupq_n_u8(0x8f)));
+#else
+    MVec r;
+    for(Size k = 0; k < SIMD_LANES(Uint8); k++) {
+        r.u8[k] = idx.u8[k] & 0x80 ? 0 : table.u8[idx.u8[k] & 0x0f];
+    }
+    return r;
+#endif
+}
+
+#endif // ANVIE_SIMD_IMPLEMENTATIONS_SHUFFLE_OPERATIONS_H
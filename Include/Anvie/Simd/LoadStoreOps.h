@@ -26,8 +26,7 @@
 #include <Anvie/Types.h>
 #include <Anvie/Simd/Types.h>
 
-#if SIMD_ENABLED
-
+    static inline MVec simd_setzero();
     static inline MVec simd_set1_epi8(Int8 a);
     static inline MVec simd_set1_epi16(Int16 a);
     static inline MVec simd_set1_epi32(Int32 a);
@@ -47,48 +46,80 @@
 #   if SIMD_LVL3
         static inline MVec simd_loadu_si512(const void* m);
 
-        static inline MVec16 simd_load128_epi8(const void* m);
-        static inline MVec16 simd_load128_epi16(const void* m);
-        static inline MVec16 simd_load128_epi32(const void* m);
-        static inline MVec16 simd_load128_epi64(const void* m);
+        static inline MVec16 simd_loadu128_epi8(const void* m);
+        static inline MVec16 simd_loadu128_epi16(const void* m);
+        static inline MVec16 simd_loadu128_epi32(const void* m);
+        static inline MVec16 simd_loadu128_epi64(const void* m);
 
-        static inline MVec32 simd_load256_epi8(const void* m);
-        static inline MVec32 simd_load256_epi16(const void* m);
-        static inline MVec32 simd_load256_epi32(const void* m);
-        static inline MVec32 simd_load256_epi64(const void* m);
+        static inline MVec32 simd_loadu256_epi8(const void* m);
+        static inline MVec32 simd_loadu256_epi16(const void* m);
+        static inline MVec32 simd_loadu256_epi32(const void* m);
+        static inline MVec32 simd_loadu256_epi64(const void* m);
 
         // when SIMD_LVL3 is defined, MVec = MVec64
-        static inline MVec simd_load512_epi8(const void* m);
-        static inline MVec simd_load512_epi16(const void* m);
-        static inline MVec simd_load512_epi32(const void* m);
-        static inline MVec simd_load512_epi64(const void* m);
+        static inline MVec64 simd_loadu512_epi8(const void* m);
+        static inline MVec64 simd_loadu512_epi16(const void* m);
+        static inline MVec64 simd_loadu512_epi32(const void* m);
+        static inline MVec64 simd_loadu512_epi64(const void* m);
 
         static inline MVec simd_loadu_epi8(const void* m);
         static inline MVec simd_loadu_epi16(const void* m);
         static inline MVec simd_loadu_epi32(const void* m);
         static inline MVec simd_loadu_epi64(const void* m);
 
-        static inline MVec simd256_loadu_epi8(const void* m);
-        static inline MVec simd256_loadu_epi16(const void* m);
-        static inline MVec simd256_loadu_epi32(const void* m);
-        static inline MVec simd256_loadu_epi64(const void* m);
+        static inline MVec32 simd256_loadu_epi8(const void* m);
+        static inline MVec32 simd256_loadu_epi16(const void* m);
+        static inline MVec32 simd256_loadu_epi32(const void* m);
+        static inline MVec32 simd256_loadu_epi64(const void* m);
 
-        static inline MVec simd128_loadu_epi8(const void* m);
-        static inline MVec simd128_loadu_epi16(const void* m);
-        static inline MVec simd128_loadu_epi32(const void* m);
-        static inline MVec simd128_loadu_epi64(const void* m);
+        static inline MVec16 simd128_loadu_epi8(const void* m);
+        static inline MVec16 simd128_loadu_epi16(const void* m);
+        static inline MVec16 simd128_loadu_epi32(const void* m);
+        static inline MVec16 simd128_loadu_epi64(const void* m);
 #   endif // SIMD_LVL3
 
+    /* 16 bytes at @p m repeated in every 128 bit lane, eg: a table for simd_shuffle_epi8 */
+    static inline MVec simd_broadcast_si128(const void* m);
+
+    static inline void simd_storeu(void* m, MVec v);
+
+    /**
+     * Left pack lanes selected by @p mask and store them contiguously at @p m.
+     * Returns number of lanes stored. Whole register width may be written at @p m,
+     * so @p m must have space for a full register, unless AVX512 is enabled.
+     * */
+    static inline Size simd_compress_storeu_epi32(void* m, MMask mask, MVec v);
+    static inline Size simd_compress_storeu_epi64(void* m, MMask mask, MVec v);
+
+    /**
+     * Load or store only 4 or 8 byte lanes selected by @p mask, one bit per lane
+     * as from @c simd_cmpeq_epi32_mask. Memory of other lanes is never accessed,
+     * so these can load and store tails of arrays, and loaded lanes not selected
+     * are zero.
+     * */
+    static inline MVec simd_maskz_loadu_epi32(const void* m, MMask mask);
+    static inline MVec simd_maskz_loadu_epi64(const void* m, MMask mask);
+    static inline void simd_mask_storeu_epi32(void* m, MMask mask, MVec v);
+    static inline void simd_mask_storeu_epi64(void* m, MMask mask, MVec v);
+
+    /**
+     * Load each 4 (or 8) byte lane from @p base indexed by same lane of @p idx,
+     * ie: lane @c k is @c base[idx[k]]. Indices are signed, and element size
+     * is lane size.
+     * */
+    static inline MVec simd_gather_epi32(const void* base, MVec idx);
+    static inline MVec simd_gather_epi64(const void* base, MVec idx);
+
 #if SIMD_LVL3
 #   define simd_loadu simd_loadu_si512
 #elif SIMD_LVL2
 #   define simd_loadu simd_loadu_si256
 #elif SIMD_LVL1
 #   define simd_loadu simd_loadu_si128
+#else
+    static inline MVec simd_loadu(const void* m);
 #endif
 
 #include <Anvie/Simd/Impl/LoadStoreOps.h>
 
-#endif // SIMD_ENABLED
-
 #endif // ANVIE_SIMD_LOAD_STORE_OPERATIONS_H
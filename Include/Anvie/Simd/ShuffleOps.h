@@ -0,0 +1,42 @@
+/**
+ * @file ShuffleOps.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Defines generic SIMD (Single Instruction Multiple Data) wrappers over
+ * byte shuffles.
+ *
+ * This file only contains definions. The actual implementation of each function
+ * is in the Impl file.
+ * */
+
+#ifndef ANVIE_SIMD_SHUFFLE_OPERATIONS_H
+#define ANVIE_SIMD_SHUFFLE_OPERATIONS_H
+
+#include <Anvie/Types.h>
+#include <Anvie/Simd/Types.h>
+
+    /**
+     * Pick bytes of @p table using low 4 bits of each byte of @p idx, within each
+     * 128 bit lane. A byte of @p idx with it's highest bit set gives 0. With a table
+     * from @c simd_broadcast_si128 this is a 16 entry lookup of every byte at once.
+     * */
+    static inline MVec simd_shuffle_epi8(MVec table, MVec idx);
+
+#include <Anvie/Simd/Impl/ShuffleOps.h>
+
+#endif // ANVIE_SIMD_SHUFFLE_OPERATIONS_H
@@ -32,6 +32,10 @@
 
 #include <Anvie/Simd/Types.h>
 #include <Anvie/Simd/ComparisionOps.h>
+#include <Anvie/Simd/BitwiseOps.h>
+#include <Anvie/Simd/ArithmeticOps.h>
 #include <Anvie/Simd/LoadStoreOps.h>
+#include <Anvie/Simd/ShuffleOps.h>
+#include <Anvie/Simd/FloatOps.h>
 
 #endif // ANVIE_SIMD_SIMD_H
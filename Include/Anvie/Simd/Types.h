@@ -24,8 +24,14 @@
 #ifndef ANVIE_SIMD_TYPES_H
 #define ANVIE_SIMD_TYPES_H
 
-#include <emmintrin.h>
-#include <immintrin.h>
+#include <Anvie/Types.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <emmintrin.h>
+#   include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#   include <arm_neon.h>
+#endif
 
 /*
 ** Define basic type names first. Writing __mmXXX or __mmaskXX
@@ -59,6 +65,25 @@
 #   define SIMD_LVL3 0
 #endif // __AVX512__
 
+/*
+** NEON is always present on AArch64, and it's registers are 16 bytes, same as
+** with AVX. Lanes are kept as bytes, each wrapper reinterprets them as needed.
+** Masks are one bit per lane, same as on x86, and are emulated from vectors.
+*/
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    typedef uint8x16_t MVec16; /**< SIMD Vector register to store 16 bytes of data. */
+    typedef Uint16 MMask16;    /**< One bit per lane mask, emulated with horizontal adds. */
+#   define SIMD_NEON 1
+    /* identity reinterpret, so that wrappers can paste lane size in reinterpret names */
+#   define vreinterpretq_u8_u8(v) (v)
+#   pragma message "NEON EXTENSIONS ENABLED"
+#else
+#   define SIMD_NEON 0
+#endif // __ARM_NEON
+
+/* x86 levels share intrinsic families, so code using those checks this single macro */
+#define SIMD_X86 (SIMD_LVL1 || SIMD_LVL2 || SIMD_LVL3)
+
 /*
 ** Define standard name of vector registers. Below code will
 ** select the maximum possible size of register.
@@ -69,16 +94,55 @@
 #elif SIMD_LVL2
     typedef MVec32 MVec;
     typedef MMask32 MMask;
-#elif SIMD_LVL1
+#elif SIMD_LVL1 || SIMD_NEON
     typedef MVec16 MVec;
     typedef MMask16 MMask;
 #endif // SIMD_LVL1
 
+/*
+** Floating point registers are as wide as integer ones, so that a mask from
+** a float compare selects same lanes as from a 4 byte integer compare.
+*/
+#if SIMD_LVL3
+    typedef __m512 MVecF;
+#elif SIMD_LVL2
+    typedef __m256 MVecF;
+#elif SIMD_LVL1
+    typedef __m128 MVecF;
+#elif SIMD_NEON
+    typedef float32x4_t MVecF;
+#else
+/*
+** Without any SIMD level, wrappers still work, one lane at a time, on
+** registers emulated as 16 byte unions. Code choosing between SIMD and
+** plain loops should still check SIMD_ENABLED.
+*/
+    typedef union MVec {
+        Int8    i8[16];
+        Uint8   u8[16];
+        Int16   i16[8];
+        Uint16  u16[8];
+        Int32   i32[4];
+        Uint32  u32[4];
+        Int64   i64[2];
+        Uint64  u64[2];
+    } MVec;
+
+    typedef union MVecF {
+        Float32 f32[4];
+    } MVecF;
+
+    typedef Uint16 MMask;
+#endif // SIMD_LVL3
+
+/* number of lanes of @c MVec for given lane type */
+#define SIMD_LANES(type) (sizeof(MVec) / sizeof(type))
+
 /*
 ** Define a single macro to inform whether or not SIMD is enabled at all!
 ** This single macro is to replace checking for each level one by one again and again.
  */
-#if SIMD_LVL1 || SIMD_LVL2 || SIMD_LVL3
+#if SIMD_X86 || SIMD_NEON
 #   define SIMD_ENABLED 1
 #   define SIMD_VECTOR_REGISTER_SIZE sizeof(MVec)
 #   pragma message "SIMD IS ENABLED"
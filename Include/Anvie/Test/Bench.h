@@ -0,0 +1,127 @@
+/**
+ * @file Bench.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Helper functions and defines for micro benchmarks, written the same
+ * way as unit tests. Each benchmark case is run a few times to warm up, then
+ * sampled repeatedly, and median and percentiles of samples are reported.
+ *
+ * Take a look at benchmarks in Source/Bench for examples on how to use.
+ * */
+
+#ifndef ANVIE_UTILS_BENCH_H
+#define ANVIE_UTILS_BENCH_H
+
+#include <Anvie/Types.h>
+#include <Anvie/HelperDefines.h>
+
+/**
+ * State of one benchmark case, passed to all of it's callbacks.
+ * */
+typedef struct BenchState {
+    Size   size; /**< Problem size of case, eg: number of elements to insert. */
+    void*  data; /**< Anything setup prepares for run, and teardown destroys. */
+    Uint64 sink; /**< Fold results in here, so that compiler can't drop work. */
+} BenchState;
+
+/**
+ * All benchmark callbacks look like this
+ * */
+typedef void (*BenchCallbackFn)(BenchState* state);
+#define BENCH_FN static
+
+/**
+ * One benchmark case. Setup and teardown run before and after every sample,
+ * and are not timed.
+ * */
+typedef struct BenchCase {
+    ZString         name;
+    BenchCallbackFn setup;    /**< May be NULL. */
+    BenchCallbackFn run;      /**< Timed part of benchmark. */
+    BenchCallbackFn teardown; /**< May be NULL. */
+    Size            size;     /**< Number of elements processed by one run. */
+} BenchCase;
+
+/**
+ * Options for a benchmark run, parsed from command line.
+ * */
+typedef struct BenchConfig {
+    Size    warmup;  /**< Untimed runs of each case before sampling. */
+    Size    samples; /**< Timed runs of each case. */
+    ZString filter;  /**< Run only cases with this in their "suite/name", NULL for all. */
+    Bool    json;    /**< Print results as JSON instead of a table. */
+    Bool    perf;    /**< Also count instructions and misses with perf_event, where allowed. */
+    Size    printed; /**< Number of results printed so far. */
+} BenchConfig;
+
+Bool bench_config_from_args(BenchConfig* config, int argc, char** argv);
+void bench_begin(BenchConfig* config);
+void bench_end(BenchConfig* config);
+Size bench_run_suite(ZString suite, const BenchCase* cases, Size count, BenchConfig* config);
+
+// begin benchmarks recording
+#define BEGIN_BENCHES(name)                                 \
+    Size bench_##name##_suite(BenchConfig* config) {        \
+    static ZString bench_suite_name = #name;                \
+    static const BenchCase cases[] = {
+
+// end benchmarks recording
+#define END_BENCHES()                                                               \
+    };                                                                              \
+    return bench_run_suite(bench_suite_name, cases, sizeof(cases) / sizeof(cases[0]), config); \
+    }
+
+// record a benchmark case, without and with setup and teardown
+#define BENCH(run_fn, n) {.name = #run_fn, .setup = NULL, .run = run_fn, .teardown = NULL, .size = (n)}
+#define BENCH_WITH_SETUP(run_fn, setup_fn, teardown_fn, n) \
+    {.name = #run_fn, .setup = setup_fn, .run = run_fn, .teardown = teardown_fn, .size = (n)}
+
+#define BEGIN_BENCH_SUITES()                                \
+    int main(int argc, char** argv) {                       \
+    BenchConfig config;                                     \
+    if(!bench_config_from_args(&config, argc, argv)) {      \
+        return 1;                                           \
+    }                                                       \
+    bench_begin(&config);
+
+#define END_BENCH_SUITES()                      \
+    bench_end(&config);                         \
+    return 0;                                   \
+    }
+
+#define BENCH_SUITE(name) bench_##name##_suite(&config);
+
+#define IMPORT_BENCHES(name) Size bench_##name##_suite(BenchConfig* config);
+
+/**
+ * Make compiler believe @p value is used, without generating any code.
+ * */
+#define BENCH_KEEP(value) __asm__ volatile("" : : "g"(value) : "memory")
+
+/**
+ * Deterministic pseudo random numbers (splitmix64) for generating inputs,
+ * so that every run benchmarks same data.
+ * */
+static inline Uint64 bench_random(Uint64* state) {
+    Uint64 z = (*state += 0x9e3779b97f4a7c15);
+    z        = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z        = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+#endif // ANVIE_UTILS_BENCH_H
@@ -0,0 +1,87 @@
+/**
+ * @file ThreadPool.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief A work stealing thread pool, shared by parallel algorithms of the
+ * library.
+ *
+ * Each worker owns a Chase-Lev deque of tasks. A worker pushes and pops
+ * tasks at bottom of it's own deque, and when that runs empty, steals from
+ * top of deques of other workers. Tasks spawned from threads outside the
+ * pool go into a shared queue instead, that workers also take from. Idle
+ * workers sleep until new work is spawned.
+ *
+ * Work is spawned either into a @c TaskGroup, and joined with
+ * @c task_group_wait, or as a range with @c parallel_for. A thread waiting
+ * for a group runs pending tasks meanwhile, so tasks may spawn and wait for
+ * nested groups of their own without deadlocking the pool.
+ * */
+
+#ifndef ANVIE_THREAD_POOL_H
+#define ANVIE_THREAD_POOL_H
+
+#include <Anvie/Types.h>
+
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * Task callback, @p udata is the pointer given when task was spawned.
+ * */
+typedef void (*TaskCallback)(void* udata);
+
+/**
+ * Body of a @c parallel_for, called with a subrange [begin, end) of
+ * iteration space.
+ * */
+typedef void (*ParallelForCallback)(Size begin, Size end, void* udata);
+
+/**
+ * Creation options of a @c ThreadPool. A zero initialized config is valid
+ * and gives one worker per online CPU, with no affinity.
+ * */
+typedef struct ThreadPoolConfig {
+    Size thread_count; /**< Number of workers, 0 means number of online CPUs. */
+    Bool pin_threads;  /**< Pin worker i to CPU (first_cpu + i) modulo number of online CPUs. */
+    Size first_cpu;    /**< CPU of first worker, when pin_threads is set. */
+} ThreadPoolConfig;
+
+/**
+ * A set of tasks that can be waited for together. Initialize with
+ * @c task_group_init, before spawning anything into it. A group can be
+ * reused once it's been waited for.
+ * */
+typedef struct TaskGroup {
+    ThreadPool* pool;    /**< Pool tasks of this group run on. */
+    Size        pending; /**< Number of spawned tasks not yet completed. */
+} TaskGroup;
+
+ThreadPool* thread_pool_create(Size thread_count);
+ThreadPool* thread_pool_create_with_config(const ThreadPoolConfig* config);
+void        thread_pool_destroy(ThreadPool* pool);
+ThreadPool* thread_pool_default();
+Size        thread_pool_get_thread_count(ThreadPool* pool);
+Bool        thread_pool_set_affinity(ThreadPool* pool, Size worker, Size cpu);
+Size        thread_pool_current_worker();
+
+void        task_group_init(TaskGroup* group, ThreadPool* pool);
+void        task_group_spawn(TaskGroup* group, TaskCallback fn, void* udata);
+void        task_group_wait(TaskGroup* group);
+
+void        parallel_for(ThreadPool* pool, Size begin, Size end, Size grain, ParallelForCallback fn, void* udata);
+
+#endif // ANVIE_THREAD_POOL_H
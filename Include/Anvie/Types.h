@@ -45,9 +45,9 @@ typedef long Int64;
 #define INT8_MAX (127)
 #define INT16_MIN (-32768)
 #define INT16_MAX (32767)
-#define INT32_MIN (-2147483648)
+#define INT32_MIN (-INT32_MAX - 1)
 #define INT32_MAX (2147483647)
-#define INT64_MIN (-9223372036854775808LL)
+#define INT64_MIN (-INT64_MAX - 1)
 #define INT64_MAX (9223372036854775807LL)
 
 typedef Int64 PtrDiff;
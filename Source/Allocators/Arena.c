@@ -0,0 +1,352 @@
+/**
+ * @file Arena.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c Arena in Allocators/Arena.h
+ * */
+
+#include <Anvie/Allocators/Arena.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* align given value up to given power of two */
+#define ALIGN_UP(v, a) (((v) + ((a) - 1)) & ~((a) - 1))
+
+/* check whether given value is a power of two */
+#define IS_POW2(v) ((v) && !((v) & ((v) - 1)))
+
+/**
+ * Create a new chunk capable of storing at least @p capacity bytes.
+ * */
+static ArenaChunk* create_chunk(Size capacity) {
+    ArenaChunk* chunk = malloc(sizeof(ArenaChunk) + capacity);
+    ERR_RETURN_VALUE_IF_FAIL(chunk, NULL, ERR_OUT_OF_MEMORY);
+
+    chunk->next     = NULL;
+    chunk->capacity = capacity;
+    chunk->used     = 0;
+
+    return chunk;
+}
+
+/**
+ * Create a new arena.
+ *
+ * @param chunk_size Size of each chunk arena allocates from. If 0 then
+ * @c ARENA_DEFAULT_CHUNK_SIZE is used.
+ * @return Arena* on success.
+ * @return NULL otherwise.
+ * */
+Arena* arena_create(Size chunk_size) {
+    Arena* arena = NEW(Arena);
+    ERR_RETURN_VALUE_IF_FAIL(arena, NULL, ERR_OUT_OF_MEMORY);
+
+    arena->chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK_SIZE;
+    arena->first      = create_chunk(arena->chunk_size);
+    if(!arena->first) {
+        FREE(arena);
+        return NULL;
+    }
+    arena->current = arena->first;
+
+    return arena;
+}
+
+/**
+ * Destroy given arena. All memory allocated from arena
+ * becomes invalid.
+ *
+ * @param arena
+ * */
+void arena_destroy(Arena* arena) {
+    ERR_RETURN_IF_FAIL(arena, ERR_INVALID_ARGUMENTS);
+
+    ArenaChunk* chunk = arena->first;
+    while(chunk) {
+        ArenaChunk* next = chunk->next;
+        FREE(chunk);
+        chunk = next;
+    }
+
+    FREE(arena);
+}
+
+/**
+ * Allocate memory with given alignment from arena.
+ * Memory is not initialized.
+ *
+ * If current chunk cannot fit the allocation then next unused chunk
+ * is used if it's big enough, otherwise a new chunk is created.
+ *
+ * @param arena
+ * @param size Number of bytes to allocate.
+ * @param alignment Alignment of returned memory. Must be a power of two.
+ * @return Pointer to allocated memory on success.
+ * @return NULL otherwise.
+ * */
+void* arena_allocate_aligned(Arena* arena, Size size, Size alignment) {
+    ERR_RETURN_VALUE_IF_FAIL(arena && size && IS_POW2(alignment), NULL, ERR_INVALID_ARGUMENTS);
+
+    ArenaChunk* chunk = arena->current;
+    Uint64 addr  = (Uint64)(chunk->data + chunk->used);
+    Size   begin = chunk->used + (ALIGN_UP(addr, alignment) - addr);
+
+    /* fast path, fits in current chunk */
+    if(begin + size <= chunk->capacity) {
+        chunk->used = begin + size;
+        arena->stats.live_count++;
+        ALLOCATOR_STATS_RECORD_ALLOC(arena->stats, arena->stats.live_count);
+        return chunk->data + begin;
+    }
+
+    /* need extra space for alignment in worst case */
+    Size required = size + alignment - 1;
+
+    /* reuse next chunk if it's big enough, otherwise add a new one after current */
+    ArenaChunk* next = chunk->next;
+    if(!next || next->capacity < required) {
+        next = create_chunk(MAX(required, arena->chunk_size));
+        ERR_RETURN_VALUE_IF_FAIL(next, NULL, ERR_OUT_OF_MEMORY);
+        next->next  = chunk->next;
+        chunk->next = next;
+    }
+
+    next->used     = 0;
+    arena->current = next;
+
+    addr  = (Uint64)next->data;
+    begin = ALIGN_UP(addr, alignment) - addr;
+    next->used = begin + size;
+    arena->stats.live_count++;
+    ALLOCATOR_STATS_RECORD_ALLOC(arena->stats, arena->stats.live_count);
+    return next->data + begin;
+}
+
+/**
+ * Allocate memory from arena with @c ARENA_DEFAULT_ALIGNMENT.
+ * Memory is not initialized.
+ *
+ * @param arena
+ * @param size Number of bytes to allocate.
+ * @return Pointer to allocated memory on success.
+ * @return NULL otherwise.
+ * */
+void* arena_allocate(Arena* arena, Size size) {
+    return arena_allocate_aligned(arena, size, ARENA_DEFAULT_ALIGNMENT);
+}
+
+/**
+ * Allocate zero initialized memory from arena with
+ * @c ARENA_DEFAULT_ALIGNMENT. This is like @c calloc.
+ *
+ * @param arena
+ * @param size Number of bytes to allocate.
+ * @return Pointer to allocated memory on success.
+ * @return NULL otherwise.
+ * */
+void* arena_allocate_zeroed(Arena* arena, Size size) {
+    void* mem = arena_allocate_aligned(arena, size, ARENA_DEFAULT_ALIGNMENT);
+    if(mem) memset(mem, 0, size);
+    return mem;
+}
+
+/**
+ * Resize an allocation made from arena.
+ * If @p ptr is the most recent allocation and current chunk has space,
+ * then it's grown in place, otherwise a new allocation is made and old
+ * contents are copied to it. Old memory is not released until arena
+ * is reset or restored.
+ *
+ * @param arena
+ * @param ptr Previous allocation. Can be @c NULL.
+ * @param old_size Size of previous allocation.
+ * @param new_size New size of allocation.
+ * @return Pointer to resized memory on success.
+ * @return NULL otherwise.
+ * */
+void* arena_reallocate(Arena* arena, void* ptr, Size old_size, Size new_size) {
+    ERR_RETURN_VALUE_IF_FAIL(arena && new_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    if(!ptr) return arena_allocate(arena, new_size);
+    if(new_size <= old_size) return ptr;
+
+    /* grow in place if this was last allocation */
+    ArenaChunk* chunk = arena->current;
+    if((Uint8*)ptr + old_size == chunk->data + chunk->used &&
+       (Size)((Uint8*)ptr - chunk->data) + new_size <= chunk->capacity) {
+        chunk->used += new_size - old_size;
+        return ptr;
+    }
+
+    void* mem = arena_allocate(arena, new_size);
+    if(mem) memcpy(mem, ptr, old_size);
+    return mem;
+}
+
+/**
+ * Save current state of arena. This is a constant time operation.
+ *
+ * @param arena
+ * @return ArenaMarker to be used with @c arena_restore.
+ * */
+ArenaMarker arena_save(Arena* arena) {
+    ArenaMarker marker = {0};
+    ERR_RETURN_VALUE_IF_FAIL(arena, marker, ERR_INVALID_ARGUMENTS);
+
+    marker.chunk      = arena->current;
+    marker.used       = arena->current->used;
+    marker.live_count = arena->stats.live_count;
+    return marker;
+}
+
+/**
+ * Restore arena to a previously saved state. All allocations made
+ * after marker was saved become invalid. Chunks are kept for reuse,
+ * so this is a constant time operation.
+ *
+ * Restoring to a marker saved before a later restore or reset is
+ * undefined behaviour.
+ *
+ * @param arena
+ * @param marker Marker returned by @c arena_save.
+ * */
+void arena_restore(Arena* arena, ArenaMarker marker) {
+    ERR_RETURN_IF_FAIL(arena && marker.chunk, ERR_INVALID_ARGUMENTS);
+
+    arena->current       = marker.chunk;
+    arena->current->used = marker.used;
+
+    /* everything allocated after marker counts as freed */
+    arena->stats.total_frees += arena->stats.live_count - marker.live_count;
+    arena->stats.live_count   = marker.live_count;
+}
+
+/**
+ * Release all allocations made from arena in constant time.
+ * Chunks are kept for reuse.
+ *
+ * @param arena
+ * */
+void arena_reset(Arena* arena) {
+    ERR_RETURN_IF_FAIL(arena, ERR_INVALID_ARGUMENTS);
+
+    arena->current       = arena->first;
+    arena->current->used = 0;
+
+    arena->stats.total_frees += arena->stats.live_count;
+    arena->stats.live_count   = 0;
+}
+
+/**
+ * Get total number of bytes allocated from arena, including
+ * alignment padding and unused tails of filled chunks.
+ * This is linear in number of chunks in use.
+ *
+ * @param arena
+ * */
+Size arena_get_used_size(Arena* arena) {
+    ERR_RETURN_VALUE_IF_FAIL(arena, 0, ERR_INVALID_ARGUMENTS);
+
+    Size used = 0;
+    for(ArenaChunk* chunk = arena->first; chunk != arena->current; chunk = chunk->next) {
+        used += chunk->capacity;
+    }
+
+    return used + arena->current->used;
+}
+
+/**
+ * Get total number of bytes reserved by arena in all of it's chunks.
+ * This is linear in number of chunks.
+ *
+ * @param arena
+ * */
+Size arena_get_reserved_size(Arena* arena) {
+    ERR_RETURN_VALUE_IF_FAIL(arena, 0, ERR_INVALID_ARGUMENTS);
+
+    Size reserved = 0;
+    for(ArenaChunk* chunk = arena->first; chunk; chunk = chunk->next) {
+        reserved += chunk->capacity;
+    }
+
+    return reserved;
+}
+
+/**
+ * Get a snapshot of statistics of given arena.
+ * This is linear in number of chunks.
+ *
+ * Live allocations are the ones made since last reset or restore. Frees
+ * count allocations released by reset and restore. Used bytes include
+ * alignment padding. Fragmentation is fraction of used bytes that are
+ * unusable tails of chunks filled before current chunk.
+ *
+ * @param arena
+ * */
+AllocatorStats arena_get_stats(Arena* arena) {
+    AllocatorStats stats = {0};
+    ERR_RETURN_VALUE_IF_FAIL(arena, stats, ERR_INVALID_ARGUMENTS);
+
+    stats = arena->stats;
+
+    Size wasted = 0;
+    Bool in_use = True;
+    for(ArenaChunk* chunk = arena->first; chunk; chunk = chunk->next) {
+        stats.chunk_count++;
+        stats.reserved_bytes += chunk->capacity;
+
+        if(in_use) {
+            stats.used_bytes += chunk == arena->current ? chunk->used : chunk->capacity;
+            if(chunk != arena->current) wasted += chunk->capacity - chunk->used;
+            else in_use = False;
+        }
+    }
+
+    stats.fragmentation = stats.used_bytes ? (Float32)wasted / (Float32)stats.used_bytes : 0.f;
+    ALLOCATOR_STATS_FINALIZE(stats);
+
+    return stats;
+}
+
+/* adapters to plug an arena into generic allocator interface */
+static void* arena_allocator_allocate(Size size, void* ctx) {
+    return arena_allocate((Arena*)ctx, size);
+}
+
+static void* arena_allocator_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    return arena_reallocate((Arena*)ctx, ptr, old_size, new_size);
+}
+
+/**
+ * Get an @c Allocator that allocates from given arena.
+ * Containers created with this allocator never free individual
+ * allocations, all their memory is released on arena reset or destroy.
+ *
+ * @param arena
+ * */
+Allocator arena_get_allocator(Arena* arena) {
+    Allocator allocator = {
+        .allocate   = arena_allocator_allocate,
+        .reallocate = arena_allocator_reallocate,
+        .free       = NULL,
+        .ctx        = arena
+    };
+
+    return allocator;
+}
@@ -0,0 +1,294 @@
+/**
+ * @file ConcurrentBlockAllocator.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c ConcurrentBlockAllocator in
+ * Allocators/ConcurrentBlockAllocator.h
+ * */
+
+#include <Anvie/Allocators/ConcurrentBlockAllocator.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+
+#define MAGAZINE_SIZE CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE
+
+/* number of blocks moved between magazine and depot at once */
+#define BATCH_SIZE (MAGAZINE_SIZE / 2)
+
+/**
+ * Per thread cache of free blocks. Each thread that uses a
+ * @c ConcurrentBlockAllocator gets one magazine for that allocator.
+ * Magazines are also kept in a doubly linked list inside
+ * the allocator so that they can be freed on destroy.
+ * */
+struct BlockMagazine {
+    ConcurrentBlockAllocator* owner;
+    BlockMagazine*            prev;
+    BlockMagazine*            next;
+    Size                      count;
+    Size                      allocs; /* written only by owner thread, read by stats */
+    Size                      frees;  /* written only by owner thread, read by stats */
+    MemBlock                  blocks[MAGAZINE_SIZE];
+};
+
+/* counters of a magazine written by it's owner and read by any thread */
+#define COUNTER_INC(c) __atomic_store_n(&(c), __atomic_load_n(&(c), __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED)
+#define COUNTER_GET(c) __atomic_load_n(&(c), __ATOMIC_RELAXED)
+
+/**
+ * Return @p n blocks from top of magazine to depot.
+ * Must be called with lock held.
+ * */
+static void drain_magazine(BlockMagazine* mag, Size n) {
+    while(n-- && mag->count) {
+        lballoc_free(mag->owner->depot, mag->blocks[--mag->count]);
+    }
+}
+
+/**
+ * Called on exit of a thread that had a magazine.
+ * All cached blocks are returned to depot.
+ * */
+static void destroy_magazine(void* arg) {
+    BlockMagazine* mag = (BlockMagazine*)arg;
+    ConcurrentBlockAllocator* cba = mag->owner;
+
+    pthread_mutex_lock(&cba->lock);
+    drain_magazine(mag, mag->count);
+    cba->retired_allocs += mag->allocs;
+    cba->retired_frees  += mag->frees;
+    if(mag->prev) mag->prev->next = mag->next;
+    else cba->magazines = mag->next;
+    if(mag->next) mag->next->prev = mag->prev;
+    pthread_mutex_unlock(&cba->lock);
+
+    FREE(mag);
+}
+
+/**
+ * Get magazine of calling thread, creating one if required.
+ * */
+static BlockMagazine* get_magazine(ConcurrentBlockAllocator* cba) {
+    BlockMagazine* mag = pthread_getspecific(cba->magazine_key);
+    if(mag) return mag;
+
+    mag = NEW(BlockMagazine);
+    ERR_RETURN_VALUE_IF_FAIL(mag, NULL, ERR_OUT_OF_MEMORY);
+    mag->owner = cba;
+
+    pthread_mutex_lock(&cba->lock);
+    mag->next = cba->magazines;
+    if(cba->magazines) cba->magazines->prev = mag;
+    cba->magazines = mag;
+    pthread_mutex_unlock(&cba->lock);
+
+    if(pthread_setspecific(cba->magazine_key, mag)) {
+        destroy_magazine(mag);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
+        return NULL;
+    }
+
+    return mag;
+}
+
+/**
+ * Create a new thread safe block allocator to allocate
+ * fixed memory blocks of given size.
+ *
+ * @param block_size Size of each block to be allocated.
+ * @return ConcurrentBlockAllocator* A valid object on success.
+ * @return NULL on failure.
+ * */
+ConcurrentBlockAllocator* cballoc_create(Size block_size) {
+    ERR_RETURN_VALUE_IF_FAIL(block_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    ConcurrentBlockAllocator* cba = NEW(ConcurrentBlockAllocator);
+    ERR_RETURN_VALUE_IF_FAIL(cba, NULL, ERR_OUT_OF_MEMORY);
+
+    cba->depot = lballoc_create(block_size);
+    if(!cba->depot) {
+        FREE(cba);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&cba->lock, NULL)) {
+        goto HELL;
+    }
+
+    if(pthread_key_create(&cba->magazine_key, destroy_magazine)) {
+        pthread_mutex_destroy(&cba->lock);
+        goto HELL;
+    }
+
+    return cba;
+
+HELL:
+    lballoc_destroy(cba->depot);
+    FREE(cba);
+    ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
+    return NULL;
+}
+
+/**
+ * Destroy given allocator. All blocks allocated from it become
+ * invalid, including the ones cached by other threads.
+ * No other thread must be using this allocator when this is called.
+ *
+ * @param cba
+ * */
+void cballoc_destroy(ConcurrentBlockAllocator* cba) {
+    ERR_RETURN_IF_FAIL(cba, ERR_INVALID_ARGUMENTS);
+
+    /* no thread exit destructor will run after this */
+    pthread_key_delete(cba->magazine_key);
+
+    /* blocks in magazines belong to depot, so just free magazines */
+    BlockMagazine* mag = cba->magazines;
+    while(mag) {
+        BlockMagazine* next = mag->next;
+        FREE(mag);
+        mag = next;
+    }
+    cba->magazines = NULL;
+
+    lballoc_destroy(cba->depot);
+    cba->depot = NULL;
+
+    pthread_mutex_destroy(&cba->lock);
+    FREE(cba);
+}
+
+/**
+ * Allocate a new block. This is lock free when calling thread's
+ * magazine has a cached block, otherwise a batch of blocks is first
+ * taken from shared depot under lock.
+ *
+ * @param cba
+ * @return MemBlock A pointer/reference to allocated memory on success.
+ * @return INVALID_MEM_BLOCK otherwise.
+ * */
+MemBlock cballoc_allocate(ConcurrentBlockAllocator* cba) {
+    ERR_RETURN_VALUE_IF_FAIL(cba, INVALID_MEM_BLOCK, ERR_INVALID_ARGUMENTS);
+
+    BlockMagazine* mag = get_magazine(cba);
+    ERR_RETURN_VALUE_IF_FAIL(mag, INVALID_MEM_BLOCK, ERR_OPERATION_FAILED);
+
+    /* refill from depot */
+    if(!mag->count) {
+        pthread_mutex_lock(&cba->lock);
+        while(mag->count < BATCH_SIZE) {
+            MemBlock blk = lballoc_allocate(cba->depot);
+            if(!blk) break;
+            mag->blocks[mag->count++] = blk;
+        }
+        pthread_mutex_unlock(&cba->lock);
+
+        ERR_RETURN_VALUE_IF_FAIL(mag->count, INVALID_MEM_BLOCK, ERR_OUT_OF_MEMORY);
+    }
+
+    COUNTER_INC(mag->allocs);
+    return mag->blocks[--mag->count];
+}
+
+/**
+ * Free given block. Block can be freed from any thread, not
+ * only the thread that allocated it. This is lock free unless
+ * calling thread's magazine is full, in which case half of it is
+ * returned to shared depot under lock.
+ *
+ * Unlike @c lballoc_free, double frees are not detected here,
+ * because cached blocks are not tracked by depot.
+ *
+ * @param cba
+ * @param blk
+ * */
+void cballoc_free(ConcurrentBlockAllocator* cba, MemBlock blk) {
+    ERR_RETURN_IF_FAIL(cba && blk, ERR_INVALID_ARGUMENTS);
+
+    BlockMagazine* mag = get_magazine(cba);
+    if(!mag) {
+        /* can't cache, return directly to depot */
+        pthread_mutex_lock(&cba->lock);
+        lballoc_free(cba->depot, blk);
+        pthread_mutex_unlock(&cba->lock);
+        return;
+    }
+
+    /* drain to depot */
+    if(mag->count == MAGAZINE_SIZE) {
+        pthread_mutex_lock(&cba->lock);
+        drain_magazine(mag, BATCH_SIZE);
+        pthread_mutex_unlock(&cba->lock);
+    }
+
+    mag->blocks[mag->count++] = blk;
+    COUNTER_INC(mag->frees);
+}
+
+/**
+ * Return all blocks cached by calling thread back to shared depot.
+ * Useful before a thread goes idle for a long time.
+ *
+ * @param cba
+ * */
+void cballoc_flush(ConcurrentBlockAllocator* cba) {
+    ERR_RETURN_IF_FAIL(cba, ERR_INVALID_ARGUMENTS);
+
+    BlockMagazine* mag = pthread_getspecific(cba->magazine_key);
+    if(!mag || !mag->count) return;
+
+    pthread_mutex_lock(&cba->lock);
+    drain_magazine(mag, mag->count);
+    pthread_mutex_unlock(&cba->lock);
+}
+
+/**
+ * Get a snapshot of statistics of given allocator.
+ * Takes the lock, and is linear in number of threads using the allocator.
+ *
+ * Allocation and free counts are exact user level counts. Live count is
+ * their difference, so it may be momentarily off while other threads
+ * are allocating. Peak, column and fragmentation values are of shared depot,
+ * where blocks cached in magazines count as allocated.
+ *
+ * @param cba
+ * */
+AllocatorStats cballoc_get_stats(ConcurrentBlockAllocator* cba) {
+    AllocatorStats stats = {0};
+    ERR_RETURN_VALUE_IF_FAIL(cba, stats, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock(&cba->lock);
+    stats = lballoc_get_stats(cba->depot);
+
+    Size allocs = cba->retired_allocs;
+    Size frees  = cba->retired_frees;
+    for(BlockMagazine* mag = cba->magazines; mag; mag = mag->next) {
+        allocs += COUNTER_GET(mag->allocs);
+        frees  += COUNTER_GET(mag->frees);
+    }
+    pthread_mutex_unlock(&cba->lock);
+
+    stats.total_allocs = allocs;
+    stats.total_frees  = frees;
+    stats.live_count   = allocs > frees ? allocs - frees : 0;
+    stats.used_bytes   = stats.live_count * cba->depot->block_size;
+    ALLOCATOR_STATS_FINALIZE(stats);
+
+    return stats;
+}
@@ -0,0 +1,311 @@
+/**
+ * @file ExpBlockAllocator.c
+ * @date Wed, 20th December, 2023
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c ExpBlockAllocator in Allocators/BlockAllocator.h
+ * */
+
+#include <Anvie/Allocators/BlockAllocator.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/**
+ * The implementation keeps all memory blocks in a single contiguous array.
+ * Each time the allocator runs out of blocks, the array is reallocated to
+ * twice it's size. Occupancy of each block is tracked by a @c BitVector,
+ * with one bit per block.
+ *
+ *        | 0 | 1 | 2 | 3 | ... | n-1 | n | n+1 | ... | 2n-1 |
+ *        \_________________________/ \_____________________/
+ *              before growth            added by growth
+ *
+ * Because of contiguity, visiting all live blocks is a linear sweep, and
+ * converting a block to it's index (or vice versa) is a single division
+ * (or multiplication).
+ * */
+
+/* get pointer to block at given index */
+#define BLOCK_AT(eba, i) ((eba)->block_array + ((i) * (eba)->block_size))
+
+/**
+ * Create a new exponential block allocator to allocate
+ * fixed memory blocks of given size.
+ *
+ * @param block_size Size of each block to be allocated.
+ * @return ExpBlockAllocator* A valid object on success.
+ * @return NULL on failure.
+ * */
+ExpBlockAllocator* eballoc_create(Size block_size) {
+    ERR_RETURN_VALUE_IF_FAIL(block_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    ExpBlockAllocator* eba = NEW(ExpBlockAllocator);
+    ERR_RETURN_VALUE_IF_FAIL(eba, NULL, ERR_OUT_OF_MEMORY);
+
+    /* bitvector to store allocation status */
+    eba->occupancy = bitvec_create();
+    GOTO_LABEL_IF_FAIL(eba->occupancy, HELL, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+    bitvec_reserve(eba->occupancy, EXP_BLOCK_ALLOCATOR_INITIAL_CAPACITY);
+
+    eba->block_array = ALLOCATE(Uint8, EXP_BLOCK_ALLOCATOR_INITIAL_CAPACITY * block_size);
+    GOTO_LABEL_IF_FAIL(eba->block_array, HELL, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+
+    eba->block_size       = block_size;
+    eba->total_capacity   = EXP_BLOCK_ALLOCATOR_INITIAL_CAPACITY;
+    eba->allocation_count = 0;
+    eba->last_freed_block = 0; /* first block is always free after creation */
+
+    return eba;
+
+HELL:
+    eballoc_destroy(eba);
+    return NULL;
+}
+
+/**
+ * Destroy given exponential block allocator.
+ * All blocks allocated from this allocator become invalid.
+ *
+ * @param eba
+ * */
+void eballoc_destroy(ExpBlockAllocator* eba) {
+    ERR_RETURN_IF_FAIL(eba, ERR_INVALID_ARGUMENTS);
+
+    if(eba->occupancy) {
+        bitvec_destroy(eba->occupancy);
+        eba->occupancy = NULL;
+    }
+
+    if(eba->block_array) {
+        FREE(eba->block_array);
+        eba->block_array = NULL;
+    }
+
+    FREE(eba);
+}
+
+/**
+ * Reserve space for at least given number of blocks.
+ * Capacity is doubled until it can store @p num_blocks.
+ * Nothing happens if allocator can already store that many blocks.
+ *
+ * Growth may move the block array, invalidating all previously
+ * returned @c MemBlock references. Indices stay valid.
+ *
+ * @param eba
+ * @param num_blocks Number of blocks to reserve memory for.
+ * */
+void eballoc_reserve(ExpBlockAllocator* eba, Size num_blocks) {
+    ERR_RETURN_IF_FAIL(eba && num_blocks, ERR_INVALID_ARGUMENTS);
+
+    if(num_blocks <= eba->total_capacity) {
+        return;
+    }
+
+    Size newcap = eba->total_capacity;
+    while(newcap < num_blocks) newcap *= 2;
+
+    MemBlockArray tmp = realloc(eba->block_array, newcap * eba->block_size);
+    ERR_RETURN_IF_FAIL(tmp, ERR_OUT_OF_MEMORY);
+
+    /* keep new blocks zeroed, just like fresh allocation */
+    memset(tmp + eba->total_capacity * eba->block_size, 0,
+           (newcap - eba->total_capacity) * eba->block_size);
+
+    bitvec_reserve(eba->occupancy, newcap);
+
+    eba->block_array    = tmp;
+    eba->total_capacity = newcap;
+}
+
+/**
+ * Allocate a new block.
+ * If there's a known free block (the last freed one, or the one
+ * after last allocated one) then allocation is constant time, otherwise
+ * occupancy is scanned one word (64 blocks) at a time.
+ * When allocator is full, it's capacity is doubled.
+ *
+ * @param eba
+ * @return MemBlock A pointer/reference to allocated memory on success.
+ * @return INVALID_MEM_BLOCK otherwise.
+ * */
+MemBlock eballoc_allocate(ExpBlockAllocator* eba) {
+    ERR_RETURN_VALUE_IF_FAIL(eba, INVALID_MEM_BLOCK, ERR_INVALID_ARGUMENTS);
+
+    Size index = eba->last_freed_block;
+
+    /* no block known to be free, find one */
+    if(index >= eba->total_capacity || bitvec_peek_unchecked(eba->occupancy, index)) {
+        if(eba->allocation_count < eba->total_capacity) {
+            /* there's a hole somewhere, blocks past length of occupancy were never used */
+            index = bitvec_find_first_clear(eba->occupancy);
+            if(index == SIZE_MAX) {
+                index = bitvec_length(eba->occupancy);
+            }
+
+            /* each word scanned is a search step */
+            eba->stats.search_steps += index / 64 + 1;
+        } else {
+            /* full, first block after growth is free */
+            index = eba->total_capacity;
+            eballoc_reserve(eba, eba->total_capacity + 1);
+            ERR_RETURN_VALUE_IF_FAIL(index < eba->total_capacity, INVALID_MEM_BLOCK, ERR_OUT_OF_MEMORY);
+        }
+    }
+
+    bitvec_set(eba->occupancy, index);
+    eba->allocation_count++;
+    eba->high_water_block = MAX(eba->high_water_block, index + 1);
+    ALLOCATOR_STATS_RECORD_ALLOC(eba->stats, eba->allocation_count);
+
+    /* block just after this one is a good guess for next allocation */
+    eba->last_freed_block = index + 1;
+
+    return BLOCK_AT(eba, index);
+}
+
+/**
+ * Free provided @c MemBlock. User must set all previous
+ * references to this @c MemBlock to @c INVALID_MEM_BLOCK
+ * after calling this free. This is just like what you do
+ * when using @c FREE.
+ *
+ * This is a constant time operation.
+ *
+ * @param eba
+ * @param blk
+ * */
+void eballoc_free(ExpBlockAllocator* eba, MemBlock blk) {
+    ERR_RETURN_IF_FAIL(eba && blk, ERR_INVALID_ARGUMENTS);
+
+    Size index = eballoc_get_block_index(eba, blk);
+    RETURN_IF_FAIL(index != SIZE_MAX, COLOR_RED "INVALID FREE" COLOR_RESET " : Provided MemBlock not allocated from provided ExpBlockAllocator\n");
+
+    /* no need to abort the program and be dramatic about it, since a debug warning should suffice */
+    RETURN_IF_FAIL(bitvec_peek_unchecked(eba->occupancy, index), COLOR_RED "DOUBLE FREE" COLOR_RESET " : from ExpBlockAllocator\n");
+    bitvec_clear(eba->occupancy, index);
+
+    eba->allocation_count--;
+    eba->last_freed_block = index;
+    ALLOCATOR_STATS_RECORD_FREE(eba->stats);
+}
+
+/**
+ * Get a value between 0 and 1 representing load on the
+ * exponential block allocator. The value is total number of allocated
+ * blocks divided by total number of blocks that can be allocated
+ * without growth.
+ *
+ * @param eba
+ * */
+Float32 eballoc_get_load(ExpBlockAllocator* eba) {
+    ERR_RETURN_VALUE_IF_FAIL(eba, 0.f, ERR_INVALID_ARGUMENTS);
+    return (Float32)eba->allocation_count/(Float32)eba->total_capacity;
+}
+
+/**
+ * Visit each allocated block in given exponential block allocator.
+ * Blocks are visited in increasing order of their indices, which is
+ * also increasing order of their addresses.
+ *
+ * The visitor must not allocate from this allocator, because that
+ * may move the block array. Freeing the visited block is allowed.
+ *
+ * @param eba
+ * @param visitor Callback to be called for each allocated block.
+ * @param udata User data to be passed to @p visitor.
+ * */
+void eballoc_foreach(ExpBlockAllocator* eba, MemBlockVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(eba && visitor, ERR_INVALID_ARGUMENTS);
+
+    /* occupancy never has bits set past total capacity */
+    for(Size index = bitvec_find_first_set(eba->occupancy); index != SIZE_MAX;
+        index = bitvec_find_next_set(eba->occupancy, index + 1)) {
+        visitor(BLOCK_AT(eba, index), index, udata);
+    }
+}
+
+/**
+ * Get index of given block inside the allocator.
+ * Unlike a @c MemBlock, an index remains valid after allocator grows.
+ *
+ * @param eba
+ * @param blk
+ * @return Index of block on success.
+ * @return SIZE_MAX if block does not belong to given allocator.
+ * */
+Size eballoc_get_block_index(ExpBlockAllocator* eba, MemBlock blk) {
+    ERR_RETURN_VALUE_IF_FAIL(eba && blk, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    if(blk < eba->block_array || blk >= BLOCK_AT(eba, eba->total_capacity)) {
+        return SIZE_MAX;
+    }
+
+    Size offset = blk - eba->block_array;
+    if(offset % eba->block_size) {
+        return SIZE_MAX;
+    }
+
+    return offset / eba->block_size;
+}
+
+/**
+ * Get block at given index.
+ *
+ * @param eba
+ * @param index Index of block, usually obtained from @c eballoc_get_block_index.
+ * @return MemBlock on success.
+ * @return INVALID_MEM_BLOCK if index is out of range or block is not allocated.
+ * */
+MemBlock eballoc_get_block(ExpBlockAllocator* eba, Size index) {
+    ERR_RETURN_VALUE_IF_FAIL(eba, INVALID_MEM_BLOCK, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(index < eba->total_capacity, INVALID_MEM_BLOCK, ERR_INVALID_INDEX);
+
+    if(!bitvec_peek_unchecked(eba->occupancy, index)) {
+        return INVALID_MEM_BLOCK;
+    }
+
+    return BLOCK_AT(eba, index);
+}
+
+/**
+ * Get a snapshot of statistics of given exponential block allocator.
+ * This is constant time.
+ *
+ * Search steps count bytes skipped and bits tested when scanning occupancy
+ * for a hole, which only happens when last freed block hint is invalid.
+ * Fragmentation is fraction of blocks below highest allocated index that
+ * are free now.
+ *
+ * @param eba
+ * */
+AllocatorStats eballoc_get_stats(ExpBlockAllocator* eba) {
+    AllocatorStats stats = {0};
+    ERR_RETURN_VALUE_IF_FAIL(eba, stats, ERR_INVALID_ARGUMENTS);
+
+    stats                = eba->stats;
+    stats.live_count     = eba->allocation_count;
+    stats.chunk_count    = 1;
+    stats.reserved_bytes = eba->total_capacity * eba->block_size;
+    stats.used_bytes     = eba->allocation_count * eba->block_size;
+    stats.fragmentation  = eba->high_water_block ?
+        (Float32)(eba->high_water_block - eba->allocation_count) / (Float32)eba->high_water_block : 0.f;
+    ALLOCATOR_STATS_FINALIZE(stats);
+
+    return stats;
+}
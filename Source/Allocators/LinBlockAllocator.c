@@ -23,6 +23,8 @@
 #include <Anvie/Allocators/BlockAllocator.h>
 #include <Anvie/HelperDefines.h>
 #include <Anvie/Error.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <string.h>
 
 /**
@@ -57,43 +59,248 @@
  *
  *  In the above diagram, each column represents a memory block array. The indices
  *  are just to display the initial layout (16 columns).
+ *
+ *  When created with @c LIN_BLOCK_ALLOCATOR_FLAG_MMAP, columns are consecutive slices
+ *  of one reserved virtual range instead of separate allocations. The reserved range
+ *  is mapped without any access and each column is committed (made accessible) only
+ *  when the allocator grows into it.
  * */
 
 /* this value should always be a power of 2*/
 /* influences growth step size of array that stores pointers to each row (or page)*/
 #define COL_STEP 16
 
-/* power of two by which we grow the linear allocator's memory */
-#define FACTOR LIN_BLOCK_ALLOCATOR_RESIZE_FACTOR
-
 /* analogous to number of columns in matrix */
-#define NUM_ROWS (1 << FACTOR)
+#define NUM_ROWS(lba) ((Size)1 << (lba)->col_shift)
+
+/* number of bytes in a single column */
+#define COL_BYTES(lba) (NUM_ROWS(lba) * (lba)->block_size)
+
+/* whether columns are slices of a reserved range */
+#define IS_MMAPED(lba) ((lba)->region != NULL)
 
-/* finds next multiple of COL_STEP from given rowcnt */
-#define NEXT_INCREMENTED_COL_COUNT(rowcnt) (((rowcnt) & (~(COL_STEP - 1))) + COL_STEP)
+/* largest column shift accepted at runtime, 2^24 blocks per column */
+#define MAX_COL_SHIFT 24
+
+/* next multiple of COL_STEP from given col count, this is the number of slots in block_matrix */
+#define NEXT_INCREMENTED_COL_COUNT(colcnt) (((colcnt) + (COL_STEP - 1)) & ~(COL_STEP - 1))
 
 /* convert given index to column index */
-#define COL(i) ((i) >> FACTOR)          /* quotient when divided by (1 << FACTOR) or two raised to power of FACTOR */
-#define ROW(i) ((i) & ~(NUM_ROWS - 1))  /* remainder when divided by (1 << FACTOR) */
+#define COL(lba, i) ((i) >> (lba)->col_shift)          /* quotient when divided by (1 << col_shift) */
+#define ROW(lba, i) ((i) & (NUM_ROWS(lba) - 1))         /* remainder when divided by (1 << col_shift) */
+
+/* get pointer to block at given index */
+#define BLOCK_AT(lba, i) ((lba)->block_matrix[COL(lba, i)] + (ROW(lba, i) * (lba)->block_size))
+
+/**
+ * Free blocks are threaded into an intrusive singly linked list.
+ * The first @c sizeof(Size) bytes of a free block store the index of the
+ * next free block, and @c last_freed_block is the head of this list.
+ * @c SIZE_MAX marks end of list. Blocks after @c next_unused_block
+ * have never been allocated and are not part of the list.
+ *
+ * Blocks might not be aligned for a @c Size (eg: block size of 12),
+ * so links are read and written using @c memcpy.
+ * */
+#define GET_NEXT_FREE(blk, next) memcpy(&(next), (blk), sizeof(Size))
+#define SET_NEXT_FREE(blk, next) memcpy((blk), &(next), sizeof(Size))
+
+/**
+ * Columns are allocated independently, so their addresses are in no particular order.
+ * To find the column that owns a block in O(log n) time, @c col_order keeps column
+ * indices sorted by base address of their memory block array. This has same number of
+ * slots as @c block_matrix.
+ * */
+
+/**
+ * Insert newly allocated column into sorted column order.
+ * Columns are allocated rarely, so an insertion in O(n) time is fine here.
+ *
+ * @param lba
+ * @param col Index of column in block matrix.
+ * */
+static void insert_col_order(LinBlockAllocator* lba, Size col) {
+    MemBlockArray base = lba->block_matrix[col];
+
+    /* find insertion position */
+    Size lo = 0, hi = col;
+    while(lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if(lba->block_matrix[lba->col_order[mid]] < base) lo = mid + 1;
+        else hi = mid;
+    }
+
+    memmove(lba->col_order + lo + 1, lba->col_order + lo, (col - lo) * sizeof(Size));
+    lba->col_order[lo] = col;
+}
+
+/**
+ * Find column owning given block in O(log n) time.
+ *
+ * @param lba
+ * @param blk
+ * @return Index of owner column on success.
+ * @return SIZE_MAX if no column owns given block.
+ * */
+static Size find_owner_col(LinBlockAllocator* lba, MemBlock blk) {
+    Size col_cnt = COL(lba, lba->total_capacity);
+
+    /* all columns are in one range, so this is just arithmetic */
+    if(IS_MMAPED(lba)) {
+        if(blk < lba->region) return SIZE_MAX;
+        Size c = (Size)(blk - lba->region) / COL_BYTES(lba);
+        return c < col_cnt ? c : SIZE_MAX;
+    }
+
+    /* find last column with base address less than or equal to blk */
+    Size lo = 0, hi = col_cnt;
+    while(lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if(lba->block_matrix[lba->col_order[mid]] <= blk) lo = mid + 1;
+        else hi = mid;
+    }
+    if(!lo) return SIZE_MAX;
+
+    Size c = lba->col_order[lo - 1];
+    if(blk >= lba->block_matrix[c] + COL_BYTES(lba)) return SIZE_MAX;
+
+    return c;
+}
+
+/**
+ * Get memory for a new column at given index.
+ * For mmaped allocators, this commits next column from reserved range.
+ *
+ * @param lba
+ * @param col Index of column to create.
+ * @return Memory block array for column on success.
+ * @return NULL otherwise.
+ * */
+static MemBlockArray create_col(LinBlockAllocator* lba, Size col) {
+    if(!IS_MMAPED(lba)) {
+        return ALLOCATE(Uint8, COL_BYTES(lba));
+    }
+
+    /* make sure column fits in reserved range */
+    Size col_end = (col + 1) * COL_BYTES(lba);
+    if(col_end > lba->region_size) {
+        return NULL;
+    }
+
+    /* commit whole pages, columns need not be page aligned */
+    if(col_end > lba->committed_size) {
+        Size page_size = (Size)sysconf(_SC_PAGESIZE);
+        Size new_committed = MIN((col_end + page_size - 1) & ~(page_size - 1), lba->region_size);
+        if(mprotect(lba->region + lba->committed_size, new_committed - lba->committed_size, PROT_READ | PROT_WRITE)) {
+            return NULL;
+        }
+        lba->committed_size = new_committed;
+    }
+
+    return lba->region + col * COL_BYTES(lba);
+}
+
+/**
+ * Reserve virtual address range for all blocks of an mmaped allocator.
+ * Nothing is committed here.
+ *
+ * @param lba
+ * @param max_blocks Maximum number of blocks allocator will ever hold.
+ * @return True on success, False otherwise.
+ * */
+static Bool reserve_region(LinBlockAllocator* lba, Size max_blocks) {
+    Size num_cols  = COL(lba, max_blocks + NUM_ROWS(lba) - 1);
+    Size page_size = (Size)sysconf(_SC_PAGESIZE);
+    Size size      = (num_cols * COL_BYTES(lba) + page_size - 1) & ~(page_size - 1);
+    void* region   = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if(lba->flags & LIN_BLOCK_ALLOCATOR_FLAG_HUGETLB) {
+        /* huge tlb mappings can't be partially protected in normal page sizes, so map them accessible.
+         * Huge pages are reserved for whole range here, without MAP_NORESERVE. This way mmap fails
+         * right away if there aren't enough huge pages, instead of faulting on first use. */
+        Size huge_size = (size + (2 << 20) - 1) & ~(Size)((2 << 20) - 1);
+        region = mmap(NULL, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(region != MAP_FAILED) {
+            lba->region         = region;
+            lba->region_size    = huge_size;
+            lba->committed_size = huge_size;
+            return True;
+        }
+    }
+#endif
+
+    region = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(region == MAP_FAILED) {
+        return False;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if(lba->flags & (LIN_BLOCK_ALLOCATOR_FLAG_HUGEPAGE | LIN_BLOCK_ALLOCATOR_FLAG_HUGETLB)) {
+        madvise(region, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    lba->region         = region;
+    lba->region_size    = size;
+    lba->committed_size = 0;
+    return True;
+}
 
 /**
  * Create a new linear block allocator to allocate
  * fixed memory blocks of given size.
  *
+ * Block size is internally rounded up to be at least @c sizeof(Size),
+ * since free blocks are used to store free list links.
+ *
  * @param block_size Size of each block to be allocated.
  * @return LinBlockAllocator* A valid object on success.
  * @return NULL on failure.
  * */
 LinBlockAllocator* lballoc_create(Size block_size) {
-    ERR_RETURN_VALUE_IF_FAIL(block_size, NULL, ERR_INVALID_ARGUMENTS);
+    return lballoc_create_with_options(block_size, LIN_BLOCK_ALLOCATOR_RESIZE_FACTOR, 0, 0);
+}
+
+/**
+ * Create a new linear block allocator with given column size and
+ * memory backing.
+ *
+ * Large pools should use bigger columns, which means fewer allocations
+ * and less TLB pressure. Pools with known upper bound can additionally
+ * use @c LIN_BLOCK_ALLOCATOR_FLAG_MMAP for a single contiguous range.
+ *
+ * @param block_size Size of each block to be allocated.
+ * @param col_shift Each column holds @c (1 << col_shift) blocks.
+ * If 0 then @c LIN_BLOCK_ALLOCATOR_RESIZE_FACTOR is used.
+ * @param max_blocks Maximum number of blocks when using @c LIN_BLOCK_ALLOCATOR_FLAG_MMAP.
+ * Required for mmaped allocators, ignored otherwise.
+ * @param flags Bitwise OR of @c LinBlockAllocatorFlags.
+ * @return LinBlockAllocator* A valid object on success.
+ * @return NULL on failure.
+ * */
+LinBlockAllocator* lballoc_create_with_options(Size block_size, Size col_shift, Size max_blocks, Uint32 flags) {
+    ERR_RETURN_VALUE_IF_FAIL(block_size && col_shift <= MAX_COL_SHIFT, NULL, ERR_INVALID_ARGUMENTS);
+
+    /* asking for huge pages means asking for a reserved range */
+    if(flags & (LIN_BLOCK_ALLOCATOR_FLAG_HUGEPAGE | LIN_BLOCK_ALLOCATOR_FLAG_HUGETLB)) {
+        flags |= LIN_BLOCK_ALLOCATOR_FLAG_MMAP;
+    }
+    ERR_RETURN_VALUE_IF_FAIL(!(flags & LIN_BLOCK_ALLOCATOR_FLAG_MMAP) || max_blocks, NULL, ERR_INVALID_ARGUMENTS);
 
     /* create new lba */
     LinBlockAllocator* lba = NEW(LinBlockAllocator);
-    ERR_RETURN_VALUE_IF_FAIL(lba, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(lba, NULL, ERR_OUT_OF_MEMORY);
+
+    lba->block_size = MAX(block_size, sizeof(Size));
+    lba->col_shift  = col_shift ? col_shift : LIN_BLOCK_ALLOCATOR_RESIZE_FACTOR;
+    lba->flags      = flags;
 
     /* bitvector to store allocation status */
     lba->occupancy = bitvec_create();
-    ERR_RETURN_VALUE_IF_FAIL(lba->occupancy, NULL, ERR_INVALID_OBJECT);
+    if(!lba->occupancy) {
+        goto HELL;
+    }
 
     /* Create a matrix of memory blocks. Not all rows are allocated at once. */
     lba->block_matrix = ALLOCATE(MemBlockArray, COL_STEP);
@@ -101,16 +308,28 @@ LinBlockAllocator* lballoc_create(Size block_size) {
         goto HELL;
     }
 
+    lba->col_order = ALLOCATE(Size, COL_STEP);
+    if(!lba->col_order) {
+        goto HELL;
+    }
+
+    if((flags & LIN_BLOCK_ALLOCATOR_FLAG_MMAP) && !reserve_region(lba, max_blocks)) {
+        goto HELL;
+    }
+
     /* allocate first array of memory block */
-    MemBlockArray mmblk = ALLOCATE(Uint8, NUM_ROWS * block_size);
+    MemBlockArray mmblk = create_col(lba, 0);
     if(!mmblk) {
         goto HELL;
     }
 
     /* set first row of memory block matrix. */
-    *lba->block_matrix    = mmblk;
-    lba->block_size       = block_size;
-    lba->total_capacity   = NUM_ROWS;
+    *lba->block_matrix      = mmblk;
+    *lba->col_order         = 0;
+    lba->total_capacity     = NUM_ROWS(lba);
+    lba->allocation_count   = 0;
+    lba->next_unused_block  = 0;
+    lba->last_freed_block   = SIZE_MAX;
 
     return lba;
 
@@ -125,7 +344,7 @@ HELL:
  *
  * @param lba
  * */
-inline void lballoc_destroy(LinBlockAllocator* lba) {
+void lballoc_destroy(LinBlockAllocator* lba) {
     ERR_RETURN_IF_FAIL(lba, ERR_INVALID_ARGUMENTS);
 
     if(lba->occupancy) {
@@ -134,15 +353,26 @@ inline void lballoc_destroy(LinBlockAllocator* lba) {
     }
 
     if(lba->block_matrix) {
-        MemBlockArray* m = lba->block_matrix;
-        while(*m) {
-            FREE(*m);
-            *m++ = NULL;
+        /* columns of an mmaped allocator are released with the region */
+        Size col_cnt = IS_MMAPED(lba) ? 0 : COL(lba, lba->total_capacity);
+        for(Size c = 0; c < col_cnt; c++) {
+            FREE(lba->block_matrix[c]);
+            lba->block_matrix[c] = NULL;
         }
         FREE(lba->block_matrix);
         lba->block_matrix = NULL;
     }
 
+    if(lba->region) {
+        munmap(lba->region, lba->region_size);
+        lba->region = NULL;
+    }
+
+    if(lba->col_order) {
+        FREE(lba->col_order);
+        lba->col_order = NULL;
+    }
+
     FREE(lba);
 }
 
@@ -158,53 +388,64 @@ void lballoc_reserve(LinBlockAllocator* lba, Size num_blocks) {
     ERR_RETURN_IF_FAIL(lba && num_blocks, ERR_INVALID_ARGUMENTS);
 
     /* if total memory to reserve is less than what is required at the moment then exit. */
-    if(num_blocks < lba->total_capacity) {
+    if(num_blocks <= lba->total_capacity) {
         return;
     }
 
     /* get total number of current cols (mem block array) */
-    Size col_cnt = COL(lba->total_capacity);
+    Size col_cnt = COL(lba, lba->total_capacity);
 
-    /* if number of blocks to allocate exceeds the number of blocks that can actually fit
-     * in all the preallocated cols, reallocate */
-    if(num_blocks > (col_cnt * NUM_ROWS)) {
-        /* number of cols for which memory block array will be allocated */
-        Size new_col_cnt = COL(num_blocks);
+    /* number of cols for which memory block array will be allocated */
+    Size new_col_cnt = COL(lba, num_blocks + NUM_ROWS(lba) - 1);
 
-        /* resize array containing pointer to each row in memory block matrix */
-        /* number of rows actually in new matrix. This is always integral multiple of COL_STEP */
-        Size new_matrix_cols = NEXT_INCREMENTED_COL_COUNT(new_col_cnt);
+    /* number of slots in matrix. This is always integral multiple of COL_STEP */
+    Size matrix_cols = NEXT_INCREMENTED_COL_COUNT(col_cnt);
+    Size new_matrix_cols = NEXT_INCREMENTED_COL_COUNT(new_col_cnt);
 
-        /* Create a matrix of memory blocks. Not all rows are allocated at once. */
-        MemBlockArray* tmp = realloc(lba->block_matrix, new_matrix_cols * sizeof(MemBlockArray*));
+    /* resize array containing pointer to each column in memory block matrix */
+    if(new_matrix_cols > matrix_cols) {
+        MemBlockArray* tmp = realloc(lba->block_matrix, new_matrix_cols * sizeof(MemBlockArray));
         ERR_RETURN_IF_FAIL(tmp, ERR_OUT_OF_MEMORY);
-        memset(tmp, 0, (new_matrix_cols - new_col_cnt) * sizeof(MemBlockArray*));
+        memset(tmp + matrix_cols, 0, (new_matrix_cols - matrix_cols) * sizeof(MemBlockArray));
         lba->block_matrix = tmp;
-        if(!lba->block_matrix) {
-            goto HELL;
-        }
 
-        /* allocate rows */
-        while(new_col_cnt - col_cnt) {
-            /* allocate first array of memory block */
-            MemBlockArray mmblk = ALLOCATE(Uint8, NUM_ROWS * lba->block_size);
-            if(!mmblk) {
-                goto HELL;
-            }
-            lba->block_matrix[++col_cnt] = mmblk;
+        Size* tmp_order = realloc(lba->col_order, new_matrix_cols * sizeof(Size));
+        ERR_RETURN_IF_FAIL(tmp_order, ERR_OUT_OF_MEMORY);
+        lba->col_order = tmp_order;
+    }
+
+    /* allocate cols */
+    while(col_cnt < new_col_cnt) {
+        MemBlockArray mmblk = create_col(lba, col_cnt);
+        if(!mmblk) {
+            goto HELL;
         }
+        lba->block_matrix[col_cnt] = mmblk;
 
-        lba->total_capacity = col_cnt * NUM_ROWS;
+        /* mmaped columns are already in address order */
+        if(IS_MMAPED(lba)) lba->col_order[col_cnt] = col_cnt;
+        else insert_col_order(lba, col_cnt);
+        col_cnt++;
     }
 
+    lba->total_capacity = col_cnt * NUM_ROWS(lba);
+    bitvec_reserve(lba->occupancy, lba->total_capacity);
+    return;
+
 HELL:
+    /* keep whatever we were able to allocate */
+    lba->total_capacity = col_cnt * NUM_ROWS(lba);
+    bitvec_reserve(lba->occupancy, lba->total_capacity);
     ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
 }
 
 /**
- * Allocate a new block.
- * The allocation implementation aims to provide constant
- * time allocation but the worst case may be linear time.
+ * Allocate a new block in constant time.
+ *
+ * Most recently freed blocks are reused first (LIFO), which tends to keep
+ * hot blocks in cache. If there are no freed blocks, then the next never
+ * allocated block is returned, growing the allocator by one column if
+ * required (amortized constant time).
  *
  * @param lba
  * @return MemBlock A pointer/reference to allocated memory on success.
@@ -213,44 +454,33 @@ HELL:
 MemBlock lballoc_allocate(LinBlockAllocator* lba) {
     ERR_RETURN_VALUE_IF_FAIL(lba, INVALID_MEM_BLOCK, ERR_INVALID_ARGUMENTS);
 
-#define RETURN_BLOCK_AT(i)                                          \
-    bitvec_set(lba->occupancy, i);                                  \
-    return (lba->block_matrix[COL(i)] + (ROW(i) * lba->block_size))
+    Size     index;
+    MemBlock blk;
 
-    /* if we've recently free'd a block then allocate that one first. */
     if(lba->last_freed_block != SIZE_MAX) {
-        RETURN_BLOCK_AT(lba->last_freed_block);
-
-        /* if the block just after this is already allocated then next allocation
-         * needs to search the whole matrix for a free block. */
-        if(bitvec_peek(lba->occupancy, ++lba->last_freed_block)) {
-            lba->last_freed_block = SIZE_MAX;
+        /* pop head of free list */
+        index = lba->last_freed_block;
+        blk   = BLOCK_AT(lba, index);
+        GET_NEXT_FREE(blk, lba->last_freed_block);
+
+        /* don't leak free list internals to user */
+        memset(blk, 0, sizeof(Size));
+    } else {
+        /* bump allocate a never used block */
+        if(lba->next_unused_block >= lba->total_capacity) {
+            lballoc_reserve(lba, lba->total_capacity + 1);
+            ERR_RETURN_VALUE_IF_FAIL(lba->next_unused_block < lba->total_capacity, INVALID_MEM_BLOCK, ERR_OUT_OF_MEMORY);
         }
 
-        /* this part of code tends to search and allocate block in a linear fashion at the very beginning of creation */
+        index = lba->next_unused_block++;
+        blk   = BLOCK_AT(lba, index);
     }
 
-    /* else linearly search through */
-    Size r = 0;
-    Size c = 0;
-    Size col_cnt = COL(lba->total_capacity);
-    while((c < col_cnt) && (r < NUM_ROWS)) {
-        Size pos = c*NUM_ROWS + r;
-        if(bitvec_peek(lba->occupancy, pos)) {
-            RETURN_BLOCK_AT(pos); /* this part of code skips COL_STEP number of elemnets at once to search (linear, but with strides, possibly faster) */
-        }
-        c++;
-        if(c == col_cnt) {
-            c = 0;
-            r++;
-        }
-    }
+    bitvec_set(lba->occupancy, index);
+    lba->allocation_count++;
+    ALLOCATOR_STATS_RECORD_ALLOC(lba->stats, lba->allocation_count);
 
-    lballoc_reserve(lba, lba->total_capacity+1);
-    lba->last_freed_block = lba->total_capacity + 2;
-    RETURN_BLOCK_AT(lba->total_capacity + 1);
-
-#undef RETURN_BLOCK_AT
+    return blk;
 }
 
 /**
@@ -259,25 +489,33 @@ MemBlock lballoc_allocate(LinBlockAllocator* lba) {
  * after calling this free. This is just like what you do
  * when using @c FREE.
  *
+ * Owner column is found by a binary search over columns sorted
+ * by address, so this takes O(log(number of columns)) time.
+ * For mmaped allocators this is constant time.
+ *
  * @param lba
  * @param blk
  * */
 void lballoc_free(LinBlockAllocator* lba, MemBlock blk) {
     ERR_RETURN_IF_FAIL(lba && blk, ERR_INVALID_ARGUMENTS);
 
-    Size cols = COL(lba->total_capacity);
-    for(Size c = 0; c < cols; c++) {
-        /* if given block falls in the boundary of any range then we're sure this was allocated from this allocator */
-        if(blk >= lba->block_matrix[c] && blk <= lba->block_matrix[NUM_ROWS-1]) {
-            Size index = c * NUM_ROWS + ROW(blk - lba->block_matrix[c]);
-
-            /* no need to abort the program and be dramatic about it, since a debug warning should suffice */
-            RETURN_IF_FAIL(!bitvec_peek(lba->occupancy, index), COLOR_RED "DOUBLE FREE" COLOR_RESET " : from LinBlockAllocator\n");
-            bitvec_clear(lba->occupancy, index);
-
-            lba->last_freed_block = index;
-            return;
-        }
+    /* find column owning this block */
+    Size c = find_owner_col(lba, blk);
+    if(c != SIZE_MAX) {
+        Size offset = blk - lba->block_matrix[c];
+        RETURN_IF_FAIL(!(offset % lba->block_size), COLOR_RED "INVALID FREE" COLOR_RESET " : Provided MemBlock is not aligned to a block boundary\n");
+        Size index = c * NUM_ROWS(lba) + offset / lba->block_size;
+
+        /* no need to abort the program and be dramatic about it, since a debug warning should suffice */
+        RETURN_IF_FAIL(bitvec_peek(lba->occupancy, index), COLOR_RED "DOUBLE FREE" COLOR_RESET " : from LinBlockAllocator\n");
+        bitvec_clear(lba->occupancy, index);
+        lba->allocation_count--;
+        ALLOCATOR_STATS_RECORD_FREE(lba->stats);
+
+        /* push to head of free list */
+        SET_NEXT_FREE(blk, lba->last_freed_block);
+        lba->last_freed_block = index;
+        return;
     }
 
     ERR(__FUNCTION__, COLOR_RED "INVALID FREE" COLOR_RESET " : Provided MemBlock not allocated from provided LinBlockAllocator\n");
@@ -294,3 +532,48 @@ void lballoc_free(LinBlockAllocator* lba, MemBlock blk) {
 Float32  lballoc_get_load(LinBlockAllocator* lba) {
     return (Float32)lba->allocation_count/(Float32)lba->total_capacity;
 }
+
+/**
+ * Visit each allocated block in given linear block allocator.
+ * Blocks are visited column by column, in increasing order of
+ * their indices.
+ *
+ * @param lba
+ * @param visitor Callback to be called for each allocated block.
+ * @param udata User data to be passed to @p visitor.
+ * */
+void lballoc_foreach(LinBlockAllocator* lba, MemBlockVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(lba && visitor, ERR_INVALID_ARGUMENTS);
+
+    /* skip free blocks a word at a time */
+    for(Size index = bitvec_find_first_set(lba->occupancy); index != SIZE_MAX;
+        index = bitvec_find_next_set(lba->occupancy, index + 1)) {
+        visitor(BLOCK_AT(lba, index), index, udata);
+    }
+}
+
+/**
+ * Get a snapshot of statistics of given linear block allocator.
+ * This is constant time.
+ *
+ * Allocation never searches for a free block (free list or bump pointer),
+ * so search length is always zero. Fragmentation is fraction of blocks
+ * that have been handed out at least once but are free now.
+ *
+ * @param lba
+ * */
+AllocatorStats lballoc_get_stats(LinBlockAllocator* lba) {
+    AllocatorStats stats = {0};
+    ERR_RETURN_VALUE_IF_FAIL(lba, stats, ERR_INVALID_ARGUMENTS);
+
+    stats                = lba->stats;
+    stats.live_count     = lba->allocation_count;
+    stats.chunk_count    = COL(lba, lba->total_capacity);
+    stats.reserved_bytes = IS_MMAPED(lba) ? lba->committed_size : stats.chunk_count * COL_BYTES(lba);
+    stats.used_bytes     = lba->allocation_count * lba->block_size;
+    stats.fragmentation  = lba->next_unused_block ?
+        (Float32)(lba->next_unused_block - lba->allocation_count) / (Float32)lba->next_unused_block : 0.f;
+    ALLOCATOR_STATS_FINALIZE(stats);
+
+    return stats;
+}
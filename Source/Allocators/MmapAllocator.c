@@ -0,0 +1,229 @@
+/**
+ * @file MmapAllocator.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c MmapAllocator in Allocators/MmapAllocator.h
+ * */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* for mremap */
+#endif
+
+#include <Anvie/Allocators/MmapAllocator.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <string.h>
+
+/* whether an allocation of given size is served by a mapping */
+#define IS_MAPPED(mma, size) ((size) > (mma)->threshold)
+
+/* size of mapping for an allocation of given size */
+#define MAP_SIZE(mma, size) (((size) + (mma)->page_size - 1) & ~((mma)->page_size - 1))
+
+/**
+ * Create a new mmap allocator.
+ *
+ * @param threshold Allocations larger than this many bytes are mapped.
+ * Zero means @c MMAP_ALLOCATOR_DEFAULT_THRESHOLD.
+ * @return MmapAllocator* on success.
+ * @return NULL otherwise.
+ * */
+MmapAllocator* mmapalloc_create(Size threshold) {
+    MmapAllocator* mma = NEW(MmapAllocator);
+    ERR_RETURN_VALUE_IF_FAIL(mma, NULL, ERR_OUT_OF_MEMORY);
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    mma->page_size = page_size > 0 ? (Size)page_size : 4096;
+    mma->threshold = threshold ? threshold : MMAP_ALLOCATOR_DEFAULT_THRESHOLD;
+
+    return mma;
+}
+
+/**
+ * Destroy given mmap allocator. All memory allocated from it must be
+ * freed before this.
+ *
+ * @param mma
+ * */
+void mmapalloc_destroy(MmapAllocator* mma) {
+    ERR_RETURN_IF_FAIL(mma, ERR_INVALID_ARGUMENTS);
+    memset(mma, 0, sizeof(MmapAllocator));
+    FREE(mma);
+}
+
+/**
+ * Allocate memory of given size. Mapped memory is always zeroed by system,
+ * memory from system allocator is not initialized.
+ *
+ * @param mma
+ * @param size Number of bytes to allocate. Must be non-zero.
+ * @return Pointer to allocated memory on success.
+ * @return NULL otherwise.
+ * */
+void* mmapalloc_allocate(MmapAllocator* mma, Size size) {
+    ERR_RETURN_VALUE_IF_FAIL(mma && size, NULL, ERR_INVALID_ARGUMENTS);
+
+    void* mem;
+    if(IS_MAPPED(mma, size)) {
+        mem = mmap(NULL, MAP_SIZE(mma, size), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        ERR_RETURN_VALUE_IF_FAIL(mem != MAP_FAILED, NULL, ERR_OUT_OF_MEMORY);
+        mma->map_count++;
+        mma->mapped_bytes += MAP_SIZE(mma, size);
+    } else {
+        mem = malloc(size);
+        ERR_RETURN_VALUE_IF_FAIL(mem, NULL, ERR_OUT_OF_MEMORY);
+    }
+
+    mma->used_bytes += size;
+    mma->stats.live_count++;
+    ALLOCATOR_STATS_RECORD_ALLOC(mma->stats, mma->stats.live_count);
+
+    return mem;
+}
+
+/**
+ * Resize memory allocated from given mmap allocator.
+ * When both old and new sizes are mapped, mapping is resized in place or
+ * moved by remapping pages, without copying contents.
+ *
+ * @param mma
+ * @param ptr Memory to be resized. If @c NULL then this is same as allocate.
+ * @param old_size Size @p ptr was allocated with.
+ * @param new_size New size of allocation. Must be non-zero.
+ * @return Pointer to resized memory on success.
+ * @return NULL otherwise, in which case @p ptr stays valid.
+ * */
+void* mmapalloc_reallocate(MmapAllocator* mma, void* ptr, Size old_size, Size new_size) {
+    ERR_RETURN_VALUE_IF_FAIL(mma && new_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    if(!ptr) return mmapalloc_allocate(mma, new_size);
+
+    /* both small, let system allocator handle it */
+    if(!IS_MAPPED(mma, old_size) && !IS_MAPPED(mma, new_size)) {
+        void* mem = realloc(ptr, new_size);
+        ERR_RETURN_VALUE_IF_FAIL(mem, NULL, ERR_OUT_OF_MEMORY);
+        mma->used_bytes = mma->used_bytes - old_size + new_size;
+        return mem;
+    }
+
+#ifdef __linux__
+    /* both mapped, move pages instead of copying */
+    if(IS_MAPPED(mma, old_size) && IS_MAPPED(mma, new_size)) {
+        Size old_map = MAP_SIZE(mma, old_size);
+        Size new_map = MAP_SIZE(mma, new_size);
+        if(old_map == new_map) {
+            mma->used_bytes = mma->used_bytes - old_size + new_size;
+            return ptr;
+        }
+
+        void* mem = mremap(ptr, old_map, new_map, MREMAP_MAYMOVE);
+        ERR_RETURN_VALUE_IF_FAIL(mem != MAP_FAILED, NULL, ERR_OUT_OF_MEMORY);
+        mma->mapped_bytes = mma->mapped_bytes - old_map + new_map;
+        mma->used_bytes   = mma->used_bytes - old_size + new_size;
+        return mem;
+    }
+#endif
+
+    /* crossing threshold, or no mremap on this system */
+    void* mem = mmapalloc_allocate(mma, new_size);
+    if(!mem) return NULL;
+
+    memcpy(mem, ptr, MIN(old_size, new_size));
+    mmapalloc_free(mma, ptr, old_size);
+
+    return mem;
+}
+
+/**
+ * Release memory allocated from given mmap allocator. Mappings are
+ * returned to the system immediately.
+ *
+ * @param mma
+ * @param ptr Memory to be released. Nothing happens if @c NULL.
+ * @param size Size the memory was allocated with.
+ * */
+void mmapalloc_free(MmapAllocator* mma, void* ptr, Size size) {
+    ERR_RETURN_IF_FAIL(mma && size, ERR_INVALID_ARGUMENTS);
+    if(!ptr) return;
+
+    if(IS_MAPPED(mma, size)) {
+        munmap(ptr, MAP_SIZE(mma, size));
+        mma->map_count--;
+        mma->mapped_bytes -= MAP_SIZE(mma, size);
+    } else {
+        FREE(ptr);
+    }
+
+    mma->used_bytes -= size;
+    mma->stats.live_count--;
+    ALLOCATOR_STATS_RECORD_FREE(mma->stats);
+}
+
+/* adapters to plug an mmap allocator into generic allocator interface */
+static void* mmap_allocator_allocate(Size size, void* ctx) {
+    return mmapalloc_allocate((MmapAllocator*)ctx, size);
+}
+
+static void* mmap_allocator_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    return mmapalloc_reallocate((MmapAllocator*)ctx, ptr, old_size, new_size);
+}
+
+static void mmap_allocator_free(void* ptr, Size size, void* ctx) {
+    mmapalloc_free((MmapAllocator*)ctx, ptr, size);
+}
+
+/**
+ * Get an @c Allocator that allocates from given mmap allocator.
+ * This can be passed to any @c *_create_with_allocator function,
+ * for eg: to keep a huge vector from copying it's elements on growth.
+ *
+ * @param mma
+ * */
+Allocator mmapalloc_get_allocator(MmapAllocator* mma) {
+    Allocator allocator = {
+        .allocate   = mmap_allocator_allocate,
+        .reallocate = mmap_allocator_reallocate,
+        .free       = mmap_allocator_free,
+        .ctx        = mma
+    };
+
+    return allocator;
+}
+
+/**
+ * Get a snapshot of statistics of given mmap allocator.
+ * Reserved bytes count only mappings, since size of blocks in system
+ * allocator is unknown. Mappings are never searched or reused, so search
+ * length and fragmentation are always zero.
+ *
+ * @param mma
+ * */
+AllocatorStats mmapalloc_get_stats(MmapAllocator* mma) {
+    AllocatorStats stats = {0};
+    ERR_RETURN_VALUE_IF_FAIL(mma, stats, ERR_INVALID_ARGUMENTS);
+
+    stats = mma->stats;
+    stats.chunk_count    = mma->map_count;
+    stats.reserved_bytes = mma->mapped_bytes;
+    stats.used_bytes     = mma->used_bytes;
+    ALLOCATOR_STATS_FINALIZE(stats);
+
+    return stats;
+}
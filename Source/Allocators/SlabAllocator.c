@@ -0,0 +1,287 @@
+/**
+ * @file SlabAllocator.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c SlabAllocator in Allocators/SlabAllocator.h
+ * */
+
+#include <Anvie/Allocators/SlabAllocator.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* log2 of smallest block size */
+#define MIN_BLOCK_SHIFT 3
+
+/* index of size class serving given non-zero size, valid only for sizes within max block size */
+#define CLASS_INDEX(size) ((size) <= SLAB_ALLOCATOR_MIN_BLOCK_SIZE ? 0 : \
+                           (Size)(64 - __builtin_clzll((size) - 1) - MIN_BLOCK_SHIFT))
+
+/* intrusive free list links, stored in first bytes of a free block */
+#define GET_NEXT_FREE(blk) (*(void**)(blk))
+#define SET_NEXT_FREE(blk, nxt) (*(void**)(blk) = (nxt))
+
+/**
+ * Create a new slab allocator. No pages are allocated until first
+ * allocation is made from a size class.
+ *
+ * @return SlabAllocator* on success.
+ * @return NULL otherwise.
+ * */
+SlabAllocator* slaballoc_create() {
+    SlabAllocator* sla = NEW(SlabAllocator);
+    ERR_RETURN_VALUE_IF_FAIL(sla, NULL, ERR_OUT_OF_MEMORY);
+
+    for(Size c = 0; c < SLAB_ALLOCATOR_CLASS_COUNT; c++) {
+        sla->classes[c].block_size = (Size)SLAB_ALLOCATOR_MIN_BLOCK_SIZE << c;
+    }
+
+    return sla;
+}
+
+/**
+ * Destroy given slab allocator. All memory allocated from size classes
+ * is released. Large allocations forwarded to system allocator must be
+ * freed before this.
+ *
+ * @param sla
+ * */
+void slaballoc_destroy(SlabAllocator* sla) {
+    ERR_RETURN_IF_FAIL(sla, ERR_INVALID_ARGUMENTS);
+
+    for(Size c = 0; c < SLAB_ALLOCATOR_CLASS_COUNT; c++) {
+        SlabPage* page = sla->classes[c].pages;
+        while(page) {
+            SlabPage* next = page->next;
+            FREE(page);
+            page = next;
+        }
+    }
+
+    memset(sla, 0, sizeof(SlabAllocator));
+    FREE(sla);
+}
+
+/**
+ * Allocate a block from given size class. Reuses a freed block if there's
+ * one, otherwise bumps into current page, creating a new page if required.
+ * */
+static FORCE_INLINE void* allocate_from_class(SlabClass* sc) {
+    /* first try to reuse freed block */
+    void* blk = sc->free_list;
+    if(blk) {
+        sc->free_list = GET_NEXT_FREE(blk);
+        sc->live_count++;
+        return blk;
+    }
+
+    /* get a fresh block from current page, or from a new page */
+    SlabPage* page = sc->pages;
+    if(!page || page->used + sc->block_size > SLAB_ALLOCATOR_PAGE_SIZE) {
+        page = malloc(sizeof(SlabPage) + SLAB_ALLOCATOR_PAGE_SIZE);
+        ERR_RETURN_VALUE_IF_FAIL(page, NULL, ERR_OUT_OF_MEMORY);
+
+        page->next = sc->pages;
+        page->used = 0;
+        sc->pages  = page;
+        sc->page_count++;
+    }
+
+    blk = page->data + page->used;
+    page->used += sc->block_size;
+    sc->live_count++;
+
+    return blk;
+}
+
+/**
+ * Allocate memory of given size. Returned memory is not initialized.
+ * Sizes up to @c SLAB_ALLOCATOR_MAX_BLOCK_SIZE are served in constant time
+ * from a size class, larger sizes are forwarded to @c malloc.
+ *
+ * @param sla
+ * @param size Number of bytes to allocate. Must be non-zero.
+ * @return Pointer to allocated memory on success.
+ * @return NULL otherwise.
+ * */
+void* slaballoc_allocate(SlabAllocator* sla, Size size) {
+    ERR_RETURN_VALUE_IF_FAIL(sla && size, NULL, ERR_INVALID_ARGUMENTS);
+
+    void* mem;
+    if(size > SLAB_ALLOCATOR_MAX_BLOCK_SIZE) {
+        mem = malloc(size);
+        ERR_RETURN_VALUE_IF_FAIL(mem, NULL, ERR_OUT_OF_MEMORY);
+        sla->large_count++;
+        sla->large_bytes += size;
+    } else {
+        mem = allocate_from_class(&sla->classes[CLASS_INDEX(size)]);
+        if(!mem) return NULL;
+    }
+
+    sla->stats.live_count++;
+    ALLOCATOR_STATS_RECORD_ALLOC(sla->stats, sla->stats.live_count);
+
+    return mem;
+}
+
+/**
+ * Resize memory allocated from given slab allocator.
+ * If both sizes map to same size class then @p ptr is returned as is.
+ *
+ * @param sla
+ * @param ptr Memory to be resized. If @c NULL then this is same as allocate.
+ * @param old_size Size @p ptr was allocated with.
+ * @param new_size New size of allocation. Must be non-zero.
+ * @return Pointer to resized memory on success.
+ * @return NULL otherwise, in which case @p ptr stays valid.
+ * */
+void* slaballoc_reallocate(SlabAllocator* sla, void* ptr, Size old_size, Size new_size) {
+    ERR_RETURN_VALUE_IF_FAIL(sla && new_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    if(!ptr) return slaballoc_allocate(sla, new_size);
+
+    /* both allocations are large, let system allocator handle it */
+    if(old_size > SLAB_ALLOCATOR_MAX_BLOCK_SIZE && new_size > SLAB_ALLOCATOR_MAX_BLOCK_SIZE) {
+        void* mem = realloc(ptr, new_size);
+        ERR_RETURN_VALUE_IF_FAIL(mem, NULL, ERR_OUT_OF_MEMORY);
+        sla->large_bytes = sla->large_bytes - old_size + new_size;
+        return mem;
+    }
+
+    /* block is already large enough */
+    if(slaballoc_get_block_size(old_size) == slaballoc_get_block_size(new_size)) {
+        return ptr;
+    }
+
+    void* mem = slaballoc_allocate(sla, new_size);
+    if(!mem) return NULL;
+
+    memcpy(mem, ptr, MIN(old_size, new_size));
+    slaballoc_free(sla, ptr, old_size);
+
+    return mem;
+}
+
+/**
+ * Return memory back to slab allocator in constant time.
+ *
+ * @param sla
+ * @param ptr Memory to be released. Nothing happens if @c NULL.
+ * @param size Size the memory was allocated with.
+ * */
+void slaballoc_free(SlabAllocator* sla, void* ptr, Size size) {
+    ERR_RETURN_IF_FAIL(sla && size, ERR_INVALID_ARGUMENTS);
+    if(!ptr) return;
+
+    sla->stats.live_count--;
+    ALLOCATOR_STATS_RECORD_FREE(sla->stats);
+
+    if(size > SLAB_ALLOCATOR_MAX_BLOCK_SIZE) {
+        FREE(ptr);
+        sla->large_count--;
+        sla->large_bytes -= size;
+        return;
+    }
+
+    SlabClass* sc = &sla->classes[CLASS_INDEX(size)];
+    SET_NEXT_FREE(ptr, sc->free_list);
+    sc->free_list = ptr;
+    sc->live_count--;
+}
+
+/**
+ * Get actual number of bytes reserved for an allocation of given size.
+ * For large allocations this is the size itself.
+ *
+ * @param size
+ * */
+Size slaballoc_get_block_size(Size size) {
+    if(size > SLAB_ALLOCATOR_MAX_BLOCK_SIZE) return size;
+    return (Size)SLAB_ALLOCATOR_MIN_BLOCK_SIZE << CLASS_INDEX(size);
+}
+
+/* adapters to plug a slab allocator into generic allocator interface */
+static void* slab_allocator_allocate(Size size, void* ctx) {
+    return slaballoc_allocate((SlabAllocator*)ctx, size);
+}
+
+static void* slab_allocator_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    return slaballoc_reallocate((SlabAllocator*)ctx, ptr, old_size, new_size);
+}
+
+static void slab_allocator_free(void* ptr, Size size, void* ctx) {
+    slaballoc_free((SlabAllocator*)ctx, ptr, size);
+}
+
+/**
+ * Get an @c Allocator that allocates from given slab allocator.
+ * This can be passed to any @c *_create_with_allocator function,
+ * for eg: to route key and data copies of a map through size classes.
+ *
+ * @param sla
+ * */
+Allocator slaballoc_get_allocator(SlabAllocator* sla) {
+    Allocator allocator = {
+        .allocate   = slab_allocator_allocate,
+        .reallocate = slab_allocator_reallocate,
+        .free       = slab_allocator_free,
+        .ctx        = sla
+    };
+
+    return allocator;
+}
+
+/**
+ * Get a snapshot of statistics of given slab allocator.
+ * This is constant time.
+ *
+ * Reserved and used bytes include large allocations forwarded to system
+ * allocator. Used bytes count full block size of each live block, so
+ * internal waste due to rounding up to size class is included in it.
+ * A slab never searches for a free block, so search length is always zero.
+ * Fragmentation is fraction of touched block memory that is in free lists.
+ *
+ * @param sla
+ * */
+AllocatorStats slaballoc_get_stats(SlabAllocator* sla) {
+    AllocatorStats stats = {0};
+    ERR_RETURN_VALUE_IF_FAIL(sla, stats, ERR_INVALID_ARGUMENTS);
+
+    stats = sla->stats;
+
+    Size touched = 0, used = 0;
+    for(Size c = 0; c < SLAB_ALLOCATOR_CLASS_COUNT; c++) {
+        SlabClass* sc = &sla->classes[c];
+        if(!sc->page_count) continue;
+
+        /* all pages except the first one are completely carved */
+        Size page_bytes = (SLAB_ALLOCATOR_PAGE_SIZE / sc->block_size) * sc->block_size;
+        touched += (sc->page_count - 1) * page_bytes + sc->pages->used;
+        used    += sc->live_count * sc->block_size;
+
+        stats.chunk_count    += sc->page_count;
+        stats.reserved_bytes += sc->page_count * SLAB_ALLOCATOR_PAGE_SIZE;
+    }
+
+    stats.reserved_bytes += sla->large_bytes;
+    stats.used_bytes      = used + sla->large_bytes;
+    stats.fragmentation   = touched ? (Float32)(touched - used) / (Float32)touched : 0.f;
+    ALLOCATOR_STATS_FINALIZE(stats);
+
+    return stats;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file LinBlockAllocator.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief LinBlockAllocator benchmarks, allocating blocks into an empty
+ * allocator, and churning a full one by freeing and reallocating blocks
+ * in random order.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Allocators/BlockAllocator.h>
+
+#define LBALLOC_BENCH_BLOCK_SIZE 64
+
+/* allocator with all blocks it's going to hand out, in random order */
+typedef struct LinBlockAllocatorBench {
+    LinBlockAllocator* lba;
+    MemBlock*          blocks;
+} LinBlockAllocatorBench;
+
+BENCH_FN void lballoc_bench_setup(BenchState* state) {
+    LinBlockAllocatorBench* bench = NEW(LinBlockAllocatorBench);
+    Uint64                  seed  = state->size;
+
+    bench->lba    = lballoc_create(LBALLOC_BENCH_BLOCK_SIZE);
+    bench->blocks = ALLOCATE(MemBlock, state->size);
+    for(Size i = 0; i < state->size; i++) {
+        bench->blocks[i] = lballoc_allocate(bench->lba);
+    }
+
+    /* shuffle, so that churn doesn't free blocks in allocation order */
+    for(Size i = state->size; i > 1; i--) {
+        Size     j        = bench_random(&seed) % i;
+        MemBlock blk      = bench->blocks[i - 1];
+        bench->blocks[i - 1] = bench->blocks[j];
+        bench->blocks[j]     = blk;
+    }
+
+    state->data = bench;
+}
+
+BENCH_FN void lballoc_bench_teardown(BenchState* state) {
+    LinBlockAllocatorBench* bench = state->data;
+    lballoc_destroy(bench->lba);
+    FREE(bench->blocks);
+    FREE(bench);
+    state->data = NULL;
+}
+
+BENCH_FN void lballoc_allocate_bench(BenchState* state) {
+    LinBlockAllocator* lba = lballoc_create(LBALLOC_BENCH_BLOCK_SIZE);
+    for(Size i = 0; i < state->size; i++) {
+        MemBlock blk = lballoc_allocate(lba);
+        BENCH_KEEP(blk);
+    }
+    lballoc_destroy(lba);
+}
+
+/* free half of blocks and allocate them again, twice */
+BENCH_FN void lballoc_churn_bench(BenchState* state) {
+    LinBlockAllocatorBench* bench = state->data;
+    Size                    half  = state->size / 2;
+
+    for(Size round = 0; round < 2; round++) {
+        for(Size i = round * half; i < (round + 1) * half; i++) {
+            lballoc_free(bench->lba, bench->blocks[i]);
+        }
+        for(Size i = round * half; i < (round + 1) * half; i++) {
+            bench->blocks[i] = lballoc_allocate(bench->lba);
+        }
+    }
+
+    state->sink += (UintPtr)bench->blocks[0];
+}
+
+BEGIN_BENCHES(lballoc)
+    BENCH(lballoc_allocate_bench, 1024),
+    BENCH(lballoc_allocate_bench, 1048576),
+    BENCH_WITH_SETUP(lballoc_churn_bench, lballoc_bench_setup, lballoc_bench_teardown, 1024),
+    BENCH_WITH_SETUP(lballoc_churn_bench, lballoc_bench_setup, lballoc_bench_teardown, 1048576),
+END_BENCHES()
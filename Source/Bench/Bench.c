@@ -0,0 +1,47 @@
+/**
+ * @file Bench.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Benchmark runner entry point. Run with --help to see options.
+ * */
+
+#include "ImportBenches.h"
+
+BEGIN_BENCH_SUITES()
+
+    /* containers */
+    BENCH_SUITE(vector)
+    BENCH_SUITE(bitvector)
+    BENCH_SUITE(dense_map)
+    BENCH_SUITE(sparse_map)
+    BENCH_SUITE(string)
+    BENCH_SUITE(queue)
+    BENCH_SUITE(priority_queue)
+    BENCH_SUITE(group_by)
+    BENCH_SUITE(pipeline)
+
+    /* allocators */
+    BENCH_SUITE(lballoc)
+
+    /* maths */
+    BENCH_SUITE(entropy)
+
+    /* runtime */
+    BENCH_SUITE(thread_pool)
+
+END_BENCH_SUITES()
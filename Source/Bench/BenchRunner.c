@@ -0,0 +1,421 @@
+/**
+ * @file BenchRunner.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Benchmark runner. Times every case of a suite, and prints median
+ * and percentiles of it's samples as a table or as JSON.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Chrono/Cycles.h>
+#include <Anvie/Counters.h>
+#include <Anvie/Simd/Dispatch.h>
+#include <Anvie/Error.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   define BENCH_PERF_SUPPORTED 1
+#else
+#   define BENCH_PERF_SUPPORTED 0
+#endif
+
+#define BENCH_DEFAULT_WARMUP  2
+#define BENCH_DEFAULT_SAMPLES 21
+
+/* counted events, in order they're printed */
+#define BENCH_PERF_COUNTERS 3
+static ZString bench_perf_counter_names[BENCH_PERF_COUNTERS] = {"instructions", "branch_misses", "cache_misses"};
+
+/* perf_event group, leader is first file descriptor, -1 where not open */
+static int bench_perf_fds[BENCH_PERF_COUNTERS] = {-1, -1, -1};
+
+/**
+ * Summary of samples of one case, sorted in ascending order.
+ * */
+typedef struct BenchStats {
+    Uint64 min, median, p90, p99, max;
+} BenchStats;
+
+static int bench_compare_u64(const void* a, const void* b) {
+    Uint64 x = *(const Uint64*)a;
+    Uint64 y = *(const Uint64*)b;
+    return (x > y) - (x < y);
+}
+
+/* nearest rank percentile of sorted samples */
+static Uint64 bench_percentile(const Uint64* sorted, Size count, Size percent) {
+    Size rank = (percent * count + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static BenchStats bench_stats(Uint64* samples, Size count) {
+    qsort(samples, count, sizeof(Uint64), bench_compare_u64);
+
+    BenchStats stats;
+    stats.min    = samples[0];
+    stats.median = bench_percentile(samples, count, 50);
+    stats.p90    = bench_percentile(samples, count, 90);
+    stats.p99    = bench_percentile(samples, count, 99);
+    stats.max    = samples[count - 1];
+    return stats;
+}
+
+#if BENCH_PERF_SUPPORTED
+static int bench_perf_open_counter(Uint64 config, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.disabled       = group == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif // BENCH_PERF_SUPPORTED
+
+static void bench_perf_close() {
+#if BENCH_PERF_SUPPORTED
+    for(Size c = 0; c < BENCH_PERF_COUNTERS; c++) {
+        if(bench_perf_fds[c] != -1) {
+            close(bench_perf_fds[c]);
+        }
+        bench_perf_fds[c] = -1;
+    }
+#endif // BENCH_PERF_SUPPORTED
+}
+
+/**
+ * Open a group of hardware counters for this process. Counters are often not
+ * available (containers, VMs, perf_event_paranoid), in which case benchmarks
+ * still run, just without counters.
+ * */
+static Bool bench_perf_open() {
+#if BENCH_PERF_SUPPORTED
+    static const Uint64 configs[BENCH_PERF_COUNTERS] = {
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+    };
+
+    for(Size c = 0; c < BENCH_PERF_COUNTERS; c++) {
+        bench_perf_fds[c] = bench_perf_open_counter(configs[c], c ? bench_perf_fds[0] : -1);
+        if(bench_perf_fds[c] == -1) {
+            bench_perf_close();
+            return False;
+        }
+    }
+
+    return True;
+#else
+    return False;
+#endif // BENCH_PERF_SUPPORTED
+}
+
+static FORCE_INLINE void bench_perf_start() {
+#if BENCH_PERF_SUPPORTED
+    ioctl(bench_perf_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(bench_perf_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif // BENCH_PERF_SUPPORTED
+}
+
+/* stop counting and read one value for each counter into @p counts */
+static FORCE_INLINE void bench_perf_stop(Uint64 counts[BENCH_PERF_COUNTERS]) {
+#if BENCH_PERF_SUPPORTED
+    /* group is read as number of counters followed by their values */
+    Uint64 values[BENCH_PERF_COUNTERS + 1] = {0};
+
+    ioctl(bench_perf_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if(read(bench_perf_fds[0], values, sizeof(values)) != (ssize_t)sizeof(values)) {
+        memset(values, 0, sizeof(values));
+    }
+    memcpy(counts, values + 1, sizeof(Uint64) * BENCH_PERF_COUNTERS);
+#else
+    memset(counts, 0, sizeof(Uint64) * BENCH_PERF_COUNTERS);
+#endif // BENCH_PERF_SUPPORTED
+}
+
+static void bench_usage(ZString program) {
+    println("usage : %s [--samples N] [--warmup N] [--filter TEXT] [--json] [--perf]", program);
+    println("    --samples N    timed runs of each case (default %d)", BENCH_DEFAULT_SAMPLES);
+    println("    --warmup N     untimed runs of each case before sampling (default %d)", BENCH_DEFAULT_WARMUP);
+    println("    --filter TEXT  run only cases with TEXT in their \"suite/name\"");
+    println("    --json         print results as JSON");
+    println("    --perf         count instructions, branch and cache misses (Linux perf_event)");
+}
+
+/* parse a count argument, which must be positive unless @p allow_zero */
+static Bool bench_parse_count(ZString arg, Size* count, Bool allow_zero) {
+    char*  end   = NULL;
+    Uint64 value = strtoull(arg, &end, 10);
+    if(!*arg || *end || (!value && !allow_zero)) {
+        return False;
+    }
+    *count = (Size)value;
+    return True;
+}
+
+/**
+ * Fill @p config with defaults, overridden by command line arguments.
+ *
+ * @return False if arguments are invalid or help was requested, True otherwise.
+ * */
+Bool bench_config_from_args(BenchConfig* config, int argc, char** argv) {
+    ERR_RETURN_VALUE_IF_FAIL(config, False, ERR_INVALID_ARGUMENTS);
+
+    config->warmup  = BENCH_DEFAULT_WARMUP;
+    config->samples = BENCH_DEFAULT_SAMPLES;
+    config->filter  = NULL;
+    config->json    = False;
+    config->perf    = False;
+    config->printed = 0;
+
+    for(int i = 1; i < argc; i++) {
+        ZString arg     = argv[i];
+        ZString value   = i + 1 < argc ? argv[i + 1] : NULL;
+        Bool    invalid = False;
+
+        if(!strcmp(arg, "--json")) {
+            config->json = True;
+        } else if(!strcmp(arg, "--perf")) {
+            config->perf = True;
+        } else if(!strcmp(arg, "--samples")) {
+            invalid = !value || !bench_parse_count(value, &config->samples, False);
+            i++;
+        } else if(!strcmp(arg, "--warmup")) {
+            invalid = !value || !bench_parse_count(value, &config->warmup, True);
+            i++;
+        } else if(!strcmp(arg, "--filter")) {
+            invalid        = !value;
+            config->filter = value;
+            i++;
+        } else {
+            bench_usage(argv[0]);
+            return False;
+        }
+
+        if(invalid) {
+            ERR(__FUNCTION__, "invalid value for \"%s\"\n", arg);
+            bench_usage(argv[0]);
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/**
+ * Prepare for running suites and print header of results.
+ * */
+void bench_begin(BenchConfig* config) {
+    RETURN_IF_FAIL(config, ERRFMT, ERRMSG(ERR_INVALID_ARGUMENTS));
+
+    if(config->perf && !bench_perf_open()) {
+        ERR(__FUNCTION__, "hardware counters are not available, running without --perf\n");
+        config->perf = False;
+    }
+
+    /* calibrate now, so that first case doesn't pay for it */
+    Uint64 frequency = chrono_cycles_frequency();
+
+    if(config->json) {
+        printf("{\"simd_level\": \"%s\", \"cycles_frequency\": %llu, \"warmup\": %zu, \"samples\": %zu, \"benchmarks\": [",
+               simd_level_name(simd_level_get()), (unsigned long long)frequency, config->warmup, config->samples);
+        return;
+    }
+
+    println("simd level : %s, cycle counter : %.3f GHz, %zu warmup runs, %zu samples%s",
+            simd_level_name(simd_level_get()), frequency / 1e9, config->warmup, config->samples,
+            counters_enabled() ? ", hot path counters enabled (timings include their cost)" : "");
+    LINE80();
+    printf("%-48s %9s %10s %10s %10s %10s", "case", "size", "min ns", "median ns", "p90 ns", "p99 ns");
+    printf(" %10s", "cyc/elem");
+    if(config->perf) {
+        printf(" %10s %10s %10s", "ins/elem", "brmiss", "cachemiss");
+    }
+    putchar('\n');
+    LINE80();
+}
+
+/**
+ * Finish printing results and release counters.
+ * */
+void bench_end(BenchConfig* config) {
+    RETURN_IF_FAIL(config, ERRFMT, ERRMSG(ERR_INVALID_ARGUMENTS));
+
+    if(config->json) {
+        println("\n]}");
+    } else {
+        LINE80();
+        println("%zu cases", config->printed);
+    }
+
+    bench_perf_close();
+}
+
+static void bench_print(BenchConfig* config, ZString suite, const BenchCase* bench, BenchStats ns, BenchStats cycles,
+                        const Uint64 counters[BENCH_PERF_COUNTERS], const Counters* events) {
+    Float64 size = (Float64)MAX(bench->size, 1);
+
+    if(config->json) {
+        printf("%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"size\": %zu, \"samples\": %zu, "
+               "\"ns\": {\"min\": %llu, \"median\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu}, "
+               "\"cycles_per_element\": %.3f",
+               config->printed ? "," : "", suite, bench->name, bench->size, config->samples,
+               (unsigned long long)ns.min, (unsigned long long)ns.median, (unsigned long long)ns.p90,
+               (unsigned long long)ns.p99, (unsigned long long)ns.max, cycles.median / size);
+        if(config->perf) {
+            for(Size c = 0; c < BENCH_PERF_COUNTERS; c++) {
+                printf(", \"%s_per_element\": %.3f", bench_perf_counter_names[c], counters[c] / size);
+            }
+        }
+        if(counters_enabled()) {
+            printf(", \"counters\": {");
+            for(Size c = 0, printed = 0; c < COUNTER_MAX; c++) {
+                if(events->values[c]) {
+                    printf("%s\"%s\": %llu", printed++ ? ", " : "", counter_name(c), (unsigned long long)events->values[c]);
+                }
+            }
+            putchar('}');
+        }
+        putchar('}');
+    } else {
+        Char name[64];
+        snprintf(name, sizeof(name), "%s/%s", suite, bench->name);
+        printf("%-48s %9zu %10llu %10llu %10llu %10llu %10.2f", name, bench->size, (unsigned long long)ns.min,
+               (unsigned long long)ns.median, (unsigned long long)ns.p90, (unsigned long long)ns.p99,
+               cycles.median / size);
+        if(config->perf) {
+            printf(" %10.2f %10.3f %10.3f", counters[0] / size, counters[1] / size, counters[2] / size);
+        }
+        putchar('\n');
+
+        /* hot path events of one run, below the row they belong to */
+        for(Size c = 0; c < COUNTER_MAX; c++) {
+            if(events->values[c]) {
+                println("    %-44s %12llu %10.3f/elem", counter_name(c), (unsigned long long)events->values[c],
+                        events->values[c] / size);
+            }
+        }
+    }
+
+    fflush(stdout);
+    config->printed++;
+}
+
+/* check whether "suite/name" contains filter text */
+static Bool bench_selected(const BenchConfig* config, ZString suite, ZString name) {
+    if(!config->filter) {
+        return True;
+    }
+
+    Char full_name[256];
+    snprintf(full_name, sizeof(full_name), "%s/%s", suite, name);
+    return strstr(full_name, config->filter) != NULL;
+}
+
+/**
+ * Run given benchmark cases, each after warming it up. Only run callback is
+ * timed, and with --perf, counted. Reported perf counters are median of
+ * samples, and hot path counters of Anvie/Counters.h are those of last run.
+ *
+ * @return Number of cases run.
+ * */
+Size bench_run_suite(ZString suite, const BenchCase* cases, Size count, BenchConfig* config) {
+    ERR_RETURN_VALUE_IF_FAIL(suite && cases && config, 0, ERR_INVALID_ARGUMENTS);
+
+    Uint64* cycles = ALLOCATE(Uint64, config->samples);
+    Uint64* ns     = ALLOCATE(Uint64, config->samples);
+    Uint64* counts = ALLOCATE(Uint64, config->samples * BENCH_PERF_COUNTERS);
+    Uint64* column = ALLOCATE(Uint64, config->samples);
+    ERR_RETURN_VALUE_IF_FAIL(cycles && ns && counts && column, 0, ERR_OUT_OF_MEMORY);
+
+    Size run = 0;
+    for(Size b = 0; b < count; b++) {
+        const BenchCase* bench = cases + b;
+        if(!bench->run || !bench_selected(config, suite, bench->name)) {
+            continue;
+        }
+
+        BenchState state  = {.size = bench->size, .data = NULL, .sink = 0};
+        Counters   events = {0};
+
+        for(Size s = 0; s < config->warmup + config->samples; s++) {
+            /* warmup runs all go to first sample, and are overwritten by it */
+            Size sample = s >= config->warmup ? s - config->warmup : 0;
+
+            if(bench->setup) {
+                bench->setup(&state);
+            }
+
+            Counters before;
+            counters_get(&before);
+
+            if(config->perf) {
+                bench_perf_start();
+            }
+
+            Uint64 start = chrono_cycles_ordered();
+            bench->run(&state);
+            Uint64 end = chrono_cycles_ordered();
+
+            counters_get(&events);
+            counters_diff(&events, &events, &before);
+
+            if(config->perf) {
+                bench_perf_stop(counts + sample * BENCH_PERF_COUNTERS);
+            }
+
+            if(bench->teardown) {
+                bench->teardown(&state);
+            }
+
+            cycles[sample] = end - start;
+            ns[sample]     = chrono_cycles_to_nanoseconds(end - start);
+        }
+
+        BENCH_KEEP(state.sink);
+
+        Uint64 counters[BENCH_PERF_COUNTERS] = {0};
+        if(config->perf) {
+            for(Size c = 0; c < BENCH_PERF_COUNTERS; c++) {
+                for(Size s = 0; s < config->samples; s++) {
+                    column[s] = counts[s * BENCH_PERF_COUNTERS + c];
+                }
+                counters[c] = bench_stats(column, config->samples).median;
+            }
+        }
+
+        bench_print(config, suite, bench, bench_stats(ns, config->samples), bench_stats(cycles, config->samples),
+                    counters, &events);
+        run++;
+    }
+
+    FREE(cycles);
+    FREE(ns);
+    FREE(counts);
+    FREE(column);
+
+    return run;
+}
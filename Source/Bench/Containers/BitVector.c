@@ -0,0 +1,103 @@
+/**
+ * @file BitVector.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief BitVector benchmarks, bulk word operations and set bit scans.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/BitVector.h>
+
+/* two operands with about one in four bits set, a copy of first, and a destination */
+typedef struct BitVectorBench {
+    BitVector* a;
+    BitVector* b;
+    BitVector* a_copy;
+    BitVector* dst;
+} BitVectorBench;
+
+BENCH_FN void bitvec_bench_setup(BenchState* state) {
+    BitVectorBench* bench = NEW(BitVectorBench);
+    Uint64          seed  = state->size;
+
+    bench->a   = bitvec_create();
+    bench->b   = bitvec_create();
+    bench->dst = bitvec_create();
+    bitvec_resize(bench->a, state->size);
+    bitvec_resize(bench->b, state->size);
+    bitvec_resize(bench->dst, state->size);
+
+    for(Size i = 0; i < state->size; i++) {
+        Uint64 r = bench_random(&seed);
+        if(!(r & 3)) {
+            bitvec_set(bench->a, i);
+        }
+        if(!(r & 12)) {
+            bitvec_set(bench->b, i);
+        }
+    }
+
+    bench->a_copy = bitvec_clone(bench->a);
+    state->data   = bench;
+}
+
+BENCH_FN void bitvec_bench_teardown(BenchState* state) {
+    BitVectorBench* bench = state->data;
+    bitvec_destroy(bench->a);
+    bitvec_destroy(bench->b);
+    bitvec_destroy(bench->a_copy);
+    bitvec_destroy(bench->dst);
+    FREE(bench);
+    state->data = NULL;
+}
+
+BENCH_FN void bitvec_and_into_bench(BenchState* state) {
+    BitVectorBench* bench = state->data;
+    bitvec_and_into(bench->dst, bench->a, bench->b);
+    BENCH_KEEP(bench->dst->data);
+}
+
+BENCH_FN void bitvec_popcount_bench(BenchState* state) {
+    BitVectorBench* bench = state->data;
+    state->sink += bitvec_popcount(bench->a);
+}
+
+BENCH_FN void bitvec_cmpeq_bench(BenchState* state) {
+    BitVectorBench* bench = state->data;
+    state->sink += bitvec_cmpeq(bench->a, bench->a_copy);
+}
+
+BENCH_FN void bitvec_find_next_set_bench(BenchState* state) {
+    BitVectorBench* bench = state->data;
+    for(Size i = bitvec_find_next_set(bench->a, 0); i != SIZE_MAX; i = bitvec_find_next_set(bench->a, i + 1)) {
+        state->sink += i;
+    }
+}
+
+#define BITVEC_BENCH(fn, n) BENCH_WITH_SETUP(fn, bitvec_bench_setup, bitvec_bench_teardown, n)
+
+BEGIN_BENCHES(bitvector)
+    BITVEC_BENCH(bitvec_and_into_bench, 65536),
+    BITVEC_BENCH(bitvec_and_into_bench, 16777216),
+    BITVEC_BENCH(bitvec_popcount_bench, 65536),
+    BITVEC_BENCH(bitvec_popcount_bench, 16777216),
+    BITVEC_BENCH(bitvec_cmpeq_bench, 65536),
+    BITVEC_BENCH(bitvec_cmpeq_bench, 16777216),
+    BITVEC_BENCH(bitvec_find_next_set_bench, 65536),
+    BITVEC_BENCH(bitvec_find_next_set_bench, 16777216),
+END_BENCHES()
@@ -0,0 +1,131 @@
+/**
+ * @file GroupBy.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Group by benchmarks, summing random values of few and of many
+ * distinct keys, with a search and insert into a DenseMap for each row,
+ * and with serial and parallel group by.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/GroupBy.h>
+#include <Anvie/Containers/DenseMap.h>
+
+/* distinct keys of low cardinality benches, high cardinality ones have one for every 4 rows */
+#define GROUP_BY_FEW_KEYS 1024
+
+typedef struct GroupByBenchData {
+    U64_Vector* keys;
+    F64_Vector* values;
+} GroupByBenchData;
+
+typedef struct GroupByBenchAggregate {
+    Float64 sum;
+    Uint64  count;
+    Float64 min;
+    Float64 max;
+} GroupByBenchAggregate;
+
+static void group_by_setup(BenchState* state, Uint64 distinct) {
+    GroupByBenchData* data = NEW(GroupByBenchData);
+    Uint64            seed = state->size;
+
+    data->keys   = u64_vector_create();
+    data->values = f64_vector_create();
+    u64_vector_resize(data->keys, state->size);
+    f64_vector_resize(data->values, state->size);
+    for(Size i = 0; i < state->size; i++) {
+        data->keys->data[i]   = hash_mix64(bench_random(&seed) % distinct);
+        data->values->data[i] = (Float64)(bench_random(&seed) % 1000000) / 100.0;
+    }
+    state->data = data;
+}
+
+BENCH_FN void group_by_few_setup(BenchState* state) {
+    group_by_setup(state, GROUP_BY_FEW_KEYS);
+}
+
+BENCH_FN void group_by_many_setup(BenchState* state) {
+    group_by_setup(state, MAX(state->size / 4, 1));
+}
+
+BENCH_FN void group_by_teardown(BenchState* state) {
+    GroupByBenchData* data = state->data;
+    u64_vector_destroy(data->keys, NULL);
+    f64_vector_destroy(data->values, NULL);
+    FREE(data);
+    state->data = NULL;
+}
+
+BENCH_FN void group_by_dense_map_bench(BenchState* state) {
+    GroupByBenchData* data = state->data;
+    DenseMap*         map  = dense_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64), NULL, NULL,
+                                              (CompareElementCallback)(void*)compare_u64, sizeof(GroupByBenchAggregate), NULL, NULL,
+                                              False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
+    for(Size i = 0; i < vector_length(data->keys); i++) {
+        void*         key   = (void*)data->keys->data[i];
+        Float64       value = data->values->data[i];
+        DenseMapItem* item  = dense_map_search(map, key, NULL);
+        if(item) {
+            GroupByBenchAggregate* agg = item->data;
+            agg->sum += value;
+            agg->count++;
+            agg->min = MIN(agg->min, value);
+            agg->max = MAX(agg->max, value);
+        } else {
+            GroupByBenchAggregate agg = {value, 1, value, value};
+            dense_map_insert(map, key, &agg, NULL);
+        }
+    }
+
+    state->sink += map->item_count;
+    dense_map_destroy(map, NULL);
+}
+
+BENCH_FN void group_by_serial_bench(BenchState* state) {
+    GroupByBenchData* data = state->data;
+    GroupByResult     result;
+    group_by_aggregate_f64(data->keys, data->values, &result);
+    state->sink += vector_length(result.keys);
+    group_by_result_destroy(&result);
+}
+
+BENCH_FN void group_by_parallel_bench(BenchState* state) {
+    GroupByBenchData* data = state->data;
+    GroupByResult     result;
+    group_by_aggregate_f64_parallel(NULL, data->keys, data->values, &result);
+    state->sink += vector_length(result.keys);
+    group_by_result_destroy(&result);
+}
+
+#define GROUP_BY_FEW_BENCH(fn, n)  BENCH_WITH_SETUP(fn, group_by_few_setup, group_by_teardown, n)
+#define GROUP_BY_MANY_BENCH(fn, n) BENCH_WITH_SETUP(fn, group_by_many_setup, group_by_teardown, n)
+
+BEGIN_BENCHES(group_by)
+    GROUP_BY_FEW_BENCH(group_by_dense_map_bench, 1048576),
+    GROUP_BY_FEW_BENCH(group_by_serial_bench, 1048576),
+    GROUP_BY_FEW_BENCH(group_by_parallel_bench, 1048576),
+    GROUP_BY_MANY_BENCH(group_by_dense_map_bench, 65536),
+    GROUP_BY_MANY_BENCH(group_by_serial_bench, 65536),
+    GROUP_BY_MANY_BENCH(group_by_parallel_bench, 65536),
+    GROUP_BY_MANY_BENCH(group_by_dense_map_bench, 1048576),
+    GROUP_BY_MANY_BENCH(group_by_serial_bench, 1048576),
+    GROUP_BY_MANY_BENCH(group_by_parallel_bench, 1048576),
+END_BENCHES()
@@ -0,0 +1,109 @@
+/**
+ * @file Maps.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief DenseMap and SparseMap benchmarks, inserting random keys into an
+ * empty map, and looking up present and absent keys in a filled one.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Containers/SparseMap.h>
+
+/* keys that are present in map are random values with lowest bit set, absent ones have it clear */
+static FORCE_INLINE Uint64 map_bench_key(Uint64* seed, Bool present) {
+    return present ? bench_random(seed) | 1 : bench_random(seed) & ~(Uint64)1;
+}
+
+/**
+ * Define setup, teardown and run callbacks for benchmarking a typed map
+ * interface with given api prefix, eg: u64_u64_dense_map.
+ * */
+#define DEF_MAP_BENCHES(map, type)                                      \
+    BENCH_FN void map##_empty_setup(BenchState* state) {                \
+        state->data = map##_create();                                   \
+    }                                                                   \
+                                                                        \
+    BENCH_FN void map##_filled_setup(BenchState* state) {               \
+        type*  m    = map##_create();                                   \
+        Uint64 seed = state->size;                                      \
+        for(Size i = 0; i < state->size; i++) {                         \
+            map##_insert(m, map_bench_key(&seed, True), i, NULL);       \
+        }                                                               \
+        state->data = m;                                                \
+    }                                                                   \
+                                                                        \
+    BENCH_FN void map##_teardown(BenchState* state) {                   \
+        map##_destroy(state->data, NULL);                               \
+        state->data = NULL;                                             \
+    }                                                                   \
+                                                                        \
+    BENCH_FN void map##_insert_bench(BenchState* state) {               \
+        type*  m    = state->data;                                      \
+        Uint64 seed = state->size;                                      \
+        for(Size i = 0; i < state->size; i++) {                         \
+            map##_insert(m, map_bench_key(&seed, True), i, NULL);       \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    BENCH_FN void map##_search_hit_bench(BenchState* state) {           \
+        type*  m    = state->data;                                      \
+        Uint64 seed = state->size;                                      \
+        for(Size i = 0; i < state->size; i++) {                         \
+            state->sink += map##_search(m, map_bench_key(&seed, True), NULL)->data; \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    BENCH_FN void map##_search_miss_bench(BenchState* state) {          \
+        type*  m    = state->data;                                      \
+        Uint64 seed = state->size;                                      \
+        for(Size i = 0; i < state->size; i++) {                         \
+            state->sink += map##_search(m, map_bench_key(&seed, False), NULL) != NULL; \
+        }                                                               \
+    }
+
+DEF_MAP_BENCHES(u64_u64_dense_map, U64_U64_DenseMap);
+DEF_MAP_BENCHES(u64_u64_sparse_map, U64_U64_SparseMap);
+
+#define MAP_INSERT_BENCH(map, n) BENCH_WITH_SETUP(map##_insert_bench, map##_empty_setup, map##_teardown, n)
+#define MAP_SEARCH_BENCH(map, hit_or_miss, n) \
+    BENCH_WITH_SETUP(map##_search_##hit_or_miss##_bench, map##_filled_setup, map##_teardown, n)
+
+BEGIN_BENCHES(dense_map)
+    MAP_INSERT_BENCH(u64_u64_dense_map, 1024),
+    MAP_INSERT_BENCH(u64_u64_dense_map, 65536),
+    MAP_INSERT_BENCH(u64_u64_dense_map, 1048576),
+    MAP_SEARCH_BENCH(u64_u64_dense_map, hit, 1024),
+    MAP_SEARCH_BENCH(u64_u64_dense_map, hit, 65536),
+    MAP_SEARCH_BENCH(u64_u64_dense_map, hit, 1048576),
+    MAP_SEARCH_BENCH(u64_u64_dense_map, miss, 1024),
+    MAP_SEARCH_BENCH(u64_u64_dense_map, miss, 65536),
+    MAP_SEARCH_BENCH(u64_u64_dense_map, miss, 1048576),
+END_BENCHES()
+
+BEGIN_BENCHES(sparse_map)
+    MAP_INSERT_BENCH(u64_u64_sparse_map, 1024),
+    MAP_INSERT_BENCH(u64_u64_sparse_map, 65536),
+    MAP_INSERT_BENCH(u64_u64_sparse_map, 1048576),
+    MAP_SEARCH_BENCH(u64_u64_sparse_map, hit, 1024),
+    MAP_SEARCH_BENCH(u64_u64_sparse_map, hit, 65536),
+    MAP_SEARCH_BENCH(u64_u64_sparse_map, hit, 1048576),
+    MAP_SEARCH_BENCH(u64_u64_sparse_map, miss, 1024),
+    MAP_SEARCH_BENCH(u64_u64_sparse_map, miss, 65536),
+    MAP_SEARCH_BENCH(u64_u64_sparse_map, miss, 1048576),
+END_BENCHES()
@@ -0,0 +1,92 @@
+/**
+ * @file Pipeline.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Pipeline benchmarks, summing tripled values below a threshold of
+ * many random numbers, with a temporary vector after each step, with a
+ * pipeline of callbacks and with a pipeline of numeric stages.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/Pipeline.h>
+
+/* values are uniform below this, and about a quarter of them are kept */
+#define PIPELINE_BENCH_RANGE     1000000
+#define PIPELINE_BENCH_THRESHOLD (PIPELINE_BENCH_RANGE / 4)
+
+static Bool pipeline_bench_below(void* value, void* udata) {
+    UNUSED(udata);
+    return (Uint64)value < PIPELINE_BENCH_THRESHOLD;
+}
+
+static void pipeline_bench_triple(void* dst, void* value, void* udata) {
+    UNUSED(udata);
+    *(Uint64*)dst = (Uint64)value * 3;
+}
+
+BENCH_FN void pipeline_setup(BenchState* state) {
+    U64_Vector* vec  = u64_vector_create();
+    Uint64      seed = state->size;
+    u64_vector_resize(vec, state->size);
+    for(Size i = 0; i < state->size; i++) {
+        vec->data[i] = bench_random(&seed) % PIPELINE_BENCH_RANGE;
+    }
+    state->data = vec;
+}
+
+BENCH_FN void pipeline_teardown(BenchState* state) {
+    u64_vector_destroy(state->data, NULL);
+    state->data = NULL;
+}
+
+BENCH_FN void pipeline_temporaries_bench(BenchState* state) {
+    U64_Vector* vec      = state->data;
+    U64_Vector* filtered = (U64_Vector*)vector_filter((Vector*)vec, pipeline_bench_below, NULL);
+    U64_Vector* tripled  = u64_vector_create();
+    u64_vector_resize(tripled, vector_length(filtered));
+    for(Size i = 0; i < vector_length(filtered); i++) {
+        pipeline_bench_triple(tripled->data + i, (void*)filtered->data[i], NULL);
+    }
+    state->sink += u64_vector_sum(tripled);
+    u64_vector_destroy(tripled, NULL);
+    u64_vector_destroy(filtered, NULL);
+}
+
+BENCH_FN void pipeline_callbacks_bench(BenchState* state) {
+    Pipeline p = u64_pipeline_from_vector(state->data);
+    pipeline_map(pipeline_filter(&p, pipeline_bench_below, NULL), sizeof(Uint64), pipeline_bench_triple, NULL);
+    state->sink += pipeline_sum_u64(&p);
+}
+
+BENCH_FN void pipeline_numeric_bench(BenchState* state) {
+    Pipeline p = u64_pipeline_from_vector(state->data);
+    u64_pipeline_mul(u64_pipeline_retain_lt(&p, PIPELINE_BENCH_THRESHOLD), 3);
+    state->sink += u64_pipeline_sum(&p);
+}
+
+#define PIPELINE_BENCH(fn, n) BENCH_WITH_SETUP(fn, pipeline_setup, pipeline_teardown, n)
+
+BEGIN_BENCHES(pipeline)
+    PIPELINE_BENCH(pipeline_temporaries_bench, 65536),
+    PIPELINE_BENCH(pipeline_callbacks_bench, 65536),
+    PIPELINE_BENCH(pipeline_numeric_bench, 65536),
+    PIPELINE_BENCH(pipeline_temporaries_bench, 1048576),
+    PIPELINE_BENCH(pipeline_callbacks_bench, 1048576),
+    PIPELINE_BENCH(pipeline_numeric_bench, 1048576),
+END_BENCHES()
@@ -0,0 +1,82 @@
+/**
+ * @file PriorityQueue.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Priority queue benchmarks, selecting top k of many random scores
+ * by full sort, partial sort and a bounded heap.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/PriorityQueue.h>
+
+#define TOP_K 100
+
+BENCH_FN void top_k_setup(BenchState* state) {
+    U64_Vector* vec  = u64_vector_create();
+    Uint64      seed = state->size;
+    u64_vector_reserve(vec, state->size);
+    for(Size i = 0; i < state->size; i++) {
+        u64_vector_push_back(vec, bench_random(&seed), NULL);
+    }
+    state->data = vec;
+}
+
+BENCH_FN void top_k_teardown(BenchState* state) {
+    u64_vector_destroy(state->data, NULL);
+    state->data = NULL;
+}
+
+BENCH_FN void top_k_sort_bench(BenchState* state) {
+    U64_Vector* vec = state->data;
+    u64_vector_sort_descending(vec);
+    state->sink += vec->data[TOP_K - 1];
+}
+
+BENCH_FN void top_k_partial_sort_bench(BenchState* state) {
+    U64_Vector* vec = state->data;
+    u64_vector_partial_sort_descending(vec, TOP_K);
+    state->sink += vec->data[TOP_K - 1];
+}
+
+/* smallest of best k is on top, and is replaced whenever a better score shows up */
+BENCH_FN void top_k_heap_bench(BenchState* state) {
+    U64_Vector*        vec = state->data;
+    U64_PriorityQueue* pq  = u64_priority_queue_create(False);
+    u64_priority_queue_reserve(pq, TOP_K);
+    for(Size i = 0; i < vector_length(vec); i++) {
+        Uint64 score = vec->data[i];
+        if(u64_priority_queue_length(pq) < TOP_K) {
+            u64_priority_queue_push(pq, score);
+        } else if(score > u64_priority_queue_peek(pq)) {
+            u64_priority_queue_replace_top(pq, score, NULL);
+        }
+    }
+    state->sink += u64_priority_queue_peek(pq);
+    u64_priority_queue_destroy(pq);
+}
+
+#define TOP_K_BENCH(fn, n) BENCH_WITH_SETUP(fn, top_k_setup, top_k_teardown, n)
+
+BEGIN_BENCHES(priority_queue)
+    TOP_K_BENCH(top_k_sort_bench, 65536),
+    TOP_K_BENCH(top_k_partial_sort_bench, 65536),
+    TOP_K_BENCH(top_k_heap_bench, 65536),
+    TOP_K_BENCH(top_k_sort_bench, 1048576),
+    TOP_K_BENCH(top_k_partial_sort_bench, 1048576),
+    TOP_K_BENCH(top_k_heap_bench, 1048576),
+END_BENCHES()
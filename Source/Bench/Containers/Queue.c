@@ -0,0 +1,100 @@
+/**
+ * @file Queue.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Queue benchmarks, cost of a push and pop pair on an uncontended
+ * queue, one element at a time and in batches.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/Queue.h>
+
+#define QUEUE_BENCH_CAPACITY 1024
+#define QUEUE_BENCH_BATCH 64
+
+BENCH_FN void spsc_queue_bench_setup(BenchState* state) {
+    state->data = u64_spsc_queue_create(QUEUE_BENCH_CAPACITY);
+}
+
+BENCH_FN void spsc_queue_bench_teardown(BenchState* state) {
+    u64_spsc_queue_destroy(state->data);
+    state->data = NULL;
+}
+
+BENCH_FN void mpmc_queue_bench_setup(BenchState* state) {
+    state->data = u64_mpmc_queue_create(QUEUE_BENCH_CAPACITY);
+}
+
+BENCH_FN void mpmc_queue_bench_teardown(BenchState* state) {
+    u64_mpmc_queue_destroy(state->data);
+    state->data = NULL;
+}
+
+BENCH_FN void spsc_queue_push_pop_bench(BenchState* state) {
+    U64_SpscQueue* q = state->data;
+    Uint64         v = 0;
+    for(Size i = 0; i < state->size; i++) {
+        u64_spsc_queue_push(q, i);
+        u64_spsc_queue_pop(q, &v);
+        state->sink += v;
+    }
+}
+
+BENCH_FN void spsc_queue_batch_bench(BenchState* state) {
+    U64_SpscQueue* q = state->data;
+    Uint64         buf[QUEUE_BENCH_BATCH];
+    for(Size i = 0; i < QUEUE_BENCH_BATCH; i++) {
+        buf[i] = i;
+    }
+    for(Size i = 0; i < state->size; i += QUEUE_BENCH_BATCH) {
+        u64_spsc_queue_push_batch(q, buf, QUEUE_BENCH_BATCH);
+        state->sink += u64_spsc_queue_pop_batch(q, buf, QUEUE_BENCH_BATCH);
+    }
+}
+
+BENCH_FN void mpmc_queue_push_pop_bench(BenchState* state) {
+    U64_MpmcQueue* q = state->data;
+    Uint64         v = 0;
+    for(Size i = 0; i < state->size; i++) {
+        u64_mpmc_queue_push(q, i);
+        u64_mpmc_queue_pop(q, &v);
+        state->sink += v;
+    }
+}
+
+BENCH_FN void mpmc_queue_batch_bench(BenchState* state) {
+    U64_MpmcQueue* q = state->data;
+    Uint64         buf[QUEUE_BENCH_BATCH];
+    for(Size i = 0; i < QUEUE_BENCH_BATCH; i++) {
+        buf[i] = i;
+    }
+    for(Size i = 0; i < state->size; i += QUEUE_BENCH_BATCH) {
+        u64_mpmc_queue_push_batch(q, buf, QUEUE_BENCH_BATCH);
+        state->sink += u64_mpmc_queue_pop_batch(q, buf, QUEUE_BENCH_BATCH);
+    }
+}
+
+#define SPSC_QUEUE_BENCH(fn, n) BENCH_WITH_SETUP(fn, spsc_queue_bench_setup, spsc_queue_bench_teardown, n)
+#define MPMC_QUEUE_BENCH(fn, n) BENCH_WITH_SETUP(fn, mpmc_queue_bench_setup, mpmc_queue_bench_teardown, n)
+
+BEGIN_BENCHES(queue)
+    SPSC_QUEUE_BENCH(spsc_queue_push_pop_bench, 65536),
+    SPSC_QUEUE_BENCH(spsc_queue_batch_bench, 65536),
+    MPMC_QUEUE_BENCH(mpmc_queue_push_pop_bench, 65536),
+    MPMC_QUEUE_BENCH(mpmc_queue_batch_bench, 65536),
+END_BENCHES()
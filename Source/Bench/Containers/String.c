@@ -0,0 +1,68 @@
+/**
+ * @file String.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief String benchmarks, appending short strings, characters and numbers.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/String.h>
+
+BENCH_FN void str_bench_setup(BenchState* state) {
+    state->data = str_create("");
+}
+
+BENCH_FN void str_bench_teardown(BenchState* state) {
+    str_destroy(state->data);
+    state->data = NULL;
+}
+
+BENCH_FN void str_push_zstr_bench(BenchState* state) {
+    String* str = state->data;
+    for(Size i = 0; i < state->size; i++) {
+        str_push_zstr(str, "anvie");
+    }
+    state->sink += str->length;
+}
+
+BENCH_FN void str_push_char_bench(BenchState* state) {
+    String* str = state->data;
+    for(Size i = 0; i < state->size; i++) {
+        str_push_char(str, (Char)('a' + (i & 15)));
+    }
+    state->sink += str->length;
+}
+
+BENCH_FN void str_push_u64_bench(BenchState* state) {
+    String* str = state->data;
+    for(Size i = 0; i < state->size; i++) {
+        str_push_u64(str, i * 2654435761u);
+    }
+    state->sink += str->length;
+}
+
+#define STR_BENCH(fn, n) BENCH_WITH_SETUP(fn, str_bench_setup, str_bench_teardown, n)
+
+BEGIN_BENCHES(string)
+    STR_BENCH(str_push_zstr_bench, 1024),
+    STR_BENCH(str_push_zstr_bench, 1048576),
+    STR_BENCH(str_push_char_bench, 1024),
+    STR_BENCH(str_push_char_bench, 1048576),
+    STR_BENCH(str_push_u64_bench, 1024),
+    STR_BENCH(str_push_u64_bench, 1048576),
+END_BENCHES()
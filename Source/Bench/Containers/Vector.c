@@ -0,0 +1,64 @@
+/**
+ * @file Vector.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Vector benchmarks, appending elements one by one and sorting.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Containers/Vector.h>
+
+BENCH_FN void vector_push_back_bench(BenchState* state) {
+    U64_Vector* vec = u64_vector_create();
+    for(Size i = 0; i < state->size; i++) {
+        u64_vector_push_back(vec, i, NULL);
+    }
+    state->sink += vector_length(vec);
+    u64_vector_destroy(vec, NULL);
+}
+
+/* vector of random values, sorted by each run */
+BENCH_FN void vector_sort_setup(BenchState* state) {
+    U64_Vector* vec  = u64_vector_create();
+    Uint64      seed = state->size;
+    u64_vector_reserve(vec, state->size);
+    for(Size i = 0; i < state->size; i++) {
+        u64_vector_push_back(vec, bench_random(&seed), NULL);
+    }
+    state->data = vec;
+}
+
+BENCH_FN void vector_sort_teardown(BenchState* state) {
+    u64_vector_destroy(state->data, NULL);
+    state->data = NULL;
+}
+
+BENCH_FN void vector_sort_bench(BenchState* state) {
+    U64_Vector* vec = state->data;
+    u64_vector_sort_ascending(vec);
+    state->sink += u64_vector_data(vec)[0];
+}
+
+BEGIN_BENCHES(vector)
+    BENCH(vector_push_back_bench, 1024),
+    BENCH(vector_push_back_bench, 65536),
+    BENCH(vector_push_back_bench, 1048576),
+    BENCH_WITH_SETUP(vector_sort_bench, vector_sort_setup, vector_sort_teardown, 1024),
+    BENCH_WITH_SETUP(vector_sort_bench, vector_sort_setup, vector_sort_teardown, 65536),
+    BENCH_WITH_SETUP(vector_sort_bench, vector_sort_setup, vector_sort_teardown, 1048576),
+END_BENCHES()
@@ -0,0 +1,41 @@
+/**
+ * @file ImportBenches.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Imports benchmark suites defined in different units.
+ * */
+
+#ifndef ANVIE_UTILS_BENCH_IMPORT_BENCHES_H
+#define ANVIE_UTILS_BENCH_IMPORT_BENCHES_H
+
+#include <Anvie/Test/Bench.h>
+
+IMPORT_BENCHES(vector)
+IMPORT_BENCHES(bitvector)
+IMPORT_BENCHES(dense_map)
+IMPORT_BENCHES(sparse_map)
+IMPORT_BENCHES(string)
+IMPORT_BENCHES(lballoc)
+IMPORT_BENCHES(entropy)
+IMPORT_BENCHES(thread_pool)
+IMPORT_BENCHES(queue)
+IMPORT_BENCHES(priority_queue)
+IMPORT_BENCHES(group_by)
+IMPORT_BENCHES(pipeline)
+
+#endif // ANVIE_UTILS_BENCH_IMPORT_BENCHES_H
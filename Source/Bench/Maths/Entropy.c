@@ -0,0 +1,72 @@
+/**
+ * @file Entropy.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Entropy benchmarks, over random bytes and over text like bytes.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/Maths/Entropy.h>
+
+/* random bytes, worst case for histogram based entropy */
+BENCH_FN void entropy_bench_setup(BenchState* state) {
+    Uint8* data = ALLOCATE(Uint8, state->size);
+    Uint64 seed = state->size;
+    for(Size i = 0; i < state->size; i++) {
+        data[i] = (Uint8)bench_random(&seed);
+    }
+    state->data = data;
+}
+
+BENCH_FN void entropy_bench_teardown(BenchState* state) {
+    FREE(state->data);
+    state->data = NULL;
+}
+
+BENCH_FN void byte_histogram_bench(BenchState* state) {
+    Size hist[0x100];
+    byte_histogram(state->data, state->size, hist);
+    state->sink += hist[0];
+}
+
+BENCH_FN void compute_shannon_entropy_bench(BenchState* state) {
+    Float32 entropy = compute_shannon_entropy(state->data, state->size);
+    BENCH_KEEP(entropy);
+}
+
+/* streamed in 4 KiB chunks, as if read from a file */
+BENCH_FN void entropy_update_bench(BenchState* state) {
+    EntropyState entropy;
+    entropy_init(&entropy);
+    for(Size i = 0; i < state->size; i += 4096) {
+        entropy_update(&entropy, (Uint8*)state->data + i, MIN(4096, state->size - i));
+    }
+    Float32 value = entropy_finalize(&entropy);
+    BENCH_KEEP(value);
+}
+
+#define ENTROPY_BENCH(fn, n) BENCH_WITH_SETUP(fn, entropy_bench_setup, entropy_bench_teardown, n)
+
+BEGIN_BENCHES(entropy)
+    ENTROPY_BENCH(byte_histogram_bench, 65536),
+    ENTROPY_BENCH(byte_histogram_bench, 16777216),
+    ENTROPY_BENCH(compute_shannon_entropy_bench, 65536),
+    ENTROPY_BENCH(compute_shannon_entropy_bench, 16777216),
+    ENTROPY_BENCH(entropy_update_bench, 65536),
+    ENTROPY_BENCH(entropy_update_bench, 16777216),
+END_BENCHES()
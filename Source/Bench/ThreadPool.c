@@ -0,0 +1,91 @@
+/**
+ * @file ThreadPool.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Thread pool benchmarks, overhead of spawning tasks and of
+ * splitting a cheap loop with parallel_for. Both run on default pool.
+ * */
+
+#include <Anvie/Test/Bench.h>
+#include <Anvie/ThreadPool.h>
+
+BENCH_FN void parallel_for_bench_setup(BenchState* state) {
+    Uint64* data = ALLOCATE(Uint64, state->size);
+    Uint64  seed = state->size;
+    for(Size i = 0; i < state->size; i++) {
+        data[i] = bench_random(&seed);
+    }
+    state->data = data;
+
+    /* create default pool outside of timed region */
+    thread_pool_default();
+}
+
+BENCH_FN void parallel_for_bench_teardown(BenchState* state) {
+    FREE(state->data);
+    state->data = NULL;
+}
+
+typedef struct SumJob {
+    const Uint64* data;
+    Uint64        sum;
+} SumJob;
+
+static void sum_range(Size begin, Size end, void* udata) {
+    SumJob* job = (SumJob*)udata;
+    Uint64  sum = 0;
+    for(Size i = begin; i < end; i++) {
+        sum += job->data[i];
+    }
+    __atomic_fetch_add(&job->sum, sum, __ATOMIC_RELAXED);
+}
+
+BENCH_FN void parallel_for_sum_bench(BenchState* state) {
+    SumJob job = {.data = state->data};
+    parallel_for(NULL, 0, state->size, 0, sum_range, &job);
+    state->sink += job.sum;
+}
+
+/* every iteration its own call, shows cost of a single task */
+BENCH_FN void parallel_for_grain1_bench(BenchState* state) {
+    SumJob job = {.data = state->data};
+    parallel_for(NULL, 0, state->size, 1, sum_range, &job);
+    state->sink += job.sum;
+}
+
+static void empty_task(void* udata) {
+    UNUSED(udata);
+}
+
+BENCH_FN void task_group_spawn_bench(BenchState* state) {
+    TaskGroup group;
+    task_group_init(&group, NULL);
+    for(Size i = 0; i < state->size; i++) {
+        task_group_spawn(&group, empty_task, NULL);
+    }
+    task_group_wait(&group);
+}
+
+#define THREAD_POOL_BENCH(fn, n) BENCH_WITH_SETUP(fn, parallel_for_bench_setup, parallel_for_bench_teardown, n)
+
+BEGIN_BENCHES(thread_pool)
+    THREAD_POOL_BENCH(parallel_for_sum_bench, 65536),
+    THREAD_POOL_BENCH(parallel_for_sum_bench, 16777216),
+    THREAD_POOL_BENCH(parallel_for_grain1_bench, 65536),
+    THREAD_POOL_BENCH(task_group_spawn_bench, 65536),
+END_BENCHES()
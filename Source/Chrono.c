@@ -0,0 +1,91 @@
+/**
+ * @file Chrono.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Calibration of cycle counter of @c Anvie/Chrono/Cycles.h.
+ * */
+
+#include <Anvie/Chrono/Cycles.h>
+
+#ifndef CHRONO_CALIBRATION_NANOSECONDS
+/**
+ * Time spent on counting cycles against monotonic clock, on first conversion.
+ * Longer calibration gives a more accurate frequency.
+ * */
+#define CHRONO_CALIBRATION_NANOSECONDS 10000000
+#endif // CHRONO_CALIBRATION_NANOSECONDS
+
+/* cycles per second, 0 until first calibration */
+static Uint64 chrono_frequency = 0;
+
+/**
+ * Measure frequency of cycle counter. AArch64 reports it in a register,
+ * otherwise counter is read at both ends of a short busy wait on monotonic
+ * clock.
+ * */
+static Uint64 chrono_calibrate(void) {
+#if defined(__aarch64__)
+    Uint64 frequency;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return frequency;
+#elif defined(__x86_64__) || defined(__i386__)
+    Uint64 ns_start     = chrono_monotonic_nanoseconds();
+    Uint64 cycles_start = chrono_cycles_ordered();
+    Uint64 ns_end;
+    do {
+        ns_end = chrono_monotonic_nanoseconds();
+    } while(ns_end - ns_start < CHRONO_CALIBRATION_NANOSECONDS);
+    Uint64 cycles_end = chrono_cycles_ordered();
+
+    return (Uint64)((Float64)(cycles_end - cycles_start) * 1e9 / (Float64)(ns_end - ns_start));
+#else
+    /* counter is monotonic clock itself */
+    return 1000000000;
+#endif
+}
+
+/**
+ * Number of cycle counter ticks in a second. Calibrated on first call, so
+ * first call may take @c CHRONO_CALIBRATION_NANOSECONDS, call it once during
+ * setup to keep that out of measurements.
+ *
+ * @return Cycles per second.
+ * */
+Uint64 chrono_cycles_frequency(void) {
+    Uint64 frequency = __atomic_load_n(&chrono_frequency, __ATOMIC_RELAXED);
+    if(!frequency) {
+        /* racing threads may both calibrate, any of their results is fine */
+        frequency = chrono_calibrate();
+        frequency = MAX(frequency, 1);
+        __atomic_store_n(&chrono_frequency, frequency, __ATOMIC_RELAXED);
+    }
+    return frequency;
+}
+
+/**
+ * Convert a number of cycles, eg: difference of two @c chrono_cycles
+ * readings, to nanoseconds.
+ *
+ * @param cycles Number of cycles.
+ * @return Nanoseconds.
+ * */
+Uint64 chrono_cycles_to_nanoseconds(Uint64 cycles) {
+    Uint64 frequency = chrono_cycles_frequency();
+
+    /* whole seconds first, so that multiplying remainder by 1e9 can't overflow */
+    return cycles / frequency * 1000000000 + cycles % frequency * 1000000000 / frequency;
+}
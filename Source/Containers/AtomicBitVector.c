@@ -0,0 +1,316 @@
+/**
+ * @file AtomicBitVector.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c AtomicBitVector in Containers/AtomicBitVector.h
+ * */
+
+#include <Anvie/Containers/AtomicBitVector.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+#define WORD_LOAD(w) __atomic_load_n(&(w), __ATOMIC_ACQUIRE)
+#define WORD_FETCH_OR(w, m) __atomic_fetch_or(&(w), (m), __ATOMIC_ACQ_REL)
+#define WORD_FETCH_AND(w, m) __atomic_fetch_and(&(w), (m), __ATOMIC_ACQ_REL)
+
+/* mask of bits of given word that are inside vector */
+static FORCE_INLINE Uint64 word_valid_mask(const AtomicBitVector* abv, Size word_index) {
+    Size tail = abv->length & 63;
+    return (word_index + 1 == abv->word_count && tail) ? ((Uint64)1 << tail) - 1 : ~(Uint64)0;
+}
+
+/**
+ * Create a new @c AtomicBitVector with given number of bits, all clear.
+ * @param length Number of bits. Must be non-zero.
+ * @return AtomicBitVector* on success.
+ * @return INVALID_ATOMIC_BITVECTOR otherwise.
+ * */
+AtomicBitVector* atomic_bitvec_create(Size length) {
+    return atomic_bitvec_create_with_allocator(length, NULL);
+}
+
+/**
+ * Create a new @c AtomicBitVector with given number of bits, all clear,
+ * allocating all it's memory from given allocator.
+ * @param length Number of bits. Must be non-zero.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return AtomicBitVector* on success.
+ * @return INVALID_ATOMIC_BITVECTOR otherwise.
+ * */
+AtomicBitVector* atomic_bitvec_create_with_allocator(Size length, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(length, INVALID_ATOMIC_BITVECTOR, ERR_INVALID_ARGUMENTS);
+
+    AtomicBitVector* abv = allocator_allocate_zeroed(allocator, sizeof(AtomicBitVector));
+    ERR_RETURN_VALUE_IF_FAIL(abv, INVALID_ATOMIC_BITVECTOR, ERR_OUT_OF_MEMORY);
+
+    abv->word_count = (length + 63) / 64;
+    abv->words      = allocator_allocate_zeroed(allocator, abv->word_count * sizeof(Uint64));
+    if(!abv->words) {
+        allocator_free(allocator, abv, sizeof(AtomicBitVector));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return INVALID_ATOMIC_BITVECTOR;
+    }
+
+    /* atomic operations on words need natural alignment */
+    if((Size)abv->words & (sizeof(Uint64) - 1)) {
+        allocator_free(allocator, abv->words, abv->word_count * sizeof(Uint64));
+        allocator_free(allocator, abv, sizeof(AtomicBitVector));
+        ERR(__FUNCTION__, "Allocator returned memory not aligned to 8 bytes\n");
+        return INVALID_ATOMIC_BITVECTOR;
+    }
+
+    abv->length    = length;
+    abv->allocator = allocator;
+    return abv;
+}
+
+/**
+ * Destroy given @c AtomicBitVector.
+ * No other thread may be using it.
+ * @param abv
+ * */
+void atomic_bitvec_destroy(AtomicBitVector* abv) {
+    ERR_RETURN_IF_FAIL(abv, ERR_INVALID_ARGUMENTS);
+
+    allocator_free(abv->allocator, abv->words, abv->word_count * sizeof(Uint64));
+    allocator_free(abv->allocator, abv, sizeof(AtomicBitVector));
+}
+
+/**
+ * Get value of bit at given index.
+ * @param abv
+ * @param index
+ * */
+Bool atomic_bitvec_peek(AtomicBitVector* abv, Size index) {
+    ERR_RETURN_VALUE_IF_FAIL(abv && index < abv->length, False, ERR_INVALID_ARGUMENTS);
+
+    return (WORD_LOAD(abv->words[atomic_bitvec_word_index(index)]) & atomic_bitvec_bit_mask(index)) != 0;
+}
+
+/**
+ * Set bit at given index.
+ * @param abv
+ * @param index
+ * */
+void atomic_bitvec_set(AtomicBitVector* abv, Size index) {
+    ERR_RETURN_IF_FAIL(abv && index < abv->length, ERR_INVALID_ARGUMENTS);
+
+    WORD_FETCH_OR(abv->words[atomic_bitvec_word_index(index)], atomic_bitvec_bit_mask(index));
+}
+
+/**
+ * Clear bit at given index.
+ * @param abv
+ * @param index
+ * */
+void atomic_bitvec_clear(AtomicBitVector* abv, Size index) {
+    ERR_RETURN_IF_FAIL(abv && index < abv->length, ERR_INVALID_ARGUMENTS);
+
+    WORD_FETCH_AND(abv->words[atomic_bitvec_word_index(index)], ~atomic_bitvec_bit_mask(index));
+}
+
+/**
+ * Set bit at given index and get it's previous value.
+ * Exactly one of many threads setting same bit at once gets False.
+ * @param abv
+ * @param index
+ * @return True if bit was already set.
+ * */
+Bool atomic_bitvec_test_and_set(AtomicBitVector* abv, Size index) {
+    ERR_RETURN_VALUE_IF_FAIL(abv && index < abv->length, False, ERR_INVALID_ARGUMENTS);
+
+    Uint64 mask = atomic_bitvec_bit_mask(index);
+    return (WORD_FETCH_OR(abv->words[atomic_bitvec_word_index(index)], mask) & mask) != 0;
+}
+
+/**
+ * Clear bit at given index and get it's previous value.
+ * Exactly one of many threads clearing same bit at once gets True.
+ * @param abv
+ * @param index
+ * @return True if bit was set.
+ * */
+Bool atomic_bitvec_test_and_clear(AtomicBitVector* abv, Size index) {
+    ERR_RETURN_VALUE_IF_FAIL(abv && index < abv->length, False, ERR_INVALID_ARGUMENTS);
+
+    Uint64 mask = atomic_bitvec_bit_mask(index);
+    return (WORD_FETCH_AND(abv->words[atomic_bitvec_word_index(index)], ~mask) & mask) != 0;
+}
+
+/**
+ * Get all 64 bits of word at given index.
+ * @param abv
+ * @param word_index Index of word, bit @c i is in word @c (i / 64).
+ * */
+Uint64 atomic_bitvec_load_word(AtomicBitVector* abv, Size word_index) {
+    ERR_RETURN_VALUE_IF_FAIL(abv && word_index < abv->word_count, 0, ERR_INVALID_ARGUMENTS);
+
+    return WORD_LOAD(abv->words[word_index]);
+}
+
+/**
+ * Set all bits of given mask in word at given index in a single atomic
+ * operation. Bits of mask past length of vector are ignored.
+ * @param abv
+ * @param word_index Index of word, bit @c i is in word @c (i / 64).
+ * @param mask Bits to be set.
+ * @return Value of word before operation.
+ * */
+Uint64 atomic_bitvec_fetch_or(AtomicBitVector* abv, Size word_index, Uint64 mask) {
+    ERR_RETURN_VALUE_IF_FAIL(abv && word_index < abv->word_count, 0, ERR_INVALID_ARGUMENTS);
+
+    return WORD_FETCH_OR(abv->words[word_index], mask & word_valid_mask(abv, word_index));
+}
+
+/**
+ * Keep only bits of given mask in word at given index in a single atomic
+ * operation.
+ * @param abv
+ * @param word_index Index of word, bit @c i is in word @c (i / 64).
+ * @param mask Bits to be kept, all others are cleared.
+ * @return Value of word before operation.
+ * */
+Uint64 atomic_bitvec_fetch_and(AtomicBitVector* abv, Size word_index, Uint64 mask) {
+    ERR_RETURN_VALUE_IF_FAIL(abv && word_index < abv->word_count, 0, ERR_INVALID_ARGUMENTS);
+
+    return WORD_FETCH_AND(abv->words[word_index], mask);
+}
+
+/**
+ * Atomically set one clear bit of given word among bits in @p allowed.
+ * The lowest clear bit is tried first. If another thread sets it first,
+ * the word value returned by the failed attempt is used to pick another.
+ * @return Index of claimed bit in word, or SIZE_MAX if all allowed bits are set.
+ * */
+static Size claim_in_word(AtomicBitVector* abv, Size word_index, Uint64 allowed) {
+    Uint64* word  = abv->words + word_index;
+    Uint64  value = WORD_LOAD(*word);
+
+    for(Uint64 free = ~value & allowed; free; free = ~value & allowed) {
+        Uint64 bit = free & (~free + 1);
+        value = WORD_FETCH_OR(*word, bit);
+        if(!(value & bit)) {
+            return (Size)__builtin_ctzll(bit);
+        }
+        value |= bit;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Find a clear bit and set it, without locks. Each bit is claimed by
+ * exactly one caller, no matter how many threads claim at once.
+ * @param abv
+ * @return Index of claimed bit.
+ * @return SIZE_MAX if all bits are set.
+ * */
+Size atomic_bitvec_claim_first_clear(AtomicBitVector* abv) {
+    return atomic_bitvec_claim_next_clear(abv, 0);
+}
+
+/**
+ * Same as @c atomic_bitvec_claim_first_clear, but search starts at given
+ * index and wraps around to beginning. Starting different threads at
+ * different positions keeps them from fighting over the same word.
+ * @param abv
+ * @param from Index to start search at. Wrapped to length of vector.
+ * @return Index of claimed bit.
+ * @return SIZE_MAX if all bits are set.
+ * */
+Size atomic_bitvec_claim_next_clear(AtomicBitVector* abv, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(abv, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    from %= abv->length;
+    Size   first = atomic_bitvec_word_index(from);
+    Uint64 head  = ~(Uint64)0 << (from & 63);
+
+    for(Size i = 0; i <= abv->word_count; i++) {
+        Size w = (first + i) % abv->word_count;
+
+        /* first word is visited twice, for bits after and before from */
+        Uint64 allowed = word_valid_mask(abv, w);
+        if(i == 0) allowed &= head;
+        else if(i == abv->word_count) allowed &= ~head;
+
+        if(!allowed) continue;
+        Size bit = claim_in_word(abv, w, allowed);
+        if(bit != SIZE_MAX) {
+            return w * 64 + bit;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Clear all bits. Each word is cleared atomically, but a thread running
+ * concurrently may see some words cleared and others not yet.
+ * @param abv
+ * */
+void atomic_bitvec_clear_all(AtomicBitVector* abv) {
+    ERR_RETURN_IF_FAIL(abv, ERR_INVALID_ARGUMENTS);
+
+    for(Size w = 0; w < abv->word_count; w++) {
+        __atomic_store_n(abv->words + w, 0, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * Count set bits. Result is exact only if no thread modifies
+ * vector concurrently.
+ * @param abv
+ * */
+Size atomic_bitvec_popcount(AtomicBitVector* abv) {
+    ERR_RETURN_VALUE_IF_FAIL(abv, 0, ERR_INVALID_ARGUMENTS);
+
+    Size count = 0;
+    for(Size w = 0; w < abv->word_count; w++) {
+        count += (Size)__builtin_popcountll(WORD_LOAD(abv->words[w]));
+    }
+    return count;
+}
+
+/**
+ * Copy bits to a new @c BitVector of same length, for example to run
+ * @c BitVector queries once all threads are done.
+ * @param abv
+ * @return BitVector* on success, using allocator of @p abv.
+ * @return INVALID_BITVECTOR otherwise.
+ * */
+BitVector* atomic_bitvec_to_bitvec(AtomicBitVector* abv) {
+    ERR_RETURN_VALUE_IF_FAIL(abv, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
+
+    BitVector* bv = bitvec_create_with_allocator(abv->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_INVALID_OBJECT);
+
+    bitvec_resize(bv, abv->length);
+    if(bv->length != abv->length) {
+        bitvec_destroy(bv);
+        return INVALID_BITVECTOR;
+    }
+
+    /* bit i of a word is bit i % 8 of byte i / 8 on little endian machines */
+    for(Size w = 0; w < abv->word_count; w++) {
+        Uint64 word = WORD_LOAD(abv->words[w]);
+        memcpy(bv->data + w * sizeof(Uint64), &word, sizeof(Uint64));
+    }
+
+    return bv;
+}
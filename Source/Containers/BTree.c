@@ -0,0 +1,951 @@
+/**
+ * @file BTree.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Ordered map stored as a B+tree, with items kept sorted by key in
+ * leaves that are linked together for range iteration.
+ * */
+
+#include <Anvie/Containers/BTree.h>
+#include <Anvie/Error.h>
+#include <Anvie/Simd/Simd.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* minimum number of keys in any node other than root */
+#define BTREE_MIN_KEYS (BTREE_ORDER / 2)
+
+/* a tree with minimum fan out at every level has far fewer levels than this before running out of memory */
+#define BTREE_MAX_HEIGHT 32
+
+/* nodes are aligned to cache lines, so a key array starts on one */
+#define BTREE_NODE_ALIGNMENT 64
+
+/**
+ * Header common to leaves and inner nodes.
+ *
+ * Search keys are kept apart from items and children so that search within
+ * a node reads only them. For integer keys, they're order preserving 64 bit
+ * integers. For generic keys, they're keys in stored form, and in inner
+ * nodes they're separate copies when keys need copying.
+ * */
+typedef struct BTreeNode {
+    Uint64 keys[BTREE_ORDER] __attribute__((aligned(BTREE_NODE_ALIGNMENT)));
+    Uint32 count;   /**< Number of keys in node. */
+    Bool   is_leaf;
+} BTreeNode;
+
+typedef struct BTreeLeaf {
+    BTreeNode         node;
+    BTreeItem         items[BTREE_ORDER];
+    struct BTreeLeaf* prev;
+    struct BTreeLeaf* next;
+} BTreeLeaf;
+
+/* children[i] holds keys less than keys[i], children[i + 1] keys not less than it */
+typedef struct BTreeInner {
+    BTreeNode  node;
+    BTreeNode* children[BTREE_ORDER + 1];
+} BTreeInner;
+
+#define TO_LEAF(n) ((BTreeLeaf*)(n))
+#define TO_INNER(n) ((BTreeInner*)(n))
+#define IS_INTEGER_KEYED(tree) ((tree)->key_kind != BTREE_KEY_GENERIC)
+
+/* separators in inner nodes are copies of keys only for generic keys that need copying */
+#define OWNS_SEPARATORS(tree) (!IS_INTEGER_KEYED(tree) && ((tree)->create_key_copy || (tree)->key_size > 8))
+
+static BTreeNode* node_create(Bool is_leaf);
+static void*      load_packed(const void* src, Size size);
+static void       node_destroy(BTree* tree, BTreeNode* node, void* udata);
+static Bool       value_create(Size size, CreateElementCopyCallback create, void* src, void** dst, void* udata);
+static void       value_destroy(Size size, DestroyElementCopyCallback destroy, void** slot, void* udata);
+static Uint64     search_key(BTree* tree, void* key);
+static Size       node_rank(BTree* tree, BTreeNode* node, Uint64 key, Bool inclusive, void* udata);
+static Uint64     separator_create(BTree* tree, Uint64 key, void* udata);
+static void       separator_destroy(BTree* tree, Uint64 separator, void* udata);
+static BTreeLeaf* leaf_find(BTree* tree, Uint64 key, BTreeInner** path, Size* path_idx, void* udata);
+static void       insert_into_parent(BTree* tree, BTreeInner** path, Size* path_idx, Size depth, BTreeNode* right, Uint64 separator);
+static void       rebalance_leaf(BTree* tree, BTreeInner** path, Size* path_idx, Size depth, BTreeLeaf* leaf, void* udata);
+
+/**
+ * Create a new B-tree with keys compared by a callback.
+ * Like vectors, for both key and data, either give both copy constructor
+ * and destructor or none of them.
+ *
+ * @param key_size Size of key in bytes.
+ * @param create_key_copy Copy constructor for key. Can be NULL.
+ * @param destroy_key_copy Copy destructor for key. Can be NULL.
+ * @param compare_key Key comparator, receives keys in same form as they're
+ * passed to @c btree_insert. Cannot be NULL.
+ * @param data_size Size of data in bytes.
+ * @param create_data_copy Copy constructor for data. Can be NULL.
+ * @param destroy_data_copy Copy destructor for data. Can be NULL.
+ * @return New B-tree on success, NULL otherwise.
+ * */
+BTree* btree_create(
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy
+) {
+    ERR_RETURN_VALUE_IF_FAIL(key_size && data_size && compare_key, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!create_key_copy == !destroy_key_copy, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!create_data_copy == !destroy_data_copy, NULL, ERR_INVALID_ARGUMENTS);
+
+    BTree* tree = NEW(BTree);
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_OUT_OF_MEMORY);
+
+    tree->key_kind          = BTREE_KEY_GENERIC;
+    tree->key_size          = key_size;
+    tree->create_key_copy   = create_key_copy;
+    tree->destroy_key_copy  = destroy_key_copy;
+    tree->compare_key       = compare_key;
+    tree->data_size         = data_size;
+    tree->create_data_copy  = create_data_copy;
+    tree->destroy_data_copy = destroy_data_copy;
+
+    return tree;
+}
+
+/**
+ * Create a new B-tree with integer keys. Keys are compared directly, which
+ * lets search within a node use SIMD compares.
+ *
+ * @param key_size Size of key in bytes : 1, 2, 4 or 8.
+ * @param is_signed Whether keys are signed integers.
+ * @param data_size Size of data in bytes.
+ * @param create_data_copy Copy constructor for data. Can be NULL.
+ * @param destroy_data_copy Copy destructor for data. Can be NULL.
+ * @return New B-tree on success, NULL otherwise.
+ * */
+BTree* btree_create_integer(
+    Size                       key_size,
+    Bool                       is_signed,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy
+) {
+    ERR_RETURN_VALUE_IF_FAIL(key_size == 1 || key_size == 2 || key_size == 4 || key_size == 8, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(data_size, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!create_data_copy == !destroy_data_copy, NULL, ERR_INVALID_ARGUMENTS);
+
+    BTree* tree = NEW(BTree);
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_OUT_OF_MEMORY);
+
+    tree->key_kind          = is_signed ? BTREE_KEY_SIGNED : BTREE_KEY_UNSIGNED;
+    tree->key_size          = key_size;
+    tree->data_size         = data_size;
+    tree->create_data_copy  = create_data_copy;
+    tree->destroy_data_copy = destroy_data_copy;
+
+    return tree;
+}
+
+/**
+ * Destroy given B-tree along with copies of all keys and data.
+ *
+ * @param tree
+ * @param udata User data passed to copy destructors.
+ * */
+void btree_destroy(BTree* tree, void* udata) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    btree_clear(tree, udata);
+    FREE(tree);
+}
+
+/**
+ * Remove all items from given B-tree.
+ *
+ * @param tree
+ * @param udata User data passed to copy destructors.
+ * */
+void btree_clear(BTree* tree, void* udata) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+
+    if(tree->root) {
+        node_destroy(tree, tree->root, udata);
+    }
+
+    tree->root       = NULL;
+    tree->first      = NULL;
+    tree->last       = NULL;
+    tree->height     = 0;
+    tree->item_count = 0;
+}
+
+/**
+ * Insert a key and it's data. If key is already present, it's data is
+ * replaced with a copy of new data.
+ *
+ * @param tree
+ * @param key Key value if key is at most 8 bytes, pointer to key otherwise.
+ * @param data Data value if data is at most 8 bytes, pointer to data otherwise.
+ * @param udata User data passed to callbacks.
+ * @return Item holding key, valid till next insertion or deletion. NULL on failure.
+ * */
+BTreeItem* btree_insert(BTree* tree, void* key, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_INVALID_ARGUMENTS);
+
+    if(!tree->root) {
+        BTreeLeaf* leaf = TO_LEAF(node_create(True));
+        ERR_RETURN_VALUE_IF_FAIL(leaf, NULL, ERR_OUT_OF_MEMORY);
+        tree->root   = &leaf->node;
+        tree->first  = leaf;
+        tree->last   = leaf;
+        tree->height = 1;
+    }
+
+    Uint64      skey = search_key(tree, key);
+    BTreeInner* path[BTREE_MAX_HEIGHT];
+    Size        path_idx[BTREE_MAX_HEIGHT];
+    BTreeLeaf*  leaf = leaf_find(tree, skey, path, path_idx, udata);
+    Size        pos  = node_rank(tree, &leaf->node, skey, False, udata);
+
+    /* replace data of an existing key */
+    if(pos < leaf->node.count && node_rank(tree, &leaf->node, skey, True, udata) > pos) {
+        BTreeItem* item = &leaf->items[pos];
+        void* copy;
+        ERR_RETURN_VALUE_IF_FAIL(value_create(tree->data_size, tree->create_data_copy, data, &copy, udata), NULL, ERR_OUT_OF_MEMORY);
+        value_destroy(tree->data_size, tree->destroy_data_copy, &item->data, udata);
+        item->data = copy;
+        return item;
+    }
+
+    BTreeItem item;
+    ERR_RETURN_VALUE_IF_FAIL(value_create(tree->key_size, tree->create_key_copy, key, &item.key, udata), NULL, ERR_OUT_OF_MEMORY);
+    if(!value_create(tree->data_size, tree->create_data_copy, data, &item.data, udata)) {
+        value_destroy(tree->key_size, tree->destroy_key_copy, &item.key, udata);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+    /* generic keys are searched in stored form */
+    Uint64 stored = IS_INTEGER_KEYED(tree) ? skey : (Uint64)item.key;
+
+    /* split full leaf, upper half goes to a new leaf on right */
+    if(leaf->node.count == BTREE_ORDER) {
+        BTreeLeaf* right = TO_LEAF(node_create(True));
+        if(!right) {
+            value_destroy(tree->key_size, tree->destroy_key_copy, &item.key, udata);
+            value_destroy(tree->data_size, tree->destroy_data_copy, &item.data, udata);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+            return NULL;
+        }
+
+        Size half = BTREE_ORDER / 2;
+        memcpy(right->node.keys, leaf->node.keys + half, half * sizeof(Uint64));
+        memcpy(right->items, leaf->items + half, half * sizeof(BTreeItem));
+        right->node.count = half;
+        leaf->node.count  = half;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        if(leaf->next) leaf->next->prev = right;
+        else tree->last = right;
+        leaf->next = right;
+
+        if(pos > half) {
+            leaf = right;
+            pos -= half;
+        }
+
+        /* new item may become first key of right leaf, so separator is taken after insertion */
+        memmove(leaf->node.keys + pos + 1, leaf->node.keys + pos, (leaf->node.count - pos) * sizeof(Uint64));
+        memmove(leaf->items + pos + 1, leaf->items + pos, (leaf->node.count - pos) * sizeof(BTreeItem));
+        leaf->node.keys[pos] = stored;
+        leaf->items[pos]     = item;
+        leaf->node.count++;
+        tree->item_count++;
+
+        Size depth = tree->height - 1;
+        insert_into_parent(tree, path, path_idx, depth, &right->node, separator_create(tree, right->node.keys[0], udata));
+        return &leaf->items[pos];
+    }
+
+    memmove(leaf->node.keys + pos + 1, leaf->node.keys + pos, (leaf->node.count - pos) * sizeof(Uint64));
+    memmove(leaf->items + pos + 1, leaf->items + pos, (leaf->node.count - pos) * sizeof(BTreeItem));
+    leaf->node.keys[pos] = stored;
+    leaf->items[pos]     = item;
+    leaf->node.count++;
+    tree->item_count++;
+
+    return &leaf->items[pos];
+}
+
+/**
+ * Search for an item with given key.
+ *
+ * @param tree
+ * @param key Key value if key is at most 8 bytes, pointer to key otherwise.
+ * @param udata User data passed to key comparator.
+ * @return Item on success, NULL if key is not present.
+ * */
+BTreeItem* btree_search(BTree* tree, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_INVALID_ARGUMENTS);
+    if(!tree->root) return NULL;
+
+    Uint64     skey = search_key(tree, key);
+    BTreeLeaf* leaf = leaf_find(tree, skey, NULL, NULL, udata);
+    Size       pos  = node_rank(tree, &leaf->node, skey, False, udata);
+
+    if(pos < leaf->node.count && node_rank(tree, &leaf->node, skey, True, udata) > pos) {
+        return &leaf->items[pos];
+    }
+    return NULL;
+}
+
+/**
+ * Delete item with given key, along with copies of it's key and data.
+ *
+ * @param tree
+ * @param key Key value if key is at most 8 bytes, pointer to key otherwise.
+ * @param udata User data passed to callbacks.
+ * @return True if an item was deleted, False if key was not present.
+ * */
+Bool btree_delete(BTree* tree, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree, False, ERR_INVALID_ARGUMENTS);
+    if(!tree->root) return False;
+
+    Uint64      skey = search_key(tree, key);
+    BTreeInner* path[BTREE_MAX_HEIGHT];
+    Size        path_idx[BTREE_MAX_HEIGHT];
+    BTreeLeaf*  leaf = leaf_find(tree, skey, path, path_idx, udata);
+    Size        pos  = node_rank(tree, &leaf->node, skey, False, udata);
+
+    if(pos >= leaf->node.count || node_rank(tree, &leaf->node, skey, True, udata) == pos) {
+        return False;
+    }
+
+    value_destroy(tree->key_size, tree->destroy_key_copy, &leaf->items[pos].key, udata);
+    value_destroy(tree->data_size, tree->destroy_data_copy, &leaf->items[pos].data, udata);
+
+    leaf->node.count--;
+    memmove(leaf->node.keys + pos, leaf->node.keys + pos + 1, (leaf->node.count - pos) * sizeof(Uint64));
+    memmove(leaf->items + pos, leaf->items + pos + 1, (leaf->node.count - pos) * sizeof(BTreeItem));
+    tree->item_count--;
+
+    rebalance_leaf(tree, path, path_idx, tree->height - 1, leaf, udata);
+    return True;
+}
+
+/**
+ * Fill an empty B-tree from keys sorted in strictly increasing order. Leaves
+ * are filled completely and every level is built in a single pass, which
+ * is much faster than inserting keys one by one and gives a smaller tree.
+ *
+ * @param tree An empty tree.
+ * @param keys Array of @p count keys, laid out like a C array of key type.
+ * @param values Array of @p count values, laid out like a C array of data type.
+ * @param count Number of items.
+ * @param udata User data passed to callbacks.
+ * @return True on success. False if tree was not empty, keys were not in
+ * increasing order or memory ran out, in which case tree is left empty.
+ * */
+Bool btree_build_from_sorted(BTree* tree, const void* keys, const void* values, Size count, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && !tree->root && ((keys && values) || !count), False, ERR_INVALID_ARGUMENTS);
+    if(!count) return True;
+
+    const Uint8* kbytes = keys;
+    const Uint8* vbytes = values;
+
+    /* keys and values are passed to callbacks in same form as btree_insert() takes them */
+#define KEY_AT(i) (tree->key_size > 8 ? (void*)(Size)(kbytes + (i) * tree->key_size) : load_packed(kbytes + (i) * tree->key_size, tree->key_size))
+#define VALUE_AT(i) (tree->data_size > 8 ? (void*)(Size)(vbytes + (i) * tree->data_size) : load_packed(vbytes + (i) * tree->data_size, tree->data_size))
+
+    /* check order before touching tree, so a failure leaves it unchanged */
+    for(Size i = 1; i < count; i++) {
+        Uint64 a = search_key(tree, KEY_AT(i - 1));
+        Uint64 b = search_key(tree, KEY_AT(i));
+        Bool ordered = IS_INTEGER_KEYED(tree) ? (Int64)a < (Int64)b : tree->compare_key((void*)a, (void*)b, udata) < 0;
+        /* order depends on data, so this must not be compiled out with argument checks */
+        ERR_RETURN_VALUE_IF_FAIL(ordered, False, ERR_INVALID_CONTENTS);
+    }
+
+    /* nodes of level being built and smallest key under each of them */
+    Size        level_count = (count + BTREE_ORDER - 1) / BTREE_ORDER;
+    BTreeNode** level       = ALLOCATE(BTreeNode*, level_count);
+    Uint64*     level_min   = ALLOCATE(Uint64, level_count);
+    if(!level || !level_min) {
+        FREE(level);
+        FREE(level_min);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return False;
+    }
+
+    /* leaves, items are spread evenly so that every leaf is at least half full */
+    Size next = 0;
+    for(Size l = 0; l < level_count; l++) {
+        Size       n    = count / level_count + (l < count % level_count);
+        BTreeLeaf* leaf = TO_LEAF(node_create(True));
+        if(!leaf) goto OUT_OF_MEMORY;
+
+        leaf->prev = tree->last;
+        if(tree->last) tree->last->next = leaf;
+        else tree->first = leaf;
+        tree->last = leaf;
+        tree->root = &leaf->node;
+        tree->height = 1;
+
+        for(Size i = 0; i < n; i++, next++) {
+            BTreeItem* item = &leaf->items[i];
+            if(!value_create(tree->key_size, tree->create_key_copy, KEY_AT(next), &item->key, udata)) goto OUT_OF_MEMORY;
+            if(!value_create(tree->data_size, tree->create_data_copy, VALUE_AT(next), &item->data, udata)) {
+                value_destroy(tree->key_size, tree->destroy_key_copy, &item->key, udata);
+                goto OUT_OF_MEMORY;
+            }
+            leaf->node.keys[i] = IS_INTEGER_KEYED(tree) ? search_key(tree, KEY_AT(next)) : (Uint64)item->key;
+            leaf->node.count++;
+            tree->item_count++;
+        }
+
+        level[l]     = &leaf->node;
+        level_min[l] = leaf->node.keys[0];
+    }
+
+    /* inner levels, children are spread evenly too, each inner node replaces it's children in level array */
+    while(level_count > 1) {
+        Size parent_count = (level_count + BTREE_ORDER) / (BTREE_ORDER + 1);
+        Size child = 0;
+        for(Size p = 0; p < parent_count; p++) {
+            Size        n     = level_count / parent_count + (p < level_count % parent_count);
+            BTreeInner* inner = TO_INNER(node_create(False));
+            if(!inner) goto OUT_OF_MEMORY;
+
+            Uint64 min = level_min[child];
+            for(Size c = 0; c < n; c++, child++) {
+                inner->children[c] = level[child];
+                level[child] = NULL;
+                if(c) {
+                    inner->node.keys[c - 1] = separator_create(tree, level_min[child], udata);
+                    inner->node.count++;
+                }
+            }
+
+            level[p]     = &inner->node;
+            level_min[p] = min;
+        }
+
+        level_count = parent_count;
+        tree->height++;
+    }
+
+    tree->root = level[0];
+    FREE(level);
+    FREE(level_min);
+    return True;
+
+OUT_OF_MEMORY:
+    ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+    /* leaves are reachable from leaf list, nodes of partially built level from level array */
+    for(Size l = 0; l < level_count; l++) {
+        if(level[l] && !level[l]->is_leaf) {
+            TO_INNER(level[l])->node.count = 0;
+            FREE(level[l]);
+        }
+    }
+    for(BTreeLeaf* leaf = tree->first; leaf;) {
+        BTreeLeaf* next_leaf = leaf->next;
+        for(Size i = 0; i < leaf->node.count; i++) {
+            value_destroy(tree->key_size, tree->destroy_key_copy, &leaf->items[i].key, udata);
+            value_destroy(tree->data_size, tree->destroy_data_copy, &leaf->items[i].data, udata);
+        }
+        FREE(leaf);
+        leaf = next_leaf;
+    }
+    FREE(level);
+    FREE(level_min);
+    tree->root = NULL;
+    tree->first = tree->last = NULL;
+    tree->height = tree->item_count = 0;
+    return False;
+
+#undef KEY_AT
+#undef VALUE_AT
+}
+
+/**
+ * Iterate over all items of tree in increasing order of keys.
+ *
+ * @param tree
+ * @return Iterator positioned at first item.
+ * */
+BTreeIterator btree_iter(BTree* tree) {
+    BTreeIterator iter = {0};
+    ERR_RETURN_VALUE_IF_FAIL(tree, iter, ERR_INVALID_ARGUMENTS);
+    iter.leaf = tree->first;
+    return iter;
+}
+
+/**
+ * Iterate over items with keys not less than given key, in increasing order.
+ *
+ * @param tree
+ * @param key Key value if key is at most 8 bytes, pointer to key otherwise.
+ * @param udata User data passed to key comparator.
+ * @return Iterator positioned at first item with key not less than @p key.
+ * */
+BTreeIterator btree_lower_bound(BTree* tree, void* key, void* udata) {
+    BTreeIterator iter = {0};
+    ERR_RETURN_VALUE_IF_FAIL(tree, iter, ERR_INVALID_ARGUMENTS);
+    if(!tree->root) return iter;
+
+    Uint64 skey = search_key(tree, key);
+    iter.leaf = leaf_find(tree, skey, NULL, NULL, udata);
+    iter.pos  = node_rank(tree, &iter.leaf->node, skey, False, udata);
+    return iter;
+}
+
+/**
+ * Iterate over items with keys in `[low, high)`, in increasing order.
+ *
+ * @param tree
+ * @param low Smallest key to visit.
+ * @param high Keys not less than this are not visited.
+ * @param udata User data passed to key comparator.
+ * @return Iterator positioned at first item in range.
+ * */
+BTreeIterator btree_range(BTree* tree, void* low, void* high, void* udata) {
+    BTreeIterator iter = btree_lower_bound(tree, low, udata);
+    if(!iter.leaf) return iter;
+
+    BTreeIterator end = btree_lower_bound(tree, high, udata);
+    iter.end_leaf = end.leaf;
+    iter.end_pos  = end.pos;
+
+    /* an empty or inverted range must not run till end of tree */
+    Uint64 lkey = search_key(tree, low);
+    Uint64 hkey = search_key(tree, high);
+    Bool   empty = IS_INTEGER_KEYED(tree) ? (Int64)lkey >= (Int64)hkey : tree->compare_key((void*)lkey, (void*)hkey, udata) >= 0;
+    if(empty) {
+        iter.leaf = NULL;
+    }
+    return iter;
+}
+
+/**
+ * Get next item from iterator.
+ *
+ * @param iter
+ * @return Next item, NULL once iteration is over.
+ * */
+BTreeItem* btree_iter_next(BTreeIterator* iter) {
+    ERR_RETURN_VALUE_IF_FAIL(iter, NULL, ERR_INVALID_ARGUMENTS);
+
+    while(iter->leaf) {
+        if(iter->leaf == iter->end_leaf && iter->pos >= iter->end_pos) {
+            iter->leaf = NULL;
+            break;
+        }
+        if(iter->pos < iter->leaf->node.count) {
+            return &iter->leaf->items[iter->pos++];
+        }
+        iter->leaf = iter->leaf->next;
+        iter->pos  = 0;
+    }
+
+    return NULL;
+}
+
+/************************** PRIVATE FUNCTIONS ***************************/
+
+/* zero initialized node aligned to cache line */
+static BTreeNode* node_create(Bool is_leaf) {
+    Size size = is_leaf ? sizeof(BTreeLeaf) : sizeof(BTreeInner);
+    size = (size + BTREE_NODE_ALIGNMENT - 1) & ~(Size)(BTREE_NODE_ALIGNMENT - 1);
+
+    BTreeNode* node = aligned_alloc(BTREE_NODE_ALIGNMENT, size);
+    if(node) {
+        memset(node, 0, size);
+        node->is_leaf = is_leaf;
+    }
+    return node;
+}
+
+/* read a value of upto 8 bytes, in the form it's passed around as void* */
+static void* load_packed(const void* src, Size size) {
+    Uint64 value = 0;
+    memcpy(&value, src, size);
+    return (void*)value;
+}
+
+/* destroy subtree under given node, recursion depth is bounded by height of tree */
+static void node_destroy(BTree* tree, BTreeNode* node, void* udata) {
+    if(node->is_leaf) {
+        BTreeLeaf* leaf = TO_LEAF(node);
+        for(Size i = 0; i < node->count; i++) {
+            value_destroy(tree->key_size, tree->destroy_key_copy, &leaf->items[i].key, udata);
+            value_destroy(tree->data_size, tree->destroy_data_copy, &leaf->items[i].data, udata);
+        }
+    } else {
+        BTreeInner* inner = TO_INNER(node);
+        for(Size i = 0; i < node->count; i++) {
+            separator_destroy(tree, node->keys[i], udata);
+        }
+        for(Size i = 0; i <= node->count; i++) {
+            node_destroy(tree, inner->children[i], udata);
+        }
+    }
+    FREE(node);
+}
+
+/**
+ * Create copy of a key or data value, with Vector semantics : values
+ * of upto 8 bytes are stored in slot, larger values are copied to new
+ * memory and slot holds pointer to it.
+ * */
+static Bool value_create(Size size, CreateElementCopyCallback create, void* src, void** dst, void* udata) {
+    if(size <= 8) {
+        if(create) {
+            *dst = NULL;
+            create(dst, src, udata);
+        } else {
+            *dst = src;
+        }
+        return True;
+    }
+
+    void* copy = ALLOCATE(Uint8, size);
+    if(!copy) return False;
+
+    if(create) create(copy, src, udata);
+    else memcpy(copy, src, size);
+    *dst = copy;
+    return True;
+}
+
+/* destroy copy created by value_create */
+static void value_destroy(Size size, DestroyElementCopyCallback destroy, void** slot, void* udata) {
+    if(size <= 8) {
+        if(destroy) destroy(slot, udata);
+    } else {
+        if(destroy) destroy(*slot, udata);
+        FREE(*slot);
+    }
+    *slot = NULL;
+}
+
+/* key in form stored in search arrays : order preserving integer, or key itself */
+static Uint64 search_key(BTree* tree, void* key) {
+    Uint64 value = (Uint64)key;
+    Size   shift = 64 - tree->key_size * 8;
+
+    switch(tree->key_kind) {
+        case BTREE_KEY_SIGNED:
+            /* sign extend from key size, then compare as Int64 */
+            return (Uint64)((Int64)(value << shift) >> shift);
+        case BTREE_KEY_UNSIGNED:
+            /* flipping top bit maps unsigned order onto signed order */
+            return ((value << shift) >> shift) ^ ((Uint64)1 << 63);
+        default:
+            return value;
+    }
+}
+
+/**
+ * Number of keys in node less than given key, or not greater than it when
+ * @p inclusive. First is position of key in a leaf, second is index of
+ * child to descend into from an inner node.
+ * */
+static Size node_rank(BTree* tree, BTreeNode* node, Uint64 key, Bool inclusive, void* udata) {
+    Size count = node->count;
+
+    if(!IS_INTEGER_KEYED(tree)) {
+        Size lo = 0, hi = count;
+        while(lo < hi) {
+            Size  mid = lo + (hi - lo) / 2;
+            Int32 cmp = tree->compare_key((void*)node->keys[mid], (void*)key, udata);
+            if(cmp < 0 || (inclusive && cmp == 0)) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    /* keys are sorted, so counting them is same as searching, and a count has no branches to mispredict */
+    const Int64* keys  = (const Int64*)node->keys;
+    Int64        skey  = (Int64)key;
+    Size         rank  = 0;
+
+#if SIMD_ENABLED
+    const Size lanes = sizeof(MVec) / sizeof(Int64);
+    MVec       vkey  = simd_set1_epi64(skey);
+    for(Size i = 0; i < count; i += lanes) {
+        /* keys array is a multiple of register width, so loading past count stays inside node */
+        MVec   vkeys = simd_loadu(keys + i);
+        Size   valid = MIN(count - i, lanes);
+        Uint64 mask  = inclusive ? (Uint64)simd_cmpgt_epi64_mask(vkeys, vkey) : (Uint64)simd_cmpgt_epi64_mask(vkey, vkeys);
+        mask &= ((Uint64)1 << valid) - 1;
+        rank += inclusive ? valid - (Size)__builtin_popcountll(mask) : (Size)__builtin_popcountll(mask);
+    }
+#else
+    if(inclusive) {
+        for(Size i = 0; i < count; i++) rank += keys[i] <= skey;
+    } else {
+        for(Size i = 0; i < count; i++) rank += keys[i] < skey;
+    }
+#endif
+
+    return rank;
+}
+
+/* separator to put in an inner node for given search key of a leaf */
+static Uint64 separator_create(BTree* tree, Uint64 key, void* udata) {
+    if(!OWNS_SEPARATORS(tree)) {
+        return key;
+    }
+
+    void* copy = NULL;
+    if(!value_create(tree->key_size, tree->create_key_copy, (void*)key, &copy, udata)) {
+        /* not fatal, but separator is then shared with leaf key it was made from */
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return key;
+    }
+    return (Uint64)copy;
+}
+
+static void separator_destroy(BTree* tree, Uint64 separator, void* udata) {
+    if(OWNS_SEPARATORS(tree)) {
+        void* slot = (void*)separator;
+        value_destroy(tree->key_size, tree->destroy_key_copy, &slot, udata);
+    }
+}
+
+/* descend to leaf that may hold given key, optionally recording inner nodes and child indices on the way */
+static BTreeLeaf* leaf_find(BTree* tree, Uint64 key, BTreeInner** path, Size* path_idx, void* udata) {
+    BTreeNode* node = tree->root;
+    for(Size depth = 0; !node->is_leaf; depth++) {
+        Size idx = node_rank(tree, node, key, True, udata);
+        if(path) {
+            path[depth]     = TO_INNER(node);
+            path_idx[depth] = idx;
+        }
+        node = TO_INNER(node)->children[idx];
+    }
+    return TO_LEAF(node);
+}
+
+/**
+ * Insert separator and new right sibling of child at given depth of path into
+ * it's parent, splitting parents as required. Depth is number of inner nodes
+ * above the node that was split.
+ * */
+static void insert_into_parent(BTree* tree, BTreeInner** path, Size* path_idx, Size depth, BTreeNode* right, Uint64 separator) {
+    while(depth) {
+        BTreeInner* parent = path[depth - 1];
+        Size        idx    = path_idx[depth - 1];
+
+        if(parent->node.count < BTREE_ORDER) {
+            memmove(parent->node.keys + idx + 1, parent->node.keys + idx, (parent->node.count - idx) * sizeof(Uint64));
+            memmove(parent->children + idx + 2, parent->children + idx + 1, (parent->node.count - idx) * sizeof(BTreeNode*));
+            parent->node.keys[idx]     = separator;
+            parent->children[idx + 1] = right;
+            parent->node.count++;
+            return;
+        }
+
+        /* split full parent : gather all keys and children, middle key moves up */
+        Uint64     keys[BTREE_ORDER + 1];
+        BTreeNode* children[BTREE_ORDER + 2];
+        memcpy(keys, parent->node.keys, idx * sizeof(Uint64));
+        keys[idx] = separator;
+        memcpy(keys + idx + 1, parent->node.keys + idx, (BTREE_ORDER - idx) * sizeof(Uint64));
+        memcpy(children, parent->children, (idx + 1) * sizeof(BTreeNode*));
+        children[idx + 1] = right;
+        memcpy(children + idx + 2, parent->children + idx + 1, (BTREE_ORDER - idx) * sizeof(BTreeNode*));
+
+        BTreeInner* sibling = TO_INNER(node_create(False));
+        if(!sibling) {
+            /* can't happen gracefully, tree would lose a subtree */
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+            abort();
+        }
+
+        Size mid = BTREE_ORDER / 2;
+        memcpy(parent->node.keys, keys, mid * sizeof(Uint64));
+        memcpy(parent->children, children, (mid + 1) * sizeof(BTreeNode*));
+        parent->node.count = mid;
+
+        memcpy(sibling->node.keys, keys + mid + 1, (BTREE_ORDER - mid) * sizeof(Uint64));
+        memcpy(sibling->children, children + mid + 1, (BTREE_ORDER - mid + 1) * sizeof(BTreeNode*));
+        sibling->node.count = BTREE_ORDER - mid;
+
+        separator = keys[mid];
+        right     = &sibling->node;
+        depth--;
+    }
+
+    /* root was split, tree grows by one level */
+    BTreeInner* root = TO_INNER(node_create(False));
+    if(!root) {
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        abort();
+    }
+    root->node.keys[0] = separator;
+    root->children[0]  = tree->root;
+    root->children[1]  = right;
+    root->node.count   = 1;
+    tree->root = &root->node;
+    tree->height++;
+}
+
+/* remove key at given position and child right of it from an inner node */
+static void inner_remove(BTreeInner* inner, Size key_pos) {
+    memmove(inner->node.keys + key_pos, inner->node.keys + key_pos + 1, (inner->node.count - key_pos - 1) * sizeof(Uint64));
+    memmove(inner->children + key_pos + 1, inner->children + key_pos + 2, (inner->node.count - key_pos - 1) * sizeof(BTreeNode*));
+    inner->node.count--;
+}
+
+/* replace separator at given position with one made from given leaf key */
+static void separator_replace(BTree* tree, BTreeInner* inner, Size pos, Uint64 key, void* udata) {
+    separator_destroy(tree, inner->node.keys[pos], udata);
+    inner->node.keys[pos] = separator_create(tree, key, udata);
+}
+
+/* restore minimum fill of an inner node at given depth, by borrowing from or merging with a sibling */
+static void rebalance_inner(BTree* tree, BTreeInner** path, Size* path_idx, Size depth) {
+    while(True) {
+        BTreeInner* node = path[depth];
+
+        if(!depth) {
+            /* root with a single child is replaced by that child */
+            if(!node->node.count) {
+                tree->root = node->children[0];
+                tree->height--;
+                FREE(node);
+            }
+            return;
+        }
+
+        if(node->node.count >= BTREE_MIN_KEYS) {
+            return;
+        }
+
+        BTreeInner* parent = path[depth - 1];
+        Size        idx    = path_idx[depth - 1];
+        BTreeInner* left   = idx ? TO_INNER(parent->children[idx - 1]) : NULL;
+        BTreeInner* right  = idx < parent->node.count ? TO_INNER(parent->children[idx + 1]) : NULL;
+
+        if(left && left->node.count > BTREE_MIN_KEYS) {
+            /* rotate right : separator comes down, last key of left goes up */
+            memmove(node->node.keys + 1, node->node.keys, node->node.count * sizeof(Uint64));
+            memmove(node->children + 1, node->children, (node->node.count + 1) * sizeof(BTreeNode*));
+            node->node.keys[0] = parent->node.keys[idx - 1];
+            node->children[0]  = left->children[left->node.count];
+            node->node.count++;
+            parent->node.keys[idx - 1] = left->node.keys[left->node.count - 1];
+            left->node.count--;
+            return;
+        }
+
+        if(right && right->node.count > BTREE_MIN_KEYS) {
+            /* rotate left : separator comes down, first key of right goes up */
+            node->node.keys[node->node.count]     = parent->node.keys[idx];
+            node->children[node->node.count + 1]  = right->children[0];
+            node->node.count++;
+            parent->node.keys[idx] = right->node.keys[0];
+            memmove(right->node.keys, right->node.keys + 1, (right->node.count - 1) * sizeof(Uint64));
+            memmove(right->children, right->children + 1, right->node.count * sizeof(BTreeNode*));
+            right->node.count--;
+            return;
+        }
+
+        /* merge with a sibling, separator between them comes down */
+        if(!left) {
+            left  = node;
+            node  = right;
+            idx++;
+        }
+        left->node.keys[left->node.count] = parent->node.keys[idx - 1];
+        memcpy(left->node.keys + left->node.count + 1, node->node.keys, node->node.count * sizeof(Uint64));
+        memcpy(left->children + left->node.count + 1, node->children, (node->node.count + 1) * sizeof(BTreeNode*));
+        left->node.count += node->node.count + 1;
+        FREE(node);
+
+        inner_remove(parent, idx - 1);
+        depth--;
+    }
+}
+
+/* restore minimum fill of a leaf after deletion, depth is number of inner nodes above it */
+static void rebalance_leaf(BTree* tree, BTreeInner** path, Size* path_idx, Size depth, BTreeLeaf* leaf, void* udata) {
+    if(!depth) {
+        /* last item of tree was deleted */
+        if(!leaf->node.count) {
+            FREE(leaf);
+            tree->root   = NULL;
+            tree->first  = NULL;
+            tree->last   = NULL;
+            tree->height = 0;
+        }
+        return;
+    }
+
+    if(leaf->node.count >= BTREE_MIN_KEYS) {
+        return;
+    }
+
+    BTreeInner* parent = path[depth - 1];
+    Size        idx    = path_idx[depth - 1];
+    BTreeLeaf*  left   = idx ? TO_LEAF(parent->children[idx - 1]) : NULL;
+    BTreeLeaf*  right  = idx < parent->node.count ? TO_LEAF(parent->children[idx + 1]) : NULL;
+
+    if(left && left->node.count > BTREE_MIN_KEYS) {
+        /* borrow last item of left sibling, it becomes our smallest key */
+        memmove(leaf->node.keys + 1, leaf->node.keys, leaf->node.count * sizeof(Uint64));
+        memmove(leaf->items + 1, leaf->items, leaf->node.count * sizeof(BTreeItem));
+        left->node.count--;
+        leaf->node.keys[0] = left->node.keys[left->node.count];
+        leaf->items[0]     = left->items[left->node.count];
+        leaf->node.count++;
+        separator_replace(tree, parent, idx - 1, leaf->node.keys[0], udata);
+        return;
+    }
+
+    if(right && right->node.count > BTREE_MIN_KEYS) {
+        /* borrow first item of right sibling, it's next key becomes separator */
+        leaf->node.keys[leaf->node.count] = right->node.keys[0];
+        leaf->items[leaf->node.count]     = right->items[0];
+        leaf->node.count++;
+        right->node.count--;
+        memmove(right->node.keys, right->node.keys + 1, right->node.count * sizeof(Uint64));
+        memmove(right->items, right->items + 1, right->node.count * sizeof(BTreeItem));
+        separator_replace(tree, parent, idx, right->node.keys[0], udata);
+        return;
+    }
+
+    /* merge into left sibling, or merge right sibling into this leaf */
+    if(!left) {
+        left = leaf;
+        leaf = right;
+        idx++;
+    }
+    memcpy(left->node.keys + left->node.count, leaf->node.keys, leaf->node.count * sizeof(Uint64));
+    memcpy(left->items + left->node.count, leaf->items, leaf->node.count * sizeof(BTreeItem));
+    left->node.count += leaf->node.count;
+
+    left->next = leaf->next;
+    if(leaf->next) leaf->next->prev = left;
+    else tree->last = left;
+    FREE(leaf);
+
+    separator_destroy(tree, parent->node.keys[idx - 1], udata);
+    inner_remove(parent, idx - 1);
+    rebalance_inner(tree, path, path_idx, depth - 1);
+}
@@ -24,6 +24,8 @@
 #include <Anvie/HelperDefines.h>
 #include <Anvie/Bit/Bit.h>
 #include <Anvie/Error.h>
+#include <Anvie/Counters.h>
+#include <Anvie/Simd/Simd.h>
 #include <string.h>
 
 /**
@@ -44,22 +46,42 @@
 #define BITVEC_NEXT_INCREMENTED_LENGTH(bytelen)                      \
     (((bytelen) & (~(BITVEC_DEFAULT_INCREMENT_SIZE - 1))) + BITVEC_DEFAULT_INCREMENT_SIZE)
 
+/**
+ * Mark rank directory of given @c BitVector stale, if it has one.
+ * Must be called by every operation that changes bits or length.
+ * */
+#define INVALIDATE_RANK_INDEX(bv) do { if((bv)->rank_index) (bv)->rank_index->valid = False; } while(0)
+
 /**
  * Create a new @c BitVector.
  * @return BitVector* A valid pointer on success.
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_create() {
-    BitVector* bv = NEW(BitVector);
+    return bitvec_create_with_allocator(NULL);
+}
+
+/**
+ * Create a new @c BitVector that allocates all of it's memory
+ * from given allocator.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return BitVector* A valid pointer on success.
+ * @return BitVector* @c INVALID_BITVECTOR on failure.
+ * */
+BitVector* bitvec_create_with_allocator(Allocator* allocator) {
+    BitVector* bv = allocator_allocate_zeroed(allocator, sizeof(BitVector));
     ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_OUT_OF_MEMORY);
 
-    bv->data = ALLOCATE(Uint8, BITVEC_DEFAULT_INCREMENT_SIZE);
+    bv->data = allocator_allocate_zeroed(allocator, BITVEC_DEFAULT_INCREMENT_SIZE);
     if(!bv->data) {
-        FREE(bv);
+        allocator_free(allocator, bv, sizeof(BitVector));
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return INVALID_BITVECTOR;
     }
 
-    bv->capacity = MUL8(BITVEC_DEFAULT_INCREMENT_SIZE);
+    bv->capacity  = MUL8(BITVEC_DEFAULT_INCREMENT_SIZE);
+    bv->allocator = allocator;
+    COUNTER_INC(BITVEC_CREATE);
 
     return bv;
 }
@@ -71,12 +93,16 @@ BitVector* bitvec_create() {
 void bitvec_destroy(BitVector* bv) {
     ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
 
+    if(bv->rank_index) {
+        bitvec_drop_rank_index(bv);
+    }
+
     if(bv->data) {
-        FREE(bv->data);
+        allocator_free(bv->allocator, bv->data, DIV8(bv->capacity));
         bv->data = NULL;
     }
 
-    FREE(bv);
+    allocator_free(bv->allocator, bv, sizeof(BitVector));
 }
 
 /**
@@ -88,7 +114,7 @@ void bitvec_destroy(BitVector* bv) {
 BitVector* bitvec_clone(BitVector* bv) {
     ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
 
-    BitVector* bvclone = bitvec_create();
+    BitVector* bvclone = bitvec_create_with_allocator(bv->allocator);
     ERR_RETURN_VALUE_IF_FAIL(bvclone, INVALID_BITVECTOR, ERR_INVALID_OBJECT);
 
     bitvec_resize(bvclone, bv->length);
@@ -97,6 +123,95 @@ BitVector* bitvec_clone(BitVector* bv) {
     return bvclone;
 }
 
+/* header, one section of bits with bits past length cleared, and trailer */
+static Size bitvec_write_image(BitVector* bv, ImageWriter* writer) {
+    Size   bytes     = DIV8(bv->length + 7);
+    Uint64 params[1] = {bv->length};
+
+    image_writer_begin(writer, IMAGE_KIND_BITVECTOR, 0, params, ARRAY_SIZE(params),
+                       image_section_size(sizeof(ImageHeader)) + image_section_size(bytes) + sizeof(ImageTrailer));
+    if(MOD8(bv->length)) {
+        Uint8 last = bv->data[bytes - 1] & (Uint8)((1u << MOD8(bv->length)) - 1);
+        image_writer_put(writer, bv->data, bytes - 1);
+        image_writer_put(writer, &last, 1);
+    } else {
+        image_writer_put(writer, bv->data, bytes);
+    }
+    image_writer_align(writer);
+    return image_writer_finish(writer);
+}
+
+/**
+ * Write an image of given @c BitVector into @p buffer, see Anvie/Containers/Image.h.
+ * Rank index is not written, it's rebuilt on demand after loading.
+ *
+ * @param buffer Destination, can be NULL to only compute size of image.
+ * @param capacity Size of @p buffer.
+ * @return Size of image. Image is complete only if this is at most @p capacity.
+ * @return 0 on invalid arguments.
+ * */
+Size bitvec_write_to_buffer(BitVector* bv, void* buffer, Size capacity) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, 0, ERR_INVALID_ARGUMENTS);
+
+    ImageWriter writer;
+    image_writer_init_buffer(&writer, buffer, capacity);
+    return bitvec_write_image(bv, &writer);
+}
+
+/**
+ * Write an image of given @c BitVector to a file, at it's current offset.
+ *
+ * @return True if whole image was written.
+ * */
+Bool bitvec_serialize_to_fd(BitVector* bv, int fd) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, False, ERR_INVALID_ARGUMENTS);
+
+    ImageWriter writer;
+    if(!image_writer_init_fd(&writer, fd)) {
+        return False;
+    }
+    return bitvec_write_image(bv, &writer) != 0;
+}
+
+/**
+ * Load @c BitVector held by given image. Bits are not copied, they're used
+ * right where they are in image. @c BitVector is owned by image and loading
+ * it again returns same @c BitVector.
+ *
+ * @return BitVector* on success.
+ * @return NULL if image does not hold a valid @c BitVector.
+ * */
+BitVector* bitvec_from_image(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(image_get_kind(image) == IMAGE_KIND_BITVECTOR, NULL, ERR_INVALID_CONTENTS);
+
+    BitVector* bv = image_get_container(image);
+    if(bv) {
+        return bv;
+    }
+
+    Uint64 length = image_get_header(image)->params[0];
+    RETURN_VALUE_IF_FAIL(length <= SIZE_MAX - IMAGE_SECTION_ALIGN * 8, NULL, "invalid bitvector image\n");
+
+    /* zero padding of section is usable capacity */
+    Size   cursor = 0;
+    Size   bytes  = image_section_size(DIV8(length + 7));
+    Uint8* data   = image_take_section(image, &cursor, bytes);
+    RETURN_VALUE_IF_FAIL(data, NULL, "invalid bitvector image\n");
+
+    Allocator* allocator = image_get_allocator(image);
+    bv = allocator_allocate_zeroed(allocator, sizeof(BitVector));
+    ERR_RETURN_VALUE_IF_FAIL(bv, NULL, ERR_OUT_OF_MEMORY);
+
+    bv->length    = length;
+    bv->capacity  = MUL8(bytes);
+    bv->data      = data;
+    bv->allocator = allocator;
+
+    image_set_container(image, bv);
+    return bv;
+}
+
 /**
  * Make @p dstbv and @p srcbv equal, i.e., @p dstbv = @p srcbv.
  * The implementation does not care about the length of
@@ -110,6 +225,7 @@ BitVector* bitvec_clone(BitVector* bv) {
  * */
 void bitvec_set_equal(BitVector* dstbv, BitVector* srcbv) {
     ERR_RETURN_IF_FAIL(dstbv && srcbv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(dstbv);
 
     /* resize as well as clear contents after length boundary in dstbv */
     bitvec_resize(dstbv, srcbv->length);
@@ -141,9 +257,10 @@ void bitvec_reserve(BitVector* bv, Size numbools) {
 
     /* recompute new size and resize */
     Size newsz = BITVEC_NEXT_INCREMENTED_LENGTH(DIV8(numbools)); /* next multiple */
-    Uint8* tmp = realloc(bv->data, newsz);
+    Uint8* tmp = allocator_reallocate(bv->allocator, bv->data, DIV8(bv->capacity), newsz);
     ERR_RETURN_IF_FAIL(tmp, ERR_OUT_OF_MEMORY);
     bv->data = tmp;
+    COUNTER_INC(BITVEC_REALLOC);
 
     /* clear all bits in allocated new memory */
     Size ol = bv->length;
@@ -167,6 +284,7 @@ void bitvec_reserve(BitVector* bv, Size numbools) {
  * */
 void bitvec_resize(BitVector* bv, Size numbools) {
     ERR_RETURN_IF_FAIL(bv && numbools, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     if(numbools < bv->length) {
         bitvec_clear_range(bv, numbools, bv->length - numbools);
@@ -184,6 +302,7 @@ void bitvec_resize(BitVector* bv, Size numbools) {
  * */
 void bitvec_push(BitVector* bv, Bool val) {
     ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     if(bv->length >= bv->capacity) {
         bitvec_reserve(bv, bv->length + 1); /* create space to store just one more bool */
@@ -207,6 +326,7 @@ void bitvec_push(BitVector* bv, Bool val) {
  * */
 Bool bitvec_pop(BitVector* bv) {
     ERR_RETURN_VALUE_IF_FAIL(bv, False, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     if(!bv->length) {
         return False;
@@ -253,6 +373,7 @@ Bool bitvec_peek(BitVector* bv, Size index) {
  * */
 inline void bitvec_set(BitVector* bv, Size index) {
     ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     /* if write position exceeds the capacity, then reserve more space */
     if(index >= bv->capacity) {
@@ -283,6 +404,7 @@ inline void bitvec_set(BitVector* bv, Size index) {
  * */
 inline void bitvec_clear(BitVector* bv, Size index) {
     ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     /* if write position exceeds the capacity, then reserve more space */
     if(index >= bv->capacity) {
@@ -338,6 +460,7 @@ inline void bitvec_clear_all(BitVector* bv) {
 inline void bitvec_set_range(BitVector* bv, Size range_begin, Size range_size) {
     if(!range_size) return;
     ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     /* reserve more space if needed */
     if(range_begin + range_size > bv->capacity) {
@@ -399,6 +522,7 @@ inline void bitvec_set_range(BitVector* bv, Size range_begin, Size range_size) {
 void bitvec_clear_range(BitVector* bv, Size range_begin, Size range_size) {
     if(!range_size) return;
     ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(bv);
 
     /* reserve more space if needed */
     if(range_begin + range_size > bv->capacity) {
@@ -407,10 +531,11 @@ void bitvec_clear_range(BitVector* bv, Size range_begin, Size range_size) {
 
         /* resize manually here */
         Size newsz = BITVEC_NEXT_INCREMENTED_LENGTH(DIV8(range_begin + range_size)); /* next multiple */
-        Uint8* tmp = realloc(bv->data, newsz);
+        Uint8* tmp = allocator_reallocate(bv->allocator, bv->data, DIV8(bv->capacity), newsz);
         ERR_RETURN_IF_FAIL(tmp, ERR_OUT_OF_MEMORY);
         bv->data = tmp;
         bv->capacity = MUL8(newsz);
+        COUNTER_INC(BITVEC_REALLOC);
     }
     bv->length = MAX(range_begin + range_size, bv->length);
 
@@ -454,49 +579,168 @@ void bitvec_clear_range(BitVector* bv, Size range_begin, Size range_size) {
     }
 }
 
-#define OPERATE_ON_BIT_VECTORS(bv1, bv2, OP)                            \
-    do {                                                                \
-        /* Check for valid arguments */                                 \
-        ERR_RETURN_VALUE_IF_FAIL((bv1) && (bv2), INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS); \
-                                                                        \
-        /* Calculate minimum and maximum lengths */                     \
-        Size minlen = MIN((bv1)->length, (bv2)->length);                \
-        Size maxlen = MAX((bv1)->length, (bv2)->length);                \
-                                                                        \
-        /* Create a BitVector to store the result of the operation */   \
-        BitVector* bvres = bitvec_create();                             \
-        bitvec_resize(bvres, maxlen);                                   \
-        ERR_RETURN_VALUE_IF_FAIL(bvres, INVALID_BITVECTOR, ERR_INVALID_OBJECT);      \
-                                                                        \
-        /* if maxlen is 0 then no need to process */                    \
-        if(maxlen == 0) {                                               \
-            return bvres;                                               \
-        }                                                               \
-                                                                        \
-        /* align minlen and maxlen to upper bound 8 bit boundaries */   \
-        if(MOD8(maxlen)) maxlen = ALIGN8_HI(maxlen);                    \
-        if(MOD8(maxlen)) minlen = ALIGN8_HI(minlen);                    \
-                                                                        \
-        Uint8* dres = (bvres)->data;                                    \
-        Uint8* d1 = (bv1)->data;                                        \
-        Uint8* d2 = (bv2)->data;                                        \
-                                                                        \
-        for (Size s = 0; s < DIV8(minlen); s++) {                       \
-            *dres++ = OP(*d1++, *d2++);                                 \
-        }                                                               \
-                                                                        \
-        /* make early exit if possible */                               \
-        if(minlen == maxlen) {                                          \
-            return bvres;                                               \
-        }                                                               \
-                                                                        \
-        Uint8* d = ((bv1)->length == maxlen ? d1 : d2);                 \
-        for (Size s = DIV8(minlen); s < DIV8(maxlen); s++) {            \
-            *dres++ = OP(*d++, 0);                                      \
+/* number of bytes in 64 bit words required to cover given number of bits */
+#define WORD_BYTES(nbits) (((nbits) + 63) / 64 * 8)
+
+static FORCE_INLINE Uint64 load_word(const Uint8* p) {
+    Uint64 w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+static FORCE_INLINE void store_word(Uint8* p, Uint64 w) {
+    memcpy(p, &w, sizeof(w));
+}
+
+/**
+ * Kernel computing @c dst = OP(a, b) over given number of bytes,
+ * which must be a multiple of 8. A @c NULL operand is treated as all
+ * zeroes. Whole SIMD registers are processed first when SIMD is enabled
+ * and rest is processed 64 bits at a time.
+ * */
+typedef void (*BitVectorKernel)(Uint8* dst, const Uint8* a, const Uint8* b, Size nbytes);
+
+#if SIMD_ENABLED
+#define MVEC_AND(x, y, ones) simd_and(x, y)
+#define MVEC_OR(x, y, ones) simd_or(x, y)
+#define MVEC_XOR(x, y, ones) simd_xor(x, y)
+#define MVEC_NAND(x, y, ones) simd_xor(simd_and(x, y), ones)
+#define MVEC_NOR(x, y, ones) simd_xor(simd_or(x, y), ones)
+#define MVEC_XNOR(x, y, ones) simd_xor(simd_xor(x, y), ones)
+#define MVEC_ANDNOT(x, y, ones) simd_andnot(y, x)
+#endif // SIMD_ENABLED
+
+#if SIMD_ENABLED
+#define BITVEC_KERNEL_SIMD_LOOP(MVEC_OP)                                \
+    const MVec ones = simd_set1_epi8(-1);                               \
+    const MVec zero = simd_set1_epi8(0);                                \
+    UNUSED(ones);                                                       \
+    for(; i + sizeof(MVec) <= nbytes; i += sizeof(MVec)) {              \
+        MVec x = a ? simd_loadu(a + i) : zero;                          \
+        MVec y = b ? simd_loadu(b + i) : zero;                          \
+        simd_storeu(dst + i, MVEC_OP(x, y, ones));                      \
+    }
+#else
+#define BITVEC_KERNEL_SIMD_LOOP(MVEC_OP)
+#endif // SIMD_ENABLED
+
+#define DEF_BIT_VECTOR_KERNEL(name, WORD_OP, MVEC_OP)                   \
+    static void bitvec_kernel_##name(Uint8* dst, const Uint8* a, const Uint8* b, Size nbytes) { \
+        Size i = 0;                                                     \
+        BITVEC_KERNEL_SIMD_LOOP(MVEC_OP)                                \
+        for(; i < nbytes; i += 8) {                                     \
+            Uint64 x = a ? load_word(a + i) : 0;                        \
+            Uint64 y = b ? load_word(b + i) : 0;                        \
+            store_word(dst + i, WORD_OP(x, y));                         \
         }                                                               \
-                                                                        \
-        return bvres;                                                   \
-    } while (0)
+    }
+
+DEF_BIT_VECTOR_KERNEL(and,  AND,  MVEC_AND)
+DEF_BIT_VECTOR_KERNEL(or,   OR,   MVEC_OR)
+DEF_BIT_VECTOR_KERNEL(xor,  XOR,  MVEC_XOR)
+DEF_BIT_VECTOR_KERNEL(nand, NAND, MVEC_NAND)
+DEF_BIT_VECTOR_KERNEL(nor,  NOR,  MVEC_NOR)
+DEF_BIT_VECTOR_KERNEL(xnor, XNOR, MVEC_XNOR)
+DEF_BIT_VECTOR_KERNEL(andnot, ANDNOT, MVEC_ANDNOT)
+
+#undef DEF_BIT_VECTOR_KERNEL
+#undef BITVEC_KERNEL_SIMD_LOOP
+
+/**
+ * Clear all bits from @p length up to the end of 64 bit word containing
+ * last bit, so that bits past length stay cleared after a kernel has
+ * operated on whole words.
+ * */
+static FORCE_INLINE void clear_tail_bits(Uint8* data, Size length) {
+    Size end = WORD_BYTES(length);
+    Size pos = DIV8(length);
+    if(MOD8(length)) {
+        data[pos] = GET8_LO(data[pos], MOD8(length));
+        pos++;
+    }
+    memset(data + pos, 0, end - pos);
+}
+
+/**
+ * Combine @p bv1 and @p bv2 into @p dst using given kernel. Bits of shorter
+ * @c BitVector past it's length are treated as cleared. @p dst must be
+ * able to hold as many bits as the longer one.
+ * */
+static void combine_bit_vectors(Uint8* dst, BitVector* bv1, BitVector* bv2, BitVectorKernel kernel) {
+    Size minlen = MIN(bv1->length, bv2->length);
+    Size maxlen = MAX(bv1->length, bv2->length);
+
+    /* bits past length of a bitvector are always cleared, so whole words can be used */
+    Size common = WORD_BYTES(minlen);
+    kernel(dst, bv1->data, bv2->data, common);
+
+    Size total = WORD_BYTES(maxlen);
+    if(total > common) {
+        Bool first_longer = bv1->length == maxlen;
+        kernel(dst + common,
+               first_longer ? bv1->data + common : NULL,
+               first_longer ? NULL : bv2->data + common,
+               total - common);
+    }
+
+    clear_tail_bits(dst, maxlen);
+}
+
+/**
+ * Make sure @p dst can hold @p length bits, without touching it's length.
+ * @return True if @p dst has enough capacity after this.
+ * */
+static FORCE_INLINE Bool reserve_for_result(BitVector* dst, Size length) {
+    if(length > dst->capacity) {
+        bitvec_reserve(dst, length);
+    }
+    return dst->capacity >= length;
+}
+
+/**
+ * Clear bits a destination @c BitVector had past it's new length.
+ * */
+static FORCE_INLINE void clear_stale_bits(BitVector* dst, Size oldlen, Size newlen) {
+    if(WORD_BYTES(oldlen) > WORD_BYTES(newlen)) {
+        memset(dst->data + WORD_BYTES(newlen), 0, WORD_BYTES(oldlen) - WORD_BYTES(newlen));
+    }
+}
+
+/**
+ * Store result of a binary operation on @p bv1 and @p bv2 in @p dst,
+ * reusing memory of @p dst. @p dst may be same as any of the operands,
+ * because kernels read a word before writing the same word.
+ * */
+static void combine_bit_vectors_into(BitVector* dst, BitVector* bv1, BitVector* bv2, BitVectorKernel kernel) {
+    ERR_RETURN_IF_FAIL(dst && bv1 && bv2, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(dst);
+
+    /* reserve first, an aliased operand must be read from new memory */
+    Size maxlen = MAX(bv1->length, bv2->length);
+    ERR_RETURN_IF_FAIL(reserve_for_result(dst, maxlen), ERR_OUT_OF_MEMORY);
+
+    if(maxlen) {
+        combine_bit_vectors(dst->data, bv1, bv2, kernel);
+    }
+
+    clear_stale_bits(dst, dst->length, maxlen);
+    dst->length = maxlen;
+}
+
+/**
+ * Create result of a binary operation on two @c BitVector values.
+ * */
+static BitVector* operate_on_bit_vectors(BitVector* bv1, BitVector* bv2, BitVectorKernel kernel) {
+    ERR_RETURN_VALUE_IF_FAIL(bv1 && bv2, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
+
+    /* Create a BitVector to store the result of the operation */
+    BitVector* bvres = bitvec_create_with_allocator(bv1->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(bvres, INVALID_BITVECTOR, ERR_INVALID_OBJECT);
+
+    combine_bit_vectors_into(bvres, bv1, bv2, kernel);
+
+    return bvres;
+}
 
 /**
  * Take logical XOR of two @c BitVector values and
@@ -517,7 +761,7 @@ void bitvec_clear_range(BitVector* bv, Size range_begin, Size range_size) {
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_xor(BitVector* bv1, BitVector* bv2) {
-    OPERATE_ON_BIT_VECTORS(bv1, bv2, XOR);
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_xor);
 }
 
 /**
@@ -539,7 +783,7 @@ BitVector* bitvec_xor(BitVector* bv1, BitVector* bv2) {
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_and(BitVector* bv1, BitVector* bv2) {
-    OPERATE_ON_BIT_VECTORS(bv1, bv2, AND);
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_and);
 }
 
 /**
@@ -561,7 +805,7 @@ BitVector* bitvec_and(BitVector* bv1, BitVector* bv2) {
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_or(BitVector* bv1, BitVector* bv2) {
-    OPERATE_ON_BIT_VECTORS(bv1, bv2, OR);
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_or);
 }
 
 /**
@@ -583,7 +827,7 @@ BitVector* bitvec_or(BitVector* bv1, BitVector* bv2) {
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_xnor(BitVector* bv1, BitVector* bv2) {
-    OPERATE_ON_BIT_VECTORS(bv1, bv2, XNOR);
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_xnor);
 }
 
 /**
@@ -605,7 +849,7 @@ BitVector* bitvec_xnor(BitVector* bv1, BitVector* bv2) {
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_nand(BitVector* bv1, BitVector* bv2) {
-    OPERATE_ON_BIT_VECTORS(bv1, bv2, NAND);
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_nand);
 }
 
 /**
@@ -627,11 +871,9 @@ BitVector* bitvec_nand(BitVector* bv1, BitVector* bv2) {
  * @return BitVector* @c INVALID_BITVECTOR on failure.
  * */
 BitVector* bitvec_nor(BitVector* bv1, BitVector* bv2) {
-    OPERATE_ON_BIT_VECTORS(bv1, bv2, NOR);
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_nor);
 }
 
-#undef OPERATE_ON_BIT_VECTORS
-
 /**
  * Compute logical NOT of two @c BitVector values and
  * return the resulting @c BitVector.
@@ -650,7 +892,7 @@ BitVector* bitvec_not(BitVector* bv) {
     ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
 
     /* create new bitvector to store result */
-    BitVector* notbv = bitvec_create();
+    BitVector* notbv = bitvec_create_with_allocator(bv->allocator);
     ERR_RETURN_VALUE_IF_FAIL(notbv, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
 
     if(!bv->length) {
@@ -660,20 +902,218 @@ BitVector* bitvec_not(BitVector* bv) {
     /* create space to store result*/
     bitvec_resize(notbv, bv->length);
 
-    Uint8* dres = notbv->data;
-    Uint8* d    = bv->data;
+    /* NOT is NOR with zero, bits past length are cleared again afterwards */
+    bitvec_kernel_nor(notbv->data, bv->data, NULL, WORD_BYTES(bv->length));
+    clear_tail_bits(notbv->data, bv->length);
+
+    return notbv;
+}
+
+/**
+ * Take logical AND of @p bv1 with logical NOT of @p bv2 and
+ * return the resulting bitvector. This is same as
+ * `bitvec_and(bv1, bitvec_not(bv2))`, but done in a single pass
+ * without creating an intermediate @c BitVector.
+ *
+ * Missing bits of shorter @c BitVector are assumed to be 0, so the
+ * result has set bits past length of @p bv2 wherever @p bv1 has them.
+ * The new, resultant @c BitVector's length will be the maximum
+ * of length of both the @c BitVectors
+ *
+ * @param bv1
+ * @param bv2 Bits to be removed from @p bv1.
+ * @return BitVector* A valid @c BitVector on success.
+ * @return BitVector* @c INVALID_BITVECTOR on failure.
+ * */
+BitVector* bitvec_andnot(BitVector* bv1, BitVector* bv2) {
+    return operate_on_bit_vectors(bv1, bv2, bitvec_kernel_andnot);
+}
 
-    /* handle aligned bits */
-    for(Size s = 0; s < DIV8(bv->length); s++) {
-        *dres++ = ~(*d++);
+/**
+ * Define destination and in-place variants of a binary operation.
+ *
+ * `bitvec_<op>_into(dst, bv1, bv2)` stores `bv1 OP bv2` in @p dst, and
+ * `bitvec_<op>_assign(dst, src)` stores `dst OP src` in @p dst. Both follow
+ * same length rules as the allocating variant, but reuse memory of @p dst,
+ * so it's reallocated only if result does not fit in it's capacity.
+ * @p dst can be same as any of the operands.
+ * */
+#define DEF_BIT_VECTOR_ASSIGN_OPS(name)                                 \
+    void bitvec_##name##_into(BitVector* dst, BitVector* bv1, BitVector* bv2) { \
+        combine_bit_vectors_into(dst, bv1, bv2, bitvec_kernel_##name);  \
+    }                                                                   \
+                                                                        \
+    void bitvec_##name##_assign(BitVector* dst, BitVector* src) {       \
+        combine_bit_vectors_into(dst, dst, src, bitvec_kernel_##name);  \
     }
 
-    /* handle unaligned bits */
-    if(MOD8(bv->length)) {
-        *dres = GET8_LO(~(*d), MOD8(bv->length));
+DEF_BIT_VECTOR_ASSIGN_OPS(xor)
+DEF_BIT_VECTOR_ASSIGN_OPS(and)
+DEF_BIT_VECTOR_ASSIGN_OPS(or)
+DEF_BIT_VECTOR_ASSIGN_OPS(xnor)
+DEF_BIT_VECTOR_ASSIGN_OPS(nand)
+DEF_BIT_VECTOR_ASSIGN_OPS(nor)
+DEF_BIT_VECTOR_ASSIGN_OPS(andnot)
+
+#undef DEF_BIT_VECTOR_ASSIGN_OPS
+
+/**
+ * Store logical NOT of @p bv in @p dst, reusing memory of @p dst.
+ * Same as @c bitvec_not, @p dst gets length of @p bv and bits past
+ * that length are cleared. @p dst can be same as @p bv.
+ *
+ * @param dst
+ * @param bv
+ * */
+void bitvec_not_into(BitVector* dst, BitVector* bv) {
+    ERR_RETURN_IF_FAIL(dst && bv, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(dst);
+
+    Size length = bv->length;
+    ERR_RETURN_IF_FAIL(reserve_for_result(dst, length), ERR_OUT_OF_MEMORY);
+
+    if(length) {
+        bitvec_kernel_nor(dst->data, bv->data, NULL, WORD_BYTES(length));
+        clear_tail_bits(dst->data, length);
     }
 
-    return notbv;
+    clear_stale_bits(dst, dst->length, length);
+    dst->length = length;
+}
+
+/**
+ * Flip all bits of given @c BitVector in place, up to it's length.
+ *
+ * @param bv
+ * */
+void bitvec_not_assign(BitVector* bv) {
+    bitvec_not_into(bv, bv);
+}
+
+/* number of bytes of destination processed against all sources at once, small enough to stay in L1 */
+#define BITVEC_OR_MANY_BLOCK_SIZE 4096
+
+/**
+ * Store logical OR of all given @c BitVector values in @p dst in a single
+ * pass, without creating any intermediate @c BitVector. Destination is
+ * processed in blocks small enough to stay in cache, and every source is
+ * combined into a block before moving to next one.
+ *
+ * Length of @p dst becomes maximum of lengths of all sources.
+ * @p dst can itself be one of the sources.
+ *
+ * @param dst
+ * @param bvs Array of @p n @c BitVector values.
+ * @param n Number of @c BitVector values in @p bvs. If zero, @p dst is cleared.
+ * */
+void bitvec_or_many(BitVector* dst, BitVector** bvs, Size n) {
+    ERR_RETURN_IF_FAIL(dst && (bvs || !n), ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(dst);
+
+    /* find length of result, and whether destination is one of sources */
+    Size maxlen    = 0;
+    Bool dst_is_src = False;
+    for(Size i = 0; i < n; i++) {
+        ERR_RETURN_IF_FAIL(bvs[i], ERR_INVALID_ARGUMENTS);
+        maxlen = MAX(maxlen, bvs[i]->length);
+        dst_is_src = dst_is_src || bvs[i] == dst;
+    }
+
+    ERR_RETURN_IF_FAIL(reserve_for_result(dst, maxlen), ERR_OUT_OF_MEMORY);
+
+    /* when destination is a source, it's own bits are the starting value of each block */
+    Size total = WORD_BYTES(maxlen);
+    for(Size begin = 0; begin < total; begin += BITVEC_OR_MANY_BLOCK_SIZE) {
+        Size end = MIN(begin + BITVEC_OR_MANY_BLOCK_SIZE, total);
+        if(!dst_is_src) {
+            memset(dst->data + begin, 0, end - begin);
+        }
+
+        for(Size i = 0; i < n; i++) {
+            Size srcend = MIN(end, WORD_BYTES(bvs[i]->length));
+            if(bvs[i] == dst || srcend <= begin) continue;
+            bitvec_kernel_or(dst->data + begin, dst->data + begin, bvs[i]->data + begin, srcend - begin);
+        }
+    }
+
+    clear_stale_bits(dst, dst->length, maxlen);
+    dst->length = maxlen;
+}
+
+#undef BITVEC_OR_MANY_BLOCK_SIZE
+
+/**
+ * Store @p src shifted towards index 0 by @p index bits in @p dst.
+ * Whole words are moved with a single @c memmove and remaining shift is
+ * a funnel shift across pairs of adjacent 64 bit words. Words are written
+ * in increasing order and read from same or higher positions, so @p dst
+ * can be same as @p src.
+ * */
+static void shift_bits_down(BitVector* dst, BitVector* src, Size index) {
+    ERR_RETURN_IF_FAIL(dst && src, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(dst);
+
+    Size srclen = src->length;
+    Size newlen = index < srclen ? srclen - index : 0;
+    ERR_RETURN_IF_FAIL(reserve_for_result(dst, newlen), ERR_OUT_OF_MEMORY);
+
+    Size nsrc = WORD_BYTES(srclen) / 8;
+    Size ndst = WORD_BYTES(newlen) / 8;
+    Size ws   = index / 64; /* whole words shifted */
+    Size bs   = index % 64; /* remaining bits shifted */
+
+    const Uint8* s = src->data;
+    Uint8*       d = dst->data;
+    if(!bs) {
+        memmove(d, s + 8 * ws, 8 * ndst);
+    } else {
+        for(Size i = 0; i < ndst; i++) {
+            Uint64 lo = load_word(s + 8 * (i + ws)) >> bs;
+            Uint64 hi = i + ws + 1 < nsrc ? load_word(s + 8 * (i + ws + 1)) << (64 - bs) : 0;
+            store_word(d + 8 * i, lo | hi);
+        }
+    }
+
+    clear_tail_bits(d, newlen);
+    clear_stale_bits(dst, dst->length, newlen);
+    dst->length = newlen;
+}
+
+/**
+ * Store @p src shifted away from index 0 by @p index bits in @p dst.
+ * Same as @c shift_bits_down but words are written in decreasing order,
+ * so @p dst can be same as @p src here as well.
+ * */
+static void shift_bits_up(BitVector* dst, BitVector* src, Size index) {
+    ERR_RETURN_IF_FAIL(dst && src, ERR_INVALID_ARGUMENTS);
+    INVALIDATE_RANK_INDEX(dst);
+
+    Size srclen = src->length;
+    Size newlen = srclen + index;
+    ERR_RETURN_IF_FAIL(newlen >= srclen, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_IF_FAIL(reserve_for_result(dst, newlen), ERR_OUT_OF_MEMORY);
+
+    Size nsrc = WORD_BYTES(srclen) / 8;
+    Size ndst = WORD_BYTES(newlen) / 8;
+    Size ws   = index / 64;
+    Size bs   = index % 64;
+
+    const Uint8* s = src->data;
+    Uint8*       d = dst->data;
+    if(!bs) {
+        memmove(d + 8 * ws, s, 8 * nsrc);
+    } else {
+        for(Size i = ndst; i-- > ws;) {
+            Size   j  = i - ws;
+            Uint64 hi = j < nsrc ? load_word(s + 8 * j) << bs : 0;
+            Uint64 lo = j >= 1 && j - 1 < nsrc ? load_word(s + 8 * (j - 1)) >> (64 - bs) : 0;
+            store_word(d + 8 * i, hi | lo);
+        }
+    }
+    memset(d, 0, 8 * ws);
+
+    clear_stale_bits(dst, dst->length, newlen);
+    dst->length = newlen;
 }
 
 /**
@@ -683,7 +1123,7 @@ BitVector* bitvec_not(BitVector* bv) {
  * @p index must be strictly less than (1 << 63).
  *
  * `|  0  |  1  |  2  | . . . | n-1 |  n  | <<- bits will be introduced from this side`
- * New length will be original length + shift index.
+ * New length will be original length - shift index.
  *
  * @param bv.
  * @param index.
@@ -694,37 +1134,16 @@ BitVector* bitvec_shl(BitVector* bv, Size index) {
     ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
 
     /* create bitvec to store result */
-    BitVector* newbv = bitvec_create();
+    BitVector* newbv = bitvec_create_with_allocator(bv->allocator);
     ERR_RETURN_VALUE_IF_FAIL(newbv, INVALID_BITVECTOR, ERR_INVALID_OBJECT);
 
-    /* reserve space to store in new bitvector */
-    Int64 newbvlen = TO_INT64(bv->length) - TO_INT64(index);
-    if(newbvlen <= 0) {
-        return newbv;
-    } else {
-        bitvec_resize(newbv, newbvlen);
-    }
-
-    /* process differently if not 8bit aligned and if 8bit aligned */
-    Uint8 rem = MOD8(index);
-    if(rem) {
-        Size pos = DIV8(index);
-        Size sz = DIV8(newbvlen);
-        for(Size s = 0; s < sz; s++) {
-            newbv->data[s] |= GET8_HI(bv->data[pos], 8-rem); /* rem */ /* get lower 8-rem bits, can use select here also, because it's already adjusted */
-            newbv->data[s] |= SHL(GET8_LO(bv->data[pos+1], rem), 8-rem); /* select remaining higher rem bits and place them after */
-            pos++;
-        }
-    } else {
-        /* if bit shift is aligned to 8 bit boundary, then direct memcpy is fast */
-        memcpy(newbv->data, bv->data + DIV8(index), DIV8(newbvlen));
-    }
+    shift_bits_down(newbv, bv, index);
 
     return newbv;
 }
 
 /**
- * Perform shift-left (<<) operation on given @c BitVector.
+ * Perform shift-right (>>) operation on given @c BitVector.
  * @p index must be strictly less than (1 << 63).
  *
  * `bits will be introduced from this side -->> |  0  |  1  |  2  | . . . | n-1 |  n  |`
@@ -738,29 +1157,59 @@ BitVector* bitvec_shl(BitVector* bv, Size index) {
 BitVector* bitvec_shr(BitVector* bv, Size index) {
     ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
 
-    BitVector* newbv = bitvec_create();
+    BitVector* newbv = bitvec_create_with_allocator(bv->allocator);
     ERR_RETURN_VALUE_IF_FAIL(newbv, INVALID_BITVECTOR, ERR_INVALID_OBJECT);
-    bitvec_reserve(newbv, bv->length + index + 8); /* need space for extra 8 bits for cases when new length escapes boundary */
 
-    Uint8 rem = MOD8(index); /* remainder when index is divided by 8 */
+    shift_bits_up(newbv, bv, index);
 
-    if(rem) {
-        Size pos = DIV8(index);
-        /* adjust size depending on whether or not some extra bits need to be covered */
-        Size sz = DIV8(MOD8(bv->length) ? ALIGN8_HI(bv->length) : bv->length);
-        for(Size s = 0; s < sz; s++) {
-            newbv->data[pos]   |= SHL(GET8_LO(bv->data[s], 8-rem), rem); /* get lower 8-rem bits, (already adjusted) */
-            newbv->data[pos+1] |= GET8_HI(bv->data[s], rem); /* 8-rem */ /* (already adjusted), get higher rem bits */
-            pos++;
-        }
-    } else {
-        /* if bit shift is aligned to 8 bit boundary, then direct memcpy is fast */
-        memcpy(newbv->data + DIV8(index), bv->data, DIV8(bv->length));
-    }
+    return newbv;
+}
 
-    newbv->length = bv->length + index;
+/**
+ * Same as @c bitvec_shl, but stores result in @p dst, reusing it's memory.
+ * @p dst can be same as @p bv.
+ *
+ * @param dst
+ * @param bv
+ * @param index
+ * */
+void bitvec_shl_into(BitVector* dst, BitVector* bv, Size index) {
+    shift_bits_down(dst, bv, index);
+}
 
-    return newbv;
+/**
+ * Same as @c bitvec_shr, but stores result in @p dst, reusing it's memory.
+ * @p dst can be same as @p bv.
+ *
+ * @param dst
+ * @param bv
+ * @param index
+ * */
+void bitvec_shr_into(BitVector* dst, BitVector* bv, Size index) {
+    shift_bits_up(dst, bv, index);
+}
+
+/**
+ * Perform shift-left (<<) operation on given @c BitVector in place.
+ * Length decreases by @p index, memory is never reallocated.
+ *
+ * @param bv
+ * @param index
+ * */
+void bitvec_shl_assign(BitVector* bv, Size index) {
+    shift_bits_down(bv, bv, index);
+}
+
+/**
+ * Perform shift-right (>>) operation on given @c BitVector in place.
+ * Length increases by @p index, memory is reallocated only if
+ * new length does not fit in capacity.
+ *
+ * @param bv
+ * @param index
+ * */
+void bitvec_shr_assign(BitVector* bv, Size index) {
+    shift_bits_up(bv, bv, index);
 }
 
 /**
@@ -777,13 +1226,13 @@ BitVector* bitvec_shr(BitVector* bv, Size index) {
 Bool bitvec_cmpeq(BitVector* bv1, BitVector* bv2) {
     ERR_RETURN_VALUE_IF_FAIL(bv1 && bv2, False, ERR_INVALID_ARGUMENTS);
 
-    Uint64* d1 = (Uint64*)bv1->data;
-    Uint64* d2 = (Uint64*)bv2->data;
+    Uint8* d1 = bv1->data;
+    Uint8* d2 = bv2->data;
 
     /* compare 8bit aligned blocks first */
     Size minlen = MIN(bv1->capacity, bv2->capacity);
     Size commonlen = DIV8(minlen); /* number of bytes common between the two, always atleat 1 byte is common */
-    if(memcmp(d1, d2, commonlen) != 0) {
+    if(!mem_equal(d1, d2, commonlen)) {
         return False;
     }
 
@@ -801,3 +1250,368 @@ Bool bitvec_cmpeq(BitVector* bv1, BitVector* bv2) {
 
     return True;
 }
+
+/* mask with lower n bits set, n must be less than 64 */
+#define LOW_BITS_MASK(n) ((((Uint64)1) << (n)) - 1)
+
+/**
+ * Count set bits in given number of 64 bit words, using four independent
+ * accumulators so that hardware popcount instructions can overlap.
+ * */
+static Size popcount_words(const Uint8* data, Size nwords) {
+    Size c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    Size w = 0;
+    for(; w + 4 <= nwords; w += 4) {
+        c0 += (Size)__builtin_popcountll(load_word(data + 8 * w));
+        c1 += (Size)__builtin_popcountll(load_word(data + 8 * (w + 1)));
+        c2 += (Size)__builtin_popcountll(load_word(data + 8 * (w + 2)));
+        c3 += (Size)__builtin_popcountll(load_word(data + 8 * (w + 3)));
+    }
+    for(; w < nwords; w++) {
+        c0 += (Size)__builtin_popcountll(load_word(data + 8 * w));
+    }
+    return c0 + c1 + c2 + c3;
+}
+
+/**
+ * Count set bits in bit range [begin, end). @p end must not be past length
+ * of @c BitVector owning @p data, so that no word past length is read.
+ * */
+static Size count_bits(const Uint8* data, Size begin, Size end) {
+    if(begin >= end) return 0;
+
+    Size wb = begin / 64, we = end / 64;
+    Size rb = begin % 64, re = end % 64;
+
+    /* range lies within a single word */
+    if(wb == we) {
+        return (Size)__builtin_popcountll((load_word(data + 8 * wb) >> rb) & LOW_BITS_MASK(re - rb));
+    }
+
+    Size count = (Size)__builtin_popcountll(load_word(data + 8 * wb) >> rb);
+    count += popcount_words(data + 8 * (wb + 1), we - wb - 1);
+    if(re) {
+        count += (Size)__builtin_popcountll(load_word(data + 8 * we) & LOW_BITS_MASK(re));
+    }
+
+    return count;
+}
+
+/**
+ * Count number of set bits in given @c BitVector.
+ * Bits past length are always cleared, so whole words are counted.
+ * This is constant time if a valid rank index is present.
+ *
+ * @param bv
+ * @return Number of set bits.
+ * */
+Size bitvec_popcount(BitVector* bv) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, 0, ERR_INVALID_ARGUMENTS);
+
+    if(bv->rank_index && bv->rank_index->valid) {
+        return bv->rank_index->total;
+    }
+
+    return popcount_words(bv->data, WORD_BYTES(bv->length) / 8);
+}
+
+/**
+ * Count number of set bits in given range of @c BitVector.
+ * Parts of range past length of @p bv are ignored.
+ *
+ * @param bv
+ * @param range_begin Index of first bit in range.
+ * @param range_size Number of bits in range.
+ * @return Number of set bits in range.
+ * */
+Size bitvec_count_range(BitVector* bv, Size range_begin, Size range_size) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, 0, ERR_INVALID_ARGUMENTS);
+
+    Size end = range_size > bv->length - MIN(range_begin, bv->length) ?
+        bv->length : range_begin + range_size;
+    return count_bits(bv->data, range_begin, end);
+}
+
+/**
+ * Find first bit at or after @p from that is set in @p data, or in it's
+ * complement if @p flip is all ones. Returns SIZE_MAX if there's none
+ * before @p length.
+ * */
+static FORCE_INLINE Size find_next_bit(const Uint8* data, Size length, Size from, Uint64 flip) {
+    if(from >= length) return SIZE_MAX;
+
+    Size nwords = WORD_BYTES(length) / 8;
+    Size w = from / 64;
+
+    /* ignore bits before from in first word */
+    Uint64 word = (load_word(data + 8 * w) ^ flip) & ~LOW_BITS_MASK(from % 64);
+    while(!word) {
+        if(++w >= nwords) return SIZE_MAX;
+        word = load_word(data + 8 * w) ^ flip;
+    }
+
+    /* cleared bits past length look set in complement, filter them out */
+    Size index = w * 64 + (Size)__builtin_ctzll(word);
+    return index < length ? index : SIZE_MAX;
+}
+
+/**
+ * Find index of first set bit in given @c BitVector.
+ * Whole 64 bit words are skipped at once.
+ *
+ * @param bv
+ * @return Index of first set bit.
+ * @return SIZE_MAX if no bit is set.
+ * */
+Size bitvec_find_first_set(BitVector* bv) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return find_next_bit(bv->data, bv->length, 0, 0);
+}
+
+/**
+ * Find index of first clear bit in given @c BitVector.
+ * Whole 64 bit words are skipped at once.
+ *
+ * @param bv
+ * @return Index of first clear bit.
+ * @return SIZE_MAX if all bits up to length are set.
+ * */
+Size bitvec_find_first_clear(BitVector* bv) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return find_next_bit(bv->data, bv->length, 0, ~(Uint64)0);
+}
+
+/**
+ * Find index of first set bit at or after given index.
+ *
+ * @param bv
+ * @param from Index to start search from.
+ * @return Index of set bit.
+ * @return SIZE_MAX if no bit is set in range [from, length).
+ * */
+Size bitvec_find_next_set(BitVector* bv, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return find_next_bit(bv->data, bv->length, from, 0);
+}
+
+/**
+ * Find index of first clear bit at or after given index.
+ *
+ * @param bv
+ * @param from Index to start search from.
+ * @return Index of clear bit.
+ * @return SIZE_MAX if all bits are set in range [from, length).
+ * */
+Size bitvec_find_next_clear(BitVector* bv, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return find_next_bit(bv->data, bv->length, from, ~(Uint64)0);
+}
+
+/**
+ * Call @p visitor for index of each set bit in given @c BitVector,
+ * in increasing order. Set bits are extracted from each 64 bit word
+ * one at a time, so the cost is proportional to number of words plus
+ * number of set bits. @p visitor must not modify @p bv.
+ *
+ * @param bv
+ * @param visitor Callback to be called for each set bit.
+ * @param udata User data to be passed to @p visitor.
+ * */
+void bitvec_foreach_set(BitVector* bv, BitVectorVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(bv && visitor, ERR_INVALID_ARGUMENTS);
+
+    Size nwords = WORD_BYTES(bv->length) / 8;
+    for(Size w = 0; w < nwords; w++) {
+        Uint64 word = load_word(bv->data + 8 * w);
+        while(word) {
+            visitor(w * 64 + (Size)__builtin_ctzll(word), udata);
+            word &= word - 1;
+        }
+    }
+}
+
+/**
+ * (Re)compute rank directory of given @c BitVector for it's current bits.
+ * */
+static Bool rebuild_rank_index(BitVector* bv) {
+    BitVectorRankIndex* ri = bv->rank_index;
+
+    Size block_count = (bv->length + BITVEC_RANK_BLOCK_BITS - 1) / BITVEC_RANK_BLOCK_BITS;
+    Size super_count = (bv->length + BITVEC_RANK_SUPERBLOCK_BITS - 1) / BITVEC_RANK_SUPERBLOCK_BITS;
+
+    /* grow directory to fit current length, it's never shrunk */
+    if(block_count > ri->block_count) {
+        Uint16* blocks = allocator_reallocate(bv->allocator, ri->blocks, ri->block_count * sizeof(Uint16), block_count * sizeof(Uint16));
+        ERR_RETURN_VALUE_IF_FAIL(blocks, False, ERR_OUT_OF_MEMORY);
+        ri->blocks      = blocks;
+        ri->block_count = block_count;
+    }
+    if(super_count > ri->super_count) {
+        Size* supers = allocator_reallocate(bv->allocator, ri->supers, ri->super_count * sizeof(Size), super_count * sizeof(Size));
+        ERR_RETURN_VALUE_IF_FAIL(supers, False, ERR_OUT_OF_MEMORY);
+        ri->supers      = supers;
+        ri->super_count = super_count;
+    }
+
+    const Size words_per_block = BITVEC_RANK_BLOCK_BITS / 64;
+    const Size blocks_per_super = BITVEC_RANK_SUPERBLOCK_BITS / BITVEC_RANK_BLOCK_BITS;
+    Size nwords = WORD_BYTES(bv->length) / 8;
+
+    Size total = 0;
+    for(Size b = 0; b < block_count; b++) {
+        if(b % blocks_per_super == 0) {
+            ri->supers[b / blocks_per_super] = total;
+        }
+        ri->blocks[b] = (Uint16)(total - ri->supers[b / blocks_per_super]);
+
+        Size w = b * words_per_block;
+        total += popcount_words(bv->data + 8 * w, MIN(words_per_block, nwords - w));
+    }
+
+    ri->length = bv->length;
+    ri->total  = total;
+    ri->valid  = True;
+
+    return True;
+}
+
+/**
+ * Get rank directory of given @c BitVector, rebuilding it if stale.
+ * @return NULL if there's no rank directory or it cannot be rebuilt.
+ * */
+static FORCE_INLINE BitVectorRankIndex* get_rank_index(BitVector* bv) {
+    BitVectorRankIndex* ri = bv->rank_index;
+    if(ri && !ri->valid && !rebuild_rank_index(bv)) {
+        return NULL;
+    }
+    return ri;
+}
+
+/**
+ * Build a rank directory for given @c BitVector, making @c bitvec_rank
+ * constant time and @c bitvec_select logarithmic time. Once built, any
+ * operation that changes bits of @p bv marks it stale and it's rebuilt
+ * lazily on next rank or select query.
+ *
+ * Writes made directly to @c data bypass this, so call this again after
+ * modifying @c data by hand.
+ *
+ * @param bv
+ * */
+void bitvec_build_rank_index(BitVector* bv) {
+    ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+
+    if(!bv->rank_index) {
+        bv->rank_index = allocator_allocate_zeroed(bv->allocator, sizeof(BitVectorRankIndex));
+        ERR_RETURN_IF_FAIL(bv->rank_index, ERR_OUT_OF_MEMORY);
+    }
+
+    rebuild_rank_index(bv);
+}
+
+/**
+ * Release rank directory of given @c BitVector, if it has one.
+ * Rank and select queries fall back to scanning words after this.
+ *
+ * @param bv
+ * */
+void bitvec_drop_rank_index(BitVector* bv) {
+    ERR_RETURN_IF_FAIL(bv, ERR_INVALID_ARGUMENTS);
+
+    BitVectorRankIndex* ri = bv->rank_index;
+    if(!ri) return;
+
+    allocator_free(bv->allocator, ri->blocks, ri->block_count * sizeof(Uint16));
+    allocator_free(bv->allocator, ri->supers, ri->super_count * sizeof(Size));
+    allocator_free(bv->allocator, ri, sizeof(BitVectorRankIndex));
+    bv->rank_index = NULL;
+}
+
+/**
+ * Count number of set bits before given index, i.e. in range [0, index).
+ * Constant time if @p bv has a rank directory, linear otherwise.
+ *
+ * @param bv
+ * @param index Indices past length are treated as length.
+ * @return Number of set bits before @p index.
+ * */
+Size bitvec_rank(BitVector* bv, Size index) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, 0, ERR_INVALID_ARGUMENTS);
+
+    index = MIN(index, bv->length);
+
+    BitVectorRankIndex* ri = get_rank_index(bv);
+    if(!ri) {
+        return count_bits(bv->data, 0, index);
+    }
+
+    /* at most one block worth of words is counted after directory lookup */
+    Size b = index / BITVEC_RANK_BLOCK_BITS;
+    if(b == ri->block_count) {
+        return ri->total;
+    }
+
+    Size rank = ri->supers[index / BITVEC_RANK_SUPERBLOCK_BITS] + ri->blocks[b];
+    return rank + count_bits(bv->data, b * BITVEC_RANK_BLOCK_BITS, index);
+}
+
+/* index of k-th (0 based) set bit in a word, which must have more than k set bits */
+static FORCE_INLINE Size select_in_word(Uint64 w, Size k) {
+    while(k--) {
+        w &= w - 1;
+    }
+    return (Size)__builtin_ctzll(w);
+}
+
+/**
+ * Find index of k-th set bit, with k starting from 0, so that
+ * `bitvec_rank(bv, bitvec_select(bv, k)) == k`.
+ * Logarithmic time if @p bv has a rank directory, linear otherwise.
+ *
+ * @param bv
+ * @param k Number of set bits to skip.
+ * @return Index of k-th set bit.
+ * @return SIZE_MAX if @p bv has @p k or less set bits.
+ * */
+Size bitvec_select(BitVector* bv, Size k) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    Size nwords = WORD_BYTES(bv->length) / 8;
+    Size w = 0;
+
+    BitVectorRankIndex* ri = get_rank_index(bv);
+    if(ri) {
+        if(k >= ri->total) return SIZE_MAX;
+
+        /* last superblock having at most k set bits before it */
+        Size lo = 0, hi = ri->super_count;
+        while(hi - lo > 1) {
+            Size mid = lo + (hi - lo) / 2;
+            if(ri->supers[mid] <= k) lo = mid;
+            else hi = mid;
+        }
+
+        /* then last block within it having at most k set bits before it */
+        const Size blocks_per_super = BITVEC_RANK_SUPERBLOCK_BITS / BITVEC_RANK_BLOCK_BITS;
+        Size b = lo * blocks_per_super;
+        Size bend = MIN(b + blocks_per_super, ri->block_count);
+        k -= ri->supers[lo];
+        while(b + 1 < bend && ri->blocks[b + 1] <= k) b++;
+
+        k -= ri->blocks[b];
+        w = b * (BITVEC_RANK_BLOCK_BITS / 64);
+    }
+
+    for(; w < nwords; w++) {
+        Uint64 word = load_word(bv->data + 8 * w);
+        Size count = (Size)__builtin_popcountll(word);
+        if(k < count) {
+            return w * 64 + select_in_word(word, k);
+        }
+        k -= count;
+    }
+
+    return SIZE_MAX;
+}
+
+#undef LOW_BITS_MASK
@@ -0,0 +1,327 @@
+/**
+ * @file BloomFilter.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of @c BloomFilter in Containers/BloomFilter.h
+ * */
+
+#include <Anvie/Containers/BloomFilter.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Simd/Simd.h>
+#include <string.h>
+#include <math.h>
+
+#define BLOCK_BYTES (BLOOM_BLOCK_BITS / 8)
+#define BLOCK_WORDS (BLOOM_BLOCK_BITS / 64)
+
+/* number of bits needed to address a bit inside a block */
+#define BLOCK_INDEX_BITS 9
+
+/* finalizer of splitmix64, spreads every input bit over whole output */
+static FORCE_INLINE Uint64 mix_hash(Uint64 x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * Get number of bits a filter needs to hold given number of keys with
+ * given false positive rate : `m = -n ln(p) / ln(2)^2`.
+ * @param expected_count Number of keys expected to be inserted.
+ * @param false_positive_rate Acceptable false positive rate, in (0, 1).
+ * @return Number of bits, 0 on invalid arguments.
+ * */
+Size bloom_optimal_bit_count(Size expected_count, Float64 false_positive_rate) {
+    ERR_RETURN_VALUE_IF_FAIL(false_positive_rate > 0 && false_positive_rate < 1, 0, ERR_INVALID_ARGUMENTS);
+
+    Float64 n    = (Float64)MAX(expected_count, (Size)1);
+    Float64 bits = ceil(-n * log(false_positive_rate) / (M_LN2 * M_LN2));
+    return MAX((Size)bits, (Size)64);
+}
+
+/**
+ * Get number of probes per key that minimizes false positive rate
+ * for given number of bits and keys : `k = (m / n) ln(2)`.
+ * @param bit_count Number of bits in filter.
+ * @param expected_count Number of keys expected to be inserted.
+ * @return Number of probes, in [1, BLOOM_MAX_HASH_COUNT].
+ * */
+Uint32 bloom_optimal_hash_count(Size bit_count, Size expected_count) {
+    Float64 k = round((Float64)bit_count / (Float64)MAX(expected_count, (Size)1) * M_LN2);
+    if(k < 1) return 1;
+    if(k > BLOOM_MAX_HASH_COUNT) return BLOOM_MAX_HASH_COUNT;
+    return (Uint32)k;
+}
+
+/**
+ * Create a new empty Bloom filter.
+ * @param hash Hash function applied to keys.
+ * @param bit_count Number of bits. Rounded up to a multiple of
+ * @c BLOOM_BLOCK_BITS for blocked filters.
+ * @param hash_count Number of probes per key, in [1, BLOOM_MAX_HASH_COUNT].
+ * @param is_blocked Place all probes of a key in one cache line.
+ * @return BloomFilter* on success, NULL otherwise.
+ * */
+BloomFilter* bloom_create(HashCallback hash, Size bit_count, Uint32 hash_count, Bool is_blocked) {
+    return bloom_create_with_allocator(hash, bit_count, hash_count, is_blocked, NULL);
+}
+
+/**
+ * Same as @c bloom_create, but allocates all memory from given allocator.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return BloomFilter* on success, NULL otherwise.
+ * */
+BloomFilter* bloom_create_with_allocator(HashCallback hash, Size bit_count, Uint32 hash_count, Bool is_blocked, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(hash && bit_count, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(hash_count && hash_count <= BLOOM_MAX_HASH_COUNT, NULL, ERR_INVALID_ARGUMENTS);
+
+    if(is_blocked) {
+        bit_count = (bit_count + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS * BLOOM_BLOCK_BITS;
+    }
+
+    BloomFilter* bf = allocator_allocate_zeroed(allocator, sizeof(BloomFilter));
+    ERR_RETURN_VALUE_IF_FAIL(bf, NULL, ERR_OUT_OF_MEMORY);
+
+    bf->bits = bitvec_create_with_allocator(allocator);
+    if(bf->bits) bitvec_resize(bf->bits, bit_count);
+    if(!bf->bits || bf->bits->length != bit_count) {
+        if(bf->bits) bitvec_destroy(bf->bits);
+        allocator_free(allocator, bf, sizeof(BloomFilter));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    bf->bit_count   = bit_count;
+    bf->block_count = is_blocked ? bit_count / BLOOM_BLOCK_BITS : 0;
+    bf->hash_count  = hash_count;
+    bf->is_blocked  = is_blocked;
+    bf->hash        = hash;
+    bf->allocator   = allocator;
+
+    return bf;
+}
+
+/**
+ * Create a Bloom filter sized for given number of keys and false
+ * positive rate, using @c bloom_optimal_bit_count and
+ * @c bloom_optimal_hash_count.
+ * @param hash Hash function applied to keys.
+ * @param expected_count Number of keys expected to be inserted.
+ * @param false_positive_rate Acceptable false positive rate, in (0, 1).
+ * @param is_blocked Place all probes of a key in one cache line.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return BloomFilter* on success, NULL otherwise.
+ * */
+BloomFilter* bloom_create_for(HashCallback hash, Size expected_count, Float64 false_positive_rate, Bool is_blocked, Allocator* allocator) {
+    Size bit_count = bloom_optimal_bit_count(expected_count, false_positive_rate);
+    ERR_RETURN_VALUE_IF_FAIL(bit_count, NULL, ERR_INVALID_ARGUMENTS);
+
+    Uint32 hash_count = bloom_optimal_hash_count(bit_count, expected_count);
+    return bloom_create_with_allocator(hash, bit_count, hash_count, is_blocked, allocator);
+}
+
+/**
+ * Destroy given Bloom filter.
+ * @param bf
+ * */
+void bloom_destroy(BloomFilter* bf) {
+    ERR_RETURN_IF_FAIL(bf, ERR_INVALID_ARGUMENTS);
+
+    bitvec_destroy(bf->bits);
+    allocator_free(bf->allocator, bf, sizeof(BloomFilter));
+}
+
+/**
+ * Remove all keys from given Bloom filter.
+ * @param bf
+ * */
+void bloom_clear(BloomFilter* bf) {
+    ERR_RETURN_IF_FAIL(bf, ERR_INVALID_ARGUMENTS);
+
+    bitvec_clear_all(bf->bits);
+    bf->item_count = 0;
+}
+
+/**
+ * Build mask of all probes of a key inside it's block.
+ * Each probe takes @c BLOCK_INDEX_BITS bits of @p h2, which is remixed
+ * once all it's bits are used.
+ * */
+static void build_block_mask(Uint64* mask, Uint64 h2, Uint32 hash_count) {
+    memset(mask, 0, BLOCK_BYTES);
+
+    Uint32 left = 64 / BLOCK_INDEX_BITS;
+    for(Uint32 i = 0; i < hash_count; i++) {
+        if(!left) {
+            h2   = mix_hash(h2);
+            left = 64 / BLOCK_INDEX_BITS;
+        }
+
+        Uint32 bit = (Uint32)(h2 & (BLOOM_BLOCK_BITS - 1));
+        mask[bit >> 6] |= (Uint64)1 << (bit & 63);
+        h2 >>= BLOCK_INDEX_BITS;
+        left--;
+    }
+}
+
+/* check whether all bits of mask are set in given block */
+static FORCE_INLINE Bool block_contains_mask(const Uint8* block, const Uint64* mask) {
+#if SIMD_ENABLED
+    const Uint8* m     = (const Uint8*)mask;
+    const MVec   zeroes = simd_set1_epi8(0);
+    MVec         missing = zeroes;
+    for(Size i = 0; i < BLOCK_BYTES; i += sizeof(MVec)) {
+        MVec mv = simd_loadu(m + i);
+        missing = simd_or(missing, simd_andnot(simd_loadu(block + i), mv));
+    }
+    return !(~simd_movemask_epi8(simd_cmpeq_epi8(missing, zeroes)) & (MMask)-1);
+#else
+    Uint64 missing = 0;
+    for(Size w = 0; w < BLOCK_WORDS; w++) {
+        Uint64 word;
+        memcpy(&word, block + w * 8, 8);
+        missing |= mask[w] & ~word;
+    }
+    return !missing;
+#endif // SIMD_ENABLED
+}
+
+/**
+ * Insert a key by it's precomputed hash. Hash must come from same
+ * function as @c BloomFilter::hash for @c bloom_contains to find it.
+ * @param bf
+ * @param hash
+ * */
+void bloom_insert_hash(BloomFilter* bf, Size hash) {
+    ERR_RETURN_IF_FAIL(bf, ERR_INVALID_ARGUMENTS);
+
+    Uint64 h1   = mix_hash(hash);
+    Uint64 h2   = mix_hash(h1 ^ 0x9e3779b97f4a7c15ull);
+    Uint8* data = bf->bits->data;
+
+    if(bf->is_blocked) {
+        Uint64 mask[BLOCK_WORDS];
+        build_block_mask(mask, h2, bf->hash_count);
+
+        Uint8* block = data + (h1 % bf->block_count) * BLOCK_BYTES;
+        for(Size w = 0; w < BLOCK_WORDS; w++) {
+            Uint64 word;
+            memcpy(&word, block + w * 8, 8);
+            word |= mask[w];
+            memcpy(block + w * 8, &word, 8);
+        }
+    } else {
+        h2 |= 1;
+        for(Uint32 i = 0; i < bf->hash_count; i++) {
+            Size bit = (h1 + i * h2) % bf->bit_count;
+            data[bit >> 3] |= (Uint8)(1 << (bit & 7));
+        }
+    }
+
+    bf->item_count++;
+}
+
+/**
+ * Check whether a key may have been inserted, by it's precomputed hash.
+ * @param bf
+ * @param hash
+ * @return False if key was definitely never inserted.
+ * @return True if key may have been inserted.
+ * */
+Bool bloom_contains_hash(BloomFilter* bf, Size hash) {
+    ERR_RETURN_VALUE_IF_FAIL(bf, False, ERR_INVALID_ARGUMENTS);
+
+    Uint64 h1   = mix_hash(hash);
+    Uint64 h2   = mix_hash(h1 ^ 0x9e3779b97f4a7c15ull);
+    Uint8* data = bf->bits->data;
+
+    if(bf->is_blocked) {
+        Uint64 mask[BLOCK_WORDS];
+        build_block_mask(mask, h2, bf->hash_count);
+        return block_contains_mask(data + (h1 % bf->block_count) * BLOCK_BYTES, mask);
+    }
+
+    h2 |= 1;
+    for(Uint32 i = 0; i < bf->hash_count; i++) {
+        Size bit = (h1 + i * h2) % bf->bit_count;
+        if(!(data[bit >> 3] & (1 << (bit & 7)))) {
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/**
+ * Insert a key into given Bloom filter.
+ * @param bf
+ * @param key Key passed to @c BloomFilter::hash.
+ * @param udata User data passed to @c BloomFilter::hash.
+ * */
+void bloom_insert(BloomFilter* bf, void* key, void* udata) {
+    ERR_RETURN_IF_FAIL(bf, ERR_INVALID_ARGUMENTS);
+
+    bloom_insert_hash(bf, bf->hash(key, udata));
+}
+
+/**
+ * Check whether a key may have been inserted into given Bloom filter.
+ * @param bf
+ * @param key Key passed to @c BloomFilter::hash.
+ * @param udata User data passed to @c BloomFilter::hash.
+ * @return False if key was definitely never inserted.
+ * @return True if key may have been inserted.
+ * */
+Bool bloom_contains(BloomFilter* bf, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(bf, False, ERR_INVALID_ARGUMENTS);
+
+    return bloom_contains_hash(bf, bf->hash(key, udata));
+}
+
+/**
+ * Add all keys of @p src to @p dst. Both filters must have been created
+ * with same hash function, bit count, hash count and blocking.
+ * @param dst
+ * @param src
+ * */
+void bloom_merge(BloomFilter* dst, BloomFilter* src) {
+    ERR_RETURN_IF_FAIL(dst && src, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_IF_FAIL(dst->hash == src->hash && dst->bit_count == src->bit_count &&
+                       dst->hash_count == src->hash_count && dst->is_blocked == src->is_blocked,
+                       ERR_INVALID_ARGUMENTS);
+
+    bitvec_or_assign(dst->bits, src->bits);
+    dst->item_count += src->item_count;
+}
+
+/**
+ * Estimate false positive rate of given filter from number of
+ * insertions so far : `(1 - e^(-kn/m))^k`. Blocked filters are a little
+ * worse than this estimate.
+ * @param bf
+ * */
+Float64 bloom_estimated_false_positive_rate(BloomFilter* bf) {
+    ERR_RETURN_VALUE_IF_FAIL(bf, 1, ERR_INVALID_ARGUMENTS);
+
+    Float64 k = bf->hash_count;
+    return pow(1 - exp(-k * (Float64)bf->item_count / (Float64)bf->bit_count), k);
+}
@@ -0,0 +1,666 @@
+/**
+ * @file Cache.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Bounded caches with LRU, CLOCK and S3-FIFO eviction, and a
+ * sharded thread safe variant.
+ * */
+
+#include <Anvie/Containers/Cache.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+#include <string.h>
+
+/* round value up to a multiple of a power of two */
+#define ALIGN_UP(value, align) (((value) + (align) - 1) & ~((Size)(align) - 1))
+
+/* queue ids stored in CacheEntry::queue */
+#define QUEUE_MAIN  0
+#define QUEUE_SMALL 1
+#define QUEUE_FREE  0xff
+
+/* S3-FIFO access counts saturate here */
+#define S3FIFO_MAX_FREQ 3
+
+/* address of slot of given entry */
+#define SLOT(cache, e) ((cache)->slots + (Size)(e) * (cache)->slot_size)
+
+/* key of given entry, in the form passed to callbacks */
+static FORCE_INLINE void* entry_key(Cache* cache, Uint32 e) {
+    Uint8* slot = SLOT(cache, e);
+    if(cache->key_size > 8) {
+        return slot;
+    }
+
+    Uint64 value = 0;
+    memcpy(&value, slot, cache->key_size);
+    return (void*)value;
+}
+
+/* entry holding given key, CACHE_NONE when absent */
+static FORCE_INLINE Uint32 find_entry(Cache* cache, void* key, Size hash, void* udata) {
+    DenseMapItem* item = dense_map_search_with_hash(cache->index, key, hash, udata);
+    if(!item) {
+        return CACHE_NONE;
+    }
+
+    Uint64 e = 0;
+    memcpy(&e, dense_map_slot_data(cache->index, item), sizeof(e));
+    return (Uint32)e;
+}
+
+/* add entry at head of given queue */
+static void queue_push(Cache* cache, Uint8 q, Uint32 e) {
+    CacheQueue* queue = cache->queues + q;
+    CacheEntry* entry = cache->entries + e;
+
+    entry->queue = q;
+    entry->prev  = CACHE_NONE;
+    entry->next  = queue->head;
+    if(queue->head != CACHE_NONE) {
+        cache->entries[queue->head].prev = e;
+    } else {
+        queue->tail = e;
+    }
+    queue->head = e;
+
+    queue->count++;
+    queue->charge += entry->charge;
+}
+
+/* remove entry from queue holding it */
+static void queue_remove(Cache* cache, Uint32 e) {
+    CacheEntry* entry = cache->entries + e;
+    CacheQueue* queue = cache->queues + entry->queue;
+
+    if(entry->prev != CACHE_NONE) {
+        cache->entries[entry->prev].next = entry->next;
+    } else {
+        queue->head = entry->next;
+    }
+    if(entry->next != CACHE_NONE) {
+        cache->entries[entry->next].prev = entry->prev;
+    } else {
+        queue->tail = entry->prev;
+    }
+
+    queue->count--;
+    queue->charge -= entry->charge;
+}
+
+/* slot in ghost table for given hash */
+static FORCE_INLINE Uint64* ghost_of(Cache* cache, Size hash) {
+    return cache->ghosts + (hash_mix64(hash) & cache->ghost_mask);
+}
+
+/* ghost tag of given hash, never 0 so that an empty ghost slot matches nothing */
+#define GHOST_TAG(hash) ((Uint64)(hash) | 1)
+
+/* record key that just got hit */
+static FORCE_INLINE void touch(Cache* cache, Uint32 e) {
+    CacheEntry* entry = cache->entries + e;
+    switch(cache->policy) {
+        case CACHE_POLICY_LRU :
+            if(cache->queues[QUEUE_MAIN].head != e) {
+                queue_remove(cache, e);
+                queue_push(cache, QUEUE_MAIN, e);
+            }
+            break;
+        case CACHE_POLICY_CLOCK :
+            entry->freq = 1;
+            break;
+        case CACHE_POLICY_S3FIFO :
+            entry->freq = MIN(entry->freq + 1, S3FIFO_MAX_FREQ);
+            break;
+    }
+}
+
+/* pick entry to evict, never @p keep */
+static Uint32 pick_victim(Cache* cache, Uint32 keep) {
+    switch(cache->policy) {
+        case CACHE_POLICY_LRU : {
+            Uint32 e = cache->queues[QUEUE_MAIN].tail;
+            return e == keep ? cache->entries[e].prev : e;
+        }
+
+        case CACHE_POLICY_CLOCK : {
+            for(;;) {
+                Uint32      e     = cache->hand;
+                CacheEntry* entry = cache->entries + e;
+                cache->hand = (Uint32)((e + 1) % cache->max_entries);
+                if(entry->queue == QUEUE_FREE || e == keep) {
+                    continue;
+                }
+                if(!entry->freq) {
+                    return e;
+                }
+                entry->freq = 0;
+            }
+        }
+
+        case CACHE_POLICY_S3FIFO : {
+            CacheQueue* small         = cache->queues + QUEUE_SMALL;
+            CacheQueue* main_queue    = cache->queues + QUEUE_MAIN;
+            Size        small_entries = MAX(cache->max_entries / 10, (Size)1);
+            Size        small_charge  = cache->max_charge / 10;
+            for(;;) {
+                /* small queue is evicted from while it's above it's share, or when main queue is empty */
+                Bool from_small = small->count && (small->count >= small_entries || !main_queue->count ||
+                                                   (cache->max_charge && small->charge > small_charge));
+                Uint8       q     = from_small ? QUEUE_SMALL : QUEUE_MAIN;
+                Uint32      e     = cache->queues[q].tail;
+                CacheEntry* entry = cache->entries + e;
+
+                /* accessed entries get another round, in main queue */
+                if(entry->freq || e == keep) {
+                    queue_remove(cache, e);
+                    entry->freq = from_small ? 0 : entry->freq - (e != keep);
+                    queue_push(cache, QUEUE_MAIN, e);
+                    continue;
+                }
+
+                if(from_small) {
+                    *ghost_of(cache, entry->hash) = GHOST_TAG(entry->hash);
+                }
+                return e;
+            }
+        }
+    }
+
+    return CACHE_NONE;
+}
+
+/* remove given entry from queue and index, and put it on free list */
+static void release_entry(Cache* cache, Uint32 e, void* udata) {
+    CacheEntry* entry = cache->entries + e;
+
+    dense_map_delete(cache->index, entry_key(cache, e), udata);
+    if(cache->policy != CACHE_POLICY_CLOCK) {
+        queue_remove(cache, e);
+    }
+
+    cache->item_count--;
+    cache->charge -= entry->charge;
+
+    entry->queue     = QUEUE_FREE;
+    entry->next      = cache->free_head;
+    cache->free_head = e;
+}
+
+/* evict one entry other than @p keep */
+static void evict_one(Cache* cache, Uint32 keep, CacheEvictCallback on_evict, void* udata) {
+    Uint32 e = pick_victim(cache, keep);
+    if(on_evict) {
+        on_evict(entry_key(cache, e), SLOT(cache, e) + cache->data_offset, udata);
+    }
+
+    release_entry(cache, e, udata);
+    cache->stats.evictions++;
+}
+
+/**
+ * Create a new cache.
+ *
+ * @param hash Hash function for keys.
+ * @param key_size Size of key in bytes.
+ * @param compare_key Key comparision function.
+ * @param data_size Size of data in bytes.
+ * @param max_entries Maximum number of entries, all allocated at once.
+ * @param max_charge Maximum sum of charges of entries, 0 for no limit.
+ * @param policy Eviction policy.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return Cache object on success, NULL otherwise.
+ * */
+Cache* cache_create(
+    HashCallback           hash,
+    Size                   key_size,
+    CompareElementCallback compare_key,
+    Size                   data_size,
+    Size                   max_entries,
+    Size                   max_charge,
+    CachePolicy            policy,
+    Allocator*             allocator
+) {
+    ERR_RETURN_VALUE_IF_FAIL(hash && compare_key && key_size && data_size, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(max_entries && max_entries < CACHE_NONE && policy <= CACHE_POLICY_S3FIFO, NULL, ERR_INVALID_ARGUMENTS);
+
+    Cache* cache = allocator_allocate_zeroed(allocator, sizeof(Cache));
+    ERR_RETURN_VALUE_IF_FAIL(cache, NULL, ERR_OUT_OF_MEMORY);
+
+    cache->policy      = policy;
+    cache->hash        = hash;
+    cache->key_size    = key_size;
+    cache->data_size   = data_size;
+    cache->data_offset = ALIGN_UP(key_size, 8);
+    cache->slot_size   = ALIGN_UP(cache->data_offset + data_size, 8);
+    cache->max_entries = max_entries;
+    cache->max_charge  = max_charge;
+    cache->allocator   = allocator;
+
+    // index stores key bytes inline, so that large keys are not allocated one by one
+    cache->index   = dense_map_create_inline(hash, key_size, NULL, NULL, compare_key, sizeof(Uint64), NULL, NULL, 0, 0,
+                                             False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, allocator);
+    cache->slots   = allocator_allocate(allocator, max_entries * cache->slot_size);
+    cache->entries = allocator_allocate(allocator, max_entries * sizeof(CacheEntry));
+    if(policy == CACHE_POLICY_S3FIFO) {
+        cache->ghost_mask = NEXT_POW2(max_entries) - 1;
+        cache->ghosts     = allocator_allocate_zeroed(allocator, (cache->ghost_mask + 1) * sizeof(Uint64));
+    }
+
+    if(!cache->index || !cache->slots || !cache->entries || (policy == CACHE_POLICY_S3FIFO && !cache->ghosts)) {
+        cache_destroy(cache);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    dense_map_reserve(cache->index, max_entries, NULL);
+    cache_clear(cache, NULL);
+
+    return cache;
+}
+
+/**
+ * Destroy given cache.
+ * @param cache
+ * */
+void cache_destroy(Cache* cache) {
+    ERR_RETURN_IF_FAIL(cache, ERR_INVALID_ARGUMENTS);
+
+    if(cache->index) {
+        dense_map_destroy(cache->index, NULL);
+    }
+    if(cache->slots) {
+        allocator_free(cache->allocator, cache->slots, cache->max_entries * cache->slot_size);
+    }
+    if(cache->entries) {
+        allocator_free(cache->allocator, cache->entries, cache->max_entries * sizeof(CacheEntry));
+    }
+    if(cache->ghosts) {
+        allocator_free(cache->allocator, cache->ghosts, (cache->ghost_mask + 1) * sizeof(Uint64));
+    }
+    allocator_free(cache->allocator, cache, sizeof(Cache));
+}
+
+/**
+ * Remove all entries from cache, without calling eviction callbacks.
+ * Counters are kept, see @c cache_reset_stats.
+ * @param cache
+ * @param udata User data passed to callbacks of index.
+ * */
+void cache_clear(Cache* cache, void* udata) {
+    ERR_RETURN_IF_FAIL(cache, ERR_INVALID_ARGUMENTS);
+
+    dense_map_clear(cache->index, udata);
+
+    for(Size e = 0; e < cache->max_entries; e++) {
+        cache->entries[e].queue = QUEUE_FREE;
+        cache->entries[e].next  = e + 1 < cache->max_entries ? (Uint32)(e + 1) : CACHE_NONE;
+    }
+    for(Size q = 0; q < 2; q++) {
+        cache->queues[q] = (CacheQueue) {.head = CACHE_NONE, .tail = CACHE_NONE};
+    }
+    if(cache->ghosts) {
+        memset(cache->ghosts, 0, (cache->ghost_mask + 1) * sizeof(Uint64));
+    }
+
+    cache->free_head  = 0;
+    cache->hand       = 0;
+    cache->item_count = 0;
+    cache->charge     = 0;
+}
+
+/**
+ * Insert given key with given data, replacing data when key is present.
+ * Entries are evicted first when cache has no room, and @p on_evict is
+ * called for each of them before it's storage is reused.
+ *
+ * @param cache
+ * @param key
+ * @param data Pointer to @c data_size bytes of data to be copied into cache.
+ * @param charge Cost of entry. Must be at most @c max_charge when that is set.
+ * @param on_evict Called for each evicted entry, can be NULL.
+ * @param udata User data passed to callbacks.
+ * @return True on success, False when @p charge can never fit.
+ * */
+Bool cache_insert(Cache* cache, void* key, const void* data, Size charge, CacheEvictCallback on_evict, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, False, ERR_INVALID_ARGUMENTS);
+    return cache_insert_with_hash(cache, key, data, charge, cache->hash(key, udata), on_evict, udata);
+}
+
+/**
+ * Same as @c cache_insert, with hash of key already computed by caller.
+ * @param hash Hash of key. Must be exactly what `hash` callback of cache returns for @p key.
+ * */
+Bool cache_insert_with_hash(Cache* cache, void* key, const void* data, Size charge, Size hash, CacheEvictCallback on_evict, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache && data, False, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!cache->max_charge || charge <= cache->max_charge, False, ERR_INVALID_ARGUMENTS);
+
+    Uint32 e = find_entry(cache, key, hash, udata);
+    if(e != CACHE_NONE) {
+        CacheEntry* entry = cache->entries + e;
+        memcpy(SLOT(cache, e) + cache->data_offset, data, cache->data_size);
+
+        if(cache->policy != CACHE_POLICY_CLOCK) {
+            cache->queues[entry->queue].charge += charge - entry->charge;
+        }
+        cache->charge += charge - entry->charge;
+        entry->charge  = charge;
+        touch(cache, e);
+
+        while(cache->max_charge && cache->charge > cache->max_charge) {
+            evict_one(cache, e, on_evict, udata);
+        }
+        return True;
+    }
+
+    while(cache->item_count == cache->max_entries || (cache->max_charge && cache->charge + charge > cache->max_charge)) {
+        evict_one(cache, CACHE_NONE, on_evict, udata);
+    }
+
+    e = cache->free_head;
+    CacheEntry* entry = cache->entries + e;
+    cache->free_head = entry->next;
+
+    Uint8* slot = SLOT(cache, e);
+    memcpy(slot, cache->key_size > 8 ? key : (void*)&key, cache->key_size);
+    memcpy(slot + cache->data_offset, data, cache->data_size);
+
+    Uint64 index_data = e;
+    if(!dense_map_insert_with_hash(cache->index, entry_key(cache, e), (void*)index_data, hash, udata)) {
+        entry->next      = cache->free_head;
+        cache->free_head = e;
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return False;
+    }
+
+    entry->hash   = hash;
+    entry->charge = charge;
+    entry->freq   = 0;
+    cache->item_count++;
+    cache->charge += charge;
+    cache->stats.insertions++;
+
+    switch(cache->policy) {
+        case CACHE_POLICY_LRU :
+            queue_push(cache, QUEUE_MAIN, e);
+            break;
+        case CACHE_POLICY_CLOCK :
+            entry->queue = QUEUE_MAIN;
+            break;
+        case CACHE_POLICY_S3FIFO : {
+            /* keys evicted from small queue not long ago go straight to main queue */
+            Uint64* ghost = ghost_of(cache, hash);
+            if(*ghost == GHOST_TAG(hash)) {
+                *ghost = 0;
+                queue_push(cache, QUEUE_MAIN, e);
+            } else {
+                queue_push(cache, QUEUE_SMALL, e);
+            }
+            break;
+        }
+    }
+
+    return True;
+}
+
+/**
+ * Search for given key, and record it as used.
+ * @param cache
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return Pointer to data of key, valid until next insert or delete, NULL when absent.
+ * */
+void* cache_get(Cache* cache, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, NULL, ERR_INVALID_ARGUMENTS);
+    return cache_get_with_hash(cache, key, cache->hash(key, udata), udata);
+}
+
+/**
+ * Same as @c cache_get, with hash of key already computed by caller.
+ * @param hash Hash of key. Must be exactly what `hash` callback of cache returns for @p key.
+ * */
+void* cache_get_with_hash(Cache* cache, void* key, Size hash, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, NULL, ERR_INVALID_ARGUMENTS);
+
+    Uint32 e = find_entry(cache, key, hash, udata);
+    if(e == CACHE_NONE) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    cache->stats.hits++;
+    touch(cache, e);
+    return SLOT(cache, e) + cache->data_offset;
+}
+
+/**
+ * Search for given key without recording it as used or counting a hit or miss.
+ * @param cache
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return Pointer to data of key, valid until next insert or delete, NULL when absent.
+ * */
+void* cache_peek(Cache* cache, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, NULL, ERR_INVALID_ARGUMENTS);
+
+    Uint32 e = find_entry(cache, key, cache->hash(key, udata), udata);
+    return e == CACHE_NONE ? NULL : SLOT(cache, e) + cache->data_offset;
+}
+
+/**
+ * Remove given key from cache, without calling an eviction callback.
+ * @param cache
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return True if key was present, False otherwise.
+ * */
+Bool cache_delete(Cache* cache, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, False, ERR_INVALID_ARGUMENTS);
+
+    Uint32 e = find_entry(cache, key, cache->hash(key, udata), udata);
+    if(e == CACHE_NONE) {
+        return False;
+    }
+
+    release_entry(cache, e, udata);
+    return True;
+}
+
+/* shard holding given key */
+static FORCE_INLINE ShardedCacheShard* shard_of(ShardedCache* cache, Size hash) {
+    return cache->shards + ((hash_mix64(hash) >> (cache->shard_shift & 63)) & (cache->shard_count - 1));
+}
+
+/**
+ * Create a new sharded cache. Capacity is split evenly between shards.
+ *
+ * @param shard_count Number of shards, rounded up to a power of two.
+ * 0 means @c CONCURRENT_MAP_DEFAULT_SHARD_COUNT.
+ * @param allocator Thread safe allocator to use. NULL means system allocator.
+ * Rest of the parameters are same as @c cache_create.
+ * @return ShardedCache object on success, NULL otherwise.
+ * */
+ShardedCache* sharded_cache_create(
+    HashCallback           hash,
+    Size                   key_size,
+    CompareElementCallback compare_key,
+    Size                   data_size,
+    Size                   max_entries,
+    Size                   max_charge,
+    CachePolicy            policy,
+    Size                   shard_count,
+    Allocator*             allocator
+) {
+    ERR_RETURN_VALUE_IF_FAIL(hash && max_entries, NULL, ERR_INVALID_ARGUMENTS);
+
+    shard_count = shard_count ? NEXT_POW2(shard_count) : CONCURRENT_MAP_DEFAULT_SHARD_COUNT;
+
+    ShardedCache* cache = allocator_allocate_zeroed(allocator, sizeof(ShardedCache));
+    ERR_RETURN_VALUE_IF_FAIL(cache, NULL, ERR_OUT_OF_MEMORY);
+
+    // allocator may not align to cache lines, so over allocate and align by hand
+    cache->shard_memory_size = shard_count * sizeof(ShardedCacheShard) + CONCURRENT_MAP_CACHE_LINE_SIZE;
+    cache->shard_memory      = allocator_allocate_zeroed(allocator, cache->shard_memory_size);
+    if(!cache->shard_memory) {
+        allocator_free(allocator, cache, sizeof(ShardedCache));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    cache->shards      = (ShardedCacheShard*)ALIGN_UP((Size)cache->shard_memory, CONCURRENT_MAP_CACHE_LINE_SIZE);
+    cache->shard_count = shard_count;
+    cache->shard_shift = 64 - (Uint32)__builtin_ctzll(shard_count);
+    cache->hash        = hash;
+    cache->data_size   = data_size;
+    cache->allocator   = allocator;
+
+    Size shard_entries = (max_entries + shard_count - 1) / shard_count;
+    Size shard_charge  = (max_charge + shard_count - 1) / shard_count;
+    for(Size s = 0; s < shard_count; s++) {
+        ShardedCacheShard* shard = cache->shards + s;
+        shard->cache = cache_create(hash, key_size, compare_key, data_size, shard_entries, shard_charge, policy, allocator);
+        if(!shard->cache || pthread_mutex_init(&shard->lock, NULL) != 0) {
+            if(shard->cache) {
+                cache_destroy(shard->cache);
+            }
+            cache->shard_count = s;
+            sharded_cache_destroy(cache);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+            return NULL;
+        }
+    }
+
+    return cache;
+}
+
+/**
+ * Destroy sharded cache. No other thread may be using it.
+ * @param cache
+ * */
+void sharded_cache_destroy(ShardedCache* cache) {
+    ERR_RETURN_IF_FAIL(cache, ERR_INVALID_ARGUMENTS);
+
+    for(Size s = 0; s < cache->shard_count; s++) {
+        cache_destroy(cache->shards[s].cache);
+        pthread_mutex_destroy(&cache->shards[s].lock);
+    }
+
+    allocator_free(cache->allocator, cache->shard_memory, cache->shard_memory_size);
+    allocator_free(cache->allocator, cache, sizeof(ShardedCache));
+}
+
+/**
+ * Insert given key with given data into it's shard, see @c cache_insert.
+ * @p on_evict is called with shard locked.
+ * */
+Bool sharded_cache_insert(ShardedCache* cache, void* key, const void* data, Size charge, CacheEvictCallback on_evict, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, False, ERR_INVALID_ARGUMENTS);
+
+    Size               hash  = cache->hash(key, udata);
+    ShardedCacheShard* shard = shard_of(cache, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    Bool inserted = cache_insert_with_hash(shard->cache, key, data, charge, hash, on_evict, udata);
+    pthread_mutex_unlock(&shard->lock);
+
+    return inserted;
+}
+
+/**
+ * Search for given key and copy it's data out.
+ * @param cache
+ * @param key
+ * @param data Where @c data_size bytes of data are copied when key is found. Can be NULL.
+ * @param udata User data passed to callbacks.
+ * @return True if key was found, False otherwise.
+ * */
+Bool sharded_cache_get(ShardedCache* cache, void* key, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, False, ERR_INVALID_ARGUMENTS);
+
+    Size               hash  = cache->hash(key, udata);
+    ShardedCacheShard* shard = shard_of(cache, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    void* found = cache_get_with_hash(shard->cache, key, hash, udata);
+    if(found && data) {
+        memcpy(data, found, cache->data_size);
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    return found != NULL;
+}
+
+/**
+ * Remove given key from cache.
+ * @param cache
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return True if key was present, False otherwise.
+ * */
+Bool sharded_cache_delete(ShardedCache* cache, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, False, ERR_INVALID_ARGUMENTS);
+
+    ShardedCacheShard* shard = shard_of(cache, cache->hash(key, udata));
+
+    pthread_mutex_lock(&shard->lock);
+    Bool deleted = cache_delete(shard->cache, key, udata);
+    pthread_mutex_unlock(&shard->lock);
+
+    return deleted;
+}
+
+/**
+ * Sum counters of all shards. Each shard is read under it's lock, but shards
+ * are read one after another, so result is not a snapshot of whole cache.
+ * @param cache
+ * @param stats Where sums are stored.
+ * */
+void sharded_cache_stats(ShardedCache* cache, CacheStats* stats) {
+    ERR_RETURN_IF_FAIL(cache && stats, ERR_INVALID_ARGUMENTS);
+
+    *stats = (CacheStats) {0};
+    for(Size s = 0; s < cache->shard_count; s++) {
+        ShardedCacheShard* shard = cache->shards + s;
+        pthread_mutex_lock(&shard->lock);
+        stats->hits       += shard->cache->stats.hits;
+        stats->misses     += shard->cache->stats.misses;
+        stats->insertions += shard->cache->stats.insertions;
+        stats->evictions  += shard->cache->stats.evictions;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+/**
+ * Get number of entries in all shards. Not a snapshot while other threads
+ * are modifying cache.
+ * @param cache
+ * @return Number of entries.
+ * */
+Size sharded_cache_item_count(ShardedCache* cache) {
+    ERR_RETURN_VALUE_IF_FAIL(cache, 0, ERR_INVALID_ARGUMENTS);
+
+    Size count = 0;
+    for(Size s = 0; s < cache->shard_count; s++) {
+        ShardedCacheShard* shard = cache->shards + s;
+        pthread_mutex_lock(&shard->lock);
+        count += shard->cache->item_count;
+        pthread_mutex_unlock(&shard->lock);
+    }
+    return count;
+}
@@ -22,9 +22,16 @@
 
 #include <Anvie/Containers/Common.h>
 #include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
 #include <Anvie/Bit/Bit.h>
+#include <Anvie/Simd/Dispatch.h>
 #include <string.h>
 
+/* defined in Kernels/Memory.c, once for each SIMD level */
+SIMD_KERNEL_DECLARE(Bool, mem_kernel_equal, (const Uint8* a, const Uint8* b, Size length));
+SIMD_KERNEL_DECLARE(Int32, mem_kernel_compare, (const Uint8* a, const Uint8* b, Size length));
+SIMD_KERNEL_DECLARE(Int32, zstr_kernel_compare, (const Char* a, const Char* b));
+
 /**
  * @brief Prints a string value.
  * @param x Pointer to the string to be printed.
@@ -57,6 +64,37 @@ void zstr_destroy_copy(ZString* copy, void* udata){
     if(copy) FREE(*copy);
 }
 
+/**
+ * Copy constructor for strings that allocates the copy from given
+ * allocator. Use as a copy callback and pass an @c Allocator* as udata,
+ * for eg: to keep small string copies in a @c SlabAllocator.
+ *
+ * @param dst Pointer where new created string will be stored
+ * @param src ZString to be copied
+ * @param allocator Allocator to create copy with, NULL for system allocator.
+ * */
+void zstr_create_copy_with_allocator(ZString* dst, ZString src, Allocator* allocator) {
+    if(!dst || !src) return;
+
+    Size size = strlen(src) + 1;
+    Char* copy = allocator_allocate(allocator, size);
+    if(copy) memcpy(copy, src, size);
+    *dst = copy;
+}
+
+/**
+ * Destroy string created with @c zstr_create_copy_with_allocator.
+ *
+ * @param copy Pointer to copy of string to be destroyed.
+ * @param allocator Allocator copy was created with.
+ * */
+void zstr_destroy_copy_with_allocator(ZString* copy, Allocator* allocator) {
+    if(!copy || !*copy) return;
+
+    allocator_free(allocator, (void*)*copy, strlen(*copy) + 1);
+    *copy = NULL;
+}
+
 /**
  * @brief Prints a signed 8-bit integer value.
  * @param x Pointer to the value to be printed.
@@ -145,6 +183,167 @@ void print_u64(void* x, Size idx, void* udata) {
     printf("%lu, ", TO_UINT64(x));
 }
 
+/* seed mixed into every default hash function, see hash_set_default_seed */
+static Uint64 default_hash_seed = 0;
+
+/* wyhash secret constants, odd 64 bit numbers with 32 set bits each */
+#define HASH_P0 0x2d358dccaa6c78a5ull
+#define HASH_P1 0x8bb84b93962eacc9ull
+#define HASH_P2 0x4b33a62ed433d4a3ull
+#define HASH_P3 0x4d5a2da51de1aa47ull
+
+/**
+ * Set seed used by all default hash functions (hash_u8 .. hash_u64,
+ * hash_zstr, str_hash). Changing seed changes every hash value, so this
+ * must be called before inserting into any map that uses the default hashes.
+ * Setting this to a per-process random value makes it hard for anyone
+ * feeding keys into a map to force collisions (HashDoS).
+ * @param seed New seed value.
+ */
+void hash_set_default_seed(Uint64 seed) {
+    default_hash_seed = seed;
+}
+
+/**
+ * Get seed used by default hash functions.
+ * @return Current default seed.
+ */
+Uint64 hash_get_default_seed() {
+    return default_hash_seed;
+}
+
+/**
+ * Multiply-xorshift finalizer (splitmix64). Every input bit affects every
+ * output bit, and it is a bijection, so distinct integers never collide
+ * with each other before being reduced to a table index.
+ * @param val Value to mix.
+ * @return Mixed value.
+ */
+Uint64 hash_mix64(Uint64 val) {
+    val ^= val >> 30;
+    val *= 0xbf58476d1ce4e5b9ull;
+    val ^= val >> 27;
+    val *= 0x94d049bb133111ebull;
+    val ^= val >> 31;
+    return val;
+}
+
+/**
+ * Hash a 64 bit integer with given seed.
+ * @param val The value to be hashed.
+ * @param seed Seed for hash.
+ * @return The hashed value.
+ */
+Uint64 hash_u64_seeded(Uint64 val, Uint64 seed) {
+    return hash_mix64(val + seed + 0x9e3779b97f4a7c15ull);
+}
+
+/* full 64x64 -> 128 bit multiply, low half in *a and high half in *b */
+static FORCE_INLINE void hash_mum(Uint64* a, Uint64* b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)(*a) * (*b);
+    *a = (Uint64)r;
+    *b = (Uint64)(r >> 64);
+#else
+    Uint64 ha = *a >> 32, hb = *b >> 32, la = (Uint32)*a, lb = (Uint32)*b;
+    Uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    Uint64 t = rl + (rm0 << 32), c = t < rl;
+    Uint64 lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/* multiply and fold both halves into one */
+static FORCE_INLINE Uint64 hash_mum_mix(Uint64 a, Uint64 b) {
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+/* unaligned native endian reads, compilers turn these into single loads */
+static FORCE_INLINE Uint64 hash_read8(const Uint8* p) {
+    Uint64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static FORCE_INLINE Uint64 hash_read4(const Uint8* p) {
+    Uint32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* read 1 to 3 bytes, touching only bytes within [p, p + k) */
+static FORCE_INLINE Uint64 hash_read3(const Uint8* p, Size k) {
+    return (((Uint64)p[0]) << 16) | (((Uint64)p[k >> 1]) << 8) | p[k - 1];
+}
+
+/**
+ * Hash an arbitrary byte sequence with given seed.
+ * This is wyhash : input is consumed 48 bytes per iteration in three
+ * independent 64x64 -> 128 bit multiply chains, and short inputs (up to
+ * 16 bytes) are hashed with two overlapping reads and no loop at all.
+ * @param data Bytes to hash. Can be NULL only when @p length is 0.
+ * @param length Number of bytes to hash.
+ * @param seed Seed for hash.
+ * @return The hashed value.
+ */
+Uint64 hash_bytes_seeded(const void* data, Size length, Uint64 seed) {
+    const Uint8* p = (const Uint8*)data;
+    Uint64 a, b;
+
+    seed ^= hash_mum_mix(seed ^ HASH_P0, HASH_P1);
+
+    if(length <= 16) {
+        if(length >= 4) {
+            Size off = (length >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + off);
+            b = (hash_read4(p + length - 4) << 32) | hash_read4(p + length - 4 - off);
+        } else if(length > 0) {
+            a = hash_read3(p, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        Size i = length;
+        if(i > 48) {
+            Uint64 see1 = seed, see2 = seed;
+            do {
+                seed = hash_mum_mix(hash_read8(p) ^ HASH_P1, hash_read8(p + 8) ^ seed);
+                see1 = hash_mum_mix(hash_read8(p + 16) ^ HASH_P2, hash_read8(p + 24) ^ see1);
+                see2 = hash_mum_mix(hash_read8(p + 32) ^ HASH_P3, hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while(i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while(i > 16) {
+            seed = hash_mum_mix(hash_read8(p) ^ HASH_P1, hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = hash_read8(p + i - 16);
+        b = hash_read8(p + i - 8);
+    }
+
+    a ^= HASH_P1;
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mum_mix(a ^ HASH_P0 ^ length, b ^ HASH_P1);
+}
+
+/**
+ * Hash an arbitrary byte sequence with default seed.
+ * @param data Bytes to hash. Can be NULL only when @p length is 0.
+ * @param length Number of bytes to hash.
+ * @return The hashed value.
+ */
+Uint64 hash_bytes(const void* data, Size length) {
+    return hash_bytes_seeded(data, length, default_hash_seed);
+}
+
 /**
  * Hashes an 8-bit unsigned integer value.
  * @param val The value to be hashed.
@@ -153,7 +352,7 @@ void print_u64(void* x, Size idx, void* udata) {
  */
 Uint64 hash_u8(Uint64 val, void* udata) {
     UNUSED(udata);
-    return val & UINT8_MAX;
+    return hash_u64_seeded(val & UINT8_MAX, default_hash_seed);
 }
 
 /**
@@ -164,7 +363,7 @@ Uint64 hash_u8(Uint64 val, void* udata) {
  */
 Uint64 hash_u16(Uint64 val, void* udata) {
     UNUSED(udata);
-    return val & UINT16_MAX;
+    return hash_u64_seeded(val & UINT16_MAX, default_hash_seed);
 }
 
 /**
@@ -175,7 +374,7 @@ Uint64 hash_u16(Uint64 val, void* udata) {
  */
 Uint64 hash_u32(Uint64 val, void* udata) {
     UNUSED(udata);
-    return val & UINT32_MAX;
+    return hash_u64_seeded(val & UINT32_MAX, default_hash_seed);
 }
 
 /**
@@ -186,24 +385,18 @@ Uint64 hash_u32(Uint64 val, void* udata) {
  */
 Uint64 hash_u64(Uint64 val, void* udata) {
     UNUSED(udata);
-    return val & UINT64_MAX;
+    return hash_u64_seeded(val, default_hash_seed);
 }
 
 /**
- * Hashes a string.
- * @param val The string to be hashed.
+ * Hashes a null-terminated string.
+ * @param val The string to be hashed. NULL hashes same as empty string.
  * @param udata User data (unused in this implementation).
  * @return The hashed value.
  */
-Uint64 hash_string(ZString val, void* udata) {
+Uint64 hash_zstr(ZString val, void* udata) {
     UNUSED(udata);
-    Uint64 hash = 0;
-    int i = 0;
-    while (val[i] != '\0') {
-        hash = hash * 31 + val[i];
-        i++;
-    }
-    return hash;
+    return hash_bytes_seeded(val, val ? strlen(val) : 0, default_hash_seed);
 }
 
 /**
@@ -259,3 +452,121 @@ Int32 compare_u64(Uint64 v1, Uint64 v2, void* udata) {
         return -1;
     }
 }
+
+/**
+ * Compares two null terminated strings lexicographically. A NULL string
+ * is ordered before every other string.
+ * @param v1 First string to compare.
+ * @param v2 Second string to compare.
+ * @param udata User data (unused in this implementation).
+ * @return 0 if strings are equal, negative if v1 < v2, positive if v1 > v2.
+ */
+Int32 compare_zstr(ZString v1, ZString v2, void* udata) {
+    UNUSED(udata);
+    if(v1 == v2) {
+        return 0;
+    } else if(!v1) {
+        return -1;
+    } else if(!v2) {
+        return 1;
+    }
+
+    return SIMD_DISPATCH(zstr_kernel_compare)(v1, v2);
+}
+
+/**
+ * Check whether first @p length bytes of two memory regions are equal.
+ * @param a First region.
+ * @param b Second region.
+ * @param length Number of bytes to compare, regions may be NULL if 0.
+ * @return True if equal, False otherwise.
+ */
+Bool mem_equal(const void* a, const void* b, Size length) {
+    if(a == b || !length) {
+        return True;
+    }
+    ERR_RETURN_VALUE_IF_FAIL(a && b, False, ERR_INVALID_ARGUMENTS);
+
+    return SIMD_DISPATCH(mem_kernel_equal)(a, b, length);
+}
+
+/**
+ * Compares first @p length bytes of two memory regions lexicographically,
+ * bytes are compared as unsigned values.
+ * @param a First region.
+ * @param b Second region.
+ * @param length Number of bytes to compare, regions may be NULL if 0.
+ * @return 0 if regions are equal, negative if a < b, positive if a > b.
+ */
+Int32 mem_compare(const void* a, const void* b, Size length) {
+    if(a == b || !length) {
+        return 0;
+    }
+    ERR_RETURN_VALUE_IF_FAIL(a && b, 1, ERR_INVALID_ARGUMENTS);
+
+    return SIMD_DISPATCH(mem_kernel_compare)(a, b, length);
+}
+
+/* count a length in given histogram, longest lengths share last entry */
+static void add_to_histogram(Size* histogram, Size length) {
+    histogram[MIN(length, (Size)HASH_MAP_STATS_HISTOGRAM_SIZE) - 1]++;
+}
+
+/**
+ * Record probe length of one key while filling @c HashMapStats.
+ * @param stats Zero initialized before first call.
+ * @param length Probe length, at least 1.
+ * */
+void hash_map_stats_add_probe(HashMapStats* stats, Size length) {
+    ERR_RETURN_IF_FAIL(stats && length, ERR_INVALID_ARGUMENTS);
+
+    add_to_histogram(stats->probe_histogram, length);
+    stats->max_probe   = MAX(stats->max_probe, length);
+    stats->mean_probe += (Float64)length;
+}
+
+/**
+ * Record length of one non empty chain while filling @c HashMapStats.
+ * @param stats Zero initialized before first call.
+ * @param length Number of items in chain, at least 1.
+ * */
+void hash_map_stats_add_chain(HashMapStats* stats, Size length) {
+    ERR_RETURN_IF_FAIL(stats && length, ERR_INVALID_ARGUMENTS);
+
+    add_to_histogram(stats->chain_histogram, length);
+    stats->max_chain   = MAX(stats->max_chain, length);
+    stats->mean_chain += (Float64)length;
+}
+
+/**
+ * Turn sums recorded by @c hash_map_stats_add_probe and @c hash_map_stats_add_chain
+ * into averages and percentiles. @c item_count must be set, and tag collision
+ * rate must hold total number of tag collisions.
+ * @param stats
+ * */
+void hash_map_stats_finish(HashMapStats* stats) {
+    ERR_RETURN_IF_FAIL(stats, ERR_INVALID_ARGUMENTS);
+
+    Size chains = 0;
+    for(Size i = 0; i < HASH_MAP_STATS_HISTOGRAM_SIZE; i++) {
+        chains += stats->chain_histogram[i];
+    }
+
+    // 99th percentile is first length whose cumulative count reaches 99% of keys
+    Size seen = 0;
+    for(Size i = 0; i < HASH_MAP_STATS_HISTOGRAM_SIZE && stats->item_count; i++) {
+        seen += stats->probe_histogram[i];
+        if(seen * 100 >= stats->item_count * 99) {
+            stats->p99_probe = i + 1 == HASH_MAP_STATS_HISTOGRAM_SIZE ? stats->max_probe : i + 1;
+            break;
+        }
+    }
+
+    if(stats->item_count) {
+        stats->mean_probe         /= (Float64)stats->item_count;
+        stats->tag_collision_rate /= (Float64)stats->item_count;
+    }
+    if(chains) {
+        stats->mean_chain /= (Float64)chains;
+    }
+}
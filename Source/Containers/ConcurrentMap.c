@@ -0,0 +1,249 @@
+/**
+ * @file ConcurrentMap.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Sharded concurrent hash map on top of @c DenseMap.
+ * */
+
+#include <Anvie/Containers/ConcurrentMap.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+#include <string.h>
+
+/* round value up to a multiple of a power of two */
+#define ALIGN_UP(value, align) (((value) + (align) - 1) & ~((Size)(align) - 1))
+
+/* shard holding given key */
+static FORCE_INLINE ConcurrentMapShard* shard_of(ConcurrentMap* map, void* key, void* udata) {
+    Uint64 hash = hash_mix64(map->hash(key, udata));
+    return map->shards + ((hash >> (map->shard_shift & 63)) & (map->shard_count - 1));
+}
+
+/**
+ * Create a new concurrent map.
+ *
+ * @param hash Hash function for keys.
+ * @param key_size Size of key in bytes.
+ * @param create_key_copy Copy constructor for key, can be NULL.
+ * @param destroy_key_copy Copy destructor for key, can be NULL.
+ * @param compare_key Key comparision function.
+ * @param data_size Size of data in bytes.
+ * @param shard_count Number of shards, rounded up to a power of two.
+ * 0 means @c CONCURRENT_MAP_DEFAULT_SHARD_COUNT. A few times the number
+ * of threads using the map at once keeps lock contention low.
+ * @param allocator Thread safe allocator to use. NULL means system allocator.
+ * @return ConcurrentMap object on success, NULL otherwise.
+ * */
+ConcurrentMap* concurrent_map_create(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    Size                       shard_count,
+    Allocator*                 allocator
+) {
+    ERR_RETURN_VALUE_IF_FAIL(hash && compare_key && key_size && data_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    shard_count = shard_count ? NEXT_POW2(shard_count) : CONCURRENT_MAP_DEFAULT_SHARD_COUNT;
+
+    ConcurrentMap* map = allocator_allocate_zeroed(allocator, sizeof(ConcurrentMap));
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_OUT_OF_MEMORY);
+
+    // allocator may not align to cache lines, so over allocate and align by hand
+    map->shard_memory_size = shard_count * sizeof(ConcurrentMapShard) + CONCURRENT_MAP_CACHE_LINE_SIZE;
+    map->shard_memory      = allocator_allocate_zeroed(allocator, map->shard_memory_size);
+    if(!map->shard_memory) {
+        allocator_free(allocator, map, sizeof(ConcurrentMap));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    map->shards      = (ConcurrentMapShard*)ALIGN_UP((Size)map->shard_memory, CONCURRENT_MAP_CACHE_LINE_SIZE);
+    map->shard_count = shard_count;
+    map->shard_shift = 64 - (Uint32)__builtin_ctzll(shard_count);
+    map->hash        = hash;
+    map->data_size   = data_size;
+    map->allocator   = allocator;
+
+    for(Size s = 0; s < shard_count; s++) {
+        ConcurrentMapShard* shard = map->shards + s;
+        shard->map = dense_map_create_inline(hash, key_size, create_key_copy, destroy_key_copy, compare_key,
+                                             data_size, NULL, NULL, 0, 0,
+                                             False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, allocator);
+        if(!shard->map || pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            if(shard->map) {
+                dense_map_destroy(shard->map, NULL);
+            }
+            map->shard_count = s;
+            concurrent_map_destroy(map, NULL);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+            return NULL;
+        }
+    }
+
+    return map;
+}
+
+/**
+ * Destroy concurrent map. No other thread may be using map.
+ * @param map
+ * @param udata User data passed to key copy destructor.
+ * */
+void concurrent_map_destroy(ConcurrentMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    for(Size s = 0; s < map->shard_count; s++) {
+        dense_map_destroy(map->shards[s].map, udata);
+        pthread_rwlock_destroy(&map->shards[s].lock);
+    }
+
+    allocator_free(map->allocator, map->shard_memory, map->shard_memory_size);
+    allocator_free(map->allocator, map, sizeof(ConcurrentMap));
+}
+
+/**
+ * Insert given key with given data, replacing data of key if already present.
+ * @param map
+ * @param key
+ * @param data Pointer to @c data_size bytes of data to be copied into map.
+ * @param udata User data passed to callbacks.
+ * @return True on success, False otherwise.
+ * */
+Bool concurrent_map_insert(ConcurrentMap* map, void* key, const void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && data, False, ERR_INVALID_ARGUMENTS);
+
+    ConcurrentMapShard* shard = shard_of(map, key, udata);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    DenseMapItem* item = dense_map_insert(shard->map, key, dense_map_pack(data, map->data_size), udata);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return item != NULL;
+}
+
+/**
+ * Search for given key and copy it's data out.
+ * @param map
+ * @param key
+ * @param data Buffer of @c data_size bytes where data of key will be copied.
+ * Can be NULL to only check whether key is present.
+ * @param udata User data passed to callbacks.
+ * @return True if key was found, False otherwise.
+ * */
+Bool concurrent_map_search(ConcurrentMap* map, void* key, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    ConcurrentMapShard* shard = shard_of(map, key, udata);
+
+    pthread_rwlock_rdlock(&shard->lock);
+    DenseMapItem* item = dense_map_search(shard->map, key, udata);
+    if(item && data) {
+        memcpy(data, dense_map_slot_data(shard->map, item), map->data_size);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return item != NULL;
+}
+
+/**
+ * Delete given key from map.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return True if key was present, False otherwise.
+ * */
+Bool concurrent_map_delete(ConcurrentMap* map, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    ConcurrentMapShard* shard = shard_of(map, key, udata);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    Size count = shard->map->item_count;
+    dense_map_delete(shard->map, key, udata);
+    Bool deleted = shard->map->item_count != count;
+    pthread_rwlock_unlock(&shard->lock);
+
+    return deleted;
+}
+
+/**
+ * Get data of given key, inserting data computed by @p compute first if key
+ * is absent. @p compute is called at most once per absent key even when many
+ * threads race to insert same key.
+ *
+ * Key is searched under a read lock first, so when it's present, this is as
+ * cheap as @c concurrent_map_search. Otherwise @p compute runs with shard write
+ * locked, so it should be quick and must not use this map.
+ *
+ * @param map
+ * @param key
+ * @param compute Writes data for an absent key.
+ * @param data Buffer of @c data_size bytes where data of key will be copied,
+ * whether it was present or just computed. Cannot be NULL.
+ * @param udata User data passed to callbacks and to @p compute.
+ * @return True if data was computed and inserted, False if key was already
+ * present or on failure.
+ * */
+Bool concurrent_map_compute_if_absent(ConcurrentMap* map, void* key, ConcurrentMapComputeCallback compute, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && compute && data, False, ERR_INVALID_ARGUMENTS);
+
+    if(concurrent_map_search(map, key, data, udata)) {
+        return False;
+    }
+
+    ConcurrentMapShard* shard = shard_of(map, key, udata);
+    Bool                computed = False;
+
+    pthread_rwlock_wrlock(&shard->lock);
+
+    // another thread may have inserted key between the two locks
+    DenseMapItem* item = dense_map_search(shard->map, key, udata);
+    if(!item) {
+        compute(key, data, udata);
+        item     = dense_map_insert(shard->map, key, dense_map_pack(data, map->data_size), udata);
+        computed = item != NULL;
+    } else {
+        memcpy(data, dense_map_slot_data(shard->map, item), map->data_size);
+    }
+
+    pthread_rwlock_unlock(&shard->lock);
+
+    return computed;
+}
+
+/**
+ * Get number of items in map. Shards are counted one after another, so
+ * with concurrent modifications, result is only a snapshot of each shard.
+ * @param map
+ * @return Number of items.
+ * */
+Size concurrent_map_item_count(ConcurrentMap* map) {
+    ERR_RETURN_VALUE_IF_FAIL(map, 0, ERR_INVALID_ARGUMENTS);
+
+    Size count = 0;
+    for(Size s = 0; s < map->shard_count; s++) {
+        pthread_rwlock_rdlock(&map->shards[s].lock);
+        count += map->shards[s].map->item_count;
+        pthread_rwlock_unlock(&map->shards[s].lock);
+    }
+
+    return count;
+}
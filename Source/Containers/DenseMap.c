@@ -24,13 +24,48 @@
 #include <Anvie/Containers/DenseMap.h>
 #include <Anvie/HelperDefines.h>
 #include <Anvie/Error.h>
+#include <Anvie/Counters.h>
 #include <Anvie/Bit/Bit.h>
+#include <Anvie/Simd/Simd.h>
 #include <string.h>
 
 #define MDATA_OCCUPANCY_MASK (1 << 7)
 #define MDATA_HASH_MASK (0x7f)
+#define MDATA_EMPTY (0x00)
+#define MDATA_DELETED (0x7f)
 #define DENSE_MAP_INITIAL_SIZE 64
 
+/* number of keys hashed and prefetched together by batch operations */
+#define DENSE_MAP_BATCH_SIZE 32
+
+/* load factor is never allowed to reach 1, so that every probe sequence ends */
+#define DENSE_MAP_MAX_LOAD_FACTOR 0.9375f
+
+/**
+ * Metadata of a whole group of slots is compared at once. A group is as
+ * wide as a SIMD register, where comparision gives one bit per slot, or a
+ * 64 bit word otherwise, where it gives highest bit of each matching byte.
+ * */
+#if SIMD_ENABLED
+#   define GROUP_SIZE SIMD_VECTOR_REGISTER_SIZE
+#   define GROUP_SLOT_SHIFT 0
+#else
+#   define GROUP_SIZE 8
+#   define GROUP_SLOT_SHIFT 3
+#endif // SIMD_ENABLED
+
+/* one bit (or byte) per slot of a group, set for slots matching some condition */
+typedef Uint64 GroupMask;
+
+/* slot of first set bit of a non-zero group mask */
+#define GROUP_SLOT(mask) ((Size)__builtin_ctzll(mask) >> GROUP_SLOT_SHIFT)
+
+#define METADATA(map) ((map)->metadata->data)
+#define HASHES(map) ((map)->hashes)
+#define SLOT_ITEM(map, slot) ((DenseMapItem*)(map)->map->data + (slot))
+#define SLOT_ADDR(map, slot) ((Uint8*)(map)->map->data + (slot) * (map)->map->element_size)
+#define IS_INLINE(map) ((map)->slot_size != 0)
+
 /**
  * Callback data to be passed to copy constructor and copy destructor of
  * @c DenseMapItem.
@@ -39,7 +74,81 @@ struct Dmi_CallbackData {
     void*     udata;            /**< User data passed to callbacks. */
     DenseMap* map;              /**< @c DenseMap to which @c DenseMapItem will be inserted*/
 };
-static inline DenseMapItem* insert_into_dense_map_directly(DenseMap* map, DenseMapItem* dmi, void* udata);
+
+static Size find_slot(DenseMap* map, void* key, Uint64 hash, void* udata);
+static DenseMapItem* insert_hashed(DenseMap* map, void* key, void* value, Size user_hash, void* udata);
+static Size find_free_slot(Uint8* mdata, Size length, Uint64 hash);
+static Size next_occupied_slot(const Uint8* mdata, Size length, Size from);
+static void rehash_dense_map(DenseMap* map, Size size, void* udata);
+static void begin_rehash(DenseMap* map, Size size, void* udata);
+static Size size_for_count(DenseMap* map, Size count, Float32 fraction);
+static void migrate_slots(DenseMap* map, Size budget, void* udata);
+static void swap_tables(DenseMap* map);
+static void destroy_old_table(DenseMap* map);
+static void visit_table(DenseMap* map, DenseMapVisitorCallback visitor, Bool destroy, void* udata);
+static Size table_stats(const Uint8* mdata, const DenseMapHash* hashes, Size length, HashMapStats* stats);
+static DenseMapItem* lookup(DenseMap* map, void* key, Uint64 hash, void* udata);
+static DenseMapItem* replace_existing(DenseMap* map, void* key, void* value, Uint64 hash, void* udata);
+static void delete_in_table(DenseMap* map, void* key, Uint64 hash, void* udata);
+static void destroy_dmi_vector_shallow(Dmi_Vector* vec);
+static Dmi_Vector* create_slot_vector(DenseMap* map, Size size);
+static DenseMapHash* create_hash_array(DenseMap* map, Size size);
+static void destroy_hash_array(DenseMap* map, DenseMapHash* hashes, Size size);
+static void* key_at(DenseMap* map, Uint8* addr);
+static void* slot_key(DenseMap* map, Size slot);
+static void* slot_data(DenseMap* map, Size slot);
+static void create_slot_copy(DenseMap* map, Size slot, void* key, void* data, void* udata);
+static void destroy_slot_copy(DenseMap* map, Size slot, void* udata);
+
+/* finalizer of splitmix64, so that group and hash bits stay uniform for weak hashes.
+ * Result is truncated to stored hash width, so that probing never depends on bits not stored. */
+static FORCE_INLINE Uint64 mix_hash(Uint64 x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return (DenseMapHash)x;
+}
+
+/* metadata stored for an occupied slot with given mixed hash */
+#define MDATA_OF(hash) ((Uint8)(MDATA_OCCUPANCY_MASK | ((hash) & MDATA_HASH_MASK)))
+
+/* mask of slots in group whose metadata is exactly given byte */
+static FORCE_INLINE GroupMask group_match(const Uint8* group, Uint8 mdata) {
+#if SIMD_ENABLED
+    return (GroupMask)simd_cmpeq_epi8_mask(simd_loadu(group), simd_set1_epi8((Int8)mdata));
+#else
+    /* a byte of x is zero only where metadata matches, exact test for zero bytes */
+    Uint64 word;
+    memcpy(&word, group, sizeof(word));
+    Uint64 x = word ^ (0x0101010101010101ull * mdata);
+    Uint64 y = (x & 0x7f7f7f7f7f7f7f7full) + 0x7f7f7f7f7f7f7f7full;
+    return ~(y | x | 0x7f7f7f7f7f7f7f7full);
+#endif // SIMD_ENABLED
+}
+
+/* mask of slots in group which are occupied, highest bit of metadata is set */
+static FORCE_INLINE GroupMask group_match_occupied(const Uint8* group) {
+#if SIMD_ENABLED
+    return (GroupMask)(MMask)simd_movemask_epi8(simd_loadu(group));
+#else
+    Uint64 word;
+    memcpy(&word, group, sizeof(word));
+    return word & 0x8080808080808080ull;
+#endif // SIMD_ENABLED
+}
+
+/* mask of slots in group which are empty or deleted */
+static FORCE_INLINE GroupMask group_match_free(const Uint8* group) {
+#if SIMD_ENABLED
+    return (GroupMask)(MMask)~simd_movemask_epi8(simd_loadu(group));
+#else
+    Uint64 word;
+    memcpy(&word, group, sizeof(word));
+    return ~word & 0x8080808080808080ull;
+#endif // SIMD_ENABLED
+}
 
 /**
  * Create a new hash map.
@@ -61,6 +170,32 @@ DenseMap* dense_map_create(
     DestroyElementCopyCallback destroy_data_copy,
     Bool                       is_multimap,
     Float32                    max_load_factor
+) {
+    return dense_map_create_with_allocator(hash, key_size, create_key_copy, destroy_key_copy, compare_key,
+                                           data_size, create_data_copy, destroy_data_copy,
+                                           is_multimap, max_load_factor, NULL);
+}
+
+/**
+ * Create a new hash map that allocates it's slot vectors and
+ * key/data copies from given allocator.
+ * Rest of the parameters are same as @c dense_map_create.
+ *
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return DenseMap object on success, NULL otherwise.
+ * */
+DenseMap* dense_map_create_with_allocator(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy,
+    Bool                       is_multimap,
+    Float32                    max_load_factor,
+    Allocator*                 allocator
 ) {
     ERR_RETURN_VALUE_IF_FAIL(hash && data_size && key_size, NULL, ERR_INVALID_ARGUMENTS);
 
@@ -75,39 +210,39 @@ DenseMap* dense_map_create(
     ERR_RETURN_VALUE_IF_FAIL(!(b1 ^ b2), NULL, ERR_INVALID_ARGUMENTS);
 
     // create vector to store DenseMapItem entries for the DenseMap.
-    Dmi_Vector* dmi_vec = dmi_vector_create();
+    Dmi_Vector* dmi_vec = dmi_vector_create_with_allocator(allocator);
     ERR_RETURN_VALUE_IF_FAIL(dmi_vec, NULL, ERR_INVALID_OBJECT);
     dmi_vector_resize(dmi_vec, DENSE_MAP_INITIAL_SIZE);
 
     // create vector to store metadata about each entry in the DenseMap.
-    U8_Vector* mdata_vec = u8_vector_create();
+    U8_Vector* mdata_vec = u8_vector_create_with_allocator(allocator);
     if(!mdata_vec) {
-        dmi_vector_destroy(dmi_vec, NULL);
+        destroy_dmi_vector_shallow(dmi_vec);
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
         return NULL;
     }
     u8_vector_resize(mdata_vec, DENSE_MAP_INITIAL_SIZE);
 
-    U8_Vector* pl_vec = u8_vector_create();
-    if(!pl_vec) {
-        dmi_vector_destroy(dmi_vec, NULL);
+    // finally create dense map
+    DenseMap* map = allocator_allocate_zeroed(allocator, sizeof(DenseMap));
+    if(!map) {
+        destroy_dmi_vector_shallow(dmi_vec);
         u8_vector_destroy(mdata_vec, NULL);
-        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
         return NULL;
     }
-    u8_vector_resize(pl_vec, DENSE_MAP_INITIAL_SIZE);
 
-    // finally create dense map
-    DenseMap* map = NEW(DenseMap);
-    if(!map) {
-        dmi_vector_destroy(dmi_vec, NULL);
+    // stored hash of each slot
+    map->allocator = allocator;
+    map->hashes    = create_hash_array(map, DENSE_MAP_INITIAL_SIZE);
+    if(!map->hashes) {
+        destroy_dmi_vector_shallow(dmi_vec);
         u8_vector_destroy(mdata_vec, NULL);
-        u8_vector_destroy(pl_vec, NULL);
+        allocator_free(allocator, map, sizeof(DenseMap));
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
         return NULL;
     }
 
-    map->probe_len         = pl_vec;
     map->metadata          = mdata_vec;
     map->map               = dmi_vec;
     map->hash              = hash;
@@ -121,6 +256,78 @@ DenseMap* dense_map_create(
     map->is_multimap       = is_multimap;
     map->max_load_factor   = max_load_factor;
     map->item_count = 0;
+    map->allocator  = allocator;
+
+    return map;
+}
+
+/**
+ * Create a new hash map that stores key and data bytes inline in slots,
+ * instead of in separately allocated copies pointed to by a @c DenseMapItem.
+ * Slots are laid out like a struct `{ ktype key; dtype data; }`, with key
+ * at offset 0 and data at @p data_offset. A search then touches metadata
+ * and one slot, and inserting types without copy callbacks never allocates.
+ *
+ * Keys and data are passed to and from callbacks exactly as in a
+ * @c DenseMap created by @c dense_map_create : by value when size is at
+ * most 8 and no copy callback is given, by pointer otherwise. Here the
+ * pointer points into the slot. Copy constructors get slot memory as
+ * destination, and copy destructors must not free it.
+ *
+ * Insert and search return address of slot cast to @c DenseMapItem*.
+ * Don't use it as one, address key and data through @c dense_map_slot_key
+ * and @c dense_map_slot_data or through a @c DEF_INLINE_DENSE_MAP_INTERFACE
+ * item type instead. Slot addresses change whenever map is rehashed.
+ *
+ * Rest of the parameters are same as @c dense_map_create_with_allocator.
+ *
+ * @param data_offset Offset of data in slot, at least @p key_size.
+ * @param slot_size Size of a slot, at least @p data_offset + @p data_size.
+ * Passing 0 for both lays slot out with natural alignment of key and data sizes.
+ * @return DenseMap object on success, NULL otherwise.
+ * */
+DenseMap* dense_map_create_inline(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy,
+    Size                       data_offset,
+    Size                       slot_size,
+    Bool                       is_multimap,
+    Float32                    max_load_factor,
+    Allocator*                 allocator
+) {
+    if(!data_offset && !slot_size) {
+        // natural alignment of a value is largest power of two dividing it's size, at most 16
+        Size key_align  = MIN(key_size & (~key_size + 1), (Size)16);
+        Size data_align = MIN(data_size & (~data_size + 1), (Size)16);
+        Size slot_align = MAX(key_align, data_align);
+        data_offset     = (key_size + data_align - 1) & ~(data_align - 1);
+        slot_size       = (data_offset + data_size + slot_align - 1) & ~(slot_align - 1);
+    }
+    ERR_RETURN_VALUE_IF_FAIL(data_offset >= key_size && slot_size >= data_offset + data_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    DenseMap* map = dense_map_create_with_allocator(hash, key_size, create_key_copy, destroy_key_copy, compare_key,
+                                                    data_size, create_data_copy, destroy_data_copy,
+                                                    is_multimap, max_load_factor, allocator);
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_OBJECT);
+
+    /* replace empty vector of DenseMapItem with one of inline slots */
+    map->slot_size   = slot_size;
+    map->data_offset = data_offset;
+    Dmi_Vector* slots = create_slot_vector(map, DENSE_MAP_INITIAL_SIZE);
+    if(!slots) {
+        map->slot_size = 0;
+        dense_map_destroy(map, NULL);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+    destroy_dmi_vector_shallow(map->map);
+    map->map = slots;
 
     return map;
 }
@@ -135,26 +342,416 @@ DenseMap* dense_map_create(
 void dense_map_destroy(DenseMap* map, void* udata) {
     ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
 
+    // all memory will be released by allocator at once
+    if(!allocator_needs_free(map->allocator)) {
+        return;
+    }
+
     if(map->map) {
-        Dmi_CallbackData clbk_data = {
-            .udata = udata,
-            .map   = map
-        };
-        dmi_vector_destroy(map->map, &clbk_data);
+        // only occupied slots hold copies
+        for(Size s = next_occupied_slot(METADATA(map), map->map->length, 0); s != SIZE_MAX;
+            s = next_occupied_slot(METADATA(map), map->map->length, s + 1)) {
+            destroy_slot_copy(map, s, udata);
+        }
+
+        destroy_hash_array(map, map->hashes, map->map->length);
+        map->hashes = NULL;
+        destroy_dmi_vector_shallow(map->map);
         map->map = NULL;
     }
 
+    // items not yet migrated by an incremental rehash
+    if(map->old_map) {
+        swap_tables(map);
+        for(Size s = next_occupied_slot(METADATA(map), map->map->length, 0); s != SIZE_MAX;
+            s = next_occupied_slot(METADATA(map), map->map->length, s + 1)) {
+            destroy_slot_copy(map, s, udata);
+        }
+        swap_tables(map);
+        destroy_old_table(map);
+    }
+
     if(map->metadata) {
         u8_vector_destroy(map->metadata, NULL);
         map->metadata = NULL;
     }
 
-    if(map->probe_len) {
-        u8_vector_destroy(map->probe_len, NULL);
-        map->probe_len = NULL;
+    dense_map_disable_filter(map);
+
+    allocator_free(map->allocator, map, sizeof(DenseMap));
+}
+
+/**
+ * Create a copy of given map, with same configuration and same items in
+ * same slots. Bloom filter of map, if any, is not copied.
+ * Only maps without key and data copy callbacks can be cloned, because a
+ * copy constructor can't tell a user provided value from a stored copy.
+ * @param map
+ * @param udata User data passed to `hash` callback.
+ * @return New map on success, NULL otherwise.
+ * */
+DenseMap* dense_map_clone(DenseMap* map, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!map->create_key_copy && !map->create_data_copy, NULL, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, udata);
+    }
+
+    DenseMap* clone = NULL;
+    if(IS_INLINE(map)) {
+        clone = dense_map_create_inline(map->hash, map->key_size, NULL, NULL, map->compare_key,
+                                        map->data_size, NULL, NULL, map->data_offset, map->slot_size,
+                                        map->is_multimap, map->max_load_factor, map->allocator);
+    } else {
+        clone = dense_map_create_with_allocator(map->hash, map->key_size, NULL, NULL, map->compare_key,
+                                                map->data_size, NULL, NULL,
+                                                map->is_multimap, map->max_load_factor, map->allocator);
+    }
+    ERR_RETURN_VALUE_IF_FAIL(clone, NULL, ERR_INVALID_OBJECT);
+
+    Size length = map->map->length;
+    if(clone->map->length != length) {
+        rehash_dense_map(clone, length, udata);
+        if(clone->map->length != length) {
+            dense_map_destroy(clone, udata);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+            return NULL;
+        }
+    }
+
+    // same metadata means every item goes to same slot, and tombstones stay too
+    memcpy(METADATA(clone), METADATA(map), length);
+    memcpy(HASHES(clone), HASHES(map), length * sizeof(DenseMapHash));
+    for(Size s = next_occupied_slot(METADATA(map), length, 0); s != SIZE_MAX;
+        s = next_occupied_slot(METADATA(map), length, s + 1)) {
+        create_slot_copy(clone, s, slot_key(map, s), slot_data(map, s), udata);
+    }
+    clone->item_count      = map->item_count;
+    clone->tombstone_count = map->tombstone_count;
+    clone->rehash_budget   = map->rehash_budget;
+    clone->min_load_factor = map->min_load_factor;
+
+    return clone;
+}
+
+/* key and data copies of items, or strings they are, are packed in blob of image at this alignment */
+#define IMAGE_BLOB_ALIGN(n) (((n) + 15) & ~(Size)15)
+
+/* key or data of a non inline slot lives in a copy or string pointed to by item, instead of in item itself */
+#define KEY_IS_INDIRECT(map, flags) ((map)->key_size > 8 || ((flags) & DENSE_MAP_IMAGE_ZSTR_KEYS))
+#define DATA_IS_INDIRECT(map, flags) ((map)->data_size > 8 || ((flags) & DENSE_MAP_IMAGE_ZSTR_DATA))
+
+/**
+ * Bytes a key or data copy takes in blob of image. A @c ZString copy is
+ * the string itself, stored in item like other copies of at most 8 bytes.
+ * */
+static Size image_copy_size(const void* copy, Size size, Bool is_zstr) {
+    if(!copy) {
+        return 0;
+    }
+    return IMAGE_BLOB_ALIGN(is_zstr ? strlen(copy) + 1 : size);
+}
+
+/* write given bytes followed by zeroes up to blob alignment */
+static void image_put_padded(ImageWriter* writer, const void* data, Size size) {
+    static const Uint8 zeroes[16] = {0};
+    image_writer_put(writer, data, size);
+    image_writer_put(writer, zeroes, IMAGE_BLOB_ALIGN(size) - size);
+}
+
+/**
+ * Write a key or data copy into blob.
+ * @param offset Blob offset where copy is written, advanced past it.
+ * */
+static void image_put_copy(ImageWriter* writer, const void* copy, Size size, Bool is_zstr, Size* offset) {
+    if(!copy) {
+        return;
+    }
+
+    image_put_padded(writer, copy, is_zstr ? strlen(copy) + 1 : size);
+    *offset += image_copy_size(copy, size, is_zstr);
+}
+
+/* header, metadata, hashes, slots and blob of copies, and trailer */
+static Size dense_map_write_image(DenseMap* map, Uint32 flags, ImageWriter* writer) {
+    Size   length       = map->map->length;
+    Size   element_size = map->map->element_size;
+    Uint8* mdata        = METADATA(map);
+    Bool   zstr_keys    = (flags & DENSE_MAP_IMAGE_ZSTR_KEYS) != 0;
+    Bool   zstr_data    = (flags & DENSE_MAP_IMAGE_ZSTR_DATA) != 0;
+
+    Size blob_size = 0;
+    if(!IS_INLINE(map)) {
+        for(Size s = next_occupied_slot(mdata, length, 0); s != SIZE_MAX; s = next_occupied_slot(mdata, length, s + 1)) {
+            DenseMapItem* item = SLOT_ITEM(map, s);
+            if(KEY_IS_INDIRECT(map, flags)) blob_size += image_copy_size(item->key, map->key_size, zstr_keys);
+            if(DATA_IS_INDIRECT(map, flags)) blob_size += image_copy_size(item->data, map->data_size, zstr_data);
+        }
+    }
+
+    Uint64 load_factors = 0;
+    memcpy(&load_factors, &map->max_load_factor, sizeof(Float32));
+    memcpy((Uint8*)&load_factors + sizeof(Float32), &map->min_load_factor, sizeof(Float32));
+
+    Uint64 params[] = {
+        map->key_size, map->data_size, map->slot_size, map->data_offset, length, map->item_count,
+        map->tombstone_count, map->is_multimap, load_factors, DENSE_MAP_HASH_BITS, GROUP_SIZE, blob_size
+    };
+    Size image_size = image_section_size(sizeof(ImageHeader)) + image_section_size(length) +
+                      image_section_size(length * sizeof(DenseMapHash)) + image_section_size(length * element_size) +
+                      image_section_size(blob_size) + sizeof(ImageTrailer);
+
+    image_writer_begin(writer, IMAGE_KIND_DENSE_MAP, flags, params, ARRAY_SIZE(params), image_size);
+    image_writer_put(writer, mdata, length);
+    image_writer_align(writer);
+    image_writer_put(writer, HASHES(map), length * sizeof(DenseMapHash));
+    image_writer_align(writer);
+
+    if(IS_INLINE(map)) {
+        image_writer_put(writer, map->map->data, length * element_size);
+        image_writer_align(writer);
+        return image_writer_finish(writer);
+    }
+
+    /* copies are replaced by their blob offset + 1, and free slots are zeroed */
+    Size blob_offset = 0;
+    for(Size s = 0; s < length; s++) {
+        DenseMapItem item = {0};
+        if(mdata[s] & MDATA_OCCUPANCY_MASK) {
+            item = *SLOT_ITEM(map, s);
+            if(KEY_IS_INDIRECT(map, flags) && item.key) {
+                void* copy = item.key;
+                item.key   = (void*)(Uint64)(blob_offset + 1);
+                blob_offset += image_copy_size(copy, map->key_size, zstr_keys);
+            }
+            if(DATA_IS_INDIRECT(map, flags) && item.data) {
+                void* copy = item.data;
+                item.data  = (void*)(Uint64)(blob_offset + 1);
+                blob_offset += image_copy_size(copy, map->data_size, zstr_data);
+            }
+        }
+        image_writer_put(writer, &item, sizeof(item));
+    }
+    image_writer_align(writer);
+
+    blob_offset = 0;
+    for(Size s = next_occupied_slot(mdata, length, 0); s != SIZE_MAX; s = next_occupied_slot(mdata, length, s + 1)) {
+        DenseMapItem* item = SLOT_ITEM(map, s);
+        if(KEY_IS_INDIRECT(map, flags)) image_put_copy(writer, item->key, map->key_size, zstr_keys, &blob_offset);
+        if(DATA_IS_INDIRECT(map, flags)) image_put_copy(writer, item->data, map->data_size, zstr_data, &blob_offset);
+    }
+    image_writer_align(writer);
+
+    return image_writer_finish(writer);
+}
+
+/**
+ * Check whether given map can be written to an image with given flags.
+ * Items must be plain bytes, except for copies of strings marked by flags.
+ * */
+static Bool dense_map_can_write_image(DenseMap* map, Uint32 flags) {
+    if(IS_INLINE(map)) {
+        return !map->create_key_copy && !map->create_data_copy && !flags;
+    }
+
+    Bool zstr_keys = (flags & DENSE_MAP_IMAGE_ZSTR_KEYS) != 0;
+    Bool zstr_data = (flags & DENSE_MAP_IMAGE_ZSTR_DATA) != 0;
+    if(zstr_keys ? map->key_size != sizeof(ZString) || !map->create_key_copy : map->create_key_copy != NULL) {
+        return False;
+    }
+    if(zstr_data ? map->data_size != sizeof(ZString) || !map->create_data_copy : map->create_data_copy != NULL) {
+        return False;
+    }
+    return True;
+}
+
+/**
+ * Write an image of given map into @p buffer, see Anvie/Containers/Image.h.
+ * Items are written as plain bytes, so copy callbacks are allowed only for
+ * keys or data that are @c ZString copies, like those made by
+ * @c zstr_create_copy, and only when marked by @p flags. Inline maps can't
+ * have copy callbacks at all. An incremental rehash in progress is finished
+ * first, and bloom filter is not written.
+ *
+ * @param flags @c DENSE_MAP_IMAGE_ZSTR_KEYS and/or @c DENSE_MAP_IMAGE_ZSTR_DATA.
+ * @param buffer Destination, can be NULL to only compute size of image.
+ * @param capacity Size of @p buffer.
+ * @return Size of image. Image is complete only if this is at most @p capacity.
+ * @return 0 if map can't be written.
+ * */
+Size dense_map_write_to_buffer(DenseMap* map, Uint32 flags, void* buffer, Size capacity) {
+    ERR_RETURN_VALUE_IF_FAIL(map && dense_map_can_write_image(map, flags), 0, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, NULL);
+    }
+
+    ImageWriter writer;
+    image_writer_init_buffer(&writer, buffer, capacity);
+    return dense_map_write_image(map, flags, &writer);
+}
+
+/**
+ * Write an image of given map to a file, at it's current offset.
+ * Same restrictions as @c dense_map_write_to_buffer apply.
+ *
+ * @param flags @c DENSE_MAP_IMAGE_ZSTR_KEYS and/or @c DENSE_MAP_IMAGE_ZSTR_DATA.
+ * @return True if whole image was written.
+ * */
+Bool dense_map_serialize_to_fd(DenseMap* map, Uint32 flags, int fd) {
+    ERR_RETURN_VALUE_IF_FAIL(map && dense_map_can_write_image(map, flags), False, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, NULL);
+    }
+
+    ImageWriter writer;
+    if(!image_writer_init_fd(&writer, fd)) {
+        return False;
+    }
+    return dense_map_write_image(map, flags, &writer) != 0;
+}
+
+/**
+ * Check that a copy stored as blob offset + 1 in an item is inside blob,
+ * up to it's terminating zero when it's a @c ZString.
+ * */
+static Bool image_copy_is_valid(Uint64 offset, const Uint8* blob, Size blob_size, Size size, Bool is_zstr) {
+    if(!offset--) {
+        return True;
+    }
+    if(offset >= blob_size) {
+        return False;
+    }
+    return is_zstr ? memchr(blob + offset, 0, blob_size - offset) != NULL : size <= blob_size - offset;
+}
+
+/* turn blob offset + 1 of a valid copy back into it's address */
+static void image_relocate_copy(void** field, Uint8* blob) {
+    Uint64 offset = (Uint64)*field;
+    if(offset) {
+        *field = blob + offset - 1;
+    }
+}
+
+/* vector struct over slots, metadata or hashes that live in image */
+static Vector* image_wrap_vector(Allocator* allocator, void* data, Size element_size, Size length) {
+    Vector* vec = allocator_allocate_zeroed(allocator, sizeof(Vector));
+    if(vec) {
+        vec->element_size  = element_size;
+        vec->length        = length;
+        vec->capacity      = length;
+        vec->data          = data;
+        vec->resize_factor = 1; /* default of Vector, 2x growth */
+        vec->allocator     = allocator;
+    }
+    return vec;
+}
+
+/**
+ * Load map held by given image. Slots are not copied or rehashed, they're
+ * used right where they are in image, only pointers to key and data copies
+ * of non inline maps are relocated. Map is owned by image and loading it
+ * again returns same map.
+ *
+ * Functions can't be stored in an image, so they're given here, and must
+ * be same as those map was created with, and hash must be seeded the same.
+ * Loaded map has no copy callbacks. It can be modified, but if it was
+ * written with a @c DENSE_MAP_IMAGE_ZSTR_KEYS or @c DENSE_MAP_IMAGE_ZSTR_DATA
+ * flag, then it must only be searched and iterated, because strings of new
+ * items would not be copied like those of loaded ones.
+ *
+ * @param hash Hash function of map.
+ * @param compare_key Key comparision function of map.
+ * @return DenseMap* on success.
+ * @return NULL if image does not hold a valid map.
+ * */
+DenseMap* dense_map_from_image(Image* image, HashCallback hash, CompareElementCallback compare_key) {
+    ERR_RETURN_VALUE_IF_FAIL(image && hash && compare_key, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(image_get_kind(image) == IMAGE_KIND_DENSE_MAP, NULL, ERR_INVALID_CONTENTS);
+
+    DenseMap* map = image_get_container(image);
+    if(map) {
+        return map;
+    }
+
+    const ImageHeader* header = image_get_header(image);
+    const Uint64*      params = header->params;
+    Size key_size = params[0], data_size = params[1], slot_size = params[2], data_offset = params[3];
+    Size length = params[4], item_count = params[5], tombstone_count = params[6], blob_size = params[11];
+    Size element_size = slot_size ? slot_size : sizeof(DenseMapItem);
+
+    RETURN_VALUE_IF_FAIL(params[9] == DENSE_MAP_HASH_BITS && params[10] == GROUP_SIZE, NULL,
+                         "dense map image was written with different hash bits or group size\n");
+    RETURN_VALUE_IF_FAIL(key_size && data_size && length >= GROUP_SIZE && !(length & (length - 1)) &&
+                         length <= SIZE_MAX / MAX(element_size, sizeof(DenseMapHash)) &&
+                         item_count <= length && tombstone_count <= length - item_count,
+                         NULL, "invalid dense map image\n");
+    RETURN_VALUE_IF_FAIL(!slot_size ? !data_offset : !header->flags && data_offset >= key_size &&
+                         data_offset <= slot_size && data_size <= slot_size - data_offset,
+                         NULL, "invalid dense map image\n");
+
+    Bool zstr_keys = (header->flags & DENSE_MAP_IMAGE_ZSTR_KEYS) != 0;
+    Bool zstr_data = (header->flags & DENSE_MAP_IMAGE_ZSTR_DATA) != 0;
+    RETURN_VALUE_IF_FAIL((!zstr_keys || key_size == sizeof(ZString)) && (!zstr_data || data_size == sizeof(ZString)),
+                         NULL, "invalid dense map image\n");
+
+    Size   cursor = 0;
+    Uint8* mdata  = image_take_section(image, &cursor, length);
+    void*  hashes = image_take_section(image, &cursor, length * sizeof(DenseMapHash));
+    Uint8* slots  = image_take_section(image, &cursor, length * element_size);
+    Uint8* blob   = image_take_section(image, &cursor, blob_size);
+    RETURN_VALUE_IF_FAIL(mdata && hashes && slots && blob, NULL, "invalid dense map image\n");
+
+    map = allocator_allocate_zeroed(image_get_allocator(image), sizeof(DenseMap));
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_OUT_OF_MEMORY);
+    map->key_size    = key_size;
+    map->data_size   = data_size;
+    map->slot_size   = slot_size;
+    map->data_offset = data_offset;
+
+    /* everything is checked before anything is relocated, so a rejected image stays as it is */
+    Bool key_indirect  = !slot_size && KEY_IS_INDIRECT(map, header->flags);
+    Bool data_indirect = !slot_size && DATA_IS_INDIRECT(map, header->flags);
+    Size occupied      = 0;
+    for(Size s = next_occupied_slot(mdata, length, 0); s != SIZE_MAX; s = next_occupied_slot(mdata, length, s + 1)) {
+        DenseMapItem* item = (DenseMapItem*)slots + s;
+        occupied++;
+        RETURN_VALUE_IF_FAIL((!key_indirect || image_copy_is_valid((Uint64)item->key, blob, blob_size, key_size, zstr_keys)) &&
+                             (!data_indirect || image_copy_is_valid((Uint64)item->data, blob, blob_size, data_size, zstr_data)),
+                             NULL, "invalid dense map image\n");
+    }
+    RETURN_VALUE_IF_FAIL(occupied == item_count, NULL, "invalid dense map image\n");
+
+    for(Size s = next_occupied_slot(mdata, length, 0); (key_indirect || data_indirect) && s != SIZE_MAX;
+        s = next_occupied_slot(mdata, length, s + 1)) {
+        DenseMapItem* item = (DenseMapItem*)slots + s;
+        if(key_indirect) image_relocate_copy(&item->key, blob);
+        if(data_indirect) image_relocate_copy(&item->data, blob);
     }
 
-    FREE(map);
+    Allocator* allocator = image_get_allocator(image);
+    map->metadata = (U8_Vector*)image_wrap_vector(allocator, mdata, sizeof(Uint8), length);
+    map->map      = (Dmi_Vector*)image_wrap_vector(allocator, slots, element_size, length);
+    ERR_RETURN_VALUE_IF_FAIL(map->metadata && map->map, NULL, ERR_OUT_OF_MEMORY);
+    if(!slot_size) {
+        map->map->create_copy  = (CreateDmiCopyCallback)(void*)create_dmi_copy;
+        map->map->destroy_copy = (DestroyDmiCopyCallback)(void*)destroy_dmi_copy;
+    }
+
+    memcpy(&map->max_load_factor, &params[8], sizeof(Float32));
+    memcpy(&map->min_load_factor, (const Uint8*)&params[8] + sizeof(Float32), sizeof(Float32));
+    map->hash            = hash;
+    map->compare_key     = compare_key;
+    map->hashes          = hashes;
+    map->is_multimap     = params[7] != 0;
+    map->item_count      = item_count;
+    map->tombstone_count = tombstone_count;
+    map->allocator       = allocator;
+
+    image_set_container(image, map);
+    return map;
 }
 
 /**
@@ -168,13 +765,10 @@ void dense_map_destroy(DenseMap* map, void* udata) {
  * the size in power of 2. So, for example if size is 200, the actual
  * size of hash map will be 256. If new size is 1024, then it stays 1024.
  *
- * If ater resize, there are collisions, then it'll be resolved,
- * as if this were a multimap. But when using the insert operation
- * after resize, it'll fallback to it's old behaviour.
- *
  * Using resize, one cannot reduce the size of hash map. This implementation
  * does not reduce size, even when the whole hash map becomes empty at once
- * stage.
+ * stage. Use @c dense_map_shrink_to_fit or @c dense_map_set_shrink_watermark
+ * for that.
  *
  * @param map DenseMap to be resized.
  * @param size New size. The actual size of hash map will be next power of 2 from given size.
@@ -183,66 +777,61 @@ void dense_map_destroy(DenseMap* map, void* udata) {
  * */
 void dense_map_resize(DenseMap* map, Size size, void* udata) {
     ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
-    if(size <= map->item_count) {
+    if(size <= map->item_count || size <= map->map->length) {
         return;
     }
 
-    // when we reach a size greater than or equal to given size and  that's also a power of 2, then we break.
-    Size sz = NEXT_POW2(size);
-
-    // create vector to store DenseMapItem entries for the DenseMap.
-    Dmi_Vector* dmi_vec = dmi_vector_create();
-    ERR_RETURN_IF_FAIL(dmi_vec,  ERR_INVALID_OBJECT);
-    dmi_vector_resize(dmi_vec, sz);
+    rehash_dense_map(map, NEXT_POW2(size), udata);
+}
 
-    // create vector to store metadata about each entry in the DenseMap.
-    U8_Vector* mdata_vec = u8_vector_create();
-    if(!mdata_vec) {
-        dmi_vector_destroy(dmi_vec, NULL);
-        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
-        return;
-    }
-    u8_vector_resize(mdata_vec, sz);
+/**
+ * Make sure that map can hold given number of items without rehashing,
+ * at it's configured load factor. Pre-sizing a map before a bulk load
+ * replaces repeated doubling with a single rehash.
+ * @param map
+ * @param expected_count Number of items map is expected to hold.
+ * @param udata User data passed to `hash`.
+ * */
+void dense_map_reserve(DenseMap* map, Size expected_count, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
 
-    // create vector to store probe sequence length
-    U8_Vector* psl_vec = u8_vector_create();
-    if(!psl_vec) {
-        dmi_vector_destroy(dmi_vec, NULL);
-        u8_vector_destroy(mdata_vec, NULL);
-        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
-        return;
+    Size size = size_for_count(map, expected_count, 1.f);
+    if(size > map->map->length) {
+        rehash_dense_map(map, size, udata);
     }
-    u8_vector_resize(psl_vec, sz);
+}
 
-    // store old map vectors with different names
-    Dmi_Vector* old_dmi_vec = map->map;
+/**
+ * Reduce number of slots to the smallest that holds current items at
+ * configured load factor. Tombstones are dropped too.
+ * @param map
+ * @param udata User data passed to `hash`.
+ * */
+void dense_map_shrink_to_fit(DenseMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
 
-    U8_Vector* old_mdata_vec = map->metadata;
-    u8_vector_destroy(map->probe_len, NULL);
+    Size size = size_for_count(map, map->item_count, 1.f);
+    if(size < map->map->length || map->tombstone_count || map->old_map) {
+        rehash_dense_map(map, size, udata);
+    }
+}
 
-    // assign new, unhashed maps to this DenseMap
-    map->map       = dmi_vec;
-    map->metadata  = mdata_vec;
-    map->probe_len = psl_vec;
-    map->item_count = 0;
+/**
+ * Shrink map automatically when a deletion takes load below given watermark.
+ * The map is then shrunk to be half full at most, so it takes a number of
+ * insertions or deletions proportional to it's size before it is resized
+ * again either way.
+ * @param map
+ * @param min_load_factor Load below which map shrinks. Must be less than a
+ * quarter of max load factor of map. 0 disables automatic shrinking.
+ * */
+void dense_map_set_shrink_watermark(DenseMap* map, Float32 min_load_factor) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
 
-    // rehash and insert
-    Size old_map_len = old_dmi_vec->length;
-    for(Size s = 0; s < old_map_len; s++) {
-        const Uint8 mdata = u8_vector_peek(old_mdata_vec, s);
-        if(mdata & MDATA_OCCUPANCY_MASK) {
-            /* insert directly without creating any more copies of data */
-            /* this function will automatically create both metadata and probe sequence lengths */
-            insert_into_dense_map_directly(map, dmi_vector_peek(old_dmi_vec, s), udata);
-        }
-    }
+    Float32 load_factor = MIN(map->max_load_factor, DENSE_MAP_MAX_LOAD_FACTOR);
+    ERR_RETURN_IF_FAIL(min_load_factor >= 0.f && min_load_factor < load_factor / 4, ERR_INVALID_ARGUMENTS);
 
-    // Cannot destroy map directly as this will destroy all previously created copies
-    // All this trickery is to void calling copy constructor twice for same key-value pair.
-    FREE(old_dmi_vec->data);
-    old_dmi_vec->data = NULL;
-    FREE(old_dmi_vec);
-    u8_vector_destroy(old_mdata_vec, NULL);
+    map->min_load_factor = min_load_factor;
 }
 
 /**
@@ -258,46 +847,7 @@ void dense_map_resize(DenseMap* map, Size size, void* udata) {
 DenseMapItem* dense_map_insert(DenseMap* map, void* key, void* value, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    Float32 load_factor = ((Float32)map->item_count + 1)/((Float32)map->map->length);
-    if(load_factor > map->max_load_factor) {
-        dense_map_resize(map, map->map->length * 2, udata);
-    }
-
-    // set callback data and a temporary instance of DenseMapItem that we'll create copy of
-    Dmi_CallbackData clbk_data = {
-        .udata = udata,
-        .map   = map
-    };
-    DenseMapItem tmp_dmi = { .key = key, .data = value };
-
-    // if not multimap, then first find any entry with same key
-    if(!map->is_multimap) {
-        // if an element with same key exists then insert this new data there by deleting old one.
-        DenseMapItem* searched_dmi = dense_map_search(map, key, udata);
-        if(searched_dmi) {
-            // destroy whatever's present at the given place
-            destroy_dmi_copy(searched_dmi, &clbk_data);
-            // create a new copy at the searched item's slot
-            create_dmi_copy(searched_dmi, &tmp_dmi, &clbk_data);
-            // return the new created copy
-            return searched_dmi;
-        }
-    }
-
-    // If no key-value pair exists with same key ten
-    // Create DenseMap's own copy of key-value pair
-    DenseMapItem this_dmi;
-    create_dmi_copy(&this_dmi, &tmp_dmi, &clbk_data);
-
-    // next insert in such a way that no more copy constructors will be called.
-    DenseMapItem* inserted_item = insert_into_dense_map_directly(map, &this_dmi, udata);
-    if(!inserted_item) {
-        destroy_dmi_copy(&this_dmi, &clbk_data);
-        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
-        return NULL;
-    }
-
-    return inserted_item;
+    return insert_hashed(map, key, value, map->hash(key, udata), udata);
 }
 
 /**
@@ -310,58 +860,509 @@ DenseMapItem* dense_map_insert(DenseMap* map, void* key, void* value, void* udat
 DenseMapItem* dense_map_search(DenseMap* map, void* key, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    Size len_wrap_mask = map->map->length - 1;
-    Size hash = map->hash(key, udata);
-    Size pos = hash & len_wrap_mask;
-    Size iter = pos;
-    Size iter_mdata = u8_vector_peek(map->metadata, iter);
-    Uint8 this_mdata = MDATA_OCCUPANCY_MASK | (hash & MDATA_HASH_MASK);
-
-    while((iter_mdata & MDATA_OCCUPANCY_MASK) && (((iter + 1) & len_wrap_mask) != pos)) {
-        if(iter_mdata == this_mdata) {
-            DenseMapItem* item = dmi_vector_peek(map->map, iter);
-            if(map->compare_key(item->key, key, udata) == 0) {
-                return item;
-            }
-        }
+    return dense_map_search_with_hash(map, key, map->hash(key, udata), udata);
+}
 
-        iter = (iter + 1) & len_wrap_mask;
-        iter_mdata = u8_vector_peek(map->metadata, iter);
-    }
+/**
+ * Insert given key-value pair, with hash of key already computed by caller,
+ * eg: because it was needed for something else too. Otherwise same as
+ * @c dense_map_insert.
+ * @param map
+ * @param key
+ * @param value
+ * @param hash Hash of key. Must be exactly what `hash` callback of map returns for @p key.
+ * @param udata User data passed to callbacks.
+ * @return Pointer to new inserted @c DenseMapItem in @c DenseMap.
+ * */
+DenseMapItem* dense_map_insert_with_hash(DenseMap* map, void* key, void* value, Size hash, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    return NULL;
+    return insert_hashed(map, key, value, hash, udata);
 }
 
 /**
- * Delete all items with given key in @c DenseMap.
- * When behaviour is of multimap then all items with same key
- * are destroyed. When behaviour is otherwise then only the entry
- * with given key is destroyed, because there exists only one such
- * entry.
+ * Search for given key, with hash of key already computed by caller.
+ * Otherwise same as @c dense_map_search.
  * @param map
  * @param key
- * @param udata User data passed to callbacks : `hash`, `compare_key`,
- * `destroy_dmi_copy`.
+ * @param hash Hash of key. Must be exactly what `hash` callback of map returns for @p key.
+ * @param udata User data passed to `compare_key`.
+ * @return Pointer to first @c DenseMapItem* with equivalent or matching key, else @c NULL.
  * */
-void dense_map_delete(DenseMap* map, void* key, void* udata) {
-    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+DenseMapItem* dense_map_search_with_hash(DenseMap* map, void* key, Size hash, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    Dmi_CallbackData clbk_data = {
-        .udata = udata,
-        .map   = map
-    };
+    if(map->old_map) {
+        migrate_slots(map, map->rehash_budget, udata);
+    }
 
-    // search for item with given key
-    DenseMapItem* item = dense_map_search(map, key, udata);
-    destroy_dmi_copy(item, &clbk_data);
-    map->item_count--;
-    while(map->compare_key(++item->key, key, udata) == 0) {
-        destroy_dmi_copy(item, &clbk_data);
-        map->item_count--;
+    /* most misses are answered by filter without touching slots */
+    if(map->filter && !bloom_contains_hash(map->filter, hash)) {
+        return NULL;
     }
+
+    return lookup(map, key, mix_hash(hash), udata);
 }
 
-/************************************ PRIVATE FUNCTIONS ***************************************/
+/**
+ * Hash a chunk of keys and prefetch metadata group and first slot of group
+ * each key starts probing from, so that cache misses of all keys in chunk
+ * overlap instead of being waited for one after another.
+ * @param map
+ * @param keys
+ * @param n Number of keys, at most @c DENSE_MAP_BATCH_SIZE.
+ * @param hashes Where hashes returned by `hash` callback are stored.
+ * @param skip Set for keys that filter says are absent. NULL to not use filter.
+ * @param udata User data passed to `hash`.
+ * */
+static void prefetch_batch(DenseMap* map, void** keys, Size n, Size* hashes, Bool* skip, void* udata) {
+    Size group_mask = map->map->length / GROUP_SIZE - 1;
+
+    for(Size k = 0; k < n; k++) {
+        hashes[k] = map->hash(keys[k], udata);
+    }
+
+    for(Size k = 0; k < n; k++) {
+        if(skip) {
+            skip[k] = map->filter && !bloom_contains_hash(map->filter, hashes[k]);
+            if(skip[k]) {
+                continue;
+            }
+        }
+
+        Size first = ((mix_hash(hashes[k]) >> 7) & group_mask) * GROUP_SIZE;
+        __builtin_prefetch(METADATA(map) + first);
+        __builtin_prefetch(SLOT_ADDR(map, first));
+    }
+}
+
+/**
+ * Search for many keys at once. Keys are processed in chunks : all keys of a
+ * chunk are hashed and their metadata and slots are prefetched before any of
+ * them is probed, which hides most of memory latency when map is much larger
+ * than cache. Results are same as calling @c dense_map_search for each key.
+ *
+ * @param map
+ * @param keys Array of @p n keys, each in same form as taken by @c dense_map_search.
+ * @param n Number of keys.
+ * @param out Array of @p n pointers, where item found for each key
+ * (or NULL when key is absent) is stored.
+ * @param udata User data passed to callbacks : `hash`, `compare_key`
+ * @return Number of keys found.
+ * */
+Size dense_map_search_batch(DenseMap* map, void** keys, Size n, DenseMapItem** out, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && ((keys && out) || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    Size hashes[DENSE_MAP_BATCH_SIZE];
+    Bool skip[DENSE_MAP_BATCH_SIZE];
+    Size found = 0;
+
+    for(Size base = 0; base < n; base += DENSE_MAP_BATCH_SIZE) {
+        Size count = MIN(n - base, (Size)DENSE_MAP_BATCH_SIZE);
+        if(map->old_map) {
+            migrate_slots(map, map->rehash_budget, udata);
+        }
+        prefetch_batch(map, keys + base, count, hashes, skip, udata);
+
+        for(Size k = 0; k < count; k++) {
+            out[base + k] = skip[k] ? NULL : lookup(map, keys[base + k], mix_hash(hashes[k]), udata);
+            found += out[base + k] != NULL;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * Insert many key-value pairs at once. Map is grown once up front to fit
+ * all items, and then keys are processed in chunks like in
+ * @c dense_map_search_batch. Results are same as calling @c dense_map_insert
+ * for each pair in order.
+ *
+ * Pointers stored in @p out stay valid only until map is rehashed, and with
+ * tombstones present, a later insertion of same batch can still rehash map.
+ * Use them before next modification of map.
+ *
+ * @param map
+ * @param keys Array of @p n keys, each in same form as taken by @c dense_map_insert.
+ * @param values Array of @p n values, each in same form as taken by @c dense_map_insert.
+ * @param n Number of pairs.
+ * @param out Array of @p n pointers, where inserted item of each pair
+ * (or NULL on failure) is stored. Can be NULL.
+ * @param udata Pointer to user data provied to callbacks :
+ * `hash`, `compare_key`, `create_data_copy`, `create_key_copy`, `destroy_data_copy`, `destroy_key_copy`
+ * @return Number of pairs inserted successfully.
+ * */
+Size dense_map_insert_batch(DenseMap* map, void** keys, void** values, Size n, DenseMapItem** out, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && ((keys && values) || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    // grow once now, instead of possibly many times in between, unless rehashes are incremental
+    if(!map->rehash_budget) {
+        dense_map_reserve(map, map->item_count + n, udata);
+    }
+
+    Size hashes[DENSE_MAP_BATCH_SIZE];
+    Size inserted = 0;
+
+    for(Size base = 0; base < n; base += DENSE_MAP_BATCH_SIZE) {
+        Size count = MIN(n - base, (Size)DENSE_MAP_BATCH_SIZE);
+        prefetch_batch(map, keys + base, count, hashes, NULL, udata);
+
+        for(Size k = 0; k < count; k++) {
+            DenseMapItem* item = insert_hashed(map, keys[base + k], values[base + k], hashes[k], udata);
+            if(out) {
+                out[base + k] = item;
+            }
+            inserted += item != NULL;
+        }
+    }
+
+    return inserted;
+}
+
+/**
+ * Load many key-value pairs at once, eg: when building a map from scratch.
+ * Table is sized once for all pairs, and keys are hashed a chunk at a time
+ * in a tight loop before any of them is placed.
+ *
+ * With @c DENSE_MAP_BUILD_UNIQUE_KEYS, caller guarantees that keys are
+ * distinct from each other and from keys already in map. No key is then
+ * compared with any other, no growth is checked per pair, and each pair
+ * goes straight to first free slot of it's probe sequence. Breaking that
+ * guarantee leaves duplicate items in map. Without the flag, pairs are
+ * inserted as by @c dense_map_insert_batch.
+ *
+ * @param map
+ * @param keys Array of @p n keys, each in same form as taken by @c dense_map_insert.
+ * @param values Array of @p n values, each in same form as taken by @c dense_map_insert.
+ * @param n Number of pairs.
+ * @param flags Bitwise or of @c DENSE_MAP_BUILD_* flags.
+ * @param udata Pointer to user data provied to callbacks.
+ * @return Number of pairs inserted successfully.
+ * */
+Size dense_map_build_from_arrays(DenseMap* map, void** keys, void** values, Size n, Uint32 flags, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && ((keys && values) || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    if(!(flags & DENSE_MAP_BUILD_UNIQUE_KEYS)) {
+        dense_map_reserve(map, map->item_count + n, udata);
+        return dense_map_insert_batch(map, keys, values, n, NULL, udata);
+    }
+
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, udata);
+    }
+
+    // tombstones count towards load, so a table crowded by them is rebuilt too
+    Float32 load_factor = MIN(map->max_load_factor, DENSE_MAP_MAX_LOAD_FACTOR);
+    if((Float32)(map->item_count + map->tombstone_count + n) > load_factor * (Float32)map->map->length) {
+        rehash_dense_map(map, MAX(size_for_count(map, map->item_count + n, 1.f), map->map->length), udata);
+    }
+    ERR_RETURN_VALUE_IF_FAIL((Float32)(map->item_count + map->tombstone_count + n) <= load_factor * (Float32)map->map->length,
+                             0, ERR_OUT_OF_MEMORY);
+
+    Uint8* mdata  = METADATA(map);
+    Size   length = map->map->length;
+    Size   hashes[DENSE_MAP_BATCH_SIZE];
+
+    for(Size base = 0; base < n; base += DENSE_MAP_BATCH_SIZE) {
+        Size count = MIN(n - base, (Size)DENSE_MAP_BATCH_SIZE);
+        prefetch_batch(map, keys + base, count, hashes, NULL, udata);
+
+        for(Size k = 0; k < count; k++) {
+            Uint64 hash = mix_hash(hashes[k]);
+            Size   slot = find_free_slot(mdata, length, hash);
+
+            create_slot_copy(map, slot, keys[base + k], values[base + k], udata);
+
+            if(mdata[slot] == MDATA_DELETED) {
+                map->tombstone_count--;
+            }
+            mdata[slot]       = MDATA_OF(hash);
+            HASHES(map)[slot] = hash;
+
+            if(map->filter) {
+                bloom_insert_hash(map->filter, hashes[k]);
+            }
+        }
+    }
+
+    map->item_count += n;
+    return n;
+}
+
+/**
+ * Delete all items with given key in @c DenseMap.
+ * When behaviour is of multimap then all items with same key
+ * are destroyed. When behaviour is otherwise then only the entry
+ * with given key is destroyed, because there exists only one such
+ * entry.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks : `hash`, `compare_key`,
+ * `destroy_dmi_copy`.
+ * */
+void dense_map_delete(DenseMap* map, void* key, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_slots(map, map->rehash_budget, udata);
+    }
+
+    Uint64 hash  = mix_hash(map->hash(key, udata));
+    Size   count = map->item_count;
+    delete_in_table(map, key, hash, udata);
+
+    // key may still have items that are not migrated yet
+    if(map->old_map && (map->is_multimap || map->item_count == count)) {
+        swap_tables(map);
+        delete_in_table(map, key, hash, udata);
+        swap_tables(map);
+    }
+
+    Size length = map->map->length;
+    if(map->item_count != count && length > DENSE_MAP_INITIAL_SIZE &&
+       (Float32)map->item_count < map->min_load_factor * (Float32)length) {
+        begin_rehash(map, size_for_count(map, map->item_count, 0.5f), udata);
+    }
+}
+
+/**
+ * Put a blocked Bloom filter of keys in front of @c dense_map_search,
+ * so that searches for absent keys mostly return without probing.
+ * Keys already in map are added to new filter, and every insertion
+ * afterwards adds it's key too. Deleted keys stay in filter, so enable
+ * filter again after many deletions to rebuild it.
+ *
+ * @param map
+ * @param expected_count Number of keys map is expected to hold.
+ * @param false_positive_rate Acceptable rate of absent keys that still probe.
+ * @param udata User data passed to `hash` callback.
+ * */
+void dense_map_enable_filter(DenseMap* map, Size expected_count, Float64 false_positive_rate, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, udata);
+    }
+
+    BloomFilter* filter = bloom_create_for(map->hash, MAX(expected_count, map->item_count),
+                                           false_positive_rate, True, map->allocator);
+    ERR_RETURN_IF_FAIL(filter, ERR_INVALID_OBJECT);
+
+    for(Size s = next_occupied_slot(METADATA(map), map->map->length, 0); s != SIZE_MAX;
+        s = next_occupied_slot(METADATA(map), map->map->length, s + 1)) {
+        bloom_insert_hash(filter, map->hash(slot_key(map, s), udata));
+    }
+
+    dense_map_disable_filter(map);
+    map->filter = filter;
+}
+
+/**
+ * Remove filter added by @c dense_map_enable_filter, if any.
+ * @param map
+ * */
+void dense_map_disable_filter(DenseMap* map) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->filter) {
+        bloom_destroy(map->filter);
+        map->filter = NULL;
+    }
+}
+
+/**
+ * Get next item of an iteration over map. Free slots are skipped a whole
+ * group of metadata at a time.
+ *
+ * Map must not be modified during iteration, except for changing data of
+ * returned items in place.
+ *
+ * @param map
+ * @param iter Zero initialized before first call, advanced by each call.
+ * @return Next item, NULL when all items have been visited.
+ * */
+DenseMapItem* dense_map_iter_next(DenseMap* map, DenseMapIterator* iter) {
+    ERR_RETURN_VALUE_IF_FAIL(map && iter, NULL, ERR_INVALID_ARGUMENTS);
+
+    Size length = map->map->length;
+    if(iter->slot < length) {
+        Size slot = next_occupied_slot(METADATA(map), length, iter->slot);
+        if(slot != SIZE_MAX) {
+            iter->slot = slot + 1;
+            return (DenseMapItem*)SLOT_ADDR(map, slot);
+        }
+        iter->slot = length;
+    }
+
+    // slots after current table are slots of table being migrated from
+    if(map->old_map) {
+        Size old_length = map->old_map->length;
+        Size slot       = next_occupied_slot(map->old_metadata->data, old_length, iter->slot - length);
+        iter->slot      = slot == SIZE_MAX ? length + old_length : length + slot + 1;
+        if(slot != SIZE_MAX) {
+            return (DenseMapItem*)((Uint8*)map->old_map->data + slot * map->old_map->element_size);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Call @p visitor for each item in map, in slot order.
+ * @p visitor must not modify @p map, except for changing data of given
+ * item in place.
+ *
+ * @param map
+ * @param visitor Callback to be called for each item.
+ * @param udata User data to be passed to @p visitor.
+ * */
+void dense_map_foreach(DenseMap* map, DenseMapVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(map && visitor, ERR_INVALID_ARGUMENTS);
+
+    visit_table(map, visitor, False, udata);
+    if(map->old_map) {
+        swap_tables(map);
+        visit_table(map, visitor, False, udata);
+        swap_tables(map);
+    }
+}
+
+/**
+ * Remove all items from map, keeping it's capacity.
+ * Bloom filter of map, if any, is cleared too.
+ * @param map
+ * @param udata User data passed to copy destructors.
+ * */
+void dense_map_clear(DenseMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    dense_map_drain(map, NULL, udata);
+}
+
+/**
+ * Call @p visitor for each item in map and remove it right after, so that
+ * taking every item out of a map costs a single pass over it's slots.
+ * Map is left empty, with it's capacity unchanged. Item given to @p visitor
+ * is destroyed after @p visitor returns, so it must copy out anything it
+ * needs to keep.
+ *
+ * @param map
+ * @param visitor Callback to be called for each item. Can be NULL to only clear map.
+ * @param udata User data passed to @p visitor and copy destructors.
+ * */
+void dense_map_drain(DenseMap* map, DenseMapVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    visit_table(map, visitor, True, udata);
+    if(map->old_map) {
+        swap_tables(map);
+        visit_table(map, visitor, True, udata);
+        swap_tables(map);
+        destroy_old_table(map);
+    }
+
+    memset(METADATA(map), MDATA_EMPTY, map->map->length);
+    map->item_count      = 0;
+    map->tombstone_count = 0;
+
+    if(map->filter) {
+        bloom_clear(map->filter);
+    }
+}
+
+/**
+ * Make future rehashes of map incremental. Instead of moving all items at
+ * once when map grows, a new table is created and both tables coexist while
+ * each following insert, search and delete moves items from a bounded number
+ * of old slots. Searches look into both tables until migration finishes.
+ * This bounds latency of every operation at cost of a slightly slower
+ * average during migration.
+ *
+ * In this mode, @c dense_map_search modifies map too, so it can't be called
+ * concurrently even with other searches, and an item pointer returned by any
+ * operation is valid only until next operation on map.
+ *
+ * @param map
+ * @param budget Number of old slots to migrate per operation, rounded up to a
+ * whole group of slots. Must be non-zero.
+ * */
+void dense_map_enable_incremental_rehash(DenseMap* map, Size budget) {
+    ERR_RETURN_IF_FAIL(map && budget, ERR_INVALID_ARGUMENTS);
+
+    map->rehash_budget = budget;
+}
+
+/**
+ * Make future rehashes of map move all items at once again. A migration in
+ * progress is finished right away.
+ * @param map
+ * @param udata User data passed to `hash`.
+ * */
+void dense_map_disable_incremental_rehash(DenseMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, udata);
+    }
+    map->rehash_budget = 0;
+}
+
+/**
+ * Drive an incremental rehash in progress, eg: when program is idle.
+ * Does nothing when no migration is in progress.
+ * @param map
+ * @param budget Number of old slots to migrate. SIZE_MAX to finish migration.
+ * @param udata User data passed to `hash`.
+ * @return True if migration is still in progress, False otherwise.
+ * */
+Bool dense_map_rehash_step(DenseMap* map, Size budget, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map && budget) {
+        migrate_slots(map, budget, udata);
+    }
+    return map->old_map != NULL;
+}
+
+/**
+ * Measure how well keys are spread over map. Costs a pass over all slots,
+ * and walks probe sequence of each key, but never calls `hash` or `compare_key`.
+ * @param map
+ * @param stats Filled with statistics of map, see @c HashMapStats.
+ * */
+void dense_map_stats(DenseMap* map, HashMapStats* stats) {
+    ERR_RETURN_IF_FAIL(map && stats, ERR_INVALID_ARGUMENTS);
+
+    memset(stats, 0, sizeof(HashMapStats));
+    stats->item_count      = map->item_count;
+    stats->capacity        = map->map->length;
+    stats->tombstone_count = map->tombstone_count;
+    stats->resize_count    = map->resize_count;
+
+    Size current_count = table_stats(METADATA(map), HASHES(map), map->map->length, stats);
+    stats->load_factor = (Float64)current_count / (Float64)map->map->length;
+    if(map->old_map) {
+        stats->capacity        += map->old_map->length;
+        stats->tombstone_count += map->old_tombstone_count;
+        table_stats(map->old_metadata->data, map->old_hashes, map->old_map->length, stats);
+    }
+
+    // keys and data larger than 8 bytes are allocated separately for each item
+    Size copy_size = 0;
+    if(!IS_INLINE(map)) {
+        copy_size += map->key_size > 8 ? map->key_size : 0;
+        copy_size += map->data_size > 8 ? map->data_size : 0;
+    }
+    Size slot_size = map->map->element_size + sizeof(Uint8) + sizeof(DenseMapHash);
+
+    stats->bytes_used      = map->item_count * (slot_size + copy_size);
+    stats->bytes_allocated = stats->capacity * slot_size + map->item_count * copy_size;
+
+    hash_map_stats_finish(stats);
+}
+
+/************************************ PRIVATE FUNCTIONS ***************************************/
 
 /**
  * Macro to create code for wrapper over copy constructors
@@ -372,14 +1373,18 @@ void dense_map_delete(DenseMap* map, void* key, void* udata) {
 #define CREATE_COPY(d, s, n)                                            \
     do {                                                                \
         DenseMap* hmap = clbk_data->map;                                \
-        if(hmap->create_##n##_copy) {                                   \
-            (d)->n = ALLOCATE(Uint8, hmap->n##_size);                   \
+        if(hmap->create_##n##_copy && hmap->n##_size <= 8) {            \
+            /* small copies live in item itself, like in a Vector */    \
+            (d)->n = NULL;                                              \
+            hmap->create_##n##_copy(&(d)->n, (s)->n, clbk_data->udata); \
+        } else if(hmap->create_##n##_copy) {                            \
+            (d)->n = allocator_allocate_zeroed(hmap->allocator, hmap->n##_size); \
             ERR_RETURN_IF_FAIL((d)->n, ERR_OUT_OF_MEMORY);                  \
             hmap->create_##n##_copy((d)->n, (s)->n, clbk_data->udata);  \
         } else if(hmap->n##_size <= 8) {                                \
             (d)->n = (s)->n;                                            \
         } else  {                                                       \
-            (d)->n = ALLOCATE(Uint8, hmap->n##_size);                   \
+            (d)->n = allocator_allocate_zeroed(hmap->allocator, hmap->n##_size); \
             ERR_RETURN_IF_FAIL((d)->n, ERR_OUT_OF_MEMORY);                  \
             if((s)->n) memcpy((d)->n, (s)->n, hmap->n##_size);          \
         }                                                               \
@@ -393,11 +1398,13 @@ void dense_map_delete(DenseMap* map, void* key, void* udata) {
 #define DESTROY_COPY(c, n)                                      \
     do {                                                        \
         DenseMap* hmap = clbk_data->map;                        \
-        if(hmap->destroy_##n##_copy) {                          \
+        if(hmap->destroy_##n##_copy && hmap->n##_size <= 8) {   \
+            hmap->destroy_##n##_copy(&c->n, clbk_data->udata);  \
+        } else if(hmap->destroy_##n##_copy) {                   \
             hmap->destroy_##n##_copy(c->n, clbk_data->udata);   \
-            FREE(c->n);                                         \
+            allocator_free(hmap->allocator, c->n, hmap->n##_size); \
         } else if(hmap->n##_size > 8) {                         \
-            FREE(c->n);                                         \
+            allocator_free(hmap->allocator, c->n, hmap->n##_size); \
         }                                                       \
         c->n = 0;                                               \
     } while(0)
@@ -429,104 +1436,706 @@ void destroy_dmi_copy(DenseMapItem* copy, Dmi_CallbackData* clbk_data) {
 
 /**
  *                      GENNERAL IMPLEMENTATION INFO
- * The following implementation uses a modified version of Robin Hood hashing.
- * Robin Hood hashing works by maintaining an attribute for each item in the
- * @c DenseMap. This attribute measures how far the item is from it's desired
- * position in the map. This is known as probe length. In @c DenseMap, this is
- * stored in a vector named @c probe_len.
- *
- * Robin Hood hashing is a collision resolution technique within hash tables that aims
- * to minimize probe length, reducing clustering of elements with the same hash values.
- * While it attempts to optimize by favorably positioning items with identical hash values,
- * it does not ensure the optimal layout for all elements in the table. This
- * introduces another property of Robin Hood hashing, clustering. Due to clustering,
- * all items having same hash value will be found clustered in the whole map. All
- * such items will be found in vicinity of each other and there won't be any item
- * with a different hash value in bettween any two items with same hash value.
- * Here clusters are analogous to buckets in separate chaining.
+ * The following implementation is modelled after SwissTable (abseil's flat_hash_map).
+ * Along with the vector of items, we maintain a vector of 8 bit metadata values, one
+ * for each slot. Highest bit of metadata tells whether slot is occupied. For an occupied
+ * slot, lower 7 bits are lower 7 bits of (mixed) hash of it's key. For free slots, metadata
+ * is either @c MDATA_EMPTY for slots never used since last rehash, or @c MDATA_DELETED
+ * (a tombstone) for slots whose item was deleted.
  *
- *                                SPECIFICS
- * The modification in Robin Hood hashing is that now we maintain a new vector, containing
- * 8 bit values, with highest bit indicitating whether or not the entry is pre-occupied.
- * The lower 7 bits contains, lower 7 bits of hash value of corresponding item in the map.
- * By corresponding item, I mean, item at same index. This 8 bit value is called metadata
- * and is stored with same name in @c DenseMap.
+ * Slots are divided into groups of @c GROUP_SIZE. Remaining bits of hash select the first
+ * group to look in, and further groups are visited with triangular probing, which visits
+ * every group exactly once when number of groups is a power of two. In each group :
+ * - metadata of whole group is compared with metadata of searched key at once, and keys are
+ *   compared only for slots in resulting mask. With 7 hash bits, a key comparision is a
+ *   false positive only 1 in 128 times.
+ * - if group has an empty slot, then no insertion ever went past this group, so search ends.
  *
- * Now, the un-optimized implementation of insert operation does not use this whole metadata
- * value. It needs only the highest btt of metadata to know occupancy status at given posn.
- * This un-optimized version hence is the vanilla implementation of Robin Hood hashing.
+ * Deleting an item turns it's slot into a tombstone, unless it's group has an empty slot,
+ * in which case no probe sequence goes through this group and slot can become empty again.
+ * Tombstones are dropped whenever map is rehashed.
  *
  * Some references
- * [0] : https://programming.guide/robin-hood-hashing.html (explains with animations)
- * [1] : https://jasonlue.github.io/algo/2019/08/20/clustered-hashing.html (lots of content)
- * [2] : https://youtu.be/M2fKMP47slQ?si=rTfRyId52pXqMfEQ (from where I got the idea to implement this)
- * */
-
-/**< Defined this way to standardize the names of variables in macros that need same set of variables */
-
-/**
- * Insert into the given @c DenseMap directly without triggering copy constructors.
- * @param map @c DenseMap to insert into.
- * @param dmi @c DenseMapItem to be directly inserted.
- * @param udata User data passed to callbacks : `hash`
- * @return Pointer to inserted @c DenseMapItem into the map. Note that inserted
- * @c DenseMapItem is a direct @c memcpy of provided @c DenseMapItem. The
- * returned pointer will be an address in the internal mapping vector maintained
- * by the given @c DenseMap.
- * */
-static inline DenseMapItem* insert_into_dense_map_directly(DenseMap* map, DenseMapItem* dmi, void* udata) {
-    ERR_RETURN_VALUE_IF_FAIL(map && dmi, NULL, ERR_INVALID_ARGUMENTS);
-
-    DenseMapItem this_dmi = *dmi;
-    Size hash = map->hash(dmi->key, udata);
-    Size len_wrap_mask = map->map->length - 1;
-    Size pos = hash & len_wrap_mask; /* it's guaranteed that size of densemap will always be in powers of two */
-    Size iter = pos;
-    Uint8 iter_psl = u8_vector_peek(map->probe_len, iter);
-    Uint8 this_psl = 0;
-    Uint8 this_mdata = MDATA_OCCUPANCY_MASK | (hash & MDATA_HASH_MASK);
-
-    /* if total size of psl vector is less than maximum size of vector, use unoptimized search */
-    while(True) {
-        /* when this becomes poor as compared to iterated position, swap values */
-        if(this_psl > iter_psl) {
-            /* swap metadata before, to know the occupancy status. */
-            Uint8 tmp_mdata = u8_vector_peek(map->metadata, iter);
-            u8_vector_overwrite(map->metadata, iter, this_mdata, NULL);
-                this_mdata = tmp_mdata;
-
-                /* swap items */
-                DenseMapItem* iter_dmi = dmi_vector_peek(map->map, iter);
-                /* need to swap only if this position is already occupied */
-                if(this_mdata & MDATA_OCCUPANCY_MASK) {
-                    DenseMapItem tmp_dmi = *iter_dmi;
-                    memcpy(iter_dmi, &this_dmi, sizeof(DenseMapItem));
-                    this_dmi = tmp_dmi;
-                } else {
-                    /* if the position is not already occupied then we just do an overwrite. */
-                    memcpy(iter_dmi, &this_dmi, sizeof(DenseMapItem));
-                }
-
-                /* swap psls' as well */
-                Uint8 tmp_psl = u8_vector_peek(map->probe_len, iter);
-                u8_vector_overwrite(map->probe_len, iter, this_psl, NULL);
-                this_psl = tmp_psl;
-
-                /* stop processing if the value we just swapped with was in an empty slot. */
-                if(!(this_mdata & MDATA_OCCUPANCY_MASK)) {
-                    break;
-                }
+ * [0] : https://abseil.io/about/design/swisstables
+ * [1] : https://youtu.be/ncHmEUmJZf4 (CppCon 2017, Designing a Fast, Efficient, Cache-friendly Hash Table)
+ * */
+
+/**
+ * Find first slot holding given key.
+ * @param map
+ * @param key
+ * @param hash Mixed hash of key.
+ * @param udata User data passed to `compare_key`.
+ * @return Index of slot. SIZE_MAX if key is not present.
+ * */
+static Size find_slot(DenseMap* map, void* key, Uint64 hash, void* udata) {
+    const Uint8* mdata      = METADATA(map);
+    const Uint8  this_mdata = MDATA_OF(hash);
+    Size         group_mask = map->map->length / GROUP_SIZE - 1;
+    Size         group      = (hash >> 7) & group_mask;
+
+    COUNTER_INC(DENSE_MAP_FIND);
+    for(Size step = 1; step <= group_mask + 1; step++) {
+        const Uint8* gmdata = mdata + group * GROUP_SIZE;
+        COUNTER_INC(DENSE_MAP_GROUP_PROBE);
+
+        for(GroupMask match = group_match(gmdata, this_mdata); match; match &= match - 1) {
+            Size slot = group * GROUP_SIZE + GROUP_SLOT(match);
+            if(HASHES(map)[slot] != hash) {
+                continue;
+            }
+
+            COUNTER_INC(DENSE_MAP_KEY_COMPARE);
+            if(map->compare_key(slot_key(map, slot), key, udata) == 0) {
+                return slot;
+            }
         }
 
-        /* psl of element not yet inserted in the map will keep increasing */
-        this_psl++;
+        if(group_match(gmdata, MDATA_EMPTY)) {
+            break;
+        }
+        group = (group + step) & group_mask;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Insert given key-value pair, using already computed hash of key.
+ * @param map
+ * @param key
+ * @param value
+ * @param user_hash Hash of key returned by `hash` callback.
+ * @param udata
+ * @return Pointer to new inserted @c DenseMapItem in @c DenseMap.
+ * */
+static DenseMapItem* insert_hashed(DenseMap* map, void* key, void* value, Size user_hash, void* udata) {
+    Uint64 hash = mix_hash(user_hash);
+
+    if(map->old_map) {
+        migrate_slots(map, map->rehash_budget, udata);
+    }
+
+    // if not multimap, then first find any entry with same key
+    if(!map->is_multimap) {
+        DenseMapItem* item = replace_existing(map, key, value, hash, udata);
+        if(!item && map->old_map) {
+            swap_tables(map);
+            item = replace_existing(map, key, value, hash, udata);
+            swap_tables(map);
+        }
+        if(item) {
+            return item;
+        }
+    }
 
-        /* increase iterator and fecth metadata as well as probe sequence length */
-        iter = (iter + 1) & len_wrap_mask;
-        iter_psl = u8_vector_peek(map->probe_len, iter);
+    // tombstones lengthen probe sequences just like items, so both count towards load
+    Size    length      = map->map->length;
+    Float32 load_factor = MIN(map->max_load_factor, DENSE_MAP_MAX_LOAD_FACTOR);
+    if((Float32)(map->item_count + map->tombstone_count + 1) > load_factor * (Float32)length) {
+        // grow only when items alone are dense, otherwise rehashing drops tombstones
+        Bool grow = (Float32)(map->item_count + 1) > load_factor * (Float32)length / 2;
+        begin_rehash(map, grow ? length * 2 : length, udata);
     }
 
-    // finally return the stored item
+    Size slot = find_free_slot(METADATA(map), map->map->length, hash);
+    ERR_RETURN_VALUE_IF_FAIL(slot != SIZE_MAX, NULL, ERR_OPERATION_FAILED);
+
+    create_slot_copy(map, slot, key, value, udata);
+
+    if(METADATA(map)[slot] == MDATA_DELETED) {
+        map->tombstone_count--;
+    }
+    METADATA(map)[slot] = MDATA_OF(hash);
+    HASHES(map)[slot]   = hash;
     map->item_count++;
-    return dmi_vector_peek(map->map, iter);
+
+    if(map->filter) {
+        bloom_insert_hash(map->filter, user_hash);
+    }
+
+    return (DenseMapItem*)SLOT_ADDR(map, slot);
+}
+
+/**
+ * Find first item with given key, in current table and then in table being
+ * migrated from, if any.
+ * @param map
+ * @param key
+ * @param hash Mixed hash of key.
+ * @param udata User data passed to `compare_key`.
+ * @return Item if found, NULL otherwise.
+ * */
+static DenseMapItem* lookup(DenseMap* map, void* key, Uint64 hash, void* udata) {
+    Size slot = find_slot(map, key, hash, udata);
+    if(slot != SIZE_MAX) {
+        return (DenseMapItem*)SLOT_ADDR(map, slot);
+    }
+
+    DenseMapItem* item = NULL;
+    if(map->old_map) {
+        swap_tables(map);
+        slot = find_slot(map, key, hash, udata);
+        item = slot == SIZE_MAX ? NULL : (DenseMapItem*)SLOT_ADDR(map, slot);
+        swap_tables(map);
+    }
+
+    return item;
+}
+
+/**
+ * Replace key and value of first item with given key in current table.
+ * @param map
+ * @param key
+ * @param value
+ * @param hash Mixed hash of key.
+ * @param udata User data passed to callbacks.
+ * @return Replaced item, NULL if key is not in current table.
+ * */
+static DenseMapItem* replace_existing(DenseMap* map, void* key, void* value, Uint64 hash, void* udata) {
+    Size slot = find_slot(map, key, hash, udata);
+    if(slot == SIZE_MAX) {
+        return NULL;
+    }
+
+    // destroy whatever's present at the given place and create a new copy there
+    destroy_slot_copy(map, slot, udata);
+    create_slot_copy(map, slot, key, value, udata);
+    return (DenseMapItem*)SLOT_ADDR(map, slot);
+}
+
+/**
+ * Delete items with given key from current table of map.
+ * @param map
+ * @param key
+ * @param hash Mixed hash of key.
+ * @param udata User data passed to `compare_key` and copy destructors.
+ * */
+static void delete_in_table(DenseMap* map, void* key, Uint64 hash, void* udata) {
+    Uint8* mdata      = METADATA(map);
+    Size   group_mask = map->map->length / GROUP_SIZE - 1;
+    Size   group      = (hash >> 7) & group_mask;
+
+    for(Size step = 1; step <= group_mask + 1; step++) {
+        Uint8*    gmdata = mdata + group * GROUP_SIZE;
+        GroupMask empty  = group_match(gmdata, MDATA_EMPTY);
+
+        for(GroupMask match = group_match(gmdata, MDATA_OF(hash)); match; match &= match - 1) {
+            Size slot = group * GROUP_SIZE + GROUP_SLOT(match);
+            if(HASHES(map)[slot] != hash || map->compare_key(slot_key(map, slot), key, udata) != 0) {
+                continue;
+            }
+
+            destroy_slot_copy(map, slot, udata);
+            map->item_count--;
+
+            /* a group that still has an empty slot never had a probe sequence pass through it */
+            if(empty) {
+                mdata[slot] = MDATA_EMPTY;
+            } else {
+                mdata[slot] = MDATA_DELETED;
+                map->tombstone_count++;
+            }
+
+            if(!map->is_multimap) {
+                return;
+            }
+        }
+
+        if(empty) {
+            return;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+/**
+ * Find first empty or deleted slot in probe sequence of given hash.
+ * @param mdata Metadata of map.
+ * @param length Number of slots in map.
+ * @param hash Mixed hash of key to be inserted.
+ * @return Index of slot. SIZE_MAX if map is full.
+ * */
+static Size find_free_slot(Uint8* mdata, Size length, Uint64 hash) {
+    Size group_mask = length / GROUP_SIZE - 1;
+    Size group      = (hash >> 7) & group_mask;
+
+    for(Size step = 1; step <= group_mask + 1; step++) {
+        GroupMask free = group_match_free(mdata + group * GROUP_SIZE);
+        if(free) {
+            return group * GROUP_SIZE + GROUP_SLOT(free);
+        }
+        group = (group + step) & group_mask;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Find first occupied slot at or after given slot.
+ * @param mdata Metadata of map.
+ * @param length Number of slots in map.
+ * @param from
+ * @return Index of slot. SIZE_MAX if there's none.
+ * */
+static Size next_occupied_slot(const Uint8* mdata, Size length, Size from) {
+    for(Size group = from & ~(Size)(GROUP_SIZE - 1); group < length; group += GROUP_SIZE) {
+        GroupMask occupied = group_match_occupied(mdata + group);
+        if(group < from) {
+            occupied &= ~(GroupMask)0 << ((from - group) << GROUP_SLOT_SHIFT);
+        }
+        if(occupied) {
+            return group + GROUP_SLOT(occupied);
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Move all items into new slot and metadata vectors of given size, without
+ * creating any more copies of items. Tombstones are dropped in the process.
+ * @param map
+ * @param size New number of slots, a power of two.
+ * @param udata User data passed to `hash`.
+ * */
+static void rehash_dense_map(DenseMap* map, Size size, void* udata) {
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, udata);
+    }
+
+    size = MAX(size, (Size)DENSE_MAP_INITIAL_SIZE);
+
+    // create vector to store slots of the DenseMap.
+    Dmi_Vector* dmi_vec = create_slot_vector(map, size);
+    ERR_RETURN_IF_FAIL(dmi_vec,  ERR_INVALID_OBJECT);
+
+    // create vector to store metadata about each entry in the DenseMap.
+    U8_Vector* mdata_vec = u8_vector_create_with_allocator(map->allocator);
+    if(!mdata_vec) {
+        destroy_dmi_vector_shallow(dmi_vec);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        return;
+    }
+    u8_vector_resize(mdata_vec, size);
+
+    DenseMapHash* hashes = create_hash_array(map, size);
+    if(dmi_vec->length != size || mdata_vec->length != size || !hashes) {
+        destroy_dmi_vector_shallow(dmi_vec);
+        u8_vector_destroy(mdata_vec, NULL);
+        if(hashes) destroy_hash_array(map, hashes, size);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return;
+    }
+
+    // move each item to it's slot in new vectors, using stored hashes
+    const Uint8* old_mdata = METADATA(map);
+    Size         old_size  = map->map->length;
+    for(Size s = next_occupied_slot(old_mdata, old_size, 0); s != SIZE_MAX;
+        s = next_occupied_slot(old_mdata, old_size, s + 1)) {
+        Uint64 hash = HASHES(map)[s];
+        Size   slot = find_free_slot(mdata_vec->data, size, hash);
+
+        memcpy((Uint8*)dmi_vec->data + slot * dmi_vec->element_size, SLOT_ADDR(map, s), dmi_vec->element_size);
+        mdata_vec->data[slot] = MDATA_OF(hash);
+        hashes[slot]          = hash;
+    }
+
+    // Cannot destroy map directly as this will destroy all previously created copies
+    destroy_hash_array(map, map->hashes, old_size);
+    destroy_dmi_vector_shallow(map->map);
+    u8_vector_destroy(map->metadata, NULL);
+
+    map->map             = dmi_vec;
+    map->metadata        = mdata_vec;
+    map->hashes          = hashes;
+    map->tombstone_count = 0;
+    map->resize_count++;
+    COUNTER_INC(DENSE_MAP_REHASH);
+}
+
+/**
+ * Get smallest number of slots that holds given number of items, with load
+ * at most given fraction of load factor of map.
+ * @param map
+ * @param count Number of items.
+ * @param fraction Fraction of load factor.
+ * @return A power of two, at least @c DENSE_MAP_INITIAL_SIZE.
+ * */
+static Size size_for_count(DenseMap* map, Size count, Float32 fraction) {
+    Float32 load = MIN(map->max_load_factor, DENSE_MAP_MAX_LOAD_FACTOR) * fraction;
+
+    Size size = DENSE_MAP_INITIAL_SIZE;
+    while((Float32)count > load * (Float32)size) {
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * Start moving items into a new table of given size. Without incremental
+ * rehashing, all items are moved right away. Otherwise, the current table
+ * is kept as old table and items are moved a few slots at a time by
+ * @c migrate_slots.
+ * @param map
+ * @param size New number of slots, a power of two.
+ * @param udata User data passed to `hash`.
+ * */
+static void begin_rehash(DenseMap* map, Size size, void* udata) {
+    if(!map->rehash_budget) {
+        rehash_dense_map(map, size, udata);
+        return;
+    }
+
+    // a table is migrated only from one other table at a time
+    if(map->old_map) {
+        migrate_slots(map, SIZE_MAX, udata);
+    }
+
+    size = MAX(size, (Size)DENSE_MAP_INITIAL_SIZE);
+
+    Dmi_Vector* dmi_vec = create_slot_vector(map, size);
+    ERR_RETURN_IF_FAIL(dmi_vec,  ERR_INVALID_OBJECT);
+
+    U8_Vector* mdata_vec = u8_vector_create_with_allocator(map->allocator);
+    if(mdata_vec) {
+        u8_vector_resize(mdata_vec, size);
+    }
+    DenseMapHash* hashes = create_hash_array(map, size);
+    if(!mdata_vec || mdata_vec->length != size || !hashes) {
+        destroy_dmi_vector_shallow(dmi_vec);
+        if(mdata_vec) u8_vector_destroy(mdata_vec, NULL);
+        if(hashes) destroy_hash_array(map, hashes, size);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return;
+    }
+
+    map->old_map             = map->map;
+    map->old_metadata        = map->metadata;
+    map->old_hashes          = map->hashes;
+    map->old_tombstone_count = map->tombstone_count;
+    map->migrate_pos         = 0;
+    map->map                 = dmi_vec;
+    map->metadata            = mdata_vec;
+    map->hashes              = hashes;
+    map->tombstone_count     = 0;
+    map->resize_count++;
+    COUNTER_INC(DENSE_MAP_REHASH);
+}
+
+/**
+ * Move items from old table into current table, examining at most given
+ * number of old slots. Slots are examined in order, and a moved slot is
+ * turned into a tombstone so that probe sequences through it stay intact.
+ * Old table is destroyed once every slot has been examined.
+ * @param map
+ * @param budget Number of old slots to examine, rounded up to a whole group.
+ * SIZE_MAX to finish migration.
+ * @param udata Unused, hashes of migrated items are stored in old table.
+ * */
+static void migrate_slots(DenseMap* map, Size budget, void* udata) {
+    UNUSED(udata);
+
+    Uint8* old_mdata    = map->old_metadata->data;
+    Size   old_length   = map->old_map->length;
+    Size   element_size = map->map->element_size;
+    Uint8* mdata        = METADATA(map);
+
+    Size end = old_length;
+    if(budget < old_length - map->migrate_pos) {
+        end = MIN(old_length, (map->migrate_pos + budget + GROUP_SIZE - 1) & ~(Size)(GROUP_SIZE - 1));
+    }
+
+    for(Size s = next_occupied_slot(old_mdata, end, map->migrate_pos); s != SIZE_MAX;
+        s = next_occupied_slot(old_mdata, end, s + 1)) {
+        Uint8* from = (Uint8*)map->old_map->data + s * element_size;
+        Uint64 hash = map->old_hashes[s];
+        Size   slot = find_free_slot(mdata, map->map->length, hash);
+
+        memcpy(SLOT_ADDR(map, slot), from, element_size);
+        if(mdata[slot] == MDATA_DELETED) {
+            map->tombstone_count--;
+        }
+        mdata[slot]       = MDATA_OF(hash);
+        HASHES(map)[slot] = hash;
+        old_mdata[s]      = MDATA_DELETED;
+    }
+
+    map->migrate_pos = end;
+    if(end == old_length) {
+        destroy_old_table(map);
+    }
+}
+
+/**
+ * Exchange current table with old table, so that functions working on
+ * current table can be used on old table.
+ * @param map
+ * */
+static void swap_tables(DenseMap* map) {
+    Dmi_Vector* slots = map->map;
+    map->map          = map->old_map;
+    map->old_map      = slots;
+
+    U8_Vector* mdata  = map->metadata;
+    map->metadata     = map->old_metadata;
+    map->old_metadata = mdata;
+
+    DenseMapHash* hashes = map->hashes;
+    map->hashes          = map->old_hashes;
+    map->old_hashes      = hashes;
+
+    Size tombstones          = map->tombstone_count;
+    map->tombstone_count     = map->old_tombstone_count;
+    map->old_tombstone_count = tombstones;
+}
+
+/**
+ * Call visitor for each item in current table, a metadata group at a time.
+ * @param map
+ * @param visitor Callback called for each item, can be NULL.
+ * @param destroy Whether to destroy each item after visiting it.
+ * @param udata User data passed to @p visitor and copy destructors.
+ * */
+/**
+ * Add probe lengths and tag collisions of every item of a table to given stats.
+ * Probe length of an item is number of groups visited from it's first group
+ * to group holding it, and it's tag collisions are other slots with same
+ * metadata in those groups.
+ * @param mdata Metadata of table.
+ * @param hashes Stored hashes of table.
+ * @param length Number of slots in table.
+ * @param stats
+ * @return Number of items in table.
+ * */
+static Size table_stats(const Uint8* mdata, const DenseMapHash* hashes, Size length, HashMapStats* stats) {
+    Size group_mask = length / GROUP_SIZE - 1;
+    Size count      = 0;
+
+    for(Size s = next_occupied_slot(mdata, length, 0); s != SIZE_MAX; s = next_occupied_slot(mdata, length, s + 1)) {
+        Size target = s / GROUP_SIZE;
+        Size group  = (hashes[s] >> 7) & group_mask;
+        Size step   = 1;
+        for(;; step++) {
+            GroupMask match = group_match(mdata + group * GROUP_SIZE, mdata[s]);
+            stats->tag_collision_rate += (Float64)(__builtin_popcountll(match) - (group == target));
+            if(group == target) {
+                break;
+            }
+            group = (group + step) & group_mask;
+        }
+        hash_map_stats_add_probe(stats, step);
+        count++;
+    }
+
+    return count;
+}
+
+static void visit_table(DenseMap* map, DenseMapVisitorCallback visitor, Bool destroy, void* udata) {
+    const Uint8* mdata = METADATA(map);
+    for(Size group = 0; group < map->map->length; group += GROUP_SIZE) {
+        for(GroupMask occupied = group_match_occupied(mdata + group); occupied; occupied &= occupied - 1) {
+            Size slot = group + GROUP_SLOT(occupied);
+            if(visitor) {
+                visitor((DenseMapItem*)SLOT_ADDR(map, slot), udata);
+            }
+            if(destroy) {
+                destroy_slot_copy(map, slot, udata);
+            }
+        }
+    }
+}
+
+/**
+ * Destroy old table without destroying any copies stored in it.
+ * @param map
+ * */
+static void destroy_old_table(DenseMap* map) {
+    destroy_hash_array(map, map->old_hashes, map->old_map->length);
+    destroy_dmi_vector_shallow(map->old_map);
+    u8_vector_destroy(map->old_metadata, NULL);
+    map->old_map             = NULL;
+    map->old_metadata        = NULL;
+    map->old_hashes          = NULL;
+    map->old_tombstone_count = 0;
+    map->migrate_pos         = 0;
+}
+
+/**
+ * Free memory of given item vector, without destroying items in it.
+ * @param vec
+ * */
+static void destroy_dmi_vector_shallow(Dmi_Vector* vec) {
+    allocator_free(vec->allocator, vec->data, vec->capacity * vec->element_size);
+    vec->data = NULL;
+    allocator_free(vec->allocator, vec, sizeof(Vector));
+}
+
+/**
+ * Create array to store hash of each of given number of slots.
+ * Entries are written when a slot is filled, so array isn't zeroed.
+ * @param map
+ * @param size Number of slots.
+ * @return New array, NULL on failure.
+ * */
+static DenseMapHash* create_hash_array(DenseMap* map, Size size) {
+    return allocator_allocate(map->allocator, size * sizeof(DenseMapHash));
+}
+
+/**
+ * Free array created by @c create_hash_array.
+ * @param map
+ * @param hashes
+ * @param size Number of slots array was created for.
+ * */
+static void destroy_hash_array(DenseMap* map, DenseMapHash* hashes, Size size) {
+    allocator_free(map->allocator, hashes, size * sizeof(DenseMapHash));
+}
+
+/**
+ * Create slot vector with given number of zeroed slots. Slots are
+ * @c DenseMapItem, or @c slot_size bytes for inline maps.
+ * @param map
+ * @param size
+ * @return New vector, NULL on failure.
+ * */
+static Dmi_Vector* create_slot_vector(DenseMap* map, Size size) {
+    Dmi_Vector* vec = IS_INLINE(map) ? (Dmi_Vector*)vector_create_with_allocator(map->slot_size, NULL, NULL, map->allocator)
+                                     : dmi_vector_create_with_allocator(map->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(vec, NULL, ERR_INVALID_OBJECT);
+
+    vector_resize((Vector*)vec, size);
+    if(vec->length != size) {
+        destroy_dmi_vector_shallow(vec);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    return vec;
+}
+
+/**
+ * Load inline value of given size, as it would be passed to a callback.
+ * @param addr Address of value in slot.
+ * @param size Size of value.
+ * @param by_value True when value is passed by value, pointer to it otherwise.
+ * */
+static FORCE_INLINE void* load_inline(Uint8* addr, Size size, Bool by_value) {
+    if(!by_value) {
+        return addr;
+    }
+
+    Uint64 val = 0;
+    memcpy(&val, addr, size);
+    return (void*)val;
+}
+
+/**
+ * Store a value passed by callback convention into slot memory.
+ * @param addr Address of value in slot.
+ * @param val Value, or pointer to value bytes when not @p by_value.
+ * @param size Size of value.
+ * @param by_value True when @p val is the value itself.
+ * */
+static FORCE_INLINE void store_inline(Uint8* addr, void* val, Size size, Bool by_value) {
+    if(by_value) {
+        Uint64 v = (Uint64)val;
+        memcpy(addr, &v, size);
+    } else if(val) {
+        memcpy(addr, val, size);
+    } else {
+        memset(addr, 0, size);
+    }
+}
+
+/* whether inline key or data is passed to callbacks by value, copies of small ones are values too */
+#define KEY_BY_VALUE(map) ((map)->key_size <= 8)
+#define DATA_BY_VALUE(map) ((map)->data_size <= 8)
+
+/**
+ * Get key of occupied slot, in form passed to `hash` and `compare_key`.
+ * @param map
+ * @param slot
+ * */
+static void* slot_key(DenseMap* map, Size slot) {
+    return key_at(map, SLOT_ADDR(map, slot));
+}
+
+/**
+ * Get key stored in slot at given address, in same form as @c slot_key.
+ * @param map
+ * @param addr Address of slot.
+ * */
+static void* key_at(DenseMap* map, Uint8* addr) {
+    if(!IS_INLINE(map)) {
+        return ((DenseMapItem*)addr)->key;
+    }
+    return load_inline(addr, map->key_size, KEY_BY_VALUE(map));
+}
+
+/**
+ * Get data of occupied slot, in same form as passed to @c dense_map_insert.
+ * @param map
+ * @param slot
+ * */
+static void* slot_data(DenseMap* map, Size slot) {
+    if(!IS_INLINE(map)) {
+        return SLOT_ITEM(map, slot)->data;
+    }
+    return load_inline(SLOT_ADDR(map, slot) + map->data_offset, map->data_size, DATA_BY_VALUE(map));
+}
+
+/**
+ * Create copy of key and data in given slot.
+ * @param map
+ * @param slot
+ * @param key
+ * @param data
+ * @param udata User data passed to copy constructors.
+ * */
+static void create_slot_copy(DenseMap* map, Size slot, void* key, void* data, void* udata) {
+    if(!IS_INLINE(map)) {
+        Dmi_CallbackData clbk_data = { .udata = udata, .map = map };
+        DenseMapItem     tmp_dmi   = { .key = key, .data = data };
+        create_dmi_copy(SLOT_ITEM(map, slot), &tmp_dmi, &clbk_data);
+        return;
+    }
+
+    Uint8* addr = SLOT_ADDR(map, slot);
+    if(map->create_key_copy) {
+        memset(addr, 0, map->key_size);
+        map->create_key_copy(addr, key, udata);
+    } else {
+        store_inline(addr, key, map->key_size, KEY_BY_VALUE(map));
+    }
+
+    addr += map->data_offset;
+    if(map->create_data_copy) {
+        memset(addr, 0, map->data_size);
+        map->create_data_copy(addr, data, udata);
+    } else {
+        store_inline(addr, data, map->data_size, DATA_BY_VALUE(map));
+    }
+}
+
+/**
+ * Destroy copy of key and data in given slot.
+ * @param map
+ * @param slot
+ * @param udata User data passed to copy destructors.
+ * */
+static void destroy_slot_copy(DenseMap* map, Size slot, void* udata) {
+    if(!IS_INLINE(map)) {
+        Dmi_CallbackData clbk_data = { .udata = udata, .map = map };
+        destroy_dmi_copy(SLOT_ITEM(map, slot), &clbk_data);
+        return;
+    }
+
+    Uint8* addr = SLOT_ADDR(map, slot);
+    if(map->destroy_key_copy) {
+        map->destroy_key_copy(addr, udata);
+    }
+    if(map->destroy_data_copy) {
+        map->destroy_data_copy(addr + map->data_offset, udata);
+    }
 }
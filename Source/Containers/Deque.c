@@ -0,0 +1,352 @@
+/**
+ * @file Deque.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of ring buffer backed double ended queue.
+ * */
+
+#include <Anvie/Containers/Deque.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/**
+ * Initial number of elements ring buffer can hold.
+ * Must be a power of two.
+ * */
+#define DEQUE_INIT_ELEMENT_COUNT 4
+
+/**
+ * Create a new deque.
+ * If any one of @c create_copy or @c destroy_copy is non null,
+ * then both must be non null!
+ *
+ * @param element_size Size of each element in deque.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @return Deque* or NULL if allocation failed
+ * */
+Deque* deque_create(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy) {
+    return deque_create_with_allocator(element_size, create_copy, destroy_copy, NULL);
+}
+
+/**
+ * Create a new deque that allocates all of it's memory from given allocator.
+ * If any one of @c create_copy or @c destroy_copy is non null,
+ * then both must be non null!
+ *
+ * @param element_size Size of each element in deque.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return Deque* or NULL if allocation failed
+ * */
+Deque* deque_create_with_allocator(Size element_size,
+                                   CreateElementCopyCallback create_copy,
+                                   DestroyElementCopyCallback destroy_copy,
+                                   Allocator* allocator)
+{
+    ERR_RETURN_VALUE_IF_FAIL(element_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    // both must be null or non null at the same time
+    Bool b1 = create_copy != NULL;
+    Bool b2 = destroy_copy != NULL;
+    ERR_RETURN_VALUE_IF_FAIL(!(b1 ^ b2), NULL, ERR_INVALID_ARGUMENTS);
+
+    Deque* dq = allocator_allocate_zeroed(allocator, sizeof(Deque));
+    ERR_RETURN_VALUE_IF_FAIL(dq, NULL, ERR_OUT_OF_MEMORY);
+
+    dq->data = allocator_allocate_zeroed(allocator, DEQUE_INIT_ELEMENT_COUNT * element_size);
+    if(!dq->data) {
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        allocator_free(allocator, dq, sizeof(Deque));
+        return NULL;
+    }
+
+    dq->capacity     = DEQUE_INIT_ELEMENT_COUNT;
+    dq->element_size = element_size;
+    dq->create_copy  = create_copy;
+    dq->destroy_copy = destroy_copy;
+    dq->allocator    = allocator;
+    return dq;
+}
+
+/**
+ * Destroy given deque.
+ * If deque's allocator releases memory in bulk, then nothing
+ * is destroyed or freed here.
+ * @param dq Deque to be destroyed
+ * @param udata User data to be passed to callback functions.
+ * */
+void deque_destroy(Deque* dq, void* udata) {
+    ERR_RETURN_IF_FAIL(dq, ERR_INVALID_ARGUMENTS);
+
+    // all memory will be released by allocator at once
+    if(!allocator_needs_free(dq->allocator)) {
+        return;
+    }
+
+    deque_clear(dq, udata);
+
+    if(dq->data) {
+        allocator_free(dq->allocator, dq->data, dq->capacity * dq->element_size);
+        dq->data = NULL;
+    }
+
+    allocator_free(dq->allocator, dq, sizeof(Deque));
+}
+
+/**
+ * Reallocate ring buffer to hold given number of elements.
+ * Elements that wrapped around end of old buffer are moved
+ * right after it, so order is preserved without changing head.
+ * @param dq
+ * @param new_capacity Must be a power of two, not less than current capacity.
+ * @return True on success, False otherwise.
+ * */
+static Bool deque_grow(Deque* dq, Size new_capacity) {
+    Size esz     = dq->element_size;
+    Size old_cap = dq->capacity;
+
+    UByteArray temp = allocator_reallocate(dq->allocator, dq->data, old_cap * esz, new_capacity * esz);
+    ERR_RETURN_VALUE_IF_FAIL(temp, False, ERR_OUT_OF_MEMORY);
+
+    // number of elements that wrapped around to start of old buffer
+    Size wrapped = dq->head + dq->length > old_cap ? dq->head + dq->length - old_cap : 0;
+    if(wrapped) {
+        memcpy(temp + old_cap * esz, temp, wrapped * esz);
+    }
+
+    // keep unused slots zeroed
+    Size used_end = old_cap + wrapped;
+    memset(temp + used_end * esz, 0, (new_capacity - used_end) * esz);
+    memset(temp, 0, wrapped * esz);
+
+    dq->data     = temp;
+    dq->capacity = new_capacity;
+    return True;
+}
+
+/**
+ * Reserve space for given number of elements. Capacity is rounded
+ * up to next power of two. This does not change length of deque.
+ * @param dq
+ * @param capacity
+ * */
+void deque_reserve(Deque* dq, Size capacity) {
+    ERR_RETURN_IF_FAIL(dq && capacity, ERR_INVALID_ARGUMENTS);
+    if(capacity <= dq->capacity) return;
+
+    Size new_capacity = dq->capacity;
+    while(new_capacity < capacity) {
+        new_capacity <<= 1;
+    }
+
+    deque_grow(dq, new_capacity);
+}
+
+/**
+ * Clear deque.
+ * Destroy each element if copy destructor is provided,
+ * otherwise, just length is set to 0 in order to save time.
+ * @param dq
+ * @param udata User data to be passed to callback functions.
+ * */
+void deque_clear(Deque* dq, void* udata) {
+    ERR_RETURN_IF_FAIL(dq, ERR_INVALID_ARGUMENTS);
+
+    if(dq->destroy_copy) {
+        for(Size s = 0; s < dq->length; s++) {
+            dq->destroy_copy(deque_address_at(dq, s), udata);
+        }
+    }
+
+    dq->length = 0;
+    dq->head   = 0;
+}
+
+/**
+ * Store a copy of data in given element slot.
+ * Follows insertion semantics of @c Vector.
+ * */
+static FORCE_INLINE void deque_store(Deque* dq, UByteArray elem, void* data, void* udata) {
+    if(dq->create_copy) {
+        if(data) dq->create_copy(elem, data, udata);
+        else memset(elem, 0, dq->element_size);
+        return;
+    }
+
+    Uint64 value = (Uint64)data;
+    switch(dq->element_size) {
+        case 8 : *(Uint64*)elem = (Uint64)value; break;
+        case 4 : *(Uint32*)elem = (Uint32)value; break;
+        case 2 : *(Uint16*)elem = (Uint16)value; break;
+        case 1 : *(Uint8*)elem  = (Uint8) value; break;
+        default: {
+            if(data) memcpy(elem, data, dq->element_size);
+            else memset(elem, 0, dq->element_size);
+        }
+    }
+}
+
+/**
+ * Take element out of given slot without creating a copy.
+ * Integer sized elements are returned by value, others are returned
+ * in a newly allocated memory that must be freed by caller using @c FREE.
+ * */
+static FORCE_INLINE void* deque_take(Deque* dq, UByteArray elem) {
+    void* data = NULL;
+    switch(dq->element_size) {
+        case 8 : data = (void*)(Uint64)*(Uint64*)elem; break;
+        case 4 : data = (void*)(Uint64)*(Uint32*)elem; break;
+        case 2 : data = (void*)(Uint64)*(Uint16*)elem; break;
+        case 1 : data = (void*)(Uint64)*(Uint8*)elem;  break;
+        default: {
+            data = ALLOCATE(Uint8, dq->element_size);
+            ERR_RETURN_VALUE_IF_FAIL(data, NULL, ERR_OUT_OF_MEMORY);
+            memcpy(data, elem, dq->element_size);
+        }
+    }
+
+    // memset to avoid data copies
+    memset(elem, 0, dq->element_size);
+    return data;
+}
+
+/**
+ * Insert element at back of deque in constant time.
+ * @param dq
+ * @param data Value or pointer to element to be inserted, same as @c vector_push_back.
+ * @param udata User data to be passed to callback functions.
+ * */
+void deque_push_back(Deque* dq, void* data, void* udata) {
+    ERR_RETURN_IF_FAIL(dq, ERR_INVALID_ARGUMENTS);
+
+    if(dq->length == dq->capacity && !deque_grow(dq, dq->capacity << 1)) {
+        return;
+    }
+
+    deque_store(dq, deque_address_at(dq, dq->length), data, udata);
+    dq->length++;
+}
+
+/**
+ * Insert element at front of deque in constant time.
+ * @param dq
+ * @param data Value or pointer to element to be inserted, same as @c vector_push_front.
+ * @param udata User data to be passed to callback functions.
+ * */
+void deque_push_front(Deque* dq, void* data, void* udata) {
+    ERR_RETURN_IF_FAIL(dq, ERR_INVALID_ARGUMENTS);
+
+    if(dq->length == dq->capacity && !deque_grow(dq, dq->capacity << 1)) {
+        return;
+    }
+
+    dq->head = (dq->head - 1) & (dq->capacity - 1);
+    deque_store(dq, dq->data + dq->head * dq->element_size, data, udata);
+    dq->length++;
+}
+
+/**
+ * Remove element from back of deque in constant time.
+ * Ownership of removed element is transferred to caller, no copy is destroyed.
+ * @param dq
+ * @return Value of element if element size is 1, 2, 4 or 8, otherwise
+ * an allocated copy of element that must be freed by caller.
+ * */
+void* deque_pop_back(Deque* dq) {
+    ERR_RETURN_VALUE_IF_FAIL(dq, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(dq->length, NULL, ERR_CONTAINER_UNDERFLOW);
+
+    void* data = deque_take(dq, deque_address_at(dq, dq->length - 1));
+    dq->length--;
+    return data;
+}
+
+/**
+ * Remove element from front of deque in constant time.
+ * Ownership of removed element is transferred to caller, no copy is destroyed.
+ * @param dq
+ * @return Value of element if element size is 1, 2, 4 or 8, otherwise
+ * an allocated copy of element that must be freed by caller.
+ * */
+void* deque_pop_front(Deque* dq) {
+    ERR_RETURN_VALUE_IF_FAIL(dq, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(dq->length, NULL, ERR_CONTAINER_UNDERFLOW);
+
+    void* data = deque_take(dq, dq->data + dq->head * dq->element_size);
+    dq->head = (dq->head + 1) & (dq->capacity - 1);
+    dq->length--;
+    return data;
+}
+
+/**
+ * Get mutable reference to element in deque if the size of
+ * element is not 1, 2, 4, or 8.
+ * Get value stored in deque at given position if the size
+ * of each element in deque is either 1, 2, 4 or 8.
+ * @param dq
+ * @param pos Position counted from front of deque.
+ * @return Mutable reference or direct value stored at given position.
+ * */
+void* deque_peek(Deque* dq, Size pos) {
+    ERR_RETURN_VALUE_IF_FAIL(dq, NULL, ERR_INVALID_ARGUMENTS);
+    if(pos >= dq->length) return NULL;
+
+    UByteArray elem = deque_address_at(dq, pos);
+    switch(dq->element_size) {
+        case 8: return (void*)*(Uint64*)elem;
+        case 4: return (void*)(Uint64)*(Uint32*)elem;
+        case 2: return (void*)(Uint64)*(Uint16*)elem;
+        case 1: return (void*)(Uint64)*(Uint8*)elem;
+        default: return elem;
+    }
+}
+
+/**
+ * Get element at front of deque, same as @c deque_peek at 0.
+ * @param dq
+ * */
+void* deque_front(Deque* dq) {
+    ERR_RETURN_VALUE_IF_FAIL(dq, NULL, ERR_INVALID_ARGUMENTS);
+    return deque_peek(dq, 0);
+}
+
+/**
+ * Get element at back of deque, same as @c deque_peek at length - 1.
+ * @param dq
+ * */
+void* deque_back(Deque* dq) {
+    ERR_RETURN_VALUE_IF_FAIL(dq, NULL, ERR_INVALID_ARGUMENTS);
+    return dq->length ? deque_peek(dq, dq->length - 1) : NULL;
+}
+
+/**
+ * Visit each element of deque from front to back using given printer.
+ * @param dq
+ * @param printer Called with element (as returned by @c deque_peek) and it's position.
+ * @param udata User data to be passed to callback functions.
+ * */
+void deque_print(Deque* dq, PrintElementCallback printer, void* udata) {
+    ERR_RETURN_IF_FAIL(dq && printer, ERR_INVALID_ARGUMENTS);
+
+    for(Size s = 0; s < dq->length; s++) {
+        printer(deque_peek(dq, s), s, udata);
+    }
+}
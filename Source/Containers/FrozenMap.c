@@ -0,0 +1,435 @@
+/**
+ * @file FrozenMap.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Building, searching and serializing of frozen maps.
+ * */
+
+#include <Anvie/Containers/FrozenMap.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* average number of keys per bucket, larger means fewer pilots but slower build */
+#define FROZEN_MAP_BUCKET_LOAD 4
+
+/* number of seeds tried before giving up on building a frozen map */
+#define FROZEN_MAP_MAX_SEEDS 16
+
+/* keys below this hash go to dense buckets, 60 percent of keys in 30 percent of buckets */
+#define FROZEN_MAP_DENSE_THRESHOLD ((Uint64)(0.6 * 18446744073709551616.0))
+
+/* bytes used by pilots in image, padded so that slots start 8 byte aligned */
+#define PILOTS_SIZE(bucket_count) (((bucket_count) * sizeof(Uint32) + 7) & ~(Size)7)
+
+/* finalizer of splitmix64 */
+static FORCE_INLINE Uint64 mix(Uint64 x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/* map x uniformly to [0, n) using high bits of product, no division needed */
+static FORCE_INLINE Uint64 reduce(Uint64 x, Uint64 n) {
+    return (Uint64)(((unsigned __int128)x * n) >> 64);
+}
+
+/* bucket of a key with given seeded hash */
+static FORCE_INLINE Size bucket_of(const FrozenMapHeader* header, Uint64 h) {
+    Uint64 r = h * 0x9e3779b97f4a7c15ull;
+    if(h < FROZEN_MAP_DENSE_THRESHOLD) {
+        return reduce(r, header->dense_bucket_count);
+    }
+    return header->dense_bucket_count + reduce(r, header->bucket_count - header->dense_bucket_count);
+}
+
+/* slot of a key with given seeded hash, when it's bucket has given pilot.
+ * Pilot is mixed together with hash, since reduce only looks at high bits and
+ * two keys with same high bits would otherwise collide for every pilot. */
+static FORCE_INLINE Size position_of(const FrozenMapHeader* header, Uint64 h, Uint32 pilot) {
+    return reduce(mix(h ^ (0xd6e8feb86659fd93ull * (pilot + 1))), header->item_count);
+}
+
+/* key as passed to callbacks, from key bytes */
+static FORCE_INLINE void* key_form(Size key_size, const Uint8* key) {
+    if(key_size > sizeof(void*)) {
+        return (void*)key;
+    }
+
+    Uint64 value = 0;
+    memcpy(&value, key, key_size);
+    return (void*)value;
+}
+
+/* bytes of key of item of a dense map */
+static FORCE_INLINE const Uint8* item_key_bytes(DenseMap* map, DenseMapItem* item) {
+    if(map->slot_size) {
+        return dense_map_slot_key(map, item);
+    }
+    return map->key_size > sizeof(void*) ? item->key : (Uint8*)&item->key;
+}
+
+/* bytes of data of item of a dense map */
+static FORCE_INLINE const Uint8* item_data_bytes(DenseMap* map, DenseMapItem* item) {
+    if(map->slot_size) {
+        return dense_map_slot_data(map, item);
+    }
+    return map->data_size > sizeof(void*) ? item->data : (Uint8*)&item->data;
+}
+
+/* wrap an image into a map object */
+static FrozenMap* create_frozen_map(const void* image, HashCallback hash, CompareElementCallback compare_key, Bool owns_image, Allocator* allocator) {
+    FrozenMap* map = allocator_allocate_zeroed(allocator, sizeof(FrozenMap));
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_OUT_OF_MEMORY);
+
+    map->header      = image;
+    map->pilots      = (const Uint32*)((const Uint8*)image + sizeof(FrozenMapHeader));
+    map->slots       = (const Uint8*)map->pilots + PILOTS_SIZE(map->header->bucket_count);
+    map->hash        = hash;
+    map->compare_key = compare_key;
+    map->owns_image  = owns_image;
+    map->allocator   = allocator;
+
+    return map;
+}
+
+/**
+ * Try to find a pilot for every bucket with given seed.
+ * Buckets are tried from largest to smallest, since large buckets are
+ * hardest to place and easy to place while table is still mostly empty.
+ *
+ * @param header Header of image being built, with seed set.
+ * @param h Seeded hash of each key.
+ * @param pilots Pilot of each bucket is stored here.
+ * @param place Slot of each key is stored here.
+ * @param scratch At least `2 * item_count + 2 * bucket_count + 3` Size values.
+ * @param taken Bit per slot, all zero on entry.
+ * @return True when every bucket got a pilot, False otherwise.
+ * */
+static Bool find_pilots(const FrozenMapHeader* header, const Uint64* h, Uint32* pilots, Size* place, Size* scratch, Uint8* taken) {
+    Size n       = header->item_count;
+    Size buckets = header->bucket_count;
+
+    Size* start  = scratch;               /* first key of each bucket in order, buckets + 1 values */
+    Size* order  = start + buckets + 1;   /* keys grouped by bucket, n values */
+    Size* sorted = order + n;             /* buckets from largest to smallest, buckets values */
+    Size* bucket = sorted + buckets;      /* bucket of each key, n + 2 values */
+
+    /* group keys by bucket with a counting sort */
+    memset(start, 0, (buckets + 1) * sizeof(Size));
+    Size max_size = 0;
+    for(Size i = 0; i < n; i++) {
+        bucket[i] = bucket_of(header, h[i]);
+        start[bucket[i] + 1]++;
+        max_size = MAX(max_size, start[bucket[i] + 1]);
+    }
+    for(Size b = 0; b < buckets; b++) {
+        start[b + 1] += start[b];
+    }
+    for(Size i = 0; i < n; i++) {
+        order[start[bucket[i]]++] = i;
+    }
+    for(Size b = buckets; b; b--) {
+        start[b] = start[b - 1];
+    }
+    start[0] = 0;
+
+    /* sort buckets by size, largest first, reusing bucket array as count of each size */
+    Size* size_start = bucket;
+    memset(size_start, 0, (max_size + 2) * sizeof(Size));
+    for(Size b = 0; b < buckets; b++) {
+        size_start[max_size - (start[b + 1] - start[b]) + 1]++;
+    }
+    for(Size s = 0; s <= max_size; s++) {
+        size_start[s + 1] += size_start[s];
+    }
+    for(Size b = 0; b < buckets; b++) {
+        sorted[size_start[max_size - (start[b + 1] - start[b])]++] = b;
+    }
+
+    /* expected tries for last key is n, so this only fails for colliding hashes */
+    Uint64 max_pilot = MIN(MAX((Uint64)n * 16, (Uint64)1 << 20), (Uint64)UINT32_MAX);
+
+    memset(pilots, 0, buckets * sizeof(Uint32));
+    for(Size s = 0; s < buckets; s++) {
+        Size b     = sorted[s];
+        Size first = start[b];
+        Size last  = start[b + 1];
+        if(first == last) {
+            break;
+        }
+
+        Uint64 pilot = 0;
+        for(; pilot < max_pilot; pilot++) {
+            Size k = first;
+            for(; k < last; k++) {
+                Size pos = position_of(header, h[order[k]], (Uint32)pilot);
+                if(taken[pos >> 3] & (1 << (pos & 7))) {
+                    break;
+                }
+                taken[pos >> 3] |= 1 << (pos & 7);
+                place[order[k]]  = pos;
+            }
+            if(k == last) {
+                break;
+            }
+
+            /* undo slots taken by keys of this bucket placed before conflict */
+            while(k-- > first) {
+                Size pos = place[order[k]];
+                taken[pos >> 3] &= ~(1 << (pos & 7));
+            }
+        }
+
+        if(pilot == max_pilot) {
+            return False;
+        }
+        pilots[b] = (Uint32)pilot;
+    }
+
+    return True;
+}
+
+/**
+ * Build an immutable map with same items as given map. Search cost of
+ * returned map is one probe and one key comparision, with no empty slots.
+ *
+ * Given map is not modified and can be destroyed right after. Keys and data
+ * must be plain-old-data, so map must not have copy callbacks, and keys
+ * must be unique. Build takes linear time on average.
+ *
+ * @param map
+ * @param udata User data passed to @c hash and @c compare_key of map.
+ * @return FrozenMap on success, NULL otherwise. Fails also when two distinct
+ * keys have same hash, since no perfect hash can separate them then.
+ * */
+FrozenMap* dense_map_freeze(DenseMap* map, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!map->create_key_copy && !map->create_data_copy && !map->is_multimap, NULL, ERR_INVALID_ARGUMENTS);
+
+    FrozenMapHeader header = {0};
+    header.magic              = FROZEN_MAP_MAGIC;
+    header.version            = FROZEN_MAP_VERSION;
+    header.item_count         = map->item_count;
+    header.bucket_count       = map->item_count / FROZEN_MAP_BUCKET_LOAD + 2;
+    header.dense_bucket_count = MAX(header.bucket_count * 3 / 10, (Uint64)1);
+    header.key_size           = map->key_size;
+    header.data_size          = map->data_size;
+
+    if(map->slot_size) {
+        header.data_offset = map->data_offset;
+        header.slot_size   = map->slot_size;
+    } else {
+        // same layout as dense_map_create_inline
+        Size key_align     = MIN(map->key_size & (~map->key_size + 1), (Size)16);
+        Size data_align    = MIN(map->data_size & (~map->data_size + 1), (Size)16);
+        Size slot_align    = MAX(key_align, data_align);
+        header.data_offset = (map->key_size + data_align - 1) & ~(data_align - 1);
+        header.slot_size   = (header.data_offset + map->data_size + slot_align - 1) & ~(slot_align - 1);
+    }
+    header.image_size = sizeof(FrozenMapHeader) + PILOTS_SIZE(header.bucket_count) + header.item_count * header.slot_size;
+
+    Size n       = header.item_count;
+    Size buckets = header.bucket_count;
+
+    /* scratch : items, user hash and seeded hash of each key, slot of each key, sorting space and taken bits */
+    Size scratch_size = n * (sizeof(DenseMapItem*) + 3 * sizeof(Uint64) + sizeof(Size))
+                        + (2 * n + 2 * buckets + 3) * sizeof(Size) + (n + 7) / 8;
+    Uint8* scratch = allocator_allocate(map->allocator, scratch_size);
+    ERR_RETURN_VALUE_IF_FAIL(scratch, NULL, ERR_OUT_OF_MEMORY);
+
+    Uint8* image = allocator_allocate_zeroed(map->allocator, header.image_size);
+    if(!image) {
+        allocator_free(map->allocator, scratch, scratch_size);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    DenseMapItem** items = (DenseMapItem**)scratch;
+    Uint64*        uh    = (Uint64*)(items + n);
+    Uint64*        h     = uh + n;
+    Size*          place = (Size*)(h + n);
+    Size*          sort  = place + n;
+    Uint8*         taken = (Uint8*)(sort + 2 * n + 2 * buckets + 3);
+
+    DenseMapIterator iter = {0};
+    DenseMapItem*    item = NULL;
+    Size             i    = 0;
+    while((item = dense_map_iter_next(map, &iter))) {
+        items[i] = item;
+        uh[i++]  = map->hash(key_form(map->key_size, item_key_bytes(map, item)), udata);
+    }
+
+    FrozenMapHeader* out    = (FrozenMapHeader*)image;
+    Uint32*          pilots = (Uint32*)(image + sizeof(FrozenMapHeader));
+    Bool             found  = False;
+    for(Uint64 attempt = 0; attempt < FROZEN_MAP_MAX_SEEDS && !found; attempt++) {
+        header.seed = mix(attempt + 0x9e3779b97f4a7c15ull);
+        for(Size k = 0; k < n; k++) {
+            h[k] = mix(uh[k] ^ header.seed);
+        }
+
+        memset(taken, 0, (n + 7) / 8);
+        found = find_pilots(&header, h, pilots, place, sort, taken);
+    }
+
+    if(!found) {
+        allocator_free(map->allocator, image, header.image_size);
+        allocator_free(map->allocator, scratch, scratch_size);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
+        return NULL;
+    }
+
+    /* copy header, then each key and data to it's slot */
+    *out = header;
+    Uint8* slots = (Uint8*)pilots + PILOTS_SIZE(buckets);
+    for(Size k = 0; k < n; k++) {
+        Uint8* slot = slots + place[k] * header.slot_size;
+        memcpy(slot, item_key_bytes(map, items[k]), header.key_size);
+        memcpy(slot + header.data_offset, item_data_bytes(map, items[k]), header.data_size);
+    }
+
+    allocator_free(map->allocator, scratch, scratch_size);
+
+    FrozenMap* frozen = create_frozen_map(image, map->hash, map->compare_key, True, map->allocator);
+    if(!frozen) {
+        allocator_free(map->allocator, image, header.image_size);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        return NULL;
+    }
+
+    return frozen;
+}
+
+/**
+ * Use a frozen map image in place, eg: one written by @c frozen_map_serialize
+ * and mapped back into memory. Image is not copied, so it must stay valid
+ * and unchanged until returned map is destroyed.
+ *
+ * @param image Start of image, must be 8 byte aligned.
+ * @param size Number of bytes readable at @p image.
+ * @param hash Hash function, must give same values as when image was built.
+ * @param compare_key Key comparision function.
+ * @param allocator Allocator for returned map object. NULL means system allocator.
+ * @return FrozenMap on success, NULL when image is invalid or truncated.
+ * */
+FrozenMap* frozen_map_open(const void* image, Size size, HashCallback hash, CompareElementCallback compare_key, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(image && hash && compare_key, NULL, ERR_INVALID_ARGUMENTS);
+
+    /* image may come from anywhere, so it's checked even in unchecked builds */
+    ERR_RETURN_VALUE_IF_FAIL(!((Size)image & 7) && size >= sizeof(FrozenMapHeader), NULL, ERR_INVALID_CONTENTS);
+
+    const FrozenMapHeader* header = image;
+    ERR_RETURN_VALUE_IF_FAIL(header->magic == FROZEN_MAP_MAGIC && header->version == FROZEN_MAP_VERSION, NULL, ERR_INVALID_OBJECT);
+    ERR_RETURN_VALUE_IF_FAIL(header->image_size <= size, NULL, ERR_INVALID_OBJECT);
+
+    /* check that layout described by header is consistent with it's size */
+    ERR_RETURN_VALUE_IF_FAIL(header->bucket_count >= 2 && header->dense_bucket_count
+                             && header->dense_bucket_count < header->bucket_count
+                             && header->bucket_count <= size / sizeof(Uint32), NULL, ERR_INVALID_OBJECT);
+    ERR_RETURN_VALUE_IF_FAIL(header->data_offset >= header->key_size && header->slot_size >= header->data_offset
+                             && header->slot_size - header->data_offset >= header->data_size, NULL, ERR_INVALID_OBJECT);
+    ERR_RETURN_VALUE_IF_FAIL(!header->item_count || header->slot_size <= size / header->item_count, NULL, ERR_INVALID_OBJECT);
+    ERR_RETURN_VALUE_IF_FAIL(header->image_size == sizeof(FrozenMapHeader) + PILOTS_SIZE(header->bucket_count)
+                             + header->item_count * header->slot_size, NULL, ERR_INVALID_OBJECT);
+
+    return create_frozen_map(image, hash, compare_key, False, allocator);
+}
+
+/**
+ * Destroy given frozen map. Image is freed too when map built it.
+ * @param map
+ * */
+void frozen_map_destroy(FrozenMap* map) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->owns_image) {
+        allocator_free(map->allocator, (void*)map->header, map->header->image_size);
+    }
+    allocator_free(map->allocator, map, sizeof(FrozenMap));
+}
+
+/**
+ * Search for given key.
+ * @param map
+ * @param key Key to search for, passed as to @c compare_key.
+ * @param udata User data passed to @c hash and @c compare_key.
+ * @return Pointer to data of key in image, NULL when key is absent.
+ * */
+void* frozen_map_search(FrozenMap* map, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
+    return frozen_map_search_with_hash(map, key, map->hash(key, udata), udata);
+}
+
+/**
+ * Search for given key, using it's already computed hash.
+ * @param map
+ * @param key Key to search for, passed as to @c compare_key.
+ * @param hash Value @c hash of map returns for @p key.
+ * @param udata User data passed to @c compare_key.
+ * @return Pointer to data of key in image, NULL when key is absent.
+ * */
+void* frozen_map_search_with_hash(FrozenMap* map, void* key, Size hash, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
+
+    const FrozenMapHeader* header = map->header;
+    if(!header->item_count) {
+        return NULL;
+    }
+
+    Uint64       h    = mix(hash ^ header->seed);
+    Size         pos  = position_of(header, h, map->pilots[bucket_of(header, h)]);
+    const Uint8* slot = map->slots + pos * header->slot_size;
+
+    if(map->compare_key(key_form(header->key_size, slot), key, udata) != 0) {
+        return NULL;
+    }
+    return (void*)(slot + header->data_offset);
+}
+
+/**
+ * Get number of bytes @c frozen_map_serialize writes.
+ * @param map
+ * @return Size of image of map.
+ * */
+Size frozen_map_serialized_size(FrozenMap* map) {
+    ERR_RETURN_VALUE_IF_FAIL(map, 0, ERR_INVALID_ARGUMENTS);
+    return map->header->image_size;
+}
+
+/**
+ * Write image of map to given buffer, to be used later with @c frozen_map_open.
+ * @param map
+ * @param buffer Where image is written.
+ * @param size Size of @p buffer in bytes.
+ * @return Number of bytes written, 0 when @p buffer is too small.
+ * */
+Size frozen_map_serialize(FrozenMap* map, void* buffer, Size size) {
+    ERR_RETURN_VALUE_IF_FAIL(map && buffer, 0, ERR_INVALID_ARGUMENTS);
+
+    Size image_size = map->header->image_size;
+    if(size < image_size) {
+        return 0;
+    }
+
+    memcpy(buffer, map->header, image_size);
+    return image_size;
+}
@@ -0,0 +1,680 @@
+/**
+ * @file GroupBy.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Implementation of hash group by of @c Anvie/Containers/GroupBy.h.
+ *
+ * Groups are found in an open addressing table with linear probing, whose
+ * slots hold a key and index of it's group in aggregate columns. Keys are
+ * hashed a batch at a time, and slot of each row is prefetched a few rows
+ * ahead of it being probed.
+ *
+ * A single table is used until it holds more groups than fit in cache.
+ * Rest of input is then partitioned by top bits of hash of keys, into
+ * partitions whose tables fit in cache, and groups found so far are moved
+ * into partition of their key. Partitions have no keys in common, so their
+ * groups are just concatenated at end. Parallel variant partitions whole
+ * input, and partitions both rows and aggregation work among tasks.
+ * */
+
+#include <Anvie/Containers/GroupBy.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+#include <string.h>
+
+/* number of rows hashed together, and how many rows ahead a slot is prefetched */
+#define GROUP_BY_BATCH          256
+#define GROUP_BY_PREFETCH_DIST  16
+
+/* most groups kept in a single table, slots and aggregates of these take about 1 MB */
+#define GROUP_BY_CACHE_GROUPS   (1 << 14)
+
+/* rows aimed for in each partition, and most partitions made in a single pass */
+#define GROUP_BY_PARTITION_ROWS (1 << 14)
+#define GROUP_BY_PARTITION_BITS 8
+
+/* parallel variant aggregates smaller inputs on calling thread */
+#define GROUP_BY_PARALLEL_MIN_ROWS (1 << 16)
+
+/* row ranges partitioned in parallel, for each thread */
+#define GROUP_BY_CHUNKS_PER_THREAD 4
+
+#define GROUP_BY_EMPTY (~(Uint64)0)
+
+typedef struct GroupBySlot {
+    Uint64 key;
+    Uint64 group; /**< index of group in aggregate columns, GROUP_BY_EMPTY for free slots */
+} GroupBySlot;
+
+typedef struct GroupByTable {
+    GroupBySlot*  slots;
+    Size          mask;   /**< number of slots - 1, slots are a power of two */
+    Uint64        seed;
+    GroupByResult groups; /**< aggregates of groups in table */
+} GroupByTable;
+
+/**
+ * State shared by steps of partitioned aggregation. Rows are split into
+ * chunks, and each chunk is partitioned independently, into it's own range
+ * of each partition, so that rows of a partition stay in input order.
+ * */
+typedef struct GroupByPartitions {
+    const Uint64*  keys;
+    const Float64* values;
+    Size           length;     /**< number of rows to partition */
+    Uint64         seed;
+    Uint32         shift;      /**< partition of a hash is hash >> shift */
+    Size           count;      /**< number of partitions, a power of two */
+    Size           chunks;     /**< number of chunks rows are split into */
+    Size           chunk_size; /**< rows in each chunk, except last one */
+    Uint8*         ids;        /**< partition of each row */
+    Size*          offsets;    /**< for chunk c, next position of partition p is at c * count + p */
+    Size*          starts;     /**< count + 1 starting positions of partitions */
+    Uint64*        part_keys;  /**< partitioned rows */
+    Float64*       part_values;
+
+    const GroupByResult* spilled;        /**< groups aggregated before partitioning, or NULL */
+    Size*                spilled_order;  /**< spilled groups, in order of partition */
+    Size*                spilled_starts; /**< count + 1 starting positions in spilled_order */
+
+    GroupByTable* tables;      /**< table of each partition */
+    ThreadPool*   pool;
+    Bool          parallel;
+    Bool          failed;      /**< set by any step that runs out of memory */
+} GroupByPartitions;
+
+/* splitmix64 finalizer of seeded key, top bits pick a partition and low bits a slot */
+static FORCE_INLINE Uint64 group_by_hash(Uint64 key, Uint64 seed) {
+    key += seed;
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+/**
+ * Create empty aggregate columns with space for given number of groups.
+ * */
+static Bool group_by_result_init(GroupByResult* result, Size capacity) {
+    result->keys   = u64_vector_create();
+    result->sums   = f64_vector_create();
+    result->counts = u64_vector_create();
+    result->mins   = f64_vector_create();
+    result->maxs   = f64_vector_create();
+
+    if(!result->keys || !result->sums || !result->counts || !result->mins || !result->maxs) {
+        group_by_result_destroy(result);
+        return False;
+    }
+
+    capacity = MAX(capacity, 1);
+    u64_vector_reserve(result->keys, capacity);
+    f64_vector_reserve(result->sums, capacity);
+    u64_vector_reserve(result->counts, capacity);
+    f64_vector_reserve(result->mins, capacity);
+    f64_vector_reserve(result->maxs, capacity);
+
+    if(result->keys->capacity < capacity || result->sums->capacity < capacity || result->counts->capacity < capacity ||
+       result->mins->capacity < capacity || result->maxs->capacity < capacity) {
+        group_by_result_destroy(result);
+        return False;
+    }
+
+    return True;
+}
+
+/**
+ * Rebuild slots of table with given number of slots, from keys of it's groups.
+ * */
+static Bool group_by_table_rehash(GroupByTable* table, Size slot_count) {
+    GroupBySlot* slots = ALLOCATE(GroupBySlot, slot_count);
+    if(!slots) {
+        return False;
+    }
+    memset(slots, 0xff, slot_count * sizeof(GroupBySlot));
+
+    Size    mask   = slot_count - 1;
+    Uint64* keys   = table->groups.keys->data;
+    Size    length = table->groups.keys->length;
+    for(Size g = 0; g < length; g++) {
+        Size pos = group_by_hash(keys[g], table->seed) & mask;
+        while(slots[pos].group != GROUP_BY_EMPTY) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos].key   = keys[g];
+        slots[pos].group = g;
+    }
+
+    FREE(table->slots);
+    table->slots = slots;
+    table->mask  = mask;
+    return True;
+}
+
+/**
+ * Create an empty table, with space for groups of one batch. Number of
+ * groups is not known up front, and most partitions of inputs with few
+ * distinct keys stay this small.
+ * */
+static Bool group_by_table_init(GroupByTable* table, Uint64 seed) {
+    memset(table, 0, sizeof(GroupByTable));
+    table->seed = seed;
+
+    if(!group_by_result_init(&table->groups, GROUP_BY_BATCH)) {
+        return False;
+    }
+
+    if(!group_by_table_rehash(table, GROUP_BY_BATCH * 2)) {
+        group_by_result_destroy(&table->groups);
+        return False;
+    }
+
+    return True;
+}
+
+static void group_by_table_deinit(GroupByTable* table) {
+    FREE(table->slots);
+    group_by_result_destroy(&table->groups);
+    table->slots = NULL;
+}
+
+/**
+ * Make space for given number of new groups, both in aggregate columns and
+ * in slots, so that probing never has to check for growth. Slots are kept
+ * at most half full.
+ * */
+static Bool group_by_table_grow(GroupByTable* table, Size count) {
+    GroupByResult* groups = &table->groups;
+    Size           needed = groups->keys->length + count;
+
+    if(needed > groups->keys->capacity) {
+        Size capacity = MAX(needed, groups->keys->capacity * 2);
+        u64_vector_reserve(groups->keys, capacity);
+        f64_vector_reserve(groups->sums, capacity);
+        u64_vector_reserve(groups->counts, capacity);
+        f64_vector_reserve(groups->mins, capacity);
+        f64_vector_reserve(groups->maxs, capacity);
+
+        if(groups->keys->capacity < capacity || groups->sums->capacity < capacity || groups->counts->capacity < capacity ||
+           groups->mins->capacity < capacity || groups->maxs->capacity < capacity) {
+            return False;
+        }
+    }
+
+    if(needed * 2 > table->mask + 1) {
+        return group_by_table_rehash(table, NEXT_POW2(needed * 2));
+    }
+
+    return True;
+}
+
+/* set length of all aggregate columns */
+static FORCE_INLINE void group_by_result_set_length(GroupByResult* result, Size length) {
+    result->keys->length   = length;
+    result->sums->length   = length;
+    result->counts->length = length;
+    result->mins->length   = length;
+    result->maxs->length   = length;
+}
+
+/**
+ * Aggregate a batch of at most @c GROUP_BY_BATCH rows into table. Table
+ * must already have space for a new group for each row.
+ * */
+static void group_by_table_aggregate(GroupByTable* table, const Uint64* keys, const Float64* values, Size count) {
+    Size         pos[GROUP_BY_BATCH];
+    GroupBySlot* slots = table->slots;
+    Size         mask  = table->mask;
+    Uint64       seed  = table->seed;
+
+    /* no dependency between rows here, so hashes are computed back to back */
+    for(Size r = 0; r < count; r++) {
+        pos[r] = group_by_hash(keys[r], seed) & mask;
+    }
+
+    for(Size r = 0; r < MIN(count, GROUP_BY_PREFETCH_DIST); r++) {
+        __builtin_prefetch(slots + pos[r]);
+    }
+
+    Uint64*  group_keys = table->groups.keys->data;
+    Float64* sums       = table->groups.sums->data;
+    Uint64*  counts     = table->groups.counts->data;
+    Float64* mins       = table->groups.mins->data;
+    Float64* maxs       = table->groups.maxs->data;
+    Size     length     = table->groups.keys->length;
+
+    for(Size r = 0; r < count; r++) {
+        if(r + GROUP_BY_PREFETCH_DIST < count) {
+            __builtin_prefetch(slots + pos[r + GROUP_BY_PREFETCH_DIST]);
+        }
+
+        Uint64  key   = keys[r];
+        Float64 value = values[r];
+        Size    p     = pos[r];
+        while(slots[p].group != GROUP_BY_EMPTY && slots[p].key != key) {
+            p = (p + 1) & mask;
+        }
+
+        Uint64 g = slots[p].group;
+        if(g == GROUP_BY_EMPTY) {
+            slots[p].key   = key;
+            slots[p].group = length;
+            group_keys[length] = key;
+            sums[length]       = value;
+            counts[length]     = 1;
+            mins[length]       = value;
+            maxs[length]       = value;
+            length++;
+        } else {
+            sums[g]   += value;
+            counts[g] += 1;
+            mins[g]    = value < mins[g] ? value : mins[g];
+            maxs[g]    = value > maxs[g] ? value : maxs[g];
+        }
+    }
+
+    group_by_result_set_length(&table->groups, length);
+}
+
+/**
+ * Aggregate rows into table, a batch at a time.
+ * @return Number of rows aggregated, less than @p length only if table ran
+ * out of memory, or grew past @p max_groups.
+ * */
+static Size group_by_table_aggregate_rows(GroupByTable* table, const Uint64* keys, const Float64* values, Size length, Size max_groups) {
+    Size row = 0;
+    while(row < length && table->groups.keys->length <= max_groups) {
+        Size count = MIN(length - row, GROUP_BY_BATCH);
+        if(!group_by_table_grow(table, count)) {
+            break;
+        }
+        group_by_table_aggregate(table, keys + row, values + row, count);
+        row += count;
+    }
+    return row;
+}
+
+/**
+ * Add an already aggregated group to table. Table must already have space
+ * for a new group.
+ * */
+static void group_by_table_merge(GroupByTable* table, const GroupByResult* from, Size index) {
+    GroupByResult* groups = &table->groups;
+    Uint64         key    = from->keys->data[index];
+    Size           p      = group_by_hash(key, table->seed) & table->mask;
+
+    while(table->slots[p].group != GROUP_BY_EMPTY && table->slots[p].key != key) {
+        p = (p + 1) & table->mask;
+    }
+
+    Uint64 g = table->slots[p].group;
+    if(g == GROUP_BY_EMPTY) {
+        g = groups->keys->length;
+        table->slots[p].key   = key;
+        table->slots[p].group = g;
+        groups->keys->data[g]   = key;
+        groups->sums->data[g]   = from->sums->data[index];
+        groups->counts->data[g] = from->counts->data[index];
+        groups->mins->data[g]   = from->mins->data[index];
+        groups->maxs->data[g]   = from->maxs->data[index];
+        group_by_result_set_length(groups, g + 1);
+    } else {
+        groups->sums->data[g]   += from->sums->data[index];
+        groups->counts->data[g] += from->counts->data[index];
+        groups->mins->data[g]    = MIN(groups->mins->data[g], from->mins->data[index]);
+        groups->maxs->data[g]    = MAX(groups->maxs->data[g], from->maxs->data[index]);
+    }
+}
+
+/* run a step for items [0, count), on pool if partitioning is parallel */
+static void group_by_run(GroupByPartitions* parts, Size count, ParallelForCallback fn) {
+    if(parts->parallel) {
+        parallel_for(parts->pool, 0, count, 1, fn, parts);
+    } else {
+        fn(0, count, parts);
+    }
+}
+
+/* rows of given chunk */
+static FORCE_INLINE void group_by_chunk_rows(GroupByPartitions* parts, Size chunk, Size* begin, Size* end) {
+    *begin = MIN(chunk * parts->chunk_size, parts->length);
+    *end   = MIN(*begin + parts->chunk_size, parts->length);
+}
+
+/**
+ * Find partition of each row of given chunks, and count rows of each
+ * partition in each chunk.
+ * */
+static void group_by_count_partitions(Size begin, Size end, void* udata) {
+    GroupByPartitions* parts = udata;
+
+    for(Size c = begin; c < end; c++) {
+        Size* counts = parts->offsets + c * parts->count;
+        Size  row, last;
+        group_by_chunk_rows(parts, c, &row, &last);
+
+        for(; row < last; row++) {
+            Uint8 id = (Uint8)(group_by_hash(parts->keys[row], parts->seed) >> parts->shift);
+            parts->ids[row] = id;
+            counts[id]++;
+        }
+    }
+}
+
+/**
+ * Copy rows of given chunks into their partitions.
+ * */
+static void group_by_scatter_partitions(Size begin, Size end, void* udata) {
+    GroupByPartitions* parts = udata;
+
+    for(Size c = begin; c < end; c++) {
+        Size* offsets = parts->offsets + c * parts->count;
+        Size  row, last;
+        group_by_chunk_rows(parts, c, &row, &last);
+
+        for(; row < last; row++) {
+            Size pos = offsets[parts->ids[row]]++;
+            parts->part_keys[pos]   = parts->keys[row];
+            parts->part_values[pos] = parts->values[row];
+        }
+    }
+}
+
+/**
+ * Aggregate given partitions, each into it's own table. Spilled groups of
+ * a partition go in first, and come before rows of partition in input.
+ * */
+static void group_by_aggregate_partitions(Size begin, Size end, void* udata) {
+    GroupByPartitions* parts = udata;
+
+    for(Size p = begin; p < end; p++) {
+        GroupByTable* table  = parts->tables + p;
+        Size          first  = parts->starts[p];
+        Size          length = parts->starts[p + 1] - first;
+        Size          merged = 0;
+
+        if(parts->spilled) {
+            merged = parts->spilled_starts[p + 1] - parts->spilled_starts[p];
+        }
+
+        if(!group_by_table_init(table, parts->seed)) {
+            __atomic_store_n(&parts->failed, True, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if(merged) {
+            if(!group_by_table_grow(table, merged)) {
+                __atomic_store_n(&parts->failed, True, __ATOMIC_RELAXED);
+                continue;
+            }
+            for(Size s = parts->spilled_starts[p]; s < parts->spilled_starts[p + 1]; s++) {
+                group_by_table_merge(table, parts->spilled, parts->spilled_order[s]);
+            }
+        }
+
+        Size done = group_by_table_aggregate_rows(table, parts->part_keys + first, parts->part_values + first, length, SIZE_MAX);
+        if(done != length) {
+            __atomic_store_n(&parts->failed, True, __ATOMIC_RELAXED);
+        }
+
+        /* only aggregates are needed from here on */
+        FREE(table->slots);
+        table->slots = NULL;
+    }
+}
+
+/**
+ * Order spilled groups by partition of their keys.
+ * */
+static Bool group_by_order_spilled(GroupByPartitions* parts) {
+    Size length = parts->spilled->keys->length;
+
+    parts->spilled_order  = ALLOCATE(Size, MAX(length, 1));
+    parts->spilled_starts = ALLOCATE(Size, parts->count + 1);
+    Uint8* ids            = ALLOCATE(Uint8, MAX(length, 1));
+    if(!parts->spilled_order || !parts->spilled_starts || !ids) {
+        FREE(ids);
+        return False;
+    }
+
+    for(Size g = 0; g < length; g++) {
+        ids[g] = (Uint8)(group_by_hash(parts->spilled->keys->data[g], parts->seed) >> parts->shift);
+        parts->spilled_starts[ids[g] + 1]++;
+    }
+    for(Size p = 0; p < parts->count; p++) {
+        parts->spilled_starts[p + 1] += parts->spilled_starts[p];
+    }
+
+    /* starts are shifted by one while filling, and end up at their place */
+    for(Size g = 0; g < length; g++) {
+        parts->spilled_order[parts->spilled_starts[ids[g]]++] = g;
+    }
+    memmove(parts->spilled_starts + 1, parts->spilled_starts, parts->count * sizeof(Size));
+    parts->spilled_starts[0] = 0;
+
+    FREE(ids);
+    return True;
+}
+
+/**
+ * Partition rows, aggregate each partition and concatenate groups of all
+ * partitions into result.
+ * */
+static Bool group_by_partitioned(GroupByPartitions* parts, GroupByResult* result) {
+    Size count   = parts->count;
+    Bool success = False;
+
+    parts->ids         = ALLOCATE(Uint8, MAX(parts->length, 1));
+    parts->offsets     = ALLOCATE(Size, parts->chunks * count);
+    parts->starts      = ALLOCATE(Size, count + 1);
+    parts->part_keys   = ALLOCATE(Uint64, MAX(parts->length, 1));
+    parts->part_values = ALLOCATE(Float64, MAX(parts->length, 1));
+    parts->tables      = ALLOCATE(GroupByTable, count);
+    if(!parts->ids || !parts->offsets || !parts->starts || !parts->part_keys || !parts->part_values || !parts->tables) {
+        goto cleanup;
+    }
+
+    if(parts->spilled && !group_by_order_spilled(parts)) {
+        goto cleanup;
+    }
+
+    group_by_run(parts, parts->chunks, group_by_count_partitions);
+
+    /* turn counts into positions, each partition holding it's chunks one after another */
+    Size pos = 0;
+    for(Size p = 0; p < count; p++) {
+        parts->starts[p] = pos;
+        for(Size c = 0; c < parts->chunks; c++) {
+            Size rows                    = parts->offsets[c * count + p];
+            parts->offsets[c * count + p] = pos;
+            pos                          += rows;
+        }
+    }
+    parts->starts[count] = pos;
+
+    group_by_run(parts, parts->chunks, group_by_scatter_partitions);
+
+    /* partitioned rows replace ids and offsets */
+    FREE(parts->ids);
+    FREE(parts->offsets);
+    parts->ids     = NULL;
+    parts->offsets = NULL;
+
+    group_by_run(parts, count, group_by_aggregate_partitions);
+    if(parts->failed) {
+        goto cleanup;
+    }
+
+    Size total = 0;
+    for(Size p = 0; p < count; p++) {
+        total += parts->tables[p].groups.keys->length;
+    }
+
+    if(!group_by_result_init(result, total)) {
+        goto cleanup;
+    }
+
+    Size at = 0;
+    for(Size p = 0; p < count; p++) {
+        GroupByResult* groups = &parts->tables[p].groups;
+        Size           length = groups->keys->length;
+        memcpy(result->keys->data + at, groups->keys->data, length * sizeof(Uint64));
+        memcpy(result->sums->data + at, groups->sums->data, length * sizeof(Float64));
+        memcpy(result->counts->data + at, groups->counts->data, length * sizeof(Uint64));
+        memcpy(result->mins->data + at, groups->mins->data, length * sizeof(Float64));
+        memcpy(result->maxs->data + at, groups->maxs->data, length * sizeof(Float64));
+        at += length;
+    }
+    group_by_result_set_length(result, total);
+    success = True;
+
+cleanup:
+    if(parts->tables) {
+        for(Size p = 0; p < count; p++) {
+            group_by_table_deinit(parts->tables + p);
+        }
+    }
+    FREE(parts->tables);
+    FREE(parts->part_values);
+    FREE(parts->part_keys);
+    FREE(parts->starts);
+    FREE(parts->offsets);
+    FREE(parts->ids);
+    FREE(parts->spilled_starts);
+    FREE(parts->spilled_order);
+    return success;
+}
+
+/* partition bits for given number of rows, at least one and at most @c GROUP_BY_PARTITION_BITS */
+static Uint32 group_by_partition_bits(Size rows, Size min_partitions) {
+    Size   partitions = MAX(rows / GROUP_BY_PARTITION_ROWS, MAX(min_partitions, 2));
+    Uint32 bits       = 64 - __builtin_clzll(NEXT_POW2(partitions) - 1);
+    return MIN(bits, GROUP_BY_PARTITION_BITS);
+}
+
+/**
+ * Group rows by their key, and compute sum, count, min and max of values
+ * of each group. Result columns are created by this call, and must be
+ * destroyed with @c group_by_result_destroy.
+ *
+ * @param keys Key of each row.
+ * @param values Value of each row, same length as @p keys.
+ * @param result Filled with aggregates of each distinct key.
+ *
+ * @return True on success.
+ * @return False otherwise, and @p result is left empty.
+ * */
+Bool group_by_aggregate_f64(U64_Vector* keys, F64_Vector* values, GroupByResult* result) {
+    ERR_RETURN_VALUE_IF_FAIL(result, False, ERR_INVALID_ARGUMENTS);
+    memset(result, 0, sizeof(GroupByResult));
+    ERR_RETURN_VALUE_IF_FAIL(keys && values && keys->length == values->length, False, ERR_INVALID_ARGUMENTS);
+
+    Size         length = keys->length;
+    Uint64       seed   = hash_get_default_seed();
+    GroupByTable table;
+    ERR_RETURN_VALUE_IF_FAIL(group_by_table_init(&table, seed), False, ERR_OUT_OF_MEMORY);
+
+    Size done = group_by_table_aggregate_rows(&table, keys->data, values->data, length, GROUP_BY_CACHE_GROUPS);
+    if(done == length) {
+        FREE(table.slots);
+        *result = table.groups;
+        return True;
+    }
+
+    /* table outgrew cache, or ran out of memory while growing */
+    Bool success = False;
+    if(table.groups.keys->length > GROUP_BY_CACHE_GROUPS) {
+        Size              rest  = length - done;
+        GroupByPartitions parts = {0};
+        parts.keys       = keys->data + done;
+        parts.values     = values->data + done;
+        parts.length     = rest;
+        parts.seed       = seed;
+        parts.shift      = 64 - group_by_partition_bits(rest + table.groups.keys->length, 0);
+        parts.count      = (Size)1 << (64 - parts.shift);
+        parts.chunks     = 1;
+        parts.chunk_size = rest;
+        parts.spilled    = &table.groups;
+
+        FREE(table.slots);
+        table.slots = NULL;
+        success     = group_by_partitioned(&parts, result);
+    }
+
+    group_by_table_deinit(&table);
+    ERR_RETURN_VALUE_IF_FAIL(success, False, ERR_OUT_OF_MEMORY);
+    return True;
+}
+
+/**
+ * Same as @c group_by_aggregate_f64, but partitions rows and aggregates
+ * partitions on given thread pool. Small inputs are aggregated on calling
+ * thread instead.
+ *
+ * @param pool Pool to run on, default pool if NULL.
+ * @param keys Key of each row.
+ * @param values Value of each row, same length as @p keys.
+ * @param result Filled with aggregates of each distinct key.
+ *
+ * @return True on success.
+ * @return False otherwise, and @p result is left empty.
+ * */
+Bool group_by_aggregate_f64_parallel(ThreadPool* pool, U64_Vector* keys, F64_Vector* values, GroupByResult* result) {
+    ERR_RETURN_VALUE_IF_FAIL(result, False, ERR_INVALID_ARGUMENTS);
+    memset(result, 0, sizeof(GroupByResult));
+    ERR_RETURN_VALUE_IF_FAIL(keys && values && keys->length == values->length, False, ERR_INVALID_ARGUMENTS);
+
+    pool = pool ? pool : thread_pool_default();
+    Size threads = pool ? thread_pool_get_thread_count(pool) + 1 : 1;
+    if(keys->length < GROUP_BY_PARALLEL_MIN_ROWS || threads == 1) {
+        return group_by_aggregate_f64(keys, values, result);
+    }
+
+    GroupByPartitions parts = {0};
+    parts.keys       = keys->data;
+    parts.values     = values->data;
+    parts.length     = keys->length;
+    parts.seed       = hash_get_default_seed();
+    parts.shift      = 64 - group_by_partition_bits(keys->length, threads * GROUP_BY_CHUNKS_PER_THREAD);
+    parts.count      = (Size)1 << (64 - parts.shift);
+    parts.chunks     = threads * GROUP_BY_CHUNKS_PER_THREAD;
+    parts.chunk_size = (keys->length + parts.chunks - 1) / parts.chunks;
+    parts.pool       = pool;
+    parts.parallel   = True;
+
+    ERR_RETURN_VALUE_IF_FAIL(group_by_partitioned(&parts, result), False, ERR_OUT_OF_MEMORY);
+    return True;
+}
+
+/**
+ * Destroy columns of a result, and leave it empty.
+ * */
+void group_by_result_destroy(GroupByResult* result) {
+    ERR_RETURN_IF_FAIL(result, ERR_INVALID_ARGUMENTS);
+
+    if(result->keys) u64_vector_destroy(result->keys, NULL);
+    if(result->sums) f64_vector_destroy(result->sums, NULL);
+    if(result->counts) u64_vector_destroy(result->counts, NULL);
+    if(result->mins) f64_vector_destroy(result->mins, NULL);
+    if(result->maxs) f64_vector_destroy(result->maxs, NULL);
+    memset(result, 0, sizeof(GroupByResult));
+}
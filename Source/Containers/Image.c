@@ -0,0 +1,446 @@
+/**
+ * @file Image.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Loading, validating and writing of container images, see
+ * @c Anvie/Containers/Image.h.
+ * */
+
+#include <Anvie/Containers/Image.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define IMAGE_MAGIC "ANVIEIMG"
+#define IMAGE_END_MAGIC "ANVIEEND"
+#define IMAGE_BYTE_ORDER 0x01020304u
+#define IMAGE_CHECKSUM_SEED 0x616e7669652d696dull
+
+/* loaded containers hold doubles and 16 byte aligned slots */
+#define IMAGE_MIN_ALIGN 16
+
+/* memory allocated by a container loaded from image, released with image */
+typedef struct ImageBlock {
+    struct ImageBlock* next;
+    Size               size;
+} ImageBlock;
+
+struct Image {
+    Uint8*      base;      /**< First byte of image. */
+    Size        size;      /**< Size of image in bytes. */
+    Bool        mapped;    /**< True when @c base was mapped by @c image_map_file. */
+    Allocator   allocator; /**< Allocator of containers loaded from this image. */
+    ImageBlock* blocks;    /**< All memory allocated by @c allocator. */
+    void*       container; /**< Container loaded from this image, NULL until loaded. */
+};
+
+/* ------------------------------- allocator ------------------------------- */
+
+static void* image_allocate(Size size, void* ctx) {
+    Image*      image = (Image*)ctx;
+    ImageBlock* block = malloc(sizeof(ImageBlock) + size);
+    if(!block) {
+        return NULL;
+    }
+
+    block->next   = image->blocks;
+    block->size   = size;
+    image->blocks = block;
+    return block + 1;
+}
+
+/* old memory may be inside image, so it's never released, not even when it's a block */
+static void* image_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    void* mem = image_allocate(new_size, ctx);
+    if(mem && ptr) {
+        memcpy(mem, ptr, MIN(old_size, new_size));
+    }
+    return mem;
+}
+
+/* ------------------------------- validation ------------------------------ */
+
+/* checksum of given bytes, computed chunk by chunk exactly like ImageWriter does */
+static Uint64 image_checksum(const Uint8* data, Size size) {
+    Uint64 checksum = IMAGE_CHECKSUM_SEED;
+    for(Size i = 0; i < size; i += IMAGE_CHECKSUM_CHUNK_SIZE) {
+        checksum = hash_bytes_seeded(data + i, MIN((Size)IMAGE_CHECKSUM_CHUNK_SIZE, size - i), checksum);
+    }
+    return checksum;
+}
+
+static Bool image_validate(const Uint8* base, Size size) {
+    RETURN_VALUE_IF_FAIL(size >= sizeof(ImageHeader) + sizeof(ImageTrailer), False, "image is too small\n");
+    RETURN_VALUE_IF_FAIL(!((UintPtr)base % IMAGE_MIN_ALIGN), False, "image is not aligned to %d bytes\n", IMAGE_MIN_ALIGN);
+
+    const ImageHeader* header = (const ImageHeader*)base;
+    RETURN_VALUE_IF_FAIL(!memcmp(header->magic, IMAGE_MAGIC, sizeof(header->magic)), False, "not an image\n");
+    RETURN_VALUE_IF_FAIL(header->version == IMAGE_VERSION, False, "unsupported image version %u\n", header->version);
+    RETURN_VALUE_IF_FAIL(header->byte_order == IMAGE_BYTE_ORDER && header->word_size == sizeof(Size), False,
+                         "image was written on a machine of different byte order or word size\n");
+    RETURN_VALUE_IF_FAIL(header->kind > IMAGE_KIND_INVALID && header->kind < IMAGE_KIND_MAX, False, "unknown image kind %u\n", header->kind);
+    RETURN_VALUE_IF_FAIL(header->image_size == size, False, "image is truncated\n");
+
+    const ImageTrailer* trailer = (const ImageTrailer*)(base + size - sizeof(ImageTrailer));
+    RETURN_VALUE_IF_FAIL(!memcmp(trailer->magic, IMAGE_END_MAGIC, sizeof(trailer->magic)), False, "image is truncated\n");
+    RETURN_VALUE_IF_FAIL(image_checksum(base, size - sizeof(ImageTrailer)) == trailer->checksum, False, "image checksum mismatch\n");
+
+    return True;
+}
+
+static Image* image_create(Uint8* base, Size size, Bool mapped) {
+    Image* image = NEW(Image);
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_OUT_OF_MEMORY);
+
+    image->base                 = base;
+    image->size                 = size;
+    image->mapped               = mapped;
+    image->allocator.allocate   = image_allocate;
+    image->allocator.reallocate = image_reallocate;
+    image->allocator.free       = NULL;
+    image->allocator.ctx        = image;
+    return image;
+}
+
+/* ------------------------------- public API ------------------------------ */
+
+/**
+ * Map an image file into memory and validate it. File is mapped privately,
+ * so nothing is ever written back to it, and only pages that are touched
+ * are read. Validating reads the whole file once, to verify checksum.
+ *
+ * @param path Path of image file.
+ *
+ * @return Image on success.
+ * @return NULL if file can't be mapped or is not a valid image.
+ * */
+Image* image_map_file(ZString path) {
+    ERR_RETURN_VALUE_IF_FAIL(path, NULL, ERR_INVALID_ARGUMENTS);
+
+    int fd = open(path, O_RDONLY);
+    RETURN_VALUE_IF_FAIL(fd >= 0, NULL, "failed to open \"%s\" : %s\n", path, strerror(errno));
+
+    struct stat st;
+    if(fstat(fd, &st) || st.st_size <= 0) {
+        close(fd);
+        ERR(__FUNCTION__, "failed to get size of \"%s\"\n", path);
+        return NULL;
+    }
+
+    Size  size = (Size)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    RETURN_VALUE_IF_FAIL(base != MAP_FAILED, NULL, "failed to map \"%s\" : %s\n", path, strerror(errno));
+
+    Image* image = image_validate(base, size) ? image_create(base, size, True) : NULL;
+    if(!image) {
+        munmap(base, size);
+        ERR(__FUNCTION__, "\"%s\" is not a valid image\n", path);
+    }
+
+    return image;
+}
+
+/**
+ * Validate an image already in memory and use it in place. Buffer must
+ * stay alive and unchanged until image is destroyed, and is modified in
+ * place by loaders that have to relocate strings, so a buffer can be
+ * loaded only once.
+ *
+ * @param buffer Image, aligned to at least 16 bytes.
+ * @param size Size of image.
+ *
+ * @return Image on success.
+ * @return NULL if buffer is not a valid image.
+ * */
+Image* image_wrap_buffer(void* buffer, Size size) {
+    ERR_RETURN_VALUE_IF_FAIL(buffer && size, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(image_validate(buffer, size), NULL, ERR_INVALID_CONTENTS);
+    return image_create(buffer, size, False);
+}
+
+/**
+ * Destroy image along with container loaded from it, and all memory that
+ * container allocated since.
+ * */
+void image_destroy(Image* image) {
+    ERR_RETURN_IF_FAIL(image, ERR_INVALID_ARGUMENTS);
+
+    while(image->blocks) {
+        ImageBlock* next = image->blocks->next;
+        FREE(image->blocks);
+        image->blocks = next;
+    }
+
+    if(image->mapped) {
+        munmap(image->base, image->size);
+    }
+
+    FREE(image);
+}
+
+/**
+ * Get kind of container held by given image.
+ * */
+ImageKind image_get_kind(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, IMAGE_KIND_INVALID, ERR_INVALID_ARGUMENTS);
+    return (ImageKind)((ImageHeader*)image->base)->kind;
+}
+
+/**
+ * Get size of given image in bytes.
+ * */
+Size image_get_size(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, 0, ERR_INVALID_ARGUMENTS);
+    return image->size;
+}
+
+/* ------------------------ for container implementations ------------------------ */
+
+/**
+ * Get size a section of given size takes in an image, including padding.
+ * */
+Size image_section_size(Size size) {
+    return (size + IMAGE_SECTION_ALIGN - 1) & ~(Size)(IMAGE_SECTION_ALIGN - 1);
+}
+
+/**
+ * Get header of given image.
+ * */
+const ImageHeader* image_get_header(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_INVALID_ARGUMENTS);
+    return (const ImageHeader*)image->base;
+}
+
+/**
+ * Get next section of given size, in order sections were written.
+ *
+ * @param cursor Position of next section, 0 before first section.
+ * @param size Size of section.
+ *
+ * @return Address of section in image.
+ * @return NULL if section would extend past end of image.
+ * */
+void* image_take_section(Image* image, Size* cursor, Size size) {
+    ERR_RETURN_VALUE_IF_FAIL(image && cursor, NULL, ERR_INVALID_ARGUMENTS);
+
+    Size offset = *cursor ? *cursor : image_section_size(sizeof(ImageHeader));
+    Size end    = image->size - sizeof(ImageTrailer);
+    RETURN_VALUE_IF_FAIL(offset <= end && size <= end - offset, NULL, "image section is out of bounds\n");
+
+    *cursor = offset + image_section_size(size);
+    return image->base + offset;
+}
+
+/**
+ * Get allocator to be used by container loaded from given image.
+ * It never frees anything, memory is released with image.
+ * */
+Allocator* image_get_allocator(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_INVALID_ARGUMENTS);
+    return &image->allocator;
+}
+
+/**
+ * Get container already loaded from given image, NULL if none is.
+ * */
+void* image_get_container(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_INVALID_ARGUMENTS);
+    return image->container;
+}
+
+/**
+ * Remember container loaded from given image, so that loading it again
+ * gives same container.
+ * */
+void image_set_container(Image* image, void* container) {
+    ERR_RETURN_IF_FAIL(image, ERR_INVALID_ARGUMENTS);
+    image->container = container;
+}
+
+/* --------------------------------- writer -------------------------------- */
+
+/* write all given bytes to file, retrying on short writes */
+static Bool write_all(int fd, const Uint8* data, Size size) {
+    while(size) {
+        ssize_t n = write(fd, data, size);
+        if(n < 0 && errno == EINTR) {
+            continue;
+        }
+        RETURN_VALUE_IF_FAIL(n > 0, False, "failed to write image : %s\n", strerror(errno));
+        data += n;
+        size -= (Size)n;
+    }
+    return True;
+}
+
+/* checksum current chunk, and write it out when writing to file */
+static void image_writer_flush(ImageWriter* writer) {
+    if(!writer->chunk_fill) {
+        return;
+    }
+
+    const Uint8* chunk = NULL;
+    if(writer->chunk) {
+        chunk = writer->chunk;
+    } else if(writer->buffer && writer->offset <= writer->capacity) {
+        chunk = writer->buffer + writer->offset - writer->chunk_fill;
+    }
+
+    if(chunk) {
+        writer->checksum = hash_bytes_seeded(chunk, writer->chunk_fill, writer->checksum);
+    }
+    if(writer->chunk && !writer->failed && !write_all(writer->fd, writer->chunk, writer->chunk_fill)) {
+        writer->failed = True;
+    }
+    writer->chunk_fill = 0;
+}
+
+/**
+ * Start writing an image to given file descriptor, at it's current offset.
+ *
+ * @return True on success.
+ * @return False if staging memory can't be allocated.
+ * */
+Bool image_writer_init_fd(ImageWriter* writer, int fd) {
+    ERR_RETURN_VALUE_IF_FAIL(writer && fd >= 0, False, ERR_INVALID_ARGUMENTS);
+
+    memset(writer, 0, sizeof(*writer));
+    writer->fd       = fd;
+    writer->checksum = IMAGE_CHECKSUM_SEED;
+    writer->chunk    = malloc(IMAGE_CHECKSUM_CHUNK_SIZE);
+    ERR_RETURN_VALUE_IF_FAIL(writer->chunk, False, ERR_OUT_OF_MEMORY);
+    return True;
+}
+
+/**
+ * Start writing an image into given buffer. Nothing past @p capacity is
+ * written, but size of image is still counted, so a NULL buffer can be
+ * used to only compute size of image.
+ * */
+void image_writer_init_buffer(ImageWriter* writer, void* buffer, Size capacity) {
+    ERR_RETURN_IF_FAIL(writer, ERR_INVALID_ARGUMENTS);
+
+    memset(writer, 0, sizeof(*writer));
+    writer->fd       = -1;
+    writer->buffer   = buffer;
+    writer->capacity = buffer ? capacity : 0;
+    writer->checksum = IMAGE_CHECKSUM_SEED;
+}
+
+/**
+ * Write header of image, and pad it to first section.
+ *
+ * @param params Container specific parameters, at most @c IMAGE_MAX_PARAMS.
+ * @param image_size Size of whole image, including header and trailer.
+ * */
+void image_writer_begin(ImageWriter* writer, ImageKind kind, Uint32 flags, const Uint64* params, Size param_count, Size image_size) {
+    ERR_RETURN_IF_FAIL(writer && param_count <= IMAGE_MAX_PARAMS, ERR_INVALID_ARGUMENTS);
+
+    ImageHeader header = {0};
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+    header.version    = IMAGE_VERSION;
+    header.kind       = (Uint16)kind;
+    header.flags      = flags;
+    header.byte_order = IMAGE_BYTE_ORDER;
+    header.word_size  = sizeof(Size);
+    header.image_size = image_size;
+    if(param_count) {
+        memcpy(header.params, params, param_count * sizeof(Uint64));
+    }
+
+    image_writer_put(writer, &header, sizeof(header));
+    image_writer_align(writer);
+}
+
+/**
+ * Append given bytes to image.
+ * */
+void image_writer_put(ImageWriter* writer, const void* data, Size size) {
+    ERR_RETURN_IF_FAIL(writer && (data || !size), ERR_INVALID_ARGUMENTS);
+
+    const Uint8* bytes = (const Uint8*)data;
+    while(size) {
+        Size n = MIN(size, (Size)IMAGE_CHECKSUM_CHUNK_SIZE - writer->chunk_fill);
+
+        if(writer->chunk) {
+            memcpy(writer->chunk + writer->chunk_fill, bytes, n);
+        } else if(writer->offset + n <= writer->capacity) {
+            memcpy(writer->buffer + writer->offset, bytes, n);
+        } else {
+            writer->failed = True;
+        }
+
+        writer->offset     += n;
+        writer->chunk_fill += n;
+        bytes              += n;
+        size               -= n;
+
+        if(writer->chunk_fill == IMAGE_CHECKSUM_CHUNK_SIZE) {
+            image_writer_flush(writer);
+        }
+    }
+}
+
+/**
+ * Pad image with zeroes to start of next section.
+ * */
+void image_writer_align(ImageWriter* writer) {
+    ERR_RETURN_IF_FAIL(writer, ERR_INVALID_ARGUMENTS);
+
+    static const Uint8 zeroes[IMAGE_SECTION_ALIGN] = {0};
+    image_writer_put(writer, zeroes, image_section_size(writer->offset) - writer->offset);
+}
+
+/**
+ * Write trailer of image, and release staging memory of writer.
+ *
+ * @return Size of whole image. Image is complete only if writer did not
+ * fail, ie: only if all writes to file succeeded, or if size of image is
+ * at most capacity of buffer.
+ * @return 0 if writing to file failed.
+ * */
+Size image_writer_finish(ImageWriter* writer) {
+    ERR_RETURN_VALUE_IF_FAIL(writer, 0, ERR_INVALID_ARGUMENTS);
+
+    image_writer_flush(writer);
+
+    ImageTrailer trailer = {.checksum = writer->checksum};
+    memcpy(trailer.magic, IMAGE_END_MAGIC, sizeof(trailer.magic));
+
+    if(writer->chunk) {
+        if(!writer->failed && !write_all(writer->fd, (const Uint8*)&trailer, sizeof(trailer))) {
+            writer->failed = True;
+        }
+        FREE(writer->chunk);
+        writer->chunk = NULL;
+    } else if(writer->offset + sizeof(trailer) <= writer->capacity) {
+        memcpy(writer->buffer + writer->offset, &trailer, sizeof(trailer));
+    } else {
+        writer->failed = True;
+    }
+    writer->offset += sizeof(trailer);
+
+    return writer->fd >= 0 && writer->failed ? 0 : writer->offset;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file Memory.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Byte equality and ordering kernels behind @c mem_equal,
+ * @c mem_compare and @c compare_zstr. This file is built once per SIMD
+ * level and it's kernels are called through @c SIMD_DISPATCH, so arguments
+ * are checked by callers.
+ * */
+
+#include <Anvie/Simd/Dispatch.h>
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Types.h>
+#include <string.h>
+
+/*
+** Smallest page size of any supported platform. A register load that does not
+** cross a boundary of this size touches only the page of it's first byte, and
+** so can never fault, even if it reads past end of a string.
+*/
+#define MEM_PAGE_SIZE 4096
+
+/* a whole register can be loaded from p without touching next page */
+#define MEM_LOAD_IN_PAGE(p) ((((UintPtr)(p)) & (MEM_PAGE_SIZE - 1)) <= MEM_PAGE_SIZE - sizeof(MVec))
+
+/* reads past terminator are safe for hardware, but still out of bounds for Address and ThreadSanitizer */
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#   define MEM_OVERREAD_ALLOWED 0
+#elif defined(__has_feature)
+#   if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#       define MEM_OVERREAD_ALLOWED 0
+#   endif
+#endif
+#ifndef MEM_OVERREAD_ALLOWED
+#   define MEM_OVERREAD_ALLOWED 1
+#endif
+
+/* -1, 0 or 1 ordering of two bytes, compared as unsigned like memcmp does */
+#define MEM_ORDER(x, y) (((Uint8)(x) > (Uint8)(y)) - ((Uint8)(x) < (Uint8)(y)))
+
+#if SIMD_ENABLED
+/* one bit for each lane of a register where @p a and @p b differ */
+static inline Uint64 mem_diff_mask(const Uint8* a, const Uint8* b) {
+    return (Uint64)(MMask)~simd_movemask_epi8(simd_cmpeq_epi8(simd_loadu(a), simd_loadu(b)));
+}
+#endif // SIMD_ENABLED
+
+/**
+ * Check whether first @p length bytes of @p a and @p b are equal. Differences
+ * of four registers are accumulated and checked once, and last partial block
+ * is compared with a register overlapping previous one.
+ * */
+Bool SIMD_KERNEL(mem_kernel_equal)(const Uint8* a, const Uint8* b, Size length) {
+#if SIMD_ENABLED
+    Size i = 0;
+
+    if(length >= sizeof(MVec)) {
+        for(; i + 4 * sizeof(MVec) <= length; i += 4 * sizeof(MVec)) {
+            MVec diff = simd_xor(simd_loadu(a + i), simd_loadu(b + i));
+            diff = simd_or(diff, simd_xor(simd_loadu(a + i + sizeof(MVec)), simd_loadu(b + i + sizeof(MVec))));
+            diff = simd_or(diff, simd_xor(simd_loadu(a + i + 2 * sizeof(MVec)), simd_loadu(b + i + 2 * sizeof(MVec))));
+            diff = simd_or(diff, simd_xor(simd_loadu(a + i + 3 * sizeof(MVec)), simd_loadu(b + i + 3 * sizeof(MVec))));
+            if(!simd_testz(diff)) return False;
+        }
+
+        for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+            if(!simd_testz(simd_xor(simd_loadu(a + i), simd_loadu(b + i)))) return False;
+        }
+
+        if(i == length) return True;
+        i = length - sizeof(MVec);
+        return simd_testz(simd_xor(simd_loadu(a + i), simd_loadu(b + i)));
+    }
+
+    for(; i + 8 <= length; i += 8) {
+        Uint64 x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if(x ^ y) return False;
+    }
+
+    for(; i < length; i++) {
+        if(a[i] != b[i]) return False;
+    }
+
+    return True;
+#else
+    return !length || !memcmp(a, b, length);
+#endif // SIMD_ENABLED
+}
+
+/**
+ * Order first @p length bytes of @p a and @p b, compared as unsigned bytes.
+ * First differing byte is found from a mask of unequal lanes.
+ *
+ * @return -1, 0 or 1.
+ * */
+Int32 SIMD_KERNEL(mem_kernel_compare)(const Uint8* a, const Uint8* b, Size length) {
+#if SIMD_ENABLED
+    Size i = 0;
+
+    if(length >= sizeof(MVec)) {
+        for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+            Uint64 mask = mem_diff_mask(a + i, b + i);
+            if(mask) {
+                i += simd_tzcnt(mask);
+                return MEM_ORDER(a[i], b[i]);
+            }
+        }
+
+        if(i == length) return 0;
+        i = length - sizeof(MVec);
+        Uint64 mask = mem_diff_mask(a + i, b + i);
+        if(!mask) return 0;
+        i += simd_tzcnt(mask);
+        return MEM_ORDER(a[i], b[i]);
+    }
+
+    for(; i < length; i++) {
+        if(a[i] != b[i]) return MEM_ORDER(a[i], b[i]);
+    }
+
+    return 0;
+#else
+    Int32 cmp = length ? memcmp(a, b, length) : 0;
+    return (cmp > 0) - (cmp < 0);
+#endif // SIMD_ENABLED
+}
+
+/**
+ * Order two null terminated strings. Registers are loaded past terminator,
+ * but only while neither load crosses a page boundary, so no page beyond
+ * last one of a string is ever touched. Near a boundary bytes are compared
+ * one by one, until both strings are past it.
+ *
+ * @return -1, 0 or 1.
+ * */
+Int32 SIMD_KERNEL(zstr_kernel_compare)(const Char* a, const Char* b) {
+#if SIMD_ENABLED && MEM_OVERREAD_ALLOWED
+    const MVec zeroes = simd_setzero();
+    Size       i      = 0;
+
+    for(;;) {
+        if(MEM_LOAD_IN_PAGE(a + i) && MEM_LOAD_IN_PAGE(b + i)) {
+            MVec va = simd_loadu(a + i);
+
+            /* lanes where strings continue to be equal, ie: equal and not terminator */
+            MVec   same = simd_andnot(simd_cmpeq_epi8(va, zeroes), simd_cmpeq_epi8(va, simd_loadu(b + i)));
+            Uint64 stop = (Uint64)(MMask)~simd_movemask_epi8(same);
+            if(stop) {
+                i += simd_tzcnt(stop);
+                return MEM_ORDER(a[i], b[i]);
+            }
+            i += sizeof(MVec);
+        } else {
+            if(a[i] != b[i] || !a[i]) return MEM_ORDER(a[i], b[i]);
+            i++;
+        }
+    }
+#else
+    Int32 cmp = strcmp(a, b);
+    return (cmp > 0) - (cmp < 0);
+#endif // SIMD_ENABLED && MEM_OVERREAD_ALLOWED
+}
@@ -0,0 +1,416 @@
+/**
+ * @file StringView.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Byte search and UTF-8 kernels behind @c StringView. This file is
+ * built once per SIMD level and it's kernels are called through
+ * @c SIMD_DISPATCH, so arguments are checked by callers.
+ * */
+
+#include <Anvie/Simd/Dispatch.h>
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Types.h>
+#include <string.h>
+
+#ifndef STR_FIND_ANY_SIMD_SET_SIZE
+/**
+ * Largest set for which @c strview_find_any compares a whole register against
+ * each character of set. Larger sets use a lookup table, one byte at a time.
+ * */
+#define STR_FIND_ANY_SIMD_SET_SIZE 8
+#endif// STR_FIND_ANY_SIMD_SET_SIZE
+
+/**
+ * Position of first @p c in @p data.
+ *
+ * @return Position, or @c SIZE_MAX if there's none.
+ * */
+Size SIMD_KERNEL(strview_kernel_find_byte)(const Char* data, Size length, Char c) {
+    Size i = 0;
+
+#if SIMD_ENABLED
+    const MVec needle = simd_set1_epi8((Int8)c);
+    for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+        Uint64 mask = (Uint64)simd_cmpeq_epi8_mask(simd_loadu(data + i), needle);
+        if(mask) {
+            return i + simd_tzcnt(mask);
+        }
+    }
+#else
+    const Char* p = length ? memchr(data, c, length) : NULL;
+    return p ? (Size)(p - data) : SIZE_MAX;
+#endif // SIMD_ENABLED
+
+    for(; i < length; i++) {
+        if(data[i] == c) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * Position of first byte of @p data that is in @p set. Small sets are matched
+ * a whole register at a time, larger ones through a table with one bit per
+ * character.
+ *
+ * @param set Characters to find, atleast 2.
+ * @param set_size Number of characters in @p set.
+ * @return Position, or @c SIZE_MAX if there's none.
+ * */
+Size SIMD_KERNEL(strview_kernel_find_any)(const Char* data, Size length, const Char* set, Size set_size) {
+    Size i = 0;
+
+#if SIMD_ENABLED
+    if(set_size <= STR_FIND_ANY_SIMD_SET_SIZE) {
+        MVec needles[STR_FIND_ANY_SIMD_SET_SIZE];
+        for(Size k = 0; k < set_size; k++) {
+            needles[k] = simd_set1_epi8((Int8)set[k]);
+        }
+
+        for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+            MVec   block = simd_loadu(data + i);
+            Uint64 mask  = 0;
+            for(Size k = 0; k < set_size; k++) {
+                mask |= (Uint64)simd_cmpeq_epi8_mask(block, needles[k]);
+            }
+            if(mask) {
+                return i + simd_tzcnt(mask);
+            }
+        }
+    }
+#endif // SIMD_ENABLED
+
+    Uint64 table[4] = {0};
+    for(Size k = 0; k < set_size; k++) {
+        Uint8 b = (Uint8)set[k];
+        table[b >> 6] |= (Uint64)1 << (b & 63);
+    }
+
+    for(; i < length; i++) {
+        Uint8 b = (Uint8)data[i];
+        if(table[b >> 6] & ((Uint64)1 << (b & 63))) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * Position of first occurence of @p needle in @p data. Candidates are found by
+ * comparing first and last bytes of needle against a whole register of
+ * positions at once, and only positions where both match are compared fully.
+ *
+ * @param needle Bytes to find.
+ * @param n Length of needle, atleast 2 and atmost @p length.
+ * @return Position, or @c SIZE_MAX if there's none.
+ * */
+Size SIMD_KERNEL(strview_kernel_find)(const Char* data, Size length, const Char* needle, Size n) {
+    Char first = needle[0];
+    Char last  = needle[n - 1];
+    Size i     = 0;
+
+#if SIMD_ENABLED
+    const MVec firsts = simd_set1_epi8((Int8)first);
+    const MVec lasts  = simd_set1_epi8((Int8)last);
+    for(; i + n - 1 + sizeof(MVec) <= length; i += sizeof(MVec)) {
+        Uint64 mask = (Uint64)simd_cmpeq_epi8_mask(simd_loadu(data + i), firsts) &
+                      (Uint64)simd_cmpeq_epi8_mask(simd_loadu(data + i + n - 1), lasts);
+        while(mask) {
+            Size pos = i + simd_tzcnt(mask);
+            if(!memcmp(data + pos + 1, needle + 1, n - 2)) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif // SIMD_ENABLED
+
+    while(i + n <= length) {
+        Size pos = SIMD_KERNEL(strview_kernel_find_byte)(data + i, length - n + 1 - i, first);
+        if(pos == SIZE_MAX) {
+            break;
+        }
+        pos += i;
+        if(data[pos + n - 1] == last && !memcmp(data + pos + 1, needle + 1, n - 2)) {
+            return pos;
+        }
+        i = pos + 1;
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * Number of occurences of @p c in @p data.
+ * */
+Size SIMD_KERNEL(strview_kernel_count_byte)(const Char* data, Size length, Char c) {
+    Size count = 0;
+    Size i     = 0;
+
+#if SIMD_ENABLED
+    const MVec needle = simd_set1_epi8((Int8)c);
+    for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+        count += (Size)__builtin_popcountll((Uint64)simd_cmpeq_epi8_mask(simd_loadu(data + i), needle));
+    }
+#endif // SIMD_ENABLED
+
+    for(; i < length; i++) {
+        count += data[i] == c;
+    }
+    return count;
+}
+
+/* highest bit of every byte of a 64 bit word */
+#define ASCII_MASK_U64 0x8080808080808080ULL
+
+/* continuation bytes are 10xxxxxx, which as signed bytes are all below -64 */
+#define IS_UTF8_CONTINUATION(c) (((Uint8)(c) & 0xc0) == 0x80)
+
+/**
+ * Validate UTF-8 one character at a time, taking 8 ASCII bytes at once
+ * whenever possible. Rejects overlong encodings, surrogates, code points
+ * above U+10FFFF and truncated or stray continuation bytes.
+ * */
+static Bool validate_utf8_scalar(const Uint8* data, Size length) {
+    Size i = 0;
+    while(i < length) {
+        if(i + 8 <= length) {
+            Uint64 word;
+            memcpy(&word, data + i, 8);
+            if(!(word & ASCII_MASK_U64)) {
+                i += 8;
+                continue;
+            }
+        }
+
+        Uint8 c = data[i];
+        if(c < 0x80) {
+            i++;
+            continue;
+        }
+
+        Size n;
+        if(c >= 0xc2 && c <= 0xdf) {
+            n = 2;
+        } else if((c & 0xf0) == 0xe0) {
+            n = 3;
+        } else if(c >= 0xf0 && c <= 0xf4) {
+            n = 4;
+        } else {
+            return False;
+        }
+        if(n > length - i) {
+            return False;
+        }
+
+        /* second byte range excludes overlongs, surrogates and values above U+10FFFF */
+        Uint8 lo = 0x80, hi = 0xbf;
+        if(c == 0xe0) {
+            lo = 0xa0;
+        } else if(c == 0xed) {
+            hi = 0x9f;
+        } else if(c == 0xf0) {
+            lo = 0x90;
+        } else if(c == 0xf4) {
+            hi = 0x8f;
+        }
+        if(data[i + 1] < lo || data[i + 1] > hi) {
+            return False;
+        }
+        for(Size k = 2; k < n; k++) {
+            if(!IS_UTF8_CONTINUATION(data[i + k])) {
+                return False;
+            }
+        }
+        i += n;
+    }
+    return True;
+}
+
+#if SIMD_ENABLED
+/*
+ * Error classes of Keiser and Lemire's lookup validator ("Validating UTF-8 In
+ * Less Than One Instruction Per Byte"). Every pair of adjacent bytes is looked
+ * up by high nibble of first byte, low nibble of first byte and high nibble of
+ * second byte. A bit set in all three lookups is an error, except that bit 7
+ * marks a continuation after a continuation, which is an error only when it's
+ * not third or fourth byte of a character.
+ * */
+#define UTF8_TOO_SHORT      (1 << 0) /* 11______ 0_______, 11______ 11______ */
+#define UTF8_TOO_LONG       (1 << 1) /* 0_______ 10______ */
+#define UTF8_OVERLONG_3     (1 << 2) /* 11100000 100_____ */
+#define UTF8_TOO_LARGE      (1 << 3) /* 11110100 1001____ and above */
+#define UTF8_SURROGATE      (1 << 4) /* 11101101 101_____ */
+#define UTF8_OVERLONG_2     (1 << 5) /* 1100000_ 10______ */
+#define UTF8_TOO_LARGE_1000 (1 << 6) /* 11110101 1000____ and above */
+#define UTF8_OVERLONG_4     (1 << 6) /* 11110000 1000____ */
+#define UTF8_TWO_CONTS      (1 << 7) /* 10______ 10______ */
+#define UTF8_CARRY          (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static const Uint8 utf8_byte1_high[16] = {
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+static const Uint8 utf8_byte1_low[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+static const Uint8 utf8_byte2_high[16] = {
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+/**
+ * Error bits of each byte of a register at @p p. Previous bytes are loaded
+ * from @p p - 1, @p p - 2 and @p p - 3, so these must be readable.
+ * */
+static FORCE_INLINE MVec utf8_block_errors(const Uint8* p, MVec byte1_high, MVec byte1_low, MVec byte2_high) {
+    const MVec nibble = simd_set1_epi8(0x0f);
+    MVec       input  = simd_loadu(p);
+    MVec       prev1  = simd_loadu(p - 1);
+
+    MVec special = simd_and(simd_and(simd_shuffle_epi8(byte1_high, simd_and(simd_srli_epi16(prev1, 4), nibble)),
+                                     simd_shuffle_epi8(byte1_low, simd_and(prev1, nibble))),
+                            simd_shuffle_epi8(byte2_high, simd_and(simd_srli_epi16(input, 4), nibble)));
+
+    /* bit 7 set where byte must be third or fourth byte of a character */
+    MVec must_be_continuation = simd_or(simd_subs_epu8(simd_loadu(p - 2), simd_set1_epi8((Int8)(0xe0 - 0x80))),
+                                        simd_subs_epu8(simd_loadu(p - 3), simd_set1_epi8((Int8)(0xf0 - 0x80))));
+    must_be_continuation     = simd_and(must_be_continuation, simd_set1_epi8((Int8)0x80));
+    return simd_xor(must_be_continuation, special);
+}
+#endif // SIMD_ENABLED
+
+/**
+ * Check whether @p data is valid UTF-8, a whole register at a time using
+ * three 16 entry table lookups, skipping runs of ASCII.
+ * */
+Bool SIMD_KERNEL(strview_kernel_validate_utf8)(const Uint8* data, Size length) {
+    Size i = 0;
+
+#if SIMD_ENABLED
+    if(length >= sizeof(MVec)) {
+        const MVec byte1_high = simd_broadcast_si128(utf8_byte1_high);
+        const MVec byte1_low  = simd_broadcast_si128(utf8_byte1_low);
+        const MVec byte2_high = simd_broadcast_si128(utf8_byte2_high);
+
+        /* first register has no bytes before it, so look it up from a copy preceded by ASCII */
+        Uint8 head[sizeof(MVec) + 3] = {0};
+        memcpy(head + 3, data, sizeof(MVec));
+        MVec errors = utf8_block_errors(head + 3, byte1_high, byte1_low, byte2_high);
+
+        for(i = sizeof(MVec); i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+            /* ASCII register is valid unless a character before it is still incomplete */
+            if(!simd_movemask_epi8(simd_loadu(data + i)) &&
+               data[i - 1] < 0xc0 && data[i - 2] < 0xe0 && data[i - 3] < 0xf0) {
+                continue;
+            }
+            errors = simd_or(errors, utf8_block_errors(data + i, byte1_high, byte1_low, byte2_high));
+        }
+        if(!simd_testz(errors)) {
+            return False;
+        }
+
+        /* rest is validated from start of last character that may continue past i */
+        for(Size k = i; k > i - 3; k--) {
+            if(!IS_UTF8_CONTINUATION(data[k - 1])) {
+                i = data[k - 1] >= 0xc0 ? k - 1 : i;
+                break;
+            }
+        }
+    }
+#endif // SIMD_ENABLED
+
+    return validate_utf8_scalar(data + i, length - i);
+}
+
+/**
+ * Check whether no byte of @p data has it's highest bit set.
+ * */
+Bool SIMD_KERNEL(strview_kernel_is_ascii)(const Char* data, Size length) {
+    Size i = 0;
+
+#if SIMD_ENABLED
+    if(length >= sizeof(MVec)) {
+        MVec any = simd_set1_epi8(0);
+        for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+            any = simd_or(any, simd_loadu(data + i));
+        }
+        if(simd_movemask_epi8(any)) {
+            return False;
+        }
+    }
+#endif // SIMD_ENABLED
+
+    Uint64 any = 0;
+    for(; i + 8 <= length; i += 8) {
+        Uint64 word;
+        memcpy(&word, data + i, 8);
+        any |= word;
+    }
+    for(; i < length; i++) {
+        any |= (Uint8)data[i];
+    }
+    return !(any & ASCII_MASK_U64);
+}
+
+/**
+ * Number of bytes of @p data that are not UTF-8 continuation bytes.
+ * */
+Size SIMD_KERNEL(strview_kernel_utf8_length)(const Char* data, Size length) {
+    Size count = 0;
+    Size i     = 0;
+
+#if SIMD_ENABLED
+    /* as signed bytes continuation bytes are -128 to -65 */
+    const MVec cont_max = simd_set1_epi8(-65);
+    for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+        count += (Size)__builtin_popcountll((Uint64)simd_cmpgt_epi8_mask(simd_loadu(data + i), cont_max));
+    }
+#endif // SIMD_ENABLED
+
+    for(; i < length; i++) {
+        count += !IS_UTF8_CONTINUATION(data[i]);
+    }
+    return count;
+}
@@ -0,0 +1,350 @@
+/**
+ * @file LinkedTree.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Tree with pooled, pointer stable nodes linked as first child
+ * and next sibling.
+ * */
+
+#include <Anvie/Containers/LinkedTree.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* round value up to a multiple of 8 */
+#define ALIGN8(value) (((value) + 7) & ~(Size)7)
+
+/* allocate a node with no links, data is left uninitialized */
+static LinkedTreeNode* node_allocate(LinBlockAllocator* pool) {
+    LinkedTreeNode* node = (LinkedTreeNode*)lballoc_allocate(pool);
+    ERR_RETURN_VALUE_IF_FAIL(node, NULL, ERR_OUT_OF_MEMORY);
+    memset(node, 0, sizeof(LinkedTreeNode));
+    return node;
+}
+
+/* create pool and root node of a tree */
+static Bool create_pool(LinkedTree* tree) {
+    tree->pool = lballoc_create(sizeof(LinkedTreeNode) + ALIGN8(tree->element_size));
+    ERR_RETURN_VALUE_IF_FAIL(tree->pool, False, ERR_OUT_OF_MEMORY);
+
+    tree->root = node_allocate(tree->pool);
+    if(!tree->root) {
+        lballoc_destroy(tree->pool);
+        tree->pool = NULL;
+        return False;
+    }
+    memset(tree->root->data, 0, tree->element_size);
+    tree->node_count = 0;
+    return True;
+}
+
+/* context of destroy_copy_visitor */
+typedef struct DestroyCopiesContext {
+    LinkedTree* tree;
+    void*       udata;
+} DestroyCopiesContext;
+
+static void destroy_copy_visitor(MemBlock blk, Size index, void* udata) {
+    UNUSED(index);
+    DestroyCopiesContext* ctx = udata;
+    if((LinkedTreeNode*)blk != ctx->tree->root) {
+        ctx->tree->destroy_copy(((LinkedTreeNode*)blk)->data, ctx->udata);
+    }
+}
+
+/* destroy copies of data in all nodes, attached or not, and release whole pool */
+static void destroy_pool(LinkedTree* tree, void* udata) {
+    if(tree->destroy_copy && tree->node_count) {
+        DestroyCopiesContext ctx = {tree, udata};
+        lballoc_foreach(tree->pool, destroy_copy_visitor, &ctx);
+    }
+    lballoc_destroy(tree->pool);
+    tree->pool = NULL;
+    tree->root = NULL;
+}
+
+/* allocate a node and store a copy of given data in it */
+static LinkedTreeNode* node_create(LinkedTree* tree, void* data, void* udata) {
+    LinkedTreeNode* node = node_allocate(tree->pool);
+    if(!node) {
+        return NULL;
+    }
+
+    Size   esz   = tree->element_size;
+    Uint64 value = (Uint64)data;
+    if(tree->create_copy) {
+        if(data) tree->create_copy(node->data, data, udata);
+        else memset(node->data, 0, esz);
+    } else switch(esz) {
+            /* data is an array of Uint64, so narrower values are copied, not stored through a cast */
+            case 8 : node->data[0] = value; break;
+            case 4 : { Uint32 v = (Uint32)value; memcpy(node->data, &v, sizeof(v)); } break;
+            case 2 : { Uint16 v = (Uint16)value; memcpy(node->data, &v, sizeof(v)); } break;
+            case 1 : { Uint8  v = (Uint8) value; memcpy(node->data, &v, sizeof(v)); } break;
+            default: {
+                if(data) memcpy(node->data, data, esz);
+                else memset(node->data, 0, esz);
+            }
+        }
+
+    tree->node_count++;
+    return node;
+}
+
+/* link a node with no parent as child of @p parent, between @p prev and @p next */
+static void node_link(LinkedTreeNode* parent, LinkedTreeNode* prev, LinkedTreeNode* next, LinkedTreeNode* node) {
+    node->parent       = parent;
+    node->prev_sibling = prev;
+    node->next_sibling = next;
+    if(prev) prev->next_sibling = node;
+    else parent->first_child = node;
+    if(next) next->prev_sibling = node;
+    else parent->last_child = node;
+    parent->child_count++;
+}
+
+/**
+ * Create a new linked tree, with an empty root node.
+ * Like vectors, you either have both @c create_copy
+ * and @c destroy_copy or you don't have them at all.
+ *
+ * @param element_size Size of data stored in each node.
+ * @param create_copy Copy constructor for data of each node. Can be NULL.
+ * @param destroy_copy Copy destructor for data of each node. Can be NULL.
+ * @return LinkedTree* on success, NULL otherwise.
+ * */
+LinkedTree* linked_tree_create(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy) {
+    ERR_RETURN_VALUE_IF_FAIL(element_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    Bool b1 = create_copy != NULL;
+    Bool b2 = destroy_copy != NULL;
+    ERR_RETURN_VALUE_IF_FAIL(!(b1 ^ b2), NULL, ERR_INVALID_ARGUMENTS);
+
+    LinkedTree* tree = NEW(LinkedTree);
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_OUT_OF_MEMORY);
+
+    tree->element_size = element_size;
+    tree->create_copy  = create_copy;
+    tree->destroy_copy = destroy_copy;
+    if(!create_pool(tree)) {
+        FREE(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+/**
+ * Destroy given tree and all it's nodes, including detached ones.
+ * Node pool is released at once. Nodes are visited only to destroy
+ * their data when tree has a copy destructor.
+ *
+ * @param tree
+ * @param udata User data passed to copy destructor.
+ * */
+void linked_tree_destroy(LinkedTree* tree, void* udata) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    destroy_pool(tree, udata);
+    FREE(tree);
+}
+
+/**
+ * Delete all nodes except root, releasing node pool at once.
+ *
+ * @param tree
+ * @param udata User data passed to copy destructor.
+ * */
+void linked_tree_clear(LinkedTree* tree, void* udata) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    destroy_pool(tree, udata);
+    create_pool(tree);
+}
+
+/**
+ * Make space for atleast given number of nodes, so that creating
+ * them never grows node pool.
+ *
+ * @param tree
+ * @param node_count Number of nodes, not counting root.
+ * */
+void linked_tree_reserve(LinkedTree* tree, Size node_count) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    lballoc_reserve(tree->pool, node_count + 1);
+}
+
+/**
+ * Add a new node as first child of given node.
+ *
+ * @param tree
+ * @param parent Node to add child to, eg: @c linked_tree_root(tree).
+ * @param data Data for new node.
+ * @param udata User data passed to copy constructor.
+ * @return New node on success, NULL otherwise.
+ * */
+LinkedTreeNode* linked_tree_push_front(LinkedTree* tree, LinkedTreeNode* parent, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && parent, NULL, ERR_INVALID_ARGUMENTS);
+
+    LinkedTreeNode* node = node_create(tree, data, udata);
+    if(node) {
+        node_link(parent, NULL, parent->first_child, node);
+    }
+    return node;
+}
+
+/**
+ * Add a new node as last child of given node.
+ *
+ * @param tree
+ * @param parent Node to add child to, eg: @c linked_tree_root(tree).
+ * @param data Data for new node.
+ * @param udata User data passed to copy constructor.
+ * @return New node on success, NULL otherwise.
+ * */
+LinkedTreeNode* linked_tree_push_back(LinkedTree* tree, LinkedTreeNode* parent, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && parent, NULL, ERR_INVALID_ARGUMENTS);
+
+    LinkedTreeNode* node = node_create(tree, data, udata);
+    if(node) {
+        node_link(parent, parent->last_child, NULL, node);
+    }
+    return node;
+}
+
+/**
+ * Add a new node right before given node, as child of same parent.
+ *
+ * @param tree
+ * @param sibling Node to insert before, must have a parent.
+ * @param data Data for new node.
+ * @param udata User data passed to copy constructor.
+ * @return New node on success, NULL otherwise.
+ * */
+LinkedTreeNode* linked_tree_insert_before(LinkedTree* tree, LinkedTreeNode* sibling, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && sibling && sibling->parent, NULL, ERR_INVALID_ARGUMENTS);
+
+    LinkedTreeNode* node = node_create(tree, data, udata);
+    if(node) {
+        node_link(sibling->parent, sibling->prev_sibling, sibling, node);
+    }
+    return node;
+}
+
+/**
+ * Add a new node right after given node, as child of same parent.
+ *
+ * @param tree
+ * @param sibling Node to insert after, must have a parent.
+ * @param data Data for new node.
+ * @param udata User data passed to copy constructor.
+ * @return New node on success, NULL otherwise.
+ * */
+LinkedTreeNode* linked_tree_insert_after(LinkedTree* tree, LinkedTreeNode* sibling, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && sibling && sibling->parent, NULL, ERR_INVALID_ARGUMENTS);
+
+    LinkedTreeNode* node = node_create(tree, data, udata);
+    if(node) {
+        node_link(sibling->parent, sibling, sibling->next_sibling, node);
+    }
+    return node;
+}
+
+/**
+ * Unlink a node, along with it's whole subtree, from it's parent.
+ * Subtree keeps it's nodes and can be attached anywhere else with
+ * @c linked_tree_attach_back. A detached subtree that is never attached
+ * again is still destroyed with tree.
+ *
+ * @param tree
+ * @param node Node to detach, must not be root.
+ * */
+void linked_tree_detach(LinkedTree* tree, LinkedTreeNode* node) {
+    ERR_RETURN_IF_FAIL(tree && node && node != tree->root, ERR_INVALID_ARGUMENTS);
+
+    LinkedTreeNode* parent = node->parent;
+    if(!parent) {
+        return;
+    }
+
+    if(node->prev_sibling) node->prev_sibling->next_sibling = node->next_sibling;
+    else parent->first_child = node->next_sibling;
+    if(node->next_sibling) node->next_sibling->prev_sibling = node->prev_sibling;
+    else parent->last_child = node->prev_sibling;
+    parent->child_count--;
+
+    node->parent       = NULL;
+    node->prev_sibling = NULL;
+    node->next_sibling = NULL;
+}
+
+/**
+ * Attach a detached node, along with it's whole subtree, as last child
+ * of given node. To move a subtree, detach it first.
+ *
+ * @param tree
+ * @param parent Node to attach to, must not be inside subtree of @p node.
+ * @param node Detached node.
+ * */
+void linked_tree_attach_back(LinkedTree* tree, LinkedTreeNode* parent, LinkedTreeNode* node) {
+    ERR_RETURN_IF_FAIL(tree && parent && node && !node->parent && node != tree->root, ERR_INVALID_ARGUMENTS);
+
+    /* attaching under own subtree would make a cycle */
+    for(LinkedTreeNode* iter = parent; iter; iter = iter->parent) {
+        ERR_RETURN_IF_FAIL(iter != node, ERR_INVALID_ARGUMENTS);
+    }
+
+    node_link(parent, parent->last_child, NULL, node);
+}
+
+/**
+ * Delete a node along with it's whole subtree. Nodes are freed back to
+ * node pool one leaf at a time, without recursion, so depth of subtree
+ * does not matter.
+ *
+ * @param tree
+ * @param node Node to delete, attached or detached. Deleting root
+ * deletes all nodes but keeps root, like @c linked_tree_clear.
+ * @param udata User data passed to copy destructor.
+ * */
+void linked_tree_delete(LinkedTree* tree, LinkedTreeNode* node, void* udata) {
+    ERR_RETURN_IF_FAIL(tree && node, ERR_INVALID_ARGUMENTS);
+
+    if(node == tree->root) {
+        linked_tree_clear(tree, udata);
+        return;
+    }
+    linked_tree_detach(tree, node);
+
+    /* free leaves, unlinking each from it's parent, until node itself is a leaf */
+    LinkedTreeNode* iter = node;
+    while(True) {
+        while(iter->first_child) {
+            iter = iter->first_child;
+        }
+
+        LinkedTreeNode* parent = iter->parent;
+        if(tree->destroy_copy) {
+            tree->destroy_copy(iter->data, udata);
+        }
+        lballoc_free(tree->pool, (MemBlock)iter);
+        tree->node_count--;
+
+        if(iter == node) {
+            break;
+        }
+        parent->first_child = iter->next_sibling;
+        iter                = parent;
+    }
+}
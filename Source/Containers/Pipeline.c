@@ -0,0 +1,702 @@
+/**
+ * @file Pipeline.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *
+ * @brief Implementation of lazy pipelines of @c Anvie/Containers/Pipeline.h.
+ *
+ * A reduction pulls elements from source into a chunk, runs chunk through
+ * every stage and hands what's left to reduction, until source runs out or
+ * a take stage is done. A chunk either points into source, when source is
+ * contiguous, or into one of two scratch buffers. Filters keep a selection
+ * of live positions instead of moving elements, maps write their output
+ * into buffer not holding chunk, and numeric kernels work in place once
+ * chunk is in a buffer, so no stage ever allocates memory.
+ * */
+
+#include <Anvie/Containers/Pipeline.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <math.h>
+#include <string.h>
+
+/* most elements in a chunk, and bytes in each scratch buffer */
+#define PIPELINE_CHUNK       1024
+#define PIPELINE_CHUNK_BYTES (PIPELINE_CHUNK * sizeof(Uint64))
+
+struct PipelineChunk {
+    Byte*   data;         /**< elements of chunk, in source or in one of buffers */
+    Size    element_size;
+    Size    live;         /**< number of elements still going through pipeline */
+    Uint16* selection;    /**< positions of live elements in data, NULL if they are first live elements */
+    Byte*   buffers[2];
+    Uint16  positions[PIPELINE_CHUNK];
+};
+
+/* position of a reduction in source of it's pipeline */
+typedef struct PipelineCursor {
+    Size              position; /**< next element of a view, or next word of a bitvector */
+    Uint64            word;     /**< set bits of current word not yet pulled */
+    DenseMapIterator  dense_iter;
+    SparseMapIterator sparse_iter;
+} PipelineCursor;
+
+typedef void (*PipelineSink)(PipelineChunk* chunk, void* ctx);
+
+/**
+ * Get value to be passed to callbacks for element at given address.
+ * Follows same convention as @c vector_peek.
+ * */
+static FORCE_INLINE void* pipeline_value(const Byte* p, Size element_size) {
+    switch(element_size) {
+        case 8: { Uint64 v; memcpy(&v, p, 8); return (void*)v; }
+        case 4: { Uint32 v; memcpy(&v, p, 4); return (void*)(Uint64)v; }
+        case 2: { Uint16 v; memcpy(&v, p, 2); return (void*)(Uint64)v; }
+        case 1: return (void*)(Uint64)*(const Uint8*)p;
+        default: return (void*)p;
+    }
+}
+
+/* address of i-th live element of chunk */
+static FORCE_INLINE Byte* pipeline_live_at(PipelineChunk* chunk, Size i) {
+    Size pos = chunk->selection ? chunk->selection[i] : i;
+    return chunk->data + pos * chunk->element_size;
+}
+
+/* scratch buffer not holding elements of chunk */
+static FORCE_INLINE Byte* pipeline_free_buffer(PipelineChunk* chunk) {
+    return chunk->data == chunk->buffers[0] ? chunk->buffers[1] : chunk->buffers[0];
+}
+
+/* where a kernel writes it's output, in place unless chunk still points into source */
+static FORCE_INLINE Byte* pipeline_output(PipelineChunk* chunk) {
+    Bool in_buffer = chunk->data == chunk->buffers[0] || chunk->data == chunk->buffers[1];
+    return in_buffer ? chunk->data : pipeline_free_buffer(chunk);
+}
+
+static Pipeline pipeline_from_source(PipelineSourceKind source, void* container, Size element_size) {
+    Pipeline pipeline = {0};
+    pipeline.source       = source;
+    pipeline.container    = container;
+    pipeline.element_size = element_size;
+    pipeline.failed       = !container;
+    return pipeline;
+}
+
+/**
+ * Create a pipeline over elements of a vector. Vector must not be resized
+ * or have it's elements moved while pipeline is in use.
+ * */
+Pipeline pipeline_from_vector(Vector* vec) {
+    Pipeline pipeline = pipeline_from_source(PIPELINE_SOURCE_VIEW, vec, vec ? vec->element_size : 0);
+    ERR_RETURN_VALUE_IF_FAIL(vec, pipeline, ERR_INVALID_ARGUMENTS);
+
+    pipeline.view.element_size = vec->element_size;
+    pipeline.view.length       = vec->length;
+    pipeline.view.data         = vec->data;
+    return pipeline;
+}
+
+/**
+ * Create a pipeline over elements of a view.
+ * */
+Pipeline pipeline_from_view(VectorView view) {
+    Pipeline pipeline = pipeline_from_source(PIPELINE_SOURCE_VIEW, view.data, view.element_size);
+    ERR_RETURN_VALUE_IF_FAIL(view.element_size && (view.data || !view.length), pipeline, ERR_INVALID_ARGUMENTS);
+
+    pipeline.failed = False;
+    pipeline.view   = view;
+    return pipeline;
+}
+
+/**
+ * Create a pipeline over items of a dense map, in iteration order. Elements
+ * are item pointers, as returned by @c dense_map_iter_next.
+ * */
+Pipeline pipeline_from_dense_map(DenseMap* map) {
+    Pipeline pipeline = pipeline_from_source(PIPELINE_SOURCE_DENSE_MAP, map, sizeof(DenseMapItem*));
+    ERR_RETURN_VALUE_IF_FAIL(map, pipeline, ERR_INVALID_ARGUMENTS);
+    return pipeline;
+}
+
+/**
+ * Create a pipeline over items of a sparse map, in iteration order. Elements
+ * are item pointers, as returned by @c sparse_map_iter_next.
+ * */
+Pipeline pipeline_from_sparse_map(SparseMap* map) {
+    Pipeline pipeline = pipeline_from_source(PIPELINE_SOURCE_SPARSE_MAP, map, sizeof(SparseMapItem*));
+    ERR_RETURN_VALUE_IF_FAIL(map, pipeline, ERR_INVALID_ARGUMENTS);
+    return pipeline;
+}
+
+/**
+ * Create a pipeline over positions of set bits of a bitvector, in
+ * ascending order. Elements are @c Size values.
+ * */
+Pipeline pipeline_from_set_bits(BitVector* bv) {
+    Pipeline pipeline = pipeline_from_source(PIPELINE_SOURCE_SET_BITS, bv, sizeof(Size));
+    ERR_RETURN_VALUE_IF_FAIL(bv, pipeline, ERR_INVALID_ARGUMENTS);
+    return pipeline;
+}
+
+/**
+ * Add a stage to pipeline, unless it's already failed or full.
+ * @return New stage, or NULL on failure.
+ * */
+static PipelineStage* pipeline_push_stage(Pipeline* pipeline, PipelineStageKind kind, Size element_size) {
+    if(pipeline->failed) {
+        return NULL;
+    }
+
+    if(pipeline->stage_count == PIPELINE_MAX_STAGES) {
+        pipeline->failed = True;
+        ERR_RETURN_VALUE_IF_FAIL(False, NULL, ERR_INVALID_CAPACITY);
+    }
+
+    PipelineStage* stage = pipeline->stages + pipeline->stage_count++;
+    memset(stage, 0, sizeof(PipelineStage));
+    stage->kind            = kind;
+    stage->element_size    = element_size;
+    pipeline->element_size = element_size;
+    return stage;
+}
+
+/**
+ * Add a stage that replaces each element with output of @p map.
+ *
+ * @param pipeline
+ * @param element_size Size of elements written by @p map, at most 8 KB.
+ * @param map Writes an output element for each element.
+ * @param udata Passed to @p map.
+ * @return @p pipeline, for chaining.
+ * */
+Pipeline* pipeline_map(Pipeline* pipeline, Size element_size, MapElementCallback map, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(pipeline, NULL, ERR_INVALID_ARGUMENTS);
+    if(!map || !element_size || element_size > PIPELINE_CHUNK_BYTES) {
+        pipeline->failed = True;
+        ERR_RETURN_VALUE_IF_FAIL(False, pipeline, ERR_INVALID_ARGUMENTS);
+    }
+
+    PipelineStage* stage = pipeline_push_stage(pipeline, PIPELINE_STAGE_MAP, element_size);
+    if(stage) {
+        stage->callback = (void*)map;
+        stage->udata    = udata;
+    }
+    return pipeline;
+}
+
+/**
+ * Add a stage that lets only elements for which @p filter returns True through.
+ *
+ * @param pipeline
+ * @param filter Decides which elements to keep.
+ * @param udata Passed to @p filter.
+ * @return @p pipeline, for chaining.
+ * */
+Pipeline* pipeline_filter(Pipeline* pipeline, FilterElementCallback filter, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(pipeline, NULL, ERR_INVALID_ARGUMENTS);
+    if(!filter) {
+        pipeline->failed = True;
+        ERR_RETURN_VALUE_IF_FAIL(False, pipeline, ERR_INVALID_ARGUMENTS);
+    }
+
+    PipelineStage* stage = pipeline_push_stage(pipeline, PIPELINE_STAGE_FILTER, pipeline->element_size);
+    if(stage) {
+        stage->callback = (void*)filter;
+        stage->udata    = udata;
+    }
+    return pipeline;
+}
+
+/**
+ * Add a stage that lets only first @p count elements reaching it through.
+ * Source is not read any further once they have passed.
+ *
+ * @return @p pipeline, for chaining.
+ * */
+Pipeline* pipeline_take(Pipeline* pipeline, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(pipeline, NULL, ERR_INVALID_ARGUMENTS);
+
+    PipelineStage* stage = pipeline_push_stage(pipeline, PIPELINE_STAGE_TAKE, pipeline->element_size);
+    if(stage) {
+        stage->count = count;
+    }
+    return pipeline;
+}
+
+/**
+ * Add a numeric stage, if pipeline carries elements of given size.
+ * */
+static Pipeline* pipeline_push_kernel(Pipeline* pipeline, Size element_size, PipelineKernel kernel, const void* lo, const void* hi) {
+    ERR_RETURN_VALUE_IF_FAIL(pipeline, NULL, ERR_INVALID_ARGUMENTS);
+    if(!pipeline->failed && pipeline->element_size != element_size) {
+        pipeline->failed = True;
+        ERR_RETURN_VALUE_IF_FAIL(False, pipeline, ERR_TYPE_MISMATCH);
+    }
+
+    PipelineStage* stage = pipeline_push_stage(pipeline, PIPELINE_STAGE_NUMERIC, element_size);
+    if(stage) {
+        stage->kernel = kernel;
+        memcpy(stage->operands, lo, element_size);
+        memcpy(stage->operands + 1, hi, element_size);
+    }
+    return pipeline;
+}
+
+/* bits [64 * word, 64 * word + 64) of bitvector, with bits past it's length cleared */
+static FORCE_INLINE Uint64 pipeline_bits_word(BitVector* bv, Size word) {
+    Size   first = word * 64;
+    Size   bytes = MIN((bv->length - first + 7) / 8, 8);
+    Uint64 bits  = 0;
+    memcpy(&bits, bv->data + word * 8, bytes);
+    if(bv->length - first < 64) {
+        bits &= ((Uint64)1 << (bv->length - first)) - 1;
+    }
+    return bits;
+}
+
+/**
+ * Pull at most @p count next elements of source into chunk.
+ * @return Number of elements pulled, 0 once source is exhausted.
+ * */
+static Size pipeline_pull(Pipeline* pipeline, PipelineCursor* cursor, PipelineChunk* chunk, Size count) {
+    Size n = 0;
+
+    chunk->selection    = NULL;
+    chunk->data         = chunk->buffers[0];
+
+    switch(pipeline->source) {
+        case PIPELINE_SOURCE_VIEW : {
+            VectorView* view    = &pipeline->view;
+            n                   = MIN(count, view->length - cursor->position);
+            chunk->data         = view->data + cursor->position * view->element_size;
+            chunk->element_size = view->element_size;
+            cursor->position   += n;
+            break;
+        }
+
+        case PIPELINE_SOURCE_DENSE_MAP : {
+            DenseMapItem** items = (DenseMapItem**)chunk->data;
+            DenseMapItem*  item  = NULL;
+            while(n < count && (item = dense_map_iter_next(pipeline->container, &cursor->dense_iter))) {
+                items[n++] = item;
+            }
+            chunk->element_size = sizeof(DenseMapItem*);
+            break;
+        }
+
+        case PIPELINE_SOURCE_SPARSE_MAP : {
+            SparseMapItem** items = (SparseMapItem**)chunk->data;
+            SparseMapItem*  item  = NULL;
+            while(n < count && (item = sparse_map_iter_next(pipeline->container, &cursor->sparse_iter))) {
+                items[n++] = item;
+            }
+            chunk->element_size = sizeof(SparseMapItem*);
+            break;
+        }
+
+        case PIPELINE_SOURCE_SET_BITS : {
+            BitVector* bv        = pipeline->container;
+            Size*      positions = (Size*)chunk->data;
+            Size       words     = (bv->length + 63) / 64;
+            while(n < count) {
+                while(!cursor->word && cursor->position < words) {
+                    cursor->word = pipeline_bits_word(bv, cursor->position++);
+                }
+                if(!cursor->word) {
+                    break;
+                }
+                positions[n++] = (cursor->position - 1) * 64 + (Size)__builtin_ctzll(cursor->word);
+                cursor->word  &= cursor->word - 1;
+            }
+            chunk->element_size = sizeof(Size);
+            break;
+        }
+    }
+
+    chunk->live = n;
+    return n;
+}
+
+static void pipeline_map_chunk(PipelineStage* stage, PipelineChunk* chunk) {
+    MapElementCallback map = (MapElementCallback)stage->callback;
+    Byte*              out = pipeline_free_buffer(chunk);
+
+    for(Size i = 0; i < chunk->live; i++) {
+        map(out + i * stage->element_size, pipeline_value(pipeline_live_at(chunk, i), chunk->element_size), stage->udata);
+    }
+
+    chunk->data         = out;
+    chunk->element_size = stage->element_size;
+    chunk->selection    = NULL;
+}
+
+/* live positions are always written, and count of kept ones advances only for kept ones */
+static void pipeline_filter_chunk(PipelineStage* stage, PipelineChunk* chunk) {
+    FilterElementCallback filter    = (FilterElementCallback)stage->callback;
+    Uint16*               selection = chunk->positions;
+    Size                  kept      = 0;
+
+    for(Size i = 0; i < chunk->live; i++) {
+        Uint16 pos      = chunk->selection ? chunk->selection[i] : (Uint16)i;
+        selection[kept] = pos;
+        kept           += filter(pipeline_value(chunk->data + pos * chunk->element_size, chunk->element_size), stage->udata) != 0;
+    }
+
+    /* a chunk that lost nothing stays without a selection */
+    if(kept != chunk->live || chunk->selection) {
+        chunk->selection = selection;
+    }
+    chunk->live = kept;
+}
+
+/**
+ * Run pipeline, handing every chunk with live elements left after last
+ * stage to @p sink.
+ * @return False if pipeline failed to build.
+ * */
+static Bool pipeline_run(Pipeline* pipeline, PipelineSink sink, void* ctx) {
+    ERR_RETURN_VALUE_IF_FAIL(pipeline, False, ERR_INVALID_ARGUMENTS);
+
+    /* error was already reported by stage that failed */
+    if(pipeline->failed) {
+        return False;
+    }
+
+    Uint64        buffers[2][PIPELINE_CHUNK];
+    PipelineChunk chunk;
+    chunk.buffers[0] = (Byte*)buffers[0];
+    chunk.buffers[1] = (Byte*)buffers[1];
+
+    /* every element written to a buffer must fit, so chunks hold as many of widest ones as fit */
+    Size remaining[PIPELINE_MAX_STAGES];
+    Size widest = pipeline->source == PIPELINE_SOURCE_VIEW ? pipeline->view.element_size : sizeof(Size);
+    for(Size s = 0; s < pipeline->stage_count; s++) {
+        PipelineStage* stage = pipeline->stages + s;
+        if(stage->kind == PIPELINE_STAGE_TAKE && !stage->count) {
+            return True;
+        }
+        remaining[s] = stage->count;
+        widest       = MAX(widest, stage->element_size);
+    }
+    Size count = MIN(MAX(PIPELINE_CHUNK_BYTES / widest, 1), PIPELINE_CHUNK);
+
+    PipelineCursor cursor;
+    memset(&cursor, 0, sizeof(cursor));
+    while(pipeline_pull(pipeline, &cursor, &chunk, count)) {
+        Bool done = False;
+
+        for(Size s = 0; s < pipeline->stage_count && chunk.live; s++) {
+            PipelineStage* stage = pipeline->stages + s;
+            switch(stage->kind) {
+                case PIPELINE_STAGE_MAP :
+                    pipeline_map_chunk(stage, &chunk);
+                    break;
+
+                case PIPELINE_STAGE_FILTER :
+                    pipeline_filter_chunk(stage, &chunk);
+                    break;
+
+                case PIPELINE_STAGE_TAKE :
+                    if(chunk.live >= remaining[s]) {
+                        chunk.live = remaining[s];
+                        done       = True;
+                    }
+                    remaining[s] -= chunk.live;
+                    break;
+
+                case PIPELINE_STAGE_NUMERIC :
+                    stage->kernel(stage, &chunk);
+                    break;
+            }
+        }
+
+        if(chunk.live) {
+            sink(&chunk, ctx);
+        }
+
+        if(done) {
+            break;
+        }
+    }
+
+    return True;
+}
+
+static void pipeline_count_sink(PipelineChunk* chunk, void* ctx) {
+    *(Size*)ctx += chunk->live;
+}
+
+/**
+ * Count elements coming out of pipeline.
+ * */
+Size pipeline_count(Pipeline* pipeline) {
+    Size count = 0;
+    pipeline_run(pipeline, pipeline_count_sink, &count);
+    return count;
+}
+
+typedef struct PipelineReduce {
+    void*                 acc;
+    ReduceElementCallback reduce;
+    void*                 udata;
+} PipelineReduce;
+
+static void pipeline_reduce_sink(PipelineChunk* chunk, void* ctx) {
+    PipelineReduce* r = ctx;
+    for(Size i = 0; i < chunk->live; i++) {
+        r->reduce(r->acc, pipeline_value(pipeline_live_at(chunk, i), chunk->element_size), r->udata);
+    }
+}
+
+/**
+ * Fold elements coming out of pipeline into @p acc, in order.
+ *
+ * @param pipeline
+ * @param acc Accumulator, initialized by caller.
+ * @param reduce Called with @p acc and each element.
+ * @param udata Passed to @p reduce.
+ * */
+void pipeline_reduce(Pipeline* pipeline, void* acc, ReduceElementCallback reduce, void* udata) {
+    ERR_RETURN_IF_FAIL(reduce, ERR_INVALID_ARGUMENTS);
+
+    PipelineReduce r = {acc, reduce, udata};
+    pipeline_run(pipeline, pipeline_reduce_sink, &r);
+}
+
+typedef struct PipelineCollect {
+    Vector* out;
+    void*   udata;
+    Size    count;
+} PipelineCollect;
+
+static void pipeline_collect_sink(PipelineChunk* chunk, void* ctx) {
+    PipelineCollect* c = ctx;
+    if(chunk->selection) {
+        for(Size i = 0; i < chunk->live; i++) {
+            vector_push_back(c->out, pipeline_value(pipeline_live_at(chunk, i), chunk->element_size), c->udata);
+        }
+    } else {
+        vector_push_back_n(c->out, chunk->data, chunk->live, c->udata);
+    }
+    c->count += chunk->live;
+}
+
+/**
+ * Append elements coming out of pipeline to a vector, using it's copy
+ * constructor if set. This is the only reduction that allocates memory.
+ *
+ * @param pipeline
+ * @param out Vector with same element size as output of pipeline.
+ * @param udata Passed to copy constructor of @p out.
+ * @return Number of elements appended.
+ * */
+Size pipeline_collect(Pipeline* pipeline, Vector* out, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(pipeline && out, 0, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(out->element_size == pipeline->element_size, 0, ERR_TYPE_MISMATCH);
+
+    PipelineCollect c = {out, udata, 0};
+    pipeline_run(pipeline, pipeline_collect_sink, &c);
+    return c.count;
+}
+
+/* arithmetic and range checks of numeric kernels, integers wrap around in unsigned type of same size */
+#define PIPELINE_INT_ADD(utype, x, v)              ((utype)((utype)(x) + (utype)(v)))
+#define PIPELINE_INT_MUL(utype, x, v)              ((utype)(1u * (utype)(x) * (utype)(v)))
+#define PIPELINE_INT_IN_RANGE(utype, x, lo, hi)    ((utype)((utype)(x) - (utype)(lo)) <= (utype)((utype)(hi) - (utype)(lo)))
+#define PIPELINE_INT_BEFORE(type, v)               ((type)((v) - 1))
+#define PIPELINE_F32_ADD(utype, x, v)              ((x) + (v))
+#define PIPELINE_F32_MUL(utype, x, v)              ((x) * (v))
+#define PIPELINE_F32_IN_RANGE(utype, x, lo, hi)    (((x) >= (lo)) & ((x) <= (hi)))
+#define PIPELINE_F32_BEFORE(type, v)               nextafterf(v, -INFINITY)
+#define PIPELINE_F64_ADD                           PIPELINE_F32_ADD
+#define PIPELINE_F64_MUL                           PIPELINE_F32_MUL
+#define PIPELINE_F64_IN_RANGE                      PIPELINE_F32_IN_RANGE
+#define PIPELINE_F64_BEFORE(type, v)               nextafter(v, -INFINITY)
+
+/**
+ * Define numeric stages and reductions for a type. Kernels gather live
+ * elements of a chunk into a dense array first, if a filter left a
+ * selection, so that every loop here runs over plain arrays.
+ *
+ * @param sfx Suffix of generated function names (eg: u32).
+ * @param type Type of elements.
+ * @param utype Unsigned integer type of same size as @p type, @p type itself for floats.
+ * @param sum_type Type sums are accumulated in.
+ * @param lowest Smallest value of @p type, nothing is less than it.
+ * @param ops INT, F32 or F64, picks arithmetic and range checks above.
+ * */
+#define DEF_NUMERIC_PIPELINE(sfx, type, utype, sum_type, lowest, ops)   \
+    static type* sfx##_pipeline_dense(PipelineChunk* chunk) {           \
+        if(chunk->selection) {                                          \
+            const type* in  = (const type*)chunk->data;                 \
+            type*       out = (type*)pipeline_free_buffer(chunk);       \
+            for(Size i = 0; i < chunk->live; i++) {                     \
+                out[i] = in[chunk->selection[i]];                       \
+            }                                                           \
+            chunk->data      = (Byte*)out;                              \
+            chunk->selection = NULL;                                    \
+        }                                                               \
+        return (type*)chunk->data;                                      \
+    }                                                                   \
+                                                                        \
+    static void sfx##_pipeline_add_kernel(PipelineStage* stage, PipelineChunk* chunk) { \
+        type v;                                                         \
+        memcpy(&v, stage->operands, sizeof(type));                      \
+        const type* in  = sfx##_pipeline_dense(chunk);                  \
+        type*       out = (type*)pipeline_output(chunk);                \
+        for(Size i = 0; i < chunk->live; i++) {                         \
+            out[i] = (type)PIPELINE_##ops##_ADD(utype, in[i], v);       \
+        }                                                               \
+        chunk->data = (Byte*)out;                                       \
+    }                                                                   \
+                                                                        \
+    static void sfx##_pipeline_mul_kernel(PipelineStage* stage, PipelineChunk* chunk) { \
+        type v;                                                         \
+        memcpy(&v, stage->operands, sizeof(type));                      \
+        const type* in  = sfx##_pipeline_dense(chunk);                  \
+        type*       out = (type*)pipeline_output(chunk);                \
+        for(Size i = 0; i < chunk->live; i++) {                         \
+            out[i] = (type)PIPELINE_##ops##_MUL(utype, in[i], v);       \
+        }                                                               \
+        chunk->data = (Byte*)out;                                       \
+    }                                                                   \
+                                                                        \
+    /* elements are always written, and output advances only for kept ones */ \
+    static void sfx##_pipeline_retain_kernel(PipelineStage* stage, PipelineChunk* chunk) { \
+        type lo, hi;                                                    \
+        memcpy(&lo, stage->operands, sizeof(type));                     \
+        memcpy(&hi, stage->operands + 1, sizeof(type));                 \
+        const type* in   = sfx##_pipeline_dense(chunk);                 \
+        type*       out  = (type*)pipeline_output(chunk);               \
+        Size        kept = 0;                                           \
+        for(Size i = 0; i < chunk->live; i++) {                         \
+            type x    = in[i];                                          \
+            out[kept] = x;                                              \
+            kept     += PIPELINE_##ops##_IN_RANGE(utype, x, lo, hi);    \
+        }                                                               \
+        chunk->data = (Byte*)out;                                       \
+        chunk->live = kept;                                             \
+    }                                                                   \
+                                                                        \
+    Pipeline* pipeline_add_##sfx(Pipeline* pipeline, type value) {      \
+        return pipeline_push_kernel(pipeline, sizeof(type), sfx##_pipeline_add_kernel, &value, &value); \
+    }                                                                   \
+                                                                        \
+    Pipeline* pipeline_mul_##sfx(Pipeline* pipeline, type value) {      \
+        return pipeline_push_kernel(pipeline, sizeof(type), sfx##_pipeline_mul_kernel, &value, &value); \
+    }                                                                   \
+                                                                        \
+    Pipeline* pipeline_retain_in_range_##sfx(Pipeline* pipeline, type lo, type hi) { \
+        /* an empty range lets nothing through, just like taking nothing */ \
+        if(!(lo <= hi)) {                                               \
+            return pipeline_take(pipeline, 0);                          \
+        }                                                               \
+        return pipeline_push_kernel(pipeline, sizeof(type), sfx##_pipeline_retain_kernel, &lo, &hi); \
+    }                                                                   \
+                                                                        \
+    Pipeline* pipeline_retain_eq_##sfx(Pipeline* pipeline, type value) { \
+        return pipeline_retain_in_range_##sfx(pipeline, value, value);  \
+    }                                                                   \
+                                                                        \
+    Pipeline* pipeline_retain_lt_##sfx(Pipeline* pipeline, type value) { \
+        /* nothing is less than lowest value */                         \
+        if(!(value > (type)(lowest))) {                                 \
+            return pipeline_take(pipeline, 0);                          \
+        }                                                               \
+        return pipeline_retain_in_range_##sfx(pipeline, (type)(lowest), PIPELINE_##ops##_BEFORE(type, value)); \
+    }                                                                   \
+                                                                        \
+    static void sfx##_pipeline_sum_sink(PipelineChunk* chunk, void* ctx) { \
+        const type* in  = sfx##_pipeline_dense(chunk);                  \
+        sum_type    sum = 0;                                            \
+        for(Size i = 0; i < chunk->live; i++) {                         \
+            sum += in[i];                                               \
+        }                                                               \
+        *(sum_type*)ctx += sum;                                         \
+    }                                                                   \
+                                                                        \
+    sum_type pipeline_sum_##sfx(Pipeline* pipeline) {                   \
+        ERR_RETURN_VALUE_IF_FAIL(pipeline, 0, ERR_INVALID_ARGUMENTS);   \
+        ERR_RETURN_VALUE_IF_FAIL(pipeline->element_size == sizeof(type), 0, ERR_TYPE_MISMATCH); \
+        sum_type sum = 0;                                               \
+        pipeline_run(pipeline, sfx##_pipeline_sum_sink, &sum);          \
+        return sum;                                                     \
+    }                                                                   \
+                                                                        \
+    typedef struct sfx##_PipelineExtreme {                              \
+        type value;                                                     \
+        Bool found;                                                     \
+    } sfx##_PipelineExtreme;                                            \
+                                                                        \
+    static void sfx##_pipeline_min_sink(PipelineChunk* chunk, void* ctx) { \
+        sfx##_PipelineExtreme* e  = ctx;                                \
+        const type*            in = sfx##_pipeline_dense(chunk);        \
+        type                   m  = e->found ? e->value : in[0];        \
+        for(Size i = 0; i < chunk->live; i++) {                         \
+            m = in[i] < m ? in[i] : m;                                  \
+        }                                                               \
+        e->value = m;                                                   \
+        e->found = True;                                                \
+    }                                                                   \
+                                                                        \
+    static void sfx##_pipeline_max_sink(PipelineChunk* chunk, void* ctx) { \
+        sfx##_PipelineExtreme* e  = ctx;                                \
+        const type*            in = sfx##_pipeline_dense(chunk);        \
+        type                   m  = e->found ? e->value : in[0];        \
+        for(Size i = 0; i < chunk->live; i++) {                         \
+            m = in[i] > m ? in[i] : m;                                  \
+        }                                                               \
+        e->value = m;                                                   \
+        e->found = True;                                                \
+    }                                                                   \
+                                                                        \
+    Bool pipeline_min_##sfx(Pipeline* pipeline, type* out) {            \
+        ERR_RETURN_VALUE_IF_FAIL(pipeline && out, False, ERR_INVALID_ARGUMENTS); \
+        ERR_RETURN_VALUE_IF_FAIL(pipeline->element_size == sizeof(type), False, ERR_TYPE_MISMATCH); \
+        sfx##_PipelineExtreme e = {0};                                  \
+        pipeline_run(pipeline, sfx##_pipeline_min_sink, &e);            \
+        if(e.found) {                                                   \
+            *out = e.value;                                             \
+        }                                                               \
+        return e.found;                                                 \
+    }                                                                   \
+                                                                        \
+    Bool pipeline_max_##sfx(Pipeline* pipeline, type* out) {            \
+        ERR_RETURN_VALUE_IF_FAIL(pipeline && out, False, ERR_INVALID_ARGUMENTS); \
+        ERR_RETURN_VALUE_IF_FAIL(pipeline->element_size == sizeof(type), False, ERR_TYPE_MISMATCH); \
+        sfx##_PipelineExtreme e = {0};                                  \
+        pipeline_run(pipeline, sfx##_pipeline_max_sink, &e);            \
+        if(e.found) {                                                   \
+            *out = e.value;                                             \
+        }                                                               \
+        return e.found;                                                 \
+    }
+
+DEF_NUMERIC_PIPELINE(u8,  Uint8,   Uint8,   Uint64,  0,         INT);
+DEF_NUMERIC_PIPELINE(u16, Uint16,  Uint16,  Uint64,  0,         INT);
+DEF_NUMERIC_PIPELINE(u32, Uint32,  Uint32,  Uint64,  0,         INT);
+DEF_NUMERIC_PIPELINE(u64, Uint64,  Uint64,  Uint64,  0,         INT);
+DEF_NUMERIC_PIPELINE(i8,  Int8,    Uint8,   Int64,   INT8_MIN,  INT);
+DEF_NUMERIC_PIPELINE(i16, Int16,   Uint16,  Int64,   INT16_MIN, INT);
+DEF_NUMERIC_PIPELINE(i32, Int32,   Uint32,  Int64,   INT32_MIN, INT);
+DEF_NUMERIC_PIPELINE(i64, Int64,   Uint64,  Int64,   INT64_MIN, INT);
+DEF_NUMERIC_PIPELINE(f32, Float32, Float32, Float64, -INFINITY, F32);
+DEF_NUMERIC_PIPELINE(f64, Float64, Float64, Float64, -INFINITY, F64);
+
+#undef DEF_NUMERIC_PIPELINE
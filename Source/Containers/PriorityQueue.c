@@ -0,0 +1,438 @@
+/**
+ * @file PriorityQueue.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of 4-ary heap backed priority queue.
+ * */
+
+#include <Anvie/Containers/PriorityQueue.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* number of children of each node, children of node i are at [4i + 1, 4i + 4] */
+#define PQ_ARITY 4
+#define PQ_PARENT(pos) (((pos) - 1) / PQ_ARITY)
+#define PQ_FIRST_CHILD(pos) ((pos) * PQ_ARITY + 1)
+
+#define PQ_ELEM(heap, pos) vector_address_at(heap, pos)
+
+/**
+ * Get value to be passed to compare function for element at given address.
+ * Follows same convention as @c vector_peek.
+ * */
+static FORCE_INLINE void* pq_value(const Byte* p, Size element_size) {
+    switch(element_size) {
+        case 8: { Uint64 v; memcpy(&v, p, 8); return (void*)v; }
+        case 4: { Uint32 v; memcpy(&v, p, 4); return (void*)(Uint64)v; }
+        case 2: { Uint16 v; memcpy(&v, p, 2); return (void*)(Uint64)v; }
+        case 1: return (void*)(Uint64)*(const Uint8*)p;
+        default: return (void*)p;
+    }
+}
+
+/* true when element at a must be above element at b */
+static FORCE_INLINE Bool pq_before(PriorityQueue* pq, const Byte* a, const Byte* b) {
+    Size element_size = pq->heap->element_size;
+    return pq->compare(pq_value(a, element_size), pq_value(b, element_size), pq->udata) > 0;
+}
+
+/**
+ * Move element at @p pos up until it's parent is not below it.
+ * @param tmp Space for one element.
+ * */
+static void pq_sift_up(PriorityQueue* pq, Size pos, Byte* tmp) {
+    Vector* heap         = pq->heap;
+    Size    element_size = heap->element_size;
+
+    memcpy(tmp, PQ_ELEM(heap, pos), element_size);
+    while(pos) {
+        Size parent = PQ_PARENT(pos);
+        if(!pq_before(pq, tmp, PQ_ELEM(heap, parent))) break;
+        memcpy(PQ_ELEM(heap, pos), PQ_ELEM(heap, parent), element_size);
+        pos = parent;
+    }
+    memcpy(PQ_ELEM(heap, pos), tmp, element_size);
+}
+
+/**
+ * Place @p elem at @p pos, or below it, moving children that must be above
+ * it up on the way. @p elem must not point into heap.
+ * */
+static void pq_sift_down(PriorityQueue* pq, Size pos, const Byte* elem, Size length) {
+    Vector* heap         = pq->heap;
+    Size    element_size = heap->element_size;
+
+    for(;;) {
+        Size first = PQ_FIRST_CHILD(pos);
+        if(first >= length) break;
+
+        Size last = MIN(first + PQ_ARITY, length);
+        Size best = first;
+        for(Size child = first + 1; child < last; child++) {
+            if(pq_before(pq, PQ_ELEM(heap, child), PQ_ELEM(heap, best))) best = child;
+        }
+
+        if(!pq_before(pq, PQ_ELEM(heap, best), elem)) break;
+        memcpy(PQ_ELEM(heap, pos), PQ_ELEM(heap, best), element_size);
+        pos = best;
+    }
+    memcpy(PQ_ELEM(heap, pos), elem, element_size);
+}
+
+/* bottom up heap construction, O(n) */
+static void pq_heapify(PriorityQueue* pq) {
+    Vector* heap = pq->heap;
+    if(heap->length < 2) return;
+
+    Byte tmp[heap->element_size];
+    for(Size pos = PQ_PARENT(heap->length - 1) + 1; pos > 0; pos--) {
+        memcpy(tmp, PQ_ELEM(heap, pos - 1), heap->element_size);
+        pq_sift_down(pq, pos - 1, tmp, heap->length);
+    }
+}
+
+/* create queue object around given heap vector */
+static PriorityQueue* pq_wrap(Vector* heap, CompareElementCallback compare, void* udata, Bool descending) {
+    PriorityQueue* pq = allocator_allocate_zeroed(heap->allocator, sizeof(PriorityQueue));
+    ERR_RETURN_VALUE_IF_FAIL(pq, NULL, ERR_OUT_OF_MEMORY);
+
+    pq->heap       = heap;
+    pq->compare    = compare;
+    pq->udata      = udata;
+    pq->descending = descending;
+    return pq;
+}
+
+/**
+ * Create a new priority queue.
+ * @param element_size Size of each element.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @param compare Compare function, element a is above b if compare(a, b) > 0.
+ * @param udata User data passed to all callbacks.
+ * @return PriorityQueue* or NULL if allocation failed.
+ * */
+PriorityQueue* priority_queue_create(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy, CompareElementCallback compare, void* udata) {
+    return priority_queue_create_with_allocator(element_size, create_copy, destroy_copy, compare, udata, NULL);
+}
+
+/**
+ * Create a new priority queue that allocates all of it's memory from
+ * given allocator.
+ * @param element_size Size of each element.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @param compare Compare function, element a is above b if compare(a, b) > 0.
+ * @param udata User data passed to all callbacks.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return PriorityQueue* or NULL if allocation failed.
+ * */
+PriorityQueue* priority_queue_create_with_allocator(Size element_size, CreateElementCopyCallback create_copy, DestroyElementCopyCallback destroy_copy, CompareElementCallback compare, void* udata, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(compare, NULL, ERR_INVALID_ARGUMENTS);
+
+    Vector* heap = vector_create_with_allocator(element_size, create_copy, destroy_copy, allocator);
+    if(!heap) return NULL;
+
+    PriorityQueue* pq = pq_wrap(heap, compare, udata, False);
+    if(!pq) vector_destroy(heap, udata);
+    return pq;
+}
+
+/**
+ * Create a priority queue out of all elements of given vector, in O(n).
+ * Queue takes ownership of @p vec and uses it as it's heap, so @p vec
+ * must not be used or destroyed by caller after this.
+ * @param vec
+ * @param compare Compare function, element a is above b if compare(a, b) > 0.
+ * @param udata User data passed to all callbacks.
+ * @return PriorityQueue* or NULL if allocation failed, in which case
+ * caller still owns @p vec.
+ * */
+PriorityQueue* priority_queue_from_vector(Vector* vec, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && compare, NULL, ERR_INVALID_ARGUMENTS);
+
+    PriorityQueue* pq = pq_wrap(vec, compare, udata, False);
+    if(pq) pq_heapify(pq);
+    return pq;
+}
+
+/**
+ * Destroy given priority queue and all elements in it.
+ * @param pq
+ * */
+void priority_queue_destroy(PriorityQueue* pq) {
+    ERR_RETURN_IF_FAIL(pq, ERR_INVALID_ARGUMENTS);
+
+    Allocator* allocator = pq->heap->allocator;
+    vector_destroy(pq->heap, pq->udata);
+    allocator_free(allocator, pq, sizeof(PriorityQueue));
+}
+
+/**
+ * Remove and destroy all elements, keeping capacity.
+ * @param pq
+ * */
+void priority_queue_clear(PriorityQueue* pq) {
+    ERR_RETURN_IF_FAIL(pq, ERR_INVALID_ARGUMENTS);
+    vector_clear(pq->heap, pq->udata);
+}
+
+/**
+ * Make space for at least @p capacity elements.
+ * @param pq
+ * @param capacity
+ * */
+void priority_queue_reserve(PriorityQueue* pq, Size capacity) {
+    ERR_RETURN_IF_FAIL(pq, ERR_INVALID_ARGUMENTS);
+    vector_reserve(pq->heap, capacity);
+}
+
+/**
+ * Insert an element, in O(log n).
+ * @param pq
+ * @param data Value or pointer to element, same as @c vector_push_back.
+ * */
+void priority_queue_push(PriorityQueue* pq, void* data) {
+    ERR_RETURN_IF_FAIL(pq && pq->compare, ERR_INVALID_ARGUMENTS);
+
+    Vector* heap   = pq->heap;
+    Size    length = heap->length;
+    vector_push_back(heap, data, pq->udata);
+    if(heap->length == length) return;
+
+    Byte tmp[heap->element_size];
+    pq_sift_up(pq, length, tmp);
+}
+
+/**
+ * Get element on top without removing it.
+ * @param pq
+ * @return Value or reference of top element, same as @c vector_peek,
+ * or NULL if queue is empty.
+ * */
+void* priority_queue_peek(PriorityQueue* pq) {
+    ERR_RETURN_VALUE_IF_FAIL(pq, NULL, ERR_INVALID_ARGUMENTS);
+    return vector_peek(pq->heap, 0);
+}
+
+/**
+ * Remove element on top, in O(log n).
+ * @param pq
+ * @param out Where removed element is copied to, must have space for one
+ * element. If NULL, removed element is destroyed.
+ * @return False if queue is empty, True otherwise.
+ * */
+Bool priority_queue_pop(PriorityQueue* pq, void* out) {
+    ERR_RETURN_VALUE_IF_FAIL(pq && pq->compare, False, ERR_INVALID_ARGUMENTS);
+
+    Vector* heap = pq->heap;
+    if(!heap->length) return False;
+
+    if(out) memcpy(out, PQ_ELEM(heap, 0), heap->element_size);
+    else if(heap->destroy_copy) heap->destroy_copy(PQ_ELEM(heap, 0), pq->udata);
+
+    Size length = --heap->length;
+    if(length) {
+        Byte tmp[heap->element_size];
+        memcpy(tmp, PQ_ELEM(heap, length), heap->element_size);
+        pq_sift_down(pq, 0, tmp, length);
+    }
+    return True;
+}
+
+/**
+ * Remove element on top and insert a new one, with a single sift down.
+ * This is cheaper than a pop followed by a push, and is how a bounded
+ * queue keeps best k elements.
+ * @param pq
+ * @param data Value or pointer to new element, same as @c vector_push_back.
+ * @param out Where removed element is copied to, must have space for one
+ * element. If NULL, removed element is destroyed.
+ * @return False if queue is empty, in which case nothing is inserted.
+ * */
+Bool priority_queue_replace_top(PriorityQueue* pq, void* data, void* out) {
+    ERR_RETURN_VALUE_IF_FAIL(pq && pq->compare, False, ERR_INVALID_ARGUMENTS);
+
+    Vector* heap   = pq->heap;
+    Size    length = heap->length;
+    if(!length) return False;
+
+    /* new element is copied in at the end, using copy callbacks of heap, and then taken back out */
+    vector_push_back(heap, data, pq->udata);
+    if(heap->length == length) return False;
+    heap->length = length;
+
+    Byte tmp[heap->element_size];
+    memcpy(tmp, PQ_ELEM(heap, length), heap->element_size);
+
+    if(out) memcpy(out, PQ_ELEM(heap, 0), heap->element_size);
+    else if(heap->destroy_copy) heap->destroy_copy(PQ_ELEM(heap, 0), pq->udata);
+
+    pq_sift_down(pq, 0, tmp, length);
+    return True;
+}
+
+/* convert bit pattern of a value to an unsigned key, that orders same as the value */
+#define UNSIGNED_PQ_KEY(k, utype) (k)
+#define SIGNED_PQ_KEY(k, utype) ((k) ^ ((utype)1 << (sizeof(utype) * 8 - 1)))
+#define FLOAT_PQ_KEY(k, utype) ((k) ^ (((k) >> (sizeof(utype) * 8 - 1)) ? (utype)~(utype)0 : \
+                                       ((utype)1 << (sizeof(utype) * 8 - 1))))
+
+/**
+ * Define numeric priority queue operations for a numeric type.
+ * Each element is mapped to an unsigned key, flipped for descending
+ * queues, so element with smallest key is always on top, and sifts
+ * only ever compare unsigned integers.
+ *
+ * @param sfx Suffix for generated functions.
+ * @param type Type of elements in queue.
+ * @param utype Unsigned integer type of same size as @p type.
+ * @param to_key One of UNSIGNED_PQ_KEY, SIGNED_PQ_KEY or FLOAT_PQ_KEY.
+ * */
+#define DEF_NUMERIC_PRIORITY_QUEUE(sfx, type, utype, to_key)           \
+    static FORCE_INLINE utype sfx##_pq_key(type v, Bool descending) {   \
+        utype k;                                                        \
+        memcpy(&k, &v, sizeof(utype));                                  \
+        k = (utype)to_key(k, utype);                                    \
+        return descending ? (utype)~k : k;                              \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void sfx##_pq_sift_up(type* data, Size pos, Bool descending) { \
+        type  v = data[pos];                                            \
+        utype k = sfx##_pq_key(v, descending);                          \
+        while(pos) {                                                    \
+            Size parent = PQ_PARENT(pos);                               \
+            if(!(k < sfx##_pq_key(data[parent], descending))) break;    \
+            data[pos] = data[parent];                                   \
+            pos       = parent;                                         \
+        }                                                               \
+        data[pos] = v;                                                  \
+    }                                                                   \
+                                                                        \
+    static FORCE_INLINE void sfx##_pq_sift_down(type* data, Size pos, type v, Size length, Bool descending) { \
+        utype k = sfx##_pq_key(v, descending);                          \
+        for(;;) {                                                       \
+            Size first = PQ_FIRST_CHILD(pos);                           \
+            if(first >= length) break;                                  \
+                                                                        \
+            Size  last     = MIN(first + PQ_ARITY, length);             \
+            Size  best     = first;                                     \
+            utype best_key = sfx##_pq_key(data[first], descending);     \
+            for(Size child = first + 1; child < last; child++) {        \
+                utype child_key = sfx##_pq_key(data[child], descending); \
+                if(child_key < best_key) {                              \
+                    best     = child;                                   \
+                    best_key = child_key;                               \
+                }                                                       \
+            }                                                           \
+                                                                        \
+            if(!(best_key < k)) break;                                  \
+            data[pos] = data[best];                                     \
+            pos       = best;                                           \
+        }                                                               \
+        data[pos] = v;                                                  \
+    }                                                                   \
+                                                                        \
+    /**
+     * Create a numeric priority queue.
+     * @param descending Keep largest element on top if True, smallest otherwise.
+     * @param allocator Allocator to use. NULL means system allocator.
+     * @return PriorityQueue* or NULL if allocation failed.
+     * */                                                               \
+    PriorityQueue* priority_queue_create_##sfx(Bool descending, Allocator* allocator) { \
+        Vector* heap = vector_create_with_allocator(sizeof(type), NULL, NULL, allocator); \
+        if(!heap) return NULL;                                          \
+                                                                        \
+        PriorityQueue* pq = pq_wrap(heap, NULL, NULL, descending);      \
+        if(!pq) vector_destroy(heap, NULL);                             \
+        return pq;                                                      \
+    }                                                                   \
+                                                                        \
+    /**
+     * Create a numeric priority queue out of all elements of given vector,
+     * in O(n). Queue takes ownership of @p vec.
+     * @param vec
+     * @param descending Keep largest element on top if True, smallest otherwise.
+     * @return PriorityQueue* or NULL if allocation failed, in which case
+     * caller still owns @p vec.
+     * */                                                               \
+    PriorityQueue* priority_queue_from_vector_##sfx(Vector* vec, Bool descending) { \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type), NULL, ERR_INVALID_ARGUMENTS); \
+                                                                        \
+        PriorityQueue* pq = pq_wrap(vec, NULL, NULL, descending);       \
+        if(!pq) return NULL;                                            \
+                                                                        \
+        type* data   = (type*)vec->data;                                \
+        Size  length = vec->length;                                     \
+        for(Size pos = length > 1 ? PQ_PARENT(length - 1) + 1 : 0; pos > 0; pos--) { \
+            sfx##_pq_sift_down(data, pos - 1, data[pos - 1], length, descending); \
+        }                                                               \
+        return pq;                                                      \
+    }                                                                   \
+                                                                        \
+    void priority_queue_push_##sfx(PriorityQueue* pq, type value) {     \
+        ERR_RETURN_IF_FAIL(pq && pq->heap->element_size == sizeof(type), ERR_INVALID_ARGUMENTS); \
+                                                                        \
+        /* a zero is appended, so that heap grows by it's growth policy */ \
+        Vector* heap   = pq->heap;                                      \
+        Size    length = heap->length;                                  \
+        vector_push_back(heap, NULL, NULL);                             \
+        if(heap->length == length) return;                              \
+                                                                        \
+        ((type*)heap->data)[length] = value;                            \
+        sfx##_pq_sift_up((type*)heap->data, length, pq->descending);    \
+    }                                                                   \
+                                                                        \
+    Bool priority_queue_pop_##sfx(PriorityQueue* pq, type* out) {       \
+        ERR_RETURN_VALUE_IF_FAIL(pq && pq->heap->element_size == sizeof(type), False, ERR_INVALID_ARGUMENTS); \
+                                                                        \
+        Vector* heap = pq->heap;                                        \
+        if(!heap->length) return False;                                 \
+                                                                        \
+        type* data = (type*)heap->data;                                 \
+        if(out) *out = data[0];                                         \
+        Size length = --heap->length;                                   \
+        if(length) sfx##_pq_sift_down(data, 0, data[length], length, pq->descending); \
+        return True;                                                    \
+    }                                                                   \
+                                                                        \
+    Bool priority_queue_replace_top_##sfx(PriorityQueue* pq, type value, type* out) { \
+        ERR_RETURN_VALUE_IF_FAIL(pq && pq->heap->element_size == sizeof(type), False, ERR_INVALID_ARGUMENTS); \
+                                                                        \
+        Vector* heap = pq->heap;                                        \
+        if(!heap->length) return False;                                 \
+                                                                        \
+        type* data = (type*)heap->data;                                 \
+        if(out) *out = data[0];                                         \
+        sfx##_pq_sift_down(data, 0, value, heap->length, pq->descending); \
+        return True;                                                    \
+    }
+
+DEF_NUMERIC_PRIORITY_QUEUE(u8,  Uint8,   Uint8,  UNSIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(u16, Uint16,  Uint16, UNSIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(u32, Uint32,  Uint32, UNSIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(u64, Uint64,  Uint64, UNSIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(i8,  Int8,    Uint8,  SIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(i16, Int16,   Uint16, SIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(i32, Int32,   Uint32, SIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(i64, Int64,   Uint64, SIGNED_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(f32, Float32, Uint32, FLOAT_PQ_KEY)
+DEF_NUMERIC_PRIORITY_QUEUE(f64, Float64, Uint64, FLOAT_PQ_KEY)
+
+#undef DEF_NUMERIC_PRIORITY_QUEUE
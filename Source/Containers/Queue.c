@@ -0,0 +1,455 @@
+/**
+ * @file Queue.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Lock-free single producer single consumer ring queue, and
+ * Vyukov's bounded multi producer multi consumer queue.
+ * */
+
+#include <Anvie/Containers/Queue.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+#include <string.h>
+
+/* round value up to a multiple of a power of two */
+#define ALIGN_UP(value, align) (((value) + (align) - 1) & ~((Size)(align) - 1))
+
+#define LOAD_RELAXED(p) __atomic_load_n(p, __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+/* copy one element, with common sizes copied by a single load and store */
+static FORCE_INLINE void copy_element(void* dst, const void* src, Size size) {
+    switch(size) {
+        case 8: memcpy(dst, src, 8); break;
+        case 4: memcpy(dst, src, 4); break;
+        case 2: memcpy(dst, src, 2); break;
+        case 1: memcpy(dst, src, 1); break;
+        default: memcpy(dst, src, size); break;
+    }
+}
+
+/**
+ * Allocate memory for a queue and it's slots, with queue aligned to a cache line.
+ * @param header_size Size of queue struct, a multiple of cache line size.
+ * @param slots_size Size of all slots.
+ * @param memory_size Set to size of returned allocation.
+ * @return Allocation, queue is at first cache line boundary in it. NULL on failure.
+ * */
+static void* allocate_queue_memory(Size header_size, Size slots_size, Allocator* allocator, Size* memory_size) {
+    // allocator may not align to cache lines, so over allocate and align by hand
+    *memory_size = header_size + slots_size + QUEUE_CACHE_LINE_SIZE;
+    return allocator_allocate_zeroed(allocator, *memory_size);
+}
+
+/*------------------------------- SPSC QUEUE --------------------------------*/
+
+/**
+ * Create a new single producer single consumer queue using system allocator.
+ * @param element_size Size of each element.
+ * @param capacity Maximum number of elements, rounded up to a power of two.
+ * @return SpscQueue* on success, NULL otherwise.
+ * */
+SpscQueue* spsc_queue_create(Size element_size, Size capacity) {
+    return spsc_queue_create_with_allocator(element_size, capacity, NULL);
+}
+
+/**
+ * Create a new single producer single consumer queue that allocates it's
+ * memory from given allocator. Memory is allocated once, queue never grows.
+ * @param element_size Size of each element.
+ * @param capacity Maximum number of elements, rounded up to a power of two.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return SpscQueue* on success, NULL otherwise.
+ * */
+SpscQueue* spsc_queue_create_with_allocator(Size element_size, Size capacity, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(element_size && capacity && capacity <= (SIZE_MAX >> 2) / element_size, NULL,
+                             ERR_INVALID_ARGUMENTS);
+
+    capacity = NEXT_POW2(capacity);
+
+    Size  memory_size = 0;
+    void* memory      = allocate_queue_memory(sizeof(SpscQueue), capacity * element_size, allocator, &memory_size);
+    ERR_RETURN_VALUE_IF_FAIL(memory, NULL, ERR_OUT_OF_MEMORY);
+
+    SpscQueue* q    = (SpscQueue*)ALIGN_UP((Size)memory, QUEUE_CACHE_LINE_SIZE);
+    q->element_size = element_size;
+    q->capacity     = capacity;
+    q->data         = (Uint8*)(q + 1);
+    q->memory       = memory;
+    q->memory_size  = memory_size;
+    q->allocator    = allocator;
+
+    return q;
+}
+
+/**
+ * Destroy queue. No thread may be using it.
+ * @param q
+ * */
+void spsc_queue_destroy(SpscQueue* q) {
+    ERR_RETURN_IF_FAIL(q, ERR_INVALID_ARGUMENTS);
+    allocator_free(q->allocator, q->memory, q->memory_size);
+}
+
+/* copy elements into consecutive slots starting at given position, wrapping around end of ring */
+static void spsc_copy_in(SpscQueue* q, Size pos, const Uint8* src, Size count) {
+    Size slot  = pos & (q->capacity - 1);
+    Size first = MIN(count, q->capacity - slot);
+    memcpy(q->data + slot * q->element_size, src, first * q->element_size);
+    memcpy(q->data, src + first * q->element_size, (count - first) * q->element_size);
+}
+
+/* copy elements out of consecutive slots starting at given position, wrapping around end of ring */
+static void spsc_copy_out(SpscQueue* q, Size pos, Uint8* dst, Size count) {
+    Size slot  = pos & (q->capacity - 1);
+    Size first = MIN(count, q->capacity - slot);
+    memcpy(dst, q->data + slot * q->element_size, first * q->element_size);
+    memcpy(dst + first * q->element_size, q->data, (count - first) * q->element_size);
+}
+
+/**
+ * Push one element. Must only be called from producer thread.
+ * @param q
+ * @param element Address of element, @c element_size bytes are copied from it.
+ * @return True on success, False if queue is full.
+ * */
+Bool spsc_queue_push(SpscQueue* q, const void* element) {
+    ERR_RETURN_VALUE_IF_FAIL(q && element, False, ERR_INVALID_ARGUMENTS);
+
+    Size head = LOAD_RELAXED(&q->head);
+    if(head - q->cached_tail == q->capacity) {
+        q->cached_tail = LOAD_ACQUIRE(&q->tail);
+        if(head - q->cached_tail == q->capacity) {
+            return False;
+        }
+    }
+
+    copy_element(q->data + (head & (q->capacity - 1)) * q->element_size, element, q->element_size);
+    STORE_RELEASE(&q->head, head + 1);
+    return True;
+}
+
+/**
+ * Pop one element. Must only be called from consumer thread.
+ * @param q
+ * @param element Where to copy popped element to.
+ * @return True on success, False if queue is empty.
+ * */
+Bool spsc_queue_pop(SpscQueue* q, void* element) {
+    ERR_RETURN_VALUE_IF_FAIL(q && element, False, ERR_INVALID_ARGUMENTS);
+
+    Size tail = LOAD_RELAXED(&q->tail);
+    if(tail == q->cached_head) {
+        q->cached_head = LOAD_ACQUIRE(&q->head);
+        if(tail == q->cached_head) {
+            return False;
+        }
+    }
+
+    copy_element(element, q->data + (tail & (q->capacity - 1)) * q->element_size, q->element_size);
+    STORE_RELEASE(&q->tail, tail + 1);
+    return True;
+}
+
+/**
+ * Push as many of given elements as fit, publishing all of them at once.
+ * Must only be called from producer thread.
+ * @param q
+ * @param elements Array of @p count elements.
+ * @param count
+ * @return Number of elements pushed, from start of @p elements.
+ * */
+Size spsc_queue_push_batch(SpscQueue* q, const void* elements, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(q && (elements || !count), 0, ERR_INVALID_ARGUMENTS);
+
+    Size head = LOAD_RELAXED(&q->head);
+    if(q->capacity - (head - q->cached_tail) < count) {
+        q->cached_tail = LOAD_ACQUIRE(&q->tail);
+    }
+
+    count = MIN(count, q->capacity - (head - q->cached_tail));
+    if(count) {
+        spsc_copy_in(q, head, (const Uint8*)elements, count);
+        STORE_RELEASE(&q->head, head + count);
+    }
+    return count;
+}
+
+/**
+ * Pop up to given number of elements, releasing all of their slots at once.
+ * Must only be called from consumer thread.
+ * @param q
+ * @param elements Where to copy popped elements to, room for @p count elements.
+ * @param count
+ * @return Number of elements popped.
+ * */
+Size spsc_queue_pop_batch(SpscQueue* q, void* elements, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(q && (elements || !count), 0, ERR_INVALID_ARGUMENTS);
+
+    Size tail = LOAD_RELAXED(&q->tail);
+    if(q->cached_head - tail < count) {
+        q->cached_head = LOAD_ACQUIRE(&q->head);
+    }
+
+    count = MIN(count, q->cached_head - tail);
+    if(count) {
+        spsc_copy_out(q, tail, (Uint8*)elements, count);
+        STORE_RELEASE(&q->tail, tail + count);
+    }
+    return count;
+}
+
+/**
+ * Number of elements in queue. Exact only when called from producer or
+ * consumer thread while other one is idle, otherwise it's a snapshot.
+ * @param q
+ * */
+Size spsc_queue_length(SpscQueue* q) {
+    ERR_RETURN_VALUE_IF_FAIL(q, 0, ERR_INVALID_ARGUMENTS);
+
+    Size tail = LOAD_ACQUIRE(&q->tail);
+    Size head = LOAD_ACQUIRE(&q->head);
+    return MIN(head - tail, q->capacity);
+}
+
+/*------------------------------- MPMC QUEUE --------------------------------*/
+
+/* sequence number of slot of given position, element follows it */
+#define MPMC_SEQUENCE(q, pos) ((Size*)((q)->cells + ((pos) & ((q)->capacity - 1)) * (q)->cell_size))
+#define MPMC_ELEMENT(seq) ((Uint8*)(seq) + sizeof(Size))
+
+/**
+ * Create a new multi producer multi consumer queue using system allocator.
+ * @param element_size Size of each element.
+ * @param capacity Maximum number of elements, rounded up to a power of two, at least 2.
+ * @return MpmcQueue* on success, NULL otherwise.
+ * */
+MpmcQueue* mpmc_queue_create(Size element_size, Size capacity) {
+    return mpmc_queue_create_with_allocator(element_size, capacity, NULL);
+}
+
+/**
+ * Create a new multi producer multi consumer queue that allocates it's
+ * memory from given allocator. Memory is allocated once, queue never grows.
+ * @param element_size Size of each element.
+ * @param capacity Maximum number of elements, rounded up to a power of two, at least 2.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return MpmcQueue* on success, NULL otherwise.
+ * */
+MpmcQueue* mpmc_queue_create_with_allocator(Size element_size, Size capacity, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(element_size && element_size <= (SIZE_MAX >> 2) && capacity, NULL, ERR_INVALID_ARGUMENTS);
+
+    // sequence numbers are read and written atomically, so they stay aligned
+    Size cell_size = ALIGN_UP(sizeof(Size) + element_size, sizeof(Size));
+    ERR_RETURN_VALUE_IF_FAIL(capacity <= (SIZE_MAX >> 2) / cell_size, NULL, ERR_INVALID_CAPACITY);
+
+    // a slot popped at one position must not look free for next position, so at least 2 slots
+    capacity = MAX(NEXT_POW2(capacity), (Size)2);
+
+    Size  memory_size = 0;
+    void* memory      = allocate_queue_memory(sizeof(MpmcQueue), capacity * cell_size, allocator, &memory_size);
+    ERR_RETURN_VALUE_IF_FAIL(memory, NULL, ERR_OUT_OF_MEMORY);
+
+    MpmcQueue* q    = (MpmcQueue*)ALIGN_UP((Size)memory, QUEUE_CACHE_LINE_SIZE);
+    q->element_size = element_size;
+    q->cell_size    = cell_size;
+    q->capacity     = capacity;
+    q->cells        = (Uint8*)(q + 1);
+    q->memory       = memory;
+    q->memory_size  = memory_size;
+    q->allocator    = allocator;
+
+    for(Size pos = 0; pos < capacity; pos++) {
+        *MPMC_SEQUENCE(q, pos) = pos;
+    }
+
+    return q;
+}
+
+/**
+ * Destroy queue. No thread may be using it.
+ * @param q
+ * */
+void mpmc_queue_destroy(MpmcQueue* q) {
+    ERR_RETURN_IF_FAIL(q, ERR_INVALID_ARGUMENTS);
+    allocator_free(q->allocator, q->memory, q->memory_size);
+}
+
+/**
+ * Push one element. Can be called from any thread.
+ * @param q
+ * @param element Address of element, @c element_size bytes are copied from it.
+ * @return True on success, False if queue is full.
+ * */
+Bool mpmc_queue_push(MpmcQueue* q, const void* element) {
+    ERR_RETURN_VALUE_IF_FAIL(q && element, False, ERR_INVALID_ARGUMENTS);
+
+    Size  pos = LOAD_RELAXED(&q->enqueue_pos);
+    Size* seq = NULL;
+    for(;;) {
+        seq      = MPMC_SEQUENCE(q, pos);
+        Int64 d = (Int64)(LOAD_ACQUIRE(seq) - pos);
+        if(d == 0) {
+            if(__atomic_compare_exchange_n(&q->enqueue_pos, &pos, pos + 1, True, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if(d < 0) {
+            return False;
+        } else {
+            pos = LOAD_RELAXED(&q->enqueue_pos);
+        }
+    }
+
+    copy_element(MPMC_ELEMENT(seq), element, q->element_size);
+    STORE_RELEASE(seq, pos + 1);
+    return True;
+}
+
+/**
+ * Pop one element. Can be called from any thread.
+ * @param q
+ * @param element Where to copy popped element to.
+ * @return True on success, False if queue is empty.
+ * */
+Bool mpmc_queue_pop(MpmcQueue* q, void* element) {
+    ERR_RETURN_VALUE_IF_FAIL(q && element, False, ERR_INVALID_ARGUMENTS);
+
+    Size  pos = LOAD_RELAXED(&q->dequeue_pos);
+    Size* seq = NULL;
+    for(;;) {
+        seq      = MPMC_SEQUENCE(q, pos);
+        Int64 d = (Int64)(LOAD_ACQUIRE(seq) - (pos + 1));
+        if(d == 0) {
+            if(__atomic_compare_exchange_n(&q->dequeue_pos, &pos, pos + 1, True, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if(d < 0) {
+            return False;
+        } else {
+            pos = LOAD_RELAXED(&q->dequeue_pos);
+        }
+    }
+
+    copy_element(element, MPMC_ELEMENT(seq), q->element_size);
+    STORE_RELEASE(seq, pos + q->capacity);
+    return True;
+}
+
+/**
+ * Claim a run of consecutive positions, all of whose slots are in given state.
+ * Slots are checked before claiming, and a slot ready for position @c pos + i
+ * can only be taken by whoever claims that position, so after a successful
+ * compare and swap, whole run belongs to caller.
+ * @param pos_ptr @c enqueue_pos or @c dequeue_pos.
+ * @param ready Sequence number of a ready slot, relative to it's position : 0 to push, 1 to pop.
+ * @param count Maximum length of run.
+ * @param first Set to first claimed position.
+ * @return Length of claimed run, 0 if slot of next position is not ready.
+ * */
+static Size mpmc_claim(MpmcQueue* q, Size* pos_ptr, Size ready, Size count, Size* first) {
+    Size pos = LOAD_RELAXED(pos_ptr);
+    for(;;) {
+        Int64 d = (Int64)(LOAD_ACQUIRE(MPMC_SEQUENCE(q, pos)) - (pos + ready));
+        if(d < 0) {
+            return 0;
+        }
+        if(d > 0) {
+            pos = LOAD_RELAXED(pos_ptr);
+            continue;
+        }
+
+        Size n = 1;
+        while(n < count && LOAD_ACQUIRE(MPMC_SEQUENCE(q, pos + n)) == pos + n + ready) {
+            n++;
+        }
+        if(__atomic_compare_exchange_n(pos_ptr, &pos, pos + n, True, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *first = pos;
+            return n;
+        }
+    }
+}
+
+/**
+ * Push as many of given elements as there are free slots in a row, claiming
+ * all of them with a single compare and swap. Can be called from any thread.
+ * @param q
+ * @param elements Array of @p count elements.
+ * @param count
+ * @return Number of elements pushed, from start of @p elements.
+ * */
+Size mpmc_queue_push_batch(MpmcQueue* q, const void* elements, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(q && (elements || !count), 0, ERR_INVALID_ARGUMENTS);
+
+    if(!count) {
+        return 0;
+    }
+
+    Size pos = 0;
+    Size n   = mpmc_claim(q, &q->enqueue_pos, 0, count, &pos);
+
+    const Uint8* src = (const Uint8*)elements;
+    for(Size i = 0; i < n; i++) {
+        Size* seq = MPMC_SEQUENCE(q, pos + i);
+        copy_element(MPMC_ELEMENT(seq), src + i * q->element_size, q->element_size);
+        STORE_RELEASE(seq, pos + i + 1);
+    }
+    return n;
+}
+
+/**
+ * Pop up to given number of elements, from as many full slots as there are
+ * in a row, claiming all of them with a single compare and swap. Can be
+ * called from any thread.
+ * @param q
+ * @param elements Where to copy popped elements to, room for @p count elements.
+ * @param count
+ * @return Number of elements popped.
+ * */
+Size mpmc_queue_pop_batch(MpmcQueue* q, void* elements, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(q && (elements || !count), 0, ERR_INVALID_ARGUMENTS);
+
+    if(!count) {
+        return 0;
+    }
+
+    Size pos = 0;
+    Size n   = mpmc_claim(q, &q->dequeue_pos, 1, count, &pos);
+
+    Uint8* dst = (Uint8*)elements;
+    for(Size i = 0; i < n; i++) {
+        Size* seq = MPMC_SEQUENCE(q, pos + i);
+        copy_element(dst + i * q->element_size, MPMC_ELEMENT(seq), q->element_size);
+        STORE_RELEASE(seq, pos + i + q->capacity);
+    }
+    return n;
+}
+
+/**
+ * Number of elements in queue, including those being pushed or popped
+ * right now. Only a snapshot when other threads are using queue.
+ * @param q
+ * */
+Size mpmc_queue_length(MpmcQueue* q) {
+    ERR_RETURN_VALUE_IF_FAIL(q, 0, ERR_INVALID_ARGUMENTS);
+
+    Size dequeue = LOAD_ACQUIRE(&q->dequeue_pos);
+    Size enqueue = LOAD_ACQUIRE(&q->enqueue_pos);
+    return (Int64)(enqueue - dequeue) > 0 ? MIN(enqueue - dequeue, q->capacity) : 0;
+}
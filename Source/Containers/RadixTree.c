@@ -0,0 +1,1038 @@
+/**
+ * @file RadixTree.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Adaptive radix tree, an ordered map from byte string keys to data
+ * with prefix queries.
+ * */
+
+#include <Anvie/Containers/RadixTree.h>
+#include <Anvie/Error.h>
+#include <Anvie/Simd/Simd.h>
+#include <string.h>
+
+/* bytes of a compressed path kept in node, longer paths are read back from any leaf below node */
+#define RADIX_TREE_MAX_PREFIX 12
+
+/* keys are at most this long, so that a prefix length fits in node header */
+#define RADIX_TREE_MAX_KEY_LENGTH ((Size)0xffffffff)
+
+typedef enum RadixNodeType {
+    RADIX_NODE4,
+    RADIX_NODE16,
+    RADIX_NODE48,
+    RADIX_NODE256,
+} RadixNodeType;
+
+/**
+ * Header common to all inner node layouts, fits in half a cache line.
+ *
+ * A key is routed through a node by first matching @c prefix_length bytes of
+ * compressed path, then branching on next byte. A key that ends right after
+ * the compressed path is stored in @c value instead.
+ *
+ * Every node has at least two entries (children and value together), a node
+ * that drops to one is replaced by it's remaining entry.
+ * */
+typedef struct RadixNode {
+    Uint8          type;
+    Uint16         count; /**< Number of children, value is not counted. */
+    Uint32         prefix_length;
+    Uint8          prefix[RADIX_TREE_MAX_PREFIX];
+    RadixTreeLeaf* value;
+} RadixNode;
+
+/* children sorted by key byte */
+typedef struct RadixNode4 {
+    RadixNode node;
+    Uint8     keys[4];
+    void*     children[4];
+} RadixNode4;
+
+/* children sorted by key byte, keys are searched with a single SIMD compare */
+typedef struct RadixNode16 {
+    RadixNode node;
+    Uint8     keys[16];
+    void*     children[16];
+} RadixNode16;
+
+/* index maps a key byte to one more than position of child, 0 means no child */
+typedef struct RadixNode48 {
+    RadixNode node;
+    Uint8     index[256];
+    void*     children[48];
+} RadixNode48;
+
+typedef struct RadixNode256 {
+    RadixNode node;
+    void*     children[256];
+} RadixNode256;
+
+/* children are nodes or leaves, leaves are told apart by lowest bit of pointer */
+#define IS_LEAF(p) ((Uint64)(p) & 1)
+#define TAG_LEAF(l) ((void*)((Uint64)(l) | 1))
+#define UNTAG_LEAF(p) ((RadixTreeLeaf*)((Uint64)(p) & ~(Uint64)1))
+
+#define TO_NODE4(n) ((RadixNode4*)(n))
+#define TO_NODE16(n) ((RadixNode16*)(n))
+#define TO_NODE48(n) ((RadixNode48*)(n))
+#define TO_NODE256(n) ((RadixNode256*)(n))
+
+static RadixTreeLeaf* leaf_create(RadixTree* tree, const Uint8* key, Size key_length, void* data, void* udata);
+static void           leaf_destroy(RadixTree* tree, RadixTreeLeaf* leaf, void* udata);
+static Bool           leaf_set_data(RadixTree* tree, RadixTreeLeaf* leaf, void* data, void* udata);
+static Bool           leaf_matches(RadixTreeLeaf* leaf, const Uint8* key, Size key_length);
+static RadixNode*     node_create(RadixNodeType type);
+static void**         node_find_child(RadixNode* node, Uint8 byte);
+static Bool           node_add_child(void** ref, RadixNode* node, Uint8 byte, void* child);
+static void           node_remove_child(void** ref, RadixNode* node, Uint8 byte);
+static void           node_collapse(void** ref);
+static void*          node_first_child(RadixNode* node);
+static void*          node_last_child(RadixNode* node);
+static void           node_push_entries_reversed(VPtr_Vector* stack, RadixNode* node);
+static Bool           prefix_matches(RadixNode* node, const Uint8* key, Size key_length, Size depth);
+static Size           prefix_mismatch(RadixNode* node, const Uint8* key, Size key_length, Size depth);
+static RadixTreeLeaf* subtree_minimum(void* p);
+static RadixTreeLeaf* subtree_maximum(void* p);
+
+/**
+ * Create a new radix tree.
+ * Like vectors, either give both copy constructor and destructor for data or none.
+ *
+ * @param data_size Size of data in bytes.
+ * @param create_data_copy Copy constructor for data. Can be NULL.
+ * @param destroy_data_copy Copy destructor for data. Can be NULL.
+ * @return New radix tree on success, NULL otherwise.
+ * */
+RadixTree* radix_tree_create(Size data_size, CreateElementCopyCallback create_data_copy, DestroyElementCopyCallback destroy_data_copy) {
+    ERR_RETURN_VALUE_IF_FAIL(data_size, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!create_data_copy == !destroy_data_copy, NULL, ERR_INVALID_ARGUMENTS);
+
+    RadixTree* tree = NEW(RadixTree);
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_OUT_OF_MEMORY);
+
+    tree->data_size         = data_size;
+    tree->create_data_copy  = create_data_copy;
+    tree->destroy_data_copy = destroy_data_copy;
+
+    return tree;
+}
+
+/**
+ * Destroy given radix tree along with all keys and copies of data.
+ *
+ * @param tree
+ * @param udata User data passed to copy destructor.
+ * */
+void radix_tree_destroy(RadixTree* tree, void* udata) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    radix_tree_clear(tree, udata);
+    FREE(tree);
+}
+
+/**
+ * Remove all keys from given radix tree.
+ *
+ * @param tree
+ * @param udata User data passed to copy destructor.
+ * */
+void radix_tree_clear(RadixTree* tree, void* udata) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    if(!tree->root) return;
+
+    VPtr_Vector* stack = voidptr_vector_create();
+    ERR_RETURN_IF_FAIL(stack, ERR_OUT_OF_MEMORY);
+
+    voidptr_vector_push_back(stack, tree->root, NULL);
+    while(stack->length) {
+        void* p = voidptr_vector_pop_back(stack);
+        if(IS_LEAF(p)) {
+            leaf_destroy(tree, UNTAG_LEAF(p), udata);
+        } else {
+            node_push_entries_reversed(stack, p);
+            FREE(p);
+        }
+    }
+    voidptr_vector_destroy(stack, NULL);
+
+    tree->root  = NULL;
+    tree->count = 0;
+}
+
+/**
+ * Insert a key and it's data. If key is already present, it's data is
+ * replaced with a copy of new data.
+ *
+ * @param tree
+ * @param key Bytes of key. Can be NULL only when @p key_length is 0.
+ * @param key_length Number of bytes in key.
+ * @param data Data value if data is at most 8 bytes, pointer to data otherwise.
+ * @param udata User data passed to copy callbacks.
+ * @return Leaf holding key on success, NULL otherwise.
+ * */
+RadixTreeLeaf* radix_tree_insert(RadixTree* tree, const void* key, Size key_length, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && (key || !key_length), NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(key_length <= RADIX_TREE_MAX_KEY_LENGTH, NULL, ERR_INVALID_ARGUMENTS);
+
+    const Uint8* bytes = key;
+    void**       ref   = &tree->root;
+    Size         depth = 0;
+
+    while(True) {
+        void* p = *ref;
+
+        /* empty slot, key goes right here */
+        if(!p) {
+            RadixTreeLeaf* leaf = leaf_create(tree, bytes, key_length, data, udata);
+            ERR_RETURN_VALUE_IF_FAIL(leaf, NULL, ERR_OUT_OF_MEMORY);
+            *ref = TAG_LEAF(leaf);
+            tree->count++;
+            return leaf;
+        }
+
+        /* a leaf with another key is replaced by a node branching at first byte where keys differ */
+        if(IS_LEAF(p)) {
+            RadixTreeLeaf* existing = UNTAG_LEAF(p);
+            if(leaf_matches(existing, bytes, key_length)) {
+                ERR_RETURN_VALUE_IF_FAIL(leaf_set_data(tree, existing, data, udata), NULL, ERR_OUT_OF_MEMORY);
+                return existing;
+            }
+
+            RadixTreeLeaf* leaf = leaf_create(tree, bytes, key_length, data, udata);
+            ERR_RETURN_VALUE_IF_FAIL(leaf, NULL, ERR_OUT_OF_MEMORY);
+            RadixNode* node = node_create(RADIX_NODE4);
+            if(!node) {
+                leaf_destroy(tree, leaf, udata);
+                ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+                return NULL;
+            }
+
+            Size split = depth;
+            Size limit = MIN(existing->key_length, key_length);
+            while(split < limit && existing->key[split] == bytes[split]) split++;
+
+            node->prefix_length = (Uint32)(split - depth);
+            memcpy(node->prefix, bytes + depth, MIN(node->prefix_length, (Size)RADIX_TREE_MAX_PREFIX));
+
+            /* keys differ, so at most one of them ends at split */
+            if(existing->key_length == split) node->value = existing;
+            else node_add_child(ref, node, existing->key[split], p);
+            if(key_length == split) node->value = leaf;
+            else node_add_child(ref, node, bytes[split], TAG_LEAF(leaf));
+
+            *ref = node;
+            tree->count++;
+            return leaf;
+        }
+
+        /* key leaves compressed path of node, node moves under a new node branching there */
+        RadixNode* node    = p;
+        Size       matched = prefix_mismatch(node, bytes, key_length, depth);
+        if(matched < node->prefix_length) {
+            RadixTreeLeaf* leaf = leaf_create(tree, bytes, key_length, data, udata);
+            ERR_RETURN_VALUE_IF_FAIL(leaf, NULL, ERR_OUT_OF_MEMORY);
+            RadixNode* parent = node_create(RADIX_NODE4);
+            if(!parent) {
+                leaf_destroy(tree, leaf, udata);
+                ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+                return NULL;
+            }
+
+            parent->prefix_length = (Uint32)matched;
+            memcpy(parent->prefix, bytes + depth, MIN(matched, (Size)RADIX_TREE_MAX_PREFIX));
+
+            Uint8 edge;
+            if(node->prefix_length <= RADIX_TREE_MAX_PREFIX) {
+                edge = node->prefix[matched];
+                node->prefix_length -= (Uint32)(matched + 1);
+                memmove(node->prefix, node->prefix + matched + 1, node->prefix_length);
+            } else {
+                /* part of path is not stored in node, all leaves below have it */
+                RadixTreeLeaf* any = subtree_minimum(node);
+                edge = any->key[depth + matched];
+                node->prefix_length -= (Uint32)(matched + 1);
+                memcpy(node->prefix, any->key + depth + matched + 1, MIN(node->prefix_length, (Uint32)RADIX_TREE_MAX_PREFIX));
+            }
+
+            node_add_child(ref, parent, edge, node);
+            if(key_length == depth + matched) parent->value = leaf;
+            else node_add_child(ref, parent, bytes[depth + matched], TAG_LEAF(leaf));
+
+            *ref = parent;
+            tree->count++;
+            return leaf;
+        }
+
+        depth += node->prefix_length;
+
+        /* key ends at this node */
+        if(depth == key_length) {
+            if(node->value) {
+                ERR_RETURN_VALUE_IF_FAIL(leaf_set_data(tree, node->value, data, udata), NULL, ERR_OUT_OF_MEMORY);
+                return node->value;
+            }
+            node->value = leaf_create(tree, bytes, key_length, data, udata);
+            ERR_RETURN_VALUE_IF_FAIL(node->value, NULL, ERR_OUT_OF_MEMORY);
+            tree->count++;
+            return node->value;
+        }
+
+        void** child = node_find_child(node, bytes[depth]);
+        if(child) {
+            ref = child;
+            depth++;
+            continue;
+        }
+
+        RadixTreeLeaf* leaf = leaf_create(tree, bytes, key_length, data, udata);
+        ERR_RETURN_VALUE_IF_FAIL(leaf, NULL, ERR_OUT_OF_MEMORY);
+        if(!node_add_child(ref, node, bytes[depth], TAG_LEAF(leaf))) {
+            leaf_destroy(tree, leaf, udata);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+            return NULL;
+        }
+        tree->count++;
+        return leaf;
+    }
+}
+
+/**
+ * Search for given key.
+ *
+ * @param tree
+ * @param key Bytes of key.
+ * @param key_length Number of bytes in key.
+ * @return Leaf holding key if present, NULL otherwise.
+ * */
+RadixTreeLeaf* radix_tree_search(RadixTree* tree, const void* key, Size key_length) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && (key || !key_length), NULL, ERR_INVALID_ARGUMENTS);
+
+    const Uint8* bytes = key;
+    void*        p     = tree->root;
+    Size         depth = 0;
+
+    /* compressed paths are compared only as far as they're stored, full key is compared at leaf */
+    while(p) {
+        if(IS_LEAF(p)) {
+            return leaf_matches(UNTAG_LEAF(p), bytes, key_length) ? UNTAG_LEAF(p) : NULL;
+        }
+
+        RadixNode* node = p;
+        if(!prefix_matches(node, bytes, key_length, depth)) return NULL;
+        depth += node->prefix_length;
+
+        if(depth == key_length) {
+            return node->value && leaf_matches(node->value, bytes, key_length) ? node->value : NULL;
+        }
+
+        void** child = node_find_child(node, bytes[depth]);
+        if(!child) return NULL;
+        p = *child;
+        depth++;
+    }
+
+    return NULL;
+}
+
+/**
+ * Delete given key along with copy of it's data.
+ *
+ * @param tree
+ * @param key Bytes of key.
+ * @param key_length Number of bytes in key.
+ * @param udata User data passed to copy destructor.
+ * @return True if key was deleted, False if it was not present.
+ * */
+Bool radix_tree_delete(RadixTree* tree, const void* key, Size key_length, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && (key || !key_length), False, ERR_INVALID_ARGUMENTS);
+
+    const Uint8* bytes       = key;
+    void**       ref         = &tree->root;
+    void**       parent_ref  = NULL;
+    Uint8        parent_edge = 0;
+    Size         depth       = 0;
+
+    while(*ref) {
+        void* p = *ref;
+
+        if(IS_LEAF(p)) {
+            RadixTreeLeaf* leaf = UNTAG_LEAF(p);
+            if(!leaf_matches(leaf, bytes, key_length)) return False;
+
+            if(parent_ref) {
+                node_remove_child(parent_ref, *parent_ref, parent_edge);
+                node_collapse(parent_ref);
+            } else {
+                tree->root = NULL;
+            }
+            leaf_destroy(tree, leaf, udata);
+            tree->count--;
+            return True;
+        }
+
+        RadixNode* node = p;
+        if(!prefix_matches(node, bytes, key_length, depth)) return False;
+        depth += node->prefix_length;
+
+        if(depth == key_length) {
+            RadixTreeLeaf* leaf = node->value;
+            if(!leaf || !leaf_matches(leaf, bytes, key_length)) return False;
+
+            node->value = NULL;
+            node_collapse(ref);
+            leaf_destroy(tree, leaf, udata);
+            tree->count--;
+            return True;
+        }
+
+        void** child = node_find_child(node, bytes[depth]);
+        if(!child) return False;
+        parent_ref  = ref;
+        parent_edge = bytes[depth];
+        ref         = child;
+        depth++;
+    }
+
+    return False;
+}
+
+/**
+ * Find longest key in tree that's a prefix of given key, eg: most specific
+ * route for a path. Key itself counts as it's own prefix.
+ *
+ * @param tree
+ * @param key Bytes of key.
+ * @param key_length Number of bytes in key.
+ * @return Leaf holding longest matching key, NULL if no key in tree is a
+ * prefix of given key.
+ * */
+RadixTreeLeaf* radix_tree_longest_prefix(RadixTree* tree, const void* key, Size key_length) {
+    ERR_RETURN_VALUE_IF_FAIL(tree && (key || !key_length), NULL, ERR_INVALID_ARGUMENTS);
+
+    const Uint8*   bytes = key;
+    void*          p     = tree->root;
+    Size           depth = 0;
+    RadixTreeLeaf* best  = NULL;
+
+/* whether leaf key is a prefix of search key */
+#define IS_PREFIX_LEAF(leaf) ((leaf)->key_length <= key_length && !memcmp((leaf)->key, bytes, (leaf)->key_length))
+
+    /* keys ending at nodes along search path are it's prefixes, deeper ones are longer */
+    while(p) {
+        if(IS_LEAF(p)) {
+            if(IS_PREFIX_LEAF(UNTAG_LEAF(p))) best = UNTAG_LEAF(p);
+            break;
+        }
+
+        RadixNode* node = p;
+        if(!prefix_matches(node, bytes, key_length, depth)) break;
+        depth += node->prefix_length;
+
+        if(node->value && IS_PREFIX_LEAF(node->value)) best = node->value;
+        if(depth == key_length) break;
+
+        void** child = node_find_child(node, bytes[depth]);
+        if(!child) break;
+        p = *child;
+        depth++;
+    }
+
+#undef IS_PREFIX_LEAF
+
+    return best;
+}
+
+/**
+ * Get smallest key in tree.
+ *
+ * @param tree
+ * @return Leaf holding smallest key, NULL if tree is empty.
+ * */
+RadixTreeLeaf* radix_tree_minimum(RadixTree* tree) {
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_INVALID_ARGUMENTS);
+    return tree->root ? subtree_minimum(tree->root) : NULL;
+}
+
+/**
+ * Get largest key in tree.
+ *
+ * @param tree
+ * @return Leaf holding largest key, NULL if tree is empty.
+ * */
+RadixTreeLeaf* radix_tree_maximum(RadixTree* tree) {
+    ERR_RETURN_VALUE_IF_FAIL(tree, NULL, ERR_INVALID_ARGUMENTS);
+    return tree->root ? subtree_maximum(tree->root) : NULL;
+}
+
+/**
+ * Create an iterator over all keys of tree, in increasing order.
+ *
+ * @param tree
+ * @return Iterator. Iterating an iterator that failed to be created
+ * returns no keys.
+ * */
+RadixTreeIterator radix_tree_iter(RadixTree* tree) {
+    return radix_tree_iter_prefix(tree, NULL, 0);
+}
+
+/**
+ * Create an iterator over keys starting with given prefix, in increasing
+ * order. All such keys are in a single subtree, so finding it costs as
+ * much as a search for the prefix.
+ *
+ * @param tree
+ * @param prefix Bytes of prefix. Can be NULL only when @p prefix_length is 0.
+ * @param prefix_length Number of bytes in prefix.
+ * @return Iterator. Iterating an iterator that failed to be created
+ * returns no keys.
+ * */
+RadixTreeIterator radix_tree_iter_prefix(RadixTree* tree, const void* prefix, Size prefix_length) {
+    RadixTreeIterator iter = {0};
+    ERR_RETURN_VALUE_IF_FAIL(tree && (prefix || !prefix_length), iter, ERR_INVALID_ARGUMENTS);
+
+    iter.stack = voidptr_vector_create();
+    ERR_RETURN_VALUE_IF_FAIL(iter.stack, iter, ERR_OUT_OF_MEMORY);
+
+    const Uint8* bytes = prefix;
+    void*        p     = tree->root;
+    Size         depth = 0;
+
+    /* descend till prefix is used up, subtree reached there holds all matching keys */
+    while(p && !IS_LEAF(p) && depth < prefix_length) {
+        RadixNode* node = p;
+
+        /* prefix ends inside compressed path of node */
+        if(node->prefix_length >= prefix_length - depth) {
+            Size stored = MIN(prefix_length - depth, (Size)RADIX_TREE_MAX_PREFIX);
+            if(memcmp(node->prefix, bytes + depth, stored)) p = NULL;
+            break;
+        }
+
+        if(!prefix_matches(node, bytes, prefix_length, depth)) {
+            p = NULL;
+            break;
+        }
+        depth += node->prefix_length;
+
+        void** child = node_find_child(node, bytes[depth]);
+        p = child ? *child : NULL;
+        depth++;
+    }
+
+    /* bytes skipped in long compressed paths are checked once, on any key of subtree */
+    if(p) {
+        RadixTreeLeaf* any = subtree_minimum(p);
+        if(any->key_length >= prefix_length && !memcmp(any->key, bytes, prefix_length)) {
+            voidptr_vector_push_back(iter.stack, p, NULL);
+        }
+    }
+
+    return iter;
+}
+
+/**
+ * Get next key from iterator.
+ *
+ * @param iter
+ * @return Leaf holding next key, NULL once all keys are visited.
+ * */
+RadixTreeLeaf* radix_tree_iter_next(RadixTreeIterator* iter) {
+    ERR_RETURN_VALUE_IF_FAIL(iter, NULL, ERR_INVALID_ARGUMENTS);
+    if(!iter->stack) return NULL;
+
+    while(iter->stack->length) {
+        void* p = voidptr_vector_pop_back(iter->stack);
+        if(IS_LEAF(p)) {
+            return UNTAG_LEAF(p);
+        }
+        node_push_entries_reversed(iter->stack, p);
+    }
+
+    return NULL;
+}
+
+/**
+ * Free memory held by iterator.
+ *
+ * @param iter
+ * */
+void radix_tree_iter_destroy(RadixTreeIterator* iter) {
+    ERR_RETURN_IF_FAIL(iter, ERR_INVALID_ARGUMENTS);
+
+    if(iter->stack) voidptr_vector_destroy(iter->stack, NULL);
+    iter->stack = NULL;
+}
+
+/************************** PRIVATE FUNCTIONS ***************************/
+
+/* copy data into leaf with Vector semantics, value itself upto 8 bytes, pointer to a copy otherwise */
+static Bool data_create(RadixTree* tree, void* data, void** slot, void* udata) {
+    if(tree->data_size <= 8) {
+        if(tree->create_data_copy) {
+            *slot = NULL;
+            tree->create_data_copy(slot, data, udata);
+        } else {
+            *slot = data;
+        }
+        return True;
+    }
+
+    void* copy = ALLOCATE(Uint8, tree->data_size);
+    if(!copy) return False;
+
+    if(tree->create_data_copy) tree->create_data_copy(copy, data, udata);
+    else memcpy(copy, data, tree->data_size);
+    *slot = copy;
+    return True;
+}
+
+static void data_destroy(RadixTree* tree, void** slot, void* udata) {
+    if(tree->data_size <= 8) {
+        if(tree->destroy_data_copy) tree->destroy_data_copy(slot, udata);
+    } else {
+        if(tree->destroy_data_copy) tree->destroy_data_copy(*slot, udata);
+        FREE(*slot);
+    }
+    *slot = NULL;
+}
+
+static RadixTreeLeaf* leaf_create(RadixTree* tree, const Uint8* key, Size key_length, void* data, void* udata) {
+    /* key is followed by a null terminator */
+    RadixTreeLeaf* leaf = (RadixTreeLeaf*)ALLOCATE(Uint8, sizeof(RadixTreeLeaf) + key_length + 1);
+    if(!leaf) return NULL;
+
+    if(!data_create(tree, data, &leaf->data, udata)) {
+        FREE(leaf);
+        return NULL;
+    }
+    leaf->key_length = key_length;
+    if(key_length) memcpy(leaf->key, key, key_length);
+
+    return leaf;
+}
+
+static void leaf_destroy(RadixTree* tree, RadixTreeLeaf* leaf, void* udata) {
+    data_destroy(tree, &leaf->data, udata);
+    FREE(leaf);
+}
+
+/* replace data of an existing key, old data is kept if copying new one fails */
+static Bool leaf_set_data(RadixTree* tree, RadixTreeLeaf* leaf, void* data, void* udata) {
+    void* copy;
+    if(!data_create(tree, data, &copy, udata)) return False;
+    data_destroy(tree, &leaf->data, udata);
+    leaf->data = copy;
+    return True;
+}
+
+static Bool leaf_matches(RadixTreeLeaf* leaf, const Uint8* key, Size key_length) {
+    return leaf->key_length == key_length && (!key_length || !memcmp(leaf->key, key, key_length));
+}
+
+static RadixNode* node_create(RadixNodeType type) {
+    static const Size sizes[] = {
+        [RADIX_NODE4]   = sizeof(RadixNode4),
+        [RADIX_NODE16]  = sizeof(RadixNode16),
+        [RADIX_NODE48]  = sizeof(RadixNode48),
+        [RADIX_NODE256] = sizeof(RadixNode256),
+    };
+
+    RadixNode* node = (RadixNode*)ALLOCATE(Uint8, sizes[type]);
+    if(node) node->type = type;
+    return node;
+}
+
+/* create a node of given type with header of given node, children are moved by caller */
+static RadixNode* node_resize(RadixNode* node, RadixNodeType type) {
+    RadixNode* resized = node_create(type);
+    if(!resized) return NULL;
+
+    resized->count         = node->count;
+    resized->prefix_length = node->prefix_length;
+    resized->value         = node->value;
+    memcpy(resized->prefix, node->prefix, RADIX_TREE_MAX_PREFIX);
+    return resized;
+}
+
+/* slot holding child for given byte, NULL if there's no such child */
+static void** node_find_child(RadixNode* node, Uint8 byte) {
+    switch(node->type) {
+        case RADIX_NODE4: {
+            RadixNode4* n = TO_NODE4(node);
+            for(Size i = 0; i < node->count; i++) {
+                if(n->keys[i] == byte) return &n->children[i];
+            }
+            return NULL;
+        }
+
+        case RADIX_NODE16: {
+            RadixNode16* n = TO_NODE16(node);
+#if SIMD_ENABLED
+            /* registers wider than 16 bytes read into children array, those lanes are masked off */
+            Uint64 mask = (Uint64)simd_cmpeq_epi8_mask(simd_set1_epi8((Int8)byte), simd_loadu(n->keys));
+            mask &= ((Uint64)1 << node->count) - 1;
+            return mask ? &n->children[__builtin_ctzll(mask)] : NULL;
+#else
+            for(Size i = 0; i < node->count; i++) {
+                if(n->keys[i] == byte) return &n->children[i];
+            }
+            return NULL;
+#endif
+        }
+
+        case RADIX_NODE48: {
+            RadixNode48* n = TO_NODE48(node);
+            return n->index[byte] ? &n->children[n->index[byte] - 1] : NULL;
+        }
+
+        case RADIX_NODE256: {
+            RadixNode256* n = TO_NODE256(node);
+            return n->children[byte] ? &n->children[byte] : NULL;
+        }
+
+        default:
+            return NULL;
+    }
+}
+
+/* insert into a sorted key array of a Node4 or Node16 that has room */
+static void node_insert_sorted(Uint8* keys, void** children, Size count, Uint8 byte, void* child) {
+    Size pos = 0;
+    while(pos < count && keys[pos] < byte) pos++;
+    memmove(keys + pos + 1, keys + pos, count - pos);
+    memmove(children + pos + 1, children + pos, (count - pos) * sizeof(void*));
+    keys[pos]     = byte;
+    children[pos] = child;
+}
+
+/**
+ * Add a child for a byte that has none. A full node is replaced by a node
+ * of next larger layout, and @p ref is updated to point to it.
+ * */
+static Bool node_add_child(void** ref, RadixNode* node, Uint8 byte, void* child) {
+    switch(node->type) {
+        case RADIX_NODE4: {
+            RadixNode4* n = TO_NODE4(node);
+            if(node->count < 4) {
+                node_insert_sorted(n->keys, n->children, node->count++, byte, child);
+                return True;
+            }
+
+            RadixNode16* grown = TO_NODE16(node_resize(node, RADIX_NODE16));
+            if(!grown) return False;
+            memcpy(grown->keys, n->keys, sizeof(n->keys));
+            memcpy(grown->children, n->children, sizeof(n->children));
+            FREE(node);
+            *ref = grown;
+            return node_add_child(ref, &grown->node, byte, child);
+        }
+
+        case RADIX_NODE16: {
+            RadixNode16* n = TO_NODE16(node);
+            if(node->count < 16) {
+                node_insert_sorted(n->keys, n->children, node->count++, byte, child);
+                return True;
+            }
+
+            RadixNode48* grown = TO_NODE48(node_resize(node, RADIX_NODE48));
+            if(!grown) return False;
+            for(Size i = 0; i < 16; i++) {
+                grown->index[n->keys[i]] = (Uint8)(i + 1);
+                grown->children[i]       = n->children[i];
+            }
+            FREE(node);
+            *ref = grown;
+            return node_add_child(ref, &grown->node, byte, child);
+        }
+
+        case RADIX_NODE48: {
+            RadixNode48* n = TO_NODE48(node);
+            if(node->count < 48) {
+                /* children are kept packed, so first free slot is at count */
+                n->children[node->count] = child;
+                n->index[byte]           = (Uint8)(++node->count);
+                return True;
+            }
+
+            RadixNode256* grown = TO_NODE256(node_resize(node, RADIX_NODE256));
+            if(!grown) return False;
+            for(Size b = 0; b < 256; b++) {
+                if(n->index[b]) grown->children[b] = n->children[n->index[b] - 1];
+            }
+            FREE(node);
+            *ref = grown;
+            return node_add_child(ref, &grown->node, byte, child);
+        }
+
+        case RADIX_NODE256: {
+            TO_NODE256(node)->children[byte] = child;
+            node->count++;
+            return True;
+        }
+
+        default:
+            return False;
+    }
+}
+
+/**
+ * Remove child for given byte. A node that gets sparse enough is replaced
+ * by a node of next smaller layout, and @p ref is updated to point to it.
+ * Thresholds are below those for growing, so that alternating insertion and
+ * deletion at a boundary doesn't resize every time.
+ * */
+static void node_remove_child(void** ref, RadixNode* node, Uint8 byte) {
+    switch(node->type) {
+        case RADIX_NODE4:
+        case RADIX_NODE16: {
+            Uint8* keys     = node->type == RADIX_NODE4 ? TO_NODE4(node)->keys : TO_NODE16(node)->keys;
+            void** children = node->type == RADIX_NODE4 ? TO_NODE4(node)->children : TO_NODE16(node)->children;
+
+            Size pos = 0;
+            while(keys[pos] != byte) pos++;
+            node->count--;
+            memmove(keys + pos, keys + pos + 1, node->count - pos);
+            memmove(children + pos, children + pos + 1, (node->count - pos) * sizeof(void*));
+
+            if(node->type == RADIX_NODE16 && node->count <= 3) {
+                RadixNode4* shrunk = TO_NODE4(node_resize(node, RADIX_NODE4));
+                if(!shrunk) return; /* a sparse node is still a valid node */
+                memcpy(shrunk->keys, keys, node->count);
+                memcpy(shrunk->children, children, node->count * sizeof(void*));
+                FREE(node);
+                *ref = shrunk;
+            }
+            return;
+        }
+
+        case RADIX_NODE48: {
+            RadixNode48* n    = TO_NODE48(node);
+            Size         slot = n->index[byte] - 1;
+            Size         last = node->count - 1;
+
+            /* keep children packed by moving last child into freed slot */
+            n->index[byte] = 0;
+            if(slot != last) {
+                n->children[slot] = n->children[last];
+                for(Size b = 0; b < 256; b++) {
+                    if(n->index[b] == last + 1) {
+                        n->index[b] = (Uint8)(slot + 1);
+                        break;
+                    }
+                }
+            }
+            n->children[last] = NULL;
+            node->count--;
+
+            if(node->count <= 12) {
+                RadixNode16* shrunk = TO_NODE16(node_resize(node, RADIX_NODE16));
+                if(!shrunk) return;
+                Size i = 0;
+                for(Size b = 0; b < 256; b++) {
+                    if(n->index[b]) {
+                        shrunk->keys[i]       = (Uint8)b;
+                        shrunk->children[i++] = n->children[n->index[b] - 1];
+                    }
+                }
+                FREE(node);
+                *ref = shrunk;
+            }
+            return;
+        }
+
+        case RADIX_NODE256: {
+            RadixNode256* n = TO_NODE256(node);
+            n->children[byte] = NULL;
+            node->count--;
+
+            if(node->count <= 37) {
+                RadixNode48* shrunk = TO_NODE48(node_resize(node, RADIX_NODE48));
+                if(!shrunk) return;
+                Size i = 0;
+                for(Size b = 0; b < 256; b++) {
+                    if(n->children[b]) {
+                        shrunk->children[i] = n->children[b];
+                        shrunk->index[b]    = (Uint8)(++i);
+                    }
+                }
+                FREE(node);
+                *ref = shrunk;
+            }
+            return;
+        }
+
+        default:
+            return;
+    }
+}
+
+/* replace a node left with a single entry by that entry */
+static void node_collapse(void** ref) {
+    RadixNode* node = *ref;
+    if(node->count + (node->value != NULL) != 1) return;
+
+    if(!node->count) {
+        *ref = TAG_LEAF(node->value);
+        FREE(node);
+        return;
+    }
+
+    /* only Node4 gets this sparse, unless shrinking a larger node failed */
+    if(node->type != RADIX_NODE4) return;
+    RadixNode4* n     = TO_NODE4(node);
+    void*       child = n->children[0];
+
+    /* a child node takes over compressed path of this node and the edge byte to it */
+    if(!IS_LEAF(child)) {
+        RadixNode* c = child;
+        Uint8      prefix[RADIX_TREE_MAX_PREFIX];
+        Size       length = MIN(node->prefix_length, (Uint32)RADIX_TREE_MAX_PREFIX);
+
+        memcpy(prefix, node->prefix, length);
+        if(length < RADIX_TREE_MAX_PREFIX) prefix[length++] = n->keys[0];
+        if(length < RADIX_TREE_MAX_PREFIX) {
+            Size rest = MIN(MIN(c->prefix_length, (Uint32)RADIX_TREE_MAX_PREFIX), RADIX_TREE_MAX_PREFIX - length);
+            memcpy(prefix + length, c->prefix, rest);
+            length += rest;
+        }
+
+        memcpy(c->prefix, prefix, length);
+        c->prefix_length += node->prefix_length + 1;
+    }
+
+    *ref = child;
+    FREE(node);
+}
+
+static void* node_first_child(RadixNode* node) {
+    switch(node->type) {
+        case RADIX_NODE4:
+            return TO_NODE4(node)->children[0];
+        case RADIX_NODE16:
+            return TO_NODE16(node)->children[0];
+        case RADIX_NODE48:
+            for(Size b = 0; b < 256; b++) {
+                if(TO_NODE48(node)->index[b]) return TO_NODE48(node)->children[TO_NODE48(node)->index[b] - 1];
+            }
+            return NULL;
+        case RADIX_NODE256:
+            for(Size b = 0; b < 256; b++) {
+                if(TO_NODE256(node)->children[b]) return TO_NODE256(node)->children[b];
+            }
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
+static void* node_last_child(RadixNode* node) {
+    if(!node->count) return NULL;
+
+    switch(node->type) {
+        case RADIX_NODE4:
+            return TO_NODE4(node)->children[node->count - 1];
+        case RADIX_NODE16:
+            return TO_NODE16(node)->children[node->count - 1];
+        case RADIX_NODE48:
+            for(Size b = 256; b; b--) {
+                if(TO_NODE48(node)->index[b - 1]) return TO_NODE48(node)->children[TO_NODE48(node)->index[b - 1] - 1];
+            }
+            return NULL;
+        case RADIX_NODE256:
+            for(Size b = 256; b; b--) {
+                if(TO_NODE256(node)->children[b - 1]) return TO_NODE256(node)->children[b - 1];
+            }
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
+/* push children from largest byte to smallest, then value, so popping visits them in key order */
+static void node_push_entries_reversed(VPtr_Vector* stack, RadixNode* node) {
+    switch(node->type) {
+        case RADIX_NODE4:
+            for(Size i = node->count; i; i--) voidptr_vector_push_back(stack, TO_NODE4(node)->children[i - 1], NULL);
+            break;
+        case RADIX_NODE16:
+            for(Size i = node->count; i; i--) voidptr_vector_push_back(stack, TO_NODE16(node)->children[i - 1], NULL);
+            break;
+        case RADIX_NODE48:
+            for(Size b = 256; b; b--) {
+                RadixNode48* n = TO_NODE48(node);
+                if(n->index[b - 1]) voidptr_vector_push_back(stack, n->children[n->index[b - 1] - 1], NULL);
+            }
+            break;
+        case RADIX_NODE256:
+            for(Size b = 256; b; b--) {
+                if(TO_NODE256(node)->children[b - 1]) voidptr_vector_push_back(stack, TO_NODE256(node)->children[b - 1], NULL);
+            }
+            break;
+        default:
+            break;
+    }
+
+    /* a key ending here is a prefix of, so smaller than, all keys in children */
+    if(node->value) voidptr_vector_push_back(stack, TAG_LEAF(node->value), NULL);
+}
+
+/* whether key can pass compressed path of node, bytes not stored in node are not checked */
+static Bool prefix_matches(RadixNode* node, const Uint8* key, Size key_length, Size depth) {
+    if(node->prefix_length > key_length - depth) return False;
+    Size stored = MIN(node->prefix_length, (Uint32)RADIX_TREE_MAX_PREFIX);
+    return !stored || !memcmp(node->prefix, key + depth, stored);
+}
+
+/* number of bytes of compressed path of node that match key, checking bytes not stored in node too */
+static Size prefix_mismatch(RadixNode* node, const Uint8* key, Size key_length, Size depth) {
+    Size limit  = MIN((Size)node->prefix_length, key_length - depth);
+    Size stored = MIN(limit, (Size)RADIX_TREE_MAX_PREFIX);
+    Size i      = 0;
+
+    for(; i < stored; i++) {
+        if(node->prefix[i] != key[depth + i]) return i;
+    }
+
+    if(limit > stored) {
+        RadixTreeLeaf* any = subtree_minimum(node);
+        for(; i < limit; i++) {
+            if(any->key[depth + i] != key[depth + i]) return i;
+        }
+    }
+
+    return i;
+}
+
+/* leaf with smallest key in subtree, nodes always have a value or a child */
+static RadixTreeLeaf* subtree_minimum(void* p) {
+    while(!IS_LEAF(p)) {
+        RadixNode* node = p;
+        if(node->value) return node->value;
+        p = node_first_child(node);
+    }
+    return UNTAG_LEAF(p);
+}
+
+static RadixTreeLeaf* subtree_maximum(void* p) {
+    while(!IS_LEAF(p)) {
+        RadixNode* node = p;
+        if(!node->count) return node->value;
+        p = node_last_child(node);
+    }
+    return UNTAG_LEAF(p);
+}
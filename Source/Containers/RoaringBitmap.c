@@ -0,0 +1,1170 @@
+/**
+ * @file RoaringBitmap.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of compressed bitmap in Containers/RoaringBitmap.h
+ * */
+
+#include <Anvie/Containers/RoaringBitmap.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* number of containers allocated on first insertion */
+#define ROARING_INIT_CONTAINER_COUNT 4
+
+/* number of array values allocated when an array container is created */
+#define ROARING_INIT_ARRAY_SIZE 4
+
+/* magic number at beginning of serialized bitmap, "RBM1" in memory */
+#define ROARING_SERIAL_MAGIC 0x314d4252u
+
+/* size of serialized header and of serialized header of each container */
+#define SERIAL_HEADER_SIZE 8
+#define SERIAL_CONTAINER_HEADER_SIZE 12
+
+#define KEY_OF(v) ((Uint16)((v) >> 16))
+#define LOW_OF(v) ((Uint16)((v) & 0xffff))
+
+#define ARRAY_OF(c) ((Uint16*)(c)->data)
+#define WORDS_OF(c) ((Uint64*)(c)->data)
+#define RUNS_OF(c) ((RoaringRun*)(c)->data)
+
+/* size of a single element of data of given container type */
+static FORCE_INLINE Size element_size(Uint16 type) {
+    switch(type) {
+        case ROARING_CONTAINER_ARRAY: return sizeof(Uint16);
+        case ROARING_CONTAINER_BITMAP: return sizeof(Uint64);
+        default: return sizeof(RoaringRun);
+    }
+}
+
+/*------------------------------- BITMAP WORDS -------------------------------*/
+
+static FORCE_INLINE Bool words_test(const Uint64* words, Uint16 low) {
+    return (words[low >> 6] >> (low & 63)) & 1;
+}
+
+/* set bits [lo, hi] in given bitmap */
+static void words_set_range(Uint64* words, Uint32 lo, Uint32 hi) {
+    Uint32 wlo = lo >> 6, whi = hi >> 6;
+    Uint64 mlo = ~(Uint64)0 << (lo & 63);
+    Uint64 mhi = ~(Uint64)0 >> (63 - (hi & 63));
+
+    if(wlo == whi) {
+        words[wlo] |= mlo & mhi;
+        return;
+    }
+
+    words[wlo] |= mlo;
+    for(Uint32 w = wlo + 1; w < whi; w++) {
+        words[w] = ~(Uint64)0;
+    }
+    words[whi] |= mhi;
+}
+
+static Uint32 words_popcount(const Uint64* words) {
+    Uint32 count = 0;
+    for(Size w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        count += (Uint32)__builtin_popcountll(words[w]);
+    }
+    return count;
+}
+
+/* number of runs of set bits in given bitmap */
+static Uint32 words_run_count(const Uint64* words) {
+    Uint32 runs = 0;
+    Uint64 carry = 0;
+    for(Size w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        /* a run starts wherever a set bit is preceded by a cleared one */
+        runs += (Uint32)__builtin_popcountll(words[w] & ~((words[w] << 1) | carry));
+        carry = words[w] >> 63;
+    }
+    return runs;
+}
+
+/* fill given bitmap with values of a container of any type */
+static void materialize(const RoaringContainer* c, Uint64* words) {
+    switch(c->type) {
+        case ROARING_CONTAINER_BITMAP:
+            memcpy(words, c->data, ROARING_BITMAP_WORDS * sizeof(Uint64));
+            return;
+        case ROARING_CONTAINER_ARRAY: {
+            memset(words, 0, ROARING_BITMAP_WORDS * sizeof(Uint64));
+            const Uint16* values = ARRAY_OF(c);
+            for(Uint32 i = 0; i < c->size; i++) {
+                words[values[i] >> 6] |= (Uint64)1 << (values[i] & 63);
+            }
+            return;
+        }
+        default: {
+            memset(words, 0, ROARING_BITMAP_WORDS * sizeof(Uint64));
+            const RoaringRun* runs = RUNS_OF(c);
+            for(Uint32 r = 0; r < c->size; r++) {
+                words_set_range(words, runs[r].start, (Uint32)runs[r].start + runs[r].length);
+            }
+            return;
+        }
+    }
+}
+
+/*------------------------------- CONTAINERS -------------------------------*/
+
+/**
+ * Replace data of given container with a new allocation of given type
+ * and capacity. Old data is released. Cardinality and size are left to
+ * the caller.
+ * */
+static Bool container_realloc_as(RoaringBitmap* rb, RoaringContainer* c, Uint16 type, Uint32 capacity) {
+    void* data = allocator_allocate(rb->allocator, capacity * element_size(type));
+    ERR_RETURN_VALUE_IF_FAIL(data, False, ERR_OUT_OF_MEMORY);
+
+    if(c->data) {
+        allocator_free(rb->allocator, c->data, c->capacity * element_size(c->type));
+    }
+
+    c->data     = data;
+    c->type     = type;
+    c->capacity = capacity;
+    return True;
+}
+
+static void container_release(RoaringBitmap* rb, RoaringContainer* c) {
+    if(c->data) {
+        allocator_free(rb->allocator, c->data, c->capacity * element_size(c->type));
+    }
+    c->data = NULL;
+    c->capacity = 0;
+}
+
+/* make sure array or run container can hold given number of elements */
+static Bool container_reserve(RoaringBitmap* rb, RoaringContainer* c, Uint32 size) {
+    if(size <= c->capacity) return True;
+
+    Uint32 cap = MAX(c->capacity * 2, (Uint32)ROARING_INIT_ARRAY_SIZE);
+    cap = MAX(cap, size);
+    if(c->type == ROARING_CONTAINER_ARRAY) cap = MIN(cap, (Uint32)ROARING_ARRAY_MAX_SIZE);
+
+    Size  esz  = element_size(c->type);
+    void* data = allocator_reallocate(rb->allocator, c->data, c->capacity * esz, cap * esz);
+    ERR_RETURN_VALUE_IF_FAIL(data, False, ERR_OUT_OF_MEMORY);
+
+    c->data     = data;
+    c->capacity = cap;
+    return True;
+}
+
+/* store values of given bitmap in container, as array or bitmap depending on cardinality */
+static Bool container_store_words(RoaringBitmap* rb, RoaringContainer* c, const Uint64* words, Uint32 cardinality) {
+    if(cardinality > ROARING_ARRAY_MAX_SIZE) {
+        if(c->type != ROARING_CONTAINER_BITMAP || c->capacity != ROARING_BITMAP_WORDS) {
+            if(!container_realloc_as(rb, c, ROARING_CONTAINER_BITMAP, ROARING_BITMAP_WORDS)) return False;
+        }
+        if(WORDS_OF(c) != words) memcpy(c->data, words, ROARING_BITMAP_WORDS * sizeof(Uint64));
+        c->size = ROARING_BITMAP_WORDS;
+    } else {
+        Uint16* values = allocator_allocate(rb->allocator, MAX(cardinality, 1u) * sizeof(Uint16));
+        ERR_RETURN_VALUE_IF_FAIL(values, False, ERR_OUT_OF_MEMORY);
+
+        Uint32 n = 0;
+        for(Size w = 0; w < ROARING_BITMAP_WORDS; w++) {
+            for(Uint64 word = words[w]; word; word &= word - 1) {
+                values[n++] = (Uint16)(w * 64 + (Size)__builtin_ctzll(word));
+            }
+        }
+
+        container_release(rb, c);
+        c->data     = values;
+        c->type     = ROARING_CONTAINER_ARRAY;
+        c->capacity = MAX(cardinality, 1u);
+        c->size     = n;
+    }
+
+    c->cardinality = cardinality;
+    return True;
+}
+
+/* convert array or run container to a bitmap container */
+static Bool container_to_bitmap(RoaringBitmap* rb, RoaringContainer* c) {
+    if(c->type == ROARING_CONTAINER_BITMAP) return True;
+
+    Uint64* words = allocator_allocate(rb->allocator, ROARING_BITMAP_WORDS * sizeof(Uint64));
+    ERR_RETURN_VALUE_IF_FAIL(words, False, ERR_OUT_OF_MEMORY);
+    materialize(c, words);
+
+    container_release(rb, c);
+    c->data     = words;
+    c->type     = ROARING_CONTAINER_BITMAP;
+    c->capacity = ROARING_BITMAP_WORDS;
+    c->size     = ROARING_BITMAP_WORDS;
+    return True;
+}
+
+/* convert a run container to the form single value updates work on */
+static Bool container_expand_runs(RoaringBitmap* rb, RoaringContainer* c) {
+    if(c->type != ROARING_CONTAINER_RUN) return True;
+
+    Uint64 words[ROARING_BITMAP_WORDS];
+    materialize(c, words);
+    return container_store_words(rb, c, words, c->cardinality);
+}
+
+/* index of first array value not less than low */
+static FORCE_INLINE Uint32 array_lower_bound(const Uint16* values, Uint32 size, Uint16 low) {
+    Uint32 lo = 0, hi = size;
+    while(lo < hi) {
+        Uint32 mid = lo + (hi - lo) / 2;
+        if(values[mid] < low) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static Bool container_contains(const RoaringContainer* c, Uint16 low) {
+    switch(c->type) {
+        case ROARING_CONTAINER_ARRAY: {
+            Uint32 i = array_lower_bound(ARRAY_OF(c), c->size, low);
+            return i < c->size && ARRAY_OF(c)[i] == low;
+        }
+        case ROARING_CONTAINER_BITMAP:
+            return words_test(WORDS_OF(c), low);
+        default: {
+            /* last run starting at or before low */
+            const RoaringRun* runs = RUNS_OF(c);
+            Uint32 lo = 0, hi = c->size;
+            while(lo < hi) {
+                Uint32 mid = lo + (hi - lo) / 2;
+                if(runs[mid].start <= low) lo = mid + 1;
+                else hi = mid;
+            }
+            return lo && low <= (Uint32)runs[lo - 1].start + runs[lo - 1].length;
+        }
+    }
+}
+
+static Bool container_add(RoaringBitmap* rb, RoaringContainer* c, Uint16 low) {
+    if(container_contains(c, low)) return False;
+    if(!container_expand_runs(rb, c)) return False;
+
+    if(c->type == ROARING_CONTAINER_ARRAY && c->size == ROARING_ARRAY_MAX_SIZE) {
+        if(!container_to_bitmap(rb, c)) return False;
+    }
+
+    if(c->type == ROARING_CONTAINER_BITMAP) {
+        WORDS_OF(c)[low >> 6] |= (Uint64)1 << (low & 63);
+    } else {
+        if(!container_reserve(rb, c, c->size + 1)) return False;
+        Uint16* values = ARRAY_OF(c);
+        Uint32  i      = array_lower_bound(values, c->size, low);
+        memmove(values + i + 1, values + i, (c->size - i) * sizeof(Uint16));
+        values[i] = low;
+        c->size++;
+    }
+
+    c->cardinality++;
+    return True;
+}
+
+static Bool container_remove(RoaringBitmap* rb, RoaringContainer* c, Uint16 low) {
+    if(!container_contains(c, low)) return False;
+    if(!container_expand_runs(rb, c)) return False;
+
+    if(c->type == ROARING_CONTAINER_BITMAP) {
+        WORDS_OF(c)[low >> 6] &= ~((Uint64)1 << (low & 63));
+        c->cardinality--;
+        if(c->cardinality <= ROARING_ARRAY_MAX_SIZE) {
+            container_store_words(rb, c, WORDS_OF(c), c->cardinality);
+        }
+    } else {
+        Uint16* values = ARRAY_OF(c);
+        Uint32  i      = array_lower_bound(values, c->size, low);
+        memmove(values + i, values + i + 1, (c->size - i - 1) * sizeof(Uint16));
+        c->size--;
+        c->cardinality--;
+    }
+
+    return True;
+}
+
+/* number of runs needed to represent given container */
+static Uint32 container_run_count(const RoaringContainer* c) {
+    switch(c->type) {
+        case ROARING_CONTAINER_ARRAY: {
+            const Uint16* values = ARRAY_OF(c);
+            Uint32 runs = c->size ? 1 : 0;
+            for(Uint32 i = 1; i < c->size; i++) {
+                runs += values[i] != values[i - 1] + 1;
+            }
+            return runs;
+        }
+        case ROARING_CONTAINER_BITMAP:
+            return words_run_count(WORDS_OF(c));
+        default:
+            return c->size;
+    }
+}
+
+/* convert array or bitmap container to a run container with given number of runs */
+static Bool container_to_runs(RoaringBitmap* rb, RoaringContainer* c, Uint32 run_count) {
+    RoaringRun* runs = allocator_allocate(rb->allocator, run_count * sizeof(RoaringRun));
+    ERR_RETURN_VALUE_IF_FAIL(runs, False, ERR_OUT_OF_MEMORY);
+
+    Uint32 n = 0;
+    if(c->type == ROARING_CONTAINER_ARRAY) {
+        const Uint16* values = ARRAY_OF(c);
+        for(Uint32 i = 0; i < c->size; i++) {
+            if(n && values[i] == (Uint32)runs[n - 1].start + runs[n - 1].length + 1) {
+                runs[n - 1].length++;
+            } else {
+                runs[n].start  = values[i];
+                runs[n].length = 0;
+                n++;
+            }
+        }
+    } else {
+        /* find starts and ends of runs of set bits a word at a time */
+        const Uint64* words = WORDS_OF(c);
+        Uint32 v = 0;
+        while(v < ROARING_CHUNK_SIZE) {
+            Uint32 w = v >> 6;
+            Uint64 word = words[w] & (~(Uint64)0 << (v & 63));
+            while(!word && ++w < ROARING_BITMAP_WORDS) word = words[w];
+            if(!word) break;
+
+            Uint32 start = w * 64 + (Uint32)__builtin_ctzll(word);
+            word = ~words[w] & (~(Uint64)0 << (start & 63));
+            while(!word && ++w < ROARING_BITMAP_WORDS) word = ~words[w];
+            Uint32 end = word ? w * 64 + (Uint32)__builtin_ctzll(word) : ROARING_CHUNK_SIZE;
+
+            runs[n].start  = (Uint16)start;
+            runs[n].length = (Uint16)(end - start - 1);
+            n++;
+            v = end;
+        }
+    }
+
+    container_release(rb, c);
+    c->data     = runs;
+    c->type     = ROARING_CONTAINER_RUN;
+    c->capacity = run_count;
+    c->size     = n;
+    return True;
+}
+
+static Bool container_clone(RoaringBitmap* rb, RoaringContainer* dst, const RoaringContainer* src) {
+    *dst = *src;
+    dst->capacity = MAX(src->size, 1u);
+    dst->data     = allocator_allocate(rb->allocator, dst->capacity * element_size(src->type));
+    ERR_RETURN_VALUE_IF_FAIL(dst->data, False, ERR_OUT_OF_MEMORY);
+
+    memcpy(dst->data, src->data, src->size * element_size(src->type));
+    return True;
+}
+
+/*------------------------------- CONTAINER LIST -------------------------------*/
+
+/**
+ * Find position of container with given key.
+ * @return position of container if found, otherwise position where it must be inserted.
+ * */
+static Size container_search(const RoaringBitmap* rb, Uint16 key, Bool* found) {
+    Size lo = 0, hi = rb->count;
+    while(lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if(rb->containers[mid].key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    *found = lo < rb->count && rb->containers[lo].key == key;
+    return lo;
+}
+
+/* insert an empty container with given key at given position */
+static RoaringContainer* container_insert(RoaringBitmap* rb, Size pos, Uint16 key) {
+    if(rb->count == rb->capacity) {
+        Size cap = MAX(rb->capacity * 2, (Size)ROARING_INIT_CONTAINER_COUNT);
+        RoaringContainer* tmp = allocator_reallocate(rb->allocator, rb->containers,
+                                                     rb->capacity * sizeof(RoaringContainer),
+                                                     cap * sizeof(RoaringContainer));
+        ERR_RETURN_VALUE_IF_FAIL(tmp, NULL, ERR_OUT_OF_MEMORY);
+        rb->containers = tmp;
+        rb->capacity   = cap;
+    }
+
+    memmove(rb->containers + pos + 1, rb->containers + pos, (rb->count - pos) * sizeof(RoaringContainer));
+    rb->count++;
+
+    RoaringContainer* c = rb->containers + pos;
+    memset(c, 0, sizeof(RoaringContainer));
+    c->key = key;
+    return c;
+}
+
+static void container_erase(RoaringBitmap* rb, Size pos) {
+    container_release(rb, rb->containers + pos);
+    memmove(rb->containers + pos, rb->containers + pos + 1, (rb->count - pos - 1) * sizeof(RoaringContainer));
+    rb->count--;
+}
+
+/* append a container to a bitmap being built in increasing order of keys */
+static RoaringContainer* container_append(RoaringBitmap* rb, Uint16 key) {
+    return container_insert(rb, rb->count, key);
+}
+
+/*------------------------------- PUBLIC API -------------------------------*/
+
+/**
+ * Create a new empty compressed bitmap.
+ * @return RoaringBitmap* on success.
+ * @return NULL otherwise.
+ * */
+RoaringBitmap* roaring_create() {
+    return roaring_create_with_allocator(NULL);
+}
+
+/**
+ * Create a new empty compressed bitmap that allocates all of it's memory
+ * from given allocator.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return RoaringBitmap* on success.
+ * @return NULL otherwise.
+ * */
+RoaringBitmap* roaring_create_with_allocator(Allocator* allocator) {
+    RoaringBitmap* rb = allocator_allocate_zeroed(allocator, sizeof(RoaringBitmap));
+    ERR_RETURN_VALUE_IF_FAIL(rb, NULL, ERR_OUT_OF_MEMORY);
+
+    rb->allocator = allocator;
+    return rb;
+}
+
+/**
+ * Destroy given compressed bitmap.
+ * @param rb
+ * */
+void roaring_destroy(RoaringBitmap* rb) {
+    ERR_RETURN_IF_FAIL(rb, ERR_INVALID_ARGUMENTS);
+
+    roaring_clear(rb);
+    allocator_free(rb->allocator, rb->containers, rb->capacity * sizeof(RoaringContainer));
+    allocator_free(rb->allocator, rb, sizeof(RoaringBitmap));
+}
+
+/**
+ * Create a deep copy of given compressed bitmap, using same allocator.
+ * @param rb
+ * @return RoaringBitmap* on success.
+ * @return NULL otherwise.
+ * */
+RoaringBitmap* roaring_clone(RoaringBitmap* rb) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, NULL, ERR_INVALID_ARGUMENTS);
+
+    RoaringBitmap* clone = roaring_create_with_allocator(rb->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(clone, NULL, ERR_INVALID_OBJECT);
+
+    for(Size i = 0; i < rb->count; i++) {
+        RoaringContainer* c = container_append(clone, rb->containers[i].key);
+        if(!c || !container_clone(clone, c, rb->containers + i)) {
+            if(c) clone->count--;
+            roaring_destroy(clone);
+            return NULL;
+        }
+    }
+
+    return clone;
+}
+
+/**
+ * Remove all values from given compressed bitmap.
+ * Memory of container list is kept for reuse.
+ * @param rb
+ * */
+void roaring_clear(RoaringBitmap* rb) {
+    ERR_RETURN_IF_FAIL(rb, ERR_INVALID_ARGUMENTS);
+
+    for(Size i = 0; i < rb->count; i++) {
+        container_release(rb, rb->containers + i);
+    }
+    rb->count = 0;
+}
+
+/**
+ * Add a value to given compressed bitmap.
+ * @param rb
+ * @param value
+ * @return True if value was added.
+ * @return False if value was already present, or on failure.
+ * */
+Bool roaring_add(RoaringBitmap* rb, Uint32 value) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, False, ERR_INVALID_ARGUMENTS);
+
+    Bool found;
+    Size pos = container_search(rb, KEY_OF(value), &found);
+    if(found) {
+        return container_add(rb, rb->containers + pos, LOW_OF(value));
+    }
+
+    RoaringContainer* c = container_insert(rb, pos, KEY_OF(value));
+    if(!c) return False;
+
+    if(!container_realloc_as(rb, c, ROARING_CONTAINER_ARRAY, ROARING_INIT_ARRAY_SIZE)) {
+        container_erase(rb, pos);
+        return False;
+    }
+
+    ARRAY_OF(c)[0] = LOW_OF(value);
+    c->size        = 1;
+    c->cardinality = 1;
+    return True;
+}
+
+/**
+ * Remove a value from given compressed bitmap.
+ * @param rb
+ * @param value
+ * @return True if value was removed.
+ * @return False if value was not present, or on failure.
+ * */
+Bool roaring_remove(RoaringBitmap* rb, Uint32 value) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, False, ERR_INVALID_ARGUMENTS);
+
+    Bool found;
+    Size pos = container_search(rb, KEY_OF(value), &found);
+    if(!found || !container_remove(rb, rb->containers + pos, LOW_OF(value))) {
+        return False;
+    }
+
+    if(!rb->containers[pos].cardinality) {
+        container_erase(rb, pos);
+    }
+
+    return True;
+}
+
+/**
+ * Check whether given value is present in compressed bitmap.
+ * @param rb
+ * @param value
+ * */
+Bool roaring_contains(RoaringBitmap* rb, Uint32 value) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, False, ERR_INVALID_ARGUMENTS);
+
+    Bool found;
+    Size pos = container_search(rb, KEY_OF(value), &found);
+    return found && container_contains(rb->containers + pos, LOW_OF(value));
+}
+
+/**
+ * Add all values in range [range_begin, range_end) to given compressed
+ * bitmap. Chunks not present before are stored as a single run, so adding
+ * a large range is cheap both in time and memory.
+ *
+ * @param rb
+ * @param range_begin First value in range.
+ * @param range_end One past last value in range. Clamped to (1 << 32).
+ * */
+void roaring_add_range(RoaringBitmap* rb, Uint64 range_begin, Uint64 range_end) {
+    ERR_RETURN_IF_FAIL(rb, ERR_INVALID_ARGUMENTS);
+
+    range_end = MIN(range_end, (Uint64)1 << 32);
+    if(range_begin >= range_end) return;
+
+    Uint32 first = (Uint32)(range_begin >> 16);
+    Uint32 last  = (Uint32)((range_end - 1) >> 16);
+    for(Uint32 key = first; key <= last; key++) {
+        Uint32 lo = key == first ? LOW_OF(range_begin) : 0;
+        Uint32 hi = key == last ? LOW_OF(range_end - 1) : 0xffff;
+
+        Bool found;
+        Size pos = container_search(rb, (Uint16)key, &found);
+        if(!found) {
+            RoaringContainer* c = container_insert(rb, pos, (Uint16)key);
+            if(!c) return;
+            if(!container_realloc_as(rb, c, ROARING_CONTAINER_RUN, 1)) {
+                container_erase(rb, pos);
+                return;
+            }
+            RUNS_OF(c)[0].start  = (Uint16)lo;
+            RUNS_OF(c)[0].length = (Uint16)(hi - lo);
+            c->size        = 1;
+            c->cardinality = hi - lo + 1;
+            continue;
+        }
+
+        RoaringContainer* c = rb->containers + pos;
+        Uint64 words[ROARING_BITMAP_WORDS];
+        materialize(c, words);
+        words_set_range(words, lo, hi);
+        container_store_words(rb, c, words, words_popcount(words));
+    }
+}
+
+/**
+ * Get number of values in given compressed bitmap.
+ * This is linear in number of containers.
+ * @param rb
+ * */
+Uint64 roaring_cardinality(RoaringBitmap* rb) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, 0, ERR_INVALID_ARGUMENTS);
+
+    Uint64 total = 0;
+    for(Size i = 0; i < rb->count; i++) {
+        total += rb->containers[i].cardinality;
+    }
+    return total;
+}
+
+/**
+ * Convert each container to whichever of array, bitmap or run form takes
+ * least memory. Call this after bulk insertion of clustered values.
+ * @param rb
+ * */
+void roaring_run_optimize(RoaringBitmap* rb) {
+    ERR_RETURN_IF_FAIL(rb, ERR_INVALID_ARGUMENTS);
+
+    for(Size i = 0; i < rb->count; i++) {
+        RoaringContainer* c = rb->containers + i;
+
+        Size run_count  = container_run_count(c);
+        Size run_bytes  = run_count * sizeof(RoaringRun);
+        Size best_bytes = c->cardinality <= ROARING_ARRAY_MAX_SIZE ?
+            c->cardinality * sizeof(Uint16) : ROARING_BITMAP_WORDS * sizeof(Uint64);
+
+        if(run_bytes < best_bytes) {
+            if(c->type != ROARING_CONTAINER_RUN) container_to_runs(rb, c, (Uint32)run_count);
+        } else {
+            container_expand_runs(rb, c);
+        }
+    }
+}
+
+/*------------------------------- SET OPERATIONS -------------------------------*/
+
+typedef enum RoaringOp { ROARING_OP_AND, ROARING_OP_OR, ROARING_OP_XOR, ROARING_OP_ANDNOT } RoaringOp;
+
+/* merge two sorted arrays, keeping values selected by op */
+static Uint32 merge_arrays(const Uint16* a, Uint32 na, const Uint16* b, Uint32 nb, Uint16* out, RoaringOp op) {
+    Uint32 i = 0, j = 0, n = 0;
+    Bool keep_a = op != ROARING_OP_AND;           /* values only in a */
+    Bool keep_b = op == ROARING_OP_OR || op == ROARING_OP_XOR; /* values only in b */
+    Bool keep_both = op == ROARING_OP_AND || op == ROARING_OP_OR;
+
+    while(i < na && j < nb) {
+        if(a[i] < b[j]) {
+            if(keep_a) out[n++] = a[i];
+            i++;
+        } else if(b[j] < a[i]) {
+            if(keep_b) out[n++] = b[j];
+            j++;
+        } else {
+            if(keep_both) out[n++] = a[i];
+            i++;
+            j++;
+        }
+    }
+
+    if(keep_a) while(i < na) out[n++] = a[i++];
+    if(keep_b) while(j < nb) out[n++] = b[j++];
+
+    return n;
+}
+
+/**
+ * Compute op of two containers with same key into empty container @p out.
+ * Arrays are merged directly, and an array is probed against anything
+ * else when result can only shrink. Everything else goes through whole
+ * bitmaps. Leaves @p out empty if result has no values.
+ * */
+static Bool container_op(RoaringBitmap* rb, RoaringContainer* out, const RoaringContainer* a, const RoaringContainer* b, RoaringOp op) {
+    if(a->type == ROARING_CONTAINER_ARRAY && b->type == ROARING_CONTAINER_ARRAY) {
+        Uint16 values[2 * ROARING_ARRAY_MAX_SIZE];
+        Uint32 n = merge_arrays(ARRAY_OF(a), a->size, ARRAY_OF(b), b->size, values, op);
+        if(!n) return True;
+
+        if(n > ROARING_ARRAY_MAX_SIZE) {
+            Uint64 words[ROARING_BITMAP_WORDS] = {0};
+            for(Uint32 i = 0; i < n; i++) words[values[i] >> 6] |= (Uint64)1 << (values[i] & 63);
+            return container_store_words(rb, out, words, n);
+        }
+
+        if(!container_realloc_as(rb, out, ROARING_CONTAINER_ARRAY, n)) return False;
+        memcpy(out->data, values, n * sizeof(Uint16));
+        out->size = out->cardinality = n;
+        return True;
+    }
+
+    /* result is a subset of an array, probe it against other container */
+    const RoaringContainer* probe = NULL;
+    const RoaringContainer* other = NULL;
+    Bool expect = True;
+    if(op == ROARING_OP_AND && (a->type == ROARING_CONTAINER_ARRAY || b->type == ROARING_CONTAINER_ARRAY)) {
+        probe = a->type == ROARING_CONTAINER_ARRAY ? a : b;
+        other = probe == a ? b : a;
+    } else if(op == ROARING_OP_ANDNOT && a->type == ROARING_CONTAINER_ARRAY) {
+        probe  = a;
+        other  = b;
+        expect = False;
+    }
+
+    if(probe) {
+        Uint16 values[ROARING_ARRAY_MAX_SIZE];
+        Uint32 n = 0;
+        for(Uint32 i = 0; i < probe->size; i++) {
+            Uint16 v = ARRAY_OF(probe)[i];
+            if(container_contains(other, v) == expect) values[n++] = v;
+        }
+        if(!n) return True;
+
+        if(!container_realloc_as(rb, out, ROARING_CONTAINER_ARRAY, n)) return False;
+        memcpy(out->data, values, n * sizeof(Uint16));
+        out->size = out->cardinality = n;
+        return True;
+    }
+
+    Uint64 wa[ROARING_BITMAP_WORDS], wb[ROARING_BITMAP_WORDS];
+    materialize(a, wa);
+    materialize(b, wb);
+
+    Uint32 count = 0;
+    for(Size w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        switch(op) {
+            case ROARING_OP_AND: wa[w] &= wb[w]; break;
+            case ROARING_OP_OR: wa[w] |= wb[w]; break;
+            case ROARING_OP_XOR: wa[w] ^= wb[w]; break;
+            default: wa[w] &= ~wb[w]; break;
+        }
+        count += (Uint32)__builtin_popcountll(wa[w]);
+    }
+
+    return !count || container_store_words(rb, out, wa, count);
+}
+
+/**
+ * Create result of a set operation on two compressed bitmaps, walking
+ * containers of both in increasing order of keys.
+ * */
+static RoaringBitmap* operate_on_roaring_bitmaps(RoaringBitmap* rb1, RoaringBitmap* rb2, RoaringOp op) {
+    ERR_RETURN_VALUE_IF_FAIL(rb1 && rb2, NULL, ERR_INVALID_ARGUMENTS);
+
+    RoaringBitmap* res = roaring_create_with_allocator(rb1->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(res, NULL, ERR_INVALID_OBJECT);
+
+    Bool keep_a = op != ROARING_OP_AND;
+    Bool keep_b = op == ROARING_OP_OR || op == ROARING_OP_XOR;
+
+    Size i = 0, j = 0;
+    while(i < rb1->count || j < rb2->count) {
+        const RoaringContainer* a = i < rb1->count ? rb1->containers + i : NULL;
+        const RoaringContainer* b = j < rb2->count ? rb2->containers + j : NULL;
+
+        /* container present in only one of the operands */
+        const RoaringContainer* only = NULL;
+        Bool keep = False;
+        if(a && (!b || a->key < b->key)) {
+            only = a; keep = keep_a; i++;
+        } else if(b && (!a || b->key < a->key)) {
+            only = b; keep = keep_b; j++;
+        }
+
+        if(only) {
+            if(!keep) continue;
+            RoaringContainer* c = container_append(res, only->key);
+            if(!c || !container_clone(res, c, only)) goto FAILED;
+            continue;
+        }
+
+        RoaringContainer* c = container_append(res, a->key);
+        if(!c || !container_op(res, c, a, b, op)) goto FAILED;
+        if(!c->cardinality) res->count--;
+        i++;
+        j++;
+    }
+
+    return res;
+
+FAILED:
+    roaring_destroy(res);
+    return NULL;
+}
+
+/**
+ * Compute intersection of two compressed bitmaps.
+ * @param rb1
+ * @param rb2
+ * @return RoaringBitmap* containing values present in both, NULL on failure.
+ * */
+RoaringBitmap* roaring_and(RoaringBitmap* rb1, RoaringBitmap* rb2) {
+    return operate_on_roaring_bitmaps(rb1, rb2, ROARING_OP_AND);
+}
+
+/**
+ * Compute union of two compressed bitmaps.
+ * @param rb1
+ * @param rb2
+ * @return RoaringBitmap* containing values present in any one, NULL on failure.
+ * */
+RoaringBitmap* roaring_or(RoaringBitmap* rb1, RoaringBitmap* rb2) {
+    return operate_on_roaring_bitmaps(rb1, rb2, ROARING_OP_OR);
+}
+
+/**
+ * Compute symmetric difference of two compressed bitmaps.
+ * @param rb1
+ * @param rb2
+ * @return RoaringBitmap* containing values present in exactly one, NULL on failure.
+ * */
+RoaringBitmap* roaring_xor(RoaringBitmap* rb1, RoaringBitmap* rb2) {
+    return operate_on_roaring_bitmaps(rb1, rb2, ROARING_OP_XOR);
+}
+
+/**
+ * Compute difference of two compressed bitmaps.
+ * @param rb1
+ * @param rb2 Values to be removed from @p rb1.
+ * @return RoaringBitmap* containing values of @p rb1 not in @p rb2, NULL on failure.
+ * */
+RoaringBitmap* roaring_andnot(RoaringBitmap* rb1, RoaringBitmap* rb2) {
+    return operate_on_roaring_bitmaps(rb1, rb2, ROARING_OP_ANDNOT);
+}
+
+/**
+ * Check whether two compressed bitmaps contain same values,
+ * irrespective of form their containers are stored in.
+ * @param rb1
+ * @param rb2
+ * */
+Bool roaring_cmpeq(RoaringBitmap* rb1, RoaringBitmap* rb2) {
+    ERR_RETURN_VALUE_IF_FAIL(rb1 && rb2, False, ERR_INVALID_ARGUMENTS);
+    if(rb1->count != rb2->count) return False;
+
+    for(Size i = 0; i < rb1->count; i++) {
+        const RoaringContainer* a = rb1->containers + i;
+        const RoaringContainer* b = rb2->containers + i;
+        if(a->key != b->key || a->cardinality != b->cardinality) return False;
+
+        if(a->type == b->type && a->type != ROARING_CONTAINER_BITMAP) {
+            if(a->size != b->size || memcmp(a->data, b->data, a->size * element_size(a->type))) return False;
+            continue;
+        }
+
+        Uint64 wa[ROARING_BITMAP_WORDS], wb[ROARING_BITMAP_WORDS];
+        materialize(a, wa);
+        materialize(b, wb);
+        if(memcmp(wa, wb, sizeof(wa))) return False;
+    }
+
+    return True;
+}
+
+/**
+ * Call @p visitor for each value in given compressed bitmap,
+ * in increasing order. @p visitor must not modify @p rb.
+ *
+ * @param rb
+ * @param visitor Callback to be called for each value.
+ * @param udata User data to be passed to @p visitor.
+ * */
+void roaring_foreach(RoaringBitmap* rb, RoaringVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(rb && visitor, ERR_INVALID_ARGUMENTS);
+
+    for(Size i = 0; i < rb->count; i++) {
+        const RoaringContainer* c = rb->containers + i;
+        Uint32 high = (Uint32)c->key << 16;
+
+        switch(c->type) {
+            case ROARING_CONTAINER_ARRAY:
+                for(Uint32 k = 0; k < c->size; k++) {
+                    visitor(high | ARRAY_OF(c)[k], udata);
+                }
+                break;
+            case ROARING_CONTAINER_BITMAP:
+                for(Uint32 w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                    for(Uint64 word = WORDS_OF(c)[w]; word; word &= word - 1) {
+                        visitor(high | (w * 64 + (Uint32)__builtin_ctzll(word)), udata);
+                    }
+                }
+                break;
+            default:
+                for(Uint32 r = 0; r < c->size; r++) {
+                    Uint32 start = RUNS_OF(c)[r].start;
+                    Uint32 end   = start + RUNS_OF(c)[r].length;
+                    for(Uint32 v = start; v <= end; v++) {
+                        visitor(high | v, udata);
+                    }
+                }
+                break;
+        }
+    }
+}
+
+/*------------------------------- SERIALIZATION -------------------------------*/
+
+/**
+ * Get number of bytes @c roaring_serialize needs to store given bitmap.
+ * @param rb
+ * */
+Size roaring_serialized_size(RoaringBitmap* rb) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, 0, ERR_INVALID_ARGUMENTS);
+
+    Size size = SERIAL_HEADER_SIZE + rb->count * SERIAL_CONTAINER_HEADER_SIZE;
+    for(Size i = 0; i < rb->count; i++) {
+        size += rb->containers[i].size * element_size(rb->containers[i].type);
+    }
+    return size;
+}
+
+/**
+ * Store given compressed bitmap in a flat buffer.
+ *
+ * Layout is a magic number and container count, then a header of key, type,
+ * cardinality and size for each container, followed by data of all
+ * containers in same order. Integers are stored in native byte order, so
+ * the buffer can be read back only on machines of same endianness.
+ *
+ * @param rb
+ * @param buffer Memory to store bitmap in.
+ * @param buffer_size Size of @p buffer, must be at least @c roaring_serialized_size.
+ * @return Number of bytes written on success.
+ * @return 0 if buffer is too small.
+ * */
+Size roaring_serialize(RoaringBitmap* rb, void* buffer, Size buffer_size) {
+    ERR_RETURN_VALUE_IF_FAIL(rb && buffer, 0, ERR_INVALID_ARGUMENTS);
+
+    Size size = roaring_serialized_size(rb);
+    ERR_RETURN_VALUE_IF_FAIL(buffer_size >= size, 0, ERR_INVALID_LENGTH);
+
+    Uint8* p     = buffer;
+    Uint32 magic = ROARING_SERIAL_MAGIC;
+    Uint32 count = (Uint32)rb->count;
+    memcpy(p, &magic, 4);
+    memcpy(p + 4, &count, 4);
+
+    Uint8* hdr  = p + SERIAL_HEADER_SIZE;
+    Uint8* data = hdr + rb->count * SERIAL_CONTAINER_HEADER_SIZE;
+    for(Size i = 0; i < rb->count; i++) {
+        const RoaringContainer* c = rb->containers + i;
+        memcpy(hdr, &c->key, 2);
+        memcpy(hdr + 2, &c->type, 2);
+        memcpy(hdr + 4, &c->cardinality, 4);
+        memcpy(hdr + 8, &c->size, 4);
+        hdr += SERIAL_CONTAINER_HEADER_SIZE;
+
+        Size nbytes = c->size * element_size(c->type);
+        memcpy(data, c->data, nbytes);
+        data += nbytes;
+    }
+
+    return size;
+}
+
+/* check that data of a deserialized container is well formed */
+static Bool container_is_valid(const RoaringContainer* c) {
+    if(!c->cardinality) return False;
+
+    switch(c->type) {
+        case ROARING_CONTAINER_ARRAY: {
+            if(c->size != c->cardinality || c->size > ROARING_ARRAY_MAX_SIZE) return False;
+            for(Uint32 i = 1; i < c->size; i++) {
+                if(ARRAY_OF(c)[i] <= ARRAY_OF(c)[i - 1]) return False;
+            }
+            return True;
+        }
+        case ROARING_CONTAINER_BITMAP:
+            return c->size == ROARING_BITMAP_WORDS && words_popcount(WORDS_OF(c)) == c->cardinality;
+        case ROARING_CONTAINER_RUN: {
+            Uint32 total = 0;
+            for(Uint32 r = 0; r < c->size; r++) {
+                const RoaringRun* run = RUNS_OF(c) + r;
+                if(r && run->start <= (Uint32)run[-1].start + run[-1].length + 1) return False;
+                if((Uint32)run->start + run->length >= ROARING_CHUNK_SIZE) return False;
+                total += (Uint32)run->length + 1;
+            }
+            return c->size && total == c->cardinality;
+        }
+        default:
+            return False;
+    }
+}
+
+/**
+ * Create a compressed bitmap from a buffer filled by @c roaring_serialize.
+ * @param buffer
+ * @param buffer_size
+ * @return RoaringBitmap* on success.
+ * @return NULL if buffer is malformed or allocation failed.
+ * */
+RoaringBitmap* roaring_deserialize(const void* buffer, Size buffer_size) {
+    return roaring_deserialize_with_allocator(buffer, buffer_size, NULL);
+}
+
+/**
+ * Same as @c roaring_deserialize, but allocates all memory of new bitmap
+ * from given allocator.
+ * @param buffer
+ * @param buffer_size
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return RoaringBitmap* on success.
+ * @return NULL if buffer is malformed or allocation failed.
+ * */
+RoaringBitmap* roaring_deserialize_with_allocator(const void* buffer, Size buffer_size, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(buffer, NULL, ERR_INVALID_ARGUMENTS);
+
+    /* buffer may come from anywhere, so it's contents are checked even in unchecked builds */
+    ERR_RETURN_VALUE_IF_FAIL(buffer_size >= SERIAL_HEADER_SIZE, NULL, ERR_INVALID_CONTENTS);
+
+    const Uint8* p = buffer;
+    Uint32 magic, count;
+    memcpy(&magic, p, 4);
+    memcpy(&count, p + 4, 4);
+    ERR_RETURN_VALUE_IF_FAIL(magic == ROARING_SERIAL_MAGIC, NULL, ERR_INVALID_CONTENTS);
+    ERR_RETURN_VALUE_IF_FAIL(count <= ROARING_CHUNK_SIZE, NULL, ERR_INVALID_CONTENTS);
+
+    Size data_offset = SERIAL_HEADER_SIZE + (Size)count * SERIAL_CONTAINER_HEADER_SIZE;
+    ERR_RETURN_VALUE_IF_FAIL(buffer_size >= data_offset, NULL, ERR_INVALID_CONTENTS);
+
+    RoaringBitmap* rb = roaring_create_with_allocator(allocator);
+    ERR_RETURN_VALUE_IF_FAIL(rb, NULL, ERR_INVALID_OBJECT);
+
+    const Uint8* hdr  = p + SERIAL_HEADER_SIZE;
+    const Uint8* data = p + data_offset;
+    const Uint8* end  = p + buffer_size;
+    for(Uint32 i = 0; i < count; i++) {
+        RoaringContainer tmp = {0};
+        memcpy(&tmp.key, hdr, 2);
+        memcpy(&tmp.type, hdr + 2, 2);
+        memcpy(&tmp.cardinality, hdr + 4, 4);
+        memcpy(&tmp.size, hdr + 8, 4);
+        hdr += SERIAL_CONTAINER_HEADER_SIZE;
+
+        if(tmp.type > ROARING_CONTAINER_RUN || !tmp.size || tmp.size > ROARING_CHUNK_SIZE) goto MALFORMED;
+        if(rb->count && tmp.key <= rb->containers[rb->count - 1].key) goto MALFORMED;
+
+        Size nbytes = tmp.size * element_size(tmp.type);
+        if((Size)(end - data) < nbytes) goto MALFORMED;
+
+        RoaringContainer* c = container_append(rb, tmp.key);
+        if(!c) goto FAILED;
+        tmp.data = (void*)data;
+        if(!container_clone(rb, c, &tmp)) {
+            rb->count--;
+            goto FAILED;
+        }
+        data += nbytes;
+
+        if(!container_is_valid(c)) goto MALFORMED;
+    }
+
+    return rb;
+
+MALFORMED:
+    ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_CONTENTS));
+FAILED:
+    roaring_destroy(rb);
+    return NULL;
+}
+
+/*------------------------------- CONVERSION -------------------------------*/
+
+/**
+ * Create a compressed bitmap containing index of each set bit of given
+ * @c BitVector. Bits at or past (1 << 32) are ignored.
+ *
+ * @param bv
+ * @return RoaringBitmap* on success, using allocator of @p bv.
+ * @return NULL otherwise.
+ * */
+RoaringBitmap* roaring_from_bitvec(BitVector* bv) {
+    ERR_RETURN_VALUE_IF_FAIL(bv, NULL, ERR_INVALID_ARGUMENTS);
+
+    RoaringBitmap* rb = roaring_create_with_allocator(bv->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(rb, NULL, ERR_INVALID_OBJECT);
+
+    Size length = MIN(bv->length, (Size)1 << 32);
+    Size nwords = (length + 63) / 64;
+    for(Size first = 0; first < nwords; first += ROARING_BITMAP_WORDS) {
+        /* copy one chunk of words, bits past length are always cleared */
+        Uint64 words[ROARING_BITMAP_WORDS] = {0};
+        Size   n = MIN((Size)ROARING_BITMAP_WORDS, nwords - first);
+        memcpy(words, bv->data + first * 8, n * 8);
+        if(length < (first + n) * 64) {
+            words[n - 1] &= ~(Uint64)0 >> (64 - length % 64);
+        }
+
+        Uint32 count = 0;
+        for(Size w = 0; w < n; w++) count += (Uint32)__builtin_popcountll(words[w]);
+        if(!count) continue;
+
+        RoaringContainer* c = container_append(rb, (Uint16)(first / ROARING_BITMAP_WORDS));
+        if(!c || !container_store_words(rb, c, words, count)) {
+            if(c) rb->count--;
+            roaring_destroy(rb);
+            return NULL;
+        }
+    }
+
+    return rb;
+}
+
+/* largest value in a non-empty container */
+static Uint32 container_maximum(const RoaringContainer* c) {
+    switch(c->type) {
+        case ROARING_CONTAINER_ARRAY:
+            return ARRAY_OF(c)[c->size - 1];
+        case ROARING_CONTAINER_RUN:
+            return (Uint32)RUNS_OF(c)[c->size - 1].start + RUNS_OF(c)[c->size - 1].length;
+        default: {
+            Uint32 w = ROARING_BITMAP_WORDS;
+            while(!WORDS_OF(c)[--w]);
+            return w * 64 + 63 - (Uint32)__builtin_clzll(WORDS_OF(c)[w]);
+        }
+    }
+}
+
+/**
+ * Create a dense @c BitVector with a bit set for each value in given
+ * compressed bitmap. Length of @c BitVector is one more than largest value.
+ *
+ * @param rb
+ * @return BitVector* on success, using allocator of @p rb.
+ * @return INVALID_BITVECTOR otherwise.
+ * */
+BitVector* roaring_to_bitvec(RoaringBitmap* rb) {
+    ERR_RETURN_VALUE_IF_FAIL(rb, INVALID_BITVECTOR, ERR_INVALID_ARGUMENTS);
+
+    BitVector* bv = bitvec_create_with_allocator(rb->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(bv, INVALID_BITVECTOR, ERR_INVALID_OBJECT);
+    if(!rb->count) return bv;
+
+    const RoaringContainer* last = rb->containers + rb->count - 1;
+    Size length = ((Size)last->key << 16) + container_maximum(last) + 1;
+    bitvec_resize(bv, length);
+    if(bv->length != length) {
+        bitvec_destroy(bv);
+        return INVALID_BITVECTOR;
+    }
+
+    Uint64 words[ROARING_BITMAP_WORDS];
+    for(Size i = 0; i < rb->count; i++) {
+        const RoaringContainer* c = rb->containers + i;
+        materialize(c, words);
+
+        /* last chunk may be shorter than a full chunk */
+        Size offset = (Size)c->key * ROARING_BITMAP_WORDS * 8;
+        memcpy(bv->data + offset, words, MIN(ROARING_BITMAP_WORDS * 8, (length + 7) / 8 - offset));
+    }
+
+    return bv;
+}
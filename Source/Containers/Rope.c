@@ -0,0 +1,494 @@
+/**
+ * @file Rope.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Ropes are built with AVL join : joining two trees walks down the
+ * spine of taller one until heights match, and rebalances on way back up,
+ * in time proportional to difference of their heights. Slicing is done by
+ * joining pieces of tree on either side of the range.
+ *
+ * All static functions creating nodes take over references passed to them,
+ * and return a new reference, or NULL after releasing their inputs if an
+ * allocation fails.
+ * */
+
+#include <Anvie/Containers/Rope.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+#define IS_LEAF(node) (!(node)->left)
+
+static FORCE_INLINE RopeNode* retain(RopeNode* node) {
+    if(node) {
+        node->refcount++;
+    }
+    return node;
+}
+
+/* drop a reference, freeing node and releasing it's children when it's the last one */
+static void release(Allocator* allocator, RopeNode* node) {
+    if(!node || --node->refcount) {
+        return;
+    }
+
+    if(IS_LEAF(node)) {
+        allocator_free(allocator, node, sizeof(RopeNode) + node->length);
+    } else {
+        release(allocator, node->left);
+        release(allocator, node->right);
+        allocator_free(allocator, node, sizeof(RopeNode));
+    }
+}
+
+/* create a leaf holding @p n1 bytes of @p d1 followed by @p n2 bytes of @p d2 */
+static RopeNode* new_leaf(Allocator* allocator, const Char* d1, Size n1, const Char* d2, Size n2) {
+    RopeNode* leaf = allocator_allocate(allocator, sizeof(RopeNode) + n1 + n2);
+    if(!leaf) {
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    leaf->left     = NULL;
+    leaf->right    = NULL;
+    leaf->length   = n1 + n2;
+    leaf->height   = 0;
+    leaf->refcount = 1;
+    memcpy(leaf->data, d1, n1);
+    if(n2) {
+        memcpy(leaf->data + n1, d2, n2);
+    }
+    return leaf;
+}
+
+/* concatenate two trees without any rebalancing */
+static RopeNode* new_concat(Allocator* allocator, RopeNode* left, RopeNode* right) {
+    RopeNode* node = left && right ? allocator_allocate(allocator, sizeof(RopeNode)) : NULL;
+    if(!node) {
+        if(left && right) {
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        }
+        release(allocator, left);
+        release(allocator, right);
+        return NULL;
+    }
+
+    node->left     = left;
+    node->right    = right;
+    node->length   = left->length + right->length;
+    node->height   = MAX(left->height, right->height) + 1;
+    node->refcount = 1;
+    return node;
+}
+
+/* concatenate two balanced trees whose heights differ by atmost 2, rotating once or twice if needed */
+static RopeNode* balance(Allocator* allocator, RopeNode* left, RopeNode* right) {
+    if(left && right && right->height > left->height + 1) {
+        RopeNode* rl = retain(right->left);
+        RopeNode* rr = retain(right->right);
+        release(allocator, right);
+
+        if(rr->height >= rl->height) {
+            return new_concat(allocator, new_concat(allocator, left, rl), rr);
+        }
+
+        RopeNode* rll = retain(rl->left);
+        RopeNode* rlr = retain(rl->right);
+        release(allocator, rl);
+        return new_concat(allocator, new_concat(allocator, left, rll), new_concat(allocator, rlr, rr));
+    }
+
+    if(left && right && left->height > right->height + 1) {
+        RopeNode* ll = retain(left->left);
+        RopeNode* lr = retain(left->right);
+        release(allocator, left);
+
+        if(ll->height >= lr->height) {
+            return new_concat(allocator, ll, new_concat(allocator, lr, right));
+        }
+
+        RopeNode* lrl = retain(lr->left);
+        RopeNode* lrr = retain(lr->right);
+        release(allocator, lr);
+        return new_concat(allocator, new_concat(allocator, ll, lrl), new_concat(allocator, lrr, right));
+    }
+
+    return new_concat(allocator, left, right);
+}
+
+/**
+ * Join two balanced trees into one. Taller tree is walked down towards
+ * shorter one until heights are close. A leaf is always pushed down to
+ * the leaf next to it, so that small appends merge into that leaf
+ * instead of growing the tree.
+ * */
+static RopeNode* join(Allocator* allocator, RopeNode* left, RopeNode* right) {
+    if(!left) {
+        return right;
+    }
+    if(!right) {
+        return left;
+    }
+
+    if(IS_LEAF(left) && IS_LEAF(right)) {
+        if(left->length + right->length > ROPE_LEAF_SIZE) {
+            return new_concat(allocator, left, right);
+        }
+
+        RopeNode* merged = new_leaf(allocator, left->data, left->length, right->data, right->length);
+        release(allocator, left);
+        release(allocator, right);
+        return merged;
+    }
+
+    if(left->height > right->height + 1 || IS_LEAF(right)) {
+        RopeNode* ll = retain(left->left);
+        RopeNode* lr = retain(left->right);
+        release(allocator, left);
+
+        RopeNode* joined = join(allocator, lr, right);
+        if(!joined) {
+            release(allocator, ll);
+            return NULL;
+        }
+        return balance(allocator, ll, joined);
+    }
+
+    if(right->height > left->height + 1 || IS_LEAF(left)) {
+        RopeNode* rl = retain(right->left);
+        RopeNode* rr = retain(right->right);
+        release(allocator, right);
+
+        RopeNode* joined = join(allocator, left, rl);
+        if(!joined) {
+            release(allocator, rr);
+            return NULL;
+        }
+        return balance(allocator, joined, rr);
+    }
+
+    return new_concat(allocator, left, right);
+}
+
+/* build a balanced tree of leaves of @c ROPE_LEAF_SIZE bytes over @p n bytes, n must not be 0 */
+static RopeNode* build(Allocator* allocator, const Char* data, Size n) {
+    if(n <= ROPE_LEAF_SIZE) {
+        return new_leaf(allocator, data, n, NULL, 0);
+    }
+
+    Size leaf_count = (n + ROPE_LEAF_SIZE - 1) / ROPE_LEAF_SIZE;
+    Size left_n     = (leaf_count / 2) * ROPE_LEAF_SIZE;
+    RopeNode* left  = build(allocator, data, left_n);
+    RopeNode* right = left ? build(allocator, data + left_n, n - left_n) : NULL;
+    return new_concat(allocator, left, right);
+}
+
+/* new reference to tree of characters [pos, pos + n) of @p node, n must not be 0 */
+static RopeNode* slice(Allocator* allocator, RopeNode* node, Size pos, Size n) {
+    if(!pos && n == node->length) {
+        return retain(node);
+    }
+    if(IS_LEAF(node)) {
+        return new_leaf(allocator, node->data + pos, n, NULL, 0);
+    }
+
+    Size left_length = node->left->length;
+    if(pos + n <= left_length) {
+        return slice(allocator, node->left, pos, n);
+    }
+    if(pos >= left_length) {
+        return slice(allocator, node->right, pos - left_length, n);
+    }
+
+    RopeNode* left  = slice(allocator, node->left, pos, left_length - pos);
+    RopeNode* right = left ? slice(allocator, node->right, 0, pos + n - left_length) : NULL;
+    if(!right) {
+        release(allocator, left);
+        return NULL;
+    }
+    return join(allocator, left, right);
+}
+
+/* copy characters [pos, pos + n) of @p node to @p dst */
+static void copy_range(RopeNode* node, Size pos, Char* dst, Size n) {
+    while(!IS_LEAF(node)) {
+        Size left_length = node->left->length;
+        if(pos + n <= left_length) {
+            node = node->left;
+        } else if(pos >= left_length) {
+            pos  -= left_length;
+            node  = node->right;
+        } else {
+            Size count = left_length - pos;
+            copy_range(node->left, pos, dst, count);
+            dst  += count;
+            n    -= count;
+            pos   = 0;
+            node  = node->right;
+        }
+    }
+    memcpy(dst, node->data + pos, n);
+}
+
+static Bool visit_leaves(RopeNode* node, RopeVisitorCallback visitor, void* udata) {
+    while(!IS_LEAF(node)) {
+        if(!visit_leaves(node->left, visitor, udata)) {
+            return False;
+        }
+        node = node->right;
+    }
+    return visitor(strview(node->data, node->length), udata);
+}
+
+/**
+ * Create a new rope holding a copy of given characters.
+ *
+ * @param sv Characters of rope, can be empty.
+ * @param allocator Allocator for rope and it's nodes. NULL means system allocator.
+ * @return Rope on success, NULL otherwise.
+ * */
+Rope* rope_create(StringView sv, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(sv.data || !sv.length, NULL, ERR_INVALID_ARGUMENTS);
+
+    Rope* rope = allocator_allocate_zeroed(allocator, sizeof(Rope));
+    ERR_RETURN_VALUE_IF_FAIL(rope, NULL, ERR_OUT_OF_MEMORY);
+    rope->allocator = allocator;
+
+    if(sv.length) {
+        rope->root = build(allocator, sv.data, sv.length);
+        if(!rope->root) {
+            allocator_free(allocator, rope, sizeof(Rope));
+            return NULL;
+        }
+    }
+    return rope;
+}
+
+/**
+ * Create a rope with same characters as given one, in constant time.
+ * Both share all their nodes.
+ *
+ * @param rope
+ * @return Rope on success, NULL otherwise.
+ * */
+Rope* rope_clone(Rope* rope) {
+    ERR_RETURN_VALUE_IF_FAIL(rope, NULL, ERR_INVALID_ARGUMENTS);
+
+    Rope* clone = allocator_allocate_zeroed(rope->allocator, sizeof(Rope));
+    ERR_RETURN_VALUE_IF_FAIL(clone, NULL, ERR_OUT_OF_MEMORY);
+
+    clone->root      = retain(rope->root);
+    clone->allocator = rope->allocator;
+    return clone;
+}
+
+/**
+ * Destroy given rope. Nodes shared with other ropes stay alive.
+ *
+ * @param rope
+ * */
+void rope_destroy(Rope* rope) {
+    ERR_RETURN_IF_FAIL(rope, ERR_INVALID_ARGUMENTS);
+
+    release(rope->allocator, rope->root);
+    allocator_free(rope->allocator, rope, sizeof(Rope));
+}
+
+/* replace root of rope with join of it and @p right, keeping rope unchanged on failure */
+static Bool append_node(Rope* rope, RopeNode* right) {
+    if(!right) {
+        return False;
+    }
+
+    RopeNode* joined = join(rope->allocator, retain(rope->root), right);
+    if(!joined) {
+        return False;
+    }
+
+    release(rope->allocator, rope->root);
+    rope->root = joined;
+    return True;
+}
+
+/**
+ * Append a copy of given characters to end of rope. Short appends are
+ * merged into last leaf of rope.
+ *
+ * @param rope
+ * @param sv Characters to append.
+ * @return True on success, False otherwise. Rope is unchanged on failure.
+ * */
+Bool rope_append_view(Rope* rope, StringView sv) {
+    ERR_RETURN_VALUE_IF_FAIL(rope && (sv.data || !sv.length), False, ERR_INVALID_ARGUMENTS);
+    if(!sv.length) {
+        return True;
+    }
+    return append_node(rope, build(rope->allocator, sv.data, sv.length));
+}
+
+/**
+ * Append characters of another rope to end of given rope, sharing
+ * nodes of @p other instead of copying them.
+ *
+ * @param rope Rope to append to.
+ * @param other Rope to append, may be same as @p rope.
+ * @return True on success, False otherwise. Rope is unchanged on failure.
+ * */
+Bool rope_append(Rope* rope, Rope* other) {
+    ERR_RETURN_VALUE_IF_FAIL(rope && other, False, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(rope->allocator == other->allocator, False, ERR_INVALID_ARGUMENTS);
+    if(!other->root) {
+        return True;
+    }
+    return append_node(rope, retain(other->root));
+}
+
+/**
+ * Create a new rope holding characters of @p rope1 followed by those of
+ * @p rope2, in O(log n) time. Both ropes are unchanged.
+ *
+ * @param rope1
+ * @param rope2
+ * @return Rope on success, NULL otherwise.
+ * */
+Rope* rope_concat(Rope* rope1, Rope* rope2) {
+    ERR_RETURN_VALUE_IF_FAIL(rope1 && rope2, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(rope1->allocator == rope2->allocator, NULL, ERR_INVALID_ARGUMENTS);
+
+    Rope* rope = rope_clone(rope1);
+    if(!rope) {
+        return NULL;
+    }
+    if(!rope_append(rope, rope2)) {
+        rope_destroy(rope);
+        return NULL;
+    }
+    return rope;
+}
+
+/**
+ * Create a new rope holding part of a rope, in O(log n) time. Only leaves
+ * at both ends of the part are copied, everything in between is shared.
+ * Out of range positions and lengths are clamped to end of rope.
+ *
+ * @param rope
+ * @param pos First character of part.
+ * @param length Maximum number of characters in part, @c SIZE_MAX for upto end.
+ * @return Rope on success, NULL otherwise.
+ * */
+Rope* rope_slice(Rope* rope, Size pos, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(rope, NULL, ERR_INVALID_ARGUMENTS);
+
+    Rope* part = allocator_allocate_zeroed(rope->allocator, sizeof(Rope));
+    ERR_RETURN_VALUE_IF_FAIL(part, NULL, ERR_OUT_OF_MEMORY);
+    part->allocator = rope->allocator;
+
+    Size total = rope_length(rope);
+    pos        = MIN(pos, total);
+    length     = MIN(length, total - pos);
+    if(length) {
+        part->root = slice(rope->allocator, rope->root, pos, length);
+        if(!part->root) {
+            allocator_free(rope->allocator, part, sizeof(Rope));
+            return NULL;
+        }
+    }
+    return part;
+}
+
+/**
+ * Get character at given position, in O(log n) time.
+ *
+ * @param rope
+ * @param pos Position of character, must be less than length of rope.
+ * @return Character at @p pos, 0 if @p pos is out of range.
+ * */
+Char rope_char_at(Rope* rope, Size pos) {
+    ERR_RETURN_VALUE_IF_FAIL(rope && pos < rope_length(rope), 0, ERR_INVALID_ARGUMENTS);
+
+    RopeNode* node = rope->root;
+    while(!IS_LEAF(node)) {
+        if(pos < node->left->length) {
+            node = node->left;
+        } else {
+            pos  -= node->left->length;
+            node  = node->right;
+        }
+    }
+    return node->data[pos];
+}
+
+/**
+ * Copy characters of part of a rope to given buffer.
+ *
+ * @param rope
+ * @param pos First character to copy.
+ * @param dst Buffer to copy to, not null terminated after copy.
+ * @param n Maximum number of characters to copy.
+ * @return Number of characters copied, less than @p n if rope ends before.
+ * */
+Size rope_copy_to(Rope* rope, Size pos, Char* dst, Size n) {
+    ERR_RETURN_VALUE_IF_FAIL(rope && (dst || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    Size total = rope_length(rope);
+    pos        = MIN(pos, total);
+    n          = MIN(n, total - pos);
+    if(n) {
+        copy_range(rope->root, pos, dst, n);
+    }
+    return n;
+}
+
+/**
+ * Call given visitor with each leaf of rope, in order, eg: to write rope
+ * to a file without making it contiguous first.
+ *
+ * @param rope
+ * @param visitor Called once per leaf, returning False stops the visit.
+ * @param udata Passed to each call to @p visitor.
+ * @return False if visitor stopped the visit, True otherwise.
+ * */
+Bool rope_foreach_chunk(Rope* rope, RopeVisitorCallback visitor, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(rope && visitor, False, ERR_INVALID_ARGUMENTS);
+    return !rope->root || visit_leaves(rope->root, visitor, udata);
+}
+
+/**
+ * Copy characters of rope into a new @c String, allocated exactly large enough.
+ *
+ * @param rope
+ * @return String on success, NULL otherwise.
+ * */
+String* rope_to_string(Rope* rope) {
+    ERR_RETURN_VALUE_IF_FAIL(rope, NULL, ERR_INVALID_ARGUMENTS);
+
+    String* str = str_create_with_allocator(NULL, rope->allocator);
+    if(!str) {
+        return NULL;
+    }
+
+    Size length = rope_length(rope);
+    if(length) {
+        str_reserve(str, length);
+        if(str->capacity < length) {
+            str_destroy(str);
+            return NULL;
+        }
+        str->length = rope_copy_to(rope, 0, str->data, length);
+    }
+    return str;
+}
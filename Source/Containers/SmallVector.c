@@ -0,0 +1,181 @@
+/**
+ * @file SmallVector.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of inline storage aware allocator for small vectors.
+ * */
+
+#include <Anvie/Containers/SmallVector.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* allocations other than vector data never use inline storage */
+static void* small_vector_allocate(Size size, void* ctx) {
+    SmallVector* sv = ctx;
+    return allocator_allocate(sv->parent, size);
+}
+
+static void* small_vector_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    SmallVector* sv = ctx;
+
+    if(ptr == sv->storage) {
+        // still fits inline
+        if(new_size <= sv->storage_size) return ptr;
+
+        // spill to heap
+        void* mem = allocator_allocate(sv->parent, new_size);
+        ERR_RETURN_VALUE_IF_FAIL(mem, NULL, ERR_OUT_OF_MEMORY);
+        memcpy(mem, ptr, MIN(old_size, sv->storage_size));
+        return mem;
+    }
+
+    // shrunk enough to move back inline, only for small vector's own buffer, never for a clone's
+    if(ptr && ptr == (void*)sv->vec.data && new_size <= sv->storage_size) {
+        memcpy(sv->storage, ptr, new_size);
+        allocator_free(sv->parent, ptr, old_size);
+        return sv->storage;
+    }
+
+    return allocator_reallocate(sv->parent, ptr, old_size, new_size);
+}
+
+static void small_vector_free(void* ptr, Size size, void* ctx) {
+    SmallVector* sv = ctx;
+
+    // inline storage and header live inside small vector itself
+    if(ptr == sv->storage || ptr == (void*)sv) return;
+
+    allocator_free(sv->parent, ptr, size);
+}
+
+/**
+ * Initialize a small vector. No memory is allocated.
+ * If any one of @c create_copy or @c destroy_copy is non null,
+ * then both must be non null!
+ *
+ * @param sv Small vector to be initialized. Must not be moved after this.
+ * @param element_size Size of each element.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @param storage Inline storage of @p inline_count elements, usually placed right after @p sv.
+ * @param inline_count Number of elements that fit in @p storage. Must be non zero.
+ * @param parent Allocator to use when elements don't fit inline. NULL means system allocator.
+ * */
+void small_vector_init(SmallVector* sv,
+                       Size element_size,
+                       CreateElementCopyCallback create_copy,
+                       DestroyElementCopyCallback destroy_copy,
+                       void* storage,
+                       Size inline_count,
+                       Allocator* parent)
+{
+    ERR_RETURN_IF_FAIL(sv && element_size && storage && inline_count, ERR_INVALID_ARGUMENTS);
+
+    // both must be null or non null at the same time
+    Bool b1 = create_copy != NULL;
+    Bool b2 = destroy_copy != NULL;
+    ERR_RETURN_IF_FAIL(!(b1 ^ b2), ERR_INVALID_ARGUMENTS);
+
+    sv->parent       = parent;
+    sv->storage      = storage;
+    sv->storage_size = inline_count * element_size;
+
+    sv->allocator.allocate   = small_vector_allocate;
+    sv->allocator.reallocate = small_vector_reallocate;
+    sv->allocator.free       = allocator_needs_free(parent) ? small_vector_free : NULL;
+    sv->allocator.ctx        = sv;
+
+    memset(storage, 0, sv->storage_size);
+
+    Vector* vec        = &sv->vec;
+    vec->element_size  = element_size;
+    vec->length        = 0;
+    vec->capacity      = inline_count;
+    vec->data          = storage;
+    vec->create_copy   = create_copy;
+    vec->destroy_copy  = destroy_copy;
+    vec->resize_factor = 1;
+    vec->allocator     = &sv->allocator;
+    vec->growth_policy = NULL;
+}
+
+/**
+ * Destroy all elements of small vector and release heap memory if any.
+ * Small vector itself is not freed.
+ *
+ * @param sv
+ * @param udata User data to be passed to callback functions.
+ * */
+void small_vector_deinit(SmallVector* sv, void* udata) {
+    ERR_RETURN_IF_FAIL(sv, ERR_INVALID_ARGUMENTS);
+
+    // this also "frees" vector header, which is a no-op for small vector
+    vector_destroy(&sv->vec, udata);
+}
+
+/**
+ * Create a small vector in a single allocation from @p parent.
+ * Inline storage is placed at @p storage_offset inside the allocated object.
+ * Typed small vectors call this with size and layout of their own struct.
+ *
+ * @param object_size Total size of small vector object, including inline storage.
+ * @param storage_offset Offset of inline storage from start of object.
+ * @param element_size Size of each element.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @param inline_count Number of elements that fit inline. Must be non zero.
+ * @param parent Allocator to allocate object and heap storage from. NULL means system allocator.
+ *
+ * @return SmallVector* on success.
+ * @return NULL otherwise.
+ * */
+SmallVector* small_vector_create(Size object_size,
+                                 Size storage_offset,
+                                 Size element_size,
+                                 CreateElementCopyCallback create_copy,
+                                 DestroyElementCopyCallback destroy_copy,
+                                 Size inline_count,
+                                 Allocator* parent)
+{
+    ERR_RETURN_VALUE_IF_FAIL(storage_offset >= sizeof(SmallVector) &&
+                             storage_offset + inline_count * element_size <= object_size,
+                             NULL, ERR_INVALID_ARGUMENTS);
+
+    SmallVector* sv = allocator_allocate(parent, object_size);
+    ERR_RETURN_VALUE_IF_FAIL(sv, NULL, ERR_OUT_OF_MEMORY);
+
+    small_vector_init(sv, element_size, create_copy, destroy_copy, (Byte*)sv + storage_offset, inline_count, parent);
+
+    return sv;
+}
+
+/**
+ * Destroy a small vector created using @c small_vector_create.
+ *
+ * @param sv
+ * @param object_size Same size small vector was created with.
+ * @param udata User data to be passed to callback functions.
+ * */
+void small_vector_destroy(SmallVector* sv, Size object_size, void* udata) {
+    ERR_RETURN_IF_FAIL(sv && object_size, ERR_INVALID_ARGUMENTS);
+
+    Allocator* parent = sv->parent;
+    small_vector_deinit(sv, udata);
+    allocator_free(parent, sv, object_size);
+}
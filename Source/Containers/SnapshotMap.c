@@ -0,0 +1,421 @@
+/**
+ * @file SnapshotMap.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Read-copy-update hash map with epoch based reclamation.
+ * */
+
+#include <Anvie/Containers/SnapshotMap.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+#define READER_ALIGNMENT 64
+#define ALIGN_UP(value, align) (((value) + (align) - 1) & ~((Size)(align) - 1))
+
+/**
+ * Reader record of one thread. Aligned to and padded to a cache line so
+ * that announcing an epoch never invalidates a line another reader uses.
+ * */
+struct SnapshotMapReader {
+    Uint64             epoch;  /**< Epoch announced while reading, 0 when not reading. */
+    Size               depth;  /**< Nesting depth of read sections, used only by owner thread. */
+    Bool               in_use; /**< False once owner thread exits, so record can be reused. */
+    SnapshotMapReader* next;   /**< Next record in list of all records. */
+    void*              memory; /**< Unaligned allocation holding this record. */
+} __attribute__((aligned(READER_ALIGNMENT)));
+
+/* allocator may not align to cache lines, so records are over allocated and aligned by hand */
+#define READER_MEMORY_SIZE (sizeof(SnapshotMapReader) + READER_ALIGNMENT)
+
+/**
+ * A version replaced by a write, to be freed when no reader can see it.
+ * */
+struct SnapshotMapVersion {
+    DenseMap*           map;          /**< Replaced version. */
+    Uint64              retire_epoch; /**< Epoch at the time version was replaced. */
+    SnapshotMapVersion* next;
+};
+
+/**
+ * Called when a thread with a reader record exits.
+ * @param arg Reader record.
+ * */
+static void release_reader(void* arg) {
+    SnapshotMapReader* reader = (SnapshotMapReader*)arg;
+    __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&reader->in_use, False, __ATOMIC_RELEASE);
+}
+
+/**
+ * Get reader record of calling thread, reusing records of exited threads.
+ * @param map
+ * @return Reader record, NULL on failure.
+ * */
+static SnapshotMapReader* get_reader(SnapshotMap* map) {
+    SnapshotMapReader* reader = pthread_getspecific(map->reader_key);
+    if(reader) {
+        return reader;
+    }
+
+    for(reader = __atomic_load_n(&map->readers, __ATOMIC_ACQUIRE); reader; reader = reader->next) {
+        Bool expected = False;
+        if(__atomic_compare_exchange_n(&reader->in_use, &expected, True, False, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if(!reader) {
+        void* memory = allocator_allocate_zeroed(map->allocator, READER_MEMORY_SIZE);
+        ERR_RETURN_VALUE_IF_FAIL(memory, NULL, ERR_OUT_OF_MEMORY);
+        reader         = (SnapshotMapReader*)ALIGN_UP((Size)memory, READER_ALIGNMENT);
+        reader->memory = memory;
+        reader->in_use = True;
+
+        // records are only ever pushed, so a plain compare and swap push has no ABA problem
+        reader->next = __atomic_load_n(&map->readers, __ATOMIC_RELAXED);
+        while(!__atomic_compare_exchange_n(&map->readers, &reader->next, reader, True, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {}
+    }
+
+    reader->depth = 0;
+    if(pthread_setspecific(map->reader_key, reader)) {
+        release_reader(reader);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
+        return NULL;
+    }
+
+    return reader;
+}
+
+/**
+ * Free retired versions that no reader can still be using. A version retired
+ * at epoch @c e can be in use only by a reader that announced an epoch <= @c e,
+ * because such reader must have loaded current version before it was replaced.
+ * Must be called with @c write_lock held.
+ * @param map
+ * @return Number of retired versions still waiting.
+ * */
+static Size reclaim_versions(SnapshotMap* map) {
+    Uint64 min_epoch = UINT64_MAX;
+    for(SnapshotMapReader* reader = __atomic_load_n(&map->readers, __ATOMIC_ACQUIRE); reader; reader = reader->next) {
+        Uint64 epoch = __atomic_load_n(&reader->epoch, __ATOMIC_SEQ_CST);
+        if(epoch && epoch < min_epoch) {
+            min_epoch = epoch;
+        }
+    }
+
+    Size                 waiting = 0;
+    SnapshotMapVersion** link    = &map->retired;
+    while(*link) {
+        SnapshotMapVersion* version = *link;
+        if(version->retire_epoch < min_epoch) {
+            *link = version->next;
+            dense_map_destroy(version->map, NULL);
+            allocator_free(map->allocator, version, sizeof(SnapshotMapVersion));
+        } else {
+            link = &version->next;
+            waiting++;
+        }
+    }
+
+    return waiting;
+}
+
+/**
+ * Create a new snapshot map.
+ * @param hash Hash function for keys.
+ * @param key_size Size of key in bytes.
+ * @param compare_key Key comparision function.
+ * @param data_size Size of data in bytes.
+ * @param allocator Thread safe allocator to use. NULL means system allocator.
+ * @return SnapshotMap object on success, NULL otherwise.
+ * */
+SnapshotMap* snapshot_map_create(HashCallback hash, Size key_size, CompareElementCallback compare_key, Size data_size, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(hash && compare_key && key_size && data_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    SnapshotMap* map = allocator_allocate_zeroed(allocator, sizeof(SnapshotMap));
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_OUT_OF_MEMORY);
+
+    map->current = dense_map_create_inline(hash, key_size, NULL, NULL, compare_key, data_size, NULL, NULL, 0, 0,
+                                           False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, allocator);
+    if(!map->current) {
+        allocator_free(allocator, map, sizeof(SnapshotMap));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&map->write_lock, NULL)) {
+        goto HELL;
+    }
+
+    if(pthread_key_create(&map->reader_key, release_reader)) {
+        pthread_mutex_destroy(&map->write_lock);
+        goto HELL;
+    }
+
+    map->epoch     = 1;
+    map->data_size = data_size;
+    map->allocator = allocator;
+
+    return map;
+
+HELL:
+    dense_map_destroy(map->current, NULL);
+    allocator_free(allocator, map, sizeof(SnapshotMap));
+    ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
+    return NULL;
+}
+
+/**
+ * Destroy snapshot map. No other thread may be using map.
+ * @param map
+ * */
+void snapshot_map_destroy(SnapshotMap* map) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    pthread_key_delete(map->reader_key);
+
+    SnapshotMapReader* reader = map->readers;
+    while(reader) {
+        SnapshotMapReader* next = reader->next;
+        allocator_free(map->allocator, reader->memory, READER_MEMORY_SIZE);
+        reader = next;
+    }
+
+    SnapshotMapVersion* version = map->retired;
+    while(version) {
+        SnapshotMapVersion* next = version->next;
+        dense_map_destroy(version->map, NULL);
+        allocator_free(map->allocator, version, sizeof(SnapshotMapVersion));
+        version = next;
+    }
+
+    dense_map_destroy(map->current, NULL);
+    pthread_mutex_destroy(&map->write_lock);
+    allocator_free(map->allocator, map, sizeof(SnapshotMap));
+}
+
+/**
+ * Start a read section and get current version of map. Returned map and
+ * items in it stay valid until matching @c snapshot_map_read_end, and must
+ * only be searched, never modified. Read sections can be nested.
+ * @param map
+ * @return Current version, NULL on failure.
+ * */
+DenseMap* snapshot_map_read_begin(SnapshotMap* map) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
+
+    SnapshotMapReader* reader = get_reader(map);
+    ERR_RETURN_VALUE_IF_FAIL(reader, NULL, ERR_OPERATION_FAILED);
+
+    if(reader->depth++ == 0) {
+        // announcement must be visible before current version is loaded
+        __atomic_store_n(&reader->epoch, __atomic_load_n(&map->epoch, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    }
+
+    return __atomic_load_n(&map->current, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * End a read section started by @c snapshot_map_read_begin. Nothing obtained
+ * in read section can be used after this.
+ * @param map
+ * */
+void snapshot_map_read_end(SnapshotMap* map) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    SnapshotMapReader* reader = pthread_getspecific(map->reader_key);
+    ERR_RETURN_IF_FAIL(reader && reader->depth, ERR_INVALID_OBJECT);
+
+    if(--reader->depth == 0) {
+        __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * Search for given key without taking any lock, and copy it's data out.
+ * @param map
+ * @param key
+ * @param data Buffer of @c data_size bytes where data of key will be copied.
+ * Can be NULL to only check whether key is present.
+ * @param udata User data passed to callbacks.
+ * @return True if key was found, False otherwise.
+ * */
+Bool snapshot_map_search(SnapshotMap* map, void* key, void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    DenseMap* current = snapshot_map_read_begin(map);
+    ERR_RETURN_VALUE_IF_FAIL(current, False, ERR_OPERATION_FAILED);
+
+    DenseMapItem* item = dense_map_search(current, key, udata);
+    if(item && data) {
+        memcpy(data, dense_map_slot_data(current, item), map->data_size);
+    }
+
+    snapshot_map_read_end(map);
+    return item != NULL;
+}
+
+/**
+ * Start a write. This blocks other writers (never readers) until matching
+ * @c snapshot_map_write_commit or @c snapshot_map_write_abort, and returns
+ * a private copy of current version to be modified with @c DenseMap api.
+ * @param map
+ * @param udata User data passed to `hash` when copying.
+ * @return Copy of current version, NULL on failure.
+ * */
+DenseMap* snapshot_map_write_begin(SnapshotMap* map, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock(&map->write_lock);
+
+    // only writers replace current version, so it can't change under write lock
+    DenseMap* next = dense_map_clone(map->current, udata);
+    if(!next) {
+        pthread_mutex_unlock(&map->write_lock);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    return next;
+}
+
+/**
+ * Publish version returned by @c snapshot_map_write_begin, and end write.
+ * Readers starting after this see @p next. @p next must not be used after this.
+ * @param map
+ * @param next
+ * */
+void snapshot_map_write_commit(SnapshotMap* map, DenseMap* next) {
+    ERR_RETURN_IF_FAIL(map && next, ERR_INVALID_ARGUMENTS);
+
+    SnapshotMapVersion* version = allocator_allocate(map->allocator, sizeof(SnapshotMapVersion));
+    if(!version) {
+        // can't retire old version safely, so drop this write instead
+        snapshot_map_write_abort(map, next);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return;
+    }
+
+    version->map          = __atomic_exchange_n(&map->current, next, __ATOMIC_SEQ_CST);
+    version->retire_epoch = __atomic_fetch_add(&map->epoch, 1, __ATOMIC_SEQ_CST);
+    version->next         = map->retired;
+    map->retired          = version;
+
+    reclaim_versions(map);
+    pthread_mutex_unlock(&map->write_lock);
+}
+
+/**
+ * Discard version returned by @c snapshot_map_write_begin, and end write.
+ * @param map
+ * @param next
+ * */
+void snapshot_map_write_abort(SnapshotMap* map, DenseMap* next) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(next) {
+        dense_map_destroy(next, NULL);
+    }
+    pthread_mutex_unlock(&map->write_lock);
+}
+
+/**
+ * Insert given key with given data in a write of it's own, replacing data
+ * of key if already present.
+ * @param map
+ * @param key
+ * @param data Pointer to @c data_size bytes of data to be copied into map.
+ * @param udata User data passed to callbacks.
+ * @return True on success, False otherwise.
+ * */
+Bool snapshot_map_insert(SnapshotMap* map, void* key, const void* data, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && data, False, ERR_INVALID_ARGUMENTS);
+
+    DenseMap* next = snapshot_map_write_begin(map, udata);
+    ERR_RETURN_VALUE_IF_FAIL(next, False, ERR_OPERATION_FAILED);
+
+    if(!dense_map_insert(next, key, dense_map_pack(data, map->data_size), udata)) {
+        snapshot_map_write_abort(map, next);
+        return False;
+    }
+
+    snapshot_map_write_commit(map, next);
+    return True;
+}
+
+/**
+ * Delete given key in a write of it's own.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return True if key was present, False otherwise.
+ * */
+Bool snapshot_map_delete(SnapshotMap* map, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    // skip copying whole map when there's nothing to delete
+    if(!snapshot_map_search(map, key, NULL, udata)) {
+        return False;
+    }
+
+    DenseMap* next = snapshot_map_write_begin(map, udata);
+    ERR_RETURN_VALUE_IF_FAIL(next, False, ERR_OPERATION_FAILED);
+
+    Size count = next->item_count;
+    dense_map_delete(next, key, udata);
+    if(next->item_count == count) {
+        snapshot_map_write_abort(map, next);
+        return False;
+    }
+
+    snapshot_map_write_commit(map, next);
+    return True;
+}
+
+/**
+ * Get number of items in current version of map.
+ * @param map
+ * @return Number of items.
+ * */
+Size snapshot_map_item_count(SnapshotMap* map) {
+    ERR_RETURN_VALUE_IF_FAIL(map, 0, ERR_INVALID_ARGUMENTS);
+
+    DenseMap* current = snapshot_map_read_begin(map);
+    ERR_RETURN_VALUE_IF_FAIL(current, 0, ERR_OPERATION_FAILED);
+
+    Size count = current->item_count;
+    snapshot_map_read_end(map);
+    return count;
+}
+
+/**
+ * Free replaced versions that no reader uses anymore. Writes do this on
+ * their own, call this to release memory early after long read sections.
+ * @param map
+ * @return Number of replaced versions still in use by some reader.
+ * */
+Size snapshot_map_reclaim(SnapshotMap* map) {
+    ERR_RETURN_VALUE_IF_FAIL(map, 0, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock(&map->write_lock);
+    Size waiting = reclaim_versions(map);
+    pthread_mutex_unlock(&map->write_lock);
+
+    return waiting;
+}
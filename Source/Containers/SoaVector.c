@@ -0,0 +1,296 @@
+/**
+ * @file SoaVector.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Implementation of struct of arrays vector.
+ * */
+
+#include <Anvie/Containers/SoaVector.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/**
+ * Number of rows allocated on first insertion.
+ * */
+#define SOA_VECTOR_INIT_ROW_COUNT 8
+
+/* size of header allocation, including column pointers and column sizes */
+#define HEADER_SIZE(column_count) (sizeof(SoaVector) + (column_count) * (sizeof(void*) + sizeof(Size)))
+
+/**
+ * Get element at given address in the form it is passed to callbacks.
+ * Same as in @c Vector.
+ * */
+static FORCE_INLINE void* element_value(const void* p, Size element_size) {
+    switch(element_size) {
+        case 8: { Uint64 v; memcpy(&v, p, 8); return (void*)v; }
+        case 4: { Uint32 v; memcpy(&v, p, 4); return (void*)(Uint64)v; }
+        case 2: { Uint16 v; memcpy(&v, p, 2); return (void*)(Uint64)v; }
+        case 1: return (void*)(Uint64)*(const Uint8*)p;
+        default: return (void*)p;
+    }
+}
+
+/**
+ * Create a new struct of arrays vector.
+ * No column memory is allocated until first row is added.
+ *
+ * @param column_count Number of columns. Must be non-zero.
+ * @param column_sizes Size of an element of each column. All must be non-zero.
+ * @return SoaVector* or NULL if allocation failed
+ * */
+SoaVector* soa_vector_create(Size column_count, const Size* column_sizes) {
+    return soa_vector_create_with_allocator(column_count, column_sizes, NULL);
+}
+
+/**
+ * Create a new struct of arrays vector that allocates all of it's memory
+ * from given allocator.
+ *
+ * @param column_count Number of columns. Must be non-zero.
+ * @param column_sizes Size of an element of each column. All must be non-zero.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return SoaVector* or NULL if allocation failed
+ * */
+SoaVector* soa_vector_create_with_allocator(Size column_count, const Size* column_sizes, Allocator* allocator) {
+    ERR_RETURN_VALUE_IF_FAIL(column_count && column_sizes, NULL, ERR_INVALID_ARGUMENTS);
+    for(Size c = 0; c < column_count; c++) {
+        ERR_RETURN_VALUE_IF_FAIL(column_sizes[c], NULL, ERR_INVALID_ARGUMENTS);
+    }
+
+    SoaVector* soa = allocator_allocate_zeroed(allocator, HEADER_SIZE(column_count));
+    ERR_RETURN_VALUE_IF_FAIL(soa, NULL, ERR_OUT_OF_MEMORY);
+
+    soa->column_count = column_count;
+    soa->column_sizes = (Size*)(soa->columns + column_count);
+    soa->allocator    = allocator;
+    memcpy(soa->column_sizes, column_sizes, column_count * sizeof(Size));
+
+    return soa;
+}
+
+/**
+ * Destroy given struct of arrays vector.
+ * If vector's allocator releases memory in bulk, then nothing is freed here.
+ *
+ * @param soa
+ * */
+void soa_vector_destroy(SoaVector* soa) {
+    ERR_RETURN_IF_FAIL(soa, ERR_INVALID_ARGUMENTS);
+
+    if(!allocator_needs_free(soa->allocator)) {
+        return;
+    }
+
+    for(Size c = 0; c < soa->column_count; c++) {
+        allocator_free(soa->allocator, soa->columns[c], soa->capacity * soa->column_sizes[c]);
+    }
+
+    allocator_free(soa->allocator, soa, HEADER_SIZE(soa->column_count));
+}
+
+/**
+ * Make sure each column can hold at least given number of rows.
+ * Columns are grown together. If growing any one of them fails then
+ * already grown columns are given back their old size, so all columns
+ * always have same capacity.
+ *
+ * @param soa
+ * @param capacity Number of rows to reserve space for.
+ * @return True on success, False otherwise.
+ * */
+Bool soa_vector_reserve(SoaVector* soa, Size capacity) {
+    ERR_RETURN_VALUE_IF_FAIL(soa, False, ERR_INVALID_ARGUMENTS);
+    if(capacity <= soa->capacity) return True;
+
+    for(Size c = 0; c < soa->column_count; c++) {
+        Size esz = soa->column_sizes[c];
+        ERR_RETURN_VALUE_IF_FAIL(capacity <= SIZE_MAX / esz, False, ERR_INVALID_CAPACITY);
+
+        void* column = allocator_reallocate(soa->allocator, soa->columns[c], soa->capacity * esz, capacity * esz);
+        if(!column) {
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+
+            /* undo columns grown so far */
+            while(c--) {
+                esz     = soa->column_sizes[c];
+                column  = allocator_reallocate(soa->allocator, soa->columns[c], capacity * esz, soa->capacity * esz);
+                if(column) soa->columns[c] = column;
+            }
+            return False;
+        }
+
+        soa->columns[c] = column;
+    }
+
+    soa->capacity = capacity;
+    return True;
+}
+
+/**
+ * Remove all rows. Capacity is not changed.
+ *
+ * @param soa
+ * */
+void soa_vector_clear(SoaVector* soa) {
+    ERR_RETURN_IF_FAIL(soa, ERR_INVALID_ARGUMENTS);
+    soa->length = 0;
+}
+
+/**
+ * Append given number of uninitialized rows, growing all columns if required.
+ *
+ * @param soa
+ * @param count Number of rows to append.
+ * @return Index of first appended row on success.
+ * @return SIZE_MAX otherwise.
+ * */
+Size soa_vector_extend(SoaVector* soa, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(soa, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(count <= SIZE_MAX / 2 - soa->length, SIZE_MAX, ERR_INVALID_CAPACITY);
+
+    Size pos = soa->length;
+    if(pos + count > soa->capacity) {
+        Size capacity = soa->capacity ? soa->capacity : SOA_VECTOR_INIT_ROW_COUNT;
+        while(capacity < pos + count) {
+            capacity *= 2;
+        }
+
+        if(!soa_vector_reserve(soa, capacity)) {
+            return SIZE_MAX;
+        }
+    }
+
+    soa->length += count;
+    return pos;
+}
+
+/**
+ * Remove last row.
+ *
+ * @param soa
+ * */
+void soa_vector_pop_back(SoaVector* soa) {
+    ERR_RETURN_IF_FAIL(soa && soa->length, ERR_INVALID_ARGUMENTS);
+    soa->length--;
+}
+
+/**
+ * Swap two rows, in all columns.
+ *
+ * @param soa
+ * @param p1
+ * @param p2
+ * */
+void soa_vector_swap(SoaVector* soa, Size p1, Size p2) {
+    ERR_RETURN_IF_FAIL(soa && p1 < soa->length && p2 < soa->length, ERR_INVALID_ARGUMENTS);
+    if(p1 == p2) return;
+
+    for(Size c = 0; c < soa->column_count; c++) {
+        UByteArray a = soa_vector_address_at(soa, c, p1);
+        UByteArray b = soa_vector_address_at(soa, c, p2);
+        for(Size k = 0; k < soa->column_sizes[c]; k++) {
+            Uint8 t = a[k];
+            a[k] = b[k];
+            b[k] = t;
+        }
+    }
+}
+
+/**
+ * Stable merge sort of row indices, comparing elements of one column.
+ * Runs are merged back and forth between @p perm and @p tmp.
+ * @return Whichever one of both arrays holds sorted indices in the end.
+ * */
+static Size* sort_rows(SoaVector* soa, Size col, Size* perm, Size* tmp, CompareElementCallback compare, void* udata) {
+    Size       n      = soa->length;
+    Size       esz    = soa->column_sizes[col];
+    UByteArray column = soa->columns[col];
+
+    for(Size width = 1; width < n; width *= 2) {
+        for(Size lo = 0; lo < n; lo += 2 * width) {
+            Size mid = MIN(lo + width, n);
+            Size hi  = MIN(lo + 2 * width, n);
+            Size i = lo, j = mid, k = lo;
+
+            while(i < mid && j < hi) {
+                /* take from right run only if it strictly comes first, to keep sort stable */
+                void* l = element_value(column + perm[i] * esz, esz);
+                void* r = element_value(column + perm[j] * esz, esz);
+                tmp[k++] = compare(r, l, udata) > 0 ? perm[j++] : perm[i++];
+            }
+            while(i < mid) tmp[k++] = perm[i++];
+            while(j < hi) tmp[k++] = perm[j++];
+        }
+
+        Size* t = perm;
+        perm = tmp;
+        tmp = t;
+    }
+
+    return perm;
+}
+
+/**
+ * Sort rows by elements of given column. Sort is stable, so sorting by
+ * several columns one after other, from least significant to most
+ * significant, sorts by all of them. All columns are permuted together.
+ *
+ * @param soa
+ * @param col Index of column to sort by.
+ * @param compare Comparator. Returns positive value if first element must come first.
+ * @param udata User data passed to @p compare.
+ * */
+void soa_vector_sort_by_column(SoaVector* soa, Size col, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(soa && col < soa->column_count && compare, ERR_INVALID_ARGUMENTS);
+
+    Size n = soa->length;
+    if(n < 2) return;
+
+    Size max_esz = 0;
+    for(Size c = 0; c < soa->column_count; c++) {
+        max_esz = MAX(max_esz, soa->column_sizes[c]);
+    }
+
+    /* one allocation for both index arrays and a gather buffer for one column */
+    Size  scratch_size = 2 * n * sizeof(Size) + n * max_esz;
+    Size* scratch      = allocator_allocate(soa->allocator, scratch_size);
+    ERR_RETURN_IF_FAIL(scratch, ERR_OUT_OF_MEMORY);
+
+    Size* perm = scratch;
+    Size* tmp  = scratch + n;
+    for(Size i = 0; i < n; i++) {
+        perm[i] = i;
+    }
+
+    perm = sort_rows(soa, col, perm, tmp, compare, udata);
+
+    /* apply permutation to each column by gathering into buffer */
+    UByteArray buffer = (UByteArray)(scratch + 2 * n);
+    for(Size c = 0; c < soa->column_count; c++) {
+        Size       esz    = soa->column_sizes[c];
+        UByteArray column = soa->columns[c];
+        for(Size i = 0; i < n; i++) {
+            memcpy(buffer + i * esz, column + perm[i] * esz, esz);
+        }
+        memcpy(column, buffer, n * esz);
+    }
+
+    allocator_free(soa->allocator, scratch, scratch_size);
+}
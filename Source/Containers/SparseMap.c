@@ -26,12 +26,17 @@
 #include <Anvie/HelperDefines.h>
 #include <Anvie/Chrono/Time.h>
 #include <Anvie/Error.h>
+#include <Anvie/Counters.h>
 #include <Anvie/Bit/Bit.h>
 #include <string.h>
 
 #define SPARSE_MAP_INITIAL_SIZE 64
 
-LinBlockAllocator* lba;
+/* number of keys hashed and prefetched together by batch operations */
+#define SPARSE_MAP_BATCH_SIZE 32
+
+/* whether destroying an item requires calling destructor or freeing memory */
+#define NEEDS_DESTROY(map, n) ((map)->destroy_##n##_copy || (map)->n##_size > 8)
 
 /**
  * Callback data to be passed to copy constructor and copy destructor of
@@ -42,7 +47,20 @@ typedef struct Smi_CallbackData {
     SparseMap* map;             /**< @c SparseMap to which @c SparseMapItem will be inserted*/
 } Smi_CallbackData;
 
-static FORCE_INLINE SparseMapItem* insert_into_sparse_map_directly(SparseMap* map, SparseMapItem* item, void* udata);
+static FORCE_INLINE SparseMapItem* insert_into_sparse_map_directly(SparseMap* map, SparseMapItem* item, Size hash);
+static SparseMapItem* search_hashed(SparseMap* map, void* key, Size hash, void* udata);
+static SparseMapItem* insert_hashed(SparseMap* map, void* key, void* value, Size hash, void* udata);
+static SparseMapItem* lookup(SparseMap* map, void* key, Size hash, void* udata);
+static void delete_in_table(SparseMap* map, void* key, Size hash, void* udata);
+static void destroy_bucket_copies(SparseMap* map, Bool destroy_copies, void* udata);
+static void begin_rehash(SparseMap* map, Size size, void* udata);
+static Size size_for_count(SparseMap* map, Size count, Float64 fraction);
+static void migrate_buckets(SparseMap* map, Size budget, void* udata);
+static void swap_tables(SparseMap* map);
+static void destroy_old_table(SparseMap* map);
+static void visit_buckets(SparseMap* map, SparseMapVisitorCallback visitor, Bool destroy, void* udata);
+static Size table_stats(Smi_Vector* buckets, BitVector* occupancy, HashMapStats* stats, Size* chained);
+static void destroy_smi_vector_shallow(Smi_Vector* vec);
 
 /**
  * Create a new hash map.
@@ -65,10 +83,40 @@ SparseMap* sparse_map_create(
     Bool                       is_multimap,
     Float32                    max_load_factor
 ) {
-    lba = lballoc_create(sizeof(SparseMapItem));
-    ERR_RETURN_VALUE_IF_FAIL(lba, NULL, ERR_INVALID_OBJECT);
+    return sparse_map_create_with_allocator(hash, key_size, create_key_copy, destroy_key_copy, compare_key,
+                                            data_size, create_data_copy, destroy_data_copy,
+                                            is_multimap, max_load_factor, NULL, NULL);
+}
 
+/**
+ * Create a new hash map that allocates it's buckets, occupancy
+ * bitvector and key/data copies from given allocator, and chained
+ * items from given node pool.
+ * Rest of the parameters are same as @c sparse_map_create.
+ *
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @param node_pool Pool to allocate chained items from. Can be shared
+ * between multiple maps, as long as it outlives all of them, and blocks
+ * must be at least @c sizeof(SparseMapItem) in size. If NULL then map
+ * creates and owns a pool of it's own.
+ * @return SparseMap object on success, NULL otherwise.
+ * */
+SparseMap* sparse_map_create_with_allocator(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       data_size,
+    CreateElementCopyCallback  create_data_copy,
+    DestroyElementCopyCallback destroy_data_copy,
+    Bool                       is_multimap,
+    Float32                    max_load_factor,
+    Allocator*                 allocator,
+    LinBlockAllocator*         node_pool
+) {
     ERR_RETURN_VALUE_IF_FAIL(hash && compare_key && data_size && key_size, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(!node_pool || node_pool->block_size >= sizeof(SparseMapItem), NULL, ERR_INVALID_ARGUMENTS);
 
     // both must be null or non null at the same time
     Bool b1 = create_data_copy != NULL;
@@ -80,25 +128,38 @@ SparseMap* sparse_map_create(
     b2 = destroy_key_copy != NULL;
     ERR_RETURN_VALUE_IF_FAIL(!(b1 ^ b2), NULL, ERR_INVALID_ARGUMENTS);
 
+    // create pool for chained items if one is not provided
+    Bool owns_node_pool = !node_pool;
+    if(owns_node_pool) {
+        node_pool = lballoc_create(sizeof(SparseMapItem));
+        ERR_RETURN_VALUE_IF_FAIL(node_pool, NULL, ERR_INVALID_OBJECT);
+    }
+
     // create bitvector to keep track of occupied buckets
-    BitVector* bv = bitvec_create();
-    ERR_RETURN_VALUE_IF_FAIL(bv, NULL, ERR_INVALID_OBJECT);
+    BitVector* bv = bitvec_create_with_allocator(allocator);
+    if(!bv) {
+        if(owns_node_pool) lballoc_destroy(node_pool);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        return NULL;
+    }
     bitvec_resize(bv, SPARSE_MAP_INITIAL_SIZE);
 
     // create vector to store SparseMapItem entries for the SparseMap.
-    Smi_Vector* smi_vec = smi_vector_create();
+    Smi_Vector* smi_vec = smi_vector_create_with_allocator(allocator);
     if(!smi_vec) {
         bitvec_destroy(bv);
+        if(owns_node_pool) lballoc_destroy(node_pool);
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
         return NULL;
     }
     smi_vector_resize(smi_vec, SPARSE_MAP_INITIAL_SIZE);
 
     // finally create dense map
-    SparseMap* map = NEW(SparseMap);
+    SparseMap* map = allocator_allocate_zeroed(allocator, sizeof(SparseMap));
     if(!map) {
         bitvec_destroy(bv);
-        smi_vector_destroy(smi_vec, NULL);
+        destroy_smi_vector_shallow(smi_vec);
+        if(owns_node_pool) lballoc_destroy(node_pool);
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
         return NULL;
     }
@@ -116,12 +177,20 @@ SparseMap* sparse_map_create(
     map->is_multimap       = is_multimap;
     map->max_item_count    = map->map->length * MAX(max_load_factor, 0.5);
     map->item_count        = 0;
+    map->allocator         = allocator;
+    map->node_pool         = node_pool;
+    map->owns_node_pool    = owns_node_pool;
 
     return map;
 }
 
 /**
  * Destroy hash map.
+ *
+ * Chains are walked only if key or data copies need to be destroyed, or if
+ * node pool is shared. Otherwise all chained items are released at once
+ * with the map's own node pool.
+ *
  * @param map SparseMap object to be destroyed.
  * @param udata User data passed to callback functions.
  * This will be passed to copy destructor for each data copy
@@ -130,25 +199,46 @@ SparseMap* sparse_map_create(
 void sparse_map_destroy(SparseMap* map, void* udata) {
     ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
 
-    if(map->occupancy) {
-        bitvec_destroy(map->occupancy);
-        map->occupancy = NULL;
+    // all memory will be released by allocator at once
+    if(!allocator_needs_free(map->allocator)) {
+        if(map->owns_node_pool) lballoc_destroy(map->node_pool);
+        return;
+    }
+
+    Bool destroy_copies = NEEDS_DESTROY(map, key) || NEEDS_DESTROY(map, data);
+    if(map->map && (destroy_copies || !map->owns_node_pool)) {
+        destroy_bucket_copies(map, destroy_copies, udata);
+
+        // items not yet migrated by an incremental rehash
+        if(map->old_map) {
+            swap_tables(map);
+            destroy_bucket_copies(map, destroy_copies, udata);
+            swap_tables(map);
+        }
+    }
+
+    if(map->old_map) {
+        destroy_old_table(map);
     }
 
     if(map->map) {
-        Smi_CallbackData clbk_data = {
-            .udata = udata,
-            .map   = map
-        };
-        smi_vector_destroy(map->map, &clbk_data);
+        destroy_smi_vector_shallow(map->map);
         map->map = NULL;
     }
 
-    FREE(map);
+    if(map->occupancy) {
+        bitvec_destroy(map->occupancy);
+        map->occupancy = NULL;
+    }
 
-    lballoc_destroy(lba);
-    lba = NULL;
+    if(map->owns_node_pool) {
+        lballoc_destroy(map->node_pool);
+    }
+    map->node_pool = NULL;
 
+    sparse_map_disable_filter(map);
+
+    allocator_free(map->allocator, map, sizeof(SparseMap));
 }
 
 /**
@@ -157,27 +247,34 @@ void sparse_map_destroy(SparseMap* map, void* udata) {
  * the size in power of 2. So, for example if size is 200, the actual
  * size of hash map will be 256. If new size is 1024, then it stays 1024.
  *
- * It's recommended to keepp
+ * Chained items are moved between buckets without being reallocated.
+ * A size smaller than current one shrinks hash map, see
+ * @c sparse_map_shrink_to_fit for sizing it to number of items.
+ *
  * @param map SparseMap to be resized.
  * @param size New size. The actual size of hash map will be next power of 2 from given size.
  * @param udata User data passed to callback functions.
  * Since the whole @c SparseMap will be rehashed, we need this user data as well.
  * */
 void sparse_map_resize(SparseMap* map, Size size, void* udata) {
-    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_IF_FAIL(map && size, ERR_INVALID_ARGUMENTS);
 
-    Float64 load_factor = (Float64)map->item_count/(Float64)map->max_item_count;
+    if(map->old_map) {
+        migrate_buckets(map, SIZE_MAX, udata);
+    }
+
+    Float64 load_factor = (Float64)map->max_item_count/(Float64)map->map->length;
 
     // when we reach a size greater than or equal to given size and  that's also a power of 2, then we break.
     Size sz = NEXT_POW2(size);
 
     /* Create a ne bitvector to store data about occupancy of each slot. */
-    BitVector* new_occupancy = bitvec_create();
+    BitVector* new_occupancy = bitvec_create_with_allocator(map->allocator);
     ERR_RETURN_IF_FAIL(new_occupancy, ERR_INVALID_OBJECT);
-    bitvec_resize(new_occupancy, size);
+    bitvec_resize(new_occupancy, sz);
 
     // create vector to store SparseMapItem entries for the SparseMap.
-    Smi_Vector* smi_vec = smi_vector_create();
+    Smi_Vector* smi_vec = smi_vector_create_with_allocator(map->allocator);
     if(!smi_vec) {
         bitvec_destroy(new_occupancy);
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
@@ -195,34 +292,83 @@ void sparse_map_resize(SparseMap* map, Size size, void* udata) {
     map->item_count = 0;
 
     // go through each item in old map and insert if the slot is occupied.
-    Size old_map_len = old_smi_vec->length;
-    for(Size s = 0; s < old_map_len; s++) {
-        if(bitvec_peek(old_occupancy, s)) {
-            /* go through each item in a bucket and keep inserting while we not reach the end of bucket */
-            SparseMapItem* iter = smi_vector_peek(old_smi_vec, s);
-            insert_into_sparse_map_directly(map, iter, udata);
-
-            /* items coming after the first one in a bucket are allocated separately. After inserting, free them. */
-            iter = iter->next;
-            while(iter) {
-                insert_into_sparse_map_directly(map, iter, udata);
-                SparseMapItem* next = iter->next;
-                memset(iter, 0, sizeof(SparseMapItem));
-                lballoc_free(lba, (MemBlock)iter);
-                iter = next;
-            }
+    for(Size s = bitvec_find_first_set(old_occupancy); s != SIZE_MAX;
+        s = bitvec_find_next_set(old_occupancy, s + 1)) {
+        /* go through each item in a bucket and keep inserting while we not reach the end of bucket */
+        SparseMapItem* iter = smi_vector_address_at(old_smi_vec, s);
+        SparseMapItem* next = iter->next;
+        insert_into_sparse_map_directly(map, iter, iter->hash);
+
+        /* items coming after the first one in a bucket are allocated separately. After inserting, free them. */
+        iter = next;
+        while(iter) {
+            next = iter->next;
+            insert_into_sparse_map_directly(map, iter, iter->hash);
+            lballoc_free(map->node_pool, (MemBlock)iter);
+            iter = next;
         }
     }
 
     // Cannot destroy map directly as this will destroy all previously created copies
     // All this trickery is to void calling copy constructor twice for same key-value pair.
-    FREE(old_smi_vec->data);
-    old_smi_vec->data = NULL;
-    FREE(old_smi_vec);
-
+    destroy_smi_vector_shallow(old_smi_vec);
     bitvec_destroy(old_occupancy);
 
     map->max_item_count = map->map->length * load_factor;
+    map->resize_count++;
+    COUNTER_INC(SPARSE_MAP_REHASH);
+}
+
+/**
+ * Make sure that map can hold given number of items without rehashing,
+ * at it's configured load factor. Pre-sizing a map before a bulk load
+ * replaces repeated doubling with a single rehash.
+ * @param map
+ * @param expected_count Number of items map is expected to hold.
+ * @param udata User data passed to `hash`.
+ * */
+void sparse_map_reserve(SparseMap* map, Size expected_count, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    Size size = size_for_count(map, expected_count, 1.0);
+    if(size > map->map->length) {
+        sparse_map_resize(map, size, udata);
+    }
+}
+
+/**
+ * Reduce number of buckets to the smallest that holds current items at
+ * configured load factor.
+ * @param map
+ * @param udata User data passed to `hash`.
+ * */
+void sparse_map_shrink_to_fit(SparseMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    Size size = size_for_count(map, map->item_count, 1.0);
+    if(size < map->map->length) {
+        sparse_map_resize(map, size, udata);
+    } else if(map->old_map) {
+        migrate_buckets(map, SIZE_MAX, udata);
+    }
+}
+
+/**
+ * Shrink map automatically when a deletion takes load below given watermark.
+ * The map is then shrunk to be half full at most, so it takes a number of
+ * insertions or deletions proportional to it's size before it is resized
+ * again either way.
+ * @param map
+ * @param min_load_factor Load below which map shrinks. Must be less than a
+ * quarter of load factor of map. 0 disables automatic shrinking.
+ * */
+void sparse_map_set_shrink_watermark(SparseMap* map, Float32 min_load_factor) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    Float64 load_factor = (Float64)map->max_item_count/(Float64)map->map->length;
+    ERR_RETURN_IF_FAIL(min_load_factor >= 0.f && min_load_factor < load_factor / 4, ERR_INVALID_ARGUMENTS);
+
+    map->min_load_factor = min_load_factor;
 }
 
 /**
@@ -238,61 +384,221 @@ void sparse_map_resize(SparseMap* map, Size size, void* udata) {
 SparseMapItem* sparse_map_insert(SparseMap* map, void* key, void* value, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    if(map->item_count > map->max_item_count) {
-        sparse_map_resize(map, map->map->length * 2, udata);
-    }
+    return insert_hashed(map, key, value, map->hash(key, udata), udata);
+}
 
-    Smi_CallbackData clbk_data = {
-        .udata = udata,
-        .map   = map
-    };
-    SparseMapItem tmp_smi = { .key = key, .data = value };
+/**
+ * Search for element in @c SparseMap.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks : `hash`, `compare_key`
+ * @return Pointer to first @c SparseMapItem* with equivalent or matching key, else @c NULL.
+ * */
+SparseMapItem* sparse_map_search(SparseMap* map, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    if(!map->is_multimap) {
-        SparseMapItem* searched_smi = sparse_map_search(map, key, udata);
-        if(searched_smi) {
-            destroy_smi_copy(searched_smi, &clbk_data);
-            create_smi_copy(searched_smi, &tmp_smi, &clbk_data);
-            return searched_smi;
-        }
-    }
+    return sparse_map_search_with_hash(map, key, map->hash(key, udata), udata);
+}
 
-    SparseMapItem this_smi;
-    create_smi_copy(&this_smi, &tmp_smi, &clbk_data);
+/**
+ * Insert given key-value pair, with hash of key already computed by caller,
+ * eg: because it was needed for something else too. Otherwise same as
+ * @c sparse_map_insert.
+ * @param map
+ * @param key
+ * @param value
+ * @param hash Hash of key. Must be exactly what `hash` callback of map returns for @p key.
+ * @param udata User data passed to callbacks.
+ * @return Pointer to new inserted @c SparseMapItem in @c SparseMap.
+ * */
+SparseMapItem* sparse_map_insert_with_hash(SparseMap* map, void* key, void* value, Size hash, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
-    SparseMapItem* i = insert_into_sparse_map_directly(map, &this_smi, udata);
-    return i;
+    return insert_hashed(map, key, value, hash, udata);
 }
 
 /**
- * Search for element in @c SparseMap.
+ * Search for given key, with hash of key already computed by caller.
+ * Otherwise same as @c sparse_map_search.
  * @param map
  * @param key
- * @param udata User data passed to callbacks : `hash`, `compare_key`
+ * @param hash Hash of key. Must be exactly what `hash` callback of map returns for @p key.
+ * @param udata User data passed to `compare_key`.
  * @return Pointer to first @c SparseMapItem* with equivalent or matching key, else @c NULL.
  * */
-SparseMapItem* sparse_map_search(SparseMap* map, void* key, void* udata) {
+SparseMapItem* sparse_map_search_with_hash(SparseMap* map, void* key, Size hash, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_INVALID_ARGUMENTS);
 
+    if(map->old_map) {
+        migrate_buckets(map, map->rehash_budget, udata);
+    }
+
+    return lookup(map, key, hash, udata);
+}
+
+/**
+ * Hash a chunk of keys and prefetch occupancy bits and bucket of each key,
+ * so that cache misses of all keys in chunk overlap instead of being waited
+ * for one after another.
+ * @param map
+ * @param keys
+ * @param n Number of keys, at most @c SPARSE_MAP_BATCH_SIZE.
+ * @param hashes Where hashes returned by `hash` callback are stored.
+ * @param udata User data passed to `hash`.
+ * */
+static void prefetch_batch(SparseMap* map, void** keys, Size n, Size* hashes, void* udata) {
     Size len_wrap_mask = map->map->length - 1;
-    Size hash = map->hash(key, udata);
-    Size pos = hash & len_wrap_mask;
 
-    /* if the bucket is empty, then no value is there, return NULL */
-    if(!bitvec_peek(map->occupancy, pos)) {
-        return NULL;
+    for(Size k = 0; k < n; k++) {
+        hashes[k] = map->hash(keys[k], udata);
     }
 
-    /* if however bucket is not empty, search for matching key in bucket at position */
-    SparseMapItem* iter = smi_vector_peek(map->map, pos);
-    while(iter) {
-        if(map->compare_key(iter->key, key, udata) == 0) {
-            return iter;
+    for(Size k = 0; k < n; k++) {
+        Size pos = hashes[k] & len_wrap_mask;
+        __builtin_prefetch(map->occupancy->data + pos / 8);
+        __builtin_prefetch(smi_vector_address_at(map->map, pos));
+    }
+}
+
+/**
+ * Search for many keys at once. Keys are processed in chunks : all keys of a
+ * chunk are hashed and their buckets are prefetched before any of them is
+ * searched, which hides most of memory latency when map is much larger than
+ * cache. Results are same as calling @c sparse_map_search for each key.
+ *
+ * @param map
+ * @param keys Array of @p n keys, each in same form as taken by @c sparse_map_search.
+ * @param n Number of keys.
+ * @param out Array of @p n pointers, where item found for each key
+ * (or NULL when key is absent) is stored.
+ * @param udata User data passed to callbacks : `hash`, `compare_key`
+ * @return Number of keys found.
+ * */
+Size sparse_map_search_batch(SparseMap* map, void** keys, Size n, SparseMapItem** out, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && ((keys && out) || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    Size hashes[SPARSE_MAP_BATCH_SIZE];
+    Size found = 0;
+
+    for(Size base = 0; base < n; base += SPARSE_MAP_BATCH_SIZE) {
+        Size count = MIN(n - base, (Size)SPARSE_MAP_BATCH_SIZE);
+        if(map->old_map) {
+            migrate_buckets(map, map->rehash_budget, udata);
+        }
+        prefetch_batch(map, keys + base, count, hashes, udata);
+
+        for(Size k = 0; k < count; k++) {
+            out[base + k] = lookup(map, keys[base + k], hashes[k], udata);
+            found += out[base + k] != NULL;
         }
-        iter = iter->next;
     }
 
-    return NULL;
+    return found;
+}
+
+/**
+ * Insert many key-value pairs at once. Map is grown once up front to fit
+ * all items, and then keys are processed in chunks like in
+ * @c sparse_map_search_batch. Results are same as calling @c sparse_map_insert
+ * for each pair in order.
+ *
+ * @param map
+ * @param keys Array of @p n keys, each in same form as taken by @c sparse_map_insert.
+ * @param values Array of @p n values, each in same form as taken by @c sparse_map_insert.
+ * @param n Number of pairs.
+ * @param out Array of @p n pointers, where inserted item of each pair
+ * (or NULL on failure) is stored. Can be NULL.
+ * @param udata Pointer to user data provied to callbacks :
+ * `hash`, `compare_key`, `create_data_copy`, `create_key_copy`, `destroy_data_copy`, `destroy_key_copy`
+ * @return Number of pairs inserted successfully.
+ * */
+Size sparse_map_insert_batch(SparseMap* map, void** keys, void** values, Size n, SparseMapItem** out, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && ((keys && values) || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    // grow once now, instead of possibly many times in between, unless rehashes are incremental
+    if(!map->rehash_budget) {
+        sparse_map_reserve(map, map->item_count + n, udata);
+    }
+
+    Size hashes[SPARSE_MAP_BATCH_SIZE];
+    Size inserted = 0;
+
+    for(Size base = 0; base < n; base += SPARSE_MAP_BATCH_SIZE) {
+        Size count = MIN(n - base, (Size)SPARSE_MAP_BATCH_SIZE);
+        prefetch_batch(map, keys + base, count, hashes, udata);
+
+        for(Size k = 0; k < count; k++) {
+            SparseMapItem* item = insert_hashed(map, keys[base + k], values[base + k], hashes[k], udata);
+            if(out) {
+                out[base + k] = item;
+            }
+            inserted += item != NULL;
+        }
+    }
+
+    return inserted;
+}
+
+/**
+ * Load many key-value pairs at once, eg: when building a map from scratch.
+ * Buckets are sized once for all pairs, with any incremental rehash
+ * finished first, and keys are hashed a chunk at a time in a tight loop
+ * before any of them is placed.
+ *
+ * With @c SPARSE_MAP_BUILD_UNIQUE_KEYS, caller guarantees that keys are
+ * distinct from each other and from keys already in map. Bucket chains are
+ * then never searched for an equal key, and each pair is appended to it's
+ * bucket directly. Breaking that guarantee leaves duplicate items in map.
+ * Without the flag, pairs are inserted as by @c sparse_map_insert_batch.
+ *
+ * @param map
+ * @param keys Array of @p n keys, each in same form as taken by @c sparse_map_insert.
+ * @param values Array of @p n values, each in same form as taken by @c sparse_map_insert.
+ * @param n Number of pairs.
+ * @param flags Bitwise or of @c SPARSE_MAP_BUILD_* flags.
+ * @param udata Pointer to user data provied to callbacks.
+ * @return Number of pairs inserted successfully.
+ * */
+Size sparse_map_build_from_arrays(SparseMap* map, void** keys, void** values, Size n, Uint32 flags, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map && ((keys && values) || !n), 0, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_buckets(map, SIZE_MAX, udata);
+    }
+    sparse_map_reserve(map, map->item_count + n, udata);
+
+    if(!(flags & SPARSE_MAP_BUILD_UNIQUE_KEYS)) {
+        return sparse_map_insert_batch(map, keys, values, n, NULL, udata);
+    }
+
+    Smi_CallbackData clbk_data = {
+        .udata = udata,
+        .map   = map
+    };
+    Size hashes[SPARSE_MAP_BATCH_SIZE];
+    Size inserted = 0;
+
+    for(Size base = 0; base < n; base += SPARSE_MAP_BATCH_SIZE) {
+        Size count = MIN(n - base, (Size)SPARSE_MAP_BATCH_SIZE);
+        prefetch_batch(map, keys + base, count, hashes, udata);
+
+        for(Size k = 0; k < count; k++) {
+            SparseMapItem tmp_smi  = { .key = keys[base + k], .data = values[base + k] };
+            SparseMapItem this_smi = {0};
+            create_smi_copy(&this_smi, &tmp_smi, &clbk_data);
+
+            if(!insert_into_sparse_map_directly(map, &this_smi, hashes[k])) {
+                destroy_smi_copy(&this_smi, &clbk_data);
+                continue;
+            }
+            if(map->filter) {
+                bloom_insert_hash(map->filter, hashes[k]);
+            }
+            inserted++;
+        }
+    }
+
+    return inserted;
 }
 
 /**
@@ -309,38 +615,258 @@ SparseMapItem* sparse_map_search(SparseMap* map, void* key, void* udata) {
 void sparse_map_delete(SparseMap* map, void* key, void* udata) {
     ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
 
-    Size len_wrap_mask = map->map->length - 1;
-    Size hash = map->hash(key, udata);
-    Size pos = hash & len_wrap_mask;
+    if(map->old_map) {
+        migrate_buckets(map, map->rehash_budget, udata);
+    }
 
-    /* if the bucket is empty, then no value is there, return NULL */
-    if(!bitvec_peek(map->occupancy, pos)) {
-        return;
+    Size hash  = map->hash(key, udata);
+    Size count = map->item_count;
+    delete_in_table(map, key, hash, udata);
+
+    // key may still have items that are not migrated yet
+    if(map->old_map && (map->is_multimap || map->item_count == count)) {
+        swap_tables(map);
+        delete_in_table(map, key, hash, udata);
+        swap_tables(map);
     }
 
-    Smi_CallbackData clbk_data = {
-        .udata = udata,
-        .map   = map
-    };
+    Size length = map->map->length;
+    if(map->item_count != count && length > SPARSE_MAP_INITIAL_SIZE &&
+       (Float32)map->item_count < map->min_load_factor * (Float32)length) {
+        begin_rehash(map, size_for_count(map, map->item_count, 0.5), udata);
+    }
+}
 
-    // search for item with given key
-    SparseMapItem* prev = NULL;
-    SparseMapItem* iter = sparse_map_search(map, key, udata);
-    while(iter) {
-        /* destroy only if keys are exactly same */
-        SparseMapItem* next = iter->next;
-        if(map->compare_key(iter->key, key, udata) == 0) {
-            destroy_smi_copy(iter, &clbk_data);
-            if(prev) {
-                prev->next = next;
-                memset(iter, 0, sizeof(SparseMapItem));
-                lballoc_free(lba, (MemBlock)iter);
-            } else if (next) {
-                memcpy(iter, next, sizeof(SparseMapItem));
-            }
+/**
+ * Put a blocked Bloom filter of keys in front of @c sparse_map_search,
+ * so that searches for absent keys mostly return without walking buckets.
+ * Keys already in map are added to new filter, and every insertion
+ * afterwards adds it's key too. Deleted keys stay in filter, so enable
+ * filter again after many deletions to rebuild it.
+ *
+ * @param map
+ * @param expected_count Number of keys map is expected to hold.
+ * @param false_positive_rate Acceptable rate of absent keys that still search buckets.
+ * @param udata User data passed to `hash` callback.
+ * */
+void sparse_map_enable_filter(SparseMap* map, Size expected_count, Float64 false_positive_rate, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_buckets(map, SIZE_MAX, udata);
+    }
+
+    BloomFilter* filter = bloom_create_for(map->hash, MAX(expected_count, map->item_count),
+                                           false_positive_rate, True, map->allocator);
+    ERR_RETURN_IF_FAIL(filter, ERR_INVALID_OBJECT);
+
+    for(Size s = bitvec_find_first_set(map->occupancy); s != SIZE_MAX;
+        s = bitvec_find_next_set(map->occupancy, s + 1)) {
+        for(SparseMapItem* iter = smi_vector_address_at(map->map, s); iter; iter = iter->next) {
+            bloom_insert_hash(filter, iter->hash);
         }
-        iter = next;
     }
+
+    sparse_map_disable_filter(map);
+    map->filter = filter;
+}
+
+/**
+ * Remove filter added by @c sparse_map_enable_filter, if any.
+ * @param map
+ * */
+void sparse_map_disable_filter(SparseMap* map) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->filter) {
+        bloom_destroy(map->filter);
+        map->filter = NULL;
+    }
+}
+
+/**
+ * Get next item of an iteration over map. Empty buckets are skipped a whole
+ * word of occupancy bits at a time.
+ *
+ * Map must not be modified during iteration, except for changing data of
+ * returned items in place.
+ *
+ * @param map
+ * @param iter Zero initialized before first call, advanced by each call.
+ * @return Next item, NULL when all items have been visited.
+ * */
+SparseMapItem* sparse_map_iter_next(SparseMap* map, SparseMapIterator* iter) {
+    ERR_RETURN_VALUE_IF_FAIL(map && iter, NULL, ERR_INVALID_ARGUMENTS);
+
+    SparseMapItem* item   = iter->next;
+    Size           length = map->map->length;
+    if(!item && iter->bucket < length) {
+        Size bucket  = bitvec_find_next_set(map->occupancy, iter->bucket);
+        iter->bucket = bucket == SIZE_MAX ? length : bucket + 1;
+        item         = bucket == SIZE_MAX ? NULL : smi_vector_address_at(map->map, bucket);
+    }
+
+    // buckets after current table are buckets of table being migrated from
+    if(!item && map->old_map && iter->bucket - length < map->old_map->length) {
+        Size bucket  = bitvec_find_next_set(map->old_occupancy, iter->bucket - length);
+        iter->bucket = length + (bucket == SIZE_MAX ? map->old_map->length : bucket + 1);
+        item         = bucket == SIZE_MAX ? NULL : smi_vector_address_at(map->old_map, bucket);
+    }
+
+    if(!item) {
+        return NULL;
+    }
+
+    iter->next = item->next;
+    return item;
+}
+
+/**
+ * Call @p visitor for each item in map, bucket by bucket.
+ * @p visitor must not modify @p map, except for changing data of given
+ * item in place.
+ *
+ * @param map
+ * @param visitor Callback to be called for each item.
+ * @param udata User data to be passed to @p visitor.
+ * */
+void sparse_map_foreach(SparseMap* map, SparseMapVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(map && visitor, ERR_INVALID_ARGUMENTS);
+
+    visit_buckets(map, visitor, False, udata);
+    if(map->old_map) {
+        swap_tables(map);
+        visit_buckets(map, visitor, False, udata);
+        swap_tables(map);
+    }
+}
+
+/**
+ * Remove all items from map, keeping it's capacity.
+ * Bloom filter of map, if any, is cleared too.
+ * @param map
+ * @param udata User data passed to copy destructors.
+ * */
+void sparse_map_clear(SparseMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    sparse_map_drain(map, NULL, udata);
+}
+
+/**
+ * Call @p visitor for each item in map and remove it right after, so that
+ * taking every item out of a map costs a single pass over it's buckets.
+ * Map is left empty, with it's capacity unchanged. Item given to @p visitor
+ * is destroyed after @p visitor returns, so it must copy out anything it
+ * needs to keep.
+ *
+ * @param map
+ * @param visitor Callback to be called for each item. Can be NULL to only clear map.
+ * @param udata User data passed to @p visitor and copy destructors.
+ * */
+void sparse_map_drain(SparseMap* map, SparseMapVisitorCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    visit_buckets(map, visitor, True, udata);
+    if(map->old_map) {
+        swap_tables(map);
+        visit_buckets(map, visitor, True, udata);
+        swap_tables(map);
+        destroy_old_table(map);
+    }
+
+    memset(map->map->data, 0, map->map->length * map->map->element_size);
+    bitvec_clear_all(map->occupancy);
+    map->item_count = 0;
+
+    if(map->filter) {
+        bloom_clear(map->filter);
+    }
+}
+
+/**
+ * Make future rehashes of map incremental. Instead of moving all items at
+ * once when map grows, a new table is created and both tables coexist while
+ * each following insert, search and delete moves items of a bounded number
+ * of old buckets. Searches look into both tables until migration finishes.
+ *
+ * In this mode, @c sparse_map_search modifies map too, so it can't be called
+ * concurrently even with other searches, and an item pointer returned by any
+ * operation is valid only until next operation on map.
+ *
+ * @param map
+ * @param budget Number of old buckets to migrate per operation. Must be non-zero.
+ * */
+void sparse_map_enable_incremental_rehash(SparseMap* map, Size budget) {
+    ERR_RETURN_IF_FAIL(map && budget, ERR_INVALID_ARGUMENTS);
+
+    map->rehash_budget = budget;
+}
+
+/**
+ * Make future rehashes of map move all items at once again. A migration in
+ * progress is finished right away.
+ * @param map
+ * @param udata User data passed to `hash`.
+ * */
+void sparse_map_disable_incremental_rehash(SparseMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map) {
+        migrate_buckets(map, SIZE_MAX, udata);
+    }
+    map->rehash_budget = 0;
+}
+
+/**
+ * Drive an incremental rehash in progress, eg: when program is idle.
+ * Does nothing when no migration is in progress.
+ * @param map
+ * @param budget Number of old buckets to migrate. SIZE_MAX to finish migration.
+ * @param udata User data passed to `hash`.
+ * @return True if migration is still in progress, False otherwise.
+ * */
+Bool sparse_map_rehash_step(SparseMap* map, Size budget, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    if(map->old_map && budget) {
+        migrate_buckets(map, budget, udata);
+    }
+    return map->old_map != NULL;
+}
+
+/**
+ * Measure how well keys are spread over buckets of map. Costs a walk over
+ * all chains, but never calls `hash` or `compare_key`.
+ * @param map
+ * @param stats Filled with statistics of map, see @c HashMapStats.
+ * */
+void sparse_map_stats(SparseMap* map, HashMapStats* stats) {
+    ERR_RETURN_IF_FAIL(map && stats, ERR_INVALID_ARGUMENTS);
+
+    memset(stats, 0, sizeof(HashMapStats));
+    stats->item_count   = map->item_count;
+    stats->capacity     = map->map->length;
+    stats->resize_count = map->resize_count;
+
+    Size chained       = 0;
+    Size current_count = table_stats(map->map, map->occupancy, stats, &chained);
+    stats->load_factor = (Float64)current_count / (Float64)map->map->length;
+    if(map->old_map) {
+        stats->capacity += map->old_map->length;
+        table_stats(map->old_map, map->old_occupancy, stats, &chained);
+    }
+
+    // keys and data larger than 8 bytes are allocated separately for each item
+    Size copy_size = 0;
+    copy_size += map->key_size > 8 ? map->key_size : 0;
+    copy_size += map->data_size > 8 ? map->data_size : 0;
+
+    stats->bytes_used      = map->item_count * (sizeof(SparseMapItem) + copy_size);
+    stats->bytes_allocated = (stats->capacity + chained) * sizeof(SparseMapItem) + map->item_count * copy_size
+                             + (stats->capacity + 7) / 8;
+
+    hash_map_stats_finish(stats);
 }
 
 /************************************ PRIVATE FUNCTIONS ***************************************/
@@ -354,15 +880,19 @@ void sparse_map_delete(SparseMap* map, void* key, void* udata) {
 #define CREATE_COPY(d, s, n)                                            \
     do {                                                                \
         SparseMap* hmap = clbk_data->map;                               \
-        if(hmap->create_##n##_copy) {                                   \
-            (d)->n = ALLOCATE(Uint8, hmap->n##_size);                   \
+        if(hmap->create_##n##_copy && hmap->n##_size <= 8) {            \
+            /* small copies live in item itself, like in a Vector */    \
+            (d)->n = NULL;                                              \
+            hmap->create_##n##_copy(&(d)->n, (s)->n, clbk_data->udata); \
+        } else if(hmap->create_##n##_copy) {                            \
+            (d)->n = allocator_allocate_zeroed(hmap->allocator, hmap->n##_size); \
             ERR_RETURN_IF_FAIL((d)->n, ERR_OUT_OF_MEMORY);              \
             /* same callback data is passed to all callbacks. */        \
             hmap->create_##n##_copy((d)->n, (s)->n, clbk_data->udata);  \
         } else if(hmap->n##_size <= 8) {                                \
             (d)->n = (s)->n;                                            \
         } else  {                                                       \
-            (d)->n = ALLOCATE(Uint8, hmap->n##_size);                   \
+            (d)->n = allocator_allocate_zeroed(hmap->allocator, hmap->n##_size); \
             ERR_RETURN_IF_FAIL((d)->n, ERR_OUT_OF_MEMORY);              \
             if((s)->n) memcpy((d)->n, (s)->n, hmap->n##_size);          \
         }                                                               \
@@ -376,12 +906,14 @@ void sparse_map_delete(SparseMap* map, void* key, void* udata) {
 #define DESTROY_COPY(c, n)                                      \
     do {                                                        \
         SparseMap* hmap = clbk_data->map;                       \
-        if(hmap->destroy_##n##_copy) {                          \
+        if(hmap->destroy_##n##_copy && hmap->n##_size <= 8) {   \
+            hmap->destroy_##n##_copy(&c->n, clbk_data->udata);  \
+        } else if(hmap->destroy_##n##_copy) {                   \
             /* same callback data is passed to all callbacks. */\
             hmap->destroy_##n##_copy(c->n, clbk_data->udata);   \
-            FREE(c->n);                                         \
+            allocator_free(hmap->allocator, c->n, hmap->n##_size); \
         } else if(hmap->n##_size > 8) {                         \
-            FREE(c->n);                                         \
+            allocator_free(hmap->allocator, c->n, hmap->n##_size); \
         }                                                       \
         c->n = 0;                                               \
     } while(0)
@@ -411,30 +943,415 @@ void destroy_smi_copy(SparseMapItem* copy, Smi_CallbackData* clbk_data) {
     DESTROY_COPY(copy, key);
 }
 
+/**
+ * Search for element in @c SparseMap, using already computed hash of key.
+ * @param map
+ * @param key
+ * @param hash Hash of key returned by `hash` callback.
+ * @param udata User data passed to `compare_key`.
+ * @return Pointer to first @c SparseMapItem* with matching key, else @c NULL.
+ * */
+static SparseMapItem* search_hashed(SparseMap* map, void* key, Size hash, void* udata) {
+    Size len_wrap_mask = map->map->length - 1;
+    Size pos = hash & len_wrap_mask;
+
+    /* most misses are answered by filter without touching buckets */
+    if(map->filter && !bloom_contains_hash(map->filter, hash)) {
+        return NULL;
+    }
+
+    /* if the bucket is empty, then no value is there, return NULL */
+    if(!bitvec_peek_unchecked(map->occupancy, pos)) {
+        return NULL;
+    }
+
+    /* if however bucket is not empty, search for matching key in bucket at position */
+    SparseMapItem* iter = smi_vector_address_at(map->map, pos);
+    COUNTER_INC(SPARSE_MAP_FIND);
+    while(iter) {
+        COUNTER_INC(SPARSE_MAP_CHAIN_STEP);
+        if(iter->hash == hash) {
+            COUNTER_INC(SPARSE_MAP_KEY_COMPARE);
+            if(map->compare_key(iter->key, key, udata) == 0) {
+                return iter;
+            }
+        }
+        iter = iter->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Insert given key-value pair, using already computed hash of key.
+ * @param map
+ * @param key
+ * @param value
+ * @param hash Hash of key returned by `hash` callback.
+ * @param udata
+ * @return Pointer to new inserted @c SparseMapItem in @c SparseMap.
+ * */
+static SparseMapItem* insert_hashed(SparseMap* map, void* key, void* value, Size hash, void* udata) {
+    Smi_CallbackData clbk_data = {
+        .udata = udata,
+        .map   = map
+    };
+    SparseMapItem tmp_smi = { .key = key, .data = value };
+
+    if(map->old_map) {
+        migrate_buckets(map, map->rehash_budget, udata);
+    }
+
+    if(!map->is_multimap) {
+        SparseMapItem* searched_smi = lookup(map, key, hash, udata);
+        if(searched_smi) {
+            SparseMapItem* next = searched_smi->next;
+            destroy_smi_copy(searched_smi, &clbk_data);
+            create_smi_copy(searched_smi, &tmp_smi, &clbk_data);
+            searched_smi->next = next;
+            return searched_smi;
+        }
+    }
+
+    if(map->item_count >= map->max_item_count) {
+        begin_rehash(map, map->map->length * 2, udata);
+    }
+
+    SparseMapItem this_smi = {0};
+    create_smi_copy(&this_smi, &tmp_smi, &clbk_data);
+
+    SparseMapItem* i = insert_into_sparse_map_directly(map, &this_smi, hash);
+    if(i && map->filter) {
+        bloom_insert_hash(map->filter, hash);
+    }
+    return i;
+}
+
+/**
+ * Find first item with given key, in current table and then in table being
+ * migrated from, if any.
+ * @param map
+ * @param key
+ * @param hash Hash of key returned by `hash` callback.
+ * @param udata User data passed to `compare_key`.
+ * @return Item if found, NULL otherwise.
+ * */
+static SparseMapItem* lookup(SparseMap* map, void* key, Size hash, void* udata) {
+    SparseMapItem* item = search_hashed(map, key, hash, udata);
+    if(!item && map->old_map) {
+        swap_tables(map);
+        item = search_hashed(map, key, hash, udata);
+        swap_tables(map);
+    }
+    return item;
+}
+
+/**
+ * Delete items with given key from current table of map.
+ * @param map
+ * @param key
+ * @param hash Hash of key returned by `hash` callback.
+ * @param udata User data passed to `compare_key` and copy destructors.
+ * */
+static void delete_in_table(SparseMap* map, void* key, Size hash, void* udata) {
+    Size len_wrap_mask = map->map->length - 1;
+    Size pos = hash & len_wrap_mask;
+
+    /* if the bucket is empty, then no value is there, return NULL */
+    if(!bitvec_peek_unchecked(map->occupancy, pos)) {
+        return;
+    }
+
+    Smi_CallbackData clbk_data = {
+        .udata = udata,
+        .map   = map
+    };
+
+    /* first item of bucket lives in bucket array itself, rest are chained nodes */
+    SparseMapItem* head = smi_vector_address_at(map->map, pos);
+    SparseMapItem* prev = NULL;
+    SparseMapItem* iter = head;
+    while(iter) {
+        SparseMapItem* next = iter->next;
+
+        /* destroy only if keys are exactly same */
+        if(iter->hash != hash || map->compare_key(iter->key, key, udata) != 0) {
+            prev = iter;
+            iter = next;
+            continue;
+        }
+
+        destroy_smi_copy(iter, &clbk_data);
+        map->item_count--;
+
+        if(prev) {
+            /* unlink chained node */
+            prev->next = next;
+            lballoc_free(map->node_pool, (MemBlock)iter);
+            iter = next;
+        } else if(next) {
+            /* pull next node into bucket, and check head again */
+            memcpy(head, next, sizeof(SparseMapItem));
+            lballoc_free(map->node_pool, (MemBlock)next);
+        } else {
+            /* bucket is now empty */
+            memset(head, 0, sizeof(SparseMapItem));
+            bitvec_clear(map->occupancy, pos);
+            iter = NULL;
+        }
+    }
+}
+
+/**
+ * Destroy copies in all buckets of current table, and release chained items
+ * when map shares it's node pool.
+ * @param map
+ * @param destroy_copies Whether keys or data need to be destroyed.
+ * @param udata User data passed to copy destructors.
+ * */
+static void destroy_bucket_copies(SparseMap* map, Bool destroy_copies, void* udata) {
+    Smi_CallbackData clbk_data = {
+        .udata = udata,
+        .map   = map
+    };
+
+    for(Size s = bitvec_find_first_set(map->occupancy); s != SIZE_MAX;
+        s = bitvec_find_next_set(map->occupancy, s + 1)) {
+        SparseMapItem* head = smi_vector_address_at(map->map, s);
+        if(destroy_copies) destroy_smi_copy(head, &clbk_data);
+
+        SparseMapItem* iter = head->next;
+        while(iter) {
+            SparseMapItem* next = iter->next;
+            if(destroy_copies) destroy_smi_copy(iter, &clbk_data);
+            if(!map->owns_node_pool) lballoc_free(map->node_pool, (MemBlock)iter);
+            iter = next;
+        }
+    }
+}
+
+/**
+ * Add chain lengths, probe lengths and hash collisions of a table to given stats.
+ * Probe length of an item is it's position in chain, and it's collisions are
+ * items before it in chain with same stored hash, for which a search has to
+ * call `compare_key`.
+ * @param buckets Buckets of table.
+ * @param occupancy Occupancy of table.
+ * @param stats
+ * @param chained Number of items allocated outside buckets is added here.
+ * @return Number of items in table.
+ * */
+static Size table_stats(Smi_Vector* buckets, BitVector* occupancy, HashMapStats* stats, Size* chained) {
+    Size count = 0;
+
+    for(Size b = bitvec_find_first_set(occupancy); b != SIZE_MAX; b = bitvec_find_next_set(occupancy, b + 1)) {
+        SparseMapItem* head   = smi_vector_address_at(buckets, b);
+        Size           length = 0;
+        for(SparseMapItem* iter = head; iter; iter = iter->next) {
+            hash_map_stats_add_probe(stats, ++length);
+            for(SparseMapItem* prev = head; prev != iter; prev = prev->next) {
+                stats->tag_collision_rate += prev->hash == iter->hash;
+            }
+        }
+
+        hash_map_stats_add_chain(stats, length);
+        *chained += length - 1;
+        count    += length;
+    }
+
+    return count;
+}
+
+/**
+ * Call visitor for each item in current table, bucket by bucket.
+ * @param map
+ * @param visitor Callback called for each item, can be NULL.
+ * @param destroy Whether to destroy each item after visiting it. Buckets
+ * themselves are not cleared.
+ * @param udata User data passed to @p visitor and copy destructors.
+ * */
+static void visit_buckets(SparseMap* map, SparseMapVisitorCallback visitor, Bool destroy, void* udata) {
+    Smi_CallbackData clbk_data = {
+        .udata = udata,
+        .map   = map
+    };
+
+    for(Size s = bitvec_find_first_set(map->occupancy); s != SIZE_MAX;
+        s = bitvec_find_next_set(map->occupancy, s + 1)) {
+        SparseMapItem* head = smi_vector_address_at(map->map, s);
+        SparseMapItem* iter = head;
+        while(iter) {
+            SparseMapItem* next = iter->next;
+            if(visitor) {
+                visitor(iter, udata);
+            }
+            if(destroy) {
+                destroy_smi_copy(iter, &clbk_data);
+
+                /* first item of bucket lives in bucket array itself, rest are chained nodes */
+                if(iter != head) {
+                    lballoc_free(map->node_pool, (MemBlock)iter);
+                }
+            }
+            iter = next;
+        }
+    }
+}
+
+/**
+ * Get smallest number of buckets that holds given number of items, with
+ * load at most given fraction of load factor of map.
+ * @param map
+ * @param count Number of items.
+ * @param fraction Fraction of load factor.
+ * @return A power of two, at least @c SPARSE_MAP_INITIAL_SIZE.
+ * */
+static Size size_for_count(SparseMap* map, Size count, Float64 fraction) {
+    Float64 load = (Float64)map->max_item_count/(Float64)map->map->length * fraction;
+
+    Size size = SPARSE_MAP_INITIAL_SIZE;
+    while((Float64)count > load * (Float64)size) {
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * Start moving items into a new table of given size. Without incremental
+ * rehashing, all items are moved right away. Otherwise, the current table
+ * is kept as old table and items are moved a few buckets at a time by
+ * @c migrate_buckets.
+ * @param map
+ * @param size New number of buckets, a power of two.
+ * @param udata User data passed to `hash`.
+ * */
+static void begin_rehash(SparseMap* map, Size size, void* udata) {
+    if(!map->rehash_budget) {
+        sparse_map_resize(map, size, udata);
+        return;
+    }
+
+    // a table is migrated only from one other table at a time
+    if(map->old_map) {
+        migrate_buckets(map, SIZE_MAX, udata);
+    }
+
+    Float64 load_factor = (Float64)map->max_item_count/(Float64)map->map->length;
+
+    BitVector* new_occupancy = bitvec_create_with_allocator(map->allocator);
+    ERR_RETURN_IF_FAIL(new_occupancy, ERR_INVALID_OBJECT);
+    bitvec_resize(new_occupancy, size);
+
+    Smi_Vector* smi_vec = smi_vector_create_with_allocator(map->allocator);
+    if(!smi_vec) {
+        bitvec_destroy(new_occupancy);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        return;
+    }
+    smi_vector_resize(smi_vec, size);
+
+    map->old_map        = map->map;
+    map->old_occupancy  = map->occupancy;
+    map->migrate_pos    = 0;
+    map->map            = smi_vec;
+    map->occupancy      = new_occupancy;
+    map->max_item_count = map->map->length * load_factor;
+    map->resize_count++;
+    COUNTER_INC(SPARSE_MAP_REHASH);
+}
+
+/**
+ * Move items from old table into current table, examining at most given
+ * number of old buckets. Buckets are examined in order, and old table is
+ * destroyed once every bucket has been examined.
+ * @param map
+ * @param budget Number of old buckets to examine. SIZE_MAX to finish migration.
+ * @param udata Unused, hashes of migrated items are stored in items.
+ * */
+static void migrate_buckets(SparseMap* map, Size budget, void* udata) {
+    UNUSED(udata);
+
+    Size old_length = map->old_map->length;
+    Size end        = budget < old_length - map->migrate_pos ? map->migrate_pos + budget : old_length;
+
+    for(Size s = bitvec_find_next_set(map->old_occupancy, map->migrate_pos); s < end;
+        s = s + 1 < end ? bitvec_find_next_set(map->old_occupancy, s + 1) : SIZE_MAX) {
+        /* same as in resize, chained items are allocated separately and freed after being moved */
+        SparseMapItem* iter = smi_vector_address_at(map->old_map, s);
+        SparseMapItem* next = iter->next;
+        map->item_count--;
+        insert_into_sparse_map_directly(map, iter, iter->hash);
+
+        iter = next;
+        while(iter) {
+            next = iter->next;
+            map->item_count--;
+            insert_into_sparse_map_directly(map, iter, iter->hash);
+            lballoc_free(map->node_pool, (MemBlock)iter);
+            iter = next;
+        }
+
+        bitvec_clear(map->old_occupancy, s);
+    }
+
+    map->migrate_pos = end;
+    if(end == old_length) {
+        destroy_old_table(map);
+    }
+}
+
+/**
+ * Exchange current table with old table, so that functions working on
+ * current table can be used on old table.
+ * @param map
+ * */
+static void swap_tables(SparseMap* map) {
+    Smi_Vector* buckets = map->map;
+    map->map            = map->old_map;
+    map->old_map        = buckets;
+
+    BitVector* occupancy = map->occupancy;
+    map->occupancy       = map->old_occupancy;
+    map->old_occupancy   = occupancy;
+}
+
+/**
+ * Destroy old table without destroying any copies stored in it.
+ * @param map
+ * */
+static void destroy_old_table(SparseMap* map) {
+    destroy_smi_vector_shallow(map->old_map);
+    bitvec_destroy(map->old_occupancy);
+    map->old_map       = NULL;
+    map->old_occupancy = NULL;
+    map->migrate_pos   = 0;
+}
+
 /**
  * Insert a value into hash map without creating any copy of it.
  * @param map
  * @param item
- * @param udata
+ * @param hash Hash of key of item.
  * */
-static inline SparseMapItem* insert_into_sparse_map_directly(SparseMap* map, SparseMapItem* item, void* udata) {
+static inline SparseMapItem* insert_into_sparse_map_directly(SparseMap* map, SparseMapItem* item, Size hash) {
     ERR_RETURN_VALUE_IF_FAIL(map && item, NULL, ERR_INVALID_ARGUMENTS);
 
-    Size hash = map->hash(item->key, udata);
     Size len_wrap_mask = map->map->length - 1;
     Size pos = hash & len_wrap_mask; /* it's guaranteed that size of sparsemap will always be in powers of two */
+    item->hash = hash;
 
     SparseMapItem* iter = smi_vector_address_at(map->map, pos);
-    if(bitvec_peek(map->occupancy, pos)) {
+    if(bitvec_peek_unchecked(map->occupancy, pos)) {
         /* if bucket has is occupied : separate-chaining */
         while(iter->next) {
             iter = iter->next;
         }
 
         /* create new item for chain and add to chain. */
-        SparseMapItem* newitem = (SparseMapItem*)lballoc_allocate(lba);
+        SparseMapItem* newitem = (SparseMapItem*)lballoc_allocate(map->node_pool);
         ERR_RETURN_VALUE_IF_FAIL(newitem, NULL, ERR_OUT_OF_MEMORY);
         memcpy(newitem, item, sizeof(SparseMapItem));
+        newitem->next = NULL;
         iter->next = newitem;
 
         map->item_count++;
@@ -443,8 +1360,21 @@ static inline SparseMapItem* insert_into_sparse_map_directly(SparseMap* map, Spa
         /* if bucket is empty */
         memcpy(iter, item, sizeof(SparseMapItem));
         iter->next = NULL;
+        bitvec_set(map->occupancy, pos);
 
         map->item_count++;
         return iter;
     }
 }
+
+/**
+ * Destroy bucket vector without destroying any copies stored in it.
+ * Copies are either moved elsewhere or already destroyed when this is called.
+ *
+ * @param vec
+ * */
+static void destroy_smi_vector_shallow(Smi_Vector* vec) {
+    allocator_free(vec->allocator, vec->data, vec->capacity * vec->element_size);
+    vec->data = NULL;
+    allocator_free(vec->allocator, vec, sizeof(Vector));
+}
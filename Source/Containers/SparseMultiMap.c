@@ -0,0 +1,272 @@
+/**
+ * @file SparseMultiMap.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Multimap with values of each key grouped in a @c Vector.
+ * */
+
+#include <Anvie/Containers/SparseMultiMap.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+
+/* vector of values of given key, NULL when key is absent */
+static FORCE_INLINE Vector* values_of(SparseMultiMap* map, void* key, void* udata) {
+    SparseMapItem* item = sparse_map_search(map->keys, key, udata);
+    return item ? (Vector*)item->data : NULL;
+}
+
+/* sparse_map_drain visitor destroying value vector of each key */
+static void destroy_values(SparseMapItem* item, void* udata) {
+    vector_destroy((Vector*)item->data, udata);
+}
+
+/**
+ * Create a new multimap.
+ *
+ * @param hash Hash function for keys.
+ * @param key_size Size of key in bytes.
+ * @param create_key_copy Copy constructor for key, can be NULL.
+ * @param destroy_key_copy Copy destructor for key, can be NULL.
+ * @param compare_key Key comparision function.
+ * @param value_size Size of each value in bytes.
+ * @param create_value_copy Copy constructor for value, can be NULL.
+ * @param destroy_value_copy Copy destructor for value, can be NULL.
+ * @return SparseMultiMap object on success, NULL otherwise.
+ * */
+SparseMultiMap* sparse_multimap_create(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       value_size,
+    CreateElementCopyCallback  create_value_copy,
+    DestroyElementCopyCallback destroy_value_copy
+) {
+    return sparse_multimap_create_with_allocator(hash, key_size, create_key_copy, destroy_key_copy, compare_key,
+                                                 value_size, create_value_copy, destroy_value_copy, NULL);
+}
+
+/**
+ * Create a new multimap that allocates all it's memory from given allocator.
+ * Rest of the parameters are same as @c sparse_multimap_create.
+ *
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return SparseMultiMap object on success, NULL otherwise.
+ * */
+SparseMultiMap* sparse_multimap_create_with_allocator(
+    HashCallback               hash,
+    Size                       key_size,
+    CreateElementCopyCallback  create_key_copy,
+    DestroyElementCopyCallback destroy_key_copy,
+    CompareElementCallback     compare_key,
+    Size                       value_size,
+    CreateElementCopyCallback  create_value_copy,
+    DestroyElementCopyCallback destroy_value_copy,
+    Allocator*                 allocator
+) {
+    ERR_RETURN_VALUE_IF_FAIL(hash && compare_key && key_size && value_size, NULL, ERR_INVALID_ARGUMENTS);
+
+    // both must be null or non null at the same time
+    ERR_RETURN_VALUE_IF_FAIL(!create_value_copy == !destroy_value_copy, NULL, ERR_INVALID_ARGUMENTS);
+
+    SparseMultiMap* map = allocator_allocate_zeroed(allocator, sizeof(SparseMultiMap));
+    ERR_RETURN_VALUE_IF_FAIL(map, NULL, ERR_OUT_OF_MEMORY);
+
+    // value vectors are owned by this map, so keys map stores just the pointers
+    map->keys = sparse_map_create_with_allocator(hash, key_size, create_key_copy, destroy_key_copy, compare_key,
+                                                 sizeof(Vector*), NULL, NULL,
+                                                 False, SPARSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, allocator, NULL);
+    if(!map->keys) {
+        allocator_free(allocator, map, sizeof(SparseMultiMap));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+        return NULL;
+    }
+
+    map->value_size         = value_size;
+    map->create_value_copy  = create_value_copy;
+    map->destroy_value_copy = destroy_value_copy;
+    map->allocator          = allocator;
+
+    return map;
+}
+
+/**
+ * Destroy given multimap, along with all keys and values in it.
+ * @param map
+ * @param udata User data passed to copy destructors.
+ * */
+void sparse_multimap_destroy(SparseMultiMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    sparse_map_drain(map->keys, destroy_values, udata);
+    sparse_map_destroy(map->keys, udata);
+    allocator_free(map->allocator, map, sizeof(SparseMultiMap));
+}
+
+/**
+ * Add a value to given key, after all values it already has.
+ * @param map
+ * @param key
+ * @param value Value to be copied into map.
+ * @param udata User data passed to callbacks.
+ * @return True on success, False otherwise.
+ * */
+Bool sparse_multimap_insert(SparseMultiMap* map, void* key, void* value, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    Vector* values = values_of(map, key, udata);
+    if(!values) {
+        values = vector_create_with_allocator(map->value_size, map->create_value_copy,
+                                              map->destroy_value_copy, map->allocator);
+        ERR_RETURN_VALUE_IF_FAIL(values, False, ERR_INVALID_OBJECT);
+
+        if(!sparse_map_insert(map->keys, key, values, udata)) {
+            vector_destroy(values, udata);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+            return False;
+        }
+    }
+
+    Size length = values->length;
+    vector_push_back(values, value, udata);
+    if(values->length == length) {
+        return False;
+    }
+
+    map->value_count++;
+    return True;
+}
+
+/**
+ * Get all values of given key. Values are contiguous, in order of insertion.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return View over values of key, an empty view when key is absent.
+ * Valid until next insertion or deletion of same key.
+ * */
+VectorView sparse_multimap_equal_range(SparseMultiMap* map, void* key, void* udata) {
+    VectorView view = {0};
+    ERR_RETURN_VALUE_IF_FAIL(map, view, ERR_INVALID_ARGUMENTS);
+
+    Vector* values = values_of(map, key, udata);
+
+    view.element_size = map->value_size;
+    if(values) {
+        view = vector_get_view(values, 0, values->length);
+    }
+    return view;
+}
+
+/**
+ * Get number of values of given key.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return Number of values, 0 when key is absent.
+ * */
+Size sparse_multimap_count(SparseMultiMap* map, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, 0, ERR_INVALID_ARGUMENTS);
+
+    Vector* values = values_of(map, key, udata);
+    return values ? values->length : 0;
+}
+
+/**
+ * Call @p visitor for each value of given key, in order of insertion.
+ * @param map
+ * @param key
+ * @param visitor Callback to be called for each value. Must not modify map.
+ * @param udata User data passed to @p visitor and callbacks of map.
+ * */
+void sparse_multimap_foreach_value(SparseMultiMap* map, void* key, SparseMultiMapValueCallback visitor, void* udata) {
+    ERR_RETURN_IF_FAIL(map && visitor, ERR_INVALID_ARGUMENTS);
+
+    Vector* values = values_of(map, key, udata);
+    if(!values) {
+        return;
+    }
+
+    for(Size s = 0; s < values->length; s++) {
+        visitor(vector_address_at(values, s), udata);
+    }
+}
+
+/**
+ * Delete given key together with all of it's values.
+ * @param map
+ * @param key
+ * @param udata User data passed to callbacks.
+ * @return Number of values deleted.
+ * */
+Size sparse_multimap_delete(SparseMultiMap* map, void* key, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, 0, ERR_INVALID_ARGUMENTS);
+
+    Vector* values = values_of(map, key, udata);
+    if(!values) {
+        return 0;
+    }
+
+    Size count = values->length;
+    sparse_map_delete(map->keys, key, udata);
+    vector_destroy(values, udata);
+
+    map->value_count -= count;
+    return count;
+}
+
+/**
+ * Delete one value of given key. Order of remaining values is preserved.
+ * Key is deleted along with it's last value.
+ * @param map
+ * @param key
+ * @param pos Index of value in @c sparse_multimap_equal_range of key.
+ * @param udata User data passed to callbacks.
+ * @return True if value was deleted, False if there's no such value.
+ * */
+Bool sparse_multimap_delete_value(SparseMultiMap* map, void* key, Size pos, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(map, False, ERR_INVALID_ARGUMENTS);
+
+    Vector* values = values_of(map, key, udata);
+    if(!values || pos >= values->length) {
+        return False;
+    }
+
+    if(values->length == 1) {
+        sparse_map_delete(map->keys, key, udata);
+        vector_destroy(values, udata);
+    } else {
+        vector_delete(values, pos, udata);
+    }
+
+    map->value_count--;
+    return True;
+}
+
+/**
+ * Remove all keys and values from map, keeping capacity of key table.
+ * @param map
+ * @param udata User data passed to copy destructors.
+ * */
+void sparse_multimap_clear(SparseMultiMap* map, void* udata) {
+    ERR_RETURN_IF_FAIL(map, ERR_INVALID_ARGUMENTS);
+
+    sparse_map_drain(map->keys, destroy_values, udata);
+    map->value_count = 0;
+}
@@ -22,41 +22,108 @@
  * */
 
 #include <Anvie/Containers/String.h>
+#include <Anvie/Containers/Common.h>
+#include <Anvie/Containers/NumberFormat.h>
 #include <Anvie/Error.h>
+#include <Anvie/Counters.h>
+#include <Anvie/Simd/Simd.h>
+#include <stdio.h>
 #include <string.h>
 
-#ifndef STR_INITIAL_CAPACITY
-#define STR_INITIAL_CAPACITY 32
-#endif// STR_INITIAL_CAPACITY
+/**
+ * Make sure given string has space for at least @p capacity bytes.
+ * Inline contents are moved to a new allocation the first time string
+ * outgrows @c inline_data, and inline bytes are cleared after that.
+ *
+ * @param str
+ * @param capacity Required capacity.
+ * @return True on success, False otherwise.
+ * */
+static Bool grow_to(String* str, Size capacity) {
+    if(capacity <= str->capacity) {
+        return True;
+    }
+
+    Char* tmp = NULL;
+    if(str_is_inline(str)) {
+        tmp = allocator_allocate(str->allocator, capacity);
+        if(tmp) {
+            memcpy(tmp, str->data, str->length);
+            memset(str->inline_data, 0, STR_INLINE_CAPACITY);
+        }
+    } else {
+        tmp = allocator_reallocate(str->allocator, str->data, str->capacity, capacity);
+    }
+
+    if(!tmp) {
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return False;
+    }
+    str->data     = tmp;
+    str->capacity = capacity;
+    COUNTER_INC(STRING_REALLOC);
+    return True;
+}
+
+/**
+ * Make sure given string has space for @p n more bytes after it's
+ * contents, doubling capacity as many times as needed.
+ *
+ * @param str
+ * @param n Number of bytes to make space for.
+ * @return True on success, False otherwise.
+ * */
+static Bool grow_by(String* str, Size n) {
+    Size required = str->length + n;
+    if(required <= str->capacity) {
+        return True;
+    }
+
+    Size capacity = str->capacity;
+    while(capacity < required) capacity *= 2;
+    return grow_to(str, capacity);
+}
 
 /**
  * Create a new string buffer object. If @p zstr is @c NULL
- * then empty string will be created with some default initial
- * capacity to store new strings.
+ * then empty string will be created with @c STR_INLINE_CAPACITY
+ * bytes of inline capacity to store new strings. Strings that fit
+ * in there need no allocation other than the object itself.
  *
  * @param zstr String to be set initially. This can be @c NULL.
  * @return String on success, NULL otherwise.
  * */
 String* str_create(ZString zstr) {
-    String* sb = NEW(String);
+    return str_create_with_allocator(zstr, NULL);
+}
+
+/**
+ * Create a new string buffer object that allocates all of it's
+ * memory from given allocator.
+ *
+ * @param zstr String to be set initially. This can be @c NULL.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return String on success, NULL otherwise.
+ * */
+String* str_create_with_allocator(ZString zstr, Allocator* allocator) {
+    String* sb = allocator_allocate_zeroed(allocator, sizeof(String));
     ERR_RETURN_VALUE_IF_FAIL(sb, NULL, ERR_OUT_OF_MEMORY);
 
-    /* get size to allocate for storing string */
-    Size zstrlen = zstr ? strlen(zstr) : 0;
-    sb->capacity = MAX(zstrlen, STR_INITIAL_CAPACITY);
+    sb->data      = sb->inline_data;
+    sb->capacity  = STR_INLINE_CAPACITY;
+    sb->allocator = allocator;
 
     /* string objects are not null terminated,
      * so no need to allocate an extra byte for that */
-    sb->data = ALLOCATE(Char, sb->capacity);
-    if(!sb->data) {
-        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
-        FREE(sb);
+    Size zstrlen = zstr ? strlen(zstr) : 0;
+    if(!grow_to(sb, zstrlen)) {
+        allocator_free(allocator, sb, sizeof(String));
         return NULL;
     }
 
     /* if string is not null then create copy and adjust length */
     if(zstr) {
-        memcpy(sb->data, zstr, sb->capacity);
+        memcpy(sb->data, zstr, zstrlen);
         sb->length = zstrlen;
     }
 
@@ -73,18 +140,21 @@ void str_destroy(String* string) {
 
     if(string->data) {
         memset(string->data, 0, string->capacity);
-        FREE(string->data);
+        if(!str_is_inline(string)) {
+            allocator_free(string->allocator, string->data, string->capacity);
+        }
         string->data = NULL;
     }
 
-    FREE(string);
+    allocator_free(string->allocator, string, sizeof(String));
 }
 
 /**
  * Clone the given @c String.
- * This will clone every aspect of given @c String.
  * The two buffers will be identical in their content,
- * capacity and length.
+ * length and allocator. Clone of a string that fits in
+ * @c STR_INLINE_CAPACITY bytes is stored inline, otherwise
+ * both have same capacity.
  *
  * @param sb @c String to be cloned.
  *
@@ -93,23 +163,105 @@ void str_destroy(String* string) {
 String* str_clone(String* sb) {
     ERR_RETURN_VALUE_IF_FAIL(sb, NULL, ERR_INVALID_ARGUMENTS);
 
-    String* sbclone = NEW(String);
+    String* sbclone = allocator_allocate_zeroed(sb->allocator, sizeof(String));
     ERR_RETURN_VALUE_IF_FAIL(sbclone, NULL, ERR_OUT_OF_MEMORY);
 
-    sbclone->data = ALLOCATE(Char, sb->capacity);
-    if(!sbclone->data) {
-        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
-        FREE(sbclone);
+    sbclone->data      = sbclone->inline_data;
+    sbclone->capacity  = STR_INLINE_CAPACITY;
+    sbclone->allocator = sb->allocator;
+
+    if(!grow_to(sbclone, sb->length > STR_INLINE_CAPACITY ? sb->capacity : 0)) {
+        allocator_free(sb->allocator, sbclone, sizeof(String));
         return NULL;
     }
 
     memcpy((void*)sbclone->data, sb->data, sb->length);
-    sbclone->capacity = sb->capacity;
-    sbclone->length   = sb->length;
+    sbclone->length = sb->length;
 
     return sbclone;
 }
 
+/* header, one section of characters, and trailer */
+static Size str_write_image(String* str, ImageWriter* writer) {
+    Uint64 params[1] = {str->length};
+
+    image_writer_begin(writer, IMAGE_KIND_STRING, 0, params, ARRAY_SIZE(params),
+                       image_section_size(sizeof(ImageHeader)) + image_section_size(str->length) + sizeof(ImageTrailer));
+    image_writer_put(writer, str->data, str->length);
+    image_writer_align(writer);
+    return image_writer_finish(writer);
+}
+
+/**
+ * Write an image of given @c String into @p buffer, see Anvie/Containers/Image.h.
+ *
+ * @param buffer Destination, can be NULL to only compute size of image.
+ * @param capacity Size of @p buffer.
+ * @return Size of image. Image is complete only if this is at most @p capacity.
+ * @return 0 on invalid arguments.
+ * */
+Size str_write_to_buffer(String* str, void* buffer, Size capacity) {
+    ERR_RETURN_VALUE_IF_FAIL(str, 0, ERR_INVALID_ARGUMENTS);
+
+    ImageWriter writer;
+    image_writer_init_buffer(&writer, buffer, capacity);
+    return str_write_image(str, &writer);
+}
+
+/**
+ * Write an image of given @c String to a file, at it's current offset.
+ *
+ * @return True if whole image was written.
+ * */
+Bool str_serialize_to_fd(String* str, int fd) {
+    ERR_RETURN_VALUE_IF_FAIL(str, False, ERR_INVALID_ARGUMENTS);
+
+    ImageWriter writer;
+    if(!image_writer_init_fd(&writer, fd)) {
+        return False;
+    }
+    return str_write_image(str, &writer) != 0;
+}
+
+/**
+ * Load @c String held by given image. Characters are not copied, they're
+ * used right where they are in image, even for short strings. @c String is
+ * owned by image and loading it again returns same @c String.
+ *
+ * @return String* on success.
+ * @return NULL if image does not hold a valid @c String.
+ * */
+String* str_from_image(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(image_get_kind(image) == IMAGE_KIND_STRING, NULL, ERR_INVALID_CONTENTS);
+
+    String* str = image_get_container(image);
+    if(str) {
+        return str;
+    }
+
+    Uint64 length = image_get_header(image)->params[0];
+    RETURN_VALUE_IF_FAIL(length <= SIZE_MAX - IMAGE_SECTION_ALIGN, NULL, "invalid string image\n");
+
+    /* zero padding of section is usable capacity */
+    Size  cursor   = 0;
+    Size  capacity = image_section_size(length);
+    Char* data     = image_take_section(image, &cursor, capacity);
+    RETURN_VALUE_IF_FAIL(data, NULL, "invalid string image\n");
+
+    Allocator* allocator = image_get_allocator(image);
+    str = allocator_allocate_zeroed(allocator, sizeof(String));
+    ERR_RETURN_VALUE_IF_FAIL(str, NULL, ERR_OUT_OF_MEMORY);
+
+    str->data      = data;
+    str->length    = length;
+    str->capacity  = capacity;
+    str->allocator = allocator;
+
+    image_set_container(image, str);
+    return str;
+}
+
 /**
  * Create a NULL terminated data copy of @c String object.
  *
@@ -117,7 +269,7 @@ String* str_clone(String* sb) {
  * @return Duplicated @c ZString on success, @c NULL otherwise.
  * This does not check for @c NULL returned by strdup.
  * */
-ZString str_clone_zstr(String* sb) {
+ZString str_clone_to_zstr(String* sb) {
     ERR_RETURN_VALUE_IF_FAIL(sb, NULL, ERR_INVALID_ARGUMENTS);
 
     Char* zstrclone = (Char*)malloc(sb->length + 1);
@@ -146,14 +298,9 @@ void str_set_zstr(String* str, ZString zstr) {
 
     Size zstrlen = strlen(zstr);
 
-    /* realloc to store string */
-    if(zstrlen > str->capacity) {
-        Char* tmp = realloc(str->data, zstrlen);
-        if(!tmp) {
-            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
-            return;
-        }
-        str->capacity = zstrlen;
+    /* grow to store string */
+    if(!grow_to(str, zstrlen)) {
+        return;
     }
 
     /* create copy of given null terminated string */
@@ -210,7 +357,7 @@ Int32 str_cmp_zstr(String* sb, ZString s) {
 
     Size zstrlen = strlen(s);
     if(zstrlen != sb->length) return 1;
-    return memcmp(sb->data, s, sb->length);
+    return mem_compare(sb->data, s, sb->length);
 }
 
 /**
@@ -227,7 +374,7 @@ Int32 str_cmpn_zstr(String* sb, ZString s, Size n) {
     ERR_RETURN_VALUE_IF_FAIL(sb && s && n, 1, ERR_INVALID_ARGUMENTS);
 
     Size zstrlen = MIN(strlen(s), n);
-    return memcmp(sb->data, s, MIN(sb->length, zstrlen));
+    return mem_compare(sb->data, s, MIN(sb->length, zstrlen));
 }
 
 /**
@@ -240,8 +387,9 @@ Int32 str_cmpn_zstr(String* sb, ZString s, Size n) {
 Int32 str_cmp(String* sb1, String* sb2) {
     ERR_RETURN_VALUE_IF_FAIL(sb1 && sb2, 1, ERR_INVALID_ARGUMENTS);
 
+    /* strings of different lengths are never equal, so no byte needs to be compared */
     if(sb1->length != sb2->length) return 1;
-    return memcmp(sb1->data, sb2->data, sb1->length);
+    return mem_compare(sb1->data, sb2->data, sb1->length);
 }
 
 /**
@@ -257,7 +405,33 @@ Int32 str_cmp(String* sb1, String* sb2) {
 Int32 str_cmpn(String* sb1, String* sb2, Size n) {
     ERR_RETURN_VALUE_IF_FAIL(sb1 && sb2 && n, 1, ERR_INVALID_ARGUMENTS);
 
-    return memcmp(sb1->data, sb2->data, MIN3(sb1->length, sb2->length, n));
+    return mem_compare(sb1->data, sb2->data, MIN3(sb1->length, sb2->length, n));
+}
+
+/**
+ * Hash contents of @c String with default hash seed.
+ * Signature matches @c HashCallback, so this can be used directly
+ * as hash function for maps keyed by @c String*.
+ *
+ * @param sb @c String to hash.
+ * @param udata Unused.
+ * @return Hash of first @c length bytes of string.
+ * */
+Uint64 str_hash(String* sb, void* udata) {
+    UNUSED(udata);
+    return str_hash_seeded(sb, hash_get_default_seed());
+}
+
+/**
+ * Hash contents of @c String with given seed.
+ *
+ * @param sb @c String to hash.
+ * @param seed Seed for hash.
+ * @return Hash of first @c length bytes of string.
+ * */
+Uint64 str_hash_seeded(String* sb, Uint64 seed) {
+    ERR_RETURN_VALUE_IF_FAIL(sb, 0, ERR_INVALID_ARGUMENTS);
+    return hash_bytes_seeded(sb->data, sb->length, seed);
 }
 
 /**
@@ -273,15 +447,7 @@ void str_reserve(String* buf, Size n) {
     ERR_RETURN_IF_FAIL(buf && n, ERR_INVALID_ARGUMENTS);
 
     /* resize only if reserve size is greater than capacity */
-    if(n > buf->capacity) {
-        Char* tmpstr = realloc((void*)buf->data, n + 1);
-        if(!tmpstr) {
-            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
-            return;
-        }
-        buf->data = tmpstr;
-        buf->capacity = n;
-    }
+    grow_to(buf, n);
 }
 
 /**
@@ -323,22 +489,18 @@ void str_clear_fast(String* buf) {
 void str_push_char(String* buf, Char c) {
     ERR_RETURN_IF_FAIL(buf, ERR_INVALID_ARGUMENTS);
 
-    Size newlen = buf->length++;
+    Size newlen = buf->length + 1;
 
     // allocate new space if needed
     if(newlen > buf->capacity) {
         Size newcap = buf->capacity;
         while(newlen >= newcap) newcap *= 2;
-        Char* tmpstr = realloc((void*)buf->data, newcap);
-        if(!tmpstr) {
-            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        if(!grow_to(buf, newcap)) {
             return;
         }
-        buf->data = tmpstr;
-        buf->capacity = newcap;
     }
 
-    buf->data[buf->length - 1] = c;
+    buf->data[buf->length] = c;
     buf->length = newlen;
 }
 
@@ -349,8 +511,8 @@ void str_push_char(String* buf, Char c) {
  * @return Char last character popped out from string.
  * */
 Char str_pop_char(String* str) {
-    ERR_RETURN_VALUE_IF_FAIL(str, 0, ERR_INVALID_ARGUMENTS);
-    return str->data[str->length--];
+    ERR_RETURN_VALUE_IF_FAIL(str && str->length, 0, ERR_INVALID_ARGUMENTS);
+    return str->data[--str->length];
 }
 
 /**
@@ -371,13 +533,9 @@ void str_push_zstr(String* buf, ZString s) {
     if(newlen > buf->capacity) {
         Size newcap = buf->capacity;
         while(newlen >= newcap) newcap *= 2;
-        Char* tmpstr = realloc((void*)buf->data, newcap);
-        if(!tmpstr) {
-            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        if(!grow_to(buf, newcap)) {
             return;
         }
-        buf->data = tmpstr;
-        buf->capacity = newcap;
     }
 
     memcpy((void*)(buf->data + buf->length), s, ssz);
@@ -404,16 +562,12 @@ void str_pushn_zstr(String* buf, ZString s, Size n) {
     Size newlen = buf->length + ssz;
 
     // allocate new space if needed
-    if(newlen >= buf->capacity) {
+    if(newlen > buf->capacity) {
         Size newcap = buf->capacity;
         while(newlen >= newcap) newcap *= 2;
-        Char* tmpstr = realloc((void*)buf->data, newcap + 1);
-        if(!tmpstr) {
-            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        if(!grow_to(buf, newcap)) {
             return;
         }
-        buf->data = tmpstr;
-        buf->capacity = newcap;
     }
 
     memcpy((void*)(buf->data + buf->length), s, ssz);
@@ -440,3 +594,388 @@ ZString str_popn_zstr(String* str, Size n) {
 
     return zstr;
 }
+
+
+/**
+ * Get view of part of string. Out of range positions and lengths are
+ * clamped to end of string.
+ *
+ * @param str @c String to view.
+ * @param pos First character of part.
+ * @param length Maximum number of characters in part, @c SIZE_MAX for upto end.
+ * @return View valid until string is modified or destroyed.
+ * */
+StringView str_subview(String* str, Size pos, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(str, strview(NULL, 0), ERR_INVALID_ARGUMENTS);
+    return strview_sub(str_view(str), pos, length);
+}
+
+/**
+ * Remove last @p n characters of string, without copying them like
+ * @c str_popn_zstr does. Removed bytes are not cleared, so returned
+ * view stays valid until string is modified or destroyed.
+ *
+ * @param str
+ * @param n Number of characters to remove, clamped to length of string.
+ * @return View of removed characters.
+ * */
+StringView str_popn_view(String* str, Size n) {
+    ERR_RETURN_VALUE_IF_FAIL(str, strview(NULL, 0), ERR_INVALID_ARGUMENTS);
+
+    n            = MIN(n, str->length);
+    str->length -= n;
+    return strview(str->data + str->length, n);
+}
+
+/**
+ * Compare a @c String and a view, same as @c strview_cmp.
+ *
+ * @param str @c String.
+ * @param sv View, need not be null terminated.
+ * @return Negative, zero or positive if @p str is smaller than, equal to
+ * or greater than @p sv.
+ * */
+Int32 str_cmp_view(String* str, StringView sv) {
+    ERR_RETURN_VALUE_IF_FAIL(str, 1, ERR_INVALID_ARGUMENTS);
+    return strview_cmp(str_view(str), sv);
+}
+
+/* true if @p sv refers into storage of @p str, which moves when it grows */
+static FORCE_INLINE Bool is_own_view(String* str, StringView sv) {
+    return sv.data >= str->data && sv.data < str->data + str->capacity;
+}
+
+/**
+ * Append characters of a view to given @c String.
+ * View may refer to this same string, eg: to repeat a part of it.
+ *
+ * @param str @c String to append to.
+ * @param sv Characters to append.
+ * */
+void str_push_view(String* str, StringView sv) {
+    ERR_RETURN_IF_FAIL(str && (sv.data || !sv.length), ERR_INVALID_ARGUMENTS);
+    if(!sv.length) {
+        return;
+    }
+
+    Size offset = is_own_view(str, sv) ? (Size)(sv.data - str->data) : SIZE_MAX;
+    Size newlen = str->length + sv.length;
+
+    // allocate new space if needed
+    if(newlen > str->capacity) {
+        Size newcap = str->capacity;
+        while(newlen > newcap) newcap *= 2;
+        if(!grow_to(str, newcap)) {
+            return;
+        }
+    }
+
+    memmove(str->data + str->length, offset == SIZE_MAX ? sv.data : str->data + offset, sv.length);
+    str->length = newlen;
+}
+
+/**
+ * Set contents of given @c String to characters of a view.
+ * View may refer to this same string, eg: to keep only a part of it.
+ *
+ * @param str @c String to set.
+ * @param sv Characters to set.
+ * */
+void str_set_view(String* str, StringView sv) {
+    ERR_RETURN_IF_FAIL(str && (sv.data || !sv.length), ERR_INVALID_ARGUMENTS);
+
+    if(is_own_view(str, sv)) {
+        memmove(str->data, sv.data, sv.length);
+    } else {
+        if(!grow_to(str, sv.length)) {
+            return;
+        }
+        memcpy(str->data, sv.data, sv.length);
+    }
+    str->length = sv.length;
+}
+
+/**
+ * Append text formatted as by @c printf, see @c str_vappendf.
+ *
+ * @param str @c String to append to.
+ * @param fmt Format string.
+ * @return Number of characters appended.
+ * */
+Size str_appendf(String* str, ZString fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    Size n = str_vappendf(str, fmt, args);
+    va_end(args);
+    return n;
+}
+
+/**
+ * Append text formatted as by @c vprintf. Text is formatted directly
+ * into spare capacity of string. Only if it does not fit, string grows
+ * once to exactly fit it and text is formatted again, so there's never
+ * an intermediate buffer or an extra copy.
+ *
+ * @param str @c String to append to.
+ * @param fmt Format string.
+ * @param args Arguments for @p fmt.
+ * @return Number of characters appended, 0 on failure.
+ * */
+Size str_vappendf(String* str, ZString fmt, va_list args) {
+    ERR_RETURN_VALUE_IF_FAIL(str && fmt, 0, ERR_INVALID_ARGUMENTS);
+
+    va_list retry;
+    va_copy(retry, args);
+
+    /* vsnprintf always writes a null terminator, that byte is not part of string */
+    Size  spare = str->capacity - str->length;
+    Int32 n     = vsnprintf(str->data + str->length, spare, fmt, args);
+    if(n < 0) {
+        va_end(retry);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_ARGUMENTS));
+        return 0;
+    }
+
+    if((Size)n >= spare) {
+        if(!grow_by(str, (Size)n + 1)) {
+            va_end(retry);
+            return 0;
+        }
+        vsnprintf(str->data + str->length, (Size)n + 1, fmt, retry);
+    }
+    va_end(retry);
+
+    str->length += (Size)n;
+    return (Size)n;
+}
+
+/**
+ * Append decimal digits of given integer, formatted directly into string.
+ *
+ * @param str @c String to append to.
+ * @param value
+ * */
+void str_push_u64(String* str, Uint64 value) {
+    ERR_RETURN_IF_FAIL(str, ERR_INVALID_ARGUMENTS);
+    if(!grow_by(str, NUM_FORMAT_U64_MAX_LENGTH)) {
+        return;
+    }
+    str->length += num_format_u64(str->data + str->length, value);
+}
+
+/**
+ * Append decimal digits of given integer, preceded by '-' if negative.
+ *
+ * @param str @c String to append to.
+ * @param value
+ * */
+void str_push_i64(String* str, Int64 value) {
+    ERR_RETURN_IF_FAIL(str, ERR_INVALID_ARGUMENTS);
+    if(!grow_by(str, NUM_FORMAT_I64_MAX_LENGTH)) {
+        return;
+    }
+    str->length += num_format_i64(str->data + str->length, value);
+}
+
+/**
+ * Append shortest decimal text that parses back to exactly given
+ * double, see @c num_format_f64.
+ *
+ * @param str @c String to append to.
+ * @param value
+ * */
+void str_push_f64(String* str, Float64 value) {
+    ERR_RETURN_IF_FAIL(str, ERR_INVALID_ARGUMENTS);
+    if(!grow_by(str, NUM_FORMAT_F64_MAX_LENGTH)) {
+        return;
+    }
+    str->length += num_format_f64(str->data + str->length, value);
+}
+
+/**
+ * Find first occurence of given character.
+ *
+ * @param str @c String to search in.
+ * @param c Character to find.
+ * @param from Position to start search from.
+ * @return Position of character, or @c SIZE_MAX if not found.
+ * */
+Size str_find_char(String* str, Char c, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(str, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return strview_find_char(str_view(str), c, from);
+}
+
+/**
+ * Find first character that is any of characters in given set.
+ * See @c strview_find_any.
+ *
+ * @param str @c String to search in.
+ * @param set Null terminated set of characters to find.
+ * @param from Position to start search from.
+ * @return Position of first matching character, or @c SIZE_MAX if not found.
+ * */
+Size str_find_any(String* str, ZString set, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(str && set, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return strview_find_any(str_view(str), set, from);
+}
+
+/**
+ * Find first occurence of given null terminated string.
+ *
+ * @param str @c String to search in.
+ * @param needle Null terminated string to find.
+ * @param from Position to start search from.
+ * @return Position of first occurence, or @c SIZE_MAX if not found.
+ * */
+Size str_find(String* str, ZString needle, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(needle, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return str_findn(str, needle, strlen(needle), from);
+}
+
+/**
+ * Find first occurence of first @p n bytes of @p needle.
+ * See @c strview_find.
+ *
+ * @param str @c String to search in.
+ * @param needle Bytes to find, need not be null terminated.
+ * @param n Number of bytes in @p needle.
+ * @param from Position to start search from.
+ * @return Position of first occurence, or @c SIZE_MAX if not found.
+ * An empty needle is found at @p from.
+ * */
+Size str_findn(String* str, const Char* needle, Size n, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(str && (needle || !n), SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    return strview_find(str_view(str), strview(needle, n), from);
+}
+
+/**
+ * Count occurences of given character.
+ *
+ * @param str @c String to count in.
+ * @param c Character to count.
+ * @return Number of occurences.
+ * */
+Size str_count_char(String* str, Char c) {
+    ERR_RETURN_VALUE_IF_FAIL(str, 0, ERR_INVALID_ARGUMENTS);
+    return strview_count_char(str_view(str), c);
+}
+
+/**
+ * Check whether string is valid UTF-8, see @c strview_validate_utf8.
+ *
+ * @param str
+ * @return True if valid, False otherwise.
+ * */
+Bool str_validate_utf8(String* str) {
+    ERR_RETURN_VALUE_IF_FAIL(str, False, ERR_INVALID_ARGUMENTS);
+    return strview_validate_utf8(str_view(str));
+}
+
+/**
+ * Check whether all characters of string are ASCII.
+ *
+ * @param str
+ * @return True if no byte has it's highest bit set, False otherwise.
+ * */
+Bool str_is_ascii(String* str) {
+    ERR_RETURN_VALUE_IF_FAIL(str, False, ERR_INVALID_ARGUMENTS);
+    return strview_is_ascii(str_view(str));
+}
+
+/**
+ * Count code points of UTF-8 text in string, see @c strview_utf8_length.
+ *
+ * @param str
+ * @return Number of code points.
+ * */
+Size str_utf8_length(String* str) {
+    ERR_RETURN_VALUE_IF_FAIL(str, 0, ERR_INVALID_ARGUMENTS);
+    return strview_utf8_length(str_view(str));
+}
+
+/* flip case of all characters in [first, last], a register at a time */
+static void change_ascii_case(Char* data, Size length, Char first, Char last) {
+    Size i = 0;
+
+#if SIMD_ENABLED
+    /* bytes above 0x7f are negative, so they never fall in range */
+    const MVec lo   = simd_set1_epi8((Int8)(first - 1));
+    const MVec hi   = simd_set1_epi8((Int8)(last + 1));
+    const MVec flip = simd_set1_epi8(0x20);
+    for(; i + sizeof(MVec) <= length; i += sizeof(MVec)) {
+        MVec v        = simd_loadu(data + i);
+        MVec in_range = simd_and(simd_cmpgt_epi8(v, lo), simd_cmpgt_epi8(hi, v));
+        simd_storeu(data + i, simd_xor(v, simd_and(in_range, flip)));
+    }
+#endif // SIMD_ENABLED
+
+    for(; i < length; i++) {
+        if((Uint8)(data[i] - first) <= (Uint8)(last - first)) {
+            data[i] ^= 0x20;
+        }
+    }
+}
+
+/**
+ * Convert ASCII letters of string to lowercase in place. Bytes of
+ * other UTF-8 characters are never ASCII letters, so UTF-8 text
+ * stays valid, and non ASCII letters are left unchanged.
+ *
+ * @param str
+ * */
+void str_to_lower(String* str) {
+    ERR_RETURN_IF_FAIL(str, ERR_INVALID_ARGUMENTS);
+    change_ascii_case(str->data, str->length, 'A', 'Z');
+}
+
+/**
+ * Convert ASCII letters of string to uppercase in place,
+ * see @c str_to_lower.
+ *
+ * @param str
+ * */
+void str_to_upper(String* str) {
+    ERR_RETURN_IF_FAIL(str, ERR_INVALID_ARGUMENTS);
+    change_ascii_case(str->data, str->length, 'a', 'z');
+}
+
+/**
+ * Split string at each occurence of given delimiter, without copying.
+ * See @c strview_split.
+ *
+ * @param str @c String to split.
+ * @param delim Delimiter between fields.
+ * @param fields Array of atleast @p max_fields views to fill, can be NULL if @p max_fields is 0.
+ * @param max_fields Maximum number of views to store.
+ * @return Total number of fields in string.
+ * Views are valid until string is modified or destroyed.
+ * */
+Size str_split(String* str, Char delim, StringView* fields, Size max_fields) {
+    ERR_RETURN_VALUE_IF_FAIL(str && (fields || !max_fields), 0, ERR_INVALID_ARGUMENTS);
+    return strview_split(str_view(str), delim, fields, max_fields);
+}
+
+/**
+ * Begin splitting given string at each occurence of given delimiter.
+ * Fields are returned one by one by @c str_split_next.
+ *
+ * @param str @c String to split. Must not be modified during split.
+ * @param delim Delimiter between fields.
+ * @return Iterator over fields.
+ * */
+StringSplitIterator str_split_iter(String* str, Char delim) {
+    StringSplitIterator iter = {0};
+    ERR_RETURN_VALUE_IF_FAIL(str, iter, ERR_INVALID_ARGUMENTS);
+    return strview_split_iter(str_view(str), delim);
+}
+
+/**
+ * Get next field of a split, same as @c strview_split_next.
+ *
+ * @param iter Iterator returned by @c str_split_iter.
+ * @param field View to store next field in.
+ * @return True if a field was stored, False when there are no more fields.
+ * */
+Bool str_split_next(StringSplitIterator* iter, StringView* field) {
+    return strview_split_next(iter, field);
+}
@@ -0,0 +1,285 @@
+/**
+ * @file StringArena.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Chunked storage of packed null terminated strings.
+ * */
+
+#include <Anvie/Containers/StringArena.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* bytes taken in a chunk by a string of given length */
+#define STRING_SIZE(length) (STRING_ARENA_HEADER_SIZE + (length) + 1)
+
+/* allocate an empty chunk with space for atleast @p capacity bytes */
+static StringArenaChunk* chunk_create(StringArena* arena, Size capacity) {
+    StringArenaChunk* chunk = allocator_allocate(arena->allocator, sizeof(StringArenaChunk) + capacity);
+    ERR_RETURN_VALUE_IF_FAIL(chunk, NULL, ERR_OUT_OF_MEMORY);
+    chunk->next     = NULL;
+    chunk->capacity = capacity;
+    chunk->used     = 0;
+    return chunk;
+}
+
+/* free all chunks in given list */
+static void chunk_list_destroy(StringArena* arena, StringArenaChunk* chunk) {
+    while(chunk) {
+        StringArenaChunk* next = chunk->next;
+        allocator_free(arena->allocator, chunk, sizeof(StringArenaChunk) + chunk->capacity);
+        chunk = next;
+    }
+}
+
+/**
+ * Create a new string arena.
+ *
+ * @param chunk_size Size of each chunk, 0 for @c STRING_ARENA_DEFAULT_CHUNK_SIZE.
+ * @param allocator Allocator for chunks, NULL for system allocator.
+ * @return StringArena* on success, NULL otherwise.
+ * */
+StringArena* string_arena_create(Size chunk_size, Allocator* allocator) {
+    StringArena* arena = allocator_allocate_zeroed(allocator, sizeof(StringArena));
+    ERR_RETURN_VALUE_IF_FAIL(arena, NULL, ERR_OUT_OF_MEMORY);
+
+    arena->chunk_size = chunk_size ? chunk_size : STRING_ARENA_DEFAULT_CHUNK_SIZE;
+    arena->allocator  = allocator;
+    return arena;
+}
+
+/**
+ * Destroy given string arena, and all strings in it at once.
+ * Takes time proportional to number of chunks, not strings.
+ *
+ * @param arena
+ * */
+void string_arena_destroy(StringArena* arena) {
+    ERR_RETURN_IF_FAIL(arena, ERR_INVALID_ARGUMENTS);
+
+    chunk_list_destroy(arena, arena->chunks);
+    chunk_list_destroy(arena, arena->retired);
+    allocator_free(arena->allocator, arena, sizeof(StringArena));
+}
+
+/**
+ * Release all strings at once. First chunk is kept for reuse
+ * if it's of regular size, all other chunks are freed.
+ *
+ * @param arena
+ * */
+void string_arena_reset(StringArena* arena) {
+    ERR_RETURN_IF_FAIL(arena && !arena->retired, ERR_INVALID_ARGUMENTS);
+
+    StringArenaChunk* keep = arena->chunks;
+    if(keep && keep->capacity == arena->chunk_size) {
+        chunk_list_destroy(arena, keep->next);
+        keep->next = NULL;
+        keep->used = 0;
+    } else {
+        chunk_list_destroy(arena, keep);
+        keep = NULL;
+    }
+
+    arena->chunks       = keep;
+    arena->used_size    = 0;
+    arena->wasted_size  = 0;
+    arena->string_count = 0;
+}
+
+/**
+ * Copy a null terminated string into arena.
+ *
+ * @param arena
+ * @param zstr String to copy.
+ * @return Copy of string in arena, valid until it's released and arena is
+ * compacted, reset or destroyed. NULL on failure.
+ * */
+ZString string_arena_push(StringArena* arena, ZString zstr) {
+    ERR_RETURN_VALUE_IF_FAIL(zstr, NULL, ERR_INVALID_ARGUMENTS);
+    return string_arena_pushn(arena, zstr, strlen(zstr));
+}
+
+/**
+ * Copy given bytes into arena, followed by a null terminator.
+ *
+ * @param arena
+ * @param data Bytes to copy, need not be null terminated.
+ * @param length Number of bytes, atmost UINT32_MAX.
+ * @return Null terminated copy in arena, NULL on failure.
+ * */
+ZString string_arena_pushn(StringArena* arena, const Char* data, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(arena && (data || !length) && length <= UINT32_MAX, NULL, ERR_INVALID_ARGUMENTS);
+
+    Size              size  = STRING_SIZE(length);
+    StringArenaChunk* chunk = arena->chunks;
+    if(!chunk || chunk->capacity - chunk->used < size) {
+        if(size > arena->chunk_size) {
+            /* oversized string goes in a chunk of it's own, placed behind
+             * first chunk so that rest of first chunk is still used */
+            chunk = chunk_create(arena, size);
+            if(!chunk) {
+                return NULL;
+            }
+            if(arena->chunks) {
+                chunk->next         = arena->chunks->next;
+                arena->chunks->next = chunk;
+            } else {
+                arena->chunks = chunk;
+            }
+        } else {
+            chunk = chunk_create(arena, arena->chunk_size);
+            if(!chunk) {
+                return NULL;
+            }
+            chunk->next   = arena->chunks;
+            arena->chunks = chunk;
+        }
+    }
+
+    Char*  dst    = chunk->data + chunk->used;
+    Uint32 header = (Uint32)length;
+    memcpy(dst, &header, sizeof(header));
+    dst += STRING_ARENA_HEADER_SIZE;
+    if(length) {
+        memcpy(dst, data, length);
+    }
+    dst[length] = 0;
+
+    chunk->used      += size;
+    arena->used_size += size;
+    arena->string_count++;
+    return dst;
+}
+
+/**
+ * Mark a string as no longer used. It's memory is not reused until
+ * arena is compacted, this only keeps count of wasted bytes.
+ *
+ * @param arena
+ * @param zstr String returned by @c string_arena_push or @c string_arena_pushn.
+ * */
+void string_arena_release(StringArena* arena, ZString zstr) {
+    ERR_RETURN_IF_FAIL(arena && zstr, ERR_INVALID_ARGUMENTS);
+
+    arena->wasted_size += STRING_SIZE(string_arena_length(zstr));
+    arena->string_count--;
+}
+
+/**
+ * Start a compaction. All chunks are retired, and strings moved with
+ * @c string_arena_relocate are packed into new chunks. Retired chunks
+ * are freed by @c string_arena_compact_end.
+ *
+ * Use this directly when strings in use are not in one array, eg: to
+ * relocate keys of a map one slot at a time.
+ *
+ * @param arena
+ * */
+void string_arena_compact_begin(StringArena* arena) {
+    ERR_RETURN_IF_FAIL(arena && !arena->retired, ERR_INVALID_ARGUMENTS);
+
+    arena->retired      = arena->chunks;
+    arena->chunks       = NULL;
+    arena->used_size    = 0;
+    arena->wasted_size  = 0;
+    arena->string_count = 0;
+}
+
+/**
+ * Move a string in use to new chunks during a compaction, and update it.
+ * Each string must be relocated exactly once, a string referred to from
+ * two places must be relocated once and then assigned to both.
+ *
+ * @param arena
+ * @param zstr Reference to string to move, NULL string is left as is.
+ * */
+void string_arena_relocate(StringArena* arena, ZString* zstr) {
+    ERR_RETURN_IF_FAIL(arena && arena->retired && zstr, ERR_INVALID_ARGUMENTS);
+    if(!*zstr) {
+        return;
+    }
+
+    ZString moved = string_arena_pushn(arena, *zstr, string_arena_length(*zstr));
+    if(moved) {
+        *zstr = moved;
+    }
+}
+
+/**
+ * Finish a compaction, freeing all retired chunks. Strings that were
+ * not relocated are freed with them.
+ *
+ * @param arena
+ * */
+void string_arena_compact_end(StringArena* arena) {
+    ERR_RETURN_IF_FAIL(arena, ERR_INVALID_ARGUMENTS);
+
+    chunk_list_destroy(arena, arena->retired);
+    arena->retired = NULL;
+}
+
+/**
+ * Give back memory of released strings, by copying strings still in use
+ * back to back into new chunks and freeing old ones. Worth doing once
+ * @c string_arena_wasted_size is a large part of @c string_arena_used_size.
+ *
+ * @param arena
+ * @param strings Array of all strings in use, eg: data of a @c ZStrArena_Vector.
+ * Each is updated to it's new place. NULL entries are skipped.
+ * @param count Number of strings in array.
+ * */
+void string_arena_compact(StringArena* arena, ZString* strings, Size count) {
+    ERR_RETURN_IF_FAIL(arena && (strings || !count), ERR_INVALID_ARGUMENTS);
+
+    string_arena_compact_begin(arena);
+    for(Size i = 0; i < count; i++) {
+        string_arena_relocate(arena, strings + i);
+    }
+    string_arena_compact_end(arena);
+}
+
+/**
+ * Copy constructor for strings that packs the copy into a
+ * @c StringArena, passed as udata.
+ *
+ * @param dst Pointer where copy will be stored.
+ * @param src ZString to be copied.
+ * @param arena Arena to store copy in.
+ * */
+void zstr_create_copy_in_arena(ZString* dst, ZString src, StringArena* arena) {
+    if(!dst || !src) return;
+    *dst = string_arena_push(arena, src);
+}
+
+/**
+ * Copy destructor for strings created with @c zstr_create_copy_in_arena.
+ * Only counts string as released in arena. With a NULL arena this does
+ * nothing at all, which is how a container is destroyed without touching
+ * any of it's strings, before destroying or resetting the arena itself.
+ *
+ * @param copy Pointer to copy to be destroyed.
+ * @param arena Arena copy was created in, or NULL.
+ * */
+void zstr_destroy_copy_in_arena(ZString* copy, StringArena* arena) {
+    if(!copy || !*copy) return;
+
+    if(arena) {
+        string_arena_release(arena, *copy);
+    }
+    *copy = NULL;
+}
@@ -0,0 +1,345 @@
+/**
+ * @file StringBuilder.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include <Anvie/Containers/StringBuilder.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/**
+ * Make chunk after tail the new tail. A chunk left over from before a
+ * clear is reused if it can hold @p need characters, otherwise a new
+ * chunk is inserted after tail.
+ *
+ * @param sb
+ * @param need Minimum number of characters new tail must be able to hold.
+ * @param want Number of characters caller is going to append, new chunks
+ * are made large enough to hold all of them.
+ * @return True on success, False otherwise.
+ * */
+static Bool advance(StringBuilder* sb, Size need, Size want) {
+    StringBuilderChunk* next = sb->tail ? sb->tail->next : sb->head;
+    if(next && next->capacity >= need) {
+        sb->tail = next;
+        return True;
+    }
+
+    Size                capacity = MAX(sb->chunk_size, want);
+    StringBuilderChunk* chunk    = allocator_allocate(sb->allocator, sizeof(StringBuilderChunk) + capacity);
+    if(!chunk) {
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return False;
+    }
+
+    chunk->next     = next;
+    chunk->length   = 0;
+    chunk->capacity = capacity;
+    if(sb->tail) {
+        sb->tail->next = chunk;
+    } else {
+        sb->head = chunk;
+    }
+    sb->tail = chunk;
+    return True;
+}
+
+/**
+ * Create a new string builder. No chunk is allocated until first append.
+ *
+ * @param chunk_size Capacity of each chunk, 0 for @c STRING_BUILDER_DEFAULT_CHUNK_SIZE.
+ * @param allocator Allocator for builder and it's chunks. NULL means system allocator.
+ * @return StringBuilder on success, NULL otherwise.
+ * */
+StringBuilder* string_builder_create(Size chunk_size, Allocator* allocator) {
+    StringBuilder* sb = allocator_allocate_zeroed(allocator, sizeof(StringBuilder));
+    ERR_RETURN_VALUE_IF_FAIL(sb, NULL, ERR_OUT_OF_MEMORY);
+
+    sb->chunk_size = chunk_size ? chunk_size : STRING_BUILDER_DEFAULT_CHUNK_SIZE;
+    sb->allocator  = allocator;
+    return sb;
+}
+
+/**
+ * Destroy given string builder and all it's chunks. Nothing is freed
+ * individually if memory is released in bulk by allocator.
+ *
+ * @param sb
+ * */
+void string_builder_destroy(StringBuilder* sb) {
+    ERR_RETURN_IF_FAIL(sb, ERR_INVALID_ARGUMENTS);
+
+    if(allocator_needs_free(sb->allocator)) {
+        StringBuilderChunk* chunk = sb->head;
+        while(chunk) {
+            StringBuilderChunk* next = chunk->next;
+            allocator_free(sb->allocator, chunk, sizeof(StringBuilderChunk) + chunk->capacity);
+            chunk = next;
+        }
+    }
+
+    allocator_free(sb->allocator, sb, sizeof(StringBuilder));
+}
+
+/**
+ * Remove all characters from builder. Chunks are kept and reused
+ * by next appends.
+ *
+ * @param sb
+ * */
+void string_builder_clear(StringBuilder* sb) {
+    ERR_RETURN_IF_FAIL(sb, ERR_INVALID_ARGUMENTS);
+
+    for(StringBuilderChunk* chunk = sb->head; chunk; chunk = chunk->next) {
+        chunk->length = 0;
+    }
+    sb->tail        = sb->head;
+    sb->length      = 0;
+    sb->chunk_count = 0;
+}
+
+/**
+ * Append first @p n bytes of @p data. Bytes that do not fit in last
+ * chunk are stored in next one.
+ *
+ * @param sb
+ * @param data Bytes to append, need not be null terminated.
+ * @param n Number of bytes to append.
+ * @return True on success, False otherwise.
+ * */
+Bool string_builder_pushn(StringBuilder* sb, const Char* data, Size n) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && (data || !n), False, ERR_INVALID_ARGUMENTS);
+
+    while(n) {
+        StringBuilderChunk* tail = sb->tail;
+        if(!tail || tail->length == tail->capacity) {
+            if(!advance(sb, 1, n)) {
+                return False;
+            }
+            tail = sb->tail;
+        }
+
+        Size count = MIN(n, tail->capacity - tail->length);
+        if(!tail->length) {
+            sb->chunk_count++;
+        }
+        memcpy(tail->data + tail->length, data, count);
+        tail->length += count;
+        sb->length   += count;
+        data         += count;
+        n            -= count;
+    }
+    return True;
+}
+
+/**
+ * Append a single character.
+ *
+ * @param sb
+ * @param c
+ * @return True on success, False otherwise.
+ * */
+Bool string_builder_push_char(StringBuilder* sb, Char c) {
+    ERR_RETURN_VALUE_IF_FAIL(sb, False, ERR_INVALID_ARGUMENTS);
+
+    StringBuilderChunk* tail = sb->tail;
+    if(tail && tail->length < tail->capacity && tail->length) {
+        tail->data[tail->length++] = c;
+        sb->length++;
+        return True;
+    }
+    return string_builder_pushn(sb, &c, 1);
+}
+
+/**
+ * Append a null terminated string, without it's terminator.
+ *
+ * @param sb
+ * @param zstr
+ * @return True on success, False otherwise.
+ * */
+Bool string_builder_push_zstr(StringBuilder* sb, ZString zstr) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && zstr, False, ERR_INVALID_ARGUMENTS);
+    return string_builder_pushn(sb, zstr, strlen(zstr));
+}
+
+/**
+ * Append characters of a view.
+ *
+ * @param sb
+ * @param sv
+ * @return True on success, False otherwise.
+ * */
+Bool string_builder_push_view(StringBuilder* sb, StringView sv) {
+    return string_builder_pushn(sb, sv.data, sv.length);
+}
+
+/**
+ * Append contents of a @c String.
+ *
+ * @param sb
+ * @param str
+ * @return True on success, False otherwise.
+ * */
+Bool string_builder_push_str(StringBuilder* sb, String* str) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && str, False, ERR_INVALID_ARGUMENTS);
+    return string_builder_pushn(sb, str->data, str->length);
+}
+
+/**
+ * Get space for @p n contiguous characters at end of builder, to be
+ * written directly, eg: by a formatting function, and then made part of
+ * builder with @c string_builder_commit. If last chunk does not have
+ * enough space left, rest of it is left unused.
+ *
+ * @param sb
+ * @param n Number of characters to make space for.
+ * @return Pointer to space on success, NULL otherwise. Valid until next
+ * append to or clear of builder.
+ * */
+Char* string_builder_reserve(StringBuilder* sb, Size n) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && n, NULL, ERR_INVALID_ARGUMENTS);
+
+    StringBuilderChunk* tail = sb->tail;
+    if(!tail || tail->capacity - tail->length < n) {
+        if(!advance(sb, n, n)) {
+            return NULL;
+        }
+        tail = sb->tail;
+    }
+    return tail->data + tail->length;
+}
+
+/**
+ * Make first @p n characters written to space returned by last
+ * @c string_builder_reserve part of builder.
+ *
+ * @param sb
+ * @param n Number of characters written, atmost number reserved.
+ * */
+void string_builder_commit(StringBuilder* sb, Size n) {
+    ERR_RETURN_IF_FAIL(sb && sb->tail && n <= sb->tail->capacity - sb->tail->length, ERR_INVALID_ARGUMENTS);
+    if(!n) {
+        return;
+    }
+
+    if(!sb->tail->length) {
+        sb->chunk_count++;
+    }
+    sb->tail->length += n;
+    sb->length       += n;
+}
+
+/**
+ * Describe contents of builder as an array of @c iovec, one per
+ * chunk in order, to be written with @c writev without any copy.
+ *
+ * @param sb
+ * @param iov Array of atleast @p max_iov iovecs to fill, can be NULL if @p max_iov is 0.
+ * @param max_iov Maximum number of iovecs to store.
+ * @return Number of chunks holding characters. When this is greater than
+ * @p max_iov, only first @p max_iov chunks are stored.
+ * Iovecs are valid until builder is cleared or destroyed.
+ * */
+Size string_builder_iovecs(StringBuilder* sb, struct iovec* iov, Size max_iov) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && (iov || !max_iov), 0, ERR_INVALID_ARGUMENTS);
+
+    Size count = 0;
+    for(StringBuilderChunk* chunk = sb->head; chunk && count < max_iov; chunk = chunk->next) {
+        if(chunk->length) {
+            iov[count].iov_base = chunk->data;
+            iov[count].iov_len  = chunk->length;
+            count++;
+        }
+        if(chunk == sb->tail) {
+            break;
+        }
+    }
+    return sb->chunk_count;
+}
+
+/**
+ * Copy contents of builder to given buffer.
+ *
+ * @param sb
+ * @param dst Buffer to copy to, not null terminated after copy.
+ * @param capacity Size of @p dst in bytes.
+ * @return Number of bytes copied, less than length of builder if
+ * @p dst is too small.
+ * */
+Size string_builder_copy_to(StringBuilder* sb, Char* dst, Size capacity) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && (dst || !capacity), 0, ERR_INVALID_ARGUMENTS);
+
+    Size copied = 0;
+    for(StringBuilderChunk* chunk = sb->head; chunk && copied < capacity; chunk = chunk->next) {
+        Size count = MIN(chunk->length, capacity - copied);
+        memcpy(dst + copied, chunk->data, count);
+        copied += count;
+        if(chunk == sb->tail) {
+            break;
+        }
+    }
+    return copied;
+}
+
+/**
+ * Append contents of builder to a @c String. String grows atmost once,
+ * and each character is copied exactly once.
+ *
+ * @param sb
+ * @param str @c String to append to.
+ * @return True on success, False otherwise.
+ * */
+Bool string_builder_append_to(StringBuilder* sb, String* str) {
+    ERR_RETURN_VALUE_IF_FAIL(sb && str, False, ERR_INVALID_ARGUMENTS);
+    if(!sb->length) {
+        return True;
+    }
+
+    Size length = str->length + sb->length;
+    str_reserve(str, length);
+    if(str->capacity < length) {
+        return False;
+    }
+
+    str->length += string_builder_copy_to(sb, str->data + str->length, sb->length);
+    return True;
+}
+
+/**
+ * Copy contents of builder into a new @c String, allocated exactly large
+ * enough, and clear builder for next use.
+ *
+ * @param sb
+ * @return String on success, NULL otherwise. Builder is cleared only on success.
+ * */
+String* string_builder_finish(StringBuilder* sb) {
+    ERR_RETURN_VALUE_IF_FAIL(sb, NULL, ERR_INVALID_ARGUMENTS);
+
+    String* str = str_create_with_allocator(NULL, sb->allocator);
+    if(!str) {
+        return NULL;
+    }
+    if(!string_builder_append_to(sb, str)) {
+        str_destroy(str);
+        return NULL;
+    }
+
+    string_builder_clear(sb);
+    return str;
+}
@@ -0,0 +1,430 @@
+/**
+ * @file StringPool.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief String interning pool, and it's sharded concurrent variant.
+ * */
+
+#include <Anvie/Containers/StringPool.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+#include <string.h>
+
+/* round value up to a multiple of a power of two */
+#define ALIGN_UP(value, align) (((value) + (align) - 1) & ~((Size)(align) - 1))
+
+/* number of symbols in given segment */
+#define SEGMENT_SIZE(s) ((Size)STRING_POOL_FIRST_SEGMENT_SIZE << (s))
+
+/* hash callback of index, same hash as used for lookups */
+static Uint64 key_hash(StringPoolKey* key, void* udata) {
+    UNUSED(udata);
+    return hash_bytes(key->data, key->length);
+}
+
+/* compare callback of index */
+static Int32 key_compare(StringPoolKey* a, StringPoolKey* b, void* udata) {
+    UNUSED(udata);
+    if(a->length != b->length) {
+        return a->length < b->length ? -1 : 1;
+    }
+    return memcmp(a->data, b->data, a->length);
+}
+
+/* segment and position in segment of symbol with given index, first symbol has index 0 */
+static FORCE_INLINE Size segment_of(Size index, Size* offset) {
+    Size s  = 63 - (Size)__builtin_clzll(index / STRING_POOL_FIRST_SEGMENT_SIZE + 1);
+    *offset = index - STRING_POOL_FIRST_SEGMENT_SIZE * (((Size)1 << s) - 1);
+    return s;
+}
+
+/* string of symbol, without checking if symbol was given */
+static FORCE_INLINE ZString symbol_string(StringPool* pool, Symbol sym) {
+    Size     offset  = 0;
+    Size     s       = segment_of((Size)sym - 1, &offset);
+    ZString* segment = pool->segments[s];
+    return segment ? segment[offset] : NULL;
+}
+
+/* symbol of given bytes, SYMBOL_NONE when not interned */
+static Symbol find_hashed(StringPool* pool, const Char* data, Size length, Uint64 hash) {
+    StringPoolKey key  = { .data = data, .length = length };
+    DenseMapItem* item = dense_map_search_with_hash(pool->index, &key, hash, NULL);
+    if(!item) {
+        return SYMBOL_NONE;
+    }
+
+    Uint64 sym = 0;
+    memcpy(&sym, dense_map_slot_data(pool->index, item), sizeof(sym));
+    return (Symbol)sym;
+}
+
+/**
+ * Create a new string pool.
+ *
+ * @param allocator Allocator for symbol table and index. Bytes of strings
+ * are kept in an @c Arena of pool. NULL means system allocator.
+ * @return StringPool object on success, NULL otherwise.
+ * */
+StringPool* string_pool_create(Allocator* allocator) {
+    StringPool* pool = allocator_allocate_zeroed(allocator, sizeof(StringPool));
+    ERR_RETURN_VALUE_IF_FAIL(pool, NULL, ERR_OUT_OF_MEMORY);
+
+    pool->allocator = allocator;
+    pool->max_count = (Symbol)-1;
+
+    // keys are stored inline and point into arena, so index makes no copies at all
+    pool->index = dense_map_create_inline((HashCallback)(void*)key_hash, sizeof(StringPoolKey), NULL, NULL,
+                                          (CompareElementCallback)(void*)key_compare, sizeof(Uint64), NULL, NULL,
+                                          0, 0, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, allocator);
+    pool->bytes = arena_create(ARENA_DEFAULT_CHUNK_SIZE);
+    if(!pool->index || !pool->bytes) {
+        string_pool_destroy(pool);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    return pool;
+}
+
+/**
+ * Destroy string pool, along with bytes of all strings in it.
+ * Strings returned by @c string_pool_lookup are invalid after this.
+ * @param pool
+ * */
+void string_pool_destroy(StringPool* pool) {
+    ERR_RETURN_IF_FAIL(pool, ERR_INVALID_ARGUMENTS);
+
+    for(Size s = 0; s < STRING_POOL_SEGMENT_COUNT; s++) {
+        if(pool->segments[s]) {
+            allocator_free(pool->allocator, pool->segments[s], SEGMENT_SIZE(s) * sizeof(ZString));
+        }
+    }
+    if(pool->index) {
+        dense_map_destroy(pool->index, NULL);
+    }
+    if(pool->bytes) {
+        arena_destroy(pool->bytes);
+    }
+
+    allocator_free(pool->allocator, pool, sizeof(StringPool));
+}
+
+/**
+ * Make sure that index of pool can hold given number of strings without
+ * growing.
+ * @param pool
+ * @param count Number of strings pool is expected to hold.
+ * */
+void string_pool_reserve(StringPool* pool, Size count) {
+    ERR_RETURN_IF_FAIL(pool, ERR_INVALID_ARGUMENTS);
+    dense_map_reserve(pool->index, count, NULL);
+}
+
+/**
+ * Intern given null terminated string.
+ * @param pool
+ * @param zstr
+ * @return Symbol of string on success, @c SYMBOL_NONE otherwise.
+ * */
+Symbol string_pool_intern(StringPool* pool, ZString zstr) {
+    ERR_RETURN_VALUE_IF_FAIL(zstr, SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+    return string_pool_internn(pool, zstr, strlen(zstr));
+}
+
+/**
+ * Intern first @p length bytes at @p data. Bytes may contain null
+ * characters, and need not be null terminated.
+ * @param pool
+ * @param data
+ * @param length
+ * @return Symbol of string on success, @c SYMBOL_NONE otherwise.
+ * */
+Symbol string_pool_internn(StringPool* pool, const Char* data, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(data || !length, SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+    return string_pool_intern_with_hash(pool, data, length, hash_bytes(data, length));
+}
+
+/**
+ * Intern contents of given @c String.
+ * @param pool
+ * @param str
+ * @return Symbol of string on success, @c SYMBOL_NONE otherwise.
+ * */
+Symbol string_pool_intern_str(StringPool* pool, String* str) {
+    ERR_RETURN_VALUE_IF_FAIL(str, SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+    return string_pool_internn(pool, str->data, str->length);
+}
+
+/**
+ * Intern first @p length bytes at @p data, using already computed hash.
+ * @param pool
+ * @param data
+ * @param length
+ * @param hash Must be value of @c hash_bytes for same bytes.
+ * @return Symbol of string on success, @c SYMBOL_NONE otherwise.
+ * */
+Symbol string_pool_intern_with_hash(StringPool* pool, const Char* data, Size length, Uint64 hash) {
+    ERR_RETURN_VALUE_IF_FAIL(pool && (data || !length) && length < (Uint32)-1, SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+
+    Symbol sym = find_hashed(pool, data, length, hash);
+    if(sym != SYMBOL_NONE) {
+        return sym;
+    }
+    ERR_RETURN_VALUE_IF_FAIL(pool->count < pool->max_count, SYMBOL_NONE, ERR_OPERATION_FAILED);
+
+    Size offset = 0;
+    Size s      = segment_of(pool->count, &offset);
+    if(!pool->segments[s]) {
+        pool->segments[s] = allocator_allocate_zeroed(pool->allocator, SEGMENT_SIZE(s) * sizeof(ZString));
+        ERR_RETURN_VALUE_IF_FAIL(pool->segments[s], SYMBOL_NONE, ERR_OUT_OF_MEMORY);
+    }
+
+    // length, then bytes, then a null terminator so strings can be used as ZString
+    Uint8* block = arena_allocate_aligned(pool->bytes, sizeof(Uint32) + length + 1, sizeof(Uint32));
+    ERR_RETURN_VALUE_IF_FAIL(block, SYMBOL_NONE, ERR_OUT_OF_MEMORY);
+
+    Uint32 length32 = (Uint32)length;
+    Char*  copy     = (Char*)(block + sizeof(Uint32));
+    memcpy(block, &length32, sizeof(Uint32));
+    if(length) {
+        memcpy(copy, data, length);
+    }
+    copy[length] = 0;
+
+    sym = (Symbol)(pool->count + 1);
+    StringPoolKey key = { .data = copy, .length = length };
+    ERR_RETURN_VALUE_IF_FAIL(dense_map_insert_with_hash(pool->index, &key, (void*)(Uint64)sym, hash, NULL),
+                             SYMBOL_NONE, ERR_OPERATION_FAILED);
+
+    pool->segments[s][offset] = copy;
+    pool->count++;
+    return sym;
+}
+
+/**
+ * Find symbol of given null terminated string without interning it.
+ * @param pool
+ * @param zstr
+ * @return Symbol of string if interned, @c SYMBOL_NONE otherwise.
+ * */
+Symbol string_pool_find(StringPool* pool, ZString zstr) {
+    ERR_RETURN_VALUE_IF_FAIL(zstr, SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+    return string_pool_findn(pool, zstr, strlen(zstr));
+}
+
+/**
+ * Find symbol of first @p length bytes at @p data without interning them.
+ * @param pool
+ * @param data
+ * @param length
+ * @return Symbol of string if interned, @c SYMBOL_NONE otherwise.
+ * */
+Symbol string_pool_findn(StringPool* pool, const Char* data, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(pool && (data || !length), SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+    return find_hashed(pool, data, length, hash_bytes(data, length));
+}
+
+/**
+ * Get string of given symbol in constant time.
+ * @param pool
+ * @param sym
+ * @return Null terminated string, valid until pool is destroyed, or NULL
+ * if symbol was not given by this pool.
+ * */
+ZString string_pool_lookup(StringPool* pool, Symbol sym) {
+    ERR_RETURN_VALUE_IF_FAIL(pool && sym != SYMBOL_NONE && sym <= pool->count, NULL, ERR_INVALID_ARGUMENTS);
+    return symbol_string(pool, sym);
+}
+
+/**
+ * Get length of string of given symbol in constant time.
+ * @param pool
+ * @param sym
+ * @return Number of bytes in string, 0 if symbol was not given by this pool.
+ * */
+Size string_pool_length(StringPool* pool, Symbol sym) {
+    ZString str = string_pool_lookup(pool, sym);
+    if(!str) {
+        return 0;
+    }
+
+    Uint32 length = 0;
+    memcpy(&length, str - sizeof(Uint32), sizeof(Uint32));
+    return length;
+}
+
+/* shard holding string with given hash */
+static FORCE_INLINE Size shard_index(ConcurrentStringPool* pool, Uint64 hash) {
+    return (hash_mix64(hash) >> (pool->shard_shift & 63)) & (pool->shard_count - 1);
+}
+
+/**
+ * Create a new concurrent string pool.
+ *
+ * @param shard_count Number of shards, rounded up to a power of two.
+ * 0 means @c CONCURRENT_MAP_DEFAULT_SHARD_COUNT. Each shard can give
+ * upto 2^32 / @p shard_count symbols.
+ * @param allocator Thread safe allocator to use. NULL means system allocator.
+ * @return ConcurrentStringPool object on success, NULL otherwise.
+ * */
+ConcurrentStringPool* concurrent_string_pool_create(Size shard_count, Allocator* allocator) {
+    shard_count = shard_count ? NEXT_POW2(shard_count) : CONCURRENT_MAP_DEFAULT_SHARD_COUNT;
+    ERR_RETURN_VALUE_IF_FAIL(shard_count <= (1u << 16), NULL, ERR_INVALID_ARGUMENTS);
+
+    ConcurrentStringPool* pool = allocator_allocate_zeroed(allocator, sizeof(ConcurrentStringPool));
+    ERR_RETURN_VALUE_IF_FAIL(pool, NULL, ERR_OUT_OF_MEMORY);
+
+    // allocator may not align to cache lines, so over allocate and align by hand
+    pool->shard_memory_size = shard_count * sizeof(ConcurrentStringPoolShard) + CONCURRENT_MAP_CACHE_LINE_SIZE;
+    pool->shard_memory      = allocator_allocate_zeroed(allocator, pool->shard_memory_size);
+    if(!pool->shard_memory) {
+        allocator_free(allocator, pool, sizeof(ConcurrentStringPool));
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    pool->shards      = (ConcurrentStringPoolShard*)ALIGN_UP((Size)pool->shard_memory, CONCURRENT_MAP_CACHE_LINE_SIZE);
+    pool->shard_count = shard_count;
+    pool->shard_bits  = (Uint32)__builtin_ctzll(shard_count);
+    pool->shard_shift = 64 - pool->shard_bits;
+    pool->allocator   = allocator;
+
+    for(Size s = 0; s < shard_count; s++) {
+        ConcurrentStringPoolShard* shard = pool->shards + s;
+        shard->pool = string_pool_create(allocator);
+        if(!shard->pool || pthread_mutex_init(&shard->lock, NULL) != 0) {
+            if(shard->pool) {
+                string_pool_destroy(shard->pool);
+            }
+            pool->shard_count = s;
+            concurrent_string_pool_destroy(pool);
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_OBJECT));
+            return NULL;
+        }
+
+        // symbol of shard is shifted left by shard bits, so it must fit in what remains
+        shard->pool->max_count = (Symbol)-1 >> pool->shard_bits;
+    }
+
+    return pool;
+}
+
+/**
+ * Destroy concurrent string pool. No other thread may be using it.
+ * @param pool
+ * */
+void concurrent_string_pool_destroy(ConcurrentStringPool* pool) {
+    ERR_RETURN_IF_FAIL(pool, ERR_INVALID_ARGUMENTS);
+
+    for(Size s = 0; s < pool->shard_count; s++) {
+        string_pool_destroy(pool->shards[s].pool);
+        pthread_mutex_destroy(&pool->shards[s].lock);
+    }
+
+    allocator_free(pool->allocator, pool->shard_memory, pool->shard_memory_size);
+    allocator_free(pool->allocator, pool, sizeof(ConcurrentStringPool));
+}
+
+/**
+ * Intern given null terminated string.
+ * @param pool
+ * @param zstr
+ * @return Symbol of string on success, @c SYMBOL_NONE otherwise.
+ * */
+Symbol concurrent_string_pool_intern(ConcurrentStringPool* pool, ZString zstr) {
+    ERR_RETURN_VALUE_IF_FAIL(zstr, SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+    return concurrent_string_pool_internn(pool, zstr, strlen(zstr));
+}
+
+/**
+ * Intern first @p length bytes at @p data.
+ * @param pool
+ * @param data
+ * @param length
+ * @return Symbol of string on success, @c SYMBOL_NONE otherwise.
+ * */
+Symbol concurrent_string_pool_internn(ConcurrentStringPool* pool, const Char* data, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(pool && (data || !length), SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+
+    Uint64                     hash  = hash_bytes(data, length);
+    Size                       index = shard_index(pool, hash);
+    ConcurrentStringPoolShard* shard = pool->shards + index;
+
+    pthread_mutex_lock(&shard->lock);
+    Symbol sym = string_pool_intern_with_hash(shard->pool, data, length, hash);
+    pthread_mutex_unlock(&shard->lock);
+
+    return sym == SYMBOL_NONE ? SYMBOL_NONE : (Symbol)((sym << pool->shard_bits) | index);
+}
+
+/**
+ * Find symbol of first @p length bytes at @p data without interning them.
+ * @param pool
+ * @param data
+ * @param length
+ * @return Symbol of string if interned, @c SYMBOL_NONE otherwise.
+ * */
+Symbol concurrent_string_pool_findn(ConcurrentStringPool* pool, const Char* data, Size length) {
+    ERR_RETURN_VALUE_IF_FAIL(pool && (data || !length), SYMBOL_NONE, ERR_INVALID_ARGUMENTS);
+
+    Uint64                     hash  = hash_bytes(data, length);
+    Size                       index = shard_index(pool, hash);
+    ConcurrentStringPoolShard* shard = pool->shards + index;
+
+    pthread_mutex_lock(&shard->lock);
+    Symbol sym = find_hashed(shard->pool, data, length, hash);
+    pthread_mutex_unlock(&shard->lock);
+
+    return sym == SYMBOL_NONE ? SYMBOL_NONE : (Symbol)((sym << pool->shard_bits) | index);
+}
+
+/**
+ * Get string of given symbol in constant time, without taking any lock.
+ * @param pool
+ * @param sym Symbol given by this pool.
+ * @return Null terminated string, valid until pool is destroyed.
+ * */
+ZString concurrent_string_pool_lookup(ConcurrentStringPool* pool, Symbol sym) {
+    ERR_RETURN_VALUE_IF_FAIL(pool, NULL, ERR_INVALID_ARGUMENTS);
+
+    Symbol local = sym >> pool->shard_bits;
+    ERR_RETURN_VALUE_IF_FAIL(local != SYMBOL_NONE, NULL, ERR_INVALID_ARGUMENTS);
+
+    // count of shard may be changing right now, segments and given strings never do
+    return symbol_string(pool->shards[sym & (pool->shard_count - 1)].pool, local);
+}
+
+/**
+ * Get number of strings in pool. Value may be stale as soon as it's
+ * returned if other threads are interning.
+ * @param pool
+ * @return Number of strings.
+ * */
+Size concurrent_string_pool_count(ConcurrentStringPool* pool) {
+    ERR_RETURN_VALUE_IF_FAIL(pool, 0, ERR_INVALID_ARGUMENTS);
+
+    Size count = 0;
+    for(Size s = 0; s < pool->shard_count; s++) {
+        pthread_mutex_lock(&pool->shards[s].lock);
+        count += pool->shards[s].pool->count;
+        pthread_mutex_unlock(&pool->shards[s].lock);
+    }
+    return count;
+}
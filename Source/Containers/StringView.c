@@ -0,0 +1,418 @@
+/**
+ * @file StringView.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Comparison, hashing, searching and slicing of @c StringView.
+ * Searches of @c String are done through views of it, so all search
+ * kernels live here.
+ * */
+
+#include <Anvie/Containers/StringView.h>
+#include <Anvie/Error.h>
+#include <Anvie/Simd/Dispatch.h>
+
+/* whitespace removed by trim functions : space, \t, \n, \v, \f and \r */
+#define IS_SPACE(c) ((c) == ' ' || (Uint8)((Uint8)(c) - '\t') < 5)
+
+/* kernels are in Kernels/StringView.c, built once per SIMD level */
+SIMD_KERNEL_DECLARE(Size, strview_kernel_find_byte, (const Char* data, Size length, Char c));
+SIMD_KERNEL_DECLARE(Size, strview_kernel_find_any, (const Char* data, Size length, const Char* set, Size set_size));
+SIMD_KERNEL_DECLARE(Size, strview_kernel_find, (const Char* data, Size length, const Char* needle, Size n));
+SIMD_KERNEL_DECLARE(Size, strview_kernel_count_byte, (const Char* data, Size length, Char c));
+SIMD_KERNEL_DECLARE(Bool, strview_kernel_validate_utf8, (const Uint8* data, Size length));
+SIMD_KERNEL_DECLARE(Bool, strview_kernel_is_ascii, (const Char* data, Size length));
+SIMD_KERNEL_DECLARE(Size, strview_kernel_utf8_length, (const Char* data, Size length));
+
+/**
+ * Compare two views lexicographically, byte by byte as unsigned values.
+ * A view that is a prefix of other one is smaller.
+ *
+ * @param sv1
+ * @param sv2
+ * @return Negative, zero or positive if @p sv1 is smaller than, equal to
+ * or greater than @p sv2.
+ * */
+Int32 strview_cmp(StringView sv1, StringView sv2) {
+    Size  n   = MIN(sv1.length, sv2.length);
+    Int32 cmp = n ? memcmp(sv1.data, sv2.data, n) : 0;
+    if(cmp) {
+        return cmp;
+    }
+    return (sv1.length > sv2.length) - (sv1.length < sv2.length);
+}
+
+/**
+ * Compare a view and a null terminated string, same as @c strview_cmp.
+ *
+ * @param sv
+ * @param zstr Null terminated string.
+ * @return Negative, zero or positive if @p sv is smaller than, equal to
+ * or greater than @p zstr.
+ * */
+Int32 strview_cmp_zstr(StringView sv, ZString zstr) {
+    ERR_RETURN_VALUE_IF_FAIL(zstr, 1, ERR_INVALID_ARGUMENTS);
+    return strview_cmp(sv, strview_from_zstr(zstr));
+}
+
+/**
+ * Check whether two views refer to same characters. Views of different
+ * lengths are rejected without reading any byte.
+ *
+ * @param sv1
+ * @param sv2
+ * @return True if equal, False otherwise.
+ * */
+Bool strview_equal(StringView sv1, StringView sv2) {
+    if(sv1.length != sv2.length) {
+        return False;
+    }
+    return sv1.data == sv2.data || !sv1.length || !memcmp(sv1.data, sv2.data, sv1.length);
+}
+
+/**
+ * Check whether view begins with given prefix.
+ *
+ * @param sv
+ * @param prefix
+ * @return True if @p sv begins with @p prefix. Every view begins with an
+ * empty prefix.
+ * */
+Bool strview_starts_with(StringView sv, StringView prefix) {
+    return prefix.length <= sv.length && strview_equal(strview_left(sv, prefix.length), prefix);
+}
+
+/**
+ * Check whether view ends with given suffix.
+ *
+ * @param sv
+ * @param suffix
+ * @return True if @p sv ends with @p suffix. Every view ends with an
+ * empty suffix.
+ * */
+Bool strview_ends_with(StringView sv, StringView suffix) {
+    return suffix.length <= sv.length && strview_equal(strview_right(sv, suffix.length), suffix);
+}
+
+/**
+ * Hash bytes of view with given seed. Same bytes hash same as a
+ * @c String holding them, through @c str_hash_seeded.
+ *
+ * @param sv
+ * @param seed Seed for hash.
+ * @return Hash of bytes of view.
+ * */
+Uint64 strview_hash_seeded(StringView sv, Uint64 seed) {
+    return hash_bytes_seeded(sv.data, sv.length, seed);
+}
+
+/**
+ * Hash a view with default hash seed. Matches @c HashCallback for
+ * containers that pass keys by pointer, as maps with inline keys do.
+ *
+ * @param sv Pointer to view to hash.
+ * @param udata Unused.
+ * @return Hash of bytes of view.
+ * */
+Uint64 hash_strview(const StringView* sv, void* udata) {
+    UNUSED(udata);
+    ERR_RETURN_VALUE_IF_FAIL(sv, 0, ERR_INVALID_ARGUMENTS);
+    return hash_bytes_seeded(sv->data, sv->length, hash_get_default_seed());
+}
+
+/**
+ * Compare two views, matches @c CompareElementCallback for containers
+ * that pass elements by pointer. Orders same as @c strview_cmp, so can
+ * also be used to sort a vector of views.
+ *
+ * @param sv1 Pointer to first view.
+ * @param sv2 Pointer to second view.
+ * @param udata Unused.
+ * @return 0 if views are equal, non zero otherwise.
+ * */
+Int32 compare_strview(const StringView* sv1, const StringView* sv2, void* udata) {
+    UNUSED(udata);
+    ERR_RETURN_VALUE_IF_FAIL(sv1 && sv2, 1, ERR_INVALID_ARGUMENTS);
+    return strview_cmp(*sv1, *sv2);
+}
+
+/**
+ * Find first occurence of given character.
+ *
+ * @param sv View to search in.
+ * @param c Character to find.
+ * @param from Position to start search from.
+ * @return Position of character, or @c SIZE_MAX if not found.
+ * */
+Size strview_find_char(StringView sv, Char c, Size from) {
+    if(from >= sv.length) {
+        return SIZE_MAX;
+    }
+
+    Size pos = SIMD_DISPATCH(strview_kernel_find_byte)(sv.data + from, sv.length - from, c);
+    return pos == SIZE_MAX ? SIZE_MAX : from + pos;
+}
+
+/**
+ * Find last occurence of given character.
+ *
+ * @param sv View to search in.
+ * @param c Character to find.
+ * @return Position of character, or @c SIZE_MAX if not found.
+ * */
+Size strview_rfind_char(StringView sv, Char c) {
+    for(Size i = sv.length; i; i--) {
+        if(sv.data[i - 1] == c) {
+            return i - 1;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * Find first character that is any of characters in given set.
+ * Small sets are matched a whole vector register at a time, larger
+ * ones through a table with one bit per character.
+ *
+ * @param sv View to search in.
+ * @param set Null terminated set of characters to find.
+ * @param from Position to start search from.
+ * @return Position of first matching character, or @c SIZE_MAX if not found.
+ * */
+Size strview_find_any(StringView sv, ZString set, Size from) {
+    ERR_RETURN_VALUE_IF_FAIL(set, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    if(from >= sv.length) {
+        return SIZE_MAX;
+    }
+
+    Size set_size = strlen(set);
+    if(set_size == 1) {
+        return strview_find_char(sv, set[0], from);
+    }
+
+    Size pos = SIMD_DISPATCH(strview_kernel_find_any)(sv.data + from, sv.length - from, set, set_size);
+    return pos == SIZE_MAX ? SIZE_MAX : from + pos;
+}
+
+/**
+ * Find first occurence of @p needle.
+ *
+ * Candidates are found by comparing first and last bytes of needle against
+ * a whole vector register of positions at once, and only positions where
+ * both match are compared fully. This skips over text quickly unless both
+ * of those bytes are very common in it.
+ *
+ * @param sv View to search in.
+ * @param needle Bytes to find.
+ * @param from Position to start search from.
+ * @return Position of first occurence, or @c SIZE_MAX if not found.
+ * An empty needle is found at @p from.
+ * */
+Size strview_find(StringView sv, StringView needle, Size from) {
+    Size n = needle.length;
+    ERR_RETURN_VALUE_IF_FAIL(needle.data || !n, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+    if(from > sv.length || n > sv.length - from) {
+        return SIZE_MAX;
+    }
+    if(n == 0) {
+        return from;
+    }
+    if(n == 1) {
+        return strview_find_char(sv, needle.data[0], from);
+    }
+
+    Size pos = SIMD_DISPATCH(strview_kernel_find)(sv.data + from, sv.length - from, needle.data, n);
+    return pos == SIZE_MAX ? SIZE_MAX : from + pos;
+}
+
+/**
+ * Count occurences of given character.
+ *
+ * @param sv View to count in.
+ * @param c Character to count.
+ * @return Number of occurences.
+ * */
+Size strview_count_char(StringView sv, Char c) {
+    return SIMD_DISPATCH(strview_kernel_count_byte)(sv.data, sv.length, c);
+}
+
+/**
+ * Get view of part of a view. Out of range positions and lengths are
+ * clamped to end of view, so this never fails.
+ *
+ * @param sv
+ * @param pos First character of part.
+ * @param length Maximum number of characters in part, @c SIZE_MAX for upto end.
+ * @return View of characters [pos, pos + length) of @p sv.
+ * */
+StringView strview_sub(StringView sv, Size pos, Size length) {
+    pos = MIN(pos, sv.length);
+    return strview(sv.data + pos, MIN(length, sv.length - pos));
+}
+
+/**
+ * Get view of first @p n characters, or whole view if it is shorter.
+ * */
+StringView strview_left(StringView sv, Size n) {
+    return strview(sv.data, MIN(n, sv.length));
+}
+
+/**
+ * Get view of last @p n characters, or whole view if it is shorter.
+ * */
+StringView strview_right(StringView sv, Size n) {
+    n = MIN(n, sv.length);
+    return strview(sv.data + sv.length - n, n);
+}
+
+/**
+ * Remove ASCII whitespace from beginning of view.
+ * */
+StringView strview_trim_left(StringView sv) {
+    Size i = 0;
+    while(i < sv.length && IS_SPACE(sv.data[i])) {
+        i++;
+    }
+    return strview(sv.data + i, sv.length - i);
+}
+
+/**
+ * Remove ASCII whitespace from end of view.
+ * */
+StringView strview_trim_right(StringView sv) {
+    Size n = sv.length;
+    while(n && IS_SPACE(sv.data[n - 1])) {
+        n--;
+    }
+    return strview(sv.data, n);
+}
+
+/**
+ * Remove ASCII whitespace from both ends of view.
+ * */
+StringView strview_trim(StringView sv) {
+    return strview_trim_right(strview_trim_left(sv));
+}
+
+/**
+ * Split view at each occurence of given delimiter, storing views to each
+ * field in given array. A view with @c k delimiters has @c k+1 fields,
+ * and fields may be empty, eg: "a,,b" splits into "a", "" and "b", and an
+ * empty view into one empty field.
+ *
+ * @param sv View to split.
+ * @param delim Delimiter between fields.
+ * @param fields Array of atleast @p max_fields views to fill, can be NULL if @p max_fields is 0.
+ * @param max_fields Maximum number of views to store.
+ * @return Total number of fields. When this is greater than @p max_fields,
+ * only first @p max_fields fields are stored.
+ * */
+Size strview_split(StringView sv, Char delim, StringView* fields, Size max_fields) {
+    ERR_RETURN_VALUE_IF_FAIL(fields || !max_fields, 0, ERR_INVALID_ARGUMENTS);
+
+    StringSplitIterator iter  = strview_split_iter(sv, delim);
+    StringView          field = {0};
+    Size                count = 0;
+
+    while(strview_split_next(&iter, &field)) {
+        if(count < max_fields) {
+            fields[count] = field;
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Begin splitting given view at each occurence of given delimiter.
+ * Fields are returned one by one by @c strview_split_next, same as
+ * @c strview_split would store them, so no array of fields is needed.
+ *
+ * @param sv View to split.
+ * @param delim Delimiter between fields.
+ * @return Iterator over fields.
+ * */
+StringSplitIterator strview_split_iter(StringView sv, Char delim) {
+    StringSplitIterator iter = {0};
+
+    /* an empty view still has one empty field, so data must not be NULL */
+    iter.data   = sv.data ? sv.data : "";
+    iter.length = sv.length;
+    iter.delim  = delim;
+    return iter;
+}
+
+/**
+ * Get next field of a split.
+ *
+ * @param iter Iterator returned by @c strview_split_iter.
+ * @param field View to store next field in.
+ * @return True if a field was stored, False when there are no more fields.
+ * */
+Bool strview_split_next(StringSplitIterator* iter, StringView* field) {
+    ERR_RETURN_VALUE_IF_FAIL(iter && field, False, ERR_INVALID_ARGUMENTS);
+    if(!iter->data || iter->pos > iter->length) {
+        return False;
+    }
+
+    Size remaining = iter->length - iter->pos;
+    Size end       = SIMD_DISPATCH(strview_kernel_find_byte)(iter->data + iter->pos, remaining, iter->delim);
+    if(end == SIZE_MAX) {
+        end = remaining;
+    }
+
+    field->data   = iter->data + iter->pos;
+    field->length = end;
+    iter->pos    += end + 1;
+    return True;
+}
+
+
+/**
+ * Check whether a view is valid UTF-8. Overlong encodings, surrogates
+ * (U+D800 to U+DFFF), code points above U+10FFFF and truncated characters
+ * are all invalid. With SIMD enabled a whole register is validated at once
+ * using three 16 entry table lookups, and runs of ASCII are skipped.
+ *
+ * @param sv View to validate.
+ * @return True if valid, False otherwise.
+ * */
+Bool strview_validate_utf8(StringView sv) {
+    return SIMD_DISPATCH(strview_kernel_validate_utf8)((const Uint8*)sv.data, sv.length);
+}
+
+/**
+ * Check whether all characters of a view are ASCII.
+ *
+ * @param sv View to check.
+ * @return True if no byte has it's highest bit set, False otherwise.
+ * */
+Bool strview_is_ascii(StringView sv) {
+    return SIMD_DISPATCH(strview_kernel_is_ascii)(sv.data, sv.length);
+}
+
+/**
+ * Count code points in a view of UTF-8 text, by counting all bytes that
+ * are not continuation bytes. View is not validated, for invalid text
+ * result is only an estimate.
+ *
+ * @param sv View of UTF-8 text.
+ * @return Number of code points.
+ * */
+Size strview_utf8_length(StringView sv) {
+    return SIMD_DISPATCH(strview_kernel_utf8_length)(sv.data, sv.length);
+}
@@ -22,6 +22,7 @@
 
 #include <Anvie/Containers/Tree.h>
 #include <Anvie/Error.h>
+#include <Anvie/ThreadPool.h>
 #include <string.h>
 
 // private functions
@@ -29,6 +30,7 @@ static void tree_node_increment_height(TreeNode* node); /* used as a recursive o
 static void tree_node_increment_size(TreeNode* node); /* used as a recursive operation */
 static void tree_node_decrement_height(TreeNode* node); /* used as a recursive operation */
 static void tree_node_decrement_size(TreeNode* node); /* used as a recursive operation */
+static void tree_node_recompute(TreeNode* node);
 
 /**
  * Create a copy of given node object.
@@ -82,6 +84,8 @@ void tree_node_create_copy(void* dst, void* src, void* udata) {
 
 /**
  * Destroy the copy of given tree node object.
+ * Subtree is destroyed bottom up without recursion, so deep trees
+ * don't overflow the stack.
  * @param copy Pointer to copy of TreeNode created
  * @param udata User data passed to callback functions.
  * This data will be passed recursively to copy destructor
@@ -90,21 +94,31 @@ void tree_node_create_copy(void* dst, void* src, void* udata) {
 void tree_node_destroy_copy(void* copy, void* udata) {
     ERR_RETURN_IF_FAIL(copy, ERR_INVALID_ARGUMENTS);
 
-    TreeNode* node = TO_TREE_NODE(copy);
-    Tree* tree = TREE_PARENT(node);
-
-    // if element was created using a create_copy() or it's size is greater than 8
-    // then free it
-    if(tree->destroy_copy || tree->element_size > 8) {
-        tree->destroy_copy(node->data, udata);
-        FREE(node->data);
-    }
-    node->data = NULL;
+    TreeNode* root = TO_TREE_NODE(copy);
+    Tree* tree = TREE_PARENT(root);
+
+    // children are visited before their parent, so when a node is visited
+    // all it's children are already destroyed and only their vector remains
+    TreeIterator iter = tree_node_iter(root, TREE_TRAVERSAL_POSTORDER);
+    TreeNode* node;
+    while((node = tree_iter_next(&iter))) {
+        // if element was created using a create_copy() or it's size is greater than 8
+        // then free it
+        if(tree->destroy_copy || tree->element_size > 8) {
+            if(tree->destroy_copy) {
+                tree->destroy_copy(node->data, udata);
+            }
+            FREE(node->data);
+        }
+        node->data = NULL;
 
-    // TODO: make sure this will destroy the tree recursively!
-    if(node->children) {
-        tree_node_vector_destroy(node->children, udata);
+        if(node->children) {
+            node->children->length = 0; /* already destroyed */
+            tree_node_vector_destroy(node->children, udata);
+            node->children = NULL;
+        }
     }
+    tree_iter_destroy(&iter);
 }
 
 /**
@@ -189,7 +203,7 @@ TreeNode* tree_node_peek(TreeNode* node, Size idx) {
     TreeNode* tree_node_push_##place(TreeNode* node, void* data, void* udata) { \
         ERR_RETURN_VALUE_IF_FAIL(node, NULL, ERR_INVALID_ARGUMENTS);    \
                                                                         \
-        TreeNode node_child;                                            \
+        TreeNode node_child = {0};                                      \
         node_child.node_parent = node;                                  \
         node_child.tree_parent = TREE_PARENT(node);                     \
         node_child.data        = data;                                  \
@@ -228,7 +242,7 @@ TreeNode* tree_node_insert(TreeNode* node, void* data, Size index, void* udata)
     ERR_RETURN_VALUE_IF_FAIL(node, NULL, ERR_INVALID_ARGUMENTS);
 
     // create temporary child node object
-    TreeNode node_child;
+    TreeNode node_child = {0};
     node_child.node_parent = node; /* provided node is now an immediate parent of new node */
     node_child.tree_parent = TREE_PARENT(node); /* get tree parent from given node */
     node_child.data        = data; /* set data of this new node */
@@ -318,7 +332,7 @@ TreeNode* tree_node_push_front_fast(TreeNode* node, void* data, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(node, NULL, ERR_INVALID_ARGUMENTS);
 
     // create temporary child node object
-    TreeNode node_child;
+    TreeNode node_child = {0};
     node_child.node_parent = node;
     node_child.tree_parent = TREE_PARENT(node);
     node_child.data        = data;
@@ -351,7 +365,7 @@ TreeNode* tree_node_insert_fast(TreeNode* node, void* data, Size index, void* ud
     ERR_RETURN_VALUE_IF_FAIL(node, NULL, ERR_INVALID_ARGUMENTS);
 
     // create temporary child node object
-    TreeNode node_child;
+    TreeNode node_child = {0};
     node_child.node_parent = node;
     node_child.tree_parent = TREE_PARENT(node);
     node_child.data        = data;
@@ -387,7 +401,7 @@ TreeNode* tree_node_remove_fast(TreeNode* node, Size index) {
 
     tree_node_decrement_size(node);
     if(!node->children->length) {
-        tree_node_increment_height(node);
+        tree_node_decrement_height(node);
     }
 
     return node_child;
@@ -411,17 +425,315 @@ void tree_node_delete_fast(TreeNode* node, Size index, void* udata) {
 
     tree_node_decrement_size(node);
     if(!node->children->length) {
-        tree_node_increment_height(node);
+        tree_node_decrement_height(node);
+    }
+}
+
+/**
+ * Start a batch of mutations. Till matching @c tree_end_bulk, inserting
+ * or removing nodes doesn't walk up to root to update size and height of
+ * every ancestor, making each mutation O(1) instead of O(depth).
+ *
+ * Size and height of nodes are stale during a batch. Batches can be nested,
+ * maintenance resumes when outermost batch ends.
+ *
+ * @param tree
+ * */
+void tree_begin_bulk(Tree* tree) {
+    ERR_RETURN_IF_FAIL(tree, ERR_INVALID_ARGUMENTS);
+    tree->bulk_depth++;
+}
+
+/**
+ * End a batch of mutations started with @c tree_begin_bulk. When outermost
+ * batch ends, size and height of every node are recomputed in a single
+ * bottom up pass over the tree, and parent pointers of nodes moved by
+ * growing children vectors are fixed.
+ *
+ * @param tree
+ * */
+void tree_end_bulk(Tree* tree) {
+    ERR_RETURN_IF_FAIL(tree && tree->bulk_depth, ERR_INVALID_ARGUMENTS);
+    if(!--tree->bulk_depth) {
+        tree_node_recompute(TO_TREE_NODE(tree));
+    }
+}
+
+/******************************** TRAVERSAL *********************************/
+
+/* push children of given node, in reverse so that first child is on top of stack */
+static inline void tree_iter_push_children_reversed(VPtr_Vector* stack, TreeNode* node) {
+    if(!node->children) return;
+    for(Size i = node->children->length; i; i--) {
+        voidptr_vector_push_back(stack, &node->children->data[i - 1], NULL);
+    }
+}
+
+/**
+ * Create an iterator over subtree of given node, including node itself.
+ *
+ * @param node Root of subtree to iterate over.
+ * @param order Order in which nodes are visited.
+ * @return Iterator. Iterating an iterator that failed to be created
+ * returns no nodes.
+ * */
+TreeIterator tree_node_iter(TreeNode* node, TreeTraversalOrder order) {
+    TreeIterator iter = {.order = order};
+    ERR_RETURN_VALUE_IF_FAIL(node, iter, ERR_INVALID_ARGUMENTS);
+
+    iter.nodes = voidptr_vector_create();
+    ERR_RETURN_VALUE_IF_FAIL(iter.nodes, iter, ERR_OUT_OF_MEMORY);
+
+    if(order == TREE_TRAVERSAL_POSTORDER) {
+        iter.next_child = u64_vector_create();
+        if(!iter.next_child) {
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+            voidptr_vector_destroy(iter.nodes, NULL);
+            iter.nodes = NULL;
+            return iter;
+        }
+        u64_vector_push_back(iter.next_child, 0, NULL);
     }
+
+    voidptr_vector_push_back(iter.nodes, node, NULL);
+    return iter;
+}
+
+/**
+ * Create an iterator over all nodes of given tree. Root of tree holds no
+ * data and is not returned.
+ *
+ * @param tree
+ * @param order Order in which nodes are visited.
+ * @return Iterator.
+ * */
+TreeIterator tree_iter(Tree* tree, TreeTraversalOrder order) {
+    TreeIterator iter = tree_node_iter(TO_TREE_NODE(tree), order);
+    iter.skip = TO_TREE_NODE(tree);
+    return iter;
+}
+
+/**
+ * Get next node from iterator.
+ *
+ * @param iter
+ * @return Next node, NULL once all nodes are visited.
+ * */
+TreeNode* tree_iter_next(TreeIterator* iter) {
+    ERR_RETURN_VALUE_IF_FAIL(iter, NULL, ERR_INVALID_ARGUMENTS);
+
+    VPtr_Vector* nodes = iter->nodes;
+    TreeNode*    node  = NULL;
+
+    do {
+        if(!nodes) return NULL;
+
+        switch(iter->order) {
+            case TREE_TRAVERSAL_PREORDER: {
+                if(!nodes->length) return NULL;
+                node = voidptr_vector_pop_back(nodes);
+                tree_iter_push_children_reversed(nodes, node);
+                break;
+            }
+
+            case TREE_TRAVERSAL_POSTORDER: {
+                /* descend into leftmost unvisited child till a node with no unvisited child is on top */
+                while(nodes->length) {
+                    Size top = nodes->length - 1;
+                    node = nodes->data[top];
+                    if(!node->children || iter->next_child->data[top] >= node->children->length) {
+                        break;
+                    }
+                    TreeNode* child = &node->children->data[iter->next_child->data[top]++];
+                    voidptr_vector_push_back(nodes, child, NULL);
+                    u64_vector_push_back(iter->next_child, 0, NULL);
+                }
+                if(!nodes->length) return NULL;
+                voidptr_vector_pop_back(nodes);
+                u64_vector_pop_back(iter->next_child);
+                break;
+            }
+
+            case TREE_TRAVERSAL_LEVEL_ORDER: {
+                if(iter->head == nodes->length) return NULL;
+                node = nodes->data[iter->head++];
+
+                /* drop visited prefix of queue once it's most of the vector */
+                if(iter->head == nodes->length) {
+                    voidptr_vector_clear(nodes, NULL);
+                    iter->head = 0;
+                } else if(iter->head > 1024 && iter->head > nodes->length / 2) {
+                    vector_delete_range((Vector*)nodes, 0, iter->head, NULL);
+                    iter->head = 0;
+                }
+
+                if(node->children) {
+                    for(Size i = 0; i < node->children->length; i++) {
+                        voidptr_vector_push_back(nodes, &node->children->data[i], NULL);
+                    }
+                }
+                break;
+            }
+
+            default:
+                ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_INVALID_ARGUMENTS));
+                return NULL;
+        }
+    } while(node == iter->skip);
+
+    return node;
+}
+
+/**
+ * Free memory held by iterator.
+ *
+ * @param iter
+ * */
+void tree_iter_destroy(TreeIterator* iter) {
+    ERR_RETURN_IF_FAIL(iter, ERR_INVALID_ARGUMENTS);
+
+    if(iter->nodes) voidptr_vector_destroy(iter->nodes, NULL);
+    if(iter->next_child) u64_vector_destroy(iter->next_child, NULL);
+    iter->nodes      = NULL;
+    iter->next_child = NULL;
+}
+
+/* trees smaller than this are visited sequentially */
+#define TREE_PARALLEL_THRESHOLD (1 << 14)
+
+/* number of tasks created per thread, more tasks balance uneven subtrees better */
+#define TREE_PARALLEL_TASKS_PER_THREAD 8
+
+/**
+ * A unit of work in parallel foreach, either a whole subtree
+ * or just a single node whose subtree was too large and got split.
+ * */
+typedef struct TreeParallelTask {
+    TreeNode* node;
+    Bool      subtree;
+} TreeParallelTask;
+
+/* state shared by all tasks of a parallel foreach */
+typedef struct TreeParallelContext {
+    TreeParallelTask*     tasks;
+    TreeNodeVisitCallback visit;
+    void*                 udata;
+} TreeParallelContext;
+
+/* run tasks [begin, end), visiting subtrees in preorder with a stack of this call */
+static void tree_parallel_visit(Size begin, Size end, void* udata) {
+    TreeParallelContext* ctx = udata;
+    VPtr_Vector* stack = voidptr_vector_create();
+    ERR_RETURN_IF_FAIL(stack, ERR_OUT_OF_MEMORY);
+
+    for(Size t = begin; t < end; t++) {
+        TreeParallelTask* task = &ctx->tasks[t];
+        if(!task->subtree) {
+            ctx->visit(task->node, ctx->udata);
+            continue;
+        }
+
+        voidptr_vector_push_back(stack, task->node, NULL);
+        while(stack->length) {
+            TreeNode* node = voidptr_vector_pop_back(stack);
+            ctx->visit(node, ctx->udata);
+            tree_iter_push_children_reversed(stack, node);
+        }
+    }
+
+    voidptr_vector_destroy(stack, NULL);
+}
+
+/**
+ * Call given callback once for every node of tree, except root, using
+ * multiple threads. Order in which nodes are visited is unspecified.
+ *
+ * Tree is split into independent subtrees, using size of each node, so
+ * that every subtree has roughly same number of nodes. Nodes with too
+ * large subtrees are visited on their own and their children are split
+ * further. Subtrees are then visited as tasks of @c thread_pool_default,
+ * which idle workers steal from busy ones, so one large subtree doesn't
+ * hold back others.
+ *
+ * Trees smaller than an internal threshold are visited sequentially, on
+ * calling thread. Callback must be safe to call from multiple threads at
+ * the same time, and must not modify structure of tree.
+ *
+ * @param tree
+ * @param visit Callback called for each node.
+ * @param udata User data passed to callback.
+ * @param nthreads Number of threads tree is split for, 1 visits it on calling
+ * thread. 0 means number of workers of default pool.
+ * */
+void tree_parallel_foreach(Tree* tree, TreeNodeVisitCallback visit, void* udata, Size nthreads) {
+    ERR_RETURN_IF_FAIL(tree && visit, ERR_INVALID_ARGUMENTS);
+
+    if(!nthreads) {
+        ThreadPool* pool = thread_pool_default();
+        nthreads = pool ? thread_pool_get_thread_count(pool) : 1;
+    }
+
+    Size total = tree_size(tree);
+    if(nthreads < 2 || total < TREE_PARALLEL_THRESHOLD) {
+        TreeIterator iter = tree_iter(tree, TREE_TRAVERSAL_PREORDER);
+        TreeNode* node;
+        while((node = tree_iter_next(&iter))) {
+            visit(node, udata);
+        }
+        tree_iter_destroy(&iter);
+        return;
+    }
+
+    /* split tree into subtrees of at most grain nodes */
+    Size grain = MAX(total / (nthreads * TREE_PARALLEL_TASKS_PER_THREAD), 1);
+    Vector* tasks = vector_create(sizeof(TreeParallelTask), NULL, NULL);
+    VPtr_Vector* split = voidptr_vector_create();
+    if(!tasks || !split) {
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        if(tasks) vector_destroy(tasks, NULL);
+        if(split) voidptr_vector_destroy(split, NULL);
+        return;
+    }
+
+    voidptr_vector_push_back(split, TO_TREE_NODE(tree), NULL);
+    while(split->length) {
+        TreeNode* node = voidptr_vector_pop_back(split);
+        if(!node->children) continue;
+
+        for(Size i = 0; i < node->children->length; i++) {
+            TreeNode* child = &node->children->data[i];
+            /* size of a node doesn't count node itself */
+            Bool small = tree_node_size(child) + 1 <= grain;
+            TreeParallelTask task = {.node = child, .subtree = small};
+            vector_push_back(tasks, &task, NULL);
+            if(!small) {
+                voidptr_vector_push_back(split, child, NULL);
+            }
+        }
+    }
+    voidptr_vector_destroy(split, NULL);
+
+    TreeParallelContext ctx = {
+        .tasks = (TreeParallelTask*)tasks->data,
+        .visit = visit,
+        .udata = udata
+    };
+
+    /* calling thread runs tasks too, while it waits */
+    parallel_for(NULL, 0, tasks->length, 1, tree_parallel_visit, &ctx);
+
+    vector_destroy(tasks, NULL);
 }
 
 /************************** PRIVATE FUNCTIONS ***************************/
 
+/* walks up to root, changes are deferred to tree_end_bulk() in bulk mode */
 #define TREE_NODE_INCREMENT_PROP(prop)                                  \
     static void tree_node_increment_##prop(TreeNode* node) {            \
-        if(!node) return;                                               \
-        node->prop++;                                                   \
-        if(node->node_parent) tree_node_increment_##prop(node->node_parent); \
+        if(!node || TREE_PARENT(node)->bulk_depth) return;              \
+        for(; node; node = node->node_parent) {                         \
+            node->prop++;                                               \
+        }                                                               \
     }
 TREE_NODE_INCREMENT_PROP(height)
 TREE_NODE_INCREMENT_PROP(size)
@@ -429,10 +741,34 @@ TREE_NODE_INCREMENT_PROP(size)
 
 #define TREE_NODE_DECREMENT_PROP(prop)                                  \
     static void tree_node_decrement_##prop(TreeNode* node) {            \
-        if(!node) return;                                               \
-        node->prop--;                                                   \
-        if(node->node_parent) tree_node_decrement_##prop(node->node_parent); \
+        if(!node || TREE_PARENT(node)->bulk_depth) return;              \
+        for(; node; node = node->node_parent) {                         \
+            node->prop--;                                               \
+        }                                                               \
     }
 TREE_NODE_DECREMENT_PROP(height)
 TREE_NODE_DECREMENT_PROP(size)
 #undef TREE_NODE_DECREMENT_PROP
+
+/* recompute size and height of every node in subtree, and relink children to their parent */
+static void tree_node_recompute(TreeNode* root) {
+    TreeIterator iter = tree_node_iter(root, TREE_TRAVERSAL_POSTORDER);
+    TreeNode* node;
+    while((node = tree_iter_next(&iter))) {
+        Size size   = 0;
+        Size height = 0;
+        if(node->children) {
+            for(Size i = 0; i < node->children->length; i++) {
+                TreeNode* child = &node->children->data[i];
+                child->node_parent = node;
+                size  += child->size + 1;
+                height = MAX(height, child->height);
+            }
+        }
+
+        node->size   = size;
+        /* tree itself holds no data and isn't counted as a level */
+        node->height = node->tree_parent ? height + 1 : height;
+    }
+    tree_iter_destroy(&iter);
+}
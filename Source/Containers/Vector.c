@@ -23,6 +23,9 @@
 #include <Anvie/Containers/Vector.h>
 #include <Anvie/HelperDefines.h>
 #include <Anvie/Error.h>
+#include <Anvie/Counters.h>
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/ThreadPool.h>
 #include <string.h>
 
 /**
@@ -38,6 +41,21 @@
 #define VECTOR_DEFAULT_RESIZE_FACTOR 1
 #define VECTOR_DEFAULT_FREE_WHEN_POSSIBLE True
 
+/**
+ * Get value of element stored at given address, the same way
+ * @c vector_peek does : integer sized elements are returned by value,
+ * everything else by address.
+ * */
+static FORCE_INLINE void* element_value(const void* p, Size element_size) {
+    switch(element_size) {
+        case 8: { Uint64 v; memcpy(&v, p, 8); return (void*)v; }
+        case 4: { Uint32 v; memcpy(&v, p, 4); return (void*)(Uint64)v; }
+        case 2: { Uint16 v; memcpy(&v, p, 2); return (void*)(Uint64)v; }
+        case 1: return (void*)(Uint64)*(const Uint8*)p;
+        default: return (void*)p;
+    }
+}
+
 /**
  * Create a new dynamic array.
  * If any one of @c create_copy or @c destroy_copy is non null,
@@ -51,6 +69,26 @@
 Vector* vector_create(Size element_size,
                             CreateElementCopyCallback create_copy,
                             DestroyElementCopyCallback destroy_copy)
+{
+    return vector_create_with_allocator(element_size, create_copy, destroy_copy, NULL);
+}
+
+/**
+ * Create a new dynamic array that allocates all of it's memory
+ * from given allocator.
+ * If any one of @c create_copy or @c destroy_copy is non null,
+ * then both must be non null!
+ *
+ * @param element_size Size of each element in this dynamic array.
+ * @param create_copy Copy constructor for elements. Can be NULL.
+ * @param destroy_copy Copy destructor for elements. Can be NULL.
+ * @param allocator Allocator to use. NULL means system allocator.
+ * @return Vector* or NULL if allocation failed
+ * */
+Vector* vector_create_with_allocator(Size element_size,
+                                     CreateElementCopyCallback create_copy,
+                                     DestroyElementCopyCallback destroy_copy,
+                                     Allocator* allocator)
 {
     ERR_RETURN_VALUE_IF_FAIL(element_size, NULL, ERR_INVALID_ARGUMENTS);
 
@@ -60,14 +98,14 @@ Vector* vector_create(Size element_size,
     ERR_RETURN_VALUE_IF_FAIL(!(b1 ^ b2), NULL, ERR_INVALID_ARGUMENTS);
 
     // create a new dyn array object
-    Vector* vec = NEW(Vector);
+    Vector* vec = allocator_allocate_zeroed(allocator, sizeof(Vector));
     ERR_RETURN_VALUE_IF_FAIL(vec, NULL, ERR_OUT_OF_MEMORY);
 
     // allocate initial memory
-    vec->data = ALLOCATE(Uint8, VECTOR_INIT_ELEMENT_COUNT * element_size);
+    vec->data = allocator_allocate_zeroed(allocator, VECTOR_INIT_ELEMENT_COUNT * element_size);
     if(!vec->data) {
         ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
-        FREE(vec);
+        allocator_free(allocator, vec, sizeof(Vector));
         return NULL;
     }
     vec->capacity = VECTOR_INIT_ELEMENT_COUNT;
@@ -75,28 +113,36 @@ Vector* vector_create(Size element_size,
     vec->resize_factor = VECTOR_DEFAULT_RESIZE_FACTOR;
     vec->create_copy = create_copy;
     vec->destroy_copy = destroy_copy;
+    vec->allocator = allocator;
     return vec;
 }
 
 /**
  * Destroy given dynamic array.
+ * If vector's allocator releases memory in bulk, then nothing
+ * is destroyed or freed here.
  * @param vec Vector to be destroyed
  * @param udata User data to be passed to callback functions.
  * */
 void vector_destroy(Vector* vec, void* udata) {
     ERR_RETURN_IF_FAIL(vec, ERR_INVALID_ARGUMENTS);
 
+    // all memory will be released by allocator at once
+    if(!allocator_needs_free(vec->allocator)) {
+        return;
+    }
+
     // destroy all object copies if possible and memset whole array!
     if(vec->length != 0) {
         vector_clear(vec, udata);
     }
 
     if(vec->data) {
-        FREE(vec->data);
+        allocator_free(vec->allocator, vec->data, vec->capacity * vec->element_size);
         vec->data = NULL;
     }
 
-    FREE(vec);
+    allocator_free(vec->allocator, vec, sizeof(Vector));
 }
 
 /**
@@ -110,7 +156,7 @@ void vector_destroy(Vector* vec, void* udata) {
 Vector* vector_clone(Vector* vec, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(vec, NULL, ERR_INVALID_ARGUMENTS);
 
-    Vector* vec_clone = NEW(Vector);
+    Vector* vec_clone = allocator_allocate_zeroed(vec->allocator, sizeof(Vector));
     ERR_RETURN_VALUE_IF_FAIL(vec_clone, NULL, ERR_OUT_OF_MEMORY);
 
     // create copy of given vector
@@ -120,6 +166,152 @@ Vector* vector_clone(Vector* vec, void* udata) {
     return vec_clone;
 }
 
+/* header, one section of elements, and trailer */
+static Size vector_write_image(Vector* vec, ImageWriter* writer) {
+    Size   bytes     = vec->length * vec->element_size;
+    Uint64 params[2] = {vec->element_size, vec->length};
+
+    image_writer_begin(writer, IMAGE_KIND_VECTOR, 0, params, ARRAY_SIZE(params),
+                       image_section_size(sizeof(ImageHeader)) + image_section_size(bytes) + sizeof(ImageTrailer));
+    image_writer_put(writer, vec->data, bytes);
+    image_writer_align(writer);
+    return image_writer_finish(writer);
+}
+
+/**
+ * Write an image of given vector into @p buffer, see Anvie/Containers/Image.h.
+ * Only vectors of plain elements, ie: without copy callbacks, can be written.
+ *
+ * @param buffer Destination, can be NULL to only compute size of image.
+ * @param capacity Size of @p buffer.
+ * @return Size of image. Image is complete only if this is at most @p capacity.
+ * @return 0 on invalid arguments.
+ * */
+Size vector_write_to_buffer(Vector* vec, void* buffer, Size capacity) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && !vec->create_copy, 0, ERR_INVALID_ARGUMENTS);
+
+    ImageWriter writer;
+    image_writer_init_buffer(&writer, buffer, capacity);
+    return vector_write_image(vec, &writer);
+}
+
+/**
+ * Write an image of given vector to a file, at it's current offset.
+ * Only vectors of plain elements, ie: without copy callbacks, can be written.
+ *
+ * @return True if whole image was written.
+ * */
+Bool vector_serialize_to_fd(Vector* vec, int fd) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && !vec->create_copy, False, ERR_INVALID_ARGUMENTS);
+
+    ImageWriter writer;
+    if(!image_writer_init_fd(&writer, fd)) {
+        return False;
+    }
+    return vector_write_image(vec, &writer) != 0;
+}
+
+/**
+ * Load vector held by given image. Vector's elements are not copied, they're
+ * used right where they are in image. Vector is owned by image and loading
+ * it again returns same vector.
+ *
+ * @return Vector* on success.
+ * @return NULL if image does not hold a valid vector.
+ * */
+Vector* vector_from_image(Image* image) {
+    ERR_RETURN_VALUE_IF_FAIL(image, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(image_get_kind(image) == IMAGE_KIND_VECTOR, NULL, ERR_INVALID_CONTENTS);
+
+    Vector* vec = image_get_container(image);
+    if(vec) {
+        return vec;
+    }
+
+    const ImageHeader* header       = image_get_header(image);
+    Uint64             element_size = header->params[0];
+    Uint64             length       = header->params[1];
+    RETURN_VALUE_IF_FAIL(element_size && length <= SIZE_MAX / element_size, NULL, "invalid vector image\n");
+
+    Size  cursor = 0;
+    void* data   = image_take_section(image, &cursor, length * element_size);
+    RETURN_VALUE_IF_FAIL(data, NULL, "invalid vector image\n");
+
+    Allocator* allocator = image_get_allocator(image);
+    vec = allocator_allocate_zeroed(allocator, sizeof(Vector));
+    ERR_RETURN_VALUE_IF_FAIL(vec, NULL, ERR_OUT_OF_MEMORY);
+
+    vec->element_size  = element_size;
+    vec->length        = length;
+    vec->capacity      = length;
+    vec->data          = data;
+    vec->resize_factor = VECTOR_DEFAULT_RESIZE_FACTOR;
+    vec->allocator     = allocator;
+
+    image_set_container(image, vec);
+    return vec;
+}
+
+/**
+ * Compute capacity vector must grow to, to be able to hold at least
+ * given number of elements, according to vector's growth policy.
+ * Never returns less than @p min_capacity.
+ * */
+static Size vector_next_capacity(Vector* vec, Size min_capacity) {
+    const VectorGrowthPolicy* policy = vec->growth_policy;
+    Size new_capacity = vec->capacity;
+
+    switch(policy ? policy->mode : VECTOR_GROWTH_GEOMETRIC) {
+        case VECTOR_GROWTH_FIXED_STEP: {
+            Size step = MAX(policy->step, 1);
+            new_capacity += (min_capacity - new_capacity + step - 1) / step * step;
+            break;
+        }
+
+        case VECTOR_GROWTH_CALLBACK: {
+            new_capacity = policy->callback ? policy->callback(vec->capacity, min_capacity, policy->udata) : min_capacity;
+            break;
+        }
+
+        default: {
+            // compound resize factor, making progress even with tiny factors
+            new_capacity = MAX(new_capacity, 1);
+            while(new_capacity < min_capacity) {
+                if(new_capacity > SIZE_MAX / 4) {
+                    new_capacity = min_capacity;
+                    break;
+                }
+                new_capacity = MAX((Size)(new_capacity * (1 + vec->resize_factor)), new_capacity + 1);
+            }
+        }
+    }
+
+    return MAX(new_capacity, min_capacity);
+}
+
+/**
+ * Make sure vector can hold at least given number of elements, growing
+ * capacity according to growth policy, with a single reallocation.
+ * New memory is zeroed. Length is not changed.
+ * @return True on success, False if reallocation failed.
+ * */
+static inline Bool vector_grow_to(Vector* vec, Size min_capacity) {
+    if(min_capacity <= vec->capacity) return True;
+
+    Size esz          = vec->element_size;
+    Size new_capacity = vector_next_capacity(vec, min_capacity);
+    ERR_RETURN_VALUE_IF_FAIL(new_capacity <= SIZE_MAX / esz, False, ERR_INVALID_CAPACITY);
+
+    void* temp = allocator_reallocate(vec->allocator, vec->data, vec->capacity * esz, new_capacity * esz);
+    ERR_RETURN_VALUE_IF_FAIL(temp, False, ERR_OUT_OF_MEMORY);
+    COUNTER_INC(VECTOR_REALLOC);
+    memset((UByteArray)temp + vec->capacity * esz, 0, (new_capacity - vec->capacity) * esz);
+
+    vec->data = temp;
+    vec->capacity = new_capacity;
+    return True;
+}
+
 /**
  * Resize the array to contain given number of elements
  * @param vec
@@ -128,14 +320,17 @@ Vector* vector_clone(Vector* vec, void* udata) {
 inline void vector_resize(Vector* vec, Size new_size) {
     ERR_RETURN_IF_FAIL(vec && new_size, ERR_INVALID_ARGUMENTS);
 
-    void* temp = realloc(vec->data, new_size * vec->element_size);
+    void* temp = allocator_reallocate(vec->allocator, vec->data, vec->capacity * vec->element_size, new_size * vec->element_size);
     ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
+    COUNTER_INC(VECTOR_REALLOC);
 
     // memset to make make new area nullified
     // ref : https://stackoverflow.com/a/32732502
     Size old_size_in_bytes = vec->length * vec->element_size;
     Size new_size_in_bytes = new_size * vec->element_size;
-    memset((UByteArray)temp + old_size_in_bytes, 0, new_size_in_bytes - old_size_in_bytes);
+    if(new_size_in_bytes > old_size_in_bytes) {
+        memset((UByteArray)temp + old_size_in_bytes, 0, new_size_in_bytes - old_size_in_bytes);
+    }
 
     vec->data = temp;
     vec->capacity = new_size;
@@ -143,14 +338,58 @@ inline void vector_resize(Vector* vec, Size new_size) {
 }
 
 /**
- * Reserve space for new array. This does not increase length of array.
+ * Reserve space for exactly given number of elements, without going through
+ * growth policy. Nothing happens if vector can already hold that many elements.
+ * This neither changes length of array nor destroys any element.
  * @param vec
  * @param capacity
  * */
 inline void vector_reserve(Vector* vec, Size capacity) {
     ERR_RETURN_IF_FAIL(vec && capacity, ERR_INVALID_ARGUMENTS);
-    vector_resize(vec, capacity);
-    vec->length = 0;
+    if(capacity <= vec->capacity) return;
+
+    ERR_RETURN_IF_FAIL(capacity <= SIZE_MAX / vec->element_size, ERR_INVALID_CAPACITY);
+    Size esz = vec->element_size;
+    void* temp = allocator_reallocate(vec->allocator, vec->data, vec->capacity * esz, capacity * esz);
+    ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
+    COUNTER_INC(VECTOR_REALLOC);
+    memset((UByteArray)temp + vec->capacity * esz, 0, (capacity - vec->capacity) * esz);
+
+    vec->data = temp;
+    vec->capacity = capacity;
+}
+
+/**
+ * Give back memory not used by elements, by reallocating array to
+ * hold exactly as many elements as there are. Capacity never goes
+ * below one element, so array stays allocated.
+ * @param vec
+ * */
+void vector_shrink_to_fit(Vector* vec) {
+    ERR_RETURN_IF_FAIL(vec, ERR_INVALID_ARGUMENTS);
+
+    Size new_capacity = MAX(vec->length, 1);
+    if(new_capacity >= vec->capacity) return;
+
+    Size esz = vec->element_size;
+    void* temp = allocator_reallocate(vec->allocator, vec->data, vec->capacity * esz, new_capacity * esz);
+    ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
+    COUNTER_INC(VECTOR_REALLOC);
+
+    vec->data = temp;
+    vec->capacity = new_capacity;
+}
+
+/**
+ * Set how vector grows when it runs out of space.
+ * @param vec
+ * @param policy Growth policy, must outlive vector. NULL means default
+ * geometric growth by @c resize_factor.
+ * */
+void vector_set_growth_policy(Vector* vec, const VectorGrowthPolicy* policy) {
+    ERR_RETURN_IF_FAIL(vec, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_IF_FAIL(!policy || policy->mode != VECTOR_GROWTH_CALLBACK || policy->callback, ERR_INVALID_ARGUMENTS);
+    vec->growth_policy = policy;
 }
 
 /**
@@ -175,17 +414,20 @@ inline void vector_clear(Vector* vec, void* udata) {
 
 /**
  * Get subvector of given vector by creating another vector containing copy
- * of data.
+ * of data. Use @c vector_get_view to just read a range without copying.
  * @param vec
  * @param start
  * @param size
  * */
 Vector* vector_get_subvector(Vector* vec, Size start, Size size, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(vec && size, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(start <= vec->length && size <= vec->length - start, NULL, ERR_INVALID_INDEX);
 
-    Vector* new_vec = vector_create(vec->element_size, vec->create_copy, vec->destroy_copy);
-    for(Size s = start; s < size; s++) {
-        vector_push_back(new_vec, vector_peek(vec, s), udata);
+    Vector* new_vec = vector_create_with_allocator(vec->element_size, vec->create_copy, vec->destroy_copy, vec->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(new_vec, NULL, ERR_OUT_OF_MEMORY);
+
+    for(Size s = start; s < start + size; s++) {
+        vector_push_back(new_vec, vector_peek_unchecked(vec, s), udata);
     }
 
     return new_vec;
@@ -239,6 +481,7 @@ inline void vector_copy(Vector* vec, Size to, Size from, void* udata) {
         void* elem_from = vector_address_at(vec, from);
         if(to < vec->length) vec->destroy_copy(elem_to, udata);
         vec->create_copy(elem_to, elem_from, udata);
+        COUNTER_INC(VECTOR_ELEMENT_COPY);
     } else switch(vector_element_size(vec)) {
         case 8 : vector_at(vec, Uint64, to) = (Uint64)vector_at(vec, Uint64, from); break;
         case 4 : vector_at(vec, Uint32, to) = (Uint64)vector_at(vec, Uint32, from); break;
@@ -267,8 +510,10 @@ inline void vector_overwrite(Vector* vec, Size pos, void* data, void* udata) {
     if(vec->create_copy) {
         void* elem = vector_address_at(vec, pos);
         if(pos < vec->length) vec->destroy_copy(elem, udata);
-        if(data) vec->create_copy(elem, data, udata);
-        else memset(elem, 0, vec->element_size);
+        if(data) {
+            vec->create_copy(elem, data, udata);
+            COUNTER_INC(VECTOR_ELEMENT_COPY);
+        } else memset(elem, 0, vec->element_size);
     } else {
         Uint64 value = (Uint64)data;
         switch(vector_element_size(vec)) {
@@ -306,29 +551,15 @@ inline void vector_overwrite(Vector* vec, Size pos, void* data, void* udata) {
 inline void vector_insert(Vector* vec, void *data, Size pos, void* udata) {
     ERR_RETURN_IF_FAIL(vec, ERR_INVALID_ARGUMENTS);
 
-    // resize array if insert position is more than capacity
-    if(pos >= vec->capacity) {
-        // calculate new allocation capacity if required
-        Size new_capacity = vec->capacity;
-        while(pos >= new_capacity) {
-            new_capacity = vec->capacity * (1 + vec->resize_factor);
-        }
-
-        // reallocate if we need to
-        void* temp = realloc(vec->data, new_capacity * vector_element_size(vec));
-        ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
-        vec->data = temp;
-        vec->capacity = new_capacity;
-        vec->length = pos;
+    // grow array if insert position is beyond capacity, or array is full
+    if(!vector_grow_to(vec, MAX(pos, vec->length) + 1)) {
+        return;
     }
 
-    // resize array if insert position is in between but array is at capacity
-    if(vec->length >= vec->capacity) {
-        Size new_size = vec->capacity * (vec->resize_factor + 1);
-        void* temp = realloc(vec->data, new_size * vector_element_size(vec));
-        ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
-        vec->data = temp;
-        vec->capacity = new_size;
+    // inserting past end fills the gap with zeroed elements
+    if(pos > vec->length) {
+        memset(vector_address_at(vec, vec->length), 0, (pos - vec->length) * vec->element_size);
+        vec->length = pos;
     }
 
     // shift elements to create space
@@ -359,8 +590,10 @@ inline void vector_insert(Vector* vec, void *data, Size pos, void* udata) {
     // or strings for eg
     if(vec->create_copy) {
         void* elem = vector_address_at(vec, pos);
-        if(data) vec->create_copy(elem, data, udata);
-        else memset(elem, 0, vec->element_size);
+        if(data) {
+            vec->create_copy(elem, data, udata);
+            COUNTER_INC(VECTOR_ELEMENT_COPY);
+        } else memset(elem, 0, vec->element_size);
     } else switch(vector_element_size(vec)) {
             case 8 : vector_at(vec, Uint64, pos) = (Uint64)value; break;
             case 4 : vector_at(vec, Uint32, pos) = (Uint32)value; break;
@@ -448,6 +681,103 @@ inline void* vector_remove(Vector* vec, Size pos) {
     return elem;
 }
 
+/**
+ * Insert elements of an array into vector at given position. Order of
+ * existing elements is preserved. Capacity is grown at most once and
+ * existing elements are shifted with a single memmove.
+ *
+ * If vector has a copy constructor, it's called once per element, with
+ * each element passed the same way @c vector_insert expects it : integer
+ * sized elements by value and others by address. Otherwise elements are
+ * copied with a single memcpy.
+ *
+ * @param vec
+ * @param pos Position of first inserted element. Must not be more than length.
+ * @param array Contiguous array of @p count elements, each of @c element_size bytes.
+ * @param count Number of elements in @p array.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_insert_range(Vector* vec, Size pos, const void* array, Size count, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && (array || !count) && (pos <= vec->length), ERR_INVALID_ARGUMENTS);
+    if(!count) return;
+
+    if(!vector_grow_to(vec, vec->length + count)) return;
+
+    Size esz = vec->element_size;
+    UByteArray dst = vector_address_at(vec, pos);
+
+    // shift tail to make room for new elements
+    memmove(dst + count * esz, dst, (vec->length - pos) * esz);
+
+    if(vec->create_copy) {
+        const Uint8* src = array;
+        for(Size s = 0; s < count; s++) {
+            vec->create_copy(dst + s * esz, element_value(src + s * esz, esz), udata);
+        }
+        COUNTER_ADD(VECTOR_ELEMENT_COPY, count);
+    } else {
+        memcpy(dst, array, count * esz);
+    }
+
+    vec->length += count;
+}
+
+/**
+ * Append elements of an array to end of vector.
+ * Same as @c vector_insert_range at @c length.
+ * @param vec
+ * @param array Contiguous array of @p count elements.
+ * @param count Number of elements in @p array.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_push_back_n(Vector* vec, const void* array, Size count, void* udata) {
+    ERR_RETURN_IF_FAIL(vec, ERR_INVALID_ARGUMENTS);
+    vector_insert_range(vec, vec->length, array, count, udata);
+}
+
+/**
+ * Replace contents of vector with elements of an array.
+ * Existing elements are destroyed first.
+ * @param vec
+ * @param array Contiguous array of @p count elements.
+ * @param count Number of elements in @p array.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_assign_from_array(Vector* vec, const void* array, Size count, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && (array || !count), ERR_INVALID_ARGUMENTS);
+    vector_clear(vec, udata);
+    vector_insert_range(vec, 0, array, count, udata);
+}
+
+/**
+ * Delete a range of elements. Order of remaining elements is preserved.
+ * Elements after the range are shifted with a single memmove.
+ * @param vec
+ * @param pos Position of first element to be deleted.
+ * @param count Number of elements to delete. Range must be within length.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_delete_range(Vector* vec, Size pos, Size count, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && (pos <= vec->length) && (count <= vec->length - pos), ERR_INVALID_ARGUMENTS);
+    if(!count) return;
+
+    Size esz = vec->element_size;
+    UByteArray dst = vector_address_at(vec, pos);
+
+    if(vec->destroy_copy) {
+        for(Size s = 0; s < count; s++) {
+            vec->destroy_copy(dst + s * esz, udata);
+        }
+    }
+
+    Size tail = vec->length - pos - count;
+    memmove(dst, dst + count * esz, tail * esz);
+
+    // memset to avoid data copies
+    memset(dst + tail * esz, 0, count * esz);
+    vec->length -= count;
+}
+
 /**
  * Insert at element without preserving order of array.
  * Use this when you don't care about order being preserved or
@@ -464,29 +794,15 @@ inline void* vector_remove(Vector* vec, Size pos) {
 inline void vector_insert_fast(Vector* vec, void* data, Size pos, void* udata) {
     ERR_RETURN_IF_FAIL(vec, ERR_INVALID_ARGUMENTS);
 
-    // resize array if insert position is more than capacity
-    if(pos >= vec->capacity) {
-        // calculate new allocation capacity if required
-        Size new_capacity = vec->capacity;
-        while(pos >= new_capacity) {
-            new_capacity = vec->capacity * (1 + vec->resize_factor);
-        }
-
-        // reallocate if we need to
-        void* temp = realloc(vec->data, new_capacity * vector_element_size(vec));
-        ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
-        vec->data = temp;
-        vec->capacity = new_capacity;
-        vec->length = pos;
+    // grow array if insert position is beyond capacity, or array is full
+    if(!vector_grow_to(vec, MAX(pos, vec->length) + 1)) {
+        return;
     }
 
-    // resize array if insert position is in between but array is at capacity
-    if(vec->length >= vec->capacity) {
-        Size new_size = vec->capacity * (vec->resize_factor + 1);
-        void* temp = realloc(vec->data, new_size * vector_element_size(vec));
-        ERR_RETURN_IF_FAIL(temp, ERR_OUT_OF_MEMORY);
-        vec->data = temp;
-        vec->capacity = new_size;
+    // inserting past end fills the gap with zeroed elements
+    if(pos > vec->length) {
+        memset(vector_address_at(vec, vec->length), 0, (pos - vec->length) * vec->element_size);
+        vec->length = pos;
     }
 
     // NOTE: No shift operation required here! compared to vanilla insert op
@@ -498,8 +814,10 @@ inline void vector_insert_fast(Vector* vec, void* data, Size pos, void* udata) {
     Uint64 value = (Uint64)data;
     if(vec->create_copy) {
         void* elem = vector_address_at(vec, pos);
-        if(data) vec->create_copy(elem, data, udata);
-        else memset(elem, 0, vec->element_size);
+        if(data) {
+            vec->create_copy(elem, data, udata);
+            COUNTER_INC(VECTOR_ELEMENT_COPY);
+        } else memset(elem, 0, vec->element_size);
     } else switch(vector_element_size(vec)) {
             case 8 : vector_at(vec, Uint64, pos) = (Uint64)value; break;
             case 4 : vector_at(vec, Uint32, pos) = (Uint32)value; break;
@@ -648,13 +966,7 @@ inline void* vector_pop_back(Vector* vec) {
 inline void* vector_peek(Vector* vec, Size pos) {
     ERR_RETURN_VALUE_IF_FAIL(vec, NULL, ERR_INVALID_ARGUMENTS);
     if(pos >= vec->length) return NULL;
-    switch(vec->element_size) {
-        case 8: return (void*)vector_at(vec, Uint64, pos); break;
-        case 4: return (void*)(Uint64)vector_at(vec, Uint32, pos); break;
-        case 2: return (void*)(Uint64)vector_at(vec, Uint16, pos); break;
-        case 1: return (void*)(Uint64)vector_at(vec, Uint8, pos); break;
-        default: return vector_address_at(vec, pos);
-    }
+    return vector_peek_unchecked(vec, pos);
 }
 
 /**
@@ -720,7 +1032,7 @@ void vector_merge(Vector* vec, Vector* vec_other, void* udata) {
     ERR_RETURN_IF_FAIL(vec->element_size == vec_other->element_size, ERR_TYPE_MISMATCH);
 
     for(Size s = 0; s < vec_other->length; s++) {
-        vector_push_back(vec, vector_peek(vec_other, s), udata);
+        vector_push_back(vec, vector_peek_unchecked(vec_other, s), udata);
     }
 }
 
@@ -735,19 +1047,172 @@ Vector* vector_filter(Vector* vec, FilterElementCallback filter, void* udata) {
     ERR_RETURN_VALUE_IF_FAIL(vec && filter, NULL, ERR_INVALID_ARGUMENTS);
 
     // create new vector for containing filtered vectors
-    Vector* filtered_vec = vector_create(vec->element_size, vec->create_copy, vec->destroy_copy);
+    Vector* filtered_vec = vector_create_with_allocator(vec->element_size, vec->create_copy, vec->destroy_copy, vec->allocator);
     ERR_RETURN_VALUE_IF_FAIL(filtered_vec, NULL, ERR_INVALID_OBJECT);
 
     // filter elements
     for(Size i = 0; i < vec->length; i++) {
-        if(filter(vector_peek(vec, i), udata)) {
-            vector_push_back(filtered_vec, vector_peek(vec, i), udata);
+        if(filter(vector_peek_unchecked(vec, i), udata)) {
+            vector_push_back(filtered_vec, vector_peek_unchecked(vec, i), udata);
         }
     }
 
     return filtered_vec;
 }
 
+/**
+ * Keep only elements for which @p filter returns True, in place.
+ * Order of retained elements is preserved. Rejected elements are destroyed
+ * using copy destructor, if any. No memory is allocated.
+ *
+ * @param vec Vector to filter elements of.
+ * @param filter Filter function, returns True for elements to keep.
+ * @param udata User data to be passed to callback functions.
+ * @return New length of vector.
+ * */
+Size vector_retain_if(Vector* vec, FilterElementCallback filter, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && filter, 0, ERR_INVALID_ARGUMENTS);
+
+    Size esz  = vec->element_size;
+    Size kept = 0;
+    for(Size i = 0; i < vec->length; i++) {
+        Byte* elem = vector_address_at(vec, i);
+        if(filter(element_value(elem, esz), udata)) {
+            if(kept != i) memcpy(vector_address_at(vec, kept), elem, esz);
+            kept++;
+        } else if(vec->destroy_copy) {
+            vec->destroy_copy(elem, udata);
+        }
+    }
+
+    // keep unused area nullified
+    memset(vector_address_at(vec, kept), 0, (vec->length - kept) * esz);
+    vec->length = kept;
+
+    return kept;
+}
+
+#if SIMD_LVL2
+/**
+ * Left pack 4 or 8 byte elements in range [lo, hi] using SIMD compares and
+ * compress stores. Compares are signed, so unsigned elements are biased by
+ * flipping their sign bit, which preserves their order.
+ *
+ * Processes only whole registers and returns number of elements consumed
+ * through @p consumed. Compress store may write a full register at output,
+ * which is safe here because output never runs ahead of input.
+ * */
+#define DEF_SIMD_RETAIN_RANGE(bits)                                     \
+    static inline Size simd_retain_range_epi##bits(Int##bits* data, Size n, Int##bits lo, Int##bits hi, \
+                                                 Int##bits bias, Size* consumed) { \
+        const Size lanes = SIMD_VECTOR_REGISTER_SIZE / sizeof(Int##bits); \
+        MVec vbias = simd_set1_epi##bits(bias);                         \
+        MVec vlo   = simd_set1_epi##bits((Int##bits)(lo ^ bias));      \
+        MVec vhi   = simd_set1_epi##bits((Int##bits)(hi ^ bias));      \
+        MMask all  = (MMask)(((Uint64)1 << lanes) - 1);                 \
+                                                                        \
+        Size kept = 0, i = 0;                                           \
+        for(; i + lanes <= n; i += lanes) {                             \
+            MVec v = simd_xor(simd_loadu(data + i), vbias);             \
+            MMask reject = simd_cmpgt_epi##bits##_mask(vlo, v) | simd_cmpgt_epi##bits##_mask(v, vhi); \
+            kept += simd_compress_storeu_epi##bits(data + kept, ~reject & all, simd_xor(v, vbias)); \
+        }                                                               \
+                                                                        \
+        *consumed = i;                                                  \
+        return kept;                                                    \
+    }
+
+DEF_SIMD_RETAIN_RANGE(32)
+DEF_SIMD_RETAIN_RANGE(64)
+
+#undef DEF_SIMD_RETAIN_RANGE
+#endif // SIMD_LVL2
+
+/**
+ * Define in place range filters for a numeric vector type.
+ * Every predicate is expressed as a closed range [lo, hi], and an element
+ * x is retained if (x - lo) <= (hi - lo) in unsigned arithmetic. Elements
+ * are always written and output position advances only for retained ones,
+ * so the loop has no data dependent branches.
+ *
+ * @param sfx Suffix of generated function names (eg: u32).
+ * @param type Type of elements.
+ * @param utype Unsigned integer type of same size as @p type.
+ * @param min Smallest value of @p type.
+ * @param simd Name of SIMD range kernel for this size, or NULL_KERNEL.
+ * @param bias Value to flip sign bit with before signed SIMD compares.
+ * */
+#define DEF_NUMERIC_VECTOR_RETAIN(sfx, type, utype, min, simd, bias)   \
+    static Size sfx##_retain_range(Vector* vec, type lo, type hi) {     \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type) && !vec->destroy_copy, \
+                                 0, ERR_INVALID_ARGUMENTS);             \
+                                                                        \
+        type* data = (type*)vec->data;                                  \
+        Size  n    = vec->length;                                       \
+        Size  kept = 0, i = 0;                                          \
+        simd(kept, i, data, n, lo, hi, bias);                           \
+                                                                        \
+        utype width = (utype)((utype)hi - (utype)lo);                   \
+        for(; i < n; i++) {                                             \
+            type x = data[i];                                           \
+            data[kept] = x;                                             \
+            kept += (utype)((utype)x - (utype)lo) <= width;             \
+        }                                                               \
+                                                                        \
+        memset(data + kept, 0, (n - kept) * sizeof(type));              \
+        vec->length = kept;                                             \
+        return kept;                                                    \
+    }                                                                   \
+                                                                        \
+    Size vector_retain_eq_##sfx(Vector* vec, type value) {              \
+        return sfx##_retain_range(vec, value, value);                   \
+    }                                                                   \
+                                                                        \
+    Size vector_retain_lt_##sfx(Vector* vec, type value) {              \
+        /* nothing is less than minimum value */                        \
+        if(value == (type)(min)) {                                      \
+            ERR_RETURN_VALUE_IF_FAIL(vec, 0, ERR_INVALID_ARGUMENTS);    \
+            vector_clear(vec, NULL);                                    \
+            return 0;                                                   \
+        }                                                               \
+        return sfx##_retain_range(vec, (type)(min), (type)(value - 1)); \
+    }                                                                   \
+                                                                        \
+    Size vector_retain_in_range_##sfx(Vector* vec, type lo, type hi) {  \
+        if(lo > hi) {                                                   \
+            ERR_RETURN_VALUE_IF_FAIL(vec, 0, ERR_INVALID_ARGUMENTS);    \
+            vector_clear(vec, NULL);                                    \
+            return 0;                                                   \
+        }                                                               \
+        return sfx##_retain_range(vec, lo, hi);                         \
+    }
+
+#define NULL_KERNEL(kept, i, data, n, lo, hi, bias)
+
+#if SIMD_LVL2
+#   define SIMD_KERNEL_32(kept, i, data, n, lo, hi, bias) \
+    kept = simd_retain_range_epi32((Int32*)(data), n, (Int32)(lo), (Int32)(hi), (Int32)(bias), &i)
+#   define SIMD_KERNEL_64(kept, i, data, n, lo, hi, bias) \
+    kept = simd_retain_range_epi64((Int64*)(data), n, (Int64)(lo), (Int64)(hi), (Int64)(bias), &i)
+#else
+#   define SIMD_KERNEL_32 NULL_KERNEL
+#   define SIMD_KERNEL_64 NULL_KERNEL
+#endif
+
+DEF_NUMERIC_VECTOR_RETAIN(u8,  Uint8,  Uint8,  0,         NULL_KERNEL,    0)
+DEF_NUMERIC_VECTOR_RETAIN(u16, Uint16, Uint16, 0,         NULL_KERNEL,    0)
+DEF_NUMERIC_VECTOR_RETAIN(u32, Uint32, Uint32, 0,         SIMD_KERNEL_32, INT32_MIN)
+DEF_NUMERIC_VECTOR_RETAIN(u64, Uint64, Uint64, 0,         SIMD_KERNEL_64, INT64_MIN)
+DEF_NUMERIC_VECTOR_RETAIN(i8,  Int8,   Uint8,  INT8_MIN,  NULL_KERNEL,    0)
+DEF_NUMERIC_VECTOR_RETAIN(i16, Int16,  Uint16, INT16_MIN, NULL_KERNEL,    0)
+DEF_NUMERIC_VECTOR_RETAIN(i32, Int32,  Uint32, INT32_MIN, SIMD_KERNEL_32, 0)
+DEF_NUMERIC_VECTOR_RETAIN(i64, Int64,  Uint64, INT64_MIN, SIMD_KERNEL_64, 0)
+
+#undef SIMD_KERNEL_32
+#undef SIMD_KERNEL_64
+#undef NULL_KERNEL
+#undef DEF_NUMERIC_VECTOR_RETAIN
+
 /**
  * Swap two elements in same vector.
  * @param vec Vector in which arrays will be sorted
@@ -782,150 +1247,1086 @@ inline void vector_swap(Vector* vec, Size p1, Size p2) {
 #undef SWAINT
 }
 
+/* partitions smaller than this are sorted using insertion sort */
+#define PDQ_INSERTION_SORT_THRESHOLD 24
+
+/* partitions larger than this use pseudo median of nine as pivot */
+#define PDQ_NINTHER_THRESHOLD 128
+
+/* max number of element moves before partial insertion sort gives up */
+#define PDQ_PARTIAL_INSERTION_SORT_LIMIT 8
+
 /**
- * Apply the fastest sort algorithm for given array possible.
- * @param vec Vector to be sorted
- * @param cmp Compare function
- * @param udata User data to be passed to callback functions.
+ * State shared by all steps of a single @c vector_sort call.
+ * Elements are addressed directly in @c data, without going through
+ * checked vector accessors.
  * */
-void vector_sort(Vector* vec, CompareElementCallback cmp, void* udata) {
-    ERR_RETURN_IF_FAIL(vec && cmp, ERR_INVALID_ARGUMENTS);
-    vector_insertion_sort(vec, cmp, udata);
-}
+typedef struct SortContext {
+    Byte*                  data;         /**< Data of vector being sorted. */
+    Size                   element_size; /**< Size of each element in bytes. */
+    CompareElementCallback compare;      /**< Compare function. */
+    void*                  udata;        /**< User data passed to compare. */
+    Byte*                  tmp;          /**< Space for one element, used when shifting elements. */
+} SortContext;
+
+#define SORT_ELEM(ctx, i) ((ctx)->data + (i) * (ctx)->element_size)
+#define SORT_MOVE(ctx, dst, src) memcpy((dst), (src), (ctx)->element_size)
 
 /**
- * Check whether the array is sorted in any manner
- * By default the algorithm is written for checking array in descending order,
- * but this can be checked for any array type by modifying the compare method.
- *
- * This means if compare returns > 0 for any comparision then array is not sorted
- *
- * @param vec
- * @param compare
- * @param udata User data to be passed to callback functions.
+ * Get value to be passed to compare function for element at given address.
+ * Follows same convention as @c vector_peek.
  * */
-Bool vector_check_sorted(Vector* vec, CompareElementCallback compare, void* udata) {
-    ERR_RETURN_VALUE_IF_FAIL(vec && compare, False, ERR_INVALID_ARGUMENTS);
-    for(Size s = 1; s < vec->length; s++) {
-        if(compare(vector_peek(vec, s), vector_peek(vec, s-1), udata) < 0) {
-            return False;
-        }
-    }
-    return True;
+static FORCE_INLINE void* sort_peek(SortContext* ctx, const Byte* p) {
+    return element_value(p, ctx->element_size);
 }
 
-/**
- * Use insertion sort mechanism to sort this array.
- * Time complexity:
- * BEST : O(n)
- * AVERAGE : O(n^2)
- * WORST : O(n^2)
- * @param vec
- * @param compare Compare function
- * @param udata User data to be passed to callback functions.
- * */
-void vector_insertion_sort(Vector* vec, CompareElementCallback compare, void* udata) {
-    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+/* true when element at a must be placed before element at b */
+static FORCE_INLINE Bool sort_before(SortContext* ctx, const Byte* a, const Byte* b) {
+    return ctx->compare(sort_peek(ctx, a), sort_peek(ctx, b), ctx->udata) > 0;
+}
 
-    for(Size s = 1; s < vec->length; s++) {
-        Size m = s;
-        while((m > 0) && (compare(vector_peek(vec, m), vector_peek(vec, m-1), udata) > 0)) {
-            vector_swap(vec, m, m-1); m--;
+#define SORT_BEFORE(ctx, i, j) sort_before(ctx, SORT_ELEM(ctx, i), SORT_ELEM(ctx, j))
+
+static FORCE_INLINE void sort_swap(SortContext* ctx, Size i, Size j) {
+    Byte* a = SORT_ELEM(ctx, i);
+    Byte* b = SORT_ELEM(ctx, j);
+    switch(ctx->element_size) {
+        case 8: { Uint64 t; memcpy(&t, a, 8); memcpy(a, b, 8); memcpy(b, &t, 8); return; }
+        case 4: { Uint32 t; memcpy(&t, a, 4); memcpy(a, b, 4); memcpy(b, &t, 4); return; }
+        default: {
+            SORT_MOVE(ctx, ctx->tmp, a);
+            SORT_MOVE(ctx, a, b);
+            SORT_MOVE(ctx, b, ctx->tmp);
+            return;
         }
     }
 }
 
+/* order two elements */
+static FORCE_INLINE void sort2(SortContext* ctx, Size a, Size b) {
+    if(SORT_BEFORE(ctx, b, a)) sort_swap(ctx, a, b);
+}
+
+/* order three elements, median ends up at b */
+static FORCE_INLINE void sort3(SortContext* ctx, Size a, Size b, Size c) {
+    sort2(ctx, a, b);
+    sort2(ctx, b, c);
+    sort2(ctx, a, b);
+}
+
 /**
- * Bubble sort algorithm.
- * @param vec
- * @param compare
- * @param udata User data to be passed to callback functions.
+ * Insertion sort [begin, end). When @p guarded is False, this assumes that
+ * the element just before @p begin must be placed before all elements in range,
+ * and hence skips the bound check.
  * */
-void vector_bubble_sort(Vector* vec, CompareElementCallback compare, void* udata) {
-    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
-
-    Bool b_swapped;
-    for (Size i = 0; i < vec->length; i++) {
-        b_swapped = False;
-        for (Size j = 0; j < vec->length-1; j++) {
-            if (compare(vector_peek(vec, j+1), vector_peek(vec, j), udata) > 0) {
-                vector_swap(vec, j, j+1);
-                b_swapped = True;
-            }
-        }
-        if (!b_swapped)
-            break;
+static inline void pdq_insertion_sort(SortContext* ctx, Size begin, Size end, Bool guarded) {
+    if(begin == end) return;
+
+    for(Size cur = begin + 1; cur < end; cur++) {
+        if(!SORT_BEFORE(ctx, cur, cur - 1)) continue;
+
+        /* shift elements right to open a hole for current element */
+        Size sift = cur;
+        SORT_MOVE(ctx, ctx->tmp, SORT_ELEM(ctx, cur));
+        do {
+            SORT_MOVE(ctx, SORT_ELEM(ctx, sift), SORT_ELEM(ctx, sift - 1));
+            sift--;
+        } while((!guarded || sift != begin) && sort_before(ctx, ctx->tmp, SORT_ELEM(ctx, sift - 1)));
+        SORT_MOVE(ctx, SORT_ELEM(ctx, sift), ctx->tmp);
     }
 }
 
 /**
- * This merges two sorted sub vectors in a given vector.
- * The first vector starts from low and continues till mid.
- * The second vector starts from mid and continues till high.
+ * Insertion sort that gives up after moving too many elements.
+ * @return True if range [begin, end) is now sorted, False otherwise.
  * */
-static inline void merge_sort_merge(Vector* vec, CompareElementCallback compare, Size low, Size mid, Size high, void* udata) {
-    Vector* tmpvec = vector_create(vec->element_size, NULL, NULL);
-    vector_reserve(tmpvec, high - low);
+static inline Bool pdq_partial_insertion_sort(SortContext* ctx, Size begin, Size end) {
+    if(begin == end) return True;
+
+    Size limit = 0;
+    for(Size cur = begin + 1; cur < end; cur++) {
+        if(!SORT_BEFORE(ctx, cur, cur - 1)) continue;
+
+        Size sift = cur;
+        SORT_MOVE(ctx, ctx->tmp, SORT_ELEM(ctx, cur));
+        do {
+            SORT_MOVE(ctx, SORT_ELEM(ctx, sift), SORT_ELEM(ctx, sift - 1));
+            sift--;
+        } while(sift != begin && sort_before(ctx, ctx->tmp, SORT_ELEM(ctx, sift - 1)));
+        SORT_MOVE(ctx, SORT_ELEM(ctx, sift), ctx->tmp);
+
+        limit += cur - sift;
+        if(limit > PDQ_PARTIAL_INSERTION_SORT_LIMIT) return False;
+    }
 
-    Size s = low; /* iterator in first array */
-    Size m = mid; /* iterator in second array */
+    return True;
+}
 
-    // merge
-    while((s < mid) && (m < high)) {
-        Int32 res = compare(vector_peek(vec, s), vector_peek(vec, m), udata);
-        if(res > 0) {
-            vector_push_back(tmpvec, vector_peek(vec, s++), NULL);
-        } else if (res < 0) {
-            vector_push_back(tmpvec, vector_peek(vec, m++), NULL);
-        } else {
-            vector_push_back(tmpvec, vector_peek(vec, s++), NULL);
-            vector_push_back(tmpvec, vector_peek(vec, m++), NULL);
-        }
+/* restore max heap property for heap rooted at root, in range [begin, begin + size) */
+static inline void pdq_sift_down(SortContext* ctx, Size begin, Size root, Size size) {
+    for(;;) {
+        Size child = 2 * root + 1;
+        if(child >= size) return;
+        if(child + 1 < size && SORT_BEFORE(ctx, begin + child, begin + child + 1)) child++;
+        if(!SORT_BEFORE(ctx, begin + root, begin + child)) return;
+        sort_swap(ctx, begin + root, begin + child);
+        root = child;
     }
+}
 
-    while(s < mid) {
-        vector_push_back(tmpvec, vector_peek(vec, s++), NULL);
+/* heapsort [begin, end), guarantees O(n log n) when partitioning keeps going bad */
+static inline void pdq_heap_sort(SortContext* ctx, Size begin, Size end) {
+    Size size = end - begin;
+    for(Size s = size / 2; s > 0; s--) {
+        pdq_sift_down(ctx, begin, s - 1, size);
     }
-    while(m < high) {
-        vector_push_back(tmpvec, vector_peek(vec, m++), NULL);
+    for(Size s = size - 1; s > 0; s--) {
+        sort_swap(ctx, begin, begin + s);
+        pdq_sift_down(ctx, begin, 0, s);
     }
-
-    // copy back sorted array
-    memcpy(vector_address_at(vec, low), tmpvec->data, tmpvec->element_size * tmpvec->length);
-    vector_destroy(tmpvec, NULL);
 }
 
 /**
- * Performs the sort operation in merge sort.
+ * Partition [begin, end) around pivot at begin. Elements equal to pivot
+ * go to the right partition.
+ * @param already_partitioned Set to True if no element had to be swapped.
+ * @return Final position of pivot.
  * */
-static inline void merge_sort_sort(Vector* vec, CompareElementCallback compare, Size start, Size size, void* udata) {
-    if(size < 2) return;
-    ERR_RETURN_IF_FAIL(vec && compare && (start + size) <= vec->length, ERR_INVALID_ARGUMENTS);
+static inline Size pdq_partition_right(SortContext* ctx, Size begin, Size end, Bool* already_partitioned) {
+    Size first = begin;
+    Size last  = end;
 
-    if((size == 2) && (compare(vector_peek(vec, start+1), vector_peek(vec, start), udata) > 0)) {
-        vector_swap(vec, start, start+1);
-        return;
+    /* median of three guarantees there's an element not placed before pivot at the end */
+    while(SORT_BEFORE(ctx, ++first, begin));
+
+    /* first element placed before pivot from right, check bounds only if there's no such element on left */
+    if(first - 1 == begin) {
+        while(first < last && !SORT_BEFORE(ctx, --last, begin));
+    } else {
+        while(!SORT_BEFORE(ctx, --last, begin));
     }
 
-    // sort by dividing into two
-    Size mid = start + size/2;
-    merge_sort_sort(vec, compare, start, size/2, udata);
-    merge_sort_sort(vec, compare, mid, size - size/2, udata);
+    *already_partitioned = first >= last;
 
-    // then merge
-    merge_sort_merge(vec, compare, start, mid, start + size, udata);
+    while(first < last) {
+        sort_swap(ctx, first, last);
+        while(SORT_BEFORE(ctx, ++first, begin));
+        while(!SORT_BEFORE(ctx, --last, begin));
+    }
+
+    Size pivot_pos = first - 1;
+    sort_swap(ctx, begin, pivot_pos);
+    return pivot_pos;
+}
+
+/**
+ * Partition [begin, end) around pivot at begin. Elements equal to pivot
+ * go to the left partition. Used when there are many equal elements.
+ * @return Final position of pivot.
+ * */
+static inline Size pdq_partition_left(SortContext* ctx, Size begin, Size end) {
+    Size first = begin;
+    Size last  = end;
+
+    while(SORT_BEFORE(ctx, begin, --last));
+
+    if(last + 1 == end) {
+        while(first < last && !SORT_BEFORE(ctx, begin, ++first));
+    } else {
+        while(!SORT_BEFORE(ctx, begin, ++first));
+    }
+
+    while(first < last) {
+        sort_swap(ctx, first, last);
+        while(SORT_BEFORE(ctx, begin, --last));
+        while(!SORT_BEFORE(ctx, begin, ++first));
+    }
+
+    sort_swap(ctx, begin, last);
+    return last;
+}
+
+/**
+ * Pattern defeating quicksort main loop.
+ * @param bad_allowed Number of highly unbalanced partitions allowed before switching to heapsort.
+ * @param leftmost True if there's no element before @p begin in the range being sorted.
+ * */
+static void pdq_sort_loop(SortContext* ctx, Size begin, Size end, Size bad_allowed, Bool leftmost) {
+    for(;;) {
+        Size size = end - begin;
+
+        if(size < PDQ_INSERTION_SORT_THRESHOLD) {
+            pdq_insertion_sort(ctx, begin, end, leftmost);
+            return;
+        }
+
+        /* choose pivot and move it to begin */
+        Size half = size / 2;
+        if(size > PDQ_NINTHER_THRESHOLD) {
+            sort3(ctx, begin, begin + half, end - 1);
+            sort3(ctx, begin + 1, begin + half - 1, end - 2);
+            sort3(ctx, begin + 2, begin + half + 1, end - 3);
+            sort3(ctx, begin + half - 1, begin + half, begin + half + 1);
+            sort_swap(ctx, begin, begin + half);
+        } else {
+            sort3(ctx, begin + half, begin, end - 1);
+        }
+
+        /* if pivot is equal to element before this partition, then all elements equal to
+         * pivot can be put on left and need not be sorted again */
+        if(!leftmost && !SORT_BEFORE(ctx, begin - 1, begin)) {
+            begin = pdq_partition_left(ctx, begin, end) + 1;
+            continue;
+        }
+
+        Bool already_partitioned;
+        Size pivot_pos = pdq_partition_right(ctx, begin, end, &already_partitioned);
+
+        Size l_size = pivot_pos - begin;
+        Size r_size = end - (pivot_pos + 1);
+
+        if(l_size < size / 8 || r_size < size / 8) {
+            /* too many bad partitions, fallback to heapsort */
+            if(--bad_allowed == 0) {
+                pdq_heap_sort(ctx, begin, end);
+                return;
+            }
+
+            /* break patterns that may cause bad pivots */
+            if(l_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                sort_swap(ctx, begin, begin + l_size / 4);
+                sort_swap(ctx, pivot_pos - 1, pivot_pos - l_size / 4);
+                if(l_size > PDQ_NINTHER_THRESHOLD) {
+                    sort_swap(ctx, begin + 1, begin + (l_size / 4 + 1));
+                    sort_swap(ctx, begin + 2, begin + (l_size / 4 + 2));
+                    sort_swap(ctx, pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    sort_swap(ctx, pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if(r_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                sort_swap(ctx, pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                sort_swap(ctx, end - 1, end - r_size / 4);
+                if(r_size > PDQ_NINTHER_THRESHOLD) {
+                    sort_swap(ctx, pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    sort_swap(ctx, pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    sort_swap(ctx, end - 2, end - (1 + r_size / 4));
+                    sort_swap(ctx, end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if(already_partitioned &&
+                  pdq_partial_insertion_sort(ctx, begin, pivot_pos) &&
+                  pdq_partial_insertion_sort(ctx, pivot_pos + 1, end)) {
+            /* range was probably already sorted */
+            return;
+        }
+
+        /* recurse into left partition, loop over right one */
+        pdq_sort_loop(ctx, begin, pivot_pos, bad_allowed, leftmost);
+        begin    = pivot_pos + 1;
+        leftmost = False;
+    }
 }
 
+/**
+ * Apply the fastest sort algorithm for given array possible.
+ * This is a pattern defeating quicksort : a quicksort that uses
+ * insertion sort for small partitions, detects already sorted and
+ * many equal elements, and falls back to heapsort on bad inputs.
+ *
+ * Time complexity:
+ * BEST : O(n)
+ * AVERAGE : O(n log n)
+ * WORST : O(n log n)
+ *
+ * Sort is not stable.
+ *
+ * @param vec Vector to be sorted
+ * @param cmp Compare function. Element a is placed before element b if
+ * cmp(a, b) returns a value greater than 0.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_sort(Vector* vec, CompareElementCallback cmp, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && cmp, ERR_INVALID_ARGUMENTS);
+    if(vec->length < 2) return;
+
+    Byte tmp[vec->element_size];
+    SortContext ctx = {
+        .data         = vec->data,
+        .element_size = vec->element_size,
+        .compare      = cmp,
+        .udata        = udata,
+        .tmp          = tmp
+    };
+
+    /* allowed bad partitions is log2 of length */
+    Size bad_allowed = 64 - __builtin_clzll(vec->length);
+    pdq_sort_loop(&ctx, 0, vec->length, bad_allowed, True);
+}
+
+/**
+ * Selection counterpart of @c pdq_sort_loop. Partitions exactly like sort,
+ * but only follows the partition that contains @p nth, so it's linear on
+ * average. Partition containing @p nth is heapsorted when partitioning
+ * keeps going bad.
+ * */
+static void pdq_select_loop(SortContext* ctx, Size begin, Size end, Size nth, Size bad_allowed) {
+    Bool leftmost = True;
+
+    while(end - begin >= PDQ_INSERTION_SORT_THRESHOLD) {
+        Size size = end - begin;
+
+        Size half = size / 2;
+        if(size > PDQ_NINTHER_THRESHOLD) {
+            sort3(ctx, begin, begin + half, end - 1);
+            sort3(ctx, begin + 1, begin + half - 1, end - 2);
+            sort3(ctx, begin + 2, begin + half + 1, end - 3);
+            sort3(ctx, begin + half - 1, begin + half, begin + half + 1);
+            sort_swap(ctx, begin, begin + half);
+        } else {
+            sort3(ctx, begin + half, begin, end - 1);
+        }
+
+        /* all elements equal to pivot are already in their final place */
+        if(!leftmost && !SORT_BEFORE(ctx, begin - 1, begin)) {
+            Size last_equal = pdq_partition_left(ctx, begin, end);
+            if(nth <= last_equal) return;
+            begin = last_equal + 1;
+            continue;
+        }
+
+        Bool already_partitioned;
+        Size pivot_pos = pdq_partition_right(ctx, begin, end, &already_partitioned);
+        if(pivot_pos == nth) return;
+
+        Size l_size = pivot_pos - begin;
+        Size r_size = end - (pivot_pos + 1);
+        if((l_size < size / 8 || r_size < size / 8) && --bad_allowed == 0) {
+            pdq_heap_sort(ctx, begin, end);
+            return;
+        }
+
+        if(nth < pivot_pos) {
+            end = pivot_pos;
+        } else {
+            begin    = pivot_pos + 1;
+            leftmost = False;
+        }
+    }
+
+    pdq_insertion_sort(ctx, begin, end, True);
+}
+
+/**
+ * Rearrange elements so that element at @p nth is the one that would be
+ * there if vector was sorted. No element before it is placed after it,
+ * and no element after it is placed before it. Order inside both sides
+ * is unspecified.
+ *
+ * Time complexity:
+ * AVERAGE : O(n)
+ * WORST : O(n log n)
+ *
+ * @param vec
+ * @param nth Position of element to be selected. Must be less than length.
+ * @param compare Compare function, same as @c vector_sort.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_nth_element(Vector* vec, Size nth, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && compare && nth < vec->length, ERR_INVALID_ARGUMENTS);
+    if(vec->length < 2) return;
+
+    Byte tmp[vec->element_size];
+    SortContext ctx = {
+        .data         = vec->data,
+        .element_size = vec->element_size,
+        .compare      = compare,
+        .udata        = udata,
+        .tmp          = tmp
+    };
+
+    pdq_select_loop(&ctx, 0, vec->length, nth, 64 - __builtin_clzll(vec->length));
+}
+
+/**
+ * Sort only first @p count elements, ie: move @p count elements that
+ * come first in sorted order to front of vector, in sorted order.
+ * Order of remaining elements is unspecified. This is a selection of
+ * @p count th element followed by a sort of elements before it, so
+ * it's much cheaper than @c vector_sort when @p count is small.
+ *
+ * Time complexity:
+ * AVERAGE : O(n + count log count)
+ *
+ * @param vec
+ * @param count Number of elements to sort. Values larger than length sort whole vector.
+ * @param compare Compare function, same as @c vector_sort.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_partial_sort(Vector* vec, Size count, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+    count = MIN(count, vec->length);
+    if(!count) return;
+
+    Byte tmp[vec->element_size];
+    SortContext ctx = {
+        .data         = vec->data,
+        .element_size = vec->element_size,
+        .compare      = compare,
+        .udata        = udata,
+        .tmp          = tmp
+    };
+
+    Size bad_allowed = 64 - __builtin_clzll(vec->length);
+    if(count < vec->length) {
+        /* last selected element is already in it's place */
+        pdq_select_loop(&ctx, 0, vec->length, count - 1, bad_allowed);
+        count--;
+    }
+    pdq_sort_loop(&ctx, 0, count, bad_allowed, True);
+}
+
+/* runs smaller than this are sorted using insertion sort before merging */
+#define STABLE_SORT_RUN_LENGTH 16
+
+/**
+ * Merge sorted ranges [begin, mid) and [mid, end). Left range is moved
+ * into scratch buffer and merged back into place, left to right.
+ * Element from right range is taken only when it must be placed strictly
+ * before element from left range, which keeps the merge stable.
+ * */
+static inline void stable_sort_merge(SortContext* ctx, Byte* scratch, Size begin, Size mid, Size end) {
+    Size esz = ctx->element_size;
+
+    /* ranges are already in order, nothing to merge */
+    if(!SORT_BEFORE(ctx, mid, mid - 1)) return;
+
+    memcpy(scratch, SORT_ELEM(ctx, begin), (mid - begin) * esz);
+
+    Byte* left     = scratch;
+    Byte* left_end = scratch + (mid - begin) * esz;
+    Byte* right    = SORT_ELEM(ctx, mid);
+    Byte* right_end = SORT_ELEM(ctx, end);
+    Byte* out      = SORT_ELEM(ctx, begin);
+
+    while(left < left_end && right < right_end) {
+        if(sort_before(ctx, right, left)) {
+            SORT_MOVE(ctx, out, right);
+            right += esz;
+        } else {
+            SORT_MOVE(ctx, out, left);
+            left += esz;
+        }
+        out += esz;
+    }
+
+    /* remaining right elements are already in place */
+    memcpy(out, left, left_end - left);
+}
+
+/* top down merge sort of [begin, end) */
+static void stable_sort_range(SortContext* ctx, Byte* scratch, Size begin, Size end) {
+    if(end - begin <= STABLE_SORT_RUN_LENGTH) {
+        /* insertion sort moves an element only past elements strictly after it, so it's stable */
+        pdq_insertion_sort(ctx, begin, end, True);
+        return;
+    }
+
+    Size mid = begin + (end - begin) / 2;
+    stable_sort_range(ctx, scratch, begin, mid);
+    stable_sort_range(ctx, scratch, mid, end);
+    stable_sort_merge(ctx, scratch, begin, mid, end);
+}
+
+/**
+ * Stable sort using caller provided scratch buffer. This never allocates.
+ * Elements that compare equal keep their relative order.
+ *
+ * Time complexity:
+ * BEST : O(n)
+ * AVERAGE : O(n log n)
+ * WORST : O(n log n)
+ *
+ * @param vec Vector to be sorted
+ * @param compare Compare function. Element a is placed before element b if
+ * compare(a, b) returns a value greater than 0.
+ * @param udata User data to be passed to callback functions.
+ * @param scratch Scratch memory, at least @c vector_stable_sort_scratch_size bytes.
+ * @param scratch_size Size of scratch memory in bytes.
+ * */
+void vector_stable_sort_with_buffer(Vector* vec, CompareElementCallback compare, void* udata, void* scratch, Size scratch_size) {
+    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+    if(vec->length < 2) return;
+    ERR_RETURN_IF_FAIL(scratch && scratch_size >= vector_stable_sort_scratch_size(vec), ERR_INVALID_ARGUMENTS);
+
+    Byte tmp[vec->element_size];
+    SortContext ctx = {
+        .data         = vec->data,
+        .element_size = vec->element_size,
+        .compare      = compare,
+        .udata        = udata,
+        .tmp          = tmp
+    };
+
+    stable_sort_range(&ctx, scratch, 0, vec->length);
+}
+
+/**
+ * Stable merge sort. Allocates a single scratch buffer of half
+ * the vector size, from allocator of vector, for the whole sort.
+ * Elements that compare equal keep their relative order.
+ *
+ * @param vec Vector to be sorted
+ * @param compare Compare function. Element a is placed before element b if
+ * compare(a, b) returns a value greater than 0.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_stable_sort(Vector* vec, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+    if(vec->length < 2) return;
+
+    Size scratch_size = vector_stable_sort_scratch_size(vec);
+    void* scratch = allocator_allocate(vec->allocator, scratch_size);
+    ERR_RETURN_IF_FAIL(scratch, ERR_OUT_OF_MEMORY);
+
+    vector_stable_sort_with_buffer(vec, compare, udata, scratch, scratch_size);
+
+    allocator_free(vec->allocator, scratch, scratch_size);
+}
+
+/**
+ * Get size of scratch buffer in bytes, required to stable sort given vector.
+ * @param vec
+ * */
+Size vector_stable_sort_scratch_size(Vector* vec) {
+    ERR_RETURN_VALUE_IF_FAIL(vec, 0, ERR_INVALID_ARGUMENTS);
+    return MAX(vec->length / 2, 1) * vec->element_size;
+}
+
+/* vectors smaller than this are sorted sequentially */
+#define PARALLEL_SORT_THRESHOLD (1 << 16)
+
+/* upper limit on number of threads used by a single parallel sort */
+#define PARALLEL_SORT_MAX_THREADS 64
+
+/**
+ * Work done by a single thread in one phase of parallel sort.
+ * In first phase each task sorts a chunk of vector in place.
+ * In following phases each task merges a slice of output of
+ * merging two adjacent sorted runs.
+ * */
+typedef struct ParallelSortTask {
+    SortContext ctx;        /**< Template context, data points to buffer being read. */
+    Byte*       dst;        /**< Buffer merged output is written to. */
+    Size        begin;      /**< Start of first run (chunk to sort in first phase). */
+    Size        mid;        /**< End of first run and start of second run. */
+    Size        end;        /**< End of second run (end of chunk in first phase). */
+    Size        out_begin;  /**< Start of output slice, relative to begin. */
+    Size        out_end;    /**< End of output slice, relative to begin. */
+} ParallelSortTask;
+
+/* parallel sort phase 1 : sort chunks of tasks [begin, end) in place */
+static void parallel_sort_chunk(Size begin, Size end, void* udata) {
+    for(ParallelSortTask* task = (ParallelSortTask*)udata + begin; task < (ParallelSortTask*)udata + end; task++) {
+        SortContext ctx = task->ctx;
+
+        Byte tmp[ctx.element_size];
+        ctx.tmp = tmp;
+
+        Size size = task->end - task->begin;
+        if(size > 1) {
+            pdq_sort_loop(&ctx, task->begin, task->end, 64 - __builtin_clzll(size), True);
+        }
+    }
+}
+
+/**
+ * Find how many elements from first run come in first k elements of merged
+ * output of runs [begin, mid) and [mid, end). On ties first run wins.
+ * */
+static inline Size parallel_sort_co_rank(SortContext* ctx, Size begin, Size mid, Size end, Size k) {
+    Size na = mid - begin;
+    Size nb = end - mid;
+    Size lo = k > nb ? k - nb : 0;
+    Size hi = MIN(k, na);
+
+    while(lo < hi) {
+        Size i = lo + (hi - lo) / 2;
+        Size j = k - i;
+        /* a[i] is placed before b[j-1], so more elements of first run are required */
+        if(j > 0 && !SORT_BEFORE(ctx, mid + j - 1, begin + i)) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+
+    return lo;
+}
+
+/* parallel sort phase 2 : merge a slice of output of two runs */
+static void parallel_sort_merge_slice(ParallelSortTask* task) {
+    SortContext* ctx = &task->ctx;
+    Size esz = ctx->element_size;
+
+    Size i = parallel_sort_co_rank(ctx, task->begin, task->mid, task->end, task->out_begin);
+    Size i_end = parallel_sort_co_rank(ctx, task->begin, task->mid, task->end, task->out_end);
+    Size j = task->out_begin - i;
+    Size j_end = task->out_end - i_end;
+
+    Byte* a     = SORT_ELEM(ctx, task->begin + i);
+    Byte* a_end = SORT_ELEM(ctx, task->begin + i_end);
+    Byte* b     = SORT_ELEM(ctx, task->mid + j);
+    Byte* b_end = SORT_ELEM(ctx, task->mid + j_end);
+    Byte* out   = task->dst + (task->begin + task->out_begin) * esz;
+
+    while(a < a_end && b < b_end) {
+        if(sort_before(ctx, b, a)) {
+            SORT_MOVE(ctx, out, b);
+            b += esz;
+        } else {
+            SORT_MOVE(ctx, out, a);
+            a += esz;
+        }
+        out += esz;
+    }
+
+    memcpy(out, a, a_end - a);
+    out += a_end - a;
+    memcpy(out, b, b_end - b);
+}
+
+static void parallel_sort_merge(Size begin, Size end, void* udata) {
+    for(Size t = begin; t < end; t++) {
+        parallel_sort_merge_slice((ParallelSortTask*)udata + t);
+    }
+}
+
+/**
+ * Sort given vector using multiple threads. Vector is split into one
+ * chunk per thread, each chunk is sorted concurrently using same algorithm
+ * as @c vector_sort, and then sorted chunks are merged pairwise, with
+ * each merge split between threads too. Chunks and merges run as tasks on
+ * @c thread_pool_default.
+ *
+ * Vectors smaller than an internal threshold are sorted sequentially.
+ * Sort is not stable. Compare function must be safe to call from multiple
+ * threads at the same time.
+ *
+ * One scratch buffer of same size as vector is allocated from allocator
+ * of vector.
+ *
+ * @param vec Vector to be sorted
+ * @param compare Compare function. Element a is placed before element b if
+ * compare(a, b) returns a value greater than 0.
+ * @param udata User data to be passed to callback functions.
+ * @param nthreads Number of chunks to split vector in, that many threads
+ * work on it at most. 0 means number of workers of default pool.
+ * */
+void vector_parallel_sort(Vector* vec, CompareElementCallback compare, void* udata, Size nthreads) {
+    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+
+    if(!nthreads) {
+        ThreadPool* pool = thread_pool_default();
+        nthreads = pool ? thread_pool_get_thread_count(pool) : 1;
+    }
+    nthreads = MIN(nthreads, PARALLEL_SORT_MAX_THREADS);
+
+    if(nthreads < 2 || vec->length < PARALLEL_SORT_THRESHOLD) {
+        vector_sort(vec, compare, udata);
+        return;
+    }
+
+    Size n   = vec->length;
+    Size esz = vec->element_size;
+    Byte* scratch = allocator_allocate(vec->allocator, n * esz);
+    if(!scratch) {
+        vector_sort(vec, compare, udata);
+        return;
+    }
+
+    SortContext ctx = {
+        .data         = vec->data,
+        .element_size = esz,
+        .compare      = compare,
+        .udata        = udata,
+        .tmp          = NULL
+    };
+
+    /* phase 1 : one sorted run per thread */
+    ParallelSortTask tasks[PARALLEL_SORT_MAX_THREADS];
+    Size run_bounds[PARALLEL_SORT_MAX_THREADS + 1];
+    Size run_count = nthreads;
+    for(Size t = 0; t < run_count; t++) {
+        run_bounds[t] = n * t / run_count;
+    }
+    run_bounds[run_count] = n;
+
+    for(Size t = 0; t < run_count; t++) {
+        tasks[t] = (ParallelSortTask) {
+            .ctx   = ctx,
+            .begin = run_bounds[t],
+            .end   = run_bounds[t + 1]
+        };
+    }
+    parallel_for(NULL, 0, run_count, 1, parallel_sort_chunk, tasks);
+
+    /* phase 2 : merge adjacent runs until one remains, alternating between buffers */
+    Byte* src = vec->data;
+    Byte* dst = scratch;
+    while(run_count > 1) {
+        Size pair_count = run_count / 2;
+        Size threads_per_pair = MAX(nthreads / pair_count, 1);
+        Size task_count = 0;
+
+        ctx.data = src;
+        for(Size p = 0; p < pair_count; p++) {
+            Size begin = run_bounds[2 * p];
+            Size mid   = run_bounds[2 * p + 1];
+            Size end   = run_bounds[2 * p + 2];
+            Size size  = end - begin;
+
+            for(Size t = 0; t < threads_per_pair; t++) {
+                tasks[task_count++] = (ParallelSortTask) {
+                    .ctx       = ctx,
+                    .dst       = dst,
+                    .begin     = begin,
+                    .mid       = mid,
+                    .end       = end,
+                    .out_begin = size * t / threads_per_pair,
+                    .out_end   = size * (t + 1) / threads_per_pair
+                };
+            }
+        }
+        parallel_for(NULL, 0, task_count, 1, parallel_sort_merge, tasks);
+
+        /* odd run out is carried over as is */
+        if(run_count & 1) {
+            Size begin = run_bounds[run_count - 1];
+            memcpy(dst + begin * esz, src + begin * esz, (n - begin) * esz);
+        }
+
+        /* drop bounds that were merged away */
+        Size new_count = 0;
+        for(Size r = 0; r < run_count; r += 2) {
+            run_bounds[new_count++] = run_bounds[r];
+        }
+        run_bounds[new_count] = n;
+        run_count = new_count;
+
+        Byte* t = src; src = dst; dst = t;
+    }
+
+    if(src != vec->data) {
+        memcpy(vec->data, src, n * esz);
+    }
+
+    allocator_free(vec->allocator, scratch, n * esz);
+}
+
+#undef SORT_BEFORE
+#undef SORT_MOVE
+#undef SORT_ELEM
+
+/* inputs smaller than this are sorted using quicksort instead of radix sort */
+#define RADIX_SORT_THRESHOLD 128
+
+/* quicksort partitions smaller than this are sorted using insertion sort */
+#define SMALL_SORT_THRESHOLD 16
+
+/* convert bit pattern of a value to an unsigned key, that orders same as the value */
+#define UNSIGNED_SORT_KEY(k, utype) (k)
+#define SIGNED_SORT_KEY(k, utype) ((k) ^ ((utype)1 << (sizeof(utype) * 8 - 1)))
+#define FLOAT_SORT_KEY(k, utype) ((k) ^ (((k) >> (sizeof(utype) * 8 - 1)) ? (utype)~(utype)0 : \
+                                         ((utype)1 << (sizeof(utype) * 8 - 1))))
+
+/**
+ * Define comparator free sorts for a numeric type.
+ * Each element is mapped to an unsigned key, flipped when sorting in
+ * descending order, so both quicksort and radix sort only ever compare
+ * or bucket unsigned integers.
+ *
+ * @param sfx Suffix for generated functions.
+ * @param type Type of elements in vector.
+ * @param utype Unsigned integer type of same size as @p type.
+ * @param to_key One of UNSIGNED_SORT_KEY, SIGNED_SORT_KEY or FLOAT_SORT_KEY.
+ * */
+#define DEF_NUMERIC_VECTOR_SORT(sfx, type, utype, to_key)              \
+    static FORCE_INLINE utype sfx##_sort_key(type v, Bool descending) { \
+        utype k;                                                        \
+        memcpy(&k, &v, sizeof(utype));                                  \
+        k = (utype)to_key(k, utype);                                    \
+        return descending ? (utype)~k : k;                              \
+    }                                                                   \
+                                                                        \
+    /**
+     * Partition around median of first, middle and last keys.
+     * @return Split point, no key before it is greater than a key after it.
+     * */                                                               \
+    static FORCE_INLINE Size sfx##_partition(type* data, Size n, Bool descending) { \
+        /* median of three as pivot */                                  \
+        Size mid = n / 2;                                               \
+        if(sfx##_sort_key(data[mid], descending) < sfx##_sort_key(data[0], descending)) { \
+            type t = data[mid]; data[mid] = data[0]; data[0] = t;       \
+        }                                                               \
+        if(sfx##_sort_key(data[n - 1], descending) < sfx##_sort_key(data[mid], descending)) { \
+            type t = data[mid]; data[mid] = data[n - 1]; data[n - 1] = t; \
+            if(sfx##_sort_key(data[mid], descending) < sfx##_sort_key(data[0], descending)) { \
+                t = data[mid]; data[mid] = data[0]; data[0] = t;        \
+            }                                                           \
+        }                                                               \
+        utype pivot = sfx##_sort_key(data[mid], descending);            \
+                                                                        \
+        /* hoare partition */                                           \
+        Size i = 0, j = n - 1;                                          \
+        for(;;) {                                                       \
+            while(sfx##_sort_key(data[i], descending) < pivot) i++;     \
+            while(sfx##_sort_key(data[j], descending) > pivot) j--;     \
+            if(i >= j) break;                                           \
+            type t = data[i]; data[i] = data[j]; data[j] = t;           \
+            i++; j--;                                                   \
+        }                                                               \
+        return j + 1;                                                   \
+    }                                                                   \
+                                                                        \
+    /* quicksort with inlined compare, only used for small inputs, so no depth limit is required */ \
+    static void sfx##_small_sort(type* data, Size n, Bool descending) { \
+        while(n > SMALL_SORT_THRESHOLD) {                               \
+            Size split = sfx##_partition(data, n, descending);          \
+                                                                        \
+            /* recurse into smaller side, loop over larger one */       \
+            if(split < n - split) {                                     \
+                sfx##_small_sort(data, split, descending);              \
+                data += split;                                          \
+                n    -= split;                                          \
+            } else {                                                    \
+                sfx##_small_sort(data + split, n - split, descending);  \
+                n = split;                                              \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        for(Size s = 1; s < n; s++) {                                   \
+            type  v = data[s];                                          \
+            utype k = sfx##_sort_key(v, descending);                    \
+            Size  m = s;                                                \
+            while(m > 0 && k < sfx##_sort_key(data[m - 1], descending)) { \
+                data[m] = data[m - 1];                                  \
+                m--;                                                    \
+            }                                                           \
+            data[m] = v;                                                \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    /* LSD radix sort, one byte per pass. Passes where all keys share same digit are skipped. */ \
+    static Bool sfx##_radix_sort(type* data, Size n, Bool descending, Allocator* allocator) { \
+        type* buf = allocator_allocate(allocator, n * sizeof(type));    \
+        if(!buf) return False;                                          \
+                                                                        \
+        /* histogram of all digits is computed in a single scan */     \
+        Size counts[sizeof(type)][256];                                 \
+        memset(counts, 0, sizeof(counts));                              \
+        for(Size s = 0; s < n; s++) {                                   \
+            utype k = sfx##_sort_key(data[s], descending);              \
+            for(Size b = 0; b < sizeof(type); b++) {                    \
+                counts[b][(k >> (b * 8)) & 0xff]++;                     \
+            }                                                           \
+        }                                                               \
+                                                                        \
+        type* src = data;                                               \
+        type* dst = buf;                                                \
+        for(Size b = 0; b < sizeof(type); b++) {                        \
+            Size* cnt = counts[b];                                      \
+            if(cnt[(sfx##_sort_key(src[0], descending) >> (b * 8)) & 0xff] == n) continue; \
+                                                                        \
+            /* convert counts to starting offsets of each digit */      \
+            Size offset = 0;                                            \
+            for(Size d = 0; d < 256; d++) {                             \
+                Size c = cnt[d];                                        \
+                cnt[d] = offset;                                        \
+                offset += c;                                            \
+            }                                                           \
+                                                                        \
+            for(Size s = 0; s < n; s++) {                               \
+                utype k = sfx##_sort_key(src[s], descending);           \
+                dst[cnt[(k >> (b * 8)) & 0xff]++] = src[s];             \
+            }                                                           \
+                                                                        \
+            type* t = src; src = dst; dst = t;                          \
+        }                                                               \
+                                                                        \
+        if(src != data) {                                               \
+            memcpy(data, src, n * sizeof(type));                        \
+        }                                                               \
+                                                                        \
+        allocator_free(allocator, buf, n * sizeof(type));               \
+        return True;                                                    \
+    }                                                                   \
+                                                                        \
+    /**
+     * Sort vector of numeric type without a compare callback.
+     * Uses radix sort for large vectors, and quicksort for small ones.
+     * @param vec
+     * @param descending Sort in descending order if True, ascending otherwise.
+     * */                                                               \
+    void vector_sort_##sfx(Vector* vec, Bool descending) {              \
+        ERR_RETURN_IF_FAIL(vec && vec->element_size == sizeof(type), ERR_INVALID_ARGUMENTS); \
+        if(vec->length < 2) return;                                     \
+                                                                        \
+        type* data = (type*)vec->data;                                  \
+        if(vec->length < RADIX_SORT_THRESHOLD ||                        \
+           !sfx##_radix_sort(data, vec->length, descending, vec->allocator)) { \
+            sfx##_small_sort(data, vec->length, descending);            \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    /* sort n elements at data, the same way vector_sort_<sfx> does */  \
+    static FORCE_INLINE void sfx##_sort_range(type* data, Size n, Bool descending, Allocator* allocator) { \
+        if(n < RADIX_SORT_THRESHOLD || !sfx##_radix_sort(data, n, descending, allocator)) { \
+            sfx##_small_sort(data, n, descending);                      \
+        }                                                               \
+    }                                                                   \
+                                                                        \
+    /**
+     * Quickselect with inlined compare. Partition holding @p nth is radix
+     * sorted instead when too many partitions are unbalanced.
+     * */                                                               \
+    static void sfx##_select(type* data, Size n, Size nth, Bool descending, Allocator* allocator) { \
+        Size bad_allowed = 64 - __builtin_clzll(n);                     \
+        while(n > SMALL_SORT_THRESHOLD) {                               \
+            Size split = sfx##_partition(data, n, descending);          \
+            if((split < n / 8 || n - split < n / 8) && --bad_allowed == 0) { \
+                sfx##_sort_range(data, n, descending, allocator);      \
+                return;                                                 \
+            }                                                           \
+                                                                        \
+            if(nth < split) {                                           \
+                n = split;                                              \
+            } else {                                                    \
+                data += split;                                          \
+                nth  -= split;                                          \
+                n    -= split;                                          \
+            }                                                           \
+        }                                                               \
+        sfx##_small_sort(data, n, descending);                          \
+    }                                                                   \
+                                                                        \
+    /**
+     * Comparator free @c vector_nth_element.
+     * @param vec
+     * @param nth Position of element to be selected. Must be less than length.
+     * @param descending Select in descending order if True, ascending otherwise.
+     * */                                                               \
+    void vector_nth_element_##sfx(Vector* vec, Size nth, Bool descending) { \
+        ERR_RETURN_IF_FAIL(vec && vec->element_size == sizeof(type) && nth < vec->length, ERR_INVALID_ARGUMENTS); \
+        sfx##_select((type*)vec->data, vec->length, nth, descending, vec->allocator); \
+    }                                                                   \
+                                                                        \
+    /**
+     * Comparator free @c vector_partial_sort.
+     * @param vec
+     * @param count Number of elements to sort. Values larger than length sort whole vector.
+     * @param descending Sort in descending order if True, ascending otherwise.
+     * */                                                               \
+    void vector_partial_sort_##sfx(Vector* vec, Size count, Bool descending) { \
+        ERR_RETURN_IF_FAIL(vec && vec->element_size == sizeof(type), ERR_INVALID_ARGUMENTS); \
+        count = MIN(count, vec->length);                                \
+        if(!count) return;                                              \
+                                                                        \
+        type* data = (type*)vec->data;                                  \
+        if(count < vec->length) {                                       \
+            sfx##_select(data, vec->length, count - 1, descending, vec->allocator); \
+            count--;                                                    \
+        }                                                               \
+        sfx##_sort_range(data, count, descending, vec->allocator);     \
+    }
+
+DEF_NUMERIC_VECTOR_SORT(u8,  Uint8,   Uint8,  UNSIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(u16, Uint16,  Uint16, UNSIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(u32, Uint32,  Uint32, UNSIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(u64, Uint64,  Uint64, UNSIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(i8,  Int8,    Uint8,  SIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(i16, Int16,   Uint16, SIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(i32, Int32,   Uint32, SIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(i64, Int64,   Uint64, SIGNED_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(f32, Float32, Uint32, FLOAT_SORT_KEY)
+DEF_NUMERIC_VECTOR_SORT(f64, Float64, Uint64, FLOAT_SORT_KEY)
+
+#undef DEF_NUMERIC_VECTOR_SORT
+
+/**
+ * Check whether the array is sorted in any manner
+ * By default the algorithm is written for checking array in descending order,
+ * but this can be checked for any array type by modifying the compare method.
+ *
+ * This means if compare returns > 0 for any comparision then array is not sorted
+ *
+ * @param vec
+ * @param compare
+ * @param udata User data to be passed to callback functions.
+ * */
+Bool vector_check_sorted(Vector* vec, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && compare, False, ERR_INVALID_ARGUMENTS);
+    for(Size s = 1; s < vec->length; s++) {
+        if(compare(vector_peek_unchecked(vec, s), vector_peek_unchecked(vec, s-1), udata) > 0) {
+            return False;
+        }
+    }
+    return True;
+}
+
+/**
+ * Use insertion sort mechanism to sort this array.
+ * Time complexity:
+ * BEST : O(n)
+ * AVERAGE : O(n^2)
+ * WORST : O(n^2)
+ * @param vec
+ * @param compare Compare function
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_insertion_sort(Vector* vec, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+
+    for(Size s = 1; s < vec->length; s++) {
+        Size m = s;
+        while((m > 0) && (compare(vector_peek_unchecked(vec, m), vector_peek_unchecked(vec, m-1), udata) > 0)) {
+            vector_swap(vec, m, m-1); m--;
+        }
+    }
+}
+
+/**
+ * Bubble sort algorithm.
+ * @param vec
+ * @param compare
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_bubble_sort(Vector* vec, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
+
+    Bool b_swapped;
+    for (Size i = 0; i < vec->length; i++) {
+        b_swapped = False;
+        for (Size j = 0; j < vec->length-1; j++) {
+            if (compare(vector_peek_unchecked(vec, j+1), vector_peek_unchecked(vec, j), udata) > 0) {
+                vector_swap(vec, j, j+1);
+                b_swapped = True;
+            }
+        }
+        if (!b_swapped)
+            break;
+    }
+}
 
 /**
- * Merge sort algorithm
+ * Merge sort algorithm. Same as @c vector_stable_sort.
  * @param vec
  * @param compare
  * @param udata User data to be passed to callback functions.
  * */
 void vector_merge_sort(Vector* vec, CompareElementCallback compare, void* udata) {
     ERR_RETURN_IF_FAIL(vec && compare, ERR_INVALID_ARGUMENTS);
-    merge_sort_sort(vec, compare, 0, vec->length, udata);
+    vector_stable_sort(vec, compare, udata);
 }
 
 /**
@@ -943,22 +2344,25 @@ void vector_create_copy(void* dst, void* src, void* udata) {
     Vector* vec_src = (Vector*)(src);
 
     // allocate space for storing array
-    vec_dst->data = ALLOCATE(Uint8, vec_src->element_size * vec_src->length);
+    Size capacity = MAX(vec_src->length, VECTOR_INIT_ELEMENT_COUNT);
+    vec_dst->data = allocator_allocate_zeroed(vec_src->allocator, vec_src->element_size * capacity);
     ERR_RETURN_IF_FAIL(vec_dst->data, ERR_OUT_OF_MEMORY);
 
     // initialize vector with basic data
     // note how length and capacity are initialized
     vec_dst->length        = 0;
-    vec_dst->capacity      = vec_src->length;
+    vec_dst->capacity      = capacity;
+    vec_dst->allocator     = vec_src->allocator;
     vec_dst->element_size  = vec_src->element_size;
     vec_dst->create_copy   = vec_src->create_copy;
     vec_dst->destroy_copy  = vec_src->destroy_copy;
     vec_dst->resize_factor = vec_src->resize_factor;
+    vec_dst->growth_policy = vec_src->growth_policy;
 
     // insert each element one by one
     // essentially using the copy constructors in src vector
-    for(Size s = 0; s < vec_dst->length; s++) {
-        vector_push_back(vec_dst, vector_peek(vec_src, s), udata);
+    for(Size s = 0; s < vec_src->length; s++) {
+        vector_push_back(vec_dst, vector_peek_unchecked(vec_src, s), udata);
     }
 }
 
@@ -972,7 +2376,835 @@ void vector_destroy_copy(void* copy, void* udata) {
 
     Vector* vec_copy = (Vector*)copy;
 
+    // all memory will be released by allocator at once
+    if(!allocator_needs_free(vec_copy->allocator)) {
+        return;
+    }
+
     if(vec_copy->length) vector_clear(vec_copy, udata);
-    FREE(vec_copy->data);
+    allocator_free(vec_copy->allocator, vec_copy->data, vec_copy->capacity * vec_copy->element_size);
     vec_copy->data = NULL;
 }
+
+/*------------------------------ VECTOR VIEWS -------------------------------*/
+
+/**
+ * Create a view over an array of elements. View does not own the array.
+ *
+ * @param data Array of elements. Can be NULL only if @p length is 0.
+ * @param length Number of elements in array.
+ * @param element_size Size of each element in array.
+ * */
+VectorView vector_view_from_array(void* data, Size length, Size element_size) {
+    VectorView view = {0};
+    ERR_RETURN_VALUE_IF_FAIL(element_size && (data || !length), view, ERR_INVALID_ARGUMENTS);
+
+    view.element_size = element_size;
+    view.length       = length;
+    view.data         = data;
+
+    return view;
+}
+
+/**
+ * Get a view over elements [start, start + size) of given vector.
+ * No memory is allocated and no copy constructor is called.
+ * View stays valid only until vector is resized, cleared or destroyed.
+ *
+ * @param vec
+ * @param start Position of first element in view.
+ * @param size Number of elements in view.
+ * */
+VectorView vector_get_view(Vector* vec, Size start, Size size) {
+    VectorView view = {0};
+    ERR_RETURN_VALUE_IF_FAIL(vec, view, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(start <= vec->length && size <= vec->length - start, view, ERR_INVALID_INDEX);
+
+    view.element_size = vec->element_size;
+    view.length       = size;
+    view.data         = vector_address_at(vec, start);
+
+    return view;
+}
+
+/**
+ * Get a view over elements [start, start + size) of another view.
+ *
+ * @param view
+ * @param start Position of first element in sub-view, relative to @p view.
+ * @param size Number of elements in sub-view.
+ * */
+VectorView vector_view_slice(VectorView view, Size start, Size size) {
+    VectorView slice = {0};
+    ERR_RETURN_VALUE_IF_FAIL(start <= view.length && size <= view.length - start, slice, ERR_INVALID_INDEX);
+
+    slice.element_size = view.element_size;
+    slice.length       = size;
+    slice.data         = vector_view_address_at(&view, start);
+
+    return slice;
+}
+
+/**
+ * Peek value at given position in view.
+ * Follows same semantics as @c vector_peek.
+ *
+ * @param view
+ * @param pos
+ * */
+void* vector_view_peek(VectorView* view, Size pos) {
+    ERR_RETURN_VALUE_IF_FAIL(view, NULL, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(pos < view->length, NULL, ERR_INVALID_INDEX);
+
+    return element_value(vector_view_address_at(view, pos), view->element_size);
+}
+
+/**
+ * Peek first element of view.
+ * @param view
+ * */
+void* vector_view_front(VectorView* view) {
+    return vector_view_peek(view, 0);
+}
+
+/**
+ * Peek last element of view.
+ * @param view
+ * */
+void* vector_view_back(VectorView* view) {
+    ERR_RETURN_VALUE_IF_FAIL(view && view->length, NULL, ERR_INVALID_ARGUMENTS);
+    return vector_view_peek(view, view->length - 1);
+}
+
+/**
+ * Print all elements of view using given printer.
+ * Printer is called in order, so this can also be used to iterate over view.
+ *
+ * @param view
+ * @param printer Function to call for each element.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_view_print(VectorView* view, PrintElementCallback printer, void* udata) {
+    ERR_RETURN_IF_FAIL(view && printer, ERR_INVALID_ARGUMENTS);
+
+    for(Size iter = 0; iter < view->length; iter++) {
+        printer(element_value(vector_view_address_at(view, iter), view->element_size), iter, udata);
+    }
+}
+
+/**
+ * Find first element in view for which @p compare returns 0.
+ * This is a linear search.
+ *
+ * @param view
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Compare function, called as compare(element, data, udata).
+ * @param udata User data to be passed to callback functions.
+ * @return Position of element in view if found.
+ * @return SIZE_MAX otherwise.
+ * */
+Size vector_view_find(VectorView* view, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(view && compare, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    for(Size iter = 0; iter < view->length; iter++) {
+        if(!compare(element_value(vector_view_address_at(view, iter), view->element_size), data, udata)) {
+            return iter;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * Find first element in a view sorted using @p compare, that is not
+ * placed before @p data.
+ *
+ * @param view
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Same compare function view was sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return Position of found element, or length of view if there's none.
+ * */
+Size vector_view_lower_bound(VectorView* view, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(view && compare, 0, ERR_INVALID_ARGUMENTS);
+
+    Size lo = 0, hi = view->length;
+    while(lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if(compare(element_value(vector_view_address_at(view, mid), view->element_size), data, udata) > 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * Find first element in a view sorted using @p compare, before which
+ * @p data must be placed.
+ *
+ * @param view
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Same compare function view was sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return Position of found element, or length of view if there's none.
+ * */
+Size vector_view_upper_bound(VectorView* view, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(view && compare, 0, ERR_INVALID_ARGUMENTS);
+
+    Size lo = 0, hi = view->length;
+    while(lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if(compare(data, element_value(vector_view_address_at(view, mid), view->element_size), udata) > 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * Binary search for an element in a view sorted using @p compare.
+ * If multiple elements compare equal to @p data, position of first one
+ * is returned.
+ *
+ * @param view
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Same compare function view was sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return Position of element in view if found.
+ * @return SIZE_MAX otherwise.
+ * */
+Size vector_view_binary_search(VectorView* view, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(view && compare, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    Size pos = vector_view_lower_bound(view, data, compare, udata);
+    if(pos < view->length &&
+       !compare(element_value(vector_view_address_at(view, pos), view->element_size), data, udata)) {
+        return pos;
+    }
+
+    return SIZE_MAX;
+}
+
+/* a vector header aliasing viewed elements, never to be resized or destroyed */
+static FORCE_INLINE Vector vector_view_as_vector(VectorView* view) {
+    Vector vec = {
+        .element_size = view->element_size,
+        .length       = view->length,
+        .capacity     = view->length,
+        .data         = view->data
+    };
+    return vec;
+}
+
+/**
+ * Sort elements of view in place, in parent buffer.
+ * Same as @c vector_sort.
+ *
+ * @param view
+ * @param compare Compare function.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_view_sort(VectorView* view, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(view && compare, ERR_INVALID_ARGUMENTS);
+
+    Vector vec = vector_view_as_vector(view);
+    vector_sort(&vec, compare, udata);
+}
+
+/**
+ * Stable sort elements of view in place, in parent buffer.
+ * Same as @c vector_stable_sort. Scratch memory comes from system allocator.
+ *
+ * @param view
+ * @param compare Compare function.
+ * @param udata User data to be passed to callback functions.
+ * */
+void vector_view_stable_sort(VectorView* view, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_IF_FAIL(view && compare, ERR_INVALID_ARGUMENTS);
+
+    Vector vec = vector_view_as_vector(view);
+    vector_stable_sort(&vec, compare, udata);
+}
+
+/**
+ * Check whether elements of view are sorted.
+ * Same as @c vector_check_sorted.
+ *
+ * @param view
+ * @param compare Compare function.
+ * @param udata User data to be passed to callback functions.
+ * */
+Bool vector_view_check_sorted(VectorView* view, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(view && compare, False, ERR_INVALID_ARGUMENTS);
+
+    Vector vec = vector_view_as_vector(view);
+    return vector_check_sorted(&vec, compare, udata);
+}
+
+/*----------------------------- SORTED VECTORS ------------------------------*/
+
+/**
+ * Find first element in a vector sorted using @p compare, that is not
+ * placed before @p data. Same as C++'s @c std::lower_bound.
+ *
+ * @param vec
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Same compare function vector was sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return Position of found element, or length of vector if there's none.
+ * */
+Size vector_lower_bound(Vector* vec, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && compare, 0, ERR_INVALID_ARGUMENTS);
+
+    VectorView view = vector_get_view(vec, 0, vec->length);
+    return vector_view_lower_bound(&view, data, compare, udata);
+}
+
+/**
+ * Find first element in a vector sorted using @p compare, before which
+ * @p data must be placed. Same as C++'s @c std::upper_bound.
+ *
+ * @param vec
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Same compare function vector was sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return Position of found element, or length of vector if there's none.
+ * */
+Size vector_upper_bound(Vector* vec, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && compare, 0, ERR_INVALID_ARGUMENTS);
+
+    VectorView view = vector_get_view(vec, 0, vec->length);
+    return vector_view_upper_bound(&view, data, compare, udata);
+}
+
+/**
+ * Binary search for an element in a vector sorted using @p compare.
+ * If multiple elements compare equal to @p data, position of first one
+ * is returned.
+ *
+ * @param vec
+ * @param data Element to search for, passed the same way as to @c vector_push_back.
+ * @param compare Same compare function vector was sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return Position of element if found.
+ * @return SIZE_MAX otherwise.
+ * */
+Size vector_binary_search(Vector* vec, void* data, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && compare, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    VectorView view = vector_get_view(vec, 0, vec->length);
+    return vector_view_binary_search(&view, data, compare, udata);
+}
+
+/**
+ * Comparator free searches over vectors sorted in ascending order.
+ * Search is branchless : the loop always runs log2(n) times, and instead of
+ * a branch, a conditional move picks the next half. Both possible next
+ * probes are prefetched, because it's not known yet which one will be taken.
+ * */
+#define DEF_NUMERIC_VECTOR_SEARCH(sfx, type)                            \
+    static FORCE_INLINE Size sfx##_search(Vector* vec, type value, Bool upper) { \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type), 0, ERR_INVALID_ARGUMENTS); \
+        if(!vec->length) return 0;                                      \
+                                                                        \
+        const type* data = (const type*)vec->data;                      \
+        const type* base = data;                                        \
+        Size        n    = vec->length;                                 \
+        while(n > 1) {                                                  \
+            Size half = n / 2;                                          \
+            __builtin_prefetch(base + half / 2);                        \
+            __builtin_prefetch(base + half + half / 2);                 \
+            base = (upper ? base[half] <= value : base[half] < value) ? base + half : base; \
+            n -= half;                                                  \
+        }                                                               \
+                                                                        \
+        return (Size)(base - data) + (upper ? *base <= value : *base < value); \
+    }                                                                   \
+                                                                        \
+    Size vector_lower_bound_##sfx(Vector* vec, type value) {            \
+        return sfx##_search(vec, value, False);                         \
+    }                                                                   \
+                                                                        \
+    Size vector_upper_bound_##sfx(Vector* vec, type value) {            \
+        return sfx##_search(vec, value, True);                          \
+    }                                                                   \
+                                                                        \
+    Size vector_binary_search_##sfx(Vector* vec, type value) {          \
+        Size pos = sfx##_search(vec, value, False);                     \
+        return (vec && pos < vec->length && ((type*)vec->data)[pos] == value) ? pos : SIZE_MAX; \
+    }
+
+DEF_NUMERIC_VECTOR_SEARCH(u8,  Uint8)
+DEF_NUMERIC_VECTOR_SEARCH(u16, Uint16)
+DEF_NUMERIC_VECTOR_SEARCH(u32, Uint32)
+DEF_NUMERIC_VECTOR_SEARCH(u64, Uint64)
+DEF_NUMERIC_VECTOR_SEARCH(i8,  Int8)
+DEF_NUMERIC_VECTOR_SEARCH(i16, Int16)
+DEF_NUMERIC_VECTOR_SEARCH(i32, Int32)
+DEF_NUMERIC_VECTOR_SEARCH(i64, Int64)
+DEF_NUMERIC_VECTOR_SEARCH(f32, Float32)
+DEF_NUMERIC_VECTOR_SEARCH(f64, Float64)
+
+#undef DEF_NUMERIC_VECTOR_SEARCH
+
+/* element at given position of vector, passed the way compare callback expects it */
+#define SORTED_PEEK(vec, pos) element_value(vector_address_at(vec, pos), (vec)->element_size)
+
+/**
+ * Find first position in [lo, hi) of @p vec whose element is not placed before
+ * @p key, or when @p upper is set, before which @p key must be placed.
+ * Positions lo, lo + 1, lo + 3, lo + 7, ... are probed first, and then the last
+ * gap is binary searched. This takes O(log d) compares, where d is distance of
+ * result from @p lo, so walking a sequence with this never costs more than a
+ * linear merge, but skips long runs in logarithmic time.
+ * */
+static Size gallop(Vector* vec, Size lo, Size hi, void* key, Bool upper, CompareElementCallback compare, void* udata) {
+#define GALLOP_GOES_LEFT(pos) (upper ? !(compare(key, SORTED_PEEK(vec, pos), udata) > 0) \
+                                     : compare(SORTED_PEEK(vec, pos), key, udata) > 0)
+    Size left  = lo;
+    Size bound = 1;
+    while(lo + bound - 1 < hi && GALLOP_GOES_LEFT(lo + bound - 1)) {
+        left   = lo + bound;
+        bound *= 2;
+    }
+
+    Size right = MIN(lo + bound - 1, hi);
+    while(left < right) {
+        Size mid = left + (right - left) / 2;
+        if(GALLOP_GOES_LEFT(mid)) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+#undef GALLOP_GOES_LEFT
+
+    return left;
+}
+
+/* create an empty vector to store result of a set operation on given vector */
+static Vector* sorted_result_create(Vector* vec, Size capacity) {
+    Vector* result = vector_create_with_allocator(vec->element_size, vec->create_copy, vec->destroy_copy, vec->allocator);
+    ERR_RETURN_VALUE_IF_FAIL(result, NULL, ERR_OUT_OF_MEMORY);
+
+    if(capacity) vector_reserve(result, capacity);
+    return result;
+}
+
+/* append elements [from, to) of src to dst */
+static FORCE_INLINE void sorted_append_run(Vector* dst, Vector* src, Size from, Size to, void* udata) {
+    if(from < to) vector_push_back_n(dst, vector_address_at(src, from), to - from, udata);
+}
+
+/**
+ * Merge two vectors sorted using @p compare, into a new sorted vector.
+ * Like C++'s @c std::set_union : if an element is present m times in @p vec
+ * and n times in @p other, then it's present max(m, n) times in result, and
+ * equal elements are taken from @p vec first.
+ *
+ * Runs are found by galloping through one vector with elements of the other,
+ * so merging a small vector into a large one costs O(m log(n/m)) compares.
+ * Result is created with allocator and callbacks of @p vec.
+ *
+ * @param vec
+ * @param other Must have same element size as @p vec.
+ * @param compare Compare function both vectors are sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return New vector on success.
+ * @return NULL otherwise.
+ * */
+Vector* vector_sorted_union(Vector* vec, Vector* other, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && other && compare && vec->element_size == other->element_size,
+                             NULL, ERR_INVALID_ARGUMENTS);
+
+    Vector* result = sorted_result_create(vec, vec->length + other->length);
+    if(!result) return NULL;
+
+    Size i = 0, j = 0;
+    if(vec->length <= other->length) {
+        for(; i < vec->length; i++) {
+            void* key = SORTED_PEEK(vec, i);
+
+            /* everything in other before this element comes first */
+            Size end = gallop(other, j, other->length, key, False, compare, udata);
+            sorted_append_run(result, other, j, end, udata);
+            if(end < other->length && !compare(SORTED_PEEK(other, end), key, udata)) end++;
+            j = end;
+
+            vector_push_back(result, key, udata);
+        }
+    } else {
+        for(; j < other->length; j++) {
+            void* key = SORTED_PEEK(other, j);
+
+            /* everything in vec before this element comes first */
+            Size end = gallop(vec, i, vec->length, key, False, compare, udata);
+            sorted_append_run(result, vec, i, end, udata);
+            if(end < vec->length && !compare(SORTED_PEEK(vec, end), key, udata)) {
+                vector_push_back(result, SORTED_PEEK(vec, end), udata);
+                end++;
+            } else {
+                vector_push_back(result, key, udata);
+            }
+            i = end;
+        }
+    }
+
+    sorted_append_run(result, vec, i, vec->length, udata);
+    sorted_append_run(result, other, j, other->length, udata);
+
+    return result;
+}
+
+/**
+ * Intersect two vectors sorted using @p compare, into a new sorted vector.
+ * Like C++'s @c std::set_intersection : if an element is present m times in
+ * @p vec and n times in @p other, then it's present min(m, n) times in result.
+ * Elements are always copied from @p vec.
+ *
+ * Smaller vector is walked, and larger one is galloped through, so this
+ * costs O(m log(n/m)) compares for sizes m <= n.
+ * Result is created with allocator and callbacks of @p vec.
+ *
+ * @param vec
+ * @param other Must have same element size as @p vec.
+ * @param compare Compare function both vectors are sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return New vector on success.
+ * @return NULL otherwise.
+ * */
+Vector* vector_sorted_intersect(Vector* vec, Vector* other, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && other && compare && vec->element_size == other->element_size,
+                             NULL, ERR_INVALID_ARGUMENTS);
+
+    Vector* result = sorted_result_create(vec, MIN(vec->length, other->length));
+    if(!result) return NULL;
+
+    Size i = 0, j = 0;
+    if(vec->length <= other->length) {
+        for(; i < vec->length && j < other->length; i++) {
+            void* key = SORTED_PEEK(vec, i);
+            j = gallop(other, j, other->length, key, False, compare, udata);
+            if(j < other->length && !compare(SORTED_PEEK(other, j), key, udata)) {
+                vector_push_back(result, key, udata);
+                j++;
+            }
+        }
+    } else {
+        for(; j < other->length && i < vec->length; j++) {
+            void* key = SORTED_PEEK(other, j);
+            i = gallop(vec, i, vec->length, key, False, compare, udata);
+            if(i < vec->length && !compare(SORTED_PEEK(vec, i), key, udata)) {
+                vector_push_back(result, SORTED_PEEK(vec, i), udata);
+                i++;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Get elements of @p vec that are not in @p other, both sorted using @p compare.
+ * Like C++'s @c std::set_difference : if an element is present m times in
+ * @p vec and n times in @p other, then it's present max(m - n, 0) times in result.
+ *
+ * Smaller vector is walked, and larger one is galloped through, so this
+ * costs O(m log(n/m)) compares for sizes m <= n.
+ * Result is created with allocator and callbacks of @p vec.
+ *
+ * @param vec
+ * @param other Must have same element size as @p vec.
+ * @param compare Compare function both vectors are sorted with.
+ * @param udata User data to be passed to callback functions.
+ * @return New vector on success.
+ * @return NULL otherwise.
+ * */
+Vector* vector_sorted_difference(Vector* vec, Vector* other, CompareElementCallback compare, void* udata) {
+    ERR_RETURN_VALUE_IF_FAIL(vec && other && compare && vec->element_size == other->element_size,
+                             NULL, ERR_INVALID_ARGUMENTS);
+
+    Vector* result = sorted_result_create(vec, vec->length);
+    if(!result) return NULL;
+
+    Size i = 0, j = 0;
+    if(vec->length <= other->length) {
+        for(; i < vec->length; i++) {
+            void* key = SORTED_PEEK(vec, i);
+            j = gallop(other, j, other->length, key, False, compare, udata);
+            if(j < other->length && !compare(SORTED_PEEK(other, j), key, udata)) {
+                j++;
+            } else {
+                vector_push_back(result, key, udata);
+            }
+        }
+    } else {
+        for(; j < other->length && i < vec->length; j++) {
+            void* key = SORTED_PEEK(other, j);
+
+            /* everything before this element survives */
+            Size end = gallop(vec, i, vec->length, key, False, compare, udata);
+            sorted_append_run(result, vec, i, end, udata);
+            if(end < vec->length && !compare(SORTED_PEEK(vec, end), key, udata)) end++;
+            i = end;
+        }
+        sorted_append_run(result, vec, i, vec->length, udata);
+    }
+
+    return result;
+}
+
+#undef SORTED_PEEK
+
+/*---------------------- NUMERIC SEARCHES AND REDUCTIONS ----------------------*/
+
+/**
+ * SIMD kernels for numeric scans. Every kernel processes only whole registers
+ * from start of given array, and reports number of elements it consumed,
+ * so caller can finish remaining tail with scalar code. When SIMD is not
+ * enabled all kernels consume nothing.
+ *
+ * Kernels take untyped arrays so that a kernel can be picked for a type
+ * just by it's name.
+ * */
+#if SIMD_ENABLED
+
+#define LANES(type) (SIMD_VECTOR_REGISTER_SIZE / sizeof(type))
+
+/* equality scans work for both signed and unsigned integers of same size */
+#define DEF_SIMD_EQ_SCAN(bits)                                          \
+    static inline Size simd_find_epi##bits(const void* data, Size n, const void* value, Size* consumed) { \
+        const Int##bits* arr = data;                                    \
+        MVec needle = simd_set1_epi##bits(*(const Int##bits*)value);    \
+        Size i = 0;                                                     \
+        for(; i + LANES(Int##bits) <= n; i += LANES(Int##bits)) {       \
+            MMask m = simd_movemask_epi8(simd_cmpeq_epi##bits(simd_loadu(arr + i), needle)); \
+            if(m) {                                                     \
+                *consumed = i;                                          \
+                return i + simd_tzcnt(m) / sizeof(Int##bits);           \
+            }                                                           \
+        }                                                               \
+        *consumed = i;                                                  \
+        return SIZE_MAX;                                                \
+    }                                                                   \
+                                                                        \
+    static inline Size simd_count_epi##bits(const void* data, Size n, const void* value, Size* consumed) { \
+        const Int##bits* arr = data;                                    \
+        MVec needle = simd_set1_epi##bits(*(const Int##bits*)value);    \
+        Size count = 0, i = 0;                                          \
+        for(; i + LANES(Int##bits) <= n; i += LANES(Int##bits)) {       \
+            MMask m = simd_movemask_epi8(simd_cmpeq_epi##bits(simd_loadu(arr + i), needle)); \
+            count += (Size)__builtin_popcountll((Uint64)m);             \
+        }                                                               \
+        *consumed = i;                                                  \
+        return count / sizeof(Int##bits);                               \
+    }
+
+DEF_SIMD_EQ_SCAN(8)
+DEF_SIMD_EQ_SCAN(16)
+DEF_SIMD_EQ_SCAN(32)
+DEF_SIMD_EQ_SCAN(64)
+
+#undef DEF_SIMD_EQ_SCAN
+
+/* reduce lanes of registers with given lane wise operation, then reduce lanes of result */
+#define DEF_SIMD_REDUCE(name, op, type, scalar_op)                      \
+    static inline Bool simd_reduce_##name(const void* data, Size n, void* result, Size* consumed) { \
+        const type* arr = data;                                         \
+        if(n < LANES(type)) {                                           \
+            *consumed = 0;                                              \
+            return False;                                               \
+        }                                                               \
+                                                                        \
+        MVec acc = simd_loadu(arr);                                     \
+        Size i = LANES(type);                                           \
+        for(; i + LANES(type) <= n; i += LANES(type)) {                 \
+            acc = op(acc, simd_loadu(arr + i));                         \
+        }                                                               \
+                                                                        \
+        type lanes[LANES(type)];                                        \
+        simd_storeu(lanes, acc);                                        \
+        type r = lanes[0];                                              \
+        for(Size l = 1; l < LANES(type); l++) {                         \
+            r = scalar_op(r, lanes[l]);                                 \
+        }                                                               \
+                                                                        \
+        *(type*)result = r;                                             \
+        *consumed = i;                                                  \
+        return True;                                                    \
+    }
+
+#define SCALAR_ADD(a, b) ((a) + (b))
+
+DEF_SIMD_REDUCE(min_epu8,  simd_min_epu8,  Uint8,  MIN)
+DEF_SIMD_REDUCE(min_epu16, simd_min_epu16, Uint16, MIN)
+DEF_SIMD_REDUCE(min_epu32, simd_min_epu32, Uint32, MIN)
+DEF_SIMD_REDUCE(max_epu8,  simd_max_epu8,  Uint8,  MAX)
+DEF_SIMD_REDUCE(max_epu16, simd_max_epu16, Uint16, MAX)
+DEF_SIMD_REDUCE(max_epu32, simd_max_epu32, Uint32, MAX)
+DEF_SIMD_REDUCE(min_epi8,  simd_min_epi8,  Int8,   MIN)
+DEF_SIMD_REDUCE(min_epi16, simd_min_epi16, Int16,  MIN)
+DEF_SIMD_REDUCE(min_epi32, simd_min_epi32, Int32,  MIN)
+DEF_SIMD_REDUCE(max_epi8,  simd_max_epi8,  Int8,   MAX)
+DEF_SIMD_REDUCE(max_epi16, simd_max_epi16, Int16,  MAX)
+DEF_SIMD_REDUCE(max_epi32, simd_max_epi32, Int32,  MAX)
+DEF_SIMD_REDUCE(sum_epi64, simd_add_epi64, Uint64, SCALAR_ADD)
+
+#undef SCALAR_ADD
+#undef DEF_SIMD_REDUCE
+#undef LANES
+
+#else
+
+static inline Size simd_find_none(const void* data, Size n, const void* value, Size* consumed) {
+    UNUSED(data); UNUSED(n); UNUSED(value);
+    *consumed = 0;
+    return SIZE_MAX;
+}
+
+static inline Size simd_count_none(const void* data, Size n, const void* value, Size* consumed) {
+    UNUSED(data); UNUSED(n); UNUSED(value);
+    *consumed = 0;
+    return 0;
+}
+
+#define simd_find_epi8   simd_find_none
+#define simd_find_epi16  simd_find_none
+#define simd_find_epi32  simd_find_none
+#define simd_find_epi64  simd_find_none
+#define simd_count_epi8  simd_count_none
+#define simd_count_epi16 simd_count_none
+#define simd_count_epi32 simd_count_none
+#define simd_count_epi64 simd_count_none
+
+#define simd_reduce_min_epu8  simd_reduce_none
+#define simd_reduce_min_epu16 simd_reduce_none
+#define simd_reduce_min_epu32 simd_reduce_none
+#define simd_reduce_max_epu8  simd_reduce_none
+#define simd_reduce_max_epu16 simd_reduce_none
+#define simd_reduce_max_epu32 simd_reduce_none
+#define simd_reduce_min_epi8  simd_reduce_none
+#define simd_reduce_min_epi16 simd_reduce_none
+#define simd_reduce_min_epi32 simd_reduce_none
+#define simd_reduce_max_epi8  simd_reduce_none
+#define simd_reduce_max_epi16 simd_reduce_none
+#define simd_reduce_max_epi32 simd_reduce_none
+#define simd_reduce_sum_epi64 simd_reduce_none
+
+#endif // SIMD_ENABLED
+
+/* used for types that don't have a SIMD kernel at any level */
+static inline Bool simd_reduce_none(const void* data, Size n, void* result, Size* consumed) {
+    UNUSED(data); UNUSED(n); UNUSED(result);
+    *consumed = 0;
+    return False;
+}
+
+/**
+ * Define searches and reductions for a numeric vector type.
+ * Equality scans use SIMD only when @p simd_eq is set, because comparing
+ * bit patterns is not same as comparing floats. Scalar loops for sums keep
+ * four independent accumulators, so that additions don't wait on each other.
+ *
+ * @param sfx Suffix of generated function names (eg: u32).
+ * @param type Type of elements.
+ * @param sum_type Type sum is accumulated and returned in.
+ * @param bits Number of bits in @p type.
+ * @param simd_eq True if equality can be checked on bit patterns.
+ * @param min_kernel, max_kernel, sum_kernel SIMD reduction kernels or simd_reduce_none.
+ * */
+#define DEF_NUMERIC_VECTOR_REDUCE(sfx, type, sum_type, bits, simd_eq, min_kernel, max_kernel, sum_kernel) \
+    Size vector_find_##sfx(Vector* vec, type value) {                   \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type), SIZE_MAX, ERR_INVALID_ARGUMENTS); \
+        const type* data = (const type*)vec->data;                      \
+        Size i = 0;                                                     \
+        if(simd_eq) {                                                   \
+            Size pos = simd_find_epi##bits(data, vec->length, &value, &i); \
+            if(pos != SIZE_MAX) return pos;                             \
+        }                                                               \
+        for(; i < vec->length; i++) {                                   \
+            if(data[i] == value) return i;                              \
+        }                                                               \
+        return SIZE_MAX;                                                \
+    }                                                                   \
+                                                                        \
+    Bool vector_contains_##sfx(Vector* vec, type value) {               \
+        return vector_find_##sfx(vec, value) != SIZE_MAX;               \
+    }                                                                   \
+                                                                        \
+    Size vector_count_##sfx(Vector* vec, type value) {                  \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type), 0, ERR_INVALID_ARGUMENTS); \
+        const type* data = (const type*)vec->data;                      \
+        Size i = 0, count = 0;                                          \
+        if(simd_eq) {                                                   \
+            count = simd_count_epi##bits(data, vec->length, &value, &i); \
+        }                                                               \
+        for(; i < vec->length; i++) {                                   \
+            count += data[i] == value;                                  \
+        }                                                               \
+        return count;                                                   \
+    }                                                                   \
+                                                                        \
+    type vector_min_##sfx(Vector* vec) {                                \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type) && vec->length, 0, ERR_INVALID_ARGUMENTS); \
+        const type* data = (const type*)vec->data;                      \
+        type r = data[0];                                               \
+        Size i = 1;                                                     \
+        if(!min_kernel(data, vec->length, &r, &i)) i = 1;               \
+        for(; i < vec->length; i++) {                                   \
+            r = data[i] < r ? data[i] : r;                              \
+        }                                                               \
+        return r;                                                       \
+    }                                                                   \
+                                                                        \
+    type vector_max_##sfx(Vector* vec) {                                \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type) && vec->length, 0, ERR_INVALID_ARGUMENTS); \
+        const type* data = (const type*)vec->data;                      \
+        type r = data[0];                                               \
+        Size i = 1;                                                     \
+        if(!max_kernel(data, vec->length, &r, &i)) i = 1;               \
+        for(; i < vec->length; i++) {                                   \
+            r = data[i] > r ? data[i] : r;                              \
+        }                                                               \
+        return r;                                                       \
+    }                                                                   \
+                                                                        \
+    sum_type vector_sum_##sfx(Vector* vec) {                            \
+        ERR_RETURN_VALUE_IF_FAIL(vec && vec->element_size == sizeof(type), 0, ERR_INVALID_ARGUMENTS); \
+        const type* data = (const type*)vec->data;                      \
+        Size n = vec->length, i = 0;                                    \
+        sum_type acc[4] = {0};                                          \
+        if(!sum_kernel(data, n, &acc[0], &i)) {                         \
+            acc[0] = 0;                                                 \
+            i = 0;                                                      \
+        }                                                               \
+        for(; i + 4 <= n; i += 4) {                                     \
+            acc[0] += data[i];                                          \
+            acc[1] += data[i + 1];                                      \
+            acc[2] += data[i + 2];                                      \
+            acc[3] += data[i + 3];                                      \
+        }                                                               \
+        for(; i < n; i++) {                                             \
+            acc[0] += data[i];                                          \
+        }                                                               \
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);                   \
+    }
+
+DEF_NUMERIC_VECTOR_REDUCE(u8,  Uint8,   Uint64,  8,  True,  simd_reduce_min_epu8,  simd_reduce_max_epu8,  simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(u16, Uint16,  Uint64,  16, True,  simd_reduce_min_epu16, simd_reduce_max_epu16, simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(u32, Uint32,  Uint64,  32, True,  simd_reduce_min_epu32, simd_reduce_max_epu32, simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(u64, Uint64,  Uint64,  64, True,  simd_reduce_none,      simd_reduce_none,      simd_reduce_sum_epi64)
+DEF_NUMERIC_VECTOR_REDUCE(i8,  Int8,    Int64,   8,  True,  simd_reduce_min_epi8,  simd_reduce_max_epi8,  simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(i16, Int16,   Int64,   16, True,  simd_reduce_min_epi16, simd_reduce_max_epi16, simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(i32, Int32,   Int64,   32, True,  simd_reduce_min_epi32, simd_reduce_max_epi32, simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(i64, Int64,   Int64,   64, True,  simd_reduce_none,      simd_reduce_none,      simd_reduce_sum_epi64)
+DEF_NUMERIC_VECTOR_REDUCE(f32, Float32, Float64, 32, False, simd_reduce_none,      simd_reduce_none,      simd_reduce_none)
+DEF_NUMERIC_VECTOR_REDUCE(f64, Float64, Float64, 64, False, simd_reduce_none,      simd_reduce_none,      simd_reduce_none)
+
+#undef DEF_NUMERIC_VECTOR_REDUCE
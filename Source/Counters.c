@@ -0,0 +1,95 @@
+/**
+ * @file Counters.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Per thread storage, snapshots and printing of @c Anvie/Counters.h.
+ * */
+
+#include <Anvie/Counters.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+#if ANVIE_ENABLE_COUNTERS
+_Thread_local Uint64 counters_thread_values[COUNTER_MAX];
+#endif // ANVIE_ENABLE_COUNTERS
+
+#define COUNTER_NAME_ENTRY(id, name) name,
+static ZString counter_names[COUNTER_MAX] = {COUNTER_LIST(COUNTER_NAME_ENTRY)};
+#undef COUNTER_NAME_ENTRY
+
+/**
+ * Check whether library was built with counters enabled.
+ * */
+Bool counters_enabled() {
+    return ANVIE_ENABLE_COUNTERS;
+}
+
+/**
+ * Get "subsystem.event" name of given counter.
+ *
+ * @return Name of counter, NULL if @p id is not a counter.
+ * */
+ZString counter_name(CounterId id) {
+    ERR_RETURN_VALUE_IF_FAIL((Size)id < COUNTER_MAX, NULL, ERR_INVALID_ARGUMENTS);
+    return counter_names[id];
+}
+
+/**
+ * Take a snapshot of counters of calling thread. All zero when counters
+ * are disabled.
+ * */
+void counters_get(Counters* counters) {
+    ERR_RETURN_IF_FAIL(counters, ERR_INVALID_ARGUMENTS);
+#if ANVIE_ENABLE_COUNTERS
+    memcpy(counters->values, counters_thread_values, sizeof(counters->values));
+#else
+    memset(counters->values, 0, sizeof(counters->values));
+#endif // ANVIE_ENABLE_COUNTERS
+}
+
+/**
+ * Set all counters of calling thread to 0.
+ * */
+void counters_reset() {
+#if ANVIE_ENABLE_COUNTERS
+    memset(counters_thread_values, 0, sizeof(counters_thread_values));
+#endif // ANVIE_ENABLE_COUNTERS
+}
+
+/**
+ * Compute events counted between two snapshots, eg: around a piece of code.
+ * @p diff may alias either snapshot.
+ * */
+void counters_diff(Counters* diff, const Counters* after, const Counters* before) {
+    ERR_RETURN_IF_FAIL(diff && after && before, ERR_INVALID_ARGUMENTS);
+    for(Size c = 0; c < COUNTER_MAX; c++) {
+        diff->values[c] = after->values[c] - before->values[c];
+    }
+}
+
+/**
+ * Print name and value of every non zero counter, one per line.
+ * */
+void counters_print(FILE* file, const Counters* counters) {
+    ERR_RETURN_IF_FAIL(file && counters, ERR_INVALID_ARGUMENTS);
+    for(Size c = 0; c < COUNTER_MAX; c++) {
+        if(counters->values[c]) {
+            fprintf(file, "%-28s %llu\n", counter_names[c], (unsigned long long)counters->values[c]);
+        }
+    }
+}
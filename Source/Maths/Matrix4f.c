@@ -24,7 +24,10 @@
 #include <Anvie/Maths/Vector3f.h>
 #include <Anvie/HelperDefines.h>
 #include <Anvie/Error.h>
+#include <Anvie/Simd/Types.h>
+#include <Anvie/ThreadPool.h>
 #include <math.h>
+#include <string.h>
 
 /**
  * Create a new Matrix4f.
@@ -49,6 +52,7 @@ void matrix_4f_destroy(Matrix4f* mat) {
 
 /**
  * Multiply first matrix with other and store the result in first matrix.
+ * Both may be same matrix.
  *
  * @param mat1
  * @param mat2
@@ -56,31 +60,8 @@ void matrix_4f_destroy(Matrix4f* mat) {
 void matrix_4f_mul(Matrix4f* mat1, Matrix4f* mat2) {
     ERR_RETURN_IF_FAIL(mat1 && mat2, ERR_INVALID_ARGUMENTS);
 
-#define M1(r, c) mat1->data[r][c]
-#define M2(r, c) mat2->data[r][c]
-
-    M1(0, 0) = M1(0, 0)*M2(0, 0) + M1(0, 1)*M2(1, 0) + M1(0, 2)*M2(2, 0) + M1(0, 3)*M2(3, 0);
-    M1(0, 1) = M1(0, 0)*M2(0, 1) + M1(0, 1)*M2(1, 1) + M1(0, 2)*M2(2, 1) + M1(0, 3)*M2(3, 1);
-    M1(0, 2) = M1(0, 0)*M2(0, 2) + M1(0, 1)*M2(1, 2) + M1(0, 2)*M2(2, 2) + M1(0, 3)*M2(3, 2);
-    M1(0, 3) = M1(0, 0)*M2(0, 3) + M1(0, 1)*M2(1, 3) + M1(0, 2)*M2(2, 3) + M1(0, 3)*M2(3, 3);
-
-    M1(1, 0) = M1(1, 0)*M2(0, 0) + M1(1, 1)*M2(1, 0) + M1(1, 2)*M2(2, 0) + M1(1, 3)*M2(3, 0);
-    M1(1, 1) = M1(1, 0)*M2(0, 1) + M1(1, 1)*M2(1, 1) + M1(1, 2)*M2(2, 1) + M1(1, 3)*M2(3, 1);
-    M1(1, 2) = M1(1, 0)*M2(0, 2) + M1(1, 1)*M2(1, 2) + M1(1, 2)*M2(2, 2) + M1(1, 3)*M2(3, 2);
-    M1(1, 3) = M1(1, 0)*M2(0, 3) + M1(1, 1)*M2(1, 3) + M1(1, 2)*M2(2, 3) + M1(1, 3)*M2(3, 3);
-
-    M1(2, 0) = M1(2, 0)*M2(0, 0) + M1(2, 1)*M2(1, 0) + M1(2, 2)*M2(2, 0) + M1(2, 3)*M2(3, 0);
-    M1(2, 1) = M1(2, 0)*M2(0, 1) + M1(2, 1)*M2(1, 1) + M1(2, 2)*M2(2, 1) + M1(2, 3)*M2(3, 1);
-    M1(2, 2) = M1(2, 0)*M2(0, 2) + M1(2, 1)*M2(1, 2) + M1(2, 2)*M2(2, 2) + M1(2, 3)*M2(3, 2);
-    M1(2, 3) = M1(2, 0)*M2(0, 3) + M1(2, 1)*M2(1, 3) + M1(2, 2)*M2(2, 3) + M1(2, 3)*M2(3, 3);
-
-    M1(3, 0) = M1(3, 0)*M2(0, 0) + M1(3, 1)*M2(1, 0) + M1(3, 2)*M2(2, 0) + M1(3, 3)*M2(3, 0);
-    M1(3, 1) = M1(3, 0)*M2(0, 1) + M1(3, 1)*M2(1, 1) + M1(3, 2)*M2(2, 1) + M1(3, 3)*M2(3, 1);
-    M1(3, 2) = M1(3, 0)*M2(0, 2) + M1(3, 1)*M2(1, 2) + M1(3, 2)*M2(2, 2) + M1(3, 3)*M2(3, 2);
-    M1(3, 3) = M1(3, 0)*M2(0, 3) + M1(3, 1)*M2(1, 3) + M1(3, 2)*M2(2, 3) + M1(3, 3)*M2(3, 3);
-
-#undef M1
-#undef M2
+    /* computed from copies, so entries of mat1 aren't read after being overwritten */
+    *mat1 = matrix_4f_mul_v(*mat1, *mat2);
 }
 
 /**
@@ -91,32 +72,7 @@ void matrix_4f_mul(Matrix4f* mat1, Matrix4f* mat2) {
  * */
 void matrix_4f_add(Matrix4f* mat1, Matrix4f* mat2) {
     ERR_RETURN_IF_FAIL(mat1 && mat2, ERR_INVALID_ARGUMENTS);
-
-#define M1(r, c) mat1->data[r][c]
-#define M2(r, c) mat2->data[r][c]
-
-    M1(0, 0) = M1(0, 0) + M2(0, 0);
-    M1(0, 1) = M1(0, 1) + M2(0, 1);
-    M1(0, 2) = M1(0, 2) + M2(0, 2);
-    M1(0, 3) = M1(0, 3) + M2(0, 3);
-
-    M1(1, 0) = M1(1, 0) + M2(1, 0);
-    M1(1, 1) = M1(1, 1) + M2(1, 1);
-    M1(1, 2) = M1(1, 2) + M2(1, 2);
-    M1(1, 3) = M1(1, 3) + M2(1, 3);
-
-    M1(2, 0) = M1(2, 0) + M2(2, 0);
-    M1(2, 1) = M1(2, 1) + M2(2, 1);
-    M1(2, 2) = M1(2, 2) + M2(2, 2);
-    M1(2, 3) = M1(2, 3) + M2(2, 3);
-
-    M1(3, 0) = M1(3, 0) + M2(3, 0);
-    M1(3, 1) = M1(3, 1) + M2(3, 1);
-    M1(3, 2) = M1(3, 2) + M2(3, 2);
-    M1(3, 3) = M1(3, 3) + M2(3, 3);
-
-#undef M1
-#undef M2
+    *mat1 = matrix_4f_add_v(*mat1, *mat2);
 }
 
 /**
@@ -127,32 +83,62 @@ void matrix_4f_add(Matrix4f* mat1, Matrix4f* mat2) {
  * */
 void matrix_4f_sub(Matrix4f* mat1, Matrix4f* mat2) {
     ERR_RETURN_IF_FAIL(mat1 && mat2, ERR_INVALID_ARGUMENTS);
+    *mat1 = matrix_4f_sub_v(*mat1, *mat2);
+}
 
-#define M1(r, c) mat1->data[r][c]
-#define M2(r, c) mat2->data[r][c]
-
-    M1(0, 0) = M1(0, 0) - M2(0, 0);
-    M1(0, 1) = M1(0, 1) - M2(0, 1);
-    M1(0, 2) = M1(0, 2) - M2(0, 2);
-    M1(0, 3) = M1(0, 3) - M2(0, 3);
-
-    M1(1, 0) = M1(1, 0) - M2(1, 0);
-    M1(1, 1) = M1(1, 1) - M2(1, 1);
-    M1(1, 2) = M1(1, 2) - M2(1, 2);
-    M1(1, 3) = M1(1, 3) - M2(1, 3);
-
-    M1(2, 0) = M1(2, 0) - M2(2, 0);
-    M1(2, 1) = M1(2, 1) - M2(2, 1);
-    M1(2, 2) = M1(2, 2) - M2(2, 2);
-    M1(2, 3) = M1(2, 3) - M2(2, 3);
-
-    M1(3, 1) = M1(3, 1) - M2(3, 1);
-    M1(3, 0) = M1(3, 0) - M2(3, 0);
-    M1(3, 2) = M1(3, 2) - M2(3, 2);
-    M1(3, 3) = M1(3, 3) - M2(3, 3);
-
-#undef M1
-#undef M2
+/**
+ * Multiply matrices pairwise, dst[i] = m1[i] * m2[i].
+ * With AVX, two products are computed at once, one in each 128 bit half of
+ * a register.
+ *
+ * @param dst Array of @p count matrices to store products in. May be same as
+ * either input array, but must not partially overlap them.
+ * @param m1 Array of @p count left operands.
+ * @param m2 Array of @p count right operands.
+ * @param count Number of products.
+ * */
+void matrix_4f_mul_n(Matrix4f* dst, const Matrix4f* m1, const Matrix4f* m2, Size count) {
+    ERR_RETURN_IF_FAIL(dst && m1 && m2, ERR_INVALID_ARGUMENTS);
+
+    Size i = 0;
+
+#ifdef __AVX__
+    for(; i + 2 <= count; i += 2) {
+        /* rows k of both right operands, first matrix in lower half */
+        __m256 b[4];
+        for(Size k = 0; k < 4; k++) {
+            b[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(m2[i].data[k])), _mm_load_ps(m2[i + 1].data[k]), 1);
+        }
+
+        __m256 rows[4];
+        for(Size r = 0; r < 4; r++) {
+            __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(m1[i].data[r])), _mm_load_ps(m1[i + 1].data[r]), 1);
+
+            /* permute broadcasts entry k of each row within it's own half */
+            __m256 row = _mm256_mul_ps(_mm256_permute_ps(a, 0x00), b[0]);
+#   ifdef __FMA__
+            row = _mm256_fmadd_ps(_mm256_permute_ps(a, 0x55), b[1], row);
+            row = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xaa), b[2], row);
+            row = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xff), b[3], row);
+#   else
+            row = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a, 0x55), b[1]), row);
+            row = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a, 0xaa), b[2]), row);
+            row = _mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a, 0xff), b[3]), row);
+#   endif
+            rows[r] = row;
+        }
+
+        /* stored only after all rows are computed, dst may be an input */
+        for(Size r = 0; r < 4; r++) {
+            _mm_store_ps(dst[i].data[r], _mm256_castps256_ps128(rows[r]));
+            _mm_store_ps(dst[i + 1].data[r], _mm256_extractf128_ps(rows[r], 1));
+        }
+    }
+#endif // __AVX__
+
+    for(; i < count; i++) {
+        dst[i] = matrix_4f_mul_v(m1[i], m2[i]);
+    }
 }
 
 /**
@@ -164,11 +150,7 @@ Matrix4f* matrix_4f_identity() {
     Matrix4f* mat = matrix_4f_create();
     ERR_RETURN_VALUE_IF_FAIL(mat, NULL, ERR_INVALID_OBJECT);
 
-    mat->data[0][0] = 1.f;
-    mat->data[1][1] = 1.f;
-    mat->data[2][2] = 1.f;
-    mat->data[3][3] = 1.f;
-
+    *mat = matrix_4f_identity_v();
     return mat;
 }
 
@@ -343,15 +325,10 @@ Matrix4f* matrix_4f_look_at(
  * @return Matrix4f* on success, NULL otherwise.
  * */
 Matrix4f* matrix_4f_translation_matrix(Float32 dx, Float32 dy, Float32 dz) {
-    Matrix4f* mat = matrix_4f_identity();
+    Matrix4f* mat = matrix_4f_create();
     ERR_RETURN_VALUE_IF_FAIL(mat, NULL, ERR_INVALID_OBJECT);
 
-#define M(r, c) mat->data[r][c]
-    M(0, 3) = dx;
-    M(1, 3) = dy;
-    M(2, 3) = dz;
-#undef M
-
+    *mat = matrix_4f_translation_matrix_v(dx, dy, dz);
     return mat;
 }
 
@@ -366,23 +343,10 @@ Matrix4f* matrix_4f_translation_matrix(Float32 dx, Float32 dy, Float32 dz) {
  * @return Matrix4f* on success, NULL otherwise.
  * */
 Matrix4f* matrix_4f_rotation_matrix(Float32 yaw, Float32 pitch, Float32 roll) {
-    Matrix4f* mat = matrix_4f_identity();
+    Matrix4f* mat = matrix_4f_create();
     ERR_RETURN_VALUE_IF_FAIL(mat, NULL, ERR_INVALID_OBJECT);
 
-#define M(r, c) mat->data[r][c]
-    M(0, 0) = cos(pitch)*cos(yaw);
-    M(0, 1) = sin(roll)*sin(pitch)*cos(yaw) - cos(roll)*cos(yaw);
-    M(0, 2) = cos(roll)*sin(pitch)*cos(yaw) + sin(roll)*sin(yaw);
-
-    M(1, 0) = cos(pitch)*sin(yaw);
-    M(1, 1) = sin(roll)*sin(pitch)*sin(yaw) + cos(roll)*cos(yaw);
-    M(1, 2) = cos(roll)*sin(pitch)*sin(yaw) - sin(roll)*sin(yaw);
-
-    M(2, 0) = -sin(pitch);
-    M(2, 1) = sin(roll)*cos(pitch);
-    M(2, 2) = cos(roll)*cos(pitch);
-#undef M
-
+    *mat = matrix_4f_rotation_matrix_v(yaw, pitch, roll);
     return mat;
 }
 
@@ -396,15 +360,10 @@ Matrix4f* matrix_4f_rotation_matrix(Float32 yaw, Float32 pitch, Float32 roll) {
  * @return Matrix4f* on success, NULL otherwise.
  * */
 Matrix4f* matrix_4f_scale_matrix(Float32 sx, Float32 sy, Float32 sz) {
-    Matrix4f* mat = matrix_4f_identity();
+    Matrix4f* mat = matrix_4f_create();
     ERR_RETURN_VALUE_IF_FAIL(mat, NULL, ERR_INVALID_OBJECT);
 
-#define M(r, c) mat->data[r][c]
-    M(0, 0) = sx;
-    M(1, 1) = sy;
-    M(2, 2) = sz;
-#undef M
-
+    *mat = matrix_4f_scale_matrix_v(sx, sy, sz);
     return mat;
 }
 
@@ -457,3 +416,679 @@ void matrix_4f_scale(Matrix4f* mat, Float32 sx, Float32 sy, Float32 sz) {
     matrix_4f_mul(mat, scalemat);
     matrix_4f_destroy(scalemat);
 }
+
+/**
+ * Multiply all matrices of an array by same matrix from left,
+ * dst[i] = mat * src[i], eg: to bring a skinning palette of bone matrices
+ * into world space. With AVX, two products are computed at once.
+ *
+ * @param dst Array of @p count matrices to store products in. May be same as
+ * @p src, but must not partially overlap it.
+ * @param mat Left operand of all products. Must not be in @p dst.
+ * @param src Array of @p count right operands.
+ * @param count Number of products.
+ * */
+void matrix_4f_mul_array(Matrix4f* dst, const Matrix4f* mat, const Matrix4f* src, Size count) {
+    ERR_RETURN_IF_FAIL(dst && mat && src, ERR_INVALID_ARGUMENTS);
+
+    Size i = 0;
+
+#ifdef __AVX__
+    /* entries of left operand, same for all products */
+    __m256 a[4][4];
+    for(Size r = 0; r < 4; r++) {
+        for(Size k = 0; k < 4; k++) {
+            a[r][k] = _mm256_set1_ps(mat->data[r][k]);
+        }
+    }
+
+    for(; i + 2 <= count; i += 2) {
+        __m256 b[4];
+        for(Size k = 0; k < 4; k++) {
+            b[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src[i].data[k])), _mm_load_ps(src[i + 1].data[k]), 1);
+        }
+
+        __m256 rows[4];
+        for(Size r = 0; r < 4; r++) {
+            __m256 row = _mm256_mul_ps(a[r][0], b[0]);
+#   ifdef __FMA__
+            row = _mm256_fmadd_ps(a[r][1], b[1], row);
+            row = _mm256_fmadd_ps(a[r][2], b[2], row);
+            row = _mm256_fmadd_ps(a[r][3], b[3], row);
+#   else
+            row = _mm256_add_ps(_mm256_mul_ps(a[r][1], b[1]), row);
+            row = _mm256_add_ps(_mm256_mul_ps(a[r][2], b[2]), row);
+            row = _mm256_add_ps(_mm256_mul_ps(a[r][3], b[3]), row);
+#   endif
+            rows[r] = row;
+        }
+
+        for(Size r = 0; r < 4; r++) {
+            _mm_store_ps(dst[i].data[r], _mm256_castps256_ps128(rows[r]));
+            _mm_store_ps(dst[i + 1].data[r], _mm256_extractf128_ps(rows[r], 1));
+        }
+    }
+#endif // __AVX__
+
+    for(; i < count; i++) {
+        dst[i] = matrix_4f_mul_v(*mat, src[i]);
+    }
+}
+
+/********************************** INVERSE **********************************/
+
+/**
+ * Transpose given matrix in place.
+ *
+ * @param mat
+ * */
+void matrix_4f_transpose(Matrix4f* mat) {
+    ERR_RETURN_IF_FAIL(mat, ERR_INVALID_OBJECT);
+    *mat = matrix_4f_transpose_v(*mat);
+}
+
+/*
+ * General inverse by 2x2 blocks. Writing M = | A B |, each 2x2 block is held
+ *                                            | C D |
+ * row major in one 128 bit lane, and the inverse is built from adjugates
+ * (A#) of blocks : |M| = |A||D| + |B||C| - tr((A#B)(D#C)) and
+ * M^-1 = 1/|M| | |D|A - B(D#C)     |B|C - D(A#B)# |#
+ *              | |C|B - A(D#C)#    |A|D - C(A#B)  |
+ *
+ * Only lane local shuffles are used, so the same kernel inverts one matrix
+ * per SSE register and two per AVX register. It's generated for both.
+ */
+
+#define INV_SHUFFLE(P, a, b, x, y, z, w) P##_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define INV_SWIZZLE(P, a, x, y, z, w) INV_SHUFFLE(P, a, a, x, y, z, w)
+
+#define DEFINE_INVERSE_KERNEL(name, T, P)                                                               \
+    /* 2x2 products A*B, A#*B and A*B# */                                                               \
+    static inline T name##_mat2_mul(T a, T b) {                                                         \
+        return P##_add_ps(                                                                              \
+            P##_mul_ps(a, INV_SWIZZLE(P, b, 0, 3, 0, 3)),                                               \
+            P##_mul_ps(INV_SWIZZLE(P, a, 1, 0, 3, 2), INV_SWIZZLE(P, b, 2, 1, 2, 1))                    \
+        );                                                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static inline T name##_mat2_adj_mul(T a, T b) {                                                     \
+        return P##_sub_ps(                                                                              \
+            P##_mul_ps(INV_SWIZZLE(P, a, 3, 3, 0, 0), b),                                               \
+            P##_mul_ps(INV_SWIZZLE(P, a, 1, 1, 2, 2), INV_SWIZZLE(P, b, 2, 3, 0, 1))                    \
+        );                                                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static inline T name##_mat2_mul_adj(T a, T b) {                                                     \
+        return P##_sub_ps(                                                                              \
+            P##_mul_ps(a, INV_SWIZZLE(P, b, 3, 0, 3, 0)),                                               \
+            P##_mul_ps(INV_SWIZZLE(P, a, 1, 0, 3, 2), INV_SWIZZLE(P, b, 2, 1, 2, 1))                    \
+        );                                                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    /* invert rows m into rows inv, determinant is returned in every lane */                            \
+    static inline T name(const T m[4], T inv[4]) {                                                      \
+        T a = INV_SHUFFLE(P, m[0], m[1], 0, 1, 0, 1);                                                   \
+        T b = INV_SHUFFLE(P, m[0], m[1], 2, 3, 2, 3);                                                   \
+        T c = INV_SHUFFLE(P, m[2], m[3], 0, 1, 0, 1);                                                   \
+        T d = INV_SHUFFLE(P, m[2], m[3], 2, 3, 2, 3);                                                   \
+                                                                                                        \
+        /* (|A|, |B|, |C|, |D|) */                                                                      \
+        T det_sub = P##_sub_ps(                                                                         \
+            P##_mul_ps(INV_SHUFFLE(P, m[0], m[2], 0, 2, 0, 2), INV_SHUFFLE(P, m[1], m[3], 1, 3, 1, 3)), \
+            P##_mul_ps(INV_SHUFFLE(P, m[0], m[2], 1, 3, 1, 3), INV_SHUFFLE(P, m[1], m[3], 0, 2, 0, 2))  \
+        );                                                                                              \
+        T det_a = INV_SWIZZLE(P, det_sub, 0, 0, 0, 0);                                                  \
+        T det_b = INV_SWIZZLE(P, det_sub, 1, 1, 1, 1);                                                  \
+        T det_c = INV_SWIZZLE(P, det_sub, 2, 2, 2, 2);                                                  \
+        T det_d = INV_SWIZZLE(P, det_sub, 3, 3, 3, 3);                                                  \
+                                                                                                        \
+        T d_c = name##_mat2_adj_mul(d, c);                                                              \
+        T a_b = name##_mat2_adj_mul(a, b);                                                              \
+        T x   = P##_sub_ps(P##_mul_ps(det_d, a), name##_mat2_mul(b, d_c));                              \
+        T w   = P##_sub_ps(P##_mul_ps(det_a, d), name##_mat2_mul(c, a_b));                              \
+        T y   = P##_sub_ps(P##_mul_ps(det_b, c), name##_mat2_mul_adj(d, a_b));                          \
+        T z   = P##_sub_ps(P##_mul_ps(det_c, b), name##_mat2_mul_adj(a, d_c));                          \
+                                                                                                        \
+        T tr = P##_mul_ps(a_b, INV_SWIZZLE(P, d_c, 0, 2, 1, 3));                                        \
+        tr   = P##_add_ps(tr, INV_SWIZZLE(P, tr, 1, 0, 3, 2));                                          \
+        tr   = P##_add_ps(tr, INV_SWIZZLE(P, tr, 2, 3, 0, 1));                                          \
+                                                                                                        \
+        T det = P##_sub_ps(P##_add_ps(P##_mul_ps(det_a, det_d), P##_mul_ps(det_b, det_c)), tr);         \
+                                                                                                        \
+        /* adjugate of each block flips signs of it's off diagonal entries */                           \
+        T rdet = P##_div_ps(P##_setr_ps(SIGNS), det);                                                   \
+        x      = P##_mul_ps(x, rdet);                                                                   \
+        y      = P##_mul_ps(y, rdet);                                                                   \
+        z      = P##_mul_ps(z, rdet);                                                                   \
+        w      = P##_mul_ps(w, rdet);                                                                   \
+                                                                                                        \
+        /* swaps of adjugate and block to row reordering in one shuffle each */                         \
+        inv[0] = INV_SHUFFLE(P, x, y, 3, 1, 3, 1);                                                      \
+        inv[1] = INV_SHUFFLE(P, x, y, 2, 0, 2, 0);                                                      \
+        inv[2] = INV_SHUFFLE(P, z, w, 3, 1, 3, 1);                                                      \
+        inv[3] = INV_SHUFFLE(P, z, w, 2, 0, 2, 0);                                                      \
+        return det;                                                                                     \
+    }
+
+#ifdef __SSE__
+#   define SIGNS 1.f, -1.f, -1.f, 1.f
+DEFINE_INVERSE_KERNEL(matrix_4f_inverse_ps, __m128, _mm)
+#   undef SIGNS
+#endif // __SSE__
+
+#ifdef __AVX__
+#   define SIGNS 1.f, -1.f, -1.f, 1.f, 1.f, -1.f, -1.f, 1.f
+DEFINE_INVERSE_KERNEL(matrix_4f_inverse_ps256, __m256, _mm256)
+#   undef SIGNS
+#endif // __AVX__
+
+#undef DEFINE_INVERSE_KERNEL
+
+/* cofactor expansion, used when SSE is not available */
+static inline Float32 matrix_4f_inverse_scalar(const Matrix4f* mat, Matrix4f* inv) {
+    const Float32* m = &mat->data[0][0];
+    Float32        r[16];
+
+    r[0]  =  m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
+    r[4]  = -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
+    r[8]  =  m[4]*m[9]*m[15]  - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
+    r[12] = -m[4]*m[9]*m[14]  + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
+    r[1]  = -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
+    r[5]  =  m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
+    r[9]  = -m[0]*m[9]*m[15]  + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
+    r[13] =  m[0]*m[9]*m[14]  - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
+    r[2]  =  m[1]*m[6]*m[15]  - m[1]*m[7]*m[14]  - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7]  - m[13]*m[3]*m[6];
+    r[6]  = -m[0]*m[6]*m[15]  + m[0]*m[7]*m[14]  + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7]  + m[12]*m[3]*m[6];
+    r[10] =  m[0]*m[5]*m[15]  - m[0]*m[7]*m[13]  - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7]  - m[12]*m[3]*m[5];
+    r[14] = -m[0]*m[5]*m[14]  + m[0]*m[6]*m[13]  + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6]  + m[12]*m[2]*m[5];
+    r[3]  = -m[1]*m[6]*m[11]  + m[1]*m[7]*m[10]  + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7]   + m[9]*m[3]*m[6];
+    r[7]  =  m[0]*m[6]*m[11]  - m[0]*m[7]*m[10]  - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7]   - m[8]*m[3]*m[6];
+    r[11] = -m[0]*m[5]*m[11]  + m[0]*m[7]*m[9]   + m[4]*m[1]*m[11] - m[4]*m[3]*m[9]  - m[8]*m[1]*m[7]   + m[8]*m[3]*m[5];
+    r[15] =  m[0]*m[5]*m[10]  - m[0]*m[6]*m[9]   - m[4]*m[1]*m[10] + m[4]*m[2]*m[9]  + m[8]*m[1]*m[6]   - m[8]*m[2]*m[5];
+
+    Float32 det = m[0]*r[0] + m[1]*r[4] + m[2]*r[8] + m[3]*r[12];
+    if(det) {
+        for(Size i = 0; i < 16; i++) {
+            (&inv->data[0][0])[i] = r[i] / det;
+        }
+    }
+    return det;
+}
+
+/* invert mat into inv, inv is untouched and 0 is returned for singular matrices */
+static inline Float32 matrix_4f_invert(const Matrix4f* mat, Matrix4f* inv) {
+#ifdef __SSE__
+    __m128 m[4], r[4];
+    for(Size i = 0; i < 4; i++) {
+        m[i] = _mm_load_ps(mat->data[i]);
+    }
+
+    Float32 det = _mm_cvtss_f32(matrix_4f_inverse_ps(m, r));
+    if(det) {
+        for(Size i = 0; i < 4; i++) {
+            _mm_store_ps(inv->data[i], r[i]);
+        }
+    }
+    return det;
+#else
+    return matrix_4f_inverse_scalar(mat, inv);
+#endif // __SSE__
+}
+
+/**
+ * Invert given matrix in place.
+ *
+ * @param mat
+ * @return True on success, False if matrix is singular, in which case
+ * it's left unchanged.
+ * */
+Bool matrix_4f_inverse(Matrix4f* mat) {
+    ERR_RETURN_VALUE_IF_FAIL(mat, False, ERR_INVALID_OBJECT);
+    return matrix_4f_invert(mat, mat) != 0;
+}
+
+/**
+ * Store inverse of a matrix in another.
+ *
+ * @param dst Where inverse is stored. May be same as @p mat.
+ * @param mat
+ * @return True on success, False if @p mat is singular, in which case
+ * @p dst is left unchanged.
+ * */
+Bool matrix_4f_inverse_into(Matrix4f* dst, const Matrix4f* mat) {
+    ERR_RETURN_VALUE_IF_FAIL(dst && mat, False, ERR_INVALID_ARGUMENTS);
+    return matrix_4f_invert(mat, dst) != 0;
+}
+
+/**
+ * Invert an affine transform in place, that is one whose last row is
+ * (0, 0, 0, 1). Only the upper 3x3 block needs a real inverse, which is
+ * much cheaper than general inverse. Handles scale and shear, for pure
+ * rotation and translation @c matrix_4f_rigid_inverse is cheaper still.
+ *
+ * @param mat
+ * @return True on success, False if matrix is singular, in which case
+ * it's left unchanged.
+ * */
+Bool matrix_4f_affine_inverse(Matrix4f* mat) {
+    ERR_RETURN_VALUE_IF_FAIL(mat, False, ERR_INVALID_OBJECT);
+
+    Float32 (*m)[4] = mat->data;
+    Vector3f r0 = {m[0][0], m[0][1], m[0][2]};
+    Vector3f r1 = {m[1][0], m[1][1], m[1][2]};
+    Vector3f r2 = {m[2][0], m[2][1], m[2][2]};
+
+    /* columns of inverse are cross products of rows */
+    Vector3f c0  = vector_3f_cross_v(r1, r2);
+    Vector3f c1  = vector_3f_cross_v(r2, r0);
+    Vector3f c2  = vector_3f_cross_v(r0, r1);
+    Float32  det = vector_3f_dot_v(r0, c0);
+    if(!det) {
+        return False;
+    }
+
+    Float32  rdet = 1.f / det;
+    Vector3f t    = {m[0][3], m[1][3], m[2][3]};
+    Vector3f cols[3] = {c0, c1, c2};
+    for(Size c = 0; c < 3; c++) {
+        m[0][c] = cols[c].x * rdet;
+        m[1][c] = cols[c].y * rdet;
+        m[2][c] = cols[c].z * rdet;
+    }
+    for(Size r = 0; r < 3; r++) {
+        m[r][3] = -(m[r][0]*t.x + m[r][1]*t.y + m[r][2]*t.z);
+    }
+    m[3][0] = m[3][1] = m[3][2] = 0;
+    m[3][3] = 1;
+    return True;
+}
+
+/**
+ * Invert a rigid body transform (rotation and translation only) in place.
+ * Same as @c matrix_4f_rigid_inverse_v.
+ *
+ * @param mat
+ * */
+void matrix_4f_rigid_inverse(Matrix4f* mat) {
+    ERR_RETURN_IF_FAIL(mat, ERR_INVALID_OBJECT);
+    *mat = matrix_4f_rigid_inverse_v(*mat);
+}
+
+/**
+ * Invert an array of matrices, dst[i] = src[i]^-1. With AVX, two matrices
+ * are inverted at once.
+ *
+ * @param dst Array of @p count matrices to store inverses in. May be same as
+ * @p src, but must not partially overlap it.
+ * @param src Array of @p count matrices to invert.
+ * @param count Number of matrices.
+ * @return Number of singular matrices. These are copied to @p dst unchanged.
+ * */
+Size matrix_4f_inverse_array(Matrix4f* dst, const Matrix4f* src, Size count) {
+    ERR_RETURN_VALUE_IF_FAIL(dst && src, 0, ERR_INVALID_ARGUMENTS);
+
+    Size singular = 0;
+    Size i        = 0;
+
+#ifdef __AVX__
+    for(; i + 2 <= count; i += 2) {
+        __m256 m[4], r[4];
+        for(Size k = 0; k < 4; k++) {
+            m[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(src[i].data[k])), _mm_load_ps(src[i + 1].data[k]), 1);
+        }
+
+        __m256  det = matrix_4f_inverse_ps256(m, r);
+        Float32 dets[2] = {_mm256_cvtss_f32(det), _mm_cvtss_f32(_mm256_extractf128_ps(det, 1))};
+
+        for(Size j = 0; j < 2; j++) {
+            if(!dets[j]) {
+                dst[i + j] = src[i + j];
+                singular++;
+                continue;
+            }
+            for(Size k = 0; k < 4; k++) {
+                _mm_store_ps(dst[i + j].data[k], j ? _mm256_extractf128_ps(r[k], 1) : _mm256_castps256_ps128(r[k]));
+            }
+        }
+    }
+#endif // __AVX__
+
+    for(; i < count; i++) {
+        if(!matrix_4f_invert(&src[i], &dst[i])) {
+            dst[i] = src[i];
+            singular++;
+        }
+    }
+
+    return singular;
+}
+
+/******************************* BATCH TRANSFORMS *******************************/
+
+/*
+ * Kernels are picked at compile time by same extension levels as Anvie/Simd :
+ * AVX512 processes 16 floats per register, AVX2 8 and SSE 4, remaining
+ * points are transformed one at a time.
+ */
+
+#if SIMD_LVL3
+static inline __m512 madd512_ps(__m512 a, __m512 b, __m512 c) {
+    return _mm512_fmadd_ps(a, b, c);
+}
+#endif
+
+#if SIMD_LVL2
+static inline __m256 madd256_ps(__m256 a, __m256 b, __m256 c) {
+#   ifdef __FMA__
+    return _mm256_fmadd_ps(a, b, c);
+#   else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#   endif
+}
+#endif
+
+#ifdef __SSE__
+/* columns of matrix, transforming a point is then a weighted sum of columns */
+static inline void matrix_4f_columns(const Matrix4f* mat, __m128 cols[4]) {
+    cols[0] = _mm_load_ps(mat->data[0]);
+    cols[1] = _mm_load_ps(mat->data[1]);
+    cols[2] = _mm_load_ps(mat->data[2]);
+    cols[3] = _mm_load_ps(mat->data[3]);
+    _MM_TRANSPOSE4_PS(cols[0], cols[1], cols[2], cols[3]);
+}
+#endif // __SSE__
+
+/**
+ * Transform an array of 4D vectors, out[i] = mat * in[i].
+ *
+ * @param mat Transform.
+ * @param in Array of @p count vectors.
+ * @param out Array of @p count vectors to store results in. May be same as @p in.
+ * @param count Number of vectors.
+ * */
+void matrix_4f_transform_points_4f(const Matrix4f* mat, const Vector4f* in, Vector4f* out, Size count) {
+    ERR_RETURN_IF_FAIL(mat && in && out, ERR_INVALID_ARGUMENTS);
+
+#ifdef __SSE__
+    __m128 cols[4];
+    matrix_4f_columns(mat, cols);
+
+    const Float32* src = (const Float32*)in;
+    Float32*       dst = (Float32*)out;
+    Size           i   = 0;
+
+    /* several vectors per register, each component is broadcast within it's own vector */
+#if SIMD_LVL3
+    __m512 c0 = _mm512_broadcast_f32x4(cols[0]);
+    __m512 c1 = _mm512_broadcast_f32x4(cols[1]);
+    __m512 c2 = _mm512_broadcast_f32x4(cols[2]);
+    __m512 c3 = _mm512_broadcast_f32x4(cols[3]);
+    for(; i + 4 <= count; i += 4) {
+        __m512 p = _mm512_loadu_ps(src + 4 * i);
+        __m512 r = _mm512_mul_ps(_mm512_permute_ps(p, 0x00), c0);
+        r = madd512_ps(_mm512_permute_ps(p, 0x55), c1, r);
+        r = madd512_ps(_mm512_permute_ps(p, 0xaa), c2, r);
+        r = madd512_ps(_mm512_permute_ps(p, 0xff), c3, r);
+        _mm512_storeu_ps(dst + 4 * i, r);
+    }
+#elif SIMD_LVL2
+    __m256 c0 = _mm256_broadcast_ps(&cols[0]);
+    __m256 c1 = _mm256_broadcast_ps(&cols[1]);
+    __m256 c2 = _mm256_broadcast_ps(&cols[2]);
+    __m256 c3 = _mm256_broadcast_ps(&cols[3]);
+    for(; i + 2 <= count; i += 2) {
+        __m256 p = _mm256_loadu_ps(src + 4 * i);
+        __m256 r = _mm256_mul_ps(_mm256_permute_ps(p, 0x00), c0);
+        r = madd256_ps(_mm256_permute_ps(p, 0x55), c1, r);
+        r = madd256_ps(_mm256_permute_ps(p, 0xaa), c2, r);
+        r = madd256_ps(_mm256_permute_ps(p, 0xff), c3, r);
+        _mm256_storeu_ps(dst + 4 * i, r);
+    }
+#endif
+
+    for(; i < count; i++) {
+        __m128 p = _mm_load_ps(src + 4 * i);
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(p, p, 0x00), cols[0]);
+        r = matrix_4f_madd_ps(_mm_shuffle_ps(p, p, 0x55), cols[1], r);
+        r = matrix_4f_madd_ps(_mm_shuffle_ps(p, p, 0xaa), cols[2], r);
+        r = matrix_4f_madd_ps(_mm_shuffle_ps(p, p, 0xff), cols[3], r);
+        _mm_store_ps(dst + 4 * i, r);
+    }
+#else
+    for(Size i = 0; i < count; i++) {
+        out[i] = matrix_4f_mul_vector_v(*mat, in[i]);
+    }
+#endif // __SSE__
+}
+
+/**
+ * Transform an array of 3D points. Each point is taken to have a fourth
+ * coordinate of 1, so translation applies, and fourth coordinate of result
+ * is dropped without a perspective divide.
+ *
+ * @param mat Transform.
+ * @param in Array of @p count points.
+ * @param out Array of @p count points to store results in. May be same as @p in.
+ * @param count Number of points.
+ * */
+void matrix_4f_transform_points_3f(const Matrix4f* mat, const Vector3f* in, Vector3f* out, Size count) {
+    ERR_RETURN_IF_FAIL(mat && in && out, ERR_INVALID_ARGUMENTS);
+
+#ifdef __SSE__
+    __m128 cols[4];
+    matrix_4f_columns(mat, cols);
+
+    /* points are 12 bytes apart, so they're transformed one per register */
+    for(Size i = 0; i < count; i++) {
+        __m128 r = matrix_4f_madd_ps(_mm_set1_ps(in[i].x), cols[0], cols[3]);
+        r = matrix_4f_madd_ps(_mm_set1_ps(in[i].y), cols[1], r);
+        r = matrix_4f_madd_ps(_mm_set1_ps(in[i].z), cols[2], r);
+
+        Float32 res[4] __attribute__((aligned(16)));
+        _mm_store_ps(res, r);
+        out[i] = (Vector3f){res[0], res[1], res[2]};
+    }
+#else
+    for(Size i = 0; i < count; i++) {
+        Vector4f r = matrix_4f_mul_vector_v(*mat, (Vector4f){in[i].x, in[i].y, in[i].z, 1.f});
+        out[i] = (Vector3f){r.x, r.y, r.z};
+    }
+#endif // __SSE__
+}
+
+/**
+ * Transform points stored as separate arrays of coordinates. Like
+ * @c matrix_4f_transform_points_3f, points have an implicit fourth
+ * coordinate of 1. This layout lets each register hold one coordinate of
+ * many points, so it's fastest of all.
+ *
+ * @param mat Transform.
+ * @param in_x X coordinates of @p count points. Similarly @p in_y and @p in_z.
+ * @param out_x Array to store X coordinates of results in, may be same as
+ * @p in_x. Similarly @p out_y and @p out_z.
+ * @param count Number of points.
+ * */
+void matrix_4f_transform_points_soa(
+    const Matrix4f* mat,
+    const Float32* in_x, const Float32* in_y, const Float32* in_z,
+    Float32* out_x, Float32* out_y, Float32* out_z,
+    Size count
+) {
+    ERR_RETURN_IF_FAIL(mat && in_x && in_y && in_z && out_x && out_y && out_z, ERR_INVALID_ARGUMENTS);
+
+#define M(r, c) mat->data[r][c]
+
+    Float32* outs[3] = {out_x, out_y, out_z};
+    Size     i       = 0;
+
+#if SIMD_LVL3
+    __m512 m512[3][4];
+    for(Size r = 0; r < 3; r++) {
+        for(Size c = 0; c < 4; c++) m512[r][c] = _mm512_set1_ps(M(r, c));
+    }
+    for(; i + 16 <= count; i += 16) {
+        __m512 x = _mm512_loadu_ps(in_x + i);
+        __m512 y = _mm512_loadu_ps(in_y + i);
+        __m512 z = _mm512_loadu_ps(in_z + i);
+        for(Size r = 0; r < 3; r++) {
+            __m512 o = madd512_ps(m512[r][0], x, madd512_ps(m512[r][1], y, madd512_ps(m512[r][2], z, m512[r][3])));
+            _mm512_storeu_ps(outs[r] + i, o);
+        }
+    }
+#endif
+
+#if SIMD_LVL2
+    __m256 m256[3][4];
+    for(Size r = 0; r < 3; r++) {
+        for(Size c = 0; c < 4; c++) m256[r][c] = _mm256_set1_ps(M(r, c));
+    }
+    for(; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(in_x + i);
+        __m256 y = _mm256_loadu_ps(in_y + i);
+        __m256 z = _mm256_loadu_ps(in_z + i);
+        for(Size r = 0; r < 3; r++) {
+            __m256 o = madd256_ps(m256[r][0], x, madd256_ps(m256[r][1], y, madd256_ps(m256[r][2], z, m256[r][3])));
+            _mm256_storeu_ps(outs[r] + i, o);
+        }
+    }
+#endif
+
+#ifdef __SSE__
+    __m128 m128[3][4];
+    for(Size r = 0; r < 3; r++) {
+        for(Size c = 0; c < 4; c++) m128[r][c] = _mm_set1_ps(M(r, c));
+    }
+    for(; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(in_x + i);
+        __m128 y = _mm_loadu_ps(in_y + i);
+        __m128 z = _mm_loadu_ps(in_z + i);
+        for(Size r = 0; r < 3; r++) {
+            __m128 o = matrix_4f_madd_ps(m128[r][0], x, matrix_4f_madd_ps(m128[r][1], y, matrix_4f_madd_ps(m128[r][2], z, m128[r][3])));
+            _mm_storeu_ps(outs[r] + i, o);
+        }
+    }
+#endif // __SSE__
+
+    for(; i < count; i++) {
+        Float32 x = in_x[i], y = in_y[i], z = in_z[i];
+        for(Size r = 0; r < 3; r++) {
+            outs[r][i] = M(r, 0)*x + M(r, 1)*y + M(r, 2)*z + M(r, 3);
+        }
+    }
+
+#undef M
+}
+
+/* batches smaller than this are not split between threads */
+#define TRANSFORM_PARALLEL_THRESHOLD (1 << 16)
+
+typedef enum TransformLayout {
+    TRANSFORM_LAYOUT_4F,
+    TRANSFORM_LAYOUT_3F,
+    TRANSFORM_LAYOUT_SOA,
+} TransformLayout;
+
+/**
+ * A batch to transform, split into slices of @c slice points.
+ * For array of structure layouts only first input and output are used.
+ * */
+typedef struct TransformTask {
+    TransformLayout layout;
+    const Matrix4f* mat;
+    const void*     in[3];
+    void*           out[3];
+    Size            count;
+    Size            slice;
+} TransformTask;
+
+/* transform points [b, b + n) of batch */
+static void transform_task_run(const TransformTask* task, Size b, Size n) {
+
+    switch(task->layout) {
+        case TRANSFORM_LAYOUT_4F:
+            matrix_4f_transform_points_4f(task->mat, (const Vector4f*)task->in[0] + b, (Vector4f*)task->out[0] + b, n);
+            break;
+        case TRANSFORM_LAYOUT_3F:
+            matrix_4f_transform_points_3f(task->mat, (const Vector3f*)task->in[0] + b, (Vector3f*)task->out[0] + b, n);
+            break;
+        case TRANSFORM_LAYOUT_SOA:
+            matrix_4f_transform_points_soa(
+                task->mat,
+                (const Float32*)task->in[0] + b, (const Float32*)task->in[1] + b, (const Float32*)task->in[2] + b,
+                (Float32*)task->out[0] + b, (Float32*)task->out[1] + b, (Float32*)task->out[2] + b,
+                n
+            );
+            break;
+    }
+}
+
+/* transform slices [begin, end), called by parallel_for */
+static void transform_slices_run(Size begin, Size end, void* udata) {
+    const TransformTask* task = udata;
+    Size b = MIN(begin * task->slice, task->count);
+    Size e = MIN(end * task->slice, task->count);
+    transform_task_run(task, b, e - b);
+}
+
+/* split batch described by task into equal slices, one per thread, and wait for all of them */
+static void transform_parallel(TransformTask task, Size count, Size nthreads) {
+    if(!nthreads) {
+        ThreadPool* pool = thread_pool_default();
+        nthreads = pool ? thread_pool_get_thread_count(pool) : 1;
+    }
+    nthreads = MIN(nthreads, count / (TRANSFORM_PARALLEL_THRESHOLD / 2) + 1);
+
+    if(nthreads < 2 || count < TRANSFORM_PARALLEL_THRESHOLD) {
+        transform_task_run(&task, 0, count);
+        return;
+    }
+
+    /* slices start at multiples of 16 points, so every slice runs full SIMD iterations */
+    task.count = count;
+    task.slice = ((count / nthreads + 15) / 16) * 16;
+    parallel_for(NULL, 0, (count + task.slice - 1) / task.slice, 1, transform_slices_run, &task);
+}
+
+/**
+ * Same as @c matrix_4f_transform_points_4f, with batch split between
+ * threads. Batches smaller than an internal threshold run on calling thread.
+ *
+ * @param nthreads Number of threads work is split for, 1 runs it on calling
+ * thread. 0 means number of workers of default pool.
+ * */
+void matrix_4f_transform_points_4f_parallel(const Matrix4f* mat, const Vector4f* in, Vector4f* out, Size count, Size nthreads) {
+    ERR_RETURN_IF_FAIL(mat && in && out, ERR_INVALID_ARGUMENTS);
+    transform_parallel((TransformTask){.layout = TRANSFORM_LAYOUT_4F, .mat = mat, .in = {in}, .out = {out}}, count, nthreads);
+}
+
+/**
+ * Same as @c matrix_4f_transform_points_3f, with batch split between
+ * threads. Batches smaller than an internal threshold run on calling thread.
+ *
+ * @param nthreads Number of threads work is split for, 1 runs it on calling
+ * thread. 0 means number of workers of default pool.
+ * */
+void matrix_4f_transform_points_3f_parallel(const Matrix4f* mat, const Vector3f* in, Vector3f* out, Size count, Size nthreads) {
+    ERR_RETURN_IF_FAIL(mat && in && out, ERR_INVALID_ARGUMENTS);
+    transform_parallel((TransformTask){.layout = TRANSFORM_LAYOUT_3F, .mat = mat, .in = {in}, .out = {out}}, count, nthreads);
+}
+
+/**
+ * Same as @c matrix_4f_transform_points_soa, with batch split between
+ * threads. Batches smaller than an internal threshold run on calling thread.
+ *
+ * @param nthreads Number of threads work is split for, 1 runs it on calling
+ * thread. 0 means number of workers of default pool.
+ * */
+void matrix_4f_transform_points_soa_parallel(
+    const Matrix4f* mat,
+    const Float32* in_x, const Float32* in_y, const Float32* in_z,
+    Float32* out_x, Float32* out_y, Float32* out_z,
+    Size count, Size nthreads
+) {
+    ERR_RETURN_IF_FAIL(mat && in_x && in_y && in_z && out_x && out_y && out_z, ERR_INVALID_ARGUMENTS);
+    transform_parallel(
+        (TransformTask){.layout = TRANSFORM_LAYOUT_SOA, .mat = mat, .in = {in_x, in_y, in_z}, .out = {out_x, out_y, out_z}},
+        count, nthreads
+    );
+}
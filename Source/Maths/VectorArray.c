@@ -0,0 +1,499 @@
+/**
+ * @file VectorArray.c
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @date Thu, 15th October, 2026
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * */
+
+#include <Anvie/Maths/VectorArray.h>
+#include <Anvie/HelperDefines.h>
+#include <Anvie/Error.h>
+#include <Anvie/Simd/Types.h>
+
+#include <math.h>
+
+/**
+ * Both layouts are read through a stream : coordinate k of vector i is at
+ * comp[k][i * stride]. AoS streams point into the same array with a stride
+ * of vector size, SoA streams have a stride of 1.
+ * */
+typedef struct FloatStream {
+    Float32* comp[4];
+    Size     stride;
+} FloatStream;
+
+#define STREAM_AT(s, k, i) ((s).comp[k][(i) * (s).stride])
+
+static inline FloatStream stream_aos(const void* base, Size dim, Size stride) {
+    FloatStream s = {.stride = stride};
+    for(Size k = 0; k < dim; k++) {
+        s.comp[k] = (Float32*)base + k;
+    }
+    return s;
+}
+
+static inline FloatStream stream_soa(const VectorSoA* soa) {
+    FloatStream s = {.stride = 1};
+    for(Size k = 0; k < soa->dim; k++) {
+        s.comp[k] = soa->comp[k];
+    }
+    return s;
+}
+
+/**************************** VECTOR REGISTER OPS *****************************/
+
+/*
+ * FVec is widest float register available. Contiguous coordinates are
+ * loaded directly, strided (AoS) ones are gathered. AVX2 has no scatter,
+ * so strided stores go through a small buffer there.
+ */
+
+#if SIMD_LVL3
+typedef __m512  FVec;
+typedef __m512i FIdx;
+#   define FVEC_WIDTH 16
+
+static inline FIdx fvec_index(Size stride) {
+    return _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32((Int32)stride)
+    );
+}
+
+static inline FVec fvec_load(const Float32* p, Size stride, FIdx idx) {
+    return stride == 1 ? _mm512_loadu_ps(p) : _mm512_i32gather_ps(idx, p, sizeof(Float32));
+}
+
+static inline void fvec_store(Float32* p, Size stride, FIdx idx, FVec v) {
+    if(stride == 1) {
+        _mm512_storeu_ps(p, v);
+    } else {
+        _mm512_i32scatter_ps(p, idx, v, sizeof(Float32));
+    }
+}
+
+#   define fvec_set1 _mm512_set1_ps
+#   define fvec_add _mm512_add_ps
+#   define fvec_sub _mm512_sub_ps
+#   define fvec_mul _mm512_mul_ps
+#   define fvec_div _mm512_div_ps
+#   define fvec_min _mm512_min_ps
+#   define fvec_max _mm512_max_ps
+#   define fvec_sqrt _mm512_sqrt_ps
+#   define fvec_madd _mm512_fmadd_ps
+#   define fvec_rsqrt_estimate _mm512_rsqrt14_ps
+
+/* lanes of v where x is not positive are zeroed */
+static inline FVec fvec_zero_unless_positive(FVec x, FVec v) {
+    return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_GT_OQ), v);
+}
+#elif SIMD_LVL2
+typedef __m256  FVec;
+typedef __m256i FIdx;
+#   define FVEC_WIDTH 8
+
+static inline FIdx fvec_index(Size stride) {
+    return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((Int32)stride));
+}
+
+static inline FVec fvec_load(const Float32* p, Size stride, FIdx idx) {
+    return stride == 1 ? _mm256_loadu_ps(p) : _mm256_i32gather_ps(p, idx, sizeof(Float32));
+}
+
+static inline void fvec_store(Float32* p, Size stride, FIdx idx, FVec v) {
+    UNUSED(idx);
+    if(stride == 1) {
+        _mm256_storeu_ps(p, v);
+    } else {
+        Float32 lanes[FVEC_WIDTH] __attribute__((aligned(32)));
+        _mm256_store_ps(lanes, v);
+        for(Size l = 0; l < FVEC_WIDTH; l++) {
+            p[l * stride] = lanes[l];
+        }
+    }
+}
+
+#   define fvec_set1 _mm256_set1_ps
+#   define fvec_add _mm256_add_ps
+#   define fvec_sub _mm256_sub_ps
+#   define fvec_mul _mm256_mul_ps
+#   define fvec_div _mm256_div_ps
+#   define fvec_min _mm256_min_ps
+#   define fvec_max _mm256_max_ps
+#   define fvec_sqrt _mm256_sqrt_ps
+#   define fvec_rsqrt_estimate _mm256_rsqrt_ps
+
+static inline FVec fvec_madd(FVec a, FVec b, FVec c) {
+#   ifdef __FMA__
+    return _mm256_fmadd_ps(a, b, c);
+#   else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#   endif
+}
+
+/* lanes of v where x is not positive are zeroed */
+static inline FVec fvec_zero_unless_positive(FVec x, FVec v) {
+    return _mm256_and_ps(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ), v);
+}
+#endif // SIMD_LVL3
+
+#ifdef FVEC_WIDTH
+#   define FVEC_LOAD(s, k, i, idx) fvec_load(&STREAM_AT(s, k, i), (s).stride, idx)
+#   define FVEC_STORE(s, k, i, idx, v) fvec_store(&STREAM_AT(s, k, i), (s).stride, idx, v)
+
+/* 1 / sqrt(x), zero where x is not positive */
+static inline FVec fvec_inv_sqrt(FVec x, VectorPrecision precision) {
+    FVec r;
+    if(precision == VECTOR_PRECISION_FAST) {
+        /* one Newton step : r = r * (1.5 - 0.5 * x * r * r) */
+        FVec e = fvec_rsqrt_estimate(x);
+        FVec h = fvec_mul(fvec_mul(fvec_set1(0.5f), x), e);
+        r      = fvec_mul(e, fvec_sub(fvec_set1(1.5f), fvec_mul(h, e)));
+    } else {
+        r = fvec_div(fvec_set1(1.f), fvec_sqrt(x));
+    }
+    return fvec_zero_unless_positive(x, r);
+}
+#endif // FVEC_WIDTH
+
+/********************************** KERNELS ***********************************/
+
+/*
+ * Kernels are written once for all dimensions. Typed wrappers pass a
+ * constant dim, which lets the compiler unroll coordinate loops.
+ */
+
+static inline void dot_kernel(FloatStream a, FloatStream b, Float32* out, Size dim, Size count) {
+    Size i = 0;
+
+#ifdef FVEC_WIDTH
+    FIdx ia = fvec_index(a.stride), ib = fvec_index(b.stride);
+    for(; i + FVEC_WIDTH <= count; i += FVEC_WIDTH) {
+        FVec acc = fvec_mul(FVEC_LOAD(a, 0, i, ia), FVEC_LOAD(b, 0, i, ib));
+        for(Size k = 1; k < dim; k++) {
+            acc = fvec_madd(FVEC_LOAD(a, k, i, ia), FVEC_LOAD(b, k, i, ib), acc);
+        }
+        fvec_store(out + i, 1, ia, acc);
+    }
+#endif // FVEC_WIDTH
+
+    for(; i < count; i++) {
+        Float32 acc = 0;
+        for(Size k = 0; k < dim; k++) {
+            acc += STREAM_AT(a, k, i) * STREAM_AT(b, k, i);
+        }
+        out[i] = acc;
+    }
+}
+
+static inline Float32 inv_sqrt(Float32 x) {
+    return x > 0 ? 1.f / sqrtf(x) : 0;
+}
+
+static inline void length_kernel(FloatStream v, Float32* out, Size dim, Size count, VectorPrecision precision) {
+    UNUSED(precision); /* remaining lengths are always exact */
+    dot_kernel(v, v, out, dim, count);
+
+    Size i = 0;
+#ifdef FVEC_WIDTH
+    FIdx idx = fvec_index(1);
+    for(; i + FVEC_WIDTH <= count; i += FVEC_WIDTH) {
+        FVec len2 = fvec_load(out + i, 1, idx);
+        FVec len  = precision == VECTOR_PRECISION_FAST ? fvec_mul(len2, fvec_inv_sqrt(len2, precision)) : fvec_sqrt(len2);
+        fvec_store(out + i, 1, idx, len);
+    }
+#endif // FVEC_WIDTH
+
+    for(; i < count; i++) {
+        out[i] = sqrtf(out[i]);
+    }
+}
+
+static inline void normalize_kernel(FloatStream in, FloatStream out, Size dim, Size count, VectorPrecision precision) {
+    UNUSED(precision); /* remaining vectors are always normalized exactly */
+    Size i = 0;
+
+#ifdef FVEC_WIDTH
+    FIdx ii = fvec_index(in.stride), io = fvec_index(out.stride);
+    for(; i + FVEC_WIDTH <= count; i += FVEC_WIDTH) {
+        FVec c[4];
+        c[0]      = FVEC_LOAD(in, 0, i, ii);
+        FVec len2 = fvec_mul(c[0], c[0]);
+        for(Size k = 1; k < dim; k++) {
+            c[k] = FVEC_LOAD(in, k, i, ii);
+            len2 = fvec_madd(c[k], c[k], len2);
+        }
+
+        FVec scale = fvec_inv_sqrt(len2, precision);
+        for(Size k = 0; k < dim; k++) {
+            FVEC_STORE(out, k, i, io, fvec_mul(c[k], scale));
+        }
+    }
+#endif // FVEC_WIDTH
+
+    for(; i < count; i++) {
+        Float32 len2 = 0;
+        for(Size k = 0; k < dim; k++) {
+            len2 += STREAM_AT(in, k, i) * STREAM_AT(in, k, i);
+        }
+
+        /* zero vectors stay zero */
+        Float32 scale = inv_sqrt(len2);
+        for(Size k = 0; k < dim; k++) {
+            STREAM_AT(out, k, i) = STREAM_AT(in, k, i) * scale;
+        }
+    }
+}
+
+typedef enum ComponentOp {
+    COMPONENT_OP_LERP,
+    COMPONENT_OP_MIN,
+    COMPONENT_OP_MAX,
+    COMPONENT_OP_CLAMP,
+} ComponentOp;
+
+/**
+ * Apply a coordinate wise operation. b is second operand of lerp, min and
+ * max, t is lerp factor and lo, hi are per coordinate clamp bounds.
+ * */
+static inline void componentwise_kernel(
+    ComponentOp op, FloatStream a, FloatStream b, FloatStream out,
+    Float32 t, const Float32* lo, const Float32* hi, Size dim, Size count
+) {
+    Size i = 0;
+
+#ifdef FVEC_WIDTH
+    FIdx ia = fvec_index(a.stride), ib = fvec_index(b.stride), io = fvec_index(out.stride);
+    FVec vt = fvec_set1(t), vlo[4], vhi[4];
+    if(op == COMPONENT_OP_CLAMP) {
+        for(Size k = 0; k < dim; k++) {
+            vlo[k] = fvec_set1(lo[k]);
+            vhi[k] = fvec_set1(hi[k]);
+        }
+    }
+
+    for(; i + FVEC_WIDTH <= count; i += FVEC_WIDTH) {
+        for(Size k = 0; k < dim; k++) {
+            FVec va = FVEC_LOAD(a, k, i, ia), r;
+            switch(op) {
+                case COMPONENT_OP_LERP:
+                    r = fvec_madd(vt, fvec_sub(FVEC_LOAD(b, k, i, ib), va), va);
+                    break;
+                case COMPONENT_OP_MIN:
+                    r = fvec_min(va, FVEC_LOAD(b, k, i, ib));
+                    break;
+                case COMPONENT_OP_MAX:
+                    r = fvec_max(va, FVEC_LOAD(b, k, i, ib));
+                    break;
+                default:
+                    r = fvec_min(fvec_max(va, vlo[k]), vhi[k]);
+                    break;
+            }
+            FVEC_STORE(out, k, i, io, r);
+        }
+    }
+#endif // FVEC_WIDTH
+
+    for(; i < count; i++) {
+        for(Size k = 0; k < dim; k++) {
+            Float32 va = STREAM_AT(a, k, i), r;
+            switch(op) {
+                case COMPONENT_OP_LERP:
+                    r = va + t * (STREAM_AT(b, k, i) - va);
+                    break;
+                case COMPONENT_OP_MIN:
+                    r = MIN(va, STREAM_AT(b, k, i));
+                    break;
+                case COMPONENT_OP_MAX:
+                    r = MAX(va, STREAM_AT(b, k, i));
+                    break;
+                default:
+                    r = MIN(MAX(va, lo[k]), hi[k]);
+                    break;
+            }
+            STREAM_AT(out, k, i) = r;
+        }
+    }
+}
+
+/****************************** ARRAY OF STRUCTURES ******************************/
+
+#define AOS_STREAM(vec, n, type) stream_aos(vec, n, sizeof(type) / sizeof(Float32))
+
+#define DEFINE_VECTOR_ARRAY_OPS(n, type)                                                                        \
+    void vector_##n##f_dot_array(const type* a, const type* b, Float32* out, Size count) {                     \
+        ERR_RETURN_IF_FAIL(a && b && out, ERR_INVALID_ARGUMENTS);                                               \
+        dot_kernel(AOS_STREAM(a, n, type), AOS_STREAM(b, n, type), out, n, count);                              \
+    }                                                                                                           \
+                                                                                                                \
+    void vector_##n##f_length_array(const type* v, Float32* out, Size count, VectorPrecision precision) {      \
+        ERR_RETURN_IF_FAIL(v && out, ERR_INVALID_ARGUMENTS);                                                    \
+        length_kernel(AOS_STREAM(v, n, type), out, n, count, precision);                                        \
+    }                                                                                                           \
+                                                                                                                \
+    void vector_##n##f_normalize_array(const type* in, type* out, Size count, VectorPrecision precision) {      \
+        ERR_RETURN_IF_FAIL(in && out, ERR_INVALID_ARGUMENTS);                                                   \
+        normalize_kernel(AOS_STREAM(in, n, type), AOS_STREAM(out, n, type), n, count, precision);               \
+    }                                                                                                           \
+                                                                                                                \
+    void vector_##n##f_lerp_array(const type* a, const type* b, Float32 t, type* out, Size count) {            \
+        ERR_RETURN_IF_FAIL(a && b && out, ERR_INVALID_ARGUMENTS);                                               \
+        componentwise_kernel(                                                                                   \
+            COMPONENT_OP_LERP, AOS_STREAM(a, n, type), AOS_STREAM(b, n, type), AOS_STREAM(out, n, type),        \
+            t, NULL, NULL, n, count                                                                             \
+        );                                                                                                      \
+    }                                                                                                           \
+                                                                                                                \
+    void vector_##n##f_min_array(const type* a, const type* b, type* out, Size count) {                        \
+        ERR_RETURN_IF_FAIL(a && b && out, ERR_INVALID_ARGUMENTS);                                               \
+        componentwise_kernel(                                                                                   \
+            COMPONENT_OP_MIN, AOS_STREAM(a, n, type), AOS_STREAM(b, n, type), AOS_STREAM(out, n, type),         \
+            0, NULL, NULL, n, count                                                                             \
+        );                                                                                                      \
+    }                                                                                                           \
+                                                                                                                \
+    void vector_##n##f_max_array(const type* a, const type* b, type* out, Size count) {                        \
+        ERR_RETURN_IF_FAIL(a && b && out, ERR_INVALID_ARGUMENTS);                                               \
+        componentwise_kernel(                                                                                   \
+            COMPONENT_OP_MAX, AOS_STREAM(a, n, type), AOS_STREAM(b, n, type), AOS_STREAM(out, n, type),         \
+            0, NULL, NULL, n, count                                                                             \
+        );                                                                                                      \
+    }                                                                                                           \
+                                                                                                                \
+    void vector_##n##f_clamp_array(const type* in, type lo, type hi, type* out, Size count) {                  \
+        ERR_RETURN_IF_FAIL(in && out, ERR_INVALID_ARGUMENTS);                                                   \
+        componentwise_kernel(                                                                                   \
+            COMPONENT_OP_CLAMP, AOS_STREAM(in, n, type), AOS_STREAM(in, n, type), AOS_STREAM(out, n, type),     \
+            0, (const Float32*)&lo, (const Float32*)&hi, n, count                                               \
+        );                                                                                                      \
+    }
+
+DEFINE_VECTOR_ARRAY_OPS(2, Vector2f)
+DEFINE_VECTOR_ARRAY_OPS(3, Vector3f)
+DEFINE_VECTOR_ARRAY_OPS(4, Vector4f)
+
+#undef DEFINE_VECTOR_ARRAY_OPS
+#undef AOS_STREAM
+
+/****************************** STRUCTURE OF ARRAYS ******************************/
+
+/* dim is in range and all used coordinate arrays are present */
+static Bool soa_is_valid(const VectorSoA* soa) {
+    if(!soa || soa->dim < 2 || soa->dim > 4) {
+        return False;
+    }
+    for(Size k = 0; k < soa->dim; k++) {
+        if(!soa->comp[k]) {
+            return False;
+        }
+    }
+    return True;
+}
+
+#define SOA_PAIR_IS_VALID(a, b) (soa_is_valid(a) && soa_is_valid(b) && (a)->dim == (b)->dim)
+
+/**
+ * Compute dot products of corresponding vectors of two arrays.
+ *
+ * @param a
+ * @param b Must have same dim as @p a.
+ * @param out Array of @p count products.
+ * @param count Number of vectors.
+ * */
+void vector_soa_dot_array(const VectorSoA* a, const VectorSoA* b, Float32* out, Size count) {
+    ERR_RETURN_IF_FAIL(SOA_PAIR_IS_VALID(a, b) && out, ERR_INVALID_ARGUMENTS);
+    dot_kernel(stream_soa(a), stream_soa(b), out, a->dim, count);
+}
+
+/**
+ * Compute lengths of all vectors of an array.
+ *
+ * @param v
+ * @param out Array of @p count lengths.
+ * @param count Number of vectors.
+ * @param precision
+ * */
+void vector_soa_length_array(const VectorSoA* v, Float32* out, Size count, VectorPrecision precision) {
+    ERR_RETURN_IF_FAIL(soa_is_valid(v) && out, ERR_INVALID_ARGUMENTS);
+    length_kernel(stream_soa(v), out, v->dim, count, precision);
+}
+
+/**
+ * Normalize all vectors of an array. Zero vectors are left as they are.
+ *
+ * @param in
+ * @param out Must have same dim as @p in.
+ * @param count Number of vectors.
+ * @param precision
+ * */
+void vector_soa_normalize_array(const VectorSoA* in, const VectorSoA* out, Size count, VectorPrecision precision) {
+    ERR_RETURN_IF_FAIL(SOA_PAIR_IS_VALID(in, out), ERR_INVALID_ARGUMENTS);
+    normalize_kernel(stream_soa(in), stream_soa(out), in->dim, count, precision);
+}
+
+/**
+ * Linearly interpolate between corresponding vectors of two arrays.
+ *
+ * @param a Vectors at t = 0.
+ * @param b Vectors at t = 1.
+ * @param t Interpolation factor.
+ * @param out
+ * @param count Number of vectors.
+ * */
+void vector_soa_lerp_array(const VectorSoA* a, const VectorSoA* b, Float32 t, const VectorSoA* out, Size count) {
+    ERR_RETURN_IF_FAIL(SOA_PAIR_IS_VALID(a, b) && SOA_PAIR_IS_VALID(a, out), ERR_INVALID_ARGUMENTS);
+    componentwise_kernel(COMPONENT_OP_LERP, stream_soa(a), stream_soa(b), stream_soa(out), t, NULL, NULL, a->dim, count);
+}
+
+/**
+ * Coordinate wise minimum of corresponding vectors of two arrays.
+ *
+ * @param a
+ * @param b
+ * @param out
+ * @param count Number of vectors.
+ * */
+void vector_soa_min_array(const VectorSoA* a, const VectorSoA* b, const VectorSoA* out, Size count) {
+    ERR_RETURN_IF_FAIL(SOA_PAIR_IS_VALID(a, b) && SOA_PAIR_IS_VALID(a, out), ERR_INVALID_ARGUMENTS);
+    componentwise_kernel(COMPONENT_OP_MIN, stream_soa(a), stream_soa(b), stream_soa(out), 0, NULL, NULL, a->dim, count);
+}
+
+/**
+ * Coordinate wise maximum of corresponding vectors of two arrays.
+ *
+ * @param a
+ * @param b
+ * @param out
+ * @param count Number of vectors.
+ * */
+void vector_soa_max_array(const VectorSoA* a, const VectorSoA* b, const VectorSoA* out, Size count) {
+    ERR_RETURN_IF_FAIL(SOA_PAIR_IS_VALID(a, b) && SOA_PAIR_IS_VALID(a, out), ERR_INVALID_ARGUMENTS);
+    componentwise_kernel(COMPONENT_OP_MAX, stream_soa(a), stream_soa(b), stream_soa(out), 0, NULL, NULL, a->dim, count);
+}
+
+/**
+ * Clamp every coordinate of all vectors of an array.
+ *
+ * @param in
+ * @param lo Lower bound of each coordinate, dim values.
+ * @param hi Upper bound of each coordinate, dim values.
+ * @param out
+ * @param count Number of vectors.
+ * */
+void vector_soa_clamp_array(const VectorSoA* in, const Float32* lo, const Float32* hi, const VectorSoA* out, Size count) {
+    ERR_RETURN_IF_FAIL(SOA_PAIR_IS_VALID(in, out) && lo && hi, ERR_INVALID_ARGUMENTS);
+    componentwise_kernel(COMPONENT_OP_CLAMP, stream_soa(in), stream_soa(in), stream_soa(out), 0, lo, hi, in->dim, count);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file SimdDispatch.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Detection, selection and override of SIMD level used by dispatched
+ * kernels, see @c Anvie/Simd/Dispatch.h.
+ * */
+
+#include <Anvie/Simd/Dispatch.h>
+#include <Anvie/Error.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   define SIMD_DISPATCH_X86 1
+#else
+#   define SIMD_DISPATCH_X86 0
+#endif
+
+SimdLevel simd_level_active = SIMD_LEVEL_NONE;
+
+static ZString simd_level_names[SIMD_LEVEL_COUNT] = {
+    [SIMD_LEVEL_NONE]   = "none",
+    [SIMD_LEVEL_AVX]    = "avx",
+    [SIMD_LEVEL_AVX2]   = "avx2",
+    [SIMD_LEVEL_AVX512] = "avx512",
+};
+
+/**
+ * Highest SIMD level current CPU (and OS, which must save wider registers
+ * on context switch) supports. Each level needs all features of levels
+ * below it, as kernels of a level are compiled with those too.
+ *
+ * @return Detected level, @c SIMD_LEVEL_NONE on non x86 targets.
+ * */
+SimdLevel simd_level_detect() {
+#if SIMD_DISPATCH_X86
+    __builtin_cpu_init();
+
+    if(!__builtin_cpu_supports("avx") || !__builtin_cpu_supports("popcnt")) {
+        return SIMD_LEVEL_NONE;
+    }
+    if(!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma") || !__builtin_cpu_supports("bmi") ||
+       !__builtin_cpu_supports("bmi2")) {
+        return SIMD_LEVEL_AVX;
+    }
+    if(!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512bw") ||
+       !__builtin_cpu_supports("avx512dq") || !__builtin_cpu_supports("avx512vl")) {
+        return SIMD_LEVEL_AVX2;
+    }
+    return SIMD_LEVEL_AVX512;
+#else
+    return SIMD_LEVEL_NONE;
+#endif // SIMD_DISPATCH_X86
+}
+
+/**
+ * Get level kernels are currently dispatched at.
+ * */
+SimdLevel simd_level_get() {
+    return simd_level_active;
+}
+
+/**
+ * Select level to dispatch kernels at, eg: to test or benchmark scalar
+ * kernels on a machine with AVX512. Not synchronized with running kernels,
+ * so change it before starting threads that use them.
+ *
+ * @param level Level to use, must not be above @c simd_level_detect.
+ * @return True on success, False if CPU doesn't support @p level.
+ * */
+Bool simd_level_set(SimdLevel level) {
+    ERR_RETURN_VALUE_IF_FAIL((Uint32)level < SIMD_LEVEL_COUNT, False, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(level <= simd_level_detect(), False, ERR_OPERATION_FAILED);
+
+    simd_level_active = level;
+    return True;
+}
+
+/**
+ * Get name of a level, same as accepted by @c simd_level_from_name.
+ *
+ * @return Name of level, "invalid" for levels that don't exist.
+ * */
+ZString simd_level_name(SimdLevel level) {
+    return (Uint32)level < SIMD_LEVEL_COUNT ? simd_level_names[level] : "invalid";
+}
+
+/**
+ * Get level from it's name, case sensitive.
+ *
+ * @return Level, or @c SIMD_LEVEL_COUNT if @p name is not a level.
+ * */
+SimdLevel simd_level_from_name(ZString name) {
+    ERR_RETURN_VALUE_IF_FAIL(name, SIMD_LEVEL_COUNT, ERR_INVALID_ARGUMENTS);
+
+    for(Uint32 level = 0; level < SIMD_LEVEL_COUNT; level++) {
+        if(!strcmp(name, simd_level_names[level])) {
+            return (SimdLevel)level;
+        }
+    }
+    return SIMD_LEVEL_COUNT;
+}
+
+/**
+ * Select level before main. @c ANVIE_SIMD_LEVEL can only lower level,
+ * unknown names and levels CPU doesn't support are ignored.
+ * */
+__attribute__((constructor)) static void simd_level_init() {
+    SimdLevel detected = simd_level_detect();
+    ZString   name     = getenv("ANVIE_SIMD_LEVEL");
+    SimdLevel level    = name ? simd_level_from_name(name) : SIMD_LEVEL_COUNT;
+
+    simd_level_active = level < detected ? level : detected;
+}
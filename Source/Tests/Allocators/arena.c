@@ -0,0 +1,195 @@
+/**
+ * @file arena.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for Arena, checking alignment of allocations, reuse of
+ * chunks after reset and restore, and in place reallocation.
+ * */
+
+#include <Anvie/Allocators/Arena.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* small chunks, so that a few allocations already need more than one */
+#define ARENA_TEST_CHUNK_SIZE 1024
+#define ARENA_TEST_ALLOCS     64
+
+/* pointer is a multiple of given power of two */
+#define ARENA_TEST_ALIGNED(p, align) (!((Uint64)(p) & ((align) - 1)))
+
+/* sizes and alignments of a fixed allocation sequence, so that it can be replayed */
+static Size arena_test_size(Size i) {
+    return (i * 37) % 200 + 1;
+}
+
+static Size arena_test_alignment(Size i) {
+    return (Size)1 << (i % 8);
+}
+
+/* make allocation sequence, filling each block with it's index */
+static Bool arena_test_fill(Arena* arena, Uint8** blocks) {
+    for(Size i = 0; i < ARENA_TEST_ALLOCS; i++) {
+        blocks[i] = arena_allocate_aligned(arena, arena_test_size(i), arena_test_alignment(i));
+        if(!blocks[i] || !ARENA_TEST_ALIGNED(blocks[i], arena_test_alignment(i))) {
+            return False;
+        }
+        memset(blocks[i], (int)i, arena_test_size(i));
+    }
+    return True;
+}
+
+/* no block was overwritten by a later one */
+static Bool arena_test_intact(Uint8** blocks) {
+    for(Size i = 0; i < ARENA_TEST_ALLOCS; i++) {
+        for(Size b = 0; b < arena_test_size(i); b++) {
+            if(blocks[i][b] != (Uint8)i) {
+                return False;
+            }
+        }
+    }
+    return True;
+}
+
+TEST_FN Bool Allocate_WHEN_ALIGNED_THEN_RESPECT_ALIGNMENT() {
+    Arena* arena = arena_create(ARENA_TEST_CHUNK_SIZE);
+    Uint8* blocks[ARENA_TEST_ALLOCS];
+    TEST_OBJECT(arena);
+
+    TEST_EQUALITY(arena_test_fill(arena, blocks));
+    TEST_EQUALITY(arena_test_intact(blocks));
+
+    /* default alignment, and alignments larger than chunk */
+    for(Size i = 0; i < 10; i++) {
+        void* p = arena_allocate(arena, i + 1);
+        TEST_EQUALITY(p && ARENA_TEST_ALIGNED(p, ARENA_DEFAULT_ALIGNMENT));
+    }
+    void* big = arena_allocate_aligned(arena, 16, 4096);
+    TEST_EQUALITY(big && ARENA_TEST_ALIGNED(big, 4096));
+
+    /* allocation larger than chunk size gets a chunk of it's own */
+    Uint8* large = arena_allocate_zeroed(arena, ARENA_TEST_CHUNK_SIZE * 4);
+    TEST_EQUALITY(large && large[0] == 0 && large[ARENA_TEST_CHUNK_SIZE * 4 - 1] == 0);
+    TEST_EQUALITY(arena_test_intact(blocks));
+
+    AllocatorStats stats = arena_get_stats(arena);
+    TEST_LENGTH_EQ(stats.live_count, ARENA_TEST_ALLOCS + 12);
+    TEST_EQUALITY(stats.chunk_count > 1 && stats.reserved_bytes == arena_get_reserved_size(arena));
+
+    DO_BEFORE_EXIT(
+        if(arena) arena_destroy(arena);
+    );
+}
+
+TEST_FN Bool Reset_WHEN_REPLAYED_THEN_REUSE_SAME_MEMORY() {
+    Arena* arena = arena_create(ARENA_TEST_CHUNK_SIZE);
+    Uint8* first[ARENA_TEST_ALLOCS];
+    Uint8* again[ARENA_TEST_ALLOCS];
+    TEST_OBJECT(arena);
+
+    TEST_EQUALITY(arena_test_fill(arena, first));
+    Size reserved = arena_get_reserved_size(arena);
+    Size used     = arena_get_used_size(arena);
+    TEST_LENGTH_GT(reserved, ARENA_TEST_CHUNK_SIZE);
+
+    arena_reset(arena);
+    TEST_LENGTH_EQ(arena_get_used_size(arena), 0);
+    TEST_LENGTH_EQ(arena_get_stats(arena).live_count, 0);
+    TEST_LENGTH_EQ(arena_get_stats(arena).total_frees, ARENA_TEST_ALLOCS);
+
+    /* same sequence after reset lands on same addresses, with no new chunks */
+    TEST_EQUALITY(arena_test_fill(arena, again));
+    TEST_EQUALITY(!memcmp(first, again, sizeof(first)));
+    TEST_LENGTH_EQ(arena_get_reserved_size(arena), reserved);
+    TEST_LENGTH_EQ(arena_get_used_size(arena), used);
+    TEST_EQUALITY(arena_test_intact(again));
+
+    DO_BEFORE_EXIT(
+        if(arena) arena_destroy(arena);
+    );
+}
+
+TEST_FN Bool Restore_WHEN_MARKER_SAVED_THEN_RELEASE_LATER_ALLOCATIONS() {
+    Arena* arena = arena_create(ARENA_TEST_CHUNK_SIZE);
+    Uint8* blocks[ARENA_TEST_ALLOCS];
+    TEST_OBJECT(arena);
+
+    Uint8* kept = arena_allocate(arena, 100);
+    TEST_EQUALITY(kept != NULL);
+    memset(kept, 0xab, 100);
+
+    /* later allocations span several chunks, and are all released by restore */
+    ArenaMarker marker = arena_save(arena);
+    Size        used   = arena_get_used_size(arena);
+    TEST_EQUALITY(arena_test_fill(arena, blocks));
+    TEST_LENGTH_GT(arena_get_used_size(arena), ARENA_TEST_CHUNK_SIZE);
+
+    Size reserved = arena_get_reserved_size(arena);
+    arena_restore(arena, marker);
+    TEST_LENGTH_EQ(arena_get_used_size(arena), used);
+    TEST_LENGTH_EQ(arena_get_stats(arena).live_count, 1);
+    TEST_EQUALITY(kept[0] == 0xab && kept[99] == 0xab);
+
+    Uint8* replay[ARENA_TEST_ALLOCS];
+    TEST_EQUALITY(arena_test_fill(arena, replay));
+    TEST_EQUALITY(!memcmp(blocks, replay, sizeof(blocks)));
+    TEST_LENGTH_EQ(arena_get_reserved_size(arena), reserved);
+
+    DO_BEFORE_EXIT(
+        if(arena) arena_destroy(arena);
+    );
+}
+
+TEST_FN Bool Reallocate_WHEN_LAST_ALLOCATION_THEN_GROW_IN_PLACE() {
+    Arena* arena = arena_create(ARENA_TEST_CHUNK_SIZE);
+    TEST_OBJECT(arena);
+
+    Uint8* p = arena_reallocate(arena, NULL, 0, 32);
+    TEST_EQUALITY(p != NULL);
+    for(Size i = 0; i < 32; i++) p[i] = (Uint8)i;
+
+    /* last allocation grows without moving, shrinking keeps pointer */
+    TEST_EQUALITY(arena_reallocate(arena, p, 32, 64) == p);
+    TEST_EQUALITY(arena_reallocate(arena, p, 64, 16) == p);
+
+    /* once something is allocated after it, contents are copied to a new block */
+    Uint8* after = arena_allocate(arena, 8);
+    Uint8* moved = arena_reallocate(arena, p, 32, 128);
+    TEST_EQUALITY(after && moved && moved != p);
+    for(Size i = 0; i < 32; i++) TEST_EQUALITY(moved[i] == (Uint8)i);
+
+    /* growing past end of chunk moves to next chunk */
+    Uint8* grown = arena_reallocate(arena, moved, 128, ARENA_TEST_CHUNK_SIZE);
+    TEST_EQUALITY(grown && grown != moved && grown[31] == 31);
+
+    /* through generic interface, free is not needed */
+    Allocator allocator = arena_get_allocator(arena);
+    void*     q         = allocator.allocate(24, allocator.ctx);
+    TEST_EQUALITY(q && ARENA_TEST_ALIGNED(q, ARENA_DEFAULT_ALIGNMENT) && allocator.free == NULL);
+
+    DO_BEFORE_EXIT(
+        if(arena) arena_destroy(arena);
+    );
+}
+
+BEGIN_TESTS(arena)
+    TEST(Allocate_WHEN_ALIGNED_THEN_RESPECT_ALIGNMENT),
+    TEST(Reset_WHEN_REPLAYED_THEN_REUSE_SAME_MEMORY),
+    TEST(Restore_WHEN_MARKER_SAVED_THEN_RELEASE_LATER_ALLOCATIONS),
+    TEST(Reallocate_WHEN_LAST_ALLOCATION_THEN_GROW_IN_PLACE)
+END_TESTS()
@@ -0,0 +1,195 @@
+/**
+ * @file cballoc.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for ConcurrentBlockAllocator, refilling and draining
+ * magazines against depot, flushing them, and freeing blocks on threads
+ * other than ones that allocated them.
+ * */
+
+#include <Anvie/Allocators/ConcurrentBlockAllocator.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <pthread.h>
+
+#define CBALLOC_TEST_THREADS 4
+#define CBALLOC_TEST_BLOCKS  1000
+
+/* a full magazine plus some more, so that frees drain to depot more than once */
+#define CBALLOC_TEST_MANY (CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE * 3 + 5)
+
+typedef struct CballocTestBlock {
+    Size owner;
+    Size index;
+} CballocTestBlock;
+
+/* blocks allocated by each thread, freed by next one */
+typedef struct CballocTestShared {
+    ConcurrentBlockAllocator* cba;
+    pthread_barrier_t         barrier;
+    MemBlock                  blocks[CBALLOC_TEST_THREADS][CBALLOC_TEST_BLOCKS];
+    Bool                      intact[CBALLOC_TEST_THREADS];
+} CballocTestShared;
+
+typedef struct CballocTestArg {
+    CballocTestShared* shared;
+    Size               id;
+} CballocTestArg;
+
+static void* cballoc_test_worker(void* arg) {
+    CballocTestArg*    a      = arg;
+    CballocTestShared* shared = a->shared;
+
+    for(Size i = 0; i < CBALLOC_TEST_BLOCKS; i++) {
+        CballocTestBlock* blk = (CballocTestBlock*)cballoc_allocate(shared->cba);
+        if(blk) {
+            blk->owner = a->id;
+            blk->index = i;
+        }
+        shared->blocks[a->id][i] = (MemBlock)blk;
+    }
+
+    pthread_barrier_wait(&shared->barrier);
+
+    /* free every block of previous thread, after checking no one else got it */
+    Size from = (a->id + CBALLOC_TEST_THREADS - 1) % CBALLOC_TEST_THREADS;
+    Bool ok   = True;
+    for(Size i = 0; i < CBALLOC_TEST_BLOCKS; i++) {
+        CballocTestBlock* blk = (CballocTestBlock*)shared->blocks[from][i];
+        ok = ok && blk && blk->owner == from && blk->index == i;
+        if(blk) {
+            cballoc_free(shared->cba, (MemBlock)blk);
+        }
+    }
+    shared->intact[a->id] = ok;
+
+    /* magazine of this thread is returned to depot when it exits */
+    return NULL;
+}
+
+TEST_FN Bool RefillAndDrain_WHEN_MORE_BLOCKS_THAN_MAGAZINE() {
+    ConcurrentBlockAllocator* cba = cballoc_create(sizeof(CballocTestBlock));
+    TEST_OBJECT(cba);
+
+    MemBlock blocks[CBALLOC_TEST_MANY];
+
+    /* first allocation takes a batch of half a magazine from depot */
+    blocks[0] = cballoc_allocate(cba);
+    TEST_OBJECT(blocks[0]);
+    TEST_LENGTH_EQ(cba->depot->allocation_count, CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE / 2);
+
+    for(Size i = 1; i < CBALLOC_TEST_MANY; i++) {
+        blocks[i] = cballoc_allocate(cba);
+        TEST_OBJECT(blocks[i]);
+        ((CballocTestBlock*)blocks[i])->index = i;
+    }
+    for(Size i = 1; i < CBALLOC_TEST_MANY; i++) {
+        TEST_EQUALITY(((CballocTestBlock*)blocks[i])->index == i);
+    }
+    TEST_LENGTH_GE(cba->depot->allocation_count, CBALLOC_TEST_MANY);
+
+    /* frees fill magazine, then drain half of it to depot each time it's full */
+    for(Size i = 0; i < CBALLOC_TEST_MANY; i++) {
+        cballoc_free(cba, blocks[i]);
+    }
+    TEST_LENGTH_LE(cba->depot->allocation_count, CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE);
+    TEST_LENGTH_GT(cba->depot->allocation_count, 0);
+
+    AllocatorStats stats = cballoc_get_stats(cba);
+    TEST_LENGTH_EQ(stats.total_allocs, CBALLOC_TEST_MANY);
+    TEST_LENGTH_EQ(stats.total_frees, CBALLOC_TEST_MANY);
+    TEST_LENGTH_EQ(stats.live_count, 0);
+
+    DO_BEFORE_EXIT(
+        if(cba) cballoc_destroy(cba);
+    );
+}
+
+TEST_FN Bool Flush_WHEN_MAGAZINE_HAS_BLOCKS_THEN_DEPOT_GETS_ALL() {
+    ConcurrentBlockAllocator* cba = cballoc_create(sizeof(CballocTestBlock));
+    TEST_OBJECT(cba);
+
+    /* flushing a thread without a magazine does nothing */
+    cballoc_flush(cba);
+    TEST_LENGTH_EQ(cba->depot->allocation_count, 0);
+
+    MemBlock blk = cballoc_allocate(cba);
+    TEST_OBJECT(blk);
+    cballoc_free(cba, blk);
+    TEST_LENGTH_EQ(cba->depot->allocation_count, CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE / 2);
+
+    cballoc_flush(cba);
+    TEST_LENGTH_EQ(cba->depot->allocation_count, 0);
+
+    /* magazine is refilled again after a flush */
+    blk = cballoc_allocate(cba);
+    TEST_OBJECT(blk);
+    TEST_LENGTH_EQ(cba->depot->allocation_count, CONCURRENT_BLOCK_ALLOCATOR_MAGAZINE_SIZE / 2);
+    cballoc_free(cba, blk);
+
+    DO_BEFORE_EXIT(
+        if(cba) cballoc_destroy(cba);
+    );
+}
+
+TEST_FN Bool Free_WHEN_FREED_ON_OTHER_THREAD() {
+    CballocTestShared* shared = NEW(CballocTestShared);
+    TEST_OBJECT(shared);
+    shared->cba = cballoc_create(sizeof(CballocTestBlock));
+    TEST_OBJECT(shared->cba);
+    pthread_barrier_init(&shared->barrier, NULL, CBALLOC_TEST_THREADS);
+
+    pthread_t      threads[CBALLOC_TEST_THREADS];
+    CballocTestArg args[CBALLOC_TEST_THREADS];
+    Size           started = 0;
+    for(; started < CBALLOC_TEST_THREADS; started++) {
+        args[started] = (CballocTestArg) {shared, started};
+        if(pthread_create(threads + started, NULL, cballoc_test_worker, args + started)) {
+            break;
+        }
+    }
+    TEST_LENGTH_EQ(started, CBALLOC_TEST_THREADS);
+    for(Size t = 0; t < CBALLOC_TEST_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for(Size t = 0; t < CBALLOC_TEST_THREADS; t++) {
+        TEST_CONTENTS(shared->intact[t]);
+    }
+
+    /* every block was freed, and magazines of exited threads went back to depot */
+    TEST_LENGTH_EQ(shared->cba->depot->allocation_count, 0);
+    AllocatorStats stats = cballoc_get_stats(shared->cba);
+    TEST_LENGTH_EQ(stats.total_allocs, CBALLOC_TEST_THREADS * CBALLOC_TEST_BLOCKS);
+    TEST_LENGTH_EQ(stats.total_frees, CBALLOC_TEST_THREADS * CBALLOC_TEST_BLOCKS);
+    TEST_LENGTH_EQ(stats.live_count, 0);
+
+    DO_BEFORE_EXIT(
+        if(shared && shared->cba) {
+            pthread_barrier_destroy(&shared->barrier);
+            cballoc_destroy(shared->cba);
+        }
+        FREE(shared);
+    );
+}
+
+BEGIN_TESTS(cballoc)
+    TEST(RefillAndDrain_WHEN_MORE_BLOCKS_THAN_MAGAZINE),
+    TEST(Flush_WHEN_MAGAZINE_HAS_BLOCKS_THEN_DEPOT_GETS_ALL),
+    TEST(Free_WHEN_FREED_ON_OTHER_THREAD)
+END_TESTS()
@@ -0,0 +1,188 @@
+/**
+ * @file slaballoc.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for SlabAllocator, checking size classes, recycling of
+ * freed blocks through free lists, and large allocations.
+ * */
+
+#include <Anvie/Allocators/SlabAllocator.h>
+#include <Anvie/Containers/Vector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <string.h>
+
+/* more blocks of largest class than fit in one page */
+#define SLABALLOC_TEST_BLOCKS (SLAB_ALLOCATOR_PAGE_SIZE / SLAB_ALLOCATOR_MAX_BLOCK_SIZE * 3 + 5)
+
+TEST_FN Bool BlockSize_WHEN_ROUNDED_THEN_NEXT_POWER_OF_TWO() {
+    SlabAllocator* sla = slaballoc_create();
+    TEST_OBJECT(sla);
+
+    TEST_LENGTH_EQ(slaballoc_get_block_size(1), SLAB_ALLOCATOR_MIN_BLOCK_SIZE);
+    TEST_LENGTH_EQ(slaballoc_get_block_size(8), 8);
+    TEST_LENGTH_EQ(slaballoc_get_block_size(9), 16);
+    TEST_LENGTH_EQ(slaballoc_get_block_size(1025), 2048);
+    TEST_LENGTH_EQ(slaballoc_get_block_size(SLAB_ALLOCATOR_MAX_BLOCK_SIZE + 1), SLAB_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+
+    /* every block is aligned to it's size, up to alignment of page data */
+    for(Size size = 1; size <= SLAB_ALLOCATOR_MAX_BLOCK_SIZE; size = size * 2 + 1) {
+        Size align = MIN(slaballoc_get_block_size(size), (Size)16);
+        for(Size i = 0; i < 4; i++) {
+            void* p = slaballoc_allocate(sla, size);
+            TEST_EQUALITY(p && !((Uint64)p & (align - 1)));
+        }
+    }
+
+    DO_BEFORE_EXIT(
+        if(sla) slaballoc_destroy(sla);
+    );
+}
+
+TEST_FN Bool Free_WHEN_BLOCKS_FREED_THEN_RECYCLE_LAST_FREED_FIRST() {
+    SlabAllocator* sla = slaballoc_create();
+    Uint8*         blocks[SLABALLOC_TEST_BLOCKS];
+    TEST_OBJECT(sla);
+
+    for(Size i = 0; i < SLABALLOC_TEST_BLOCKS; i++) {
+        blocks[i] = slaballoc_allocate(sla, 48);
+        TEST_EQUALITY(blocks[i] != NULL);
+    }
+    AllocatorStats before = slaballoc_get_stats(sla);
+
+    /* free list is a stack, so blocks come back in reverse order of freeing */
+    for(Size i = 0; i < SLABALLOC_TEST_BLOCKS; i++) slaballoc_free(sla, blocks[i], 48);
+    TEST_LENGTH_EQ(slaballoc_get_stats(sla).live_count, 0);
+
+    /* freed blocks of one class never serve another */
+    Uint8* other = slaballoc_allocate(sla, 16);
+    TEST_EQUALITY(other != NULL);
+    for(Size i = 0; i < SLABALLOC_TEST_BLOCKS; i++) TEST_EQUALITY(other != blocks[i]);
+
+    for(Size i = SLABALLOC_TEST_BLOCKS; i--;) {
+        TEST_EQUALITY(slaballoc_allocate(sla, 33) == blocks[i]);
+    }
+
+    /* recycling takes no new pages */
+    AllocatorStats after = slaballoc_get_stats(sla);
+    TEST_LENGTH_EQ(after.chunk_count, before.chunk_count + 1);
+    TEST_LENGTH_EQ(after.live_count, SLABALLOC_TEST_BLOCKS + 1);
+    TEST_LENGTH_EQ(after.total_frees, SLABALLOC_TEST_BLOCKS);
+
+    DO_BEFORE_EXIT(
+        if(sla) slaballoc_destroy(sla);
+    );
+}
+
+TEST_FN Bool Allocate_WHEN_PAGES_FILL_THEN_BLOCKS_STAY_INTACT() {
+    SlabAllocator* sla = slaballoc_create();
+    Uint8*         blocks[SLABALLOC_TEST_BLOCKS];
+    Uint8*         large  = NULL;
+    TEST_OBJECT(sla);
+
+    for(Size i = 0; i < SLABALLOC_TEST_BLOCKS; i++) {
+        blocks[i] = slaballoc_allocate(sla, SLAB_ALLOCATOR_MAX_BLOCK_SIZE);
+        TEST_EQUALITY(blocks[i] != NULL);
+        memset(blocks[i], (int)i, SLAB_ALLOCATOR_MAX_BLOCK_SIZE);
+    }
+    for(Size i = 0; i < SLABALLOC_TEST_BLOCKS; i++) {
+        TEST_EQUALITY(blocks[i][0] == (Uint8)i && blocks[i][SLAB_ALLOCATOR_MAX_BLOCK_SIZE - 1] == (Uint8)i);
+    }
+
+    AllocatorStats stats = slaballoc_get_stats(sla);
+    TEST_LENGTH_EQ(stats.chunk_count, 4);
+    TEST_LENGTH_EQ(stats.used_bytes, SLABALLOC_TEST_BLOCKS * SLAB_ALLOCATOR_MAX_BLOCK_SIZE);
+    TEST_EQUALITY(stats.fragmentation == 0.f);
+
+    /* freed blocks count as fragmentation until they are reused */
+    for(Size i = 0; i < SLABALLOC_TEST_BLOCKS; i += 2) slaballoc_free(sla, blocks[i], SLAB_ALLOCATOR_MAX_BLOCK_SIZE);
+    TEST_EQUALITY(slaballoc_get_stats(sla).fragmentation > 0.f);
+
+    /* large allocations go to system allocator, and are counted in stats */
+    large = slaballoc_allocate(sla, SLAB_ALLOCATOR_MAX_BLOCK_SIZE * 2);
+    TEST_EQUALITY(large != NULL);
+    TEST_LENGTH_EQ(slaballoc_get_stats(sla).reserved_bytes, 4 * SLAB_ALLOCATOR_PAGE_SIZE + SLAB_ALLOCATOR_MAX_BLOCK_SIZE * 2);
+
+    DO_BEFORE_EXIT(
+        if(large) slaballoc_free(sla, large, SLAB_ALLOCATOR_MAX_BLOCK_SIZE * 2);
+        if(sla) slaballoc_destroy(sla);
+    );
+}
+
+TEST_FN Bool Reallocate_WHEN_CLASS_CHANGES_THEN_MOVE_CONTENTS() {
+    SlabAllocator* sla = slaballoc_create();
+    Uint8*         p   = NULL;
+    TEST_OBJECT(sla);
+
+    p = slaballoc_allocate(sla, 20);
+    TEST_EQUALITY(p != NULL);
+    for(Size i = 0; i < 20; i++) p[i] = (Uint8)i;
+
+    /* same class keeps block, larger class moves it and frees old one */
+    TEST_EQUALITY(slaballoc_reallocate(sla, p, 20, 32) == p);
+    Uint8* moved = slaballoc_reallocate(sla, p, 32, 100);
+    TEST_EQUALITY(moved && moved != p);
+    p = moved;
+    for(Size i = 0; i < 20; i++) TEST_EQUALITY(p[i] == (Uint8)i);
+    TEST_LENGTH_EQ(slaballoc_get_stats(sla).live_count, 1);
+
+    /* into and out of large allocations */
+    p = slaballoc_reallocate(sla, p, 100, 10000);
+    TEST_EQUALITY(p && p[19] == 19 && sla->large_count == 1);
+    p = slaballoc_reallocate(sla, p, 10000, 64);
+    TEST_EQUALITY(p && p[19] == 19 && sla->large_count == 0);
+
+    DO_BEFORE_EXIT(
+        if(p) slaballoc_free(sla, p, 64);
+        if(sla) slaballoc_destroy(sla);
+    );
+}
+
+TEST_FN Bool Allocator_WHEN_USED_BY_CONTAINER_THEN_RETURN_ALL() {
+    SlabAllocator* sla       = slaballoc_create();
+    Allocator      allocator = {0};
+    U64_Vector*    vec       = NULL;
+    TEST_OBJECT(sla);
+
+    allocator = slaballoc_get_allocator(sla);
+    vec       = u64_vector_create_with_allocator(&allocator);
+    TEST_EQUALITY(vec != NULL);
+
+    /* vector grows from small blocks into a large allocation */
+    for(Uint64 i = 0; i < 1000; i++) u64_vector_push_back(vec, i, NULL);
+    for(Uint64 i = 0; i < 1000; i++) TEST_EQUALITY(vec->data[i] == i);
+    TEST_LENGTH_GT(slaballoc_get_stats(sla).live_count, 0);
+
+    u64_vector_destroy(vec, NULL);
+    vec = NULL;
+    TEST_LENGTH_EQ(slaballoc_get_stats(sla).live_count, 0);
+    TEST_LENGTH_EQ(sla->large_count, 0);
+
+    DO_BEFORE_EXIT(
+        if(vec) u64_vector_destroy(vec, NULL);
+        if(sla) slaballoc_destroy(sla);
+    );
+}
+
+BEGIN_TESTS(slaballoc)
+    TEST(BlockSize_WHEN_ROUNDED_THEN_NEXT_POWER_OF_TWO),
+    TEST(Free_WHEN_BLOCKS_FREED_THEN_RECYCLE_LAST_FREED_FIRST),
+    TEST(Allocate_WHEN_PAGES_FILL_THEN_BLOCKS_STAY_INTACT),
+    TEST(Reallocate_WHEN_CLASS_CHANGES_THEN_MOVE_CONTENTS),
+    TEST(Allocator_WHEN_USED_BY_CONTAINER_THEN_RETURN_ALL)
+END_TESTS()
@@ -0,0 +1,162 @@
+/**
+ * @file atomic_bitvec_claim.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for claim operations of AtomicBitVector.
+ * */
+
+#include <Anvie/Containers/AtomicBitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <pthread.h>
+
+#define CLAIM_TEST_THREADS 4
+
+/* not a multiple of 64, so last word is partial */
+#define CLAIM_TEST_LENGTH (64 * 157 + 37)
+
+typedef struct ClaimTestArg {
+    AtomicBitVector* abv;
+    Bool             from_first; /**< claim with claim_first_clear instead of claim_next_clear */
+    Size             from;
+    Size             count;
+    Size*            claimed;
+} ClaimTestArg;
+
+static void* claim_test_worker(void* arg) {
+    ClaimTestArg* a = arg;
+    for(;;) {
+        Size bit = a->from_first ? atomic_bitvec_claim_first_clear(a->abv) : atomic_bitvec_claim_next_clear(a->abv, a->from);
+        if(bit == SIZE_MAX) {
+            return NULL;
+        }
+        a->claimed[a->count++] = bit;
+    }
+}
+
+/* claim all bits from several threads at once, and check each one went to exactly one thread */
+static Bool claim_test_concurrent(Bool from_first) {
+    AtomicBitVector* abv    = atomic_bitvec_create(CLAIM_TEST_LENGTH);
+    Uint8*           owners = ALLOCATE(Uint8, CLAIM_TEST_LENGTH);
+    ClaimTestArg     args[CLAIM_TEST_THREADS] = {0};
+    pthread_t        threads[CLAIM_TEST_THREADS];
+    Size             started = 0;
+    TEST_OBJECT(abv && owners);
+
+    for(; started < CLAIM_TEST_THREADS; started++) {
+        ClaimTestArg* a = args + started;
+        a->abv        = abv;
+        a->from_first = from_first;
+        a->from       = started * CLAIM_TEST_LENGTH / CLAIM_TEST_THREADS + 5;
+        a->claimed    = ALLOCATE(Size, CLAIM_TEST_LENGTH);
+        if(!a->claimed || pthread_create(threads + started, NULL, claim_test_worker, a)) {
+            break;
+        }
+    }
+    for(Size t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    TEST_LENGTH_EQ(started, CLAIM_TEST_THREADS);
+
+    Size total = 0;
+    for(Size t = 0; t < CLAIM_TEST_THREADS; t++) {
+        for(Size i = 0; i < args[t].count; i++) {
+            TEST_LENGTH_LT(args[t].claimed[i], CLAIM_TEST_LENGTH);
+            owners[args[t].claimed[i]]++;
+        }
+        total += args[t].count;
+    }
+
+    TEST_LENGTH_EQ(total, CLAIM_TEST_LENGTH);
+    for(Size i = 0; i < CLAIM_TEST_LENGTH; i++) {
+        TEST_EQUALITY(owners[i] == 1);
+    }
+    TEST_LENGTH_EQ(atomic_bitvec_popcount(abv), CLAIM_TEST_LENGTH);
+    TEST_EQUALITY(atomic_bitvec_claim_first_clear(abv) == SIZE_MAX);
+
+    DO_BEFORE_EXIT(
+        for(Size t = 0; t < CLAIM_TEST_THREADS; t++) {
+            FREE(args[t].claimed);
+        }
+        FREE(owners);
+        if(abv) atomic_bitvec_destroy(abv);
+    );
+}
+
+TEST_FN Bool ClaimNextClear_WHEN_MANY_THREADS_THEN_EACH_BIT_ONCE() {
+    return claim_test_concurrent(False);
+}
+
+TEST_FN Bool ClaimFirstClear_WHEN_MANY_THREADS_THEN_EACH_BIT_ONCE() {
+    return claim_test_concurrent(True);
+}
+
+TEST_FN Bool ClaimFirstClear_WHEN_LAST_WORD_IS_PARTIAL() {
+    AtomicBitVector* abv = atomic_bitvec_create(130);
+    TEST_OBJECT(abv);
+
+    for(Size i = 0; i < 130; i++) {
+        TEST_EQUALITY(atomic_bitvec_claim_first_clear(abv) == i);
+    }
+
+    /* bits past length are never handed out */
+    TEST_EQUALITY(atomic_bitvec_claim_first_clear(abv) == SIZE_MAX);
+    TEST_EQUALITY(atomic_bitvec_load_word(abv, 2) == 3);
+
+    /* a bit cleared again can be claimed again */
+    atomic_bitvec_clear(abv, 129);
+    TEST_EQUALITY(atomic_bitvec_claim_first_clear(abv) == 129);
+
+    DO_BEFORE_EXIT(
+        if(abv) atomic_bitvec_destroy(abv);
+    );
+}
+
+TEST_FN Bool ClaimNextClear_WHEN_SEARCH_WRAPS_AROUND() {
+    AtomicBitVector* abv = atomic_bitvec_create(200);
+    TEST_OBJECT(abv);
+
+    /* only bits 65, 100 and 199 clear */
+    for(Size i = 0; i < 200; i++) {
+        if(i != 65 && i != 100 && i != 199) atomic_bitvec_set(abv, i);
+    }
+
+    /* search starts at bit 70, goes to end of vector and wraps to bits of it's first word before it */
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 70) == 100);
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 70) == 199);
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 70) == 65);
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 70) == SIZE_MAX);
+
+    /* start is wrapped to length */
+    atomic_bitvec_clear(abv, 3);
+    atomic_bitvec_clear(abv, 10);
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 200 + 5) == 10);
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 199) == 3);
+    TEST_EQUALITY(atomic_bitvec_claim_next_clear(abv, 0) == SIZE_MAX);
+
+    DO_BEFORE_EXIT(
+        if(abv) atomic_bitvec_destroy(abv);
+    );
+}
+
+BEGIN_TESTS(atomic_bitvec_claim)
+    TEST(ClaimNextClear_WHEN_MANY_THREADS_THEN_EACH_BIT_ONCE),
+    TEST(ClaimFirstClear_WHEN_MANY_THREADS_THEN_EACH_BIT_ONCE),
+    TEST(ClaimFirstClear_WHEN_LAST_WORD_IS_PARTIAL),
+    TEST(ClaimNextClear_WHEN_SEARCH_WRAPS_AROUND)
+END_TESTS()
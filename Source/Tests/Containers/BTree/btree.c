@@ -0,0 +1,227 @@
+/**
+ * @file btree.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for BTree, keeping keys ordered through inserts and deletes,
+ * and visiting exactly keys in half open ranges.
+ * */
+
+#include <Anvie/Containers/BTree.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include <stdio.h>
+
+/* enough keys for a tree of three levels */
+#define BTREE_TEST_KEYS 6000
+
+/* k-th of a permutation of [0, BTREE_TEST_KEYS), so that keys are not inserted in order */
+#define BTREE_TEST_SHUFFLE(k) (((k) * 7919) % BTREE_TEST_KEYS)
+
+/* keys visited by a range iterator are increasing and in [low, high), and are all such keys of tree */
+static Bool btree_test_check_range(BTree* tree, Uint64 low, Uint64 high, Size expected) {
+    BTreeIterator iter  = btree_range(tree, (void*)low, (void*)high, NULL);
+    Size          count = 0;
+    Uint64        prev  = 0;
+    for(BTreeItem* item = btree_iter_next(&iter); item; item = btree_iter_next(&iter)) {
+        Uint64 key = (Uint64)item->key;
+        if(key < low || key >= high || (count && key <= prev) || (Uint64)item->data != key * 2) {
+            return False;
+        }
+        prev = key;
+        count++;
+    }
+    return count == expected;
+}
+
+TEST_FN Bool Insert_WHEN_KEYS_SHUFFLED_THEN_ITERATE_IN_ORDER() {
+    I64_U64_BTree* tree = i64_u64_btree_create();
+    TEST_OBJECT(tree);
+
+    /* negative keys must sort before positive ones */
+    for(Int64 k = 0; k < BTREE_TEST_KEYS; k++) {
+        Int64 key = BTREE_TEST_SHUFFLE(k) - BTREE_TEST_KEYS / 2;
+        TEST_EQUALITY(i64_u64_btree_insert(tree, key, (Uint64)k, NULL) != NULL);
+    }
+    TEST_LENGTH_EQ(btree_count(tree), BTREE_TEST_KEYS);
+    TEST_LENGTH_GT(btree_height(tree), 2);
+
+    /* inserting an existing key replaces it's data */
+    TEST_EQUALITY(i64_u64_btree_insert(tree, -5, 12345, NULL) != NULL);
+    TEST_LENGTH_EQ(btree_count(tree), BTREE_TEST_KEYS);
+    I64_U64_BTreeItem* found = i64_u64_btree_search(tree, -5, NULL);
+    TEST_EQUALITY(found && found->key == -5 && found->data == 12345);
+    TEST_EQUALITY(!i64_u64_btree_search(tree, BTREE_TEST_KEYS, NULL));
+
+    BTreeIterator iter = btree_iter(tree);
+    Int64         next = -BTREE_TEST_KEYS / 2;
+    for(BTreeItem* item = btree_iter_next(&iter); item; item = btree_iter_next(&iter)) {
+        TEST_EQUALITY((Int64)item->key == next++);
+    }
+    TEST_EQUALITY(next == BTREE_TEST_KEYS / 2);
+
+    DO_BEFORE_EXIT(
+        if(tree) i64_u64_btree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool Range_WHEN_BOUNDS_GIVEN_THEN_VISIT_HALF_OPEN_RANGE() {
+    U64_U64_BTree* tree = u64_u64_btree_create();
+    TEST_OBJECT(tree);
+
+    /* even keys in [10, 2 * BTREE_TEST_KEYS + 10), and a few beyond top bit */
+    for(Uint64 k = 0; k < BTREE_TEST_KEYS; k++) {
+        Uint64 key = 2 * BTREE_TEST_SHUFFLE(k) + 10;
+        TEST_EQUALITY(u64_u64_btree_insert(tree, key, key * 2, NULL) != NULL);
+    }
+    for(Uint64 key = UINT64_MAX - 6; key < UINT64_MAX; key += 2) {
+        TEST_EQUALITY(u64_u64_btree_insert(tree, key, key * 2, NULL) != NULL);
+    }
+
+    /* bounds that are keys, and bounds between keys */
+    TEST_EQUALITY(btree_test_check_range(tree, 100, 200, 50));
+    TEST_EQUALITY(btree_test_check_range(tree, 99, 201, 51));
+    TEST_EQUALITY(btree_test_check_range(tree, 101, 102, 0));
+    TEST_EQUALITY(btree_test_check_range(tree, 100, 101, 1));
+
+    /* empty and inverted ranges */
+    TEST_EQUALITY(btree_test_check_range(tree, 100, 100, 0));
+    TEST_EQUALITY(btree_test_check_range(tree, 200, 100, 0));
+
+    /* bounds below smallest key and above largest one */
+    TEST_EQUALITY(btree_test_check_range(tree, 0, 14, 2));
+    TEST_EQUALITY(btree_test_check_range(tree, 0, UINT64_MAX, BTREE_TEST_KEYS + 3));
+    TEST_EQUALITY(btree_test_check_range(tree, (Uint64)1 << 63, UINT64_MAX, 3));
+    TEST_EQUALITY(btree_test_check_range(tree, UINT64_MAX - 1, UINT64_MAX, 0));
+
+    /* lower bound of a missing key is next larger key */
+    BTreeIterator iter = btree_lower_bound(tree, (void*)(Uint64)31, NULL);
+    BTreeItem*    item = btree_iter_next(&iter);
+    TEST_EQUALITY(item && (Uint64)item->key == 32);
+
+    DO_BEFORE_EXIT(
+        if(tree) u64_u64_btree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool Delete_WHEN_ITEMS_REMOVED_THEN_KEEP_REST_ORDERED() {
+    U64_U64_BTree* tree = u64_u64_btree_create();
+    TEST_OBJECT(tree);
+
+    for(Uint64 k = 0; k < BTREE_TEST_KEYS; k++) {
+        Uint64 key = BTREE_TEST_SHUFFLE(k);
+        TEST_EQUALITY(u64_u64_btree_insert(tree, key, key * 2, NULL) != NULL);
+    }
+
+    /* removing most of items merges nodes, rest must stay reachable and ordered */
+    for(Uint64 k = 0; k < BTREE_TEST_KEYS; k++) {
+        Uint64 key = BTREE_TEST_SHUFFLE(k);
+        if(key % 5) {
+            TEST_EQUALITY(u64_u64_btree_delete(tree, key, NULL));
+        }
+    }
+    TEST_EQUALITY(!u64_u64_btree_delete(tree, 1, NULL));
+    TEST_LENGTH_EQ(btree_count(tree), BTREE_TEST_KEYS / 5);
+    TEST_EQUALITY(btree_test_check_range(tree, 0, BTREE_TEST_KEYS, BTREE_TEST_KEYS / 5));
+    for(Uint64 key = 0; key < BTREE_TEST_KEYS; key++) {
+        TEST_EQUALITY(!u64_u64_btree_search(tree, key, NULL) == (key % 5 != 0));
+    }
+
+    for(Uint64 key = 0; key < BTREE_TEST_KEYS; key += 5) {
+        TEST_EQUALITY(u64_u64_btree_delete(tree, key, NULL));
+    }
+    TEST_LENGTH_EQ(btree_count(tree), 0);
+    TEST_LENGTH_EQ(btree_height(tree), 0);
+    TEST_EQUALITY(btree_test_check_range(tree, 0, UINT64_MAX, 0));
+
+    DO_BEFORE_EXIT(
+        if(tree) u64_u64_btree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool Insert_WHEN_KEYS_ARE_STRINGS_THEN_ORDER_BY_COMPARATOR() {
+    ZStr_U64_BTree* tree = zstr_u64_btree_create();
+    Char            buf[32];
+    TEST_OBJECT(tree);
+
+    /* zero padded, so that string order is number order */
+    for(Uint64 k = 0; k < BTREE_TEST_KEYS; k++) {
+        snprintf(buf, sizeof(buf), "key-%06zu", (Size)BTREE_TEST_SHUFFLE(k));
+        TEST_EQUALITY(zstr_u64_btree_insert(tree, buf, BTREE_TEST_SHUFFLE(k), NULL) != NULL);
+    }
+    for(Uint64 k = 0; k < BTREE_TEST_KEYS; k += 2) {
+        snprintf(buf, sizeof(buf), "key-%06zu", (Size)k);
+        TEST_EQUALITY(zstr_u64_btree_delete(tree, buf, NULL));
+    }
+
+    BTreeIterator iter = btree_range(tree, "key-000100", "key-000200", NULL);
+    Uint64        next = 101;
+    for(BTreeItem* item = btree_iter_next(&iter); item; item = btree_iter_next(&iter), next += 2) {
+        snprintf(buf, sizeof(buf), "key-%06zu", (Size)next);
+        TEST_EQUALITY(item->key != buf && !strcmp(item->key, buf) && (Uint64)item->data == next);
+    }
+    TEST_EQUALITY(next == 201);
+
+    DO_BEFORE_EXIT(
+        if(tree) zstr_u64_btree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool Build_WHEN_KEYS_SORTED_THEN_MATCH_INSERTED_TREE() {
+    BTree*  tree   = u64_u64_btree_create();
+    Uint64* keys   = ALLOCATE(Uint64, BTREE_TEST_KEYS);
+    Uint64* values = ALLOCATE(Uint64, BTREE_TEST_KEYS);
+    TEST_EQUALITY(tree && keys && values);
+
+    for(Uint64 k = 0; k < BTREE_TEST_KEYS; k++) {
+        keys[k]   = 3 * k;
+        values[k] = 6 * k;
+    }
+
+    /* keys out of order are rejected, leaving tree empty */
+    Uint64 swap = keys[10];
+    keys[10]    = keys[11];
+    keys[11]    = swap;
+    TEST_EQUALITY(!btree_build_from_sorted(tree, keys, values, BTREE_TEST_KEYS, NULL));
+    TEST_LENGTH_EQ(btree_count(tree), 0);
+    keys[11] = keys[10];
+    keys[10] = swap;
+
+    TEST_EQUALITY(btree_build_from_sorted(tree, keys, values, BTREE_TEST_KEYS, NULL));
+    TEST_LENGTH_EQ(btree_count(tree), BTREE_TEST_KEYS);
+    TEST_EQUALITY(btree_test_check_range(tree, 0, 3 * BTREE_TEST_KEYS, BTREE_TEST_KEYS));
+
+    /* built tree takes inserts and deletes like any other */
+    TEST_EQUALITY(u64_u64_btree_insert(tree, 4, 8, NULL) != NULL);
+    TEST_EQUALITY(u64_u64_btree_delete(tree, 3, NULL));
+    TEST_EQUALITY(btree_test_check_range(tree, 0, 7, 3));
+
+    DO_BEFORE_EXIT(
+        if(tree) u64_u64_btree_destroy(tree, NULL);
+        FREE(keys);
+        FREE(values);
+    );
+}
+
+BEGIN_TESTS(btree)
+    TEST(Insert_WHEN_KEYS_SHUFFLED_THEN_ITERATE_IN_ORDER),
+    TEST(Range_WHEN_BOUNDS_GIVEN_THEN_VISIT_HALF_OPEN_RANGE),
+    TEST(Delete_WHEN_ITEMS_REMOVED_THEN_KEEP_REST_ORDERED),
+    TEST(Insert_WHEN_KEYS_ARE_STRINGS_THEN_ORDER_BY_COMPARATOR),
+    TEST(Build_WHEN_KEYS_SORTED_THEN_MATCH_INSERTED_TREE)
+END_TESTS()
@@ -51,6 +51,17 @@ IMPORT_UNIT_TEST(bitvec_shl)
 IMPORT_UNIT_TEST(bitvec_shr)
 IMPORT_UNIT_TEST(bitvec_not)
 IMPORT_UNIT_TEST(bitvec_cmpeq)
+IMPORT_UNIT_TEST(bitvec_andnot)
+IMPORT_UNIT_TEST(bitvec_and_into)
+IMPORT_UNIT_TEST(bitvec_or_assign)
+IMPORT_UNIT_TEST(bitvec_not_assign)
+IMPORT_UNIT_TEST(bitvec_or_many)
+IMPORT_UNIT_TEST(bitvec_popcount)
+IMPORT_UNIT_TEST(bitvec_rank)
+IMPORT_UNIT_TEST(bitvec_find_next_set)
+IMPORT_UNIT_TEST(bitvec_foreach_set)
+IMPORT_UNIT_TEST(bitvec_shl_assign)
+IMPORT_UNIT_TEST(bitvec_shr_assign)
 
 IMPORT_UNIT_TEST(drop_in_replacements)
 
@@ -0,0 +1,126 @@
+/**
+ * @file bitvec_and_into.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_and_into in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool AndInto_WHEN_DESTINATION_IS_LONGER() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    BitVector* dst = bitvec_create();
+    TEST_OBJECT(bv1 && bv2 && dst);
+
+    Size len = 32, dstlen = 128;
+    Size sz = DIV8(len), dstsz = DIV8(dstlen);
+    bv1->length = len;
+    bv2->length = len;
+    dst->length = dstlen;
+    memset(bv1->data, 0xbb, sz);
+    memset(bv2->data, 0x22, sz);
+    memset(dst->data, 0xff, dstsz);
+
+    Uint8* dstdata = dst->data;
+    Size dstcap = dst->capacity;
+    bitvec_and_into(dst, bv1, bv2);
+
+    /* memory of destination is reused */
+    TEST_DATA_PTR(dst->data == dstdata);
+    TEST_LENGTH_EQ(dst->capacity, dstcap);
+    TEST_LENGTH_EQ(dst->length, len);
+
+    /* old bits of destination past new length are cleared */
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data, sz, AND(0xbb, 0x22)));
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data + sz, bitvec_get_capacity_in_bytes(dst) - sz, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+        if(dst) bitvec_destroy(dst);
+    );
+}
+
+TEST_FN Bool AndInto_WHEN_DESTINATION_IS_TOO_SMALL() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    BitVector* dst = bitvec_create();
+    TEST_OBJECT(bv1 && bv2 && dst);
+
+    /* more than default capacity of destination */
+    Size len = 1000;
+    Size sz = DIV8(len);
+    bitvec_reserve(bv1, len);
+    bitvec_reserve(bv2, len);
+    bv1->length = len;
+    bv2->length = len;
+    memset(bv1->data, 0xf0, sz);
+    memset(bv2->data, 0x3c, sz);
+
+    bitvec_and_into(dst, bv1, bv2);
+
+    TEST_LENGTH_EQ(dst->length, len);
+    TEST_LENGTH_GE(dst->capacity, len);
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data, sz, AND(0xf0, 0x3c)));
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data + sz, bitvec_get_capacity_in_bytes(dst) - sz, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+        if(dst) bitvec_destroy(dst);
+    );
+}
+
+TEST_FN Bool AndInto_WHEN_DESTINATION_IS_AN_OPERAND() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    TEST_OBJECT(bv1 && bv2);
+
+    Size len1 = 16, len2 = 32;
+    Size sz1 = DIV8(len1), sz2 = DIV8(len2);
+    bv1->length = len1;
+    bv2->length = len2;
+    memset(bv1->data, 0xaa, sz1);
+    memset(bv2->data, 0x0f, sz2);
+
+    /* shorter operand is destination, so it grows */
+    bitvec_and_into(bv1, bv1, bv2);
+
+    TEST_LENGTH_EQ(bv1->length, len2);
+    TEST_CONTENTS(is_memory_filled_with_byte(bv1->data, sz1, AND(0xaa, 0x0f)));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv1->data + sz1, bitvec_get_capacity_in_bytes(bv1) - sz1, 0x00));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv2->data, sz2, 0x0f));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+    );
+}
+
+BEGIN_TESTS(bitvec_and_into)
+    TEST(AndInto_WHEN_DESTINATION_IS_LONGER),
+    TEST(AndInto_WHEN_DESTINATION_IS_TOO_SMALL),
+    TEST(AndInto_WHEN_DESTINATION_IS_AN_OPERAND)
+END_TESTS()
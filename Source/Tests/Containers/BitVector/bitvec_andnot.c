@@ -0,0 +1,101 @@
+/**
+ * @file bitvec_andnot.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_andnot in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool AndNot_WHEN_LENGTH_IS_EQUAL() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    TEST_OBJECT(bv1 && bv2);
+
+    Size len = 32;
+    Size sz = DIV8(len);
+    bv1->length = len;
+    bv2->length = len;
+    memset(bv1->data, 0xbb, sz);
+    memset(bv2->data, 0x22, sz);
+
+    BitVector* bvres = bitvec_andnot(bv1, bv2);
+
+    TEST_OBJECT(bvres);
+    TEST_DATA_PTR(bvres->data && bv1->data && bv2->data);
+    TEST_LENGTH_EQ(bvres->length, len);
+
+    /* check bv1 and bv2 are untouched */
+    TEST_CONTENTS(is_memory_filled_with_byte(bv1->data, sz, 0xbb));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv2->data, sz, 0x22));
+    /* test bvres */
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres->data, sz, ANDNOT(0xbb, 0x22))); /* 0x99 */
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres->data + sz, bitvec_get_capacity_in_bytes(bvres) - sz, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+        if(bvres) bitvec_destroy(bvres);
+    );
+}
+
+TEST_FN Bool AndNot_WHEN_LENGTH_IS_NON_ZERO_NOT_EQUAL() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    TEST_OBJECT(bv1 && bv2);
+
+    Size len1 = 32, len2 = DIV2(len1);
+    Size sz1 = DIV8(len1); Size sz2 = DIV8(len2);
+    bv1->length = len1;
+    bv2->length = len2;
+    memset(bv1->data, 0xaa, sz1);
+    memset(bv2->data, 0x0a, sz2);
+
+    /* operation is not commutative, check both orders */
+    BitVector* bvres1 = bitvec_andnot(bv1, bv2);
+    BitVector* bvres2 = bitvec_andnot(bv2, bv1);
+
+    TEST_OBJECT(bvres1 && bvres2);
+    TEST_LENGTH_EQ(bvres1->length, len1);
+    TEST_LENGTH_EQ(bvres2->length, len1);
+
+    /* missing bits of shorter bitvector are cleared */
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres1->data, sz2, ANDNOT(0xaa, 0x0a))); /* 0xa0 */
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres1->data + sz2, sz1 - sz2, 0xaa));
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres1->data + sz1, bitvec_get_capacity_in_bytes(bvres1) - sz1, 0x00));
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres2->data, sz2, ANDNOT(0x0a, 0xaa))); /* 0x00 */
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres2->data + sz2, bitvec_get_capacity_in_bytes(bvres2) - sz2, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+        if(bvres1) bitvec_destroy(bvres1);
+        if(bvres2) bitvec_destroy(bvres2);
+    );
+}
+
+BEGIN_TESTS(bitvec_andnot)
+    TEST(AndNot_WHEN_LENGTH_IS_EQUAL),
+    TEST(AndNot_WHEN_LENGTH_IS_NON_ZERO_NOT_EQUAL)
+END_TESTS()
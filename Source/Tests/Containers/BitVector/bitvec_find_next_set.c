@@ -0,0 +1,99 @@
+/**
+ * @file bitvec_find_next_set.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_find_next_set in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool FindSet_WHEN_LENGTH_IS_ZERO() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    TEST_LENGTH_EQ(bitvec_find_first_set(bv), SIZE_MAX);
+    TEST_LENGTH_EQ(bitvec_find_first_clear(bv), SIZE_MAX);
+    TEST_LENGTH_EQ(bitvec_find_next_set(bv, 10), SIZE_MAX);
+    TEST_LENGTH_EQ(bitvec_find_next_clear(bv, 10), SIZE_MAX);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool FindSet_WHEN_BITS_ARE_FAR_APART() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 200;
+    bv->length = len;
+    bv->data[DIV8(3)]   |= (Uint8)(1 << MOD8(3));
+    bv->data[DIV8(130)] |= (Uint8)(1 << MOD8(130));
+    bv->data[DIV8(199)] |= (Uint8)(1 << MOD8(199));
+
+    TEST_LENGTH_EQ(bitvec_find_first_set(bv), 3);
+    TEST_LENGTH_EQ(bitvec_find_next_set(bv, 3), 3);
+    TEST_LENGTH_EQ(bitvec_find_next_set(bv, 4), 130);
+    TEST_LENGTH_EQ(bitvec_find_next_set(bv, 131), 199);
+    TEST_LENGTH_EQ(bitvec_find_next_set(bv, 200), SIZE_MAX);
+
+    TEST_LENGTH_EQ(bitvec_find_first_clear(bv), 0);
+    TEST_LENGTH_EQ(bitvec_find_next_clear(bv, 3), 4);
+    TEST_LENGTH_EQ(bitvec_find_next_clear(bv, 199), SIZE_MAX);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool FindClear_WHEN_ALL_BITS_ARE_SET() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    /* cleared bits past length must not be reported */
+    Size len = 203;
+    Size sz = DIV8(len);
+    bv->length = len;
+    memset(bv->data, 0xff, sz);
+    bv->data[sz] = GET8_LO(0xff, MOD8(len));
+
+    TEST_LENGTH_EQ(bitvec_find_first_clear(bv), SIZE_MAX);
+    TEST_LENGTH_EQ(bitvec_find_next_clear(bv, 150), SIZE_MAX);
+    TEST_LENGTH_EQ(bitvec_find_next_set(bv, 202), 202);
+
+    /* clear one bit in the middle */
+    bv->data[DIV8(100)] &= (Uint8)~(1 << MOD8(100));
+    TEST_LENGTH_EQ(bitvec_find_first_clear(bv), 100);
+    TEST_LENGTH_EQ(bitvec_find_next_clear(bv, 101), SIZE_MAX);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_find_next_set)
+    TEST(FindSet_WHEN_LENGTH_IS_ZERO),
+    TEST(FindSet_WHEN_BITS_ARE_FAR_APART),
+    TEST(FindClear_WHEN_ALL_BITS_ARE_SET)
+END_TESTS()
@@ -0,0 +1,84 @@
+/**
+ * @file bitvec_foreach_set.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_foreach_set in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+typedef struct VisitRecord {
+    Size count;
+    Size indices[8];
+} VisitRecord;
+
+static void record_index(Size index, void* udata) {
+    VisitRecord* rec = udata;
+    if(rec->count < 8) rec->indices[rec->count] = index;
+    rec->count++;
+}
+
+TEST_FN Bool ForeachSet_WHEN_BITS_ARE_SET() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 200;
+    bv->length = len;
+    bv->data[0] = 0x81; /* 0 and 7 */
+    bv->data[DIV8(64)] |= 1; /* 64 */
+    bv->data[DIV8(199)] |= (Uint8)(1 << MOD8(199)); /* 199 */
+
+    VisitRecord rec = {0};
+    bitvec_foreach_set(bv, record_index, &rec);
+
+    TEST_LENGTH_EQ(rec.count, 4);
+    TEST_CONTENTS(rec.indices[0] == 0);
+    TEST_CONTENTS(rec.indices[1] == 7);
+    TEST_CONTENTS(rec.indices[2] == 64);
+    TEST_CONTENTS(rec.indices[3] == 199);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool ForeachSet_WHEN_NO_BITS_ARE_SET() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    bv->length = 100;
+
+    VisitRecord rec = {0};
+    bitvec_foreach_set(bv, record_index, &rec);
+    TEST_LENGTH_EQ(rec.count, 0);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_foreach_set)
+    TEST(ForeachSet_WHEN_BITS_ARE_SET),
+    TEST(ForeachSet_WHEN_NO_BITS_ARE_SET)
+END_TESTS()
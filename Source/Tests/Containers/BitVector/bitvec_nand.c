@@ -180,8 +180,36 @@ TEST_FN Bool Nand_WHEN_LENGTH_IS_EQUAL() {
     );
 }
 
+TEST_FN Bool Nand_WHEN_LENGTH_IS_NOT_ALIGNED_TO_WORD() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    TEST_OBJECT(bv1 && bv2);
+
+    /* long enough to go through SIMD registers, words and a partial byte */
+    Size len = 203;
+    resizebv(bv1, len);
+    resizebv(bv2, len);
+
+    BitVector* bvres = bitvec_nand(bv1, bv2);
+    TEST_OBJECT(bvres);
+    TEST_LENGTH_EQ(bvres->length, len);
+
+    /* nand of cleared bits is set, but only up to length */
+    Size sz = DIV8(len);
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres->data, sz, 0xff));
+    TEST_CONTENTS(bvres->data[sz] == GET8_LO(0xff, MOD8(len)));
+    TEST_CONTENTS(is_memory_filled_with_byte(bvres->data + sz + 1, bitvec_get_capacity_in_bytes(bvres) - sz - 1, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+        if(bvres) bitvec_destroy(bvres);
+    );
+}
+
 BEGIN_TESTS(bitvec_nand)
     TEST(Nand_WHEN_LENGTH_IS_NOT_ALIGED_TO_8BIT),
+    TEST(Nand_WHEN_LENGTH_IS_NOT_ALIGNED_TO_WORD),
     TEST(Nand_WHEN_LENGTH_IS_ZERO),
     TEST(Nand_WHEN_LENGTH_IS_NON_ZERO_NOT_EQUAL),
     TEST(Nand_WHEN_LENGTH_IS_EQUAL)
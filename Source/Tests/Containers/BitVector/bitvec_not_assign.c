@@ -0,0 +1,72 @@
+/**
+ * @file bitvec_not_assign.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_not_assign in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool NotAssign_WHEN_LENGTH_IS_NOT_ALIGNED_TO_8BIT() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 13;
+    resizebv(bv, len);
+    bv->data[0] = 0x5a;
+    bv->data[1] = 0x0b;
+
+    Uint8* data = bv->data;
+    bitvec_not_assign(bv);
+
+    TEST_DATA_PTR(bv->data == data);
+    TEST_LENGTH_EQ(bv->length, len);
+    TEST_CONTENTS(bv->data[0] == (Uint8)NOT(0x5a));
+    /* bits past length stay cleared */
+    TEST_CONTENTS(bv->data[1] == GET8_LO((Uint8)NOT(0x0b), MOD8(len)));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data + 2, bitvec_get_capacity_in_bytes(bv) - 2, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool NotAssign_WHEN_LENGTH_IS_ZERO() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    bitvec_not_assign(bv);
+
+    TEST_LENGTH_EQ(bv->length, 0);
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data, bitvec_get_capacity_in_bytes(bv), 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_not_assign)
+    TEST(NotAssign_WHEN_LENGTH_IS_NOT_ALIGNED_TO_8BIT),
+    TEST(NotAssign_WHEN_LENGTH_IS_ZERO)
+END_TESTS()
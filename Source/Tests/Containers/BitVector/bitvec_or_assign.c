@@ -0,0 +1,83 @@
+/**
+ * @file bitvec_or_assign.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_or_assign in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool OrAssign_WHEN_SOURCE_IS_LONGER() {
+    BitVector* dst = bitvec_create();
+    BitVector* src = bitvec_create();
+    TEST_OBJECT(dst && src);
+
+    Size len1 = 16, len2 = 32;
+    Size sz1 = DIV8(len1), sz2 = DIV8(len2);
+    dst->length = len1;
+    src->length = len2;
+    memset(dst->data, 0xa0, sz1);
+    memset(src->data, 0x05, sz2);
+
+    Uint8* dstdata = dst->data;
+    bitvec_or_assign(dst, src);
+
+    TEST_DATA_PTR(dst->data == dstdata);
+    TEST_LENGTH_EQ(dst->length, len2);
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data, sz1, OR(0xa0, 0x05)));
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data + sz1, sz2 - sz1, 0x05));
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data + sz2, bitvec_get_capacity_in_bytes(dst) - sz2, 0x00));
+    /* source is untouched */
+    TEST_CONTENTS(is_memory_filled_with_byte(src->data, sz2, 0x05));
+
+    DO_BEFORE_EXIT(
+        if(dst) bitvec_destroy(dst);
+        if(src) bitvec_destroy(src);
+    );
+}
+
+TEST_FN Bool OrAssign_WHEN_SOURCE_IS_DESTINATION() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 13;
+    resizebv(bv, len);
+    bv->data[0] = 0x5a;
+    bv->data[1] = 0x0b;
+
+    bitvec_or_assign(bv, bv);
+
+    TEST_LENGTH_EQ(bv->length, len);
+    TEST_CONTENTS(bv->data[0] == 0x5a);
+    TEST_CONTENTS(bv->data[1] == 0x0b);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_or_assign)
+    TEST(OrAssign_WHEN_SOURCE_IS_LONGER),
+    TEST(OrAssign_WHEN_SOURCE_IS_DESTINATION)
+END_TESTS()
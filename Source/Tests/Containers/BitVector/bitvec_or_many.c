@@ -0,0 +1,116 @@
+/**
+ * @file bitvec_or_many.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_or_many in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool OrMany_WHEN_LENGTHS_ARE_NOT_EQUAL() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    BitVector* bv3 = bitvec_create();
+    BitVector* dst = bitvec_create();
+    TEST_OBJECT(bv1 && bv2 && bv3 && dst);
+
+    Size len1 = 8, len2 = 16, len3 = 32;
+    bv1->length = len1;
+    bv2->length = len2;
+    bv3->length = len3;
+    memset(bv1->data, 0x01, DIV8(len1));
+    memset(bv2->data, 0x02, DIV8(len2));
+    memset(bv3->data, 0x04, DIV8(len3));
+
+    /* stale bits in destination must not survive */
+    dst->length = 64;
+    memset(dst->data, 0xff, DIV8(dst->length));
+
+    BitVector* bvs[] = {bv1, bv2, bv3};
+    bitvec_or_many(dst, bvs, 3);
+
+    TEST_LENGTH_EQ(dst->length, len3);
+    TEST_CONTENTS(dst->data[0] == 0x07);
+    TEST_CONTENTS(dst->data[1] == 0x06);
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data + 2, 2, 0x04));
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data + 4, bitvec_get_capacity_in_bytes(dst) - 4, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+        if(bv3) bitvec_destroy(bv3);
+        if(dst) bitvec_destroy(dst);
+    );
+}
+
+TEST_FN Bool OrMany_WHEN_DESTINATION_IS_A_SOURCE() {
+    BitVector* bv1 = bitvec_create();
+    BitVector* bv2 = bitvec_create();
+    TEST_OBJECT(bv1 && bv2);
+
+    /* long enough to span more than one block of destination */
+    Size len = 40000;
+    Size sz = DIV8(len);
+    bitvec_reserve(bv1, len);
+    bitvec_reserve(bv2, len);
+    bv1->length = len;
+    bv2->length = len;
+    memset(bv1->data, 0x30, sz);
+    memset(bv2->data, 0x03, sz);
+
+    BitVector* bvs[] = {bv1, bv2};
+    bitvec_or_many(bv2, bvs, 2);
+
+    TEST_LENGTH_EQ(bv2->length, len);
+    TEST_CONTENTS(is_memory_filled_with_byte(bv2->data, sz, 0x33));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv1->data, sz, 0x30));
+
+    DO_BEFORE_EXIT(
+        if(bv1) bitvec_destroy(bv1);
+        if(bv2) bitvec_destroy(bv2);
+    );
+}
+
+TEST_FN Bool OrMany_WHEN_NO_SOURCES() {
+    BitVector* dst = bitvec_create();
+    TEST_OBJECT(dst);
+
+    dst->length = 16;
+    memset(dst->data, 0xff, 2);
+
+    bitvec_or_many(dst, NULL, 0);
+
+    TEST_LENGTH_EQ(dst->length, 0);
+    TEST_CONTENTS(is_memory_filled_with_byte(dst->data, bitvec_get_capacity_in_bytes(dst), 0x00));
+
+    DO_BEFORE_EXIT(
+        if(dst) bitvec_destroy(dst);
+    );
+}
+
+BEGIN_TESTS(bitvec_or_many)
+    TEST(OrMany_WHEN_LENGTHS_ARE_NOT_EQUAL),
+    TEST(OrMany_WHEN_DESTINATION_IS_A_SOURCE),
+    TEST(OrMany_WHEN_NO_SOURCES)
+END_TESTS()
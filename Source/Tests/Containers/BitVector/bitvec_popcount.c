@@ -0,0 +1,83 @@
+/**
+ * @file bitvec_popcount.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_popcount in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool Popcount_WHEN_LENGTH_IS_ZERO() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    TEST_LENGTH_EQ(bitvec_popcount(bv), 0);
+    TEST_LENGTH_EQ(bitvec_count_range(bv, 0, 100), 0);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool Popcount_WHEN_LENGTH_IS_NOT_ALIGNED_TO_8BIT() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 203;
+    Size sz = DIV8(len);
+    bv->length = len;
+    memset(bv->data, 0x11, sz);
+    bv->data[sz] = GET8_LO(0xff, MOD8(len));
+
+    TEST_LENGTH_EQ(bitvec_popcount(bv), 2 * sz + MOD8(len));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool CountRange_WHEN_RANGE_CROSSES_WORDS() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 256;
+    bv->length = len;
+    memset(bv->data, 0xff, DIV8(len));
+
+    /* within a word, across words, and past length */
+    TEST_LENGTH_EQ(bitvec_count_range(bv, 3, 10), 10);
+    TEST_LENGTH_EQ(bitvec_count_range(bv, 60, 130), 130);
+    TEST_LENGTH_EQ(bitvec_count_range(bv, 200, 100), 56);
+    TEST_LENGTH_EQ(bitvec_count_range(bv, 300, 10), 0);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_popcount)
+    TEST(Popcount_WHEN_LENGTH_IS_ZERO),
+    TEST(Popcount_WHEN_LENGTH_IS_NOT_ALIGNED_TO_8BIT),
+    TEST(CountRange_WHEN_RANGE_CROSSES_WORDS)
+END_TESTS()
@@ -0,0 +1,116 @@
+/**
+ * @file bitvec_rank.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_rank in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+/* every third bit is set, so rank and select have closed forms */
+static void fill_every_third(BitVector* bv, Size len) {
+    bitvec_reserve(bv, len);
+    bv->length = len;
+    for(Size i = 0; i < len; i += 3) {
+        bv->data[DIV8(i)] |= (Uint8)(1 << MOD8(i));
+    }
+}
+
+TEST_FN Bool Rank_WITHOUT_INDEX() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 10000;
+    fill_every_third(bv, len);
+
+    TEST_LENGTH_EQ(bitvec_rank(bv, 0), 0);
+    TEST_LENGTH_EQ(bitvec_rank(bv, 1), 1);
+    TEST_LENGTH_EQ(bitvec_rank(bv, 4097), 1366);
+    TEST_LENGTH_EQ(bitvec_rank(bv, len + 10), (len + 2) / 3);
+    TEST_LENGTH_EQ(bitvec_select(bv, 0), 0);
+    TEST_LENGTH_EQ(bitvec_select(bv, 1000), 3000);
+    TEST_LENGTH_EQ(bitvec_select(bv, (len + 2) / 3), SIZE_MAX);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool Rank_WITH_INDEX() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 10000;
+    fill_every_third(bv, len);
+    bitvec_build_rank_index(bv);
+    TEST_OBJECT(bv->rank_index);
+
+    for(Size i = 0; i <= len; i += 7) {
+        TEST_LENGTH_EQ(bitvec_rank(bv, i), (i + 2) / 3);
+    }
+    for(Size k = 0; k < (len + 2) / 3; k += 5) {
+        TEST_LENGTH_EQ(bitvec_select(bv, k), 3 * k);
+    }
+    TEST_LENGTH_EQ(bitvec_select(bv, (len + 2) / 3), SIZE_MAX);
+    TEST_LENGTH_EQ(bitvec_popcount(bv), (len + 2) / 3);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool Rank_WITH_INDEX_AFTER_MUTATION() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 5000;
+    fill_every_third(bv, len);
+    bitvec_build_rank_index(bv);
+    TEST_LENGTH_EQ(bitvec_rank(bv, len), (len + 2) / 3);
+
+    /* index becomes stale and must be rebuilt on next query */
+    bitvec_clear(bv, 0);
+    bitvec_set(bv, 1);
+    bitvec_set(bv, 2);
+    bitvec_push(bv, True);
+
+    TEST_LENGTH_EQ(bitvec_rank(bv, 3), 2);
+    TEST_LENGTH_EQ(bitvec_rank(bv, len + 1), (len + 2) / 3 + 2);
+    TEST_LENGTH_EQ(bitvec_select(bv, 0), 1);
+    TEST_LENGTH_EQ(bitvec_select(bv, (len + 2) / 3 + 1), len);
+
+    bitvec_drop_rank_index(bv);
+    TEST_OBJECT(!bv->rank_index);
+    TEST_LENGTH_EQ(bitvec_rank(bv, 3), 2);
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_rank)
+    TEST(Rank_WITHOUT_INDEX),
+    TEST(Rank_WITH_INDEX),
+    TEST(Rank_WITH_INDEX_AFTER_MUTATION)
+END_TESTS()
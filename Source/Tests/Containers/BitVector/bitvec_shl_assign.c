@@ -0,0 +1,78 @@
+/**
+ * @file bitvec_shl_assign.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_shl_assign in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool ShlAssign_WHEN_SHIFT_CROSSES_WORDS() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    /* bits 70 and 199 set */
+    Size len = 200;
+    bv->length = len;
+    bv->data[DIV8(70)]  |= (Uint8)(1 << MOD8(70));
+    bv->data[DIV8(199)] |= (Uint8)(1 << MOD8(199));
+
+    Uint8* data = bv->data;
+    Size cap = bv->capacity;
+    bitvec_shl_assign(bv, 67);
+
+    TEST_DATA_PTR(bv->data == data);
+    TEST_CAPACITY_EQ(bv->capacity, cap);
+    TEST_LENGTH_EQ(bv->length, len - 67);
+    TEST_CONTENTS(bv->data[0] == 0x08); /* bit 3 */
+    TEST_CONTENTS(bv->data[DIV8(132)] == (Uint8)(1 << MOD8(132)));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data + 1, DIV8(132) - 1, 0x00));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data + DIV8(132) + 1, bitvec_get_capacity_in_bytes(bv) - DIV8(132) - 1, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool ShlAssign_WHEN_SHIFT_IS_MORE_THAN_LENGTH() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    bv->length = 16;
+    memset(bv->data, 0xff, 2);
+
+    bitvec_shl_assign(bv, 20);
+
+    TEST_LENGTH_EQ(bv->length, 0);
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data, bitvec_get_capacity_in_bytes(bv), 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_shl_assign)
+    TEST(ShlAssign_WHEN_SHIFT_CROSSES_WORDS),
+    TEST(ShlAssign_WHEN_SHIFT_IS_MORE_THAN_LENGTH)
+END_TESTS()
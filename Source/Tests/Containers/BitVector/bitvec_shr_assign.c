@@ -0,0 +1,80 @@
+/**
+ * @file bitvec_shr_assign.c
+ * @date Wed, 14th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for bitvec_shr_assign in BitVector container.
+ * */
+
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <Anvie/Bit/Bit.h>
+
+#include "drop_in_replacements.h"
+#include "helpers.h"
+
+TEST_FN Bool ShrAssign_WHEN_SHIFT_CROSSES_WORDS() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    /* bits 3 and 63 set */
+    Size len = 64;
+    bv->length = len;
+    bv->data[0] = 0x08;
+    bv->data[7] = 0x80;
+
+    bitvec_shr_assign(bv, 67);
+
+    TEST_LENGTH_EQ(bv->length, len + 67);
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data, 8, 0x00));
+    TEST_CONTENTS(bv->data[DIV8(70)] == (Uint8)(1 << MOD8(70)));
+    TEST_CONTENTS(bv->data[DIV8(130)] == (Uint8)(1 << MOD8(130)));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data + DIV8(130) + 1, bitvec_get_capacity_in_bytes(bv) - DIV8(130) - 1, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool ShrAssign_WHEN_CAPACITY_IS_EXCEEDED() {
+    BitVector* bv = bitvec_create();
+    TEST_OBJECT(bv);
+
+    Size len = 200;
+    Size sz = DIV8(len);
+    bv->length = len;
+    memset(bv->data, 0xff, sz);
+
+    /* byte aligned shift past capacity */
+    bitvec_shr_assign(bv, 512);
+
+    TEST_LENGTH_EQ(bv->length, len + 512);
+    TEST_CAPACITY_GE(bv->capacity, len + 512);
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data, DIV8(512), 0x00));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data + DIV8(512), sz, 0xff));
+    TEST_CONTENTS(is_memory_filled_with_byte(bv->data + DIV8(512) + sz, bitvec_get_capacity_in_bytes(bv) - DIV8(512) - sz, 0x00));
+
+    DO_BEFORE_EXIT(
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+BEGIN_TESTS(bitvec_shr_assign)
+    TEST(ShrAssign_WHEN_SHIFT_CROSSES_WORDS),
+    TEST(ShrAssign_WHEN_CAPACITY_IS_EXCEEDED)
+END_TESTS()
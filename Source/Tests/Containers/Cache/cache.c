@@ -0,0 +1,212 @@
+/**
+ * @file cache.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for Cache, checking order in which each eviction policy
+ * evicts entries, charge limits and sharded caches.
+ * */
+
+#include <Anvie/Containers/Cache.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#define CACHE_TEST_MAX_EVICTIONS 64
+
+/* keys of evicted entries, in order of eviction, passed as udata */
+typedef struct CacheTestLog {
+    Uint64 keys[CACHE_TEST_MAX_EVICTIONS];
+    Size   count;
+    Bool   data_matches;
+} CacheTestLog;
+
+/* data of every entry is it's key times ten, so callback can check it got matching data */
+static void cache_test_on_evict(Uint64 key, Uint64* data, CacheTestLog* log) {
+    log->data_matches &= *data == key * 10;
+    if(log->count < CACHE_TEST_MAX_EVICTIONS) {
+        log->keys[log->count] = key;
+    }
+    log->count++;
+}
+
+static Cache* cache_test_create(CachePolicy policy, Size max_entries, Size max_charge) {
+    return cache_create((HashCallback)(void*)hash_u64, sizeof(Uint64), (CompareElementCallback)(void*)compare_u64,
+                        sizeof(Uint64), max_entries, max_charge, policy, NULL);
+}
+
+static Bool cache_test_insert(Cache* cache, Uint64 key, Size charge, CacheTestLog* log) {
+    Uint64 data = key * 10;
+    return cache_insert(cache, (void*)key, &data, charge, (CacheEvictCallback)(void*)cache_test_on_evict, log);
+}
+
+/* log holds exactly given keys in given order */
+static Bool cache_test_evicted(CacheTestLog* log, const Uint64* keys, Size count) {
+    if(log->count != count || !log->data_matches) {
+        return False;
+    }
+    for(Size i = 0; i < count; i++) {
+        if(log->keys[i] != keys[i]) {
+            return False;
+        }
+    }
+    return True;
+}
+
+TEST_FN Bool Evict_WHEN_LRU_THEN_LEAST_RECENTLY_USED_FIRST() {
+    CacheTestLog log   = {.data_matches = True};
+    Cache*       cache = cache_test_create(CACHE_POLICY_LRU, 4, 0);
+    TEST_OBJECT(cache);
+
+    for(Uint64 k = 0; k < 4; k++) TEST_EQUALITY(cache_test_insert(cache, k, 1, &log));
+    TEST_EQUALITY(cache_get(cache, (void*)0, NULL) != NULL);
+
+    /* recency is now 0 3 2 1, peek must not change it */
+    TEST_EQUALITY(cache_peek(cache, (void*)1, NULL) != NULL);
+    TEST_EQUALITY(cache_test_insert(cache, 4, 1, &log) && cache_test_insert(cache, 5, 1, &log));
+    TEST_EQUALITY(cache_get(cache, (void*)3, NULL) != NULL);
+    TEST_EQUALITY(cache_test_insert(cache, 6, 1, &log));
+
+    Uint64 expected[] = {1, 2, 0};
+    TEST_EQUALITY(cache_test_evicted(&log, expected, ARRAY_SIZE(expected)));
+    TEST_LENGTH_EQ(cache_item_count(cache), 4);
+    TEST_EQUALITY(*(Uint64*)cache_get(cache, (void*)3, NULL) == 30);
+    TEST_EQUALITY(cache_get(cache, (void*)1, NULL) == NULL);
+    TEST_LENGTH_EQ(cache->stats.hits, 3);
+    TEST_LENGTH_EQ(cache->stats.misses, 1);
+    TEST_LENGTH_EQ(cache->stats.insertions, 7);
+    TEST_LENGTH_EQ(cache->stats.evictions, 3);
+
+    DO_BEFORE_EXIT(
+        if(cache) cache_destroy(cache);
+    );
+}
+
+TEST_FN Bool Evict_WHEN_CLOCK_THEN_REFERENCED_GET_SECOND_CHANCE() {
+    CacheTestLog log   = {.data_matches = True};
+    Cache*       cache = cache_test_create(CACHE_POLICY_CLOCK, 4, 0);
+    TEST_OBJECT(cache);
+
+    for(Uint64 k = 0; k < 4; k++) TEST_EQUALITY(cache_test_insert(cache, k, 1, &log));
+    TEST_EQUALITY(cache_get(cache, (void*)0, NULL) && cache_get(cache, (void*)2, NULL));
+
+    /* hand clears bit of 0 and takes 1, then clears bit of 2 and takes 3, then comes back to 0 */
+    for(Uint64 k = 4; k < 7; k++) TEST_EQUALITY(cache_test_insert(cache, k, 1, &log));
+
+    Uint64 expected[] = {1, 3, 0};
+    TEST_EQUALITY(cache_test_evicted(&log, expected, ARRAY_SIZE(expected)));
+    for(Uint64 k = 2; k < 7; k += 2) TEST_EQUALITY(*(Uint64*)cache_peek(cache, (void*)k, NULL) == k * 10);
+
+    DO_BEFORE_EXIT(
+        if(cache) cache_destroy(cache);
+    );
+}
+
+TEST_FN Bool Evict_WHEN_S3FIFO_THEN_ONE_HIT_WONDERS_FIRST() {
+    CacheTestLog log   = {.data_matches = True};
+    Cache*       cache = cache_test_create(CACHE_POLICY_S3FIFO, 10, 0);
+    TEST_OBJECT(cache);
+
+    /* everything starts in small queue, keys used again are promoted to main queue when reached */
+    for(Uint64 k = 0; k < 10; k++) TEST_EQUALITY(cache_test_insert(cache, k, 1, &log));
+    for(Uint64 k = 0; k < 5; k++) TEST_EQUALITY(cache_get(cache, (void*)k, NULL) != NULL);
+    TEST_EQUALITY(cache_test_insert(cache, 10, 1, &log) && cache_test_insert(cache, 11, 1, &log));
+
+    Uint64 expected[] = {5, 6};
+    TEST_EQUALITY(cache_test_evicted(&log, expected, ARRAY_SIZE(expected)));
+
+    /* 5 is remembered by ghost queue, so it returns into main queue and survives a scan of new keys */
+    TEST_EQUALITY(cache_test_insert(cache, 5, 1, &log));
+    for(Uint64 k = 100; k < 120; k++) TEST_EQUALITY(cache_test_insert(cache, k, 1, &log));
+    for(Uint64 k = 0; k < 6; k++) TEST_EQUALITY(cache_peek(cache, (void*)k, NULL) != NULL);
+    /* small queue keeps what main queue leaves room for, 4 newest keys here */
+    TEST_EQUALITY(cache_peek(cache, (void*)115, NULL) == NULL && cache_peek(cache, (void*)116, NULL) != NULL);
+    TEST_LENGTH_EQ(cache_item_count(cache), 10);
+
+    DO_BEFORE_EXIT(
+        if(cache) cache_destroy(cache);
+    );
+}
+
+TEST_FN Bool Insert_WHEN_CHARGE_EXCEEDED_THEN_EVICT_UNTIL_FITS() {
+    CacheTestLog log   = {.data_matches = True};
+    Cache*       cache = cache_test_create(CACHE_POLICY_LRU, 16, 100);
+    TEST_OBJECT(cache);
+
+    for(Uint64 k = 0; k < 3; k++) TEST_EQUALITY(cache_test_insert(cache, k, 30, &log));
+    TEST_LENGTH_EQ(cache_total_charge(cache), 90);
+    TEST_EQUALITY(cache_test_insert(cache, 3, 30, &log));
+    TEST_LENGTH_EQ(cache_total_charge(cache), 90);
+
+    /* growing charge of a present key evicts others, never the key itself */
+    TEST_EQUALITY(cache_test_insert(cache, 1, 90, &log));
+    TEST_LENGTH_EQ(cache_total_charge(cache), 90);
+    TEST_LENGTH_EQ(cache_item_count(cache), 1);
+
+    Uint64 expected[] = {0, 2, 3};
+    TEST_EQUALITY(cache_test_evicted(&log, expected, ARRAY_SIZE(expected)));
+
+    /* deleting does not call eviction callback, and frees entry for reuse */
+    TEST_EQUALITY(cache_delete(cache, (void*)1, NULL) && !cache_delete(cache, (void*)1, NULL));
+    TEST_EQUALITY(cache_item_count(cache) == 0 && cache_total_charge(cache) == 0);
+    TEST_EQUALITY(cache_test_insert(cache, 7, 100, &log) && log.count == 3);
+
+    cache_clear(cache, NULL);
+    TEST_EQUALITY(cache_item_count(cache) == 0 && cache_peek(cache, (void*)7, NULL) == NULL);
+
+    DO_BEFORE_EXIT(
+        if(cache) cache_destroy(cache);
+    );
+}
+
+TEST_FN Bool Sharded_WHEN_FILLED_PAST_CAPACITY_THEN_STAY_BOUNDED() {
+    ShardedCache* cache = sharded_cache_create((HashCallback)(void*)hash_u64, sizeof(Uint64),
+                                               (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), 256, 0,
+                                               CACHE_POLICY_S3FIFO, 4, NULL);
+    TEST_OBJECT(cache);
+
+    for(Uint64 k = 0; k < 1000; k++) {
+        Uint64 data = k * 10;
+        TEST_EQUALITY(sharded_cache_insert(cache, (void*)k, &data, 1, NULL, NULL));
+    }
+
+    /* most recent key is in small queue of it's shard */
+    Uint64 data = 0;
+    TEST_EQUALITY(sharded_cache_get(cache, (void*)999, &data, NULL) && data == 9990);
+    TEST_EQUALITY(!sharded_cache_get(cache, (void*)5000, &data, NULL) && data == 9990);
+
+    CacheStats stats;
+    sharded_cache_stats(cache, &stats);
+    Size count = sharded_cache_item_count(cache);
+    TEST_EQUALITY(count && count <= 256);
+    TEST_EQUALITY(stats.insertions == 1000 && stats.evictions == 1000 - count);
+    TEST_EQUALITY(stats.hits == 1 && stats.misses == 1);
+
+    TEST_EQUALITY(sharded_cache_delete(cache, (void*)999, NULL) && !sharded_cache_get(cache, (void*)999, &data, NULL));
+    TEST_LENGTH_EQ(sharded_cache_item_count(cache), count - 1);
+
+    DO_BEFORE_EXIT(
+        if(cache) sharded_cache_destroy(cache);
+    );
+}
+
+BEGIN_TESTS(cache)
+    TEST(Evict_WHEN_LRU_THEN_LEAST_RECENTLY_USED_FIRST),
+    TEST(Evict_WHEN_CLOCK_THEN_REFERENCED_GET_SECOND_CHANCE),
+    TEST(Evict_WHEN_S3FIFO_THEN_ONE_HIT_WONDERS_FIRST),
+    TEST(Insert_WHEN_CHARGE_EXCEEDED_THEN_EVICT_UNTIL_FITS),
+    TEST(Sharded_WHEN_FILLED_PAST_CAPACITY_THEN_STAY_BOUNDED)
+END_TESTS()
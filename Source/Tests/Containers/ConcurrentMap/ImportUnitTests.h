@@ -0,0 +1,32 @@
+/**
+ * @file ImportUnitTests.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief ConcurrentMap container unit tests import header.
+ * Include this header exactly once throughout the whole program.
+ * This will import these unit tests to wherever this file is included.
+ * */
+
+#ifndef ANVIE_UTILS_TESTS_CONTAINERS_CONCURRENT_MAP_IMPORT_UNIT_TESTS_H
+#define ANVIE_UTILS_TESTS_CONTAINERS_CONCURRENT_MAP_IMPORT_UNIT_TESTS_H
+
+#include <Anvie/Test/UnitTest.h>
+
+IMPORT_UNIT_TEST(concurrent_map)
+
+#endif // ANVIE_UTILS_TESTS_CONTAINERS_CONCURRENT_MAP_IMPORT_UNIT_TESTS_H
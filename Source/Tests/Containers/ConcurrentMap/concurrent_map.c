@@ -0,0 +1,209 @@
+/**
+ * @file concurrent_map.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for ConcurrentMap, with inserts, searches, deletes and
+ * compute if absent racing from several threads.
+ * */
+
+#include <Anvie/Containers/ConcurrentMap.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <pthread.h>
+
+#include "TestThreads.h"
+
+#define CMAP_TEST_THREADS 4
+#define CMAP_TEST_KEYS    20000
+
+static ConcurrentMap* cmap_test_create(Size shard_count) {
+    return concurrent_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64), NULL, NULL,
+                                 (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), shard_count, NULL);
+}
+
+typedef struct CmapTestShared {
+    ConcurrentMap*    map;
+    pthread_barrier_t barrier;
+    Size              computes[CMAP_TEST_KEYS]; /**< times compute callback ran for each key */
+} CmapTestShared;
+
+typedef struct CmapTestArg {
+    CmapTestShared* shared;
+    Size            id;
+    Size            errors;
+    Size            computed; /**< times compute_if_absent returned True on this thread */
+} CmapTestArg;
+
+/* each thread inserts it's own keys, searches everyone's, then deletes odd keys of it's own */
+static void* cmap_test_worker(void* arg) {
+    CmapTestArg*   a   = arg;
+    ConcurrentMap* map = a->shared->map;
+
+    for(Uint64 k = a->id; k < CMAP_TEST_KEYS; k += CMAP_TEST_THREADS) {
+        Uint64 data = k * 3;
+        a->errors += !concurrent_map_insert(map, (void*)k, &data, NULL);
+    }
+
+    pthread_barrier_wait(&a->shared->barrier);
+
+    for(Uint64 k = 0; k < CMAP_TEST_KEYS; k++) {
+        Uint64 data = 0;
+        a->errors += !concurrent_map_search(map, (void*)k, &data, NULL) || data != k * 3;
+    }
+
+    pthread_barrier_wait(&a->shared->barrier);
+
+    /* odd keys are deleted while other threads still search even ones */
+    for(Uint64 k = a->id; k < CMAP_TEST_KEYS; k += CMAP_TEST_THREADS) {
+        if(k & 1) {
+            a->errors += !concurrent_map_delete(map, (void*)k, NULL);
+        } else {
+            Uint64 data = 0;
+            a->errors += !concurrent_map_search(map, (void*)(k ^ 2), &data, NULL) || data != (k ^ 2) * 3;
+        }
+    }
+
+    return NULL;
+}
+
+static void cmap_test_compute(void* key, void* data, void* udata) {
+    CmapTestShared* shared = udata;
+    __atomic_fetch_add(shared->computes + (Uint64)key, 1, __ATOMIC_RELAXED);
+    *(Uint64*)data = (Uint64)key * 7;
+}
+
+/* all threads race to compute every key, in different orders */
+static void* cmap_test_compute_worker(void* arg) {
+    CmapTestArg*   a   = arg;
+    ConcurrentMap* map = a->shared->map;
+
+    pthread_barrier_wait(&a->shared->barrier);
+
+    for(Uint64 i = 0; i < CMAP_TEST_KEYS; i++) {
+        Uint64 k    = a->id & 1 ? CMAP_TEST_KEYS - 1 - i : i;
+        Uint64 data = 0;
+        a->computed += concurrent_map_compute_if_absent(map, (void*)k, cmap_test_compute, &data, a->shared);
+        a->errors   += data != k * 7;
+    }
+
+    return NULL;
+}
+
+/* run @p worker on all test threads, @return False if they could not be started */
+static Bool cmap_test_run(CmapTestShared* shared, CmapTestArg* args, TestThreadFn worker) {
+    for(Size t = 0; t < CMAP_TEST_THREADS; t++) {
+        args[t] = (CmapTestArg) {shared, t, 0, 0};
+    }
+
+    pthread_barrier_init(&shared->barrier, NULL, CMAP_TEST_THREADS);
+    Bool ran = test_run_threads(CMAP_TEST_THREADS, worker, args, sizeof(CmapTestArg));
+    pthread_barrier_destroy(&shared->barrier);
+    return ran;
+}
+
+TEST_FN Bool InsertSearchDelete_WHEN_SINGLE_THREAD() {
+    ConcurrentMap* map = cmap_test_create(0);
+    TEST_OBJECT(map);
+    TEST_LENGTH_EQ(map->shard_count, CONCURRENT_MAP_DEFAULT_SHARD_COUNT);
+
+    Uint64 data = 10;
+    TEST_EQUALITY(concurrent_map_insert(map, (void*)1, &data, NULL));
+    data = 20;
+    TEST_EQUALITY(concurrent_map_insert(map, (void*)2, &data, NULL));
+    data = 11;
+    TEST_EQUALITY(concurrent_map_insert(map, (void*)1, &data, NULL));
+    TEST_LENGTH_EQ(concurrent_map_item_count(map), 2);
+
+    data = 0;
+    TEST_EQUALITY(concurrent_map_search(map, (void*)1, &data, NULL) && data == 11);
+    TEST_EQUALITY(concurrent_map_search(map, (void*)2, NULL, NULL));
+    TEST_EQUALITY(!concurrent_map_search(map, (void*)3, &data, NULL));
+
+    TEST_EQUALITY(concurrent_map_delete(map, (void*)1, NULL));
+    TEST_EQUALITY(!concurrent_map_delete(map, (void*)1, NULL));
+    TEST_EQUALITY(!concurrent_map_search(map, (void*)1, NULL, NULL));
+    TEST_LENGTH_EQ(concurrent_map_item_count(map), 1);
+
+    DO_BEFORE_EXIT(
+        if(map) concurrent_map_destroy(map, NULL);
+    );
+}
+
+TEST_FN Bool InsertSearchDelete_WHEN_MANY_THREADS() {
+    CmapTestShared* shared = NEW(CmapTestShared);
+    CmapTestArg     args[CMAP_TEST_THREADS];
+    TEST_OBJECT(shared);
+
+    /* few shards, so that threads keep meeting on same shards and shards keep growing */
+    shared->map = cmap_test_create(4);
+    TEST_OBJECT(shared->map);
+
+    TEST_EQUALITY(cmap_test_run(shared, args, cmap_test_worker));
+    for(Size t = 0; t < CMAP_TEST_THREADS; t++) {
+        TEST_LENGTH_EQ(args[t].errors, 0);
+    }
+
+    TEST_LENGTH_EQ(concurrent_map_item_count(shared->map), CMAP_TEST_KEYS / 2);
+    for(Uint64 k = 0; k < CMAP_TEST_KEYS; k++) {
+        Uint64 data  = 0;
+        Bool   found = concurrent_map_search(shared->map, (void*)k, &data, NULL);
+        TEST_EQUALITY(k & 1 ? !found : found && data == k * 3);
+    }
+
+    DO_BEFORE_EXIT(
+        if(shared && shared->map) concurrent_map_destroy(shared->map, NULL);
+        FREE(shared);
+    );
+}
+
+TEST_FN Bool ComputeIfAbsent_WHEN_THREADS_RACE_THEN_COMPUTE_ONCE() {
+    CmapTestShared* shared = NEW(CmapTestShared);
+    CmapTestArg     args[CMAP_TEST_THREADS];
+    TEST_OBJECT(shared);
+    shared->map = cmap_test_create(8);
+    TEST_OBJECT(shared->map);
+
+    TEST_EQUALITY(cmap_test_run(shared, args, cmap_test_compute_worker));
+
+    Size computed = 0;
+    for(Size t = 0; t < CMAP_TEST_THREADS; t++) {
+        TEST_LENGTH_EQ(args[t].errors, 0);
+        computed += args[t].computed;
+    }
+    TEST_LENGTH_EQ(computed, CMAP_TEST_KEYS);
+    for(Size k = 0; k < CMAP_TEST_KEYS; k++) {
+        TEST_LENGTH_EQ(shared->computes[k], 1);
+    }
+    TEST_LENGTH_EQ(concurrent_map_item_count(shared->map), CMAP_TEST_KEYS);
+
+    /* present keys are never computed again */
+    Uint64 data = 0;
+    TEST_EQUALITY(!concurrent_map_compute_if_absent(shared->map, (void*)5, cmap_test_compute, &data, shared));
+    TEST_EQUALITY(data == 35 && shared->computes[5] == 1);
+
+    DO_BEFORE_EXIT(
+        if(shared && shared->map) concurrent_map_destroy(shared->map, NULL);
+        FREE(shared);
+    );
+}
+
+BEGIN_TESTS(concurrent_map)
+    TEST(InsertSearchDelete_WHEN_SINGLE_THREAD),
+    TEST(InsertSearchDelete_WHEN_MANY_THREADS),
+    TEST(ComputeIfAbsent_WHEN_THREADS_RACE_THEN_COMPUTE_ONCE)
+END_TESTS()
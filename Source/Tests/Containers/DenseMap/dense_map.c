@@ -0,0 +1,372 @@
+/**
+ * @file dense_map.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for DenseMap, probing groups of slots when hashes collide,
+ * with copy callbacks for keys, as a multimap, with key and data stored
+ * inline in slots, and while incrementally rehashing.
+ * */
+
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#define DMAP_TEST_KEYS 1000
+
+/* key too large to be passed by value, so map keeps a separately allocated copy of it */
+typedef struct DmapTestKey {
+    Uint64 id;
+    Uint64 pad[2];
+} DmapTestKey;
+
+/* every u64 key hashes to one of only four values, so probes run through many full groups */
+static Size dmap_test_hash_colliding(Uint64 key, void* udata) {
+    UNUSED(udata);
+    return key & 3;
+}
+
+static Size dmap_test_hash_key(DmapTestKey* key, void* udata) {
+    UNUSED(udata);
+    return hash_u64(key->id, NULL);
+}
+
+static Int32 dmap_test_compare_key(DmapTestKey* a, DmapTestKey* b, void* udata) {
+    UNUSED(udata);
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+/* copy callbacks count live copies in Size passed as udata */
+static void dmap_test_create_key_copy(DmapTestKey* dst, DmapTestKey* src, Size* live) {
+    *dst = *src;
+    (*live)++;
+}
+
+static void dmap_test_destroy_key_copy(DmapTestKey* copy, Size* live) {
+    UNUSED(copy);
+    (*live)--;
+}
+
+/* 16 byte data, stored by value in slots of an inline map */
+typedef struct DmapTestVec {
+    Float32 x, y, z, w;
+} DmapTestVec;
+
+DEF_INLINE_DENSE_MAP_INTERFACE(dmap_test_u64_vec, DmapTest_U64_Vec_, hash_u64, Uint64, compare_u64, DmapTestVec, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+
+/* allocator counting allocations and reallocations in Size pointed to by ctx */
+static void* dmap_test_allocate(Size size, void* ctx) {
+    (*(Size*)ctx)++;
+    return malloc(size);
+}
+
+static void* dmap_test_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    UNUSED(old_size);
+    (*(Size*)ctx)++;
+    return realloc(ptr, new_size);
+}
+
+static void dmap_test_free(void* ptr, Size size, void* ctx) {
+    UNUSED(size && ctx);
+    free(ptr);
+}
+
+static DenseMap* dmap_test_create_copying(Bool is_multimap) {
+    return dense_map_create((HashCallback)(void*)dmap_test_hash_key, sizeof(DmapTestKey),
+                            (CreateElementCopyCallback)(void*)dmap_test_create_key_copy,
+                            (DestroyElementCopyCallback)(void*)dmap_test_destroy_key_copy,
+                            (CompareElementCallback)(void*)dmap_test_compare_key, sizeof(Uint64), NULL, NULL,
+                            is_multimap, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+}
+
+/* data of key, or UINT64_MAX if absent */
+static Uint64 dmap_test_get(DenseMap* map, Uint64 key) {
+    DenseMapItem* item = dense_map_search(map, (void*)key, NULL);
+    return item ? (Uint64)item->data : UINT64_MAX;
+}
+
+TEST_FN Bool Probe_WHEN_HASHES_COLLIDE_THEN_COMPARE_KEYS() {
+    DenseMap* map = dense_map_create((HashCallback)(void*)dmap_test_hash_colliding, sizeof(Uint64), NULL, NULL,
+                                     (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), NULL, NULL,
+                                     False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+    TEST_OBJECT(map);
+
+    /* a few hundred keys share each hash, spilling over many groups */
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dense_map_insert(map, (void*)k, (void*)(k * 3), NULL) != NULL);
+    }
+    TEST_LENGTH_EQ(map->item_count, DMAP_TEST_KEYS);
+    for(Uint64 k = 0; k < 2 * DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dmap_test_get(map, k) == (k < DMAP_TEST_KEYS ? k * 3 : UINT64_MAX));
+    }
+
+    /* deleted slots become tombstones that must not end probes of keys past them */
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k += 3) {
+        dense_map_delete(map, (void*)k, NULL);
+    }
+    TEST_LENGTH_GT(map->tombstone_count, 0);
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dmap_test_get(map, k) == (k % 3 ? k * 3 : UINT64_MAX));
+    }
+
+    /* reinserting reuses tombstones, and inserting an existing key only replaces it's data */
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dense_map_insert(map, (void*)k, (void*)(k + 1), NULL) != NULL);
+    }
+    TEST_LENGTH_EQ(map->item_count, DMAP_TEST_KEYS);
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dmap_test_get(map, k) == k + 1);
+    }
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+    );
+}
+
+TEST_FN Bool Copy_WHEN_MAP_GROWS_THEN_KEEP_ONE_COPY_PER_ITEM() {
+    Size      live = 0;
+    DenseMap* map  = dmap_test_create_copying(False);
+    TEST_OBJECT(map);
+
+    /* keys are copied out of a stack variable that's overwritten for every insert */
+    DmapTestKey key = {0};
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        key.id = k;
+        TEST_EQUALITY(dense_map_insert(map, &key, (void*)k, &live) != NULL);
+    }
+    TEST_LENGTH_EQ(map->item_count, DMAP_TEST_KEYS);
+    TEST_LENGTH_EQ(live, DMAP_TEST_KEYS);
+
+    /* growing moved items without copying them again */
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        key.id = k;
+        DenseMapItem* item = dense_map_search(map, &key, &live);
+        TEST_EQUALITY(item && item->key != (void*)&key && ((DmapTestKey*)item->key)->id == k && (Uint64)item->data == k);
+    }
+
+    /* replacing data of an existing key keeps a single copy of it */
+    key.id = 7;
+    TEST_EQUALITY(dense_map_insert(map, &key, (void*)70, &live) != NULL);
+    TEST_LENGTH_EQ(live, DMAP_TEST_KEYS);
+    DenseMapItem* item = dense_map_search(map, &key, &live);
+    TEST_EQUALITY(item && (Uint64)item->data == 70);
+
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k += 2) {
+        key.id = k;
+        dense_map_delete(map, &key, &live);
+    }
+    TEST_LENGTH_EQ(map->item_count, DMAP_TEST_KEYS / 2);
+    TEST_LENGTH_EQ(live, DMAP_TEST_KEYS / 2);
+
+    dense_map_destroy(map, &live);
+    map = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, &live);
+    );
+}
+
+TEST_FN Bool Multimap_WHEN_KEY_REPEATS_THEN_DELETE_ALL() {
+    Size      live = 0;
+    DenseMap* map  = dmap_test_create_copying(True);
+    TEST_OBJECT(map);
+
+    DmapTestKey key = {0};
+    for(Uint64 r = 0; r < 3; r++) {
+        for(Uint64 k = 0; k < DMAP_TEST_KEYS / 4; k++) {
+            key.id = k;
+            TEST_EQUALITY(dense_map_insert(map, &key, (void*)r, &live) != NULL);
+        }
+    }
+    TEST_LENGTH_EQ(map->item_count, 3 * (DMAP_TEST_KEYS / 4));
+    TEST_LENGTH_EQ(live, map->item_count);
+
+    /* every repeat of a key is an item of it's own, and delete removes them all */
+    Size found = 0;
+    DenseMapIterator iter = {0};
+    for(DenseMapItem* item = dense_map_iter_next(map, &iter); item; item = dense_map_iter_next(map, &iter)) {
+        found += ((DmapTestKey*)item->key)->id == 5;
+    }
+    TEST_LENGTH_EQ(found, 3);
+
+    key.id = 5;
+    dense_map_delete(map, &key, &live);
+    TEST_EQUALITY(!dense_map_search(map, &key, &live));
+    TEST_LENGTH_EQ(map->item_count, 3 * (DMAP_TEST_KEYS / 4 - 1));
+    TEST_LENGTH_EQ(live, map->item_count);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, &live);
+    );
+}
+
+TEST_FN Bool Inline_WHEN_RESERVED_THEN_INSERT_WITHOUT_ALLOCATING() {
+    Size                       allocs    = 0;
+    Allocator                  allocator = {dmap_test_allocate, dmap_test_reallocate, dmap_test_free, &allocs};
+    DmapTest_U64_Vec_DenseMap* map       = dmap_test_u64_vec_dense_map_create_with_allocator(&allocator);
+    TEST_OBJECT(map);
+
+    /* 16 byte data would need a copy per item in a map of DenseMapItem */
+    dense_map_reserve(map, DMAP_TEST_KEYS, NULL);
+    Size reserved = allocs;
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        DmapTestVec v = {(Float32)k, 1, 2, 3};
+        TEST_EQUALITY(dmap_test_u64_vec_dense_map_insert(map, k, v, NULL) != NULL);
+    }
+    TEST_LENGTH_EQ(allocs, reserved);
+    TEST_LENGTH_EQ(map->item_count, DMAP_TEST_KEYS);
+
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        DmapTest_U64_Vec_DenseMapItem* item = dmap_test_u64_vec_dense_map_search(map, k, NULL);
+        TEST_EQUALITY(item && item->key == k && item->data.x == (Float32)k && item->data.w == 3);
+    }
+
+    /* growing past reservation moves slot bytes into a bigger table */
+    for(Uint64 k = DMAP_TEST_KEYS; k < 4 * DMAP_TEST_KEYS; k++) {
+        DmapTestVec v = {(Float32)k, 1, 2, 3};
+        TEST_EQUALITY(dmap_test_u64_vec_dense_map_insert(map, k, v, NULL) != NULL);
+    }
+    for(Uint64 k = 0; k < 4 * DMAP_TEST_KEYS; k += 2) {
+        dmap_test_u64_vec_dense_map_delete(map, k, NULL);
+    }
+    for(Uint64 k = 0; k < 4 * DMAP_TEST_KEYS; k++) {
+        DmapTest_U64_Vec_DenseMapItem* item = dmap_test_u64_vec_dense_map_search(map, k, NULL);
+        TEST_EQUALITY((k & 1) ? item && item->data.x == (Float32)k : !item);
+    }
+
+    DO_BEFORE_EXIT(
+        if(map) dmap_test_u64_vec_dense_map_destroy(map, NULL);
+    );
+}
+
+TEST_FN Bool Inline_WHEN_KEYS_ARE_COPIED_THEN_COPY_INTO_SLOT() {
+    Size      live = 0;
+    DenseMap* map  = dense_map_create_inline((HashCallback)(void*)dmap_test_hash_key, sizeof(DmapTestKey),
+                                             (CreateElementCopyCallback)(void*)dmap_test_create_key_copy,
+                                             (DestroyElementCopyCallback)(void*)dmap_test_destroy_key_copy,
+                                             (CompareElementCallback)(void*)dmap_test_compare_key,
+                                             sizeof(Uint64), NULL, NULL, 0, 0,
+                                             False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, NULL);
+    TEST_OBJECT(map);
+
+    DmapTestKey key = {0};
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        key.id = k;
+        TEST_EQUALITY(dense_map_insert(map, &key, (void*)k, &live) != NULL);
+    }
+    TEST_LENGTH_EQ(live, DMAP_TEST_KEYS);
+
+    /* key is copied right into slot, and data follows it */
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k++) {
+        key.id = k;
+        DenseMapItem* slot = dense_map_search(map, &key, &live);
+        TEST_EQUALITY(slot && ((DmapTestKey*)dense_map_slot_key(map, slot))->id == k);
+        TEST_EQUALITY(*(Uint64*)dense_map_slot_data(map, slot) == k);
+    }
+
+    for(Uint64 k = 0; k < DMAP_TEST_KEYS; k += 2) {
+        key.id = k;
+        dense_map_delete(map, &key, &live);
+    }
+    TEST_LENGTH_EQ(live, DMAP_TEST_KEYS / 2);
+
+    dense_map_destroy(map, &live);
+    map = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, &live);
+    );
+}
+
+TEST_FN Bool Rehash_WHEN_INCREMENTAL_THEN_FIND_KEYS_IN_BOTH_TABLES() {
+    DenseMap* map = dense_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64), NULL, NULL,
+                                     (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), NULL, NULL,
+                                     False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+    TEST_OBJECT(map);
+    dense_map_enable_incremental_rehash(map, 16);
+
+    /* every operation moves a few old slots, so keys are spread over both tables for a while */
+    Size migrating = 0;
+    for(Uint64 k = 0; k < 4 * DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dense_map_insert(map, (void*)k, (void*)(k * 5), NULL) != NULL);
+        migrating += map->old_map != NULL;
+
+        TEST_EQUALITY(dmap_test_get(map, k) == k * 5);
+        TEST_EQUALITY(dmap_test_get(map, k / 2) == k / 2 * 5);
+
+        /* a key deleted mid migration is gone from both tables */
+        if(map->old_map && !(k % 7)) {
+            dense_map_delete(map, (void*)(k / 3), NULL);
+            TEST_EQUALITY(dmap_test_get(map, k / 3) == UINT64_MAX);
+            TEST_EQUALITY(dense_map_insert(map, (void*)(k / 3), (void*)(k / 3 * 5), NULL) != NULL);
+        }
+    }
+    TEST_LENGTH_GT(migrating, 0);
+    TEST_LENGTH_EQ(map->item_count, 4 * DMAP_TEST_KEYS);
+
+    /* idle time finishes migration */
+    dense_map_rehash_step(map, SIZE_MAX, NULL);
+    TEST_EQUALITY(!dense_map_rehash_step(map, 16, NULL) && !map->old_map);
+    for(Uint64 k = 0; k < 4 * DMAP_TEST_KEYS; k++) {
+        TEST_EQUALITY(dmap_test_get(map, k) == k * 5);
+    }
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+    );
+}
+
+TEST_FN Bool Rehash_WHEN_INCREMENTAL_THEN_MOVE_COPIES_ONCE() {
+    Size      live = 0;
+    DenseMap* map  = dmap_test_create_copying(False);
+    TEST_OBJECT(map);
+    dense_map_enable_incremental_rehash(map, 16);
+
+    DmapTestKey key                     = {0};
+    Bool        destroyed_mid_migration = False;
+    for(Uint64 k = 0; k < 4 * DMAP_TEST_KEYS; k++) {
+        key.id = k;
+        TEST_EQUALITY(dense_map_insert(map, &key, (void*)k, &live) != NULL);
+        TEST_LENGTH_EQ(live, map->item_count);
+
+        /* destroying a map mid migration frees copies in both tables */
+        if(map->old_map && k > DMAP_TEST_KEYS) {
+            dense_map_destroy(map, &live);
+            map                     = NULL;
+            destroyed_mid_migration = True;
+            break;
+        }
+    }
+    TEST_EQUALITY(destroyed_mid_migration);
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, &live);
+    );
+}
+
+BEGIN_TESTS(dense_map)
+    TEST(Probe_WHEN_HASHES_COLLIDE_THEN_COMPARE_KEYS),
+    TEST(Copy_WHEN_MAP_GROWS_THEN_KEEP_ONE_COPY_PER_ITEM),
+    TEST(Multimap_WHEN_KEY_REPEATS_THEN_DELETE_ALL),
+    TEST(Inline_WHEN_RESERVED_THEN_INSERT_WITHOUT_ALLOCATING),
+    TEST(Inline_WHEN_KEYS_ARE_COPIED_THEN_COPY_INTO_SLOT),
+    TEST(Rehash_WHEN_INCREMENTAL_THEN_FIND_KEYS_IN_BOTH_TABLES),
+    TEST(Rehash_WHEN_INCREMENTAL_THEN_MOVE_COPIES_ONCE)
+END_TESTS()
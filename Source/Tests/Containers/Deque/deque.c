@@ -0,0 +1,214 @@
+/**
+ * @file deque.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for Deque, pushing and popping at both ends while ring buffer
+ * wraps around and grows, with copied elements.
+ * */
+
+#include <Anvie/Containers/Deque.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include <stdio.h>
+
+#define DEQUE_TEST_OPS 3000
+
+/* element too large to be passed by value, copies are counted in Size passed as udata */
+typedef struct DequeTestElem {
+    Uint64 value;
+    Uint64 pad[2];
+} DequeTestElem;
+
+static void deque_test_create_copy(DequeTestElem* dst, DequeTestElem* src, Size* live) {
+    *dst = *src;
+    (*live)++;
+}
+
+static void deque_test_destroy_copy(DequeTestElem* copy, Size* live) {
+    UNUSED(copy);
+    (*live)--;
+}
+
+/* deque holds exactly @p count values of @p ref, front first */
+static Bool deque_test_matches(U64_Deque* dq, const Uint64* ref, Size count) {
+    if(deque_length(dq) != count) {
+        return False;
+    }
+    for(Size i = 0; i < count; i++) {
+        if(u64_deque_peek(dq, i) != ref[i]) {
+            return False;
+        }
+    }
+    return !count || (u64_deque_front(dq) == ref[0] && u64_deque_back(dq) == ref[count - 1]);
+}
+
+TEST_FN Bool Push_WHEN_BOTH_ENDS_USED_THEN_MATCH_REFERENCE() {
+    U64_Deque* dq  = u64_deque_create();
+    Uint64*    ref = ALLOCATE(Uint64, 2 * DEQUE_TEST_OPS + 1);
+    TEST_EQUALITY(dq && ref);
+
+    /* reference grows both ways from middle of it's array */
+    Size   begin = DEQUE_TEST_OPS, end = DEQUE_TEST_OPS;
+    Uint64 state = 0x9e3779b97f4a7c15ull;
+    for(Uint64 i = 0; i < DEQUE_TEST_OPS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        /* pushes outnumber pops, so capacity grows while elements wrap around */
+        switch(state % 5) {
+            case 0 :
+            case 1 :
+                u64_deque_push_back(dq, i, NULL);
+                ref[end++] = i;
+                break;
+            case 2 :
+            case 3 :
+                u64_deque_push_front(dq, i, NULL);
+                ref[--begin] = i;
+                break;
+            default :
+                if(end - begin) {
+                    if(i & 1) {
+                        TEST_EQUALITY(u64_deque_pop_back(dq) == ref[--end]);
+                    } else {
+                        TEST_EQUALITY(u64_deque_pop_front(dq) == ref[begin++]);
+                    }
+                }
+        }
+        if(!(i % 97)) {
+            TEST_EQUALITY(deque_test_matches(dq, ref + begin, end - begin));
+        }
+    }
+    TEST_EQUALITY(deque_test_matches(dq, ref + begin, end - begin));
+
+    /* drain from alternating ends */
+    while(end - begin) {
+        TEST_EQUALITY(u64_deque_pop_front(dq) == ref[begin++]);
+        if(end - begin) {
+            TEST_EQUALITY(u64_deque_pop_back(dq) == ref[--end]);
+        }
+    }
+    TEST_EQUALITY(deque_is_empty(dq));
+
+    DO_BEFORE_EXIT(
+        if(dq) u64_deque_destroy(dq, NULL);
+        FREE(ref);
+    );
+}
+
+TEST_FN Bool Grow_WHEN_WRAPPED_AROUND_THEN_UNWRAP_IN_ORDER() {
+    U64_Deque* dq = u64_deque_create();
+    Uint64     ref[64];
+    TEST_OBJECT(dq);
+
+    u64_deque_reserve(dq, 8);
+    TEST_LENGTH_EQ(deque_capacity(dq), 8);
+
+    /* move head to middle of ring, then fill it so that elements wrap past end */
+    for(Uint64 i = 0; i < 6; i++) u64_deque_push_back(dq, 100 + i, NULL);
+    for(Uint64 i = 0; i < 5; i++) TEST_EQUALITY(u64_deque_pop_front(dq) == 100 + i);
+    Size count = 0;
+    ref[count++] = 105;
+    for(Uint64 i = 0; i < 7; i++) {
+        u64_deque_push_back(dq, i, NULL);
+        ref[count++] = i;
+    }
+    TEST_LENGTH_EQ(deque_capacity(dq), 8);
+    TEST_EQUALITY(deque_test_matches(dq, ref, count));
+
+    /* growing a full, wrapped ring keeps logical order */
+    for(Uint64 i = 7; i < 40; i++) {
+        u64_deque_push_back(dq, i, NULL);
+        ref[count++] = i;
+    }
+    TEST_LENGTH_EQ(deque_capacity(dq), 64);
+    TEST_EQUALITY(deque_test_matches(dq, ref, count));
+
+    u64_deque_clear(dq, NULL);
+    TEST_EQUALITY(deque_is_empty(dq));
+    u64_deque_push_front(dq, 1, NULL);
+    TEST_EQUALITY(u64_deque_front(dq) == 1 && u64_deque_back(dq) == 1);
+
+    DO_BEFORE_EXIT(
+        if(dq) u64_deque_destroy(dq, NULL);
+    );
+}
+
+TEST_FN Bool Copy_WHEN_ELEMENTS_ARE_STRUCTS_THEN_OWN_COPIES() {
+    Size   live = 0;
+    Deque* dq   = deque_create(sizeof(DequeTestElem), (CreateElementCopyCallback)(void*)deque_test_create_copy,
+                               (DestroyElementCopyCallback)(void*)deque_test_destroy_copy);
+    TEST_OBJECT(dq);
+
+    DequeTestElem elem = {0};
+    for(Uint64 i = 0; i < 100; i++) {
+        elem.value = i;
+        if(i & 1) {
+            deque_push_back(dq, &elem, &live);
+        } else {
+            deque_push_front(dq, &elem, &live);
+        }
+    }
+    TEST_LENGTH_EQ(live, 100);
+    TEST_EQUALITY(((DequeTestElem*)deque_front(dq))->value == 98 && ((DequeTestElem*)deque_back(dq))->value == 99);
+    TEST_EQUALITY(((DequeTestElem*)deque_peek(dq, 50))->value == 1);
+
+    /* popped element is handed over to caller, it's copy is not destroyed */
+    DequeTestElem* popped = deque_pop_back(dq);
+    TEST_EQUALITY(popped && popped->value == 99);
+    TEST_LENGTH_EQ(live, 100);
+    deque_test_destroy_copy(popped, &live);
+    FREE(popped);
+
+    deque_destroy(dq, &live);
+    dq = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(dq) deque_destroy(dq, &live);
+    );
+}
+
+TEST_FN Bool Copy_WHEN_ELEMENTS_ARE_STRINGS_THEN_OWN_COPIES() {
+    ZStr_Deque* dq = zstr_deque_create();
+    Char        buf[32];
+    TEST_OBJECT(dq);
+
+    for(Size i = 0; i < 50; i++) {
+        snprintf(buf, sizeof(buf), "deque-%zu", i);
+        zstr_deque_push_front(dq, buf, NULL);
+    }
+    for(Size i = 0; i < 50; i++) {
+        snprintf(buf, sizeof(buf), "deque-%zu", 49 - i);
+        ZString str = zstr_deque_peek(dq, i);
+        TEST_EQUALITY(str != buf && !strcmp(str, buf));
+    }
+
+    DO_BEFORE_EXIT(
+        if(dq) zstr_deque_destroy(dq, NULL);
+    );
+}
+
+BEGIN_TESTS(deque)
+    TEST(Push_WHEN_BOTH_ENDS_USED_THEN_MATCH_REFERENCE),
+    TEST(Grow_WHEN_WRAPPED_AROUND_THEN_UNWRAP_IN_ORDER),
+    TEST(Copy_WHEN_ELEMENTS_ARE_STRUCTS_THEN_OWN_COPIES),
+    TEST(Copy_WHEN_ELEMENTS_ARE_STRINGS_THEN_OWN_COPIES)
+END_TESTS()
@@ -0,0 +1,315 @@
+/**
+ * @file deserialize.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for loading containers from untrusted bytes. Truncated and
+ * corrupted buffers must be rejected, in unchecked builds too, where argument
+ * checks are compiled out (see Anvie/Error.h).
+ * */
+
+
+#include <Anvie/Containers/RoaringBitmap.h>
+#include <Anvie/Containers/FrozenMap.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Containers/BitVector.h>
+#include <Anvie/Containers/Vector.h>
+#include <Anvie/Containers/String.h>
+#include <Anvie/Containers/Image.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#define DESERIALIZE_TEST_KEYS 200
+
+/*
+ * Checking every prefix or every byte of a large buffer only repeats same
+ * checks, so all of header and this much of rest are checked, and a byte
+ * every DESERIALIZE_TEST_STRIDE after that.
+ */
+#define DESERIALIZE_TEST_EDGE   64
+#define DESERIALIZE_TEST_STRIDE 61
+
+/* True for offsets in @p head bytes at start, in last DESERIALIZE_TEST_EDGE bytes, or on stride */
+static Bool deserialize_test_picked(Size offset, Size head, Size size) {
+    return offset < head + DESERIALIZE_TEST_EDGE || offset + DESERIALIZE_TEST_EDGE >= size || !(offset % DESERIALIZE_TEST_STRIDE);
+}
+
+/* header and container headers of a serialized bitmap */
+static Size deserialize_test_roaring_head(const Uint8* buffer) {
+    Uint32 count;
+    memcpy(&count, buffer + 4, 4);
+    return 8 + (Size)count * 12;
+}
+
+/*
+ * Bytes are copied to a heap block of exactly given size, so that reading
+ * past end of a truncated buffer is caught by address sanitizer.
+ */
+static void* deserialize_test_copy(const void* buffer, Size size) {
+    void* copy = malloc(size ? size : 1);
+    if(copy) {
+        memcpy(copy, buffer, size);
+    }
+    return copy;
+}
+
+/* bitmap with array, bitmap and run containers */
+static RoaringBitmap* deserialize_test_roaring() {
+    RoaringBitmap* rb = roaring_create();
+    if(!rb) {
+        return NULL;
+    }
+    for(Uint32 v = 0; v < 1000; v += 7) {
+        roaring_add(rb, v);
+    }
+    for(Uint32 v = 0; v < 10000; v += 2) {
+        roaring_add(rb, 0x10000 + v);
+    }
+    roaring_add_range(rb, 0x20000, 0x28000);
+    roaring_run_optimize(rb);
+    return rb;
+}
+
+/* deserialize a heap copy of given bytes, True if it loads, and equals @p expected when that's given */
+static Bool deserialize_test_roaring_loads(const void* buffer, Size size, RoaringBitmap* expected) {
+    void* copy = deserialize_test_copy(buffer, size);
+    if(!copy) {
+        return False;
+    }
+
+    RoaringBitmap* rb    = roaring_deserialize(copy, size);
+    Bool           loads = rb && (!expected || roaring_cmpeq(rb, expected));
+    if(rb) {
+        roaring_destroy(rb);
+    }
+    free(copy);
+    return loads;
+}
+
+static FrozenMap* deserialize_test_frozen_map() {
+    DenseMap* map = dense_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64), NULL, NULL,
+                                     (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), NULL, NULL,
+                                     False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+    if(!map) {
+        return NULL;
+    }
+    for(Uint64 k = 0; k < DESERIALIZE_TEST_KEYS; k++) {
+        Uint64 v = k * 3;
+        dense_map_insert(map, (void*)(k * 7), dense_map_pack(&v, sizeof(v)), NULL);
+    }
+
+    FrozenMap* frozen = dense_map_freeze(map, NULL);
+    dense_map_destroy(map, NULL);
+    return frozen;
+}
+
+/*
+ * Open a heap copy of given bytes as frozen map. When it opens, every key is
+ * searched, which must stay inside image even if search results are wrong.
+ * True if it opens, and finds every key when @p exact.
+ */
+static Bool deserialize_test_frozen_map_opens(const void* image, Size size, Bool exact) {
+    void* copy = deserialize_test_copy(image, size);
+    if(!copy) {
+        return False;
+    }
+
+    FrozenMap* map   = frozen_map_open(copy, size, (HashCallback)(void*)hash_u64, (CompareElementCallback)(void*)compare_u64, NULL);
+    Bool       opens = map != NULL;
+    if(map) {
+        for(Uint64 k = 0; k < DESERIALIZE_TEST_KEYS; k++) {
+            Uint64* v = frozen_map_search(map, (void*)(k * 7), NULL);
+            opens     = opens && (!exact || (v && *v == k * 3));
+        }
+        frozen_map_destroy(map);
+    }
+    free(copy);
+    return opens;
+}
+
+TEST_FN Bool RoaringDeserialize_WHEN_BUFFER_IS_TRUNCATED() {
+    RoaringBitmap* rb     = deserialize_test_roaring();
+    Uint8*         buffer = NULL;
+    TEST_OBJECT(rb);
+
+    Size size = roaring_serialized_size(rb);
+    buffer    = malloc(size);
+    TEST_OBJECT(buffer);
+
+    /* too small a buffer is rejected rather than written past */
+    TEST_LENGTH_EQ(roaring_serialize(rb, buffer, size - 1), 0);
+    TEST_LENGTH_EQ(roaring_serialize(rb, buffer, size), size);
+    TEST_EQUALITY(deserialize_test_roaring_loads(buffer, size, rb));
+
+    /* every byte of image is used, so every prefix is invalid */
+    Size head = deserialize_test_roaring_head(buffer);
+    for(Size n = 0; n < size; n++) {
+        if(deserialize_test_picked(n, head, size)) {
+            TEST_EQUALITY(!deserialize_test_roaring_loads(buffer, n, NULL));
+        }
+    }
+
+    DO_BEFORE_EXIT(
+        if(rb) roaring_destroy(rb);
+        free(buffer);
+    );
+}
+
+TEST_FN Bool RoaringDeserialize_WHEN_BUFFER_IS_CORRUPTED() {
+    RoaringBitmap* rb     = deserialize_test_roaring();
+    Uint8*         buffer = NULL;
+    TEST_OBJECT(rb);
+
+    Size size = roaring_serialized_size(rb);
+    buffer    = malloc(size);
+    TEST_OBJECT(buffer);
+    TEST_LENGTH_EQ(roaring_serialize(rb, buffer, size), size);
+
+    /* magic, then container count larger than bitmap allows, then larger than buffer holds */
+    Uint32 word;
+    buffer[0] ^= 0xff;
+    TEST_EQUALITY(!deserialize_test_roaring_loads(buffer, size, NULL));
+    buffer[0] ^= 0xff;
+
+    memcpy(&word, buffer + 4, 4);
+    Uint32 counts[] = {0xffffffff, 0x10001, 0x10000, word + 1};
+    for(Size i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        memcpy(buffer + 4, counts + i, 4);
+        TEST_EQUALITY(!deserialize_test_roaring_loads(buffer, size, NULL));
+    }
+    memcpy(buffer + 4, &word, 4);
+    TEST_EQUALITY(deserialize_test_roaring_loads(buffer, size, rb));
+
+    /*
+     * Every byte flipped in turn. A flip in data of a container may still
+     * give a valid bitmap, only a different one, so result is not checked,
+     * but nothing may be read outside buffer.
+     */
+    Size head = deserialize_test_roaring_head(buffer);
+    for(Size i = 0; i < size; i++) {
+        if(deserialize_test_picked(i, head, size)) {
+            buffer[i] ^= 0xff;
+            deserialize_test_roaring_loads(buffer, size, NULL);
+            buffer[i] ^= 0xff;
+        }
+    }
+
+    DO_BEFORE_EXIT(
+        if(rb) roaring_destroy(rb);
+        free(buffer);
+    );
+}
+
+TEST_FN Bool FrozenMapOpen_WHEN_IMAGE_IS_TRUNCATED_OR_MISALIGNED() {
+    FrozenMap* map   = deserialize_test_frozen_map();
+    Uint64*    image = NULL;
+    TEST_OBJECT(map);
+
+    Size size = frozen_map_serialized_size(map);
+    image     = malloc(size + sizeof(Uint64));
+    TEST_OBJECT(image);
+    TEST_LENGTH_EQ(frozen_map_serialize(map, image, size), size);
+    TEST_EQUALITY(deserialize_test_frozen_map_opens(image, size, True));
+
+    for(Size n = 0; n < size; n++) {
+        if(deserialize_test_picked(n, sizeof(FrozenMapHeader), size)) {
+            TEST_EQUALITY(!deserialize_test_frozen_map_opens(image, n, False));
+        }
+    }
+
+    /* image must be 8 byte aligned */
+    memmove((Uint8*)image + 4, image, size);
+    TEST_EQUALITY(!frozen_map_open((Uint8*)image + 4, size, (HashCallback)(void*)hash_u64,
+                                   (CompareElementCallback)(void*)compare_u64, NULL));
+
+    DO_BEFORE_EXIT(
+        if(map) frozen_map_destroy(map);
+        free(image);
+    );
+}
+
+TEST_FN Bool FrozenMapOpen_WHEN_HEADER_IS_CORRUPTED() {
+    FrozenMap* map   = deserialize_test_frozen_map();
+    Uint8*     image = NULL;
+    TEST_OBJECT(map);
+
+    Size size = frozen_map_serialized_size(map);
+    image     = malloc(size);
+    TEST_OBJECT(image);
+    TEST_LENGTH_EQ(frozen_map_serialize(map, image, size), size);
+
+    /* only seed can change and still give a valid image, with keys in wrong slots */
+    for(Size i = 0; i < sizeof(FrozenMapHeader); i++) {
+        Bool in_seed = i >= offsetof(FrozenMapHeader, seed) && i < offsetof(FrozenMapHeader, seed) + sizeof(Uint64);
+        image[i] ^= 0xff;
+        TEST_EQUALITY(deserialize_test_frozen_map_opens(image, size, False) == in_seed);
+        image[i] ^= 0xff;
+    }
+
+    /* corrupted pilots send keys to wrong slots, but never outside image */
+    FrozenMapHeader* header = (FrozenMapHeader*)image;
+    Uint32*          pilots = (Uint32*)(header + 1);
+    for(Size b = 0; b < header->bucket_count; b++) {
+        pilots[b] = ~pilots[b];
+    }
+    TEST_EQUALITY(deserialize_test_frozen_map_opens(image, size, False));
+
+    DO_BEFORE_EXIT(
+        if(map) frozen_map_destroy(map);
+        free(image);
+    );
+}
+
+/* an image of one kind of container is never loaded as another */
+TEST_FN Bool ImageLoad_WHEN_KIND_DOES_NOT_MATCH() {
+    String* str   = str_create("an image holding a string");
+    void*   image = NULL;
+    Image*  img   = NULL;
+    TEST_OBJECT(str);
+
+    Size size = str_write_to_buffer(str, NULL, 0);
+    TEST_LENGTH_GT(size, 0);
+    image = aligned_alloc(16, (size + 15) / 16 * 16);
+    TEST_EQUALITY(image);
+    TEST_LENGTH_EQ(str_write_to_buffer(str, image, size), size);
+
+    img = image_wrap_buffer(image, size);
+    TEST_EQUALITY(img);
+    TEST_EQUALITY(image_get_kind(img) == IMAGE_KIND_STRING);
+    TEST_EQUALITY(!vector_from_image(img));
+    TEST_EQUALITY(!bitvec_from_image(img));
+    TEST_EQUALITY(!dense_map_from_image(img, (HashCallback)(void*)hash_u64, (CompareElementCallback)(void*)compare_u64));
+
+    String* loaded = str_from_image(img);
+    TEST_EQUALITY(loaded);
+    TEST_LENGTH_EQ(loaded->length, str->length);
+    TEST_EQUALITY(!memcmp(loaded->data, str->data, str->length));
+
+    DO_BEFORE_EXIT(
+        if(img) image_destroy(img);
+        free(image);
+        if(str) str_destroy(str);
+    );
+}
+
+BEGIN_TESTS(deserialize)
+    TEST(RoaringDeserialize_WHEN_BUFFER_IS_TRUNCATED),
+    TEST(RoaringDeserialize_WHEN_BUFFER_IS_CORRUPTED),
+    TEST(FrozenMapOpen_WHEN_IMAGE_IS_TRUNCATED_OR_MISALIGNED),
+    TEST(FrozenMapOpen_WHEN_HEADER_IS_CORRUPTED),
+    TEST(ImageLoad_WHEN_KIND_DOES_NOT_MATCH)
+END_TESTS()
@@ -0,0 +1,234 @@
+/**
+ * @file frozen_map.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for FrozenMap, freezing dense maps and serializing their
+ * images to open them again in place.
+ * */
+
+#include <Anvie/Containers/FrozenMap.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FMAP_TEST_KEYS 5000
+
+/* key too large to be passed by value */
+typedef struct FmapTestKey {
+    Uint64 id;
+    Uint64 pad[2];
+} FmapTestKey;
+
+static Size fmap_test_hash_key(FmapTestKey* key, void* udata) {
+    UNUSED(udata);
+    return hash_u64(key->id, NULL);
+}
+
+static Int32 fmap_test_compare_key(FmapTestKey* a, FmapTestKey* b, void* udata) {
+    UNUSED(udata);
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+/* keys are spread out so that absent keys fall in between them */
+static DenseMap* fmap_test_u64_map(Size count) {
+    DenseMap* map = dense_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64), NULL, NULL,
+                                     (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), NULL, NULL, False,
+                                     DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+    if(map) {
+        for(Uint64 k = 0; k < count; k++) dense_map_insert(map, (void*)(k * 2), (void*)(k * 7), NULL);
+    }
+    return map;
+}
+
+/* every key of fmap_test_u64_map is found with it's data, and none of keys between them */
+static Bool fmap_test_check_u64(FrozenMap* fmap, Size count) {
+    if(frozen_map_item_count(fmap) != count) {
+        return False;
+    }
+    for(Uint64 k = 0; k < count; k++) {
+        Uint64* data = frozen_map_search(fmap, (void*)(k * 2), NULL);
+        if(!data || *data != k * 7 || frozen_map_search(fmap, (void*)(k * 2 + 1), NULL)) {
+            return False;
+        }
+    }
+    return !frozen_map_search(fmap, (void*)(count * 2), NULL);
+}
+
+TEST_FN Bool Freeze_WHEN_INTEGER_KEYS_THEN_FIND_ALL() {
+    Size       counts[] = {0, 1, 2, 3, 100, FMAP_TEST_KEYS};
+    DenseMap*  map      = NULL;
+    FrozenMap* fmap     = NULL;
+
+    for(Size i = 0; i < ARRAY_SIZE(counts); i++) {
+        map = fmap_test_u64_map(counts[i]);
+        TEST_EQUALITY(map != NULL);
+        fmap = dense_map_freeze(map, NULL);
+        TEST_EQUALITY(fmap != NULL);
+
+        /* frozen map owns it's image, so source map is not needed anymore */
+        dense_map_destroy(map, NULL);
+        map = NULL;
+        TEST_EQUALITY(fmap_test_check_u64(fmap, counts[i]));
+
+        frozen_map_destroy(fmap);
+        fmap = NULL;
+    }
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+        if(fmap) frozen_map_destroy(fmap);
+    );
+}
+
+TEST_FN Bool Freeze_WHEN_INLINE_STRUCT_KEYS_THEN_FIND_ALL() {
+    DenseMap*  map  = dense_map_create_inline((HashCallback)(void*)fmap_test_hash_key, sizeof(FmapTestKey), NULL, NULL,
+                                              (CompareElementCallback)(void*)fmap_test_compare_key, sizeof(Uint32),
+                                              NULL, NULL, 0, 0, False, DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE, NULL);
+    FrozenMap* fmap = NULL;
+    TEST_OBJECT(map);
+
+    for(Uint64 k = 0; k < FMAP_TEST_KEYS; k++) {
+        FmapTestKey key = {.id = k * 3};
+        TEST_EQUALITY(dense_map_insert(map, &key, (void*)(k + 1), NULL) != NULL);
+    }
+    fmap = dense_map_freeze(map, NULL);
+    TEST_EQUALITY(fmap != NULL);
+    TEST_LENGTH_EQ(frozen_map_item_count(fmap), FMAP_TEST_KEYS);
+
+    for(Uint64 k = 0; k < FMAP_TEST_KEYS; k++) {
+        FmapTestKey key  = {.id = k * 3};
+        Uint32*     data = frozen_map_search(fmap, &key, NULL);
+        TEST_EQUALITY(data && *data == k + 1);
+        key.id++;
+        TEST_EQUALITY(frozen_map_search(fmap, &key, NULL) == NULL);
+    }
+
+    /* every slot holds one distinct key, there are no empty ones */
+    Uint64 id_sum = 0;
+    for(Size pos = 0; pos < frozen_map_item_count(fmap); pos++) {
+        id_sum += ((FmapTestKey*)frozen_map_slot_key(fmap, pos))->id;
+    }
+    TEST_EQUALITY(id_sum == 3ull * FMAP_TEST_KEYS * (FMAP_TEST_KEYS - 1) / 2);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+        if(fmap) frozen_map_destroy(fmap);
+    );
+}
+
+TEST_FN Bool Serialize_WHEN_OPENED_IN_PLACE_THEN_FIND_ALL() {
+    DenseMap*  map    = fmap_test_u64_map(FMAP_TEST_KEYS);
+    FrozenMap* fmap   = NULL;
+    FrozenMap* opened = NULL;
+    Uint8*     image  = NULL;
+    Uint8*     again  = NULL;
+    TEST_OBJECT(map);
+
+    fmap = dense_map_freeze(map, NULL);
+    TEST_EQUALITY(fmap != NULL);
+
+    Size size = frozen_map_serialized_size(fmap);
+    TEST_LENGTH_GT(size, sizeof(FrozenMapHeader));
+    image = aligned_alloc(16, (size + 15) & ~(Size)15);
+    TEST_EQUALITY(image != NULL);
+    TEST_LENGTH_EQ(frozen_map_serialize(fmap, image, size - 1), 0);
+    TEST_LENGTH_EQ(frozen_map_serialize(fmap, image, size), size);
+
+    /* image does not depend on map that wrote it */
+    frozen_map_destroy(fmap);
+    fmap = NULL;
+
+    opened = frozen_map_open(image, size, (HashCallback)(void*)hash_u64, (CompareElementCallback)(void*)compare_u64, NULL);
+    TEST_EQUALITY(opened != NULL && !opened->owns_image);
+    TEST_EQUALITY(fmap_test_check_u64(opened, FMAP_TEST_KEYS));
+
+    /* opened image writes itself back byte for byte */
+    again = ALLOCATE(Uint8, size);
+    TEST_EQUALITY(again != NULL);
+    TEST_LENGTH_EQ(frozen_map_serialize(opened, again, size), size);
+    TEST_EQUALITY(!memcmp(again, image, size));
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+        if(fmap) frozen_map_destroy(fmap);
+        if(opened) frozen_map_destroy(opened);
+        free(image);
+        FREE(again);
+    );
+}
+
+TEST_FN Bool Open_WHEN_IMAGE_INVALID_THEN_RETURN_NULL() {
+    DenseMap*  map   = fmap_test_u64_map(100);
+    FrozenMap* fmap  = NULL;
+    Uint64*    image = NULL;
+    TEST_OBJECT(map);
+
+    fmap = dense_map_freeze(map, NULL);
+    TEST_EQUALITY(fmap != NULL);
+    Size size = frozen_map_serialized_size(fmap);
+    image = ALLOCATE(Uint64, size / sizeof(Uint64) + 2);
+    TEST_EQUALITY(image != NULL);
+    TEST_LENGTH_EQ(frozen_map_serialize(fmap, image, size), size);
+
+    HashCallback           hash    = (HashCallback)(void*)hash_u64;
+    CompareElementCallback compare = (CompareElementCallback)(void*)compare_u64;
+
+    /* truncated, or not aligned */
+    TEST_EQUALITY(frozen_map_open(image, size - 8, hash, compare, NULL) == NULL);
+    TEST_EQUALITY(frozen_map_open(image, sizeof(FrozenMapHeader) - 1, hash, compare, NULL) == NULL);
+    memmove((Uint8*)image + 4, image, size);
+    TEST_EQUALITY(frozen_map_open((Uint8*)image + 4, size, hash, compare, NULL) == NULL);
+    memmove(image, (Uint8*)image + 4, size);
+
+    /* header fields that don't agree with each other */
+    FrozenMapHeader* header = (FrozenMapHeader*)image;
+    header->magic++;
+    TEST_EQUALITY(frozen_map_open(image, size, hash, compare, NULL) == NULL);
+    header->magic--;
+    header->version++;
+    TEST_EQUALITY(frozen_map_open(image, size, hash, compare, NULL) == NULL);
+    header->version--;
+    header->item_count++;
+    TEST_EQUALITY(frozen_map_open(image, size + 8, hash, compare, NULL) == NULL);
+    header->item_count--;
+    header->data_offset = header->slot_size;
+    TEST_EQUALITY(frozen_map_open(image, size, hash, compare, NULL) == NULL);
+    header->data_offset = fmap->header->data_offset;
+
+    /* and image restored as it was opens again */
+    FrozenMap* opened = frozen_map_open(image, size, hash, compare, NULL);
+    TEST_EQUALITY(opened != NULL);
+    Bool found = fmap_test_check_u64(opened, 100);
+    frozen_map_destroy(opened);
+    TEST_EQUALITY(found);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+        if(fmap) frozen_map_destroy(fmap);
+        FREE(image);
+    );
+}
+
+BEGIN_TESTS(frozen_map)
+    TEST(Freeze_WHEN_INTEGER_KEYS_THEN_FIND_ALL),
+    TEST(Freeze_WHEN_INLINE_STRUCT_KEYS_THEN_FIND_ALL),
+    TEST(Serialize_WHEN_OPENED_IN_PLACE_THEN_FIND_ALL),
+    TEST(Open_WHEN_IMAGE_INVALID_THEN_RETURN_NULL)
+END_TESTS()
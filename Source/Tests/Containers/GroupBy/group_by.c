@@ -0,0 +1,180 @@
+/**
+ * @file group_by.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for GroupBy, checking aggregates of small inputs, inputs
+ * that spill into partitions, and parallel aggregation.
+ * */
+
+#include <Anvie/Containers/GroupBy.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+/* more groups than fit in a single table, so rows get partitioned */
+#define GROUP_BY_TEST_GROUPS 40000
+#define GROUP_BY_TEST_ROWS   (1 << 17)
+
+/* distinct keys for each group, spread over whole key range */
+#define GROUP_BY_TEST_KEY(g) ((Uint64)(g) * 1000003 + 17)
+#define GROUP_BY_TEST_GROUP(k) (((k) - 17) / 1000003)
+
+/* expected aggregates of one group */
+typedef struct GroupByTestAgg {
+    Float64 sum;
+    Uint64  count;
+    Float64 min;
+    Float64 max;
+    Bool    seen;
+} GroupByTestAgg;
+
+/* rows in pseudo random group order, values are small integers so every sum is exact */
+static Bool group_by_test_rows(U64_Vector* keys, F64_Vector* values, GroupByTestAgg* expected) {
+    Uint64 state = 0x9e3779b97f4a7c15ull;
+    for(Size i = 0; i < GROUP_BY_TEST_ROWS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        Size    g     = state % GROUP_BY_TEST_GROUPS;
+        Float64 value = (Float64)((Int64)(state >> 40) % 1000 - 500);
+        u64_vector_push_back(keys, GROUP_BY_TEST_KEY(g), NULL);
+        f64_vector_push_back(values, value, NULL);
+
+        GroupByTestAgg* agg = expected + g;
+        agg->min   = agg->count ? MIN(agg->min, value) : value;
+        agg->max   = agg->count ? MAX(agg->max, value) : value;
+        agg->sum  += value;
+        agg->count++;
+    }
+    return keys->length == GROUP_BY_TEST_ROWS && values->length == GROUP_BY_TEST_ROWS;
+}
+
+/* result has every group of expected exactly once, with matching aggregates */
+static Bool group_by_test_check(GroupByResult* result, GroupByTestAgg* expected) {
+    Size groups = 0;
+    for(Size g = 0; g < GROUP_BY_TEST_GROUPS; g++) {
+        expected[g].seen  = False;
+        groups           += expected[g].count != 0;
+    }
+    if(result->keys->length != groups || result->sums->length != groups || result->counts->length != groups ||
+       result->mins->length != groups || result->maxs->length != groups) {
+        return False;
+    }
+
+    for(Size i = 0; i < groups; i++) {
+        Uint64 g = GROUP_BY_TEST_GROUP(result->keys->data[i]);
+        if(g >= GROUP_BY_TEST_GROUPS || expected[g].seen || !expected[g].count) {
+            return False;
+        }
+        expected[g].seen = True;
+
+        GroupByTestAgg* agg = expected + g;
+        if(result->sums->data[i] != agg->sum || result->counts->data[i] != agg->count ||
+           result->mins->data[i] != agg->min || result->maxs->data[i] != agg->max) {
+            return False;
+        }
+    }
+    return True;
+}
+
+TEST_FN Bool Aggregate_WHEN_FEW_KEYS_THEN_FIRST_APPEARANCE_ORDER() {
+    U64_Vector*   keys         = u64_vector_create();
+    F64_Vector*   values       = f64_vector_create();
+    GroupByResult result       = {0};
+    Uint64        row_keys[]   = {5, ~(Uint64)0, 5, 0, 7, ~(Uint64)0, 5};
+    Float64       row_values[] = {1.5, -2.0, 4.0, 0.0, 8.0, 3.0, -1.0};
+    TEST_EQUALITY(keys && values);
+
+    u64_vector_push_back_n(keys, row_keys, ARRAY_SIZE(row_keys), NULL);
+    f64_vector_push_back_n(values, row_values, ARRAY_SIZE(row_values), NULL);
+    TEST_EQUALITY(group_by_aggregate_f64(keys, values, &result));
+
+    /* all keys are valid, including those that look like sentinels */
+    Uint64  group_keys[] = {5, ~(Uint64)0, 0, 7};
+    Float64 sums[]       = {4.5, 1.0, 0.0, 8.0};
+    Uint64  counts[]     = {3, 2, 1, 1};
+    Float64 mins[]       = {-1.0, -2.0, 0.0, 8.0};
+    Float64 maxs[]       = {4.0, 3.0, 0.0, 8.0};
+    TEST_LENGTH_EQ(result.keys->length, ARRAY_SIZE(group_keys));
+    for(Size i = 0; i < ARRAY_SIZE(group_keys); i++) {
+        TEST_EQUALITY(result.keys->data[i] == group_keys[i] && result.sums->data[i] == sums[i]);
+        TEST_EQUALITY(result.counts->data[i] == counts[i]);
+        TEST_EQUALITY(result.mins->data[i] == mins[i] && result.maxs->data[i] == maxs[i]);
+    }
+
+    group_by_result_destroy(&result);
+    TEST_EQUALITY(!result.keys && !result.sums);
+
+    /* no rows gives no groups */
+    u64_vector_clear(keys, NULL);
+    f64_vector_clear(values, NULL);
+    TEST_EQUALITY(group_by_aggregate_f64(keys, values, &result));
+    TEST_EQUALITY(result.keys && !result.keys->length);
+
+    DO_BEFORE_EXIT(
+        group_by_result_destroy(&result);
+        if(keys) u64_vector_destroy(keys, NULL);
+        if(values) f64_vector_destroy(values, NULL);
+    );
+}
+
+TEST_FN Bool Aggregate_WHEN_GROUPS_SPILL_THEN_MATCH_REFERENCE() {
+    U64_Vector*     keys     = u64_vector_create();
+    F64_Vector*     values   = f64_vector_create();
+    GroupByTestAgg* expected = ALLOCATE(GroupByTestAgg, GROUP_BY_TEST_GROUPS);
+    GroupByResult   result   = {0};
+    TEST_EQUALITY(keys && values && expected);
+
+    TEST_EQUALITY(group_by_test_rows(keys, values, expected));
+    TEST_EQUALITY(group_by_aggregate_f64(keys, values, &result));
+    TEST_EQUALITY(group_by_test_check(&result, expected));
+
+    DO_BEFORE_EXIT(
+        group_by_result_destroy(&result);
+        if(keys) u64_vector_destroy(keys, NULL);
+        if(values) f64_vector_destroy(values, NULL);
+        FREE(expected);
+    );
+}
+
+TEST_FN Bool Aggregate_WHEN_PARALLEL_THEN_SAME_AS_SERIAL() {
+    U64_Vector*     keys     = u64_vector_create();
+    F64_Vector*     values   = f64_vector_create();
+    GroupByTestAgg* expected = ALLOCATE(GroupByTestAgg, GROUP_BY_TEST_GROUPS);
+    ThreadPool*     pool     = thread_pool_create(3);
+    GroupByResult   result   = {0};
+    TEST_EQUALITY(keys && values && expected && pool);
+
+    TEST_EQUALITY(group_by_test_rows(keys, values, expected));
+    TEST_EQUALITY(group_by_aggregate_f64_parallel(pool, keys, values, &result));
+    TEST_EQUALITY(group_by_test_check(&result, expected));
+
+    DO_BEFORE_EXIT(
+        group_by_result_destroy(&result);
+        if(pool) thread_pool_destroy(pool);
+        if(keys) u64_vector_destroy(keys, NULL);
+        if(values) f64_vector_destroy(values, NULL);
+        FREE(expected);
+    );
+}
+
+BEGIN_TESTS(group_by)
+    TEST(Aggregate_WHEN_FEW_KEYS_THEN_FIRST_APPEARANCE_ORDER),
+    TEST(Aggregate_WHEN_GROUPS_SPILL_THEN_MATCH_REFERENCE),
+    TEST(Aggregate_WHEN_PARALLEL_THEN_SAME_AS_SERIAL)
+END_TESTS()
@@ -29,4 +29,55 @@
 /* import unit tests from bitvector */
 #include "BitVector/ImportUnitTests.h"
 
+/* import unit tests from atomic bitvector */
+#include "AtomicBitVector/ImportUnitTests.h"
+
+/* import unit tests from concurrent map */
+#include "ConcurrentMap/ImportUnitTests.h"
+
+/* import unit tests from snapshot map */
+#include "SnapshotMap/ImportUnitTests.h"
+
+/* import unit tests from queue */
+#include "Queue/ImportUnitTests.h"
+
+/* import unit tests of loading containers from untrusted bytes */
+#include "Deserialize/ImportUnitTests.h"
+
+/* import unit tests from zstring keyed maps */
+#include "ZStrMap/ImportUnitTests.h"
+
+/* import unit tests from dense map */
+#include "DenseMap/ImportUnitTests.h"
+
+/* import unit tests from string */
+#include "String/ImportUnitTests.h"
+
+/* import unit tests from btree */
+#include "BTree/ImportUnitTests.h"
+
+/* import unit tests from radix tree */
+#include "RadixTree/ImportUnitTests.h"
+
+/* import unit tests from roaring bitmap */
+#include "RoaringBitmap/ImportUnitTests.h"
+
+/* import unit tests from deque */
+#include "Deque/ImportUnitTests.h"
+
+/* import unit tests from priority queue */
+#include "PriorityQueue/ImportUnitTests.h"
+
+/* import unit tests from cache */
+#include "Cache/ImportUnitTests.h"
+
+/* import unit tests from frozen map */
+#include "FrozenMap/ImportUnitTests.h"
+
+/* import unit tests from group by */
+#include "GroupBy/ImportUnitTests.h"
+
+/* import unit tests from pipeline */
+#include "Pipeline/ImportUnitTests.h"
+
 #endif // ANVIE_UTILS_TESTS_CONTAINER_IMPORT_UNIT_TESTS_H
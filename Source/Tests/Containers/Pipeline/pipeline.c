@@ -0,0 +1,236 @@
+/**
+ * @file pipeline.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for Pipeline, running callback and numeric stages over
+ * vectors, maps and set bits, across many chunks.
+ * */
+
+#include <Anvie/Containers/Pipeline.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+/* several chunks worth of elements, and not a multiple of chunk size */
+#define PIPELINE_TEST_ELEMS 10007
+
+static Bool pipeline_test_is_odd(Uint32 value, Size* calls) {
+    (*calls)++;
+    return value & 1;
+}
+
+static void pipeline_test_square(Uint64* dst, Uint32 value, void* udata) {
+    UNUSED(udata);
+    *dst = (Uint64)value * value;
+}
+
+static void pipeline_test_sum(Uint64* acc, Uint64 value, void* udata) {
+    UNUSED(udata);
+    *acc += value;
+}
+
+static void pipeline_test_item_sum(Uint64* dst, DenseMapItem* item, void* udata) {
+    UNUSED(udata);
+    *dst = (Uint64)item->key + (Uint64)item->data;
+}
+
+TEST_FN Bool Callbacks_WHEN_CHAINED_THEN_MATCH_LOOP() {
+    U32_Vector* vec = u32_vector_create();
+    U64_Vector* out = u64_vector_create();
+    TEST_EQUALITY(vec && out);
+
+    for(Uint32 i = 0; i < PIPELINE_TEST_ELEMS; i++) u32_vector_push_back(vec, i, NULL);
+
+    Size     calls    = 0;
+    Pipeline pipeline = u32_pipeline_from_vector(vec);
+    pipeline_filter(&pipeline, (FilterElementCallback)(void*)pipeline_test_is_odd, &calls);
+    pipeline_map(&pipeline, sizeof(Uint64), (MapElementCallback)(void*)pipeline_test_square, NULL);
+
+    /* pipeline is evaluated again by every reduction */
+    Size odd = PIPELINE_TEST_ELEMS / 2;
+    TEST_LENGTH_EQ(pipeline_count(&pipeline), odd);
+    TEST_LENGTH_EQ(calls, PIPELINE_TEST_ELEMS);
+
+    Uint64 sum = 0, expected = 0;
+    pipeline_reduce(&pipeline, &sum, (ReduceElementCallback)(void*)pipeline_test_sum, NULL);
+    TEST_LENGTH_EQ(pipeline_collect(&pipeline, (Vector*)out, NULL), odd);
+    TEST_LENGTH_EQ(out->length, odd);
+    for(Size i = 0; i < odd; i++) {
+        Uint64 value = 2 * i + 1;
+        TEST_EQUALITY(out->data[i] == value * value);
+        expected += value * value;
+    }
+    TEST_EQUALITY(sum == expected && u64_pipeline_sum(&pipeline) == expected);
+
+    DO_BEFORE_EXIT(
+        if(vec) u32_vector_destroy(vec, NULL);
+        if(out) u64_vector_destroy(out, NULL);
+    );
+}
+
+TEST_FN Bool Numeric_WHEN_CHAINED_THEN_MATCH_LOOP() {
+    I32_Vector* vec = i32_vector_create();
+    F64_Vector* fvec = f64_vector_create();
+    TEST_EQUALITY(vec && fvec);
+
+    for(Int32 i = 0; i < PIPELINE_TEST_ELEMS; i++) {
+        i32_vector_push_back(vec, (i * 37) % 2001 - 1000, NULL);
+        f64_vector_push_back(fvec, (Float64)(i % 100) - 49.5, NULL);
+    }
+
+    Pipeline pipeline = i32_pipeline_from_vector(vec);
+    i32_pipeline_add(&pipeline, 5);
+    i32_pipeline_mul(&pipeline, -2);
+    i32_pipeline_retain_in_range(&pipeline, -300, 700);
+
+    Int64 sum   = 0;
+    Int32 min   = INT32_MAX, max = INT32_MIN;
+    Size  count = 0;
+    for(Size i = 0; i < vec->length; i++) {
+        Int32 value = (vec->data[i] + 5) * -2;
+        if(value >= -300 && value <= 700) {
+            sum += value;
+            min  = MIN(min, value);
+            max  = MAX(max, value);
+            count++;
+        }
+    }
+
+    Int32 got_min, got_max;
+    TEST_LENGTH_EQ(pipeline_count(&pipeline), count);
+    TEST_EQUALITY(i32_pipeline_sum(&pipeline) == sum);
+    TEST_EQUALITY(i32_pipeline_min(&pipeline, &got_min) && got_min == min);
+    TEST_EQUALITY(i32_pipeline_max(&pipeline, &got_max) && got_max == max);
+
+    /* nothing left gives no min and no max */
+    i32_pipeline_retain_lt(&pipeline, -300);
+    TEST_EQUALITY(pipeline_count(&pipeline) == 0 && !i32_pipeline_min(&pipeline, &got_min));
+    TEST_EQUALITY(i32_pipeline_sum(&pipeline) == 0);
+
+    /* halves are exact, so float sums compare exactly */
+    Pipeline fpipeline = f64_pipeline_from_vector(fvec);
+    f64_pipeline_retain_lt(&fpipeline, 0.0);
+    f64_pipeline_mul(&fpipeline, 2.0);
+    Float64 fsum = 0.0;
+    for(Size i = 0; i < fvec->length; i++) {
+        fsum += fvec->data[i] < 0.0 ? fvec->data[i] * 2.0 : 0.0;
+    }
+    Float64 fmin;
+    TEST_EQUALITY(f64_pipeline_sum(&fpipeline) == fsum);
+    TEST_EQUALITY(f64_pipeline_min(&fpipeline, &fmin) && fmin == -99.0);
+
+    DO_BEFORE_EXIT(
+        if(vec) i32_vector_destroy(vec, NULL);
+        if(fvec) f64_vector_destroy(fvec, NULL);
+    );
+}
+
+TEST_FN Bool Take_WHEN_COUNT_REACHED_THEN_STOP_PULLING() {
+    U32_Vector* vec = u32_vector_create();
+    U32_Vector* out = u32_vector_create();
+    TEST_EQUALITY(vec && out);
+
+    for(Uint32 i = 0; i < PIPELINE_TEST_ELEMS; i++) u32_vector_push_back(vec, i, NULL);
+
+    Size     calls    = 0;
+    Pipeline pipeline = u32_pipeline_from_vector(vec);
+    pipeline_filter(&pipeline, (FilterElementCallback)(void*)pipeline_test_is_odd, &calls);
+    pipeline_take(&pipeline, 10);
+
+    TEST_LENGTH_EQ(pipeline_collect(&pipeline, (Vector*)out, NULL), 10);
+    for(Uint32 i = 0; i < 10; i++) TEST_EQUALITY(out->data[i] == 2 * i + 1);
+
+    /* only first chunk was filtered */
+    TEST_LENGTH_GT(calls, 0);
+    TEST_EQUALITY(calls < PIPELINE_TEST_ELEMS / 2);
+
+    DO_BEFORE_EXIT(
+        if(vec) u32_vector_destroy(vec, NULL);
+        if(out) u32_vector_destroy(out, NULL);
+    );
+}
+
+TEST_FN Bool Sources_WHEN_MAP_OR_BITS_THEN_VISIT_ALL() {
+    DenseMap*  map = dense_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64), NULL, NULL,
+                                      (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), NULL, NULL, False,
+                                      DENSE_MAP_DEFAULT_LOAD_FACTOR_TOLERANCE);
+    BitVector* bv  = bitvec_create();
+    TEST_EQUALITY(map && bv);
+
+    Uint64 expected = 0;
+    for(Uint64 k = 0; k < PIPELINE_TEST_ELEMS; k++) {
+        dense_map_insert(map, (void*)k, (void*)(k * 3), NULL);
+        expected += k * 4;
+    }
+
+    /* map items are passed as item pointers */
+    Pipeline pipeline = pipeline_from_dense_map(map);
+    pipeline_map(&pipeline, sizeof(Uint64), (MapElementCallback)(void*)pipeline_test_item_sum, NULL);
+    TEST_LENGTH_EQ(pipeline_count(&pipeline), PIPELINE_TEST_ELEMS);
+    TEST_EQUALITY(u64_pipeline_sum(&pipeline) == expected);
+
+    /* set bits are passed as their positions */
+    bitvec_resize(bv, PIPELINE_TEST_ELEMS);
+    Size   set_count = 0;
+    Uint64 set_sum   = 0;
+    for(Size i = 0; i < PIPELINE_TEST_ELEMS; i += 3) {
+        bitvec_set(bv, i);
+        set_count++;
+        set_sum += i;
+    }
+    Pipeline bits = pipeline_from_set_bits(bv);
+    TEST_LENGTH_EQ(pipeline_count(&bits), set_count);
+    TEST_EQUALITY(u64_pipeline_sum(&bits) == set_sum);
+
+    DO_BEFORE_EXIT(
+        if(map) dense_map_destroy(map, NULL);
+        if(bv) bitvec_destroy(bv);
+    );
+}
+
+TEST_FN Bool Build_WHEN_STAGE_INVALID_THEN_PIPELINE_FAILS() {
+    U32_Vector* vec = u32_vector_create();
+    TEST_OBJECT(vec);
+
+    for(Uint32 i = 0; i < 100; i++) u32_vector_push_back(vec, i, NULL);
+
+    /* stage type must match element type */
+    Pipeline pipeline = u32_pipeline_from_vector(vec);
+    u64_pipeline_add(&pipeline, 1);
+    TEST_EQUALITY(pipeline.failed && pipeline_count(&pipeline) == 0);
+
+    /* and there's a limit on number of stages */
+    Pipeline full = u32_pipeline_from_vector(vec);
+    for(Size i = 0; i <= PIPELINE_MAX_STAGES; i++) u32_pipeline_add(&full, 1);
+    TEST_EQUALITY(full.failed && pipeline_count(&full) == 0);
+
+    Pipeline ok = u32_pipeline_from_vector(vec);
+    for(Size i = 0; i < PIPELINE_MAX_STAGES; i++) u32_pipeline_add(&ok, 1);
+    TEST_EQUALITY(!ok.failed && u32_pipeline_sum(&ok) == 99 * 100 / 2 + 100 * PIPELINE_MAX_STAGES);
+
+    DO_BEFORE_EXIT(
+        if(vec) u32_vector_destroy(vec, NULL);
+    );
+}
+
+BEGIN_TESTS(pipeline)
+    TEST(Callbacks_WHEN_CHAINED_THEN_MATCH_LOOP),
+    TEST(Numeric_WHEN_CHAINED_THEN_MATCH_LOOP),
+    TEST(Take_WHEN_COUNT_REACHED_THEN_STOP_PULLING),
+    TEST(Sources_WHEN_MAP_OR_BITS_THEN_VISIT_ALL),
+    TEST(Build_WHEN_STAGE_INVALID_THEN_PIPELINE_FAILS)
+END_TESTS()
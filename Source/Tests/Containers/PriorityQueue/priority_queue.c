@@ -0,0 +1,211 @@
+/**
+ * @file priority_queue.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for PriorityQueue, checking pop order of numeric and struct
+ * queues, bounded top k and heapified vectors.
+ * */
+
+#include <Anvie/Containers/PriorityQueue.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#define PQ_TEST_ELEMS 2000
+#define PQ_TEST_TOP_K 16
+
+/* struct elements are copied, and live copies are counted in Size passed as udata */
+typedef struct PqTestJob {
+    Int64  priority;
+    Uint64 id;
+    Uint64 pad;
+} PqTestJob;
+
+static void pq_test_create_copy(PqTestJob* dst, PqTestJob* src, Size* live) {
+    *dst = *src;
+    (*live)++;
+}
+
+static void pq_test_destroy_copy(PqTestJob* copy, Size* live) {
+    UNUSED(copy);
+    (*live)--;
+}
+
+/* higher priority on top */
+static Int32 pq_test_compare_job(PqTestJob* a, PqTestJob* b, Size* live) {
+    UNUSED(live);
+    return (a->priority > b->priority) - (a->priority < b->priority);
+}
+
+static Uint64 pq_test_next(Uint64* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+TEST_FN Bool Pop_WHEN_NUMERIC_QUEUE_THEN_SORTED_BOTH_WAYS() {
+    I64_PriorityQueue* asc  = i64_priority_queue_create(False);
+    I64_PriorityQueue* desc = i64_priority_queue_create(True);
+    TEST_EQUALITY(asc && desc);
+
+    Uint64 state = 0x9e3779b97f4a7c15ull, sum = 0;
+    for(Size i = 0; i < PQ_TEST_ELEMS; i++) {
+        /* small range so that there are duplicates, and both signs */
+        Int64 value = (Int64)(pq_test_next(&state) % 1000) - 500;
+        i64_priority_queue_push(asc, value);
+        i64_priority_queue_push(desc, value);
+        sum += (Uint64)value;
+    }
+    TEST_LENGTH_EQ(i64_priority_queue_length(asc), PQ_TEST_ELEMS);
+    TEST_EQUALITY(i64_priority_queue_peek(asc) < i64_priority_queue_peek(desc));
+
+    Int64  prev_asc = INT64_MIN, prev_desc = INT64_MAX;
+    Uint64 sum_asc = 0, sum_desc = 0;
+    for(Size i = 0; i < PQ_TEST_ELEMS; i++) {
+        Int64 a, d;
+        TEST_EQUALITY(i64_priority_queue_pop(asc, &a) && i64_priority_queue_pop(desc, &d));
+        TEST_EQUALITY(a >= prev_asc && d <= prev_desc);
+        prev_asc  = a;
+        prev_desc = d;
+        sum_asc  += (Uint64)a;
+        sum_desc += (Uint64)d;
+    }
+    TEST_EQUALITY(sum_asc == sum && sum_desc == sum);
+
+    Int64 out = 7;
+    TEST_EQUALITY(!i64_priority_queue_pop(asc, &out) && out == 7);
+    TEST_EQUALITY(priority_queue_is_empty(asc) && i64_priority_queue_peek(asc) == 0);
+
+    DO_BEFORE_EXIT(
+        if(asc) i64_priority_queue_destroy(asc);
+        if(desc) i64_priority_queue_destroy(desc);
+    );
+}
+
+TEST_FN Bool Pop_WHEN_FLOAT_QUEUE_THEN_NEGATIVES_FIRST() {
+    F64_PriorityQueue* pq       = f64_priority_queue_create(False);
+    Float64            values[] = {3.5, -0.25, 0.0, -1e9, 1e-9, -3.5, 42.0, -0.125};
+    Float64            sorted[] = {-1e9, -3.5, -0.25, -0.125, 0.0, 1e-9, 3.5, 42.0};
+    TEST_OBJECT(pq);
+
+    for(Size i = 0; i < ARRAY_SIZE(values); i++) f64_priority_queue_push(pq, values[i]);
+    for(Size i = 0; i < ARRAY_SIZE(sorted); i++) {
+        Float64 out;
+        TEST_EQUALITY(f64_priority_queue_pop(pq, &out) && out == sorted[i]);
+    }
+
+    DO_BEFORE_EXIT(
+        if(pq) f64_priority_queue_destroy(pq);
+    );
+}
+
+TEST_FN Bool ReplaceTop_WHEN_BOUNDED_THEN_KEEP_TOP_K() {
+    U64_PriorityQueue* pq = u64_priority_queue_create(False);
+    TEST_OBJECT(pq);
+
+    /* values are a permutation of [0, PQ_TEST_ELEMS), so top k are known */
+    for(Uint64 i = 0; i < PQ_TEST_ELEMS; i++) {
+        Uint64 value = (i * 7919) % PQ_TEST_ELEMS;
+        if(u64_priority_queue_length(pq) < PQ_TEST_TOP_K) {
+            u64_priority_queue_push(pq, value);
+        } else if(value > u64_priority_queue_peek(pq)) {
+            Uint64 out;
+            TEST_EQUALITY(u64_priority_queue_replace_top(pq, value, &out) && out < value);
+        }
+    }
+    TEST_LENGTH_EQ(u64_priority_queue_length(pq), PQ_TEST_TOP_K);
+    for(Uint64 i = PQ_TEST_ELEMS - PQ_TEST_TOP_K; i < PQ_TEST_ELEMS; i++) {
+        Uint64 out;
+        TEST_EQUALITY(u64_priority_queue_pop(pq, &out) && out == i);
+    }
+    TEST_EQUALITY(!u64_priority_queue_replace_top(pq, 1, NULL) && priority_queue_is_empty(pq));
+
+    DO_BEFORE_EXIT(
+        if(pq) u64_priority_queue_destroy(pq);
+    );
+}
+
+TEST_FN Bool Heapify_WHEN_CREATED_FROM_VECTOR_THEN_POP_SORTED() {
+    U32_Vector*        vec = u32_vector_create();
+    U32_PriorityQueue* pq  = NULL;
+    TEST_OBJECT(vec);
+
+    for(Uint32 i = 0; i < PQ_TEST_ELEMS; i++) u32_vector_push_back(vec, (i * 7919) % PQ_TEST_ELEMS, NULL);
+    pq = u32_priority_queue_from_vector(vec, True);
+    TEST_EQUALITY(pq != NULL);
+    vec = NULL;
+
+    for(Uint32 i = PQ_TEST_ELEMS; i--;) {
+        Uint32 out;
+        TEST_EQUALITY(u32_priority_queue_pop(pq, &out) && out == i);
+    }
+
+    DO_BEFORE_EXIT(
+        if(vec) u32_vector_destroy(vec, NULL);
+        if(pq) u32_priority_queue_destroy(pq);
+    );
+}
+
+TEST_FN Bool Pop_WHEN_STRUCT_QUEUE_THEN_CALLER_OWNS_COPY() {
+    Size           live = 0;
+    PriorityQueue* pq   = priority_queue_create(sizeof(PqTestJob), (CreateElementCopyCallback)(void*)pq_test_create_copy,
+                                                (DestroyElementCopyCallback)(void*)pq_test_destroy_copy,
+                                                (CompareElementCallback)(void*)pq_test_compare_job, &live);
+    TEST_OBJECT(pq);
+
+    Uint64 state = 0x2545f4914f6cdd1dull;
+    for(Uint64 i = 0; i < PQ_TEST_ELEMS; i++) {
+        PqTestJob job = {.priority = (Int64)(pq_test_next(&state) % 100), .id = i};
+        priority_queue_push(pq, &job);
+    }
+    TEST_LENGTH_EQ(live, PQ_TEST_ELEMS);
+
+    /* popped copies move to caller, dropped ones are destroyed by queue */
+    Int64 prev = INT64_MAX;
+    for(Size i = 0; i < PQ_TEST_ELEMS / 2; i++) {
+        PqTestJob job;
+        TEST_EQUALITY(((PqTestJob*)priority_queue_peek(pq))->priority <= prev);
+        TEST_EQUALITY(priority_queue_pop(pq, &job) && job.priority <= prev);
+        prev = job.priority;
+        pq_test_destroy_copy(&job, &live);
+    }
+    TEST_LENGTH_EQ(live, PQ_TEST_ELEMS / 2);
+    TEST_EQUALITY(priority_queue_pop(pq, NULL));
+    TEST_LENGTH_EQ(live, PQ_TEST_ELEMS / 2 - 1);
+
+    PqTestJob top = {.priority = 1000, .id = 0};
+    TEST_EQUALITY(priority_queue_replace_top(pq, &top, NULL));
+    TEST_LENGTH_EQ(live, PQ_TEST_ELEMS / 2 - 1);
+    TEST_EQUALITY(((PqTestJob*)priority_queue_peek(pq))->priority == 1000);
+
+    priority_queue_destroy(pq);
+    pq = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(pq) priority_queue_destroy(pq);
+    );
+}
+
+BEGIN_TESTS(priority_queue)
+    TEST(Pop_WHEN_NUMERIC_QUEUE_THEN_SORTED_BOTH_WAYS),
+    TEST(Pop_WHEN_FLOAT_QUEUE_THEN_NEGATIVES_FIRST),
+    TEST(ReplaceTop_WHEN_BOUNDED_THEN_KEEP_TOP_K),
+    TEST(Heapify_WHEN_CREATED_FROM_VECTOR_THEN_POP_SORTED),
+    TEST(Pop_WHEN_STRUCT_QUEUE_THEN_CALLER_OWNS_COPY)
+END_TESTS()
@@ -0,0 +1,362 @@
+/**
+ * @file queue.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for SpscQueue and MpmcQueue, with single and batch
+ * pushes and pops wrapping around small rings, and elements handed between
+ * racing producers and consumers.
+ * */
+
+#include <Anvie/Containers/Queue.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <sched.h>
+
+#include "TestThreads.h"
+
+/* largest batch pushed or popped at once */
+#define QUEUE_TEST_BATCH 13
+
+#define QUEUE_TEST_SPSC_COUNT 200000
+#define QUEUE_TEST_PRODUCERS  4
+#define QUEUE_TEST_CONSUMERS  4
+#define QUEUE_TEST_PER_PRODUCER 50000
+
+/* 12 bytes, so elements are copied by generic path and MPMC cells need padding */
+typedef struct QueueTestItem {
+    Uint32 seq;
+    Uint32 check;
+    Uint32 pad;
+} QueueTestItem;
+
+static QueueTestItem queue_test_item(Uint32 seq) {
+    return (QueueTestItem) {seq, seq * 2654435761u ^ 0x5bd1e995u, ~seq};
+}
+
+static Bool queue_test_item_is(const QueueTestItem* item, Uint32 seq) {
+    QueueTestItem expected = queue_test_item(seq);
+    return !memcmp(item, &expected, sizeof(QueueTestItem));
+}
+
+/* tests below run same steps on both kinds of queue */
+static void* queue_test_create(Bool mpmc, Size element_size, Size capacity) {
+    return mpmc ? (void*)mpmc_queue_create(element_size, capacity) : (void*)spsc_queue_create(element_size, capacity);
+}
+
+static void queue_test_destroy(Bool mpmc, void* q) {
+    if(mpmc) {
+        mpmc_queue_destroy(q);
+    } else {
+        spsc_queue_destroy(q);
+    }
+}
+
+static Size queue_test_capacity(Bool mpmc, void* q) {
+    return mpmc ? mpmc_queue_capacity((MpmcQueue*)q) : spsc_queue_capacity((SpscQueue*)q);
+}
+
+static Size queue_test_length(Bool mpmc, void* q) {
+    return mpmc ? mpmc_queue_length(q) : spsc_queue_length(q);
+}
+
+static Bool queue_test_push(Bool mpmc, void* q, const void* element) {
+    return mpmc ? mpmc_queue_push(q, element) : spsc_queue_push(q, element);
+}
+
+static Bool queue_test_pop(Bool mpmc, void* q, void* element) {
+    return mpmc ? mpmc_queue_pop(q, element) : spsc_queue_pop(q, element);
+}
+
+static Size queue_test_push_batch(Bool mpmc, void* q, const void* elements, Size count) {
+    return mpmc ? mpmc_queue_push_batch(q, elements, count) : spsc_queue_push_batch(q, elements, count);
+}
+
+static Size queue_test_pop_batch(Bool mpmc, void* q, void* elements, Size count) {
+    return mpmc ? mpmc_queue_pop_batch(q, elements, count) : spsc_queue_pop_batch(q, elements, count);
+}
+
+/*
+ * Fill queue until a push fails, then pop a varying number of elements,
+ * many times over, so positions wrap around ring again and again.
+ * @return Number of mismatches found.
+ * */
+static Size queue_test_wrap_single(Bool mpmc, void* q) {
+    Size          errors = 0, capacity = queue_test_capacity(mpmc, q);
+    Uint32        next_push = 0, next_pop = 0;
+    QueueTestItem item;
+
+    for(Size round = 0; round < 100 * capacity + 7; round++) {
+        for(;;) {
+            item = queue_test_item(next_push);
+            if(!queue_test_push(mpmc, q, &item)) {
+                break;
+            }
+            next_push++;
+        }
+        errors += next_push - next_pop != capacity;
+        errors += queue_test_length(mpmc, q) != capacity;
+
+        for(Size n = round % capacity + 1; n; n--) {
+            errors += !queue_test_pop(mpmc, q, &item) || !queue_test_item_is(&item, next_pop++);
+        }
+        errors += queue_test_length(mpmc, q) != next_push - next_pop;
+    }
+
+    while(queue_test_pop(mpmc, q, &item)) {
+        errors += !queue_test_item_is(&item, next_pop++);
+    }
+    errors += next_pop != next_push || queue_test_length(mpmc, q);
+    return errors;
+}
+
+/*
+ * Push and pop batches of sizes that don't divide capacity, and are often
+ * larger than free space or length, so batches straddle end of ring and
+ * come back short.
+ * @return Number of mismatches found.
+ * */
+static Size queue_test_wrap_batch(Bool mpmc, void* q) {
+    Size          errors = 0, capacity = queue_test_capacity(mpmc, q);
+    Uint32        next_push = 0, next_pop = 0;
+    QueueTestItem items[QUEUE_TEST_BATCH];
+
+    errors += queue_test_push_batch(mpmc, q, items, 0) || queue_test_pop_batch(mpmc, q, items, 0);
+
+    for(Size round = 0; round < 1000; round++) {
+        Size n = round * 5 % QUEUE_TEST_BATCH + 1;
+        for(Size i = 0; i < n; i++) {
+            items[i] = queue_test_item(next_push + i);
+        }
+        Size pushed = queue_test_push_batch(mpmc, q, items, n);
+        errors     += pushed != MIN(n, capacity - (next_push - next_pop));
+        next_push  += pushed;
+
+        Size m      = round * 3 % QUEUE_TEST_BATCH + 1;
+        Size popped = queue_test_pop_batch(mpmc, q, items, m);
+        errors     += popped != MIN(m, (Size)(next_push - next_pop));
+        for(Size i = 0; i < popped; i++) {
+            errors += !queue_test_item_is(items + i, next_pop++);
+        }
+    }
+
+    while(next_pop != next_push) {
+        Size popped = queue_test_pop_batch(mpmc, q, items, QUEUE_TEST_BATCH);
+        errors     += !popped;
+        for(Size i = 0; i < popped; i++) {
+            errors += !queue_test_item_is(items + i, next_pop++);
+        }
+        if(!popped) {
+            break;
+        }
+    }
+    errors += queue_test_length(mpmc, q) != 0;
+    return errors;
+}
+
+TEST_FN Bool PushPop_WHEN_CAPACITY_IS_SMALL_THEN_WRAP_AROUND() {
+    /* capacities are rounded up to a power of two, and MPMC has at least two slots */
+    static const Size capacities[]  = {1, 2, 3, 5, 8};
+    static const Size rounded[2][5] = {{1, 2, 4, 8, 8}, {2, 2, 4, 8, 8}};
+    void*             q             = NULL;
+    Bool              mpmc          = False;
+
+    for(; mpmc <= True; mpmc++) {
+        for(Size c = 0; c < ARRAY_SIZE(capacities); c++) {
+            q = queue_test_create(mpmc, sizeof(QueueTestItem), capacities[c]);
+            TEST_EQUALITY(q);
+            TEST_LENGTH_EQ(queue_test_capacity(mpmc, q), rounded[mpmc ? 1 : 0][c]);
+
+            QueueTestItem item;
+            TEST_EQUALITY(!queue_test_pop(mpmc, q, &item));
+            TEST_LENGTH_EQ(queue_test_wrap_single(mpmc, q), 0);
+            TEST_LENGTH_EQ(queue_test_wrap_batch(mpmc, q), 0);
+
+            queue_test_destroy(mpmc, q);
+            q = NULL;
+        }
+    }
+
+    DO_BEFORE_EXIT(
+        if(q) queue_test_destroy(mpmc, q);
+    );
+}
+
+typedef struct QueueTestShared {
+    void*  q;
+    Bool   mpmc;
+    Size   popped;    /**< elements popped by all consumers, MPMC only */
+    Uint8* seen;      /**< times each element was popped, MPMC only */
+} QueueTestShared;
+
+typedef struct QueueTestArg {
+    QueueTestShared* shared;
+    Size             id;
+    Size             errors;
+    Uint64           sum; /**< sum of elements popped by this consumer */
+} QueueTestArg;
+
+/*
+ * Push elements @p first, @p first + 1, ... @p first + @p count - 1, in
+ * order, alternating single pushes with batches of varying size, and
+ * yielding while queue is full.
+ * */
+static void queue_test_produce(QueueTestShared* shared, Uint64 first, Size count) {
+    Uint64 batch[QUEUE_TEST_BATCH];
+    Size   done = 0;
+
+    for(Size round = 0; done < count; round++) {
+        Size n = MIN(round % QUEUE_TEST_BATCH + 1, count - done);
+        for(Size i = 0; i < n; i++) {
+            batch[i] = first + done + i;
+        }
+
+        Size pushed = round & 1 ? queue_test_push_batch(shared->mpmc, shared->q, batch, n)
+                                : (Size)queue_test_push(shared->mpmc, shared->q, batch);
+        if(!pushed) {
+            sched_yield();
+        }
+        done += pushed;
+    }
+}
+
+/* pop into @p out, alternating single pops with batches, @return number of elements popped */
+static Size queue_test_consume(QueueTestShared* shared, Size round, Uint64* out) {
+    Size popped = round & 1 ? queue_test_pop_batch(shared->mpmc, shared->q, out, round % QUEUE_TEST_BATCH + 1)
+                            : (Size)queue_test_pop(shared->mpmc, shared->q, out);
+    if(!popped) {
+        sched_yield();
+    }
+    return popped;
+}
+
+/* thread 0 produces 0, 1, 2 ... and thread 1 checks that it pops them in same order */
+static void* queue_test_spsc_worker(void* arg) {
+    QueueTestArg*    a      = arg;
+    QueueTestShared* shared = a->shared;
+
+    if(!a->id) {
+        queue_test_produce(shared, 0, QUEUE_TEST_SPSC_COUNT);
+        return NULL;
+    }
+
+    Uint64 batch[QUEUE_TEST_BATCH];
+    Uint64 next = 0;
+    for(Size round = 0; next < QUEUE_TEST_SPSC_COUNT; round++) {
+        Size popped = queue_test_consume(shared, round, batch);
+        for(Size i = 0; i < popped; i++) {
+            a->errors += batch[i] != next++;
+            a->sum    += batch[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * First QUEUE_TEST_PRODUCERS threads push their id in upper half and a
+ * sequence number in lower half of each element. Rest pop until all were
+ * popped, checking that elements of any one producer come out in order.
+ * */
+static void* queue_test_mpmc_worker(void* arg) {
+    QueueTestArg*    a      = arg;
+    QueueTestShared* shared = a->shared;
+    Size             total  = QUEUE_TEST_PRODUCERS * QUEUE_TEST_PER_PRODUCER;
+
+    if(a->id < QUEUE_TEST_PRODUCERS) {
+        queue_test_produce(shared, (Uint64)a->id << 32, QUEUE_TEST_PER_PRODUCER);
+        return NULL;
+    }
+
+    Uint64 batch[QUEUE_TEST_BATCH];
+    Uint64 next[QUEUE_TEST_PRODUCERS] = {0}; /* smallest sequence number this consumer can see next, per producer */
+    for(Size round = 0; __atomic_load_n(&shared->popped, __ATOMIC_RELAXED) < total; round++) {
+        Size popped = queue_test_consume(shared, round, batch);
+        for(Size i = 0; i < popped; i++) {
+            Size   producer = batch[i] >> 32;
+            Uint64 seq      = batch[i] & 0xffffffff;
+            if(producer >= QUEUE_TEST_PRODUCERS || seq >= QUEUE_TEST_PER_PRODUCER || seq < next[producer]) {
+                a->errors++;
+                continue;
+            }
+            next[producer] = seq + 1;
+            a->sum        += batch[i];
+            __atomic_fetch_add(shared->seen + producer * QUEUE_TEST_PER_PRODUCER + seq, 1, __ATOMIC_RELAXED);
+        }
+        __atomic_fetch_add(&shared->popped, popped, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+TEST_FN Bool SpscTransfer_WHEN_PRODUCER_AND_CONSUMER_RACE() {
+    QueueTestShared shared = {.q = spsc_queue_create(sizeof(Uint64), 16), .mpmc = False};
+    QueueTestArg    args[2];
+    TEST_OBJECT(shared.q);
+
+    for(Size t = 0; t < 2; t++) {
+        args[t] = (QueueTestArg) {&shared, t, 0, 0};
+    }
+    TEST_EQUALITY(test_run_threads(2, queue_test_spsc_worker, args, sizeof(QueueTestArg)));
+
+    TEST_LENGTH_EQ(args[1].errors, 0);
+    TEST_EQUALITY(args[1].sum == (Uint64)QUEUE_TEST_SPSC_COUNT * (QUEUE_TEST_SPSC_COUNT - 1) / 2);
+    TEST_LENGTH_EQ(spsc_queue_length(shared.q), 0);
+
+    DO_BEFORE_EXIT(
+        spsc_queue_destroy(shared.q);
+    );
+}
+
+TEST_FN Bool MpmcTransfer_WHEN_MANY_PRODUCERS_AND_CONSUMERS_RACE() {
+    Size            threads = QUEUE_TEST_PRODUCERS + QUEUE_TEST_CONSUMERS;
+    Size            total   = QUEUE_TEST_PRODUCERS * QUEUE_TEST_PER_PRODUCER;
+    QueueTestShared shared  = {.q = mpmc_queue_create(sizeof(Uint64), 32), .mpmc = True};
+    QueueTestArg    args[QUEUE_TEST_PRODUCERS + QUEUE_TEST_CONSUMERS];
+    TEST_OBJECT(shared.q);
+    shared.seen = ALLOCATE(Uint8, total);
+    TEST_EQUALITY(shared.seen);
+
+    for(Size t = 0; t < threads; t++) {
+        args[t] = (QueueTestArg) {&shared, t, 0, 0};
+    }
+    TEST_EQUALITY(test_run_threads(threads, queue_test_mpmc_worker, args, sizeof(QueueTestArg)));
+
+    Uint64 sum = 0, expected = 0;
+    for(Size t = QUEUE_TEST_PRODUCERS; t < threads; t++) {
+        TEST_LENGTH_EQ(args[t].errors, 0);
+        sum += args[t].sum;
+    }
+    for(Uint64 p = 0; p < QUEUE_TEST_PRODUCERS; p++) {
+        expected += (p << 32) * QUEUE_TEST_PER_PRODUCER + (Uint64)QUEUE_TEST_PER_PRODUCER * (QUEUE_TEST_PER_PRODUCER - 1) / 2;
+    }
+    TEST_EQUALITY(sum == expected);
+    TEST_LENGTH_EQ(shared.popped, total);
+    for(Size i = 0; i < total; i++) {
+        TEST_LENGTH_EQ(shared.seen[i], 1);
+    }
+    TEST_LENGTH_EQ(mpmc_queue_length(shared.q), 0);
+
+    DO_BEFORE_EXIT(
+        mpmc_queue_destroy(shared.q);
+        FREE(shared.seen);
+    );
+}
+
+BEGIN_TESTS(queue)
+    TEST(PushPop_WHEN_CAPACITY_IS_SMALL_THEN_WRAP_AROUND),
+    TEST(SpscTransfer_WHEN_PRODUCER_AND_CONSUMER_RACE),
+    TEST(MpmcTransfer_WHEN_MANY_PRODUCERS_AND_CONSUMERS_RACE)
+END_TESTS()
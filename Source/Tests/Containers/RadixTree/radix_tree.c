@@ -0,0 +1,226 @@
+/**
+ * @file radix_tree.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for RadixTree, growing and shrinking nodes, ordered and
+ * prefix iteration, and longest prefix matches.
+ * */
+
+#include <Anvie/Containers/RadixTree.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#define RTREE_TEST_KEYS 5000
+
+/* data too large to be stored in leaf, copies are counted in Size passed as udata */
+typedef struct RtreeTestData {
+    Uint64 value;
+    Uint64 pad;
+} RtreeTestData;
+
+static void rtree_test_create_copy(RtreeTestData* dst, RtreeTestData* src, Size* live) {
+    *dst = *src;
+    (*live)++;
+}
+
+static void rtree_test_destroy_copy(RtreeTestData* copy, Size* live) {
+    UNUSED(copy);
+    (*live)--;
+}
+
+/* key of longest prefix match of given string, or NULL if none */
+static ZString rtree_test_longest(RadixTree* tree, ZString key) {
+    RadixTreeLeaf* leaf = radix_tree_longest_prefix(tree, key, strlen(key));
+    return leaf ? (ZString)leaf->key : NULL;
+}
+
+/* whether longest prefix match of @p key is @p expected */
+static Bool rtree_test_longest_is(RadixTree* tree, ZString key, ZString expected) {
+    ZString found = rtree_test_longest(tree, key);
+    return expected ? found && !strcmp(found, expected) : !found;
+}
+
+TEST_FN Bool Insert_WHEN_NODES_GROW_AND_SHRINK_THEN_FIND_KEYS() {
+    RadixTree* tree = radix_tree_create(sizeof(Uint64), NULL, NULL);
+    TEST_OBJECT(tree);
+
+    /* keys spread over every value of a byte grow a node through all of it's layouts */
+    Uint8 key[8];
+    for(Uint64 k = 0; k < RTREE_TEST_KEYS; k++) {
+        radix_tree_encode_u64(k * 0x01000193ull, key);
+        TEST_EQUALITY(radix_tree_insert(tree, key, sizeof(key), (void*)k, NULL) != NULL);
+    }
+    TEST_LENGTH_EQ(radix_tree_count(tree), RTREE_TEST_KEYS);
+    for(Uint64 k = 0; k < RTREE_TEST_KEYS; k++) {
+        radix_tree_encode_u64(k * 0x01000193ull, key);
+        RadixTreeLeaf* leaf = radix_tree_search(tree, key, sizeof(key));
+        TEST_EQUALITY(leaf && (Uint64)leaf->data == k && leaf->key_length == sizeof(key));
+    }
+    radix_tree_encode_u64(3, key);
+    TEST_EQUALITY(!radix_tree_search(tree, key, sizeof(key)));
+
+    /* deleting shrinks nodes back, remaining keys must stay reachable */
+    for(Uint64 k = 0; k < RTREE_TEST_KEYS; k++) {
+        radix_tree_encode_u64(k * 0x01000193ull, key);
+        if(k % 7) {
+            TEST_EQUALITY(radix_tree_delete(tree, key, sizeof(key), NULL));
+        }
+    }
+    TEST_EQUALITY(!radix_tree_delete(tree, key, sizeof(key), NULL));
+    TEST_LENGTH_EQ(radix_tree_count(tree), (RTREE_TEST_KEYS + 6) / 7);
+
+    /* big endian keys iterate in numeric order */
+    RadixTreeIterator iter = radix_tree_iter(tree);
+    Uint64            next = 0;
+    for(RadixTreeLeaf* leaf = radix_tree_iter_next(&iter); leaf; leaf = radix_tree_iter_next(&iter), next += 7) {
+        if(radix_tree_decode_u64(leaf->key) != next * 0x01000193ull || (Uint64)leaf->data != next) {
+            break;
+        }
+    }
+    radix_tree_iter_destroy(&iter);
+    TEST_EQUALITY(next == (RTREE_TEST_KEYS + 6) / 7 * 7);
+    TEST_EQUALITY((Uint64)radix_tree_minimum(tree)->data == 0);
+    TEST_EQUALITY((Uint64)radix_tree_maximum(tree)->data == (RTREE_TEST_KEYS - 1) / 7 * 7);
+
+    DO_BEFORE_EXIT(
+        if(tree) radix_tree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool LongestPrefix_WHEN_KEYS_NEST_THEN_PICK_LONGEST() {
+    RadixTree* tree = radix_tree_create(sizeof(Uint64), NULL, NULL);
+    TEST_OBJECT(tree);
+
+    ZString routes[] = {"/", "/api", "/api/v1", "/api/v1/users", "/static"};
+    for(Size r = 0; r < ARRAY_SIZE(routes); r++) {
+        TEST_EQUALITY(radix_tree_insert_zstr(tree, routes[r], (void*)r, NULL) != NULL);
+    }
+
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/api/v1/users/42", "/api/v1/users"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/api/v1/users", "/api/v1/users"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/api/v1/user", "/api/v1"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/api/v2", "/api"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/apix", "/api"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/ap", "/"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/static/app.js", "/static"));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "api", NULL));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "", NULL));
+
+    /* a deleted key no longer matches, next shorter one does */
+    TEST_EQUALITY(radix_tree_delete_zstr(tree, "/api/v1/users", NULL));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/api/v1/users/42", "/api/v1"));
+    TEST_EQUALITY(radix_tree_delete_zstr(tree, "/", NULL));
+    TEST_EQUALITY(rtree_test_longest_is(tree, "/ap", NULL));
+
+    /* a match can end inside a long compressed path of another key */
+    Char long_key[64];
+    memset(long_key, 'a', sizeof(long_key) - 1);
+    long_key[sizeof(long_key) - 1] = 0;
+    TEST_EQUALITY(radix_tree_insert_zstr(tree, long_key, (void*)100, NULL) != NULL);
+    long_key[20] = 0;
+    TEST_EQUALITY(radix_tree_insert_zstr(tree, long_key, (void*)20, NULL) != NULL);
+    long_key[20] = 'a';
+    long_key[40] = 'b';
+    RadixTreeLeaf* leaf = radix_tree_longest_prefix(tree, long_key, strlen(long_key));
+    TEST_EQUALITY(leaf && (Uint64)leaf->data == 20 && leaf->key_length == 20);
+
+    DO_BEFORE_EXIT(
+        if(tree) radix_tree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool IterPrefix_WHEN_PREFIX_GIVEN_THEN_VISIT_KEYS_UNDER_IT() {
+    RadixTree*        tree = radix_tree_create(sizeof(Uint64), NULL, NULL);
+    RadixTreeIterator iter = {0};
+    TEST_OBJECT(tree);
+
+    ZString keys[] = {"car", "card", "care", "cart", "carton", "cat", "ca", "dog"};
+    for(Size k = 0; k < ARRAY_SIZE(keys); k++) {
+        TEST_EQUALITY(radix_tree_insert_zstr(tree, keys[k], (void*)k, NULL) != NULL);
+    }
+
+    /* a key that's prefix of others comes before them, and keys are null terminated */
+    ZString expected[] = {"car", "card", "care", "cart", "carton"};
+    Size    count      = 0;
+    iter = radix_tree_iter_prefix(tree, "car", 3);
+    for(RadixTreeLeaf* leaf = radix_tree_iter_next(&iter); leaf; leaf = radix_tree_iter_next(&iter)) {
+        TEST_EQUALITY(count < ARRAY_SIZE(expected) && !strcmp((ZString)leaf->key, expected[count]));
+        count++;
+    }
+    TEST_LENGTH_EQ(count, ARRAY_SIZE(expected));
+    radix_tree_iter_destroy(&iter);
+
+    /* prefix ending inside a compressed path, and prefix matching nothing */
+    count = 0;
+    iter  = radix_tree_iter_prefix(tree, "cart", 4);
+    while(radix_tree_iter_next(&iter)) count++;
+    TEST_LENGTH_EQ(count, 2);
+    radix_tree_iter_destroy(&iter);
+
+    iter = radix_tree_iter_prefix(tree, "cb", 2);
+    TEST_EQUALITY(!radix_tree_iter_next(&iter));
+
+    DO_BEFORE_EXIT(
+        radix_tree_iter_destroy(&iter);
+        if(tree) radix_tree_destroy(tree, NULL);
+    );
+}
+
+TEST_FN Bool Data_WHEN_LARGER_THAN_POINTER_THEN_COPY_ONCE() {
+    Size       live = 0;
+    RadixTree* tree = radix_tree_create(sizeof(RtreeTestData), (CreateElementCopyCallback)(void*)rtree_test_create_copy,
+                                        (DestroyElementCopyCallback)(void*)rtree_test_destroy_copy);
+    TEST_OBJECT(tree);
+
+    RtreeTestData data = {0};
+    Uint8         key[8];
+    for(Uint64 k = 0; k < RTREE_TEST_KEYS; k++) {
+        data.value = k;
+        radix_tree_encode_i64((Int64)k - RTREE_TEST_KEYS / 2, key);
+        TEST_EQUALITY(radix_tree_insert(tree, key, sizeof(key), &data, &live) != NULL);
+    }
+    TEST_LENGTH_EQ(live, RTREE_TEST_KEYS);
+
+    /* replacing data of an existing key destroys old copy */
+    data.value = 42;
+    radix_tree_encode_i64(0, key);
+    RadixTreeLeaf* leaf = radix_tree_insert(tree, key, sizeof(key), &data, &live);
+    TEST_EQUALITY(leaf && ((RtreeTestData*)leaf->data)->value == 42);
+    TEST_LENGTH_EQ(live, RTREE_TEST_KEYS);
+
+    /* negative keys come first */
+    TEST_EQUALITY(radix_tree_decode_i64(radix_tree_minimum(tree)->key) == -RTREE_TEST_KEYS / 2);
+
+    TEST_EQUALITY(radix_tree_delete(tree, key, sizeof(key), &live));
+    TEST_LENGTH_EQ(live, RTREE_TEST_KEYS - 1);
+
+    radix_tree_destroy(tree, &live);
+    tree = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(tree) radix_tree_destroy(tree, &live);
+    );
+}
+
+BEGIN_TESTS(radix_tree)
+    TEST(Insert_WHEN_NODES_GROW_AND_SHRINK_THEN_FIND_KEYS),
+    TEST(LongestPrefix_WHEN_KEYS_NEST_THEN_PICK_LONGEST),
+    TEST(IterPrefix_WHEN_PREFIX_GIVEN_THEN_VISIT_KEYS_UNDER_IT),
+    TEST(Data_WHEN_LARGER_THAN_POINTER_THEN_COPY_ONCE)
+END_TESTS()
@@ -0,0 +1,271 @@
+/**
+ * @file roaring.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for RoaringBitmap, converting between container forms, set
+ * operations over every mix of forms, and serialization round trips.
+ * */
+
+#include <Anvie/Containers/RoaringBitmap.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+/* values of test bitmaps lie in first few chunks, and are mirrored in a byte per value */
+#define ROAR_TEST_CHUNKS 4
+#define ROAR_TEST_DOMAIN (ROAR_TEST_CHUNKS * ROARING_CHUNK_SIZE)
+
+typedef struct RoarTestCheck {
+    const Uint8* expected;
+    Size         count;
+    Size         errors;
+    Uint64       last;
+} RoarTestCheck;
+
+static void roar_test_visit(Uint32 value, void* udata) {
+    RoarTestCheck* check = udata;
+    check->errors += value >= ROAR_TEST_DOMAIN || !check->expected[value] || (check->count && value <= check->last);
+    check->last = value;
+    check->count++;
+}
+
+/* bitmap holds exactly values marked in @p expected, visited in increasing order */
+static Bool roar_test_matches(RoaringBitmap* rb, const Uint8* expected) {
+    if(!rb) {
+        return False;
+    }
+
+    RoarTestCheck check = {expected, 0, 0, 0};
+    roaring_foreach(rb, roar_test_visit, &check);
+
+    Size count = 0;
+    for(Size v = 0; v < ROAR_TEST_DOMAIN; v++) {
+        count += expected[v];
+    }
+    return !check.errors && check.count == count && roaring_cardinality(rb) == count;
+}
+
+static void roar_test_add_range(RoaringBitmap* rb, Uint8* ref, Uint32 begin, Uint32 end) {
+    roaring_add_range(rb, begin, end);
+    memset(ref + begin, 1, end - begin);
+}
+
+/* type of container holding given chunk, or -1 if there's none */
+static Int32 roar_test_type(RoaringBitmap* rb, Uint16 key) {
+    for(Size c = 0; c < rb->count; c++) {
+        if(rb->containers[c].key == key) {
+            return rb->containers[c].type;
+        }
+    }
+    return -1;
+}
+
+/*
+ * First bitmap has an array, a bitmap and a run container, second one has
+ * a bitmap, an array, an overlapping run and a chunk of it's own, so set
+ * operations meet every pair of forms.
+ */
+static void roar_test_fill(RoaringBitmap* a, Uint8* ref_a, RoaringBitmap* b, Uint8* ref_b) {
+    for(Uint32 v = 0; v < ROARING_CHUNK_SIZE; v += 37) {
+        roaring_add(a, v);
+        ref_a[v] = 1;
+    }
+    for(Uint32 v = ROARING_CHUNK_SIZE; v < 2 * ROARING_CHUNK_SIZE; v += 3) {
+        roaring_add(a, v);
+        ref_a[v] = 1;
+    }
+    roar_test_add_range(a, ref_a, 2 * ROARING_CHUNK_SIZE + 100, 2 * ROARING_CHUNK_SIZE + 40000);
+
+    for(Uint32 v = 0; v < ROARING_CHUNK_SIZE; v += 2) {
+        roaring_add(b, v);
+        ref_b[v] = 1;
+    }
+    for(Uint32 v = ROARING_CHUNK_SIZE; v < 2 * ROARING_CHUNK_SIZE; v += 50) {
+        roaring_add(b, v);
+        ref_b[v] = 1;
+    }
+    roar_test_add_range(b, ref_b, 2 * ROARING_CHUNK_SIZE + 30000, 2 * ROARING_CHUNK_SIZE + 60000);
+    for(Uint32 v = 3 * ROARING_CHUNK_SIZE; v < 3 * ROARING_CHUNK_SIZE + 1000; v += 10) {
+        roaring_add(b, v);
+        ref_b[v] = 1;
+    }
+}
+
+TEST_FN Bool Add_WHEN_CONTAINER_FILLS_UP_THEN_CONVERT_FORMS() {
+    RoaringBitmap* rb  = roaring_create();
+    Uint8*         ref = ALLOCATE(Uint8, ROAR_TEST_DOMAIN);
+    TEST_EQUALITY(rb && ref);
+
+    /* an array holds upto ROARING_ARRAY_MAX_SIZE values */
+    for(Uint32 v = 0; v < ROARING_ARRAY_MAX_SIZE; v++) {
+        TEST_EQUALITY(roaring_add(rb, v * 7));
+        ref[v * 7] = 1;
+    }
+    TEST_EQUALITY(!roaring_add(rb, 0));
+    TEST_EQUALITY(roar_test_type(rb, 0) == ROARING_CONTAINER_ARRAY);
+
+    TEST_EQUALITY(roaring_add(rb, 1));
+    ref[1] = 1;
+    TEST_EQUALITY(roar_test_type(rb, 0) == ROARING_CONTAINER_BITMAP);
+    TEST_EQUALITY(roar_test_matches(rb, ref));
+
+    /* and back */
+    TEST_EQUALITY(roaring_remove(rb, 1));
+    TEST_EQUALITY(!roaring_remove(rb, 1));
+    ref[1] = 0;
+    TEST_EQUALITY(roar_test_type(rb, 0) == ROARING_CONTAINER_ARRAY);
+    TEST_EQUALITY(roar_test_matches(rb, ref));
+
+    /* a range is stored as a run, and single changes turn it back into an array or bitmap */
+    roar_test_add_range(rb, ref, ROARING_CHUNK_SIZE, 2 * ROARING_CHUNK_SIZE);
+    TEST_EQUALITY(roar_test_type(rb, 1) == ROARING_CONTAINER_RUN);
+    TEST_EQUALITY(roaring_remove(rb, ROARING_CHUNK_SIZE + 5));
+    ref[ROARING_CHUNK_SIZE + 5] = 0;
+    TEST_EQUALITY(roar_test_type(rb, 1) == ROARING_CONTAINER_BITMAP);
+    TEST_EQUALITY(roaring_contains(rb, ROARING_CHUNK_SIZE + 4) && !roaring_contains(rb, ROARING_CHUNK_SIZE + 5));
+    TEST_EQUALITY(roar_test_matches(rb, ref));
+
+    /* clustered values compress into runs without changing contents */
+    roaring_run_optimize(rb);
+    TEST_EQUALITY(roar_test_type(rb, 1) == ROARING_CONTAINER_RUN);
+    TEST_EQUALITY(roar_test_matches(rb, ref));
+
+    /* emptying a chunk removes it's container */
+    for(Uint32 v = 0; v < ROARING_ARRAY_MAX_SIZE; v++) {
+        TEST_EQUALITY(roaring_remove(rb, v * 7));
+        ref[v * 7] = 0;
+    }
+    TEST_EQUALITY(roar_test_type(rb, 0) == -1);
+    TEST_EQUALITY(roar_test_matches(rb, ref));
+
+    DO_BEFORE_EXIT(
+        if(rb) roaring_destroy(rb);
+        FREE(ref);
+    );
+}
+
+TEST_FN Bool SetOps_WHEN_CONTAINER_FORMS_MIX_THEN_MATCH_REFERENCE() {
+    RoaringBitmap* a        = roaring_create();
+    RoaringBitmap* b        = roaring_create();
+    RoaringBitmap* result   = NULL;
+    Uint8*         ref_a    = ALLOCATE(Uint8, ROAR_TEST_DOMAIN);
+    Uint8*         ref_b    = ALLOCATE(Uint8, ROAR_TEST_DOMAIN);
+    Uint8*         expected = ALLOCATE(Uint8, ROAR_TEST_DOMAIN);
+    TEST_EQUALITY(a && b && ref_a && ref_b && expected);
+
+    roar_test_fill(a, ref_a, b, ref_b);
+    TEST_EQUALITY(roar_test_type(a, 0) == ROARING_CONTAINER_ARRAY && roar_test_type(b, 0) == ROARING_CONTAINER_BITMAP);
+    TEST_EQUALITY(roar_test_type(a, 1) == ROARING_CONTAINER_BITMAP && roar_test_type(b, 1) == ROARING_CONTAINER_ARRAY);
+    TEST_EQUALITY(roar_test_type(a, 2) == ROARING_CONTAINER_RUN && roar_test_type(b, 2) == ROARING_CONTAINER_RUN);
+
+    for(Size v = 0; v < ROAR_TEST_DOMAIN; v++) expected[v] = ref_a[v] & ref_b[v];
+    result = roaring_and(a, b);
+    TEST_EQUALITY(roar_test_matches(result, expected));
+    roaring_destroy(result);
+
+    for(Size v = 0; v < ROAR_TEST_DOMAIN; v++) expected[v] = ref_a[v] | ref_b[v];
+    result = roaring_or(a, b);
+    TEST_EQUALITY(roar_test_matches(result, expected));
+    roaring_destroy(result);
+
+    for(Size v = 0; v < ROAR_TEST_DOMAIN; v++) expected[v] = ref_a[v] ^ ref_b[v];
+    result = roaring_xor(a, b);
+    TEST_EQUALITY(roar_test_matches(result, expected));
+    roaring_destroy(result);
+
+    for(Size v = 0; v < ROAR_TEST_DOMAIN; v++) expected[v] = ref_a[v] & !ref_b[v];
+    result = roaring_andnot(a, b);
+    TEST_EQUALITY(roar_test_matches(result, expected));
+    roaring_destroy(result);
+
+    for(Size v = 0; v < ROAR_TEST_DOMAIN; v++) expected[v] = ref_b[v] & !ref_a[v];
+    result = roaring_andnot(b, a);
+    TEST_EQUALITY(roar_test_matches(result, expected));
+
+    /* a bitmap xor itself is empty, and or with itself is same */
+    TEST_EQUALITY(!roaring_cmpeq(a, b));
+    roaring_destroy(result);
+    result = roaring_xor(a, a);
+    TEST_EQUALITY(result && roaring_is_empty(result));
+    roaring_destroy(result);
+    result = roaring_or(a, a);
+    TEST_EQUALITY(result && roaring_cmpeq(result, a));
+
+    DO_BEFORE_EXIT(
+        if(result) roaring_destroy(result);
+        if(a) roaring_destroy(a);
+        if(b) roaring_destroy(b);
+        FREE(ref_a);
+        FREE(ref_b);
+        FREE(expected);
+    );
+}
+
+TEST_FN Bool Serialize_WHEN_ROUND_TRIPPED_THEN_KEEP_VALUES_AND_FORMS() {
+    RoaringBitmap* a      = roaring_create();
+    RoaringBitmap* b      = roaring_create();
+    RoaringBitmap* loaded = NULL;
+    Uint8*         ref_a  = ALLOCATE(Uint8, ROAR_TEST_DOMAIN);
+    Uint8*         ref_b  = ALLOCATE(Uint8, ROAR_TEST_DOMAIN);
+    void*          buffer = NULL;
+    TEST_EQUALITY(a && b && ref_a && ref_b);
+
+    roar_test_fill(a, ref_a, b, ref_b);
+    roaring_add(a, UINT32_MAX);
+
+    Size size = roaring_serialized_size(a);
+    buffer    = malloc(size);
+    TEST_EQUALITY(buffer != NULL);
+    TEST_LENGTH_EQ(roaring_serialize(a, buffer, size - 1), 0);
+    TEST_LENGTH_EQ(roaring_serialize(a, buffer, size), size);
+
+    loaded = roaring_deserialize(buffer, size);
+    TEST_EQUALITY(loaded && roaring_cmpeq(loaded, a));
+    TEST_EQUALITY(roaring_contains(loaded, UINT32_MAX) && roaring_cardinality(loaded) == roaring_cardinality(a));
+    for(Uint16 key = 0; key < ROAR_TEST_CHUNKS; key++) {
+        TEST_EQUALITY(roar_test_type(loaded, key) == roar_test_type(a, key));
+    }
+
+    /* a truncated buffer is rejected */
+    roaring_destroy(loaded);
+    loaded = roaring_deserialize(buffer, size - 1);
+    TEST_EQUALITY(!loaded);
+
+    /* an empty bitmap round trips too */
+    roaring_clear(b);
+    FREE(buffer);
+    size   = roaring_serialized_size(b);
+    buffer = malloc(size);
+    TEST_EQUALITY(buffer && roaring_serialize(b, buffer, size) == size);
+    loaded = roaring_deserialize(buffer, size);
+    TEST_EQUALITY(loaded && roaring_is_empty(loaded));
+
+    DO_BEFORE_EXIT(
+        if(loaded) roaring_destroy(loaded);
+        if(a) roaring_destroy(a);
+        if(b) roaring_destroy(b);
+        FREE(ref_a);
+        FREE(ref_b);
+        FREE(buffer);
+    );
+}
+
+BEGIN_TESTS(roaring)
+    TEST(Add_WHEN_CONTAINER_FILLS_UP_THEN_CONVERT_FORMS),
+    TEST(SetOps_WHEN_CONTAINER_FORMS_MIX_THEN_MATCH_REFERENCE),
+    TEST(Serialize_WHEN_ROUND_TRIPPED_THEN_KEEP_VALUES_AND_FORMS)
+END_TESTS()
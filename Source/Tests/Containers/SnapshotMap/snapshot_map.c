@@ -0,0 +1,171 @@
+/**
+ * @file snapshot_map.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for SnapshotMap, reclaiming replaced versions only after
+ * readers that can see them are done, with readers running during commits.
+ * */
+
+#include <Anvie/Containers/SnapshotMap.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <pthread.h>
+
+#include "TestThreads.h"
+
+#define SMAP_TEST_READERS 3
+#define SMAP_TEST_KEYS    64
+#define SMAP_TEST_COMMITS 300
+
+static SnapshotMap* smap_test_create() {
+    return snapshot_map_create((HashCallback)(void*)hash_u64, sizeof(Uint64),
+                               (CompareElementCallback)(void*)compare_u64, sizeof(Uint64), NULL);
+}
+
+/* data of key in a version, or UINT64_MAX if absent */
+static Uint64 smap_test_get(DenseMap* version, Uint64 key) {
+    DenseMapItem* item = dense_map_search(version, (void*)key, NULL);
+    Uint64        data = UINT64_MAX;
+    if(item) {
+        memcpy(&data, dense_map_slot_data(version, item), sizeof(data));
+    }
+    return data;
+}
+
+/* set every key to @p generation in a single commit */
+static Bool smap_test_commit(SnapshotMap* map, Uint64 generation) {
+    DenseMap* next = snapshot_map_write_begin(map, NULL);
+    if(!next) {
+        return False;
+    }
+    for(Uint64 k = 0; k < SMAP_TEST_KEYS; k++) {
+        dense_map_insert(next, (void*)k, (void*)generation, NULL);
+    }
+    snapshot_map_write_commit(map, next);
+    return True;
+}
+
+TEST_FN Bool Reclaim_WHEN_READER_HOLDS_OLD_VERSION() {
+    SnapshotMap* map = smap_test_create();
+    TEST_OBJECT(map);
+    TEST_EQUALITY(smap_test_commit(map, 1));
+
+    /* version seen by reader must survive every commit made during it's read */
+    DenseMap* seen = snapshot_map_read_begin(map);
+    TEST_OBJECT(seen);
+    for(Uint64 g = 2; g <= 4; g++) {
+        TEST_EQUALITY(smap_test_commit(map, g));
+    }
+    TEST_LENGTH_EQ(snapshot_map_reclaim(map), 3);
+    TEST_EQUALITY(smap_test_get(seen, 7) == 1);
+
+    /* a nested section keeps protection until outermost one ends */
+    TEST_OBJECT(snapshot_map_read_begin(map));
+    snapshot_map_read_end(map);
+    TEST_LENGTH_EQ(snapshot_map_reclaim(map), 3);
+    TEST_EQUALITY(smap_test_get(seen, 7) == 1);
+
+    Uint64 data = 0;
+    TEST_EQUALITY(snapshot_map_search(map, (void*)7, &data, NULL) && data == 4);
+
+    snapshot_map_read_end(map);
+    TEST_LENGTH_EQ(snapshot_map_reclaim(map), 0);
+
+    /* writes with no reader free replaced version right away */
+    TEST_EQUALITY(smap_test_commit(map, 5));
+    TEST_LENGTH_EQ(snapshot_map_reclaim(map), 0);
+
+    DO_BEFORE_EXIT(
+        if(map) snapshot_map_destroy(map);
+    );
+}
+
+typedef struct SmapTestArg {
+    SnapshotMap* map;
+    volatile int* done;
+    Size         id;
+    Size         reads;
+    Size         errors;
+} SmapTestArg;
+
+/* first thread commits new generations, others check each version they see is one whole commit */
+static void* smap_test_worker(void* arg) {
+    SmapTestArg* a = arg;
+
+    if(!a->id) {
+        for(Uint64 g = 1; g <= SMAP_TEST_COMMITS; g++) {
+            a->errors += !smap_test_commit(a->map, g);
+            if(g % 16 == 0) {
+                sched_yield();
+            }
+        }
+        __atomic_store_n(a->done, 1, __ATOMIC_RELEASE);
+        return NULL;
+    }
+
+    Uint64 last = 0;
+    while(!__atomic_load_n(a->done, __ATOMIC_ACQUIRE)) {
+        DenseMap* version = snapshot_map_read_begin(a->map);
+        Uint64    first   = smap_test_get(version, 0);
+
+        /* versions only move forward, and all keys of a version have same generation */
+        a->errors += first < last && first != UINT64_MAX;
+        for(Uint64 k = 1; k < SMAP_TEST_KEYS && first != UINT64_MAX; k++) {
+            a->errors += smap_test_get(version, k) != first;
+        }
+        if(first != UINT64_MAX) {
+            last = first;
+        }
+
+        snapshot_map_read_end(a->map);
+        a->reads++;
+    }
+
+    return NULL;
+}
+
+TEST_FN Bool Reclaim_WHEN_READERS_RUN_DURING_COMMITS() {
+    SnapshotMap* map  = smap_test_create();
+    volatile int done = 0;
+    SmapTestArg  args[SMAP_TEST_READERS + 1];
+    TEST_OBJECT(map);
+
+    for(Size t = 0; t <= SMAP_TEST_READERS; t++) {
+        args[t] = (SmapTestArg) {map, &done, t, 0, 0};
+    }
+    TEST_EQUALITY(test_run_threads(SMAP_TEST_READERS + 1, smap_test_worker, args, sizeof(SmapTestArg)));
+
+    for(Size t = 0; t <= SMAP_TEST_READERS; t++) {
+        TEST_LENGTH_EQ(args[t].errors, 0);
+    }
+
+    /* all readers are done, so no replaced version is in use anymore */
+    TEST_LENGTH_EQ(snapshot_map_reclaim(map), 0);
+    TEST_LENGTH_EQ(snapshot_map_item_count(map), SMAP_TEST_KEYS);
+    Uint64 data = 0;
+    TEST_EQUALITY(snapshot_map_search(map, (void*)(SMAP_TEST_KEYS - 1), &data, NULL) && data == SMAP_TEST_COMMITS);
+
+    DO_BEFORE_EXIT(
+        if(map) snapshot_map_destroy(map);
+    );
+}
+
+BEGIN_TESTS(snapshot_map)
+    TEST(Reclaim_WHEN_READER_HOLDS_OLD_VERSION),
+    TEST(Reclaim_WHEN_READERS_RUN_DURING_COMMITS)
+END_TESTS()
@@ -0,0 +1,179 @@
+/**
+ * @file string.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for String, moving between inline and heap storage, pushing
+ * or setting a view of same string, and formatted appends.
+ * */
+
+#include <Anvie/Containers/String.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include <stdio.h>
+
+/* allocator counting allocations and reallocations in Size pointed to by ctx */
+static void* string_test_allocate(Size size, void* ctx) {
+    (*(Size*)ctx)++;
+    return malloc(size);
+}
+
+static void* string_test_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    UNUSED(old_size);
+    (*(Size*)ctx)++;
+    return realloc(ptr, new_size);
+}
+
+static void string_test_free(void* ptr, Size size, void* ctx) {
+    UNUSED(size && ctx);
+    free(ptr);
+}
+
+TEST_FN Bool Inline_WHEN_GROWN_AND_SHRUNK_THEN_KEEP_CONTENTS() {
+    Size      allocs    = 0;
+    Allocator allocator = {string_test_allocate, string_test_reallocate, string_test_free, &allocs};
+    String*   str       = str_create_with_allocator("", &allocator);
+    String*   clone     = NULL;
+    Char      expected[STR_INLINE_CAPACITY * 4 + 1];
+    memset(expected, 0, sizeof(expected));
+    TEST_OBJECT(str);
+
+    /* whole inline capacity is used without allocating anything other than object itself */
+    Size created = allocs;
+    for(Size i = 0; i < STR_INLINE_CAPACITY; i++) {
+        expected[i] = (Char)('a' + i % 26);
+        str_push_char(str, expected[i]);
+    }
+    TEST_EQUALITY(str_is_inline(str) && allocs == created);
+    TEST_EQUALITY(!str_cmp_zstr(str, expected));
+
+    /* one more byte spills contents to heap */
+    for(Size i = STR_INLINE_CAPACITY; i < STR_INLINE_CAPACITY * 4; i++) {
+        expected[i] = (Char)('A' + i % 26);
+        str_push_char(str, expected[i]);
+    }
+    TEST_EQUALITY(!str_is_inline(str) && allocs > created);
+    TEST_LENGTH_EQ(str->length, STR_INLINE_CAPACITY * 4);
+    TEST_EQUALITY(!str_cmp_zstr(str, expected));
+
+    /* a long clone stays on heap, and a short one goes back inline */
+    clone = str_clone(str);
+    TEST_EQUALITY(clone && !str_is_inline(clone) && !str_cmp(clone, str));
+    str_destroy(clone);
+
+    str_set_zstr(str, "short");
+    TEST_EQUALITY(!str_cmp_zstr(str, "short"));
+    clone = str_clone(str);
+    TEST_EQUALITY(clone && str_is_inline(clone) && !str_cmp_zstr(clone, "short"));
+
+    /* popping back across boundary only changes length */
+    str_set_zstr(str, expected);
+    while(str->length > STR_INLINE_CAPACITY / 2) {
+        TEST_EQUALITY(str_pop_char(str) == expected[str->length]);
+    }
+    expected[STR_INLINE_CAPACITY / 2] = 0;
+    TEST_EQUALITY(!str_cmp_zstr(str, expected));
+
+    DO_BEFORE_EXIT(
+        if(clone) str_destroy(clone);
+        if(str) str_destroy(str);
+    );
+}
+
+TEST_FN Bool Alias_WHEN_PUSHING_OWN_VIEW_THEN_COPY_BEFORE_GROWING() {
+    String* str           = str_create("0123456789");
+    Char    expected[641] = "0123456789";
+    TEST_OBJECT(str);
+
+    /* doubles from inline to inline, from inline to heap, and then reallocates heap */
+    for(Size length = 10; length < 640; length *= 2) {
+        memcpy(expected + length, expected, length);
+        expected[length * 2] = 0;
+        str_push_view(str, str_view(str));
+        TEST_LENGTH_EQ(str->length, length * 2);
+        TEST_EQUALITY(!str_cmp_zstr(str, expected));
+    }
+
+    /* tail of string pushed onto itself */
+    str_set_zstr(str, "abcdefgh");
+    str_push_view(str, str_subview(str, 4, SIZE_MAX));
+    TEST_EQUALITY(!str_cmp_zstr(str, "abcdefghefgh"));
+
+    DO_BEFORE_EXIT(
+        if(str) str_destroy(str);
+    );
+}
+
+TEST_FN Bool Alias_WHEN_SETTING_OWN_VIEW_THEN_KEEP_PART() {
+    String* str = str_create("0123456789abcdefghijklmnopqrstuvwxyz");
+    TEST_OBJECT(str);
+    TEST_EQUALITY(!str_is_inline(str));
+
+    /* overlapping part in middle of a heap string */
+    str_set_view(str, str_subview(str, 5, 20));
+    TEST_EQUALITY(!str_cmp_zstr(str, "56789abcdefghijklmno"));
+
+    /* and of an inline one */
+    str_set_zstr(str, "hello, world");
+    str_set_view(str, str_subview(str, 7, SIZE_MAX));
+    TEST_EQUALITY(!str_cmp_zstr(str, "world"));
+
+    str_set_view(str, str_view(str));
+    TEST_EQUALITY(!str_cmp_zstr(str, "world"));
+
+    DO_BEFORE_EXIT(
+        if(str) str_destroy(str);
+    );
+}
+
+TEST_FN Bool Appendf_WHEN_OUTPUT_CROSSES_CAPACITY_THEN_GROW() {
+    String* str            = str_create("id=");
+    Char    expected[4096] = "id=";
+    Size    length         = 3;
+    TEST_OBJECT(str);
+
+    /* fits in inline storage */
+    TEST_LENGTH_EQ(str_appendf(str, "%d-%s", 42, "x"), 4);
+    TEST_EQUALITY(!str_cmp_zstr(str, "id=42-x") && str_is_inline(str));
+    length += 4;
+    memcpy(expected + 3, "42-x", 4);
+
+    /* nothing appended */
+    TEST_LENGTH_EQ(str_appendf(str, "%s", ""), 0);
+    TEST_LENGTH_EQ(str->length, length);
+
+    /* each append may or may not need to grow, formatted output must be whole either way */
+    for(Size i = 0; i < 300; i++) {
+        Int32 n = snprintf(expected + length, sizeof(expected) - length, ",%zu:%.*s", i * 7919, (int)(i % 9), "abcdefghi");
+        TEST_LENGTH_EQ(str_appendf(str, ",%zu:%.*s", i * 7919, (int)(i % 9), "abcdefghi"), (Size)n);
+        length += (Size)n;
+        TEST_LENGTH_EQ(str->length, length);
+    }
+    TEST_EQUALITY(!str_is_inline(str) && !str_cmp_zstr(str, expected));
+
+    DO_BEFORE_EXIT(
+        if(str) str_destroy(str);
+    );
+}
+
+BEGIN_TESTS(string)
+    TEST(Inline_WHEN_GROWN_AND_SHRUNK_THEN_KEEP_CONTENTS),
+    TEST(Alias_WHEN_PUSHING_OWN_VIEW_THEN_COPY_BEFORE_GROWING),
+    TEST(Alias_WHEN_SETTING_OWN_VIEW_THEN_KEEP_PART),
+    TEST(Appendf_WHEN_OUTPUT_CROSSES_CAPACITY_THEN_GROW)
+END_TESTS()
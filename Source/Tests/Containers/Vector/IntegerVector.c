@@ -61,6 +61,8 @@ TEST_FN Bool Create2() {
     return True;
 }
 
+/* these check arguments, which unchecked builds don't, see Anvie/Error.h */
+#if ERR_CHECK_PRECONDITIONS
 /**
  * @TEST
  * Vector creation must fail when both create_copy()
@@ -84,6 +86,7 @@ TEST_FN Bool Create4() {
     if(vec) vector_destroy(vec, NULL);
     return True;
 }
+#endif // ERR_CHECK_PRECONDITIONS
 
 // TODO: add rest for overwrite, copy, swap, move
 
@@ -315,6 +318,45 @@ Exit:
     return res;
 }
 
+/**
+ * @TEST
+ * Check that floats and negative integers keep their value through
+ * push, peek and pop, since they are passed around as bits in a pointer
+ * */
+TEST_FN Bool PushPopFloat() {
+    Bool res = True;
+    F64_Vector* f64 = f64_vector_create();
+    F32_Vector* f32 = f32_vector_create();
+    I32_Vector* i32 = i32_vector_create();
+    for(Size iter = 0; iter < TEST_DATA_SIZE; iter++) {
+        f64_vector_push_back(f64, (Float64)iter * -0.5, NULL);
+        f32_vector_push_back(f32, (Float32)iter + 0.25f, NULL);
+        i32_vector_push_front(i32, -(Int32)iter, NULL);
+    }
+
+    for(Size iter = 0; iter < TEST_DATA_SIZE; iter++) {
+        if(f64_vector_peek(f64, iter) != (Float64)iter * -0.5 || f32_vector_peek(f32, iter) != (Float32)iter + 0.25f ||
+           i32_vector_peek(i32, TEST_DATA_SIZE - 1 - iter) != -(Int32)iter) {
+            DBG(__FUNCTION__, "VECTOR INSERTED ELEMENTS MISMATCH AT ENTRY INDEX \"%zu\"\n", iter);
+            res = False; goto Exit;
+        }
+    }
+
+    for(Size iter = TEST_DATA_SIZE; iter--;) {
+        if(f64_vector_pop_back(f64) != (Float64)iter * -0.5 || f32_vector_pop_back(f32) != (Float32)iter + 0.25f ||
+           i32_vector_pop_front(i32) != -(Int32)iter) {
+            DBG(__FUNCTION__, "VECTOR POPPED ELEMENTS MISMATCH AT ENTRY INDEX \"%zu\"\n", iter);
+            res = False; goto Exit;
+        }
+    }
+
+Exit:
+    f64_vector_destroy(f64, NULL);
+    f32_vector_destroy(f32, NULL);
+    i32_vector_destroy(i32, NULL);
+    return res;
+}
+
 /**
  * @TEST
  * Check delete fast operation of vector
@@ -569,15 +611,331 @@ TEST_VECTOR_SORT_FN(InsertionSort, insertion);
 TEST_VECTOR_SORT_FN(BubbleSort, bubble);
 TEST_VECTOR_SORT_FN(MergeSort, merge);
 
+/* check that each element is placed correctly as per comparision function */
+static Bool check_sorted_i32(I32_Vector* vec) {
+    for(Size s = 1; s < vec->length; s++) {
+        if(compare_i32(i32_vector_peek(vec, s), i32_vector_peek(vec, s-1), NULL) > 0) {
+            return False;
+        }
+    }
+    return True;
+}
+
+TEST_FN Bool Sort(void) {
+    I32_Vector* vec = i32_vector_create();
+
+    Size arr_size = 100000;
+
+    /* random input, with lots of duplicates */
+    for(Size s = 0; s < arr_size; s++) {
+        i32_vector_push_back(vec, rand()%1000, NULL);
+    }
+    Size start = chrono_get_time_as_microseconds();
+    i32_vector_sort(vec, compare_i32, NULL);
+    Size stop = chrono_get_time_as_microseconds();
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == arr_size && check_sorted_i32(vec), False, ERR_OPERATION_FAILED);
+    OK("Sort", "Sorting %zu random elements took %f ms\n", arr_size, (stop - start)/1000.f);
+
+    /* already sorted and reverse sorted input */
+    i32_vector_sort(vec, compare_i32, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(check_sorted_i32(vec), False, ERR_OPERATION_FAILED);
+    i32_vector_clear(vec, NULL);
+    for(Size s = 0; s < arr_size; s++) {
+        i32_vector_push_back(vec, s, NULL);
+    }
+    i32_vector_sort(vec, compare_i32, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(check_sorted_i32(vec), False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_check_sorted(vec, compare_i32, NULL), False, ERR_OPERATION_FAILED);
+
+    i32_vector_destroy(vec, NULL);
+    return True;
+}
+
+TEST_FN Bool ParallelSort(void) {
+    I32_Vector* vec = i32_vector_create();
+
+    Size arr_size = 200000;
+    for(Size s = 0; s < arr_size; s++) {
+        i32_vector_push_back(vec, rand(), NULL);
+    }
+
+    i32_vector_parallel_sort(vec, compare_i32, NULL, 4);
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == arr_size && check_sorted_i32(vec), False, ERR_OPERATION_FAILED);
+
+    i32_vector_destroy(vec, NULL);
+    return True;
+}
+
+TEST_FN Bool SortAscendingDescending(void) {
+    I32_Vector* vec = i32_vector_create();
+
+    /* small inputs go through quicksort, large ones through radix sort */
+    Size sizes[] = {10, 100000};
+    for(Size k = 0; k < sizeof(sizes)/sizeof(sizes[0]); k++) {
+        for(Size s = 0; s < sizes[k]; s++) {
+            i32_vector_push_back(vec, rand() - RAND_MAX/2, NULL);
+        }
+
+        i32_vector_sort_ascending(vec);
+        for(Size s = 1; s < vec->length; s++) {
+            ERR_RETURN_VALUE_IF_FAIL(vec->data[s-1] <= vec->data[s], False, ERR_OPERATION_FAILED);
+        }
+
+        i32_vector_sort_descending(vec);
+        for(Size s = 1; s < vec->length; s++) {
+            ERR_RETURN_VALUE_IF_FAIL(vec->data[s-1] >= vec->data[s], False, ERR_OPERATION_FAILED);
+        }
+
+        i32_vector_clear(vec, NULL);
+    }
+
+    i32_vector_destroy(vec, NULL);
+    return True;
+}
+
+TEST_FN Bool RangeOps(void) {
+    I32_Vector* vec = i32_vector_create();
+
+    Int32 batch[1000];
+    for(Int32 i = 0; i < 1000; i++) {
+        batch[i] = i;
+    }
+
+    // append two batches
+    i32_vector_push_back_n(vec, batch, 1000, NULL);
+    i32_vector_push_back_n(vec, batch, 1000, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == 2000 && vec->capacity >= 2000, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(vec->data[999] == 999 && vec->data[1000] == 0, False, ERR_OPERATION_FAILED);
+
+    // insert in middle, tail must be shifted
+    i32_vector_insert_range(vec, 1000, batch + 10, 5, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == 2005, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(vec->data[999] == 999 && vec->data[1000] == 10 && vec->data[1004] == 14 && vec->data[1005] == 0,
+                             False, ERR_OPERATION_FAILED);
+
+    // delete inserted range
+    i32_vector_delete_range(vec, 1000, 5, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == 2000 && vec->data[1000] == 0 && vec->data[1999] == 999, False, ERR_OPERATION_FAILED);
+
+    // replace everything
+    i32_vector_assign_from_array(vec, batch + 500, 3, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == 3 && vec->data[0] == 500 && vec->data[2] == 502, False, ERR_OPERATION_FAILED);
+
+    i32_vector_destroy(vec, NULL);
+    return True;
+}
+
+TEST_FN Bool Views(void) {
+    I32_Vector* vec = i32_vector_create();
+    for(Int32 i = 0; i < 100; i++) {
+        i32_vector_push_back(vec, i, NULL);
+    }
+
+    // view must alias vector memory
+    I32_VectorView view = i32_vector_get_view(vec, 10, 50);
+    ERR_RETURN_VALUE_IF_FAIL(view.length == 50 && view.data == vec->data + 10, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_view_front(&view) == 10 && i32_vector_view_back(&view) == 59, False, ERR_OPERATION_FAILED);
+
+    // slice is relative to view
+    I32_VectorView slice = i32_vector_view_slice(view, 5, 10);
+    ERR_RETURN_VALUE_IF_FAIL(slice.length == 10 && i32_vector_view_peek(&slice, 0) == 15, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_view_find(&slice, 20, compare_i32, NULL) == 5, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_view_find(&slice, 50, compare_i32, NULL) == SIZE_MAX, False, ERR_OPERATION_FAILED);
+
+    // sorting a view sorts only that range of parent, in place
+    i32_vector_view_sort(&slice, compare_i32, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_view_check_sorted(&slice, compare_i32, NULL), False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(vec->data[14] == 14 && vec->data[15] == 24 && vec->data[24] == 15 && vec->data[25] == 25,
+                             False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_view_binary_search(&slice, 17, compare_i32, NULL) == 7, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_view_binary_search(&slice, 30, compare_i32, NULL) == SIZE_MAX, False, ERR_OPERATION_FAILED);
+
+    i32_vector_destroy(vec, NULL);
+    return True;
+}
+
+static Bool keep_even(Int32 x, void* udata) {
+    UNUSED(udata);
+    return !(x & 1);
+}
+
+TEST_FN Bool RetainIf(void) {
+    I32_Vector* vec = i32_vector_create();
+    for(Int32 i = -500; i < 500; i++) {
+        i32_vector_push_back(vec, i, NULL);
+    }
+
+    // callback based, keeps even elements
+    Size len = i32_vector_retain_if(vec, keep_even, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(len == 500 && vec->length == 500, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(vec->data[0] == -500 && vec->data[499] == 498, False, ERR_OPERATION_FAILED);
+
+    // range kernel, order must be preserved
+    len = i32_vector_retain_in_range(vec, -11, 20);
+    ERR_RETURN_VALUE_IF_FAIL(len == 16 && vec->data[0] == -10 && vec->data[15] == 20, False, ERR_OPERATION_FAILED);
+    for(Size i = 1; i < len; i++) {
+        ERR_RETURN_VALUE_IF_FAIL(vec->data[i] == vec->data[i - 1] + 2, False, ERR_OPERATION_FAILED);
+    }
+
+    len = i32_vector_retain_lt(vec, 0);
+    ERR_RETURN_VALUE_IF_FAIL(len == 5 && vec->data[4] == -2, False, ERR_OPERATION_FAILED);
+
+    len = i32_vector_retain_eq(vec, -6);
+    ERR_RETURN_VALUE_IF_FAIL(len == 1 && vec->data[0] == -6, False, ERR_OPERATION_FAILED);
+
+    i32_vector_destroy(vec, NULL);
+
+    // unsigned values above signed range
+    U32_Vector* uvec = u32_vector_create();
+    for(Uint32 i = 0; i < 100; i++) {
+        u32_vector_push_back(uvec, UINT32_MAX - i, NULL);
+    }
+    len = u32_vector_retain_in_range(uvec, UINT32_MAX - 9, UINT32_MAX);
+    ERR_RETURN_VALUE_IF_FAIL(len == 10 && uvec->data[0] == UINT32_MAX && uvec->data[9] == UINT32_MAX - 9, False, ERR_OPERATION_FAILED);
+    u32_vector_destroy(uvec, NULL);
+
+    return True;
+}
+
+static Int32 compare_i32_ascending(Int32 x, Int32 y, void* udata) {
+    UNUSED(udata);
+    return y - x;
+}
+
+TEST_FN Bool SortedOps(void) {
+    I32_Vector* evens = i32_vector_create();
+    I32_Vector* few   = i32_vector_create();
+    for(Int32 i = 0; i < 1000; i += 2) {
+        i32_vector_push_back(evens, i, NULL);
+    }
+    i32_vector_push_back(few, 3, NULL);
+    i32_vector_push_back(few, 500, NULL);
+    i32_vector_push_back(few, 2000, NULL);
+
+    // comparator based and comparator free searches must agree
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_lower_bound(evens, 501, compare_i32_ascending, NULL) == 251, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_lower_bound_ascending(evens, 501) == 251, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_upper_bound(evens, 500, compare_i32_ascending, NULL) == 251, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_upper_bound_ascending(evens, 500) == 251, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_binary_search(evens, 500, compare_i32_ascending, NULL) == 250, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_binary_search_ascending(evens, 500) == 250, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_binary_search_ascending(evens, 501) == SIZE_MAX, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_lower_bound_ascending(evens, 5000) == 500, False, ERR_OPERATION_FAILED);
+
+    I32_Vector* result = i32_vector_sorted_union(evens, few, compare_i32_ascending, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(result->length == 502 && result->data[2] == 3 && result->data[501] == 2000, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_check_sorted(result, compare_i32_ascending, NULL), False, ERR_OPERATION_FAILED);
+    i32_vector_destroy(result, NULL);
+
+    result = i32_vector_sorted_intersect(few, evens, compare_i32_ascending, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(result->length == 1 && result->data[0] == 500, False, ERR_OPERATION_FAILED);
+    i32_vector_destroy(result, NULL);
+
+    result = i32_vector_sorted_difference(evens, few, compare_i32_ascending, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(result->length == 499 && i32_vector_binary_search_ascending(result, 500) == SIZE_MAX, False, ERR_OPERATION_FAILED);
+    i32_vector_destroy(result, NULL);
+
+    i32_vector_destroy(evens, NULL);
+    i32_vector_destroy(few, NULL);
+    return True;
+}
+
+TEST_FN Bool Reductions(void) {
+    // odd length so that both SIMD body and scalar tail are exercised
+    I32_Vector* vec = i32_vector_create();
+    for(Int32 i = 0; i < 1001; i++) {
+        i32_vector_push_back(vec, (i * 7919) % 1001 - 500, NULL);
+    }
+    i32_vector_push_back(vec, 77, NULL);
+
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_min(vec) == -500 && i32_vector_max(vec) == 500, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_sum(vec) == 77, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_count(vec, 77) == 2 && i32_vector_count(vec, 501) == 0, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_find(vec, vec->data[600]) == 600, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(i32_vector_find(vec, 501) == SIZE_MAX && !i32_vector_contains(vec, 501), False, ERR_OPERATION_FAILED);
+    i32_vector_destroy(vec, NULL);
+
+    // unsigned compare must not treat high values as negative, sums must not overflow element type
+    U8_Vector* bytes = u8_vector_create();
+    for(Uint32 i = 0; i < 300; i++) {
+        u8_vector_push_back(bytes, (Uint8)(i % 200 + 50), NULL);
+    }
+    ERR_RETURN_VALUE_IF_FAIL(u8_vector_min(bytes) == 50 && u8_vector_max(bytes) == 249, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(u8_vector_sum(bytes) == 39850, False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(u8_vector_find(bytes, 249) == 199 && u8_vector_count(bytes, 50) == 2, False, ERR_OPERATION_FAILED);
+    u8_vector_destroy(bytes, NULL);
+
+    U64_Vector* big = u64_vector_create();
+    for(Uint64 i = 1; i <= 37; i++) {
+        u64_vector_push_back(big, i << 40, NULL);
+    }
+    ERR_RETURN_VALUE_IF_FAIL(u64_vector_sum(big) == (703ull << 40), False, ERR_OPERATION_FAILED);
+    ERR_RETURN_VALUE_IF_FAIL(u64_vector_max(big) == (37ull << 40) && u64_vector_find(big, 5ull << 40) == 4, False, ERR_OPERATION_FAILED);
+    u64_vector_destroy(big, NULL);
+
+    return True;
+}
+
+static Size grow_by_min(Size capacity, Size min_capacity, void* udata) {
+    UNUSED(udata);
+    return capacity + min_capacity;
+}
+
+TEST_FN Bool Growth(void) {
+    I32_Vector* vec = i32_vector_create();
+
+    // tiny resize factor and a far insert position must still terminate
+    vec->resize_factor = 0.01f;
+    i32_vector_insert(vec, 7, 1000, NULL);
+    ERR_RETURN_VALUE_IF_FAIL(vec->length == 1001 && vec->data[1000] == 7 && vec->data[500] == 0, False, ERR_OPERATION_FAILED);
+
+    i32_vector_clear(vec, NULL);
+    i32_vector_shrink_to_fit(vec);
+    ERR_RETURN_VALUE_IF_FAIL(vec->capacity == 1, False, ERR_OPERATION_FAILED);
+
+    VectorGrowthPolicy fixed = { .mode = VECTOR_GROWTH_FIXED_STEP, .step = 100 };
+    i32_vector_set_growth_policy(vec, &fixed);
+    for(Int32 i = 0; i < 150; i++) {
+        i32_vector_push_back(vec, i, NULL);
+    }
+    ERR_RETURN_VALUE_IF_FAIL(vec->capacity == 201, False, ERR_OPERATION_FAILED);
+
+    // exact reserve keeps elements
+    i32_vector_reserve(vec, 1000);
+    ERR_RETURN_VALUE_IF_FAIL(vec->capacity == 1000 && vec->length == 150 && vec->data[149] == 149, False, ERR_OPERATION_FAILED);
+
+    VectorGrowthPolicy callback = { .mode = VECTOR_GROWTH_CALLBACK, .callback = grow_by_min };
+    i32_vector_set_growth_policy(vec, &callback);
+    for(Int32 i = 150; i < 1001; i++) {
+        i32_vector_push_back(vec, i, NULL);
+    }
+    ERR_RETURN_VALUE_IF_FAIL(vec->capacity == 2001, False, ERR_OPERATION_FAILED);
+
+    i32_vector_shrink_to_fit(vec);
+    ERR_RETURN_VALUE_IF_FAIL(vec->capacity == 1001 && vec->data[1000] == 1000, False, ERR_OPERATION_FAILED);
+
+    i32_vector_destroy(vec, NULL);
+    return True;
+}
+
 BEGIN_TESTS(IntegerVector)
     // SORTING
+    TEST(Sort),
+    TEST(SortAscendingDescending),
+    TEST(ParallelSort),
     TEST(MergeSort),
     TEST(BubbleSort),
     TEST(InsertionSort),
+    TEST(SortedOps),
 
     // MISC
+    TEST(RangeOps),
+    TEST(Views),
     TEST(Swap),
     TEST(Filter),
+    TEST(RetainIf),
+    TEST(Reductions),
+    TEST(Growth),
     TEST(Merge),
 
     // push/pop APIs
@@ -585,6 +943,7 @@ BEGIN_TESTS(IntegerVector)
     TEST(PushFront),
     TEST(PopBack),
     TEST(PushBack),
+    TEST(PushPopFloat),
 
     // insert delete tests
     TEST(Remove),
@@ -597,6 +956,8 @@ BEGIN_TESTS(IntegerVector)
     // constructor tests
     TEST(Create1),
     TEST(Create2),
+#if ERR_CHECK_PRECONDITIONS
     TEST(Create3),
     TEST(Create4),
+#endif // ERR_CHECK_PRECONDITIONS
 END_TESTS()
@@ -0,0 +1,220 @@
+/**
+ * @file SmallVector.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Small vector container tests
+ * */
+
+#include <Anvie/Containers/SmallVector.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+DEF_SMALL_VECTOR_INTERFACE(u64x4, U64x4, U64, Uint64, 4, NULL, NULL);
+
+/*
+ * Parent allocator that fills new memory with garbage, so that fields left
+ * uninitialized by small vector show up, and counts live allocations.
+ */
+static void* small_vector_test_allocate(Size size, void* ctx) {
+    void* mem = malloc(size);
+    if(mem) {
+        memset(mem, 0xa5, size);
+        (*(Size*)ctx)++;
+    }
+    return mem;
+}
+
+static void* small_vector_test_reallocate(void* ptr, Size old_size, Size new_size, void* ctx) {
+    UNUSED(old_size);
+    void* mem = realloc(ptr, new_size);
+    if(mem && !ptr) {
+        (*(Size*)ctx)++;
+    }
+    return mem;
+}
+
+static void small_vector_test_free(void* ptr, Size size, void* ctx) {
+    UNUSED(size);
+    free(ptr);
+    (*(Size*)ctx)--;
+}
+
+/* push 0, 1, 2 ... up to @p count elements, @return True if all of them read back */
+static Bool small_vector_test_fill(U64_Vector* vec, Size count) {
+    for(Size i = vec->length; i < count; i++) {
+        u64_vector_push_back(vec, i, NULL);
+    }
+    for(Size i = 0; i < count; i++) {
+        if(vec->length != count || u64_vector_peek(vec, i) != i) {
+            return False;
+        }
+    }
+    return True;
+}
+
+/**
+ * @TEST
+ * Small vector created from garbage memory grows past inline storage.
+ * */
+TEST_FN Bool Growth_WHEN_CREATED_THEN_SPILL_PAST_INLINE() {
+    Size          live   = 0;
+    Allocator     parent = {small_vector_test_allocate, small_vector_test_reallocate, small_vector_test_free, &live};
+    U64x4_SmallVector* sv = u64x4_small_vector_create_with_allocator(&parent);
+    TEST_OBJECT(sv);
+    U64_Vector* vec = u64x4_small_vector_as_vector(sv);
+
+    TEST_EQUALITY(small_vector_test_fill(vec, 4));
+    TEST_EQUALITY(u64x4_small_vector_is_inline(sv));
+    TEST_EQUALITY(small_vector_test_fill(vec, 100));
+    TEST_EQUALITY(!u64x4_small_vector_is_inline(sv));
+
+    u64x4_small_vector_destroy(sv, NULL);
+    sv = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(sv) u64x4_small_vector_destroy(sv, NULL);
+    );
+}
+
+/**
+ * @TEST
+ * Small vector initialized over garbage on stack grows by default policy,
+ * and by a growth policy set later.
+ * */
+TEST_FN Bool Growth_WHEN_INITIALIZED_ON_STACK() {
+    static const VectorGrowthPolicy step = {.mode = VECTOR_GROWTH_FIXED_STEP, .step = 3};
+
+    U64x4_SmallVector sv;
+    memset(&sv, 0xa5, sizeof(sv));
+    u64x4_small_vector_init(&sv, NULL);
+    U64_Vector* vec = u64x4_small_vector_as_vector(&sv);
+
+    TEST_EQUALITY(small_vector_test_fill(vec, 50));
+
+    u64_vector_clear(vec, NULL);
+    u64_vector_shrink_to_fit(vec);
+    u64_vector_set_growth_policy(vec, &step);
+    TEST_EQUALITY(small_vector_test_fill(vec, 50));
+    TEST_LENGTH_EQ(vec->capacity % 3, 1);
+
+    DO_BEFORE_EXIT(
+        u64x4_small_vector_deinit(&sv, NULL);
+    );
+}
+
+/**
+ * @TEST
+ * Elements stay inline until they don't fit, spill to heap, and move back
+ * inline when shrunk enough.
+ * */
+TEST_FN Bool Storage_WHEN_SPILLED_THEN_SHRINK_BACK_INLINE() {
+    Size              live   = 0;
+    Allocator         parent = {small_vector_test_allocate, small_vector_test_reallocate, small_vector_test_free, &live};
+    U64x4_SmallVector sv;
+    u64x4_small_vector_init(&sv, &parent);
+    U64_Vector*        vec    = u64x4_small_vector_as_vector(&sv);
+    U64x4_SmallVector* inited = &sv;
+
+    TEST_EQUALITY(small_vector_test_fill(vec, 4));
+    TEST_EQUALITY(u64x4_small_vector_is_inline(&sv));
+    TEST_LENGTH_EQ(live, 0);
+
+    TEST_EQUALITY(small_vector_test_fill(vec, 5));
+    TEST_EQUALITY(!u64x4_small_vector_is_inline(&sv));
+    TEST_LENGTH_EQ(live, 1);
+
+    u64_vector_resize(vec, 3);
+    u64_vector_shrink_to_fit(vec);
+    TEST_EQUALITY(u64x4_small_vector_is_inline(&sv));
+    TEST_LENGTH_EQ(live, 0);
+    TEST_EQUALITY(small_vector_test_fill(vec, 3));
+
+    /* and spills again */
+    TEST_EQUALITY(small_vector_test_fill(vec, 20));
+    TEST_EQUALITY(!u64x4_small_vector_is_inline(&sv));
+
+    u64x4_small_vector_deinit(&sv, NULL);
+    inited = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(inited) u64x4_small_vector_deinit(inited, NULL);
+    );
+}
+
+/**
+ * @TEST
+ * Clones use small vector's allocator but never it's inline storage, even
+ * when shrunk small enough to fit there.
+ * */
+TEST_FN Bool Clone_WHEN_SHRUNK_THEN_STAY_ON_HEAP() {
+    Size               live   = 0;
+    Allocator          parent = {small_vector_test_allocate, small_vector_test_reallocate, small_vector_test_free, &live};
+    U64x4_SmallVector* sv     = u64x4_small_vector_create_with_allocator(&parent);
+    U64_Vector*        clone  = NULL;
+    TEST_OBJECT(sv);
+    U64_Vector* vec = u64x4_small_vector_as_vector(sv);
+
+    /* clone of an inline small vector */
+    TEST_EQUALITY(small_vector_test_fill(vec, 2));
+    clone = u64_vector_clone(vec, NULL);
+    TEST_EQUALITY(clone && (void*)clone->data != sv->storage);
+    TEST_EQUALITY(small_vector_test_fill(clone, 2));
+    u64_vector_destroy(clone, NULL);
+    clone = NULL;
+
+    /* clone of a spilled one, both shrunk back */
+    TEST_EQUALITY(small_vector_test_fill(vec, 100));
+    clone = u64_vector_clone(vec, NULL);
+    TEST_EQUALITY(clone);
+    for(Size i = 0; i < 100; i++) {
+        vector_at((Vector*)vec, Uint64, i) += 1000;
+    }
+
+    u64_vector_resize(clone, 2);
+    u64_vector_shrink_to_fit(clone);
+    u64_vector_resize(vec, 3);
+    u64_vector_shrink_to_fit(vec);
+
+    TEST_EQUALITY((void*)clone->data != sv->storage);
+    TEST_EQUALITY(u64x4_small_vector_is_inline(sv));
+    TEST_EQUALITY(small_vector_test_fill(clone, 2));
+    for(Size i = 0; i < 3; i++) {
+        TEST_LENGTH_EQ(u64_vector_peek(vec, i), i + 1000);
+    }
+
+    /* nothing is left allocated once both are destroyed */
+    u64_vector_destroy(clone, NULL);
+    clone = NULL;
+    u64x4_small_vector_destroy(sv, NULL);
+    sv = NULL;
+    TEST_LENGTH_EQ(live, 0);
+
+    DO_BEFORE_EXIT(
+        if(clone) u64_vector_destroy(clone, NULL);
+        if(sv) u64x4_small_vector_destroy(sv, NULL);
+    );
+}
+
+BEGIN_TESTS(SmallVector)
+    TEST(Growth_WHEN_CREATED_THEN_SPILL_PAST_INLINE),
+    TEST(Growth_WHEN_INITIALIZED_ON_STACK),
+    TEST(Storage_WHEN_SPILLED_THEN_SHRINK_BACK_INLINE),
+    TEST(Clone_WHEN_SHRUNK_THEN_STAY_ON_HEAP)
+END_TESTS()
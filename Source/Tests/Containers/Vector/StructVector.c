@@ -128,6 +128,8 @@ TEST_FN Bool Create2() {
     return True;
 }
 
+/* these check arguments, which unchecked builds don't, see Anvie/Error.h */
+#if ERR_CHECK_PRECONDITIONS
 /**
  * @TEST
  * Vector creation must fail when both create_copy()
@@ -153,6 +155,7 @@ TEST_FN Bool Create4() {
     if(vec) vector_destroy(vec, &sd); // we don't actually need to destroy, but still...
     return True;
 }
+#endif // ERR_CHECK_PRECONDITIONS
 
 /**
  * @TEST
@@ -677,7 +680,65 @@ TEST_FN Bool Filter() {
     return True;
 }
 
+/**
+ * Record with a sort key that has many duplicates, and the
+ * order in which it was inserted.
+ * */
+typedef struct EventRecord {
+    Uint32 key;
+    Uint32 seq;
+    Byte   payload[16];
+} EventRecord;
+
+DEF_STRUCT_VECTOR_INTERFACE(event, Event, EventRecord, NULL, NULL);
+
+static Int32 compare_event_key(EventRecord* a, EventRecord* b, void* udata) {
+    UNUSED(udata);
+    return (Int32)b->key - (Int32)a->key;
+}
+
+TEST_FN Bool StableSort() {
+    Event_Vector* vec = event_vector_create();
+
+    for(Uint32 i = 0; i < 10000; i++) {
+        EventRecord er = {.key = rand() % 64, .seq = i};
+        event_vector_push_back(vec, &er, NULL);
+    }
+
+    event_vector_stable_sort(vec, compare_event_key, NULL);
+
+    // records with same key must remain in order of insertion
+    for(Size s = 1; s < vec->length; s++) {
+        EventRecord* prev = event_vector_address_at(vec, s-1);
+        EventRecord* cur  = event_vector_address_at(vec, s);
+        ERR_RETURN_VALUE_IF_FAIL(prev->key < cur->key || (prev->key == cur->key && prev->seq < cur->seq),
+                                 False, ERR_OPERATION_FAILED);
+    }
+
+    // caller provided scratch buffer, descending by sequence this time
+    Size scratch_size = event_vector_stable_sort_scratch_size(vec);
+    void* scratch = ALLOCATE(Byte, scratch_size);
+    for(Size s = 0; s < vec->length; s++) {
+        event_vector_address_at(vec, s)->seq = vec->length - s;
+        event_vector_address_at(vec, s)->key = s % 3;
+    }
+    event_vector_stable_sort_with_buffer(vec, compare_event_key, NULL, scratch, scratch_size);
+    for(Size s = 1; s < vec->length; s++) {
+        EventRecord* prev = event_vector_address_at(vec, s-1);
+        EventRecord* cur  = event_vector_address_at(vec, s);
+        ERR_RETURN_VALUE_IF_FAIL(prev->key < cur->key || (prev->key == cur->key && prev->seq > cur->seq),
+                                 False, ERR_OPERATION_FAILED);
+    }
+    FREE(scratch);
+
+    event_vector_destroy(vec, NULL);
+    return True;
+}
+
 BEGIN_TESTS(StructVector)
+    // SORTING
+    TEST(StableSort),
+
     // MISC
     TEST(Filter),
     TEST(Merge),
@@ -699,6 +760,8 @@ BEGIN_TESTS(StructVector)
     // constructor tests
     TEST(Create1),
     TEST(Create2),
+#if ERR_CHECK_PRECONDITIONS
     TEST(Create3),
     TEST(Create4),
+#endif // ERR_CHECK_PRECONDITIONS
 END_TESTS()
@@ -0,0 +1,260 @@
+/**
+ * @file zstr_map.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for DenseMap and SparseMap with ZString keys, whose copies
+ * must be found by hash and compare callbacks just like keys given by user.
+ * */
+
+#include <Anvie/Containers/StringArena.h>
+#include <Anvie/Containers/SparseMap.h>
+#include <Anvie/Containers/DenseMap.h>
+#include <Anvie/Containers/Image.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include <stdio.h>
+
+#define ZMAP_TEST_KEYS 200
+
+/*
+ * Keys are all written into this same buffer before being given to a map,
+ * so a map that keeps pointer to given key instead of a copy of it, or that
+ * compares or hashes anything other than the copied string, can't find them.
+ */
+static ZString zmap_test_key(Char* buf, Size size, Size k) {
+    snprintf(buf, size, "zmap-test-key-%zu", k);
+    return buf;
+}
+
+/* value stored for k-th key of a ZString to ZString map */
+static ZString zmap_test_value(Char* buf, Size size, Size k) {
+    snprintf(buf, size, "zmap-test-value-%zu", k * 31);
+    return buf;
+}
+
+/* fill a ZString to ZString map through it's typed interface */
+static Bool zmap_test_fill_zstr_zstr(ZStr_ZStr_DenseMap* map) {
+    Char kbuf[32], vbuf[32];
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        ZString key = zmap_test_key(kbuf, sizeof(kbuf), k);
+        if(!zstr_zstr_dense_map_insert(map, key, zmap_test_value(vbuf, sizeof(vbuf), k), NULL)) {
+            return False;
+        }
+    }
+    return map->item_count == ZMAP_TEST_KEYS;
+}
+
+/* every key of map maps to it's own value, with both of them being copies */
+static Bool zmap_test_check_zstr_zstr(ZStr_ZStr_DenseMap* map) {
+    Char kbuf[32], vbuf[32];
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        ZStr_ZStr_DenseMapItem* item = zstr_zstr_dense_map_search(map, zmap_test_key(kbuf, sizeof(kbuf), k), NULL);
+        if(!item || item->key == kbuf || item->data == vbuf || strcmp(item->key, kbuf) ||
+           strcmp(item->data, zmap_test_value(vbuf, sizeof(vbuf), k))) {
+            return False;
+        }
+    }
+    return map->item_count == ZMAP_TEST_KEYS;
+}
+
+/* insert all keys, delete even ones and check that exactly odd ones remain */
+static Bool zmap_test_dense(DenseMap* map, void* udata) {
+    Char buf[32];
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        if(!dense_map_insert(map, (void*)zmap_test_key(buf, sizeof(buf), k), (void*)(Uint64)k, udata)) {
+            return False;
+        }
+    }
+    if(map->item_count != ZMAP_TEST_KEYS) {
+        return False;
+    }
+
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        DenseMapItem* item = dense_map_search(map, (void*)zmap_test_key(buf, sizeof(buf), k), udata);
+        if(!item || (Uint64)item->data != k || (ZString)item->key == buf || strcmp(item->key, buf)) {
+            return False;
+        }
+    }
+
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k += 2) {
+        dense_map_delete(map, (void*)zmap_test_key(buf, sizeof(buf), k), udata);
+    }
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        DenseMapItem* item = dense_map_search(map, (void*)zmap_test_key(buf, sizeof(buf), k), udata);
+        if((k & 1) != (item != NULL) || (item && (Uint64)item->data != k)) {
+            return False;
+        }
+    }
+    return map->item_count == ZMAP_TEST_KEYS / 2;
+}
+
+/* same as zmap_test_dense, for a SparseMap */
+static Bool zmap_test_sparse(SparseMap* map, void* udata) {
+    Char buf[32];
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        if(!sparse_map_insert(map, (void*)zmap_test_key(buf, sizeof(buf), k), (void*)(Uint64)k, udata)) {
+            return False;
+        }
+    }
+    if(map->item_count != ZMAP_TEST_KEYS) {
+        return False;
+    }
+
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        SparseMapItem* item = sparse_map_search(map, (void*)zmap_test_key(buf, sizeof(buf), k), udata);
+        if(!item || (Uint64)item->data != k || (ZString)item->key == buf || strcmp(item->key, buf)) {
+            return False;
+        }
+    }
+
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k += 2) {
+        sparse_map_delete(map, (void*)zmap_test_key(buf, sizeof(buf), k), udata);
+    }
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        SparseMapItem* item = sparse_map_search(map, (void*)zmap_test_key(buf, sizeof(buf), k), udata);
+        if((k & 1) != (item != NULL) || (item && (Uint64)item->data != k)) {
+            return False;
+        }
+    }
+    return map->item_count == ZMAP_TEST_KEYS / 2;
+}
+
+TEST_FN Bool DenseMap_WHEN_ZSTR_KEYS_THEN_FIND_COPIES() {
+    ZStr_U64_DenseMap* map = zstr_u64_dense_map_create();
+    TEST_OBJECT(map);
+
+    TEST_EQUALITY(zmap_test_dense(map, NULL));
+
+    DO_BEFORE_EXIT(
+        if(map) zstr_u64_dense_map_destroy(map, NULL);
+    );
+}
+
+TEST_FN Bool DenseMap_WHEN_ZSTR_KEYS_IN_ARENA_THEN_FIND_COPIES() {
+    StringArena*            arena = string_arena_create(0, NULL);
+    ZStrArena_U64_DenseMap* map   = zstr_arena_u64_dense_map_create();
+    TEST_EQUALITY(arena && map);
+
+    TEST_EQUALITY(zmap_test_dense(map, arena));
+
+    DO_BEFORE_EXIT(
+        if(map) zstr_arena_u64_dense_map_destroy(map, arena);
+        if(arena) string_arena_destroy(arena);
+    );
+}
+
+TEST_FN Bool SparseMap_WHEN_ZSTR_KEYS_THEN_FIND_COPIES() {
+    ZStr_U64_SparseMap* map = zstr_u64_sparse_map_create();
+    TEST_OBJECT(map);
+
+    TEST_EQUALITY(zmap_test_sparse((SparseMap*)map, NULL));
+
+    DO_BEFORE_EXIT(
+        if(map) zstr_u64_sparse_map_destroy(map, NULL);
+    );
+}
+
+TEST_FN Bool SparseMap_WHEN_ZSTR_KEYS_IN_ARENA_THEN_FIND_COPIES() {
+    StringArena*             arena = string_arena_create(0, NULL);
+    ZStrArena_U64_SparseMap* map   = zstr_arena_u64_sparse_map_create();
+    TEST_EQUALITY(arena && map);
+
+    TEST_EQUALITY(zmap_test_sparse((SparseMap*)map, arena));
+
+    DO_BEFORE_EXIT(
+        if(map) zstr_arena_u64_sparse_map_destroy(map, arena);
+        if(arena) string_arena_destroy(arena);
+    );
+}
+
+TEST_FN Bool DenseMap_WHEN_ZSTR_KEYS_AND_DATA_THEN_ROUND_TRIP() {
+    ZStr_ZStr_DenseMap* map    = zstr_zstr_dense_map_create();
+    void*               buffer = NULL;
+    Image*              image  = NULL;
+    TEST_OBJECT(map);
+
+    TEST_EQUALITY(zmap_test_fill_zstr_zstr(map));
+    TEST_EQUALITY(zmap_test_check_zstr_zstr(map));
+
+    /* strings are written into image with items, and loaded map points to them */
+    Uint32 flags = DENSE_MAP_IMAGE_ZSTR_KEYS | DENSE_MAP_IMAGE_ZSTR_DATA;
+    Size   size  = dense_map_write_to_buffer(map, flags, NULL, 0);
+    TEST_LENGTH_GT(size, 0);
+    buffer = aligned_alloc(16, (size + 15) & ~(Size)15);
+    TEST_EQUALITY(buffer != NULL);
+    TEST_LENGTH_EQ(dense_map_write_to_buffer(map, flags, buffer, size), size);
+
+    /* original strings are gone before loaded map is used */
+    zstr_zstr_dense_map_destroy(map, NULL);
+    map = NULL;
+
+    image = image_wrap_buffer(buffer, size);
+    TEST_EQUALITY(image != NULL);
+    ZStr_ZStr_DenseMap* loaded = dense_map_from_image(image, (HashCallback)(void*)hash_zstr,
+                                                      (CompareElementCallback)(void*)compare_zstr);
+    TEST_EQUALITY(loaded != NULL);
+    TEST_EQUALITY(zmap_test_check_zstr_zstr(loaded));
+
+    DO_BEFORE_EXIT(
+        if(map) zstr_zstr_dense_map_destroy(map, NULL);
+        if(image) image_destroy(image);
+        free(buffer);
+    );
+}
+
+TEST_FN Bool SparseMap_WHEN_ZSTR_KEYS_AND_DATA_THEN_ROUND_TRIP() {
+    ZStr_ZStr_SparseMap* map = zstr_zstr_sparse_map_create();
+    Char                 kbuf[32], vbuf[32];
+    TEST_OBJECT(map);
+
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        ZString key = zmap_test_key(kbuf, sizeof(kbuf), k);
+        TEST_EQUALITY(zstr_zstr_sparse_map_insert(map, key, zmap_test_value(vbuf, sizeof(vbuf), k), NULL) != NULL);
+    }
+    TEST_LENGTH_EQ(map->item_count, ZMAP_TEST_KEYS);
+
+    /* deleted strings are freed, and values of remaining keys are untouched */
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k += 3) {
+        zstr_zstr_sparse_map_delete(map, zmap_test_key(kbuf, sizeof(kbuf), k), NULL);
+    }
+    for(Size k = 0; k < ZMAP_TEST_KEYS; k++) {
+        ZStr_ZStr_SparseMapItem* item = zstr_zstr_sparse_map_search(map, zmap_test_key(kbuf, sizeof(kbuf), k), NULL);
+        if(k % 3) {
+            TEST_EQUALITY(item != NULL);
+            TEST_EQUALITY(item->key != kbuf && !strcmp(item->key, kbuf));
+            TEST_EQUALITY(!strcmp(item->data, zmap_test_value(vbuf, sizeof(vbuf), k)));
+        } else {
+            TEST_EQUALITY(!item);
+        }
+    }
+    TEST_LENGTH_EQ(map->item_count, ZMAP_TEST_KEYS - (ZMAP_TEST_KEYS + 2) / 3);
+
+    DO_BEFORE_EXIT(
+        if(map) zstr_zstr_sparse_map_destroy(map, NULL);
+    );
+}
+
+BEGIN_TESTS(zstr_map)
+    TEST(DenseMap_WHEN_ZSTR_KEYS_THEN_FIND_COPIES),
+    TEST(DenseMap_WHEN_ZSTR_KEYS_IN_ARENA_THEN_FIND_COPIES),
+    TEST(SparseMap_WHEN_ZSTR_KEYS_THEN_FIND_COPIES),
+    TEST(SparseMap_WHEN_ZSTR_KEYS_IN_ARENA_THEN_FIND_COPIES),
+    TEST(DenseMap_WHEN_ZSTR_KEYS_AND_DATA_THEN_ROUND_TRIP),
+    TEST(SparseMap_WHEN_ZSTR_KEYS_AND_DATA_THEN_ROUND_TRIP)
+END_TESTS()
@@ -0,0 +1,324 @@
+/**
+ * @file matrix_4f.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for Matrix4f, comparing vectorized add, sub and multiply
+ * against their scalar references, including aliased and batched multiply,
+ * and checking transpose and all inverse kernels.
+ * */
+
+
+#include <Anvie/Maths/Matrix4f.h>
+#include <Anvie/Test/UnitTest.h>
+
+/* number of random matrices each test checks, odd so batched paths have a tail */
+#define MATRIX_4F_TEST_COUNT 9
+
+/* fill matrix with pseudo random entries in [-4, 4), same seed gives same matrix */
+static void matrix_4f_test_fill(Matrix4f* mat, Uint64 seed) {
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            /* splitmix64 */
+            Uint64 z = (seed += 0x9e3779b97f4a7c15ULL);
+            z        = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z        = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z        = z ^ (z >> 31);
+            mat->data[r][c] = (Float32)(z >> 40) / (Float32)(1 << 24) * 8.f - 4.f;
+        }
+    }
+}
+
+/* vectorized and scalar results may differ in rounding, and in fusing of multiply-adds */
+static Bool matrix_4f_test_near(const Matrix4f* a, const Matrix4f* b) {
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            if(fabsf(a->data[r][c] - b->data[r][c]) > 1e-4f * (1.f + fabsf(b->data[r][c]))) {
+                return False;
+            }
+        }
+    }
+    return True;
+}
+
+/* invertible and well conditioned, so product with it's inverse is close to identity */
+static void matrix_4f_test_fill_invertible(Matrix4f* mat, Uint64 seed) {
+    matrix_4f_test_fill(mat, seed);
+    for(Size k = 0; k < 4; k++) {
+        mat->data[k][k] += mat->data[k][k] < 0 ? -16.f : 16.f;
+    }
+}
+
+/* rotation, scale and translation, last row is (0, 0, 0, 1) */
+static Matrix4f matrix_4f_test_affine(Uint64 seed, Bool rigid) {
+    Matrix4f rnd;
+    matrix_4f_test_fill(&rnd, seed);
+
+    Matrix4f mat = matrix_4f_rotation_matrix_v(rnd.data[0][0], rnd.data[0][1], rnd.data[0][2]);
+    if(!rigid) {
+        mat = matrix_4f_mul_v(mat, matrix_4f_scale_matrix_v(rnd.data[1][0], rnd.data[1][1] + 8.f, 0.5f));
+    }
+    return matrix_4f_mul_v(matrix_4f_translation_matrix_v(rnd.data[2][0], rnd.data[2][1], rnd.data[2][2]), mat);
+}
+
+/* product of a matrix and it's computed inverse */
+static Bool matrix_4f_test_is_inverse(const Matrix4f* mat, const Matrix4f* inv) {
+    Matrix4f prod = matrix_4f_mul_v_scalar(*mat, *inv);
+    for(Size r = 0; r < 4; r++) {
+        for(Size c = 0; c < 4; c++) {
+            if(fabsf(prod.data[r][c] - (r == c)) > 1e-4f) {
+                return False;
+            }
+        }
+    }
+    return True;
+}
+
+TEST_FN Bool AddSub_WHEN_VECTORIZED_THEN_SAME_AS_SCALAR() {
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        Matrix4f m1, m2;
+        matrix_4f_test_fill(&m1, i);
+        matrix_4f_test_fill(&m2, ~i);
+
+        /* additions and subtractions are exact per entry, so no tolerance is needed */
+        Matrix4f sum = matrix_4f_add_v(m1, m2), sum_ref = matrix_4f_add_v_scalar(m1, m2);
+        Matrix4f dif = matrix_4f_sub_v(m1, m2), dif_ref = matrix_4f_sub_v_scalar(m1, m2);
+        TEST_EQUALITY(!memcmp(&sum, &sum_ref, sizeof(Matrix4f)));
+        TEST_EQUALITY(!memcmp(&dif, &dif_ref, sizeof(Matrix4f)));
+
+        matrix_4f_add(&m1, &m2);
+        TEST_EQUALITY(!memcmp(&m1, &sum_ref, sizeof(Matrix4f)));
+        matrix_4f_sub(&m1, &m2);
+        matrix_4f_sub(&m1, &m1);
+        TEST_EQUALITY(!memcmp(&m1, &(Matrix4f) {0}, sizeof(Matrix4f)));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Mul_WHEN_VECTORIZED_THEN_SAME_AS_SCALAR() {
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        Matrix4f m1, m2;
+        matrix_4f_test_fill(&m1, i);
+        matrix_4f_test_fill(&m2, ~i);
+
+        Matrix4f prod = matrix_4f_mul_v(m1, m2), ref = matrix_4f_mul_v_scalar(m1, m2);
+        TEST_EQUALITY(matrix_4f_test_near(&prod, &ref));
+
+        /* not commutative, so swapped operands must be checked too */
+        prod = matrix_4f_mul_v(m2, m1);
+        ref  = matrix_4f_mul_v_scalar(m2, m1);
+        TEST_EQUALITY(matrix_4f_test_near(&prod, &ref));
+
+        ref = matrix_4f_mul_v_scalar(m1, m2);
+        matrix_4f_mul(&m1, &m2);
+        TEST_EQUALITY(matrix_4f_test_near(&m1, &ref));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Mul_WHEN_BOTH_OPERANDS_ARE_SAME_MATRIX() {
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        Matrix4f m;
+        matrix_4f_test_fill(&m, i);
+        Matrix4f ref = matrix_4f_mul_v_scalar(m, m);
+
+        /* entries of m must not be read after they're overwritten by product */
+        matrix_4f_mul(&m, &m);
+        TEST_EQUALITY(matrix_4f_test_near(&m, &ref));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool MulN_WHEN_PAIRS_AND_TAIL_THEN_SAME_AS_SCALAR() {
+    Matrix4f m1[MATRIX_4F_TEST_COUNT], m2[MATRIX_4F_TEST_COUNT];
+    Matrix4f dst[MATRIX_4F_TEST_COUNT], ref[MATRIX_4F_TEST_COUNT];
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        matrix_4f_test_fill(m1 + i, i);
+        matrix_4f_test_fill(m2 + i, ~i);
+        ref[i] = matrix_4f_mul_v_scalar(m1[i], m2[i]);
+    }
+
+    /* every count, so both pairs and a single tail matrix are covered */
+    for(Size count = 0; count <= MATRIX_4F_TEST_COUNT; count++) {
+        memset(dst, 0, sizeof(dst));
+        matrix_4f_mul_n(dst, m1, m2, count);
+        for(Size i = 0; i < count; i++) {
+            TEST_EQUALITY(matrix_4f_test_near(dst + i, ref + i));
+        }
+        for(Size i = count; i < MATRIX_4F_TEST_COUNT; i++) {
+            TEST_EQUALITY(!memcmp(dst + i, &(Matrix4f) {0}, sizeof(Matrix4f)));
+        }
+    }
+
+    /* output may be same as either input */
+    memcpy(dst, m1, sizeof(dst));
+    matrix_4f_mul_n(dst, dst, m2, MATRIX_4F_TEST_COUNT);
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        TEST_EQUALITY(matrix_4f_test_near(dst + i, ref + i));
+    }
+    memcpy(dst, m2, sizeof(dst));
+    matrix_4f_mul_n(dst, m1, dst, MATRIX_4F_TEST_COUNT);
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        TEST_EQUALITY(matrix_4f_test_near(dst + i, ref + i));
+    }
+
+    /* matrix_4f_mul_array is same with a common left operand */
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        ref[i] = matrix_4f_mul_v_scalar(m1[0], m2[i]);
+    }
+    matrix_4f_mul_array(dst, m1, m2, MATRIX_4F_TEST_COUNT);
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        TEST_EQUALITY(matrix_4f_test_near(dst + i, ref + i));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Transpose_WHEN_VECTORIZED_THEN_ROWS_BECOME_COLUMNS() {
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        Matrix4f m;
+        matrix_4f_test_fill(&m, i);
+
+        Matrix4f t = matrix_4f_transpose_v(m);
+        for(Size r = 0; r < 4; r++) {
+            for(Size c = 0; c < 4; c++) {
+                TEST_EQUALITY(t.data[r][c] == m.data[c][r]);
+            }
+        }
+
+        matrix_4f_transpose(&t);
+        TEST_EQUALITY(!memcmp(&t, &m, sizeof(Matrix4f)));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Inverse_WHEN_INVERTIBLE() {
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        Matrix4f m, inv, into;
+        matrix_4f_test_fill_invertible(&m, i);
+
+        inv = m;
+        TEST_EQUALITY(matrix_4f_inverse(&inv));
+        TEST_EQUALITY(matrix_4f_test_is_inverse(&m, &inv));
+
+        TEST_EQUALITY(matrix_4f_inverse_into(&into, &m));
+        TEST_EQUALITY(!memcmp(&into, &inv, sizeof(Matrix4f)));
+
+        /* inverse of inverse is original matrix */
+        TEST_EQUALITY(matrix_4f_inverse_into(&into, &into));
+        TEST_EQUALITY(matrix_4f_test_is_inverse(&inv, &into));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Inverse_WHEN_AFFINE_OR_RIGID_THEN_SAME_AS_GENERAL() {
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        Matrix4f m = matrix_4f_test_affine(i, False);
+        Matrix4f inv = m;
+        TEST_EQUALITY(matrix_4f_affine_inverse(&inv));
+        TEST_EQUALITY(matrix_4f_test_is_inverse(&m, &inv));
+        TEST_EQUALITY(inv.data[3][0] == 0 && inv.data[3][1] == 0 && inv.data[3][2] == 0 && inv.data[3][3] == 1);
+
+        m   = matrix_4f_test_affine(i, True);
+        inv = m;
+        matrix_4f_rigid_inverse(&inv);
+        TEST_EQUALITY(matrix_4f_test_is_inverse(&m, &inv));
+
+        Matrix4f rigid = matrix_4f_rigid_inverse_v(m);
+        TEST_EQUALITY(!memcmp(&rigid, &inv, sizeof(Matrix4f)));
+
+        Matrix4f general = m;
+        TEST_EQUALITY(matrix_4f_inverse(&general));
+        TEST_EQUALITY(matrix_4f_test_near(&general, &inv));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Inverse_WHEN_SINGULAR_THEN_MATRIX_IS_UNCHANGED() {
+    /* a zero row gives an exactly zero determinant in every kernel */
+    Matrix4f m;
+    matrix_4f_test_fill(&m, 42);
+    m.data[1][0] = m.data[1][1] = m.data[1][2] = m.data[1][3] = 0;
+
+    Matrix4f copy = m, dst = {0};
+    TEST_EQUALITY(!matrix_4f_inverse(&copy));
+    TEST_EQUALITY(!memcmp(&copy, &m, sizeof(Matrix4f)));
+    TEST_EQUALITY(!matrix_4f_inverse_into(&dst, &m));
+    TEST_EQUALITY(!memcmp(&dst, &(Matrix4f) {0}, sizeof(Matrix4f)));
+
+    m.data[3][0] = m.data[3][1] = m.data[3][2] = 0;
+    m.data[3][3] = 1;
+    copy = m;
+    TEST_EQUALITY(!matrix_4f_affine_inverse(&copy));
+    TEST_EQUALITY(!memcmp(&copy, &m, sizeof(Matrix4f)));
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool InverseArray_WHEN_PAIRS_TAIL_AND_SINGULARS() {
+    Matrix4f src[MATRIX_4F_TEST_COUNT], dst[MATRIX_4F_TEST_COUNT];
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i++) {
+        matrix_4f_test_fill_invertible(src + i, i);
+    }
+
+    /* every third matrix singular, so they land in both halves of a pair and in tail */
+    for(Size i = 0; i < MATRIX_4F_TEST_COUNT; i += 3) {
+        memset(src[i].data[2], 0, sizeof(src[i].data[2]));
+    }
+
+    for(Size count = 0; count <= MATRIX_4F_TEST_COUNT; count++) {
+        memset(dst, 0, sizeof(dst));
+        TEST_LENGTH_EQ(matrix_4f_inverse_array(dst, src, count), (count + 2) / 3);
+        for(Size i = 0; i < count; i++) {
+            if(i % 3) {
+                TEST_EQUALITY(matrix_4f_test_is_inverse(src + i, dst + i));
+            } else {
+                TEST_EQUALITY(!memcmp(dst + i, src + i, sizeof(Matrix4f)));
+            }
+        }
+        for(Size i = count; i < MATRIX_4F_TEST_COUNT; i++) {
+            TEST_EQUALITY(!memcmp(dst + i, &(Matrix4f) {0}, sizeof(Matrix4f)));
+        }
+    }
+
+    /* in place */
+    memcpy(dst, src, sizeof(dst));
+    TEST_LENGTH_EQ(matrix_4f_inverse_array(dst, dst, MATRIX_4F_TEST_COUNT), 3);
+    for(Size i = 1; i < MATRIX_4F_TEST_COUNT; i += 3) {
+        TEST_EQUALITY(matrix_4f_test_is_inverse(src + i, dst + i));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(matrix_4f)
+    TEST(AddSub_WHEN_VECTORIZED_THEN_SAME_AS_SCALAR),
+    TEST(Mul_WHEN_VECTORIZED_THEN_SAME_AS_SCALAR),
+    TEST(Mul_WHEN_BOTH_OPERANDS_ARE_SAME_MATRIX),
+    TEST(MulN_WHEN_PAIRS_AND_TAIL_THEN_SAME_AS_SCALAR),
+    TEST(Transpose_WHEN_VECTORIZED_THEN_ROWS_BECOME_COLUMNS),
+    TEST(Inverse_WHEN_INVERTIBLE),
+    TEST(Inverse_WHEN_AFFINE_OR_RIGID_THEN_SAME_AS_GENERAL),
+    TEST(Inverse_WHEN_SINGULAR_THEN_MATRIX_IS_UNCHANGED),
+    TEST(InverseArray_WHEN_PAIRS_TAIL_AND_SINGULARS)
+END_TESTS()
@@ -0,0 +1,66 @@
+/**
+ * @file helpers.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Helpers for testing SIMD wrappers against plain loops over lanes.
+ * */
+
+#ifndef ANVIE_UTILS_TESTS_SIMD_HELPERS_H
+#define ANVIE_UTILS_TESTS_SIMD_HELPERS_H
+
+#include <Anvie/Types.h>
+
+/**
+ * Fill memory with pseudo random bytes. Same seed always gives same bytes,
+ * so a failing test can be reproduced.
+ *
+ * @param m Memory to fill.
+ * @param sz Number of bytes to fill.
+ * @param seed
+ * */
+static inline void simd_test_fill(void* m, Size sz, Uint64 seed) {
+    Uint8* p = m;
+    for(Size i = 0; i < sz; i++) {
+        /* splitmix64 */
+        Uint64 z = (seed += 0x9e3779b97f4a7c15ULL);
+        z        = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z        = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        p[i]     = (Uint8)(z ^ (z >> 31));
+    }
+}
+
+/* number of random registers each test checks */
+#define SIMD_TEST_ROUNDS 64
+
+/**
+ * Apply @p op to random registers of @p type lanes and compare each lane of
+ * result with @p expr, an expression of lanes @c a and @c b of inputs.
+ * Must be used inside a test function.
+ * */
+#define SIMD_TEST_BINARY_OP(op, type, expr)                                     \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {                    \
+        type x[SIMD_LANES(type)], y[SIMD_LANES(type)], r[SIMD_LANES(type)];     \
+        simd_test_fill(x, sizeof(x), round);                                    \
+        simd_test_fill(y, sizeof(y), ~round);                                   \
+        simd_storeu(r, op(simd_loadu(x), simd_loadu(y)));                       \
+        for(Size k = 0; k < SIMD_LANES(type); k++) {                            \
+            type a = x[k], b = y[k];                                            \
+            TEST_EQUALITY(r[k] == (type)(expr));                                \
+        }                                                                       \
+    }
+
+#endif // ANVIE_UTILS_TESTS_SIMD_HELPERS_H
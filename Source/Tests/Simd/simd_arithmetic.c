@@ -0,0 +1,78 @@
+/**
+ * @file simd_arithmetic.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Unit test for lane wise integer arithmetic of Simd wrappers.
+ * */
+
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include "helpers.h"
+
+TEST_FN Bool AddSub_WHEN_LANES_OVERFLOW_THEN_WRAP_AROUND() {
+    SIMD_TEST_BINARY_OP(simd_add_epi8, Uint8, a + b);
+    SIMD_TEST_BINARY_OP(simd_add_epi16, Uint16, a + b);
+    SIMD_TEST_BINARY_OP(simd_add_epi32, Uint32, a + b);
+    SIMD_TEST_BINARY_OP(simd_add_epi64, Uint64, a + b);
+    SIMD_TEST_BINARY_OP(simd_sub_epi8, Uint8, a - b);
+    SIMD_TEST_BINARY_OP(simd_sub_epi16, Uint16, a - b);
+    SIMD_TEST_BINARY_OP(simd_sub_epi32, Uint32, a - b);
+    SIMD_TEST_BINARY_OP(simd_sub_epi64, Uint64, a - b);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool AddsSubs_WHEN_LANES_OVERFLOW_THEN_SATURATE() {
+    SIMD_TEST_BINARY_OP(simd_adds_epu8, Uint8, MIN(a + b, 0xff));
+    SIMD_TEST_BINARY_OP(simd_subs_epu8, Uint8, a > b ? a - b : 0);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool MinMax_WHEN_SIGNED_AND_UNSIGNED() {
+    SIMD_TEST_BINARY_OP(simd_min_epi8, Int8, MIN(a, b));
+    SIMD_TEST_BINARY_OP(simd_min_epi16, Int16, MIN(a, b));
+    SIMD_TEST_BINARY_OP(simd_min_epi32, Int32, MIN(a, b));
+    SIMD_TEST_BINARY_OP(simd_max_epi8, Int8, MAX(a, b));
+    SIMD_TEST_BINARY_OP(simd_max_epi16, Int16, MAX(a, b));
+    SIMD_TEST_BINARY_OP(simd_max_epi32, Int32, MAX(a, b));
+
+    SIMD_TEST_BINARY_OP(simd_min_epu8, Uint8, MIN(a, b));
+    SIMD_TEST_BINARY_OP(simd_min_epu16, Uint16, MIN(a, b));
+    SIMD_TEST_BINARY_OP(simd_min_epu32, Uint32, MIN(a, b));
+    SIMD_TEST_BINARY_OP(simd_max_epu8, Uint8, MAX(a, b));
+    SIMD_TEST_BINARY_OP(simd_max_epu16, Uint16, MAX(a, b));
+    SIMD_TEST_BINARY_OP(simd_max_epu32, Uint32, MAX(a, b));
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Mullo_WHEN_PRODUCT_OVERFLOWS_THEN_KEEP_LOW_HALF() {
+    SIMD_TEST_BINARY_OP(simd_mullo_epi16, Uint16, (Uint32)a * b);
+    SIMD_TEST_BINARY_OP(simd_mullo_epi32, Uint32, (Uint64)a * b);
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(simd_arithmetic)
+    TEST(AddSub_WHEN_LANES_OVERFLOW_THEN_WRAP_AROUND),
+    TEST(AddsSubs_WHEN_LANES_OVERFLOW_THEN_SATURATE),
+    TEST(MinMax_WHEN_SIGNED_AND_UNSIGNED),
+    TEST(Mullo_WHEN_PRODUCT_OVERFLOWS_THEN_KEEP_LOW_HALF)
+END_TESTS()
@@ -0,0 +1,110 @@
+/**
+ * @file simd_bitwise.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Unit test for bitwise operations, shifts and popcounts of Simd wrappers.
+ * */
+
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include "helpers.h"
+
+/* shift counts below, at and above every lane width */
+static const Uint32 shift_counts[] = {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200};
+
+/**
+ * Shift random registers of @p type lanes by every count and compare each lane
+ * with @p expr, an expression of lane @c a, count @c c and lane width @c bits.
+ * */
+#define TEST_SHIFT_OP(op, type, expr)                                           \
+    for(Size i = 0; i < sizeof(shift_counts) / sizeof(shift_counts[0]); i++) {  \
+        for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {                \
+            type   x[SIMD_LANES(type)], r[SIMD_LANES(type)];                    \
+            Uint32 c    = shift_counts[i];                                      \
+            Uint32 bits = sizeof(type) * 8;                                     \
+            simd_test_fill(x, sizeof(x), round);                                \
+            simd_storeu(r, op(simd_loadu(x), c));                               \
+            for(Size k = 0; k < SIMD_LANES(type); k++) {                        \
+                type a = x[k];                                                  \
+                TEST_EQUALITY(r[k] == (type)(expr));                            \
+            }                                                                   \
+        }                                                                       \
+    }
+
+TEST_FN Bool Bitwise_WHEN_RANDOM_REGISTERS() {
+    SIMD_TEST_BINARY_OP(simd_and, Uint64, a & b);
+    SIMD_TEST_BINARY_OP(simd_or, Uint64, a | b);
+    SIMD_TEST_BINARY_OP(simd_xor, Uint64, a ^ b);
+    SIMD_TEST_BINARY_OP(simd_andnot, Uint64, ~a & b);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Shift_WHEN_COUNT_IS_LANE_WIDTH_OR_MORE() {
+    TEST_SHIFT_OP(simd_slli_epi16, Uint16, c < bits ? (Uint32)a << c : 0);
+    TEST_SHIFT_OP(simd_slli_epi32, Uint32, c < bits ? a << c : 0);
+    TEST_SHIFT_OP(simd_slli_epi64, Uint64, c < bits ? a << c : 0);
+    TEST_SHIFT_OP(simd_srli_epi16, Uint16, c < bits ? a >> c : 0);
+    TEST_SHIFT_OP(simd_srli_epi32, Uint32, c < bits ? a >> c : 0);
+    TEST_SHIFT_OP(simd_srli_epi64, Uint64, c < bits ? a >> c : 0);
+    TEST_SHIFT_OP(simd_srai_epi16, Int16, a >> MIN(c, bits - 1));
+    TEST_SHIFT_OP(simd_srai_epi32, Int32, a >> MIN(c, bits - 1));
+    TEST_SHIFT_OP(simd_srai_epi64, Int64, a >> MIN(c, bits - 1));
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Popcount_WHEN_RANDOM_REGISTERS() {
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {
+        Uint8 x[SIMD_LANES(Uint8)], r[SIMD_LANES(Uint8)];
+        Size  total = 0;
+        simd_test_fill(x, sizeof(x), round);
+
+        simd_storeu(r, simd_popcnt_epi8(simd_loadu(x)));
+        for(Size k = 0; k < SIMD_LANES(Uint8); k++) {
+            TEST_EQUALITY(r[k] == __builtin_popcount(x[k]));
+            total += r[k];
+        }
+        TEST_EQUALITY(simd_popcount(simd_loadu(x)) == total);
+    }
+
+    TEST_EQUALITY(simd_popcount(simd_setzero()) == 0);
+    TEST_EQUALITY(simd_popcount(simd_set1_epi8(-1)) == sizeof(MVec) * 8);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Testz_WHEN_ONLY_ONE_BIT_IS_SET() {
+    TEST_EQUALITY(simd_testz(simd_setzero()));
+
+    for(Size bit = 0; bit < sizeof(MVec) * 8; bit++) {
+        Uint8 x[sizeof(MVec)] = {0};
+        x[bit / 8]            = (Uint8)(1 << (bit % 8));
+        TEST_EQUALITY(!simd_testz(simd_loadu(x)));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(simd_bitwise)
+    TEST(Bitwise_WHEN_RANDOM_REGISTERS),
+    TEST(Shift_WHEN_COUNT_IS_LANE_WIDTH_OR_MORE),
+    TEST(Popcount_WHEN_RANDOM_REGISTERS),
+    TEST(Testz_WHEN_ONLY_ONE_BIT_IS_SET)
+END_TESTS()
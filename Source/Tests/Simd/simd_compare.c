@@ -0,0 +1,106 @@
+/**
+ * @file simd_compare.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Unit test for comparisions and masks of Simd wrappers.
+ * */
+
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include "helpers.h"
+
+/**
+ * Compare random registers of @p type lanes, about half of lanes being equal,
+ * through both @p op (lanes of all ones or zero) and @p op_mask (one bit per lane)
+ * and check these against @p expr of lanes @c a and @c b.
+ * */
+#define TEST_CMP_OP(op, op_mask, type, expr)                                    \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {                    \
+        type   x[SIMD_LANES(type)], y[SIMD_LANES(type)], r[SIMD_LANES(type)];   \
+        Uint64 mask = 0;                                                        \
+        simd_test_fill(x, sizeof(x), round);                                    \
+        simd_test_fill(y, sizeof(y), ~round);                                   \
+        for(Size k = 0; k < SIMD_LANES(type); k += 2) {                         \
+            y[k] = x[k];                                                        \
+        }                                                                       \
+        simd_storeu(r, op(simd_loadu(x), simd_loadu(y)));                       \
+        mask = (Uint64)op_mask(simd_loadu(x), simd_loadu(y));                   \
+        for(Size k = 0; k < SIMD_LANES(type); k++) {                            \
+            type a = x[k], b = y[k];                                            \
+            TEST_EQUALITY(r[k] == (type)((expr) ? -1 : 0));                     \
+            TEST_EQUALITY(((mask >> k) & 1) == (Uint64)(expr));                 \
+        }                                                                       \
+    }
+
+/* one bit per 2 byte lane, from every other bit of movemask of a vector compare */
+static inline Uint64 lanes_mask_epi16(MVec v) {
+    Uint64 bytes = (Uint64)simd_movemask_epi8(v);
+    Uint64 mask  = 0;
+    for(Size k = 0; k < SIMD_LANES(Int16); k++) {
+        mask |= ((bytes >> (2 * k)) & 1) << k;
+    }
+    return mask;
+}
+
+#define cmpeq_epi16_mask(v1, v2) lanes_mask_epi16(simd_cmpeq_epi16(v1, v2))
+#define cmpgt_epi16_mask(v1, v2) lanes_mask_epi16(simd_cmpgt_epi16(v1, v2))
+
+TEST_FN Bool Cmp_WHEN_HALF_OF_LANES_ARE_EQUAL() {
+    TEST_CMP_OP(simd_cmpeq_epi8, simd_cmpeq_epi8_mask, Int8, a == b);
+    TEST_CMP_OP(simd_cmpgt_epi8, simd_cmpgt_epi8_mask, Int8, a > b);
+    TEST_CMP_OP(simd_cmpeq_epi32, simd_cmpeq_epi32_mask, Int32, a == b);
+    TEST_CMP_OP(simd_cmpgt_epi32, simd_cmpgt_epi32_mask, Int32, a > b);
+    TEST_CMP_OP(simd_cmpeq_epi64, simd_cmpeq_epi64_mask, Int64, a == b);
+    TEST_CMP_OP(simd_cmpgt_epi64, simd_cmpgt_epi64_mask, Int64, a > b);
+
+    TEST_CMP_OP(simd_cmpeq_epi16, cmpeq_epi16_mask, Int16, a == b);
+    TEST_CMP_OP(simd_cmpgt_epi16, cmpgt_epi16_mask, Int16, a > b);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Movemask_WHEN_RANDOM_REGISTERS() {
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {
+        Uint8 x[SIMD_LANES(Uint8)];
+        simd_test_fill(x, sizeof(x), round);
+
+        Uint64 mask = (Uint64)simd_movemask_epi8(simd_loadu(x));
+        for(Size k = 0; k < SIMD_LANES(Uint8); k++) {
+            TEST_EQUALITY(((mask >> k) & 1) == (Uint64)(x[k] >> 7));
+        }
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Tzcnt_WHEN_MASK_IS_ZERO_THEN_GIVE_REGISTER_BITS() {
+    TEST_EQUALITY(simd_tzcnt(0) == sizeof(MVec) * 8);
+    for(Uint32 bit = 0; bit < 64; bit++) {
+        TEST_EQUALITY(simd_tzcnt((Uint64)1 << bit) == bit);
+        TEST_EQUALITY(simd_tzcnt(~(Uint64)0 << bit) == bit);
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(simd_compare)
+    TEST(Cmp_WHEN_HALF_OF_LANES_ARE_EQUAL),
+    TEST(Movemask_WHEN_RANDOM_REGISTERS),
+    TEST(Tzcnt_WHEN_MASK_IS_ZERO_THEN_GIVE_REGISTER_BITS)
+END_TESTS()
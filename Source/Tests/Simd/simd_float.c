@@ -0,0 +1,140 @@
+/**
+ * @file simd_float.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Unit test for float operations of Simd wrappers.
+ * */
+
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <math.h>
+
+#include "helpers.h"
+
+/* random floats in [-100, 100), with a few lanes repeated across inputs to test equality */
+static inline void fill_floats(Float32* x, Float32* y, Uint64 seed) {
+    Uint32 bits[SIMD_LANES(Float32) * 2];
+    simd_test_fill(bits, sizeof(bits), seed);
+    for(Size k = 0; k < SIMD_LANES(Float32); k++) {
+        x[k] = (Float32)(bits[k] % 20000) / 100.f - 100.f;
+        y[k] = k % 3 ? (Float32)(bits[k + SIMD_LANES(Float32)] % 20000) / 100.f - 100.f : x[k];
+    }
+}
+
+/* apply @p op to random registers and compare each lane with @p expr of lanes @c a and @c b */
+#define TEST_FLOAT_OP(op, expr)                                         \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {            \
+        Float32 x[SIMD_LANES(Float32)], y[SIMD_LANES(Float32)], r[SIMD_LANES(Float32)]; \
+        fill_floats(x, y, round);                                       \
+        simd_storeu_ps(r, op(simd_loadu_ps(x), simd_loadu_ps(y)));      \
+        for(Size k = 0; k < SIMD_LANES(Float32); k++) {                 \
+            Float32 a = x[k], b = y[k];                                 \
+            TEST_EQUALITY(r[k] == (Float32)(expr));                     \
+        }                                                               \
+    }
+
+/* compare random registers through @p op and check each bit of mask against @p expr */
+#define TEST_FLOAT_CMP_OP(op, expr)                                     \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {            \
+        Float32 x[SIMD_LANES(Float32)], y[SIMD_LANES(Float32)];         \
+        fill_floats(x, y, round);                                       \
+        x[round % SIMD_LANES(Float32)] = NAN;                           \
+        Uint64 mask = (Uint64)op(simd_loadu_ps(x), simd_loadu_ps(y));   \
+        for(Size k = 0; k < SIMD_LANES(Float32); k++) {                 \
+            Float32 a = x[k], b = y[k];                                 \
+            TEST_EQUALITY(((mask >> k) & 1) == (Uint64)(expr));         \
+        }                                                               \
+    }
+
+TEST_FN Bool Arithmetic_WHEN_RANDOM_REGISTERS() {
+    TEST_FLOAT_OP(simd_add_ps, a + b);
+    TEST_FLOAT_OP(simd_sub_ps, a - b);
+    TEST_FLOAT_OP(simd_mul_ps, a * b);
+    TEST_FLOAT_OP(simd_div_ps, a / b);
+    TEST_FLOAT_OP(simd_min_ps, a < b ? a : b);
+    TEST_FLOAT_OP(simd_max_ps, a > b ? a : b);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool SqrtFmadd_WHEN_RANDOM_REGISTERS() {
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {
+        Float32 x[SIMD_LANES(Float32)], y[SIMD_LANES(Float32)], r[SIMD_LANES(Float32)], s[SIMD_LANES(Float32)];
+        fill_floats(x, y, round);
+
+        MVecF vx = simd_loadu_ps(x), vy = simd_loadu_ps(y);
+        simd_storeu_ps(r, simd_fmadd_ps(vx, vy, vx));
+        simd_storeu_ps(s, simd_sqrt_ps(simd_mul_ps(vx, vx)));
+        for(Size k = 0; k < SIMD_LANES(Float32); k++) {
+            /* fused or not, result is within rounding of one multiply */
+            TEST_EQUALITY(fabsf(r[k] - (x[k] * y[k] + x[k])) <= 1e-3f);
+            TEST_EQUALITY(s[k] == sqrtf(x[k] * x[k]));
+        }
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Cmp_WHEN_A_LANE_IS_NAN_THEN_COMPARE_FALSE() {
+    TEST_FLOAT_CMP_OP(simd_cmpeq_ps_mask, a == b);
+    TEST_FLOAT_CMP_OP(simd_cmplt_ps_mask, a < b);
+    TEST_FLOAT_CMP_OP(simd_cmple_ps_mask, a <= b);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool ReduceAdd_WHEN_LANES_ARE_SMALL_INTEGERS() {
+    Float32 x[SIMD_LANES(Float32)];
+    Float32 sum = 0;
+    for(Size k = 0; k < SIMD_LANES(Float32); k++) {
+        x[k] = (Float32)k - 3.f;
+        sum += x[k];
+    }
+
+    /* integers add exactly in any order */
+    TEST_EQUALITY(simd_reduce_add_ps(simd_loadu_ps(x)) == sum);
+    TEST_EQUALITY(simd_reduce_add_ps(simd_setzero_ps()) == 0.f);
+    TEST_EQUALITY(simd_reduce_add_ps(simd_set1_ps(0.5f)) == 0.5f * SIMD_LANES(Float32));
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool Convert_WHEN_FLOATS_HAVE_FRACTIONS_THEN_TRUNCATE() {
+    Int32   i[SIMD_LANES(Int32)], r[SIMD_LANES(Int32)];
+    Float32 f[SIMD_LANES(Float32)];
+    for(Size k = 0; k < SIMD_LANES(Int32); k++) {
+        i[k] = (Int32)k * 1000 - 7777;
+    }
+
+    simd_storeu_ps(f, simd_cvtepi32_ps(simd_loadu(i)));
+    simd_storeu(r, simd_cvttps_epi32(simd_add_ps(simd_loadu_ps(f), simd_set1_ps(0.75f))));
+    for(Size k = 0; k < SIMD_LANES(Int32); k++) {
+        TEST_EQUALITY(f[k] == (Float32)i[k]);
+        TEST_EQUALITY(r[k] == (Int32)((Float32)i[k] + 0.75f));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(simd_float)
+    TEST(Arithmetic_WHEN_RANDOM_REGISTERS),
+    TEST(SqrtFmadd_WHEN_RANDOM_REGISTERS),
+    TEST(Cmp_WHEN_A_LANE_IS_NAN_THEN_COMPARE_FALSE),
+    TEST(ReduceAdd_WHEN_LANES_ARE_SMALL_INTEGERS),
+    TEST(Convert_WHEN_FLOATS_HAVE_FRACTIONS_THEN_TRUNCATE)
+END_TESTS()
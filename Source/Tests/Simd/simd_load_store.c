@@ -0,0 +1,181 @@
+/**
+ * @file simd_load_store.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Unit test for loads, stores, compress and gather of Simd wrappers.
+ * */
+
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <stdlib.h>
+
+#include "helpers.h"
+
+/* mask with one bit set for each lane of @p type */
+#define ALL_LANES(type) (SIMD_LANES(type) == 64 ? ~(Uint64)0 : ((Uint64)1 << SIMD_LANES(type)) - 1)
+
+TEST_FN Bool Set1_WHEN_EVERY_LANE_WIDTH() {
+    Int8  x8[SIMD_LANES(Int8)];
+    Int16 x16[SIMD_LANES(Int16)];
+    Int32 x32[SIMD_LANES(Int32)];
+    Int64 x64[SIMD_LANES(Int64)];
+    Uint8 zero[sizeof(MVec)];
+
+    simd_storeu(x8, simd_set1_epi8(-3));
+    simd_storeu(x16, simd_set1_epi16(-300));
+    simd_storeu(x32, simd_set1_epi32(-70000));
+    simd_storeu(x64, simd_set1_epi64(-5000000000));
+    simd_storeu(zero, simd_setzero());
+
+    for(Size k = 0; k < sizeof(MVec); k++) {
+        TEST_EQUALITY(x8[k] == -3);
+        TEST_EQUALITY(zero[k] == 0);
+        TEST_EQUALITY(k >= SIMD_LANES(Int16) || x16[k] == -300);
+        TEST_EQUALITY(k >= SIMD_LANES(Int32) || x32[k] == -70000);
+        TEST_EQUALITY(k >= SIMD_LANES(Int64) || x64[k] == -5000000000);
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool BroadcastSi128_WHEN_TABLE_OF_16_BYTES() {
+    Uint8 table[16], r[sizeof(MVec)];
+    simd_test_fill(table, sizeof(table), 16);
+
+    simd_storeu(r, simd_broadcast_si128(table));
+    for(Size k = 0; k < sizeof(MVec); k++) {
+        TEST_EQUALITY(r[k] == table[k % 16]);
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+/**
+ * Compress random registers of @p type lanes with random masks, and check that
+ * selected lanes are stored in order and counted.
+ * */
+#define TEST_COMPRESS_OP(op, type)                                              \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {                    \
+        type   x[SIMD_LANES(type)], r[SIMD_LANES(type)];                        \
+        Uint64 mask;                                                            \
+        Size   count = 0;                                                       \
+        simd_test_fill(x, sizeof(x), round);                                    \
+        simd_test_fill(&mask, sizeof(mask), ~round);                            \
+        mask &= ALL_LANES(type);                                                \
+                                                                                \
+        TEST_EQUALITY(op(r, (MMask)mask, simd_loadu(x)) == (Size)__builtin_popcountll(mask)); \
+        for(Size k = 0; k < SIMD_LANES(type); k++) {                            \
+            if((mask >> k) & 1) {                                               \
+                TEST_EQUALITY(r[count++] == x[k]);                              \
+            }                                                                   \
+        }                                                                       \
+    }
+
+TEST_FN Bool CompressStoreu_WHEN_RANDOM_MASKS() {
+    TEST_COMPRESS_OP(simd_compress_storeu_epi32, Int32);
+    TEST_COMPRESS_OP(simd_compress_storeu_epi64, Int64);
+
+    DO_BEFORE_EXIT({});
+}
+
+/**
+ * Load and store only lanes of random masks. Lanes not selected must load as
+ * zero and their memory must be left as it was by stores.
+ * */
+#define TEST_MASK_LOAD_STORE_OP(load, store, type)                              \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {                    \
+        type   x[SIMD_LANES(type)], r[SIMD_LANES(type)], m[SIMD_LANES(type)];   \
+        Uint64 mask;                                                            \
+        simd_test_fill(x, sizeof(x), round);                                    \
+        simd_test_fill(m, sizeof(m), ~round);                                   \
+        simd_test_fill(&mask, sizeof(mask), round * 7);                         \
+        mask &= ALL_LANES(type);                                                \
+                                                                                \
+        simd_storeu(r, load(x, (MMask)mask));                                   \
+        memcpy(x, m, sizeof(m));                                                \
+        store(m, (MMask)mask, simd_loadu(r));                                   \
+        for(Size k = 0; k < SIMD_LANES(type); k++) {                            \
+            Bool selected = (mask >> k) & 1;                                    \
+            TEST_EQUALITY(selected || r[k] == 0);                               \
+            TEST_EQUALITY(m[k] == (selected ? r[k] : x[k]));                    \
+        }                                                                       \
+    }
+
+TEST_FN Bool MaskLoadStore_WHEN_RANDOM_MASKS() {
+    TEST_MASK_LOAD_STORE_OP(simd_maskz_loadu_epi32, simd_mask_storeu_epi32, Int32);
+    TEST_MASK_LOAD_STORE_OP(simd_maskz_loadu_epi64, simd_mask_storeu_epi64, Int64);
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool MaskLoad_WHEN_ARRAY_IS_SHORTER_THAN_REGISTER() {
+    /* heap allocation of exactly n lanes, so reading past it is caught by address sanitizer */
+    Size   n = SIMD_LANES(Int32) - 1;
+    Int32* a = malloc(n * sizeof(Int32));
+    Int32  r[SIMD_LANES(Int32)];
+    TEST_OBJECT(a);
+
+    for(Size k = 0; k < n; k++) {
+        a[k] = (Int32)k + 1;
+    }
+    simd_storeu(r, simd_maskz_loadu_epi32(a, (MMask)(((Uint64)1 << n) - 1)));
+    simd_mask_storeu_epi32(a, (MMask)(((Uint64)1 << n) - 1), simd_add_epi32(simd_loadu(r), simd_loadu(r)));
+    for(Size k = 0; k < n; k++) {
+        TEST_EQUALITY(r[k] == (Int32)k + 1);
+        TEST_EQUALITY(a[k] == 2 * ((Int32)k + 1));
+    }
+    TEST_EQUALITY(r[n] == 0);
+
+    DO_BEFORE_EXIT({
+        free(a);
+    });
+}
+
+/**
+ * Gather lanes from a table of @p type at random indices.
+ * */
+#define TEST_GATHER_OP(op, type)                                                \
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {                    \
+        type table[256], idx[SIMD_LANES(type)], r[SIMD_LANES(type)];            \
+        simd_test_fill(table, sizeof(table), round);                            \
+        simd_test_fill(idx, sizeof(idx), ~round);                               \
+        for(Size k = 0; k < SIMD_LANES(type); k++) {                            \
+            idx[k] = (type)((Uint64)idx[k] % 256);                              \
+        }                                                                       \
+                                                                                \
+        simd_storeu(r, op(table, simd_loadu(idx)));                             \
+        for(Size k = 0; k < SIMD_LANES(type); k++) {                            \
+            TEST_EQUALITY(r[k] == table[idx[k]]);                               \
+        }                                                                       \
+    }
+
+TEST_FN Bool Gather_WHEN_RANDOM_INDICES() {
+    TEST_GATHER_OP(simd_gather_epi32, Int32);
+    TEST_GATHER_OP(simd_gather_epi64, Int64);
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(simd_load_store)
+    TEST(Set1_WHEN_EVERY_LANE_WIDTH),
+    TEST(BroadcastSi128_WHEN_TABLE_OF_16_BYTES),
+    TEST(CompressStoreu_WHEN_RANDOM_MASKS),
+    TEST(MaskLoadStore_WHEN_RANDOM_MASKS),
+    TEST(MaskLoad_WHEN_ARRAY_IS_SHORTER_THAN_REGISTER),
+    TEST(Gather_WHEN_RANDOM_INDICES)
+END_TESTS()
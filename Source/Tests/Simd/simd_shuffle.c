@@ -0,0 +1,60 @@
+/**
+ * @file simd_shuffle.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @brief Unit test for byte shuffles of Simd wrappers.
+ * */
+
+#include <Anvie/Simd/Simd.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+
+#include "helpers.h"
+
+TEST_FN Bool ShuffleEpi8_WHEN_TABLE_IS_BROADCAST() {
+    for(Size round = 0; round < SIMD_TEST_ROUNDS; round++) {
+        Uint8 table[16], idx[sizeof(MVec)], r[sizeof(MVec)];
+        simd_test_fill(table, sizeof(table), round);
+        simd_test_fill(idx, sizeof(idx), ~round);
+
+        simd_storeu(r, simd_shuffle_epi8(simd_broadcast_si128(table), simd_loadu(idx)));
+        for(Size k = 0; k < sizeof(MVec); k++) {
+            /* index with highest bit set gives zero, otherwise only low 4 bits are used */
+            TEST_EQUALITY(r[k] == (idx[k] & 0x80 ? 0 : table[idx[k] & 0x0f]));
+        }
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+TEST_FN Bool ShuffleEpi8_WHEN_TABLE_DIFFERS_PER_128_BIT_LANE() {
+    Uint8 table[sizeof(MVec)], idx[sizeof(MVec)], r[sizeof(MVec)];
+    simd_test_fill(table, sizeof(table), 3);
+    simd_test_fill(idx, sizeof(idx), 4);
+
+    simd_storeu(r, simd_shuffle_epi8(simd_loadu(table), simd_loadu(idx)));
+    for(Size k = 0; k < sizeof(MVec); k++) {
+        TEST_EQUALITY(r[k] == (idx[k] & 0x80 ? 0 : table[(k & ~(Size)15) + (idx[k] & 0x0f)]));
+    }
+
+    DO_BEFORE_EXIT({});
+}
+
+BEGIN_TESTS(simd_shuffle)
+    TEST(ShuffleEpi8_WHEN_TABLE_IS_BROADCAST),
+    TEST(ShuffleEpi8_WHEN_TABLE_DIFFERS_PER_128_BIT_LANE)
+END_TESTS()
@@ -0,0 +1,83 @@
+/**
+ * @file TestThreads.h
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Helper to run a worker on several threads at once in unit tests.
+ * */
+
+#ifndef ANVIE_UTILS_TESTS_TEST_THREADS_H
+#define ANVIE_UTILS_TESTS_TEST_THREADS_H
+
+#include <Anvie/Types.h>
+#include <pthread.h>
+#include <sched.h>
+
+/* most threads a single test can start */
+#define TEST_THREADS_MAX 16
+
+typedef void* (*TestThreadFn)(void* arg);
+
+typedef struct TestThread {
+    TestThreadFn  worker;
+    void*         arg;
+    volatile int* gate; /**< 0 while threads are being started, 1 to run worker, -1 to give up */
+} TestThread;
+
+static void* test_thread_main(void* arg) {
+    TestThread* t = arg;
+    int         gate;
+    while(!(gate = __atomic_load_n(t->gate, __ATOMIC_ACQUIRE))) {
+        sched_yield();
+    }
+    return gate > 0 ? t->worker(t->arg) : NULL;
+}
+
+/**
+ * Run @p worker on @p count threads, with argument @c args + i * @p arg_size
+ * for i-th thread, and wait for all of them. Workers run only once every
+ * thread has started, so workers can safely wait on a barrier of @p count
+ * threads : if a thread can't be started, none of them runs worker.
+ *
+ * @return True if all workers ran, False otherwise.
+ * */
+static inline Bool test_run_threads(Size count, TestThreadFn worker, void* args, Size arg_size) {
+    pthread_t    threads[TEST_THREADS_MAX];
+    TestThread   t[TEST_THREADS_MAX];
+    volatile int gate    = 0;
+    Size         started = 0;
+
+    if(count > TEST_THREADS_MAX) {
+        return False;
+    }
+
+    for(; started < count; started++) {
+        t[started] = (TestThread) {worker, (Uint8*)args + started * arg_size, &gate};
+        if(pthread_create(threads + started, NULL, test_thread_main, t + started)) {
+            break;
+        }
+    }
+
+    __atomic_store_n(&gate, started == count ? 1 : -1, __ATOMIC_RELEASE);
+    for(Size i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    return started == count;
+}
+
+#endif // ANVIE_UTILS_TESTS_TEST_THREADS_H
@@ -0,0 +1,273 @@
+/**
+ * @file thread_pool.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Unit test for ThreadPool : parallel_for coverage, nested task groups,
+ * growth of a worker deque, spawns from threads outside the pool, and
+ * destroying a pool while it's workers sleep.
+ * */
+
+
+#include <Anvie/ThreadPool.h>
+#include <Anvie/Test/UnitTest.h>
+#include <Anvie/Error.h>
+#include <unistd.h>
+
+#include "TestThreads.h"
+
+#define TPOOL_TEST_THREADS 4
+#define TPOOL_TEST_RANGE   100003
+
+/* more than a worker deque holds before it has to grow, see TASK_DEQUE_INITIAL_CAPACITY */
+#define TPOOL_TEST_SPAWNS 1000
+
+/* levels of binary tree of nested groups, one task per node */
+#define TPOOL_TEST_DEPTH 10
+
+static void tpool_test_count_range(Size begin, Size end, void* udata) {
+    Uint32* counts = udata;
+    for(Size i = begin; i < end; i++) {
+        __atomic_fetch_add(counts + i, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/* run parallel_for over [begin, end) and check every index in it was visited once, and no other */
+static Bool tpool_test_parallel_for(ThreadPool* pool, Uint32* counts, Size begin, Size end, Size grain) {
+    memset(counts, 0, TPOOL_TEST_RANGE * sizeof(Uint32));
+    parallel_for(pool, begin, end, grain, tpool_test_count_range, counts);
+
+    for(Size i = 0; i < TPOOL_TEST_RANGE; i++) {
+        if(counts[i] != (i >= begin && i < end)) {
+            return False;
+        }
+    }
+    return True;
+}
+
+TEST_FN Bool ParallelFor_WHEN_RANGE_THEN_EVERY_INDEX_ONCE() {
+    ThreadPool* pool   = thread_pool_create(TPOOL_TEST_THREADS);
+    Uint32*     counts = ALLOCATE(Uint32, TPOOL_TEST_RANGE);
+    TEST_OBJECT(pool);
+    TEST_OBJECT(counts);
+    TEST_LENGTH_EQ(thread_pool_get_thread_count(pool), TPOOL_TEST_THREADS);
+
+    /* automatic grain, smallest grain, a grain not dividing range, and a single call */
+    Size grains[] = {0, 1, 13, TPOOL_TEST_RANGE};
+    for(Size g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+        TEST_EQUALITY(tpool_test_parallel_for(pool, counts, 0, TPOOL_TEST_RANGE, grains[g]));
+        TEST_EQUALITY(tpool_test_parallel_for(pool, counts, 7, TPOOL_TEST_RANGE - 5, grains[g]));
+    }
+
+    /* empty and single index ranges, and default pool */
+    TEST_EQUALITY(tpool_test_parallel_for(pool, counts, 11, 11, 0));
+    TEST_EQUALITY(tpool_test_parallel_for(pool, counts, 11, 12, 0));
+    TEST_EQUALITY(tpool_test_parallel_for(NULL, counts, 3, TPOOL_TEST_RANGE, 0));
+
+    DO_BEFORE_EXIT(
+        if(pool) thread_pool_destroy(pool);
+        FREE(counts);
+    );
+}
+
+typedef struct TpoolTestNode {
+    ThreadPool* pool;
+    Size        depth;
+    Size*       leaves;
+} TpoolTestNode;
+
+/* spawn both children into a group of it's own and wait for them, leaves count themselves */
+static void tpool_test_node(void* udata) {
+    TpoolTestNode* node = udata;
+    if(!node->depth) {
+        __atomic_fetch_add(node->leaves, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    TpoolTestNode children[2] = {
+        {node->pool, node->depth - 1, node->leaves},
+        {node->pool, node->depth - 1, node->leaves}
+    };
+
+    TaskGroup group;
+    task_group_init(&group, node->pool);
+    task_group_spawn(&group, tpool_test_node, children);
+    task_group_spawn(&group, tpool_test_node, children + 1);
+    task_group_wait(&group);
+}
+
+TEST_FN Bool TaskGroup_WHEN_TASKS_SPAWN_AND_WAIT_FOR_NESTED_GROUPS() {
+    /* fewer workers than levels, so every worker has to run tasks while it waits */
+    ThreadPool* pool = thread_pool_create(2);
+    TEST_OBJECT(pool);
+
+    Size          leaves = 0;
+    TpoolTestNode root   = {pool, TPOOL_TEST_DEPTH, &leaves};
+
+    TaskGroup group;
+    task_group_init(&group, pool);
+    task_group_spawn(&group, tpool_test_node, &root);
+    task_group_wait(&group);
+    TEST_LENGTH_EQ(leaves, (Size)1 << TPOOL_TEST_DEPTH);
+    TEST_LENGTH_EQ(group.pending, 0);
+
+    /* a group can be reused once waited for */
+    leaves = 0;
+    task_group_spawn(&group, tpool_test_node, &root);
+    task_group_wait(&group);
+    TEST_LENGTH_EQ(leaves, (Size)1 << TPOOL_TEST_DEPTH);
+
+    DO_BEFORE_EXIT(
+        if(pool) thread_pool_destroy(pool);
+    );
+}
+
+typedef struct TpoolTestFanOut {
+    ThreadPool* pool;
+    Size        worker;  /* worker that spawned children */
+    Size        ran;     /* children that ran */
+    Bool        release; /* children wait for this, so they can't drain deque while it's filled */
+    Bool        done;
+} TpoolTestFanOut;
+
+static void tpool_test_fan_out_child(void* udata) {
+    TpoolTestFanOut* f = udata;
+    while(!__atomic_load_n(&f->release, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    __atomic_fetch_add(&f->ran, 1, __ATOMIC_RELAXED);
+}
+
+static void tpool_test_fan_out(void* udata) {
+    TpoolTestFanOut* f = udata;
+    f->worker          = thread_pool_current_worker();
+
+    /*
+     * A thief takes at most one child before it blocks in it, so all other
+     * children pile up in deque of this worker, which has to grow.
+     */
+    TaskGroup group;
+    task_group_init(&group, f->pool);
+    for(Size i = 0; i < TPOOL_TEST_SPAWNS; i++) {
+        task_group_spawn(&group, tpool_test_fan_out_child, f);
+    }
+    __atomic_store_n(&f->release, True, __ATOMIC_RELEASE);
+    task_group_wait(&group);
+
+    __atomic_store_n(&f->done, True, __ATOMIC_RELEASE);
+}
+
+TEST_FN Bool Spawn_WHEN_MORE_TASKS_THAN_WORKER_DEQUE_HOLDS() {
+    ThreadPool* pool = thread_pool_create(2);
+    TEST_OBJECT(pool);
+
+    TpoolTestFanOut f = {.pool = pool};
+    TaskGroup       group;
+    task_group_init(&group, pool);
+    task_group_spawn(&group, tpool_test_fan_out, &f);
+
+    /* not waiting on group, that would let this thread take the task and spawn from outside pool */
+    while(!__atomic_load_n(&f.done, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    task_group_wait(&group);
+
+    TEST_LENGTH_LT(f.worker, 2);
+    TEST_LENGTH_EQ(f.ran, TPOOL_TEST_SPAWNS);
+
+    DO_BEFORE_EXIT(
+        if(pool) thread_pool_destroy(pool);
+    );
+}
+
+typedef struct TpoolTestSpawner {
+    ThreadPool* pool;
+    Size        ran;
+} TpoolTestSpawner;
+
+static void tpool_test_spawned(void* udata) {
+    TpoolTestSpawner* s = udata;
+    __atomic_fetch_add(&s->ran, 1, __ATOMIC_RELAXED);
+}
+
+static void* tpool_test_spawner(void* arg) {
+    TpoolTestSpawner* s = arg;
+
+    TaskGroup group;
+    task_group_init(&group, s->pool);
+    for(Size i = 0; i < TPOOL_TEST_SPAWNS; i++) {
+        task_group_spawn(&group, tpool_test_spawned, s);
+    }
+    task_group_wait(&group);
+    return NULL;
+}
+
+TEST_FN Bool Spawn_WHEN_FROM_THREADS_OUTSIDE_POOL() {
+    ThreadPool* pool = thread_pool_create(TPOOL_TEST_THREADS);
+    TEST_OBJECT(pool);
+
+    /* calling thread is not a worker either */
+    TEST_LENGTH_EQ(thread_pool_current_worker(), SIZE_MAX);
+
+    TpoolTestSpawner spawners[TPOOL_TEST_THREADS];
+    for(Size t = 0; t < TPOOL_TEST_THREADS; t++) {
+        spawners[t] = (TpoolTestSpawner) {pool, 0};
+    }
+    TEST_EQUALITY(test_run_threads(TPOOL_TEST_THREADS, tpool_test_spawner, spawners, sizeof(TpoolTestSpawner)));
+
+    /* each group was complete when it's wait returned, whoever ran it's tasks */
+    for(Size t = 0; t < TPOOL_TEST_THREADS; t++) {
+        TEST_LENGTH_EQ(spawners[t].ran, TPOOL_TEST_SPAWNS);
+    }
+
+    DO_BEFORE_EXIT(
+        if(pool) thread_pool_destroy(pool);
+    );
+}
+
+TEST_FN Bool Destroy_WHEN_WORKERS_SLEEP() {
+    Uint32* counts = ALLOCATE(Uint32, TPOOL_TEST_RANGE);
+    TEST_OBJECT(counts);
+
+    for(Size round = 0; round < 4; round++) {
+        ThreadPool* pool = thread_pool_create(TPOOL_TEST_THREADS);
+        TEST_OBJECT(pool);
+        TEST_EQUALITY(tpool_test_parallel_for(pool, counts, 0, TPOOL_TEST_RANGE, 0));
+
+        /* idle workers spin a few rounds and then sleep, destroy must wake and join them */
+        usleep(20000);
+        thread_pool_destroy(pool);
+    }
+
+    /* and a pool that never had any work */
+    ThreadPool* idle = thread_pool_create(TPOOL_TEST_THREADS);
+    TEST_OBJECT(idle);
+    usleep(20000);
+    thread_pool_destroy(idle);
+
+    DO_BEFORE_EXIT(
+        FREE(counts);
+    );
+}
+
+BEGIN_TESTS(thread_pool)
+    TEST(ParallelFor_WHEN_RANGE_THEN_EVERY_INDEX_ONCE),
+    TEST(TaskGroup_WHEN_TASKS_SPAWN_AND_WAIT_FOR_NESTED_GROUPS),
+    TEST(Spawn_WHEN_MORE_TASKS_THAN_WORKER_DEQUE_HOLDS),
+    TEST(Spawn_WHEN_FROM_THREADS_OUTSIDE_POOL),
+    TEST(Destroy_WHEN_WORKERS_SLEEP)
+END_TESTS()
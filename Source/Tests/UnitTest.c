@@ -24,8 +24,13 @@
 
 IMPORT_UNIT_TEST(IntegerVector)
 IMPORT_UNIT_TEST(StructVector)
+IMPORT_UNIT_TEST(SmallVector)
 
 #include "Containers/ImportUnitTests.h"
+#include "Simd/ImportUnitTests.h"
+#include "Allocators/ImportUnitTests.h"
+#include "Maths/ImportUnitTests.h"
+#include "ThreadPool/ImportUnitTests.h"
 #include <Anvie/Containers/SparseMap.h>
 
 /* start running tests */
@@ -33,6 +38,7 @@ BEGIN_UNIT_TESTS()
 
     UNIT_TEST(IntegerVector)
     UNIT_TEST(StructVector)
+    UNIT_TEST(SmallVector)
 
     /* bitvector tests */
     UNIT_TEST(bitvec_create)
@@ -59,5 +65,86 @@ BEGIN_UNIT_TESTS()
     UNIT_TEST(bitvec_shr)
     UNIT_TEST(bitvec_not)
     UNIT_TEST(bitvec_cmpeq)
+    UNIT_TEST(bitvec_andnot)
+    UNIT_TEST(bitvec_and_into)
+    UNIT_TEST(bitvec_or_assign)
+    UNIT_TEST(bitvec_not_assign)
+    UNIT_TEST(bitvec_or_many)
+    UNIT_TEST(bitvec_popcount)
+    UNIT_TEST(bitvec_rank)
+    UNIT_TEST(bitvec_find_next_set)
+    UNIT_TEST(bitvec_foreach_set)
+    UNIT_TEST(bitvec_shl_assign)
+    UNIT_TEST(bitvec_shr_assign)
+
+    /* atomic bitvector tests */
+    UNIT_TEST(atomic_bitvec_claim)
+
+    /* concurrent map tests */
+    UNIT_TEST(concurrent_map)
+
+    /* snapshot map tests */
+    UNIT_TEST(snapshot_map)
+
+    /* queue tests */
+    UNIT_TEST(queue)
+
+    /* deserialization tests */
+    UNIT_TEST(deserialize)
+
+    /* zstring keyed map tests */
+    UNIT_TEST(zstr_map)
+
+    /* dense map tests */
+    UNIT_TEST(dense_map)
+
+    /* string tests */
+    UNIT_TEST(string)
+
+    /* btree tests */
+    UNIT_TEST(btree)
+
+    /* radix tree tests */
+    UNIT_TEST(radix_tree)
+
+    /* roaring bitmap tests */
+    UNIT_TEST(roaring)
+
+    /* deque tests */
+    UNIT_TEST(deque)
+
+    /* priority queue tests */
+    UNIT_TEST(priority_queue)
+
+    /* cache tests */
+    UNIT_TEST(cache)
+
+    /* frozen map tests */
+    UNIT_TEST(frozen_map)
+
+    /* group by tests */
+    UNIT_TEST(group_by)
+
+    /* pipeline tests */
+    UNIT_TEST(pipeline)
+
+    /* simd wrapper tests */
+    UNIT_TEST(simd_arithmetic)
+    UNIT_TEST(simd_bitwise)
+    UNIT_TEST(simd_compare)
+    UNIT_TEST(simd_load_store)
+    UNIT_TEST(simd_shuffle)
+    UNIT_TEST(simd_float)
+
+    /* allocator tests */
+    UNIT_TEST(cballoc)
+    UNIT_TEST(arena)
+    UNIT_TEST(slaballoc)
+
+    /* maths tests */
+    UNIT_TEST(matrix_4f)
+
+    /* thread pool tests */
+    UNIT_TEST(thread_pool)
 
 END_UNIT_TESTS()
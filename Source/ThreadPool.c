@@ -0,0 +1,625 @@
+/**
+ * @file ThreadPool.c
+ * @date Thu, 15th October, 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2023 Siddharth Mishra
+ * @copyright Copyright 2023 Anvie Labs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @brief Work stealing thread pool of @c Anvie/ThreadPool.h.
+ *
+ * Deques follow "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * by Lê, Pop, Cohen and Zappa Nardelli. A deque that fills up is copied into
+ * one twice it's size, and the old array is kept until pool is destroyed, as
+ * a thief might still be reading from it.
+ * */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* for pthread_setaffinity_np */
+#endif
+
+#include <Anvie/ThreadPool.h>
+#include <Anvie/Error.h>
+#include <Anvie/HelperDefines.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* number of tasks a worker deque can hold before it has to grow */
+#define TASK_DEQUE_INITIAL_CAPACITY 256
+
+/* rounds an idle worker looks for work, yielding in between, before it goes to sleep */
+#define WORKER_SPIN_ROUNDS 64
+
+/* parallel_for splits a range into about this many pieces per thread, when grain is not given */
+#define PARALLEL_FOR_SPLITS_PER_THREAD 8
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct Task {
+    TaskCallback        fn;
+    void*               udata;
+    TaskGroup*          group;
+    struct Task*        next;     /* link in shared queue of pool */
+    ParallelForCallback range_fn; /* set only for ranges of parallel_for */
+    Size                begin;
+    Size                end;
+    Size                grain;
+} Task;
+
+typedef struct TaskArray {
+    Size              capacity; /* always a power of two */
+    struct TaskArray* prev;     /* smaller array this one replaced */
+    Task*             slots[];
+} TaskArray;
+
+/* top is written by thieves and bottom only by owner, so they are kept on separate cache lines */
+typedef struct Worker {
+    Int64       top;
+    Uint8       top_pad[CACHE_LINE_SIZE - sizeof(Int64)];
+    Int64       bottom;
+    TaskArray*  array;
+    ThreadPool* pool;
+    Size        index;
+    pthread_t   thread;
+    Bool        started;
+    Uint8       bottom_pad[CACHE_LINE_SIZE];
+} Worker;
+
+struct ThreadPool {
+    Worker*         workers;
+    Size            thread_count;
+    Size            online_cpus;
+
+    /* tasks spawned from threads outside this pool */
+    pthread_mutex_t queue_lock;
+    Task*           queue_head;
+    Task*           queue_tail;
+    Size            queue_length;
+
+    /* idle workers sleep until epoch changes */
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t  sleep_cond;
+    Size            sleepers;
+    Uint64          epoch;
+    Bool            shutdown;
+};
+
+/* worker running on calling thread, NULL outside of any pool */
+static _Thread_local Worker* current_worker;
+
+/* state of xorshift used to pick a victim to steal from */
+static _Thread_local Uint64 steal_seed;
+
+static pthread_once_t default_pool_once = PTHREAD_ONCE_INIT;
+static ThreadPool*    default_pool;
+
+static Size online_cpu_count() {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    return ncpu > 0 ? (Size)ncpu : 1;
+}
+
+/* ----------------------------- worker deque ----------------------------- */
+
+static TaskArray* task_array_create(Size capacity) {
+    TaskArray* array = calloc(1, sizeof(TaskArray) + capacity * sizeof(Task*));
+    if(array) {
+        array->capacity = capacity;
+    }
+    return array;
+}
+
+/* replace full array of owner with one of twice the size, holding same tasks */
+static TaskArray* task_deque_grow(Worker* w, TaskArray* array, Int64 top, Int64 bottom) {
+    TaskArray* grown = task_array_create(array->capacity * 2);
+    RETURN_VALUE_IF_FAIL(grown, NULL, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+
+    for(Int64 i = top; i < bottom; i++) {
+        grown->slots[i & (grown->capacity - 1)] =
+            __atomic_load_n(&array->slots[i & (array->capacity - 1)], __ATOMIC_RELAXED);
+    }
+    grown->prev = array;
+    __atomic_store_n(&w->array, grown, __ATOMIC_RELEASE);
+    return grown;
+}
+
+/* push at bottom, only called by owner of deque */
+static Bool task_deque_push(Worker* w, Task* task) {
+    Int64      bottom = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED);
+    Int64      top    = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+    TaskArray* array  = __atomic_load_n(&w->array, __ATOMIC_RELAXED);
+
+    if(bottom - top > (Int64)array->capacity - 1) {
+        array = task_deque_grow(w, array, top, bottom);
+        if(!array) {
+            return False;
+        }
+    }
+
+    /* a release store instead of a release fence, same cost and sanitizers understand it */
+    __atomic_store_n(&array->slots[bottom & (array->capacity - 1)], task, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->bottom, bottom + 1, __ATOMIC_RELEASE);
+    return True;
+}
+
+/* pop from bottom, only called by owner of deque */
+static Task* task_deque_pop(Worker* w) {
+    Int64      bottom = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED) - 1;
+    TaskArray* array  = __atomic_load_n(&w->array, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    Int64 top = __atomic_load_n(&w->top, __ATOMIC_RELAXED);
+
+    if(top > bottom) {
+        /* deque was empty */
+        __atomic_store_n(&w->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    Task* task = __atomic_load_n(&array->slots[bottom & (array->capacity - 1)], __ATOMIC_RELAXED);
+    if(top == bottom) {
+        /* last task, race against thieves for it */
+        if(!__atomic_compare_exchange_n(&w->top, &top, top + 1, False, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            task = NULL;
+        }
+        __atomic_store_n(&w->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+    return task;
+}
+
+/* steal from top, called by any thread */
+static Task* task_deque_steal(Worker* w) {
+    Int64 top = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    Int64 bottom = __atomic_load_n(&w->bottom, __ATOMIC_ACQUIRE);
+
+    if(top >= bottom) {
+        return NULL;
+    }
+
+    TaskArray* array = __atomic_load_n(&w->array, __ATOMIC_ACQUIRE);
+    Task*      task  = __atomic_load_n(&array->slots[top & (array->capacity - 1)], __ATOMIC_RELAXED);
+    if(!__atomic_compare_exchange_n(&w->top, &top, top + 1, False, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return NULL;
+    }
+    return task;
+}
+
+/* ----------------------------- shared queue ----------------------------- */
+
+static void task_queue_push(ThreadPool* pool, Task* task) {
+    pthread_mutex_lock(&pool->queue_lock);
+    task->next = NULL;
+    if(pool->queue_tail) {
+        pool->queue_tail->next = task;
+    } else {
+        pool->queue_head = task;
+    }
+    pool->queue_tail = task;
+    __atomic_store_n(&pool->queue_length, pool->queue_length + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->queue_lock);
+}
+
+static Task* task_queue_pop(ThreadPool* pool) {
+    /* don't take the lock just to find queue empty */
+    if(!__atomic_load_n(&pool->queue_length, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pool->queue_lock);
+    Task* task = pool->queue_head;
+    if(task) {
+        pool->queue_head = task->next;
+        if(!pool->queue_head) {
+            pool->queue_tail = NULL;
+        }
+        __atomic_store_n(&pool->queue_length, pool->queue_length - 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&pool->queue_lock);
+    return task;
+}
+
+/* ------------------------------ scheduling ------------------------------ */
+
+/* wake a sleeping worker, if any, after new work became available */
+static void thread_pool_notify(ThreadPool* pool) {
+    __atomic_fetch_add(&pool->epoch, 1, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&pool->sleepers, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&pool->sleep_lock);
+        pthread_cond_signal(&pool->sleep_cond);
+        pthread_mutex_unlock(&pool->sleep_lock);
+    }
+}
+
+/* sleep until work is spawned after @p epoch was read, or pool shuts down */
+static void thread_pool_sleep(ThreadPool* pool, Uint64 epoch) {
+    pthread_mutex_lock(&pool->sleep_lock);
+    __atomic_fetch_add(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    while(__atomic_load_n(&pool->epoch, __ATOMIC_SEQ_CST) == epoch &&
+          !__atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE)) {
+        pthread_cond_wait(&pool->sleep_cond, &pool->sleep_lock);
+    }
+    __atomic_fetch_sub(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pool->sleep_lock);
+}
+
+/* worker of calling thread, if it belongs to given pool */
+static inline Worker* thread_pool_self(ThreadPool* pool) {
+    return current_worker && current_worker->pool == pool ? current_worker : NULL;
+}
+
+/* own deque first, then shared queue, then steal from other workers starting at a random one */
+static Task* thread_pool_find_task(ThreadPool* pool, Worker* self) {
+    Task* task = NULL;
+
+    if(self && (task = task_deque_pop(self))) {
+        return task;
+    }
+
+    if((task = task_queue_pop(pool))) {
+        return task;
+    }
+
+    if(!steal_seed) {
+        steal_seed = (Uint64)(UintPtr)&steal_seed | 1;
+    }
+    steal_seed ^= steal_seed << 13;
+    steal_seed ^= steal_seed >> 7;
+    steal_seed ^= steal_seed << 17;
+
+    Size start = steal_seed % pool->thread_count;
+    for(Size i = 0; i < pool->thread_count; i++) {
+        Worker* victim = &pool->workers[(start + i) % pool->thread_count];
+        if(victim != self && (task = task_deque_steal(victim))) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+/* make task available to workers of pool, or run it here if that's not possible */
+static void thread_pool_submit(ThreadPool* pool, Task* task);
+
+/* split range in halves, spawning right halves, until it's no bigger than grain, then run it */
+static void parallel_for_run_range(TaskGroup* group, ParallelForCallback fn, void* udata, Size begin, Size end, Size grain) {
+    while(end - begin > grain) {
+        Size  mid  = begin + (end - begin) / 2;
+        Task* task = NEW(Task);
+        if(!task) {
+            break;
+        }
+
+        task->range_fn = fn;
+        task->udata    = udata;
+        task->group    = group;
+        task->begin    = mid;
+        task->end      = end;
+        task->grain    = grain;
+        __atomic_fetch_add(&group->pending, 1, __ATOMIC_RELAXED);
+        thread_pool_submit(group->pool, task);
+
+        end = mid;
+    }
+
+    fn(begin, end, udata);
+}
+
+static void task_run(Task* task) {
+    TaskGroup* group = task->group;
+
+    if(task->range_fn) {
+        parallel_for_run_range(group, task->range_fn, task->udata, task->begin, task->end, task->grain);
+    } else {
+        task->fn(task->udata);
+    }
+
+    /* group may go out of scope as soon as pending reaches 0, so it's not touched after this */
+    FREE(task);
+    __atomic_fetch_sub(&group->pending, 1, __ATOMIC_RELEASE);
+}
+
+static void thread_pool_submit(ThreadPool* pool, Task* task) {
+    Worker* self = thread_pool_self(pool);
+
+    if(self) {
+        if(!task_deque_push(self, task)) {
+            task_run(task);
+            return;
+        }
+    } else {
+        task_queue_push(pool, task);
+    }
+
+    thread_pool_notify(pool);
+}
+
+static void* worker_main(void* arg) {
+    Worker*     w    = (Worker*)arg;
+    ThreadPool* pool = w->pool;
+    Size        idle = 0;
+
+    current_worker = w;
+
+    while(!__atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE)) {
+        /* read before looking for work, so work spawned after this is never slept through */
+        Uint64 epoch = __atomic_load_n(&pool->epoch, __ATOMIC_SEQ_CST);
+
+        Task* task = thread_pool_find_task(pool, w);
+        if(task) {
+            task_run(task);
+            idle = 0;
+        } else if(++idle < WORKER_SPIN_ROUNDS) {
+            sched_yield();
+        } else {
+            thread_pool_sleep(pool, epoch);
+            idle = 0;
+        }
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+/* ------------------------------- public API ------------------------------ */
+
+/**
+ * Create a thread pool with given number of workers and no CPU affinity.
+ *
+ * @param thread_count Number of workers, 0 means number of online CPUs.
+ *
+ * @return ThreadPool on success.
+ * @return NULL otherwise.
+ * */
+ThreadPool* thread_pool_create(Size thread_count) {
+    ThreadPoolConfig config = {.thread_count = thread_count};
+    return thread_pool_create_with_config(&config);
+}
+
+/**
+ * Create a thread pool with given configuration. All workers are started
+ * before this returns.
+ *
+ * @return ThreadPool on success.
+ * @return NULL otherwise.
+ * */
+ThreadPool* thread_pool_create_with_config(const ThreadPoolConfig* config) {
+    ERR_RETURN_VALUE_IF_FAIL(config, NULL, ERR_INVALID_ARGUMENTS);
+
+    ThreadPool* pool = NEW(ThreadPool);
+    ERR_RETURN_VALUE_IF_FAIL(pool, NULL, ERR_OUT_OF_MEMORY);
+
+    pool->online_cpus  = online_cpu_count();
+    pool->thread_count = config->thread_count ? config->thread_count : pool->online_cpus;
+    pool->workers      = ALLOCATE(Worker, pool->thread_count);
+    if(!pool->workers) {
+        FREE(pool);
+        ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->queue_lock, NULL);
+    pthread_mutex_init(&pool->sleep_lock, NULL);
+    pthread_cond_init(&pool->sleep_cond, NULL);
+
+    /* all deques must exist before any worker starts stealing */
+    for(Size i = 0; i < pool->thread_count; i++) {
+        pool->workers[i].pool  = pool;
+        pool->workers[i].index = i;
+        pool->workers[i].array = task_array_create(TASK_DEQUE_INITIAL_CAPACITY);
+        if(!pool->workers[i].array) {
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OUT_OF_MEMORY));
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    for(Size i = 0; i < pool->thread_count; i++) {
+        Worker* w  = &pool->workers[i];
+        w->started = pthread_create(&w->thread, NULL, worker_main, w) == 0;
+        if(!w->started) {
+            ERR(__FUNCTION__, ERRFMT, ERRMSG(ERR_OPERATION_FAILED));
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+
+        if(config->pin_threads) {
+            thread_pool_set_affinity(pool, i, (config->first_cpu + i) % pool->online_cpus);
+        }
+    }
+
+    return pool;
+}
+
+/**
+ * Stop all workers and destroy given pool. Tasks must not be spawned into
+ * a pool that's being destroyed, and all task groups of it must have been
+ * waited for.
+ * */
+void thread_pool_destroy(ThreadPool* pool) {
+    ERR_RETURN_IF_FAIL(pool, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock(&pool->sleep_lock);
+    __atomic_store_n(&pool->shutdown, True, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->sleep_cond);
+    pthread_mutex_unlock(&pool->sleep_lock);
+
+    for(Size i = 0; i < pool->thread_count; i++) {
+        if(pool->workers[i].started) {
+            pthread_join(pool->workers[i].thread, NULL);
+        }
+    }
+
+    for(Size i = 0; i < pool->thread_count; i++) {
+        TaskArray* array = pool->workers[i].array;
+        while(array) {
+            TaskArray* prev = array->prev;
+            FREE(array);
+            array = prev;
+        }
+    }
+
+    pthread_cond_destroy(&pool->sleep_cond);
+    pthread_mutex_destroy(&pool->sleep_lock);
+    pthread_mutex_destroy(&pool->queue_lock);
+    FREE(pool->workers);
+    FREE(pool);
+}
+
+static void default_pool_create() {
+    default_pool = thread_pool_create(0);
+}
+
+/**
+ * Get process wide pool, with one worker per online CPU, created on first
+ * use. It's used wherever a NULL pool is passed, and is never destroyed.
+ *
+ * @return ThreadPool on success.
+ * @return NULL if pool could not be created.
+ * */
+ThreadPool* thread_pool_default() {
+    pthread_once(&default_pool_once, default_pool_create);
+    return default_pool;
+}
+
+/**
+ * Get number of worker threads of given pool.
+ * */
+Size thread_pool_get_thread_count(ThreadPool* pool) {
+    ERR_RETURN_VALUE_IF_FAIL(pool, 0, ERR_INVALID_ARGUMENTS);
+    return pool->thread_count;
+}
+
+/**
+ * Pin a worker of given pool to a single CPU.
+ *
+ * @param worker Index of worker, less than thread count of pool.
+ * @param cpu Index of CPU to run worker on.
+ *
+ * @return True on success.
+ * @return False if pinning failed, or is not supported on this platform.
+ * */
+Bool thread_pool_set_affinity(ThreadPool* pool, Size worker, Size cpu) {
+    ERR_RETURN_VALUE_IF_FAIL(pool, False, ERR_INVALID_ARGUMENTS);
+    ERR_RETURN_VALUE_IF_FAIL(worker < pool->thread_count, False, ERR_INVALID_INDEX);
+
+#if defined(__linux__)
+    ERR_RETURN_VALUE_IF_FAIL(cpu < CPU_SETSIZE, False, ERR_INVALID_ARGUMENTS);
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pool->workers[worker].thread, sizeof(set), &set) == 0;
+#else
+    UNUSED(cpu);
+    return False;
+#endif // __linux__
+}
+
+/**
+ * Get index of worker running on calling thread, within it's pool.
+ * Useful to index per worker scratch space inside tasks.
+ *
+ * @return Index of worker.
+ * @return SIZE_MAX if calling thread is not a worker of any pool.
+ * */
+Size thread_pool_current_worker() {
+    return current_worker ? current_worker->index : SIZE_MAX;
+}
+
+/**
+ * Initialize an empty task group, to spawn tasks into given pool.
+ *
+ * @param pool Pool to run tasks on, NULL means @c thread_pool_default.
+ * */
+void task_group_init(TaskGroup* group, ThreadPool* pool) {
+    ERR_RETURN_IF_FAIL(group, ERR_INVALID_ARGUMENTS);
+
+    group->pool    = pool ? pool : thread_pool_default();
+    group->pending = 0;
+}
+
+/**
+ * Spawn a task into given group. Task may start running right away, on
+ * any worker of pool, or on a thread waiting for any group of pool. If
+ * task can't be spawned, it's run on calling thread before this returns.
+ * */
+void task_group_spawn(TaskGroup* group, TaskCallback fn, void* udata) {
+    ERR_RETURN_IF_FAIL(group && fn, ERR_INVALID_ARGUMENTS);
+
+    Task* task = group->pool ? NEW(Task) : NULL;
+    if(!task) {
+        fn(udata);
+        return;
+    }
+
+    task->fn    = fn;
+    task->udata = udata;
+    task->group = group;
+    __atomic_fetch_add(&group->pending, 1, __ATOMIC_RELAXED);
+    thread_pool_submit(group->pool, task);
+}
+
+/**
+ * Wait till all tasks spawned into given group, and all tasks they spawned
+ * into it, complete. Calling thread runs pending tasks of pool meanwhile.
+ * */
+void task_group_wait(TaskGroup* group) {
+    ERR_RETURN_IF_FAIL(group, ERR_INVALID_ARGUMENTS);
+
+    while(__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE)) {
+        Task* task = thread_pool_find_task(group->pool, thread_pool_self(group->pool));
+        if(task) {
+            task_run(task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * Call @p fn over subranges of [begin, end), in parallel, and return once
+ * all calls complete. Range is split recursively in halves, and idle
+ * workers steal larger halves first, so load balances itself even when
+ * iterations take uneven time.
+ *
+ * @param pool Pool to run on, NULL means @c thread_pool_default.
+ * @param grain Largest subrange given to a single call of @p fn, 0 picks
+ *        one from size of range and number of workers.
+ * */
+void parallel_for(ThreadPool* pool, Size begin, Size end, Size grain, ParallelForCallback fn, void* udata) {
+    ERR_RETURN_IF_FAIL(fn, ERR_INVALID_ARGUMENTS);
+
+    if(begin >= end) {
+        return;
+    }
+
+    TaskGroup group;
+    task_group_init(&group, pool);
+
+    Size count = end - begin;
+    if(!grain) {
+        Size threads = group.pool ? group.pool->thread_count + 1 : 1;
+        grain        = MAX(count / (threads * PARALLEL_FOR_SPLITS_PER_THREAD), 1);
+    }
+
+    if(!group.pool || count <= grain) {
+        fn(begin, end, udata);
+        return;
+    }
+
+    parallel_for_run_range(&group, fn, udata, begin, end, grain);
+    task_group_wait(&group);
+}